@@ -17,6 +17,7 @@
 #include <iostream>
 
 #include <qnnpack.h>
+#include <pthreadpool.h>
 
 #include <benchmark/benchmark.h>
 
@@ -60,7 +61,8 @@ class Q8Convolution : public benchmark::Fixture {
       127, 0.5f,
       127, 0.5f,
       kernel(), bias(),
-      127, 0.5f, 0, 255,
+      127, 0.5f, outputMin(), outputMax(),
+      flags(),
       &convolutionObject_);
     assert(status == qnnp_status_success);
 
@@ -177,6 +179,19 @@ class Q8Convolution : public benchmark::Fixture {
     return groups() * groupOutputChannels();
   }
 
+  virtual uint32_t flags() const {
+    return 0;
+  }
+
+  /* The full output range needs no clamps in the epilogue of the microkernels */
+  virtual uint8_t outputMin() const {
+    return 0;
+  }
+
+  virtual uint8_t outputMax() const {
+    return 255;
+  }
+
  private:
   qnnp_operator_t convolutionObject_;
   std::vector<uint8_t> input_;
@@ -194,6 +209,130 @@ class Q8Convolution : public benchmark::Fixture {
   uint32_t groupOutputChannels_{1};
 };
 
+/* Dense 3x3 layers that Q8Convolution computes with Winograd, on the convolution microkernels instead */
+class Q8ConvolutionNoWinograd : public Q8Convolution {
+ public:
+  virtual uint32_t flags() const override {
+    return QNNP_CREATE_FLAG_NO_WINOGRAD;
+  }
+};
+
+/* First layers of the networks below, reading the image in NCHW instead of NHWC layout */
+class Q8ConvolutionNCHWInput : public Q8Convolution {
+ public:
+  virtual uint32_t flags() const override {
+    return QNNP_CREATE_FLAG_INPUT_NCHW;
+  }
+};
+
+/* Layers with a fused ReLU, clamped below at the output zero point only, against the unclamped Q8Convolution */
+class Q8ConvolutionReLU : public Q8Convolution {
+ public:
+  virtual uint8_t outputMin() const override {
+    return 127;
+  }
+};
+
+/* Layers with a fused ReLU6, 6 / 0.5 above the output zero point, which need both clamps */
+class Q8ConvolutionReLU6 : public Q8ConvolutionReLU {
+ public:
+  virtual uint8_t outputMax() const override {
+    return 127 + 12;
+  }
+};
+
+/*
+ * Plan of the layer followed by a 1x1 convolution back to its input channels, as in a ShuffleNet unit, to measure the
+ * latency of running consecutive small layers on threads.
+ */
+class Q8ConvolutionPlan : public Q8Convolution {
+ public:
+  virtual void SetUp(const benchmark::State& state) override
+  {
+    Q8Convolution::SetUp(state);
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    std::vector<uint8_t> kernel(inputPixelStride() * outputPixelStride());
+    std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+    std::vector<int32_t> bias(inputPixelStride());
+    std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+    qnnp_status status = qnnp_create_convolution2d_nhwc_q8(
+      0, 0, 0, 0,
+      1, 1,
+      1, 1,
+      1, 1,
+      1, outputPixelStride(), inputPixelStride(),
+      127, 0.5f,
+      127, 0.5f,
+      kernel.data(), bias.data(),
+      127, 0.5f, 0, 255,
+      0 /* flags */,
+      &projectionObject_);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_create_plan(batchSize(), inputHeight(), inputWidth(), inputPixelStride(), &plan_);
+    assert(status == qnnp_status_success);
+    status = qnnp_plan_add_operator(plan_, convolutionObject());
+    assert(status == qnnp_status_success);
+    status = qnnp_plan_add_operator(plan_, projectionObject_);
+    assert(status == qnnp_status_success);
+
+    size_t outputHeight, outputWidth, outputChannels;
+    status = qnnp_get_plan_output_shape(plan_, &outputHeight, &outputWidth, &outputChannels);
+    assert(status == qnnp_status_success);
+    planOutput_.resize(batchSize() * outputHeight * outputWidth * outputChannels);
+
+    threadpool_ = pthreadpool_create(0);
+  }
+
+  virtual void TearDown(benchmark::State& state) override
+  {
+    qnnp_delete_plan(plan_);
+    plan_ = nullptr;
+    qnnp_delete_operator(projectionObject_);
+    projectionObject_ = nullptr;
+    if (affinityPool_ != nullptr) {
+      qnnp_delete_affinity_pool(affinityPool_);
+      affinityPool_ = nullptr;
+    }
+    pthreadpool_destroy(threadpool_);
+    threadpool_ = nullptr;
+    planOutput_.clear();
+    Q8Convolution::TearDown(state);
+  }
+
+  inline qnnp_plan_t plan() const {
+    return plan_;
+  }
+
+  inline pthreadpool_t threadpool() const {
+    return threadpool_;
+  }
+
+  inline uint8_t* planOutput() {
+    return planOutput_.data();
+  }
+
+  /* Runs the plan on the processors of the first cluster, or returns false if threads can't be pinned */
+  bool useAffinityPool(bool spinWait) {
+    if (qnnp_create_cluster_affinity_pool(0, &affinityPool_) != qnnp_status_success) {
+      return false;
+    }
+    return qnnp_plan_set_affinity_pool(plan_, affinityPool_, spinWait) == qnnp_status_success;
+  }
+
+ private:
+  qnnp_operator_t projectionObject_{nullptr};
+  qnnp_plan_t plan_{nullptr};
+  qnnp_affinity_pool_t affinityPool_{nullptr};
+  pthreadpool_t threadpool_{nullptr};
+  std::vector<uint8_t> planOutput_;
+};
+
 static void ShuffleNetV1G1(benchmark::internal::Benchmark* b) {
   b->ArgNames({"N", "H", "W", "KH", "KW", "S", "G", "GCin", "GCout"});
 
@@ -462,6 +601,7 @@ static void SqueezeNetV11(benchmark::internal::Benchmark* b) {
 
 static void VGG(benchmark::internal::Benchmark* b) {
   b->ArgNames({"N", "H", "W", "KH", "KW", "S", "G", "GCin", "GCout"});
+  /* 3x3 layers after Conv 1.1 have enough channels for Winograd, see Q8ConvolutionNoWinograd */
 
   /* Conv 1.1 */
   b->Args({1, 224, 224, 3, 3, 1, 1,   3,   64});
@@ -493,6 +633,31 @@ static void VGG(benchmark::internal::Benchmark* b) {
   b->Args({1,  14,  14, 1, 1, 1, 1, 512,  512});
 }
 
+static void FirstLayers(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "H", "W", "KH", "KW", "S", "G", "GCin", "GCout"});
+
+  /* MobileNet v1 and v2 */
+  b->Args({1, 224, 224, 3, 3, 2, 1, 3, 32});
+  /* ShuffleNet v1 */
+  b->Args({1, 224, 224, 3, 3, 2, 1, 3, 24});
+  /* SqueezeNet 1.0 */
+  b->Args({1, 224, 224, 7, 7, 2, 1, 3, 96});
+  /* VGG */
+  b->Args({1, 224, 224, 3, 3, 1, 1, 3, 64});
+}
+
+static void DepthwiseMultiplier(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "H", "W", "KH", "KW", "S", "G", "GCin", "GCout"});
+  /* Depthwise layers with a channel multiplier of 2 or 4, which read every input channel for its output channels */
+
+  b->Args({1, 112, 112, 3, 3, 1,  16, 1, 2});
+  b->Args({1, 112, 112, 3, 3, 2,  32, 1, 2});
+  b->Args({1,  56,  56, 3, 3, 1,  32, 1, 4});
+  b->Args({1,  28,  28, 3, 3, 1,  64, 1, 4});
+  b->Args({1,  28,  28, 5, 5, 1,  64, 1, 2});
+  b->Args({1,  14,  14, 3, 3, 1, 128, 1, 4});
+}
+
 BENCHMARK_DEFINE_F(Q8Convolution, run)(benchmark::State& state)
 {
   for (auto _ : state) {
@@ -509,6 +674,81 @@ BENCHMARK_REGISTER_F(Q8Convolution, run)->Apply(ShuffleNetV1G8);
 BENCHMARK_REGISTER_F(Q8Convolution, run)->Apply(SqueezeNetV10);
 BENCHMARK_REGISTER_F(Q8Convolution, run)->Apply(SqueezeNetV11);
 BENCHMARK_REGISTER_F(Q8Convolution, run)->Apply(VGG);
+BENCHMARK_REGISTER_F(Q8Convolution, run)->Apply(DepthwiseMultiplier);
+
+BENCHMARK_DEFINE_F(Q8ConvolutionNoWinograd, run)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    qnnp_run_operator(convolutionObject(), nullptr /* thread pool */);
+  }
+}
+BENCHMARK_REGISTER_F(Q8ConvolutionNoWinograd, run)->Apply(VGG);
+
+BENCHMARK_DEFINE_F(Q8ConvolutionNCHWInput, run)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    qnnp_run_operator(convolutionObject(), nullptr /* thread pool */);
+  }
+}
+BENCHMARK_REGISTER_F(Q8ConvolutionNCHWInput, run)->Apply(FirstLayers);
+
+BENCHMARK_DEFINE_F(Q8ConvolutionReLU, run)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    qnnp_run_operator(convolutionObject(), nullptr /* thread pool */);
+  }
+}
+BENCHMARK_REGISTER_F(Q8ConvolutionReLU, run)->Apply(MobileNetV1);
+BENCHMARK_REGISTER_F(Q8ConvolutionReLU, run)->Apply(MobileNetV2);
+
+BENCHMARK_DEFINE_F(Q8ConvolutionReLU6, run)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    qnnp_run_operator(convolutionObject(), nullptr /* thread pool */);
+  }
+}
+BENCHMARK_REGISTER_F(Q8ConvolutionReLU6, run)->Apply(MobileNetV1);
+BENCHMARK_REGISTER_F(Q8ConvolutionReLU6, run)->Apply(MobileNetV2);
+
+BENCHMARK_DEFINE_F(Q8ConvolutionPlan, threadpool)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    qnnp_plan_run(plan(), input(), planOutput(), threadpool());
+  }
+}
+BENCHMARK_REGISTER_F(Q8ConvolutionPlan, threadpool)->Apply(ShuffleNetV1G8);
+
+BENCHMARK_DEFINE_F(Q8ConvolutionPlan, affinity_pool)(benchmark::State& state)
+{
+  if (!useAffinityPool(false /* spin wait */)) {
+    state.SkipWithError("failed to pin threads to the first cluster");
+  }
+  for (auto _ : state) {
+    qnnp_plan_run(plan(), input(), planOutput(), nullptr /* thread pool */);
+  }
+}
+BENCHMARK_REGISTER_F(Q8ConvolutionPlan, affinity_pool)->Apply(ShuffleNetV1G8);
+
+BENCHMARK_DEFINE_F(Q8ConvolutionPlan, spin_wait)(benchmark::State& state)
+{
+  if (!useAffinityPool(true /* spin wait */)) {
+    state.SkipWithError("failed to pin threads to the first cluster");
+  }
+  for (auto _ : state) {
+    qnnp_plan_run(plan(), input(), planOutput(), nullptr /* thread pool */);
+  }
+}
+BENCHMARK_REGISTER_F(Q8ConvolutionPlan, spin_wait)->Apply(ShuffleNetV1G8);
+
+/* Layers below one million multiply-adds run on the calling thread, the others on the thread pool */
+BENCHMARK_DEFINE_F(Q8ConvolutionPlan, serial_threshold)(benchmark::State& state)
+{
+  qnnp_plan_set_serial_threshold(plan(), UINT64_C(1000000));
+  for (auto _ : state) {
+    qnnp_plan_run(plan(), input(), planOutput(), threadpool());
+  }
+}
+BENCHMARK_REGISTER_F(Q8ConvolutionPlan, serial_threshold)->Apply(ShuffleNetV1G8);
 
 #ifndef QNNPACK_BENCHMARK_NO_MAIN
 BENCHMARK_MAIN();
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <qnnpack.h>
+
+#include <benchmark/benchmark.h>
+
+
+class Q8Deconvolution : public benchmark::Fixture {
+ public:
+  virtual void SetUp(const benchmark::State& state) override
+  {
+    batchSize_ = state.range(0);
+    inputHeight_ = state.range(1);
+    inputWidth_ = state.range(2);
+    kernelHeight_ = state.range(3);
+    kernelWidth_ = state.range(4);
+    stride_ = state.range(5);
+    groups_ = state.range(6);
+    groupInputChannels_ = state.range(7);
+    groupOutputChannels_ = state.range(8);
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    input_.resize(batchSize() * inputHeight() * inputWidth() * inputPixelStride());
+    std::generate(input_.begin(), input_.end(), std::ref(u8rng));
+    kernel_.resize(groups() * groupOutputChannels() * kernelHeight() * kernelWidth() * groupInputChannels());
+    std::generate(kernel_.begin(), kernel_.end(), std::ref(u8rng));
+    bias_.resize(groups() * groupOutputChannels());
+    std::generate(bias_.begin(), bias_.end(), std::ref(s32rng));
+    output_.resize(batchSize() * outputHeight() * outputWidth() * outputPixelStride());
+
+    qnnp_status status = qnnp_initialize();
+    assert(status == qnnp_status_success);
+
+    status = qnnp_create_deconvolution2d_nhwc_q8(
+      paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+      /* adjustment */ 0, 0,
+      kernelHeight(), kernelWidth(),
+      stride(), stride(),
+      /* dilation */ 1, 1,
+      groups(), groupInputChannels(), groupOutputChannels(),
+      127, 0.5f,
+      127, 0.5f,
+      kernel(), bias(),
+      127, 0.5f, 0, 255,
+      0 /* flags */,
+      &deconvolutionObject_);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_setup_deconvolution2d_nhwc_q8(
+      deconvolutionObject_,
+      batchSize(), inputHeight(), inputWidth(),
+      input(), inputPixelStride(),
+      output(), outputPixelStride(),
+      nullptr /* thread pool */);
+    assert(status == qnnp_status_success);
+  }
+
+  virtual void TearDown(benchmark::State& state) override
+  {
+    qnnp_delete_operator(deconvolutionObject_);
+    deconvolutionObject_ = nullptr;
+
+    /* Every input pixel is multiplied by every tap, wherever the taps land in the output */
+    state.SetItemsProcessed(
+      uint64_t(state.iterations()) * 2 *
+        batchSize() * inputHeight() * inputWidth() *
+        groups() * groupInputChannels() * groupOutputChannels() *
+        kernelHeight() * kernelWidth());
+    input_.clear();
+    kernel_.clear();
+    bias_.clear();
+    output_.clear();
+  }
+
+  inline const uint8_t* input() const {
+    return input_.data();
+  }
+
+  inline const uint8_t* kernel() const {
+    return kernel_.data();
+  }
+
+  inline const int32_t* bias() const {
+    return bias_.data();
+  }
+
+  inline uint8_t* output() {
+    return output_.data();
+  }
+
+  inline size_t batchSize() const {
+    return batchSize_;
+  }
+
+  inline size_t inputHeight() const {
+    return inputHeight_;
+  }
+
+  inline size_t inputWidth() const {
+    return inputWidth_;
+  }
+
+  inline uint32_t kernelHeight() const {
+    return kernelHeight_;
+  }
+
+  inline uint32_t kernelWidth() const {
+    return kernelWidth_;
+  }
+
+  inline uint32_t stride() const {
+    return stride_;
+  }
+
+  /* Padding crops the output to exactly stride times the input, as upsampling layers do */
+  inline uint32_t paddingLeft() const {
+    return (kernelWidth() - stride()) / 2;
+  }
+
+  inline uint32_t paddingRight() const {
+    return kernelWidth() - stride() - paddingLeft();
+  }
+
+  inline uint32_t paddingTop() const {
+    return (kernelHeight() - stride()) / 2;
+  }
+
+  inline uint32_t paddingBottom() const {
+    return kernelHeight() - stride() - paddingTop();
+  }
+
+  inline size_t outputHeight() const {
+    return stride() * inputHeight();
+  }
+
+  inline size_t outputWidth() const {
+    return stride() * inputWidth();
+  }
+
+  inline uint32_t groups() const {
+    return groups_;
+  }
+
+  inline uint32_t groupInputChannels() const {
+    return groupInputChannels_;
+  }
+
+  inline uint32_t groupOutputChannels() const {
+    return groupOutputChannels_;
+  }
+
+  inline qnnp_operator_t deconvolutionObject() const {
+    return deconvolutionObject_;
+  }
+
+  inline size_t inputPixelStride() const {
+    return groups() * groupInputChannels();
+  }
+
+  inline size_t outputPixelStride() const {
+    return groups() * groupOutputChannels();
+  }
+
+ private:
+  qnnp_operator_t deconvolutionObject_;
+  std::vector<uint8_t> input_;
+  std::vector<uint8_t> kernel_;
+  std::vector<int32_t> bias_;
+  std::vector<uint8_t> output_;
+  size_t batchSize_{1};
+  size_t inputHeight_{1};
+  size_t inputWidth_{1};
+  uint32_t kernelHeight_{1};
+  uint32_t kernelWidth_{1};
+  uint32_t stride_{1};
+  uint32_t groups_{1};
+  uint32_t groupInputChannels_{1};
+  uint32_t groupOutputChannels_{1};
+};
+
+/* FCN-8s on a 512x512 image with 21 classes */
+static void FCN8s(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "H", "W", "KH", "KW", "S", "G", "GCin", "GCout"});
+
+  /* upscore2 */
+  b->Args({1,  16,  16,  4,  4, 2, 1, 21, 21});
+  /* upscore_pool4 */
+  b->Args({1,  32,  32,  4,  4, 2, 1, 21, 21});
+  /* upscore8 */
+  b->Args({1,  64,  64, 16, 16, 8, 1, 21, 21});
+}
+
+/* U-Net on a 572x572 image, with the up-convolutions of the expanding path */
+static void UNet(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "H", "W", "KH", "KW", "S", "G", "GCin", "GCout"});
+
+  b->Args({1,  28,  28, 2, 2, 2, 1, 1024, 512});
+  b->Args({1,  52,  52, 2, 2, 2, 1,  512, 256});
+  b->Args({1, 100, 100, 2, 2, 2, 1,  256, 128});
+  b->Args({1, 196, 196, 2, 2, 2, 1,  128,  64});
+}
+
+/*
+ * DeepLab v3+ on a 512x512 image with output stride 16, with the bilinear upsampling of the decoder and of the logits
+ * as depthwise deconvolutions
+ */
+static void DeepLabV3Plus(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "H", "W", "KH", "KW", "S", "G", "GCin", "GCout"});
+
+  /* ASPP features to 1/4 of the image */
+  b->Args({1,  32,  32, 8, 8, 4, 256, 1, 1});
+  /* Logits to the full image */
+  b->Args({1, 128, 128, 8, 8, 4,  21, 1, 1});
+}
+
+/* Learned 2x upsampling of segmentation decoders, e.g. LinkNet and ENet, with a 3x3 kernel */
+static void Decoder3x3(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "H", "W", "KH", "KW", "S", "G", "GCin", "GCout"});
+
+  b->Args({1,  16,  16, 3, 3, 2, 1, 128, 128});
+  b->Args({1,  32,  32, 3, 3, 2, 1,  64,  64});
+  b->Args({1,  64,  64, 3, 3, 2, 1,  32,  32});
+  b->Args({1, 128, 128, 3, 3, 2, 1,  16,  16});
+}
+
+BENCHMARK_DEFINE_F(Q8Deconvolution, run)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    qnnp_run_operator(deconvolutionObject(), nullptr /* thread pool */);
+  }
+}
+BENCHMARK_REGISTER_F(Q8Deconvolution, run)->Apply(FCN8s);
+BENCHMARK_REGISTER_F(Q8Deconvolution, run)->Apply(UNet);
+BENCHMARK_REGISTER_F(Q8Deconvolution, run)->Apply(DeepLabV3Plus);
+BENCHMARK_REGISTER_F(Q8Deconvolution, run)->Apply(Decoder3x3);
+
+#ifndef QNNPACK_BENCHMARK_NO_MAIN
+BENCHMARK_MAIN();
+#endif
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <qnnpack.h>
+
+#include <benchmark/benchmark.h>
+
+
+class Q8FullyConnected : public benchmark::Fixture {
+ public:
+  virtual void SetUp(const benchmark::State& state) override
+  {
+    batchSize_ = state.range(0);
+    inputChannels_ = state.range(1);
+    outputChannels_ = state.range(2);
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    input_.resize(batchSize() * inputChannels());
+    std::generate(input_.begin(), input_.end(), std::ref(u8rng));
+    kernel_.resize(outputChannels() * inputChannels());
+    std::generate(kernel_.begin(), kernel_.end(), std::ref(u8rng));
+    bias_.resize(outputChannels());
+    std::generate(bias_.begin(), bias_.end(), std::ref(s32rng));
+    output_.resize(batchSize() * outputChannels());
+
+    qnnp_status status = qnnp_initialize();
+    assert(status == qnnp_status_success);
+
+    status = qnnp_create_fully_connected_nc_q8(
+      inputChannels(), outputChannels(),
+      127, 0.5f,
+      127, 0.5f,
+      kernel(), bias(),
+      127, 0.5f, 0, 255,
+      0 /* flags */,
+      &fullyConnectedObject_);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_setup_fully_connected_nc_q8(
+      fullyConnectedObject_,
+      batchSize(),
+      input(), inputChannels(),
+      output(), outputChannels(),
+      nullptr /* thread pool */);
+    assert(status == qnnp_status_success);
+  }
+
+  virtual void TearDown(benchmark::State& state) override
+  {
+    qnnp_delete_operator(fullyConnectedObject_);
+    fullyConnectedObject_ = nullptr;
+
+    state.SetItemsProcessed(
+      uint64_t(state.iterations()) * 2 * batchSize() * inputChannels() * outputChannels());
+    input_.clear();
+    kernel_.clear();
+    bias_.clear();
+    output_.clear();
+  }
+
+  inline const uint8_t* input() const {
+    return input_.data();
+  }
+
+  inline const uint8_t* kernel() const {
+    return kernel_.data();
+  }
+
+  inline const int32_t* bias() const {
+    return bias_.data();
+  }
+
+  inline uint8_t* output() {
+    return output_.data();
+  }
+
+  inline size_t batchSize() const {
+    return batchSize_;
+  }
+
+  inline size_t inputChannels() const {
+    return inputChannels_;
+  }
+
+  inline size_t outputChannels() const {
+    return outputChannels_;
+  }
+
+  inline qnnp_operator_t fullyConnectedObject() const {
+    return fullyConnectedObject_;
+  }
+
+ private:
+  qnnp_operator_t fullyConnectedObject_;
+  std::vector<uint8_t> input_;
+  std::vector<uint8_t> kernel_;
+  std::vector<int32_t> bias_;
+  std::vector<uint8_t> output_;
+  size_t batchSize_{1};
+  size_t inputChannels_{1};
+  size_t outputChannels_{1};
+};
+
+/* Classifier heads of ImageNet models */
+static void ClassifierHeads(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "Cin", "Cout"});
+
+  /* AlexNet */
+  b->Args({1,  9216, 4096});
+  b->Args({1,  4096, 4096});
+  b->Args({1,  4096, 1000});
+  /* VGG */
+  b->Args({1, 25088, 4096});
+  /* MobileNet v1 */
+  b->Args({1,  1024, 1000});
+  /* MobileNet v2 */
+  b->Args({1,  1280, 1000});
+  /* ShuffleNet v1 with 3 groups */
+  b->Args({1,   960, 1000});
+  /* ResNet-50 */
+  b->Args({1,  2048, 1000});
+}
+
+/*
+ * Gate projections of recurrent cells, which multiply the concatenated input and hidden state by the weights of all
+ * gates (4 for LSTM, 3 for GRU) at once, for a single sequence and a batch of sequences
+ */
+static void RNNCells(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "Cin", "Cout"});
+
+  /* LSTM with 256 hidden units */
+  b->Args({ 1,  512, 1024});
+  b->Args({16,  512, 1024});
+  /* LSTM with 512 hidden units */
+  b->Args({ 1, 1024, 2048});
+  b->Args({16, 1024, 2048});
+  /* LSTM with 1024 hidden units, e.g. GNMT */
+  b->Args({ 1, 2048, 4096});
+  b->Args({16, 2048, 4096});
+  /* GRU with 512 hidden units */
+  b->Args({ 1, 1024, 1536});
+  b->Args({16, 1024, 1536});
+}
+
+BENCHMARK_DEFINE_F(Q8FullyConnected, run)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    qnnp_run_operator(fullyConnectedObject(), nullptr /* thread pool */);
+  }
+}
+BENCHMARK_REGISTER_F(Q8FullyConnected, run)->Apply(ClassifierHeads);
+BENCHMARK_REGISTER_F(Q8FullyConnected, run)->Apply(RNNCells);
+
+#ifndef QNNPACK_BENCHMARK_NO_MAIN
+BENCHMARK_MAIN();
+#endif
@@ -0,0 +1,585 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cpuinfo.h>
+#include <qnnpack.h>
+#include <pthreadpool.h>
+
+#include <benchmark/benchmark.h>
+
+
+/*
+ * Whole network of quantized operators, each reading the output tensor of the operators before it, as in inference.
+ * Layers of bench/convolution.cc run in isolation instead, with their input and weights in cache from the previous
+ * iteration.
+ */
+class Network {
+ public:
+  /* NHWC tensor of one image, possibly a channel slice of a larger tensor */
+  struct Tensor {
+    uint8_t* data;
+    size_t height;
+    size_t width;
+    size_t channels;
+    size_t pixelStride;
+  };
+
+  explicit Network(pthreadpool_t threadpool) :
+    threadpool_(threadpool),
+    rng_(std::random_device()())
+  {
+  }
+
+  ~Network() {
+    for (qnnp_operator_t op : operators_) {
+      qnnp_delete_operator(op);
+    }
+  }
+
+  Tensor input(size_t height, size_t width, size_t channels) {
+    Tensor x = tensor(height, width, channels);
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), std::ref(rng_));
+    std::generate(x.data, x.data + height * width * channels, std::ref(u8rng));
+    return x;
+  }
+
+  Tensor tensor(size_t height, size_t width, size_t channels) {
+    /* Microkernels may read up to 8 bytes before and after the tensor */
+    buffers_.emplace_back(height * width * channels + 16);
+    return Tensor{ buffers_.back().data() + 8, height, width, channels, channels };
+  }
+
+  /* Channels [offset, offset + channels) of the tensor */
+  static Tensor slice(const Tensor& x, size_t offset, size_t channels) {
+    return Tensor{ x.data + offset, x.height, x.width, channels, x.pixelStride };
+  }
+
+  Tensor convolution(
+      const char* name, const Tensor& x,
+      uint32_t kernelSize, uint32_t stride, uint32_t padding,
+      uint32_t groups, size_t outputChannels)
+  {
+    Tensor y = tensor(
+      (x.height + 2 * padding - kernelSize) / stride + 1,
+      (x.width + 2 * padding - kernelSize) / stride + 1,
+      outputChannels);
+    convolution(name, x, kernelSize, stride, padding, groups, y);
+    return y;
+  }
+
+  void convolution(
+      const char* name, const Tensor& x,
+      uint32_t kernelSize, uint32_t stride, uint32_t padding,
+      uint32_t groups, const Tensor& y)
+  {
+    assert(y.height == (x.height + 2 * padding - kernelSize) / stride + 1);
+    assert(y.width == (x.width + 2 * padding - kernelSize) / stride + 1);
+    const size_t groupInputChannels = x.channels / groups;
+    const size_t groupOutputChannels = y.channels / groups;
+    const std::vector<uint8_t> kernel = randomKernel(y.channels * kernelSize * kernelSize * groupInputChannels);
+    const std::vector<int32_t> bias = randomBias(y.channels);
+
+    qnnp_operator_t op = nullptr;
+    qnnp_status status = qnnp_create_convolution2d_nhwc_q8(
+      padding, padding, padding, padding,
+      kernelSize, kernelSize,
+      stride, stride,
+      1, 1,
+      groups, groupInputChannels, groupOutputChannels,
+      127, 0.5f,
+      127, 0.5f,
+      kernel.data(), bias.data(),
+      127, 0.5f, 0, 255,
+      0 /* flags */,
+      &op);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_setup_convolution2d_nhwc_q8(
+      op,
+      1, x.height, x.width,
+      x.data, x.pixelStride,
+      y.data, y.pixelStride,
+      threadpool_);
+    assert(status == qnnp_status_success);
+    addLayer(name, op);
+  }
+
+  /* Fully-connected layer over the whole image, flattened */
+  Tensor fullyConnected(const char* name, const Tensor& x, size_t outputChannels) {
+    assert(x.pixelStride == x.channels);
+    const size_t inputChannels = x.height * x.width * x.channels;
+    const std::vector<uint8_t> kernel = randomKernel(outputChannels * inputChannels);
+    const std::vector<int32_t> bias = randomBias(outputChannels);
+    Tensor y = tensor(1, 1, outputChannels);
+
+    qnnp_operator_t op = nullptr;
+    qnnp_status status = qnnp_create_fully_connected_nc_q8(
+      inputChannels, outputChannels,
+      127, 0.5f,
+      127, 0.5f,
+      kernel.data(), bias.data(),
+      127, 0.5f, 0, 255,
+      0 /* flags */,
+      &op);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_setup_fully_connected_nc_q8(
+      op, 1,
+      x.data, inputChannels,
+      y.data, outputChannels,
+      threadpool_);
+    assert(status == qnnp_status_success);
+    addLayer(name, op);
+    return y;
+  }
+
+  Tensor add(const char* name, const Tensor& a, const Tensor& b) {
+    assert(a.height == b.height && a.width == b.width && a.channels == b.channels);
+    Tensor y = tensor(a.height, a.width, a.channels);
+
+    qnnp_operator_t op = nullptr;
+    qnnp_status status = qnnp_create_add_nc_q8(
+      a.channels,
+      127, 0.5f,
+      127, 0.5f,
+      127, 1.0f,
+      0, 255,
+      0 /* flags */,
+      &op);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_setup_add_nc_q8(
+      op, a.height * a.width,
+      a.data, a.pixelStride,
+      b.data, b.pixelStride,
+      y.data, y.pixelStride,
+      threadpool_);
+    assert(status == qnnp_status_success);
+    addLayer(name, op);
+    return y;
+  }
+
+  /* Max pooling whose last window may extend past the input, as with ceil rounding of the output size */
+  Tensor maxPooling(const char* name, const Tensor& x, uint32_t poolingSize, uint32_t stride) {
+    const uint32_t paddingBottom = (stride - (x.height - poolingSize) % stride) % stride;
+    const uint32_t paddingRight = (stride - (x.width - poolingSize) % stride) % stride;
+    Tensor y = tensor(
+      (x.height + paddingBottom - poolingSize) / stride + 1,
+      (x.width + paddingRight - poolingSize) / stride + 1,
+      x.channels);
+
+    qnnp_operator_t op = nullptr;
+    qnnp_status status = qnnp_create_max_pooling2d_nhwc_u8(
+      0, paddingRight, paddingBottom, 0,
+      poolingSize, poolingSize,
+      stride, stride,
+      1, 1,
+      x.channels,
+      0, 255,
+      0 /* flags */,
+      &op);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_setup_max_pooling2d_nhwc_u8(
+      op,
+      1, x.height, x.width,
+      x.data, x.pixelStride,
+      y.data, y.pixelStride,
+      threadpool_);
+    assert(status == qnnp_status_success);
+    addLayer(name, op);
+    return y;
+  }
+
+  void averagePooling(
+      const char* name, const Tensor& x,
+      uint32_t poolingSize, uint32_t stride, uint32_t padding,
+      const Tensor& y)
+  {
+    assert(y.height == (x.height + 2 * padding - poolingSize) / stride + 1);
+    assert(y.width == (x.width + 2 * padding - poolingSize) / stride + 1);
+    assert(y.channels == x.channels);
+
+    qnnp_operator_t op = nullptr;
+    qnnp_status status = qnnp_create_average_pooling2d_nhwc_q8(
+      padding, padding, padding, padding,
+      poolingSize, poolingSize,
+      stride, stride,
+      x.channels,
+      127, 0.5f,
+      127, 0.5f,
+      0, 255,
+      0 /* flags */,
+      &op);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_setup_average_pooling2d_nhwc_q8(
+      op,
+      1, x.height, x.width,
+      x.data, x.pixelStride,
+      y.data, y.pixelStride,
+      threadpool_);
+    assert(status == qnnp_status_success);
+    addLayer(name, op);
+  }
+
+  Tensor globalAveragePooling(const char* name, const Tensor& x) {
+    Tensor y = tensor(1, 1, x.channels);
+
+    qnnp_operator_t op = nullptr;
+    qnnp_status status = qnnp_create_global_average_pooling_nwc_q8(
+      x.channels,
+      127, 0.5f,
+      127, 0.5f,
+      0, 255,
+      0 /* flags */,
+      &op);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_setup_global_average_pooling_nwc_q8(
+      op,
+      1, x.height * x.width,
+      x.data, x.pixelStride,
+      y.data, y.pixelStride,
+      threadpool_);
+    assert(status == qnnp_status_success);
+    addLayer(name, op);
+    return y;
+  }
+
+  Tensor channelShuffle(const char* name, const Tensor& x, size_t groups) {
+    Tensor y = tensor(x.height, x.width, x.channels);
+
+    qnnp_operator_t op = nullptr;
+    qnnp_status status = qnnp_create_channel_shuffle_nc_x8(
+      groups, x.channels / groups,
+      0 /* flags */,
+      &op);
+    assert(status == qnnp_status_success);
+
+    status = qnnp_setup_channel_shuffle_nc_x8(
+      op, x.height * x.width,
+      x.data, x.pixelStride,
+      y.data, y.pixelStride,
+      threadpool_);
+    assert(status == qnnp_status_success);
+    addLayer(name, op);
+    return y;
+  }
+
+  /* Runs all layers in order, and adds the time of every layer to its total */
+  void run() {
+    for (size_t i = 0; i < operators_.size(); i++) {
+      const auto start = std::chrono::high_resolution_clock::now();
+      const qnnp_status status = qnnp_run_operator(operators_[i], threadpool_);
+      const auto end = std::chrono::high_resolution_clock::now();
+      assert(status == qnnp_status_success);
+      (void) status;
+      layerSeconds_[i] += std::chrono::duration<double>(end - start).count();
+    }
+  }
+
+  /* Average time of every layer per run, as counters in microseconds named by layer index and name */
+  void reportLayers(benchmark::State& state) const {
+    for (size_t i = 0; i < layerNames_.size(); i++) {
+      char counterName[64];
+      snprintf(counterName, sizeof(counterName), "%03zu:%s[us]", i, layerNames_[i].c_str());
+      state.counters[counterName] = benchmark::Counter(layerSeconds_[i] * 1.0e+6, benchmark::Counter::kAvgIterations);
+    }
+  }
+
+ private:
+  void addLayer(const char* name, qnnp_operator_t op) {
+    operators_.push_back(op);
+    layerNames_.push_back(name);
+    layerSeconds_.push_back(0.0);
+  }
+
+  std::vector<uint8_t> randomKernel(size_t size) {
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), std::ref(rng_));
+    std::vector<uint8_t> kernel(size);
+    std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+    return kernel;
+  }
+
+  std::vector<int32_t> randomBias(size_t size) {
+    auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), std::ref(rng_));
+    std::vector<int32_t> bias(size);
+    std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+    return bias;
+  }
+
+  pthreadpool_t threadpool_;
+  std::mt19937 rng_;
+  std::vector<std::vector<uint8_t>> buffers_;
+  std::vector<qnnp_operator_t> operators_;
+  std::vector<std::string> layerNames_;
+  std::vector<double> layerSeconds_;
+};
+
+static void MobileNetV1(Network& network) {
+  static const struct { size_t channels; uint32_t stride; } blocks[] = {
+    {  64, 1 }, { 128, 2 }, { 128, 1 }, { 256, 2 }, { 256, 1 }, { 512, 2 }, { 512, 1 },
+    { 512, 1 }, { 512, 1 }, { 512, 1 }, { 512, 1 }, { 1024, 2 }, { 1024, 1 },
+  };
+
+  Network::Tensor x = network.input(224, 224, 3);
+  x = network.convolution("conv", x, 3, 2, 1, 1, 32);
+  for (const auto& block : blocks) {
+    x = network.convolution("dwconv", x, 3, block.stride, 1, x.channels, x.channels);
+    x = network.convolution("pwconv", x, 1, 1, 0, 1, block.channels);
+  }
+  x = network.globalAveragePooling("avgpool", x);
+  network.fullyConnected("fc", x, 1000);
+}
+
+static void MobileNetV2(Network& network) {
+  /* Expansion factor, output channels, number of blocks, and stride of the first block */
+  static const struct { size_t expansion; size_t channels; size_t blocks; uint32_t stride; } bottlenecks[] = {
+    { 1,  16, 1, 1 },
+    { 6,  24, 2, 2 },
+    { 6,  32, 3, 2 },
+    { 6,  64, 4, 2 },
+    { 6,  96, 3, 1 },
+    { 6, 160, 3, 2 },
+    { 6, 320, 1, 1 },
+  };
+
+  Network::Tensor x = network.input(224, 224, 3);
+  x = network.convolution("conv", x, 3, 2, 1, 1, 32);
+  for (const auto& bottleneck : bottlenecks) {
+    for (size_t i = 0; i < bottleneck.blocks; i++) {
+      const uint32_t stride = i == 0 ? bottleneck.stride : 1;
+      const size_t expandedChannels = x.channels * bottleneck.expansion;
+      Network::Tensor y = x;
+      if (bottleneck.expansion != 1) {
+        y = network.convolution("expand", y, 1, 1, 0, 1, expandedChannels);
+      }
+      y = network.convolution("dwconv", y, 3, stride, 1, expandedChannels, expandedChannels);
+      y = network.convolution("project", y, 1, 1, 0, 1, bottleneck.channels);
+      if (stride == 1 && x.channels == bottleneck.channels) {
+        y = network.add("add", x, y);
+      }
+      x = y;
+    }
+  }
+  x = network.convolution("conv", x, 1, 1, 0, 1, 1280);
+  x = network.globalAveragePooling("avgpool", x);
+  network.fullyConnected("fc", x, 1000);
+}
+
+/* ShuffleNet v1 units with the given number of groups and output channels of stage 2 */
+static void ShuffleNetV1(Network& network, size_t groups, size_t stage2Channels) {
+  Network::Tensor x = network.input(224, 224, 3);
+  x = network.convolution("conv", x, 3, 2, 1, 1, 24);
+  x = network.maxPooling("maxpool", x, 3, 2);
+  const size_t stageUnits[3] = { 4, 8, 4 };
+  for (size_t stage = 0; stage < 3; stage++) {
+    const size_t channels = stage2Channels << stage;
+    for (size_t unit = 0; unit < stageUnits[stage]; unit++) {
+      if (unit == 0) {
+        /* The average-pooled input is concatenated with the output of the unit */
+        const size_t unitChannels = channels - x.channels;
+        const size_t bottleneckChannels = unitChannels / 4 / groups * groups;
+        Network::Tensor y = network.tensor((x.height - 1) / 2 + 1, (x.width - 1) / 2 + 1, channels);
+        network.averagePooling("avgpool", x, 3, 2, 1, Network::slice(y, 0, x.channels));
+        Network::Tensor z = network.convolution("gconv", x, 1, 1, 0, groups, bottleneckChannels);
+        if (groups != 1) {
+          z = network.channelShuffle("shuffle", z, groups);
+        }
+        z = network.convolution("dwconv", z, 3, 2, 1, bottleneckChannels, bottleneckChannels);
+        network.convolution("gconv", z, 1, 1, 0, groups, Network::slice(y, x.channels, unitChannels));
+        x = y;
+      } else {
+        const size_t bottleneckChannels = channels / 4;
+        Network::Tensor z = network.convolution("gconv", x, 1, 1, 0, groups, bottleneckChannels);
+        if (groups != 1) {
+          z = network.channelShuffle("shuffle", z, groups);
+        }
+        z = network.convolution("dwconv", z, 3, 1, 1, bottleneckChannels, bottleneckChannels);
+        z = network.convolution("gconv", z, 1, 1, 0, groups, channels);
+        x = network.add("add", x, z);
+      }
+    }
+  }
+  x = network.globalAveragePooling("avgpool", x);
+  network.fullyConnected("fc", x, 1000);
+}
+
+static void ShuffleNetV1G1(Network& network) {
+  ShuffleNetV1(network, 1, 144);
+}
+
+static void ShuffleNetV1G2(Network& network) {
+  ShuffleNetV1(network, 2, 200);
+}
+
+static void ShuffleNetV1G3(Network& network) {
+  ShuffleNetV1(network, 3, 240);
+}
+
+static void ShuffleNetV1G4(Network& network) {
+  ShuffleNetV1(network, 4, 272);
+}
+
+static void ShuffleNetV1G8(Network& network) {
+  ShuffleNetV1(network, 8, 384);
+}
+
+/* Fire module: 1x1 squeeze convolution, and 1x1 and 3x3 expand convolutions into halves of the output */
+static Network::Tensor Fire(Network& network, const Network::Tensor& x, size_t squeezeChannels, size_t expandChannels) {
+  Network::Tensor s = network.convolution("squeeze", x, 1, 1, 0, 1, squeezeChannels);
+  Network::Tensor y = network.tensor(x.height, x.width, 2 * expandChannels);
+  network.convolution("expand1x1", s, 1, 1, 0, 1, Network::slice(y, 0, expandChannels));
+  network.convolution("expand3x3", s, 3, 1, 1, 1, Network::slice(y, expandChannels, expandChannels));
+  return y;
+}
+
+static void SqueezeNetV10(Network& network) {
+  Network::Tensor x = network.input(224, 224, 3);
+  x = network.convolution("conv1", x, 7, 2, 0, 1, 96);
+  x = network.maxPooling("maxpool1", x, 3, 2);
+  x = Fire(network, x, 16, 64);
+  x = Fire(network, x, 16, 64);
+  x = Fire(network, x, 32, 128);
+  x = network.maxPooling("maxpool4", x, 3, 2);
+  x = Fire(network, x, 32, 128);
+  x = Fire(network, x, 48, 192);
+  x = Fire(network, x, 48, 192);
+  x = Fire(network, x, 64, 256);
+  x = network.maxPooling("maxpool8", x, 3, 2);
+  x = Fire(network, x, 64, 256);
+  x = network.convolution("conv10", x, 1, 1, 0, 1, 1000);
+  network.globalAveragePooling("avgpool", x);
+}
+
+static void SqueezeNetV11(Network& network) {
+  Network::Tensor x = network.input(224, 224, 3);
+  x = network.convolution("conv1", x, 3, 2, 0, 1, 64);
+  x = network.maxPooling("maxpool1", x, 3, 2);
+  x = Fire(network, x, 16, 64);
+  x = Fire(network, x, 16, 64);
+  x = network.maxPooling("maxpool3", x, 3, 2);
+  x = Fire(network, x, 32, 128);
+  x = Fire(network, x, 32, 128);
+  x = network.maxPooling("maxpool5", x, 3, 2);
+  x = Fire(network, x, 48, 192);
+  x = Fire(network, x, 48, 192);
+  x = Fire(network, x, 64, 256);
+  x = Fire(network, x, 64, 256);
+  x = network.convolution("conv10", x, 1, 1, 0, 1, 1000);
+  network.globalAveragePooling("avgpool", x);
+}
+
+/* VGG-16 */
+static void VGG(Network& network) {
+  static const struct { size_t channels; size_t convolutions; } stages[] = {
+    { 64, 2 }, { 128, 2 }, { 256, 3 }, { 512, 3 }, { 512, 3 },
+  };
+
+  Network::Tensor x = network.input(224, 224, 3);
+  for (const auto& stage : stages) {
+    for (size_t i = 0; i < stage.convolutions; i++) {
+      x = network.convolution("conv", x, 3, 1, 1, 1, stage.channels);
+    }
+    x = network.maxPooling("maxpool", x, 2, 2);
+  }
+  x = network.fullyConnected("fc6", x, 4096);
+  x = network.fullyConnected("fc7", x, 4096);
+  network.fullyConnected("fc8", x, 1000);
+}
+
+/* Writes a buffer of twice the last level cache (at most 256 MB), evicting activations and packed weights */
+static void flushCaches(std::vector<uint8_t>& buffer, size_t iteration) {
+  if (buffer.empty()) {
+    size_t llcSize = cpuinfo_get_l1d_cache(0)->size;
+    if (cpuinfo_get_l2_cache(0) != nullptr) {
+      llcSize = cpuinfo_get_l2_cache(0)->size;
+    }
+    if (cpuinfo_get_l3_caches_count() != 0) {
+      llcSize = cpuinfo_get_l3_cache(0)->size;
+    }
+    buffer.resize(std::min<size_t>(2 * llcSize, 256 << 20));
+  }
+  memset(buffer.data(), int(iteration & 0xFF), buffer.size());
+  benchmark::DoNotOptimize(buffer.data());
+  benchmark::ClobberMemory();
+}
+
+/*
+ * Runs the whole network on T threads, with caches flushed before every iteration if cold is non-zero. The time of
+ * the run is the total latency; a counter per layer holds its latency.
+ */
+static void Q8Network(benchmark::State& state, void (*build)(Network&)) {
+  const size_t threads = state.range(0);
+  const bool cold = state.range(1) != 0;
+  qnnp_status status = qnnp_initialize();
+  assert(status == qnnp_status_success);
+  (void) status;
+
+  pthreadpool_t threadpool = pthreadpool_create(threads);
+  {
+    Network network(threadpool);
+    build(network);
+
+    std::vector<uint8_t> flushBuffer;
+    size_t iteration = 0;
+    for (auto _ : state) {
+      if (cold) {
+        state.PauseTiming();
+        flushCaches(flushBuffer, iteration++);
+        state.ResumeTiming();
+      }
+      network.run();
+    }
+    network.reportLayers(state);
+  }
+  pthreadpool_destroy(threadpool);
+}
+
+/* Thread counts from 1 to the number of processors in powers of 2, with warm and cold caches */
+static void NetworkThreads(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"T", "cold"});
+  b->UseRealTime();
+  b->Unit(benchmark::kMillisecond);
+
+  cpuinfo_initialize();
+  const size_t maxThreads = cpuinfo_get_processors_count();
+  for (int64_t cold = 0; cold <= 1; cold++) {
+    size_t threads = 1;
+    for (; threads < maxThreads; threads *= 2) {
+      b->Args({int64_t(threads), cold});
+    }
+    b->Args({int64_t(maxThreads), cold});
+  }
+}
+
+BENCHMARK_CAPTURE(Q8Network, mobilenet_v1, MobileNetV1)->Apply(NetworkThreads);
+BENCHMARK_CAPTURE(Q8Network, mobilenet_v2, MobileNetV2)->Apply(NetworkThreads);
+BENCHMARK_CAPTURE(Q8Network, shufflenet_v1_g1, ShuffleNetV1G1)->Apply(NetworkThreads);
+BENCHMARK_CAPTURE(Q8Network, shufflenet_v1_g2, ShuffleNetV1G2)->Apply(NetworkThreads);
+BENCHMARK_CAPTURE(Q8Network, shufflenet_v1_g3, ShuffleNetV1G3)->Apply(NetworkThreads);
+BENCHMARK_CAPTURE(Q8Network, shufflenet_v1_g4, ShuffleNetV1G4)->Apply(NetworkThreads);
+BENCHMARK_CAPTURE(Q8Network, shufflenet_v1_g8, ShuffleNetV1G8)->Apply(NetworkThreads);
+BENCHMARK_CAPTURE(Q8Network, squeezenet_v10, SqueezeNetV10)->Apply(NetworkThreads);
+BENCHMARK_CAPTURE(Q8Network, squeezenet_v11, SqueezeNetV11)->Apply(NetworkThreads);
+BENCHMARK_CAPTURE(Q8Network, vgg, VGG)->Apply(NetworkThreads);
+
+#ifndef QNNPACK_BENCHMARK_NO_MAIN
+BENCHMARK_MAIN();
+#endif
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+
+/*
+ * Hardware counters of the calling thread from Linux perf events, enabled with the QNNPACK_BENCHMARK_PERF_COUNTERS
+ * environment variable, and a roofline summary from the work of the benchmark.
+ *
+ * Counters are cycles, instructions, L1 data cache read misses, and last level cache read misses, which is the level
+ * generic perf events name after L1 (L2 on most mobile processors). If the kernel does not allow perf events, e.g.
+ * with perf_event_paranoid above 2, or on other systems, only the roofline counters without cycles are reported.
+ *
+ * The roofline summary reports the arithmetic intensity (MACs per byte moved) and, with cycles, the MACs and bytes
+ * per cycle. QNNPACK_BENCHMARK_PEAK_MACS_PER_CYCLE and QNNPACK_BENCHMARK_PEAK_BYTES_PER_CYCLE give the peak of the
+ * processor, e.g. 32 MACs per cycle for 2 AVX2 multiply-adds of 16-bit pairs per cycle, for the fraction of peak and
+ * of the roofline bound min(peak MACs, intensity x peak bytes) that the kernel achieves.
+ */
+class PerfCounters {
+ public:
+  enum Counter {
+    kCycles,
+    kInstructions,
+    kL1DReadMisses,
+    kLLCReadMisses,
+    kCounters,
+  };
+
+  PerfCounters() {
+    for (int i = 0; i < kCounters; i++) {
+      fds_[i] = -1;
+    }
+#if defined(__linux__)
+    if (getenv("QNNPACK_BENCHMARK_PERF_COUNTERS") == nullptr) {
+      return;
+    }
+    const struct { uint32_t type; uint64_t config; } events[kCounters] = {
+      { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+      { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+      {
+        PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+      },
+      {
+        PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+      },
+    };
+    for (int i = 0; i < kCounters; i++) {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = events[i].type;
+      attr.config = events[i].config;
+      attr.disabled = i == 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      /* Processors without an event, e.g. LLC misses on some ARM cores, leave its counter closed */
+      fds_[i] = int(syscall(__NR_perf_event_open, &attr, 0 /* calling thread */, -1 /* any CPU */, fds_[0], 0));
+      if (i == 0 && fds_[0] < 0) {
+        return;
+      }
+    }
+#endif
+  }
+
+  ~PerfCounters() {
+#if defined(__linux__)
+    for (int i = 0; i < kCounters; i++) {
+      if (fds_[i] >= 0) {
+        close(fds_[i]);
+      }
+    }
+#endif
+  }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  void start() {
+#if defined(__linux__)
+    if (fds_[0] >= 0) {
+      ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  void stop() {
+    for (int i = 0; i < kCounters; i++) {
+      values_[i] = 0;
+      valid_[i] = false;
+    }
+#if defined(__linux__)
+    if (fds_[0] < 0) {
+      return;
+    }
+    ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    /* Number of events in the group, then their values in the order they were opened */
+    uint64_t group[1 + kCounters];
+    if (read(fds_[0], group, sizeof(group)) < ssize_t(sizeof(uint64_t))) {
+      return;
+    }
+    uint64_t value = 1;
+    for (int i = 0; i < kCounters; i++) {
+      if (fds_[i] >= 0 && value <= group[0]) {
+        values_[i] = group[value++];
+        valid_[i] = true;
+      }
+    }
+#endif
+  }
+
+  /* Reports counters per iteration since start, and the roofline of the given work per iteration */
+  void report(benchmark::State& state, uint64_t macs, uint64_t bytes) const {
+    const double iterations = double(state.iterations());
+    if (iterations == 0.0) {
+      return;
+    }
+    state.counters["MACs/B"] = double(macs) / double(bytes);
+
+    static const char* names[kCounters] = { "cycles", "instructions", "L1D-misses", "LLC-misses" };
+    for (int i = 0; i < kCounters; i++) {
+      if (valid_[i]) {
+        state.counters[names[i]] = double(values_[i]) / iterations;
+      }
+    }
+    if (!valid_[kCycles] || values_[kCycles] == 0) {
+      return;
+    }
+    const double cycles = double(values_[kCycles]) / iterations;
+    if (valid_[kInstructions]) {
+      state.counters["IPC"] = double(values_[kInstructions]) / double(values_[kCycles]);
+    }
+    const double macsPerCycle = double(macs) / cycles;
+    state.counters["MACs/cycle"] = macsPerCycle;
+    state.counters["B/cycle"] = double(bytes) / cycles;
+
+    const double peakMacsPerCycle = getEnvironmentDouble("QNNPACK_BENCHMARK_PEAK_MACS_PER_CYCLE");
+    if (peakMacsPerCycle > 0.0) {
+      state.counters["peak%"] = 100.0 * macsPerCycle / peakMacsPerCycle;
+      const double peakBytesPerCycle = getEnvironmentDouble("QNNPACK_BENCHMARK_PEAK_BYTES_PER_CYCLE");
+      if (peakBytesPerCycle > 0.0) {
+        const double intensity = double(macs) / double(bytes);
+        const double bound = intensity * peakBytesPerCycle < peakMacsPerCycle ?
+          intensity * peakBytesPerCycle : peakMacsPerCycle;
+        state.counters["roofline%"] = 100.0 * macsPerCycle / bound;
+      }
+    }
+  }
+
+ private:
+  static double getEnvironmentDouble(const char* name) {
+    const char* value = getenv(name);
+    return value != nullptr ? atof(value) : 0.0;
+  }
+
+  int fds_[kCounters];
+  uint64_t values_[kCounters]{};
+  bool valid_[kCounters]{};
+};
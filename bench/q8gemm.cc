@@ -16,6 +16,7 @@
 #include <vector>
 
 #include <cpuinfo.h>
+#include <qnnpack.h>
 #include <qnnpack/AlignedAllocator.h>
 #include <qnnpack/q8gemm.h>
 #include <qnnpack/params.h>
@@ -23,6 +24,9 @@
 
 #include <benchmark/benchmark.h>
 
+#include "perf-counters.h"
+#include "thread-scaling.h"
+
 #if QNNPACK_BENCHMARK_GEMMLOWP
 #include <gemmlowp/public/gemmlowp.h>
 #endif
@@ -96,16 +100,25 @@ class Q8GEMM : public benchmark::Fixture {
     std::fill(c_.begin(), c_.end(), 0xA5);
 
     requantizationParams_ = qnnp_compute_requantization_params(0.75f, 0x33, 1, 254);
+    perfCounters_.start();
   }
 
   virtual void TearDown(benchmark::State& state) override
   {
+    perfCounters_.stop();
+    perfCounters_.report(state, uint64_t(mc()) * nc() * kc(), bytesMoved());
     state.SetItemsProcessed(uint64_t(state.iterations()) * 2 * mc() * nc() * kc());
     a_.clear();
     b_.clear();
     c_.clear();
   }
 
+  /* Bytes of the operands and the result, each counted once, i.e. the least traffic of the GEMM */
+  virtual uint64_t bytesMoved() const
+  {
+    return uint64_t(mc()) * kc() + uint64_t(ncStride()) * kcStride() + nc() * sizeof(int32_t) + uint64_t(mc()) * nc();
+  }
+
   inline const uint8_t* a() const
   {
     return a_.data();
@@ -183,6 +196,7 @@ class Q8GEMM : public benchmark::Fixture {
   uint32_t nc_{nr_};
   uint32_t kc_{kr_};
   qnnp_q31_requantization_params requantizationParams_;
+  PerfCounters perfCounters_;
 };
 
 template <uint32_t MR, uint32_t NR, uint32_t KR>
@@ -235,10 +249,13 @@ class Q8GEMM_XZP : public Q8GEMM {
     std::fill(c_.begin(), c_.end(), 0xA5);
     as_.resize(roundUp(mc(), mr()));
     std::fill(as_.begin(), as_.end(), 0xFE01);
+    perfCounters_.start();
   }
 
   virtual void TearDown(benchmark::State& state) override
   {
+    perfCounters_.stop();
+    perfCounters_.report(state, uint64_t(mc()) * nc() * kc(), bytesMoved());
     state.SetItemsProcessed(uint64_t(state.iterations()) * 2 * mc() * nc() * kc());
     a_.clear();
     b_.clear();
@@ -251,6 +268,11 @@ class Q8GEMM_XZP : public Q8GEMM {
     return as_.data();
   }
 
+  virtual uint64_t bytesMoved() const override
+  {
+    return Q8GEMM::bytesMoved() + mc() * sizeof(int32_t);
+  }
+
  protected:
   std::vector<int32_t, AlignedAllocator<int32_t, 32>> as_;
 };
@@ -303,6 +325,9 @@ class COMPUTE_ROW_SUM_Op : public Q8GEMM_XZP {
 
   virtual void TearDown(benchmark::State& state) override
   {
+    perfCounters_.stop();
+    /* Row sums add every element of A once, and write a sum per row */
+    perfCounters_.report(state, uint64_t(mc()) * kc(), uint64_t(mc()) * kc() + mc() * sizeof(int32_t));
     state.SetItemsProcessed(uint64_t(state.iterations()) * (mc() * kc()));
     a_.clear();
     b_.clear();
@@ -682,6 +707,18 @@ BENCHMARK_REGISTER_F(Q8GEMM_Op, 8x8__aarch64_neon)->Apply(GemmArguments);
 #endif
 
 #if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+BENCHMARK_TEMPLATE_F(Q8GEMM_L1, 1x8__neon, 1, 8, 1)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    q8gemm_ukernel_1x8__neon(
+      mr(), nr(), kc(),
+      a(), kc() * sizeof(uint8_t),
+      b(), bias(),
+      c(), mr() * sizeof(uint8_t),
+      0x11, 0x22, requantizationParams());
+  }
+}
+
 BENCHMARK_TEMPLATE_F(Q8GEMM_L1, 4x8__neon, 4, 8, 1)(benchmark::State& state)
 {
   for (auto _ : state) {
@@ -824,6 +861,18 @@ BENCHMARK_TEMPLATE_F(Q8GEMM_L1, 2x4c8__sse2, 2, 4, 8)(benchmark::State& state)
   }
 }
 
+BENCHMARK_TEMPLATE_F(Q8GEMM_L1, 1x4c2__sse2, 1, 4, 2)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    q8gemm_ukernel_1x4c2__sse2(
+      mr(), nr(), kc(),
+      a(), kc() * sizeof(uint8_t),
+      b(), bias(),
+      c(), mr() * sizeof(uint8_t),
+      0x11, 0x22, requantizationParams());
+  }
+}
+
 BENCHMARK_TEMPLATE_F(Q8GEMM_L1, 4x4c2__sse2, 4, 4, 2)(benchmark::State& state)
 {
   for (auto _ : state) {
@@ -859,8 +908,163 @@ BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x4c2__sse2)->Apply(ShuffleNetV1G1GemmArguments)
 BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x4c2__sse2)->Apply(MobileNetV1GemmArguments);
 BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x4c2__sse2)->Apply(SqueezeNetV10GemmArguments);
 BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x4c2__sse2)->Apply(GemmArguments);
+
+BENCHMARK_TEMPLATE_F(Q8GEMM_L1, 1x8c2__avx2, 1, 8, 2)(benchmark::State& state)
+{
+  if (!cpuinfo_initialize() || !cpuinfo_has_x86_avx2()) {
+    state.SkipWithError("AVX2 is not supported");
+  }
+  for (auto _ : state) {
+    q8gemm_ukernel_1x8c2__avx2(
+      mr(), nr(), kc(),
+      a(), kc() * sizeof(uint8_t),
+      b(), bias(),
+      c(), mr() * sizeof(uint8_t),
+      0x11, 0x22, requantizationParams());
+  }
+}
+
+BENCHMARK_TEMPLATE_F(Q8GEMM_L1, 4x8c2__avx2, 4, 8, 2)(benchmark::State& state)
+{
+  if (!cpuinfo_initialize() || !cpuinfo_has_x86_avx2()) {
+    state.SkipWithError("AVX2 is not supported");
+  }
+  for (auto _ : state) {
+    q8gemm_ukernel_4x8c2__avx2(
+      mr(), nr(), kc(),
+      a(), kc() * sizeof(uint8_t),
+      b(), bias(),
+      c(), mr() * sizeof(uint8_t),
+      0x11, 0x22, requantizationParams());
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(Q8GEMM_Op, 4x8c2__avx2, 4, 8, 2)(benchmark::State& state)
+{
+  if (!cpuinfo_initialize() || !cpuinfo_has_x86_avx2()) {
+    state.SkipWithError("AVX2 is not supported");
+  }
+  for (auto _ : state) {
+    for (uint32_t m = 0; m < mc(); m += mr()) {
+      const uint32_t mrr = min(mc() - m, mr());
+      for (uint32_t n = 0; n < nc(); n += nr()) {
+        const uint32_t nrr = min(nc() - n, nr());
+        q8gemm_ukernel_4x8c2__avx2(
+          mrr, nrr, kc(),
+          a() + m * kc(), kc() * sizeof(uint8_t),
+          b() + n * kcStride(),
+          bias() + n,
+          c() + m * nc() + n, nc() * sizeof(uint8_t),
+          0x11, 0x22, requantizationParams());
+      }
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x8c2__avx2)->Apply(ShuffleNetV1G1GemmArguments);
+BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x8c2__avx2)->Apply(MobileNetV1GemmArguments);
+BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x8c2__avx2)->Apply(SqueezeNetV10GemmArguments);
+BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x8c2__avx2)->Apply(GemmArguments);
+
+BENCHMARK_TEMPLATE_F(Q8GEMM_L1, 4x8c4__avx512vnni, 4, 8, 4)(benchmark::State& state)
+{
+  if (!cpuinfo_initialize() || !(cpuinfo_has_x86_avx512vnni() && cpuinfo_has_x86_avx512vl())) {
+    state.SkipWithError("AVX512-VNNI is not supported");
+  }
+  for (auto _ : state) {
+    q8gemm_ukernel_4x8c4__avx512vnni(
+      mr(), nr(), kc(),
+      a(), kc() * sizeof(uint8_t),
+      b(), bias(),
+      c(), mr() * sizeof(uint8_t),
+      0x11, 0x22, requantizationParams());
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(Q8GEMM_Op, 4x8c4__avx512vnni, 4, 8, 4)(benchmark::State& state)
+{
+  if (!cpuinfo_initialize() || !(cpuinfo_has_x86_avx512vnni() && cpuinfo_has_x86_avx512vl())) {
+    state.SkipWithError("AVX512-VNNI is not supported");
+  }
+  for (auto _ : state) {
+    for (uint32_t m = 0; m < mc(); m += mr()) {
+      const uint32_t mrr = min(mc() - m, mr());
+      for (uint32_t n = 0; n < nc(); n += nr()) {
+        const uint32_t nrr = min(nc() - n, nr());
+        q8gemm_ukernel_4x8c4__avx512vnni(
+          mrr, nrr, kc(),
+          a() + m * kc(), kc() * sizeof(uint8_t),
+          b() + n * kcStride(),
+          bias() + n,
+          c() + m * nc() + n, nc() * sizeof(uint8_t),
+          0x11, 0x22, requantizationParams());
+      }
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x8c4__avx512vnni)->Apply(ShuffleNetV1G1GemmArguments);
+BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x8c4__avx512vnni)->Apply(MobileNetV1GemmArguments);
+BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x8c4__avx512vnni)->Apply(SqueezeNetV10GemmArguments);
+BENCHMARK_REGISTER_F(Q8GEMM_Op, 4x8c4__avx512vnni)->Apply(GemmArguments);
 #endif
 
+/* Operator-level Q8 GEMM as a fully-connected operator: M is the batch, K the input and N the output channels */
+static void fully_connected_q8(benchmark::State& state, size_t threads)
+{
+  const size_t mc = state.range(0);
+  const size_t nc = state.range(1);
+  const size_t kc = state.range(2);
+
+  const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+  auto rng = std::bind(std::uniform_int_distribution<uint8_t>(), std::mt19937(seed));
+  std::vector<uint8_t> input(mc * kc);
+  std::generate(input.begin(), input.end(), std::ref(rng));
+  std::vector<uint8_t> kernel(nc * kc);
+  std::generate(kernel.begin(), kernel.end(), std::ref(rng));
+  std::vector<int32_t> bias(nc);
+  std::generate(bias.begin(), bias.end(), std::ref(rng));
+  std::vector<uint8_t> output(mc * nc);
+
+  qnnp_status status = qnnp_initialize();
+  if (status != qnnp_status_success) {
+    state.SkipWithError("failed to initialize QNNPACK");
+    return;
+  }
+
+  qnnp_operator_t fullyConnected = nullptr;
+  status = qnnp_create_fully_connected_nc_q8(
+    kc, nc,
+    127, 0.5f,
+    127, 0.5f,
+    kernel.data(), bias.data(),
+    127, 0.5f, 0, 255,
+    0 /* flags */,
+    &fullyConnected);
+  if (status != qnnp_status_success) {
+    state.SkipWithError("failed to create fully-connected operator");
+    return;
+  }
+
+  runThreadScaling(state, threads,
+    [&](pthreadpool_t threadpool) {
+      qnnp_setup_fully_connected_nc_q8(
+        fullyConnected, mc, input.data(), kc, output.data(), nc, threadpool);
+    },
+    [&](pthreadpool_t threadpool) {
+      qnnp_run_operator(fullyConnected, threadpool);
+    });
+  qnnp_delete_operator(fullyConnected);
+
+  state.SetItemsProcessed(uint64_t(state.iterations()) * 2 * mc * nc * kc);
+}
+
+static bool fullyConnectedQ8Registered =
+  registerThreadScaling("fully_connected_q8/ShuffleNetV1G1", fully_connected_q8, ShuffleNetV1G1GemmArguments) &&
+  registerThreadScaling("fully_connected_q8/MobileNetV1", fully_connected_q8, MobileNetV1GemmArguments) &&
+  registerThreadScaling("fully_connected_q8/SqueezeNetV10", fully_connected_q8, SqueezeNetV10GemmArguments) &&
+  registerThreadScaling("fully_connected_q8/Gemm", fully_connected_q8, GemmArguments);
+
 #if QNNPACK_BENCHMARK_GEMMLOWP
 BENCHMARK_DEFINE_F(GEMMLOWP, single_threaded)(benchmark::State& state)
 {
@@ -38,17 +38,10 @@ inline uint32_t min(uint32_t a, uint32_t b)
 
 class Requantization : public benchmark::Fixture {
  public:
-  inline Requantization()
+  virtual void SetUp(const benchmark::State& state) override
   {
-    cpuinfo_initialize();
-    const size_t l1d_size = cpuinfo_get_l1d_cache(0)->size;
-    const size_t l1d_reserve = 1024;
-    n_ = (l1d_size - l1d_reserve) / (sizeof(int32_t) + sizeof(uint8_t));
-    n_ = n_ / 16 * 16;
-  }
+    n_ = state.range(0);
 
-  virtual void SetUp(const benchmark::State&) override
-  {
     const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
     auto rng = std::bind(std::uniform_int_distribution<int32_t>(), std::mt19937(seed));
 
@@ -60,8 +53,12 @@ class Requantization : public benchmark::Fixture {
 
   virtual void TearDown(benchmark::State& state) override
   {
-    state.SetItemsProcessed(uint64_t(state.iterations()) * n());
-    state.SetBytesProcessed(uint64_t(state.iterations()) * n() * (sizeof(int32_t) + sizeof(uint8_t)));
+    const uint64_t elements = uint64_t(state.iterations()) * n();
+    state.SetItemsProcessed(elements);
+    state.SetBytesProcessed(elements * (sizeof(int32_t) + sizeof(uint8_t)));
+    /* Elements divided by cycles at the nominal frequency: the rate of elements per second, over cycles per second */
+    state.counters["elements/cycle"] = benchmark::Counter(
+      double(elements) / benchmark::CPUInfo::Get().cycles_per_second, benchmark::Counter::kIsRate);
     input_.clear();
     output_.clear();
   }
@@ -87,184 +84,253 @@ class Requantization : public benchmark::Fixture {
   size_t n_;
 };
 
-BENCHMARK_F(Requantization, precise__scalar_unsigned32)(benchmark::State& state)
+/*
+ * Elements whose input and output fill the L1 data cache, as in a microkernel epilogue, and elements that fill four
+ * times the last level cache (at most 256 MB), so that requantization streams from and to memory
+ */
+static void RequantizationSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"n"});
+
+  cpuinfo_initialize();
+  const size_t l1d_size = cpuinfo_get_l1d_cache(0)->size;
+  const size_t l1d_reserve = 1024;
+  b->Arg((l1d_size - l1d_reserve) / (sizeof(int32_t) + sizeof(uint8_t)) / 16 * 16);
+
+  size_t llc_size = cpuinfo_get_l2_cache(0) != nullptr ? cpuinfo_get_l2_cache(0)->size : l1d_size;
+  if (cpuinfo_get_l3_caches_count() != 0) {
+    llc_size = cpuinfo_get_l3_cache(0)->size;
+  }
+  const size_t streaming_size = std::min<size_t>(4 * llc_size, 256 << 20);
+  b->Arg(streaming_size / (sizeof(int32_t) + sizeof(uint8_t)) / 16 * 16);
+}
+
+BENCHMARK_DEFINE_F(Requantization, precise__scalar_unsigned32)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_precise__scalar_unsigned32(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, precise__scalar_unsigned32)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, precise__scalar_unsigned64)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, precise__scalar_unsigned64)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_precise__scalar_unsigned64(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, precise__scalar_unsigned64)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, precise__scalar_signed64)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, precise__scalar_signed64)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_precise__scalar_signed64(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, precise__scalar_signed64)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, fp32__scalar_lrintf)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, fp32__scalar_lrintf)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_fp32__scalar_lrintf(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, fp32__scalar_lrintf)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, fp32__scalar_magic)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, fp32__scalar_magic)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_fp32__scalar_magic(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+  }
+}
+BENCHMARK_REGISTER_F(Requantization, fp32__scalar_magic)->Apply(RequantizationSizes);
+
+BENCHMARK_DEFINE_F(Requantization, q31__scalar)(benchmark::State& state)
+{
+  for (auto _ : state) {
+    qnnp_requantize_q31__scalar(
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, q31__scalar)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, gemmlowp__scalar)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, gemmlowp__scalar)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_gemmlowp__scalar(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, gemmlowp__scalar)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, precise__psimd)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, precise__psimd)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_precise__psimd(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, precise__psimd)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, fp32__psimd)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, fp32__psimd)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_fp32__psimd(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, fp32__psimd)->Apply(RequantizationSizes);
 
 #if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
-BENCHMARK_F(Requantization, precise__neon)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, precise__neon)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_precise__neon(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, precise__neon)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, fp32__neon)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, fp32__neon)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_fp32__neon(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, fp32__neon)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, q31__neon)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, q31__neon)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_q31__neon(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, q31__neon)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, gemmlowp__neon)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, gemmlowp__neon)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_gemmlowp__neon(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, gemmlowp__neon)->Apply(RequantizationSizes);
 #endif
 
 #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
-BENCHMARK_F(Requantization, precise__sse2)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, precise__sse2)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_precise__sse2(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, precise__sse2)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, precise__ssse3)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, precise__ssse3)(benchmark::State& state)
 {
+  if (!cpuinfo_initialize() || !cpuinfo_has_x86_ssse3()) {
+    state.SkipWithError("SSSE3 is not supported");
+  }
   for (auto _ : state) {
     qnnp_requantize_precise__ssse3(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, precise__ssse3)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, precise__sse4)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, precise__sse4)(benchmark::State& state)
 {
+  if (!cpuinfo_initialize() || !cpuinfo_has_x86_sse4_1()) {
+    state.SkipWithError("SSE4.1 is not supported");
+  }
   for (auto _ : state) {
     qnnp_requantize_precise__sse4(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, precise__sse4)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, fp32__sse2)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, fp32__sse2)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_fp32__sse2(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, fp32__sse2)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, q31__sse2)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, q31__sse2)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_q31__sse2(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, q31__sse2)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, q31__ssse3)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, q31__ssse3)(benchmark::State& state)
 {
+  if (!cpuinfo_initialize() || !cpuinfo_has_x86_ssse3()) {
+    state.SkipWithError("SSSE3 is not supported");
+  }
   for (auto _ : state) {
     qnnp_requantize_q31__ssse3(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, q31__ssse3)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, q31__sse4)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, q31__sse4)(benchmark::State& state)
 {
+  if (!cpuinfo_initialize() || !cpuinfo_has_x86_sse4_1()) {
+    state.SkipWithError("SSE4.1 is not supported");
+  }
   for (auto _ : state) {
     qnnp_requantize_q31__sse4(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, q31__sse4)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, gemmlowp__sse2)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, gemmlowp__sse2)(benchmark::State& state)
 {
   for (auto _ : state) {
     qnnp_requantize_gemmlowp__sse2(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, gemmlowp__sse2)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, gemmlowp__ssse3)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, gemmlowp__ssse3)(benchmark::State& state)
 {
+  if (!cpuinfo_initialize() || !cpuinfo_has_x86_ssse3()) {
+    state.SkipWithError("SSSE3 is not supported");
+  }
   for (auto _ : state) {
     qnnp_requantize_gemmlowp__ssse3(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, gemmlowp__ssse3)->Apply(RequantizationSizes);
 
-BENCHMARK_F(Requantization, gemmlowp__sse4)(benchmark::State& state)
+BENCHMARK_DEFINE_F(Requantization, gemmlowp__sse4)(benchmark::State& state)
 {
+  if (!cpuinfo_initialize() || !cpuinfo_has_x86_sse4_1()) {
+    state.SkipWithError("SSE4.1 is not supported");
+  }
   for (auto _ : state) {
     qnnp_requantize_gemmlowp__sse4(
-        n(), input(), 0x1.0p-12f /* scale */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
+        n(), input(), 0.000244140625f /* scale = 2**-12 */, 128 /* zero point */, 1 /* qmin */, 254 /* qmax */, output());
   }
 }
+BENCHMARK_REGISTER_F(Requantization, gemmlowp__sse4)->Apply(RequantizationSizes);
 #endif
 
 #ifndef QNNPACK_BENCHMARK_NO_MAIN
@@ -12,15 +12,19 @@
 #include <cmath>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <vector>
 
 #include <cpuinfo.h>
+#include <qnnpack.h>
 #include <qnnpack/AlignedAllocator.h>
 #include <qnnpack/sgemm.h>
 
 #include <benchmark/benchmark.h>
 
+#include "thread-scaling.h"
+
 inline uint32_t divideRoundUp(uint32_t x, uint32_t q)
 {
   return x / q + uint32_t(x % q != 0);
@@ -326,6 +330,60 @@ static void GemmArguments(benchmark::internal::Benchmark* b)
   }
 }
 
+/* Operator-level SGEMM as a fully-connected operator: M is the batch, K the input and N the output channels */
+static void fully_connected_f32(benchmark::State& state, size_t threads)
+{
+  const size_t mc = state.range(0);
+  const size_t nc = state.range(1);
+  const size_t kc = state.range(2);
+
+  const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+  auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
+  std::vector<float> input(mc * kc);
+  std::generate(input.begin(), input.end(), std::ref(rng));
+  std::vector<float> kernel(nc * kc);
+  std::generate(kernel.begin(), kernel.end(), std::ref(rng));
+  std::vector<float> bias(nc);
+  std::generate(bias.begin(), bias.end(), std::ref(rng));
+  std::vector<float> output(mc * nc);
+
+  qnnp_status status = qnnp_initialize();
+  if (status != qnnp_status_success) {
+    state.SkipWithError("failed to initialize QNNPACK");
+    return;
+  }
+
+  qnnp_operator_t fullyConnected = nullptr;
+  status = qnnp_create_fully_connected_nc_f32(
+    kc, nc,
+    kernel.data(), bias.data(),
+    -std::numeric_limits<float>::infinity(), +std::numeric_limits<float>::infinity(),
+    0 /* flags */,
+    &fullyConnected);
+  if (status != qnnp_status_success) {
+    state.SkipWithError("failed to create fully-connected operator");
+    return;
+  }
+
+  runThreadScaling(state, threads,
+    [&](pthreadpool_t threadpool) {
+      qnnp_setup_fully_connected_nc_f32(
+        fullyConnected, mc, input.data(), kc, output.data(), nc, threadpool);
+    },
+    [&](pthreadpool_t threadpool) {
+      qnnp_run_operator(fullyConnected, threadpool);
+    });
+  qnnp_delete_operator(fullyConnected);
+
+  state.SetItemsProcessed(uint64_t(state.iterations()) * 2 * mc * nc * kc);
+}
+
+static bool fullyConnectedF32Registered =
+  registerThreadScaling("fully_connected_f32/ShuffleNetV1G1", fully_connected_f32, ShuffleNetV1G1GemmArguments) &&
+  registerThreadScaling("fully_connected_f32/MobileNetV1", fully_connected_f32, MobileNetV1GemmArguments) &&
+  registerThreadScaling("fully_connected_f32/SqueezeNetV10", fully_connected_f32, SqueezeNetV10GemmArguments) &&
+  registerThreadScaling("fully_connected_f32/Gemm", fully_connected_f32, GemmArguments);
+
 #if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
 BENCHMARK_TEMPLATE_F(SGEMM_L1, 5x8__neon, 5, 8, 1)(benchmark::State& state)
 {
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <cpuinfo.h>
+#include <pthreadpool.h>
+
+#include <benchmark/benchmark.h>
+
+
+/*
+ * Thread scaling of operators over the shape tables of the microkernel benchmarks. Each benchmark is registered as
+ * <name>/T:<threads> for 1, 2, 4, 8, and as many threads as processors, skipping counts above the processors, which
+ * only measure oversubscription. Besides the time with the thread pool, each run measures the operator without a
+ * thread pool and reports the speedup over it and the parallel efficiency, speedup / threads. Efficiency lost at small
+ * shapes is dispatch overhead of the pool; efficiency lost at large shapes is imbalance of the work partition, or
+ * bandwidth of the shared caches and memory.
+ */
+inline std::vector<size_t> threadScalingCounts()
+{
+  cpuinfo_initialize();
+  const size_t processors = std::max<size_t>(cpuinfo_get_processors_count(), 1);
+
+  std::vector<size_t> counts;
+  for (size_t threads = 1; threads <= 8 && threads <= processors; threads *= 2) {
+    counts.push_back(threads);
+  }
+  if (counts.back() != processors) {
+    counts.push_back(processors);
+  }
+  return counts;
+}
+
+/* Registers function(state, threads) for each thread count with the arguments of a shape table */
+inline bool registerThreadScaling(
+  const char* name,
+  void (*function)(benchmark::State&, size_t),
+  void (*arguments)(benchmark::internal::Benchmark*))
+{
+  for (size_t threads : threadScalingCounts()) {
+    const std::string benchmarkName = std::string(name) + "/T:" + std::to_string(threads);
+    benchmark::RegisterBenchmark(benchmarkName.c_str(), function, threads)->Apply(arguments)->UseRealTime();
+  }
+  return true;
+}
+
+/*
+ * Runs the benchmark loop of an operator on a pool of the given threads. setup(threadpool) sets the operator up for a
+ * thread pool, or for none with nullptr, and run(threadpool) runs it. The operator is set up again for the serial
+ * baseline, as setup may partition the work by the number of threads.
+ */
+template <class Setup, class Run>
+inline void runThreadScaling(benchmark::State& state, size_t threads, Setup setup, Run run)
+{
+  typedef std::chrono::steady_clock Clock;
+
+  /* Serial baseline, repeated for at least 50 ms to keep the timing noise of small shapes down */
+  setup(nullptr);
+  run(nullptr);
+  size_t serialRuns = 0;
+  const Clock::time_point serialStart = Clock::now();
+  std::chrono::duration<double> serialTime;
+  do {
+    run(nullptr);
+    serialRuns++;
+    serialTime = Clock::now() - serialStart;
+  } while (serialTime.count() < 0.05);
+
+  pthreadpool_t threadpool = pthreadpool_create(threads);
+  setup(threadpool);
+  run(threadpool);
+  const Clock::time_point parallelStart = Clock::now();
+  for (auto _ : state) {
+    run(threadpool);
+  }
+  const std::chrono::duration<double> parallelTime = Clock::now() - parallelStart;
+  pthreadpool_destroy(threadpool);
+
+  if (state.iterations() != 0) {
+    const double speedup =
+      (serialTime.count() / double(serialRuns)) / (parallelTime.count() / double(state.iterations()));
+    state.counters["speedup"] = speedup;
+    state.counters["efficiency"] = speedup / double(threads);
+  }
+}
@@ -63,27 +63,89 @@ def main(args):
 
         qnnpack_objects = [
             build.cc("init.c"),
+            build.cc("add.c"),
+            build.cc("affinity-pool.c"),
+            build.cc("allocator.c"),
+            build.cc("argmax.c"),
+            build.cc("average-pooling.c"),
+            build.cc("batcher.c"),
+            build.cc("channel-shuffle.c"),
+            build.cc("concat.c"),
             build.cc("convolution.c"),
             build.cc("deconvolution.c"),
+            build.cc("dequantize.c"),
+            build.cc("embedding-bag.c"),
             build.cc("fully-connected.c"),
+            build.cc("global-average-pooling.c"),
+            build.cc("inverted-residual.c"),
+            build.cc("lstm-cell.c"),
+            build.cc("max-pooling.c"),
+            build.cc("operator-info.c"),
+            build.cc("packed-weights.c"),
+            build.cc("plan.c"),
+            build.cc("profiling.c"),
+            build.cc("quantize.c"),
+            build.cc("queue.c"),
+            build.cc("requantize.c"),
+            build.cc("resize.c"),
+            build.cc("run-operators.c"),
+            build.cc("scheduler.c"),
+            build.cc("serialization.c"),
+            build.cc("setup-cache.c"),
+            build.cc("softmax.c"),
+        ]
+
+        qnnpack_objects += [
+            build.cc("u8lut32norm/scalar.c"),
+            build.cc("x8lut/scalar.c"),
         ]
 
         with build.options(isa=arm.neon if build.target.is_arm else None):
             qnnpack_objects += [
+                build.cc("sconv/6x8-psimd.c"),
                 build.cc("sgemm/6x8-psimd.c"),
             ]
 
         with build.options(isa=arm.neon if build.target.is_arm else None):
             if build.target.is_arm or build.target.is_arm64:
                 qnnpack_objects += [
+                    build.cc("q8gemm/1x8-acc32-neon.c"),
+                    build.cc("q8gemm/1x8-neon.c"),
+                    build.cc("q8gemm/1x8c2-4bit-neon.c"),
                     build.cc("q8gemm/4x8-neon.c"),
+                    build.cc("q8gemm/4x8-folded-neon.c"),
+                    build.cc("q8gemm/4x8-acc16-neon.c"),
+                    build.cc("q8gemm/4x8-fp32-neon.c"),
+                    build.cc("q8gemm/4x4c1x4-sparse-neon.c"),
+                    build.cc("q8gemm/4x8c2-4bit-neon.c"),
                     build.cc("q8gemm/4x-sumrows-neon.c"),
                     build.cc("q8gemm/4x8c2-xzp-neon.c"),
                     build.cc("q8gemm/8x8-neon.c"),
+                    build.cc("q8gemm/8x8-acc16-neon.c"),
                     build.cc("q8gemm/6x4-neon.c"),
                     build.cc("q8conv/4x8-neon.c"),
+                    build.cc("q8conv/4x8-folded-neon.c"),
+                    build.cc("q8conv/4x8-xzp-neon.c"),
+                    build.cc("q8conv/4x-sumrows-neon.c"),
+                    build.cc("q8conv/4x8-fp32-neon.c"),
+                    build.cc("q8conv/4x8-perchannel-neon.c"),
                     build.cc("q8conv/8x8-neon.c"),
                     build.cc("q8dw/9c8-neon.c"),
+                    build.cc("q8dw/25c8-neon.c"),
+                    build.cc("q8avgpool/8x-neon.c"),
+                    build.cc("q8gavgpool/8x-neon.c"),
+                    build.cc("q8vadd/neon.c"),
+                    build.cc("q8vrescale/neon.c"),
+                    build.cc("q8vquantize/neon.c"),
+                    build.cc("q8vdequantize/neon.c"),
+                    build.cc("q8embedding/neon.c"),
+                    build.cc("u8bilinear/neon.c"),
+                    build.cc("u8maxpool/8x-neon.c"),
+                    build.cc("u8rmax/neon.c"),
+                    build.cc("x8zip/x2-neon.c"),
+                    build.cc("x8zip/x3-neon.c"),
+                    build.cc("x8zip/x4-neon.c"),
+                    build.cc("x8zip/xm-neon.c"),
                     build.cc("sgemm/5x8-neon.c"),
                     build.cc("sgemm/6x8-neon.c"),
                 ]
@@ -98,15 +160,106 @@ def main(args):
                 qnnpack_objects += [
                     build.cc("q8gemm/8x8-aarch64-neon.S"),
                     build.cc("q8conv/8x8-aarch64-neon.S"),
+                    build.cc("q8gemm/4x8c4-neondot.c"),
+                    build.cc("q8conv/4x8c4-neondot.c"),
+                ]
+            if build.target.is_arm or build.target.is_arm64:
+                qnnpack_objects += [
+                    build.cc("hconv/8x8-neonfp16arith.c"),
+                    build.cc("hgemm/8x8-neonfp16arith.c"),
                 ]
             if build.target.is_x86 or build.target.is_x86_64:
                 with build.options(isa=x86.sse2):
                     qnnpack_objects += [
+                        build.cc("q8gemm/1x4c2-acc32-sse2.c"),
+                        build.cc("q8gemm/1x4c2-sse2.c"),
+                        build.cc("q8gemm/1x4c2-4bit-sse2.c"),
                         build.cc("q8gemm/2x4c8-sse2.c"),
                         build.cc("q8gemm/4x4c2-sse2.c"),
+                        build.cc("q8gemm/4x4c2-folded-sse2.c"),
+                        build.cc("q8gemm/4x4c2-fp32-sse2.c"),
+                        build.cc("q8gemm/4x4c1x4-sparse-sse2.c"),
+                        build.cc("q8gemm/4x4c2-4bit-sse2.c"),
                         build.cc("q8conv/4x4c2-sse2.c"),
+                        build.cc("q8conv/4x4c2-folded-sse2.c"),
+                        build.cc("q8conv/4x4c2-xzp-sse2.c"),
+                        build.cc("q8conv/4x-sumrows-sse2.c"),
+                        build.cc("q8conv/4x4c2-fp32-sse2.c"),
+                        build.cc("q8conv/4x4c2-perchannel-sse2.c"),
                         build.cc("q8dw/9c8-sse2.c"),
+                        build.cc("q8dw/25c8-sse2.c"),
+                        build.cc("q8dw/9c8-multiplier-sse2.c"),
+                        build.cc("q8dw/25c8-multiplier-sse2.c"),
+                        build.cc("q8avgpool/8x-sse2.c"),
+                        build.cc("q8gavgpool/8x-sse2.c"),
+                        build.cc("q8vadd/sse2.c"),
+                        build.cc("q8vrescale/sse2.c"),
+                        build.cc("q8vquantize/sse2.c"),
+                        build.cc("q8vdequantize/sse2.c"),
+                        build.cc("q8embedding/sse2.c"),
+                        build.cc("u8bilinear/sse2.c"),
+                        build.cc("u8maxpool/8x-sse2.c"),
+                        build.cc("u8rmax/sse2.c"),
+                        build.cc("x8zip/x2-sse2.c"),
+                        build.cc("x8zip/x3-sse2.c"),
+                        build.cc("x8zip/x4-sse2.c"),
+                        build.cc("x8zip/xm-sse2.c"),
                     ]
+                with build.options(isa=x86.avx2):
+                    qnnpack_objects += [
+                        build.cc("q8gemm/1x8c2-acc32-avx2.c"),
+                        build.cc("q8gemm/1x8c2-avx2.c"),
+                        build.cc("q8gemm/4x8c2-avx2.c"),
+                        build.cc("q8conv/4x8c2-avx2.c"),
+                        build.cc("q8gemm/4x8c2-signed-avx2.c"),
+                        build.cc("q8conv/4x8c2-signed-avx2.c"),
+                        build.cc("q8gemm/4x8c2-folded-avx2.c"),
+                        build.cc("q8conv/4x8c2-folded-avx2.c"),
+                        build.cc("q8conv/4x8c2-xzp-avx2.c"),
+                        build.cc("q8dw/9c16-avx2.c"),
+                        build.cc("q8dw/9c16-multiplier-avx2.c"),
+                    ]
+                with build.options(isa=x86.avx512f + x86.avx512vl + x86.avx512vnni):
+                    qnnpack_objects += [
+                        build.cc("q8gemm/1x8c4-acc32-avx512vnni.c"),
+                        build.cc("q8gemm/1x8c4-avx512vnni.c"),
+                        build.cc("q8gemm/4x8c4-avx512vnni.c"),
+                        build.cc("q8conv/4x8c4-avx512vnni.c"),
+                        build.cc("q8gemm/4x8c4-folded-avx512vnni.c"),
+                        build.cc("q8conv/4x8c4-folded-avx512vnni.c"),
+                        build.cc("q8gemm/4x8c4-signed-avx512vnni.c"),
+                        build.cc("q8conv/4x8c4-signed-avx512vnni.c"),
+                    ]
+            if not (build.target.is_arm or build.target.is_arm64 or build.target.is_x86 or build.target.is_x86_64):
+                # confu has no RISC-V Vector ISA option, so RVV microkernels are only built with CMake
+                qnnpack_objects += [
+                    build.cc("q8avgpool/1x-scalar.c"),
+                    build.cc("q8conv/4x8-folded-psimd.c"),
+                    build.cc("q8conv/4x8-fp32-psimd.c"),
+                    build.cc("q8conv/4x8-perchannel-psimd.c"),
+                    build.cc("q8conv/4x8-psimd.c"),
+                    build.cc("q8dw/9c8-psimd.c"),
+                    build.cc("q8dw/25c8-psimd.c"),
+                    build.cc("q8dw/9c8-multiplier-psimd.c"),
+                    build.cc("q8dw/25c8-multiplier-psimd.c"),
+                    build.cc("q8embedding/scalar.c"),
+                    build.cc("q8gavgpool/1x-scalar.c"),
+                    build.cc("q8gemm/1x8-acc32-psimd.c"),
+                    build.cc("q8gemm/4x8-folded-psimd.c"),
+                    build.cc("q8gemm/4x8-fp32-psimd.c"),
+                    build.cc("q8gemm/4x8-psimd.c"),
+                    build.cc("q8vadd/scalar.c"),
+                    build.cc("q8vdequantize/scalar.c"),
+                    build.cc("q8vquantize/scalar.c"),
+                    build.cc("q8vrescale/scalar.c"),
+                    build.cc("u8bilinear/scalar.c"),
+                    build.cc("u8maxpool/1x-scalar.c"),
+                    build.cc("u8rmax/scalar.c"),
+                    build.cc("x8zip/x2-scalar.c"),
+                    build.cc("x8zip/x3-scalar.c"),
+                    build.cc("x8zip/x4-scalar.c"),
+                    build.cc("x8zip/xm-scalar.c"),
+                ]
             build.static_library("qnnpack", qnnpack_objects)
 
 
@@ -119,11 +272,44 @@ def main(args):
         build.unittest("q8gemm-test", build.cxx("q8gemm.cc"))
         build.unittest("q8conv-test", build.cxx("q8conv.cc"))
         build.unittest("q8dw-test", build.cxx("q8dw.cc"))
+        build.unittest("q8avgpool-test", build.cxx("q8avgpool.cc"))
+        build.unittest("q8gavgpool-test", build.cxx("q8gavgpool.cc"))
+        build.unittest("q8vadd-test", build.cxx("q8vadd.cc"))
+        build.unittest("q8vrescale-test", build.cxx("q8vrescale.cc"))
+        build.unittest("u8maxpool-test", build.cxx("u8maxpool.cc"))
+        build.unittest("u8rmax-test", build.cxx("u8rmax.cc"))
+        build.unittest("x8zip-test", build.cxx("x8zip.cc"))
         build.unittest("hgemm-test", build.cxx("hgemm.cc"))
+        build.unittest("hconv-test", build.cxx("hconv.cc"))
         build.unittest("sgemm-test", build.cxx("sgemm.cc"))
+        build.unittest("sconv-test", build.cxx("sconv.cc"))
+        build.unittest("add-test", build.cxx("add.cc"))
+        build.unittest("average-pooling-test", build.cxx("average-pooling.cc"))
+        build.unittest("channel-shuffle-test", build.cxx("channel-shuffle.cc"))
+        build.unittest("concat-test", build.cxx("concat.cc"))
         build.unittest("convolution-test", build.cxx("convolution.cc"))
         build.unittest("deconvolution-test", build.cxx("deconvolution.cc"))
         build.unittest("fully-connected-test", build.cxx("fully-connected.cc"))
+        build.unittest("global-average-pooling-test", build.cxx("global-average-pooling.cc"))
+        build.unittest("initialize-test", build.cxx("initialize.cc"))
+        build.unittest("max-pooling-test", build.cxx("max-pooling.cc"))
+        build.unittest("plan-test", build.cxx("plan.cc"))
+        build.unittest("packed-weights-test", build.cxx("packed-weights.cc"))
+        build.unittest("operator-info-test", build.cxx("operator-info.cc"))
+        build.unittest("profiling-test", build.cxx("profiling.cc"))
+        build.unittest("scheduler-test", build.cxx("scheduler.cc"))
+        build.unittest("queue-test", build.cxx("queue.cc"))
+        build.unittest("run-operators-test", build.cxx("run-operators.cc"))
+        build.unittest("inverted-residual-test", build.cxx("inverted-residual.cc"))
+        build.unittest("depthwise-separable-test", build.cxx("depthwise-separable.cc"))
+        build.unittest("allocator-test", build.cxx("allocator.cc"))
+        build.unittest("lstm-cell-test", build.cxx("lstm-cell.cc"))
+        build.unittest("quantize-test", build.cxx("quantize.cc"))
+        build.unittest("dequantize-test", build.cxx("dequantize.cc"))
+        build.unittest("requantize-test", build.cxx("requantize.cc"))
+        build.unittest("softmax-test", build.cxx("softmax.cc"))
+        build.unittest("resize-test", build.cxx("resize.cc"))
+        build.unittest("embedding-bag-test", build.cxx("embedding-bag.cc"))
         build.unittest("requantization-test", [build.cxx("requantization.cc")] + requantization_objects)
 
     benchmark_isa = None
@@ -139,6 +325,9 @@ def main(args):
             extra_include_dirs="src"):
 
         build.benchmark("convolution-bench", build.cxx("convolution.cc"))
+        build.benchmark("deconvolution-bench", build.cxx("deconvolution.cc"))
+        build.benchmark("fully-connected-bench", build.cxx("fully-connected.cc"))
+        build.benchmark("network-bench", build.cxx("network.cc"))
         build.benchmark("q8gemm-bench", build.cxx("q8gemm.cc"))
         build.benchmark("hgemm-bench", build.cxx("hgemm.cc"))
         build.benchmark("sgemm-bench", build.cxx("sgemm.cc"))
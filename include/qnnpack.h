@@ -33,10 +33,224 @@ enum qnnp_status {
 
 enum qnnp_status qnnp_initialize(void);
 
+/**
+ * @brief Micro-benchmark candidate GEMM/convolution microkernels during initialization and use the fastest one.
+ */
+#define QNNP_INITIALIZE_FLAG_AUTOTUNE 0x00000001
+
+/**
+ * @brief Outcome of microkernel autotuning.
+ *
+ * Plain data that the caller may store (e.g. with memcpy to a file) and pass back through
+ * qnnp_initialize_options::tuning_result in a later process to skip tuning.
+ */
+struct qnnp_tuning_result {
+  uint32_t version;
+  uint32_t uarch;
+  uint32_t q8conv_ukernel;
+};
+
+/**
+ * @brief Memory allocation functions for the buffers of operators and packed weights.
+ *
+ * allocate, reallocate, and deallocate behave like malloc, realloc, and free. aligned_allocate returns memory aligned
+ * to at least the given power of two, which must be freed with aligned_deallocate; QNNPACK uses it for packed
+ * weights and zero buffers, which microkernels read on every run. Every function receives context as its first
+ * argument, e.g. to place memory on a NUMA node of the caller's choice.
+ */
+struct qnnp_allocator {
+  void* context;
+  void* (*allocate)(void* context, size_t size);
+  void* (*reallocate)(void* context, void* pointer, size_t size);
+  void (*deallocate)(void* context, void* pointer);
+  void* (*aligned_allocate)(void* context, size_t alignment, size_t size);
+  void (*aligned_deallocate)(void* context, void* pointer);
+};
+
+struct qnnp_initialize_options {
+  /** Bitwise OR of QNNP_INITIALIZE_FLAG_* values. */
+  uint32_t flags;
+  /**
+   * Result of a previous autotuning run, or NULL. It is used instead of tuning if it was produced by the same
+   * QNNPACK version on the same microarchitecture, and ignored otherwise.
+   */
+  const struct qnnp_tuning_result* tuning_result;
+  /**
+   * Allocator for all operators and packed weights, or NULL for the default. The structure is copied, but its
+   * context must stay valid until every operator and packed weights object is deleted. The default allocator aligns
+   * weights to 64-byte cache lines, and on Linux backs weights of 2 MB or more with transparent huge pages.
+   */
+  const struct qnnp_allocator* allocator;
+};
+
+/**
+ * @brief Initialize QNNPACK with the options.
+ *
+ * Like qnnp_initialize, initialization happens once per process: options passed after the first successful
+ * qnnp_initialize or qnnp_initialize_with_options call have no effect.
+ */
+enum qnnp_status qnnp_initialize_with_options(const struct qnnp_initialize_options* options);
+
+/**
+ * @brief Retrieve the microkernel selection made during initialization, in a form suitable for
+ *        qnnp_initialize_options::tuning_result.
+ */
+enum qnnp_status qnnp_get_tuning_result(struct qnnp_tuning_result* tuning_result);
+
 enum qnnp_status qnnp_deinitialize(void);
 
 typedef struct qnnp_operator* qnnp_operator_t;
 
+/**
+ * @brief Defer packing the kernel and bias from operator creation to the first qnnp_run_operator call, which packs
+ *        them using its thread pool.
+ *
+ * Saves time and memory for operators that may never run. The kernel and bias passed to the create function are
+ * not copied, and must stay valid until the operator first runs or is deleted.
+ */
+#define QNNP_CREATE_FLAG_LAZY_PACKING 0x00000001
+
+/**
+ * @brief Compute the input pointers of each tile of a convolution or deconvolution while it runs, instead of in an
+ *        indirection buffer built during setup.
+ *
+ * Setup then takes constant time and memory regardless of the input size, at the cost of recomputing the pointers for
+ * every block of output channels. The flag has no effect on 1x1 convolutions without padding, depthwise
+ * convolutions, and kernels too large for a tile's pointers to fit on the stack.
+ */
+#define QNNP_CREATE_FLAG_TILE_INDIRECTION 0x00000002
+
+/**
+ * @brief Requantize the 32-bit accumulators of a convolution, deconvolution, or fully-connected operator to 8 bits
+ *        in single-precision floating point, instead of the default Q31 fixed-point arithmetic.
+ *
+ * Both schemes multiply the accumulator by the requantization scale (input scale * kernel scale / output scale,
+ * rounded to FP32), add the output zero point, and clamp the result to [output_min, output_max]:
+ * - Q31 (default) computes the product exactly and rounds it to the nearest integer, with ties away from zero.
+ * - FP32 converts the accumulator to FP32, multiplies in FP32, and rounds to nearest with ties to even. Before
+ *   clamping, the result is within 1 of the Q31 one, and differs from it only on ties and where the product of the
+ *   accumulator and the scale is within 2**-15 of a tie.
+ *
+ * FP32 requantization needs fewer instructions per output, but only the GEMM and convolution microkernels implement
+ * it: depthwise convolutions and 1x1 convolutions with many input channels then run on the generic convolution and
+ * GEMM microkernels, which may be slower overall. Packed weights shared between operators must be created with the
+ * same scheme. Convolutions with per-channel kernel scales always use FP32 requantization.
+ */
+#define QNNP_CREATE_FLAG_FP32_REQUANTIZATION 0x00000004
+
+/**
+ * @brief Compute 3x3 convolutions on the convolution microkernels even where Winograd is available.
+ *
+ * By default, dense 3x3 convolutions with unit stride and dilation, Q31 requantization, and 64 to 512 input and at
+ * least 64 output channels per group are computed with Winograd F(2x2, 3x3), which needs 2.25x fewer multiplications
+ * and gives the same outputs. Its transformed input takes 8 bytes per output pixel and input channel in the scratch
+ * buffer. The flag is implied by QNNP_CREATE_FLAG_TILE_INDIRECTION. Operators created with packed weights follow the
+ * choice of the operator the weights were packed for.
+ */
+#define QNNP_CREATE_FLAG_NO_WINOGRAD 0x00000008
+
+/**
+ * @brief Read the input of a convolution in NCHW layout instead of NHWC, e.g. for the first convolution of a network
+ *        whose images are stored as planes of color channels, without a transpose before it.
+ *
+ * Each image of the input is then groups * group_input_channels planes of input_height rows of input_width pixels,
+ * and the input_pixel_stride passed to setup must equal the number of input channels. The output stays NHWC. Every
+ * input channel of a kernel position becomes a tap of its own for the convolution microkernels, which suits the few
+ * input channels of a first convolution: with many channels, transposing the input to NHWC is faster. The flag is
+ * only supported by quantized convolutions, disables QNNP_CREATE_FLAG_TILE_INDIRECTION, and excludes
+ * qnnp_run_convolution2d_nhwc_q8_rows.
+ */
+#define QNNP_CREATE_FLAG_INPUT_NCHW 0x00000010
+
+/**
+ * @brief Choose between the XZP and the generic GEMM microkernels of a 1x1 convolution by timing both paths on its
+ *        first runs, instead of by its number of input channels alone.
+ *
+ * XZP GEMM adds the input row sums times the kernel zero point after the GEMM, which pays off for many input channels;
+ * where it stops paying off also depends on the output channels, the batch, and the caches. With this flag, 1x1
+ * convolutions without padding or subsampling that use Q31 requantization hold weights packed for both paths, and
+ * their first qnnp_run_operator calls alternate between the paths, which give the same outputs. After four runs of
+ * each, the operator keeps the path with the fastest run per output pixel and frees the weights of the other one. The
+ * flag has no effect without XZP microkernels, i.e. on x86, or with packed weights shared between operators.
+ */
+#define QNNP_CREATE_FLAG_CALIBRATE_XZP 0x00000020
+
+/**
+ * @brief Pack the kernel of a pruned 1x1 convolution or fully-connected operator as blocks of 4 adjacent input
+ *        channels, skipping the blocks where every value equals the kernel zero point.
+ *
+ * The sparse GEMM microkernel then multiplies only the stored blocks, which pays off over the dense microkernels once
+ * most of the blocks are zero, e.g. for weights pruned in units of 4 input channels to 70% sparsity or more; it gives
+ * the same outputs either way. The flag applies to operators of a single group with at least 4 input channels,
+ * without padding or subsampling, and with Q31 requantization without per-channel scales, and has no effect on others
+ * or where there is no sparse microkernel. Operators created with packed weights follow the choice of the operator
+ * the weights were packed for. Sparse convolutions exclude qnnp_run_convolution2d_nhwc_q8_rows.
+ */
+#define QNNP_CREATE_FLAG_SPARSE_KERNEL 0x00000040
+
+/**
+ * @brief Pack the kernel of a fully-connected operator with 4 bits per value, two values per byte.
+ *
+ * Kernel values and the kernel zero point must be in [0, 15]. The GEMM microkernels unpack the values in registers,
+ * so the packed kernel takes half the memory and bandwidth of 8-bit weights, which pays off for memory-bound layers,
+ * e.g. on small batches; the outputs are the same either way. The flag applies to fully-connected operators with Q31
+ * requantization, and has no effect on others or where there are no such microkernels. Operators created with packed
+ * weights follow the choice of the operator the weights were packed for.
+ */
+#define QNNP_CREATE_FLAG_4BIT_KERNEL 0x00000080
+
+/**
+ * @brief Align the corner pixels of the input and output of a resize operator.
+ *
+ * By default resize operators use half-pixel centers: output pixel i of a dimension samples input position
+ * (i + 0.5) * input_size / output_size - 0.5. With the flag, it samples i * (input_size - 1) / (output_size - 1)
+ * instead, so that the first and last pixels of input and output coincide, as for align_corners models.
+ */
+#define QNNP_CREATE_FLAG_ALIGN_CORNERS 0x00000100
+
+/**
+ * @brief Fold the input zero point into the packed bias of a convolution, deconvolution, or fully-connected operator.
+ *
+ * The microkernels compute sum (input - input_zero_point) * (kernel - kernel_zero_point) per output. Since
+ * input_zero_point * sum (kernel - kernel_zero_point) is constant per output channel, packing subtracts it from the
+ * bias once, and the microkernels then only subtract the kernel zero point, which saves the subtraction of the input
+ * zero point from every input row in their inner loops; the outputs are the same either way. Padded kernel taps of
+ * convolutions are then read from the zero buffer instead of being skipped. The flag applies to operators with Q31
+ * requantization on the default GEMM and convolution microkernels, and has no effect on others, on kernels with zero
+ * point 128, which already fold it as signed kernels, or where the tile has no such microkernels. Operators created
+ * with packed weights follow the choice of the operator the weights were packed for. Excludes 16-bit accumulation and
+ * qnnp_setup_fully_connected_nc_q8_s32.
+ */
+#define QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT 0x00000200
+
+/**
+ * @brief Store the outputs of a fully-connected operator feature-major (CN) instead of batch-major (NC).
+ *
+ * Output channel c of batch row i is at output[c * output_stride + i], so output_stride of
+ * qnnp_setup_fully_connected_nc_q8 and its _s32 and _f32 variants is the distance between output channels, at least
+ * the batch size. The microkernels store each tile of requantized outputs transposed while it is still in cache,
+ * which saves a separate transpose of the whole output for consumers of feature-major data. The flag applies to
+ * quantized fully-connected operators and has no effect on others. Operators created with packed weights may choose
+ * either layout.
+ */
+#define QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT 0x00000400
+
+/**
+ * @brief Average the rows of every bag of an embedding-bag operator instead of adding them up.
+ *
+ * Each row, times its per-sample weight if there are any, is divided by the number of rows in its bag. Empty bags
+ * are zero either way.
+ */
+#define QNNP_CREATE_FLAG_EMBEDDING_BAG_MEAN 0x00000800
+
+/**
+ * @brief Reference-counted packed kernel and bias of a convolution, deconvolution, or fully-connected operator.
+ *
+ * Operators created with the *_with_packed_weights functions share these weights instead of holding their own copy,
+ * e.g. to run the same layer with different input shapes or on several threads.
+ */
+typedef struct qnnp_packed_weights* qnnp_packed_weights_t;
+
 enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
     uint32_t input_padding_top,
     uint32_t input_padding_right,
@@ -61,30 +275,25 @@ enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
     float output_scale,
     uint8_t output_min,
     uint8_t output_max,
+    uint32_t flags,
     qnnp_operator_t* convolution);
 
-enum qnnp_status qnnp_setup_convolution2d_nhwc_q8(
-    qnnp_operator_t convolution,
-    size_t batch_size,
-    size_t input_height,
-    size_t input_width,
-    const uint8_t* input,
-    size_t input_stride,
-    uint8_t* output,
-    size_t output_stride,
-    pthreadpool_t threadpool);
-
-enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8(
+/**
+ * @brief Like qnnp_create_convolution2d_nhwc_q8, but pack the kernel and bias with the thread pool, in parallel over
+ *        groups and blocks of output channels.
+ *
+ * With QNNP_CREATE_FLAG_LAZY_PACKING, the thread pool is not used: packing happens on the first run, with the thread
+ * pool passed to qnnp_run_operator.
+ */
+enum qnnp_status qnnp_create_convolution2d_nhwc_q8_with_threadpool(
     uint32_t input_padding_top,
     uint32_t input_padding_right,
     uint32_t input_padding_bottom,
     uint32_t input_padding_left,
-    uint32_t adjustment_height,
-    uint32_t adjustment_width,
     uint32_t kernel_height,
     uint32_t kernel_width,
-    uint32_t stride_height,
-    uint32_t stride_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
     uint32_t dilation_height,
     uint32_t dilation_width,
     uint32_t groups,
@@ -100,49 +309,1688 @@ enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8(
     float output_scale,
     uint8_t output_min,
     uint8_t output_max,
-    qnnp_operator_t* deconvolution);
-
-enum qnnp_status qnnp_setup_deconvolution2d_nhwc_q8(
-    qnnp_operator_t deconvolution,
-    size_t batch_size,
-    size_t input_height,
-    size_t input_width,
-    const uint8_t* input,
-    size_t input_stride,
-    uint8_t* output,
-    size_t output_stride,
-    pthreadpool_t threadpool);
+    uint32_t flags,
+    pthreadpool_t threadpool,
+    qnnp_operator_t* convolution);
 
-enum qnnp_status qnnp_create_fully_connected_nc_q8(
-    size_t input_channels,
-    size_t output_channels,
+/**
+ * @brief Like qnnp_create_convolution2d_nhwc_q8, but reference packed weights of another convolution instead of
+ *        packing a kernel and bias.
+ *
+ * The weights must come from a convolution created with the same kernel size, groups and channels, and input and
+ * kernel offsets; otherwise the call fails with qnnp_status_invalid_parameter. The new operator holds
+ * a reference to the weights, so they stay valid after the operator they were obtained from is deleted.
+ */
+enum qnnp_status qnnp_create_convolution2d_nhwc_q8_with_packed_weights(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
     uint8_t input_offset,
     float input_scale,
     uint8_t kernel_offset,
     float kernel_scale,
+    qnnp_packed_weights_t packed_weights,
+    uint8_t output_offset,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* convolution);
+
+/**
+ * @brief Like qnnp_create_convolution2d_nhwc_q8, but with a separate kernel scale for each output channel, as in
+ *        per-channel quantized models.
+ *
+ * kernel_scales has groups * group_output_channels positive elements. For every output channel, input_scale *
+ * kernel_scale / output_scale must be below 1.0. The convolution always runs through the indirection buffer and
+ * convolution microkernels, which requantize the accumulators in FP32 with the scales packed next to the bias; its
+ * packed weights cannot be shared or serialized. Setup and run are the same as for other quantized convolutions.
+ */
+enum qnnp_status qnnp_create_convolution2d_nhwc_q8_per_channel(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_offset,
+    float input_scale,
+    uint8_t kernel_offset,
+    const float* kernel_scales,
     const uint8_t* kernel,
     const int32_t* bias,
     uint8_t output_offset,
     float output_scale,
     uint8_t output_min,
     uint8_t output_max,
-    qnnp_operator_t* fully_connected);
+    uint32_t flags,
+    qnnp_operator_t* convolution);
 
-enum qnnp_status qnnp_setup_fully_connected_nc_q8(
-    qnnp_operator_t fully_connected,
+enum qnnp_status qnnp_setup_convolution2d_nhwc_q8(
+    qnnp_operator_t convolution,
     size_t batch_size,
+    size_t input_height,
+    size_t input_width,
     const uint8_t* input,
     size_t input_stride,
     uint8_t* output,
     size_t output_stride,
     pthreadpool_t threadpool);
 
-enum qnnp_status qnnp_run_operator(
-    qnnp_operator_t op,
+/**
+ * @brief Create a convolution on single-precision floating-point NHWC tensors, e.g. for first or last layers that
+ *        are kept in FP32 for accuracy.
+ *
+ * The kernel has the same layout as for qnnp_create_convolution2d_nhwc_q8 and is packed for the FP32 GEMM
+ * microkernels. Outputs are clamped to [output_min, output_max]; pass -INFINITY and +INFINITY for no clamping.
+ * Only QNNP_CREATE_FLAG_LAZY_PACKING is supported among the create flags.
+ */
+enum qnnp_status qnnp_create_convolution2d_nhwc_f32(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    const float* kernel,
+    const float* bias,
+    float output_min,
+    float output_max,
+    uint32_t flags,
+    qnnp_operator_t* convolution);
+
+/**
+ * @brief Set up a convolution created by qnnp_create_convolution2d_nhwc_f32. Strides are in elements.
+ */
+enum qnnp_status qnnp_setup_convolution2d_nhwc_f32(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const float* input,
+    size_t input_stride,
+    float* output,
+    size_t output_stride,
     pthreadpool_t threadpool);
 
-enum qnnp_status qnnp_delete_operator(
-    qnnp_operator_t op);
+/**
+ * @brief Create a convolution on half-precision floating-point NHWC tensors.
+ *
+ * Kernel, bias, input and output elements are IEEE half-precision values stored as 16-bit integers; the kernel has
+ * the same layout as for qnnp_create_convolution2d_nhwc_f32. Accumulation is in FP16 too, so this needs hardware FP16
+ * arithmetic (ARMv8.2-A) and fails with qnnp_status_unsupported_hardware elsewhere. The output range is given in
+ * single precision and rounded to half precision.
+ */
+enum qnnp_status qnnp_create_convolution2d_nhwc_f16(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    const void* kernel,
+    const void* bias,
+    float output_min,
+    float output_max,
+    uint32_t flags,
+    qnnp_operator_t* convolution);
+
+/**
+ * @brief Set up a convolution created by qnnp_create_convolution2d_nhwc_f16. Strides are in elements.
+ */
+enum qnnp_status qnnp_setup_convolution2d_nhwc_f16(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const void* input,
+    size_t input_stride,
+    void* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Query the memory qnnp_setup_convolution2d_nhwc_q8_with_workspace needs for the given input shape.
+ *
+ * The workspace holds the indirection buffer and must stay valid and unmodified until the operator is set up again
+ * or deleted. The scratch is only used during qnnp_run_operator, and may be shared with other operators that do not
+ * run concurrently. Either size can be zero.
+ */
+enum qnnp_status qnnp_get_convolution2d_nhwc_q8_workspace_size(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t* workspace_size,
+    size_t* scratch_size);
+
+/**
+ * @brief Like qnnp_setup_convolution2d_nhwc_q8, but place internal buffers in caller-owned memory instead of
+ *        allocating them. Workspace and scratch must be aligned to at least pointer size.
+ */
+enum qnnp_status qnnp_setup_convolution2d_nhwc_q8_with_workspace(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    void* workspace,
+    void* scratch,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Like qnnp_setup_convolution2d_nhwc_q8, but read the input as a window of a larger tensor, e.g. a region of
+ *        interest of a shared frame buffer, without copying it. Strides are in bytes.
+ *
+ * input_row_stride is the distance between rows of an image and input_image_stride the distance between images of
+ * the batch, input_width * input_pixel_stride and input_height * input_row_stride for a packed input. Convolutions
+ * that map directly to GEMM, Winograd, XZP, NCHW, and tile indirection convolutions read the input as a packed
+ * tensor and fail with qnnp_status_unsupported_parameter for any other strides.
+ */
+enum qnnp_status qnnp_setup_convolution2d_nhwc_q8_with_strides(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    size_t input_row_stride,
+    size_t input_image_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Crop of an NHWC image, e.g. a region of interest of a frame, that a convolution reads in place.
+ *
+ * row_stride is the distance in bytes between rows of the crop, e.g. the row stride of the frame it is cut from.
+ */
+struct qnnp_roi {
+  const uint8_t* input;
+  size_t height;
+  size_t width;
+  size_t row_stride;
+};
+
+/**
+ * @brief Set up a convolution to compute its output for every crop of a list in one qnnp_run_operator call, which
+ *        tiles the output pixels of all crops in one parallel loop with the same packed weights.
+ *
+ * All crops have the same input pixel stride, in bytes, and may have different sizes. Their outputs follow one
+ * another in the order of rois, each with its output pixels in row-major order and output_stride bytes apart: the
+ * output of a crop starts after the output pixels of all crops before it. Only convolutions that build a generic
+ * indirection buffer support crops; convolutions that map directly to GEMM, depthwise, Winograd, XZP, stem, NCHW, and
+ * tile indirection convolutions fail with qnnp_status_unsupported_parameter. The ROIs replace the input of the
+ * operator, so qnnp_set_operator_io fails until the next setup.
+ */
+enum qnnp_status qnnp_setup_convolution2d_nhwc_q8_rois(
+    qnnp_operator_t convolution,
+    size_t roi_count,
+    const struct qnnp_roi* rois,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Query which input rows a band of output rows of a set up convolution depends on.
+ *
+ * Input rows [*input_y_start, *input_y_start + *input_rows) of every image, including the halo that the kernel
+ * overlaps, must hold their final values before qnnp_run_convolution2d_nhwc_q8_rows computes the band.
+ * *input_rows is zero if the band only reads padding.
+ */
+enum qnnp_status qnnp_get_convolution2d_nhwc_q8_input_rows(
+    qnnp_operator_t convolution,
+    size_t output_y_start,
+    size_t output_rows,
+    size_t* input_y_start,
+    size_t* input_rows);
+
+/**
+ * @brief Compute output rows [output_y_start, output_y_start + output_rows) of every image of a set up convolution.
+ *
+ * Reads only the input rows reported by qnnp_get_convolution2d_nhwc_q8_input_rows and writes only the output rows of
+ * the band, so bands can run while later input rows are still arriving, e.g. from a camera. Computing all bands gives
+ * the same output as qnnp_run_operator. Fails with qnnp_status_unsupported_parameter for kernels too large for
+ * QNNP_CREATE_FLAG_TILE_INDIRECTION.
+ */
+enum qnnp_status qnnp_run_convolution2d_nhwc_q8_rows(
+    qnnp_operator_t convolution,
+    size_t output_y_start,
+    size_t output_rows,
+    pthreadpool_t threadpool);
+
+enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t adjustment_height,
+    uint32_t adjustment_width,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_offset,
+    float input_scale,
+    uint8_t kernel_offset,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_offset,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* deconvolution);
+
+/**
+ * @brief Like qnnp_create_deconvolution2d_nhwc_q8, but pack the kernel and bias with the thread pool, as
+ *        qnnp_create_convolution2d_nhwc_q8_with_threadpool does.
+ */
+enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8_with_threadpool(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t adjustment_height,
+    uint32_t adjustment_width,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_offset,
+    float input_scale,
+    uint8_t kernel_offset,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_offset,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    pthreadpool_t threadpool,
+    qnnp_operator_t* deconvolution);
+
+/**
+ * @brief Like qnnp_create_deconvolution2d_nhwc_q8, but reference packed weights of another deconvolution, with the
+ *        same requirements as for qnnp_create_convolution2d_nhwc_q8_with_packed_weights.
+ */
+enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8_with_packed_weights(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t adjustment_height,
+    uint32_t adjustment_width,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_offset,
+    float input_scale,
+    uint8_t kernel_offset,
+    float kernel_scale,
+    qnnp_packed_weights_t packed_weights,
+    uint8_t output_offset,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* deconvolution);
+
+enum qnnp_status qnnp_setup_deconvolution2d_nhwc_q8(
+    qnnp_operator_t deconvolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Query the workspace qnnp_setup_deconvolution2d_nhwc_q8_with_workspace needs for the given input shape.
+ */
+enum qnnp_status qnnp_get_deconvolution2d_nhwc_q8_workspace_size(
+    qnnp_operator_t deconvolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t* workspace_size);
+
+/**
+ * @brief Like qnnp_setup_deconvolution2d_nhwc_q8, but place the indirection buffer in caller-owned memory, with
+ *        the same requirements as for qnnp_setup_convolution2d_nhwc_q8_with_workspace.
+ */
+enum qnnp_status qnnp_setup_deconvolution2d_nhwc_q8_with_workspace(
+    qnnp_operator_t deconvolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    void* workspace,
+    pthreadpool_t threadpool);
+
+enum qnnp_status qnnp_create_fully_connected_nc_q8(
+    size_t input_channels,
+    size_t output_channels,
+    uint8_t input_offset,
+    float input_scale,
+    uint8_t kernel_offset,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_offset,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* fully_connected);
+
+/**
+ * @brief Like qnnp_create_fully_connected_nc_q8, but pack the kernel and bias with the thread pool, as
+ *        qnnp_create_convolution2d_nhwc_q8_with_threadpool does.
+ */
+enum qnnp_status qnnp_create_fully_connected_nc_q8_with_threadpool(
+    size_t input_channels,
+    size_t output_channels,
+    uint8_t input_offset,
+    float input_scale,
+    uint8_t kernel_offset,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_offset,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    pthreadpool_t threadpool,
+    qnnp_operator_t* fully_connected);
+
+/**
+ * @brief Like qnnp_create_fully_connected_nc_q8, but reference packed weights of another fully-connected operator,
+ *        with the same requirements as for qnnp_create_convolution2d_nhwc_q8_with_packed_weights.
+ */
+enum qnnp_status qnnp_create_fully_connected_nc_q8_with_packed_weights(
+    size_t input_channels,
+    size_t output_channels,
+    uint8_t input_offset,
+    float input_scale,
+    uint8_t kernel_offset,
+    float kernel_scale,
+    qnnp_packed_weights_t packed_weights,
+    uint8_t output_offset,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* fully_connected);
+
+enum qnnp_status qnnp_setup_fully_connected_nc_q8(
+    qnnp_operator_t fully_connected,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Set up a quantized fully-connected operator to output its 32-bit accumulators, i.e. the bias plus the dot
+ *        products of input and kernel less their zero points, instead of requantized values, e.g. for a softmax or
+ *        argmax that follows it.
+ *
+ * The output quantization, clamping, and lookup table of the operator are ignored until the next
+ * qnnp_setup_fully_connected_nc_q8. Batches run on the single-row microkernels with 32-bit outputs, one row at a time,
+ * and fail with qnnp_status_unsupported_parameter for microkernels without them, e.g. for sparse or 4-bit kernels.
+ */
+enum qnnp_status qnnp_setup_fully_connected_nc_q8_s32(
+    qnnp_operator_t fully_connected,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    int32_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Like qnnp_setup_fully_connected_nc_q8_s32, but output the accumulators times input scale times kernel scale,
+ *        i.e. dequantized without a round trip through the output quantization. Operators created by
+ *        qnnp_create_operator_from_serialized only know the requantization scale, so their outputs are also divided
+ *        by the output scale.
+ */
+enum qnnp_status qnnp_setup_fully_connected_nc_q8_f32(
+    qnnp_operator_t fully_connected,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    float* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create a fully-connected operator on single-precision floating-point tensors, see
+ *        qnnp_create_convolution2d_nhwc_f32.
+ */
+enum qnnp_status qnnp_create_fully_connected_nc_f32(
+    size_t input_channels,
+    size_t output_channels,
+    const float* kernel,
+    const float* bias,
+    float output_min,
+    float output_max,
+    uint32_t flags,
+    qnnp_operator_t* fully_connected);
+
+enum qnnp_status qnnp_setup_fully_connected_nc_f32(
+    qnnp_operator_t fully_connected,
+    size_t batch_size,
+    const float* input,
+    size_t input_stride,
+    float* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create a fully-connected operator on half-precision floating-point tensors, see
+ *        qnnp_create_convolution2d_nhwc_f16.
+ */
+enum qnnp_status qnnp_create_fully_connected_nc_f16(
+    size_t input_channels,
+    size_t output_channels,
+    const void* kernel,
+    const void* bias,
+    float output_min,
+    float output_max,
+    uint32_t flags,
+    qnnp_operator_t* fully_connected);
+
+enum qnnp_status qnnp_setup_fully_connected_nc_f16(
+    qnnp_operator_t fully_connected,
+    size_t batch_size,
+    const void* input,
+    size_t input_stride,
+    void* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that adds two quantized tensors of batch_size x channels elements, e.g. a residual
+ *        connection.
+ *
+ * The ratios of both input scales to the sum scale must be in [2**-14, 2**8) range.
+ */
+enum qnnp_status qnnp_create_add_nc_q8(
+    size_t channels,
+    uint8_t a_zero_point,
+    float a_scale,
+    uint8_t b_zero_point,
+    float b_scale,
+    uint8_t sum_zero_point,
+    float sum_scale,
+    uint8_t sum_min,
+    uint8_t sum_max,
+    uint32_t flags,
+    qnnp_operator_t* add);
+
+/**
+ * @brief Set up an add operator. Strides are in elements between consecutive rows; the sum may be computed in
+ *        place of either input if it has the same stride.
+ */
+enum qnnp_status qnnp_setup_add_nc_q8(
+    qnnp_operator_t add,
+    size_t batch_size,
+    const uint8_t* a,
+    size_t a_stride,
+    const uint8_t* b,
+    size_t b_stride,
+    uint8_t* sum,
+    size_t sum_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that quantizes a float tensor of batch_size x channels elements, e.g. at the input of the
+ *        quantized part of a network: every element x becomes output_zero_point + x / output_scale, rounded to
+ *        nearest-even and clamped to [output_min, output_max].
+ */
+enum qnnp_status qnnp_create_quantize_nc_f32_q8(
+    size_t channels,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* quantize);
+
+/**
+ * @brief Set up a quantize operator. Strides are in elements between consecutive rows.
+ */
+enum qnnp_status qnnp_setup_quantize_nc_f32_q8(
+    qnnp_operator_t quantize,
+    size_t batch_size,
+    const float* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that dequantizes a quantized tensor of batch_size x channels elements into floats, e.g.
+ *        at the output of the quantized part of a network: every element q becomes (q - input_zero_point) *
+ *        input_scale.
+ */
+enum qnnp_status qnnp_create_dequantize_nc_q8_f32(
+    size_t channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint32_t flags,
+    qnnp_operator_t* dequantize);
+
+/**
+ * @brief Set up a dequantize operator. Strides are in elements between consecutive rows.
+ */
+enum qnnp_status qnnp_setup_dequantize_nc_q8_f32(
+    qnnp_operator_t dequantize,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    float* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that requantizes a quantized tensor of batch_size x channels elements from the input zero
+ *        point and scale to those of the output, clamping to [output_min, output_max].
+ *
+ * The input scale divided by the output scale must be in [2**-14, 2**8) range, as for concat.
+ */
+enum qnnp_status qnnp_create_requantize_nc_q8(
+    size_t channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* requantize);
+
+/**
+ * @brief Set up a requantize operator. Strides are in elements between consecutive rows; the output may be computed
+ *        in place of the input if it has the same stride.
+ */
+enum qnnp_status qnnp_setup_requantize_nc_q8(
+    qnnp_operator_t requantize,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that computes the softmax of every row of a batch_size x channels tensor, e.g. at the
+ *        output of a classifier, without leaving the quantized domain.
+ *
+ * Exponents come from a 256-entry table built from the input scale, so the input zero point does not matter: every
+ * row is shifted by its maximum. The output scale must be 1/256 and the output zero point 0.
+ */
+enum qnnp_status qnnp_create_softmax_nc_q8(
+    size_t channels,
+    float input_scale,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint32_t flags,
+    qnnp_operator_t* softmax);
+
+/**
+ * @brief Set up a softmax operator. Strides are in elements between consecutive rows; the output may be computed in
+ *        place of the input if it has the same stride.
+ */
+enum qnnp_status qnnp_setup_softmax_nc_q8(
+    qnnp_operator_t softmax,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that finds the channel with the largest value in every row of a batch_size x channels
+ *        tensor, e.g. the class a classifier predicts. Ties go to the first such channel.
+ */
+enum qnnp_status qnnp_create_argmax_nc_q8(
+    size_t channels,
+    uint32_t flags,
+    qnnp_operator_t* argmax);
+
+/**
+ * @brief Set up an argmax operator. The input stride is in elements between consecutive rows, and the output holds
+ *        batch_size channel indices.
+ */
+enum qnnp_status qnnp_setup_argmax_nc_q8(
+    qnnp_operator_t argmax,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    uint32_t* output,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that looks up bags of rows in an embedding table and pools every bag into one row, e.g.
+ *        for the sparse features of a recommendation model.
+ *
+ * The table has num_embeddings rows of embedding_dim uint8 elements, and element x of row r stands for
+ * x * scales[r] + biases[r]. The operator references the table, scales, and biases, which must outlive it. Rows of a
+ * bag are added up, or averaged with QNNP_CREATE_FLAG_EMBEDDING_BAG_MEAN, into float outputs.
+ */
+enum qnnp_status qnnp_create_embedding_bag_q8(
+    size_t num_embeddings,
+    size_t embedding_dim,
+    const uint8_t* weights,
+    const float* scales,
+    const float* biases,
+    uint32_t flags,
+    qnnp_operator_t* embedding_bag);
+
+/**
+ * @brief Set up an embedding-bag operator for a batch of bags.
+ *
+ * Bag i pools the rows indices[offsets[i]] to indices[offsets[i + 1] - 1], so offsets has bags + 1 non-decreasing
+ * entries, and every index must be below num_embeddings. per_sample_weights, if not NULL, has a weight for every
+ * entry of indices that scales its row. The output stride is in elements between the pooled rows of consecutive
+ * bags. Work is split across threads by bags, and rows of tables larger than the L2 cache are prefetched a few
+ * indices ahead of the one being added.
+ */
+enum qnnp_status qnnp_setup_embedding_bag_q8(
+    qnnp_operator_t embedding_bag,
+    size_t bags,
+    const uint32_t* indices,
+    const uint32_t* offsets,
+    const float* per_sample_weights,
+    float* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that averages every channel over all pixels of an image, e.g. before the classifier of
+ *        a network.
+ */
+enum qnnp_status qnnp_create_global_average_pooling_nwc_q8(
+    size_t channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* global_average_pooling);
+
+/**
+ * @brief Set up a global average pooling operator for batch_size images of width pixels each (height x width for
+ *        NHWC tensors). The input scale divided by the output scale and width must be in [2**-32, 1) range.
+ */
+enum qnnp_status qnnp_setup_global_average_pooling_nwc_q8(
+    qnnp_operator_t global_average_pooling,
+    size_t batch_size,
+    size_t width,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that takes the maximum of every channel over a pooling window. Padding never wins the
+ *        maximum, and the result is clamped to [output_min, output_max].
+ */
+enum qnnp_status qnnp_create_max_pooling2d_nhwc_u8(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t pooling_height,
+    uint32_t pooling_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    size_t channels,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* max_pooling);
+
+enum qnnp_status qnnp_setup_max_pooling2d_nhwc_u8(
+    qnnp_operator_t max_pooling,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that resizes NHWC images with bilinear interpolation, e.g. to upsample feature maps in
+ *        segmentation and FPN networks. Inputs and outputs have the same quantization.
+ *
+ * Interpolation weights are in Q11, and outputs are within one unit of exact interpolation. See
+ * QNNP_CREATE_FLAG_ALIGN_CORNERS for the sampled input positions.
+ */
+enum qnnp_status qnnp_create_resize_bilinear2d_nhwc_u8(
+    size_t channels,
+    uint32_t flags,
+    qnnp_operator_t* resize);
+
+/**
+ * @brief Set up a bilinear resize operator. Strides are in elements between consecutive pixels; setup rebuilds its
+ *        index and weight tables only when the input or output dimensions change.
+ */
+enum qnnp_status qnnp_setup_resize_bilinear2d_nhwc_u8(
+    qnnp_operator_t resize,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t output_height,
+    size_t output_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that resizes NHWC images by copying the nearest input pixel, e.g. to upsample feature maps
+ *        by integer factors.
+ *
+ * The input positions of QNNP_CREATE_FLAG_ALIGN_CORNERS round to the nearest pixel, with halves rounding up.
+ */
+enum qnnp_status qnnp_create_resize_nearest2d_nhwc_u8(
+    size_t channels,
+    uint32_t flags,
+    qnnp_operator_t* resize);
+
+/**
+ * @brief Set up a nearest-neighbor resize operator, as qnnp_setup_resize_bilinear2d_nhwc_u8.
+ */
+enum qnnp_status qnnp_setup_resize_nearest2d_nhwc_u8(
+    qnnp_operator_t resize,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t output_height,
+    size_t output_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that averages every channel over a pooling window. Padding counts as input_zero_point,
+ *        so every output is divided by pooling_height x pooling_width. The input scale divided by the output scale
+ *        and the pooling size must be in [2**-32, 1) range.
+ */
+enum qnnp_status qnnp_create_average_pooling2d_nhwc_q8(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t pooling_height,
+    uint32_t pooling_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    size_t channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* average_pooling);
+
+enum qnnp_status qnnp_setup_average_pooling2d_nhwc_q8(
+    qnnp_operator_t average_pooling,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that transposes groups x group_channels channels of every pixel into group_channels x
+ *        groups order, i.e. the channel shuffle between group convolutions of ShuffleNet. It is type-agnostic and
+ *        preserves quantization parameters.
+ */
+enum qnnp_status qnnp_create_channel_shuffle_nc_x8(
+    size_t groups,
+    size_t group_channels,
+    uint32_t flags,
+    qnnp_operator_t* channel_shuffle);
+
+enum qnnp_status qnnp_setup_channel_shuffle_nc_x8(
+    qnnp_operator_t channel_shuffle,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that concatenates the channels of several inputs, requantizing every input from its zero
+ *        point and scale to those of the output and clamping to [output_min, output_max].
+ *
+ * Inputs quantized like the output are copied when the range is [0, 255]. The input scale divided by the output scale
+ * must be in [2**-14, 2**8) range for every input.
+ *
+ * When inputs already share the output quantization, their producers can write into channel slices of the output
+ * directly instead, see qnnp_run_operator.
+ */
+enum qnnp_status qnnp_create_concat_nc_q8(
+    size_t inputs,
+    const size_t* input_channels,
+    const uint8_t* input_zero_points,
+    const float* input_scales,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* concat);
+
+/**
+ * @brief Set up a concat operator with one pointer and stride per input, in the order of creation. Every output pixel
+ *        holds the channels of all inputs one after another.
+ */
+enum qnnp_status qnnp_setup_concat_nc_q8(
+    qnnp_operator_t concat,
+    size_t batch_size,
+    const uint8_t** inputs,
+    const size_t* input_strides,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that fuses the expansion, depthwise, and projection convolutions of an inverted residual
+ *        block, e.g. of MobileNetV2, so that the expanded tensor is only held a few rows at a time.
+ *
+ * Expansion and projection must be 1x1 convolutions without groups, padding, or subsampling that run on the GEMM
+ * microkernels, and the depthwise convolution must have as many channels as the expansion outputs and no channel
+ * multiplier. The output quantization of every operator must be the input quantization of the next one. The new
+ * operator takes the kernels, quantization, and lookup tables of the three operators, which must outlive it and must
+ * not be set up or run while it is in use. Fails with qnnp_status_unsupported_parameter for operators that can't be
+ * fused, which then run as before.
+ */
+enum qnnp_status qnnp_create_inverted_residual_nhwc_q8(
+    qnnp_operator_t expansion,
+    qnnp_operator_t depthwise,
+    qnnp_operator_t projection,
+    uint32_t flags,
+    qnnp_operator_t* inverted_residual);
+
+/**
+ * @brief Set up an inverted residual operator. Every thread of the pool computes a band of output rows with buffers
+ *        for the expanded rows under its depthwise kernel, which it computes once per band.
+ */
+enum qnnp_status qnnp_setup_inverted_residual_nhwc_q8(
+    qnnp_operator_t inverted_residual,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create an operator that fuses a depthwise convolution and the 1x1 pointwise convolution after it, e.g. of
+ *        MobileNetV1, so that the depthwise output is only held a few rows at a time.
+ *
+ * The depthwise convolution must have no channel multiplier, and the pointwise convolution must be a 1x1 convolution
+ * without groups, padding, or subsampling that runs on the GEMM microkernels, with as many input channels as the
+ * depthwise convolution has. As for qnnp_create_inverted_residual_nhwc_q8, the operators must outlive the new one,
+ * and fail with qnnp_status_unsupported_parameter if they can't be fused.
+ */
+enum qnnp_status qnnp_create_depthwise_separable_nhwc_q8(
+    qnnp_operator_t depthwise,
+    qnnp_operator_t pointwise,
+    uint32_t flags,
+    qnnp_operator_t* depthwise_separable);
+
+/**
+ * @brief Set up a depthwise separable operator. Every thread of the pool computes a band of output rows, and runs the
+ *        pointwise convolution on a few depthwise output rows at a time.
+ */
+enum qnnp_status qnnp_setup_depthwise_separable_nhwc_q8(
+    qnnp_operator_t depthwise_separable,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Create a quantized LSTM cell operator, which computes the four gates of every hidden unit with one GEMM over
+ *        the input and the previous hidden state, and updates the cell state and hidden output in its epilogue.
+ *
+ * The input, previous hidden state, and hidden output share one quantization, and the input and recurrent kernels
+ * another. Kernels have 4 * hidden_channels rows of input_channels and hidden_channels elements, and the bias
+ * 4 * hidden_channels elements in input scale times kernel scale, each for the input, forget, cell, and output gates
+ * in this order. Gate pre-activations are requantized to a fixed range of [-8, 8) before sigmoid and tanh. The cell
+ * state is int16 with cell_scale, which must be a power of two in [2**-15, 1]. Input scale times kernel scale must be
+ * below 1/16.
+ */
+enum qnnp_status qnnp_create_lstm_cell_nc_q8(
+    size_t input_channels,
+    size_t hidden_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    const uint8_t* input_kernel,
+    const uint8_t* recurrent_kernel,
+    const int32_t* bias,
+    float cell_scale,
+    uint32_t flags,
+    qnnp_operator_t* lstm_cell);
+
+/**
+ * @brief Set up an LSTM cell operator for one timestep of a batch. The cell state of batch_size * hidden_channels
+ *        elements is updated in place, and the hidden output may be the hidden input, so that successive timesteps
+ *        run the same operator without another setup.
+ */
+enum qnnp_status qnnp_setup_lstm_cell_nc_q8(
+    qnnp_operator_t lstm_cell,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    const uint8_t* hidden_input,
+    size_t hidden_input_stride,
+    int16_t* cell_state,
+    uint8_t* hidden_output,
+    size_t hidden_output_stride,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Fuse an elementwise nonlinearity, e.g. hard-swish, sigmoid, or tanh, into a convolution, deconvolution, or
+ *        fully-connected operator.
+ *
+ * Every requantized and clamped output value q is replaced by lookup_table[q] while its tile is still in cache, with
+ * no extra pass over the output. The 256 entries are copied, and a NULL table removes a previously set one. Call it
+ * after creating the operator and before running it; the table applies to all later runs. Serialized operators do
+ * not include the table.
+ */
+enum qnnp_status qnnp_set_operator_lookup_table(
+    qnnp_operator_t op,
+    const uint8_t* lookup_table);
+
+/**
+ * @brief Replace the input and output pointers of a set up operator, keeping the batch size, dimensions, and strides
+ *        of its last setup.
+ *
+ * Unlike setup, it neither validates the shape nor rebuilds the indirection buffer: GEMM, XZP, Winograd, and stem
+ * convolutions, fully-connected, global average pooling, channel shuffle, quantize, dequantize, and requantize
+ * operators only take the new pointers, and other convolution, deconvolution, and pooling operators rebase their
+ * indirection buffer onto the new input. Operators set up with a caller-provided workspace must be set up again, as
+ * must add, concat, and fused operators. These fail with qnnp_status_invalid_parameter, as do operators that haven't
+ * been set up.
+ */
+enum qnnp_status qnnp_set_operator_io(
+    qnnp_operator_t op,
+    const void* input,
+    void* output);
+
+/**
+ * @brief Keep the indirection buffers of convolution, deconvolution, and pooling operators for up to max_size bytes
+ *        of earlier input shapes, e.g. for inputs whose width varies between requests.
+ *
+ * When setup changes the batch size, input dimensions, or input pixel stride, the indirection buffer of the last
+ * shape moves into the cache, and one cached for the new shape is rebased onto the new input instead of rebuilt. The
+ * least recently cached buffers are freed to stay within max_size, and a max_size of 0 frees the cache. Setup with a
+ * caller-provided workspace neither uses nor fills the cache.
+ */
+enum qnnp_status qnnp_set_operator_setup_cache(
+    qnnp_operator_t op,
+    size_t max_size);
+
+/**
+ * @brief Task of a parallel loop, see qnnp_scheduler.
+ */
+typedef void (*qnnp_task_function)(void* task_context, size_t task);
+
+/**
+ * @brief Scheduler of the parallel loops of an operator, e.g. on a thread pool of the application.
+ *
+ * qnnp_run_operator splits every parallel loop into tasks [0, tasks) and passes them to parallelize, which must call
+ * task(task_context, i) once for every i, in any order and on any threads, and return once all calls have returned.
+ * Operators size their tasks for threads_count threads.
+ */
+struct qnnp_scheduler {
+  void (*parallelize)(void* context, qnnp_task_function task, void* task_context, size_t tasks);
+  void* context;
+  size_t threads_count;
+};
+
+/**
+ * @brief Run the parallel loops of an operator with the scheduler instead of the thread pool passed to setup and
+ *        qnnp_run_operator, which only pack weights then. A NULL scheduler restores the thread pool.
+ *
+ * The scheduler is copied. Set it before setup, which sizes the split-K reduction of fully-connected operators by its
+ * thread count.
+ */
+enum qnnp_status qnnp_set_operator_scheduler(
+    qnnp_operator_t op,
+    const struct qnnp_scheduler* scheduler);
+
+/**
+ * @brief Retrieve a scheduler that runs tasks on the threads of the thread pool, where threads that finish their
+ *        share of the tasks take the remaining tasks of the others, starting from the last one.
+ *
+ * It balances threads of different speed, e.g. big and little cores, and only needs pthreadpool_compute_1d and
+ * pthreadpool_get_threads_count from the thread pool, so it also works with QNNPACK_CUSTOM_THREADPOOL. The thread
+ * pool must outlive the operators that use the scheduler.
+ */
+enum qnnp_status qnnp_get_work_stealing_scheduler(
+    pthreadpool_t threadpool,
+    struct qnnp_scheduler* scheduler);
+
+/**
+ * @brief Pool of threads that QNNPACK pins to processors, one thread per processor, e.g. to keep the operators of a
+ *        model and their packed weights on one core cluster.
+ *
+ * Operators run on the pool through its scheduler, see qnnp_get_affinity_pool_scheduler. Only the threads of the pool
+ * run tasks, while the thread that calls qnnp_run_operator waits, and runs of operators that share a pool take turns
+ * on it. Threads can only be pinned on Linux and Android, and creating a pool fails with
+ * qnnp_status_unsupported_hardware elsewhere, or if the system does not allow a thread on one of the processors.
+ */
+typedef struct qnnp_affinity_pool* qnnp_affinity_pool_t;
+
+/**
+ * @brief Create a pool with a thread on each of the processors, which are indices of cpuinfo_get_processor.
+ */
+enum qnnp_status qnnp_create_affinity_pool(
+    size_t processors_count,
+    const uint32_t* processors,
+    qnnp_affinity_pool_t* pool);
+
+/**
+ * @brief Create a pool with a thread on each processor of the core cluster, an index of cpuinfo_get_cluster.
+ */
+enum qnnp_status qnnp_create_cluster_affinity_pool(
+    uint32_t cluster_index,
+    qnnp_affinity_pool_t* pool);
+
+/**
+ * @brief Retrieve a scheduler that runs the tasks of operators on the threads of the pool, to bind operators to the
+ *        pool with qnnp_set_operator_scheduler. The pool must outlive the operators that use the scheduler.
+ */
+enum qnnp_status qnnp_get_affinity_pool_scheduler(
+    qnnp_affinity_pool_t pool,
+    struct qnnp_scheduler* scheduler);
+
+enum qnnp_status qnnp_delete_affinity_pool(
+    qnnp_affinity_pool_t pool);
+
+/**
+ * @brief Run an operator that was set up.
+ *
+ * Within every output pixel, operators only write their own output channels. Operators that write disjoint channel
+ * slices of the same buffer, e.g. branches set up with output + channel_offset and the pixel stride of the
+ * concatenated tensor, may therefore run concurrently on different threads, as long as none of them reads the slices
+ * the others write.
+ */
+enum qnnp_status qnnp_run_operator(
+    qnnp_operator_t op,
+    pthreadpool_t threadpool);
+
+/** Maximum number of operators in one call of qnnp_run_operators */
+#define QNNP_MAX_CONCURRENT_OPERATORS 16
+
+/**
+ * @brief Run independent operators that were set up, e.g. the branches of an Inception or fire module, in one
+ *        parallel region of the thread pool.
+ *
+ * Every thread of the pool that runs out of tiles of one operator continues with the tiles of the others, so the
+ * tails of the operators overlap instead of leaving threads idle between them. No operator may read what another
+ * one writes, as for concurrent qnnp_run_operator calls. Operators run on the threads of the pool regardless of
+ * their qnnp_scheduler. Fails without running any operator if one of them fails to pack its weights.
+ */
+enum qnnp_status qnnp_run_operators(
+    size_t operators_count,
+    const qnnp_operator_t* operators,
+    pthreadpool_t threadpool);
+
+enum qnnp_status qnnp_delete_operator(
+    qnnp_operator_t op);
+
+/** Number of threads qnnp_operator_stats::thread_compute_ns tells apart. */
+#define QNNP_MAX_PROFILED_THREADS 32
+
+/**
+ * @brief Where the setup and run calls of an operator spent their time, and how much work the runs did.
+ *
+ * QNNPACK only collects statistics when it is built with the QNNPACK_PROFILING CMake option, which reads the clock
+ * around every phase and every task of the parallel loops. Times are in nanoseconds and accumulate from the creation
+ * of the operator or the last qnnp_reset_operator_stats call. Phases of concurrent setup or run calls of the same
+ * operator may be lost.
+ */
+struct qnnp_operator_stats {
+  /** Number of successful setup calls. */
+  uint64_t setups;
+  /** Time of the successful setup calls, including indirection_ns. */
+  uint64_t setup_ns;
+  /** Time building or rebasing indirection buffers during setup. */
+  uint64_t indirection_ns;
+  /** Number of successful qnnp_run_operator calls. */
+  uint64_t runs;
+  /** Time of the successful qnnp_run_operator calls, including packing_ns and compute_ns. */
+  uint64_t run_ns;
+  /** Time packing weights created with QNNP_CREATE_FLAG_LAZY_PACKING on the first run. */
+  uint64_t packing_ns;
+  /**
+   * Wall time of the parallel loops that run microkernels, also by qnnp_run_convolution2d_nhwc_q8_rows. It exceeds
+   * the longest thread_compute_ns entry by the time spent distributing tasks and waiting for the slowest thread.
+   */
+  uint64_t compute_ns;
+  /**
+   * Time every thread spent in the tasks of the parallel loops. Threads are numbered in the order they first run a
+   * task of any operator, modulo QNNP_MAX_PROFILED_THREADS.
+   */
+  uint64_t thread_compute_ns[QNNP_MAX_PROFILED_THREADS];
+  /**
+   * Multiply-adds of the runs as given by the shapes: every output pixel of a convolution or fully-connected operator
+   * with every tap of the kernel, including taps in the padding, and every input pixel of a deconvolution with every
+   * tap. Only convolution, deconvolution, and fully-connected operators count macs, bytes_read, and bytes_written.
+   */
+  uint64_t macs;
+  /**
+   * Bytes of the input and of the packed weights read by the runs, counting every element once, i.e. a lower bound of
+   * the memory traffic.
+   */
+  uint64_t bytes_read;
+  /** Bytes of the output written by the runs. */
+  uint64_t bytes_written;
+};
+
+/**
+ * @brief Retrieve the statistics of an operator.
+ *
+ * Fails with qnnp_status_unsupported_parameter if QNNPACK was built without profiling.
+ */
+enum qnnp_status qnnp_get_operator_stats(
+    qnnp_operator_t op,
+    struct qnnp_operator_stats* stats);
+
+/**
+ * @brief Reset the statistics of an operator to zero, e.g. to exclude warm-up runs.
+ */
+enum qnnp_status qnnp_reset_operator_stats(
+    qnnp_operator_t op);
+
+/**
+ * @brief How a convolution, deconvolution, or fully-connected operator computes its output.
+ */
+enum qnnp_operator_path {
+  /** Other operators, which run no GEMM, convolution, or depthwise microkernels. */
+  qnnp_operator_path_none = 0,
+  /** GEMM microkernels read the input directly: fully-connected operators and 1x1 convolutions with unit stride. */
+  qnnp_operator_path_gemm = 1,
+  /** Convolution microkernels read the input through mr x kernel_size input pointers per tile. */
+  qnnp_operator_path_conv = 2,
+  /** Depthwise microkernels, for 3x3 and 5x5 convolutions with one input channel per group. */
+  qnnp_operator_path_depthwise = 3,
+  /** XZP GEMM microkernels, which add the input row sums times the kernel zero point after the GEMM. */
+  qnnp_operator_path_xzp_gemm = 4,
+  /** Winograd F(2x2, 3x3): products of transformed 4x4 input and kernel tiles, see QNNP_CREATE_FLAG_NO_WINOGRAD. */
+  qnnp_operator_path_winograd = 5,
+};
+
+/** Packed kernel holds signed values kernel - 128 for microkernels with signed multiplications. */
+#define QNNP_OPERATOR_INFO_FLAG_SIGNED_KERNEL 0x00000001
+/** Every output channel has its own requantization scale. */
+#define QNNP_OPERATOR_INFO_FLAG_PER_CHANNEL 0x00000002
+/** Microkernels requantize in FP32, see QNNP_CREATE_FLAG_FP32_REQUANTIZATION. */
+#define QNNP_OPERATOR_INFO_FLAG_FP32_REQUANTIZATION 0x00000004
+/** Strided deconvolution runs one dense convolution per stride phase of the output. */
+#define QNNP_OPERATOR_INFO_FLAG_SUBPIXEL 0x00000008
+/** Tiles compute their input pointers while running, see QNNP_CREATE_FLAG_TILE_INDIRECTION. */
+#define QNNP_OPERATOR_INFO_FLAG_TILE_INDIRECTION 0x00000010
+/** The indirection buffer holds 32-bit pixel indices shared by all groups and images instead of pointers. */
+#define QNNP_OPERATOR_INFO_FLAG_INDIRECTION_OFFSETS 0x00000020
+/** The reduction over input channels is split across threads, and split_k_buffer_size holds the partial sums. */
+#define QNNP_OPERATOR_INFO_FLAG_SPLIT_K 0x00000040
+/** Weights are packed; without it, packing happens on the first run, see QNNP_CREATE_FLAG_LAZY_PACKING. */
+#define QNNP_OPERATOR_INFO_FLAG_PACKED 0x00000080
+/** The GEMM microkernel accumulates in 16 bits, which the kernel and zero points guarantee cannot overflow. */
+#define QNNP_OPERATOR_INFO_FLAG_ACC16 0x00000100
+/** Several groups with few output channels share each microkernel call, with a block-diagonal packed kernel. */
+#define QNNP_OPERATOR_INFO_FLAG_GROUP_BLOCKS 0x00000200
+/** The kernel is packed as blocks of 4 input channels, skipping zero blocks, see QNNP_CREATE_FLAG_SPARSE_KERNEL. */
+#define QNNP_OPERATOR_INFO_FLAG_SPARSE 0x00000400
+/** The kernel is packed with 4 bits per value, see QNNP_CREATE_FLAG_4BIT_KERNEL. */
+#define QNNP_OPERATOR_INFO_FLAG_4BIT_KERNEL 0x00000800
+/** Outputs are 32-bit accumulators rather than requantized values, see qnnp_setup_fully_connected_nc_q8_s32. */
+#define QNNP_OPERATOR_INFO_FLAG_ACCUMULATOR_OUTPUT 0x00001000
+/** The packed bias includes the input zero point term, see QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT. */
+#define QNNP_OPERATOR_INFO_FLAG_FOLDED_ZERO_POINT 0x00002000
+/** The convolution microkernels fold the kernel zero point into sums of the input rows, as XZP GEMM does. */
+#define QNNP_OPERATOR_INFO_FLAG_XZP 0x00004000
+
+/**
+ * @brief Computation path, microkernels, and memory of an operator.
+ *
+ * Buffer sizes are for the shapes of the last setup, and zero before the first one, whether the operator allocated the
+ * buffers or the caller provided them as workspace and scratch.
+ */
+struct qnnp_operator_info {
+  enum qnnp_operator_path path;
+  /** Bitwise OR of QNNP_OPERATOR_INFO_FLAG_* values. */
+  uint32_t flags;
+  /**
+   * Tile and instruction set of the microkernels, e.g. "4x8c2__avx2" for q8gemm_ukernel_4x8c2__avx2 and
+   * q8conv_ukernel_4x8c2__avx2, or NULL for qnnp_operator_path_none. Threads on little cores of big.LITTLE systems may
+   * run microkernels of the same tile for another instruction schedule.
+   */
+  const char* ukernel;
+  /** Output pixels per microkernel call, 1 for depthwise microkernels. */
+  uint32_t mr;
+  /** Output channels per microkernel call, which the packed kernel rounds up to. */
+  uint32_t nr;
+  /** Input channels the packed kernel interleaves, and rounds up to, for every output channel; 0 for depthwise. */
+  uint32_t kr;
+  /** Input channels per block of XZP GEMM microkernels, and 0 on other paths. */
+  uint32_t kc;
+  /** Bytes of the packed kernel, which operators sharing packed weights share as well. */
+  size_t packed_kernel_size;
+  /** Bytes of the packed bias, which depthwise kernels interleave with the packed kernel instead. */
+  size_t bias_size;
+  /** Bytes of the indirection buffer, i.e. the workspace of qnnp_get_convolution2d_nhwc_q8_workspace_size. */
+  size_t im2col_buffer_size;
+  /** Bytes of the input with replicated channels of depthwise convolutions with a channel multiplier. */
+  size_t expanded_input_size;
+  /** Bytes of the 32-bit partial sums of split-K GEMM. */
+  size_t split_k_buffer_size;
+  /** Bytes of the 16-bit transformed input tiles of Winograd convolutions. */
+  size_t transformed_input_size;
+};
+
+/**
+ * @brief Retrieve the computation path, microkernels, and memory of an operator, e.g. to reshape layers for faster
+ *        paths or to account for the memory of a model.
+ */
+enum qnnp_status qnnp_get_operator_info(
+    qnnp_operator_t op,
+    struct qnnp_operator_info* info);
+
+/**
+ * @brief Retrieve a new reference to the packed weights of the operator; release it with qnnp_release_packed_weights.
+ */
+enum qnnp_status qnnp_get_packed_weights(
+    qnnp_operator_t op,
+    qnnp_packed_weights_t* packed_weights);
+
+/**
+ * @brief Release a reference to packed weights. The weights are freed once neither an operator nor the caller
+ *        references them.
+ */
+enum qnnp_status qnnp_release_packed_weights(
+    qnnp_packed_weights_t packed_weights);
+
+/**
+ * @brief Serialize a convolution, deconvolution, or fully-connected operator, including its packed weights, into a
+ *        versioned binary format that qnnp_create_operator_from_serialized loads without repacking.
+ *
+ * With NULL data, only stores the required size in data_size. The format depends on the architecture, and loading
+ * fails on other architectures or QNNPACK versions that do not understand it.
+ */
+enum qnnp_status qnnp_serialize_operator(
+    qnnp_operator_t op,
+    void* data,
+    size_t* data_size);
+
+/**
+ * @brief Create an operator from data written by qnnp_serialize_operator, e.g. in a memory-mapped file.
+ *
+ * The packed weights are used in place rather than copied: the data must stay valid and unmodified until the
+ * operator, and every operator created from its packed weights, is deleted. It must be at least 4-byte aligned; the
+ * weights are as aligned as the data up to 64 bytes. Creating the operator fails if no microkernel of this process
+ * matches the tile the weights were packed for.
+ */
+enum qnnp_status qnnp_create_operator_from_serialized(
+    const void* data,
+    size_t data_size,
+    qnnp_operator_t* op);
+
+/**
+ * @brief Create an operator from a file written with the data of qnnp_serialize_operator, mapped read-only.
+ *
+ * The packed weights are used in place in a shared mapping of the file, so processes that load the same file share
+ * one copy of the weights in the page cache rather than each holding its own. The mapping is released with the
+ * last operator that references the packed weights, including those created from them with qnnp_get_packed_weights.
+ * The file must not be modified while it is mapped.
+ */
+enum qnnp_status qnnp_create_operator_from_file(
+    const char* path,
+    qnnp_operator_t* op);
+
+/**
+ * @brief Create an operator with the same parameters as a convolution, deconvolution, or fully-connected operator,
+ *        which shares its packed weights.
+ *
+ * Operators hold the buffers and pointers of their last setup, so one operator cannot be set up by several threads
+ * at once. Clones share the immutable packed kernel and bias and have their own setup state, so every thread of a
+ * server can set up and run its own clone concurrently with one copy of the weights in memory. A clone runs on the
+ * same path as the operator, but a convolution created with QNNP_CREATE_FLAG_CALIBRATE_XZP clones without the
+ * calibration. Operators with per-channel scales and FP32 or FP16 operators cannot be cloned.
+ */
+enum qnnp_status qnnp_clone_operator(
+    qnnp_operator_t op,
+    qnnp_operator_t* clone);
+
+typedef struct qnnp_plan* qnnp_plan_t;
+
+/**
+ * @brief Create an execution plan for a chain of operators on NHWC inputs of the given shape.
+ *
+ * The output of every operator feeds the next one. Intermediate tensors are densely packed (pixel stride equals
+ * the number of channels). They live, together with the internal buffers of the operators, in a single block of
+ * memory, where buffers with disjoint lifetimes share space. The plan allocates this memory on the first run unless
+ * the caller provides it with qnnp_plan_set_memory.
+ */
+enum qnnp_status qnnp_create_plan(
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t input_channels,
+    qnnp_plan_t* plan);
+
+/**
+ * @brief Append a convolution, deconvolution, or fully-connected operator to the plan.
+ *
+ * A fully-connected operator consumes either every pixel of the previous output (when its input channels match the
+ * previous output channels), or every image flattened into a single row. The plan does not take ownership of the
+ * operator, which must outlive the plan and must not be set up by the caller while the plan is in use.
+ */
+enum qnnp_status qnnp_plan_add_operator(
+    qnnp_plan_t plan,
+    qnnp_operator_t op);
+
+/**
+ * @brief Retrieve the shape of the plan output, i.e. of the output of the last operator.
+ */
+enum qnnp_status qnnp_get_plan_output_shape(
+    qnnp_plan_t plan,
+    size_t* output_height,
+    size_t* output_width,
+    size_t* output_channels);
+
+/**
+ * @brief Retrieve the size of the memory the plan needs for intermediate tensors and operator buffers.
+ */
+enum qnnp_status qnnp_get_plan_memory_size(
+    qnnp_plan_t plan,
+    size_t* memory_size);
+
+/**
+ * @brief Use caller-owned memory, aligned to 16 bytes and at least qnnp_get_plan_memory_size bytes large, for
+ *        intermediate tensors and operator buffers instead of a plan-owned allocation.
+ *
+ * The memory must stay valid until the plan is deleted or gets other memory; passing NULL returns to plan-owned
+ * memory. Adding operators changes the required size, in which case the memory must be set again.
+ */
+enum qnnp_status qnnp_plan_set_memory(
+    qnnp_plan_t plan,
+    void* memory,
+    size_t memory_size);
+
+/**
+ * @brief Run the operators of the plan on the threads of an affinity pool instead of the thread pool of
+ *        qnnp_plan_run, or on their own schedulers again if the pool is NULL.
+ *
+ * With spin_wait, the threads of the pool poll for the next parallel loop while the plan runs, rather than sleeping
+ * between operators, trading processor time for latency on layers that take as long as waking the threads. Threads
+ * sleep again shortly after the run, or after a serial operator that takes longer than a millisecond.
+ */
+enum qnnp_status qnnp_plan_set_affinity_pool(
+    qnnp_plan_t plan,
+    qnnp_affinity_pool_t pool,
+    bool spin_wait);
+
+/**
+ * @brief Run operators of the plan with fewer multiply-adds than the threshold on the calling thread alone.
+ *
+ * Multiply-adds are counted as in qnnp_operator_stats::macs. Small layers spend about as long distributing tasks to
+ * threads as computing them, and the default threshold of 0 runs every operator in parallel.
+ */
+enum qnnp_status qnnp_plan_set_serial_threshold(
+    qnnp_plan_t plan,
+    uint64_t macs_threshold);
+
+/**
+ * @brief Run all operators of the plan.
+ *
+ * Operators are set up on the first run; later runs only set up the first and last operator again, and only when
+ * the input or output pointer changed.
+ */
+enum qnnp_status qnnp_plan_run(
+    qnnp_plan_t plan,
+    const uint8_t* input,
+    uint8_t* output,
+    pthreadpool_t threadpool);
+
+/**
+ * @brief Serialize a plan that ran, with its operators, memory layout, and indirection buffers, into a snapshot that
+ *        qnnp_create_plan_from_serialized restores without packing weights or building indirection buffers.
+ *
+ * With NULL data, only stores the required size in data_size. Indirection buffers are stored as offsets from the
+ * tensors they point into. Operators must be serializable with qnnp_serialize_operator. A snapshot only restores
+ * with the same instruction set extensions and microkernels it was written with, so a process that autotunes
+ * should pass the tuning result of the process that wrote the snapshot to qnnp_initialize_with_options.
+ */
+enum qnnp_status qnnp_serialize_plan(
+    qnnp_plan_t plan,
+    void* data,
+    size_t* data_size);
+
+/**
+ * @brief Create a plan from a snapshot written by qnnp_serialize_plan, with its own operators.
+ *
+ * Packed weights and indirection buffers are used in place: the data must stay valid and unmodified until the plan
+ * is deleted, and be at least 8-byte aligned. Restoring fails with qnnp_status_unsupported_parameter if this process
+ * selected other microkernels, e.g. on a processor with other instruction set extensions. The first run copies the
+ * indirection buffers into plan memory and points them to the input, which takes a pass over them instead of
+ * building them. The plan deletes its operators with itself.
+ */
+enum qnnp_status qnnp_create_plan_from_serialized(
+    const void* data,
+    size_t data_size,
+    qnnp_plan_t* plan);
+
+/**
+ * @brief Create a plan from a file written with the data of qnnp_serialize_plan, mapped read-only once.
+ *
+ * As for qnnp_create_operator_from_file, processes that restore the same file share its weights in the page cache.
+ * The mapping is released with the plan. The file must not be modified while it is mapped.
+ */
+enum qnnp_status qnnp_create_plan_from_file(
+    const char* path,
+    qnnp_plan_t* plan);
+
+enum qnnp_status qnnp_delete_plan(
+    qnnp_plan_t plan);
+
+/**
+ * @brief Queue of asynchronous runs of operators and plans on a thread pool.
+ *
+ * A queue owns one dispatch thread, which runs the submitted work in submission order on the thread pool while the
+ * submitting threads continue. Runs of several queues that share a thread pool take turns on it.
+ */
+typedef struct qnnp_queue* qnnp_queue_t;
+
+/**
+ * @brief Called on the dispatch thread of the queue with the status of an asynchronous run once it completed.
+ *
+ * The callback may submit more work to the queue, but must not wait for or delete it.
+ */
+typedef void (*qnnp_completion_callback)(void* context, enum qnnp_status status);
+
+enum qnnp_status qnnp_create_queue(
+    pthreadpool_t threadpool,
+    qnnp_queue_t* queue);
+
+/**
+ * @brief Run an operator that was set up on the queue, and invoke the callback, if not NULL, once it completed.
+ *
+ * The operator, its input and its output must not be used by the caller until the callback was invoked.
+ */
+enum qnnp_status qnnp_run_operator_async(
+    qnnp_operator_t op,
+    qnnp_queue_t queue,
+    qnnp_completion_callback callback,
+    void* context);
+
+/**
+ * @brief Run all operators of the plan on the queue, and invoke the callback, if not NULL, once they completed.
+ *
+ * The plan, the input and the output must not be used by the caller until the callback was invoked.
+ */
+enum qnnp_status qnnp_plan_run_async(
+    qnnp_plan_t plan,
+    const uint8_t* input,
+    uint8_t* output,
+    qnnp_queue_t queue,
+    qnnp_completion_callback callback,
+    void* context);
+
+/**
+ * @brief Wait until all work submitted to the queue completed, including the callbacks.
+ */
+enum qnnp_status qnnp_wait_queue(
+    qnnp_queue_t queue);
+
+/**
+ * @brief Wait for the work submitted to the queue, and delete it.
+ */
+enum qnnp_status qnnp_delete_queue(
+    qnnp_queue_t queue);
+
+/**
+ * @brief Coalescing of single-row requests from many callers into batches of a fully-connected operator.
+ *
+ * Each run of a fully-connected operator reads all of its packed weights, whether for one row or for many, so
+ * serving concurrent batch-1 requests one by one reads the weights once per request. A batcher owns one dispatch
+ * thread, which collects requests until max_batch_size of them are pending or window_us microseconds passed since
+ * the oldest one arrived, copies their inputs side by side, sets the operator up and runs it once on the thread pool
+ * for the whole batch, and scatters the output rows back to the requests. A window of 0 runs the requests pending
+ * when the dispatch thread gets to them without waiting for more.
+ *
+ * The batcher sets the fully-connected operator up for every batch, so the caller must not set it up or run it
+ * until the batcher was deleted. Operators created with QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT are not supported.
+ */
+typedef struct qnnp_batcher* qnnp_batcher_t;
+
+enum qnnp_status qnnp_create_batcher(
+    qnnp_operator_t fully_connected,
+    size_t max_batch_size,
+    uint64_t window_us,
+    pthreadpool_t threadpool,
+    qnnp_batcher_t* batcher);
+
+/**
+ * @brief Submit one row of input channels to the batcher, and invoke the callback, if not NULL, on the dispatch
+ *        thread once its row of output channels was stored.
+ *
+ * The input and output must not be used by the caller until the callback was invoked. The callback may submit more
+ * requests, but must not wait for or delete the batcher.
+ */
+enum qnnp_status qnnp_batcher_submit(
+    qnnp_batcher_t batcher,
+    const uint8_t* input,
+    uint8_t* output,
+    qnnp_completion_callback callback,
+    void* context);
+
+/**
+ * @brief Wait until all requests submitted to the batcher completed, including the callbacks.
+ */
+enum qnnp_status qnnp_wait_batcher(
+    qnnp_batcher_t batcher);
+
+/**
+ * @brief Run the submitted requests without waiting for their windows, and delete the batcher.
+ */
+enum qnnp_status qnnp_delete_batcher(
+    qnnp_batcher_t batcher);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef _GNU_SOURCE
+  #define _GNU_SOURCE
+#endif
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <cpuinfo.h>
+
+#include <qnnpack.h>
+#include <qnnpack/affinity-pool.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+
+/* Threads that spin go to sleep after this time without a new loop, e.g. while the caller runs a serial operator */
+#define QNNP_AFFINITY_POOL_MAX_SPIN_NS 1000000
+/* Polls between reads of the clock while spinning, after which spinning threads yield to others on their processor */
+#define QNNP_AFFINITY_POOL_SPIN_POLLS 256
+
+struct affinity_thread {
+  struct qnnp_affinity_pool* pool;
+  pthread_t thread;
+  /* Processor number of the operating system */
+  int processor_id;
+};
+
+struct qnnp_affinity_pool {
+  struct affinity_thread* threads;
+  size_t threads_count;
+  /* Serializes the loops of operators that run on the pool from different threads */
+  pthread_mutex_t loop_mutex;
+  pthread_mutex_t mutex;
+  /* Signaled when a loop starts or the pool shuts down */
+  pthread_cond_t started;
+  /* Signaled when the last thread finished its tasks of the loop, or pinned itself on creation */
+  pthread_cond_t finished;
+  /* Incremented for every loop, so that threads run each loop once; spinning threads read it without the mutex */
+  uint64_t loop_index;
+  qnnp_task_function task;
+  void* task_context;
+  size_t tasks;
+  size_t next_task;
+  /* Threads that have not finished the current loop, or have not pinned themselves yet */
+  size_t active_threads;
+  /* Threads that wait on the started condition, which a new loop must wake */
+  size_t sleeping_threads;
+  /* Number of qnnp_affinity_pool_begin_spin_wait calls without their end call, updated without the mutex */
+  uint32_t spin_waits;
+  /* Threads that failed to pin themselves to their processor */
+  size_t unpinned_threads;
+  bool shutdown;
+};
+
+static bool pin_thread(int processor_id) {
+#if defined(__linux__) || defined(__ANDROID__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(processor_id, &set);
+  /* Process ID 0 is the calling thread on Linux */
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+static uint64_t get_time_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * UINT64_C(1000000000) + (uint64_t) ts.tv_nsec;
+}
+
+/*
+ * Polls for a loop after loop_index while spin waits are active, for at most QNNP_AFFINITY_POOL_MAX_SPIN_NS. Returns
+ * without the mutex, which the caller must reacquire.
+ */
+static void spin_for_loop(struct qnnp_affinity_pool* pool, uint64_t loop_index) {
+  const uint64_t start = get_time_ns();
+  for (;;) {
+    for (uint32_t i = 0; i < QNNP_AFFINITY_POOL_SPIN_POLLS; i++) {
+      if (__atomic_load_n(&pool->loop_index, __ATOMIC_RELAXED) != loop_index ||
+          __atomic_load_n(&pool->spin_waits, __ATOMIC_RELAXED) == 0)
+      {
+        return;
+      }
+    }
+    if (get_time_ns() - start >= QNNP_AFFINITY_POOL_MAX_SPIN_NS) {
+      return;
+    }
+    sched_yield();
+  }
+}
+
+/* Polls for the end of the loop for at most QNNP_AFFINITY_POOL_MAX_SPIN_NS, without the mutex */
+static void spin_for_threads(struct qnnp_affinity_pool* pool) {
+  const uint64_t start = get_time_ns();
+  for (;;) {
+    for (uint32_t i = 0; i < QNNP_AFFINITY_POOL_SPIN_POLLS; i++) {
+      if (__atomic_load_n(&pool->active_threads, __ATOMIC_ACQUIRE) == 0) {
+        return;
+      }
+    }
+    if (get_time_ns() - start >= QNNP_AFFINITY_POOL_MAX_SPIN_NS) {
+      return;
+    }
+    sched_yield();
+  }
+}
+
+static void* run_affinity_thread(void* argument) {
+  struct affinity_thread* thread = (struct affinity_thread*) argument;
+  struct qnnp_affinity_pool* pool = thread->pool;
+  const bool pinned = pin_thread(thread->processor_id);
+
+  pthread_mutex_lock(&pool->mutex);
+  if (!pinned) {
+    pool->unpinned_threads++;
+  }
+  if (--pool->active_threads == 0) {
+    pthread_cond_signal(&pool->finished);
+  }
+  uint64_t loop_index = pool->loop_index;
+  for (;;) {
+    const bool spin = __atomic_load_n(&pool->spin_waits, __ATOMIC_RELAXED) != 0;
+    if (spin && pool->loop_index == loop_index && !pool->shutdown) {
+      pthread_mutex_unlock(&pool->mutex);
+      spin_for_loop(pool, loop_index);
+      pthread_mutex_lock(&pool->mutex);
+    }
+    while (pool->loop_index == loop_index && !pool->shutdown) {
+      pool->sleeping_threads++;
+      pthread_cond_wait(&pool->started, &pool->mutex);
+      pool->sleeping_threads--;
+    }
+    if (pool->shutdown) {
+      break;
+    }
+    loop_index = pool->loop_index;
+    const qnnp_task_function task = pool->task;
+    void* task_context = pool->task_context;
+    const size_t tasks = pool->tasks;
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (size_t i = __atomic_fetch_add(&pool->next_task, 1, __ATOMIC_RELAXED); i < tasks;
+         i = __atomic_fetch_add(&pool->next_task, 1, __ATOMIC_RELAXED))
+    {
+      task(task_context, i);
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    if (__atomic_sub_fetch(&pool->active_threads, 1, __ATOMIC_RELEASE) == 0) {
+      pthread_cond_signal(&pool->finished);
+    }
+  }
+  pthread_mutex_unlock(&pool->mutex);
+  return NULL;
+}
+
+static void parallelize_affinity_pool(
+    void* context,
+    qnnp_task_function task,
+    void* task_context,
+    size_t tasks)
+{
+  struct qnnp_affinity_pool* pool = (struct qnnp_affinity_pool*) context;
+  pthread_mutex_lock(&pool->loop_mutex);
+  pthread_mutex_lock(&pool->mutex);
+  pool->task = task;
+  pool->task_context = task_context;
+  pool->tasks = tasks;
+  pool->next_task = 0;
+  pool->active_threads = pool->threads_count;
+  __atomic_store_n(&pool->loop_index, pool->loop_index + 1, __ATOMIC_RELAXED);
+  /* Spinning threads see the new loop index, and take the mutex to read the loop */
+  if (pool->sleeping_threads != 0) {
+    pthread_cond_broadcast(&pool->started);
+  }
+  if (__atomic_load_n(&pool->spin_waits, __ATOMIC_RELAXED) != 0) {
+    pthread_mutex_unlock(&pool->mutex);
+    spin_for_threads(pool);
+    pthread_mutex_lock(&pool->mutex);
+  }
+  /* The mutex orders the tasks of the threads before the return */
+  while (pool->active_threads != 0) {
+    pthread_cond_wait(&pool->finished, &pool->mutex);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+  pthread_mutex_unlock(&pool->loop_mutex);
+}
+
+/* Stops and joins the first threads_count threads of the pool, and frees it */
+static void destroy_affinity_pool(struct qnnp_affinity_pool* pool, size_t threads_count) {
+  pthread_mutex_lock(&pool->mutex);
+  pool->shutdown = true;
+  pthread_cond_broadcast(&pool->started);
+  pthread_mutex_unlock(&pool->mutex);
+  for (size_t i = 0; i < threads_count; i++) {
+    pthread_join(pool->threads[i].thread, NULL);
+  }
+  pthread_cond_destroy(&pool->finished);
+  pthread_cond_destroy(&pool->started);
+  pthread_mutex_destroy(&pool->mutex);
+  pthread_mutex_destroy(&pool->loop_mutex);
+  free(pool->threads);
+  free(pool);
+}
+
+enum qnnp_status qnnp_create_affinity_pool(
+    size_t processors_count,
+    const uint32_t* processors,
+    qnnp_affinity_pool_t* pool_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_affinity_pool failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (processors_count == 0) {
+    qnnp_log_error(
+      "failed to create affinity pool with %zu processors: number of processors must be non-zero", processors_count);
+    return qnnp_status_invalid_parameter;
+  }
+
+#if !defined(__linux__) && !defined(__ANDROID__)
+  qnnp_log_error("failed to create affinity pool: threads can only be pinned to processors on Linux and Android");
+  return qnnp_status_unsupported_hardware;
+#else
+  for (size_t i = 0; i < processors_count; i++) {
+    if (processors[i] >= cpuinfo_get_processors_count()) {
+      qnnp_log_error(
+        "failed to create affinity pool with processor %" PRIu32 ": processor index must be below %" PRIu32,
+        processors[i], cpuinfo_get_processors_count());
+      return qnnp_status_invalid_parameter;
+    }
+  }
+
+  struct qnnp_affinity_pool* pool = calloc(1, sizeof(struct qnnp_affinity_pool));
+  if (pool == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_affinity_pool structure", sizeof(struct qnnp_affinity_pool));
+    return qnnp_status_out_of_memory;
+  }
+  pool->threads = calloc(processors_count, sizeof(struct affinity_thread));
+  if (pool->threads == NULL) {
+    qnnp_log_error(
+      "failed to allocate %zu bytes for affinity pool threads", processors_count * sizeof(struct affinity_thread));
+    free(pool);
+    return qnnp_status_out_of_memory;
+  }
+  pool->threads_count = processors_count;
+  pthread_mutex_init(&pool->loop_mutex, NULL);
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->started, NULL);
+  pthread_cond_init(&pool->finished, NULL);
+
+  /* Every thread pins itself before the pool is returned */
+  pool->active_threads = processors_count;
+  for (size_t i = 0; i < processors_count; i++) {
+    struct affinity_thread* thread = &pool->threads[i];
+    thread->pool = pool;
+    thread->processor_id = cpuinfo_get_processor(processors[i])->linux_id;
+    const int error = pthread_create(&thread->thread, NULL, run_affinity_thread, thread);
+    if (error != 0) {
+      qnnp_log_error("failed to create thread %zu of affinity pool: error %d", i, error);
+      destroy_affinity_pool(pool, i);
+      return qnnp_status_out_of_memory;
+    }
+  }
+  pthread_mutex_lock(&pool->mutex);
+  while (pool->active_threads != 0) {
+    pthread_cond_wait(&pool->finished, &pool->mutex);
+  }
+  const size_t unpinned_threads = pool->unpinned_threads;
+  pthread_mutex_unlock(&pool->mutex);
+  if (unpinned_threads != 0) {
+    qnnp_log_error(
+      "failed to create affinity pool: %zu of %zu threads could not be pinned to their processor",
+      unpinned_threads, processors_count);
+    destroy_affinity_pool(pool, processors_count);
+    return qnnp_status_unsupported_hardware;
+  }
+
+  *pool_out = pool;
+  return qnnp_status_success;
+#endif
+}
+
+enum qnnp_status qnnp_create_cluster_affinity_pool(
+    uint32_t cluster_index,
+    qnnp_affinity_pool_t* pool_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_cluster_affinity_pool failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (cluster_index >= cpuinfo_get_clusters_count()) {
+    qnnp_log_error(
+      "failed to create affinity pool for cluster %" PRIu32 ": cluster index must be below %" PRIu32,
+      cluster_index, cpuinfo_get_clusters_count());
+    return qnnp_status_invalid_parameter;
+  }
+
+  const struct cpuinfo_cluster* cluster = cpuinfo_get_cluster(cluster_index);
+  uint32_t* processors = malloc(cluster->processor_count * sizeof(uint32_t));
+  if (processors == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for cluster processors", cluster->processor_count * sizeof(uint32_t));
+    return qnnp_status_out_of_memory;
+  }
+  for (uint32_t i = 0; i < cluster->processor_count; i++) {
+    processors[i] = cluster->processor_start + i;
+  }
+  const enum qnnp_status status = qnnp_create_affinity_pool(cluster->processor_count, processors, pool_out);
+  free(processors);
+  return status;
+}
+
+enum qnnp_status qnnp_get_affinity_pool_scheduler(
+    qnnp_affinity_pool_t pool,
+    struct qnnp_scheduler* scheduler)
+{
+  *scheduler = (struct qnnp_scheduler) {
+    .parallelize = parallelize_affinity_pool,
+    .context = (void*) pool,
+    .threads_count = pool->threads_count,
+  };
+  return qnnp_status_success;
+}
+
+void qnnp_affinity_pool_begin_spin_wait(struct qnnp_affinity_pool* pool) {
+  __atomic_add_fetch(&pool->spin_waits, 1, __ATOMIC_RELAXED);
+}
+
+void qnnp_affinity_pool_end_spin_wait(struct qnnp_affinity_pool* pool) {
+  __atomic_sub_fetch(&pool->spin_waits, 1, __ATOMIC_RELAXED);
+}
+
+enum qnnp_status qnnp_delete_affinity_pool(qnnp_affinity_pool_t pool)
+{
+  if (pool != NULL) {
+    destroy_affinity_pool(pool, pool->threads_count);
+  }
+  return qnnp_status_success;
+}
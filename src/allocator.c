@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <qnnpack.h>
+#include <qnnpack/allocator.h>
+
+/* Size of a transparent huge page on x86-64 and on ARM64 with 4 KB pages */
+#define QNNP_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+static void* default_allocate(void* context, size_t size) {
+  return malloc(size);
+}
+
+static void* default_reallocate(void* context, void* pointer, size_t size) {
+  return realloc(pointer, size);
+}
+
+static void default_deallocate(void* context, void* pointer) {
+  free(pointer);
+}
+
+static void* default_aligned_allocate(void* context, size_t alignment, size_t size) {
+#ifdef __linux__
+  /* Huge pages cut the TLB misses of microkernels streaming through large weights */
+  if (size >= QNNP_HUGE_PAGE_SIZE) {
+    alignment = QNNP_HUGE_PAGE_SIZE;
+  }
+#endif
+  if (alignment < sizeof(void*)) {
+    alignment = sizeof(void*);
+  }
+  void* pointer = NULL;
+  if (posix_memalign(&pointer, alignment, size) != 0) {
+    return NULL;
+  }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (size >= QNNP_HUGE_PAGE_SIZE) {
+    /* Only a hint: the kernel may lack support or have it disabled, and the memory is usable either way */
+    madvise(pointer, size & -(size_t) QNNP_HUGE_PAGE_SIZE, MADV_HUGEPAGE);
+  }
+#endif
+  return pointer;
+}
+
+struct qnnp_allocator qnnp_allocator = {
+  .context = NULL,
+  .allocate = default_allocate,
+  .reallocate = default_reallocate,
+  .deallocate = default_deallocate,
+  .aligned_allocate = default_aligned_allocate,
+  .aligned_deallocate = default_deallocate,
+};
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+
+
+enum qnnp_status qnnp_create_argmax_nc_q8(
+    size_t channels,
+    uint32_t flags,
+    qnnp_operator_t* argmax_out)
+{
+  qnnp_operator_t argmax_op = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_argmax_nc_q8 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (channels == 0) {
+    qnnp_log_error(
+      "failed to create argmax operator with %zu channels: number of channels must be non-zero", channels);
+    goto error;
+  }
+
+  status = qnnp_status_unsupported_parameter;
+
+  if (channels > (size_t) UINT32_MAX) {
+    qnnp_log_error(
+      "failed to create argmax operator with %zu channels: channel indices must fit in 32 bits", channels);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  argmax_op = calloc(1, sizeof(struct qnnp_operator));
+  if (argmax_op == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  argmax_op->channels = channels;
+
+  argmax_op->type = qnnp_operator_type_argmax;
+  argmax_op->format = qnnp_format_quint8;
+
+  *argmax_out = argmax_op;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(argmax_op);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_argmax_nc_q8(
+    qnnp_operator_t argmax_op,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    uint32_t* output,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_argmax_nc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (argmax_op->type != qnnp_operator_type_argmax) {
+    qnnp_log_error("failed to setup argmax operator: operator was not created by qnnp_create_argmax_nc_q8");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup argmax operator with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t channels = argmax_op->channels;
+  if (input_stride < channels) {
+    qnnp_log_error(
+      "failed to setup argmax operator with %zu input stride: stride must be at least the %zu channels",
+      input_stride, channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  argmax_op->batch_size = batch_size;
+  argmax_op->input = input;
+  argmax_op->input_pixel_stride = input_stride;
+  argmax_op->output = output;
+  argmax_op->output_pixel_stride = 1;
+
+  return qnnp_status_success;
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <qnnpack.h>
+#include <qnnpack/allocator.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+#include <qnnpack/requantization.h>
+
+
+enum qnnp_status qnnp_create_average_pooling2d_nhwc_q8(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t pooling_height,
+    uint32_t pooling_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    size_t channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* average_pooling_out)
+{
+  qnnp_operator_t average_pooling = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_average_pooling2d_nhwc_q8 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (pooling_height == 0 || pooling_width == 0) {
+    qnnp_log_error(
+      "failed to create average pooling with %" PRIu32 "x%" PRIu32 " pooling size: "
+      "pooling size dimensions must be non-zero",
+      pooling_width, pooling_height);
+    goto error;
+  }
+
+  if (pooling_height == 1 && pooling_width == 1) {
+    qnnp_log_error(
+      "failed to create average pooling with 1 pooling element: 1x1 pooling is meaningless");
+    goto error;
+  }
+
+  if (stride_height == 0 || stride_width == 0) {
+    qnnp_log_error(
+      "failed to create average pooling with %" PRIu32 "x%" PRIu32 " stride: stride dimensions must be non-zero",
+      stride_width, stride_height);
+    goto error;
+  }
+
+  if (channels == 0 || channels > UINT32_MAX) {
+    qnnp_log_error(
+      "failed to create average pooling with %zu channels: number of channels must be non-zero and fit in 32 bits",
+      channels);
+    goto error;
+  }
+
+  if (!(input_scale > 0.0f && isnormal(input_scale)) || !(output_scale > 0.0f && isnormal(output_scale))) {
+    qnnp_log_error(
+      "failed to create average pooling with %.7g input scale and %.7g output scale: "
+      "scales must be finite, normalized, and positive",
+      input_scale, output_scale);
+    goto error;
+  }
+
+  if (output_min >= output_max) {
+    qnnp_log_error(
+      "failed to create average pooling with [%" PRIu8 ", %" PRIu8 "] output range: range min must be below range max",
+      output_min, output_max);
+    goto error;
+  }
+
+  status = qnnp_status_unsupported_parameter;
+
+  /* Accumulators hold the sum of pooling_size inputs less zero point in 32 bits */
+  if ((size_t) pooling_height * (size_t) pooling_width > (size_t) (INT32_MAX / UINT8_MAX)) {
+    qnnp_log_error(
+      "failed to create average pooling with %" PRIu32 "x%" PRIu32 " pooling size: "
+      "pooling size must not exceed %d elements",
+      pooling_width, pooling_height, INT32_MAX / UINT8_MAX);
+    goto error;
+  }
+
+  const uint32_t pooling_size = pooling_height * pooling_width;
+  const float requantization_scale = input_scale / (output_scale * (float) pooling_size);
+  if (requantization_scale >= 1.0f) {
+    qnnp_log_error(
+      "failed to create average pooling with %" PRIu32 " pooling elements and %.7g input-to-output scale ratio: "
+      "requantization scale %.7g is greater or equal to 1.0",
+      pooling_size, input_scale / output_scale, requantization_scale);
+    goto error;
+  }
+  if (requantization_scale < 0x1.0p-32f) {
+    qnnp_log_error(
+      "failed to create average pooling with %" PRIu32 " pooling elements and %.7g input-to-output scale ratio: "
+      "requantization scale %.7g is below 2**-32",
+      pooling_size, input_scale / output_scale, requantization_scale);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  average_pooling = calloc(1, sizeof(struct qnnp_operator));
+  if (average_pooling == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  /* Pooling is a depthwise convolution without weights, and builds the same indirection buffer */
+  uint32_t convolution_flags = QNNP_CONVOLUTION_FLAG_DW;
+  if ((input_padding_left | input_padding_top | input_padding_right | input_padding_bottom) != 0) {
+    convolution_flags |= QNNP_CONVOLUTION_FLAG_ZERO;
+
+    const size_t zero_size = sizeof(uint8_t) * channels + (channels >= 8 ? 0 : 8);
+    average_pooling->zero = qnnp_allocate_weights(zero_size);
+    if (average_pooling->zero == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for zero padding", zero_size);
+      goto error;
+    }
+    memset(average_pooling->zero, input_zero_point, zero_size);
+  }
+
+  average_pooling->input_padding_top = input_padding_top;
+  average_pooling->input_padding_right = input_padding_right;
+  average_pooling->input_padding_bottom = input_padding_bottom;
+  average_pooling->input_padding_left = input_padding_left;
+
+  average_pooling->kernel_height = pooling_height;
+  average_pooling->kernel_width = pooling_width;
+  average_pooling->stride_height = stride_height;
+  average_pooling->stride_width = stride_width;
+  average_pooling->dilation_height = 1;
+  average_pooling->dilation_width = 1;
+  average_pooling->groups = (uint32_t) channels;
+  average_pooling->group_input_channels = 1;
+  average_pooling->group_output_channels = 1;
+  average_pooling->channels = channels;
+
+  average_pooling->input_zero_point = input_zero_point;
+
+  average_pooling->requantization_params =
+    qnnp_compute_requantization_params(
+      requantization_scale, output_zero_point, output_min, output_max);
+  average_pooling->requantization_scale = requantization_scale;
+  average_pooling->output_zero_point = output_zero_point;
+  average_pooling->output_min = output_min;
+  average_pooling->output_max = output_max;
+
+  average_pooling->type = qnnp_operator_type_average_pooling;
+  average_pooling->format = qnnp_format_quint8;
+  average_pooling->flags = convolution_flags;
+
+  *average_pooling_out = average_pooling;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(average_pooling);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_average_pooling2d_nhwc_q8(
+    qnnp_operator_t average_pooling,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_average_pooling2d_nhwc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup average pooling with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (input_width == 0 || input_height == 0) {
+    qnnp_log_error(
+      "failed to setup average pooling with %zux%zu input: input dimensions must be non-zero",
+      input_width, input_height);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t channels = average_pooling->channels;
+  if (input_pixel_stride < channels || output_pixel_stride < channels) {
+    qnnp_log_error(
+      "failed to setup average pooling with %zu input pixel stride and %zu output pixel stride: "
+      "strides must be at least the %zu channels",
+      input_pixel_stride, output_pixel_stride, channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t padded_input_height =
+    average_pooling->input_padding_top + input_height + average_pooling->input_padding_bottom;
+  const size_t padded_input_width =
+    average_pooling->input_padding_left + input_width + average_pooling->input_padding_right;
+  if (padded_input_height < average_pooling->kernel_height || padded_input_width < average_pooling->kernel_width) {
+    qnnp_log_error(
+      "failed to setup average pooling with %zux%zu padded input: "
+      "padded input must be at least as large as the %" PRIu32 "x%" PRIu32 " pooling window",
+      padded_input_width, padded_input_height, average_pooling->kernel_width, average_pooling->kernel_height);
+    return qnnp_status_invalid_parameter;
+  }
+
+  return qnnp_setup_convolution_indirection(
+    average_pooling,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride,
+    output, output_pixel_stride);
+}
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+#include <qnnpack/allocator.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+
+/* One row of a caller, and when it arrived on the realtime clock of pthread_cond_timedwait */
+struct qnnp_batcher_request {
+  struct qnnp_batcher_request* next;
+  const uint8_t* input;
+  uint8_t* output;
+  qnnp_completion_callback callback;
+  void* context;
+  struct timespec arrival;
+};
+
+struct qnnp_batcher {
+  qnnp_operator_t fully_connected;
+  pthreadpool_t threadpool;
+  size_t max_batch_size;
+  uint64_t window_ns;
+  /* Inputs of the requests of a batch side by side, and the outputs of the batch before they are scattered */
+  uint8_t* batch_input;
+  uint8_t* batch_output;
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  /* Signaled when a request is submitted or the batcher shuts down */
+  pthread_cond_t submitted;
+  /* Signaled when the last pending request completed */
+  pthread_cond_t idle;
+  struct qnnp_batcher_request* first_request;
+  struct qnnp_batcher_request* last_request;
+  /* Requests in the list, and requests submitted and not yet completed, including those of the batch that runs */
+  size_t queued_requests;
+  size_t pending_requests;
+  bool shutdown;
+};
+
+static struct timespec add_time_ns(struct timespec ts, uint64_t ns) {
+  ns += (uint64_t) ts.tv_nsec;
+  ts.tv_sec += (time_t) (ns / UINT64_C(1000000000));
+  ts.tv_nsec = (long) (ns % UINT64_C(1000000000));
+  return ts;
+}
+
+/* Copies the inputs of the requests side by side, runs them as one batch, and scatters the outputs */
+static void run_batch(struct qnnp_batcher* batcher, struct qnnp_batcher_request* requests, size_t batch_size) {
+  const size_t input_channels = batcher->fully_connected->group_input_channels;
+  const size_t output_channels = batcher->fully_connected->group_output_channels;
+
+  size_t i = 0;
+  for (const struct qnnp_batcher_request* request = requests; request != NULL; request = request->next) {
+    memcpy(batcher->batch_input + i++ * input_channels, request->input, input_channels);
+  }
+
+  enum qnnp_status status = qnnp_setup_fully_connected_nc_q8(
+    batcher->fully_connected, batch_size,
+    batcher->batch_input, input_channels,
+    batcher->batch_output, output_channels,
+    batcher->threadpool);
+  if (status == qnnp_status_success) {
+    status = qnnp_run_operator(batcher->fully_connected, batcher->threadpool);
+  }
+
+  i = 0;
+  while (requests != NULL) {
+    struct qnnp_batcher_request* request = requests;
+    requests = request->next;
+    if (status == qnnp_status_success) {
+      memcpy(request->output, batcher->batch_output + i++ * output_channels, output_channels);
+    }
+    if (request->callback != NULL) {
+      request->callback(request->context, status);
+    }
+    free(request);
+  }
+}
+
+static void* run_batcher(void* argument) {
+  struct qnnp_batcher* batcher = (struct qnnp_batcher*) argument;
+  pthread_mutex_lock(&batcher->mutex);
+  for (;;) {
+    while (batcher->first_request == NULL && !batcher->shutdown) {
+      pthread_cond_wait(&batcher->submitted, &batcher->mutex);
+    }
+    if (batcher->first_request == NULL) {
+      break;
+    }
+
+    /* Collect requests until the batch is full or the window of the oldest request is over */
+    if (batcher->window_ns != 0) {
+      const struct timespec deadline = add_time_ns(batcher->first_request->arrival, batcher->window_ns);
+      while (batcher->queued_requests < batcher->max_batch_size && !batcher->shutdown) {
+        if (pthread_cond_timedwait(&batcher->submitted, &batcher->mutex, &deadline) == ETIMEDOUT) {
+          break;
+        }
+      }
+    }
+
+    struct qnnp_batcher_request* requests = batcher->first_request;
+    struct qnnp_batcher_request* last_request = requests;
+    size_t batch_size = 1;
+    while (batch_size < batcher->max_batch_size && last_request->next != NULL) {
+      last_request = last_request->next;
+      batch_size++;
+    }
+    batcher->first_request = last_request->next;
+    if (batcher->first_request == NULL) {
+      batcher->last_request = NULL;
+    }
+    last_request->next = NULL;
+    batcher->queued_requests -= batch_size;
+    pthread_mutex_unlock(&batcher->mutex);
+
+    run_batch(batcher, requests, batch_size);
+
+    pthread_mutex_lock(&batcher->mutex);
+    batcher->pending_requests -= batch_size;
+    if (batcher->pending_requests == 0) {
+      pthread_cond_broadcast(&batcher->idle);
+    }
+  }
+  pthread_mutex_unlock(&batcher->mutex);
+  return NULL;
+}
+
+enum qnnp_status qnnp_create_batcher(
+    qnnp_operator_t fully_connected,
+    size_t max_batch_size,
+    uint64_t window_us,
+    pthreadpool_t threadpool,
+    qnnp_batcher_t* batcher_out)
+{
+  struct qnnp_batcher* batcher = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_batcher failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (fully_connected == NULL || fully_connected->type != qnnp_operator_type_fully_connected ||
+      fully_connected->format != qnnp_format_quint8)
+  {
+    qnnp_log_error("failed to create batcher: operator was not created by qnnp_create_fully_connected_nc_q8");
+    goto error;
+  }
+
+  if (max_batch_size == 0) {
+    qnnp_log_error(
+      "failed to create batcher with %zu maximum batch size: batch size must be non-zero", max_batch_size);
+    goto error;
+  }
+
+  status = qnnp_status_unsupported_parameter;
+
+  if (fully_connected->flags & QNNP_CONVOLUTION_FLAG_TRANSPOSED_OUTPUT) {
+    qnnp_log_error(
+      "failed to create batcher: operators with QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT do not store rows of requests");
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  batcher = calloc(1, sizeof(struct qnnp_batcher));
+  if (batcher == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_batcher structure", sizeof(struct qnnp_batcher));
+    goto error;
+  }
+  batcher->fully_connected = fully_connected;
+  batcher->threadpool = threadpool;
+  batcher->max_batch_size = max_batch_size;
+  batcher->window_ns = window_us * UINT64_C(1000);
+
+  const size_t batch_input_size = max_batch_size * fully_connected->group_input_channels;
+  batcher->batch_input = qnnp_allocate(batch_input_size);
+  if (batcher->batch_input == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for batcher inputs", batch_input_size);
+    goto error;
+  }
+  const size_t batch_output_size = max_batch_size * fully_connected->group_output_channels;
+  batcher->batch_output = qnnp_allocate(batch_output_size);
+  if (batcher->batch_output == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for batcher outputs", batch_output_size);
+    goto error;
+  }
+
+  pthread_mutex_init(&batcher->mutex, NULL);
+  pthread_cond_init(&batcher->submitted, NULL);
+  pthread_cond_init(&batcher->idle, NULL);
+
+  const int error = pthread_create(&batcher->thread, NULL, run_batcher, batcher);
+  if (error != 0) {
+    qnnp_log_error("failed to create dispatch thread of qnnp_batcher: error %d", error);
+    pthread_cond_destroy(&batcher->idle);
+    pthread_cond_destroy(&batcher->submitted);
+    pthread_mutex_destroy(&batcher->mutex);
+    goto error;
+  }
+
+  *batcher_out = batcher;
+  return qnnp_status_success;
+
+error:
+  if (batcher != NULL) {
+    qnnp_deallocate(batcher->batch_input);
+    qnnp_deallocate(batcher->batch_output);
+    free(batcher);
+  }
+  return status;
+}
+
+enum qnnp_status qnnp_batcher_submit(
+    qnnp_batcher_t batcher,
+    const uint8_t* input,
+    uint8_t* output,
+    qnnp_completion_callback callback,
+    void* context)
+{
+  if (batcher == NULL || input == NULL || output == NULL) {
+    qnnp_log_error("failed to submit batcher request: batcher, input, and output must be non-NULL");
+    return qnnp_status_invalid_parameter;
+  }
+
+  struct qnnp_batcher_request* request = malloc(sizeof(struct qnnp_batcher_request));
+  if (request == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_batcher request", sizeof(struct qnnp_batcher_request));
+    return qnnp_status_out_of_memory;
+  }
+  request->next = NULL;
+  request->input = input;
+  request->output = output;
+  request->callback = callback;
+  request->context = context;
+  clock_gettime(CLOCK_REALTIME, &request->arrival);
+
+  pthread_mutex_lock(&batcher->mutex);
+  if (batcher->last_request != NULL) {
+    batcher->last_request->next = request;
+  } else {
+    batcher->first_request = request;
+  }
+  batcher->last_request = request;
+  batcher->queued_requests++;
+  batcher->pending_requests++;
+  pthread_cond_signal(&batcher->submitted);
+  pthread_mutex_unlock(&batcher->mutex);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_wait_batcher(qnnp_batcher_t batcher)
+{
+  if (batcher == NULL) {
+    return qnnp_status_invalid_parameter;
+  }
+
+  pthread_mutex_lock(&batcher->mutex);
+  while (batcher->pending_requests != 0) {
+    pthread_cond_wait(&batcher->idle, &batcher->mutex);
+  }
+  pthread_mutex_unlock(&batcher->mutex);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_delete_batcher(qnnp_batcher_t batcher)
+{
+  if (batcher != NULL) {
+    /* The dispatch thread runs the submitted requests without waiting for their windows before it exits */
+    pthread_mutex_lock(&batcher->mutex);
+    batcher->shutdown = true;
+    pthread_cond_signal(&batcher->submitted);
+    pthread_mutex_unlock(&batcher->mutex);
+    pthread_join(batcher->thread, NULL);
+
+    pthread_cond_destroy(&batcher->idle);
+    pthread_cond_destroy(&batcher->submitted);
+    pthread_mutex_destroy(&batcher->mutex);
+    qnnp_deallocate(batcher->batch_input);
+    qnnp_deallocate(batcher->batch_output);
+    free(batcher);
+    return qnnp_status_success;
+  }
+  return qnnp_status_invalid_parameter;
+}
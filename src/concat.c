@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+#include <qnnpack/requantization.h>
+
+
+enum qnnp_status qnnp_create_concat_nc_q8(
+    size_t inputs,
+    const size_t* input_channels,
+    const uint8_t* input_zero_points,
+    const float* input_scales,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* concat_out)
+{
+  qnnp_operator_t concat_op = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_concat_nc_q8 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (inputs == 0) {
+    qnnp_log_error("failed to create concat operator with %zu inputs: number of inputs must be non-zero", inputs);
+    goto error;
+  }
+
+  for (size_t i = 0; i < inputs; i++) {
+    if (input_channels[i] == 0) {
+      qnnp_log_error(
+        "failed to create concat operator with %zu channels in input #%zu: number of channels must be non-zero",
+        input_channels[i], i);
+      goto error;
+    }
+
+    if (!(input_scales[i] > 0.0f && isnormal(input_scales[i]))) {
+      qnnp_log_error(
+        "failed to create concat operator with %.7g scale of input #%zu: scale must be finite, normalized, and positive",
+        input_scales[i], i);
+      goto error;
+    }
+  }
+
+  if (!(output_scale > 0.0f && isnormal(output_scale))) {
+    qnnp_log_error(
+      "failed to create concat operator with %.7g output scale: scale must be finite, normalized, and positive",
+      output_scale);
+    goto error;
+  }
+
+  if (output_min >= output_max) {
+    qnnp_log_error(
+      "failed to create concat operator with [%" PRIu8 ", %" PRIu8 "] output range: range min must be below range max",
+      output_min, output_max);
+    goto error;
+  }
+
+  status = qnnp_status_unsupported_parameter;
+
+  for (size_t i = 0; i < inputs; i++) {
+    const float input_output_scale = input_scales[i] / output_scale;
+    if (input_output_scale < QNNP_ADD_MIN_OUTPUT_SCALE || input_output_scale >= QNNP_ADD_MAX_OUTPUT_SCALE) {
+      qnnp_log_error(
+        "failed to create concat operator with %.7g input-to-output scale ratio of input #%zu: "
+        "scale ratio must be in [2**-14, 2**8) range",
+        input_output_scale, i);
+      goto error;
+    }
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  concat_op = calloc(1, sizeof(struct qnnp_operator));
+  if (concat_op == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  const size_t concat_inputs_size = inputs * sizeof(struct qnnp_concat_input);
+  concat_op->concat_inputs = calloc(inputs, sizeof(struct qnnp_concat_input));
+  if (concat_op->concat_inputs == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for concat inputs", concat_inputs_size);
+    goto error;
+  }
+  concat_op->concat_inputs_count = inputs;
+
+  size_t channels = 0;
+  for (size_t i = 0; i < inputs; i++) {
+    struct qnnp_concat_input* concat_input = &concat_op->concat_inputs[i];
+    concat_input->channels = input_channels[i];
+    concat_input->channel_offset = channels;
+    /* Inputs already quantized like the output, with nothing to clamp, are only copied */
+    concat_input->copy = input_zero_points[i] == output_zero_point && input_scales[i] == output_scale &&
+      output_min == 0 && output_max == UINT8_MAX;
+    if (!concat_input->copy) {
+      concat_input->quantization_params = qnnp_compute_rescale_quantization_params(
+        input_zero_points[i], output_zero_point, input_scales[i] / output_scale, output_min, output_max);
+    }
+    channels += input_channels[i];
+  }
+  concat_op->channels = channels;
+  concat_op->output_zero_point = output_zero_point;
+  concat_op->output_min = output_min;
+  concat_op->output_max = output_max;
+
+  concat_op->type = qnnp_operator_type_concat;
+  concat_op->format = qnnp_format_quint8;
+
+  *concat_out = concat_op;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(concat_op);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_concat_nc_q8(
+    qnnp_operator_t concat_op,
+    size_t batch_size,
+    const uint8_t** inputs,
+    const size_t* input_strides,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_concat_nc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup concat operator with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t channels = concat_op->channels;
+  if (output_stride < channels) {
+    qnnp_log_error(
+      "failed to setup concat operator with %zu output stride: stride must be at least the %zu output channels",
+      output_stride, channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t inputs_count = concat_op->concat_inputs_count;
+  for (size_t i = 0; i < inputs_count; i++) {
+    if (input_strides[i] < concat_op->concat_inputs[i].channels) {
+      qnnp_log_error(
+        "failed to setup concat operator with %zu stride of input #%zu: stride must be at least the %zu input channels",
+        input_strides[i], i, concat_op->concat_inputs[i].channels);
+      return qnnp_status_invalid_parameter;
+    }
+  }
+
+  for (size_t i = 0; i < inputs_count; i++) {
+    concat_op->concat_inputs[i].input = inputs[i];
+    concat_op->concat_inputs[i].input_stride = input_strides[i];
+  }
+  concat_op->batch_size = batch_size;
+  concat_op->output = output;
+  concat_op->output_pixel_stride = output_stride;
+
+  return qnnp_status_success;
+}
@@ -7,47 +7,53 @@
  */
 
 #include <assert.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include <cpuinfo.h>
 #include <fp16.h>
 #include <fxdiv.h>
 
 #include <qnnpack.h>
+#include <qnnpack/allocator.h>
 #include <qnnpack/convolution.h>
 #include <qnnpack/requantization.h>
 #include <qnnpack/log.h>
 #include <qnnpack/math.h>
 #include <qnnpack/pack.h>
+#include <qnnpack/packed-weights.h>
 #include <qnnpack/params.h>
+#include <qnnpack/profiling.h>
 #include <qnnpack/q8gemm.h>
+#include <qnnpack/scheduler.h>
+#include <qnnpack/setup-cache.h>
+#include <qnnpack/ukernel-selection.h>
 
-static inline size_t compute_output_dimension(
-    size_t padded_input_dimension,
-    size_t kernel_dimension,
-    size_t dilation_dimension,
-    size_t subsampling_dimension)
-{
-  const size_t effective_kernel_dimension = (kernel_dimension - 1) * dilation_dimension + 1;
-  return (padded_input_dimension - effective_kernel_dimension) / subsampling_dimension + 1;
+/*
+ * Number of adjacent groups that share each group of the packed weights with QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS: the
+ * most groups, dividing the number of groups, whose output channels together fit into an nr-block.
+ */
+static uint32_t get_block_groups(uint32_t groups, size_t group_output_channels, uint32_t nr) {
+  uint32_t block_groups = 1;
+  for (uint32_t i = 2; i <= groups && i * group_output_channels <= nr; i++) {
+    if (groups % i == 0) {
+      block_groups = i;
+    }
+  }
+  return block_groups;
 }
 
-static void q8gemm_compute_row_sum(
-    const uint8_t* restrict a,
-    size_t batch_size,
-    size_t groups,
-    size_t m,
-    size_t k,
-    size_t a_stride,
-    const int32_t multiplier,
-    int32_t* restrict a_sum,
-    size_t a_sum_stride,
-    pthreadpool_t threadpool);
-
-enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
+/*
+ * Creates a convolution that either packs the kernel and bias, or, when packed_weights is not NULL, references
+ * weights packed by another convolution with the same parameters. With kernel_scales, kernel_scale is ignored and
+ * every output channel is requantized with its own scale.
+ */
+static enum qnnp_status create_convolution2d_nhwc_q8(
     uint32_t input_padding_top,
     uint32_t input_padding_right,
     uint32_t input_padding_bottom,
@@ -65,12 +71,16 @@ enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
     float input_scale,
     uint8_t kernel_zero_point,
     float kernel_scale,
+    const float* kernel_scales,
     const uint8_t* kernel,
     const int32_t* bias,
+    qnnp_packed_weights_t packed_weights,
     uint8_t output_zero_point,
     float output_scale,
     uint8_t output_min,
     uint8_t output_max,
+    uint32_t create_flags,
+    pthreadpool_t threadpool,
     qnnp_operator_t* convolution_out)
 {
   qnnp_operator_t convolution = NULL;
@@ -150,8 +160,40 @@ enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
       kernel_width, kernel_height, input_padding_left, input_padding_right);
   }
 
-  const float convolution_scale = input_scale * kernel_scale / output_scale;
-  if (convolution_scale >= 1.0f) {
+  /* With per-channel scales, the shared requantization parameters only hold the zero point and output range */
+  const float input_output_scale = input_scale / output_scale;
+  float convolution_scale = input_scale * kernel_scale / output_scale;
+  if (kernel_scales != NULL) {
+    convolution_scale = 0.0f;
+    for (size_t channel = 0; channel < groups * group_output_channels; channel++) {
+      if (!(kernel_scales[channel] > 0.0f) || !isnormal(kernel_scales[channel])) {
+        qnnp_log_error(
+          "failed to create convolution with %.7g kernel scale of output channel %zu: "
+          "scale must be finite, normalized, and positive",
+          kernel_scales[channel], channel);
+        status = qnnp_status_invalid_parameter;
+        goto error;
+      }
+      const float channel_scale = input_output_scale * kernel_scales[channel];
+      if (channel_scale >= 1.0f) {
+        qnnp_log_error(
+          "failed to create convolution with %.7g input scale, %.7g kernel scale of output channel %zu, "
+          "and %.7g output scale: convolution scale %.7g is greater or equal to 1.0",
+          input_scale, kernel_scales[channel], channel, output_scale, channel_scale);
+        goto error;
+      }
+      if (channel_scale > convolution_scale) {
+        convolution_scale = channel_scale;
+      }
+    }
+    if (convolution_scale < 0x1.0p-32f) {
+      qnnp_log_error(
+        "failed to create convolution with %.7g input scale and %.7g output scale: "
+        "largest convolution scale %.7g is below 2**-32",
+        input_scale, output_scale, convolution_scale);
+      goto error;
+    }
+  } else if (convolution_scale >= 1.0f) {
     qnnp_log_error(
       "failed to create convolution with %.7g input scale, %.7g kernel scale, and %.7g output scale: "
       "convolution scale %.7g is greater or equal to 1.0",
@@ -170,37 +212,72 @@ enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
   const size_t kernel_size = kernel_height * kernel_width;
 
   uint32_t flags = 0;
-  if (kernel_size == 9 && dilation_width == 1 && group_input_channels == 1 && group_output_channels == 1 && groups > 1) {
+  if (create_flags & QNNP_CREATE_FLAG_INPUT_NCHW) {
+    flags |= QNNP_CONVOLUTION_FLAG_NCHW;
+  }
+  if (kernel_scales != NULL) {
+    /* Only the convolution microkernels requantize per output channel */
+    flags |= QNNP_CONVOLUTION_FLAG_PER_CHANNEL;
+  } else if (create_flags & QNNP_CREATE_FLAG_FP32_REQUANTIZATION) {
+    /* Only the GEMM and convolution microkernels have FP32 requantization */
+    flags |= QNNP_CONVOLUTION_FLAG_FP32_REQUANTIZATION;
+    if (kernel_size == 1 && subsampling_height == 1 && subsampling_width == 1 &&
+        !(flags & QNNP_CONVOLUTION_FLAG_NCHW))
+    {
+      flags |= QNNP_CONVOLUTION_FLAG_GEMM;
+    }
+  } else if (flags & QNNP_CONVOLUTION_FLAG_NCHW) {
+    /* Channels of an input pixel are not adjacent, so only the convolution microkernels can read them */
+  } else if ((kernel_size == 9 || kernel_size == 25) && group_input_channels == 1 && groups > 1) {
     flags |= QNNP_CONVOLUTION_FLAG_DW;
   } else if (kernel_size == 1 && subsampling_height == 1 && subsampling_width == 1) {
-    if (group_input_channels >= qnnp_params.q8conv_xzp.kthreshold) {
-      flags |= QNNP_CONVOLUTION_FLAG_XZP_GEMM;
+    bool xzp = group_input_channels >= qnnp_params.q8conv_xzp.kthreshold;
+    if (create_flags & QNNP_CREATE_FLAG_XZP_ALTERNATIVE) {
+      xzp = !xzp;
+    }
+    if (groups == 1 && (input_padding_left | input_padding_top | input_padding_right | input_padding_bottom) == 0 &&
+        qnnp_use_q8gemm_sparse(create_flags, packed_weights, group_input_channels))
+    {
+      flags |= QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_SPARSE;
     } else {
-      flags |= QNNP_CONVOLUTION_FLAG_GEMM;
+      flags |= xzp ? QNNP_CONVOLUTION_FLAG_XZP_GEMM : QNNP_CONVOLUTION_FLAG_GEMM;
     }
+  } else if (kernel_height == 3 && kernel_width == 3 && subsampling_height == 1 && subsampling_width == 1 &&
+      dilation_height == 1 && dilation_width == 1 &&
+      group_input_channels >= QNNP_WINOGRAD_MIN_CHANNELS && group_input_channels <= QNNP_WINOGRAD_MAX_CHANNELS &&
+      group_output_channels >= QNNP_WINOGRAD_MIN_CHANNELS &&
+      (packed_weights != NULL ?
+        (packed_weights->flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) != 0 :
+        !(create_flags & (QNNP_CREATE_FLAG_NO_WINOGRAD | QNNP_CREATE_FLAG_TILE_INDIRECTION))))
+  {
+    flags |= QNNP_CONVOLUTION_FLAG_WINOGRAD;
+  }
+  if (!(flags & (QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_DW | QNNP_CONVOLUTION_FLAG_XZP_GEMM |
+        QNNP_CONVOLUTION_FLAG_WINOGRAD | QNNP_CONVOLUTION_FLAG_NCHW)) &&
+      groups == 1 && group_input_channels <= QNNP_STEM_MAX_CHANNELS && kernel_width > 1 && dilation_width == 1 &&
+      (packed_weights == NULL || (packed_weights->flags & QNNP_CONVOLUTION_FLAG_STEM) != 0))
+  {
+    /* A few channels per tap would leave most lanes of the microkernels idle, while rows of the kernel fill them */
+    flags |= QNNP_CONVOLUTION_FLAG_STEM;
   }
   if ((input_padding_left | input_padding_top | input_padding_right | input_padding_bottom) != 0) {
     flags |= QNNP_CONVOLUTION_FLAG_ZERO;
   }
 
+  size_t packed_kernel_size = 0;
+  size_t bias_size = 0;
+  uint32_t block_groups = 1;
   if (flags & QNNP_CONVOLUTION_FLAG_DW) {
-    const uint32_t cr = qnnp_params.q8dw9.cr;
-    const uint32_t c_stride = (groups + (cr - 1)) & -cr;
-    const size_t packed_weights_size = (sizeof(uint8_t) * kernel_size + sizeof(int32_t)) * c_stride;
-    convolution->packed_kernel = malloc(packed_weights_size);
-    if (convolution->packed_kernel == NULL) {
-      qnnp_log_error("failed to allocate %zu bytes for packed kernel data", packed_weights_size);
-      goto error;
-    }
-
-    pack_q8dw_w(
-      kernel_height, kernel_width,
-      groups, cr,
-      kernel, bias, convolution->packed_kernel);
+    /* With a channel multiplier, each group produces group_output_channels consecutive output channels */
+    const size_t channels = groups * group_output_channels;
+    const size_t cr = kernel_size == 9 ? qnnp_params.q8dw9.cr : qnnp_params.q8dw25.cr;
+    const size_t c_stride = (channels + (cr - 1)) & -cr;
+    /* Depthwise microkernels read bias interleaved with the kernel */
+    packed_kernel_size = (sizeof(uint8_t) * kernel_size + sizeof(int32_t)) * c_stride;
 
     if (flags & QNNP_CONVOLUTION_FLAG_ZERO) {
-      const size_t zero_size = sizeof(uint8_t) * c_stride + (groups >= 8 ? 0 : 8);
-      convolution->zero = malloc(zero_size);
+      const size_t zero_size = sizeof(uint8_t) * c_stride + (channels >= 8 ? 0 : 8);
+      convolution->zero = qnnp_allocate_weights(zero_size);
       if (convolution->zero == NULL) {
         qnnp_log_error("failed to allocate %zu bytes for zero padding", zero_size);
         goto error;
@@ -208,99 +285,145 @@ enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
       memset(convolution->zero, input_zero_point, zero_size);
     }
   } else {
-    uint32_t nr = qnnp_params.q8conv.nr;
-    uint32_t kr = qnnp_params.q8conv.kr;
-
-    if (flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
-      nr = qnnp_params.q8conv_xzp.nr;
-      kr = qnnp_params.q8conv_xzp.kr;
+    uint32_t nr = qnnp_params.q8conv_xzp.nr;
+    uint32_t kr = qnnp_params.q8conv_xzp.kr;
+    /* With NCHW input, each input channel of a kernel position is a tap of its own, and stems tap rows of the kernel */
+    size_t tap_channels = group_input_channels;
+    size_t taps = kernel_size;
+    if (flags & QNNP_CONVOLUTION_FLAG_NCHW) {
+      tap_channels = 1;
+      taps = kernel_size * group_input_channels;
+    } else if (flags & QNNP_CONVOLUTION_FLAG_STEM) {
+      tap_channels = kernel_width * group_input_channels;
+      taps = kernel_height;
     }
 
-    const uint32_t n_stride = (group_output_channels + (nr - 1)) & -nr;
-    const uint32_t k_stride = (group_input_channels + (kr - 1)) & -kr;
-
-    convolution->packed_kernel = malloc(sizeof(uint8_t) * kernel_size * groups * k_stride * n_stride);
-    if (convolution->packed_kernel == NULL) {
-      qnnp_log_error("failed to allocate %zu bytes for packed kernel data",
-        sizeof(uint8_t) * kernel_size * groups * k_stride * n_stride);
-      goto error;
-    }
-    if (flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
-      /* The XZP ukernel needs the padding to be 0 */
-      memset(convolution->packed_kernel, 0, sizeof(uint8_t) * groups * kernel_size * k_stride * n_stride);
-    } else {
-      memset(convolution->packed_kernel, kernel_zero_point, sizeof(uint8_t) * groups * kernel_size * k_stride * n_stride);
-    }
-
-    if (flags & QNNP_CONVOLUTION_FLAG_GEMM) {
-      for (uint32_t group = 0; group < groups; group++) {
-        pack_q8gemm_b(
-            group_output_channels, group_input_channels,
-            nr, kr,
-            kernel + group * group_output_channels * group_input_channels,
-            convolution->packed_kernel + group * n_stride * k_stride);
-      }
-    } else if (flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
-      for (uint32_t group = 0; group < groups; group++) {
-        const uint32_t kc = qnnp_params.q8conv_xzp.kc;
-        pack_q8gemm_b_diagonal(
-            group_output_channels, group_input_channels,
-            nr, kr, kc,
-            kernel + group * group_output_channels * group_input_channels,
-            convolution->packed_kernel + group * n_stride * k_stride);
+    if (flags & QNNP_CONVOLUTION_FLAG_PER_CHANNEL) {
+      if (qnnp_params.q8conv_perchannel.conv == NULL) {
+        qnnp_log_error("failed to create convolution: no microkernel supports per-channel requantization");
+        status = qnnp_status_unsupported_hardware;
+        goto error;
       }
-    } else {
-      for (uint32_t group = 0; group < groups; group++) {
-        pack_q8conv_b(
-            group_output_channels, kernel_size, group_input_channels,
-            nr, kr,
-            kernel + group * group_output_channels * kernel_size * group_input_channels,
-            convolution->packed_kernel + group * kernel_size * n_stride * k_stride);
+      convolution->q8conv = qnnp_params.q8conv_perchannel;
+      nr = convolution->q8conv.nr;
+      kr = convolution->q8conv.kr;
+    } else if (flags & QNNP_CONVOLUTION_FLAG_FP32_REQUANTIZATION) {
+      if (!qnnp_select_q8conv_fp32_requantization(packed_weights, &convolution->q8conv, &flags)) {
+        qnnp_log_error(
+          "failed to create convolution: no available microkernel with FP32 requantization supports the tile of "
+          "the packed weights");
+        status = qnnp_status_unsupported_parameter;
+        goto error;
+      }
+      if (!qnnp_select_q8conv_signed_kernel(kernel_zero_point, packed_weights, &convolution->q8conv, &flags)) {
+        qnnp_log_error("failed to create convolution: no available microkernel supports the signed packed weights");
+        status = qnnp_status_unsupported_parameter;
+        goto error;
+      }
+      if (!qnnp_select_q8conv_folded_zero_point(create_flags, packed_weights, &convolution->q8conv, &flags)) {
+        qnnp_log_error("failed to create convolution: no available microkernel supports the folded packed weights");
+        status = qnnp_status_unsupported_parameter;
+        goto error;
+      }
+      nr = convolution->q8conv.nr;
+      kr = convolution->q8conv.kr;
+    } else if (flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) {
+      /* Products of the transformed tiles run no microkernels, and the kernel is packed in blocks of their channels */
+      nr = QNNP_WINOGRAD_NR;
+      kr = 1;
+    } else if (flags & QNNP_CONVOLUTION_FLAG_SPARSE) {
+      if (!qnnp_select_q8gemm_sparse(packed_weights, &convolution->q8conv)) {
+        qnnp_log_error("failed to create convolution: no available microkernel supports the sparse packed weights");
+        status = qnnp_status_unsupported_parameter;
+        goto error;
+      }
+      nr = convolution->q8conv.nr;
+      kr = convolution->q8conv.kr;
+    } else if (!(flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM)) {
+      if (packed_weights != NULL) {
+        if (!qnnp_select_q8conv_parameters_for_tile(packed_weights->nr, packed_weights->kr, &convolution->q8conv)) {
+          qnnp_log_error(
+            "failed to create convolution: no available microkernel supports the %" PRIu32 "x%" PRIu32 " tile of packed weights",
+            packed_weights->nr, packed_weights->kr);
+          status = qnnp_status_unsupported_parameter;
+          goto error;
+        }
+      } else {
+        convolution->q8conv = qnnp_select_q8conv_parameters(tap_channels, group_output_channels);
+      }
+      if (!qnnp_select_q8conv_signed_kernel(kernel_zero_point, packed_weights, &convolution->q8conv, &flags)) {
+        qnnp_log_error("failed to create convolution: no available microkernel supports the signed packed weights");
+        status = qnnp_status_unsupported_parameter;
+        goto error;
+      }
+      if (!qnnp_select_q8conv_folded_zero_point(create_flags, packed_weights, &convolution->q8conv, &flags)) {
+        qnnp_log_error("failed to create convolution: no available microkernel supports the folded packed weights");
+        status = qnnp_status_unsupported_parameter;
+        goto error;
+      }
+      if (!(flags & QNNP_CONVOLUTION_FLAG_GEMM) &&
+          !qnnp_select_q8conv_xzp_conv(tap_channels, packed_weights, &convolution->q8conv, &flags))
+      {
+        qnnp_log_error("failed to create convolution: no available microkernel supports the XZP packed weights");
+        status = qnnp_status_unsupported_parameter;
+        goto error;
+      }
+      /* The 1x1 kernel has a row of group_input_channels values per output channel of every group */
+      if ((flags & QNNP_CONVOLUTION_FLAG_GEMM) && !qnnp_select_q8conv_acc16(
+            groups * group_output_channels, group_input_channels, kernel, input_zero_point, kernel_zero_point,
+            packed_weights, &convolution->q8conv, &flags))
+      {
+        qnnp_log_error(
+          "failed to create convolution: no available microkernel supports 16-bit accumulation of the packed weights");
+        status = qnnp_status_unsupported_parameter;
+        goto error;
       }
+      qnnp_select_q8conv_output_clamp(output_min, output_max, flags, &convolution->q8conv);
+      nr = convolution->q8conv.nr;
+      kr = convolution->q8conv.kr;
     }
 
-    convolution->bias = malloc(sizeof(int32_t) * groups * n_stride);
-    if (convolution->bias == NULL) {
-      qnnp_log_error("failed to allocate %zu bytes for packed bias data", sizeof(int32_t) * groups * n_stride);
-      goto error;
-    }
-    for (uint32_t group = 0; group < groups; group++) {
-      memcpy(
-        (int32_t*) convolution->bias + group * n_stride,
-        bias + group * group_output_channels,
-        sizeof(int32_t) * group_output_channels);
-    }
-
-    if (flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
-      /* compute row sum for b and fold into bias */
-      int32_t* bias_buf = (int32_t*) malloc(sizeof(int32_t) * groups * n_stride);
-      const int32_t zero_point_product = group_input_channels * input_zero_point * kernel_zero_point;
-      int32_t* bias = (int32_t*) convolution->bias;
-      /* kernel: G x OC x kH x kW x IC */
-      /* row_sum:G x OC */
-      /* swap groups and batch_size */
-      q8gemm_compute_row_sum(
-        kernel,
-        groups,
-        1,
-        group_output_channels,
-        group_input_channels,
-        group_input_channels,
-        -input_zero_point,
-        bias_buf,
-        n_stride,
-        NULL);
-      for (uint32_t group = 0; group < groups; group++) {
-        for (uint32_t i = 0; i < group_output_channels; i++) {
-          bias[group * n_stride + i] += bias_buf[group * n_stride + i] + zero_point_product;
-        }
+    /*
+     * Groups with a few output channels would leave most of the nr lanes of every microkernel call idle, while
+     * merged groups fill them with one call per tile of the merged group instead of one per group. Weights packed
+     * with merged groups already have the dimensions of the merged groups when loaded from serialized data.
+     */
+    if (groups > 1 &&
+        !(flags & (QNNP_CONVOLUTION_FLAG_XZP_GEMM | QNNP_CONVOLUTION_FLAG_XZP_CONV | QNNP_CONVOLUTION_FLAG_WINOGRAD |
+          QNNP_CONVOLUTION_FLAG_NCHW)) &&
+        (packed_weights == NULL || (packed_weights->flags & QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS) != 0))
+    {
+      block_groups = get_block_groups(groups, group_output_channels, nr);
+      if (block_groups > 1 || packed_weights != NULL) {
+        flags |= QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS;
+        tap_channels *= block_groups;
       }
-      free(bias_buf);
     }
+    const uint32_t packed_groups = groups / block_groups;
+    const size_t packed_group_output_channels = group_output_channels * block_groups;
 
-    if (flags & QNNP_CONVOLUTION_FLAG_ZERO) {
-      const size_t zero_size = sizeof(uint8_t) * k_stride + (group_input_channels >= 8 ? 0 : 8);
-      convolution->zero = malloc(zero_size);
+    const uint32_t n_stride = (packed_group_output_channels + (nr - 1)) & -nr;
+    const uint32_t k_stride = (tap_channels + (kr - 1)) & -kr;
+    packed_kernel_size =
+      sizeof(uint8_t) * packed_groups * n_stride * qnnp_get_packed_channel_stride(taps, tap_channels, nr, kr);
+    if (flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) {
+      /* The 16 positions of the 4x4 transformed tiles take the place of the 9 taps */
+      packed_kernel_size = sizeof(int16_t) * 16 * groups * k_stride * n_stride;
+    } else if ((flags & QNNP_CONVOLUTION_FLAG_SPARSE) && packed_weights == NULL) {
+      const size_t blocks =
+        count_q8gemm_sparse_blocks(group_output_channels, group_input_channels, kr, kernel_zero_point, kernel);
+      packed_kernel_size = qnnp_get_sparse_packed_kernel_size(n_stride, blocks);
+    }
+    bias_size = sizeof(int32_t) * packed_groups * n_stride;
+    if (flags & QNNP_CONVOLUTION_FLAG_PER_CHANNEL) {
+      /* Each block of nr biases is followed by the requantization scales of the same output channels */
+      bias_size += sizeof(float) * packed_groups * n_stride;
+    }
+
+    /* Winograd also reads the zero buffer for input rows outside of the band of qnnp_run_convolution2d_nhwc_q8_rows */
+    if (flags & (QNNP_CONVOLUTION_FLAG_ZERO | QNNP_CONVOLUTION_FLAG_WINOGRAD)) {
+      const size_t zero_size = sizeof(uint8_t) * k_stride + (tap_channels >= 8 ? 0 : 8);
+      convolution->zero = qnnp_allocate_weights(zero_size);
       if (convolution->zero == NULL) {
         qnnp_log_error("failed to allocate %zu bytes for zero padding", zero_size);
         goto error;
@@ -320,9 +443,9 @@ enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
   convolution->stride_width = subsampling_width;
   convolution->dilation_height = dilation_height;
   convolution->dilation_width = dilation_width;
-  convolution->groups = groups;
-  convolution->group_input_channels = group_input_channels;
-  convolution->group_output_channels = group_output_channels;
+  convolution->groups = groups / block_groups;
+  convolution->group_input_channels = group_input_channels * block_groups;
+  convolution->group_output_channels = group_output_channels * block_groups;
 
   convolution->input_zero_point = input_zero_point;
   convolution->kernel_zero_point = kernel_zero_point;
@@ -330,9 +453,67 @@ enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
   convolution->requantization_params =
     qnnp_compute_requantization_params(
       convolution_scale, output_zero_point, output_min, output_max);
+  convolution->requantization_scale = convolution_scale;
+  convolution->output_zero_point = output_zero_point;
+  convolution->output_min = output_min;
+  convolution->output_max = output_max;
 
+  convolution->type = qnnp_operator_type_convolution;
   convolution->format = qnnp_format_quint8;
   convolution->flags = flags;
+  convolution->tile_indirection =
+    (create_flags & QNNP_CREATE_FLAG_TILE_INDIRECTION) && qnnp_supports_tile_indirection(convolution);
+
+  if (packed_weights != NULL) {
+    status = qnnp_attach_packed_weights(convolution, packed_weights);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+  } else {
+    status = qnnp_attach_new_packed_weights(convolution, kernel, bias, packed_kernel_size, bias_size);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+    convolution->packed_weights->unpacked_kernel_scales = kernel_scales;
+    convolution->packed_weights->input_output_scale = input_output_scale;
+    convolution->packed_weights->block_groups = block_groups;
+    if (!(create_flags & QNNP_CREATE_FLAG_LAZY_PACKING)) {
+      status = qnnp_ensure_packed_weights(convolution, threadpool);
+      if (status != qnnp_status_success) {
+        goto error;
+      }
+    }
+  }
+
+  if ((create_flags & QNNP_CREATE_FLAG_CALIBRATE_XZP) && qnnp_params.q8conv_xzp.gemm != NULL &&
+      packed_weights == NULL && (flags & (QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_XZP_GEMM)) &&
+      !(flags & (QNNP_CONVOLUTION_FLAG_FP32_REQUANTIZATION | QNNP_CONVOLUTION_FLAG_ZERO |
+        QNNP_CONVOLUTION_FLAG_SPARSE)))
+  {
+    /* The same convolution on the other path, which qnnp_run_operator alternates with this one until it is faster */
+    convolution->xzp_calibration = calloc(1, sizeof(struct qnnp_xzp_calibration));
+    if (convolution->xzp_calibration == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for XZP calibration", sizeof(struct qnnp_xzp_calibration));
+      status = qnnp_status_out_of_memory;
+      goto error;
+    }
+    status = create_convolution2d_nhwc_q8(
+      input_padding_top, input_padding_right, input_padding_bottom, input_padding_left,
+      kernel_height, kernel_width,
+      subsampling_height, subsampling_width,
+      dilation_height, dilation_width,
+      groups, group_input_channels, group_output_channels,
+      input_zero_point, input_scale,
+      kernel_zero_point, kernel_scale, kernel_scales,
+      kernel, bias, NULL,
+      output_zero_point, output_scale, output_min, output_max,
+      (create_flags & ~QNNP_CREATE_FLAG_CALIBRATE_XZP) | QNNP_CREATE_FLAG_XZP_ALTERNATIVE,
+      threadpool,
+      &convolution->xzp_calibration->alternative);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+  }
 
   *convolution_out = convolution;
   return qnnp_status_success;
@@ -342,513 +523,4328 @@ error:
   return status;
 }
 
-enum qnnp_status qnnp_setup_convolution2d_nhwc_q8(
-    qnnp_operator_t convolution,
-    size_t batch_size,
-    size_t input_height,
-    size_t input_width,
-    const uint8_t* input,
-    size_t input_pixel_stride,
-    uint8_t* output,
-    size_t output_pixel_stride,
-    pthreadpool_t threadpool)
+enum qnnp_status qnnp_create_convolution2d_nhwc_q8(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* convolution_out)
 {
-  if (!qnnp_params.initialized) {
-    qnnp_log_error("qnnp_setup_convolution2d_nhwc_q8 failed because QNNPACK is not properly initialized");
-    return qnnp_status_uninitialized;
-  }
+  return create_convolution2d_nhwc_q8(
+    input_padding_top, input_padding_right, input_padding_bottom, input_padding_left,
+    kernel_height, kernel_width,
+    subsampling_height, subsampling_width,
+    dilation_height, dilation_width,
+    groups, group_input_channels, group_output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale, NULL,
+    kernel, bias, NULL,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    NULL /* threadpool */,
+    convolution_out);
+}
 
-  if (batch_size == 0) {
-    qnnp_log_error("failed to setup convolution with batch size %zu: batch size must be non-zero", batch_size);
+enum qnnp_status qnnp_create_convolution2d_nhwc_q8_with_threadpool(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    pthreadpool_t threadpool,
+    qnnp_operator_t* convolution_out)
+{
+  return create_convolution2d_nhwc_q8(
+    input_padding_top, input_padding_right, input_padding_bottom, input_padding_left,
+    kernel_height, kernel_width,
+    subsampling_height, subsampling_width,
+    dilation_height, dilation_width,
+    groups, group_input_channels, group_output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale, NULL,
+    kernel, bias, NULL,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    threadpool,
+    convolution_out);
+}
+
+enum qnnp_status qnnp_create_convolution2d_nhwc_q8_with_packed_weights(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    qnnp_packed_weights_t packed_weights,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* convolution_out)
+{
+  if (packed_weights == NULL) {
+    qnnp_log_error("failed to create convolution: packed weights must not be NULL");
     return qnnp_status_invalid_parameter;
   }
 
-  if (input_width == 0 || input_height == 0) {
-    qnnp_log_error(
-      "failed to setup convolution with %zux%zu input: input dimensions must be non-zero",
-      input_width,
-      input_height);
+  return create_convolution2d_nhwc_q8(
+    input_padding_top, input_padding_right, input_padding_bottom, input_padding_left,
+    kernel_height, kernel_width,
+    subsampling_height, subsampling_width,
+    dilation_height, dilation_width,
+    groups, group_input_channels, group_output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale, NULL,
+    NULL, NULL, packed_weights,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    NULL /* threadpool */,
+    convolution_out);
+}
+
+enum qnnp_status qnnp_create_convolution2d_nhwc_q8_per_channel(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    const float* kernel_scales,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* convolution_out)
+{
+  if (kernel_scales == NULL) {
+    qnnp_log_error("failed to create convolution: kernel scales must not be NULL");
     return qnnp_status_invalid_parameter;
   }
 
-  convolution->batch_size = batch_size;
-  convolution->input_height = input_height;
-  convolution->input_width = input_width;
-  convolution->input = input;
-  convolution->input_pixel_stride = input_pixel_stride;
+  return create_convolution2d_nhwc_q8(
+    input_padding_top, input_padding_right, input_padding_bottom, input_padding_left,
+    kernel_height, kernel_width,
+    subsampling_height, subsampling_width,
+    dilation_height, dilation_width,
+    groups, group_input_channels, group_output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, 1.0f /* kernel_scale */, kernel_scales,
+    kernel, bias, NULL,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    NULL /* threadpool */,
+    convolution_out);
+}
 
-  convolution->output_height = compute_output_dimension(
-      convolution->input_padding_top + input_height + convolution->input_padding_bottom,
-      convolution->kernel_height,
-      convolution->dilation_height,
-      convolution->stride_height);
-  convolution->output_width = compute_output_dimension(
-      convolution->input_padding_left + input_width + convolution->input_padding_right,
-      convolution->kernel_width,
-      convolution->dilation_width,
-      convolution->stride_width);
-  convolution->output = output;
-  convolution->output_pixel_stride = output_pixel_stride;
+enum qnnp_status qnnp_create_convolution2d_nhwc_f32(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    const float* kernel,
+    const float* bias,
+    float output_min,
+    float output_max,
+    uint32_t create_flags,
+    qnnp_operator_t* convolution_out)
+{
+  qnnp_operator_t convolution = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
 
-  if (convolution->flags & QNNP_CONVOLUTION_FLAG_GEMM) {
-    /* Convolution maps directly to GEMM and doesn't use im2col buffer */
-    return qnnp_status_success;
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_convolution2d_nhwc_f32 failed because QNNPACK is not properly initialized");
+    goto error;
   }
 
-  const size_t groups = convolution->groups;
+  status = qnnp_status_invalid_parameter;
 
-  if (convolution->flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
-    void* a_sum = (void*) realloc(convolution->a_sum, sizeof(int32_t) * batch_size * groups * input_height * input_width);
-    if (a_sum == NULL) {
-      qnnp_log_error("failed to allocate %zu bytes for a row sum data",
-        sizeof(int32_t) * batch_size * groups * input_height * input_width);
-      return qnnp_status_out_of_memory;
-    }
-    convolution->a_sum = a_sum;
-    return qnnp_status_success;
+  if (kernel_width == 0 || kernel_height == 0) {
+    qnnp_log_error(
+      "failed to create convolution with %" PRIu32 "x%" PRIu32 " kernel: kernel dimensions must be non-zero",
+      kernel_width, kernel_height);
+    goto error;
   }
 
-  const size_t kernel_height = convolution->kernel_height;
-  const size_t kernel_width = convolution->kernel_width;
-  const size_t kernel_size = kernel_height * kernel_width;
+  if (subsampling_width == 0 || subsampling_height == 0) {
+    qnnp_log_error(
+      "failed to create convolution with %" PRIu32 "x%" PRIu32 " subsampling: "
+      "subsampling dimensions must be non-zero",
+      subsampling_width, subsampling_height);
+    goto error;
+  }
+
+  if (dilation_width == 0 || dilation_height == 0) {
+    qnnp_log_error(
+      "failed to create convolution with %" PRIu32 "x%" PRIu32 " dilation: "
+      "dilation dimensions must be non-zero",
+      dilation_width, dilation_height);
+    goto error;
+  }
+
+  if (!(output_min < output_max)) {
+    qnnp_log_error(
+      "failed to create convolution with [%.7g, %.7g] output range: lower bound must be below upper bound",
+      output_min, output_max);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  convolution = calloc(1, sizeof(struct qnnp_operator));
+  if (convolution == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  const size_t kernel_size = kernel_height * kernel_width;
+  const bool any_padding = (input_padding_left | input_padding_top | input_padding_right | input_padding_bottom) != 0;
+
+  /* There are no FP32 depthwise or XZP microkernels: depthwise convolutions use the convolution microkernel too */
+  uint32_t flags = 0;
+  if (kernel_size == 1 && subsampling_height == 1 && subsampling_width == 1 && !any_padding) {
+    flags |= QNNP_CONVOLUTION_FLAG_GEMM;
+  }
+  if (any_padding) {
+    flags |= QNNP_CONVOLUTION_FLAG_ZERO;
+    /* FP32 microkernels read exactly group_input_channels elements through every pointer */
+    convolution->zero = qnnp_allocate_zero_weights(group_input_channels * sizeof(float));
+    if (convolution->zero == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for zero padding", group_input_channels * sizeof(float));
+      goto error;
+    }
+  }
+
+  convolution->sconv = qnnp_params.sconv;
+  const uint32_t nr = convolution->sconv.nr;
+  const size_t n_stride = (group_output_channels + (nr - 1)) & -nr;
+  const size_t packed_kernel_size = sizeof(float) * kernel_size * groups * group_input_channels * n_stride;
+  const size_t bias_size = sizeof(float) * groups * n_stride;
+
+  convolution->input_padding_top = input_padding_top;
+  convolution->input_padding_right = input_padding_right;
+  convolution->input_padding_bottom = input_padding_bottom;
+  convolution->input_padding_left = input_padding_left;
+
+  convolution->kernel_height = kernel_height;
+  convolution->kernel_width = kernel_width;
+  convolution->stride_height = subsampling_height;
+  convolution->stride_width = subsampling_width;
+  convolution->dilation_height = dilation_height;
+  convolution->dilation_width = dilation_width;
+  convolution->groups = groups;
+  convolution->group_input_channels = group_input_channels;
+  convolution->group_output_channels = group_output_channels;
+
+  convolution->fp32_clamping_params = (struct qnnp_fp32_clamping_params) {
+    .max = output_max,
+    .min = output_min,
+  };
+
+  convolution->type = qnnp_operator_type_convolution;
+  convolution->format = qnnp_format_float32;
+  convolution->flags = flags;
+
+  status = qnnp_attach_new_packed_weights(convolution, kernel, bias, packed_kernel_size, bias_size);
+  if (status != qnnp_status_success) {
+    goto error;
+  }
+  if (!(create_flags & QNNP_CREATE_FLAG_LAZY_PACKING)) {
+    status = qnnp_ensure_packed_weights(convolution, NULL /* threadpool */);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+  }
+
+  *convolution_out = convolution;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(convolution);
+  return status;
+}
+
+enum qnnp_status qnnp_create_convolution2d_nhwc_f16(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t subsampling_height,
+    uint32_t subsampling_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    const void* kernel,
+    const void* bias,
+    float output_min,
+    float output_max,
+    uint32_t create_flags,
+    qnnp_operator_t* convolution_out)
+{
+  qnnp_operator_t convolution = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_convolution2d_nhwc_f16 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_unsupported_hardware;
+
+  if (qnnp_params.hconv.gemm == NULL) {
+    qnnp_log_error("failed to create FP16 convolution: hardware does not support FP16 arithmetic");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (kernel_width == 0 || kernel_height == 0) {
+    qnnp_log_error(
+      "failed to create convolution with %" PRIu32 "x%" PRIu32 " kernel: kernel dimensions must be non-zero",
+      kernel_width, kernel_height);
+    goto error;
+  }
+
+  if (subsampling_width == 0 || subsampling_height == 0) {
+    qnnp_log_error(
+      "failed to create convolution with %" PRIu32 "x%" PRIu32 " subsampling: "
+      "subsampling dimensions must be non-zero",
+      subsampling_width, subsampling_height);
+    goto error;
+  }
+
+  if (dilation_width == 0 || dilation_height == 0) {
+    qnnp_log_error(
+      "failed to create convolution with %" PRIu32 "x%" PRIu32 " dilation: "
+      "dilation dimensions must be non-zero",
+      dilation_width, dilation_height);
+    goto error;
+  }
+
+  if (!(output_min < output_max)) {
+    qnnp_log_error(
+      "failed to create convolution with [%.7g, %.7g] output range: lower bound must be below upper bound",
+      output_min, output_max);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  convolution = calloc(1, sizeof(struct qnnp_operator));
+  if (convolution == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  const size_t kernel_size = kernel_height * kernel_width;
+  const bool any_padding = (input_padding_left | input_padding_top | input_padding_right | input_padding_bottom) != 0;
+
+  /* As for FP32, depthwise convolutions use the convolution microkernel */
+  uint32_t flags = 0;
+  if (kernel_size == 1 && subsampling_height == 1 && subsampling_width == 1 && !any_padding) {
+    flags |= QNNP_CONVOLUTION_FLAG_GEMM;
+  }
+  if (any_padding) {
+    flags |= QNNP_CONVOLUTION_FLAG_ZERO;
+    convolution->zero = qnnp_allocate_zero_weights(group_input_channels * sizeof(uint16_t));
+    if (convolution->zero == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for zero padding", group_input_channels * sizeof(uint16_t));
+      goto error;
+    }
+  }
+
+  convolution->hconv = qnnp_params.hconv;
+  const uint32_t nr = convolution->hconv.nr;
+  const size_t n_stride = (group_output_channels + (nr - 1)) & -nr;
+  const size_t packed_kernel_size = sizeof(uint16_t) * kernel_size * groups * group_input_channels * n_stride;
+  const size_t bias_size = sizeof(uint16_t) * groups * n_stride;
+
+  convolution->input_padding_top = input_padding_top;
+  convolution->input_padding_right = input_padding_right;
+  convolution->input_padding_bottom = input_padding_bottom;
+  convolution->input_padding_left = input_padding_left;
+
+  convolution->kernel_height = kernel_height;
+  convolution->kernel_width = kernel_width;
+  convolution->stride_height = subsampling_height;
+  convolution->stride_width = subsampling_width;
+  convolution->dilation_height = dilation_height;
+  convolution->dilation_width = dilation_width;
+  convolution->groups = groups;
+  convolution->group_input_channels = group_input_channels;
+  convolution->group_output_channels = group_output_channels;
+
+  convolution->fp16_clamping_params = (struct qnnp_fp16_clamping_params) {
+    .scale = UINT16_C(0x3C00) /* 1.0 */,
+    .max = fp16_ieee_from_fp32_value(output_max),
+    .min = fp16_ieee_from_fp32_value(output_min),
+  };
+
+  convolution->type = qnnp_operator_type_convolution;
+  convolution->format = qnnp_format_float16;
+  convolution->flags = flags;
+
+  status = qnnp_attach_new_packed_weights(convolution, kernel, bias, packed_kernel_size, bias_size);
+  if (status != qnnp_status_success) {
+    goto error;
+  }
+  if (!(create_flags & QNNP_CREATE_FLAG_LAZY_PACKING)) {
+    status = qnnp_ensure_packed_weights(convolution, NULL /* threadpool */);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+  }
+
+  *convolution_out = convolution;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(convolution);
+  return status;
+}
+
+/*
+ * Layout of the depthwise indirection buffer of an output row. Output pixels x and x + phases read input columns that
+ * differ by a multiple of the horizontal dilation, so the output pixels with the same x modulo phases form a phase in
+ * which adjacent pixels share kernel columns, as all pixels do without dilation. Phases are stored one after another,
+ * each with every input column it reads stored once, and the pixels of a phase are col_stride pointers apart.
+ */
+struct dw_indirection_layout {
+  size_t phases;
+  size_t col_stride;
+  size_t row_stride;
+};
+
+static struct dw_indirection_layout get_dw_indirection_layout(
+    const struct qnnp_operator* convolution,
+    size_t output_width)
+{
+  const size_t kernel_size = (size_t) convolution->kernel_height * (size_t) convolution->kernel_width;
+  size_t gcd = convolution->stride_width;
+  for (size_t b = convolution->dilation_width; b != 0; ) {
+    const size_t remainder = gcd % b;
+    gcd = b;
+    b = remainder;
+  }
+  const size_t phases = convolution->dilation_width / gcd;
+  /* Adjacent pixels of a phase are stride * phases = lcm(stride, dilation) input columns apart */
+  const size_t col_stride = convolution->kernel_height * (convolution->stride_width / gcd);
+  /* Each phase stores kernel_size pointers for its first pixel and col_stride pointers for each of the others */
+  const size_t row_phases = min(phases, output_width);
+  const struct dw_indirection_layout layout = {
+    .phases = phases,
+    .col_stride = col_stride,
+    .row_stride = row_phases * kernel_size + (output_width - row_phases) * col_stride,
+  };
+  return layout;
+}
+
+/* Whether rows or images of the input are not packed back to back, see qnnp_setup_convolution2d_nhwc_q8_with_strides */
+static inline bool is_strided_input(
+    size_t input_height,
+    size_t input_width,
+    size_t input_pixel_stride,
+    size_t input_row_stride,
+    size_t input_image_stride)
+{
+  return input_row_stride != input_width * input_pixel_stride || input_image_stride != input_height * input_row_stride;
+}
+
+/*
+ * Pixel indices address the input as a packed tensor, so the indirection buffer of a strided input holds pointers.
+ */
+static inline bool use_indirection_offsets(
+    const struct qnnp_operator* convolution,
+    size_t input_height,
+    size_t input_width,
+    bool strided_input)
+{
+  return !strided_input && qnnp_use_indirection_offsets(convolution, input_height, input_width);
+}
+
+/*
+ * Sizes of the buffers setup needs: the workspace holds the indirection buffer, which stays valid between runs; the
+ * scratch holds the expanded input for depthwise convolution with a channel multiplier no microkernel reads directly,
+ * the padded input of stems, or the transformed input of Winograd, which are only used during qnnp_run_operator.
+ */
+static void compute_convolution_workspace_size(
+    const struct qnnp_operator* convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    bool strided_input,
+    size_t* workspace_size,
+    size_t* scratch_size)
+{
+  const size_t output_height = compute_convolution_output_dimension(
+      convolution->input_padding_top + input_height + convolution->input_padding_bottom,
+      convolution->kernel_height,
+      convolution->dilation_height,
+      convolution->stride_height);
+  const size_t output_width = compute_convolution_output_dimension(
+      convolution->input_padding_left + input_width + convolution->input_padding_right,
+      convolution->kernel_width,
+      convolution->dilation_width,
+      convolution->stride_width);
+  const size_t groups = convolution->groups;
+  const size_t kernel_height = convolution->kernel_height;
+  const size_t kernel_size = kernel_height * convolution->kernel_width;
+
+  *workspace_size = 0;
+  *scratch_size = 0;
+  if (convolution->flags & QNNP_CONVOLUTION_FLAG_GEMM) {
+    /* Convolution maps directly to GEMM and doesn't use im2col buffer */
+  } else if (convolution->flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
+    /* Input row sums are computed within the tiles of the GEMM */
+  } else if (convolution->flags & QNNP_CONVOLUTION_FLAG_DW) {
+    const struct dw_indirection_layout layout = get_dw_indirection_layout(convolution, output_width);
+    *workspace_size = sizeof(void*) * batch_size * output_height * layout.row_stride;
+    if (qnnp_convolution_expands_input(convolution)) {
+      /*
+       * With a channel multiplier and no microkernel that reads the input channels directly, qnnp_run_operator
+       * replicates every input channel group_output_channels times into a contiguous buffer, and the indirection
+       * buffer points into it. The buffer is preceded by 8 bytes of
+       * padding because the remainder path of the microkernels reads up to 8 bytes before the last pixel's channels.
+       */
+      const size_t channels = groups * convolution->group_output_channels;
+      *scratch_size = sizeof(uint8_t) * batch_size * input_height * input_width * channels + 8;
+    }
+  } else if (convolution->flags & QNNP_CONVOLUTION_FLAG_STEM) {
+    /*
+     * Tiles compute their input pointers into a copy of the input with left and right padding, preceded by 8 bytes
+     * for the remainder path of the microkernels.
+     */
+    const size_t padded_input_width = convolution->input_padding_left + input_width + convolution->input_padding_right;
+    *scratch_size =
+      sizeof(uint8_t) * batch_size * input_height * padded_input_width * convolution->group_input_channels + 8;
+  } else if (convolution->flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) {
+    /* 16 positions of the transformed input tile of every 2x2 block of output pixels, for each input channel */
+    const size_t tiles = divide_round_up(output_height, 2) * divide_round_up(output_width, 2);
+    *scratch_size = sizeof(int16_t) * batch_size * groups * tiles * 16 * convolution->group_input_channels;
+  } else {
+    const size_t output_size = output_height * output_width;
+    const size_t tiled_output_size = round_up(output_size, qnnp_operator_get_mr(convolution));
+    if (convolution->tile_indirection) {
+      /* Tiles compute their input pointers in qnnp_run_operator */
+    } else if (use_indirection_offsets(convolution, input_height, input_width, strided_input)) {
+      *workspace_size = sizeof(uint32_t) * tiled_output_size * kernel_size;
+    } else {
+      const size_t taps = qnnp_convolution_get_taps(convolution);
+      *workspace_size = sizeof(void*) * batch_size * groups * tiled_output_size * taps;
+    }
+  }
+}
+
+/*
+ * Builds the indirection buffer of a convolution that setup_convolution sized for its batch size and input
+ * dimensions, or rebases the previous one if it is reusable.
+ */
+static void init_convolution_indirection(
+    qnnp_operator_t convolution,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    size_t input_row_stride,
+    size_t input_image_stride,
+    size_t workspace_size,
+    bool external_workspace,
+    bool indirection_reusable,
+    const void* indirection_input)
+{
+  const size_t batch_size = convolution->batch_size;
+  const size_t input_height = convolution->input_height;
+  const size_t input_width = convolution->input_width;
+  const size_t groups = convolution->groups;
+  const size_t kernel_height = convolution->kernel_height;
+  const size_t kernel_width = convolution->kernel_width;
+  const size_t kernel_size = kernel_height * kernel_width;
   const size_t output_height = convolution->output_height;
   const size_t output_width = convolution->output_width;
   if (convolution->flags & QNNP_CONVOLUTION_FLAG_DW) {
-    const size_t subsampling_width = convolution->stride_width;
-    const size_t im2col_buffer_size = sizeof(void*) * batch_size * output_height *
-      (kernel_size + (output_width * subsampling_width - 1) * kernel_height);
+    const struct dw_indirection_layout layout = get_dw_indirection_layout(convolution, output_width);
+    const size_t phases = layout.phases;
+    const void** im2col_buffer = convolution->im2col_buffer;
+
+    const size_t channels = groups * convolution->group_output_channels;
+    if (qnnp_convolution_expands_input(convolution)) {
+      input = (const uint8_t*) convolution->expanded_input + 8;
+      input_pixel_stride = channels;
+      input_row_stride = input_width * channels;
+      input_image_stride = input_height * input_row_stride;
+    }
+
+    const void* zero = qnnp_get_indirection_zero(convolution);
+    if (indirection_reusable) {
+      qnnp_rebase_indirection_buffer(
+        im2col_buffer, workspace_size / sizeof(void*), zero, indirection_input, input);
+      convolution->indirection_input = input;
+      return;
+    }
+
+    for (size_t image = 0; image < batch_size; image++) {
+      for (size_t output_y = 0; output_y < output_height; output_y++) {
+        const void** im2col_phase = im2col_buffer + (image * output_height + output_y) * layout.row_stride;
+        for (size_t phase = 0; phase < min(phases, output_width); phase++) {
+          /* Pixels of the phase that share a pointer write the same input column to it */
+          for (size_t output_x = phase; output_x < output_width; output_x += phases) {
+            for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+              const size_t input_x =
+                output_x * convolution->stride_width + kernel_x * convolution->dilation_width -
+                convolution->input_padding_left;
+              for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+                const size_t input_y =
+                  output_y * convolution->stride_height + kernel_y * convolution->dilation_height -
+                  convolution->input_padding_top;
+                const size_t im2col_index = output_x / phases * layout.col_stride + kernel_x * kernel_height + kernel_y;
+                if (input_y < input_height && input_x < input_width) {
+                  im2col_phase[im2col_index] =
+                    input + image * input_image_stride + input_y * input_row_stride + input_x * input_pixel_stride;
+                } else {
+                  im2col_phase[im2col_index] = zero;
+                }
+              }
+            }
+          }
+          const size_t phase_width = divide_round_up(output_width - phase, phases);
+          im2col_phase += kernel_size + (phase_width - 1) * layout.col_stride;
+        }
+      }
+    }
+  } else {
+    const size_t output_size = output_height * output_width;
+    const size_t output_tile_size = qnnp_operator_get_mr(convolution);
+    const size_t tiled_output_size = round_up(output_size, output_tile_size);
+    const void** im2col_buffer = convolution->im2col_buffer;
+    /* Pixel strides and channel offsets are in elements, i.e. bytes for quantized operators */
+    const uint32_t log2_input_element_size = qnnp_operator_get_log2_input_element_size(convolution);
+
+    const void* zero = qnnp_get_indirection_zero(convolution);
+
+    const bool strided_input =
+      is_strided_input(input_height, input_width, input_pixel_stride, input_row_stride, input_image_stride);
+    const bool indirection_offsets = use_indirection_offsets(convolution, input_height, input_width, strided_input);
+    if (indirection_reusable) {
+      /* Pixel indices do not depend on the input pointer */
+      if (!indirection_offsets) {
+        qnnp_rebase_indirection_buffer(
+          im2col_buffer, workspace_size / sizeof(void*), zero, indirection_input, input);
+      }
+      convolution->indirection_input = input;
+      return;
+    }
+
+    const struct fxdiv_divisor_size_t output_width_divisor = fxdiv_init_size_t(output_width);
+    convolution->indirection_offsets = indirection_offsets;
+    if (indirection_offsets) {
+      /* Every image of the batch shares the indices of the first one, see compute_q8conv_with_offsets */
+      uint32_t* indirection_buffer = (uint32_t*) im2col_buffer;
+      for (size_t output_tile_start = 0; output_tile_start < tiled_output_size; output_tile_start += output_tile_size) {
+        for (size_t output_tile_offset = 0; output_tile_offset < output_tile_size; output_tile_offset++) {
+          const size_t tiled_output_index = output_tile_start + output_tile_offset;
+          const size_t output_index = min(tiled_output_index, output_size - 1);
+          const struct fxdiv_result_size_t output_index_components =
+            fxdiv_divide_size_t(output_index, output_width_divisor);
+          const size_t output_y = output_index_components.quotient;
+          const size_t output_x = output_index_components.remainder;
+          for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+            const size_t input_y =
+              output_y * convolution->stride_height + kernel_y * convolution->dilation_height - convolution->input_padding_top;
+            for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+              const size_t input_x =
+                output_x * convolution->stride_width + kernel_x * convolution->dilation_width - convolution->input_padding_left;
+              const size_t index =
+                output_tile_start * kernel_size + (kernel_y * kernel_width + kernel_x) * output_tile_size + output_tile_offset;
+              if (input_y < input_height && input_x < input_width) {
+                indirection_buffer[index] = (uint32_t) (input_y * input_width + input_x);
+              } else {
+                indirection_buffer[index] = QNNP_INDIRECTION_OFFSET_ZERO;
+              }
+            }
+          }
+        }
+      }
+      if (!external_workspace) {
+        convolution->indirection_input = input;
+      }
+      return;
+    }
+
+    if (convolution->flags & QNNP_CONVOLUTION_FLAG_NCHW) {
+      /* Taps of a kernel position are its input channels, each in its own plane of the image */
+      const size_t group_input_channels = convolution->group_input_channels;
+      const size_t taps = kernel_size * group_input_channels;
+      const size_t input_size = input_height * input_width;
+      for (size_t group = 0; group < groups; group++) {
+        for (size_t image = 0; image < batch_size; image++) {
+          const uint8_t* group_input = input + (image * groups + group) * group_input_channels * input_size;
+          for (size_t output_tile_start = 0; output_tile_start < tiled_output_size; output_tile_start += output_tile_size) {
+            for (size_t output_tile_offset = 0; output_tile_offset < output_tile_size; output_tile_offset++) {
+              const size_t tiled_output_index = output_tile_start + output_tile_offset;
+              const size_t output_index = min(tiled_output_index, output_size - 1);
+              const struct fxdiv_result_size_t output_index_components =
+                fxdiv_divide_size_t(output_index, output_width_divisor);
+              const size_t output_y = output_index_components.quotient;
+              const size_t output_x = output_index_components.remainder;
+              for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+                const size_t input_y =
+                  output_y * convolution->stride_height + kernel_y * convolution->dilation_height - convolution->input_padding_top;
+                for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+                  const size_t input_x =
+                    output_x * convolution->stride_width + kernel_x * convolution->dilation_width - convolution->input_padding_left;
+                  for (size_t channel = 0; channel < group_input_channels; channel++) {
+                    const size_t tap = (kernel_y * kernel_width + kernel_x) * group_input_channels + channel;
+                    const size_t im2col_index = (group * batch_size + image) * tiled_output_size * taps +
+                      output_tile_start * taps + tap * output_tile_size + output_tile_offset;
+                    if (input_y < input_height && input_x < input_width) {
+                      im2col_buffer[im2col_index] =
+                        group_input + channel * input_size + input_y * input_width + input_x;
+                    } else {
+                      im2col_buffer[im2col_index] = zero;
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+      if (!external_workspace) {
+        convolution->indirection_input = input;
+      }
+      return;
+    }
+
+    for (size_t group = 0; group < groups; group++) {
+      for (size_t image = 0; image < batch_size; image++) {
+        for (size_t output_tile_start = 0; output_tile_start < tiled_output_size; output_tile_start += output_tile_size) {
+          for (size_t output_tile_offset = 0; output_tile_offset < output_tile_size; output_tile_offset++) {
+            const size_t tiled_output_index = output_tile_start + output_tile_offset;
+            const size_t output_index = min(tiled_output_index, output_size - 1);
+            const struct fxdiv_result_size_t output_index_components =
+              fxdiv_divide_size_t(output_index, output_width_divisor);
+            const size_t output_y = output_index_components.quotient;
+            const size_t output_x = output_index_components.remainder;
+            for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+              const size_t input_y =
+                output_y * convolution->stride_height + kernel_y * convolution->dilation_height - convolution->input_padding_top;
+              if (input_y < input_height) {
+                for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+                  const size_t input_x =
+                    output_x * convolution->stride_width + kernel_x * convolution->dilation_width - convolution->input_padding_left;
+                  const size_t im2col_index =
+                    (group * batch_size + image) * tiled_output_size * kernel_size + output_tile_start * kernel_size + (kernel_y * kernel_width + kernel_x) * output_tile_size + output_tile_offset;
+                  if (input_x < input_width) {
+                    im2col_buffer[im2col_index] = input +
+                      ((image * input_image_stride + input_y * input_row_stride + input_x * input_pixel_stride +
+                        group * convolution->group_input_channels) << log2_input_element_size);
+                  } else {
+                    im2col_buffer[im2col_index] = zero;
+                  }
+                }
+              } else {
+                for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+                  const size_t im2col_index =
+                    (group * batch_size + image) * tiled_output_size * kernel_size + output_tile_start * kernel_size + (kernel_y * kernel_width + kernel_x) * output_tile_size + output_tile_offset;
+                  im2col_buffer[im2col_index] = zero;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (!external_workspace) {
+    convolution->indirection_input = input;
+  }
+}
+
+static enum qnnp_status setup_convolution(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    size_t input_row_stride,
+    size_t input_image_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    bool external_workspace,
+    void* workspace,
+    void* scratch)
+{
+  const uint64_t setup_start = qnnp_profile_start();
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_convolution2d_nhwc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup convolution with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (input_width == 0 || input_height == 0) {
+    qnnp_log_error(
+      "failed to setup convolution with %zux%zu input: input dimensions must be non-zero",
+      input_width,
+      input_height);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if ((convolution->flags & QNNP_CONVOLUTION_FLAG_NCHW) &&
+      input_pixel_stride != convolution->groups * convolution->group_input_channels)
+  {
+    qnnp_log_error(
+      "failed to setup convolution with NCHW input and input pixel stride of %zu: "
+      "stride must equal the number of input channels (%zu)",
+      input_pixel_stride, convolution->groups * convolution->group_input_channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const bool strided_input =
+    is_strided_input(input_height, input_width, input_pixel_stride, input_row_stride, input_image_stride);
+  if (strided_input &&
+      ((convolution->flags &
+        (QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_XZP_GEMM | QNNP_CONVOLUTION_FLAG_WINOGRAD |
+         QNNP_CONVOLUTION_FLAG_NCHW)) ||
+       convolution->tile_indirection || convolution->xzp_calibration != NULL))
+  {
+    qnnp_log_error(
+      "failed to setup convolution with input row stride of %zu and image stride of %zu: "
+      "this convolution only reads packed inputs",
+      input_row_stride, input_image_stride);
+    return qnnp_status_unsupported_parameter;
+  }
+
+  size_t workspace_size, scratch_size;
+  compute_convolution_workspace_size(
+    convolution, batch_size, input_height, input_width, strided_input, &workspace_size, &scratch_size);
+  /*
+   * With the same geometry the indirection buffer only changes with the input pointer, e.g. when the caller
+   * alternates between input buffers, and is rebased instead of rebuilt. Caller-provided workspace may have been
+   * overwritten since the last setup, so it is always rebuilt.
+   */
+  const void* indirection_input = convolution->indirection_input;
+  bool indirection_reusable = !external_workspace && !convolution->external_workspace &&
+    indirection_input != NULL &&
+    convolution->batch_size == batch_size &&
+    convolution->input_height == input_height &&
+    convolution->input_width == input_width &&
+    convolution->input_pixel_stride == input_pixel_stride &&
+    convolution->input_row_stride == input_row_stride &&
+    convolution->input_image_stride == input_image_stride;
+  convolution->indirection_input = NULL;
+  const void* prebuilt_indirection_input = convolution->prebuilt_indirection_input;
+  convolution->prebuilt_indirection_input = NULL;
+  if (external_workspace) {
+    if ((workspace_size != 0 && workspace == NULL) || (scratch_size != 0 && scratch == NULL)) {
+      qnnp_log_error(
+        "failed to setup convolution: %zu bytes of workspace and %zu bytes of scratch required", workspace_size, scratch_size);
+      return qnnp_status_invalid_parameter;
+    }
+    if (!convolution->external_workspace) {
+      qnnp_deallocate(convolution->im2col_buffer);
+      qnnp_deallocate(convolution->expanded_input);
+    }
+    convolution->im2col_buffer = (const void**) workspace;
+    convolution->expanded_input = scratch;
+    if (prebuilt_indirection_input != NULL) {
+      indirection_input = prebuilt_indirection_input;
+      indirection_reusable = true;
+    }
+  } else {
+    if (convolution->external_workspace) {
+      convolution->im2col_buffer = NULL;
+      convolution->expanded_input = NULL;
+    }
+    if (convolution->setup_cache != NULL && !indirection_reusable) {
+      /*
+       * Cache the indirection buffer of the last shape, and take the one of this shape if it is cached. Entries are
+       * keyed by the pixel stride, so indirection buffers of strided inputs are neither cached nor taken.
+       */
+      const bool previous_strided_input = is_strided_input(
+        convolution->input_height, convolution->input_width, convolution->input_pixel_stride,
+        convolution->input_row_stride, convolution->input_image_stride);
+      if (indirection_input != NULL && !previous_strided_input) {
+        size_t previous_workspace_size, previous_scratch_size;
+        compute_convolution_workspace_size(
+          convolution, convolution->batch_size, convolution->input_height, convolution->input_width, false,
+          &previous_workspace_size, &previous_scratch_size);
+        qnnp_setup_cache_store(convolution, previous_workspace_size, indirection_input);
+      }
+      if (!strided_input &&
+          qnnp_setup_cache_restore(convolution, batch_size, input_height, input_width, input_pixel_stride))
+      {
+        indirection_input = convolution->indirection_input;
+        convolution->indirection_input = NULL;
+        indirection_reusable = true;
+      }
+    }
+    if (workspace_size != 0) {
+      const void** im2col_buffer = (const void**) qnnp_reallocate(convolution->im2col_buffer, workspace_size);
+      if (im2col_buffer == NULL) {
+        qnnp_log_error("failed to allocate %zu bytes for im2col buffer", workspace_size);
+        return qnnp_status_out_of_memory;
+      }
+      convolution->im2col_buffer = im2col_buffer;
+    }
+    if (scratch_size != 0) {
+      void* expanded_input = qnnp_reallocate(convolution->expanded_input, scratch_size);
+      if (expanded_input == NULL) {
+        qnnp_log_error("failed to allocate %zu bytes for expanded input", scratch_size);
+        return qnnp_status_out_of_memory;
+      }
+      convolution->expanded_input = expanded_input;
+    }
+  }
+  convolution->external_workspace = external_workspace;
+
+  convolution->batch_size = batch_size;
+  convolution->input_height = input_height;
+  convolution->input_width = input_width;
+  convolution->input = input;
+  convolution->input_pixel_stride = input_pixel_stride;
+  convolution->input_row_stride = input_row_stride;
+  convolution->input_image_stride = input_image_stride;
+  convolution->roi_count = 0;
+
+  convolution->output_height = compute_convolution_output_dimension(
+      convolution->input_padding_top + input_height + convolution->input_padding_bottom,
+      convolution->kernel_height,
+      convolution->dilation_height,
+      convolution->stride_height);
+  convolution->output_width = compute_convolution_output_dimension(
+      convolution->input_padding_left + input_width + convolution->input_padding_right,
+      convolution->kernel_width,
+      convolution->dilation_width,
+      convolution->stride_width);
+  convolution->output = output;
+  convolution->output_pixel_stride = output_pixel_stride;
+
+  /*
+   * Convolutions that map directly to GEMM, including XZP GEMM, don't use the im2col buffer, Winograd only needs the
+   * transformed input, which is computed in qnnp_run_operator, and with tile indirection or in stems tiles compute
+   * their input pointers in qnnp_run_operator.
+   */
+  if (!(convolution->flags &
+        (QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_XZP_GEMM | QNNP_CONVOLUTION_FLAG_WINOGRAD |
+         QNNP_CONVOLUTION_FLAG_STEM)) &&
+      !convolution->tile_indirection)
+  {
+    const uint64_t indirection_start = qnnp_profile_start();
+    init_convolution_indirection(
+      convolution, input, input_pixel_stride, input_row_stride, input_image_stride, workspace_size,
+      external_workspace, indirection_reusable, indirection_input);
+    qnnp_profile_phase(convolution, qnnp_profiling_phase_indirection, indirection_start);
+  }
+  qnnp_profile_phase(convolution, qnnp_profiling_phase_setup, setup_start);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_setup_convolution_indirection(
+    qnnp_operator_t op,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride)
+{
+  return setup_convolution(
+    op,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride, input_width * input_pixel_stride, input_height * input_width * input_pixel_stride,
+    output, output_pixel_stride,
+    false, NULL, NULL);
+}
+
+enum qnnp_status qnnp_get_convolution2d_nhwc_q8_workspace_size(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t* workspace_size,
+    size_t* scratch_size)
+{
+  compute_convolution_workspace_size(
+    convolution, batch_size, input_height, input_width, false, workspace_size, scratch_size);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_setup_convolution2d_nhwc_q8(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  return setup_convolution(
+    convolution,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride, input_width * input_pixel_stride, input_height * input_width * input_pixel_stride,
+    output, output_pixel_stride,
+    false, NULL, NULL);
+}
+
+enum qnnp_status qnnp_setup_convolution2d_nhwc_q8_with_workspace(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    void* workspace,
+    void* scratch,
+    pthreadpool_t threadpool)
+{
+  return setup_convolution(
+    convolution,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride, input_width * input_pixel_stride, input_height * input_width * input_pixel_stride,
+    output, output_pixel_stride,
+    true, workspace, scratch);
+}
+
+enum qnnp_status qnnp_setup_convolution2d_nhwc_q8_with_strides(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    size_t input_row_stride,
+    size_t input_image_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  return setup_convolution(
+    convolution,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride, input_row_stride, input_image_stride,
+    output, output_pixel_stride,
+    false, NULL, NULL);
+}
+
+enum qnnp_status qnnp_setup_convolution2d_nhwc_q8_rois(
+    qnnp_operator_t convolution,
+    size_t roi_count,
+    const struct qnnp_roi* rois,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  const uint64_t setup_start = qnnp_profile_start();
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_convolution2d_nhwc_q8_rois failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (convolution->type != qnnp_operator_type_convolution || convolution->format != qnnp_format_quint8) {
+    qnnp_log_error(
+      "failed to setup convolution with ROIs: operator was not created by qnnp_create_convolution2d_nhwc_q8");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (roi_count == 0) {
+    qnnp_log_error("failed to setup convolution with %zu ROIs: number of ROIs must be non-zero", roi_count);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if ((convolution->flags &
+       (QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_XZP_GEMM | QNNP_CONVOLUTION_FLAG_DW |
+        QNNP_CONVOLUTION_FLAG_WINOGRAD | QNNP_CONVOLUTION_FLAG_STEM | QNNP_CONVOLUTION_FLAG_NCHW)) ||
+      convolution->tile_indirection || convolution->xzp_calibration != NULL)
+  {
+    qnnp_log_error("failed to setup convolution with ROIs: convolution does not build a generic indirection buffer");
+    return qnnp_status_unsupported_parameter;
+  }
+
+  const size_t padded_height = convolution->input_padding_top + convolution->input_padding_bottom;
+  const size_t padded_width = convolution->input_padding_left + convolution->input_padding_right;
+  size_t output_size = 0;
+  for (size_t roi = 0; roi < roi_count; roi++) {
+    if (rois[roi].height == 0 || rois[roi].width == 0) {
+      qnnp_log_error(
+        "failed to setup convolution with %zux%zu ROI %zu: ROI dimensions must be non-zero",
+        rois[roi].width, rois[roi].height, roi);
+      return qnnp_status_invalid_parameter;
+    }
+    output_size +=
+      compute_convolution_output_dimension(
+        padded_height + rois[roi].height, convolution->kernel_height,
+        convolution->dilation_height, convolution->stride_height) *
+      compute_convolution_output_dimension(
+        padded_width + rois[roi].width, convolution->kernel_width,
+        convolution->dilation_width, convolution->stride_width);
+  }
+
+  const size_t groups = convolution->groups;
+  const size_t group_input_channels = convolution->group_input_channels;
+  const size_t kernel_height = convolution->kernel_height;
+  const size_t kernel_width = convolution->kernel_width;
+  const size_t kernel_size = kernel_height * kernel_width;
+  const size_t output_tile_size = qnnp_operator_get_mr(convolution);
+  const size_t tiled_output_size = round_up(output_size, output_tile_size);
+  const size_t workspace_size = sizeof(void*) * groups * tiled_output_size * kernel_size;
+  if (convolution->external_workspace) {
+    convolution->im2col_buffer = NULL;
+    convolution->expanded_input = NULL;
+    convolution->external_workspace = false;
+  }
+  const void** im2col_buffer = (const void**) qnnp_reallocate(convolution->im2col_buffer, workspace_size);
+  if (im2col_buffer == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for im2col buffer", workspace_size);
+    return qnnp_status_out_of_memory;
+  }
+  convolution->im2col_buffer = im2col_buffer;
+
+  const uint64_t indirection_start = qnnp_profile_start();
+  const uint8_t* zero = (const uint8_t*) convolution->zero;
+  if (qnnp_convolution_get_tap_channels(convolution) < 8) {
+    zero += 8;
+  }
+  /* Output pixels of all crops form one sequence of tiles, as the output pixels of one image do */
+  size_t output_index = 0;
+  for (size_t roi = 0; roi < roi_count; roi++) {
+    const uint8_t* input = rois[roi].input;
+    const size_t input_height = rois[roi].height;
+    const size_t input_width = rois[roi].width;
+    const size_t input_row_stride = rois[roi].row_stride;
+    const size_t output_height = compute_convolution_output_dimension(
+      padded_height + input_height, kernel_height, convolution->dilation_height, convolution->stride_height);
+    const size_t output_width = compute_convolution_output_dimension(
+      padded_width + input_width, kernel_width, convolution->dilation_width, convolution->stride_width);
+    for (size_t output_y = 0; output_y < output_height; output_y++) {
+      for (size_t output_x = 0; output_x < output_width; output_x++) {
+        const size_t output_tile_start = output_index / output_tile_size * output_tile_size;
+        const size_t output_tile_offset = output_index - output_tile_start;
+        for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+          const size_t input_y = output_y * convolution->stride_height +
+            kernel_y * convolution->dilation_height - convolution->input_padding_top;
+          for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+            const size_t input_x = output_x * convolution->stride_width +
+              kernel_x * convolution->dilation_width - convolution->input_padding_left;
+            const bool in_roi = input_y < input_height && input_x < input_width;
+            for (size_t group = 0; group < groups; group++) {
+              const size_t im2col_index = group * tiled_output_size * kernel_size + output_tile_start * kernel_size +
+                (kernel_y * kernel_width + kernel_x) * output_tile_size + output_tile_offset;
+              im2col_buffer[im2col_index] = in_roi ?
+                input + input_y * input_row_stride + input_x * input_pixel_stride + group * group_input_channels : zero;
+            }
+          }
+        }
+        output_index++;
+      }
+    }
+  }
+  /* Rows of the last tile past the output compute the last output pixel again */
+  const size_t last_tile_start = (output_size - 1) / output_tile_size * output_tile_size;
+  const size_t last_tile_offset = output_size - 1 - last_tile_start;
+  for (size_t output_tile_offset = last_tile_offset + 1; output_tile_offset < output_tile_size; output_tile_offset++) {
+    for (size_t group = 0; group < groups; group++) {
+      const void** tile = im2col_buffer + group * tiled_output_size * kernel_size + last_tile_start * kernel_size;
+      for (size_t tap = 0; tap < kernel_size; tap++) {
+        tile[tap * output_tile_size + output_tile_offset] = tile[tap * output_tile_size + last_tile_offset];
+      }
+    }
+  }
+  qnnp_profile_phase(convolution, qnnp_profiling_phase_indirection, indirection_start);
+
+  convolution->batch_size = 1;
+  convolution->input_height = 1;
+  convolution->input_width = output_size;
+  convolution->input = rois[0].input;
+  convolution->input_pixel_stride = input_pixel_stride;
+  convolution->input_row_stride = output_size * input_pixel_stride;
+  convolution->input_image_stride = convolution->input_row_stride;
+  convolution->roi_count = roi_count;
+  /* The indirection buffer points into every crop, so it cannot be rebased onto another input */
+  convolution->indirection_input = NULL;
+  convolution->indirection_offsets = false;
+  convolution->output_height = 1;
+  convolution->output_width = output_size;
+  convolution->output = output;
+  convolution->output_pixel_stride = output_pixel_stride;
+  qnnp_profile_phase(convolution, qnnp_profiling_phase_setup, setup_start);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_setup_convolution2d_nhwc_f32(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const float* input,
+    size_t input_pixel_stride,
+    float* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  if (convolution->format != qnnp_format_float32) {
+    qnnp_log_error("failed to setup convolution: operator was not created by qnnp_create_convolution2d_nhwc_f32");
+    return qnnp_status_invalid_parameter;
+  }
+
+  return setup_convolution(
+    convolution,
+    batch_size, input_height, input_width,
+    (const uint8_t*) input, input_pixel_stride,
+    input_width * input_pixel_stride, input_height * input_width * input_pixel_stride,
+    (uint8_t*) output, output_pixel_stride,
+    false, NULL, NULL);
+}
+
+enum qnnp_status qnnp_setup_convolution2d_nhwc_f16(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const void* input,
+    size_t input_pixel_stride,
+    void* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  if (convolution->format != qnnp_format_float16) {
+    qnnp_log_error("failed to setup convolution: operator was not created by qnnp_create_convolution2d_nhwc_f16");
+    return qnnp_status_invalid_parameter;
+  }
+
+  return setup_convolution(
+    convolution,
+    batch_size, input_height, input_width,
+    (const uint8_t*) input, input_pixel_stride,
+    input_width * input_pixel_stride, input_height * input_width * input_pixel_stride,
+    (uint8_t*) output, output_pixel_stride,
+    false, NULL, NULL);
+}
+
+/* Maps an mr x nr tile of requantized outputs through the operator lookup table while it is still in cache */
+static inline void apply_lookup_table(
+    size_t rows,
+    size_t columns,
+    uint8_t* output,
+    size_t output_stride,
+    const uint8_t* lookup_table)
+{
+  const x8lut_ukernel_function x8lut = qnnp_params.x8lut;
+  do {
+    x8lut(columns, output, lookup_table, output);
+    output += output_stride;
+  } while (--rows != 0);
+}
+
+/*
+ * Stores a tile of rows x columns requantized outputs feature-major, output channel j of row i at
+ * output[j * output_stride + i], see QNNP_CONVOLUTION_FLAG_TRANSPOSED_OUTPUT.
+ */
+static inline void store_transposed_tile(
+    size_t rows,
+    size_t columns,
+    const uint8_t* tile,
+    size_t tile_stride,
+    uint8_t* output,
+    size_t output_stride)
+{
+  for (size_t j = 0; j < columns; j++) {
+    for (size_t i = 0; i < rows; i++) {
+      output[i] = tile[i * tile_stride + j];
+    }
+    output += output_stride;
+  }
+}
+
+struct q8gemm_context {
+  size_t k;
+  size_t k_stride;
+  size_t n;
+  size_t n_stride;
+  size_t nr;
+  const uint8_t* a;
+  size_t a_stride;
+  const uint8_t* packed_b;
+  const int32_t* bias;
+  uint8_t* c;
+  size_t c_stride;
+  uint8_t a_zero_point;
+  uint8_t b_zero_point;
+  union qnnp_q31_requantization_params requantization_params;
+  const uint8_t* lookup_table;
+  const struct q8conv_uarch_ukernels ukernels;
+  /* Microkernels store tiles into a buffer that is then stored feature-major, see store_transposed_tile */
+  bool transposed_c;
+};
+
+static void compute_q8gemm(
+    const struct q8gemm_context context[restrict static 1],
+    size_t group_index,
+    size_t pixel_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t pixel_range,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t k = context->k;
+  const size_t k_stride = context->k_stride;
+  const size_t n = context->n;
+  const size_t n_stride = context->n_stride;
+  const uint8_t* restrict a = context->a;
+  const size_t a_stride = context->a_stride;
+  const uint8_t* restrict packed_b = context->packed_b;
+  const int32_t* restrict bias = context->bias;
+  uint8_t* restrict c = context->c;
+  const size_t c_stride = context->c_stride;
+  const uint8_t a_zero_point = context->a_zero_point;
+  const uint8_t b_zero_point = context->b_zero_point;
+  uint8_t transposed_tile[QNNP_TRANSPOSED_OUTPUT_MAX_TILE_SIZE];
+  uint8_t* tile_c = c + (pixel_index + mr_block_start) * c_stride + nr_block_start + group_index * n;
+  size_t tile_c_stride = c_stride;
+  if (context->transposed_c) {
+    assert(mr_block_size * context->nr <= QNNP_TRANSPOSED_OUTPUT_MAX_TILE_SIZE);
+    tile_c = transposed_tile;
+    tile_c_stride = context->nr;
+  }
+
+  context->ukernels.gemm[qnnp_get_current_uarch_index()](
+      mr_block_size,
+      nr_block_size,
+      k,
+      a + (pixel_index + mr_block_start) * a_stride + group_index * k,
+      a_stride,
+      packed_b + nr_block_start * k_stride + group_index * k_stride * n_stride,
+      bias + nr_block_start + group_index * n_stride,
+      tile_c,
+      tile_c_stride,
+      a_zero_point,
+      b_zero_point,
+      &context->requantization_params);
+  if (context->lookup_table != NULL) {
+    apply_lookup_table(mr_block_size, nr_block_size, tile_c, tile_c_stride, context->lookup_table);
+  }
+  if (context->transposed_c) {
+    store_transposed_tile(
+      mr_block_size, nr_block_size, transposed_tile, tile_c_stride,
+      c + (nr_block_start + group_index * n) * c_stride + pixel_index + mr_block_start, c_stride);
+  }
+}
+
+struct q8gemm_sparse_context {
+  const uint8_t* a;
+  size_t a_stride;
+  const uint32_t* row_ptr;
+  const uint32_t* block_channels;
+  const uint8_t* values;
+  const int32_t* bias;
+  uint8_t* c;
+  size_t c_stride;
+  uint8_t a_zero_point;
+  uint8_t b_zero_point;
+  union qnnp_q31_requantization_params requantization_params;
+  const uint8_t* lookup_table;
+  q8gemm_sparse_ukernel_function ukernel;
+  size_t nr;
+  /* As for q8gemm_context::transposed_c */
+  bool transposed_c;
+};
+
+static void compute_q8gemm_sparse(
+    const struct q8gemm_sparse_context context[restrict static 1],
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  uint8_t transposed_tile[QNNP_TRANSPOSED_OUTPUT_MAX_TILE_SIZE];
+  uint8_t* tile_c = context->c + mr_block_start * context->c_stride + nr_block_start;
+  size_t tile_c_stride = context->c_stride;
+  if (context->transposed_c) {
+    assert(mr_block_size * context->nr <= QNNP_TRANSPOSED_OUTPUT_MAX_TILE_SIZE);
+    tile_c = transposed_tile;
+    tile_c_stride = context->nr;
+  }
+  context->ukernel(
+      mr_block_size,
+      nr_block_size,
+      context->a + mr_block_start * context->a_stride,
+      context->a_stride,
+      context->row_ptr + nr_block_start,
+      context->block_channels,
+      context->values,
+      context->bias + nr_block_start,
+      tile_c,
+      tile_c_stride,
+      context->a_zero_point,
+      context->b_zero_point,
+      &context->requantization_params);
+  if (context->lookup_table != NULL) {
+    apply_lookup_table(mr_block_size, nr_block_size, tile_c, tile_c_stride, context->lookup_table);
+  }
+  if (context->transposed_c) {
+    store_transposed_tile(
+      mr_block_size, nr_block_size, transposed_tile, tile_c_stride,
+      context->c + nr_block_start * context->c_stride + mr_block_start, context->c_stride);
+  }
+}
+
+/*
+ * Computes all nr-wide tiles of one M tile within a panel of nc output channels. Threads walk the M tiles of a
+ * panel in order, so its packed kernel stays in L2 and is loaded from memory once rather than once per M tile.
+ */
+static void compute_q8gemm_nc_panel(
+    const struct q8gemm_context context[restrict static 1],
+    size_t group_index,
+    size_t nc_block_start,
+    size_t mr_block_start,
+    size_t group_range /* always 1 */,
+    size_t nc_block_size,
+    size_t mr_block_size)
+{
+  const size_t nr = context->nr;
+  for (size_t nr_block_offset = 0; nr_block_offset < nc_block_size; nr_block_offset += nr) {
+    compute_q8gemm(
+        context, group_index, 0, mr_block_start, nc_block_start + nr_block_offset,
+        1, 1, mr_block_size, min(nc_block_size - nr_block_offset, nr));
+  }
+}
+
+struct q8gemm_split_k_context {
+  size_t k;
+  size_t k_slice;
+  size_t k_stride;
+  size_t m;
+  size_t n;
+  size_t nr;
+  const uint8_t* a;
+  size_t a_stride;
+  const void* packed_b;
+  int32_t* partial_sums;
+  uint8_t a_zero_point;
+  uint8_t b_zero_point;
+  q8gemm_acc32_ukernel_function ukernel;
+};
+
+static void compute_q8gemm_split_k(
+    const struct q8gemm_split_k_context context[restrict static 1],
+    size_t slice_index,
+    size_t row_index,
+    size_t nr_block_start,
+    size_t slice_range /* always 1 */,
+    size_t row_range /* always 1 */,
+    size_t nr_block_size)
+{
+  const size_t k_slice = context->k_slice;
+  const size_t k_start = slice_index * k_slice;
+  const size_t n = context->n;
+  const uint8_t* packed_b = context->packed_b;
+
+  /* Slices start on kr boundaries, where the packed kernel has nr x k_start bytes of the block before them */
+  context->ukernel(
+      1,
+      nr_block_size,
+      min(context->k - k_start, k_slice),
+      context->a + row_index * context->a_stride + k_start,
+      context->a_stride,
+      packed_b + nr_block_start * context->k_stride + k_start * context->nr,
+      context->partial_sums + (slice_index * context->m + row_index) * n + nr_block_start,
+      n * sizeof(int32_t),
+      context->a_zero_point,
+      context->b_zero_point);
+}
+
+/* Rows of a fully-connected operator with int32 or float outputs, see qnnp_setup_fully_connected_nc_q8_s32 */
+struct q8gemm_accumulator_context {
+  size_t k;
+  size_t k_stride;
+  size_t nr;
+  const uint8_t* a;
+  size_t a_stride;
+  const void* packed_b;
+  const int32_t* bias;
+  void* c;
+  /* Outputs of a row, and of an output channel, are c_stride and c_channel_stride elements apart */
+  size_t c_stride;
+  size_t c_channel_stride;
+  uint8_t a_zero_point;
+  uint8_t b_zero_point;
+  enum qnnp_accumulator_output accumulator_output;
+  float accumulator_scale;
+  q8gemm_acc32_ukernel_function ukernel;
+};
+
+static void compute_q8gemm_accumulators(
+    const struct q8gemm_accumulator_context context[restrict static 1],
+    size_t row_index,
+    size_t channel_start,
+    size_t row_range /* always 1 */,
+    size_t channels)
+{
+  const size_t nr = context->nr;
+  const uint8_t* packed_b = context->packed_b;
+  const size_t c_offset = row_index * context->c_stride;
+  for (size_t nr_block_start = channel_start; nr_block_start < channel_start + channels; nr_block_start += nr) {
+    const size_t nr_block_size = min(channel_start + channels - nr_block_start, nr);
+    int32_t acc[QNNP_ACCUMULATOR_OUTPUT_MAX_NR];
+    context->ukernel(
+        1,
+        nr_block_size,
+        context->k,
+        context->a + row_index * context->a_stride,
+        context->a_stride,
+        packed_b + nr_block_start * context->k_stride,
+        acc,
+        nr * sizeof(int32_t),
+        context->a_zero_point,
+        context->b_zero_point);
+
+    /* Bias is added while the accumulators are still in registers or L1, instead of by the microkernel */
+    const int32_t* bias = context->bias + nr_block_start;
+    const size_t c_channel_stride = context->c_channel_stride;
+    if (context->accumulator_output == qnnp_accumulator_output_float32) {
+      float* c = (float*) context->c + c_offset + nr_block_start * c_channel_stride;
+      const float scale = context->accumulator_scale;
+      for (size_t n = 0; n < nr_block_size; n++) {
+        c[n * c_channel_stride] = (float) (acc[n] + bias[n]) * scale;
+      }
+    } else {
+      int32_t* c = (int32_t*) context->c + c_offset + nr_block_start * c_channel_stride;
+      for (size_t n = 0; n < nr_block_size; n++) {
+        c[n * c_channel_stride] = acc[n] + bias[n];
+      }
+    }
+  }
+}
+
+struct q8gemm_split_k_reduction_context {
+  size_t slices;
+  size_t m;
+  size_t n;
+  const int32_t* partial_sums;
+  const int32_t* bias;
+  uint8_t* c;
+  /* As for q8gemm_accumulator_context */
+  size_t c_stride;
+  size_t c_channel_stride;
+  union qnnp_q31_requantization_params scalar_requantization_params;
+  bool fp32_requantization;
+  const uint8_t* lookup_table;
+};
+
+static void compute_q8gemm_split_k_reduction(
+    const struct q8gemm_split_k_reduction_context context[restrict static 1],
+    size_t row_index,
+    size_t channel_start,
+    size_t row_range /* always 1 */,
+    size_t channels)
+{
+  const size_t slices = context->slices;
+  const size_t n = context->n;
+  const size_t slice_stride = context->m * n;
+  const int32_t* partial_sums = context->partial_sums + row_index * n + channel_start;
+  const int32_t* bias = context->bias + channel_start;
+  const size_t c_channel_stride = context->c_channel_stride;
+  uint8_t* c = context->c + row_index * context->c_stride + channel_start * c_channel_stride;
+  const uint8_t* lookup_table = context->lookup_table;
+  for (size_t channel = 0; channel < channels; channel++) {
+    int32_t acc = bias[channel];
+    for (size_t slice = 0; slice < slices; slice++) {
+      acc += partial_sums[slice * slice_stride + channel];
+    }
+    const uint8_t output = context->fp32_requantization ?
+      qnnp_fp32_requantize(acc, context->scalar_requantization_params) :
+      qnnp_q31_requantize(acc, context->scalar_requantization_params);
+    c[channel * c_channel_stride] = lookup_table != NULL ? lookup_table[output] : output;
+  }
+}
+
+/* Rows the sum-rows microkernels take at a time, and at least the mr of the XZP GEMM microkernels */
+#define QNNP_XZP_MAX_MR 4
+
+struct q8gemm_xzp_context {
+  size_t k;
+  size_t k_stride;
+  size_t n;
+  size_t n_stride;
+  size_t nr;
+  const uint8_t* a;
+  size_t a_stride;
+  const uint8_t* packed_b;
+  const int32_t* bias;
+  uint8_t* c;
+  size_t c_stride;
+  int32_t a_sum_multiplier;
+  union qnnp_q31_requantization_params requantization_params;
+  const uint8_t* lookup_table;
+  const q8gemm_xzp_ukernel_function ukernel;
+  const q8sum_rows_ukernel_function sum_rows_ukernel;
+};
+
+/*
+ * Computes the mr rows of a panel of output channels, which is one or more nr-wide tiles. The sums of the input rows
+ * times the negated kernel zero point are computed first, while the rows come into cache for the GEMM, and shared by
+ * all tiles of the panel.
+ */
+static void compute_q8gemm_xzp(
+    const struct q8gemm_xzp_context context[restrict static 1],
+    size_t group_index,
+    size_t pixel_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t pixel_range,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t k = context->k;
+  const size_t k_stride = context->k_stride;
+  const size_t n = context->n;
+  const size_t n_stride = context->n_stride;
+  const size_t nr = context->nr;
+  const size_t a_stride = context->a_stride;
+  const size_t c_stride = context->c_stride;
+  const uint8_t* a = context->a + (pixel_index + mr_block_start) * a_stride + group_index * k;
+
+  assert(mr_block_size <= QNNP_XZP_MAX_MR);
+  int32_t a_sum[QNNP_XZP_MAX_MR];
+  context->sum_rows_ukernel(a, mr_block_size, k, a_stride, context->a_sum_multiplier, a_sum);
+
+  for (size_t n_offset = 0; n_offset < nr_block_size; n_offset += nr) {
+    const size_t n_block_start = nr_block_start + n_offset;
+    const size_t n_block_size = min(nr_block_size - n_offset, nr);
+    uint8_t* tile_c = context->c + (pixel_index + mr_block_start) * c_stride + n_block_start + group_index * n;
+    context->ukernel(
+        mr_block_size,
+        n_block_size,
+        k,
+        a,
+        a_stride,
+        context->packed_b + n_block_start * k_stride + group_index * k_stride * n_stride,
+        context->bias + n_block_start + group_index * n_stride,
+        tile_c,
+        c_stride,
+        a_sum,
+        &context->requantization_params);
+    if (context->lookup_table != NULL) {
+      apply_lookup_table(mr_block_size, n_block_size, tile_c, c_stride, context->lookup_table);
+    }
+  }
+}
+
+struct q8conv_context {
+  size_t bs;
+  size_t ks;
+  size_t kc;
+  size_t kc_stride;
+  size_t m;
+  size_t m_stride;
+  size_t n;
+  size_t n_stride;
+  const uint8_t** im2col_a;
+  /* With pixel indices in place of im2col_a, see qnnp_use_indirection_offsets */
+  const uint32_t* indirection_offsets;
+  size_t mr;
+  const uint8_t* a;
+  size_t a_pixel_stride;
+  const uint8_t* zero;
+  /* Without an indirection buffer, see QNNP_CREATE_FLAG_TILE_INDIRECTION */
+  size_t input_height;
+  size_t input_width;
+  struct fxdiv_divisor_size_t output_width_divisor;
+  size_t kernel_height;
+  size_t kernel_width;
+  size_t stride_height;
+  size_t stride_width;
+  size_t dilation_height;
+  size_t dilation_width;
+  size_t input_padding_top;
+  size_t input_padding_left;
+  /* Range of output pixels within each image, see qnnp_run_convolution2d_nhwc_q8_rows */
+  size_t m_start;
+  size_t m_end;
+  const uint8_t* packed_b;
+  const int32_t* bias;
+  /* int32_t elements of the packed bias per output channel: 2 when per-channel scales follow the biases */
+  size_t bias_stride;
+  /* Bytes of packed kernel per tap of an nr-block, or 0 if tiles must run all taps, see run_q8conv_tile */
+  size_t tap_stride;
+  uint8_t* c;
+  size_t c_stride;
+  uint8_t a_zero_point;
+  uint8_t b_zero_point;
+  union qnnp_q31_requantization_params requantization_params;
+  const uint8_t* lookup_table;
+  const struct q8conv_uarch_ukernels ukernels;
+  /*
+   * Microkernels of XZP convolutions, see QNNP_CONVOLUTION_FLAG_XZP_CONV, which run on panels of nr-wide tiles that
+   * share the sums of their input rows, or NULL
+   */
+  q8conv_xzp_ukernel_function xzp_ukernel;
+  q8conv_sum_rows_ukernel_function sum_rows_ukernel;
+  size_t nr;
+  int32_t a_sum_multiplier;
+};
+
+/*
+ * Runs the conv microkernel on a tile with the mr x ks input pointers a, where a[tap * mr + i] is for row i. Taps that
+ * read the zero buffer in every row add nothing to the accumulators, because the microkernels multiply the input
+ * minus its zero point. Leading and trailing runs of such taps, e.g. the kernel rows above the top border, are
+ * skipped together with their contiguous slices of the packed kernel.
+ */
+static void run_q8conv_tile(
+    const struct q8conv_context context[restrict static 1],
+    size_t group_index,
+    size_t nr_block_start,
+    size_t mr_block_size,
+    size_t nr_block_size,
+    const uint8_t** a,
+    uint8_t* tile_c)
+{
+  const size_t mr = context->mr;
+  const size_t n_stride = context->n_stride;
+  if (context->xzp_ukernel != NULL) {
+    /* Sums of the rows over all taps, including the padded ones, are shared by all tiles of the panel */
+    assert(mr <= QNNP_XZP_MAX_MR);
+    int32_t a_sum[QNNP_XZP_MAX_MR];
+    context->sum_rows_ukernel(context->kc, context->ks, a, context->a_sum_multiplier, a_sum);
+    const size_t nr = context->nr;
+    for (size_t n_offset = 0; n_offset < nr_block_size; n_offset += nr) {
+      const size_t n_block_start = nr_block_start + n_offset + group_index * n_stride;
+      context->xzp_ukernel(
+          mr_block_size,
+          min(nr_block_size - n_offset, nr),
+          context->kc,
+          context->ks,
+          a,
+          context->packed_b + n_block_start * context->kc_stride,
+          context->bias + n_block_start,
+          tile_c + n_offset,
+          context->c_stride,
+          a_sum,
+          &context->requantization_params);
+    }
+    if (context->lookup_table != NULL) {
+      apply_lookup_table(mr_block_size, nr_block_size, tile_c, context->c_stride, context->lookup_table);
+    }
+    return;
+  }
+
+  const uint8_t* zero = context->zero;
+  size_t tap_start = 0;
+  size_t tap_end = context->ks;
+  if (context->tap_stride != 0) {
+    /* At least one tap must run; with every tap padded, each one adds nothing */
+    while (tap_end - tap_start > 1) {
+      size_t i = 0;
+      while (i < mr && a[tap_start * mr + i] == zero) {
+        i++;
+      }
+      if (i != mr) {
+        break;
+      }
+      tap_start++;
+    }
+    while (tap_end - tap_start > 1) {
+      size_t i = 0;
+      while (i < mr && a[(tap_end - 1) * mr + i] == zero) {
+        i++;
+      }
+      if (i != mr) {
+        break;
+      }
+      tap_end--;
+    }
+  }
+
+  context->ukernels.conv[qnnp_get_current_uarch_index()](
+      mr_block_size,
+      nr_block_size,
+      context->kc,
+      tap_end - tap_start,
+      a + tap_start * mr,
+      context->packed_b + (nr_block_start + group_index * n_stride) * context->kc_stride +
+        tap_start * context->tap_stride,
+      context->bias + (nr_block_start + group_index * n_stride) * context->bias_stride,
+      tile_c,
+      context->c_stride,
+      context->a_zero_point,
+      context->b_zero_point,
+      &context->requantization_params);
+  if (context->lookup_table != NULL) {
+    apply_lookup_table(mr_block_size, nr_block_size, tile_c, context->c_stride, context->lookup_table);
+  }
+}
+
+/*
+ * q8conv_context::tap_stride of a convolution or deconvolution. Microkernels for kernels stored as int8, for folded
+ * biases, or for XZP fold the product of the input zero point and every tap of the kernel into the bias, so padded
+ * taps are not free to skip.
+ */
+static size_t get_q8conv_tap_stride(const struct qnnp_operator* op) {
+  if (op->flags &
+      (QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL | QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT | QNNP_CONVOLUTION_FLAG_XZP_CONV))
+  {
+    return 0;
+  }
+  const uint32_t kr = op->q8conv.kr;
+  return (size_t) op->q8conv.nr * ((qnnp_convolution_get_tap_channels(op) + (kr - 1)) & -kr);
+}
+
+static void compute_q8conv(
+    const struct q8conv_context context[restrict static 1],
+    size_t group_index,
+    size_t image_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t image_range /* always 1 */,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t ks = context->ks;
+  const size_t c_stride = context->c_stride;
+  uint8_t* tile_c = context->c + (mr_block_start + image_index * context->m) * c_stride + group_index * context->n +
+    nr_block_start;
+  run_q8conv_tile(
+      context, group_index, nr_block_start, mr_block_size, nr_block_size,
+      context->im2col_a + (mr_block_start + (image_index + group_index * context->bs) * context->m_stride) * ks,
+      tile_c);
+}
+
+static void compute_q8conv_with_offsets(
+    const struct q8conv_context context[restrict static 1],
+    size_t group_index,
+    size_t image_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t image_range /* always 1 */,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t ks = context->ks;
+  const size_t mr = context->mr;
+  const size_t m = context->m;
+  const size_t n = context->n;
+  const size_t kc = context->kc;
+  const size_t a_pixel_stride = context->a_pixel_stride;
+  const uint8_t* zero = context->zero;
+  /* Pixel indices are within an image, and all images of the batch share them */
+  const uint8_t* group_a =
+    context->a + image_index * context->input_height * context->input_width * a_pixel_stride + group_index * kc;
+  const uint32_t* restrict offsets = context->indirection_offsets + mr_block_start * ks;
+
+  /* The microkernel reads pointers for all mr rows of the tile, including rows past mr_block_size */
+  const uint8_t* a[QNNP_MAX_INDIRECTION_TILE_SIZE];
+  for (size_t i = 0; i < mr * ks; i++) {
+    const uint32_t offset = offsets[i];
+    a[i] = offset == QNNP_INDIRECTION_OFFSET_ZERO ? zero : group_a + (size_t) offset * a_pixel_stride;
+  }
+
+  uint8_t* tile_c =
+    context->c + (mr_block_start + image_index * m) * context->c_stride + group_index * n + nr_block_start;
+  run_q8conv_tile(context, group_index, nr_block_start, mr_block_size, nr_block_size, a, tile_c);
+}
+
+static void compute_q8conv_with_tile_indirection(
+    const struct q8conv_context context[restrict static 1],
+    size_t group_index,
+    size_t image_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t image_range /* always 1 */,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t mr = context->mr;
+  const size_t m = context->m;
+  const size_t m_start = context->m_start;
+  const size_t m_end = context->m_end;
+  const size_t n = context->n;
+  const size_t kc = context->kc;
+  const size_t input_height = context->input_height;
+  const size_t input_width = context->input_width;
+  const size_t kernel_height = context->kernel_height;
+  const size_t kernel_width = context->kernel_width;
+  const size_t a_pixel_stride = context->a_pixel_stride;
+  const uint8_t* zero = context->zero;
+  const uint8_t* image_a = context->a + image_index * input_height * input_width * a_pixel_stride + group_index * kc;
+
+  /* Same layout as a tile of the indirection buffer built in setup, including rows past mr_block_size */
+  const uint8_t* a[QNNP_MAX_INDIRECTION_TILE_SIZE];
+  for (size_t tile_offset = 0; tile_offset < mr; tile_offset++) {
+    const size_t output_index = min(m_start + mr_block_start + tile_offset, m_end - 1);
+    const struct fxdiv_result_size_t output_index_components =
+      fxdiv_divide_size_t(output_index, context->output_width_divisor);
+    const size_t output_y = output_index_components.quotient;
+    const size_t output_x = output_index_components.remainder;
+    for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+      const size_t input_y =
+        output_y * context->stride_height + kernel_y * context->dilation_height - context->input_padding_top;
+      for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+        const size_t input_x =
+          output_x * context->stride_width + kernel_x * context->dilation_width - context->input_padding_left;
+        a[(kernel_y * kernel_width + kernel_x) * mr + tile_offset] = input_y < input_height && input_x < input_width ?
+          image_a + (input_y * input_width + input_x) * a_pixel_stride : zero;
+      }
+    }
+  }
+
+  uint8_t* tile_c =
+    context->c + (m_start + mr_block_start + image_index * m) * context->c_stride + group_index * n + nr_block_start;
+  run_q8conv_tile(context, group_index, nr_block_start, mr_block_size, nr_block_size, a, tile_c);
+}
+
+static void compute_q8deconv_with_tile_indirection(
+    const struct q8conv_context context[restrict static 1],
+    size_t group_index,
+    size_t image_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t image_range /* always 1 */,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t mr = context->mr;
+  const size_t m = context->m;
+  const size_t n = context->n;
+  const size_t kc = context->kc;
+  const size_t input_height = context->input_height;
+  const size_t input_width = context->input_width;
+  const size_t kernel_height = context->kernel_height;
+  const size_t kernel_width = context->kernel_width;
+  const size_t stride_height = context->stride_height;
+  const size_t stride_width = context->stride_width;
+  const size_t a_pixel_stride = context->a_pixel_stride;
+  const uint8_t* zero = context->zero;
+  const uint8_t* image_a = context->a + image_index * input_height * input_width * a_pixel_stride + group_index * kc;
+
+  const uint8_t* a[QNNP_MAX_INDIRECTION_TILE_SIZE];
+  for (size_t tile_offset = 0; tile_offset < mr; tile_offset++) {
+    const size_t output_index = min(mr_block_start + tile_offset, m - 1);
+    const struct fxdiv_result_size_t output_index_components =
+      fxdiv_divide_size_t(output_index, context->output_width_divisor);
+    const size_t output_y = output_index_components.quotient;
+    const size_t output_x = output_index_components.remainder;
+    for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+      const size_t y = output_y + context->input_padding_top - kernel_y * context->dilation_height;
+      const size_t input_y = y / stride_height;
+      for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+        const size_t x = output_x + context->input_padding_left - kernel_x * context->dilation_width;
+        const size_t input_x = x / stride_width;
+        a[(kernel_y * kernel_width + kernel_x) * mr + tile_offset] =
+          input_y * stride_height == y && input_y < input_height && input_x * stride_width == x && input_x < input_width ?
+            image_a + (input_y * input_width + input_x) * a_pixel_stride : zero;
+      }
+    }
+  }
+
+  uint8_t* tile_c =
+    context->c + (mr_block_start + image_index * m) * context->c_stride + group_index * n + nr_block_start;
+  run_q8conv_tile(context, group_index, nr_block_start, mr_block_size, nr_block_size, a, tile_c);
+}
+
+struct q8deconv_subpixel_context {
+  /* Taps and output positions of the stride phase */
+  size_t ks;
+  size_t residue_y;
+  size_t residue_x;
+  size_t output_y_start;
+  size_t output_x_start;
+  size_t phase_width;
+  struct fxdiv_divisor_size_t phase_height_divisor;
+  size_t kc;
+  size_t kc_stride;
+  size_t n;
+  size_t n_stride;
+  size_t mr;
+  const uint8_t* a;
+  size_t a_pixel_stride;
+  const uint8_t* zero;
+  size_t input_height;
+  size_t input_width;
+  size_t output_height;
+  size_t output_width;
+  size_t kernel_height;
+  size_t kernel_width;
+  size_t stride_height;
+  size_t stride_width;
+  size_t dilation_height;
+  size_t dilation_width;
+  size_t input_padding_top;
+  size_t input_padding_left;
+  /* Packed kernel at the first tap of the phase, see QNNP_CONVOLUTION_FLAG_SUBPIXEL */
+  const uint8_t* packed_b;
+  const int32_t* bias;
+  uint8_t* c;
+  size_t c_pixel_stride;
+  uint8_t a_zero_point;
+  uint8_t b_zero_point;
+  union qnnp_q31_requantization_params requantization_params;
+  const uint8_t* lookup_table;
+  const struct q8conv_uarch_ukernels ukernels;
+};
+
+/*
+ * Computes mr consecutive outputs of a row of a stride phase, which are stride_width pixels apart in the output and
+ * read only the taps of the phase, none of which fall between input pixels.
+ */
+static void compute_q8deconv_subpixel(
+    const struct q8deconv_subpixel_context context[restrict static 1],
+    size_t group_index,
+    size_t phase_row_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t phase_row_range /* always 1 */,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t mr = context->mr;
+  const size_t kc = context->kc;
+  const size_t n = context->n;
+  const size_t n_stride = context->n_stride;
+  const size_t residue_y = context->residue_y;
+  const size_t residue_x = context->residue_x;
+  const size_t input_height = context->input_height;
+  const size_t input_width = context->input_width;
+  const size_t kernel_height = context->kernel_height;
+  const size_t kernel_width = context->kernel_width;
+  const size_t stride_height = context->stride_height;
+  const size_t stride_width = context->stride_width;
+  const size_t a_pixel_stride = context->a_pixel_stride;
+  const uint8_t* zero = context->zero;
+
+  const struct fxdiv_result_size_t phase_row_components =
+    fxdiv_divide_size_t(phase_row_index, context->phase_height_divisor);
+  const size_t image_index = phase_row_components.quotient;
+  const size_t output_y = context->output_y_start + phase_row_components.remainder * stride_height;
+  const uint8_t* image_a = context->a + image_index * input_height * input_width * a_pixel_stride + group_index * kc;
+
+  /* Same layout as a tile of the indirection buffer, including rows past mr_block_size */
+  const uint8_t* a[QNNP_MAX_INDIRECTION_TILE_SIZE];
+  for (size_t tile_offset = 0; tile_offset < mr; tile_offset++) {
+    const size_t output_x =
+      context->output_x_start + min(mr_block_start + tile_offset, context->phase_width - 1) * stride_width;
+    size_t ki = 0;
+    for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+      if ((kernel_y * context->dilation_height) % stride_height != residue_y) {
+        continue;
+      }
+      const size_t y = output_y + context->input_padding_top - kernel_y * context->dilation_height;
+      const size_t input_y = y / stride_height;
+      for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+        if ((kernel_x * context->dilation_width) % stride_width != residue_x) {
+          continue;
+        }
+        const size_t x = output_x + context->input_padding_left - kernel_x * context->dilation_width;
+        const size_t input_x = x / stride_width;
+        /* Phase taps only miss the input at its borders, where y or x wraps around or the division is inexact */
+        a[ki++ * mr + tile_offset] =
+          input_y * stride_height == y && input_y < input_height && input_x * stride_width == x && input_x < input_width ?
+            image_a + (input_y * input_width + input_x) * a_pixel_stride : zero;
+      }
+    }
+  }
+
+  const size_t c_pixel_stride = context->c_pixel_stride;
+  uint8_t* tile_c = context->c +
+    ((image_index * context->output_height + output_y) * context->output_width +
+      context->output_x_start + mr_block_start * stride_width) * c_pixel_stride +
+    group_index * n + nr_block_start;
+  context->ukernels.conv[qnnp_get_current_uarch_index()](
+      mr_block_size,
+      nr_block_size,
+      kc,
+      context->ks,
+      a,
+      context->packed_b + (nr_block_start + group_index * n_stride) * context->kc_stride,
+      context->bias + nr_block_start + group_index * n_stride,
+      tile_c,
+      c_pixel_stride * stride_width,
+      context->a_zero_point,
+      context->b_zero_point,
+      &context->requantization_params);
+  if (context->lookup_table != NULL) {
+    apply_lookup_table(mr_block_size, nr_block_size, tile_c, c_pixel_stride * stride_width, context->lookup_table);
+  }
+}
+
+struct sgemm_context {
+  size_t k;
+  size_t n;
+  size_t n_stride;
+  const float* a;
+  size_t a_stride;
+  const float* packed_b;
+  const float* bias;
+  float* c;
+  size_t c_stride;
+  struct qnnp_fp32_clamping_params clamping_params;
+  sgemm_ukernel_function ukernel;
+};
+
+static void compute_sgemm(
+    const struct sgemm_context context[restrict static 1],
+    size_t group_index,
+    size_t pixel_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t pixel_range,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t k = context->k;
+  const size_t n = context->n;
+  const size_t n_stride = context->n_stride;
+  const size_t a_stride = context->a_stride;
+  const size_t c_stride = context->c_stride;
+
+  context->ukernel(
+      mr_block_size,
+      nr_block_size,
+      k,
+      context->a + (pixel_index + mr_block_start) * a_stride + group_index * k,
+      a_stride * sizeof(float),
+      context->packed_b + (nr_block_start + group_index * n_stride) * k,
+      context->bias + nr_block_start + group_index * n_stride,
+      context->c + (pixel_index + mr_block_start) * c_stride + nr_block_start + group_index * n,
+      c_stride * sizeof(float),
+      &context->clamping_params);
+}
+
+struct sconv_context {
+  size_t bs;
+  size_t ks;
+  size_t kc;
+  size_t m;
+  size_t m_stride;
+  size_t n;
+  size_t n_stride;
+  const float** indirect_a;
+  const float* packed_b;
+  const float* bias;
+  float* c;
+  size_t c_stride;
+  struct qnnp_fp32_clamping_params clamping_params;
+  sconv_ukernel_function ukernel;
+};
+
+static void compute_sconv(
+    const struct sconv_context context[restrict static 1],
+    size_t group_index,
+    size_t image_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t image_range /* always 1 */,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t ks = context->ks;
+  const size_t kc = context->kc;
+  const size_t n_stride = context->n_stride;
+  const size_t c_stride = context->c_stride;
+
+  context->ukernel(
+      mr_block_size,
+      nr_block_size,
+      kc,
+      ks,
+      context->indirect_a + (mr_block_start + (image_index + group_index * context->bs) * context->m_stride) * ks,
+      context->packed_b + (nr_block_start + group_index * n_stride) * ks * kc,
+      context->bias + nr_block_start + group_index * n_stride,
+      context->c + (mr_block_start + image_index * context->m) * c_stride + group_index * context->n + nr_block_start,
+      c_stride * sizeof(float),
+      &context->clamping_params);
+}
+
+struct hgemm_context {
+  size_t k;
+  size_t n;
+  size_t n_stride;
+  const uint16_t* a;
+  size_t a_stride;
+  const uint16_t* packed_b;
+  const uint16_t* bias;
+  uint16_t* c;
+  size_t c_stride;
+  struct qnnp_fp16_clamping_params clamping_params;
+  hgemm_ukernel_function ukernel;
+};
+
+static void compute_hgemm(
+    const struct hgemm_context context[restrict static 1],
+    size_t group_index,
+    size_t pixel_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t pixel_range,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t k = context->k;
+  const size_t n = context->n;
+  const size_t n_stride = context->n_stride;
+  const size_t a_stride = context->a_stride;
+  const size_t c_stride = context->c_stride;
+
+  context->ukernel(
+      mr_block_size,
+      nr_block_size,
+      k,
+      context->a + (pixel_index + mr_block_start) * a_stride + group_index * k,
+      a_stride * sizeof(uint16_t),
+      context->packed_b + (nr_block_start + group_index * n_stride) * k,
+      context->bias + nr_block_start + group_index * n_stride,
+      context->c + (pixel_index + mr_block_start) * c_stride + nr_block_start + group_index * n,
+      c_stride * sizeof(uint16_t),
+      &context->clamping_params);
+}
+
+struct hconv_context {
+  size_t bs;
+  size_t ks;
+  size_t kc;
+  size_t m;
+  size_t m_stride;
+  size_t n;
+  size_t n_stride;
+  const void** indirect_a;
+  const uint16_t* packed_b;
+  const uint16_t* bias;
+  uint16_t* c;
+  size_t c_stride;
+  struct qnnp_fp16_clamping_params clamping_params;
+  hconv_ukernel_function ukernel;
+};
+
+static void compute_hconv(
+    const struct hconv_context context[restrict static 1],
+    size_t group_index,
+    size_t image_index,
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t group_range /* always 1 */,
+    size_t image_range /* always 1 */,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t ks = context->ks;
+  const size_t kc = context->kc;
+  const size_t n_stride = context->n_stride;
+  const size_t c_stride = context->c_stride;
+
+  context->ukernel(
+      mr_block_size,
+      nr_block_size,
+      kc,
+      ks,
+      context->indirect_a + (mr_block_start + (image_index + group_index * context->bs) * context->m_stride) * ks,
+      context->packed_b + (nr_block_start + group_index * n_stride) * ks * kc,
+      context->bias + nr_block_start + group_index * n_stride,
+      context->c + (mr_block_start + image_index * context->m) * c_stride + group_index * context->n + nr_block_start,
+      c_stride * sizeof(uint16_t),
+      &context->clamping_params);
+}
+
+struct channel_expansion_context {
+  size_t channels;
+  size_t multiplier;
+  size_t input_height;
+  size_t input_width;
+  const uint8_t* input;
+  size_t input_image_stride;
+  size_t input_row_stride;
+  size_t input_pixel_stride;
+  uint8_t* output;
+};
+
+static void compute_channel_expansion(
+    const struct channel_expansion_context context[restrict static 1],
+    size_t row)
+{
+  const size_t channels = context->channels;
+  const size_t multiplier = context->multiplier;
+  const size_t input_width = context->input_width;
+  const uint8_t* input = context->input +
+    row / context->input_height * context->input_image_stride + row % context->input_height * context->input_row_stride;
+  uint8_t* output = context->output + row * input_width * channels * multiplier;
+
+  for (size_t x = 0; x < input_width; x++) {
+    for (size_t c = 0; c < channels; c++) {
+      const uint8_t value = input[c];
+      for (size_t m = 0; m < multiplier; m++) {
+        *output++ = value;
+      }
+    }
+    input += context->input_pixel_stride;
+  }
+}
+
+struct row_padding_context {
+  size_t channels;
+  size_t input_width;
+  const uint8_t* input;
+  size_t input_row_stride;
+  size_t input_pixel_stride;
+  size_t padding_left;
+  size_t padding_right;
+  uint8_t zero_point;
+  uint8_t* output;
+};
+
+static void compute_row_padding(
+    const struct row_padding_context context[restrict static 1],
+    size_t row)
+{
+  const size_t channels = context->channels;
+  const size_t input_width = context->input_width;
+  const size_t input_pixel_stride = context->input_pixel_stride;
+  const uint8_t* input = context->input + row * context->input_row_stride;
+  uint8_t* output =
+    context->output + row * (context->padding_left + input_width + context->padding_right) * channels;
+
+  memset(output, context->zero_point, context->padding_left * channels);
+  output += context->padding_left * channels;
+  if (input_pixel_stride == channels) {
+    memcpy(output, input, input_width * channels);
+    output += input_width * channels;
+  } else {
+    for (size_t x = 0; x < input_width; x++) {
+      memcpy(output, input, channels);
+      output += channels;
+      input += input_pixel_stride;
+    }
+  }
+  memset(output, context->zero_point, context->padding_right * channels);
+}
+
+struct q8dw_context {
+  size_t channels;
+  size_t kernel_size;
+  const uint8_t** im2col_buffer;
+  size_t im2col_row_stride;
+  size_t im2col_col_stride;
+  /* Phases of output pixels in every row of the indirection buffer, see get_dw_indirection_layout */
+  size_t phases;
+  const uint8_t* packed_kernel;
+  size_t packed_kernel_channel_stride;
+  const int32_t* bias;
+  uint8_t* output;
+  size_t output_height;
+  size_t output_width;
+  size_t output_row_stride;
+  size_t output_pixel_stride;
+  uint8_t input_zero_point;
+  uint8_t kernel_zero_point;
+  union qnnp_q31_requantization_params requantization_params;
+  const uint8_t* lookup_table;
+  const q8dw_ukernel_function ukernel;
+  /* Channel multiplier and its microkernel, if it reads the input channels directly instead of expanded_input */
+  size_t multiplier;
+  const q8dw_multiplier_ukernel_function multiplier_ukernel;
+};
+
+static void compute_q8dw(
+    const struct q8dw_context context[restrict static 1],
+    size_t image,
+    size_t output_y,
+    size_t channel_start,
+    size_t image_range /* always 1 */,
+    size_t output_y_range /* always 1 */,
+    size_t channel_range)
+{
+  const size_t output_height = context->output_height;
+  const size_t output_width = context->output_width;
+  const size_t output_pixel_stride = context->output_pixel_stride;
+  const size_t phases = context->phases;
+  uint8_t* output = context->output + (image * output_height + output_y) * context->output_row_stride + channel_start;
+
+  const uint8_t** im2col = context->im2col_buffer + (image * output_height + output_y) * context->im2col_row_stride;
+  for (size_t phase = 0; phase < min(phases, output_width); phase++) {
+    const size_t phase_width = divide_round_up(output_width - phase, phases);
+    if (context->multiplier_ukernel != NULL) {
+      /* Channel tiles start at multiples of cr, which the multiplier divides */
+      context->multiplier_ukernel(
+        channel_range,
+        context->multiplier,
+        phase_width,
+        im2col,
+        context->packed_kernel + channel_start * context->packed_kernel_channel_stride,
+        output + phase * output_pixel_stride,
+        context->im2col_col_stride,
+        (phases * output_pixel_stride - channel_range) * sizeof(uint8_t),
+        channel_start / context->multiplier * sizeof(uint8_t),
+        context->input_zero_point,
+        context->kernel_zero_point,
+        &context->requantization_params);
+    } else {
+      context->ukernel(
+        channel_range,
+        phase_width,
+        im2col,
+        context->packed_kernel + channel_start * context->packed_kernel_channel_stride,
+        output + phase * output_pixel_stride,
+        context->im2col_col_stride,
+        (phases * output_pixel_stride - channel_range) * sizeof(uint8_t),
+        channel_start * sizeof(uint8_t),
+        context->input_zero_point,
+        context->kernel_zero_point,
+        &context->requantization_params);
+    }
+    im2col = (const uint8_t**) ((uintptr_t) im2col +
+      context->kernel_size * sizeof(void*) + (phase_width - 1) * context->im2col_col_stride);
+  }
+  if (context->lookup_table != NULL) {
+    apply_lookup_table(
+      context->output_width, channel_range, output, context->output_pixel_stride, context->lookup_table);
+  }
+}
+
+struct q8winograd_input_transform_context {
+  size_t batch_size;
+  size_t groups;
+  size_t group_input_channels;
+  size_t input_height;
+  size_t input_width;
+  /* Input rows outside [input_y_start, input_y_end) read the zero buffer, like padding */
+  size_t input_y_start;
+  size_t input_y_end;
+  const uint8_t* input;
+  size_t input_pixel_stride;
+  size_t input_padding_top;
+  size_t input_padding_left;
+  const uint8_t* zero;
+  size_t tiles_width;
+  size_t tiles;
+  size_t tile_y_start;
+  int16_t* transformed_input;
+  uint8_t input_zero_point;
+};
+
+/*
+ * Transforms the 4x4 input tiles of a row of 2x2 output tiles into V = B^T (d - input_zero_point) B, with
+ * B^T = [[1, 0, -1, 0], [0, 1, 1, 0], [0, -1, 1, 0], [0, 1, 0, -1]]. The transformed tile of every group is stored as
+ * 16 positions of group_input_channels values.
+ */
+static void compute_q8winograd_input_transform(
+    const struct q8winograd_input_transform_context context[restrict static 1],
+    size_t image,
+    size_t tile_row)
+{
+  const size_t k = context->group_input_channels;
+  const size_t input_width = context->input_width;
+  const size_t input_pixel_stride = context->input_pixel_stride;
+  const size_t input_padding_left = context->input_padding_left;
+  const size_t tile_y = context->tile_y_start + tile_row;
+  const int16_t input_zero_point = (int16_t) (uint16_t) context->input_zero_point;
+
+  const uint8_t* rows[4];
+  for (size_t i = 0; i < 4; i++) {
+    const size_t input_y = tile_y * 2 + i - context->input_padding_top;
+    rows[i] = tile_y * 2 + i >= context->input_padding_top &&
+      input_y >= context->input_y_start && input_y < context->input_y_end ?
+        context->input + (image * context->input_height + input_y) * input_width * input_pixel_stride : NULL;
+  }
+
+  for (size_t tile_x = 0; tile_x < context->tiles_width; tile_x++) {
+    const uint8_t* pixels[16];
+    for (size_t i = 0; i < 4; i++) {
+      for (size_t j = 0; j < 4; j++) {
+        const size_t input_x = tile_x * 2 + j - input_padding_left;
+        pixels[i * 4 + j] = rows[i] != NULL && tile_x * 2 + j >= input_padding_left && input_x < input_width ?
+          rows[i] + input_x * input_pixel_stride : NULL;
+      }
+    }
+
+    for (size_t group = 0; group < context->groups; group++) {
+      const uint8_t* d[16];
+      for (size_t p = 0; p < 16; p++) {
+        d[p] = pixels[p] != NULL ? pixels[p] + group * k : context->zero;
+      }
+      int16_t* v = context->transformed_input +
+        ((group * context->batch_size + image) * context->tiles + tile_y * context->tiles_width + tile_x) * 16 * k;
+      for (size_t c = 0; c < k; c++) {
+        int16_t bd[16];
+        for (size_t j = 0; j < 4; j++) {
+          const int16_t d0 = (int16_t) (uint16_t) d[j][c] - input_zero_point;
+          const int16_t d1 = (int16_t) (uint16_t) d[4 + j][c] - input_zero_point;
+          const int16_t d2 = (int16_t) (uint16_t) d[8 + j][c] - input_zero_point;
+          const int16_t d3 = (int16_t) (uint16_t) d[12 + j][c] - input_zero_point;
+          bd[j] = d0 - d2;
+          bd[4 + j] = d1 + d2;
+          bd[8 + j] = d2 - d1;
+          bd[12 + j] = d1 - d3;
+        }
+        for (size_t i = 0; i < 4; i++) {
+          v[(i * 4 + 0) * k + c] = bd[i * 4 + 0] - bd[i * 4 + 2];
+          v[(i * 4 + 1) * k + c] = bd[i * 4 + 1] + bd[i * 4 + 2];
+          v[(i * 4 + 2) * k + c] = bd[i * 4 + 2] - bd[i * 4 + 1];
+          v[(i * 4 + 3) * k + c] = bd[i * 4 + 1] - bd[i * 4 + 3];
+        }
+      }
+    }
+  }
+}
+
+struct q8winograd_context {
+  size_t k;
+  size_t n;
+  size_t n_stride;
+  size_t batch_size;
+  size_t tiles_width;
+  size_t tiles;
+  /* First tile of the band in every image */
+  size_t tile_start;
+  const int16_t* transformed_input;
+  const int16_t* packed_kernel;
+  const int32_t* bias;
+  uint8_t* output;
+  size_t output_height;
+  size_t output_width;
+  size_t output_y_start;
+  size_t output_y_end;
+  size_t output_pixel_stride;
+  union qnnp_q31_requantization_params scalar_requantization_params;
+  const uint8_t* lookup_table;
+};
+
+/*
+ * Computes a block of QNNP_WINOGRAD_MR tiles and QNNP_WINOGRAD_NR output channels: the sums M over input channels of
+ * the products of the transformed input and kernel tiles, and then the 2x2 output pixels A^T M A / 4, with
+ * A^T = [[1, 1, 1, 0], [0, 1, -1, -1]]. The division by 4 undoes the scaling of the packed kernel tiles.
+ */
+static void compute_q8winograd(
+    const struct q8winograd_context context[restrict static 1],
+    size_t image,
+    size_t group,
+    size_t tile_block_start,
+    size_t nr_block_start,
+    size_t image_range /* always 1 */,
+    size_t group_range /* always 1 */,
+    size_t tile_block_size,
+    size_t nr_block_size)
+{
+  const size_t k = context->k;
+  const size_t tiles_width = context->tiles_width;
+  const size_t tile_start = context->tile_start + tile_block_start;
+  const int16_t* v =
+    context->transformed_input + ((group * context->batch_size + image) * context->tiles + tile_start) * 16 * k;
+  const int16_t* u = context->packed_kernel + (group * context->n_stride + nr_block_start) * 16 * k;
 
-    const void** im2col_buffer = (const void**) realloc(convolution->im2col_buffer, im2col_buffer_size);
-    if (im2col_buffer == NULL) {
-      qnnp_log_error("failed to allocate %zu bytes for im2col buffer", im2col_buffer_size);
-      return qnnp_status_out_of_memory;
+  int32_t m[16][QNNP_WINOGRAD_MR][QNNP_WINOGRAD_NR];
+  for (size_t p = 0; p < 16; p++) {
+    const int16_t* up = u + p * k * QNNP_WINOGRAD_NR;
+    for (size_t t = 0; t < tile_block_size; t++) {
+      const int16_t* vp = v + (t * 16 + p) * k;
+      int32_t acc[QNNP_WINOGRAD_NR] = { 0 };
+      for (size_t c = 0; c < k; c++) {
+        const int32_t vc = (int32_t) vp[c];
+        const int16_t* uc = up + c * QNNP_WINOGRAD_NR;
+        for (size_t channel = 0; channel < QNNP_WINOGRAD_NR; channel++) {
+          acc[channel] += vc * (int32_t) uc[channel];
+        }
+      }
+      memcpy(m[p][t], acc, sizeof(acc));
     }
-    convolution->im2col_buffer = im2col_buffer;
+  }
 
-    const void* zero = convolution->zero;
-    if (groups < 8) {
-      zero = (const void*) ((uintptr_t) zero + 8);
+  const int32_t* bias = context->bias + group * context->n_stride + nr_block_start;
+  const size_t output_channel_start = group * context->n + nr_block_start;
+  const uint8_t* lookup_table = context->lookup_table;
+  for (size_t t = 0; t < tile_block_size; t++) {
+    const size_t output_y = (tile_start + t) / tiles_width * 2;
+    const size_t output_x = (tile_start + t) % tiles_width * 2;
+    for (size_t channel = 0; channel < nr_block_size; channel++) {
+      /* Sums of the transform wrap around like the direct accumulation, and the result fits 32 bits */
+      uint32_t am[2][4];
+      for (size_t j = 0; j < 4; j++) {
+        const uint32_t m0 = (uint32_t) m[j][t][channel];
+        const uint32_t m1 = (uint32_t) m[4 + j][t][channel];
+        const uint32_t m2 = (uint32_t) m[8 + j][t][channel];
+        const uint32_t m3 = (uint32_t) m[12 + j][t][channel];
+        am[0][j] = m0 + m1 + m2;
+        am[1][j] = m1 - m2 - m3;
+      }
+      for (size_t i = 0; i < 2; i++) {
+        if (output_y + i < context->output_y_start || output_y + i >= context->output_y_end) {
+          continue;
+        }
+        const uint32_t y[2] = {
+          am[i][0] + am[i][1] + am[i][2],
+          am[i][1] - am[i][2] - am[i][3],
+        };
+        for (size_t j = 0; j < 2 && output_x + j < context->output_width; j++) {
+          const int32_t acc = (int32_t) y[j] / 4 + bias[channel];
+          const uint8_t output = qnnp_q31_requantize(acc, context->scalar_requantization_params);
+          context->output[((image * context->output_height + output_y + i) * context->output_width + output_x + j) *
+            context->output_pixel_stride + output_channel_start + channel] =
+              lookup_table != NULL ? lookup_table[output] : output;
+        }
+      }
     }
+  }
+}
 
-    for (size_t group = 0; group < groups; group++) {
-      for (size_t image = 0; image < batch_size; image++) {
-        for (size_t output_y = 0; output_y < output_height; output_y++) {
-          for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
-            const size_t input_y =
-              output_y * convolution->stride_height + kernel_y * convolution->dilation_height - convolution->input_padding_top;
-            if (input_y < input_height) {
-              for (size_t output_x = 0; output_x < output_width; output_x++) {
-                for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
-                  const size_t input_x =
-                    output_x * subsampling_width + kernel_x * convolution->dilation_width - convolution->input_padding_left;
-                  const size_t im2col_index =
-                    (image * output_height + output_y) * (kernel_size + (output_width * subsampling_width - 1) * kernel_height) +
-                    output_x * subsampling_width * kernel_height + kernel_x * kernel_height + kernel_y;
-                  if (input_x < input_width) {
-                    im2col_buffer[im2col_index] = input + ((image * input_height + input_y) * input_width + input_x) * input_pixel_stride;
-                  } else {
-                    im2col_buffer[im2col_index] = zero;
-                  }
-                }
-              }
-            } else {
-              for (size_t output_x = 0; output_x < output_width; output_x++) {
-                for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
-                  const size_t im2col_index =
-                    (image * output_height + output_y) * (kernel_size + (output_width * subsampling_width - 1) * kernel_height) +
-                    output_x * subsampling_width * kernel_height + kernel_x * kernel_height + kernel_y;
-                  im2col_buffer[im2col_index] = zero;
-                }
-              }
-            }
-          }
-        }
+/* Computes all mr x nr tiles of m rows of a GEMM from a to c, with the strides, kernel, and bias of the context */
+static void compute_q8gemm_rows(
+    const struct q8gemm_context context[restrict static 1],
+    size_t m,
+    size_t mr,
+    const uint8_t* a,
+    uint8_t* c)
+{
+  const size_t n = context->n;
+  const size_t nr = context->nr;
+  const size_t a_stride = context->a_stride;
+  const size_t c_stride = context->c_stride;
+  const q8gemm_ukernel_function gemm = context->ukernels.gemm[qnnp_get_current_uarch_index()];
+  for (size_t mr_block_start = 0; mr_block_start < m; mr_block_start += mr) {
+    const size_t mr_block_size = min(m - mr_block_start, mr);
+    for (size_t nr_block_start = 0; nr_block_start < n; nr_block_start += nr) {
+      const size_t nr_block_size = min(n - nr_block_start, nr);
+      uint8_t* tile_c = c + mr_block_start * c_stride + nr_block_start;
+      gemm(
+          mr_block_size,
+          nr_block_size,
+          context->k,
+          a + mr_block_start * a_stride,
+          a_stride,
+          context->packed_b + nr_block_start * context->k_stride,
+          context->bias + nr_block_start,
+          tile_c,
+          c_stride,
+          context->a_zero_point,
+          context->b_zero_point,
+          &context->requantization_params);
+      if (context->lookup_table != NULL) {
+        apply_lookup_table(mr_block_size, nr_block_size, tile_c, c_stride, context->lookup_table);
       }
     }
-  } else {
-    const size_t output_size = output_height * output_width;
-    const size_t output_tile_size = qnnp_params.q8conv.mr;
-    const size_t tiled_output_size = round_up(output_size, output_tile_size);
-    const size_t im2col_buffer_size = sizeof(void*) * batch_size * groups * tiled_output_size * kernel_size;
+  }
+}
 
-    const void** im2col_buffer = (const void**) realloc(convolution->im2col_buffer, im2col_buffer_size);
-    if (im2col_buffer == NULL) {
-      qnnp_log_error("failed to allocate %zu bytes for im2col buffer", im2col_buffer_size);
-      return qnnp_status_out_of_memory;
+struct inverted_residual_context {
+  /* The a and c pointers of the GEMM contexts are unused: compute_q8gemm_rows gets rows of the band buffers */
+  struct q8gemm_context expansion;
+  size_t expansion_mr;
+  struct q8dw_context depthwise;
+  struct q8gemm_context projection;
+  size_t projection_mr;
+  const uint8_t* input;
+  size_t input_height;
+  size_t input_width;
+  size_t input_pixel_stride;
+  uint8_t* output;
+  size_t output_height;
+  size_t output_width;
+  size_t output_pixel_stride;
+  size_t kernel_height;
+  size_t kernel_width;
+  size_t stride_height;
+  size_t stride_width;
+  size_t dilation_height;
+  size_t dilation_width;
+  size_t input_padding_top;
+  size_t input_padding_left;
+  const uint8_t* zero;
+  size_t rows;
+  size_t bands;
+  /* 0 without expansion, when the depthwise convolution reads the input */
+  size_t ring_rows;
+  size_t depthwise_rows;
+  uint8_t* band_buffers;
+  size_t band_buffer_stride;
+  size_t depthwise_output_offset;
+  size_t indirection_offset;
+};
+
+/*
+ * Computes a band of consecutive output rows, over all images, of an inverted residual or depthwise separable
+ * operator. Expanded input rows are kept in a ring of the band buffer indexed by row modulo ring_rows, which holds all
+ * rows under the depthwise kernel of an output row, and computed when the kernel first reaches them. Depthwise output
+ * rows are collected in the band buffer until depthwise_rows of them go through one projection GEMM.
+ */
+static void compute_inverted_residual(
+    const struct inverted_residual_context context[restrict static 1],
+    size_t band)
+{
+  const size_t channels = context->depthwise.channels;
+  const size_t input_height = context->input_height;
+  const size_t input_width = context->input_width;
+  const size_t output_height = context->output_height;
+  const size_t output_width = context->output_width;
+  const size_t kernel_height = context->kernel_height;
+  const size_t kernel_width = context->kernel_width;
+  const size_t kernel_size = kernel_height * kernel_width;
+  const size_t ring_rows = context->ring_rows;
+  const size_t ring_row_stride = input_width * channels;
+  const size_t depthwise_rows = context->depthwise_rows;
+  const size_t depthwise_input_pixel_stride = ring_rows != 0 ? channels : context->input_pixel_stride;
+
+  uint8_t* band_buffer = context->band_buffers + band * context->band_buffer_stride;
+  uint8_t* ring = band_buffer + QNNP_BAND_PADDING;
+  uint8_t* depthwise_output = band_buffer + context->depthwise_output_offset;
+  const uint8_t** indirection = (const uint8_t**) (band_buffer + context->indirection_offset);
+
+  /* Input row in every ring row, or SIZE_MAX if it holds none of the current image */
+  size_t ring_input_y[max(ring_rows, 1)];
+  size_t ring_image = SIZE_MAX;
+
+  const size_t row_start = band * context->rows / context->bands;
+  const size_t row_end = (band + 1) * context->rows / context->bands;
+  size_t buffered_rows = 0;
+  for (size_t row = row_start; row < row_end; row++) {
+    const size_t image = row / output_height;
+    const size_t output_y = row % output_height;
+    if (image != ring_image) {
+      for (size_t i = 0; i < ring_rows; i++) {
+        ring_input_y[i] = SIZE_MAX;
+      }
+      ring_image = image;
     }
-    convolution->im2col_buffer = im2col_buffer;
 
-    const void* zero = convolution->zero;
-    if (convolution->group_input_channels < 8) {
-      zero = (const void*) ((uintptr_t) zero + 8);
+    for (size_t kernel_y = 0; ring_rows != 0 && kernel_y < kernel_height; kernel_y++) {
+      const size_t input_y =
+        output_y * context->stride_height + kernel_y * context->dilation_height - context->input_padding_top;
+      if (input_y < input_height && ring_input_y[input_y % ring_rows] != input_y) {
+        compute_q8gemm_rows(
+          &context->expansion, input_width, context->expansion_mr,
+          context->input + (image * input_height + input_y) * input_width * context->input_pixel_stride,
+          ring + (input_y % ring_rows) * ring_row_stride);
+        ring_input_y[input_y % ring_rows] = input_y;
+      }
     }
 
-    const struct fxdiv_divisor_size_t output_width_divisor = fxdiv_init_size_t(output_width);
-    for (size_t group = 0; group < groups; group++) {
-      for (size_t image = 0; image < batch_size; image++) {
-        for (size_t output_tile_start = 0; output_tile_start < tiled_output_size; output_tile_start += output_tile_size) {
-          for (size_t output_tile_offset = 0; output_tile_offset < output_tile_size; output_tile_offset++) {
-            const size_t tiled_output_index = output_tile_start + output_tile_offset;
-            const size_t output_index = min(tiled_output_index, output_size - 1);
-            const struct fxdiv_result_size_t output_index_components =
-              fxdiv_divide_size_t(output_index, output_width_divisor);
-            const size_t output_y = output_index_components.quotient;
-            const size_t output_x = output_index_components.remainder;
-            for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
-              const size_t input_y =
-                output_y * convolution->stride_height + kernel_y * convolution->dilation_height - convolution->input_padding_top;
-              if (input_y < input_height) {
-                for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
-                  const size_t input_x =
-                    output_x * convolution->stride_width + kernel_x * convolution->dilation_width - convolution->input_padding_left;
-                  const size_t im2col_index =
-                    (group * batch_size + image) * tiled_output_size * kernel_size + output_tile_start * kernel_size + (kernel_y * kernel_width + kernel_x) * output_tile_size + output_tile_offset;
-                  if (input_x < input_width) {
-                    im2col_buffer[im2col_index] =
-                      input + ((image * input_height + input_y) * input_width + input_x) * input_pixel_stride + group * convolution->group_input_channels;
-                  } else {
-                    im2col_buffer[im2col_index] = zero;
-                  }
-                }
-              } else {
-                for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
-                  const size_t im2col_index =
-                    (group * batch_size + image) * tiled_output_size * kernel_size + output_tile_start * kernel_size + (kernel_y * kernel_width + kernel_x) * output_tile_size + output_tile_offset;
-                  im2col_buffer[im2col_index] = zero;
-                }
-              }
-            }
+    for (size_t output_x = 0; output_x < output_width; output_x++) {
+      for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+        const size_t input_x =
+          output_x * context->stride_width + kernel_x * context->dilation_width - context->input_padding_left;
+        for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+          const size_t input_y =
+            output_y * context->stride_height + kernel_y * context->dilation_height - context->input_padding_top;
+          const size_t index = output_x * kernel_size + kernel_x * kernel_height + kernel_y;
+          if (input_y < input_height && input_x < input_width) {
+            const uint8_t* input_row = ring_rows != 0 ?
+              ring + (input_y % ring_rows) * ring_row_stride :
+              context->input + (image * input_height + input_y) * input_width * depthwise_input_pixel_stride;
+            indirection[index] = input_row + input_x * depthwise_input_pixel_stride;
+          } else {
+            indirection[index] = context->zero;
           }
         }
       }
     }
-  }
 
-  return qnnp_status_success;
+    const struct q8dw_context* depthwise = &context->depthwise;
+    uint8_t* depthwise_output_row = depthwise_output + buffered_rows * output_width * channels;
+    depthwise->ukernel(
+      channels,
+      output_width,
+      indirection,
+      depthwise->packed_kernel,
+      depthwise_output_row,
+      kernel_size * sizeof(void*),
+      0 /* output increment */,
+      0 /* input offset */,
+      depthwise->input_zero_point,
+      depthwise->kernel_zero_point,
+      &depthwise->requantization_params);
+    if (depthwise->lookup_table != NULL) {
+      apply_lookup_table(output_width, channels, depthwise_output_row, channels, depthwise->lookup_table);
+    }
+
+    /* Output rows of consecutive images are consecutive too, so buffered rows may cross images */
+    buffered_rows += 1;
+    if (buffered_rows == depthwise_rows || row + 1 == row_end) {
+      compute_q8gemm_rows(
+        &context->projection, buffered_rows * output_width, context->projection_mr,
+        depthwise_output,
+        context->output + (row + 1 - buffered_rows) * output_width * context->output_pixel_stride);
+      buffered_rows = 0;
+    }
+  }
 }
 
-struct q8gemm_context {
-  size_t k;
-  size_t k_stride;
+struct add_strided_context {
   size_t n;
-  size_t n_stride;
   const uint8_t* a;
   size_t a_stride;
-  const uint8_t* packed_b;
-  const int32_t* bias;
-  uint8_t* c;
-  size_t c_stride;
-  uint8_t a_zero_point;
-  uint8_t b_zero_point;
-  union qnnp_q31_requantization_params requantization_params;
-  const q8gemm_ukernel_function ukernel;
+  const uint8_t* b;
+  size_t b_stride;
+  uint8_t* y;
+  size_t y_stride;
+  union qnnp_add_quantization_params quantization_params;
+  q8vadd_ukernel_function ukernel;
 };
 
-static void compute_q8gemm(
-    const struct q8gemm_context context[restrict static 1],
-    size_t group_index,
-    size_t pixel_index,
-    size_t mr_block_start,
-    size_t nr_block_start,
-    size_t group_range /* always 1 */,
-    size_t pixel_range,
-    size_t mr_block_size,
-    size_t nr_block_size)
+static void compute_add_strided(
+    const struct add_strided_context context[restrict static 1],
+    size_t batch_index,
+    size_t batch_range /* always 1 */)
 {
-  const size_t k = context->k;
-  const size_t k_stride = context->k_stride;
+  assert(batch_range == 1);
+
+  context->ukernel(
+    context->n,
+    context->a + batch_index * context->a_stride,
+    context->b + batch_index * context->b_stride,
+    context->y + batch_index * context->y_stride,
+    &context->quantization_params);
+}
+
+struct add_contiguous_context {
+  const uint8_t* a;
+  const uint8_t* b;
+  uint8_t* y;
+  union qnnp_add_quantization_params quantization_params;
+  q8vadd_ukernel_function ukernel;
+};
+
+static void compute_add_contiguous(
+    const struct add_contiguous_context context[restrict static 1],
+    size_t offset,
+    size_t size)
+{
+  context->ukernel(
+    size,
+    context->a + offset,
+    context->b + offset,
+    context->y + offset,
+    &context->quantization_params);
+}
+
+/* Elements of densely packed add operands per parallel task */
+#define QNNP_ADD_CONTIGUOUS_TILE 4096
+
+/* Microkernels of quantize, dequantize, and requantize operators, with their element types erased */
+typedef void (*conversion_ukernel_function)(size_t n, const void* x, void* y, const void* params);
+
+/* Rows of a conversion between tensors of different element sizes; strides are in bytes */
+struct conversion_context {
+  size_t n;
+  const void* x;
+  size_t x_stride;
+  size_t x_element_size;
+  void* y;
+  size_t y_stride;
+  size_t y_element_size;
+  const void* params;
+  conversion_ukernel_function ukernel;
+};
+
+static void compute_conversion_strided(
+    const struct conversion_context context[restrict static 1],
+    size_t batch_index,
+    size_t batch_range /* always 1 */)
+{
+  assert(batch_range == 1);
+
+  context->ukernel(
+    context->n,
+    (const uint8_t*) context->x + batch_index * context->x_stride,
+    (uint8_t*) context->y + batch_index * context->y_stride,
+    context->params);
+}
+
+static void compute_conversion_contiguous(
+    const struct conversion_context context[restrict static 1],
+    size_t offset,
+    size_t size)
+{
+  context->ukernel(
+    size,
+    (const uint8_t*) context->x + offset * context->x_element_size,
+    (uint8_t*) context->y + offset * context->y_element_size,
+    context->params);
+}
+
+static void run_conversion(
+    qnnp_operator_t op,
+    pthreadpool_t threadpool,
+    size_t x_element_size,
+    size_t y_element_size,
+    const void* params,
+    conversion_ukernel_function ukernel)
+{
+  const size_t batch_size = op->batch_size;
+  const size_t channels = op->channels;
+  struct conversion_context conversion_context = {
+      .n = channels,
+      .x = op->input,
+      .x_stride = op->input_pixel_stride * x_element_size,
+      .x_element_size = x_element_size,
+      .y = op->output,
+      .y_stride = op->output_pixel_stride * y_element_size,
+      .y_element_size = y_element_size,
+      .params = params,
+      .ukernel = ukernel,
+  };
+  if (op->input_pixel_stride == channels && op->output_pixel_stride == channels) {
+    /* As for add, rows are adjacent, so split the whole tensor into equal blocks */
+    qnnp_compute_1d_tiled(
+        op, threadpool,
+        (pthreadpool_function_1d_tiled_t) compute_conversion_contiguous,
+        &conversion_context,
+        batch_size * channels,
+        QNNP_ADD_CONTIGUOUS_TILE);
+  } else {
+    qnnp_compute_1d_tiled(
+        op, threadpool,
+        (pthreadpool_function_1d_tiled_t) compute_conversion_strided,
+        &conversion_context,
+        batch_size,
+        1);
+  }
+}
+
+struct softmax_context {
+  size_t n;
+  const uint8_t* x;
+  size_t x_stride;
+  const uint32_t* t;
+  uint8_t* y;
+  size_t y_stride;
+  u8rmax_ukernel_function rmax_ukernel;
+  u8lut32norm_ukernel_function lut_norm_ukernel;
+};
+
+static void compute_softmax(
+    const struct softmax_context context[restrict static 1],
+    size_t batch_index,
+    size_t batch_range /* always 1 */)
+{
+  assert(batch_range == 1);
+
+  const uint8_t* x = context->x + batch_index * context->x_stride;
+  uint8_t* y = context->y + batch_index * context->y_stride;
   const size_t n = context->n;
-  const size_t n_stride = context->n_stride;
-  const uint8_t* restrict a = context->a;
-  const size_t a_stride = context->a_stride;
-  const uint8_t* restrict packed_b = context->packed_b;
-  const int32_t* restrict bias = context->bias;
-  uint8_t* restrict c = context->c;
-  const size_t c_stride = context->c_stride;
-  const uint8_t a_zero_point = context->a_zero_point;
-  const uint8_t b_zero_point = context->b_zero_point;
 
+  /* Shift the table so that the row maximum maps to its last entry, i.e. exp(0) */
+  const uint8_t x_max = context->rmax_ukernel(n, x);
+  const size_t adjustment = x_max ^ 255;
+  const uint32_t* t = context->t + adjustment;
+  context->lut_norm_ukernel(n, x, t, y);
+}
+
+struct argmax_context {
+  size_t n;
+  const uint8_t* x;
+  size_t x_stride;
+  uint32_t* y;
+  u8rmax_ukernel_function rmax_ukernel;
+};
+
+static void compute_argmax(
+    const struct argmax_context context[restrict static 1],
+    size_t batch_index,
+    size_t batch_range /* always 1 */)
+{
+  assert(batch_range == 1);
+
+  const uint8_t* x = context->x + batch_index * context->x_stride;
+  const size_t n = context->n;
+
+  /* The first channel with the maximum value */
+  const uint8_t x_max = context->rmax_ukernel(n, x);
+  const uint8_t* x_argmax = memchr(x, x_max, n);
+  context->y[batch_index] = (uint32_t) (x_argmax - x);
+}
+
+struct embedding_bag_context {
+  size_t n;
+  const uint8_t* w;
+  const float* scales;
+  const float* biases;
+  const uint32_t* indices;
+  const uint32_t* offsets;
+  const float* per_sample_weights;
+  /* End of the indices of all bags when rows are prefetched, or 0 */
+  size_t prefetch_end;
+  bool mean;
+  float* y;
+  size_t y_stride;
+  q8embedding_ukernel_function embedding_ukernel;
+};
+
+static void compute_embedding_bag(
+    const struct embedding_bag_context context[restrict static 1],
+    size_t bag_index,
+    size_t bag_range /* always 1 */)
+{
+  assert(bag_range == 1);
+
+  const size_t n = context->n;
+  const size_t start = context->offsets[bag_index];
+  const size_t end = context->offsets[bag_index + 1];
+  float* y = context->y + bag_index * context->y_stride;
+  memset(y, 0, n * sizeof(float));
+
+  /* Per-sample weights and the mean scale every dequantized row, so they fold into its scale and bias */
+  const float bag_scale = context->mean && end != start ? 1.0f / (float) (end - start) : 1.0f;
+  for (size_t i = start; i < end; i++) {
+#if defined(__GNUC__)
+    /* Indices of all bags are contiguous, so prefetching runs ahead into the next bags of the same thread too */
+    if (i + QNNP_EMBEDDING_BAG_PREFETCH_DISTANCE < context->prefetch_end) {
+      const uint8_t* w_ahead = context->w + (size_t) context->indices[i + QNNP_EMBEDDING_BAG_PREFETCH_DISTANCE] * n;
+      for (size_t offset = 0; offset < n; offset += QNNP_EMBEDDING_BAG_PREFETCH_STRIDE) {
+        __builtin_prefetch(w_ahead + offset);
+      }
+    }
+#endif
+    const size_t index = context->indices[i];
+    const float scale = context->per_sample_weights != NULL ? bag_scale * context->per_sample_weights[i] : bag_scale;
+    context->embedding_ukernel(
+      n, context->w + index * n, context->scales[index] * scale, context->biases[index] * scale, y);
+  }
+}
+
+struct resize_context {
+  const uint8_t* input;
+  size_t input_pixel_stride;
+  size_t input_row_stride;
+  size_t input_image_stride;
+  uint8_t* output;
+  size_t output_pixel_stride;
+  size_t output_row_stride;
+  size_t output_image_stride;
+  size_t output_width;
+  size_t channels;
+  const uint32_t* columns;
+  const uint32_t* rows;
+  const int16_t* column_weights;
+  const int16_t* row_weights;
+  u8bilinear_ukernel_function ukernel;
+};
+
+static void compute_resize_bilinear(
+    const struct resize_context context[restrict static 1],
+    size_t image,
+    size_t output_y)
+{
+  const uint8_t* input = context->input + image * context->input_image_stride;
+  const uint32_t* rows = context->rows + 2 * output_y;
   context->ukernel(
-      mr_block_size,
-      nr_block_size,
-      k,
-      a + (pixel_index + mr_block_start) * a_stride + group_index * k,
-      a_stride,
-      packed_b + nr_block_start * k_stride + group_index * k_stride * n_stride,
-      bias + nr_block_start + group_index * n_stride,
-      c + (pixel_index + mr_block_start) * c_stride + nr_block_start + group_index * n,
-      c_stride,
-      a_zero_point,
-      b_zero_point,
+    context->output_width,
+    context->channels,
+    input + (size_t) rows[0] * context->input_row_stride,
+    input + (size_t) rows[1] * context->input_row_stride,
+    context->input_pixel_stride,
+    context->columns,
+    context->column_weights,
+    context->row_weights[output_y],
+    context->output + image * context->output_image_stride + output_y * context->output_row_stride,
+    context->output_pixel_stride);
+}
+
+static void compute_resize_nearest(
+    const struct resize_context context[restrict static 1],
+    size_t image,
+    size_t output_y)
+{
+  const uint8_t* input = context->input + image * context->input_image_stride;
+  const uint8_t* input_row = input + (size_t) context->rows[2 * output_y] * context->input_row_stride;
+  uint8_t* output = context->output + image * context->output_image_stride + output_y * context->output_row_stride;
+  const uint32_t* columns = context->columns;
+  const size_t channels = context->channels;
+  for (size_t output_x = 0; output_x < context->output_width; output_x++) {
+    memcpy(output, input_row + (size_t) columns[2 * output_x] * context->input_pixel_stride, channels);
+    output += context->output_pixel_stride;
+  }
+}
+
+struct global_average_pooling_context {
+  const uint8_t* input;
+  size_t input_width;
+  size_t input_pixel_stride;
+  size_t input_batch_stride;
+  int32_t bias;
+  uint8_t* output;
+  size_t output_batch_stride;
+  union qnnp_q31_requantization_params requantization_params;
+  q8gavgpool_ukernel_function ukernel;
+};
+
+static void compute_global_average_pooling(
+    const struct global_average_pooling_context context[restrict static 1],
+    size_t batch_index,
+    size_t channel_start,
+    size_t batch_range /* always 1 */,
+    size_t channel_range)
+{
+  assert(batch_range == 1);
+
+  context->ukernel(
+    context->input_width,
+    channel_range,
+    context->input + batch_index * context->input_batch_stride + channel_start,
+    context->input_pixel_stride,
+    context->bias,
+    context->output + batch_index * context->output_batch_stride + channel_start,
+    &context->requantization_params);
+}
+
+struct max_pooling_context {
+  const uint8_t** indirection_buffer;
+  size_t indirection_row_stride;
+  size_t indirection_col_stride;
+  /* Phases of output pixels in every row of the indirection buffer, see get_dw_indirection_layout */
+  size_t phases;
+  size_t kernel_size;
+  uint8_t* output;
+  size_t output_height;
+  size_t output_width;
+  size_t output_row_stride;
+  size_t output_pixel_stride;
+  union qnnp_u8_clamping_params clamping_params;
+  u8maxpool_ukernel_function ukernel;
+};
+
+static void compute_max_pooling(
+    const struct max_pooling_context context[restrict static 1],
+    size_t image,
+    size_t output_y,
+    size_t channel_start,
+    size_t image_range /* always 1 */,
+    size_t output_y_range /* always 1 */,
+    size_t channel_range)
+{
+  const size_t output_row = image * context->output_height + output_y;
+  const size_t output_width = context->output_width;
+  const size_t output_pixel_stride = context->output_pixel_stride;
+  const size_t phases = context->phases;
+  uint8_t* output = context->output + output_row * context->output_row_stride + channel_start;
+
+  const uint8_t** indirection = context->indirection_buffer + output_row * context->indirection_row_stride;
+  for (size_t phase = 0; phase < min(phases, output_width); phase++) {
+    const size_t phase_width = divide_round_up(output_width - phase, phases);
+    context->ukernel(
+      channel_range,
+      phase_width,
+      context->kernel_size,
+      indirection,
+      output + phase * output_pixel_stride,
+      context->indirection_col_stride,
+      (phases * output_pixel_stride - channel_range) * sizeof(uint8_t),
+      channel_start * sizeof(uint8_t),
+      &context->clamping_params);
+    indirection = (const uint8_t**) ((uintptr_t) indirection +
+      context->kernel_size * sizeof(void*) + (phase_width - 1) * context->indirection_col_stride);
+  }
+}
+
+struct average_pooling_context {
+  const uint8_t** indirection_buffer;
+  size_t indirection_row_stride;
+  size_t indirection_col_stride;
+  /* Phases of output pixels in every row of the indirection buffer, see get_dw_indirection_layout */
+  size_t phases;
+  size_t kernel_size;
+  int32_t bias;
+  uint8_t* output;
+  size_t output_height;
+  size_t output_width;
+  size_t output_row_stride;
+  size_t output_pixel_stride;
+  union qnnp_q31_requantization_params requantization_params;
+  q8avgpool_ukernel_function ukernel;
+};
+
+static void compute_average_pooling(
+    const struct average_pooling_context context[restrict static 1],
+    size_t image,
+    size_t output_y,
+    size_t channel_start,
+    size_t image_range /* always 1 */,
+    size_t output_y_range /* always 1 */,
+    size_t channel_range)
+{
+  const size_t output_row = image * context->output_height + output_y;
+  const size_t output_width = context->output_width;
+  const size_t output_pixel_stride = context->output_pixel_stride;
+  const size_t phases = context->phases;
+  uint8_t* output = context->output + output_row * context->output_row_stride + channel_start;
+
+  const uint8_t** indirection = context->indirection_buffer + output_row * context->indirection_row_stride;
+  for (size_t phase = 0; phase < min(phases, output_width); phase++) {
+    const size_t phase_width = divide_round_up(output_width - phase, phases);
+    context->ukernel(
+      channel_range,
+      phase_width,
+      context->kernel_size,
+      indirection,
+      output + phase * output_pixel_stride,
+      context->indirection_col_stride,
+      (phases * output_pixel_stride - channel_range) * sizeof(uint8_t),
+      channel_start * sizeof(uint8_t),
+      context->bias,
       &context->requantization_params);
+    indirection = (const uint8_t**) ((uintptr_t) indirection +
+      context->kernel_size * sizeof(void*) + (phase_width - 1) * context->indirection_col_stride);
+  }
 }
 
-struct q8sum_rows_context {
-  const uint8_t* a;
-  size_t groups;
+struct channel_shuffle_context {
+  const uint8_t* x;
+  size_t x_stride;
+  uint8_t* y;
+  size_t y_stride;
+  size_t n;
   size_t m;
-  size_t k;
-  size_t a_stride;
-  const int32_t multiplier;
-  int32_t* a_sum;
-  size_t a_sum_stride;
-  const q8sum_rows_ukernel_function ukernel;
+  /* Microkernel for 2, 3, or 4 groups, or NULL when variable_ukernel handles any number of groups */
+  xzipc_ukernel_function fixed_ukernel;
+  xzipv_ukernel_function variable_ukernel;
 };
 
-static void compute_sum_rows(
-    const struct q8sum_rows_context context[restrict static 1],
-    size_t group_index,
+static void compute_channel_shuffle_fixed(
+    const struct channel_shuffle_context context[restrict static 1],
+    size_t index)
+{
+  const void* x = (const void*) ((uintptr_t) context->x + index * context->x_stride);
+  void* y = (void*) ((uintptr_t) context->y + index * context->y_stride);
+
+  context->fixed_ukernel(context->n, x, y);
+}
+
+static void compute_channel_shuffle_variable(
+    const struct channel_shuffle_context context[restrict static 1],
+    size_t index)
+{
+  const void* x = (const void*) ((uintptr_t) context->x + index * context->x_stride);
+  void* y = (void*) ((uintptr_t) context->y + index * context->y_stride);
+
+  context->variable_ukernel(context->n, context->m, x, y);
+}
+
+struct concat_context {
+  const struct qnnp_concat_input* inputs;
+  uint8_t* output;
+  size_t output_stride;
+  q8vrescale_ukernel_function ukernel;
+};
+
+static void compute_concat(
+    const struct concat_context context[restrict static 1],
     size_t batch_index,
-    size_t block_start,
-    size_t group_range /* always 1 */,
-    size_t batch_range /* always 1 */,
-    size_t block_size)
+    size_t input_index)
 {
-  const uint8_t* a = context->a;
-  const size_t groups = context->groups;
-  const size_t m = context->m;
-  const size_t k = context->k;
-  const size_t a_stride = context->a_stride;
-  const int32_t multiplier = context->multiplier;
-  int32_t* a_sum = context->a_sum;
-  const size_t a_sum_stride = context->a_sum_stride;
+  const struct qnnp_concat_input* input = &context->inputs[input_index];
+  const uint8_t* x = input->input + batch_index * input->input_stride;
+  uint8_t* y = context->output + batch_index * context->output_stride + input->channel_offset;
 
-  context->ukernel(
-      a + batch_index * m * a_stride + group_index * k + block_start * a_stride,
-      min(block_size, m - block_start),
-      k,
-      a_stride,
-      multiplier,
-      a_sum + batch_index * groups * a_sum_stride + group_index * a_sum_stride + block_start);
+  if (input->copy) {
+    memcpy(y, x, input->channels);
+  } else {
+    context->ukernel(input->channels, x, y, &input->quantization_params);
+  }
 }
 
-/*   a: batch_size * m * groups * k   */
-/*   a_sum: batch_size * groups * m   */
-static void q8gemm_compute_row_sum(
-    const uint8_t* restrict a,
-    size_t batch_size,
-    size_t groups,
-    size_t m,
-    size_t k,
-    size_t a_stride,
-    const int32_t multiplier,
-    int32_t* restrict a_sum,
-    size_t a_sum_stride,
-    pthreadpool_t threadpool)
+/*
+ * Parallel tasks per thread that operators aim for: enough for threads that finish early to pick up the work of slow
+ * ones, and few enough that dispatch costs little next to the work of a task.
+ */
+#define QNNP_TASKS_PER_THREAD 4
+
+/*
+ * Returns the number of channels per parallel task. When there are fewer than QNNP_TASKS_PER_THREAD outer tasks
+ * (e.g. images or rows) per thread, channels are split into cr-aligned tiles so that every (outer task, channel tile)
+ * pair runs in parallel.
+ */
+static size_t compute_channel_tile(size_t channels, size_t cr, size_t outer_tasks, size_t threads_count)
 {
-  struct q8sum_rows_context context = {
-      .a = a,
-      .groups = groups,
-      .m = m,
-      .k = k,
+  const size_t target_tasks = threads_count * QNNP_TASKS_PER_THREAD;
+  size_t channel_tile = channels;
+  if (outer_tasks < target_tasks) {
+    const size_t channel_tiles = min(divide_round_up(target_tasks, outer_tasks), divide_round_up(channels, cr));
+    channel_tile = min(round_up(divide_round_up(channels, channel_tiles), cr), channels);
+  }
+  return channel_tile;
+}
+
+/* Task of compute_gemm_4d_tiled that covers several mr x nr tiles of the microkernels */
+struct gemm_multitile_task {
+  pthreadpool_function_4d_tiled_t function;
+  void* argument;
+  size_t mr;
+  size_t nr;
+};
+
+static void compute_gemm_multitile(
+    const struct gemm_multitile_task task[restrict static 1],
+    size_t i, size_t j,
+    size_t mr_block_start, size_t nr_block_start,
+    size_t tile_i, size_t tile_j,
+    size_t m_block_size, size_t n_block_size)
+{
+  const size_t mr = task->mr;
+  const size_t nr = task->nr;
+  /* Output channels are the inner loop, as in the pthreadpool loop over single tiles */
+  for (size_t m_offset = 0; m_offset < m_block_size; m_offset += mr) {
+    for (size_t n_offset = 0; n_offset < n_block_size; n_offset += nr) {
+      task->function(
+          task->argument,
+          i, j,
+          mr_block_start + m_offset, nr_block_start + n_offset,
+          tile_i, tile_j,
+          min(m_block_size - m_offset, mr), min(n_block_size - n_offset, nr));
+    }
+  }
+}
+
+/*
+ * Runs a parallel loop over the mr x nr tiles of GEMM and convolution microkernels, which function computes one at a
+ * time in its two inner dimensions. When the loop has more tiles than QNNP_TASKS_PER_THREAD per thread of the pool,
+ * every task covers several of them, first along output channels and then along output pixels, so that few threads
+ * do not pay the dispatch of every tile. Otherwise every tile is a task, which balances the load of many threads
+ * best.
+ */
+static void compute_gemm_4d_tiled(
+    struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_4d_tiled_t function,
+    void* argument,
+    size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+    size_t tile_i, size_t tile_j, size_t mr, size_t nr)
+{
+  const size_t outer_tasks = divide_round_up(range_i, tile_i) * divide_round_up(range_j, tile_j);
+  const size_t m_tiles = divide_round_up(range_k, mr);
+  const size_t n_tiles = divide_round_up(range_l, nr);
+  const size_t target_tasks = qnnp_get_threads_count(op, threadpool) * QNNP_TASKS_PER_THREAD;
+  const size_t tiles_per_task = outer_tasks * m_tiles * n_tiles / target_tasks;
+  if (tiles_per_task <= 1) {
+    qnnp_compute_4d_tiled(
+        op, threadpool,
+        function, argument,
+        range_i, range_j, range_k, range_l,
+        tile_i, tile_j, mr, nr);
+    return;
+  }
+
+  const size_t n_tiles_per_task = min(tiles_per_task, n_tiles);
+  const size_t m_tiles_per_task = min(max(tiles_per_task / n_tiles_per_task, 1), m_tiles);
+  struct gemm_multitile_task task = {
+      .function = function,
+      .argument = argument,
+      .mr = mr,
+      .nr = nr,
+  };
+  qnnp_compute_4d_tiled(
+      op, threadpool,
+      (pthreadpool_function_4d_tiled_t) compute_gemm_multitile, &task,
+      range_i, range_j, range_k, range_l,
+      tile_i, tile_j, m_tiles_per_task * mr, n_tiles_per_task * nr);
+}
+
+/*
+ * Output channels per task of XZP GEMM, a multiple of nr. Every task sums its input rows once for all channels of its
+ * panel, so panels span all output channels unless there are too few tiles of rows for the threads, and are then split
+ * into only as many as the threads need.
+ */
+static size_t compute_xzp_panel_channels(
+    const struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    size_t m_tiles,
+    size_t n,
+    size_t nr)
+{
+  const size_t threads = qnnp_get_threads_count(op, threadpool);
+  const size_t target_tasks = threads * QNNP_TASKS_PER_THREAD;
+  if (threads == 1 || m_tiles >= target_tasks) {
+    return n;
+  }
+  const size_t panels = min(divide_round_up(target_tasks, m_tiles), divide_round_up(n, nr));
+  return round_up(divide_round_up(n, panels), nr);
+}
+
+/* Output channels per task of the conv microkernels: single tiles, or XZP panels that share their row sums */
+static size_t get_q8conv_task_channels(
+    const struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    size_t m_tiles,
+    size_t n,
+    size_t nr)
+{
+  return op->flags & QNNP_CONVOLUTION_FLAG_XZP_CONV ? compute_xzp_panel_channels(op, threadpool, m_tiles, n, nr) : nr;
+}
+
+static struct q8gemm_context get_fused_q8gemm_context(const struct qnnp_operator* op, size_t a_stride, size_t c_stride) {
+  const uint32_t nr = op->q8conv.nr;
+  const uint32_t kr = op->q8conv.kr;
+  const struct q8gemm_context context = {
+      .k = op->group_input_channels,
+      .k_stride = qnnp_get_packed_channel_stride(1, op->group_input_channels, nr, kr),
+      .n = op->group_output_channels,
+      .n_stride = (op->group_output_channels + (nr - 1)) & -nr,
+      .nr = nr,
       .a_stride = a_stride,
-      .multiplier = multiplier,
-      .a_sum = a_sum,
-      .a_sum_stride = a_sum_stride,
-      .ukernel = qnnp_params.q8sum_rows.sum_rows,
+      .packed_b = op->packed_kernel,
+      .bias = op->bias,
+      .c_stride = c_stride,
+      .a_zero_point = op->input_zero_point,
+      .b_zero_point = op->kernel_zero_point,
+      .requantization_params = op->requantization_params,
+      .lookup_table = op->lookup_table,
+      .ukernels = qnnp_get_q8conv_uarch_ukernels(&op->q8conv),
   };
+  return context;
+}
 
-  pthreadpool_compute_3d_tiled(
-    threadpool,
-    (pthreadpool_function_3d_tiled_t) compute_sum_rows,
-    &context,
-    groups, batch_size, m,
-    1, 1, qnnp_params.q8sum_rows.m);
+static enum qnnp_status run_inverted_residual(qnnp_operator_t op, pthreadpool_t threadpool)
+{
+  const struct qnnp_inverted_residual* fused = op->inverted_residual;
+  struct qnnp_operator* fused_ops[3] = { fused->expansion, fused->depthwise, fused->projection };
+  const uint64_t packing_start = qnnp_profile_start();
+  for (size_t i = 0; i < 3; i++) {
+    if (fused_ops[i] == NULL) {
+      continue;
+    }
+    const enum qnnp_status status = qnnp_ensure_packed_weights(fused_ops[i], threadpool);
+    if (status != qnnp_status_success) {
+      return status;
+    }
+  }
+  qnnp_profile_phase(op, qnnp_profiling_phase_packing, packing_start);
+
+  const struct qnnp_operator* depthwise = fused->depthwise;
+  const size_t channels = depthwise->groups;
+  const size_t kernel_size = depthwise->kernel_height * depthwise->kernel_width;
+  const struct q8dw_parameters* q8dw_params = kernel_size == 9 ? &qnnp_params.q8dw9 : &qnnp_params.q8dw25;
+  const void* zero = depthwise->zero;
+  if (channels < 8 && zero != NULL) {
+    zero = (const void*) ((uintptr_t) zero + 8);
+  }
+  /* Depthwise separable operators have no expansion and leave its GEMM context zeroed */
+  const struct qnnp_operator* expansion = fused->expansion;
+  struct inverted_residual_context context = {
+      .expansion = expansion != NULL ?
+        get_fused_q8gemm_context(expansion, op->input_pixel_stride, channels) : (struct q8gemm_context) { 0 },
+      .expansion_mr = expansion != NULL ? expansion->q8conv.mr : 0,
+      .depthwise = {
+          .channels = channels,
+          .packed_kernel = depthwise->packed_kernel,
+          .input_zero_point = depthwise->input_zero_point,
+          .kernel_zero_point = depthwise->kernel_zero_point,
+          .requantization_params = depthwise->requantization_params,
+          .lookup_table = depthwise->lookup_table,
+          .ukernel = q8dw_params->dw,
+      },
+      .projection = get_fused_q8gemm_context(fused->projection, channels, op->output_pixel_stride),
+      .projection_mr = fused->projection->q8conv.mr,
+      .input = op->input,
+      .input_height = op->input_height,
+      .input_width = op->input_width,
+      .input_pixel_stride = op->input_pixel_stride,
+      .output = op->output,
+      .output_height = op->output_height,
+      .output_width = op->output_width,
+      .output_pixel_stride = op->output_pixel_stride,
+      .kernel_height = depthwise->kernel_height,
+      .kernel_width = depthwise->kernel_width,
+      .stride_height = depthwise->stride_height,
+      .stride_width = depthwise->stride_width,
+      .dilation_height = depthwise->dilation_height,
+      .dilation_width = depthwise->dilation_width,
+      .input_padding_top = depthwise->input_padding_top,
+      .input_padding_left = depthwise->input_padding_left,
+      .zero = zero,
+      .rows = op->batch_size * op->output_height,
+      .bands = fused->bands,
+      .ring_rows = fused->ring_rows,
+      .depthwise_rows = fused->depthwise_rows,
+      .band_buffers = fused->band_buffers,
+      .band_buffer_stride = fused->band_buffer_stride,
+      .depthwise_output_offset = fused->depthwise_output_offset,
+      .indirection_offset = fused->indirection_offset,
+  };
+  qnnp_compute_1d(
+      op, threadpool,
+      (pthreadpool_function_1d_t) compute_inverted_residual,
+      &context,
+      fused->bands);
+  return qnnp_status_success;
 }
 
-struct q8gemm_xzp_context {
-  size_t k;
-  size_t k_stride;
-  size_t n;
-  size_t n_stride;
-  const uint8_t* a;
-  size_t a_stride;
-  const uint8_t* packed_b;
-  const int32_t* bias;
-  uint8_t* c;
-  size_t c_stride;
-  const int32_t* a_sum;
-  size_t groups;
-  size_t batch_size;
-  size_t a_sum_stride;
-  union qnnp_q31_requantization_params requantization_params;
-  const q8gemm_xzp_ukernel_function ukernel;
+struct lstm_cell_context {
+  struct q8gemm_context gates;
+  int16_t* cell_state;
+  size_t hidden_channels;
+  uint8_t* hidden_output;
+  size_t hidden_output_stride;
+  uint32_t cell_shift;
+  union qnnp_q31_requantization_params hidden_requantization_params;
+  const int16_t* sigmoid_table;
+  const int16_t* tanh_table;
+  const int16_t* cell_tanh_table;
 };
 
-static void compute_q8gemm_xzp(
-    const struct q8gemm_xzp_context context[restrict static 1],
+/* Shifts right by n > 0 bits, rounding to nearest */
+static inline int32_t lstm_rounding_shift(int32_t x, uint32_t n) {
+  return asr_s32(x + (INT32_C(1) << (n - 1)), n);
+}
+
+/* Q15 tanh of a cell state in units of 2**-cell_shift, interpolated between entries 1/16 apart in [-8, 8] */
+static inline int32_t lstm_cell_tanh(int32_t c, uint32_t cell_shift, const int16_t table[restrict static 257]) {
+  /* Position in the table in units of 1/256 of an entry, with c = 0 at entry 128 */
+  int32_t position = asr_s32(c * 4096, cell_shift) + 128 * 256;
+  position = position < 0 ? 0 : position;
+  position = position > 256 * 256 ? 256 * 256 : position;
+  const int32_t index = position >> 8;
+  if (index == 256) {
+    return table[256];
+  }
+  const int32_t fraction = position & 255;
+  return table[index] + (((table[index + 1] - table[index]) * fraction + 128) >> 8);
+}
+
+/*
+ * Computes a tile of the gate GEMM, and then updates the cell state and hidden output of its hidden units. Tiles are
+ * multiples of 4 output channels, so they always hold all four gates of a hidden unit.
+ */
+static void compute_lstm_cell(
+    const struct lstm_cell_context context[restrict static 1],
     size_t group_index,
     size_t pixel_index,
     size_t mr_block_start,
     size_t nr_block_start,
     size_t group_range /* always 1 */,
-    size_t pixel_range,
+    size_t pixel_range /* always 1 */,
     size_t mr_block_size,
     size_t nr_block_size)
 {
-  const size_t k = context->k;
-  const size_t k_stride = context->k_stride;
-  const size_t n = context->n;
-  const size_t n_stride = context->n_stride;
-  const uint8_t* restrict a = context->a;
-  const size_t a_stride = context->a_stride;
-  const uint8_t* restrict packed_b = context->packed_b;
-  const int32_t* restrict bias = context->bias;
-  uint8_t* restrict c = context->c;
-  const size_t c_stride = context->c_stride;
-  const int32_t* a_sum = context->a_sum;
-  const size_t groups = context->groups;
-  const size_t batch_size = context->batch_size;
-  const size_t a_sum_stride = context->a_sum_stride;
+  compute_q8gemm(
+      &context->gates,
+      group_index, pixel_index, mr_block_start, nr_block_start,
+      group_range, pixel_range, mr_block_size, nr_block_size);
 
-  context->ukernel(
-      mr_block_size,
-      nr_block_size,
-      k,
-      a + (pixel_index + mr_block_start) * a_stride + group_index * k,
-      a_stride,
-      packed_b + nr_block_start * k_stride + group_index * k_stride * n_stride,
-      bias + nr_block_start + group_index * n_stride,
-      c + (pixel_index + mr_block_start) * c_stride + nr_block_start + group_index * n,
-      c_stride,
-      a_sum + pixel_index * groups + group_index * a_sum_stride + mr_block_start,
-      &context->requantization_params);
+  const size_t hidden_channels = context->hidden_channels;
+  const uint32_t cell_shift = context->cell_shift;
+  const int16_t* sigmoid_table = context->sigmoid_table;
+  const int16_t* tanh_table = context->tanh_table;
+  const size_t gates_stride = context->gates.c_stride;
+  for (size_t m = mr_block_start; m < mr_block_start + mr_block_size; m++) {
+    const uint8_t* gates = context->gates.c + m * gates_stride + nr_block_start;
+    int16_t* cell_state = context->cell_state + m * hidden_channels + nr_block_start / 4;
+    uint8_t* hidden_output = context->hidden_output + m * context->hidden_output_stride + nr_block_start / 4;
+    for (size_t j = 0; j < nr_block_size / 4; j++) {
+      const int32_t input_gate = sigmoid_table[gates[4 * j]];
+      const int32_t forget_gate = sigmoid_table[gates[4 * j + 1]];
+      const int32_t cell_gate = tanh_table[gates[4 * j + 2]];
+      const int32_t output_gate = sigmoid_table[gates[4 * j + 3]];
+
+      /* Q15 forget gate keeps the units of the cell state, and the Q30 product of the others is shifted into them */
+      int32_t cell = lstm_rounding_shift(forget_gate * (int32_t) cell_state[j], 15) +
+        lstm_rounding_shift(input_gate * cell_gate, 30 - cell_shift);
+      cell = cell < INT16_MIN ? INT16_MIN : cell;
+      cell = cell > INT16_MAX ? INT16_MAX : cell;
+      cell_state[j] = (int16_t) cell;
+
+      const int32_t hidden = output_gate * lstm_cell_tanh(cell, cell_shift, context->cell_tanh_table);
+      hidden_output[j] = qnnp_q31_requantize(hidden, context->hidden_requantization_params);
+    }
+  }
 }
 
-struct q8conv_context {
-  size_t bs;
-  size_t ks;
-  size_t kc;
-  size_t kc_stride;
-  size_t m;
-  size_t m_stride;
-  size_t n;
-  size_t n_stride;
-  const uint8_t** im2col_a;
-  const uint8_t* packed_b;
-  const int32_t* bias;
-  uint8_t* c;
-  size_t c_stride;
-  uint8_t a_zero_point;
-  uint8_t b_zero_point;
-  union qnnp_q31_requantization_params requantization_params;
-  const q8conv_ukernel_function ukernel;
-};
+static enum qnnp_status run_lstm_cell(qnnp_operator_t op, pthreadpool_t threadpool)
+{
+  struct qnnp_lstm_cell* lstm_cell = op->lstm_cell;
+  struct qnnp_operator* gates = lstm_cell->gates;
+  const uint64_t packing_start = qnnp_profile_start();
+  const enum qnnp_status status = qnnp_ensure_packed_weights(gates, threadpool);
+  if (status != qnnp_status_success) {
+    return status;
+  }
+  qnnp_profile_phase(op, qnnp_profiling_phase_packing, packing_start);
 
-static void compute_q8conv(
-    const struct q8conv_context context[restrict static 1],
-    size_t group_index,
-    size_t image_index,
-    size_t mr_block_start,
-    size_t nr_block_start,
-    size_t group_range /* always 1 */,
-    size_t image_range /* always 1 */,
-    size_t mr_block_size,
-    size_t nr_block_size)
+  /* Rows of the GEMM input are the input and the previous hidden state, which may also be the hidden output */
+  const size_t batch_size = op->batch_size;
+  const size_t input_channels = op->group_input_channels;
+  const size_t hidden_channels = lstm_cell->hidden_channels;
+  const size_t concat_channels = input_channels + hidden_channels;
+  for (size_t m = 0; m < batch_size; m++) {
+    uint8_t* concat_row = lstm_cell->concat_buffer + m * concat_channels;
+    memcpy(concat_row, (const uint8_t*) op->input + m * op->input_pixel_stride, input_channels);
+    memcpy(
+      concat_row + input_channels,
+      lstm_cell->hidden_input + m * lstm_cell->hidden_input_stride,
+      hidden_channels);
+  }
+
+  struct lstm_cell_context context = {
+      .gates = get_fused_q8gemm_context(gates, concat_channels, 4 * hidden_channels),
+      .cell_state = lstm_cell->cell_state,
+      .hidden_channels = hidden_channels,
+      .hidden_output = op->output,
+      .hidden_output_stride = op->output_pixel_stride,
+      .cell_shift = lstm_cell->cell_shift,
+      .hidden_requantization_params = lstm_cell->hidden_requantization_params,
+      .sigmoid_table = lstm_cell->sigmoid_table,
+      .tanh_table = lstm_cell->tanh_table,
+      .cell_tanh_table = lstm_cell->cell_tanh_table,
+  };
+  context.gates.a = lstm_cell->concat_buffer;
+  context.gates.c = lstm_cell->gate_buffer;
+  compute_gemm_4d_tiled(
+      op, threadpool,
+      (pthreadpool_function_4d_tiled_t) compute_lstm_cell,
+      &context,
+      1, 1, batch_size, 4 * hidden_channels,
+      1, 1, gates->q8conv.mr, gates->q8conv.nr);
+  return qnnp_status_success;
+}
+
+static void compute_convolution_input_rows(
+    const struct qnnp_operator* convolution,
+    size_t output_y_start,
+    size_t output_rows,
+    size_t* input_y_start_out,
+    size_t* input_y_end_out)
 {
-  const size_t bs = context->bs;
-  const size_t ks = context->ks;
-  const size_t kc = context->kc;
-  const size_t kc_stride = context->kc_stride;
-  const size_t m = context->m;
-  const size_t m_stride = context->m_stride;
-  const size_t n = context->n;
-  const size_t n_stride = context->n_stride;
-  const uint8_t** restrict im2col_a = context->im2col_a;
-  const uint8_t* restrict packed_b = context->packed_b;
-  const int32_t* restrict bias = context->bias;
-  uint8_t* restrict c = context->c;
-  const size_t c_stride = context->c_stride;
-  const uint8_t a_zero_point = context->a_zero_point;
-  const uint8_t b_zero_point = context->b_zero_point;
+  const size_t effective_kernel_height = (convolution->kernel_height - 1) * convolution->dilation_height + 1;
+  /* Rows are in the padded input, where real input rows start at input_padding_top */
+  const size_t padded_y_start = output_y_start * convolution->stride_height;
+  const size_t padded_y_end = (output_y_start + output_rows - 1) * convolution->stride_height + effective_kernel_height;
+  const size_t input_y_start = doz(padded_y_start, convolution->input_padding_top);
+  const size_t input_y_end = min(doz(padded_y_end, convolution->input_padding_top), convolution->input_height);
+  *input_y_start_out = input_y_start;
+  *input_y_end_out = max(input_y_start, input_y_end);
+}
 
-  context->ukernel(
-      mr_block_size,
-      nr_block_size,
-      kc,
-      ks,
-      im2col_a + (mr_block_start + (image_index + group_index * bs) * m_stride) * ks,
-      packed_b + (nr_block_start + group_index * n_stride) * kc_stride,
-      bias + nr_block_start + group_index * n_stride,
-      c + (mr_block_start + image_index * m) * c_stride + group_index * n + nr_block_start,
-      c_stride,
-      a_zero_point,
-      b_zero_point,
-      &context->requantization_params);
+/*
+ * Computes output rows [output_y_start, output_y_start + output_rows) of a stem convolution. The input rows that they
+ * read are copied with their left and right padding into the scratch buffer, where the taps of kernel rows are
+ * kernel_width adjacent pixels, and tiles compute their pointers as with tile indirection for a kernel of one column.
+ */
+static void run_q8conv_stem(
+    qnnp_operator_t op,
+    size_t output_y_start,
+    size_t output_rows,
+    pthreadpool_t threadpool)
+{
+  const size_t batch_size = op->batch_size;
+  const size_t input_height = op->input_height;
+  const size_t input_width = op->input_width;
+  const size_t channels = op->group_input_channels;
+  const size_t group_output_channels = op->group_output_channels;
+  const size_t output_width = op->output_width;
+  const size_t padded_input_width = op->input_padding_left + input_width + op->input_padding_right;
+  uint8_t* padded_input = (uint8_t*) op->expanded_input + 8;
+
+  /* Only the input rows of the band are copied, the rest of the padded input may be stale */
+  size_t input_y_start, input_y_end;
+  compute_convolution_input_rows(op, output_y_start, output_rows, &input_y_start, &input_y_end);
+  for (size_t image = 0; image < batch_size; image++) {
+    const size_t input_row = image * input_height + input_y_start;
+    struct row_padding_context row_padding_context = {
+        .channels = channels,
+        .input_width = input_width,
+        .input = (const uint8_t*) op->input + image * op->input_image_stride + input_y_start * op->input_row_stride,
+        .input_row_stride = op->input_row_stride,
+        .input_pixel_stride = op->input_pixel_stride,
+        .padding_left = op->input_padding_left,
+        .padding_right = op->input_padding_right,
+        .zero_point = op->input_zero_point,
+        .output = padded_input + input_row * padded_input_width * channels,
+    };
+    qnnp_compute_1d(
+        op, threadpool,
+        (pthreadpool_function_1d_t) compute_row_padding,
+        &row_padding_context,
+        input_y_end - input_y_start);
+  }
+
+  const uint32_t mr = op->q8conv.mr;
+  const uint32_t nr = op->q8conv.nr;
+  const uint32_t kr = op->q8conv.kr;
+  const size_t tap_channels = qnnp_convolution_get_tap_channels(op);
+  const size_t taps = qnnp_convolution_get_taps(op);
+  const size_t output_size = op->output_height * output_width;
+  struct q8conv_context q8conv_context = {
+      .bs = batch_size,
+      .ks = taps,
+      .kc = tap_channels,
+      .kc_stride = qnnp_get_packed_channel_stride(taps, tap_channels, nr, kr),
+      .m = output_size,
+      .m_stride = round_up(output_size, mr),
+      .n = group_output_channels,
+      .n_stride = (group_output_channels + (nr - 1)) & -nr,
+      .mr = mr,
+      .a = padded_input,
+      .a_pixel_stride = channels,
+      .zero = (const uint8_t*) ((uintptr_t) op->zero + (tap_channels < 8 ? 8 : 0)),
+      .input_height = input_height,
+      .input_width = padded_input_width,
+      .output_width_divisor = fxdiv_init_size_t(output_width),
+      .kernel_height = op->kernel_height,
+      .kernel_width = 1,
+      .stride_height = op->stride_height,
+      .stride_width = op->stride_width,
+      .dilation_height = op->dilation_height,
+      .dilation_width = 1,
+      .input_padding_top = op->input_padding_top,
+      .input_padding_left = 0,
+      .m_start = output_y_start * output_width,
+      .m_end = (output_y_start + output_rows) * output_width,
+      .packed_b = op->packed_kernel,
+      .bias = (const int32_t*) op->bias,
+      .bias_stride = op->flags & QNNP_CONVOLUTION_FLAG_PER_CHANNEL ? 2 : 1,
+      .tap_stride = get_q8conv_tap_stride(op),
+      .c = op->output,
+      .c_stride = op->output_pixel_stride,
+      .a_zero_point = op->input_zero_point,
+      .b_zero_point = op->kernel_zero_point,
+      .requantization_params = op->requantization_params,
+      .lookup_table = op->lookup_table,
+      .ukernels = qnnp_get_q8conv_uarch_ukernels(&op->q8conv),
+      .xzp_ukernel = op->flags & QNNP_CONVOLUTION_FLAG_XZP_CONV ? op->q8conv.xzp_conv : NULL,
+      .sum_rows_ukernel = qnnp_params.q8sum_rows.conv_sum_rows,
+      .nr = nr,
+      .a_sum_multiplier = -(int32_t) op->kernel_zero_point,
+  };
+  compute_gemm_4d_tiled(
+      op, threadpool,
+      (pthreadpool_function_4d_tiled_t) compute_q8conv_with_tile_indirection,
+      &q8conv_context,
+      1, batch_size, output_rows * output_width, group_output_channels,
+      1, 1, mr,
+      get_q8conv_task_channels(
+        op, threadpool, batch_size * divide_round_up(output_rows * output_width, mr), group_output_channels, nr));
 }
 
-struct q8dw_context {
-  size_t groups;
-  const uint8_t** im2col_buffer;
-  size_t im2col_row_stride;
-  size_t im2col_col_stride;
-  const uint8_t* packed_kernel;
-  const int32_t* bias;
-  uint8_t* output;
-  size_t output_height;
-  size_t output_width;
-  size_t output_row_stride;
-  size_t output_col_increment;
-  uint8_t input_zero_point;
-  uint8_t kernel_zero_point;
-  union qnnp_q31_requantization_params requantization_params;
-  const q8dw_ukernel_function ukernel;
-};
+/*
+ * Computes output rows [output_y_start, output_y_start + output_rows) of a Winograd convolution: the input tiles of
+ * their 2x2 output tiles are transformed into the scratch buffer, and then multiplied with the transformed kernel and
+ * transformed back. Tiles that straddle the ends of the band read zeros instead of the input rows outside it, which
+ * only reach the output rows outside the band, and those are not stored.
+ */
+static void run_q8winograd(
+    qnnp_operator_t op,
+    size_t output_y_start,
+    size_t output_rows,
+    pthreadpool_t threadpool)
+{
+  const size_t batch_size = op->batch_size;
+  const size_t groups = op->groups;
+  const size_t tiles_width = divide_round_up(op->output_width, 2);
+  const size_t tiles = divide_round_up(op->output_height, 2) * tiles_width;
+  const size_t tile_y_start = output_y_start / 2;
+  const size_t tile_y_end = divide_round_up(output_y_start + output_rows, 2);
+
+  size_t input_y_start, input_y_end;
+  compute_convolution_input_rows(op, output_y_start, output_rows, &input_y_start, &input_y_end);
+  struct q8winograd_input_transform_context input_transform_context = {
+      .batch_size = batch_size,
+      .groups = groups,
+      .group_input_channels = op->group_input_channels,
+      .input_height = op->input_height,
+      .input_width = op->input_width,
+      .input_y_start = input_y_start,
+      .input_y_end = input_y_end,
+      .input = op->input,
+      .input_pixel_stride = op->input_pixel_stride,
+      .input_padding_top = op->input_padding_top,
+      .input_padding_left = op->input_padding_left,
+      .zero = op->zero,
+      .tiles_width = tiles_width,
+      .tiles = tiles,
+      .tile_y_start = tile_y_start,
+      .transformed_input = op->expanded_input,
+      .input_zero_point = op->input_zero_point,
+  };
+  qnnp_compute_2d(
+      op, threadpool,
+      (pthreadpool_function_2d_t) compute_q8winograd_input_transform,
+      &input_transform_context,
+      batch_size, tile_y_end - tile_y_start);
+
+  struct q8winograd_context q8winograd_context = {
+      .k = op->group_input_channels,
+      .n = op->group_output_channels,
+      .n_stride = round_up(op->group_output_channels, QNNP_WINOGRAD_NR),
+      .batch_size = batch_size,
+      .tiles_width = tiles_width,
+      .tiles = tiles,
+      .tile_start = tile_y_start * tiles_width,
+      .transformed_input = op->expanded_input,
+      .packed_kernel = op->packed_kernel,
+      .bias = op->bias,
+      .output = op->output,
+      .output_height = op->output_height,
+      .output_width = op->output_width,
+      .output_y_start = output_y_start,
+      .output_y_end = output_y_start + output_rows,
+      .output_pixel_stride = op->output_pixel_stride,
+      .scalar_requantization_params = qnnp_compute_scalar_requantization_params(
+        op->requantization_scale, op->output_zero_point, op->output_min, op->output_max),
+      .lookup_table = op->lookup_table,
+  };
+  compute_gemm_4d_tiled(
+      op, threadpool,
+      (pthreadpool_function_4d_tiled_t) compute_q8winograd,
+      &q8winograd_context,
+      batch_size, groups, (tile_y_end - tile_y_start) * tiles_width, op->group_output_channels,
+      1, 1, QNNP_WINOGRAD_MR, QNNP_WINOGRAD_NR);
+}
+
+static enum qnnp_status run_operator(qnnp_operator_t op, pthreadpool_t threadpool)
+{
+  const size_t threads_count = qnnp_get_threads_count(op, threadpool);
+  if (op->type == qnnp_operator_type_inverted_residual || op->type == qnnp_operator_type_depthwise_separable) {
+    return run_inverted_residual(op, threadpool);
+  }
+  if (op->type == qnnp_operator_type_lstm_cell) {
+    return run_lstm_cell(op, threadpool);
+  }
+  if (op->type == qnnp_operator_type_quantize) {
+    run_conversion(
+      op, threadpool, sizeof(float), sizeof(uint8_t), &op->f32_quantization_params,
+      (conversion_ukernel_function) qnnp_params.q8vquantize);
+    return qnnp_status_success;
+  }
+  if (op->type == qnnp_operator_type_dequantize) {
+    run_conversion(
+      op, threadpool, sizeof(uint8_t), sizeof(float), &op->f32_dequantization_params,
+      (conversion_ukernel_function) qnnp_params.q8vdequantize);
+    return qnnp_status_success;
+  }
+  if (op->type == qnnp_operator_type_requantize) {
+    run_conversion(
+      op, threadpool, sizeof(uint8_t), sizeof(uint8_t), &op->add_quantization_params,
+      (conversion_ukernel_function) qnnp_params.q8vrescale);
+    return qnnp_status_success;
+  }
+  if (op->type == qnnp_operator_type_softmax) {
+    struct softmax_context softmax_context = {
+        .n = op->channels,
+        .x = op->input,
+        .x_stride = op->input_pixel_stride,
+        .t = op->exp_lookup_table,
+        .y = op->output,
+        .y_stride = op->output_pixel_stride,
+        .rmax_ukernel = qnnp_params.u8rmax,
+        .lut_norm_ukernel = qnnp_params.u8lut32norm,
+    };
+    qnnp_compute_1d_tiled(
+        op, threadpool,
+        (pthreadpool_function_1d_tiled_t) compute_softmax,
+        &softmax_context,
+        op->batch_size,
+        1);
+    return qnnp_status_success;
+  }
+  if (op->type == qnnp_operator_type_argmax) {
+    struct argmax_context argmax_context = {
+        .n = op->channels,
+        .x = op->input,
+        .x_stride = op->input_pixel_stride,
+        .y = op->output,
+        .rmax_ukernel = qnnp_params.u8rmax,
+    };
+    qnnp_compute_1d_tiled(
+        op, threadpool,
+        (pthreadpool_function_1d_tiled_t) compute_argmax,
+        &argmax_context,
+        op->batch_size,
+        1);
+    return qnnp_status_success;
+  }
+  if (op->type == qnnp_operator_type_embedding_bag) {
+    const struct qnnp_embedding_bag* embedding_bag = op->embedding_bag;
+    struct embedding_bag_context embedding_bag_context = {
+        .n = op->channels,
+        .w = embedding_bag->weights,
+        .scales = embedding_bag->scales,
+        .biases = embedding_bag->biases,
+        .indices = embedding_bag->indices,
+        .offsets = embedding_bag->offsets,
+        .per_sample_weights = embedding_bag->per_sample_weights,
+        .prefetch_end = embedding_bag->prefetch ? embedding_bag->offsets[op->batch_size] : 0,
+        .mean = (op->flags & QNNP_CREATE_FLAG_EMBEDDING_BAG_MEAN) != 0,
+        .y = op->output,
+        .y_stride = op->output_pixel_stride,
+        .embedding_ukernel = qnnp_params.q8embedding,
+    };
+    qnnp_compute_1d_tiled(
+        op, threadpool,
+        (pthreadpool_function_1d_tiled_t) compute_embedding_bag,
+        &embedding_bag_context,
+        op->batch_size,
+        1);
+    return qnnp_status_success;
+  }
+  if (op->type == qnnp_operator_type_resize_bilinear || op->type == qnnp_operator_type_resize_nearest) {
+    const size_t output_width = op->output_width;
+    struct resize_context resize_context = {
+        .input = op->input,
+        .input_pixel_stride = op->input_pixel_stride,
+        .input_row_stride = op->input_width * op->input_pixel_stride,
+        .input_image_stride = op->input_height * op->input_width * op->input_pixel_stride,
+        .output = op->output,
+        .output_pixel_stride = op->output_pixel_stride,
+        .output_row_stride = output_width * op->output_pixel_stride,
+        .output_image_stride = op->output_height * output_width * op->output_pixel_stride,
+        .output_width = output_width,
+        .channels = op->channels,
+        .columns = op->resize_indices,
+        .rows = op->resize_indices + 2 * output_width,
+        .column_weights = op->resize_weights,
+        .row_weights = op->resize_weights + output_width,
+        .ukernel = qnnp_params.u8bilinear,
+    };
+    qnnp_compute_2d(
+        op, threadpool,
+        (pthreadpool_function_2d_t) (op->type == qnnp_operator_type_resize_bilinear ?
+          compute_resize_bilinear : compute_resize_nearest),
+        &resize_context,
+        op->batch_size, op->output_height);
+    return qnnp_status_success;
+  }
+  if (op->type == qnnp_operator_type_add) {
+    const size_t batch_size = op->batch_size;
+    const size_t channels = op->channels;
+    if (op->input_pixel_stride == channels && op->input2_pixel_stride == channels &&
+        op->output_pixel_stride == channels)
+    {
+      /* Rows are adjacent, so split the whole tensor into equal blocks regardless of the number of channels */
+      struct add_contiguous_context add_context = {
+          .a = op->input,
+          .b = op->input2,
+          .y = op->output,
+          .quantization_params = op->add_quantization_params,
+          .ukernel = qnnp_params.q8vadd,
+      };
+      qnnp_compute_1d_tiled(
+          op, threadpool,
+          (pthreadpool_function_1d_tiled_t) compute_add_contiguous,
+          &add_context,
+          batch_size * channels,
+          QNNP_ADD_CONTIGUOUS_TILE);
+    } else {
+      struct add_strided_context add_context = {
+          .n = channels,
+          .a = op->input,
+          .a_stride = op->input_pixel_stride,
+          .b = op->input2,
+          .b_stride = op->input2_pixel_stride,
+          .y = op->output,
+          .y_stride = op->output_pixel_stride,
+          .quantization_params = op->add_quantization_params,
+          .ukernel = qnnp_params.q8vadd,
+      };
+      qnnp_compute_1d_tiled(
+          op, threadpool,
+          (pthreadpool_function_1d_tiled_t) compute_add_strided,
+          &add_context,
+          batch_size,
+          1);
+    }
+    return qnnp_status_success;
+  } else if (op->type == qnnp_operator_type_global_average_pooling) {
+    const size_t batch_size = op->batch_size;
+    const size_t channels = op->channels;
+    const size_t input_width = op->input_width;
+
+    /* As for depthwise convolution, split channels into nr-aligned tiles when there are too few images */
+    const size_t channel_tile = compute_channel_tile(channels, qnnp_params.q8gavgpool.nr, batch_size, threads_count);
+
+    struct global_average_pooling_context global_average_pooling_context = {
+        .input = op->input,
+        .input_width = input_width,
+        .input_pixel_stride = op->input_pixel_stride,
+        .input_batch_stride = input_width * op->input_pixel_stride,
+        .bias = -(int32_t) input_width * (int32_t) (uint32_t) op->input_zero_point,
+        .output = op->output,
+        .output_batch_stride = op->output_pixel_stride,
+        .requantization_params = op->requantization_params,
+        .ukernel = qnnp_params.q8gavgpool.gavgpool,
+    };
+    qnnp_compute_2d_tiled(
+        op, threadpool,
+        (pthreadpool_function_2d_tiled_t) compute_global_average_pooling,
+        &global_average_pooling_context,
+        batch_size, channels,
+        1, channel_tile);
+    return qnnp_status_success;
+  } else if (op->type == qnnp_operator_type_max_pooling || op->type == qnnp_operator_type_average_pooling) {
+    /* Pooling reads the depthwise indirection buffer of qnnp_setup_convolution_indirection */
+    const size_t batch_size = op->batch_size;
+    const size_t channels = op->channels;
+    const size_t kernel_size = op->kernel_height * op->kernel_width;
+    const size_t output_height = op->output_height;
+    const size_t output_width = op->output_width;
+    const struct dw_indirection_layout layout = get_dw_indirection_layout(op, output_width);
 
-static void compute_q8dw(
-    const struct q8dw_context context[restrict static 1],
-    size_t image,
-    size_t output_y)
-{
-  const size_t output_height = context->output_height;
+    if (op->type == qnnp_operator_type_max_pooling) {
+      const size_t channel_tile =
+        compute_channel_tile(channels, qnnp_params.u8maxpool.nr, batch_size * output_height, threads_count);
+      struct max_pooling_context max_pooling_context = {
+          .indirection_buffer = (const uint8_t**) op->im2col_buffer,
+          .indirection_row_stride = layout.row_stride,
+          .indirection_col_stride = layout.col_stride * sizeof(void*),
+          .phases = layout.phases,
+          .kernel_size = kernel_size,
+          .output = op->output,
+          .output_height = output_height,
+          .output_width = output_width,
+          .output_row_stride = output_width * op->output_pixel_stride,
+          .output_pixel_stride = op->output_pixel_stride,
+          .clamping_params = qnnp_compute_u8_clamping_params(op->output_min, op->output_max),
+          .ukernel = qnnp_params.u8maxpool.maxpool,
+      };
+      qnnp_compute_3d_tiled(
+          op, threadpool,
+          (pthreadpool_function_3d_tiled_t) compute_max_pooling,
+          &max_pooling_context,
+          batch_size, output_height, channels,
+          1, 1, channel_tile);
+    } else {
+      const size_t channel_tile =
+        compute_channel_tile(channels, qnnp_params.q8avgpool.nr, batch_size * output_height, threads_count);
+      struct average_pooling_context average_pooling_context = {
+          .indirection_buffer = (const uint8_t**) op->im2col_buffer,
+          .indirection_row_stride = layout.row_stride,
+          .indirection_col_stride = layout.col_stride * sizeof(void*),
+          .phases = layout.phases,
+          .kernel_size = kernel_size,
+          .bias = -(int32_t) kernel_size * (int32_t) (uint32_t) op->input_zero_point,
+          .output = op->output,
+          .output_height = output_height,
+          .output_width = output_width,
+          .output_row_stride = output_width * op->output_pixel_stride,
+          .output_pixel_stride = op->output_pixel_stride,
+          .requantization_params = op->requantization_params,
+          .ukernel = qnnp_params.q8avgpool.avgpool,
+      };
+      qnnp_compute_3d_tiled(
+          op, threadpool,
+          (pthreadpool_function_3d_tiled_t) compute_average_pooling,
+          &average_pooling_context,
+          batch_size, output_height, channels,
+          1, 1, channel_tile);
+    }
+    return qnnp_status_success;
+  } else if (op->type == qnnp_operator_type_channel_shuffle) {
+    const size_t groups = op->groups;
+    struct channel_shuffle_context channel_shuffle_context = {
+        .x = op->input,
+        .x_stride = op->input_pixel_stride,
+        .y = op->output,
+        .y_stride = op->output_pixel_stride,
+        .n = op->group_input_channels,
+        .m = groups,
+    };
+    switch (groups) {
+      case 2:
+        channel_shuffle_context.fixed_ukernel = qnnp_params.x8zip.x2;
+        break;
+      case 3:
+        channel_shuffle_context.fixed_ukernel = qnnp_params.x8zip.x3;
+        break;
+      case 4:
+        channel_shuffle_context.fixed_ukernel = qnnp_params.x8zip.x4;
+        break;
+      default:
+        channel_shuffle_context.variable_ukernel = qnnp_params.x8zip.xm;
+        break;
+    }
+    qnnp_compute_1d(
+        op, threadpool,
+        groups <= 4 ?
+          (pthreadpool_function_1d_t) compute_channel_shuffle_fixed :
+          (pthreadpool_function_1d_t) compute_channel_shuffle_variable,
+        &channel_shuffle_context,
+        op->batch_size);
+    return qnnp_status_success;
+  } else if (op->type == qnnp_operator_type_concat) {
+    struct concat_context concat_context = {
+        .inputs = op->concat_inputs,
+        .output = op->output,
+        .output_stride = op->output_pixel_stride,
+        .ukernel = qnnp_params.q8vrescale,
+    };
+    qnnp_compute_2d(
+        op, threadpool,
+        (pthreadpool_function_2d_t) compute_concat,
+        &concat_context,
+        op->batch_size, op->concat_inputs_count);
+    return qnnp_status_success;
+  }
 
-  context->ukernel(
-    context->groups,
-    context->output_width,
-    context->im2col_buffer + (image * output_height + output_y) * context->im2col_row_stride,
-    context->packed_kernel,
-    context->output + (image * output_height + output_y) * context->output_row_stride,
-    context->im2col_col_stride,
-    context->output_col_increment,
-    context->input_zero_point,
-    context->kernel_zero_point,
-    &context->requantization_params);
-}
+  if (op->packed_weights != NULL) {
+    const uint64_t packing_start = qnnp_profile_start();
+    const enum qnnp_status status = qnnp_ensure_packed_weights(op, threadpool);
+    if (status != qnnp_status_success) {
+      return status;
+    }
+    qnnp_profile_phase(op, qnnp_profiling_phase_packing, packing_start);
+  }
 
-enum qnnp_status qnnp_run_operator(qnnp_operator_t op, pthreadpool_t threadpool)
-{
-  if (op->flags & QNNP_CONVOLUTION_FLAG_DW) {
+  if (op->format == qnnp_format_float32) {
+    const size_t batch_size = op->batch_size;
+    const size_t groups = op->groups;
+    const uint32_t mr = op->sconv.mr;
+    const uint32_t nr = op->sconv.nr;
+    const size_t n_stride = (op->group_output_channels + (nr - 1)) & -nr;
+    const size_t output_size = op->output_height * op->output_width;
+    if (op->flags & QNNP_CONVOLUTION_FLAG_GEMM) {
+      struct sgemm_context sgemm_context = {
+          .k = op->group_input_channels,
+          .n = op->group_output_channels,
+          .n_stride = n_stride,
+          .a = op->input,
+          .a_stride = op->input_pixel_stride,
+          .packed_b = op->packed_kernel,
+          .bias = op->bias,
+          .c = op->output,
+          .c_stride = op->output_pixel_stride,
+          .clamping_params = op->fp32_clamping_params,
+          .ukernel = op->sconv.gemm,
+      };
+      compute_gemm_4d_tiled(
+          op, threadpool,
+          (pthreadpool_function_4d_tiled_t) compute_sgemm,
+          &sgemm_context,
+          groups, batch_size * output_size, output_size, op->group_output_channels,
+          1, output_size, mr, nr);
+    } else {
+      struct sconv_context sconv_context = {
+          .bs = batch_size,
+          .ks = op->kernel_height * op->kernel_width,
+          .kc = op->group_input_channels,
+          .m = output_size,
+          .m_stride = round_up(output_size, mr),
+          .n = op->group_output_channels,
+          .n_stride = n_stride,
+          .indirect_a = (const float**) op->im2col_buffer,
+          .packed_b = op->packed_kernel,
+          .bias = op->bias,
+          .c = op->output,
+          .c_stride = op->output_pixel_stride,
+          .clamping_params = op->fp32_clamping_params,
+          .ukernel = op->sconv.conv,
+      };
+      compute_gemm_4d_tiled(
+          op, threadpool,
+          (pthreadpool_function_4d_tiled_t) compute_sconv,
+          &sconv_context,
+          groups, batch_size, output_size, op->group_output_channels,
+          1, 1, mr, nr);
+    }
+  } else if (op->format == qnnp_format_float16) {
+    const size_t batch_size = op->batch_size;
+    const size_t groups = op->groups;
+    const uint32_t mr = op->hconv.mr;
+    const uint32_t nr = op->hconv.nr;
+    const size_t n_stride = (op->group_output_channels + (nr - 1)) & -nr;
+    const size_t output_size = op->output_height * op->output_width;
+    if (op->flags & QNNP_CONVOLUTION_FLAG_GEMM) {
+      struct hgemm_context hgemm_context = {
+          .k = op->group_input_channels,
+          .n = op->group_output_channels,
+          .n_stride = n_stride,
+          .a = op->input,
+          .a_stride = op->input_pixel_stride,
+          .packed_b = op->packed_kernel,
+          .bias = op->bias,
+          .c = op->output,
+          .c_stride = op->output_pixel_stride,
+          .clamping_params = op->fp16_clamping_params,
+          .ukernel = op->hconv.gemm,
+      };
+      compute_gemm_4d_tiled(
+          op, threadpool,
+          (pthreadpool_function_4d_tiled_t) compute_hgemm,
+          &hgemm_context,
+          groups, batch_size * output_size, output_size, op->group_output_channels,
+          1, output_size, mr, nr);
+    } else {
+      struct hconv_context hconv_context = {
+          .bs = batch_size,
+          .ks = op->kernel_height * op->kernel_width,
+          .kc = op->group_input_channels,
+          .m = output_size,
+          .m_stride = round_up(output_size, mr),
+          .n = op->group_output_channels,
+          .n_stride = n_stride,
+          .indirect_a = (const void**) op->im2col_buffer,
+          .packed_b = op->packed_kernel,
+          .bias = op->bias,
+          .c = op->output,
+          .c_stride = op->output_pixel_stride,
+          .clamping_params = op->fp16_clamping_params,
+          .ukernel = op->hconv.conv,
+      };
+      compute_gemm_4d_tiled(
+          op, threadpool,
+          (pthreadpool_function_4d_tiled_t) compute_hconv,
+          &hconv_context,
+          groups, batch_size, output_size, op->group_output_channels,
+          1, 1, mr, nr);
+    }
+  } else if (op->flags & QNNP_CONVOLUTION_FLAG_DW) {
     const size_t batch_size = op->batch_size;
     const size_t groups = op->groups;
     const size_t kernel_height = op->kernel_height;
     const size_t kernel_width = op->kernel_width;
     const size_t kernel_size = kernel_height * kernel_width;
-    const size_t subsampling_width = op->stride_width;
     const size_t output_height = op->output_height;
     const size_t output_width = op->output_width;
+    const struct dw_indirection_layout layout = get_dw_indirection_layout(op, output_width);
+    const size_t channels = groups * op->group_output_channels;
+    const struct q8dw_parameters* q8dw_params = kernel_size == 9 ? &qnnp_params.q8dw9 : &qnnp_params.q8dw25;
+
+    /*
+     * Rows of the output are the natural unit of parallelism, but with small batch and spatial size (e.g. 7x7 in
+     * late MobileNet layers) there are too few of them to occupy all threads. In this case split channels into
+     * cr-aligned tiles, so every (image, row, channel tile) triple becomes a parallel task.
+     */
+    const size_t channel_tile =
+      compute_channel_tile(channels, q8dw_params->cr, batch_size * output_height, threads_count);
+
+    if (qnnp_convolution_expands_input(op)) {
+      struct channel_expansion_context channel_expansion_context = {
+          .channels = groups,
+          .multiplier = op->group_output_channels,
+          .input_height = op->input_height,
+          .input_width = op->input_width,
+          .input = op->input,
+          .input_image_stride = op->input_image_stride,
+          .input_row_stride = op->input_row_stride,
+          .input_pixel_stride = op->input_pixel_stride,
+          .output = (uint8_t*) op->expanded_input + 8,
+      };
+      qnnp_compute_1d(
+          op, threadpool,
+          (pthreadpool_function_1d_t) compute_channel_expansion,
+          &channel_expansion_context,
+          batch_size * op->input_height);
+    }
 
     struct q8dw_context q8dw_context = {
-        .groups = groups,
+        .channels = channels,
+        .kernel_size = kernel_size,
         .im2col_buffer = (const uint8_t**) op->im2col_buffer,
-        .im2col_row_stride = kernel_size + (output_width * subsampling_width - 1) * kernel_height,
-        .im2col_col_stride = kernel_height * subsampling_width * sizeof(void*),
+        .im2col_row_stride = layout.row_stride,
+        .im2col_col_stride = layout.col_stride * sizeof(void*),
+        .phases = layout.phases,
         .packed_kernel = op->packed_kernel,
+        .packed_kernel_channel_stride = kernel_size * sizeof(uint8_t) + sizeof(int32_t),
         .bias = op->bias,
         .output = op->output,
         .output_height = output_height,
         .output_width = output_width,
         .output_row_stride = output_width * op->output_pixel_stride,
-        .output_col_increment = (op->output_pixel_stride - groups) * sizeof(uint8_t),
+        .output_pixel_stride = op->output_pixel_stride,
         .input_zero_point = op->input_zero_point,
         .kernel_zero_point = op->kernel_zero_point,
         .requantization_params = op->requantization_params,
-        .ukernel = qnnp_params.q8dw9.dw,
+        .lookup_table = op->lookup_table,
+        .ukernel = q8dw_params->dw,
+        .multiplier = op->group_output_channels,
+        .multiplier_ukernel = qnnp_get_q8dw_multiplier_ukernel(op),
     };
-    pthreadpool_compute_2d(
-        threadpool,
-        (pthreadpool_function_2d_t) compute_q8dw,
+    qnnp_compute_3d_tiled(
+        op, threadpool,
+        (pthreadpool_function_3d_tiled_t) compute_q8dw,
         &q8dw_context,
-        batch_size, output_height);
+        batch_size, output_height, channels,
+        1, 1, channel_tile);
+  } else if (op->flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) {
+    run_q8winograd(op, 0, op->output_height, threadpool);
+  } else if (op->flags & QNNP_CONVOLUTION_FLAG_STEM) {
+    run_q8conv_stem(op, 0, op->output_height, threadpool);
   } else if (op->flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
     const size_t batch_size = op->batch_size;
     const size_t groups = op->groups;
@@ -857,65 +4853,168 @@ enum qnnp_status qnnp_run_operator(qnnp_operator_t op, pthreadpool_t threadpool)
     const uint32_t mr = qnnp_params.q8conv_xzp.mr;
     const uint32_t nr = qnnp_params.q8conv_xzp.nr;
     const uint32_t kr = qnnp_params.q8conv_xzp.kr;
-    const size_t k_stride = (group_input_channels + (kr - 1)) & -kr;
+    const size_t k_stride = qnnp_get_packed_channel_stride(1, group_input_channels, nr, kr);
     const size_t n_stride = (group_output_channels + (nr - 1)) & -nr;
 
-    /* compute input row sum */
     const size_t input_size = op->input_height * op->input_width;
-    int32_t* a_sum = (int32_t*) op->a_sum;
-    q8gemm_compute_row_sum(
-        op->input,
-        batch_size,
-        groups,
-        input_size, /* m */
-        group_input_channels, /* k */
-        op->input_pixel_stride, /* input stride */
-        -op->kernel_zero_point, /* multiplier */
-        a_sum,
-        input_size,
-        threadpool);
+    const size_t panel_channels = compute_xzp_panel_channels(
+      op, threadpool, groups * batch_size * divide_round_up(input_size, mr), group_output_channels, nr);
     struct q8gemm_xzp_context q8gemm_xzp_context = {
         .k = group_input_channels,
         .k_stride = k_stride,
         .n = group_output_channels,
         .n_stride = n_stride,
+        .nr = nr,
         .a = op->input,
         .a_stride = op->input_pixel_stride,
         .packed_b = op->packed_kernel,
         .bias = op->bias,
         .c = op->output,
         .c_stride = op->output_pixel_stride,
-        .a_sum = a_sum,
-        .groups = op->groups,
-        .batch_size = batch_size,
-        .a_sum_stride = input_size,
+        .a_sum_multiplier = -(int32_t) op->kernel_zero_point,
         .requantization_params = op->requantization_params,
+        .lookup_table = op->lookup_table,
         .ukernel = qnnp_params.q8conv_xzp.gemm,
+        .sum_rows_ukernel = qnnp_params.q8sum_rows.sum_rows,
     };
-    pthreadpool_compute_4d_tiled(
-        threadpool,
+    compute_gemm_4d_tiled(
+        op, threadpool,
         (pthreadpool_function_4d_tiled_t) compute_q8gemm_xzp,
         &q8gemm_xzp_context,
         groups, batch_size * input_size, input_size, group_output_channels,
-        1, input_size, mr, nr);
+        1, input_size, mr, panel_channels);
   } else {
     const size_t batch_size = op->batch_size;
     const size_t groups = op->groups;
     const size_t group_input_channels = op->group_input_channels;
     const size_t group_output_channels = op->group_output_channels;
-    const uint32_t mr = qnnp_params.q8conv.mr;
-    const uint32_t nr = qnnp_params.q8conv.nr;
-    const uint32_t kr = qnnp_params.q8conv.kr;
+    const uint32_t mr = op->q8conv.mr;
+    const uint32_t nr = op->q8conv.nr;
+    const uint32_t kr = op->q8conv.kr;
     const size_t k_stride = (group_input_channels + (kr - 1)) & -kr;
     const size_t n_stride = (group_output_channels + (nr - 1)) & -nr;
 
     const size_t output_size = op->output_height * op->output_width;
-    if (op->flags & QNNP_CONVOLUTION_FLAG_GEMM) {
+    /* Fully-connected operator with feature-major outputs, see QNNP_CONVOLUTION_FLAG_TRANSPOSED_OUTPUT */
+    const bool transposed_output = (op->flags & QNNP_CONVOLUTION_FLAG_TRANSPOSED_OUTPUT) != 0;
+    if (op->accumulator_output != qnnp_accumulator_output_none) {
+      /* Fully-connected operator with int32 or float outputs, see qnnp_setup_fully_connected_nc_q8_s32 */
+      struct q8gemm_accumulator_context q8gemm_accumulator_context = {
+          .k = group_input_channels,
+          .k_stride = qnnp_get_packed_channel_stride(1, group_input_channels, nr, kr),
+          .nr = nr,
+          .a = op->input,
+          .a_stride = op->input_pixel_stride,
+          .packed_b = op->packed_kernel,
+          .bias = op->bias,
+          .c = op->output,
+          .c_stride = transposed_output ? 1 : op->output_pixel_stride,
+          .c_channel_stride = transposed_output ? op->output_pixel_stride : 1,
+          .a_zero_point = op->input_zero_point,
+          .b_zero_point = op->kernel_zero_point,
+          .accumulator_output = op->accumulator_output,
+          .accumulator_scale = op->accumulator_scale,
+          .ukernel = op->q8conv.gemv_acc32,
+      };
+      qnnp_compute_2d_tiled(
+          op, threadpool,
+          (pthreadpool_function_2d_tiled_t) compute_q8gemm_accumulators,
+          &q8gemm_accumulator_context,
+          output_size, group_output_channels,
+          1, compute_channel_tile(group_output_channels, nr, output_size, threads_count));
+    } else if (op->split_k_slice != 0) {
+      /* Fully-connected operator with K split across threads by setup, see compute_split_k_slice */
+      const size_t k_slice = op->split_k_slice;
+      const size_t slices = divide_round_up(group_input_channels, k_slice);
+      struct q8gemm_split_k_context q8gemm_split_k_context = {
+          .k = group_input_channels,
+          .k_slice = k_slice,
+          .k_stride = qnnp_get_packed_channel_stride(1, group_input_channels, nr, kr),
+          .m = output_size,
+          .n = group_output_channels,
+          .nr = nr,
+          .a = op->input,
+          .a_stride = op->input_pixel_stride,
+          .packed_b = op->packed_kernel,
+          .partial_sums = op->split_k_buffer,
+          .a_zero_point = op->input_zero_point,
+          .b_zero_point = op->kernel_zero_point,
+          .ukernel = op->q8conv.gemv_acc32,
+      };
+      qnnp_compute_3d_tiled(
+          op, threadpool,
+          (pthreadpool_function_3d_tiled_t) compute_q8gemm_split_k,
+          &q8gemm_split_k_context,
+          slices, output_size, group_output_channels,
+          1, 1, nr);
+
+      struct q8gemm_split_k_reduction_context q8gemm_split_k_reduction_context = {
+          .slices = slices,
+          .m = output_size,
+          .n = group_output_channels,
+          .partial_sums = op->split_k_buffer,
+          .bias = op->bias,
+          .c = op->output,
+          .c_stride = transposed_output ? 1 : op->output_pixel_stride,
+          .c_channel_stride = transposed_output ? op->output_pixel_stride : 1,
+          .scalar_requantization_params = qnnp_compute_scalar_requantization_params(
+            op->requantization_scale, op->output_zero_point, op->output_min, op->output_max),
+          .fp32_requantization = (op->flags & QNNP_CONVOLUTION_FLAG_FP32_REQUANTIZATION) != 0,
+          .lookup_table = op->lookup_table,
+      };
+      qnnp_compute_2d_tiled(
+          op, threadpool,
+          (pthreadpool_function_2d_tiled_t) compute_q8gemm_split_k_reduction,
+          &q8gemm_split_k_reduction_context,
+          output_size, group_output_channels,
+          1, compute_channel_tile(group_output_channels, nr, output_size, threads_count));
+    } else if (op->flags & QNNP_CONVOLUTION_FLAG_SPARSE) {
+      /* The blocks of all output channels follow their offsets, see pack_q8gemm_sparse_w */
+      const uint32_t* row_ptr = op->packed_kernel;
+      const uint32_t* block_channels = row_ptr + n_stride + 1;
+      struct q8gemm_sparse_context q8gemm_sparse_context = {
+          .a = op->input,
+          .a_stride = op->input_pixel_stride,
+          .row_ptr = row_ptr,
+          .block_channels = block_channels,
+          .values = (const uint8_t*) (block_channels + row_ptr[n_stride]),
+          .bias = op->bias,
+          .c = op->output,
+          .c_stride = op->output_pixel_stride,
+          .a_zero_point = op->input_zero_point,
+          .b_zero_point = op->kernel_zero_point,
+          .requantization_params = op->requantization_params,
+          .lookup_table = op->lookup_table,
+          .ukernel = qnnp_params.q8gemm_sparse.gemm,
+          .nr = nr,
+          .transposed_c = transposed_output,
+      };
+      qnnp_compute_2d_tiled(
+          op, threadpool,
+          (pthreadpool_function_2d_tiled_t) compute_q8gemm_sparse,
+          &q8gemm_sparse_context,
+          batch_size * output_size, group_output_channels,
+          mr, nr);
+    } else if (op->flags & QNNP_CONVOLUTION_FLAG_GEMM) {
+      /*
+       * With only a few rows, e.g. a fully-connected operator on a small batch, most multiply-adds of the GEMM
+       * microkernel would compute duplicates of the last row. The single-row microkernel reads the packed kernel
+       * once per row instead, which is only cheaper while the rows fill at most a quarter of the GEMM tile.
+       */
+      struct q8conv_parameters q8conv = op->q8conv;
+      size_t gemm_mr = mr;
+      if (q8conv.gemv != NULL && 4 * output_size <= mr) {
+        q8conv.gemm = q8conv.gemv;
+        gemm_mr = 1;
+      }
       struct q8gemm_context q8gemm_context = {
           .k = group_input_channels,
-          .k_stride = k_stride,
+          .k_stride = (op->flags & QNNP_CONVOLUTION_FLAG_4BIT) ?
+            qnnp_get_4bit_packed_channel_stride(group_input_channels, nr, kr) :
+            qnnp_get_packed_channel_stride(1, group_input_channels, nr, kr),
           .n = group_output_channels,
           .n_stride = n_stride,
+          .nr = nr,
           .a = op->input,
           .a_stride = op->input_pixel_stride,
           .packed_b = op->packed_kernel,
@@ -925,44 +5024,663 @@ enum qnnp_status qnnp_run_operator(qnnp_operator_t op, pthreadpool_t threadpool)
           .a_zero_point = op->input_zero_point,
           .b_zero_point = op->kernel_zero_point,
           .requantization_params = op->requantization_params,
-          .ukernel = qnnp_params.q8conv.gemm,
+          .lookup_table = op->lookup_table,
+          .ukernels = qnnp_get_q8conv_uarch_ukernels(&q8conv),
+          .transposed_c = transposed_output,
       };
 
-      pthreadpool_compute_4d_tiled(
-          threadpool,
-          (pthreadpool_function_4d_tiled_t) compute_q8gemm,
-          &q8gemm_context,
-          groups, batch_size * output_size, output_size, group_output_channels,
-          1, output_size, mr, nr);
-    } else {
+      /*
+       * The microkernels requantize after the whole K, so K can not be blocked; instead, when the packed kernel of a
+       * group overflows half of L2, output channels are split into panels that fit, and each panel is reused by all
+       * M tiles before moving on to the next. The other half of L2 is left for the rows of A and C.
+       */
+      const size_t m = batch_size * output_size;
+      const size_t nc = max(qnnp_params.l2_cache_size / 2 / k_stride / nr, 1) * nr;
+      if (nc < group_output_channels && m > gemm_mr) {
+        qnnp_compute_3d_tiled(
+            op, threadpool,
+            (pthreadpool_function_3d_tiled_t) compute_q8gemm_nc_panel,
+            &q8gemm_context,
+            groups, group_output_channels, m,
+            1, nc, gemm_mr);
+      } else {
+        compute_gemm_4d_tiled(
+            op, threadpool,
+            (pthreadpool_function_4d_tiled_t) compute_q8gemm,
+            &q8gemm_context,
+            groups, batch_size * output_size, output_size, group_output_channels,
+            1, output_size, gemm_mr, nr);
+      }
+    } else if (op->flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL) {
+      /*
+       * Output pixels (y, x) with the same (y + input_padding_top) and (x + input_padding_left) modulo the stride form a
+       * phase, which only the taps with the same dilated offsets modulo the stride reach. Each phase is a dense
+       * convolution with the consecutive slice of the packed kernel that holds its taps.
+       */
       const size_t kernel_size = op->kernel_height * op->kernel_width;
+      const size_t stride_height = op->stride_height;
+      const size_t stride_width = op->stride_width;
+      size_t phase_tap_start = 0;
+      for (size_t residue_y = 0; residue_y < stride_height; residue_y++) {
+        const size_t taps_y = qnnp_subpixel_phase_taps(op->kernel_height, op->dilation_height, stride_height, residue_y);
+        const size_t output_y_start = (residue_y + stride_height - op->input_padding_top % stride_height) % stride_height;
+        const size_t phase_height = divide_round_up(doz(op->output_height, output_y_start), stride_height);
+        for (size_t residue_x = 0; residue_x < stride_width; residue_x++) {
+          const size_t taps_x = qnnp_subpixel_phase_taps(op->kernel_width, op->dilation_width, stride_width, residue_x);
+          const size_t output_x_start = (residue_x + stride_width - op->input_padding_left % stride_width) % stride_width;
+          const size_t phase_width = divide_round_up(doz(op->output_width, output_x_start), stride_width);
+          const size_t phase_taps = taps_y * taps_x;
+          if (phase_height != 0 && phase_width != 0) {
+            struct q8deconv_subpixel_context q8deconv_subpixel_context = {
+                .ks = phase_taps,
+                .residue_y = residue_y,
+                .residue_x = residue_x,
+                .output_y_start = output_y_start,
+                .output_x_start = output_x_start,
+                .phase_width = phase_width,
+                .phase_height_divisor = fxdiv_init_size_t(phase_height),
+                .kc = group_input_channels,
+                .kc_stride = qnnp_get_packed_channel_stride(kernel_size, group_input_channels, nr, kr),
+                .n = group_output_channels,
+                .n_stride = n_stride,
+                .mr = mr,
+                .a = op->input,
+                .a_pixel_stride = op->input_pixel_stride,
+                .zero = (const uint8_t*) ((uintptr_t) op->zero + (op->group_input_channels < 8 ? 8 : 0)),
+                .input_height = op->input_height,
+                .input_width = op->input_width,
+                .output_height = op->output_height,
+                .output_width = op->output_width,
+                .kernel_height = op->kernel_height,
+                .kernel_width = op->kernel_width,
+                .stride_height = stride_height,
+                .stride_width = stride_width,
+                .dilation_height = op->dilation_height,
+                .dilation_width = op->dilation_width,
+                .input_padding_top = op->input_padding_top,
+                .input_padding_left = op->input_padding_left,
+                .packed_b = (const uint8_t*) op->packed_kernel + phase_tap_start * nr * k_stride,
+                .bias = (const int32_t*) op->bias,
+                .c = op->output,
+                .c_pixel_stride = op->output_pixel_stride,
+                .a_zero_point = op->input_zero_point,
+                .b_zero_point = op->kernel_zero_point,
+                .requantization_params = op->requantization_params,
+                .lookup_table = op->lookup_table,
+                .ukernels = qnnp_get_q8conv_uarch_ukernels(&op->q8conv),
+            };
+            compute_gemm_4d_tiled(
+                op, threadpool,
+                (pthreadpool_function_4d_tiled_t) compute_q8deconv_subpixel,
+                &q8deconv_subpixel_context,
+                groups, batch_size * phase_height, phase_width, group_output_channels,
+                1, 1, mr, nr);
+          }
+          phase_tap_start += phase_taps;
+        }
+      }
+    } else {
+      /* Taps of NCHW convolutions read a single channel, see qnnp_convolution_get_taps */
+      const size_t taps = qnnp_convolution_get_taps(op);
+      const size_t tap_channels = qnnp_convolution_get_tap_channels(op);
       const size_t m_stride = round_up(output_size, mr);
       struct q8conv_context q8conv_context = {
           .bs = batch_size,
-          .ks = kernel_size,
-          .kc = group_input_channels,
-          .kc_stride = k_stride * kernel_size,
+          .ks = taps,
+          .kc = tap_channels,
+          .kc_stride = qnnp_get_packed_channel_stride(taps, tap_channels, nr, kr),
           .m = output_size,
           .m_stride = m_stride,
           .n = group_output_channels,
           .n_stride = n_stride,
           .im2col_a = (const uint8_t**) op->im2col_buffer,
+          .indirection_offsets = (const uint32_t*) op->im2col_buffer,
+          .mr = mr,
+          .a = op->input,
+          .a_pixel_stride = op->input_pixel_stride,
+          .zero = (const uint8_t*) ((uintptr_t) op->zero + (tap_channels < 8 ? 8 : 0)),
+          .input_height = op->input_height,
+          .input_width = op->input_width,
+          .output_width_divisor = fxdiv_init_size_t(op->output_width),
+          .kernel_height = op->kernel_height,
+          .kernel_width = op->kernel_width,
+          .stride_height = op->stride_height,
+          .stride_width = op->stride_width,
+          .dilation_height = op->dilation_height,
+          .dilation_width = op->dilation_width,
+          .input_padding_top = op->input_padding_top,
+          .input_padding_left = op->input_padding_left,
+          .m_start = 0,
+          .m_end = output_size,
           .packed_b = op->packed_kernel,
           .bias = (const int32_t*) op->bias,
+          .bias_stride = op->flags & QNNP_CONVOLUTION_FLAG_PER_CHANNEL ? 2 : 1,
+          .tap_stride = get_q8conv_tap_stride(op),
           .c = op->output,
           .c_stride = op->output_pixel_stride,
           .a_zero_point = op->input_zero_point,
           .b_zero_point = op->kernel_zero_point,
           .requantization_params = op->requantization_params,
-          .ukernel = qnnp_params.q8conv.conv,
+          .lookup_table = op->lookup_table,
+          .ukernels = qnnp_get_q8conv_uarch_ukernels(&op->q8conv),
+          .xzp_ukernel = op->flags & QNNP_CONVOLUTION_FLAG_XZP_CONV ? op->q8conv.xzp_conv : NULL,
+          .sum_rows_ukernel = qnnp_params.q8sum_rows.conv_sum_rows,
+          .nr = nr,
+          .a_sum_multiplier = -(int32_t) op->kernel_zero_point,
       };
 
-      pthreadpool_compute_4d_tiled(
-          threadpool,
-          (pthreadpool_function_4d_tiled_t) compute_q8conv,
+      pthreadpool_function_4d_tiled_t compute = (pthreadpool_function_4d_tiled_t) compute_q8conv;
+      if (op->tile_indirection) {
+        compute = op->type == qnnp_operator_type_deconvolution ?
+          (pthreadpool_function_4d_tiled_t) compute_q8deconv_with_tile_indirection :
+          (pthreadpool_function_4d_tiled_t) compute_q8conv_with_tile_indirection;
+      } else if (op->indirection_offsets) {
+        compute = (pthreadpool_function_4d_tiled_t) compute_q8conv_with_offsets;
+      }
+      compute_gemm_4d_tiled(
+          op, threadpool,
+          compute,
           &q8conv_context,
           groups, batch_size, output_size, group_output_channels,
-          1, 1, mr, nr);
+          1, 1, mr,
+          get_q8conv_task_channels(
+            op, threadpool, groups * batch_size * divide_round_up(output_size, mr), group_output_channels, nr));
+    }
+  }
+  return qnnp_status_success;
+}
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * UINT64_C(1000000000) + (uint64_t) ts.tv_nsec;
+}
+
+/* Swaps the packed weights and microkernels of a convolution with those of the other 1x1 GEMM path */
+static void swap_gemm_path(struct qnnp_operator* a, struct qnnp_operator* b) {
+  const uint32_t flags = a->flags;
+  const struct q8conv_parameters q8conv = a->q8conv;
+  void* packed_kernel = a->packed_kernel;
+  void* bias = a->bias;
+  struct qnnp_packed_weights* packed_weights = a->packed_weights;
+  /* Only the GEMM path merges groups, see QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS */
+  const uint32_t groups = a->groups;
+  const size_t group_input_channels = a->group_input_channels;
+  const size_t group_output_channels = a->group_output_channels;
+  a->flags = b->flags;
+  a->q8conv = b->q8conv;
+  a->packed_kernel = b->packed_kernel;
+  a->bias = b->bias;
+  a->packed_weights = b->packed_weights;
+  a->groups = b->groups;
+  a->group_input_channels = b->group_input_channels;
+  a->group_output_channels = b->group_output_channels;
+  b->flags = flags;
+  b->q8conv = q8conv;
+  b->packed_kernel = packed_kernel;
+  b->bias = bias;
+  b->packed_weights = packed_weights;
+  b->groups = groups;
+  b->group_input_channels = group_input_channels;
+  b->group_output_channels = group_output_channels;
+}
+
+/*
+ * Runs a convolution created with QNNP_CREATE_FLAG_CALIBRATE_XZP on its own path or, every other run, on the
+ * alternative, which takes its setup for the run. Once both have run QNNP_XZP_CALIBRATION_RUNS times, the operator
+ * keeps the path with the fastest run per output pixel and deletes the other one with its packed weights.
+ */
+static enum qnnp_status run_xzp_calibration(qnnp_operator_t op, pthreadpool_t threadpool)
+{
+  struct qnnp_xzp_calibration* calibration = op->xzp_calibration;
+  struct qnnp_operator* alternative = calibration->alternative;
+  const size_t path = (calibration->runs[0] + calibration->runs[1]) % 2;
+  struct qnnp_operator* target = op;
+  if (path == 1) {
+    alternative->batch_size = op->batch_size;
+    alternative->input_height = op->input_height;
+    alternative->input_width = op->input_width;
+    alternative->input = op->input;
+    alternative->input_pixel_stride = op->input_pixel_stride;
+    alternative->input_row_stride = op->input_row_stride;
+    alternative->input_image_stride = op->input_image_stride;
+    alternative->output_height = op->output_height;
+    alternative->output_width = op->output_width;
+    alternative->output = op->output;
+    alternative->output_pixel_stride = op->output_pixel_stride;
+    alternative->lookup_table = op->lookup_table;
+    alternative->scheduler = op->scheduler;
+    target = alternative;
+  }
+  const uint64_t start = now_ns();
+  const enum qnnp_status status = run_operator(target, threadpool);
+  const uint64_t elapsed_ns = now_ns() - start;
+  /* The lookup table stays owned by the operator */
+  alternative->lookup_table = NULL;
+  if (status != qnnp_status_success) {
+    return status;
+  }
+
+  /* Setups between runs may change the shape, so runs compare by time per output pixel, and the first packs lazily */
+  const uint64_t pixels = (uint64_t) op->batch_size * (uint64_t) op->output_height * (uint64_t) op->output_width;
+  const uint64_t ps_per_pixel = elapsed_ns * UINT64_C(1000) / max(pixels, 1);
+  if (calibration->runs[path] == 0 || ps_per_pixel < calibration->fastest_ps_per_pixel[path]) {
+    calibration->fastest_ps_per_pixel[path] = ps_per_pixel;
+  }
+  calibration->runs[path] += 1;
+
+  if (calibration->runs[0] >= QNNP_XZP_CALIBRATION_RUNS && calibration->runs[1] >= QNNP_XZP_CALIBRATION_RUNS) {
+    if (calibration->fastest_ps_per_pixel[1] < calibration->fastest_ps_per_pixel[0]) {
+      swap_gemm_path(op, alternative);
+    }
+    qnnp_delete_operator(alternative);
+    free(calibration);
+    op->xzp_calibration = NULL;
+  }
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_run_operator(qnnp_operator_t op, pthreadpool_t threadpool)
+{
+  const uint64_t run_start = qnnp_profile_start();
+  const enum qnnp_status status = op->xzp_calibration != NULL ?
+    run_xzp_calibration(op, threadpool) : run_operator(op, threadpool);
+  if (status == qnnp_status_success) {
+    qnnp_profile_phase(op, qnnp_profiling_phase_run, run_start);
+  }
+  return status;
+}
+
+static enum qnnp_status check_convolution_rows(
+    const struct qnnp_operator* convolution,
+    size_t output_y_start,
+    size_t output_rows)
+{
+  if (convolution->type != qnnp_operator_type_convolution) {
+    qnnp_log_error("failed to run output rows of operator: operator is not a convolution");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (convolution->batch_size == 0) {
+    qnnp_log_error("failed to run output rows of convolution: convolution is not set up");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (convolution->roi_count != 0) {
+    qnnp_log_error("failed to run output rows of convolution: convolution is set up with ROIs");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (output_rows == 0 || output_y_start + output_rows > convolution->output_height) {
+    qnnp_log_error(
+      "failed to run %zu output rows starting at row %zu of convolution with %zu output rows: "
+      "rows must be non-empty and within the output",
+      output_rows, output_y_start, convolution->output_height);
+    return qnnp_status_invalid_parameter;
+  }
+
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_get_convolution2d_nhwc_q8_input_rows(
+    qnnp_operator_t convolution,
+    size_t output_y_start,
+    size_t output_rows,
+    size_t* input_y_start,
+    size_t* input_rows)
+{
+  const enum qnnp_status status = check_convolution_rows(convolution, output_y_start, output_rows);
+  if (status != qnnp_status_success) {
+    return status;
+  }
+
+  size_t input_y_end;
+  compute_convolution_input_rows(convolution, output_y_start, output_rows, input_y_start, &input_y_end);
+  *input_rows = input_y_end - *input_y_start;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_run_convolution2d_nhwc_q8_rows(
+    qnnp_operator_t convolution,
+    size_t output_y_start,
+    size_t output_rows,
+    pthreadpool_t threadpool)
+{
+  enum qnnp_status status = check_convolution_rows(convolution, output_y_start, output_rows);
+  if (status != qnnp_status_success) {
+    return status;
+  }
+
+  if (convolution->flags & QNNP_CONVOLUTION_FLAG_NCHW) {
+    qnnp_log_error("failed to run output rows of convolution: rows of NCHW input are not contiguous across channels");
+    return qnnp_status_unsupported_parameter;
+  }
+
+  if (convolution->flags & QNNP_CONVOLUTION_FLAG_SPARSE) {
+    qnnp_log_error("failed to run output rows of convolution: block-sparse kernels are only supported by whole runs");
+    return qnnp_status_unsupported_parameter;
+  }
+
+  if (!(convolution->flags & (QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_DW | QNNP_CONVOLUTION_FLAG_XZP_GEMM |
+        QNNP_CONVOLUTION_FLAG_WINOGRAD | QNNP_CONVOLUTION_FLAG_STEM)) &&
+      !qnnp_supports_tile_indirection(convolution))
+  {
+    qnnp_log_error(
+      "failed to run output rows of convolution with %" PRIu32 "x%" PRIu32 " kernel: "
+      "kernel is too large to compute input pointers per tile",
+      convolution->kernel_width, convolution->kernel_height);
+    return qnnp_status_unsupported_parameter;
+  }
+
+  if (convolution->packed_weights != NULL) {
+    status = qnnp_ensure_packed_weights(convolution, threadpool);
+    if (status != qnnp_status_success) {
+      return status;
+    }
+  }
+
+  const size_t batch_size = convolution->batch_size;
+  const size_t groups = convolution->groups;
+  const size_t group_input_channels = convolution->group_input_channels;
+  const size_t group_output_channels = convolution->group_output_channels;
+  const size_t input_height = convolution->input_height;
+  const size_t input_width = convolution->input_width;
+  const size_t input_pixel_stride = convolution->input_pixel_stride;
+  const size_t output_height = convolution->output_height;
+  const size_t output_width = convolution->output_width;
+  const size_t output_pixel_stride = convolution->output_pixel_stride;
+  const size_t kernel_size = convolution->kernel_height * convolution->kernel_width;
+
+  if (convolution->flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) {
+    run_q8winograd(convolution, output_y_start, output_rows, threadpool);
+  } else if (convolution->flags & QNNP_CONVOLUTION_FLAG_STEM) {
+    run_q8conv_stem(convolution, output_y_start, output_rows, threadpool);
+  } else if (convolution->flags & QNNP_CONVOLUTION_FLAG_DW) {
+    const struct dw_indirection_layout layout = get_dw_indirection_layout(convolution, output_width);
+    const size_t channels = groups * group_output_channels;
+    const struct q8dw_parameters* q8dw_params = kernel_size == 9 ? &qnnp_params.q8dw9 : &qnnp_params.q8dw25;
+
+    if (qnnp_convolution_expands_input(convolution)) {
+      /* Only the input rows of the band are replicated, the rest of the expanded input may be stale */
+      size_t input_y_start, input_y_end;
+      compute_convolution_input_rows(convolution, output_y_start, output_rows, &input_y_start, &input_y_end);
+      for (size_t image = 0; image < batch_size; image++) {
+        const size_t input_row = image * input_height + input_y_start;
+        struct channel_expansion_context channel_expansion_context = {
+            .channels = groups,
+            .multiplier = group_output_channels,
+            .input_height = input_height,
+            .input_width = input_width,
+            .input = (const uint8_t*) convolution->input +
+              image * convolution->input_image_stride + input_y_start * convolution->input_row_stride,
+            .input_image_stride = convolution->input_image_stride,
+            .input_row_stride = convolution->input_row_stride,
+            .input_pixel_stride = input_pixel_stride,
+            .output = (uint8_t*) convolution->expanded_input + 8 + input_row * input_width * channels,
+        };
+        qnnp_compute_1d(
+            convolution, threadpool,
+            (pthreadpool_function_1d_t) compute_channel_expansion,
+            &channel_expansion_context,
+            input_y_end - input_y_start);
+      }
+    }
+
+    struct q8dw_context q8dw_context = {
+        .channels = channels,
+        .kernel_size = kernel_size,
+        .im2col_buffer = (const uint8_t**) convolution->im2col_buffer + output_y_start * layout.row_stride,
+        .im2col_row_stride = layout.row_stride,
+        .im2col_col_stride = layout.col_stride * sizeof(void*),
+        .phases = layout.phases,
+        .packed_kernel = convolution->packed_kernel,
+        .packed_kernel_channel_stride = kernel_size * sizeof(uint8_t) + sizeof(int32_t),
+        .bias = convolution->bias,
+        .output = (uint8_t*) convolution->output + output_y_start * output_width * output_pixel_stride,
+        .output_height = output_height,
+        .output_width = output_width,
+        .output_row_stride = output_width * output_pixel_stride,
+        .output_pixel_stride = output_pixel_stride,
+        .input_zero_point = convolution->input_zero_point,
+        .kernel_zero_point = convolution->kernel_zero_point,
+        .requantization_params = convolution->requantization_params,
+        .lookup_table = convolution->lookup_table,
+        .ukernel = q8dw_params->dw,
+        .multiplier = group_output_channels,
+        .multiplier_ukernel = qnnp_get_q8dw_multiplier_ukernel(convolution),
+    };
+    qnnp_compute_3d_tiled(
+        convolution, threadpool,
+        (pthreadpool_function_3d_tiled_t) compute_q8dw,
+        &q8dw_context,
+        batch_size, output_rows, channels,
+        1, 1, channels);
+  } else if (convolution->flags & (QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_XZP_GEMM)) {
+    /* 1x1 convolutions without subsampling map output pixels to the input pixels at the same position */
+    const bool xzp = (convolution->flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) != 0;
+    const uint32_t mr = xzp ? qnnp_params.q8conv_xzp.mr : convolution->q8conv.mr;
+    const uint32_t nr = xzp ? qnnp_params.q8conv_xzp.nr : convolution->q8conv.nr;
+    const uint32_t kr = xzp ? qnnp_params.q8conv_xzp.kr : convolution->q8conv.kr;
+    const size_t k_stride = qnnp_get_packed_channel_stride(1, group_input_channels, nr, kr);
+    const size_t n_stride = (group_output_channels + (nr - 1)) & -nr;
+    const size_t image_size = output_height * output_width;
+    const size_t band_size = output_rows * output_width;
+    for (size_t image = 0; image < batch_size; image++) {
+      const size_t pixel_start = image * image_size + output_y_start * output_width;
+      const uint8_t* a = (const uint8_t*) convolution->input + pixel_start * input_pixel_stride;
+      uint8_t* c = (uint8_t*) convolution->output + pixel_start * output_pixel_stride;
+      if (xzp) {
+        const size_t panel_channels = compute_xzp_panel_channels(
+          convolution, threadpool, groups * divide_round_up(band_size, mr), group_output_channels, nr);
+        struct q8gemm_xzp_context q8gemm_xzp_context = {
+            .k = group_input_channels,
+            .k_stride = k_stride,
+            .n = group_output_channels,
+            .n_stride = n_stride,
+            .nr = nr,
+            .a = a,
+            .a_stride = input_pixel_stride,
+            .packed_b = convolution->packed_kernel,
+            .bias = convolution->bias,
+            .c = c,
+            .c_stride = output_pixel_stride,
+            .a_sum_multiplier = -(int32_t) convolution->kernel_zero_point,
+            .requantization_params = convolution->requantization_params,
+            .lookup_table = convolution->lookup_table,
+            .ukernel = qnnp_params.q8conv_xzp.gemm,
+            .sum_rows_ukernel = qnnp_params.q8sum_rows.sum_rows,
+        };
+        compute_gemm_4d_tiled(
+            convolution, threadpool,
+            (pthreadpool_function_4d_tiled_t) compute_q8gemm_xzp,
+            &q8gemm_xzp_context,
+            groups, band_size, band_size, group_output_channels,
+            1, band_size, mr, panel_channels);
+      } else {
+        struct q8gemm_context q8gemm_context = {
+            .k = group_input_channels,
+            .k_stride = k_stride,
+            .n = group_output_channels,
+            .n_stride = n_stride,
+            .a = a,
+            .a_stride = input_pixel_stride,
+            .packed_b = convolution->packed_kernel,
+            .bias = convolution->bias,
+            .c = c,
+            .c_stride = output_pixel_stride,
+            .a_zero_point = convolution->input_zero_point,
+            .b_zero_point = convolution->kernel_zero_point,
+            .requantization_params = convolution->requantization_params,
+            .lookup_table = convolution->lookup_table,
+            .ukernels = qnnp_get_q8conv_uarch_ukernels(&convolution->q8conv),
+        };
+        compute_gemm_4d_tiled(
+            convolution, threadpool,
+            (pthreadpool_function_4d_tiled_t) compute_q8gemm,
+            &q8gemm_context,
+            groups, band_size, band_size, group_output_channels,
+            1, band_size, mr, nr);
+      }
+    }
+  } else {
+    /* The indirection buffer is tiled from the first output pixel, so tiles of the band compute their own pointers */
+    const uint32_t mr = convolution->q8conv.mr;
+    const uint32_t nr = convolution->q8conv.nr;
+    const uint32_t kr = convolution->q8conv.kr;
+    const size_t n_stride = (group_output_channels + (nr - 1)) & -nr;
+    const size_t output_size = output_height * output_width;
+    struct q8conv_context q8conv_context = {
+        .bs = batch_size,
+        .ks = kernel_size,
+        .kc = group_input_channels,
+        .kc_stride = qnnp_get_packed_channel_stride(kernel_size, group_input_channels, nr, kr),
+        .m = output_size,
+        .m_stride = round_up(output_size, mr),
+        .n = group_output_channels,
+        .n_stride = n_stride,
+        .mr = mr,
+        .a = convolution->input,
+        .a_pixel_stride = input_pixel_stride,
+        .zero = (const uint8_t*) ((uintptr_t) convolution->zero + (group_input_channels < 8 ? 8 : 0)),
+        .input_height = input_height,
+        .input_width = input_width,
+        .output_width_divisor = fxdiv_init_size_t(output_width),
+        .kernel_height = convolution->kernel_height,
+        .kernel_width = convolution->kernel_width,
+        .stride_height = convolution->stride_height,
+        .stride_width = convolution->stride_width,
+        .dilation_height = convolution->dilation_height,
+        .dilation_width = convolution->dilation_width,
+        .input_padding_top = convolution->input_padding_top,
+        .input_padding_left = convolution->input_padding_left,
+        .m_start = output_y_start * output_width,
+        .m_end = (output_y_start + output_rows) * output_width,
+        .packed_b = convolution->packed_kernel,
+        .bias = (const int32_t*) convolution->bias,
+        .bias_stride = convolution->flags & QNNP_CONVOLUTION_FLAG_PER_CHANNEL ? 2 : 1,
+        .tap_stride = get_q8conv_tap_stride(convolution),
+        .c = convolution->output,
+        .c_stride = output_pixel_stride,
+        .a_zero_point = convolution->input_zero_point,
+        .b_zero_point = convolution->kernel_zero_point,
+        .requantization_params = convolution->requantization_params,
+        .lookup_table = convolution->lookup_table,
+        .ukernels = qnnp_get_q8conv_uarch_ukernels(&convolution->q8conv),
+        .xzp_ukernel = convolution->flags & QNNP_CONVOLUTION_FLAG_XZP_CONV ? convolution->q8conv.xzp_conv : NULL,
+        .sum_rows_ukernel = qnnp_params.q8sum_rows.conv_sum_rows,
+        .nr = nr,
+        .a_sum_multiplier = -(int32_t) convolution->kernel_zero_point,
+    };
+    compute_gemm_4d_tiled(
+        convolution, threadpool,
+        (pthreadpool_function_4d_tiled_t) compute_q8conv_with_tile_indirection,
+        &q8conv_context,
+        groups, batch_size, output_rows * output_width, group_output_channels,
+        1, 1, mr,
+        get_q8conv_task_channels(
+          convolution, threadpool, groups * batch_size * divide_round_up(output_rows * output_width, mr),
+          group_output_channels, nr));
+  }
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_set_operator_lookup_table(qnnp_operator_t op, const uint8_t* lookup_table)
+{
+  switch (op->type) {
+    case qnnp_operator_type_convolution:
+    case qnnp_operator_type_deconvolution:
+    case qnnp_operator_type_fully_connected:
+      break;
+    default:
+      qnnp_log_error(
+        "failed to set lookup table of operator type %d: only convolution, deconvolution, and fully-connected "
+        "operators support lookup tables", (int) op->type);
+      return qnnp_status_invalid_parameter;
+  }
+
+  if (op->format != qnnp_format_quint8) {
+    qnnp_log_error("failed to set lookup table: only quantized 8-bit operators support lookup tables");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (lookup_table == NULL) {
+    free(op->lookup_table);
+    op->lookup_table = NULL;
+    return qnnp_status_success;
+  }
+
+  if (op->lookup_table == NULL) {
+    op->lookup_table = malloc(256 * sizeof(uint8_t));
+    if (op->lookup_table == NULL) {
+      qnnp_log_error("failed to allocate 256 bytes for lookup table");
+      return qnnp_status_out_of_memory;
+    }
+  }
+  memcpy(op->lookup_table, lookup_table, 256 * sizeof(uint8_t));
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_set_operator_io(qnnp_operator_t op, const void* input, void* output)
+{
+  /* Whether setup built an indirection buffer into the input, which must then follow it */
+  bool indirection;
+  switch (op->type) {
+    case qnnp_operator_type_convolution:
+    case qnnp_operator_type_max_pooling:
+    case qnnp_operator_type_average_pooling:
+      indirection = !(op->flags &
+          (QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_XZP_GEMM | QNNP_CONVOLUTION_FLAG_WINOGRAD |
+           QNNP_CONVOLUTION_FLAG_STEM)) &&
+        !op->tile_indirection;
+      break;
+    case qnnp_operator_type_deconvolution:
+      indirection = !op->tile_indirection && !(op->flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL);
+      break;
+    case qnnp_operator_type_fully_connected:
+    case qnnp_operator_type_global_average_pooling:
+    case qnnp_operator_type_channel_shuffle:
+    case qnnp_operator_type_quantize:
+    case qnnp_operator_type_dequantize:
+    case qnnp_operator_type_requantize:
+    case qnnp_operator_type_softmax:
+    case qnnp_operator_type_argmax:
+    case qnnp_operator_type_resize_bilinear:
+    case qnnp_operator_type_resize_nearest:
+      indirection = false;
+      break;
+    default:
+      qnnp_log_error(
+        "failed to set input and output of operator type %d: add, concat, and fused operators must be set up again",
+        (int) op->type);
+      return qnnp_status_invalid_parameter;
+  }
+
+  if (op->batch_size == 0) {
+    qnnp_log_error("failed to set input and output of operator: operator is not set up");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (indirection && op->indirection_input == NULL) {
+    qnnp_log_error(
+      "failed to set input and output of operator: "
+      "indirection buffer in caller-provided workspace must be rebuilt by setup");
+    return qnnp_status_invalid_parameter;
+  }
+
+  op->input = input;
+  op->output = output;
+  if (indirection) {
+    if (op->type == qnnp_operator_type_deconvolution) {
+      qnnp_rebase_deconvolution_indirection(op);
+    } else {
+      size_t workspace_size, scratch_size;
+      const bool strided_input = is_strided_input(
+        op->input_height, op->input_width, op->input_pixel_stride, op->input_row_stride, op->input_image_stride);
+      compute_convolution_workspace_size(
+        op, op->batch_size, op->input_height, op->input_width, strided_input, &workspace_size, &scratch_size);
+      init_convolution_indirection(
+        op, (const uint8_t*) input, op->input_pixel_stride, op->input_row_stride, op->input_image_stride,
+        workspace_size, false, true, op->indirection_input);
     }
   }
   return qnnp_status_success;
@@ -971,11 +5689,37 @@ enum qnnp_status qnnp_run_operator(qnnp_operator_t op, pthreadpool_t threadpool)
 enum qnnp_status qnnp_delete_operator(qnnp_operator_t op)
 {
   if (op != NULL) {
-    free(op->im2col_buffer);
-    free(op->packed_kernel);
-    free(op->a_sum);
-    free(op->bias);
-    free(op->zero);
+    if (!op->external_workspace) {
+      qnnp_deallocate(op->im2col_buffer);
+      qnnp_deallocate(op->expanded_input);
+    }
+    if (op->packed_weights != NULL) {
+      qnnp_release_packed_weights(op->packed_weights);
+    }
+    qnnp_deallocate(op->split_k_buffer);
+    qnnp_deallocate_weights(op->zero);
+    qnnp_delete_setup_cache(op->setup_cache);
+    free(op->lookup_table);
+    free(op->exp_lookup_table);
+    qnnp_deallocate(op->resize_indices);
+    qnnp_deallocate(op->resize_weights);
+    free(op->concat_inputs);
+    if (op->inverted_residual != NULL) {
+      qnnp_deallocate(op->inverted_residual->band_buffers);
+      free(op->inverted_residual);
+    }
+    if (op->xzp_calibration != NULL) {
+      qnnp_delete_operator(op->xzp_calibration->alternative);
+      free(op->xzp_calibration);
+    }
+    if (op->lstm_cell != NULL) {
+      qnnp_delete_operator(op->lstm_cell->gates);
+      qnnp_deallocate(op->lstm_cell->concat_buffer);
+      qnnp_deallocate(op->lstm_cell->gate_buffer);
+      free(op->lstm_cell);
+    }
+    free(op->embedding_bag);
+    free(op->stats);
     free(op);
     return qnnp_status_success;
   }
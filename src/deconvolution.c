@@ -16,26 +16,53 @@
 #include <fp16.h>
 
 #include <qnnpack.h>
+#include <qnnpack/allocator.h>
 #include <qnnpack/convolution.h>
 #include <qnnpack/requantization.h>
 #include <qnnpack/log.h>
 #include <qnnpack/math.h>
-#include <qnnpack/pack.h>
+#include <qnnpack/packed-weights.h>
 #include <qnnpack/params.h>
+#include <qnnpack/profiling.h>
+#include <qnnpack/setup-cache.h>
+#include <qnnpack/ukernel-selection.h>
 
-static inline size_t compute_output_dimension(
-    size_t input_dimension,
-    size_t input_padding_dimension,
-    size_t adjustment_dimension,
-    size_t kernel_dimension,
-    size_t dilation_dimension,
-    size_t stride_dimension)
+/*
+ * Whether a deconvolution can run as one convolution per stride phase: the stride is not 1, every phase has taps, and
+ * the input pointers of a phase tile fit on the stack, see QNNP_CONVOLUTION_FLAG_SUBPIXEL.
+ */
+static bool supports_subpixel(
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t mr)
 {
-  const size_t effective_kernel_dimension = (kernel_dimension - 1) * dilation_dimension + 1;
-  return stride_dimension * (input_dimension - 1) + adjustment_dimension + effective_kernel_dimension - input_padding_dimension;
+  if (stride_height == 1 && stride_width == 1) {
+    return false;
+  }
+  size_t max_phase_size = 0;
+  for (uint32_t residue_y = 0; residue_y < stride_height; residue_y++) {
+    const size_t phase_height = qnnp_subpixel_phase_taps(kernel_height, dilation_height, stride_height, residue_y);
+    for (uint32_t residue_x = 0; residue_x < stride_width; residue_x++) {
+      const size_t phase_width = qnnp_subpixel_phase_taps(kernel_width, dilation_width, stride_width, residue_x);
+      if (phase_height == 0 || phase_width == 0) {
+        /* Outputs of the phase would be just the bias */
+        return false;
+      }
+      max_phase_size = max(max_phase_size, phase_height * phase_width);
+    }
+  }
+  return (size_t) mr * max_phase_size <= QNNP_MAX_INDIRECTION_TILE_SIZE;
 }
 
-enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8(
+/*
+ * Creates a deconvolution that either packs the kernel and bias, or, when packed_weights is not NULL, references
+ * weights packed by another deconvolution with the same parameters.
+ */
+static enum qnnp_status create_deconvolution2d_nhwc_q8(
     uint32_t input_padding_top,
     uint32_t input_padding_right,
     uint32_t input_padding_bottom,
@@ -57,10 +84,13 @@ enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8(
     float kernel_scale,
     const uint8_t* kernel,
     const int32_t* bias,
+    qnnp_packed_weights_t packed_weights,
     uint8_t output_zero_point,
     float output_scale,
     uint8_t output_min,
     uint8_t output_max,
+    uint32_t create_flags,
+    pthreadpool_t threadpool,
     qnnp_operator_t* deconvolution_out)
 {
   qnnp_operator_t deconvolution = NULL;
@@ -117,43 +147,71 @@ enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8(
 
   uint32_t flags = QNNP_CONVOLUTION_FLAG_ZERO;
 
-  const uint32_t nr = qnnp_params.q8conv.nr;
-  const uint32_t kr = qnnp_params.q8conv.kr;
-
-  const uint32_t n_stride = (group_output_channels + (nr - 1)) & -nr;
-  const uint32_t k_stride = (group_input_channels + (kr - 1)) & -kr;
-  deconvolution->packed_kernel = malloc(sizeof(uint8_t) * kernel_height * kernel_width * groups * k_stride * n_stride);
-  if (deconvolution->packed_kernel == NULL) {
-    qnnp_log_error("failed to allocate %zu bytes for packed kernel data",
-      sizeof(uint8_t) * kernel_height * kernel_width * groups * k_stride * n_stride);
-    goto error;
-  }
-  const size_t kernel_size = kernel_height * kernel_width;
-  memset(deconvolution->packed_kernel, kernel_zero_point, sizeof(uint8_t) * groups * kernel_size * k_stride * n_stride);
-
-  for (uint32_t group = 0; group < groups; group++) {
-    pack_q8deconv_b(
-        group_output_channels, kernel_size, group_input_channels,
-        nr, kr,
-        kernel + group * group_output_channels * kernel_size * group_input_channels,
-        deconvolution->packed_kernel + group * kernel_size * n_stride * k_stride);
+  if (create_flags & QNNP_CREATE_FLAG_FP32_REQUANTIZATION) {
+    if (!qnnp_select_q8conv_fp32_requantization(packed_weights, &deconvolution->q8conv, &flags)) {
+      qnnp_log_error(
+        "failed to create deconvolution: no available microkernel with FP32 requantization supports the tile of "
+        "the packed weights");
+      status = qnnp_status_unsupported_parameter;
+      goto error;
+    }
+  } else if (packed_weights != NULL) {
+    if (!qnnp_select_q8conv_parameters_for_tile(packed_weights->nr, packed_weights->kr, &deconvolution->q8conv)) {
+      qnnp_log_error(
+        "failed to create deconvolution: no available microkernel supports the %" PRIu32 "x%" PRIu32 " tile of packed weights",
+        packed_weights->nr, packed_weights->kr);
+      status = qnnp_status_unsupported_parameter;
+      goto error;
+    }
+  } else {
+    deconvolution->q8conv = qnnp_select_q8conv_parameters(group_input_channels, group_output_channels);
   }
-
-  deconvolution->bias = malloc(sizeof(int32_t) * groups * n_stride);
-  if (deconvolution->bias == NULL) {
-    qnnp_log_error("failed to allocate %zu bytes for packed bias data", sizeof(int32_t) * groups * n_stride);
+  if (!qnnp_select_q8conv_signed_kernel(kernel_zero_point, packed_weights, &deconvolution->q8conv, &flags)) {
+    qnnp_log_error("failed to create deconvolution: no available microkernel supports the signed packed weights");
+    status = qnnp_status_unsupported_parameter;
     goto error;
   }
-  for (uint32_t group = 0; group < groups; group++) {
-    memcpy(
-      (int32_t*) deconvolution->bias + group * n_stride,
-      bias + group * group_output_channels,
-      sizeof(int32_t) * group_output_channels);
+  /*
+   * With a stride, most taps of the direct method multiply the zero buffer. Weights packed by phase avoid them, so they
+   * are used whenever possible, and packed weights of another deconvolution are used as they were packed. Signed
+   * kernels are excluded because their bias folds in the sum over all taps, while each phase only reads its own, and
+   * for the same reason the input zero point is only folded into the bias of deconvolutions without phases.
+   */
+  const bool subpixel = packed_weights != NULL ?
+    (packed_weights->flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL) != 0 :
+    !(flags & QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL) && supports_subpixel(
+      kernel_height, kernel_width, stride_height, stride_width, dilation_height, dilation_width,
+      deconvolution->q8conv.mr);
+  if (subpixel) {
+    if (!supports_subpixel(
+        kernel_height, kernel_width, stride_height, stride_width, dilation_height, dilation_width,
+        deconvolution->q8conv.mr))
+    {
+      qnnp_log_error(
+        "failed to create deconvolution: packed weights are ordered by stride phase, which the deconvolution does not "
+        "support");
+      status = qnnp_status_unsupported_parameter;
+      goto error;
+    }
+    flags |= QNNP_CONVOLUTION_FLAG_SUBPIXEL;
+  } else if (!qnnp_select_q8conv_folded_zero_point(create_flags, packed_weights, &deconvolution->q8conv, &flags)) {
+    qnnp_log_error("failed to create deconvolution: no available microkernel supports the folded packed weights");
+    status = qnnp_status_unsupported_parameter;
+    goto error;
   }
+  qnnp_select_q8conv_output_clamp(output_min, output_max, flags, &deconvolution->q8conv);
+  const uint32_t nr = deconvolution->q8conv.nr;
+  const uint32_t kr = deconvolution->q8conv.kr;
 
+  const uint32_t n_stride = (group_output_channels + (nr - 1)) & -nr;
+  const uint32_t k_stride = (group_input_channels + (kr - 1)) & -kr;
+  const size_t kernel_size = kernel_height * kernel_width;
+  const size_t packed_kernel_size =
+    sizeof(uint8_t) * groups * n_stride * qnnp_get_packed_channel_stride(kernel_size, group_input_channels, nr, kr);
+  const size_t bias_size = sizeof(int32_t) * groups * n_stride;
   if (flags & QNNP_CONVOLUTION_FLAG_ZERO) {
     const size_t zero_size = sizeof(uint8_t) * k_stride + (group_input_channels >= 8 ? 0 : 8);
-    deconvolution->zero = malloc(zero_size);
+    deconvolution->zero = qnnp_allocate_weights(zero_size);
     if (deconvolution->zero == NULL) {
       qnnp_log_error("failed to allocate %zu bytes for zero padding", zero_size);
       goto error;
@@ -184,9 +242,35 @@ enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8(
   deconvolution->requantization_params =
     qnnp_compute_requantization_params(
       deconvolution_scale, output_zero_point, output_min, output_max);
+  deconvolution->requantization_scale = deconvolution_scale;
+  deconvolution->output_zero_point = output_zero_point;
+  deconvolution->output_min = output_min;
+  deconvolution->output_max = output_max;
 
+  deconvolution->type = qnnp_operator_type_deconvolution;
   deconvolution->format = qnnp_format_quint8;
   deconvolution->flags = flags;
+  /* Phase tiles always compute their input pointers while running */
+  deconvolution->tile_indirection = !subpixel &&
+    (create_flags & QNNP_CREATE_FLAG_TILE_INDIRECTION) && qnnp_supports_tile_indirection(deconvolution);
+
+  if (packed_weights != NULL) {
+    status = qnnp_attach_packed_weights(deconvolution, packed_weights);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+  } else {
+    status = qnnp_attach_new_packed_weights(deconvolution, kernel, bias, packed_kernel_size, bias_size);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+    if (!(create_flags & QNNP_CREATE_FLAG_LAZY_PACKING)) {
+      status = qnnp_ensure_packed_weights(deconvolution, threadpool);
+      if (status != qnnp_status_success) {
+        goto error;
+      }
+    }
+  }
 
   *deconvolution_out = deconvolution;
   return qnnp_status_success;
@@ -196,71 +280,243 @@ error:
   return status;
 }
 
-enum qnnp_status qnnp_setup_deconvolution2d_nhwc_q8(
-    qnnp_operator_t deconvolution,
-    size_t batch_size,
-    size_t input_height,
-    size_t input_width,
-    const uint8_t* input,
-    size_t input_pixel_stride,
-    uint8_t* output,
-    size_t output_pixel_stride,
-    pthreadpool_t threadpool)
+enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t adjustment_height,
+    uint32_t adjustment_width,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* deconvolution_out)
 {
-  if (!qnnp_params.initialized) {
-    qnnp_log_error("qnnp_setup_deconvolution2d_nhwc_q8 failed because QNNPACK is not properly initialized");
-    return qnnp_status_uninitialized;
-  }
+  return create_deconvolution2d_nhwc_q8(
+    input_padding_top, input_padding_right, input_padding_bottom, input_padding_left,
+    adjustment_height, adjustment_width,
+    kernel_height, kernel_width,
+    stride_height, stride_width,
+    dilation_height, dilation_width,
+    groups, group_input_channels, group_output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale,
+    kernel, bias, NULL,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    NULL /* threadpool */,
+    deconvolution_out);
+}
 
-  if (batch_size == 0) {
-    qnnp_log_error("failed to setup deconvolution with batch size %zu: batch size must be non-zero", batch_size);
-    return qnnp_status_invalid_parameter;
-  }
+enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8_with_threadpool(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t adjustment_height,
+    uint32_t adjustment_width,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    pthreadpool_t threadpool,
+    qnnp_operator_t* deconvolution_out)
+{
+  return create_deconvolution2d_nhwc_q8(
+    input_padding_top, input_padding_right, input_padding_bottom, input_padding_left,
+    adjustment_height, adjustment_width,
+    kernel_height, kernel_width,
+    stride_height, stride_width,
+    dilation_height, dilation_width,
+    groups, group_input_channels, group_output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale,
+    kernel, bias, NULL,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    threadpool,
+    deconvolution_out);
+}
 
-  if (input_width == 0 || input_height == 0) {
-    qnnp_log_error(
-      "failed to setup deconvolution with %zux%zu input: input dimensions must be non-zero",
-      input_width,
-      input_height);
+enum qnnp_status qnnp_create_deconvolution2d_nhwc_q8_with_packed_weights(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t adjustment_height,
+    uint32_t adjustment_width,
+    uint32_t kernel_height,
+    uint32_t kernel_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    uint32_t groups,
+    size_t group_input_channels,
+    size_t group_output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    qnnp_packed_weights_t packed_weights,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* deconvolution_out)
+{
+  if (packed_weights == NULL) {
+    qnnp_log_error("failed to create deconvolution: packed weights must not be NULL");
     return qnnp_status_invalid_parameter;
   }
 
-  deconvolution->batch_size = batch_size;
-  deconvolution->input_height = input_height;
-  deconvolution->input_width = input_width;
-  deconvolution->input = input;
-  deconvolution->input_pixel_stride = input_pixel_stride;
-  deconvolution->output = output;
-  deconvolution->output_pixel_stride = output_pixel_stride;
+  return create_deconvolution2d_nhwc_q8(
+    input_padding_top, input_padding_right, input_padding_bottom, input_padding_left,
+    adjustment_height, adjustment_width,
+    kernel_height, kernel_width,
+    stride_height, stride_width,
+    dilation_height, dilation_width,
+    groups, group_input_channels, group_output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale,
+    NULL, NULL, packed_weights,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    NULL /* threadpool */,
+    deconvolution_out);
+}
+
+static size_t compute_deconvolution_workspace_size(
+    const struct qnnp_operator* deconvolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width)
+{
+  const size_t output_height = compute_deconvolution_output_dimension(
+    input_height, deconvolution->input_padding_top + deconvolution->input_padding_bottom,
+    deconvolution->adjustment_height, deconvolution->kernel_height, deconvolution->dilation_height,
+    deconvolution->stride_height);
+  const size_t output_width = compute_deconvolution_output_dimension(
+    input_width, deconvolution->input_padding_left + deconvolution->input_padding_right,
+    deconvolution->adjustment_width, deconvolution->kernel_width, deconvolution->dilation_width,
+    deconvolution->stride_width);
+  const size_t kernel_size = deconvolution->kernel_height * deconvolution->kernel_width;
+  const size_t tiled_output_size = round_up(output_height * output_width, deconvolution->q8conv.mr);
+  if (deconvolution->tile_indirection || (deconvolution->flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL)) {
+    /* Tiles compute their input pointers in qnnp_run_operator */
+    return 0;
+  } else if (qnnp_use_indirection_offsets(deconvolution, input_height, input_width)) {
+    return sizeof(uint32_t) * tiled_output_size * kernel_size;
+  } else {
+    return sizeof(void*) * batch_size * deconvolution->groups * tiled_output_size * kernel_size;
+  }
+}
 
+/*
+ * Builds the indirection buffer of a deconvolution that setup_deconvolution allocated for its batch size and input
+ * dimensions, or rebases the previous one if it is reusable.
+ */
+static void init_deconvolution_indirection(
+    qnnp_operator_t deconvolution,
+    size_t im2col_buffer_size,
+    bool external_workspace,
+    bool indirection_reusable,
+    const void* indirection_input)
+{
+  const size_t batch_size = deconvolution->batch_size;
+  const size_t input_height = deconvolution->input_height;
+  const size_t input_width = deconvolution->input_width;
+  const uint8_t* input = (const uint8_t*) deconvolution->input;
+  const size_t input_pixel_stride = deconvolution->input_pixel_stride;
   const size_t kernel_height = deconvolution->kernel_height;
   const size_t kernel_width = deconvolution->kernel_width;
   const size_t kernel_size = kernel_height * kernel_width;
   const size_t stride_height = deconvolution->stride_height;
   const size_t stride_width = deconvolution->stride_width;
-  const size_t output_height = deconvolution->output_height = compute_output_dimension(
-    input_height, deconvolution->input_padding_top + deconvolution->input_padding_bottom,
-    deconvolution->adjustment_height, kernel_height, deconvolution->dilation_height, stride_height);
-  const size_t output_width = deconvolution->output_width = compute_output_dimension(
-    input_width, deconvolution->input_padding_left + deconvolution->input_padding_right,
-    deconvolution->adjustment_width, kernel_width, deconvolution->dilation_width, stride_width);
-
+  const size_t output_height = deconvolution->output_height;
+  const size_t output_width = deconvolution->output_width;
   const size_t groups = deconvolution->groups;
   const size_t output_size = output_height * output_width;
-  const size_t output_tile_size = qnnp_params.q8conv.mr;
+  const size_t output_tile_size = deconvolution->q8conv.mr;
   const size_t tiled_output_size = round_up(output_size, output_tile_size);
-  const size_t im2col_buffer_size = sizeof(void*) * batch_size * groups * tiled_output_size * kernel_size;
-
-  const void** im2col_buffer = (const void**) realloc(deconvolution->im2col_buffer, im2col_buffer_size);
-  if (im2col_buffer == NULL) {
-    qnnp_log_error("failed to allocate %zu bytes for im2col buffer", im2col_buffer_size);
-    return qnnp_status_out_of_memory;
+  const void** im2col_buffer = deconvolution->im2col_buffer;
+
+  const void* zero = qnnp_get_indirection_zero(deconvolution);
+  const bool indirection_offsets = qnnp_use_indirection_offsets(deconvolution, input_height, input_width);
+  if (indirection_reusable) {
+    if (!indirection_offsets) {
+      qnnp_rebase_indirection_buffer(
+        im2col_buffer, im2col_buffer_size / sizeof(void*), zero, indirection_input, input);
+    }
+    deconvolution->indirection_input = input;
+    return;
   }
-  deconvolution->im2col_buffer = im2col_buffer;
 
-  const void* zero = deconvolution->zero;
-  if (deconvolution->group_input_channels < 8) {
-    zero = (const void*) ((uintptr_t) zero + 8);
+  deconvolution->indirection_offsets = indirection_offsets;
+  if (indirection_offsets) {
+    /* Every image of the batch shares the indices of the first one */
+    uint32_t* indirection_buffer = (uint32_t*) im2col_buffer;
+    for (size_t output_tile_start = 0; output_tile_start < tiled_output_size; output_tile_start += output_tile_size) {
+      for (size_t output_tile_offset = 0; output_tile_offset < output_tile_size; output_tile_offset++) {
+        const size_t tiled_output_index = output_tile_start + output_tile_offset;
+        const size_t output_index = min(tiled_output_index, output_size - 1);
+        const size_t output_y = output_index / output_width;
+        const size_t output_x = output_index % output_width;
+        for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+          const size_t y = output_y + deconvolution->input_padding_top - kernel_y * deconvolution->dilation_height;
+          const size_t input_y = y / stride_height;
+          for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+            const size_t x = output_x + deconvolution->input_padding_left - kernel_x * deconvolution->dilation_width;
+            const size_t input_x = x / stride_width;
+            const size_t index =
+              output_tile_start * kernel_size + (kernel_y * kernel_width + kernel_x) * output_tile_size + output_tile_offset;
+            if (input_y * stride_height == y && input_y < input_height && input_x * stride_width == x && input_x < input_width) {
+              indirection_buffer[index] = (uint32_t) (input_y * input_width + input_x);
+            } else {
+              indirection_buffer[index] = QNNP_INDIRECTION_OFFSET_ZERO;
+            }
+          }
+        }
+      }
+    }
+    if (!external_workspace) {
+      deconvolution->indirection_input = input;
+    }
+    return;
   }
 
   for (size_t group = 0; group < groups; group++) {
@@ -292,5 +548,186 @@ enum qnnp_status qnnp_setup_deconvolution2d_nhwc_q8(
     }
   }
 
+  if (!external_workspace) {
+    deconvolution->indirection_input = input;
+  }
+}
+
+static enum qnnp_status setup_deconvolution(
+    qnnp_operator_t deconvolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    bool external_workspace,
+    void* workspace)
+{
+  const uint64_t setup_start = qnnp_profile_start();
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_deconvolution2d_nhwc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup deconvolution with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (input_width == 0 || input_height == 0) {
+    qnnp_log_error(
+      "failed to setup deconvolution with %zux%zu input: input dimensions must be non-zero",
+      input_width,
+      input_height);
+    return qnnp_status_invalid_parameter;
+  }
+
+  /* As for convolution, the indirection buffer is rebased instead of rebuilt when only the input pointer changes */
+  const void* indirection_input = deconvolution->indirection_input;
+  bool indirection_reusable = !external_workspace && !deconvolution->external_workspace &&
+    indirection_input != NULL &&
+    deconvolution->batch_size == batch_size &&
+    deconvolution->input_height == input_height &&
+    deconvolution->input_width == input_width &&
+    deconvolution->input_pixel_stride == input_pixel_stride;
+  deconvolution->indirection_input = NULL;
+  const void* prebuilt_indirection_input = deconvolution->prebuilt_indirection_input;
+  deconvolution->prebuilt_indirection_input = NULL;
+
+  /* As for convolution, indirection buffers of other shapes move into and out of the setup cache */
+  if (!external_workspace && !deconvolution->external_workspace && deconvolution->setup_cache != NULL &&
+      !indirection_reusable)
+  {
+    if (indirection_input != NULL) {
+      qnnp_setup_cache_store(
+        deconvolution,
+        compute_deconvolution_workspace_size(
+          deconvolution, deconvolution->batch_size, deconvolution->input_height, deconvolution->input_width),
+        indirection_input);
+    }
+    if (qnnp_setup_cache_restore(deconvolution, batch_size, input_height, input_width, input_pixel_stride)) {
+      indirection_input = deconvolution->indirection_input;
+      deconvolution->indirection_input = NULL;
+      indirection_reusable = true;
+    }
+  }
+
+  deconvolution->batch_size = batch_size;
+  deconvolution->input_height = input_height;
+  deconvolution->input_width = input_width;
+  deconvolution->input = input;
+  deconvolution->input_pixel_stride = input_pixel_stride;
+  deconvolution->output = output;
+  deconvolution->output_pixel_stride = output_pixel_stride;
+
+  deconvolution->output_height = compute_deconvolution_output_dimension(
+    input_height, deconvolution->input_padding_top + deconvolution->input_padding_bottom,
+    deconvolution->adjustment_height, deconvolution->kernel_height, deconvolution->dilation_height,
+    deconvolution->stride_height);
+  deconvolution->output_width = compute_deconvolution_output_dimension(
+    input_width, deconvolution->input_padding_left + deconvolution->input_padding_right,
+    deconvolution->adjustment_width, deconvolution->kernel_width, deconvolution->dilation_width,
+    deconvolution->stride_width);
+
+  if (deconvolution->tile_indirection || (deconvolution->flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL)) {
+    /* Tiles compute their input pointers in qnnp_run_operator */
+    qnnp_profile_phase(deconvolution, qnnp_profiling_phase_setup, setup_start);
+    return qnnp_status_success;
+  }
+
+  const size_t im2col_buffer_size = compute_deconvolution_workspace_size(deconvolution, batch_size, input_height, input_width);
+
+  const void** im2col_buffer;
+  if (external_workspace) {
+    if (workspace == NULL) {
+      qnnp_log_error("failed to setup deconvolution: %zu bytes of workspace required", im2col_buffer_size);
+      return qnnp_status_invalid_parameter;
+    }
+    if (!deconvolution->external_workspace) {
+      qnnp_deallocate(deconvolution->im2col_buffer);
+    }
+    im2col_buffer = (const void**) workspace;
+    if (prebuilt_indirection_input != NULL) {
+      indirection_input = prebuilt_indirection_input;
+      indirection_reusable = true;
+    }
+  } else {
+    if (deconvolution->external_workspace) {
+      deconvolution->im2col_buffer = NULL;
+    }
+    im2col_buffer = (const void**) qnnp_reallocate(deconvolution->im2col_buffer, im2col_buffer_size);
+    if (im2col_buffer == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for im2col buffer", im2col_buffer_size);
+      return qnnp_status_out_of_memory;
+    }
+  }
+  deconvolution->im2col_buffer = im2col_buffer;
+  deconvolution->external_workspace = external_workspace;
+
+  const uint64_t indirection_start = qnnp_profile_start();
+  init_deconvolution_indirection(
+    deconvolution, im2col_buffer_size, external_workspace, indirection_reusable, indirection_input);
+  qnnp_profile_phase(deconvolution, qnnp_profiling_phase_indirection, indirection_start);
+  qnnp_profile_phase(deconvolution, qnnp_profiling_phase_setup, setup_start);
   return qnnp_status_success;
 }
+
+void qnnp_rebase_deconvolution_indirection(qnnp_operator_t deconvolution)
+{
+  const size_t im2col_buffer_size = compute_deconvolution_workspace_size(
+    deconvolution, deconvolution->batch_size, deconvolution->input_height, deconvolution->input_width);
+  init_deconvolution_indirection(
+    deconvolution, im2col_buffer_size, false, true, deconvolution->indirection_input);
+}
+
+enum qnnp_status qnnp_get_deconvolution2d_nhwc_q8_workspace_size(
+    qnnp_operator_t deconvolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t* workspace_size)
+{
+  *workspace_size = compute_deconvolution_workspace_size(deconvolution, batch_size, input_height, input_width);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_setup_deconvolution2d_nhwc_q8(
+    qnnp_operator_t deconvolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  return setup_deconvolution(
+    deconvolution,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride,
+    output, output_pixel_stride,
+    false, NULL);
+}
+
+enum qnnp_status qnnp_setup_deconvolution2d_nhwc_q8_with_workspace(
+    qnnp_operator_t deconvolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    void* workspace,
+    pthreadpool_t threadpool)
+{
+  return setup_deconvolution(
+    deconvolution,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride,
+    output, output_pixel_stride,
+    true, workspace);
+}
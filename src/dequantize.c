@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+#include <qnnpack/requantization.h>
+
+
+enum qnnp_status qnnp_create_dequantize_nc_q8_f32(
+    size_t channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint32_t flags,
+    qnnp_operator_t* dequantize_out)
+{
+  qnnp_operator_t dequantize_op = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_dequantize_nc_q8_f32 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (channels == 0) {
+    qnnp_log_error(
+      "failed to create dequantize operator with %zu channels: number of channels must be non-zero", channels);
+    goto error;
+  }
+
+  if (!(input_scale > 0.0f && isnormal(input_scale))) {
+    qnnp_log_error(
+      "failed to create dequantize operator with %.7g input scale: scale must be finite, normalized, and positive",
+      input_scale);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  dequantize_op = calloc(1, sizeof(struct qnnp_operator));
+  if (dequantize_op == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  dequantize_op->channels = channels;
+  dequantize_op->f32_dequantization_params = qnnp_compute_f32_dequantization_params(input_zero_point, input_scale);
+  dequantize_op->input_zero_point = input_zero_point;
+
+  dequantize_op->type = qnnp_operator_type_dequantize;
+  dequantize_op->format = qnnp_format_quint8;
+
+  *dequantize_out = dequantize_op;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(dequantize_op);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_dequantize_nc_q8_f32(
+    qnnp_operator_t dequantize_op,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    float* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_dequantize_nc_q8_f32 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (dequantize_op->type != qnnp_operator_type_dequantize) {
+    qnnp_log_error(
+      "failed to setup dequantize operator: operator was not created by qnnp_create_dequantize_nc_q8_f32");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error(
+      "failed to setup dequantize operator with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t channels = dequantize_op->channels;
+  if (input_stride < channels || output_stride < channels) {
+    qnnp_log_error(
+      "failed to setup dequantize operator with %zu input and %zu output strides: "
+      "strides must be at least the %zu channels",
+      input_stride, output_stride, channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  dequantize_op->batch_size = batch_size;
+  dequantize_op->input = input;
+  dequantize_op->input_pixel_stride = input_stride;
+  dequantize_op->output = output;
+  dequantize_op->output_pixel_stride = output_stride;
+
+  return qnnp_status_success;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+
+
+enum qnnp_status qnnp_create_embedding_bag_q8(
+    size_t num_embeddings,
+    size_t embedding_dim,
+    const uint8_t* weights,
+    const float* scales,
+    const float* biases,
+    uint32_t flags,
+    qnnp_operator_t* embedding_bag_out)
+{
+  qnnp_operator_t embedding_bag_op = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_embedding_bag_q8 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (num_embeddings == 0 || embedding_dim == 0) {
+    qnnp_log_error(
+      "failed to create embedding-bag operator with %zux%zu table: table dimensions must be non-zero",
+      num_embeddings, embedding_dim);
+    goto error;
+  }
+
+  if (weights == NULL || scales == NULL || biases == NULL) {
+    qnnp_log_error("failed to create embedding-bag operator: table, scales, and biases must be non-NULL");
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  embedding_bag_op = calloc(1, sizeof(struct qnnp_operator));
+  if (embedding_bag_op == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  struct qnnp_embedding_bag* embedding_bag = calloc(1, sizeof(struct qnnp_embedding_bag));
+  if (embedding_bag == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for embedding-bag table", sizeof(struct qnnp_embedding_bag));
+    goto error;
+  }
+  embedding_bag_op->embedding_bag = embedding_bag;
+
+  embedding_bag->weights = weights;
+  embedding_bag->scales = scales;
+  embedding_bag->biases = biases;
+  embedding_bag->num_embeddings = num_embeddings;
+  /* Rows of a table that fits in the L2 cache stay there across runs, and prefetching them only costs instructions */
+  embedding_bag->prefetch = num_embeddings * embedding_dim > qnnp_params.l2_cache_size;
+
+  embedding_bag_op->channels = embedding_dim;
+  embedding_bag_op->flags = flags & QNNP_CREATE_FLAG_EMBEDDING_BAG_MEAN;
+
+  embedding_bag_op->type = qnnp_operator_type_embedding_bag;
+  embedding_bag_op->format = qnnp_format_quint8;
+
+  *embedding_bag_out = embedding_bag_op;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(embedding_bag_op);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_embedding_bag_q8(
+    qnnp_operator_t embedding_bag_op,
+    size_t bags,
+    const uint32_t* indices,
+    const uint32_t* offsets,
+    const float* per_sample_weights,
+    float* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_embedding_bag_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (embedding_bag_op->type != qnnp_operator_type_embedding_bag) {
+    qnnp_log_error(
+      "failed to setup embedding-bag operator: operator was not created by qnnp_create_embedding_bag_q8");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (bags == 0) {
+    qnnp_log_error("failed to setup embedding-bag operator with %zu bags: number of bags must be non-zero", bags);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t embedding_dim = embedding_bag_op->channels;
+  if (output_stride < embedding_dim) {
+    qnnp_log_error(
+      "failed to setup embedding-bag operator with %zu output stride: stride must be at least the %zu channels",
+      output_stride, embedding_dim);
+    return qnnp_status_invalid_parameter;
+  }
+
+  for (size_t i = 0; i < bags; i++) {
+    if (offsets[i + 1] < offsets[i]) {
+      qnnp_log_error(
+        "failed to setup embedding-bag operator: offset %" PRIu32 " of bag %zu is past its end %" PRIu32,
+        offsets[i], i, offsets[i + 1]);
+      return qnnp_status_invalid_parameter;
+    }
+  }
+
+  struct qnnp_embedding_bag* embedding_bag = embedding_bag_op->embedding_bag;
+  const size_t num_embeddings = embedding_bag->num_embeddings;
+  for (size_t i = offsets[0]; i < offsets[bags]; i++) {
+    if (indices[i] >= num_embeddings) {
+      qnnp_log_error(
+        "failed to setup embedding-bag operator: index %" PRIu32 " at %zu is out of the %zu rows of the table",
+        indices[i], i, num_embeddings);
+      return qnnp_status_invalid_parameter;
+    }
+  }
+
+  embedding_bag->indices = indices;
+  embedding_bag->offsets = offsets;
+  embedding_bag->per_sample_weights = per_sample_weights;
+
+  embedding_bag_op->batch_size = bags;
+  embedding_bag_op->output = output;
+  embedding_bag_op->output_pixel_stride = output_stride;
+
+  return qnnp_status_success;
+}
@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <cpuinfo.h>
@@ -17,16 +18,25 @@
 #include <fxdiv.h>
 
 #include <qnnpack.h>
+#include <qnnpack/allocator.h>
 #include <qnnpack/convolution.h>
 #include <qnnpack/requantization.h>
 #include <qnnpack/log.h>
 #include <qnnpack/math.h>
 #include <qnnpack/pack.h>
+#include <qnnpack/packed-weights.h>
 #include <qnnpack/params.h>
+#include <qnnpack/profiling.h>
 #include <qnnpack/q8gemm.h>
+#include <qnnpack/scheduler.h>
+#include <qnnpack/ukernel-selection.h>
 
 
-enum qnnp_status qnnp_create_fully_connected_nc_q8(
+/*
+ * Creates a fully connected operator that either packs the kernel and bias, or, when packed_weights is not NULL, references
+ * weights packed by another fully connected operator with the same parameters.
+ */
+static enum qnnp_status create_fully_connected_nc_q8(
     size_t input_channels,
     size_t output_channels,
     uint8_t input_zero_point,
@@ -35,10 +45,13 @@ enum qnnp_status qnnp_create_fully_connected_nc_q8(
     float kernel_scale,
     const uint8_t* kernel,
     const int32_t* bias,
+    qnnp_packed_weights_t packed_weights,
     uint8_t output_zero_point,
     float output_scale,
     uint8_t output_min,
     uint8_t output_max,
+    uint32_t create_flags,
+    pthreadpool_t threadpool,
     qnnp_operator_t* fully_connected_out)
 {
   qnnp_operator_t fully_connected = NULL;
@@ -49,6 +62,25 @@ enum qnnp_status qnnp_create_fully_connected_nc_q8(
     goto error;
   }
 
+  status = qnnp_status_invalid_parameter;
+
+  if ((create_flags & QNNP_CREATE_FLAG_4BIT_KERNEL) && packed_weights == NULL) {
+    if (kernel_zero_point > 15) {
+      qnnp_log_error(
+        "failed to create fully connected operator with %" PRIu8 " kernel zero point: "
+        "zero point of a 4-bit kernel must be in [0, 15] range", kernel_zero_point);
+      goto error;
+    }
+    for (size_t i = 0; i < output_channels * input_channels; i++) {
+      if (kernel[i] > 15) {
+        qnnp_log_error(
+          "failed to create fully connected operator with kernel value %" PRIu8 " at index %zu: "
+          "values of a 4-bit kernel must be in [0, 15] range", kernel[i], i);
+        goto error;
+      }
+    }
+  }
+
   status = qnnp_status_unsupported_parameter;
 
   const float requantization_scale = input_scale * kernel_scale / output_scale;
@@ -68,32 +100,88 @@ enum qnnp_status qnnp_create_fully_connected_nc_q8(
     goto error;
   }
 
-  const uint32_t nr = qnnp_params.q8conv.nr;
-  const uint32_t kr = qnnp_params.q8conv.kr;
-
-  const uint32_t n_stride = (output_channels + (nr - 1)) & -nr;
-  const uint32_t k_stride = (input_channels + (kr - 1)) & -kr;
-
-  fully_connected->packed_kernel = malloc(sizeof(uint8_t) * k_stride * n_stride);
-  if (fully_connected->packed_kernel == NULL) {
-    qnnp_log_error("failed to allocate %zu bytes for packed kernel data",
-      sizeof(uint8_t) * k_stride * n_stride);
+  uint32_t flags = QNNP_CONVOLUTION_FLAG_GEMM;
+  if (create_flags & QNNP_CREATE_FLAG_FP32_REQUANTIZATION) {
+    if (!qnnp_select_q8conv_fp32_requantization(packed_weights, &fully_connected->q8conv, &flags)) {
+      qnnp_log_error(
+        "failed to create fully connected operator: no available microkernel with FP32 requantization supports the "
+        "tile of the packed weights");
+      status = qnnp_status_unsupported_parameter;
+      goto error;
+    }
+  } else if (qnnp_use_q8gemm_sparse(create_flags, packed_weights, input_channels)) {
+    if (!qnnp_select_q8gemm_sparse(packed_weights, &fully_connected->q8conv)) {
+      qnnp_log_error(
+        "failed to create fully connected operator: no available microkernel supports the sparse packed weights");
+      status = qnnp_status_unsupported_parameter;
+      goto error;
+    }
+    flags |= QNNP_CONVOLUTION_FLAG_SPARSE;
+  } else if (qnnp_use_q8gemm_4bit(create_flags, packed_weights)) {
+    if (!qnnp_select_q8conv_4bit(packed_weights, &fully_connected->q8conv, &flags)) {
+      qnnp_log_error(
+        "failed to create fully connected operator: no available microkernel supports the 4-bit packed weights");
+      status = qnnp_status_unsupported_parameter;
+      goto error;
+    }
+  } else if (packed_weights != NULL) {
+    if (!qnnp_select_q8conv_parameters_for_tile(packed_weights->nr, packed_weights->kr, &fully_connected->q8conv)) {
+      qnnp_log_error(
+        "failed to create fully connected operator: no available microkernel supports the %" PRIu32 "x%" PRIu32 " tile of packed weights",
+        packed_weights->nr, packed_weights->kr);
+      status = qnnp_status_unsupported_parameter;
+      goto error;
+    }
+  } else {
+    fully_connected->q8conv = qnnp_select_q8conv_parameters(input_channels, output_channels);
+  }
+  if (!qnnp_select_q8conv_signed_kernel(kernel_zero_point, packed_weights, &fully_connected->q8conv, &flags)) {
+    qnnp_log_error(
+      "failed to create fully connected operator: no available microkernel supports the signed packed weights");
+    status = qnnp_status_unsupported_parameter;
     goto error;
   }
-  memset(fully_connected->packed_kernel, kernel_zero_point, sizeof(uint8_t) * k_stride * n_stride);
-
-  pack_q8gemm_b(
-      output_channels, input_channels,
-      nr, kr,
-      kernel,
-      fully_connected->packed_kernel);
-
-  fully_connected->bias = malloc(sizeof(int32_t) * n_stride);
-  if (fully_connected->bias == NULL) {
-    qnnp_log_error("failed to allocate %zu bytes for packed bias data", sizeof(int32_t) * n_stride);
+  if (!qnnp_select_q8conv_folded_zero_point(create_flags, packed_weights, &fully_connected->q8conv, &flags)) {
+    qnnp_log_error(
+      "failed to create fully connected operator: no available microkernel supports the folded packed weights");
+    status = qnnp_status_unsupported_parameter;
+    goto error;
+  }
+  if (!qnnp_select_q8conv_acc16(
+        output_channels, input_channels, kernel, input_zero_point, kernel_zero_point,
+        packed_weights, &fully_connected->q8conv, &flags))
+  {
+    qnnp_log_error(
+      "failed to create fully connected operator: no available microkernel supports 16-bit accumulation of the "
+      "packed weights");
+    status = qnnp_status_unsupported_parameter;
     goto error;
   }
-  memcpy(fully_connected->bias, bias, sizeof(uint32_t) * output_channels);
+  qnnp_select_q8conv_output_clamp(output_min, output_max, flags, &fully_connected->q8conv);
+  const uint32_t nr = fully_connected->q8conv.nr;
+  const uint32_t kr = fully_connected->q8conv.kr;
+  if (create_flags & QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT) {
+    if (fully_connected->q8conv.mr * nr > QNNP_TRANSPOSED_OUTPUT_MAX_TILE_SIZE) {
+      qnnp_log_error(
+        "failed to create fully connected operator with transposed output: "
+        "%" PRIu8 "x%" PRIu32 " tile of the %s microkernels exceeds the transposed tile buffer",
+        fully_connected->q8conv.mr, nr, fully_connected->q8conv.name);
+      status = qnnp_status_unsupported_parameter;
+      goto error;
+    }
+    flags |= QNNP_CONVOLUTION_FLAG_TRANSPOSED_OUTPUT;
+  }
+
+  const uint32_t n_stride = (output_channels + (nr - 1)) & -nr;
+  size_t packed_kernel_size =
+    sizeof(uint8_t) * n_stride * qnnp_get_packed_channel_stride(1, input_channels, nr, kr);
+  if ((flags & QNNP_CONVOLUTION_FLAG_SPARSE) && packed_weights == NULL) {
+    packed_kernel_size = qnnp_get_sparse_packed_kernel_size(
+      n_stride, count_q8gemm_sparse_blocks(output_channels, input_channels, kr, kernel_zero_point, kernel));
+  } else if (flags & QNNP_CONVOLUTION_FLAG_4BIT) {
+    packed_kernel_size = sizeof(uint8_t) * n_stride * qnnp_get_4bit_packed_channel_stride(input_channels, nr, kr);
+  }
+  const size_t bias_size = sizeof(int32_t) * n_stride;
 
   fully_connected->groups = 1;
   fully_connected->group_input_channels = input_channels;
@@ -105,9 +193,33 @@ enum qnnp_status qnnp_create_fully_connected_nc_q8(
   fully_connected->requantization_params =
     qnnp_compute_requantization_params(
       requantization_scale, output_zero_point, output_min, output_max);
+  fully_connected->requantization_scale = requantization_scale;
+  fully_connected->accumulator_scale = input_scale * kernel_scale;
+  fully_connected->output_zero_point = output_zero_point;
+  fully_connected->output_min = output_min;
+  fully_connected->output_max = output_max;
 
+  fully_connected->type = qnnp_operator_type_fully_connected;
   fully_connected->format = qnnp_format_quint8;
-  fully_connected->flags = QNNP_CONVOLUTION_FLAG_GEMM;
+  fully_connected->flags = flags;
+
+  if (packed_weights != NULL) {
+    status = qnnp_attach_packed_weights(fully_connected, packed_weights);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+  } else {
+    status = qnnp_attach_new_packed_weights(fully_connected, kernel, bias, packed_kernel_size, bias_size);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+    if (!(create_flags & QNNP_CREATE_FLAG_LAZY_PACKING)) {
+      status = qnnp_ensure_packed_weights(fully_connected, threadpool);
+      if (status != qnnp_status_success) {
+        goto error;
+      }
+    }
+  }
 
   *fully_connected_out = fully_connected;
   return qnnp_status_success;
@@ -117,15 +229,131 @@ error:
   return status;
 }
 
-enum qnnp_status qnnp_setup_fully_connected_nc_q8(
+enum qnnp_status qnnp_create_fully_connected_nc_q8(
+    size_t input_channels,
+    size_t output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* fully_connected_out)
+{
+  return create_fully_connected_nc_q8(
+    input_channels, output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale,
+    kernel, bias, NULL,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    NULL /* threadpool */,
+    fully_connected_out);
+}
+
+enum qnnp_status qnnp_create_fully_connected_nc_q8_with_threadpool(
+    size_t input_channels,
+    size_t output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    const uint8_t* kernel,
+    const int32_t* bias,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    pthreadpool_t threadpool,
+    qnnp_operator_t* fully_connected_out)
+{
+  return create_fully_connected_nc_q8(
+    input_channels, output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale,
+    kernel, bias, NULL,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    threadpool,
+    fully_connected_out);
+}
+
+enum qnnp_status qnnp_create_fully_connected_nc_q8_with_packed_weights(
+    size_t input_channels,
+    size_t output_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    qnnp_packed_weights_t packed_weights,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* fully_connected_out)
+{
+  if (packed_weights == NULL) {
+    qnnp_log_error("failed to create fully connected operator: packed weights must not be NULL");
+    return qnnp_status_invalid_parameter;
+  }
+
+  return create_fully_connected_nc_q8(
+    input_channels, output_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale,
+    NULL, NULL, packed_weights,
+    output_zero_point, output_scale, output_min, output_max,
+    flags,
+    NULL /* threadpool */,
+    fully_connected_out);
+}
+
+/* Fewest input channels per slice of K, so that the 32-bit partial sums stay cheap to reduce */
+#define QNNP_SPLIT_K_MIN_SLICE 256
+
+/*
+ * Returns the input channels per slice when the reduction over K is split across threads, or 0 if it is not split.
+ * K is only split for the batches qnnp_run_operator computes with the single-row microkernel, and only when the
+ * output channel tiles of the whole batch can't keep every thread busy, e.g. a deep layer with few outputs at
+ * batch size 1. Slices are multiples of 8 channels, so that only the last one has a remainder.
+ */
+static size_t compute_split_k_slice(const struct qnnp_operator* fully_connected, size_t batch_size, pthreadpool_t threadpool)
+{
+  const size_t k = fully_connected->group_input_channels;
+  const size_t n = fully_connected->group_output_channels;
+  const size_t threads = qnnp_get_threads_count(fully_connected, threadpool);
+  if (fully_connected->q8conv.gemv_acc32 == NULL || 4 * batch_size > fully_connected->q8conv.mr || threads == 1) {
+    return 0;
+  }
+  const size_t tiles = batch_size * divide_round_up(n, fully_connected->q8conv.nr);
+  if (tiles >= threads) {
+    return 0;
+  }
+  const size_t slices = min(divide_round_up(threads, tiles), k / QNNP_SPLIT_K_MIN_SLICE);
+  if (slices < 2) {
+    return 0;
+  }
+  return round_up(divide_round_up(k, slices), 8);
+}
+
+static enum qnnp_status setup_fully_connected_nc_q8(
     qnnp_operator_t convolution,
     size_t batch_size,
     const uint8_t* input,
     size_t input_stride,
-    uint8_t* output,
+    void* output,
     size_t output_stride,
+    enum qnnp_accumulator_output accumulator_output,
     pthreadpool_t threadpool)
 {
+  const uint64_t setup_start = qnnp_profile_start();
   if (!qnnp_params.initialized) {
     qnnp_log_error("qnnp_setup_fully_connected_nc_q8 failed because QNNPACK is not properly initialized");
     return qnnp_status_uninitialized;
@@ -136,6 +364,22 @@ enum qnnp_status qnnp_setup_fully_connected_nc_q8(
     return qnnp_status_invalid_parameter;
   }
 
+  if (accumulator_output != qnnp_accumulator_output_none) {
+    if (convolution->type != qnnp_operator_type_fully_connected || convolution->format != qnnp_format_quint8) {
+      qnnp_log_error(
+        "failed to setup fully connected operator with accumulator outputs: "
+        "operator was not created by qnnp_create_fully_connected_nc_q8");
+      return qnnp_status_invalid_parameter;
+    }
+    if (convolution->q8conv.gemv_acc32 == NULL || convolution->q8conv.nr > QNNP_ACCUMULATOR_OUTPUT_MAX_NR) {
+      qnnp_log_error(
+        "failed to setup fully connected operator with accumulator outputs: "
+        "no single-row microkernel with 32-bit outputs supports the %s microkernels of the operator",
+        convolution->q8conv.name);
+      return qnnp_status_unsupported_parameter;
+    }
+  }
+
   convolution->batch_size = 1;
   convolution->input_height = batch_size;
   convolution->input_width = 1;
@@ -146,6 +390,301 @@ enum qnnp_status qnnp_setup_fully_connected_nc_q8(
   convolution->output_width = 1;
   convolution->output = output;
   convolution->output_pixel_stride = output_stride;
+  convolution->accumulator_output = accumulator_output;
+
+  /* Accumulator outputs already run on the single-row microkernels with 32-bit outputs, one row at a time */
+  const size_t split_k_slice = accumulator_output == qnnp_accumulator_output_none ?
+    compute_split_k_slice(convolution, batch_size, threadpool) : 0;
+  if (split_k_slice != 0) {
+    const size_t slices = divide_round_up(convolution->group_input_channels, split_k_slice);
+    const size_t split_k_buffer_size = sizeof(int32_t) * slices * batch_size * convolution->group_output_channels;
+    int32_t* split_k_buffer = qnnp_reallocate(convolution->split_k_buffer, split_k_buffer_size);
+    if (split_k_buffer == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for split-K partial sums", split_k_buffer_size);
+      return qnnp_status_out_of_memory;
+    }
+    convolution->split_k_buffer = split_k_buffer;
+  }
+  convolution->split_k_slice = split_k_slice;
+
+  qnnp_profile_phase(convolution, qnnp_profiling_phase_setup, setup_start);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_setup_fully_connected_nc_q8(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  return setup_fully_connected_nc_q8(
+    convolution, batch_size, input, input_stride, output, output_stride,
+    qnnp_accumulator_output_none, threadpool);
+}
+
+enum qnnp_status qnnp_setup_fully_connected_nc_q8_s32(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    int32_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  return setup_fully_connected_nc_q8(
+    convolution, batch_size, input, input_stride, output, output_stride,
+    qnnp_accumulator_output_int32, threadpool);
+}
+
+enum qnnp_status qnnp_setup_fully_connected_nc_q8_f32(
+    qnnp_operator_t convolution,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    float* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  return setup_fully_connected_nc_q8(
+    convolution, batch_size, input, input_stride, output, output_stride,
+    qnnp_accumulator_output_float32, threadpool);
+}
+
+enum qnnp_status qnnp_create_fully_connected_nc_f32(
+    size_t input_channels,
+    size_t output_channels,
+    const float* kernel,
+    const float* bias,
+    float output_min,
+    float output_max,
+    uint32_t create_flags,
+    qnnp_operator_t* fully_connected_out)
+{
+  qnnp_operator_t fully_connected = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_fully_connected_nc_f32 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (!(output_min < output_max)) {
+    qnnp_log_error(
+      "failed to create fully connected operator with [%.7g, %.7g] output range: "
+      "lower bound must be below upper bound",
+      output_min, output_max);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  fully_connected = calloc(1, sizeof(struct qnnp_operator));
+  if (fully_connected == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  fully_connected->sconv = qnnp_params.sconv;
+  const uint32_t nr = fully_connected->sconv.nr;
+  const size_t n_stride = (output_channels + (nr - 1)) & -nr;
+  const size_t packed_kernel_size = sizeof(float) * input_channels * n_stride;
+  const size_t bias_size = sizeof(float) * n_stride;
+
+  fully_connected->groups = 1;
+  fully_connected->group_input_channels = input_channels;
+  fully_connected->group_output_channels = output_channels;
+
+  fully_connected->fp32_clamping_params = (struct qnnp_fp32_clamping_params) {
+    .max = output_max,
+    .min = output_min,
+  };
+
+  fully_connected->type = qnnp_operator_type_fully_connected;
+  fully_connected->format = qnnp_format_float32;
+  fully_connected->flags = QNNP_CONVOLUTION_FLAG_GEMM;
+
+  status = qnnp_attach_new_packed_weights(fully_connected, kernel, bias, packed_kernel_size, bias_size);
+  if (status != qnnp_status_success) {
+    goto error;
+  }
+  if (!(create_flags & QNNP_CREATE_FLAG_LAZY_PACKING)) {
+    status = qnnp_ensure_packed_weights(fully_connected, NULL /* threadpool */);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+  }
+
+  *fully_connected_out = fully_connected;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(fully_connected);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_fully_connected_nc_f32(
+    qnnp_operator_t fully_connected,
+    size_t batch_size,
+    const float* input,
+    size_t input_stride,
+    float* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  const uint64_t setup_start = qnnp_profile_start();
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_fully_connected_nc_f32 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (fully_connected->format != qnnp_format_float32) {
+    qnnp_log_error("failed to setup fully connected operator: operator was not created by qnnp_create_fully_connected_nc_f32");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup fully connected operator with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  fully_connected->batch_size = 1;
+  fully_connected->input_height = batch_size;
+  fully_connected->input_width = 1;
+  fully_connected->input = input;
+  fully_connected->input_pixel_stride = input_stride;
+
+  fully_connected->output_height = batch_size;
+  fully_connected->output_width = 1;
+  fully_connected->output = output;
+  fully_connected->output_pixel_stride = output_stride;
+
+  qnnp_profile_phase(fully_connected, qnnp_profiling_phase_setup, setup_start);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_create_fully_connected_nc_f16(
+    size_t input_channels,
+    size_t output_channels,
+    const void* kernel,
+    const void* bias,
+    float output_min,
+    float output_max,
+    uint32_t create_flags,
+    qnnp_operator_t* fully_connected_out)
+{
+  qnnp_operator_t fully_connected = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_fully_connected_nc_f16 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_unsupported_hardware;
+
+  if (qnnp_params.hconv.gemm == NULL) {
+    qnnp_log_error("failed to create FP16 fully connected operator: hardware does not support FP16 arithmetic");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (!(output_min < output_max)) {
+    qnnp_log_error(
+      "failed to create fully connected operator with [%.7g, %.7g] output range: "
+      "lower bound must be below upper bound",
+      output_min, output_max);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  fully_connected = calloc(1, sizeof(struct qnnp_operator));
+  if (fully_connected == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  fully_connected->hconv = qnnp_params.hconv;
+  const uint32_t nr = fully_connected->hconv.nr;
+  const size_t n_stride = (output_channels + (nr - 1)) & -nr;
+  const size_t packed_kernel_size = sizeof(uint16_t) * input_channels * n_stride;
+  const size_t bias_size = sizeof(uint16_t) * n_stride;
+
+  fully_connected->groups = 1;
+  fully_connected->group_input_channels = input_channels;
+  fully_connected->group_output_channels = output_channels;
+
+  fully_connected->fp16_clamping_params = (struct qnnp_fp16_clamping_params) {
+    .scale = UINT16_C(0x3C00) /* 1.0 */,
+    .max = fp16_ieee_from_fp32_value(output_max),
+    .min = fp16_ieee_from_fp32_value(output_min),
+  };
+
+  fully_connected->type = qnnp_operator_type_fully_connected;
+  fully_connected->format = qnnp_format_float16;
+  fully_connected->flags = QNNP_CONVOLUTION_FLAG_GEMM;
+
+  status = qnnp_attach_new_packed_weights(fully_connected, kernel, bias, packed_kernel_size, bias_size);
+  if (status != qnnp_status_success) {
+    goto error;
+  }
+  if (!(create_flags & QNNP_CREATE_FLAG_LAZY_PACKING)) {
+    status = qnnp_ensure_packed_weights(fully_connected, NULL /* threadpool */);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+  }
+
+  *fully_connected_out = fully_connected;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(fully_connected);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_fully_connected_nc_f16(
+    qnnp_operator_t fully_connected,
+    size_t batch_size,
+    const void* input,
+    size_t input_stride,
+    void* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  const uint64_t setup_start = qnnp_profile_start();
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_fully_connected_nc_f16 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (fully_connected->format != qnnp_format_float16) {
+    qnnp_log_error("failed to setup fully connected operator: operator was not created by qnnp_create_fully_connected_nc_f16");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup fully connected operator with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  fully_connected->batch_size = 1;
+  fully_connected->input_height = batch_size;
+  fully_connected->input_width = 1;
+  fully_connected->input = input;
+  fully_connected->input_pixel_stride = input_stride;
+
+  fully_connected->output_height = batch_size;
+  fully_connected->output_width = 1;
+  fully_connected->output = output;
+  fully_connected->output_pixel_stride = output_stride;
 
+  qnnp_profile_phase(fully_connected, qnnp_profiling_phase_setup, setup_start);
   return qnnp_status_success;
 }
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+#include <qnnpack/requantization.h>
+
+
+enum qnnp_status qnnp_create_global_average_pooling_nwc_q8(
+    size_t channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* global_average_pooling_out)
+{
+  qnnp_operator_t global_average_pooling = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_global_average_pooling_nwc_q8 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (channels == 0) {
+    qnnp_log_error(
+      "failed to create global average pooling operator with %zu channels: number of channels must be non-zero",
+      channels);
+    goto error;
+  }
+
+  if (!(input_scale > 0.0f && isnormal(input_scale)) || !(output_scale > 0.0f && isnormal(output_scale))) {
+    qnnp_log_error(
+      "failed to create global average pooling operator with %.7g input scale and %.7g output scale: "
+      "scales must be finite, normalized, and positive",
+      input_scale, output_scale);
+    goto error;
+  }
+
+  if (output_min >= output_max) {
+    qnnp_log_error(
+      "failed to create global average pooling operator with [%" PRIu8 ", %" PRIu8 "] output range: "
+      "range min must be below range max",
+      output_min, output_max);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  global_average_pooling = calloc(1, sizeof(struct qnnp_operator));
+  if (global_average_pooling == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  global_average_pooling->channels = channels;
+  global_average_pooling->input_zero_point = input_zero_point;
+  /* Divided by the pooling width, which is only known at setup, to get the scale of requantization_params */
+  global_average_pooling->requantization_scale = input_scale / output_scale;
+  global_average_pooling->output_zero_point = output_zero_point;
+  global_average_pooling->output_min = output_min;
+  global_average_pooling->output_max = output_max;
+
+  global_average_pooling->type = qnnp_operator_type_global_average_pooling;
+  global_average_pooling->format = qnnp_format_quint8;
+
+  *global_average_pooling_out = global_average_pooling;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(global_average_pooling);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_global_average_pooling_nwc_q8(
+    qnnp_operator_t global_average_pooling,
+    size_t batch_size,
+    size_t width,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_global_average_pooling_nwc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error(
+      "failed to setup global average pooling operator with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (width == 0) {
+    qnnp_log_error("failed to setup global average pooling operator with width %zu: width must be non-zero", width);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t channels = global_average_pooling->channels;
+  if (input_stride < channels || output_stride < channels) {
+    qnnp_log_error(
+      "failed to setup global average pooling operator with %zu input stride and %zu output stride: "
+      "strides must be at least the %zu channels",
+      input_stride, output_stride, channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  /* Accumulators hold the sum of width inputs less zero point in 32 bits */
+  if (width > (size_t) (INT32_MAX / UINT8_MAX)) {
+    qnnp_log_error(
+      "failed to setup global average pooling operator with width %zu: width must not exceed %d",
+      width, INT32_MAX / UINT8_MAX);
+    return qnnp_status_unsupported_parameter;
+  }
+
+  const float requantization_scale = global_average_pooling->requantization_scale / (float) width;
+  if (requantization_scale >= 1.0f) {
+    qnnp_log_error(
+      "failed to setup global average pooling operator with width %zu and %.7g input-to-output scale ratio: "
+      "requantization scale %.7g is greater or equal to 1.0",
+      width, global_average_pooling->requantization_scale, requantization_scale);
+    return qnnp_status_unsupported_parameter;
+  }
+  if (requantization_scale < 0x1.0p-32f) {
+    qnnp_log_error(
+      "failed to setup global average pooling operator with width %zu and %.7g input-to-output scale ratio: "
+      "requantization scale %.7g is below 2**-32",
+      width, global_average_pooling->requantization_scale, requantization_scale);
+    return qnnp_status_unsupported_parameter;
+  }
+
+  global_average_pooling->batch_size = batch_size;
+  global_average_pooling->input_height = 1;
+  global_average_pooling->input_width = width;
+  global_average_pooling->input = input;
+  global_average_pooling->input_pixel_stride = input_stride;
+
+  global_average_pooling->output_height = 1;
+  global_average_pooling->output_width = 1;
+  global_average_pooling->output = output;
+  global_average_pooling->output_pixel_stride = output_stride;
+
+  global_average_pooling->requantization_params =
+    qnnp_compute_requantization_params(
+      requantization_scale,
+      global_average_pooling->output_zero_point,
+      global_average_pooling->output_min,
+      global_average_pooling->output_max);
+
+  return qnnp_status_success;
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <arm_neon.h>
+
+#include <qnnpack/hconv.h>
+
+
+void hconv_ukernel_8x8__neonfp16arith(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const void**restrict a,
+    const void*restrict b,
+    const void*restrict bias,
+    void*restrict c,
+    size_t c_stride,
+    const struct qnnp_fp16_clamping_params clamping_params[restrict static 1])
+{
+  float16x8_t vacc0x01234567 = vld1q_f16(bias);
+  float16x8_t vacc1x01234567 = vacc0x01234567;
+  float16x8_t vacc2x01234567 = vacc0x01234567;
+  float16x8_t vacc3x01234567 = vacc0x01234567;
+  float16x8_t vacc4x01234567 = vacc0x01234567;
+  float16x8_t vacc5x01234567 = vacc0x01234567;
+  float16x8_t vacc6x01234567 = vacc0x01234567;
+  float16x8_t vacc7x01234567 = vacc0x01234567;
+
+  do {
+    const __fp16* restrict a0 = (const __fp16*) *a++;
+    const __fp16* restrict a1 = (const __fp16*) *a++;
+    const __fp16* restrict a2 = (const __fp16*) *a++;
+    const __fp16* restrict a3 = (const __fp16*) *a++;
+    const __fp16* restrict a4 = (const __fp16*) *a++;
+    const __fp16* restrict a5 = (const __fp16*) *a++;
+    const __fp16* restrict a6 = (const __fp16*) *a++;
+    const __fp16* restrict a7 = (const __fp16*) *a++;
+
+    size_t k = kc;
+    do {
+      const float16x8_t va0 = vld1q_dup_f16(a0); a0 += 1;
+      const float16x8_t va1 = vld1q_dup_f16(a1); a1 += 1;
+      const float16x8_t va2 = vld1q_dup_f16(a2); a2 += 1;
+      const float16x8_t va3 = vld1q_dup_f16(a3); a3 += 1;
+      const float16x8_t va4 = vld1q_dup_f16(a4); a4 += 1;
+      const float16x8_t va5 = vld1q_dup_f16(a5); a5 += 1;
+      const float16x8_t va6 = vld1q_dup_f16(a6); a6 += 1;
+      const float16x8_t va7 = vld1q_dup_f16(a7); a7 += 1;
+
+      const float16x8_t vb01234567 = vld1q_f16(b); b += 16;
+
+      vacc0x01234567 = vfmaq_f16(vacc0x01234567, vb01234567, va0);
+      vacc1x01234567 = vfmaq_f16(vacc1x01234567, vb01234567, va1);
+      vacc2x01234567 = vfmaq_f16(vacc2x01234567, vb01234567, va2);
+      vacc3x01234567 = vfmaq_f16(vacc3x01234567, vb01234567, va3);
+      vacc4x01234567 = vfmaq_f16(vacc4x01234567, vb01234567, va4);
+      vacc5x01234567 = vfmaq_f16(vacc5x01234567, vb01234567, va5);
+      vacc6x01234567 = vfmaq_f16(vacc6x01234567, vb01234567, va6);
+      vacc7x01234567 = vfmaq_f16(vacc7x01234567, vb01234567, va7);
+    } while (--k != 0);
+  } while (--ks != 0);
+
+  const float16x8_t vscale = vld1q_dup_f16((const __fp16*) &clamping_params->scale);
+  vacc0x01234567 = vmulq_f16(vacc0x01234567, vscale);
+  vacc1x01234567 = vmulq_f16(vacc1x01234567, vscale);
+  vacc2x01234567 = vmulq_f16(vacc2x01234567, vscale);
+  vacc3x01234567 = vmulq_f16(vacc3x01234567, vscale);
+  vacc4x01234567 = vmulq_f16(vacc4x01234567, vscale);
+  vacc5x01234567 = vmulq_f16(vacc5x01234567, vscale);
+  vacc6x01234567 = vmulq_f16(vacc6x01234567, vscale);
+  vacc7x01234567 = vmulq_f16(vacc7x01234567, vscale);
+
+  const float16x8_t vmax = vld1q_dup_f16((const __fp16*) &clamping_params->max);
+  vacc0x01234567 = vminq_f16(vacc0x01234567, vmax);
+  vacc1x01234567 = vminq_f16(vacc1x01234567, vmax);
+  vacc2x01234567 = vminq_f16(vacc2x01234567, vmax);
+  vacc3x01234567 = vminq_f16(vacc3x01234567, vmax);
+  vacc4x01234567 = vminq_f16(vacc4x01234567, vmax);
+  vacc5x01234567 = vminq_f16(vacc5x01234567, vmax);
+  vacc6x01234567 = vminq_f16(vacc6x01234567, vmax);
+  vacc7x01234567 = vminq_f16(vacc7x01234567, vmax);
+
+  const float16x8_t vmin = vld1q_dup_f16((const __fp16*) &clamping_params->min);
+  vacc0x01234567 = vmaxq_f16(vacc0x01234567, vmin);
+  vacc1x01234567 = vmaxq_f16(vacc1x01234567, vmin);
+  vacc2x01234567 = vmaxq_f16(vacc2x01234567, vmin);
+  vacc3x01234567 = vmaxq_f16(vacc3x01234567, vmin);
+  vacc4x01234567 = vmaxq_f16(vacc4x01234567, vmin);
+  vacc5x01234567 = vmaxq_f16(vacc5x01234567, vmin);
+  vacc6x01234567 = vmaxq_f16(vacc6x01234567, vmin);
+  vacc7x01234567 = vmaxq_f16(vacc7x01234567, vmin);
+
+  __fp16* c0 = c;
+  __fp16* c1 = (__fp16*) ((uintptr_t) c0 + c_stride);
+  if (mr < 2) {
+    c1 = c0;
+  }
+  __fp16* c2 = (__fp16*) ((uintptr_t) c1 + c_stride);
+  if (mr <= 2) {
+    c2 = c1;
+  }
+  __fp16* c3 = (__fp16*) ((uintptr_t) c2 + c_stride);
+  if (mr < 4) {
+    c3 = c2;
+  }
+  __fp16* c4 = (__fp16*) ((uintptr_t) c3 + c_stride);
+  if (mr <= 4) {
+    c4 = c3;
+  }
+  __fp16* c5 = (__fp16*) ((uintptr_t) c4 + c_stride);
+  if (mr < 6) {
+    c5 = c4;
+  }
+  __fp16* c6 = (__fp16*) ((uintptr_t) c5 + c_stride);
+  if (mr <= 6) {
+    c6 = c5;
+  }
+  __fp16* c7 = (__fp16*) ((uintptr_t) c6 + c_stride);
+  if (mr != 8) {
+    c7 = c6;
+  }
+  if (nr == 8) {
+    vst1q_f16(c0, vacc0x01234567);
+    vst1q_f16(c1, vacc1x01234567);
+    vst1q_f16(c2, vacc2x01234567);
+    vst1q_f16(c3, vacc3x01234567);
+    vst1q_f16(c4, vacc4x01234567);
+    vst1q_f16(c5, vacc5x01234567);
+    vst1q_f16(c6, vacc6x01234567);
+    vst1q_f16(c7, vacc7x01234567);
+  } else {
+    if (nr >= 4) {
+      vst1_f16(c0, vget_low_f16(vacc0x01234567)); c0 += 4;
+      vst1_f16(c1, vget_low_f16(vacc1x01234567)); c1 += 4;
+      vst1_f16(c2, vget_low_f16(vacc2x01234567)); c2 += 4;
+      vst1_f16(c3, vget_low_f16(vacc3x01234567)); c3 += 4;
+      vst1_f16(c4, vget_low_f16(vacc4x01234567)); c4 += 4;
+      vst1_f16(c5, vget_low_f16(vacc5x01234567)); c5 += 4;
+      vst1_f16(c6, vget_low_f16(vacc6x01234567)); c6 += 4;
+      vst1_f16(c7, vget_low_f16(vacc7x01234567)); c7 += 4;
+      vacc0x01234567 = vextq_f16(vacc0x01234567, vacc0x01234567, 4);
+      vacc1x01234567 = vextq_f16(vacc1x01234567, vacc1x01234567, 4);
+      vacc2x01234567 = vextq_f16(vacc2x01234567, vacc2x01234567, 4);
+      vacc3x01234567 = vextq_f16(vacc3x01234567, vacc3x01234567, 4);
+      vacc4x01234567 = vextq_f16(vacc4x01234567, vacc4x01234567, 4);
+      vacc5x01234567 = vextq_f16(vacc5x01234567, vacc5x01234567, 4);
+      vacc6x01234567 = vextq_f16(vacc6x01234567, vacc6x01234567, 4);
+      vacc7x01234567 = vextq_f16(vacc7x01234567, vacc7x01234567, 4);
+      nr -= 4;
+    }
+    if (nr >= 2) {
+      vst1_lane_u32(__builtin_assume_aligned(c0, 1), vreinterpret_u32_f16(vget_low_f16(vacc0x01234567)), 0); c0 += 2;
+      vst1_lane_u32(__builtin_assume_aligned(c1, 1), vreinterpret_u32_f16(vget_low_f16(vacc1x01234567)), 0); c1 += 2;
+      vst1_lane_u32(__builtin_assume_aligned(c2, 1), vreinterpret_u32_f16(vget_low_f16(vacc2x01234567)), 0); c2 += 2;
+      vst1_lane_u32(__builtin_assume_aligned(c3, 1), vreinterpret_u32_f16(vget_low_f16(vacc3x01234567)), 0); c3 += 2;
+      vst1_lane_u32(__builtin_assume_aligned(c4, 1), vreinterpret_u32_f16(vget_low_f16(vacc4x01234567)), 0); c4 += 2;
+      vst1_lane_u32(__builtin_assume_aligned(c5, 1), vreinterpret_u32_f16(vget_low_f16(vacc5x01234567)), 0); c5 += 2;
+      vst1_lane_u32(__builtin_assume_aligned(c6, 1), vreinterpret_u32_f16(vget_low_f16(vacc6x01234567)), 0); c6 += 2;
+      vst1_lane_u32(__builtin_assume_aligned(c7, 1), vreinterpret_u32_f16(vget_low_f16(vacc7x01234567)), 0); c7 += 2;
+      vacc0x01234567 = vextq_f16(vacc0x01234567, vacc0x01234567, 2);
+      vacc1x01234567 = vextq_f16(vacc1x01234567, vacc1x01234567, 2);
+      vacc2x01234567 = vextq_f16(vacc2x01234567, vacc2x01234567, 2);
+      vacc3x01234567 = vextq_f16(vacc3x01234567, vacc3x01234567, 2);
+      vacc4x01234567 = vextq_f16(vacc4x01234567, vacc4x01234567, 2);
+      vacc5x01234567 = vextq_f16(vacc5x01234567, vacc5x01234567, 2);
+      vacc6x01234567 = vextq_f16(vacc6x01234567, vacc6x01234567, 2);
+      vacc7x01234567 = vextq_f16(vacc7x01234567, vacc7x01234567, 2);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      vst1q_lane_f16(c0, vacc0x01234567, 0);
+      vst1q_lane_f16(c1, vacc1x01234567, 0);
+      vst1q_lane_f16(c2, vacc2x01234567, 0);
+      vst1q_lane_f16(c3, vacc3x01234567, 0);
+      vst1q_lane_f16(c4, vacc4x01234567, 0);
+      vst1q_lane_f16(c5, vacc5x01234567, 0);
+      vst1q_lane_f16(c6, vacc6x01234567, 0);
+      vst1q_lane_f16(c7, vacc7x01234567, 0);
+    }
+  }
+}
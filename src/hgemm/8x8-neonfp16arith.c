@@ -75,53 +75,53 @@ void hgemm_ukernel_8x8__neonfp16arith(
     {
       const float16x8_t vb01234567 = vld1q_f16(b); b += 16;
 
-      vacc0x01234567 = vmlaq_lane_f16(vacc0x01234567, vb01234567, va0, 0);
-      vacc1x01234567 = vmlaq_lane_f16(vacc1x01234567, vb01234567, va1, 0);
-      vacc2x01234567 = vmlaq_lane_f16(vacc2x01234567, vb01234567, va2, 0);
-      vacc3x01234567 = vmlaq_lane_f16(vacc3x01234567, vb01234567, va3, 0);
-      vacc4x01234567 = vmlaq_lane_f16(vacc4x01234567, vb01234567, va4, 0);
-      vacc5x01234567 = vmlaq_lane_f16(vacc5x01234567, vb01234567, va5, 0);
-      vacc6x01234567 = vmlaq_lane_f16(vacc6x01234567, vb01234567, va6, 0);
-      vacc7x01234567 = vmlaq_lane_f16(vacc7x01234567, vb01234567, va7, 0);
+      vacc0x01234567 = vfmaq_lane_f16(vacc0x01234567, vb01234567, va0, 0);
+      vacc1x01234567 = vfmaq_lane_f16(vacc1x01234567, vb01234567, va1, 0);
+      vacc2x01234567 = vfmaq_lane_f16(vacc2x01234567, vb01234567, va2, 0);
+      vacc3x01234567 = vfmaq_lane_f16(vacc3x01234567, vb01234567, va3, 0);
+      vacc4x01234567 = vfmaq_lane_f16(vacc4x01234567, vb01234567, va4, 0);
+      vacc5x01234567 = vfmaq_lane_f16(vacc5x01234567, vb01234567, va5, 0);
+      vacc6x01234567 = vfmaq_lane_f16(vacc6x01234567, vb01234567, va6, 0);
+      vacc7x01234567 = vfmaq_lane_f16(vacc7x01234567, vb01234567, va7, 0);
     }
 
     {
       const float16x8_t vb01234567 = vld1q_f16(b); b += 16;
 
-      vacc0x01234567 = vmlaq_lane_f16(vacc0x01234567, vb01234567, va0, 1);
-      vacc1x01234567 = vmlaq_lane_f16(vacc1x01234567, vb01234567, va1, 1);
-      vacc2x01234567 = vmlaq_lane_f16(vacc2x01234567, vb01234567, va2, 1);
-      vacc3x01234567 = vmlaq_lane_f16(vacc3x01234567, vb01234567, va3, 1);
-      vacc4x01234567 = vmlaq_lane_f16(vacc4x01234567, vb01234567, va4, 1);
-      vacc5x01234567 = vmlaq_lane_f16(vacc5x01234567, vb01234567, va5, 1);
-      vacc6x01234567 = vmlaq_lane_f16(vacc6x01234567, vb01234567, va6, 1);
-      vacc7x01234567 = vmlaq_lane_f16(vacc7x01234567, vb01234567, va7, 1);
+      vacc0x01234567 = vfmaq_lane_f16(vacc0x01234567, vb01234567, va0, 1);
+      vacc1x01234567 = vfmaq_lane_f16(vacc1x01234567, vb01234567, va1, 1);
+      vacc2x01234567 = vfmaq_lane_f16(vacc2x01234567, vb01234567, va2, 1);
+      vacc3x01234567 = vfmaq_lane_f16(vacc3x01234567, vb01234567, va3, 1);
+      vacc4x01234567 = vfmaq_lane_f16(vacc4x01234567, vb01234567, va4, 1);
+      vacc5x01234567 = vfmaq_lane_f16(vacc5x01234567, vb01234567, va5, 1);
+      vacc6x01234567 = vfmaq_lane_f16(vacc6x01234567, vb01234567, va6, 1);
+      vacc7x01234567 = vfmaq_lane_f16(vacc7x01234567, vb01234567, va7, 1);
     }
 
     {
       const float16x8_t vb01234567 = vld1q_f16(b); b += 16;
 
-      vacc0x01234567 = vmlaq_lane_f16(vacc0x01234567, vb01234567, va0, 2);
-      vacc1x01234567 = vmlaq_lane_f16(vacc1x01234567, vb01234567, va1, 2);
-      vacc2x01234567 = vmlaq_lane_f16(vacc2x01234567, vb01234567, va2, 2);
-      vacc3x01234567 = vmlaq_lane_f16(vacc3x01234567, vb01234567, va3, 2);
-      vacc4x01234567 = vmlaq_lane_f16(vacc4x01234567, vb01234567, va4, 2);
-      vacc5x01234567 = vmlaq_lane_f16(vacc5x01234567, vb01234567, va5, 2);
-      vacc6x01234567 = vmlaq_lane_f16(vacc6x01234567, vb01234567, va6, 2);
-      vacc7x01234567 = vmlaq_lane_f16(vacc7x01234567, vb01234567, va7, 2);
+      vacc0x01234567 = vfmaq_lane_f16(vacc0x01234567, vb01234567, va0, 2);
+      vacc1x01234567 = vfmaq_lane_f16(vacc1x01234567, vb01234567, va1, 2);
+      vacc2x01234567 = vfmaq_lane_f16(vacc2x01234567, vb01234567, va2, 2);
+      vacc3x01234567 = vfmaq_lane_f16(vacc3x01234567, vb01234567, va3, 2);
+      vacc4x01234567 = vfmaq_lane_f16(vacc4x01234567, vb01234567, va4, 2);
+      vacc5x01234567 = vfmaq_lane_f16(vacc5x01234567, vb01234567, va5, 2);
+      vacc6x01234567 = vfmaq_lane_f16(vacc6x01234567, vb01234567, va6, 2);
+      vacc7x01234567 = vfmaq_lane_f16(vacc7x01234567, vb01234567, va7, 2);
     }
 
     {
       const float16x8_t vb01234567 = vld1q_f16(b); b += 16;
 
-      vacc0x01234567 = vmlaq_lane_f16(vacc0x01234567, vb01234567, va0, 3);
-      vacc1x01234567 = vmlaq_lane_f16(vacc1x01234567, vb01234567, va1, 3);
-      vacc2x01234567 = vmlaq_lane_f16(vacc2x01234567, vb01234567, va2, 3);
-      vacc3x01234567 = vmlaq_lane_f16(vacc3x01234567, vb01234567, va3, 3);
-      vacc4x01234567 = vmlaq_lane_f16(vacc4x01234567, vb01234567, va4, 3);
-      vacc5x01234567 = vmlaq_lane_f16(vacc5x01234567, vb01234567, va5, 3);
-      vacc6x01234567 = vmlaq_lane_f16(vacc6x01234567, vb01234567, va6, 3);
-      vacc7x01234567 = vmlaq_lane_f16(vacc7x01234567, vb01234567, va7, 3);
+      vacc0x01234567 = vfmaq_lane_f16(vacc0x01234567, vb01234567, va0, 3);
+      vacc1x01234567 = vfmaq_lane_f16(vacc1x01234567, vb01234567, va1, 3);
+      vacc2x01234567 = vfmaq_lane_f16(vacc2x01234567, vb01234567, va2, 3);
+      vacc3x01234567 = vfmaq_lane_f16(vacc3x01234567, vb01234567, va3, 3);
+      vacc4x01234567 = vfmaq_lane_f16(vacc4x01234567, vb01234567, va4, 3);
+      vacc5x01234567 = vfmaq_lane_f16(vacc5x01234567, vb01234567, va5, 3);
+      vacc6x01234567 = vfmaq_lane_f16(vacc6x01234567, vb01234567, va6, 3);
+      vacc7x01234567 = vfmaq_lane_f16(vacc7x01234567, vb01234567, va7, 3);
     }
   }
   if (k != 0) {
@@ -147,51 +147,51 @@ void hgemm_ukernel_8x8__neonfp16arith(
     {
       const float16x8_t vb01234567 = vld1q_f16(b); b += 16;
 
-      vacc0x01234567 = vmlaq_lane_f16(vacc0x01234567, vb01234567, va0, 0);
-      vacc1x01234567 = vmlaq_lane_f16(vacc1x01234567, vb01234567, va1, 0);
-      vacc2x01234567 = vmlaq_lane_f16(vacc2x01234567, vb01234567, va2, 0);
-      vacc3x01234567 = vmlaq_lane_f16(vacc3x01234567, vb01234567, va3, 0);
-      vacc4x01234567 = vmlaq_lane_f16(vacc4x01234567, vb01234567, va4, 0);
-      vacc5x01234567 = vmlaq_lane_f16(vacc5x01234567, vb01234567, va5, 0);
-      vacc6x01234567 = vmlaq_lane_f16(vacc6x01234567, vb01234567, va6, 0);
-      vacc7x01234567 = vmlaq_lane_f16(vacc7x01234567, vb01234567, va7, 0);
+      vacc0x01234567 = vfmaq_lane_f16(vacc0x01234567, vb01234567, va0, 0);
+      vacc1x01234567 = vfmaq_lane_f16(vacc1x01234567, vb01234567, va1, 0);
+      vacc2x01234567 = vfmaq_lane_f16(vacc2x01234567, vb01234567, va2, 0);
+      vacc3x01234567 = vfmaq_lane_f16(vacc3x01234567, vb01234567, va3, 0);
+      vacc4x01234567 = vfmaq_lane_f16(vacc4x01234567, vb01234567, va4, 0);
+      vacc5x01234567 = vfmaq_lane_f16(vacc5x01234567, vb01234567, va5, 0);
+      vacc6x01234567 = vfmaq_lane_f16(vacc6x01234567, vb01234567, va6, 0);
+      vacc7x01234567 = vfmaq_lane_f16(vacc7x01234567, vb01234567, va7, 0);
     }
 
     if (k >= 2) {
       const float16x8_t vb01234567 = vld1q_f16(b); b += 16;
 
-      vacc0x01234567 = vmlaq_lane_f16(vacc0x01234567, vb01234567, va0, 1);
-      vacc1x01234567 = vmlaq_lane_f16(vacc1x01234567, vb01234567, va1, 1);
-      vacc2x01234567 = vmlaq_lane_f16(vacc2x01234567, vb01234567, va2, 1);
-      vacc3x01234567 = vmlaq_lane_f16(vacc3x01234567, vb01234567, va3, 1);
-      vacc4x01234567 = vmlaq_lane_f16(vacc4x01234567, vb01234567, va4, 1);
-      vacc5x01234567 = vmlaq_lane_f16(vacc5x01234567, vb01234567, va5, 1);
-      vacc6x01234567 = vmlaq_lane_f16(vacc6x01234567, vb01234567, va6, 1);
-      vacc7x01234567 = vmlaq_lane_f16(vacc7x01234567, vb01234567, va7, 1);
+      vacc0x01234567 = vfmaq_lane_f16(vacc0x01234567, vb01234567, va0, 1);
+      vacc1x01234567 = vfmaq_lane_f16(vacc1x01234567, vb01234567, va1, 1);
+      vacc2x01234567 = vfmaq_lane_f16(vacc2x01234567, vb01234567, va2, 1);
+      vacc3x01234567 = vfmaq_lane_f16(vacc3x01234567, vb01234567, va3, 1);
+      vacc4x01234567 = vfmaq_lane_f16(vacc4x01234567, vb01234567, va4, 1);
+      vacc5x01234567 = vfmaq_lane_f16(vacc5x01234567, vb01234567, va5, 1);
+      vacc6x01234567 = vfmaq_lane_f16(vacc6x01234567, vb01234567, va6, 1);
+      vacc7x01234567 = vfmaq_lane_f16(vacc7x01234567, vb01234567, va7, 1);
 
       if (k > 2) {
         const float16x8_t vb01234567 = vld1q_f16(b); b += 16;
 
-        vacc0x01234567 = vmlaq_lane_f16(vacc0x01234567, vb01234567, va0, 2);
-        vacc1x01234567 = vmlaq_lane_f16(vacc1x01234567, vb01234567, va1, 2);
-        vacc2x01234567 = vmlaq_lane_f16(vacc2x01234567, vb01234567, va2, 2);
-        vacc3x01234567 = vmlaq_lane_f16(vacc3x01234567, vb01234567, va3, 2);
-        vacc4x01234567 = vmlaq_lane_f16(vacc4x01234567, vb01234567, va4, 2);
-        vacc5x01234567 = vmlaq_lane_f16(vacc5x01234567, vb01234567, va5, 2);
-        vacc6x01234567 = vmlaq_lane_f16(vacc6x01234567, vb01234567, va6, 2);
-        vacc7x01234567 = vmlaq_lane_f16(vacc7x01234567, vb01234567, va7, 2);
+        vacc0x01234567 = vfmaq_lane_f16(vacc0x01234567, vb01234567, va0, 2);
+        vacc1x01234567 = vfmaq_lane_f16(vacc1x01234567, vb01234567, va1, 2);
+        vacc2x01234567 = vfmaq_lane_f16(vacc2x01234567, vb01234567, va2, 2);
+        vacc3x01234567 = vfmaq_lane_f16(vacc3x01234567, vb01234567, va3, 2);
+        vacc4x01234567 = vfmaq_lane_f16(vacc4x01234567, vb01234567, va4, 2);
+        vacc5x01234567 = vfmaq_lane_f16(vacc5x01234567, vb01234567, va5, 2);
+        vacc6x01234567 = vfmaq_lane_f16(vacc6x01234567, vb01234567, va6, 2);
+        vacc7x01234567 = vfmaq_lane_f16(vacc7x01234567, vb01234567, va7, 2);
 
         if (k >= 4) {
           const float16x8_t vb01234567 = vld1q_f16(b);
 
-          vacc0x01234567 = vmlaq_lane_f16(vacc0x01234567, vb01234567, va0, 3);
-          vacc1x01234567 = vmlaq_lane_f16(vacc1x01234567, vb01234567, va1, 3);
-          vacc2x01234567 = vmlaq_lane_f16(vacc2x01234567, vb01234567, va2, 3);
-          vacc3x01234567 = vmlaq_lane_f16(vacc3x01234567, vb01234567, va3, 3);
-          vacc4x01234567 = vmlaq_lane_f16(vacc4x01234567, vb01234567, va4, 3);
-          vacc5x01234567 = vmlaq_lane_f16(vacc5x01234567, vb01234567, va5, 3);
-          vacc6x01234567 = vmlaq_lane_f16(vacc6x01234567, vb01234567, va6, 3);
-          vacc7x01234567 = vmlaq_lane_f16(vacc7x01234567, vb01234567, va7, 3);
+          vacc0x01234567 = vfmaq_lane_f16(vacc0x01234567, vb01234567, va0, 3);
+          vacc1x01234567 = vfmaq_lane_f16(vacc1x01234567, vb01234567, va1, 3);
+          vacc2x01234567 = vfmaq_lane_f16(vacc2x01234567, vb01234567, va2, 3);
+          vacc3x01234567 = vfmaq_lane_f16(vacc3x01234567, vb01234567, va3, 3);
+          vacc4x01234567 = vfmaq_lane_f16(vacc4x01234567, vb01234567, va4, 3);
+          vacc5x01234567 = vfmaq_lane_f16(vacc5x01234567, vb01234567, va5, 3);
+          vacc6x01234567 = vfmaq_lane_f16(vacc6x01234567, vb01234567, va6, 3);
+          vacc7x01234567 = vfmaq_lane_f16(vacc7x01234567, vb01234567, va7, 3);
         }
       }
     }
@@ -9,103 +9,917 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 #include <pthread.h>
 
 #include <cpuinfo.h>
 #include <qnnpack.h>
+#include <qnnpack/allocator.h>
+#include <qnnpack/hconv.h>
+#include <qnnpack/hgemm.h>
 #include <qnnpack/log.h>
+#include <qnnpack/math.h>
 #include <qnnpack/params.h>
 #include <qnnpack/q8gemm.h>
 #include <qnnpack/q8conv.h>
 #include <qnnpack/q8dw.h>
+#include <qnnpack/q8avgpool.h>
+#include <qnnpack/q8gavgpool.h>
+#include <qnnpack/q8vadd.h>
+#include <qnnpack/q8vrescale.h>
+#include <qnnpack/q8vquantize.h>
+#include <qnnpack/q8vdequantize.h>
+#include <qnnpack/q8embedding.h>
+#include <qnnpack/requantization.h>
+#include <qnnpack/sconv.h>
+#include <qnnpack/sgemm.h>
+#include <qnnpack/u8maxpool.h>
+#include <qnnpack/u8bilinear.h>
+#include <qnnpack/u8lut32norm.h>
+#include <qnnpack/u8rmax.h>
+#include <qnnpack/x8lut.h>
+#include <qnnpack/x8zip.h>
+
+/* Bump when the candidate tables below change, so stale tuning results are rejected */
+#define QNNP_TUNING_RESULT_VERSION 1
+
+/* Assumed when cpuinfo does not report an L2 cache */
+#define QNNP_DEFAULT_L2_CACHE_SIZE (256 * 1024)
 
 static pthread_once_t init_guard = PTHREAD_ONCE_INIT;
 
+static struct qnnp_initialize_options init_options;
+static uint32_t q8conv_ukernel_index;
+
 struct qnnp_parameters qnnp_params = {
   .initialized = false
 };
 
-static void init(void) {
+struct q8conv_candidate {
+  struct q8conv_parameters parameters;
+  /* Rough relative throughput, from bench/q8gemm on representative cores */
+  uint32_t throughput;
+  /* NULL if the microkernel runs on any processor of the architecture */
+  bool (*is_supported)(void);
+};
+
+/*
+ * GEMM/convolution microkernel pairs, in order of preference when autotuning is off.
+ * Only microkernels with both a GEMM and a convolution variant of the same tile can be candidates,
+ * because operators pack weights once for both.
+ */
 #if CPUINFO_ARCH_ARM
-  if (!cpuinfo_has_arm_neon()) {
-    qnnp_log_error("QNNPACK initialization failed: NEON is not supported");
-    return;
-  }
-  qnnp_params.q8conv = (struct q8conv_parameters) {
+static const struct q8conv_candidate q8conv_candidates[] = {
+  {
+    .parameters = {
       .gemm = q8gemm_ukernel_4x8__aarch32_neon,
       .conv = q8conv_ukernel_4x8__aarch32_neon,
+      .acc16_gemm = q8gemm_acc16_ukernel_4x8__neon,
+      .gemv = q8gemm_ukernel_1x8__neon,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__neon,
+      .name = "4x8__aarch32_neon",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+    },
+    .throughput = 6,
+  },
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_4x8__neon,
+      .conv = q8conv_ukernel_4x8__neon,
+      .folded_gemm = q8gemm_folded_ukernel_4x8__neon,
+      .folded_conv = q8conv_folded_ukernel_4x8__neon,
+      .relu_gemm = q8gemm_relu_ukernel_4x8__neon,
+      .relu_conv = q8conv_relu_ukernel_4x8__neon,
+      .unclamped_gemm = q8gemm_unclamped_ukernel_4x8__neon,
+      .unclamped_conv = q8conv_unclamped_ukernel_4x8__neon,
+      .xzp_conv = q8conv_xzp_ukernel_4x8__neon,
+      .acc16_gemm = q8gemm_acc16_ukernel_4x8__neon,
+      .gemv = q8gemm_ukernel_1x8__neon,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__neon,
+      .name = "4x8__neon",
       .mr = 4,
       .nr = 8,
       .kr = 1,
+    },
+    .throughput = 5,
+  },
+};
+#elif CPUINFO_ARCH_ARM64
+static bool has_arm_neon_dot(void) {
+  return cpuinfo_has_arm_neon_dot();
+}
+
+static const struct q8conv_candidate q8conv_candidates[] = {
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_4x8c4__neondot,
+      .conv = q8conv_ukernel_4x8c4__neondot,
+      .name = "4x8c4__neondot",
+      .mr = 4,
+      .nr = 8,
+      .kr = 4,
+    },
+    .throughput = 20,
+    .is_supported = has_arm_neon_dot,
+  },
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_8x8__aarch64_neon,
+      .conv = q8conv_ukernel_8x8__aarch64_neon,
+      .acc16_gemm = q8gemm_acc16_ukernel_8x8__neon,
+      .gemv = q8gemm_ukernel_1x8__neon,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__neon,
+      .name = "8x8__aarch64_neon",
+      .mr = 8,
+      .nr = 8,
+      .kr = 1,
+    },
+    .throughput = 8,
+  },
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_8x8__neon,
+      .conv = q8conv_ukernel_8x8__neon,
+      .acc16_gemm = q8gemm_acc16_ukernel_8x8__neon,
+      .gemv = q8gemm_ukernel_1x8__neon,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__neon,
+      .name = "8x8__neon",
+      .mr = 8,
+      .nr = 8,
+      .kr = 1,
+    },
+    .throughput = 7,
+  },
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_4x8__neon,
+      .conv = q8conv_ukernel_4x8__neon,
+      .folded_gemm = q8gemm_folded_ukernel_4x8__neon,
+      .folded_conv = q8conv_folded_ukernel_4x8__neon,
+      .relu_gemm = q8gemm_relu_ukernel_4x8__neon,
+      .relu_conv = q8conv_relu_ukernel_4x8__neon,
+      .unclamped_gemm = q8gemm_unclamped_ukernel_4x8__neon,
+      .unclamped_conv = q8conv_unclamped_ukernel_4x8__neon,
+      .xzp_conv = q8conv_xzp_ukernel_4x8__neon,
+      .acc16_gemm = q8gemm_acc16_ukernel_4x8__neon,
+      .gemv = q8gemm_ukernel_1x8__neon,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__neon,
+      .name = "4x8__neon",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+    },
+    .throughput = 5,
+  },
+};
+#elif CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+static bool has_x86_avx512vnni(void) {
+  return cpuinfo_has_x86_avx512vnni() && cpuinfo_has_x86_avx512vl();
+}
+
+static bool has_x86_avx2(void) {
+  return cpuinfo_has_x86_avx2();
+}
+
+/*
+ * Throughputs are multiply-adds per nanosecond on full 4-row tiles with K = 1024, measured on an AVX512-VNNI server
+ * core. AVX2 does less than twice the work of SSE2 per cycle, so the 4-wide SSE2 tile wins for groups of 4 or fewer
+ * output channels, where the 8-wide tiles compute at least half padding.
+ */
+static const struct q8conv_candidate q8conv_candidates[] = {
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_4x8c4__avx512vnni,
+      .conv = q8conv_ukernel_4x8c4__avx512vnni,
+      .folded_gemm = q8gemm_folded_ukernel_4x8c4__avx512vnni,
+      .folded_conv = q8conv_folded_ukernel_4x8c4__avx512vnni,
+      .signed_gemm = q8gemm_signed_ukernel_4x8c4__avx512vnni,
+      .signed_conv = q8conv_signed_ukernel_4x8c4__avx512vnni,
+      .gemv = q8gemm_ukernel_1x8c4__avx512vnni,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8c4__avx512vnni,
+      .name = "4x8c4__avx512vnni",
+      .mr = 4,
+      .nr = 8,
+      .kr = 4,
+    },
+    .throughput = 73,
+    .is_supported = has_x86_avx512vnni,
+  },
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_4x8c2__avx2,
+      .conv = q8conv_ukernel_4x8c2__avx2,
+      .folded_gemm = q8gemm_folded_ukernel_4x8c2__avx2,
+      .folded_conv = q8conv_folded_ukernel_4x8c2__avx2,
+      .relu_gemm = q8gemm_relu_ukernel_4x8c2__avx2,
+      .relu_conv = q8conv_relu_ukernel_4x8c2__avx2,
+      .unclamped_gemm = q8gemm_unclamped_ukernel_4x8c2__avx2,
+      .unclamped_conv = q8conv_unclamped_ukernel_4x8c2__avx2,
+      .xzp_conv = q8conv_xzp_ukernel_4x8c2__avx2,
+      .signed_gemm = q8gemm_signed_ukernel_4x8c2__avx2,
+      .signed_conv = q8conv_signed_ukernel_4x8c2__avx2,
+      .gemv = q8gemm_ukernel_1x8c2__avx2,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8c2__avx2,
+      .name = "4x8c2__avx2",
+      .mr = 4,
+      .nr = 8,
+      .kr = 2,
+    },
+    .throughput = 34,
+    .is_supported = has_x86_avx2,
+  },
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_4x4c2__sse2,
+      .conv = q8conv_ukernel_4x4c2__sse2,
+      .folded_gemm = q8gemm_folded_ukernel_4x4c2__sse2,
+      .folded_conv = q8conv_folded_ukernel_4x4c2__sse2,
+      .relu_gemm = q8gemm_relu_ukernel_4x4c2__sse2,
+      .relu_conv = q8conv_relu_ukernel_4x4c2__sse2,
+      .unclamped_gemm = q8gemm_unclamped_ukernel_4x4c2__sse2,
+      .unclamped_conv = q8conv_unclamped_ukernel_4x4c2__sse2,
+      .xzp_conv = q8conv_xzp_ukernel_4x4c2__sse2,
+      .gemv = q8gemm_ukernel_1x4c2__sse2,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x4c2__sse2,
+      .name = "4x4c2__sse2",
+      .mr = 4,
+      .nr = 4,
+      .kr = 2,
+    },
+    .throughput = 18,
+  },
+};
+#else
+#if CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+static bool has_riscv_v(void) {
+  return cpuinfo_has_riscv_v();
+}
+#endif
+
+/*
+ * Other architectures, e.g. RISC-V or POWER, run the portable psimd microkernels, and RISC-V processors with the V
+ * extension the vector microkernels of the same tile. All of them pack weights like the 4x8 NEON microkernels.
+ */
+static const struct q8conv_candidate q8conv_candidates[] = {
+#if CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_4x8__rvv,
+      .conv = q8conv_ukernel_4x8__rvv,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__psimd,
+      .folded_gemm = q8gemm_folded_ukernel_4x8__psimd,
+      .folded_conv = q8conv_folded_ukernel_4x8__psimd,
+      .name = "4x8__rvv",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+    },
+    .throughput = 4,
+    .is_supported = has_riscv_v,
+  },
+#endif
+  {
+    .parameters = {
+      .gemm = q8gemm_ukernel_4x8__psimd,
+      .conv = q8conv_ukernel_4x8__psimd,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__psimd,
+      .folded_gemm = q8gemm_folded_ukernel_4x8__psimd,
+      .folded_conv = q8conv_folded_ukernel_4x8__psimd,
+      .name = "4x8__psimd",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+    },
+    .throughput = 1,
+  },
+};
+#endif
+
+#define Q8CONV_CANDIDATES_COUNT (sizeof(q8conv_candidates) / sizeof(q8conv_candidates[0]))
+
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+struct q8conv_uarch_replacement {
+  enum cpuinfo_uarch uarch;
+  q8gemm_ukernel_function gemm;
+  q8gemm_ukernel_function uarch_gemm;
+  q8conv_ukernel_function uarch_conv;
+};
+
+/*
+ * The hand-scheduled assembly microkernels interleave loads with multiply-accumulates for wide out-of-order cores.
+ * On in-order little cores of big.LITTLE systems threads use the intrinsics microkernels with the same tile instead.
+ */
+static const struct q8conv_uarch_replacement q8conv_uarch_replacements[] = {
+#if CPUINFO_ARCH_ARM
+  { cpuinfo_uarch_cortex_a53, q8gemm_ukernel_4x8__aarch32_neon, q8gemm_ukernel_4x8__neon, q8conv_ukernel_4x8__neon },
+  { cpuinfo_uarch_cortex_a55, q8gemm_ukernel_4x8__aarch32_neon, q8gemm_ukernel_4x8__neon, q8conv_ukernel_4x8__neon },
+#else
+  { cpuinfo_uarch_cortex_a53, q8gemm_ukernel_8x8__aarch64_neon, q8gemm_ukernel_8x8__neon, q8conv_ukernel_8x8__neon },
+  { cpuinfo_uarch_cortex_a55, q8gemm_ukernel_8x8__aarch64_neon, q8gemm_ukernel_8x8__neon, q8conv_ukernel_8x8__neon },
+#endif
+};
+
+static void init_q8conv_uarch_overrides(void) {
+  uint32_t overrides_count = 0;
+  /* Replacements only pay off when the system mixes core types; a homogeneous system keeps the tuned choice */
+  if (qnnp_params.uarchs_count > 1) {
+    for (uint32_t uarch_index = 0; uarch_index < qnnp_params.uarchs_count; uarch_index++) {
+      const enum cpuinfo_uarch uarch = cpuinfo_get_uarch(uarch_index)->uarch;
+      for (size_t i = 0; i < sizeof(q8conv_uarch_replacements) / sizeof(q8conv_uarch_replacements[0]); i++) {
+        const struct q8conv_uarch_replacement* replacement = &q8conv_uarch_replacements[i];
+        if (replacement->uarch == uarch && overrides_count < QNNP_MAX_Q8CONV_UARCH_OVERRIDES) {
+          for (uint32_t j = 0; j < Q8CONV_CANDIDATES_COUNT; j++) {
+            if (q8conv_candidates[j].parameters.gemm == replacement->gemm) {
+              qnnp_params.q8conv_uarch_overrides[overrides_count++] = (struct q8conv_uarch_override) {
+                .uarch_index = uarch_index,
+                .gemm = replacement->gemm,
+                .conv = q8conv_candidates[j].parameters.conv,
+                .uarch_gemm = replacement->uarch_gemm,
+                .uarch_conv = replacement->uarch_conv,
+              };
+            }
+          }
+        }
+      }
+    }
+  }
+  qnnp_params.q8conv_uarch_overrides_count = overrides_count;
+}
+#endif /* CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 */
+
+static bool is_q8conv_candidate_supported(uint32_t index) {
+  return index < Q8CONV_CANDIDATES_COUNT &&
+    (q8conv_candidates[index].is_supported == NULL || q8conv_candidates[index].is_supported());
+}
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * UINT64_C(1000000000) + (uint64_t) ts.tv_nsec;
+}
+
+/*
+ * Measures how long the GEMM microkernel takes to compute a 16x16 output block for a few K values typical of
+ * pointwise convolutions. Every K gets the same number of multiply-adds, so they weigh equally in the total.
+ * The convolution microkernel shares the inner loop and is assumed to rank the same.
+ * Returns UINT64_MAX if the buffers could not be allocated.
+ */
+static uint64_t benchmark_q8conv(const struct q8conv_parameters* parameters) {
+  static const size_t k_values[] = { 32, 256, 1024 };
+  const size_t max_k = 1024;
+  const size_t m = 16;
+  const size_t n = 16;
+  const size_t repeats = 3;
+
+  uint8_t* a = malloc(m * max_k);
+  uint8_t* b = malloc(n * max_k);
+  int32_t* bias = malloc(n * sizeof(int32_t));
+  uint8_t* c = malloc(m * n);
+  uint64_t total_ns = UINT64_MAX;
+  if (a == NULL || b == NULL || bias == NULL || c == NULL) {
+    goto cleanup;
+  }
+  for (size_t i = 0; i < m * max_k; i++) {
+    a[i] = (uint8_t) (i * 7);
+  }
+  for (size_t i = 0; i < n * max_k; i++) {
+    b[i] = (uint8_t) (i * 13);
+  }
+  memset(bias, 0, n * sizeof(int32_t));
+
+  const union qnnp_q31_requantization_params requantization_params =
+    qnnp_compute_requantization_params(0x1.0p-16f, 128, 0, 255);
+  const size_t mr = parameters->mr;
+  const size_t nr = parameters->nr;
+  total_ns = 0;
+  for (size_t k_index = 0; k_index < sizeof(k_values) / sizeof(k_values[0]); k_index++) {
+    const size_t k = k_values[k_index];
+    const size_t passes = max_k * 16 / k;
+    uint64_t best_ns = UINT64_MAX;
+    for (size_t repeat = 0; repeat < repeats; repeat++) {
+      const uint64_t start_ns = now_ns();
+      for (size_t pass = 0; pass < passes; pass++) {
+        for (size_t m_block = 0; m_block < m; m_block += mr) {
+          for (size_t n_block = 0; n_block < n; n_block += nr) {
+            parameters->gemm(
+                mr, nr, k,
+                a + m_block * k, k,
+                b + n_block * k,
+                bias + n_block,
+                c + m_block * n + n_block, n,
+                127, 127,
+                &requantization_params);
+          }
+        }
+      }
+      const uint64_t elapsed_ns = now_ns() - start_ns;
+      if (elapsed_ns < best_ns) {
+        best_ns = elapsed_ns;
+      }
+    }
+    total_ns += best_ns;
+  }
+
+cleanup:
+  free(a);
+  free(b);
+  free(bias);
+  free(c);
+  return total_ns;
+}
+
+static uint32_t autotune_q8conv(uint32_t default_index) {
+  uint32_t best_index = default_index;
+  uint64_t best_ns = UINT64_MAX;
+  for (uint32_t index = 0; index < Q8CONV_CANDIDATES_COUNT; index++) {
+    if (is_q8conv_candidate_supported(index)) {
+      const uint64_t elapsed_ns = benchmark_q8conv(&q8conv_candidates[index].parameters);
+      if (elapsed_ns < best_ns) {
+        best_ns = elapsed_ns;
+        best_index = index;
+      }
+    }
+  }
+  return best_index;
+}
+
+static void select_q8conv(void) {
+  uint32_t index = 0;
+  while (!is_q8conv_candidate_supported(index)) {
+    index++;
+  }
+
+  bool tuned = true;
+  const struct qnnp_tuning_result* tuning_result = init_options.tuning_result;
+  if (tuning_result != NULL &&
+      tuning_result->version == QNNP_TUNING_RESULT_VERSION &&
+      tuning_result->uarch == (uint32_t) cpuinfo_get_core(0)->uarch &&
+      is_q8conv_candidate_supported(tuning_result->q8conv_ukernel))
+  {
+    index = tuning_result->q8conv_ukernel;
+  } else if (init_options.flags & QNNP_INITIALIZE_FLAG_AUTOTUNE) {
+    index = autotune_q8conv(index);
+  } else {
+    tuned = false;
+  }
+
+  q8conv_ukernel_index = index;
+  qnnp_params.q8conv = q8conv_candidates[index].parameters;
+
+  /*
+   * A measured choice overrides the throughput estimates, so operators only get to pick a different microkernel
+   * for their shape when no tuning happened.
+   */
+  uint32_t variants_count = 0;
+  qnnp_params.q8conv_variants[variants_count++] = (struct q8conv_variant) {
+    .parameters = q8conv_candidates[index].parameters,
+    .throughput = q8conv_candidates[index].throughput,
   };
+  if (!tuned) {
+    for (uint32_t i = index + 1; i < Q8CONV_CANDIDATES_COUNT && variants_count < QNNP_MAX_Q8CONV_VARIANTS; i++) {
+      if (is_q8conv_candidate_supported(i)) {
+        qnnp_params.q8conv_variants[variants_count++] = (struct q8conv_variant) {
+          .parameters = q8conv_candidates[i].parameters,
+          .throughput = q8conv_candidates[i].throughput,
+        };
+      }
+    }
+  }
+  qnnp_params.q8conv_variants_count = variants_count;
+}
+
+static size_t get_l2_cache_size(void) {
+  const struct cpuinfo_cache* l2 = cpuinfo_get_l2_caches_count() != 0 ? cpuinfo_get_l2_cache(0) : NULL;
+  if (l2 == NULL || l2->size == 0) {
+    return QNNP_DEFAULT_L2_CACHE_SIZE;
+  }
+  return l2->size / max(l2->processor_count, 1);
+}
+
+static void init(void) {
+  if (init_options.allocator != NULL) {
+    qnnp_allocator = *init_options.allocator;
+  }
+  qnnp_params.uarchs_count = min(cpuinfo_get_uarchs_count(), QNNP_MAX_UARCHES);
+  qnnp_params.l2_cache_size = get_l2_cache_size();
+#if CPUINFO_ARCH_ARM
+  if (!cpuinfo_has_arm_neon()) {
+    qnnp_log_error("QNNPACK initialization failed: NEON is not supported");
+    return;
+  }
+  select_q8conv();
+  init_q8conv_uarch_overrides();
   qnnp_params.q8conv_xzp = (struct q8conv_xzp_parameters) {
       .gemm = q8gemm_xzp_ukernel_4x8c2__aarch32_neon,
+      .name = "4x8c2__aarch32_neon",
       .mr = 4,
       .nr = 8,
       .kr = 2,
       .kc = 8,
       .kthreshold = SIZE_MAX,
+      .conv_kthreshold = SIZE_MAX,
   };
   /* setup xzp threshold based on measurements */
   switch (cpuinfo_get_core(0)->uarch) {
     case cpuinfo_uarch_cortex_a72:
       qnnp_params.q8conv_xzp.kthreshold = 64;
+      qnnp_params.q8conv_xzp.conv_kthreshold = 64;
       break;
     case cpuinfo_uarch_cortex_a73:
       qnnp_params.q8conv_xzp.kthreshold = 256;
+      qnnp_params.q8conv_xzp.conv_kthreshold = 256;
       break;
     case cpuinfo_uarch_cortex_a75:
       qnnp_params.q8conv_xzp.kthreshold = 32;
+      qnnp_params.q8conv_xzp.conv_kthreshold = 32;
       break;
     default:
       break;
   }
+  qnnp_params.q8conv_perchannel = (struct q8conv_parameters) {
+      .conv = q8conv_perchannel_ukernel_4x8__neon,
+      .name = "4x8__neon",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+  };
+  qnnp_params.q8conv_fp32 = (struct q8conv_parameters) {
+      .gemm = q8gemm_fp32_ukernel_4x8__neon,
+      .conv = q8conv_fp32_ukernel_4x8__neon,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__neon,
+      .name = "4x8__neon",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+  };
+  qnnp_params.q8conv_4bit = (struct q8conv_parameters) {
+      .gemm = q8gemm_4bit_ukernel_4x8c2__neon,
+      .gemv = q8gemm_4bit_ukernel_1x8c2__neon,
+      .name = "4x8c2__neon",
+      .mr = 4,
+      .nr = 8,
+      .kr = 2,
+  };
+  qnnp_params.q8gemm_sparse = (struct q8gemm_sparse_parameters) {
+      .gemm = q8gemm_sparse_ukernel_4x4c1x4__neon,
+      .name = "4x4c1x4__neon",
+      .mr = 4,
+      .nr = 4,
+  };
+  qnnp_params.sconv = (struct sconv_parameters) {
+      .gemm = sgemm_ukernel_6x8__neon,
+      .conv = sconv_ukernel_6x8__psimd,
+      .name = "6x8__neon",
+      .mr = 6,
+      .nr = 8,
+  };
+  if (cpuinfo_has_arm_neon_fp16_arith()) {
+    qnnp_params.hconv = (struct hconv_parameters) {
+        .gemm = hgemm_ukernel_8x8__aarch32_neonfp16arith,
+        .conv = hconv_ukernel_8x8__neonfp16arith,
+        .name = "8x8__aarch32_neonfp16arith",
+        .mr = 8,
+        .nr = 8,
+    };
+  }
   qnnp_params.q8dw9 = (struct q8dw_parameters) {
       .dw = q8dw_ukernel_9c8__neon,
+      .name = "9c8__neon",
+      .cr = 8,
+  };
+  qnnp_params.q8dw25 = (struct q8dw_parameters) {
+      .dw = q8dw_ukernel_25c8__neon,
+      .name = "25c8__neon",
       .cr = 8,
   };
   qnnp_params.q8sum_rows = (struct q8sum_rows_parameters) {
       .sum_rows = q8sumrows_ukernel_4x__neon,
+      .conv_sum_rows = q8conv_sumrows_ukernel_4x__neon,
       .m = 4,
   };
-#elif CPUINFO_ARCH_ARM64
-  qnnp_params.q8conv = (struct q8conv_parameters) {
-      .gemm = q8gemm_ukernel_8x8__aarch64_neon,
-      .conv = q8conv_ukernel_8x8__aarch64_neon,
-      .mr = 8,
+  qnnp_params.q8vadd = q8vadd_ukernel__neon;
+  qnnp_params.q8vrescale = q8vrescale_ukernel__neon;
+  qnnp_params.q8vquantize = q8vquantize_ukernel__neon;
+  qnnp_params.q8vdequantize = q8vdequantize_ukernel__neon;
+  qnnp_params.q8embedding = q8embedding_ukernel__neon;
+  qnnp_params.q8gavgpool = (struct q8gavgpool_parameters) {
+      .gavgpool = q8gavgpool_ukernel_8x__neon,
+      .nr = 8,
+  };
+  qnnp_params.u8maxpool = (struct u8maxpool_parameters) {
+      .maxpool = u8maxpool_ukernel_8x__neon,
+      .nr = 8,
+  };
+  qnnp_params.u8rmax = u8rmax_ukernel__neon;
+  qnnp_params.u8bilinear = u8bilinear_ukernel__neon;
+  qnnp_params.q8avgpool = (struct q8avgpool_parameters) {
+      .avgpool = q8avgpool_ukernel_8x__neon,
       .nr = 8,
-      .kr = 1,
   };
+  qnnp_params.x8zip = (struct x8zip_parameters) {
+      .x2 = x8zip_ukernel_x2__neon,
+      .x3 = x8zip_ukernel_x3__neon,
+      .x4 = x8zip_ukernel_x4__neon,
+      .xm = x8zip_ukernel_xm__neon,
+  };
+#elif CPUINFO_ARCH_ARM64
+  select_q8conv();
+  init_q8conv_uarch_overrides();
   qnnp_params.q8conv_xzp = (struct q8conv_xzp_parameters) {
+      .gemm = q8gemm_xzp_ukernel_4x8c2__neon,
+      .name = "4x8c2__neon",
+      .mr = 4,
+      .nr = 8,
+      .kr = 2,
+      .kc = 8,
       .kthreshold = SIZE_MAX,
+      .conv_kthreshold = SIZE_MAX,
   };
+  /* setup xzp threshold based on AArch32 measurements; other cores keep the 8x8 AArch64 GEMM kernel */
+  switch (cpuinfo_get_core(0)->uarch) {
+    case cpuinfo_uarch_cortex_a72:
+      qnnp_params.q8conv_xzp.kthreshold = 64;
+      qnnp_params.q8conv_xzp.conv_kthreshold = 64;
+      break;
+    case cpuinfo_uarch_cortex_a73:
+      qnnp_params.q8conv_xzp.kthreshold = 256;
+      qnnp_params.q8conv_xzp.conv_kthreshold = 256;
+      break;
+    case cpuinfo_uarch_cortex_a75:
+      qnnp_params.q8conv_xzp.kthreshold = 32;
+      qnnp_params.q8conv_xzp.conv_kthreshold = 32;
+      break;
+    default:
+      break;
+  }
+  qnnp_params.q8conv_perchannel = (struct q8conv_parameters) {
+      .conv = q8conv_perchannel_ukernel_4x8__neon,
+      .name = "4x8__neon",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+  };
+  qnnp_params.q8conv_fp32 = (struct q8conv_parameters) {
+      .gemm = q8gemm_fp32_ukernel_4x8__neon,
+      .conv = q8conv_fp32_ukernel_4x8__neon,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__neon,
+      .name = "4x8__neon",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+  };
+  qnnp_params.q8conv_4bit = (struct q8conv_parameters) {
+      .gemm = q8gemm_4bit_ukernel_4x8c2__neon,
+      .gemv = q8gemm_4bit_ukernel_1x8c2__neon,
+      .name = "4x8c2__neon",
+      .mr = 4,
+      .nr = 8,
+      .kr = 2,
+  };
+  qnnp_params.q8gemm_sparse = (struct q8gemm_sparse_parameters) {
+      .gemm = q8gemm_sparse_ukernel_4x4c1x4__neon,
+      .name = "4x4c1x4__neon",
+      .mr = 4,
+      .nr = 4,
+  };
+  qnnp_params.sconv = (struct sconv_parameters) {
+      .gemm = sgemm_ukernel_6x8__neon,
+      .conv = sconv_ukernel_6x8__psimd,
+      .name = "6x8__neon",
+      .mr = 6,
+      .nr = 8,
+  };
+  if (cpuinfo_has_arm_neon_fp16_arith()) {
+    qnnp_params.hconv = (struct hconv_parameters) {
+        .gemm = hgemm_ukernel_8x8__neonfp16arith,
+        .conv = hconv_ukernel_8x8__neonfp16arith,
+        .name = "8x8__neonfp16arith",
+        .mr = 8,
+        .nr = 8,
+    };
+  }
   qnnp_params.q8dw9 = (struct q8dw_parameters) {
       .dw = q8dw_ukernel_9c8__neon,
+      .name = "9c8__neon",
+      .cr = 8,
+  };
+  qnnp_params.q8dw25 = (struct q8dw_parameters) {
+      .dw = q8dw_ukernel_25c8__neon,
+      .name = "25c8__neon",
       .cr = 8,
   };
+  qnnp_params.q8sum_rows = (struct q8sum_rows_parameters) {
+      .sum_rows = q8sumrows_ukernel_4x__neon,
+      .conv_sum_rows = q8conv_sumrows_ukernel_4x__neon,
+      .m = 4,
+  };
+  qnnp_params.q8vadd = q8vadd_ukernel__neon;
+  qnnp_params.q8vrescale = q8vrescale_ukernel__neon;
+  qnnp_params.q8vquantize = q8vquantize_ukernel__neon;
+  qnnp_params.q8vdequantize = q8vdequantize_ukernel__neon;
+  qnnp_params.q8embedding = q8embedding_ukernel__neon;
+  qnnp_params.q8gavgpool = (struct q8gavgpool_parameters) {
+      .gavgpool = q8gavgpool_ukernel_8x__neon,
+      .nr = 8,
+  };
+  qnnp_params.u8maxpool = (struct u8maxpool_parameters) {
+      .maxpool = u8maxpool_ukernel_8x__neon,
+      .nr = 8,
+  };
+  qnnp_params.u8rmax = u8rmax_ukernel__neon;
+  qnnp_params.u8bilinear = u8bilinear_ukernel__neon;
+  qnnp_params.q8avgpool = (struct q8avgpool_parameters) {
+      .avgpool = q8avgpool_ukernel_8x__neon,
+      .nr = 8,
+  };
+  qnnp_params.x8zip = (struct x8zip_parameters) {
+      .x2 = x8zip_ukernel_x2__neon,
+      .x3 = x8zip_ukernel_x3__neon,
+      .x4 = x8zip_ukernel_x4__neon,
+      .xm = x8zip_ukernel_xm__neon,
+  };
 #elif CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
   if (!cpuinfo_has_x86_sse2()) {
     qnnp_log_error("QNNPACK initialization failed: SSE2 is not supported");
     return;
   }
-  qnnp_params.q8conv = (struct q8conv_parameters){
-      .gemm = q8gemm_ukernel_4x4c2__sse2,
-      .conv = q8conv_ukernel_4x4c2__sse2,
+  select_q8conv();
+  qnnp_params.q8conv_xzp = (struct q8conv_xzp_parameters) {
+      .kthreshold = SIZE_MAX,
+      .conv_kthreshold = 64,
+  };
+  qnnp_params.q8conv_perchannel = (struct q8conv_parameters) {
+      .conv = q8conv_perchannel_ukernel_4x4c2__sse2,
+      .name = "4x4c2__sse2",
+      .mr = 4,
+      .nr = 4,
+      .kr = 2,
+  };
+  qnnp_params.q8conv_fp32 = (struct q8conv_parameters) {
+      .gemm = q8gemm_fp32_ukernel_4x4c2__sse2,
+      .conv = q8conv_fp32_ukernel_4x4c2__sse2,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x4c2__sse2,
+      .name = "4x4c2__sse2",
+      .mr = 4,
+      .nr = 4,
+      .kr = 2,
+  };
+  qnnp_params.q8conv_4bit = (struct q8conv_parameters) {
+      .gemm = q8gemm_4bit_ukernel_4x4c2__sse2,
+      .gemv = q8gemm_4bit_ukernel_1x4c2__sse2,
+      .name = "4x4c2__sse2",
       .mr = 4,
       .nr = 4,
       .kr = 2,
   };
+  qnnp_params.q8gemm_sparse = (struct q8gemm_sparse_parameters) {
+      .gemm = q8gemm_sparse_ukernel_4x4c1x4__sse2,
+      .name = "4x4c1x4__sse2",
+      .mr = 4,
+      .nr = 4,
+  };
+  qnnp_params.sconv = (struct sconv_parameters) {
+      .gemm = sgemm_ukernel_6x8__psimd,
+      .conv = sconv_ukernel_6x8__psimd,
+      .name = "6x8__psimd",
+      .mr = 6,
+      .nr = 8,
+  };
+  if (cpuinfo_has_x86_avx2()) {
+    qnnp_params.q8dw9 = (struct q8dw_parameters) {
+        .dw = q8dw_ukernel_9c16__avx2,
+        .multiplier_dw = q8dw_multiplier_ukernel_9c16__avx2,
+        .name = "9c16__avx2",
+        .cr = 16,
+    };
+  } else {
+    qnnp_params.q8dw9 = (struct q8dw_parameters) {
+        .dw = q8dw_ukernel_9c8__sse2,
+        .multiplier_dw = q8dw_multiplier_ukernel_9c8__sse2,
+        .name = "9c8__sse2",
+        .cr = 8,
+    };
+  }
+  qnnp_params.q8dw25 = (struct q8dw_parameters) {
+      .dw = q8dw_ukernel_25c8__sse2,
+      .multiplier_dw = q8dw_multiplier_ukernel_25c8__sse2,
+      .name = "25c8__sse2",
+      .cr = 8,
+  };
+  qnnp_params.q8sum_rows = (struct q8sum_rows_parameters) {
+      /* There is no XZP GEMM microkernel, only the sums of indirection tiles for XZP convolutions */
+      .conv_sum_rows = q8conv_sumrows_ukernel_4x__sse2,
+      .m = 4,
+  };
+  qnnp_params.q8vadd = q8vadd_ukernel__sse2;
+  qnnp_params.q8vrescale = q8vrescale_ukernel__sse2;
+  qnnp_params.q8vquantize = q8vquantize_ukernel__sse2;
+  qnnp_params.q8vdequantize = q8vdequantize_ukernel__sse2;
+  qnnp_params.q8embedding = q8embedding_ukernel__sse2;
+  qnnp_params.q8gavgpool = (struct q8gavgpool_parameters) {
+      .gavgpool = q8gavgpool_ukernel_8x__sse2,
+      .nr = 8,
+  };
+  qnnp_params.u8maxpool = (struct u8maxpool_parameters) {
+      .maxpool = u8maxpool_ukernel_8x__sse2,
+      .nr = 8,
+  };
+  qnnp_params.u8rmax = u8rmax_ukernel__sse2;
+  qnnp_params.u8bilinear = u8bilinear_ukernel__sse2;
+  qnnp_params.q8avgpool = (struct q8avgpool_parameters) {
+      .avgpool = q8avgpool_ukernel_8x__sse2,
+      .nr = 8,
+  };
+  qnnp_params.x8zip = (struct x8zip_parameters) {
+      .x2 = x8zip_ukernel_x2__sse2,
+      .x3 = x8zip_ukernel_x3__sse2,
+      .x4 = x8zip_ukernel_x4__sse2,
+      .xm = x8zip_ukernel_xm__sse2,
+  };
+#else
+  select_q8conv();
+  /* There are no XZP, 4-bit, or sparse microkernels */
   qnnp_params.q8conv_xzp = (struct q8conv_xzp_parameters) {
       .kthreshold = SIZE_MAX,
+      .conv_kthreshold = SIZE_MAX,
+  };
+  qnnp_params.q8conv_perchannel = (struct q8conv_parameters) {
+      .conv = q8conv_perchannel_ukernel_4x8__psimd,
+      .name = "4x8__psimd",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+  };
+  qnnp_params.q8conv_fp32 = (struct q8conv_parameters) {
+      .gemm = q8gemm_fp32_ukernel_4x8__psimd,
+      .conv = q8conv_fp32_ukernel_4x8__psimd,
+      .gemv_acc32 = q8gemm_acc32_ukernel_1x8__psimd,
+      .name = "4x8__psimd",
+      .mr = 4,
+      .nr = 8,
+      .kr = 1,
+  };
+  qnnp_params.sconv = (struct sconv_parameters) {
+      .gemm = sgemm_ukernel_6x8__psimd,
+      .conv = sconv_ukernel_6x8__psimd,
+      .name = "6x8__psimd",
+      .mr = 6,
+      .nr = 8,
   };
   qnnp_params.q8dw9 = (struct q8dw_parameters) {
-      .dw = q8dw_ukernel_9c8__sse2,
+      .dw = q8dw_ukernel_9c8__psimd,
+      .multiplier_dw = q8dw_multiplier_ukernel_9c8__psimd,
+      .name = "9c8__psimd",
       .cr = 8,
   };
-#else
-  #error "Unsupported architecture"
+#if CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+  if (cpuinfo_has_riscv_v()) {
+    qnnp_params.q8dw9 = (struct q8dw_parameters) {
+        .dw = q8dw_ukernel_9c8__rvv,
+        .name = "9c8__rvv",
+        .cr = 8,
+    };
+  }
+#endif
+  qnnp_params.q8dw25 = (struct q8dw_parameters) {
+      .dw = q8dw_ukernel_25c8__psimd,
+      .multiplier_dw = q8dw_multiplier_ukernel_25c8__psimd,
+      .name = "25c8__psimd",
+      .cr = 8,
+  };
+  qnnp_params.q8vadd = q8vadd_ukernel__scalar;
+  qnnp_params.q8vrescale = q8vrescale_ukernel__scalar;
+  qnnp_params.q8vquantize = q8vquantize_ukernel__scalar;
+  qnnp_params.q8vdequantize = q8vdequantize_ukernel__scalar;
+  qnnp_params.q8embedding = q8embedding_ukernel__scalar;
+  qnnp_params.q8gavgpool = (struct q8gavgpool_parameters) {
+      .gavgpool = q8gavgpool_ukernel_1x__scalar,
+      .nr = 1,
+  };
+  qnnp_params.u8maxpool = (struct u8maxpool_parameters) {
+      .maxpool = u8maxpool_ukernel_1x__scalar,
+      .nr = 1,
+  };
+  qnnp_params.u8rmax = u8rmax_ukernel__scalar;
+  qnnp_params.u8bilinear = u8bilinear_ukernel__scalar;
+  qnnp_params.q8avgpool = (struct q8avgpool_parameters) {
+      .avgpool = q8avgpool_ukernel_1x__scalar,
+      .nr = 1,
+  };
+  qnnp_params.x8zip = (struct x8zip_parameters) {
+      .x2 = x8zip_ukernel_x2__scalar,
+      .x3 = x8zip_ukernel_x3__scalar,
+      .x4 = x8zip_ukernel_x4__scalar,
+      .xm = x8zip_ukernel_xm__scalar,
+  };
 #endif
+  qnnp_params.x8lut = x8lut_ukernel__scalar;
+  qnnp_params.u8lut32norm = u8lut32norm_ukernel__scalar;
   qnnp_params.initialized = true;
 }
 
@@ -121,6 +935,42 @@ enum qnnp_status qnnp_initialize(void) {
   }
 }
 
+enum qnnp_status qnnp_initialize_with_options(const struct qnnp_initialize_options* options) {
+  if (options == NULL) {
+    qnnp_log_error("failed to initialize QNNPACK: options must not be NULL");
+    return qnnp_status_invalid_parameter;
+  }
+  const struct qnnp_allocator* allocator = options->allocator;
+  if (allocator != NULL &&
+      (allocator->allocate == NULL || allocator->reallocate == NULL || allocator->deallocate == NULL ||
+       allocator->aligned_allocate == NULL || allocator->aligned_deallocate == NULL))
+  {
+    qnnp_log_error("failed to initialize QNNPACK: all functions of the allocator must be provided");
+    return qnnp_status_invalid_parameter;
+  }
+  if (!qnnp_params.initialized) {
+    init_options = *options;
+  }
+  const enum qnnp_status status = qnnp_initialize();
+  /* The tuning result and allocator pointers are only valid for the duration of the call */
+  init_options.tuning_result = NULL;
+  init_options.allocator = NULL;
+  return status;
+}
+
+enum qnnp_status qnnp_get_tuning_result(struct qnnp_tuning_result* tuning_result) {
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_get_tuning_result failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+  *tuning_result = (struct qnnp_tuning_result) {
+    .version = QNNP_TUNING_RESULT_VERSION,
+    .uarch = (uint32_t) cpuinfo_get_core(0)->uarch,
+    .q8conv_ukernel = q8conv_ukernel_index,
+  };
+  return qnnp_status_success;
+}
+
 enum qnnp_status qnnp_deinitialize(void) {
   cpuinfo_deinitialize();
   return qnnp_status_success;
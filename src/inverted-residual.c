@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/allocator.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/math.h>
+#include <qnnpack/params.h>
+#include <qnnpack/scheduler.h>
+
+
+/* 1x1 convolution without groups or padding that runs on the dense GEMM microkernels */
+static bool is_fusable_gemm(const struct qnnp_operator* op) {
+  return (op->flags & QNNP_CONVOLUTION_FLAG_GEMM) &&
+    !(op->flags & (QNNP_CONVOLUTION_FLAG_ZERO | QNNP_CONVOLUTION_FLAG_SPARSE)) && op->groups == 1;
+}
+
+/*
+ * Creates an operator of the given type for fused depthwise and projection convolutions, with an expansion
+ * convolution before them in inverted residual operators and without it in depthwise separable operators.
+ */
+static enum qnnp_status create_fused_convolution(
+    const char* name,
+    enum qnnp_operator_type type,
+    qnnp_operator_t expansion,
+    qnnp_operator_t depthwise,
+    qnnp_operator_t projection,
+    qnnp_operator_t* fused_convolution_out)
+{
+  qnnp_operator_t fused_convolution = NULL;
+  enum qnnp_status status = qnnp_status_invalid_parameter;
+
+  /* Operators are numbered in the order of the arguments of the create function */
+  const struct qnnp_operator* ops[3] = { expansion, depthwise, projection };
+  const size_t first_op = expansion != NULL ? 0 : 1;
+  for (size_t i = first_op; i < 3; i++) {
+    if (ops[i] == NULL || ops[i]->type != qnnp_operator_type_convolution || ops[i]->format != qnnp_format_quint8) {
+      qnnp_log_error("failed to create %s operator: operator #%zu is not a Q8 convolution", name, i - first_op);
+      goto error;
+    }
+  }
+
+  if (expansion != NULL && depthwise->groups != expansion->group_output_channels) {
+    qnnp_log_error(
+      "failed to create %s operator with %zu expanded channels: depthwise convolution has %" PRIu32 " groups",
+      name, expansion->group_output_channels, depthwise->groups);
+    goto error;
+  }
+
+  if (projection->group_input_channels != depthwise->groups * depthwise->group_output_channels) {
+    qnnp_log_error(
+      "failed to create %s operator with %zu projection input channels: depthwise convolution outputs %zu channels",
+      name, projection->group_input_channels, depthwise->groups * depthwise->group_output_channels);
+    goto error;
+  }
+
+  status = qnnp_status_unsupported_parameter;
+
+  if ((expansion != NULL && !is_fusable_gemm(expansion)) || !is_fusable_gemm(projection)) {
+    qnnp_log_error(
+      "failed to create %s operator: "
+      "1x1 convolutions must run on the GEMM microkernels without groups or padding", name);
+    goto error;
+  }
+
+  if (!(depthwise->flags & QNNP_CONVOLUTION_FLAG_DW) || depthwise->group_output_channels != 1) {
+    qnnp_log_error(
+      "failed to create %s operator: "
+      "depthwise convolution must run on the depthwise microkernels without channel multiplier", name);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  fused_convolution = calloc(1, sizeof(struct qnnp_operator));
+  if (fused_convolution == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  fused_convolution->inverted_residual = calloc(1, sizeof(struct qnnp_inverted_residual));
+  if (fused_convolution->inverted_residual == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for %s operators", sizeof(struct qnnp_inverted_residual), name);
+    goto error;
+  }
+  fused_convolution->inverted_residual->expansion = expansion;
+  fused_convolution->inverted_residual->depthwise = depthwise;
+  fused_convolution->inverted_residual->projection = projection;
+  if (expansion != NULL) {
+    /* Output rows read input rows within the dilated kernel height, so as many ring rows hold all of them */
+    fused_convolution->inverted_residual->ring_rows =
+      (depthwise->kernel_height - 1) * depthwise->dilation_height + 1;
+  }
+
+  const struct qnnp_operator* first = ops[first_op];
+  fused_convolution->groups = 1;
+  fused_convolution->group_input_channels = expansion != NULL ? expansion->group_input_channels : depthwise->groups;
+  fused_convolution->group_output_channels = projection->group_output_channels;
+  fused_convolution->input_zero_point = first->input_zero_point;
+  fused_convolution->output_zero_point = projection->output_zero_point;
+
+  fused_convolution->type = type;
+  fused_convolution->format = qnnp_format_quint8;
+
+  *fused_convolution_out = fused_convolution;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(fused_convolution);
+  return status;
+}
+
+static enum qnnp_status setup_fused_convolution(
+    const char* name,
+    qnnp_operator_t fused_convolution,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup %s operator with batch size %zu: batch size must be non-zero", name, batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (input_width == 0 || input_height == 0) {
+    qnnp_log_error(
+      "failed to setup %s operator with %zux%zu input: input dimensions must be non-zero",
+      name, input_width, input_height);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t input_channels = fused_convolution->group_input_channels;
+  const size_t output_channels = fused_convolution->group_output_channels;
+  if (input_pixel_stride < input_channels || output_pixel_stride < output_channels) {
+    qnnp_log_error(
+      "failed to setup %s operator with %zu input and %zu output pixel strides: "
+      "strides must be at least the %zu input and %zu output channels",
+      name, input_pixel_stride, output_pixel_stride, input_channels, output_channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  struct qnnp_inverted_residual* fused = fused_convolution->inverted_residual;
+  const struct qnnp_operator* depthwise = fused->depthwise;
+  const size_t output_height = compute_convolution_output_dimension(
+    depthwise->input_padding_top + input_height + depthwise->input_padding_bottom,
+    depthwise->kernel_height, depthwise->dilation_height, depthwise->stride_height);
+  const size_t output_width = compute_convolution_output_dimension(
+    depthwise->input_padding_left + input_width + depthwise->input_padding_right,
+    depthwise->kernel_width, depthwise->dilation_width, depthwise->stride_width);
+
+  /*
+   * One band per thread, so bands hold many consecutive rows: the expanded rows under the kernel are shared by the
+   * output rows of a band and only those at the start of a band are computed twice.
+   */
+  const size_t rows = batch_size * output_height;
+  const size_t bands = min(qnnp_get_threads_count(fused_convolution, threadpool), rows);
+  /* Narrow depthwise output rows are collected until the projection GEMM gets enough pixels to fill its tiles */
+  const size_t depthwise_rows =
+    min(divide_round_up(QNNP_PROJECTION_PIXELS, output_width), divide_round_up(rows, bands));
+  const size_t channels = depthwise->groups;
+  const size_t kernel_size = depthwise->kernel_height * depthwise->kernel_width;
+  const size_t ring_size = fused->ring_rows * input_width * channels;
+  const size_t depthwise_output_offset = round_up(QNNP_BAND_PADDING + ring_size + QNNP_BAND_PADDING, 16);
+  const size_t indirection_offset =
+    round_up(depthwise_output_offset + depthwise_rows * output_width * channels + QNNP_BAND_PADDING, sizeof(void*));
+  const size_t band_buffer_stride = round_up(indirection_offset + output_width * kernel_size * sizeof(void*), 64);
+  const size_t band_buffers_size = bands * band_buffer_stride;
+  if (bands != fused->bands || band_buffer_stride != fused->band_buffer_stride) {
+    void* band_buffers = qnnp_reallocate(fused->band_buffers, band_buffers_size);
+    if (band_buffers == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for band buffers", band_buffers_size);
+      return qnnp_status_out_of_memory;
+    }
+    fused->band_buffers = band_buffers;
+  }
+  fused->bands = bands;
+  fused->depthwise_rows = depthwise_rows;
+  fused->band_buffer_stride = band_buffer_stride;
+  fused->depthwise_output_offset = depthwise_output_offset;
+  fused->indirection_offset = indirection_offset;
+
+  fused_convolution->batch_size = batch_size;
+  fused_convolution->input_height = input_height;
+  fused_convolution->input_width = input_width;
+  fused_convolution->input = input;
+  fused_convolution->input_pixel_stride = input_pixel_stride;
+  fused_convolution->output_height = output_height;
+  fused_convolution->output_width = output_width;
+  fused_convolution->output = output;
+  fused_convolution->output_pixel_stride = output_pixel_stride;
+
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_create_inverted_residual_nhwc_q8(
+    qnnp_operator_t expansion,
+    qnnp_operator_t depthwise,
+    qnnp_operator_t projection,
+    uint32_t flags,
+    qnnp_operator_t* inverted_residual_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_inverted_residual_nhwc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (expansion == NULL) {
+    qnnp_log_error("failed to create inverted residual operator without expansion convolution");
+    return qnnp_status_invalid_parameter;
+  }
+
+  return create_fused_convolution(
+    "inverted residual", qnnp_operator_type_inverted_residual,
+    expansion, depthwise, projection,
+    inverted_residual_out);
+}
+
+enum qnnp_status qnnp_setup_inverted_residual_nhwc_q8(
+    qnnp_operator_t inverted_residual,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_inverted_residual_nhwc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (inverted_residual->type != qnnp_operator_type_inverted_residual) {
+    qnnp_log_error(
+      "failed to setup inverted residual operator: operator was not created by qnnp_create_inverted_residual_nhwc_q8");
+    return qnnp_status_invalid_parameter;
+  }
+
+  return setup_fused_convolution(
+    "inverted residual", inverted_residual,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride,
+    output, output_pixel_stride,
+    threadpool);
+}
+
+enum qnnp_status qnnp_create_depthwise_separable_nhwc_q8(
+    qnnp_operator_t depthwise,
+    qnnp_operator_t pointwise,
+    uint32_t flags,
+    qnnp_operator_t* depthwise_separable_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_depthwise_separable_nhwc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  return create_fused_convolution(
+    "depthwise separable", qnnp_operator_type_depthwise_separable,
+    NULL, depthwise, pointwise,
+    depthwise_separable_out);
+}
+
+enum qnnp_status qnnp_setup_depthwise_separable_nhwc_q8(
+    qnnp_operator_t depthwise_separable,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_depthwise_separable_nhwc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (depthwise_separable->type != qnnp_operator_type_depthwise_separable) {
+    qnnp_log_error(
+      "failed to setup depthwise separable operator: "
+      "operator was not created by qnnp_create_depthwise_separable_nhwc_q8");
+    return qnnp_status_invalid_parameter;
+  }
+
+  return setup_fused_convolution(
+    "depthwise separable", depthwise_separable,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride,
+    output, output_pixel_stride,
+    threadpool);
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <qnnpack.h>
+#include <qnnpack/allocator.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+#include <qnnpack/requantization.h>
+
+
+static int16_t quantize_q15(float x) {
+  return (int16_t) lrintf(x * 32767.0f);
+}
+
+static float sigmoid(float x) {
+  return 1.0f / (1.0f + expf(-x));
+}
+
+enum qnnp_status qnnp_create_lstm_cell_nc_q8(
+    size_t input_channels,
+    size_t hidden_channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t kernel_zero_point,
+    float kernel_scale,
+    const uint8_t* input_kernel,
+    const uint8_t* recurrent_kernel,
+    const int32_t* bias,
+    float cell_scale,
+    uint32_t flags,
+    qnnp_operator_t* lstm_cell_out)
+{
+  qnnp_operator_t lstm_cell = NULL;
+  uint8_t* gate_kernel = NULL;
+  int32_t* gate_bias = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_lstm_cell_nc_q8 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (input_channels == 0 || hidden_channels == 0) {
+    qnnp_log_error(
+      "failed to create LSTM cell operator with %zu input and %zu hidden channels: "
+      "number of channels must be non-zero",
+      input_channels, hidden_channels);
+    goto error;
+  }
+
+  if (input_scale <= 0.0f || !isnormal(input_scale)) {
+    qnnp_log_error(
+      "failed to create LSTM cell operator with %.7g input scale: scale must be finite and positive", input_scale);
+    goto error;
+  }
+
+  if (kernel_scale <= 0.0f || !isnormal(kernel_scale)) {
+    qnnp_log_error(
+      "failed to create LSTM cell operator with %.7g kernel scale: scale must be finite and positive", kernel_scale);
+    goto error;
+  }
+
+  int cell_exponent = 0;
+  const float cell_mantissa = frexpf(cell_scale, &cell_exponent);
+  if (cell_mantissa != 0.5f || cell_exponent > 1 || cell_exponent < -14) {
+    qnnp_log_error(
+      "failed to create LSTM cell operator with %.7g cell scale: scale must be a power of two in [2**-15, 1]",
+      cell_scale);
+    goto error;
+  }
+  const uint32_t cell_shift = (uint32_t) (1 - cell_exponent);
+
+  status = qnnp_status_unsupported_parameter;
+
+  /* Products of the Q15 output gate and tanh of the cell state are in Q30 */
+  const float hidden_scale = 0x1.0p-30f / input_scale;
+  if (hidden_scale < 0x1.0p-32f || hidden_scale >= 1.0f) {
+    qnnp_log_error(
+      "failed to create LSTM cell operator with %.7g input scale: hidden requantization scale %.7g is outside "
+      "[2**-32, 1) range", input_scale, hidden_scale);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  lstm_cell = calloc(1, sizeof(struct qnnp_operator));
+  if (lstm_cell == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  lstm_cell->lstm_cell = calloc(1, sizeof(struct qnnp_lstm_cell));
+  if (lstm_cell->lstm_cell == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for LSTM cell operator", sizeof(struct qnnp_lstm_cell));
+    goto error;
+  }
+
+  /* Output channel 4 * j + g of the gate GEMM is gate g of hidden unit j, over the input and then the hidden state */
+  const size_t concat_channels = input_channels + hidden_channels;
+  const size_t gate_channels = 4 * hidden_channels;
+  gate_kernel = malloc(gate_channels * concat_channels);
+  if (gate_kernel == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for LSTM gate kernel", gate_channels * concat_channels);
+    goto error;
+  }
+  gate_bias = malloc(gate_channels * sizeof(int32_t));
+  if (gate_bias == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for LSTM gate bias", gate_channels * sizeof(int32_t));
+    goto error;
+  }
+  for (size_t j = 0; j < hidden_channels; j++) {
+    for (size_t g = 0; g < 4; g++) {
+      const size_t source_row = g * hidden_channels + j;
+      uint8_t* row = gate_kernel + (4 * j + g) * concat_channels;
+      memcpy(row, input_kernel + source_row * input_channels, input_channels);
+      memcpy(row + input_channels, recurrent_kernel + source_row * hidden_channels, hidden_channels);
+      gate_bias[4 * j + g] = bias[source_row];
+    }
+  }
+
+  status = qnnp_create_fully_connected_nc_q8(
+    concat_channels, gate_channels,
+    input_zero_point, input_scale,
+    kernel_zero_point, kernel_scale,
+    gate_kernel, gate_bias,
+    QNNP_LSTM_GATE_ZERO_POINT, QNNP_LSTM_GATE_SCALE, 0, UINT8_MAX,
+    flags & ~QNNP_CREATE_FLAG_LAZY_PACKING,
+    &lstm_cell->lstm_cell->gates);
+  if (status != qnnp_status_success) {
+    goto error;
+  }
+  free(gate_kernel);
+  gate_kernel = NULL;
+  free(gate_bias);
+  gate_bias = NULL;
+
+  if (lstm_cell->lstm_cell->gates->q8conv.nr % 4 != 0) {
+    qnnp_log_error(
+      "failed to create LSTM cell operator: GEMM microkernel tile of %" PRIu32 " channels splits the gates of hidden "
+      "units", lstm_cell->lstm_cell->gates->q8conv.nr);
+    status = qnnp_status_unsupported_parameter;
+    goto error;
+  }
+
+  struct qnnp_lstm_cell* cell = lstm_cell->lstm_cell;
+  cell->hidden_channels = hidden_channels;
+  cell->cell_shift = cell_shift;
+  cell->hidden_requantization_params =
+    qnnp_compute_scalar_requantization_params(hidden_scale, input_zero_point, 0, UINT8_MAX);
+  for (int32_t q = 0; q < 256; q++) {
+    const float x = (float) (q - QNNP_LSTM_GATE_ZERO_POINT) * QNNP_LSTM_GATE_SCALE;
+    cell->sigmoid_table[q] = quantize_q15(sigmoid(x));
+    cell->tanh_table[q] = quantize_q15(tanhf(x));
+  }
+  for (int32_t i = 0; i <= 256; i++) {
+    cell->cell_tanh_table[i] = quantize_q15(tanhf((float) (i - 128) * 0.0625f));
+  }
+
+  lstm_cell->batch_size = 1;
+  lstm_cell->input_height = 1;
+  lstm_cell->input_width = 1;
+  lstm_cell->output_height = 1;
+  lstm_cell->output_width = 1;
+  lstm_cell->groups = 1;
+  lstm_cell->group_input_channels = input_channels;
+  lstm_cell->group_output_channels = hidden_channels;
+  lstm_cell->input_zero_point = input_zero_point;
+  lstm_cell->kernel_zero_point = kernel_zero_point;
+  lstm_cell->output_zero_point = input_zero_point;
+
+  lstm_cell->type = qnnp_operator_type_lstm_cell;
+  lstm_cell->format = qnnp_format_quint8;
+
+  *lstm_cell_out = lstm_cell;
+  return qnnp_status_success;
+
+error:
+  free(gate_kernel);
+  free(gate_bias);
+  qnnp_delete_operator(lstm_cell);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_lstm_cell_nc_q8(
+    qnnp_operator_t lstm_cell,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    const uint8_t* hidden_input,
+    size_t hidden_input_stride,
+    int16_t* cell_state,
+    uint8_t* hidden_output,
+    size_t hidden_output_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_lstm_cell_nc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (lstm_cell->type != qnnp_operator_type_lstm_cell) {
+    qnnp_log_error("failed to setup LSTM cell operator: operator was not created by qnnp_create_lstm_cell_nc_q8");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup LSTM cell operator with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t input_channels = lstm_cell->group_input_channels;
+  const size_t hidden_channels = lstm_cell->group_output_channels;
+  if (input_stride < input_channels || hidden_input_stride < hidden_channels ||
+      hidden_output_stride < hidden_channels)
+  {
+    qnnp_log_error(
+      "failed to setup LSTM cell operator with %zu input, %zu hidden input, and %zu hidden output strides: "
+      "strides must be at least the %zu input and %zu hidden channels",
+      input_stride, hidden_input_stride, hidden_output_stride, input_channels, hidden_channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  struct qnnp_lstm_cell* cell = lstm_cell->lstm_cell;
+  if (batch_size != lstm_cell->batch_size || cell->concat_buffer == NULL) {
+    /* Microkernels may read 8 bytes past the last row of the GEMM input */
+    const size_t concat_buffer_size = batch_size * (input_channels + hidden_channels) + 8;
+    uint8_t* concat_buffer = qnnp_reallocate(cell->concat_buffer, concat_buffer_size);
+    if (concat_buffer == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for LSTM cell GEMM input", concat_buffer_size);
+      return qnnp_status_out_of_memory;
+    }
+    cell->concat_buffer = concat_buffer;
+
+    const size_t gate_buffer_size = batch_size * 4 * hidden_channels;
+    uint8_t* gate_buffer = qnnp_reallocate(cell->gate_buffer, gate_buffer_size);
+    if (gate_buffer == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for LSTM cell gates", gate_buffer_size);
+      return qnnp_status_out_of_memory;
+    }
+    cell->gate_buffer = gate_buffer;
+  }
+
+  lstm_cell->batch_size = batch_size;
+  lstm_cell->input = input;
+  lstm_cell->input_pixel_stride = input_stride;
+  lstm_cell->output = hidden_output;
+  lstm_cell->output_pixel_stride = hidden_output_stride;
+  cell->hidden_input = hidden_input;
+  cell->hidden_input_stride = hidden_input_stride;
+  cell->cell_state = cell_state;
+
+  return qnnp_status_success;
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <qnnpack.h>
+#include <qnnpack/allocator.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+#include <qnnpack/requantization.h>
+
+
+enum qnnp_status qnnp_create_max_pooling2d_nhwc_u8(
+    uint32_t input_padding_top,
+    uint32_t input_padding_right,
+    uint32_t input_padding_bottom,
+    uint32_t input_padding_left,
+    uint32_t pooling_height,
+    uint32_t pooling_width,
+    uint32_t stride_height,
+    uint32_t stride_width,
+    uint32_t dilation_height,
+    uint32_t dilation_width,
+    size_t channels,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* max_pooling_out)
+{
+  qnnp_operator_t max_pooling = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_max_pooling2d_nhwc_u8 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (pooling_height == 0 || pooling_width == 0) {
+    qnnp_log_error(
+      "failed to create max pooling with %" PRIu32 "x%" PRIu32 " pooling size: "
+      "pooling size dimensions must be non-zero",
+      pooling_width, pooling_height);
+    goto error;
+  }
+
+  if (pooling_height == 1 && pooling_width == 1) {
+    qnnp_log_error(
+      "failed to create max pooling with 1 pooling element: 1x1 pooling is meaningless");
+    goto error;
+  }
+
+  if (stride_height == 0 || stride_width == 0) {
+    qnnp_log_error(
+      "failed to create max pooling with %" PRIu32 "x%" PRIu32 " stride: stride dimensions must be non-zero",
+      stride_width, stride_height);
+    goto error;
+  }
+
+  if (dilation_height == 0 || dilation_width == 0) {
+    qnnp_log_error(
+      "failed to create max pooling with %" PRIu32 "x%" PRIu32 " dilation: dilation dimensions must be non-zero",
+      dilation_width, dilation_height);
+    goto error;
+  }
+
+  if (channels == 0 || channels > UINT32_MAX) {
+    qnnp_log_error(
+      "failed to create max pooling with %zu channels: number of channels must be non-zero and fit in 32 bits",
+      channels);
+    goto error;
+  }
+
+  if (output_min >= output_max) {
+    qnnp_log_error(
+      "failed to create max pooling with [%" PRIu8 ", %" PRIu8 "] output range: range min must be below range max",
+      output_min, output_max);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  max_pooling = calloc(1, sizeof(struct qnnp_operator));
+  if (max_pooling == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  /* Pooling is a depthwise convolution without weights, and builds the same indirection buffer */
+  uint32_t convolution_flags = QNNP_CONVOLUTION_FLAG_DW;
+  if ((input_padding_left | input_padding_top | input_padding_right | input_padding_bottom) != 0) {
+    convolution_flags |= QNNP_CONVOLUTION_FLAG_ZERO;
+
+    /* Padding reads zeroes, which never exceed an input */
+    const size_t zero_size = sizeof(uint8_t) * channels + (channels >= 8 ? 0 : 8);
+    max_pooling->zero = qnnp_allocate_zero_weights(zero_size);
+    if (max_pooling->zero == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for zero padding", zero_size);
+      goto error;
+    }
+  }
+
+  max_pooling->input_padding_top = input_padding_top;
+  max_pooling->input_padding_right = input_padding_right;
+  max_pooling->input_padding_bottom = input_padding_bottom;
+  max_pooling->input_padding_left = input_padding_left;
+
+  max_pooling->kernel_height = pooling_height;
+  max_pooling->kernel_width = pooling_width;
+  max_pooling->stride_height = stride_height;
+  max_pooling->stride_width = stride_width;
+  max_pooling->dilation_height = dilation_height;
+  max_pooling->dilation_width = dilation_width;
+  max_pooling->groups = (uint32_t) channels;
+  max_pooling->group_input_channels = 1;
+  max_pooling->group_output_channels = 1;
+  max_pooling->channels = channels;
+
+  max_pooling->output_min = output_min;
+  max_pooling->output_max = output_max;
+
+  max_pooling->type = qnnp_operator_type_max_pooling;
+  max_pooling->format = qnnp_format_quint8;
+  max_pooling->flags = convolution_flags;
+
+  *max_pooling_out = max_pooling;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(max_pooling);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_max_pooling2d_nhwc_u8(
+    qnnp_operator_t max_pooling,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_max_pooling2d_nhwc_u8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup max pooling with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (input_width == 0 || input_height == 0) {
+    qnnp_log_error(
+      "failed to setup max pooling with %zux%zu input: input dimensions must be non-zero",
+      input_width, input_height);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t channels = max_pooling->channels;
+  if (input_pixel_stride < channels || output_pixel_stride < channels) {
+    qnnp_log_error(
+      "failed to setup max pooling with %zu input pixel stride and %zu output pixel stride: "
+      "strides must be at least the %zu channels",
+      input_pixel_stride, output_pixel_stride, channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t padded_input_height =
+    max_pooling->input_padding_top + input_height + max_pooling->input_padding_bottom;
+  const size_t padded_input_width =
+    max_pooling->input_padding_left + input_width + max_pooling->input_padding_right;
+  const size_t effective_pooling_height = (max_pooling->kernel_height - 1) * max_pooling->dilation_height + 1;
+  const size_t effective_pooling_width = (max_pooling->kernel_width - 1) * max_pooling->dilation_width + 1;
+  if (padded_input_height < effective_pooling_height || padded_input_width < effective_pooling_width) {
+    qnnp_log_error(
+      "failed to setup max pooling with %zux%zu padded input: "
+      "padded input must be at least as large as the %zux%zu dilated pooling window",
+      padded_input_width, padded_input_height, effective_pooling_width, effective_pooling_height);
+    return qnnp_status_invalid_parameter;
+  }
+
+  return qnnp_setup_convolution_indirection(
+    max_pooling,
+    batch_size, input_height, input_width,
+    input, input_pixel_stride,
+    output, output_pixel_stride);
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/math.h>
+#include <qnnpack/packed-weights.h>
+#include <qnnpack/params.h>
+
+
+static enum qnnp_operator_path get_operator_path(const struct qnnp_operator* op) {
+  switch (op->type) {
+    case qnnp_operator_type_fully_connected:
+      return qnnp_operator_path_gemm;
+    case qnnp_operator_type_deconvolution:
+      return qnnp_operator_path_conv;
+    case qnnp_operator_type_convolution:
+      if (op->flags & QNNP_CONVOLUTION_FLAG_GEMM) {
+        return qnnp_operator_path_gemm;
+      } else if (op->flags & QNNP_CONVOLUTION_FLAG_DW) {
+        return qnnp_operator_path_depthwise;
+      } else if (op->flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
+        return qnnp_operator_path_xzp_gemm;
+      } else if (op->flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) {
+        return qnnp_operator_path_winograd;
+      } else {
+        return qnnp_operator_path_conv;
+      }
+    default:
+      return qnnp_operator_path_none;
+  }
+}
+
+static void get_operator_ukernel(const struct qnnp_operator* op, struct qnnp_operator_info* info) {
+  if (info->path == qnnp_operator_path_depthwise) {
+    const struct q8dw_parameters* q8dw_params =
+      op->kernel_height * op->kernel_width == 9 ? &qnnp_params.q8dw9 : &qnnp_params.q8dw25;
+    info->ukernel = q8dw_params->name;
+    info->mr = 1;
+  } else if (info->path == qnnp_operator_path_xzp_gemm) {
+    info->ukernel = qnnp_params.q8conv_xzp.name;
+    info->mr = qnnp_params.q8conv_xzp.mr;
+  } else if (info->path == qnnp_operator_path_winograd) {
+    /* Tiles of 2x2 output pixels go through the portable products of transformed tiles */
+    info->ukernel = "q8winograd_2x2_3x3";
+    info->mr = QNNP_WINOGRAD_MR;
+  } else {
+    switch (op->format) {
+      case qnnp_format_float32:
+        info->ukernel = op->sconv.name;
+        break;
+      case qnnp_format_float16:
+        info->ukernel = op->hconv.name;
+        break;
+      default:
+        info->ukernel = op->q8conv.name;
+        break;
+    }
+    info->mr = qnnp_operator_get_mr(op);
+  }
+
+  /* The packed layout also holds the channel tile of depthwise and the kc of XZP GEMM microkernels */
+  const struct qnnp_packed_weights* packed_weights = op->packed_weights;
+  info->nr = packed_weights->nr;
+  info->kr = packed_weights->kr;
+  info->kc = packed_weights->kc;
+  info->packed_kernel_size = packed_weights->packed_kernel_size;
+  info->bias_size = packed_weights->bias_size;
+  if (__atomic_load_n(&packed_weights->packing_state, __ATOMIC_ACQUIRE) == qnnp_packing_state_packed) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_PACKED;
+  }
+}
+
+/* Sizes of the buffers of the last setup, which fixed the batch size and input dimensions */
+static void get_operator_buffer_sizes(const struct qnnp_operator* op, struct qnnp_operator_info* info) {
+  if (op->batch_size == 0) {
+    return;
+  }
+
+  switch (op->type) {
+    case qnnp_operator_type_convolution:
+    case qnnp_operator_type_max_pooling:
+    case qnnp_operator_type_average_pooling:
+    {
+      if (op->roi_count != 0) {
+        /* Pointers of every tap and group for the tiled output pixels of all crops */
+        info->im2col_buffer_size = sizeof(void*) * op->groups *
+          round_up(op->output_width, qnnp_operator_get_mr(op)) * op->kernel_height * op->kernel_width;
+        break;
+      }
+      size_t scratch_size;
+      qnnp_get_convolution2d_nhwc_q8_workspace_size(
+        (qnnp_operator_t) op, op->batch_size, op->input_height, op->input_width,
+        &info->im2col_buffer_size, &scratch_size);
+      if (op->flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) {
+        info->transformed_input_size = scratch_size;
+      } else {
+        info->expanded_input_size = scratch_size;
+      }
+      break;
+    }
+    case qnnp_operator_type_deconvolution:
+      qnnp_get_deconvolution2d_nhwc_q8_workspace_size(
+        (qnnp_operator_t) op, op->batch_size, op->input_height, op->input_width, &info->im2col_buffer_size);
+      break;
+    case qnnp_operator_type_fully_connected:
+      if (op->split_k_slice != 0) {
+        /* Fully-connected operators store the batch size as input_height */
+        const size_t slices = divide_round_up(op->group_input_channels, op->split_k_slice);
+        info->split_k_buffer_size = sizeof(int32_t) * slices * op->input_height * op->group_output_channels;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+enum qnnp_status qnnp_get_operator_info(
+    qnnp_operator_t op,
+    struct qnnp_operator_info* info)
+{
+  memset(info, 0, sizeof(struct qnnp_operator_info));
+  info->path = get_operator_path(op);
+
+  if (op->flags & QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_SIGNED_KERNEL;
+  }
+  if (op->flags & QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_FOLDED_ZERO_POINT;
+  }
+  if (op->flags & QNNP_CONVOLUTION_FLAG_XZP_CONV) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_XZP;
+  }
+  if (op->flags & QNNP_CONVOLUTION_FLAG_PER_CHANNEL) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_PER_CHANNEL;
+  }
+  if (op->flags & QNNP_CONVOLUTION_FLAG_FP32_REQUANTIZATION) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_FP32_REQUANTIZATION;
+  }
+  if (op->flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_SUBPIXEL;
+  }
+  if (op->flags & QNNP_CONVOLUTION_FLAG_ACC16) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_ACC16;
+  }
+  if (op->flags & QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_GROUP_BLOCKS;
+  }
+  if (op->flags & QNNP_CONVOLUTION_FLAG_SPARSE) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_SPARSE;
+  }
+  if (op->flags & QNNP_CONVOLUTION_FLAG_4BIT) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_4BIT_KERNEL;
+  }
+  if (op->tile_indirection) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_TILE_INDIRECTION;
+  }
+  if (op->indirection_offsets) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_INDIRECTION_OFFSETS;
+  }
+  if (op->split_k_slice != 0) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_SPLIT_K;
+  }
+  if (op->accumulator_output != qnnp_accumulator_output_none) {
+    info->flags |= QNNP_OPERATOR_INFO_FLAG_ACCUMULATOR_OUTPUT;
+  }
+
+  if (info->path != qnnp_operator_path_none && op->packed_weights != NULL) {
+    get_operator_ukernel(op, info);
+  }
+  get_operator_buffer_sizes(op, info);
+  return qnnp_status_success;
+}
@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+#include <qnnpack/allocator.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/pack.h>
+#include <qnnpack/packed-weights.h>
+#include <qnnpack/params.h>
+
+/* Padding only affects per-operator buffers, and the output layout only the stores, not the packed weights */
+#define QNNP_PACKED_WEIGHTS_FLAGS_MASK (~(QNNP_CONVOLUTION_FLAG_ZERO | QNNP_CONVOLUTION_FLAG_TRANSPOSED_OUTPUT))
+
+static void get_packed_layout(const struct qnnp_operator* op, uint32_t* nr, uint32_t* kr, uint32_t* kc) {
+  *nr = op->q8conv.nr;
+  *kr = op->q8conv.kr;
+  *kc = 0;
+  if (op->format == qnnp_format_float32) {
+    *nr = op->sconv.nr;
+    *kr = 1;
+  } else if (op->format == qnnp_format_float16) {
+    *nr = op->hconv.nr;
+    *kr = 1;
+  } else if (op->flags & QNNP_CONVOLUTION_FLAG_DW) {
+    *nr = op->kernel_height * op->kernel_width == 9 ? qnnp_params.q8dw9.cr : qnnp_params.q8dw25.cr;
+    *kr = 0;
+  } else if (op->flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
+    *nr = qnnp_params.q8conv_xzp.nr;
+    *kr = qnnp_params.q8conv_xzp.kr;
+    *kc = qnnp_params.q8conv_xzp.kc;
+  } else if (op->flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) {
+    *nr = QNNP_WINOGRAD_NR;
+    *kr = 1;
+  }
+}
+
+enum qnnp_status qnnp_attach_new_packed_weights(
+    qnnp_operator_t op,
+    const void* kernel,
+    const void* bias,
+    size_t packed_kernel_size,
+    size_t bias_size)
+{
+  struct qnnp_packed_weights* packed_weights = malloc(sizeof(struct qnnp_packed_weights));
+  if (packed_weights == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for packed weights structure", sizeof(struct qnnp_packed_weights));
+    return qnnp_status_out_of_memory;
+  }
+
+  *packed_weights = (struct qnnp_packed_weights) {
+    .reference_count = 1,
+    .packing_state = qnnp_packing_state_unpacked,
+    .type = op->type,
+    .format = op->format,
+    .flags = op->flags & QNNP_PACKED_WEIGHTS_FLAGS_MASK,
+    .kernel_height = op->kernel_height,
+    .kernel_width = op->kernel_width,
+    .groups = op->groups,
+    .group_input_channels = op->group_input_channels,
+    .group_output_channels = op->group_output_channels,
+    .input_zero_point = op->input_zero_point,
+    .kernel_zero_point = op->kernel_zero_point,
+    .packed_kernel_size = packed_kernel_size,
+    .bias_size = bias_size,
+    .unpacked_kernel = kernel,
+    .unpacked_bias = bias,
+    .block_groups = 1,
+  };
+  if (op->flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL) {
+    packed_weights->stride_height = op->stride_height;
+    packed_weights->stride_width = op->stride_width;
+    packed_weights->dilation_height = op->dilation_height;
+    packed_weights->dilation_width = op->dilation_width;
+  }
+  get_packed_layout(op, &packed_weights->nr, &packed_weights->kr, &packed_weights->kc);
+  op->packed_weights = packed_weights;
+  return qnnp_status_success;
+}
+
+struct pack_context {
+  const struct qnnp_packed_weights* packed_weights;
+  size_t kernel_size;
+  /* Input channels of each tap of the kernel */
+  size_t k;
+  size_t k_stride;
+  /* Bytes of packed kernel per output channel, see qnnp_get_packed_channel_stride */
+  size_t channel_stride;
+  size_t n_stride;
+  const uint8_t* kernel;
+  const int32_t* bias;
+  const float* kernel_scales;
+  uint8_t* packed_kernel;
+  int32_t* packed_bias;
+};
+
+static void compute_pack_dw(
+    const struct pack_context context[restrict static 1],
+    size_t channel_start,
+    size_t channel_range)
+{
+  const struct qnnp_packed_weights* packed_weights = context->packed_weights;
+  const size_t cr = packed_weights->nr;
+  const size_t block_size = (sizeof(int32_t) + sizeof(uint8_t) * context->kernel_size) * cr;
+  void* packed_w = context->packed_kernel + channel_start / cr * block_size;
+
+  /* Channels past the last one are never read, but clearing them makes packing deterministic */
+  memset(packed_w, 0, block_size);
+  pack_q8dw_w(
+    packed_weights->kernel_height, packed_weights->kernel_width,
+    channel_range, cr,
+    context->kernel + channel_start * context->kernel_size,
+    context->bias + channel_start,
+    packed_w);
+}
+
+static void compute_pack_gemm(
+    const struct pack_context context[restrict static 1],
+    size_t group,
+    size_t nr_block_start,
+    size_t group_range,
+    size_t nr_block_size)
+{
+  const struct qnnp_packed_weights* packed_weights = context->packed_weights;
+  const size_t kernel_size = context->kernel_size;
+  const size_t k_stride = context->k_stride;
+  const size_t n = packed_weights->group_output_channels;
+  const size_t k = context->k;
+  const uint32_t nr = packed_weights->nr;
+  const uint32_t kr = packed_weights->kr;
+  /* With QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS, groups of the unpacked kernel have block_groups times fewer channels */
+  const uint8_t* kernel = context->kernel + group * n * kernel_size * (k / packed_weights->block_groups);
+  uint8_t* packed_kernel =
+    context->packed_kernel + (group * context->n_stride + nr_block_start) * context->channel_stride;
+
+  /* The XZP microkernels need the padding to be 0; others need the kernel zero point */
+  const bool xzp = (packed_weights->flags & (QNNP_CONVOLUTION_FLAG_XZP_GEMM | QNNP_CONVOLUTION_FLAG_XZP_CONV)) != 0;
+  /* With two values per byte, see pack_q8gemm_4bit_b, the padding has the zero point in both nibbles */
+  const bool four_bit = (packed_weights->flags & QNNP_CONVOLUTION_FLAG_4BIT) != 0;
+  const uint8_t kernel_zero_point = packed_weights->kernel_zero_point;
+  const size_t block_size = four_bit ? nr * k_stride / 2 : nr * kernel_size * k_stride;
+  memset(
+    packed_kernel, xzp ? 0 : four_bit ? kernel_zero_point | (kernel_zero_point << 4) : kernel_zero_point,
+    sizeof(uint8_t) * block_size);
+  /* Microkernels never read the alignment padding of the block, but clearing it makes packing deterministic */
+  memset(packed_kernel + block_size, 0, sizeof(uint8_t) * (nr * context->channel_stride - block_size));
+
+  if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL) {
+    pack_q8deconv_b_nr_block_subpixel(
+      n, nr_block_start,
+      packed_weights->kernel_height, packed_weights->kernel_width,
+      packed_weights->stride_height, packed_weights->stride_width,
+      packed_weights->dilation_height, packed_weights->dilation_width,
+      k, nr, kr,
+      kernel,
+      packed_kernel - nr_block_start * kernel_size * k_stride);
+  } else if (packed_weights->type == qnnp_operator_type_deconvolution) {
+    /* Deconvolution kernels are transposed, so the block is packed relative to the start of the group */
+    pack_q8deconv_b_nr_block(
+      n, nr_block_start, kernel_size, k, nr, kr,
+      kernel,
+      packed_kernel - nr_block_start * kernel_size * k_stride);
+  } else if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_XZP_GEMM) {
+    pack_q8gemm_b_diagonal(
+      nr_block_size, k, nr, kr, packed_weights->kc,
+      kernel + nr_block_start * k,
+      packed_kernel);
+  } else if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS) {
+    /* The merged group fits into a single nr-block */
+    const size_t block_groups = packed_weights->block_groups;
+    pack_q8conv_b_group_block(
+      n / block_groups, block_groups, kernel_size, k / block_groups, nr, kr,
+      kernel,
+      packed_kernel);
+  } else if (four_bit) {
+    pack_q8gemm_4bit_b(
+      nr_block_size, k, nr, kr,
+      kernel + nr_block_start * k,
+      packed_kernel);
+  } else if (kernel_size == 1) {
+    pack_q8gemm_b(
+      nr_block_size, k, nr, kr,
+      kernel + nr_block_start * k,
+      packed_kernel);
+  } else {
+    pack_q8conv_b(
+      nr_block_size, kernel_size, k, nr, kr,
+      kernel + nr_block_start * kernel_size * k,
+      packed_kernel);
+  }
+
+  const bool per_channel = (packed_weights->flags & QNNP_CONVOLUTION_FLAG_PER_CHANNEL) != 0;
+  int32_t* packed_bias =
+    context->packed_bias + (group * context->n_stride + nr_block_start) * (per_channel ? 2 : 1);
+  memset(packed_bias, 0, sizeof(int32_t) * nr);
+  memcpy(packed_bias, context->bias + group * n + nr_block_start, sizeof(int32_t) * nr_block_size);
+  if (xzp) {
+    /* Fold the product of the input zero point and the kernel rows, which span all taps, into the bias */
+    const size_t row_size = kernel_size * k;
+    const int32_t input_zero_point = (int32_t) (uint32_t) packed_weights->input_zero_point;
+    const int32_t zero_point_product =
+      (int32_t) row_size * input_zero_point * (int32_t) (uint32_t) packed_weights->kernel_zero_point;
+    for (size_t i = 0; i < nr_block_size; i++) {
+      const uint8_t* row = kernel + (nr_block_start + i) * row_size;
+      int32_t row_sum = 0;
+      for (size_t j = 0; j < row_size; j++) {
+        row_sum += (int32_t) (uint32_t) row[j];
+      }
+      packed_bias[i] += zero_point_product - input_zero_point * row_sum;
+    }
+  }
+  if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL) {
+    /*
+     * Store the kernel, including the padding with zero point 128, as int8 values and fold the input zero point into
+     * the bias: sum (a - input_zero_point) * b' = sum a * b' - input_zero_point * sum b', where b' = b - 128
+     */
+    const int32_t input_zero_point = (int32_t) (uint32_t) packed_weights->input_zero_point;
+    for (size_t i = 0; i < nr * kernel_size * k_stride; i++) {
+      packed_kernel[i] ^= 0x80;
+      packed_bias[i / kr % nr] -= input_zero_point * (int32_t) (int8_t) packed_kernel[i];
+    }
+  }
+  if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT) {
+    fold_q8conv_input_zero_point(
+      nr * kernel_size * k_stride, nr, kr,
+      packed_weights->input_zero_point, kernel_zero_point,
+      packed_kernel, packed_bias);
+  }
+  if (per_channel) {
+    /* Scales of padding output channels are never used, but clearing them makes packing deterministic */
+    float* packed_scales = (float*) (packed_bias + nr);
+    const float* kernel_scales = context->kernel_scales + group * n + nr_block_start;
+    for (size_t i = 0; i < nr; i++) {
+      packed_scales[i] = i < nr_block_size ? packed_weights->input_output_scale * kernel_scales[i] : 0.0f;
+    }
+  }
+}
+
+static void compute_pack_winograd(
+    const struct pack_context context[restrict static 1],
+    size_t group,
+    size_t nr_block_start,
+    size_t group_range,
+    size_t nr_block_size)
+{
+  const struct qnnp_packed_weights* packed_weights = context->packed_weights;
+  const size_t n = packed_weights->group_output_channels;
+  const size_t k = packed_weights->group_input_channels;
+  const uint32_t nr = packed_weights->nr;
+  const uint8_t* kernel = context->kernel + (group * n + nr_block_start) * context->kernel_size * k;
+  int16_t* packed_kernel =
+    (int16_t*) context->packed_kernel + (group * context->n_stride + nr_block_start) * 16 * k;
+
+  /* Padding output channels multiply by zero weights and are never stored */
+  memset(packed_kernel, 0, sizeof(int16_t) * 16 * k * nr);
+  pack_q8winograd_w(nr_block_size, k, nr, packed_weights->kernel_zero_point, kernel, packed_kernel);
+
+  int32_t* packed_bias = context->packed_bias + group * context->n_stride + nr_block_start;
+  memset(packed_bias, 0, sizeof(int32_t) * nr);
+  memcpy(packed_bias, context->bias + group * n + nr_block_start, sizeof(int32_t) * nr_block_size);
+}
+
+static void compute_pack_sconv(
+    const struct pack_context context[restrict static 1],
+    size_t group,
+    size_t nr_block_start,
+    size_t group_range,
+    size_t nr_block_size)
+{
+  const struct qnnp_packed_weights* packed_weights = context->packed_weights;
+  const size_t kernel_size = context->kernel_size;
+  const size_t n = packed_weights->group_output_channels;
+  const size_t k = packed_weights->group_input_channels;
+  const uint32_t nr = packed_weights->nr;
+  const float* kernel = (const float*) context->kernel + group * n * kernel_size * k;
+  float* packed_kernel =
+    (float*) context->packed_kernel + (group * context->n_stride + nr_block_start) * kernel_size * k;
+
+  /* Padding output channels multiply by zero weights and are never stored */
+  memset(packed_kernel, 0, sizeof(float) * nr * kernel_size * k);
+  pack_sconv_b(
+    nr_block_size, kernel_size, k, nr,
+    kernel + nr_block_start * kernel_size * k,
+    packed_kernel);
+
+  float* packed_bias = (float*) context->packed_bias + group * context->n_stride + nr_block_start;
+  memset(packed_bias, 0, sizeof(float) * nr);
+  memcpy(packed_bias, (const float*) context->bias + group * n + nr_block_start, sizeof(float) * nr_block_size);
+}
+
+static void compute_pack_hconv(
+    const struct pack_context context[restrict static 1],
+    size_t group,
+    size_t nr_block_start,
+    size_t group_range,
+    size_t nr_block_size)
+{
+  const struct qnnp_packed_weights* packed_weights = context->packed_weights;
+  const size_t kernel_size = context->kernel_size;
+  const size_t n = packed_weights->group_output_channels;
+  const size_t k = packed_weights->group_input_channels;
+  const uint32_t nr = packed_weights->nr;
+  const uint16_t* kernel = (const uint16_t*) context->kernel + group * n * kernel_size * k;
+  uint16_t* packed_kernel =
+    (uint16_t*) context->packed_kernel + (group * context->n_stride + nr_block_start) * kernel_size * k;
+
+  memset(packed_kernel, 0, sizeof(uint16_t) * nr * kernel_size * k);
+  pack_hconv_b(
+    nr_block_size, kernel_size, k, nr,
+    kernel + nr_block_start * kernel_size * k,
+    packed_kernel);
+
+  uint16_t* packed_bias = (uint16_t*) context->packed_bias + group * context->n_stride + nr_block_start;
+  memset(packed_bias, 0, sizeof(uint16_t) * nr);
+  memcpy(packed_bias, (const uint16_t*) context->bias + group * n + nr_block_start, sizeof(uint16_t) * nr_block_size);
+}
+
+static enum qnnp_status pack_weights(
+    struct qnnp_packed_weights* packed_weights,
+    pthreadpool_t threadpool)
+{
+  uint8_t* packed_kernel = qnnp_allocate_weights(packed_weights->packed_kernel_size);
+  if (packed_kernel == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for packed kernel data", packed_weights->packed_kernel_size);
+    return qnnp_status_out_of_memory;
+  }
+  int32_t* packed_bias = NULL;
+  if (packed_weights->bias_size != 0) {
+    packed_bias = qnnp_allocate_weights(packed_weights->bias_size);
+    if (packed_bias == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for packed bias data", packed_weights->bias_size);
+      qnnp_deallocate_weights(packed_kernel);
+      return qnnp_status_out_of_memory;
+    }
+  }
+
+  const size_t kernel_size = packed_weights->type == qnnp_operator_type_fully_connected ?
+    1 : (size_t) packed_weights->kernel_height * (size_t) packed_weights->kernel_width;
+  struct pack_context context = {
+    .packed_weights = packed_weights,
+    .kernel_size = kernel_size,
+    .kernel = packed_weights->unpacked_kernel,
+    .bias = packed_weights->unpacked_bias,
+    .kernel_scales = packed_weights->unpacked_kernel_scales,
+    .packed_kernel = packed_kernel,
+    .packed_bias = packed_bias,
+  };
+  if (packed_weights->format == qnnp_format_float32 || packed_weights->format == qnnp_format_float16) {
+    const uint32_t nr = packed_weights->nr;
+    context.n_stride = (packed_weights->group_output_channels + (nr - 1)) & -nr;
+    pthreadpool_compute_2d_tiled(
+      threadpool,
+      (pthreadpool_function_2d_tiled_t) (packed_weights->format == qnnp_format_float32 ?
+        compute_pack_sconv : compute_pack_hconv),
+      &context,
+      packed_weights->groups, packed_weights->group_output_channels,
+      1, nr);
+  } else if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_DW) {
+    /* With a channel multiplier, each group produces group_output_channels consecutive output channels */
+    pthreadpool_compute_1d_tiled(
+      threadpool,
+      (pthreadpool_function_1d_tiled_t) compute_pack_dw,
+      &context,
+      packed_weights->groups * packed_weights->group_output_channels,
+      packed_weights->nr);
+  } else if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_WINOGRAD) {
+    const uint32_t nr = packed_weights->nr;
+    context.n_stride = (packed_weights->group_output_channels + (nr - 1)) & -nr;
+    pthreadpool_compute_2d_tiled(
+      threadpool,
+      (pthreadpool_function_2d_tiled_t) compute_pack_winograd,
+      &context,
+      packed_weights->groups, packed_weights->group_output_channels,
+      1, nr);
+  } else if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_SPARSE) {
+    /* Blocks of every output channel start where those of the previous one end, so this is packed sequentially */
+    const uint32_t nr = packed_weights->nr;
+    const size_t n = packed_weights->group_output_channels;
+    const size_t n_stride = (n + (nr - 1)) & -nr;
+    pack_q8gemm_sparse_w(
+      n, packed_weights->group_input_channels, n_stride, packed_weights->kr,
+      packed_weights->kernel_zero_point, context.kernel, packed_kernel);
+    memset(packed_bias, 0, sizeof(int32_t) * n_stride);
+    memcpy(packed_bias, context.bias, sizeof(int32_t) * n);
+  } else {
+    const uint32_t nr = packed_weights->nr;
+    const uint32_t kr = packed_weights->kr;
+    context.k = packed_weights->group_input_channels;
+    if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_NCHW) {
+      /* Every input channel of a kernel position is a tap, so the kernel is packed as is with one channel per tap */
+      context.kernel_size *= context.k;
+      context.k = 1;
+    } else if (packed_weights->flags & QNNP_CONVOLUTION_FLAG_STEM) {
+      /* Every row of the kernel is a tap, with the channels of its kernel_width positions */
+      context.kernel_size = packed_weights->kernel_height;
+      context.k *= packed_weights->kernel_width;
+    }
+    context.k_stride = (context.k + (kr - 1)) & -kr;
+    context.channel_stride = (packed_weights->flags & QNNP_CONVOLUTION_FLAG_4BIT) ?
+      qnnp_get_4bit_packed_channel_stride(context.k, nr, kr) :
+      qnnp_get_packed_channel_stride(context.kernel_size, context.k, nr, kr);
+    context.n_stride = (packed_weights->group_output_channels + (nr - 1)) & -nr;
+    pthreadpool_compute_2d_tiled(
+      threadpool,
+      (pthreadpool_function_2d_tiled_t) compute_pack_gemm,
+      &context,
+      packed_weights->groups, packed_weights->group_output_channels,
+      1, nr);
+  }
+
+  packed_weights->packed_kernel = packed_kernel;
+  packed_weights->bias = packed_bias;
+  packed_weights->unpacked_kernel = NULL;
+  packed_weights->unpacked_bias = NULL;
+  packed_weights->unpacked_kernel_scales = NULL;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_ensure_packed_weights(qnnp_operator_t op, pthreadpool_t threadpool) {
+  struct qnnp_packed_weights* packed_weights = op->packed_weights;
+  for (;;) {
+    uint32_t state = __atomic_load_n(&packed_weights->packing_state, __ATOMIC_ACQUIRE);
+    if (state == qnnp_packing_state_packed) {
+      break;
+    }
+    if (state == qnnp_packing_state_unpacked &&
+        __atomic_compare_exchange_n(
+          &packed_weights->packing_state, &state, qnnp_packing_state_packing,
+          false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      const enum qnnp_status status = pack_weights(packed_weights, threadpool);
+      if (status != qnnp_status_success) {
+        /* Leave the weights unpacked, so that a later call may retry */
+        __atomic_store_n(&packed_weights->packing_state, qnnp_packing_state_unpacked, __ATOMIC_RELEASE);
+        return status;
+      }
+      __atomic_store_n(&packed_weights->packing_state, qnnp_packing_state_packed, __ATOMIC_RELEASE);
+      break;
+    }
+    /* Another operator sharing the weights is packing them */
+    sched_yield();
+  }
+
+  op->packed_kernel = packed_weights->packed_kernel;
+  op->bias = packed_weights->bias;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_attach_packed_weights(qnnp_operator_t op, qnnp_packed_weights_t packed_weights) {
+  uint32_t nr, kr, kc;
+  get_packed_layout(op, &nr, &kr, &kc);
+  if (packed_weights->type != op->type ||
+      packed_weights->format != op->format ||
+      packed_weights->flags != (op->flags & QNNP_PACKED_WEIGHTS_FLAGS_MASK) ||
+      packed_weights->kernel_height != op->kernel_height ||
+      packed_weights->kernel_width != op->kernel_width ||
+      packed_weights->groups != op->groups ||
+      packed_weights->group_input_channels != op->group_input_channels ||
+      packed_weights->group_output_channels != op->group_output_channels ||
+      packed_weights->input_zero_point != op->input_zero_point ||
+      packed_weights->kernel_zero_point != op->kernel_zero_point ||
+      ((op->flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL) &&
+        (packed_weights->stride_height != op->stride_height || packed_weights->stride_width != op->stride_width ||
+         packed_weights->dilation_height != op->dilation_height ||
+         packed_weights->dilation_width != op->dilation_width)) ||
+      packed_weights->nr != nr || packed_weights->kr != kr || packed_weights->kc != kc)
+  {
+    qnnp_log_error("failed to create operator: packed weights were created for an operator with different parameters");
+    return qnnp_status_invalid_parameter;
+  }
+
+  __atomic_fetch_add(&packed_weights->reference_count, 1, __ATOMIC_RELAXED);
+  op->packed_weights = packed_weights;
+  if (__atomic_load_n(&packed_weights->packing_state, __ATOMIC_ACQUIRE) == qnnp_packing_state_packed) {
+    op->packed_kernel = packed_weights->packed_kernel;
+    op->bias = packed_weights->bias;
+  }
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_get_packed_weights(
+    qnnp_operator_t op,
+    qnnp_packed_weights_t* packed_weights_out)
+{
+  if (op->packed_weights == NULL) {
+    qnnp_log_error("failed to get packed weights: operator has no packed weights");
+    return qnnp_status_invalid_parameter;
+  }
+
+  __atomic_fetch_add(&op->packed_weights->reference_count, 1, __ATOMIC_RELAXED);
+  *packed_weights_out = op->packed_weights;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_release_packed_weights(
+    qnnp_packed_weights_t packed_weights)
+{
+  if (packed_weights == NULL) {
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (__atomic_sub_fetch(&packed_weights->reference_count, 1, __ATOMIC_ACQ_REL) == 0) {
+    if (!packed_weights->external_memory) {
+      qnnp_deallocate_weights(packed_weights->packed_kernel);
+      qnnp_deallocate_weights(packed_weights->bias);
+    }
+    if (packed_weights->mapping != NULL) {
+      munmap(packed_weights->mapping, packed_weights->mapping_size);
+    }
+    free(packed_weights);
+  }
+  return qnnp_status_success;
+}
@@ -0,0 +1,1165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cpuinfo.h>
+
+#include <qnnpack.h>
+#include <qnnpack/affinity-pool.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/math.h>
+#include <qnnpack/packed-weights.h>
+#include <qnnpack/params.h>
+
+/*
+ * Microkernels load the last few channels of a pixel with a full 8-byte load ending at the last channel, which can
+ * start before the first block in memory.
+ */
+#define QNNP_PLAN_MEMORY_PADDING 16
+#define QNNP_PLAN_BLOCK_ALIGNMENT 16
+
+/* "QNPS" in little-endian byte order */
+#define QNNP_PLAN_SNAPSHOT_MAGIC UINT32_C(0x53504E51)
+#define QNNP_PLAN_SNAPSHOT_VERSION 1
+/* Serialized operators and workspace images start at cache line multiples, as in serialized operators */
+#define QNNP_PLAN_SNAPSHOT_ALIGNMENT 64
+#define QNNP_PLAN_SNAPSHOT_NAME_SIZE 32
+/* Workspace image entry of pointer indirection buffers for taps that read the zero buffer */
+#define QNNP_PLAN_SNAPSHOT_ZERO UINT64_MAX
+
+/* Instruction set extensions init.c selects microkernels by, see get_isa_features */
+#define QNNP_PLAN_ISA_X86_AVX2 UINT32_C(0x1)
+#define QNNP_PLAN_ISA_X86_AVX512VNNI UINT32_C(0x2)
+#define QNNP_PLAN_ISA_ARM_NEON_DOT UINT32_C(0x1)
+#define QNNP_PLAN_ISA_ARM_NEON_FP16_ARITH UINT32_C(0x2)
+#define QNNP_PLAN_ISA_RISCV_V UINT32_C(0x1)
+
+enum qnnp_plan_workspace_encoding {
+  qnnp_plan_workspace_none = 0,
+  /* 32-bit pixel indices, which do not depend on any pointer and are stored verbatim */
+  qnnp_plan_workspace_offsets = 1,
+  /* Pointers, stored as 64-bit offsets from the indirection base, or QNNP_PLAN_SNAPSHOT_ZERO */
+  qnnp_plan_workspace_pointers = 2,
+};
+
+/* The operators of a node point their indirection buffers into the input of the node or into its scratch */
+enum qnnp_plan_indirection_base {
+  qnnp_plan_indirection_base_input = 0,
+  qnnp_plan_indirection_base_scratch = 1,
+};
+
+struct qnnp_plan_node {
+  qnnp_operator_t op;
+  /* Arguments for the setup function of the operator; batch_size is the number of rows for fully-connected */
+  size_t batch_size;
+  size_t input_height;
+  size_t input_width;
+  size_t input_stride;
+  size_t output_stride;
+  /* Shape of the output tensor, which is the input of the next node */
+  size_t output_height;
+  size_t output_width;
+  size_t output_channels;
+  size_t workspace_size;
+  size_t scratch_size;
+  /* Multiply-adds of a run, compared against the serial threshold of the plan */
+  uint64_t macs;
+  /* Offsets in plan memory; output_offset is unused for the last node, which writes to the caller's output */
+  size_t output_offset;
+  size_t workspace_offset;
+  size_t scratch_offset;
+  /*
+   * Indirection buffer of a plan restored from a snapshot, which setup copies into the workspace instead of building
+   * it, or NULL. Pointers are offsets from indirection_base_offset bytes into the input or scratch of the node.
+   */
+  const void* workspace_image;
+  enum qnnp_plan_workspace_encoding workspace_encoding;
+  enum qnnp_plan_indirection_base indirection_base;
+  size_t indirection_base_offset;
+};
+
+struct qnnp_plan_block {
+  size_t size;
+  /* Nodes from first_node to last_node inclusive use the block */
+  size_t first_node;
+  size_t last_node;
+  size_t* offset;
+};
+
+struct qnnp_plan {
+  size_t batch_size;
+  size_t input_height;
+  size_t input_width;
+  size_t input_channels;
+
+  struct qnnp_plan_node* nodes;
+  size_t nodes_count;
+  size_t nodes_capacity;
+
+  /* Size of memory for intermediate tensors and operator workspaces, including padding */
+  size_t memory_size;
+  /* Caller-provided memory, or NULL if the plan allocates its own buffer */
+  void* external_memory;
+  size_t external_memory_size;
+  void* buffer;
+  size_t buffer_size;
+
+  /* Pool that runs the operators instead of the thread pool argument, or NULL */
+  qnnp_affinity_pool_t affinity_pool;
+  bool spin_wait;
+  uint64_t serial_macs_threshold;
+
+  bool ready;
+  const uint8_t* input;
+  uint8_t* output;
+
+  /* Nodes before this index run operators the plan created from a snapshot and deletes with itself */
+  size_t owned_operators_count;
+  /* Read-only mapping of the snapshot file the plan was restored from, or NULL, see qnnp_create_plan_from_file */
+  void* mapping;
+  size_t mapping_size;
+};
+
+/*
+ * A snapshot starts with this header, followed by one qnnp_plan_snapshot_node per node, then the serialized operator
+ * and the workspace image of every node. Fields use the byte order of the machine, like serialized operators.
+ */
+struct qnnp_plan_snapshot_header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t pointer_size;
+  uint32_t isa_features;
+  /* Microkernels the plan was initialized with, which fix the layout of indirection buffers */
+  char q8conv_name[QNNP_PLAN_SNAPSHOT_NAME_SIZE];
+  char q8dw9_name[QNNP_PLAN_SNAPSHOT_NAME_SIZE];
+  char q8dw25_name[QNNP_PLAN_SNAPSHOT_NAME_SIZE];
+  uint32_t q8conv_mr;
+  uint32_t q8conv_nr;
+  uint32_t q8conv_kr;
+  uint32_t reserved;
+
+  uint64_t batch_size;
+  uint64_t input_height;
+  uint64_t input_width;
+  uint64_t input_channels;
+  uint64_t nodes_count;
+  uint64_t memory_size;
+};
+
+struct qnnp_plan_snapshot_node {
+  uint64_t batch_size;
+  uint64_t input_height;
+  uint64_t input_width;
+  uint64_t input_stride;
+  uint64_t output_stride;
+  uint64_t output_height;
+  uint64_t output_width;
+  uint64_t output_channels;
+  uint64_t workspace_size;
+  uint64_t scratch_size;
+  uint64_t macs;
+  uint64_t output_offset;
+  uint64_t workspace_offset;
+  uint64_t scratch_offset;
+
+  uint64_t operator_offset;
+  uint64_t operator_size;
+  /* QNNP_CREATE_FLAG_* flags the serialized operator does not record */
+  uint32_t create_flags;
+  uint32_t workspace_encoding;
+  uint64_t workspace_image_offset;
+  uint64_t workspace_image_size;
+  uint32_t indirection_base;
+  uint32_t reserved;
+  uint64_t indirection_base_offset;
+};
+
+enum qnnp_status qnnp_create_plan(
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t input_channels,
+    qnnp_plan_t* plan_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_plan failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to create plan with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (input_width == 0 || input_height == 0 || input_channels == 0) {
+    qnnp_log_error(
+      "failed to create plan with %zux%zux%zu input: input dimensions must be non-zero",
+      input_width, input_height, input_channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  struct qnnp_plan* plan = calloc(1, sizeof(struct qnnp_plan));
+  if (plan == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_plan structure", sizeof(struct qnnp_plan));
+    return qnnp_status_out_of_memory;
+  }
+
+  plan->batch_size = batch_size;
+  plan->input_height = input_height;
+  plan->input_width = input_width;
+  plan->input_channels = input_channels;
+
+  *plan_out = plan;
+  return qnnp_status_success;
+}
+
+/*
+ * Assigns offsets to the memory blocks of all nodes: the output tensor of node i is used by nodes i and i + 1, the
+ * scratch of node i only by node i, and workspaces, which hold indirection buffers built during setup, by all nodes.
+ * Blocks are placed from the largest down, each at the lowest offset that does not overlap a placed block used by
+ * an intersecting range of nodes.
+ */
+static enum qnnp_status plan_layout(struct qnnp_plan* plan) {
+  const size_t nodes_count = plan->nodes_count;
+  struct qnnp_plan_block* blocks = malloc(sizeof(struct qnnp_plan_block) * 3 * nodes_count);
+  if (blocks == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for plan memory layout", sizeof(struct qnnp_plan_block) * 3 * nodes_count);
+    return qnnp_status_out_of_memory;
+  }
+
+  size_t blocks_count = 0;
+  for (size_t i = 0; i < nodes_count; i++) {
+    struct qnnp_plan_node* node = &plan->nodes[i];
+    const struct qnnp_plan_block node_blocks[3] = {
+      {
+        .size = i + 1 == nodes_count ? 0 :
+          plan->batch_size * node->output_height * node->output_width * node->output_channels,
+        .first_node = i,
+        .last_node = i + 1,
+        .offset = &node->output_offset,
+      },
+      {
+        .size = node->workspace_size,
+        .first_node = 0,
+        .last_node = nodes_count - 1,
+        .offset = &node->workspace_offset,
+      },
+      {
+        .size = node->scratch_size,
+        .first_node = i,
+        .last_node = i,
+        .offset = &node->scratch_offset,
+      },
+    };
+    for (size_t k = 0; k < 3; k++) {
+      *node_blocks[k].offset = 0;
+      if (node_blocks[k].size != 0) {
+        /* Insertion sort by decreasing size */
+        struct qnnp_plan_block block = node_blocks[k];
+        block.size = round_up(block.size, QNNP_PLAN_BLOCK_ALIGNMENT);
+        size_t j = blocks_count++;
+        for (; j != 0 && blocks[j - 1].size < block.size; j--) {
+          blocks[j] = blocks[j - 1];
+        }
+        blocks[j] = block;
+      }
+    }
+  }
+
+  size_t memory_size = 0;
+  for (size_t i = 0; i < blocks_count; i++) {
+    const struct qnnp_plan_block* block = &blocks[i];
+    size_t offset = 0;
+    bool moved;
+    do {
+      moved = false;
+      for (size_t j = 0; j < i; j++) {
+        const struct qnnp_plan_block* placed_block = &blocks[j];
+        const size_t placed_offset = *placed_block->offset;
+        const bool live_together =
+          placed_block->first_node <= block->last_node && block->first_node <= placed_block->last_node;
+        if (live_together && offset < placed_offset + placed_block->size && placed_offset < offset + block->size) {
+          offset = placed_offset + placed_block->size;
+          moved = true;
+        }
+      }
+    } while (moved);
+    *block->offset = offset;
+    if (offset + block->size > memory_size) {
+      memory_size = offset + block->size;
+    }
+  }
+  free(blocks);
+
+  plan->memory_size = memory_size == 0 ? 0 : memory_size + QNNP_PLAN_MEMORY_PADDING;
+  return qnnp_status_success;
+}
+
+/*
+ * Computes the shapes, multiply-adds, and buffer sizes of a node that runs the operator after the last node of the
+ * plan, without the offsets of its buffers in plan memory.
+ */
+static enum qnnp_status init_node(
+    const struct qnnp_plan* plan,
+    qnnp_operator_t op,
+    struct qnnp_plan_node* node_out)
+{
+  size_t input_height = plan->input_height;
+  size_t input_width = plan->input_width;
+  size_t input_channels = plan->input_channels;
+  if (plan->nodes_count != 0) {
+    const struct qnnp_plan_node* previous_node = &plan->nodes[plan->nodes_count - 1];
+    input_height = previous_node->output_height;
+    input_width = previous_node->output_width;
+    input_channels = previous_node->output_channels;
+  }
+
+  if (op->format != qnnp_format_quint8) {
+    qnnp_log_error("failed to add operator to plan: plans only support quantized 8-bit operators");
+    return qnnp_status_invalid_parameter;
+  }
+
+  struct qnnp_plan_node node = {
+    .op = op,
+    .batch_size = plan->batch_size,
+    .input_height = input_height,
+    .input_width = input_width,
+    .input_stride = input_channels,
+  };
+  const size_t op_input_channels = op->groups * op->group_input_channels;
+  node.output_channels = op->groups * op->group_output_channels;
+  node.output_stride = node.output_channels;
+  switch (op->type) {
+    case qnnp_operator_type_convolution:
+      if (op_input_channels != input_channels) {
+        goto channels_mismatch;
+      }
+      node.output_height = compute_convolution_output_dimension(
+        op->input_padding_top + input_height + op->input_padding_bottom,
+        op->kernel_height, op->dilation_height, op->stride_height);
+      node.output_width = compute_convolution_output_dimension(
+        op->input_padding_left + input_width + op->input_padding_right,
+        op->kernel_width, op->dilation_width, op->stride_width);
+      break;
+    case qnnp_operator_type_deconvolution:
+      if (op_input_channels != input_channels) {
+        goto channels_mismatch;
+      }
+      node.output_height = compute_deconvolution_output_dimension(
+        input_height, op->input_padding_top + op->input_padding_bottom,
+        op->adjustment_height, op->kernel_height, op->dilation_height, op->stride_height);
+      node.output_width = compute_deconvolution_output_dimension(
+        input_width, op->input_padding_left + op->input_padding_right,
+        op->adjustment_width, op->kernel_width, op->dilation_width, op->stride_width);
+      break;
+    case qnnp_operator_type_fully_connected:
+      if (op_input_channels == input_channels) {
+        /* Every pixel is a row */
+        node.batch_size = plan->batch_size * input_height * input_width;
+        node.output_height = input_height;
+        node.output_width = input_width;
+      } else if (op_input_channels == input_height * input_width * input_channels) {
+        /* Every image is a row */
+        node.input_stride = input_height * input_width * input_channels;
+        node.output_height = 1;
+        node.output_width = 1;
+      } else {
+        goto channels_mismatch;
+      }
+      break;
+    default:
+      qnnp_log_error("failed to add operator to plan: only convolution, deconvolution, and fully-connected are supported");
+      return qnnp_status_unsupported_parameter;
+  }
+
+  const uint64_t kernel_size = (uint64_t) op->kernel_height * (uint64_t) op->kernel_width;
+  switch (op->type) {
+    case qnnp_operator_type_convolution:
+      node.macs = (uint64_t) node.batch_size * node.output_height * node.output_width * node.output_channels *
+        op->group_input_channels * kernel_size;
+      break;
+    case qnnp_operator_type_deconvolution:
+      node.macs = (uint64_t) node.batch_size * input_height * input_width * input_channels *
+        op->group_output_channels * kernel_size;
+      break;
+    default:
+      /* The batch size of a fully-connected node is its number of rows */
+      node.macs = (uint64_t) node.batch_size * node.output_channels * op->group_input_channels;
+      break;
+  }
+
+  switch (op->type) {
+    case qnnp_operator_type_convolution:
+      qnnp_get_convolution2d_nhwc_q8_workspace_size(
+        op, node.batch_size, input_height, input_width, &node.workspace_size, &node.scratch_size);
+      break;
+    case qnnp_operator_type_deconvolution:
+      qnnp_get_deconvolution2d_nhwc_q8_workspace_size(
+        op, node.batch_size, input_height, input_width, &node.workspace_size);
+      break;
+    default:
+      break;
+  }
+
+  *node_out = node;
+  return qnnp_status_success;
+
+channels_mismatch:
+  qnnp_log_error(
+    "failed to add operator with %zu input channels to plan: previous output has %zux%zux%zu shape",
+    op_input_channels, input_height, input_width, input_channels);
+  return qnnp_status_invalid_parameter;
+}
+
+static enum qnnp_status append_node(struct qnnp_plan* plan, const struct qnnp_plan_node* node) {
+  if (plan->nodes_count == plan->nodes_capacity) {
+    const size_t nodes_capacity = plan->nodes_capacity == 0 ? 8 : plan->nodes_capacity * 2;
+    struct qnnp_plan_node* nodes = realloc(plan->nodes, sizeof(struct qnnp_plan_node) * nodes_capacity);
+    if (nodes == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for plan nodes", sizeof(struct qnnp_plan_node) * nodes_capacity);
+      return qnnp_status_out_of_memory;
+    }
+    plan->nodes = nodes;
+    plan->nodes_capacity = nodes_capacity;
+  }
+  plan->nodes[plan->nodes_count++] = *node;
+  plan->ready = false;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_plan_add_operator(
+    qnnp_plan_t plan,
+    qnnp_operator_t op)
+{
+  struct qnnp_plan_node node;
+  enum qnnp_status status = init_node(plan, op, &node);
+  if (status != qnnp_status_success) {
+    return status;
+  }
+  status = append_node(plan, &node);
+  if (status != qnnp_status_success) {
+    return status;
+  }
+  status = plan_layout(plan);
+  if (status != qnnp_status_success) {
+    plan->nodes_count -= 1;
+  }
+  return status;
+}
+
+enum qnnp_status qnnp_get_plan_output_shape(
+    qnnp_plan_t plan,
+    size_t* output_height,
+    size_t* output_width,
+    size_t* output_channels)
+{
+  if (plan->nodes_count == 0) {
+    qnnp_log_error("failed to get plan output shape: plan has no operators");
+    return qnnp_status_invalid_parameter;
+  }
+
+  const struct qnnp_plan_node* last_node = &plan->nodes[plan->nodes_count - 1];
+  *output_height = last_node->output_height;
+  *output_width = last_node->output_width;
+  *output_channels = last_node->output_channels;
+  return qnnp_status_success;
+}
+
+static enum qnnp_status ensure_memory(struct qnnp_plan* plan) {
+  if (plan->external_memory != NULL) {
+    if (plan->external_memory_size < plan->memory_size) {
+      qnnp_log_error(
+        "failed to run plan with %zu bytes of memory: plan requires %zu bytes",
+        plan->external_memory_size, plan->memory_size);
+      return qnnp_status_invalid_parameter;
+    }
+    return qnnp_status_success;
+  }
+  if (plan->buffer_size >= plan->memory_size) {
+    return qnnp_status_success;
+  }
+  free(plan->buffer);
+  plan->buffer_size = 0;
+  plan->buffer = malloc(plan->memory_size);
+  if (plan->buffer == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for plan memory", plan->memory_size);
+    return qnnp_status_out_of_memory;
+  }
+  plan->buffer_size = plan->memory_size;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_get_plan_memory_size(
+    qnnp_plan_t plan,
+    size_t* memory_size)
+{
+  *memory_size = plan->memory_size;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_plan_set_memory(
+    qnnp_plan_t plan,
+    void* memory,
+    size_t memory_size)
+{
+  if (memory != NULL && memory_size < plan->memory_size) {
+    qnnp_log_error(
+      "failed to set plan memory of %zu bytes: plan requires %zu bytes", memory_size, plan->memory_size);
+    return qnnp_status_invalid_parameter;
+  }
+  if (memory != NULL && ((uintptr_t) memory % QNNP_PLAN_BLOCK_ALIGNMENT) != 0) {
+    qnnp_log_error("failed to set plan memory: memory must be aligned to %d bytes", QNNP_PLAN_BLOCK_ALIGNMENT);
+    return qnnp_status_invalid_parameter;
+  }
+
+  plan->external_memory = memory;
+  plan->external_memory_size = memory_size;
+  if (memory != NULL) {
+    free(plan->buffer);
+    plan->buffer = NULL;
+    plan->buffer_size = 0;
+  }
+  plan->ready = false;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_plan_set_affinity_pool(
+    qnnp_plan_t plan,
+    qnnp_affinity_pool_t pool,
+    bool spin_wait)
+{
+  plan->affinity_pool = pool;
+  plan->spin_wait = spin_wait;
+  /* Operators size their tasks for the number of threads during setup */
+  plan->ready = false;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_plan_set_serial_threshold(
+    qnnp_plan_t plan,
+    uint64_t macs_threshold)
+{
+  plan->serial_macs_threshold = macs_threshold;
+  plan->ready = false;
+  return qnnp_status_success;
+}
+
+/*
+ * Points the operator of the node to the threads it runs on for the plan, and returns the thread pool argument for
+ * its setup and run calls. The caller restores the scheduler of the operator, which is saved, afterwards.
+ */
+static pthreadpool_t bind_node_threads(
+    const struct qnnp_plan* plan,
+    size_t index,
+    pthreadpool_t threadpool,
+    struct qnnp_scheduler* saved_scheduler)
+{
+  struct qnnp_operator* op = plan->nodes[index].op;
+  *saved_scheduler = op->scheduler;
+  if (plan->nodes[index].macs < plan->serial_macs_threshold) {
+    op->scheduler = (struct qnnp_scheduler) { 0 };
+    return NULL;
+  }
+  if (plan->affinity_pool != NULL) {
+    qnnp_get_affinity_pool_scheduler(plan->affinity_pool, &op->scheduler);
+  }
+  return threadpool;
+}
+
+/*
+ * Copies the indirection buffer of a node from the snapshot of the plan into its workspace, with pointers into the
+ * current input or scratch of the node, so that the setup of its operator keeps the buffer rather than building it.
+ */
+static void restore_node_workspace(
+    const struct qnnp_plan_node* node,
+    const uint8_t* input,
+    uint8_t* scratch,
+    void* workspace)
+{
+  struct qnnp_operator* op = node->op;
+  const uint8_t* base =
+    (node->indirection_base == qnnp_plan_indirection_base_scratch ? scratch : input) + node->indirection_base_offset;
+  if (node->workspace_encoding == qnnp_plan_workspace_offsets) {
+    memcpy(workspace, node->workspace_image, node->workspace_size);
+    op->indirection_offsets = true;
+  } else {
+    const uint64_t* image = (const uint64_t*) node->workspace_image;
+    const void** indirection_buffer = (const void**) workspace;
+    const void* zero = qnnp_get_indirection_zero(op);
+    const size_t indirection_buffer_size = node->workspace_size / sizeof(void*);
+    for (size_t i = 0; i < indirection_buffer_size; i++) {
+      indirection_buffer[i] = image[i] == QNNP_PLAN_SNAPSHOT_ZERO ?
+        zero : (const void*) ((uintptr_t) base + (uintptr_t) image[i]);
+    }
+    op->indirection_offsets = false;
+  }
+  op->prebuilt_indirection_input = base;
+}
+
+static enum qnnp_status setup_node_operator(
+    const struct qnnp_plan* plan,
+    size_t index,
+    const uint8_t* input,
+    uint8_t* output,
+    pthreadpool_t threadpool)
+{
+  const struct qnnp_plan_node* node = &plan->nodes[index];
+  uint8_t* memory = (uint8_t*) (plan->external_memory != NULL ? plan->external_memory : plan->buffer);
+  if (memory != NULL) {
+    memory += QNNP_PLAN_MEMORY_PADDING;
+  }
+  if (index != 0) {
+    input = memory + plan->nodes[index - 1].output_offset;
+  }
+  if (index + 1 != plan->nodes_count) {
+    output = memory + node->output_offset;
+  }
+  if (node->workspace_image != NULL) {
+    restore_node_workspace(node, input, memory + node->scratch_offset, memory + node->workspace_offset);
+  }
+
+  switch (node->op->type) {
+    case qnnp_operator_type_convolution:
+      return qnnp_setup_convolution2d_nhwc_q8_with_workspace(
+        node->op,
+        node->batch_size, node->input_height, node->input_width,
+        input, node->input_stride,
+        output, node->output_stride,
+        node->workspace_size != 0 ? memory + node->workspace_offset : NULL,
+        node->scratch_size != 0 ? memory + node->scratch_offset : NULL,
+        threadpool);
+    case qnnp_operator_type_deconvolution:
+      return qnnp_setup_deconvolution2d_nhwc_q8_with_workspace(
+        node->op,
+        node->batch_size, node->input_height, node->input_width,
+        input, node->input_stride,
+        output, node->output_stride,
+        memory + node->workspace_offset,
+        threadpool);
+    case qnnp_operator_type_fully_connected:
+      return qnnp_setup_fully_connected_nc_q8(
+        node->op,
+        node->batch_size,
+        input, node->input_stride,
+        output, node->output_stride,
+        threadpool);
+    default:
+      return qnnp_status_unsupported_parameter;
+  }
+}
+
+static enum qnnp_status setup_node(
+    const struct qnnp_plan* plan,
+    size_t index,
+    const uint8_t* input,
+    uint8_t* output,
+    pthreadpool_t threadpool)
+{
+  struct qnnp_scheduler scheduler;
+  threadpool = bind_node_threads(plan, index, threadpool, &scheduler);
+  const enum qnnp_status status = setup_node_operator(plan, index, input, output, threadpool);
+  plan->nodes[index].op->scheduler = scheduler;
+  return status;
+}
+
+enum qnnp_status qnnp_plan_run(
+    qnnp_plan_t plan,
+    const uint8_t* input,
+    uint8_t* output,
+    pthreadpool_t threadpool)
+{
+  enum qnnp_status status = qnnp_status_success;
+  const size_t nodes_count = plan->nodes_count;
+  if (nodes_count == 0) {
+    qnnp_log_error("failed to run plan: plan has no operators");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (!plan->ready) {
+    status = ensure_memory(plan);
+    if (status != qnnp_status_success) {
+      return status;
+    }
+    for (size_t i = 0; i < nodes_count; i++) {
+      status = setup_node(plan, i, input, output, threadpool);
+      if (status != qnnp_status_success) {
+        return status;
+      }
+    }
+    plan->input = input;
+    plan->output = output;
+    plan->ready = true;
+  } else {
+    /* Intermediate tensors never move, so only the operators at the ends of the chain depend on the arguments */
+    const bool input_changed = input != plan->input;
+    const bool output_changed = output != plan->output;
+    if (input_changed || (output_changed && nodes_count == 1)) {
+      status = setup_node(plan, 0, input, output, threadpool);
+      if (status != qnnp_status_success) {
+        plan->ready = false;
+        return status;
+      }
+    }
+    if (output_changed && nodes_count != 1) {
+      status = setup_node(plan, nodes_count - 1, input, output, threadpool);
+      if (status != qnnp_status_success) {
+        plan->ready = false;
+        return status;
+      }
+    }
+    plan->input = input;
+    plan->output = output;
+  }
+
+  const bool spin_wait = plan->spin_wait && plan->affinity_pool != NULL;
+  if (spin_wait) {
+    qnnp_affinity_pool_begin_spin_wait(plan->affinity_pool);
+  }
+  for (size_t i = 0; i < nodes_count; i++) {
+    struct qnnp_scheduler scheduler;
+    pthreadpool_t node_threadpool = bind_node_threads(plan, i, threadpool, &scheduler);
+    status = qnnp_run_operator(plan->nodes[i].op, node_threadpool);
+    plan->nodes[i].op->scheduler = scheduler;
+    if (status != qnnp_status_success) {
+      break;
+    }
+  }
+  if (spin_wait) {
+    qnnp_affinity_pool_end_spin_wait(plan->affinity_pool);
+  }
+  return status;
+}
+
+/* Instruction set extensions init.c selects microkernels by, besides those every processor of the architecture has */
+static uint32_t get_isa_features(void) {
+  uint32_t isa_features = 0;
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  if (cpuinfo_has_x86_avx2()) {
+    isa_features |= QNNP_PLAN_ISA_X86_AVX2;
+  }
+  if (cpuinfo_has_x86_avx512vnni() && cpuinfo_has_x86_avx512vl()) {
+    isa_features |= QNNP_PLAN_ISA_X86_AVX512VNNI;
+  }
+#elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  if (cpuinfo_has_arm_neon_dot()) {
+    isa_features |= QNNP_PLAN_ISA_ARM_NEON_DOT;
+  }
+  if (cpuinfo_has_arm_neon_fp16_arith()) {
+    isa_features |= QNNP_PLAN_ISA_ARM_NEON_FP16_ARITH;
+  }
+#elif CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+  if (cpuinfo_has_riscv_v()) {
+    isa_features |= QNNP_PLAN_ISA_RISCV_V;
+  }
+#endif
+  return isa_features;
+}
+
+static void copy_ukernel_name(char name[QNNP_PLAN_SNAPSHOT_NAME_SIZE], const char* ukernel_name) {
+  if (ukernel_name != NULL) {
+    strncpy(name, ukernel_name, QNNP_PLAN_SNAPSHOT_NAME_SIZE - 1);
+  }
+}
+
+/*
+ * Fills the fields of a zeroed header that describe this process rather than the plan: a snapshot only restores
+ * with the microkernels, and thus the indirection buffer layouts, it was written with.
+ */
+static void init_snapshot_system(struct qnnp_plan_snapshot_header* header) {
+  header->magic = QNNP_PLAN_SNAPSHOT_MAGIC;
+  header->version = QNNP_PLAN_SNAPSHOT_VERSION;
+  header->pointer_size = (uint32_t) sizeof(void*);
+  header->isa_features = get_isa_features();
+  copy_ukernel_name(header->q8conv_name, qnnp_params.q8conv.name);
+  copy_ukernel_name(header->q8dw9_name, qnnp_params.q8dw9.name);
+  copy_ukernel_name(header->q8dw25_name, qnnp_params.q8dw25.name);
+  header->q8conv_mr = qnnp_params.q8conv.mr;
+  header->q8conv_nr = qnnp_params.q8conv.nr;
+  header->q8conv_kr = qnnp_params.q8conv.kr;
+}
+
+/* Lays out the snapshot of a plan that ran, and returns its size, or 0 if an operator cannot be serialized */
+static size_t init_snapshot_nodes(const struct qnnp_plan* plan, struct qnnp_plan_snapshot_node* records) {
+  const uint8_t* memory = (const uint8_t*) (plan->external_memory != NULL ? plan->external_memory : plan->buffer);
+  if (memory != NULL) {
+    memory += QNNP_PLAN_MEMORY_PADDING;
+  }
+  size_t offset = sizeof(struct qnnp_plan_snapshot_header) + sizeof(struct qnnp_plan_snapshot_node) * plan->nodes_count;
+  for (size_t i = 0; i < plan->nodes_count; i++) {
+    const struct qnnp_plan_node* node = &plan->nodes[i];
+    const struct qnnp_operator* op = node->op;
+    size_t operator_size = 0;
+    if (qnnp_serialize_operator(node->op, NULL, &operator_size) != qnnp_status_success) {
+      return 0;
+    }
+
+    struct qnnp_plan_snapshot_node* record = &records[i];
+    *record = (struct qnnp_plan_snapshot_node) {
+      .batch_size = node->batch_size,
+      .input_height = node->input_height,
+      .input_width = node->input_width,
+      .input_stride = node->input_stride,
+      .output_stride = node->output_stride,
+      .output_height = node->output_height,
+      .output_width = node->output_width,
+      .output_channels = node->output_channels,
+      .workspace_size = node->workspace_size,
+      .scratch_size = node->scratch_size,
+      .macs = node->macs,
+      .output_offset = node->output_offset,
+      .workspace_offset = node->workspace_offset,
+      .scratch_offset = node->scratch_offset,
+      .create_flags = op->tile_indirection ? QNNP_CREATE_FLAG_TILE_INDIRECTION : 0,
+    };
+    offset = round_up(offset, QNNP_PLAN_SNAPSHOT_ALIGNMENT);
+    record->operator_offset = offset;
+    record->operator_size = operator_size;
+    offset += operator_size;
+
+    /* Workspaces only hold indirection buffers, see compute_convolution_workspace_size */
+    if (node->workspace_size != 0) {
+      const uint8_t* input = i == 0 ? plan->input : memory + plan->nodes[i - 1].output_offset;
+      const uint8_t* scratch = memory + node->scratch_offset;
+      const uint8_t* base = (const uint8_t*) qnnp_get_indirection_base(op);
+      if (node->scratch_size != 0 && base >= scratch && base < scratch + node->scratch_size) {
+        record->indirection_base = qnnp_plan_indirection_base_scratch;
+        record->indirection_base_offset = (uint64_t) (base - scratch);
+      } else {
+        record->indirection_base = qnnp_plan_indirection_base_input;
+        record->indirection_base_offset = (uint64_t) ((uintptr_t) base - (uintptr_t) input);
+      }
+      if (op->indirection_offsets) {
+        record->workspace_encoding = qnnp_plan_workspace_offsets;
+        record->workspace_image_size = node->workspace_size;
+      } else {
+        record->workspace_encoding = qnnp_plan_workspace_pointers;
+        record->workspace_image_size = node->workspace_size / sizeof(void*) * sizeof(uint64_t);
+      }
+      offset = round_up(offset, QNNP_PLAN_SNAPSHOT_ALIGNMENT);
+      record->workspace_image_offset = offset;
+      offset += record->workspace_image_size;
+    }
+  }
+  return offset;
+}
+
+enum qnnp_status qnnp_serialize_plan(
+    qnnp_plan_t plan,
+    void* data,
+    size_t* data_size)
+{
+  if (plan->nodes_count == 0 || !plan->ready) {
+    qnnp_log_error("failed to serialize plan: plan must have run since its last change");
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t nodes_count = plan->nodes_count;
+  struct qnnp_plan_snapshot_node* records = malloc(sizeof(struct qnnp_plan_snapshot_node) * nodes_count);
+  if (records == NULL) {
+    qnnp_log_error(
+      "failed to allocate %zu bytes for plan snapshot nodes", sizeof(struct qnnp_plan_snapshot_node) * nodes_count);
+    return qnnp_status_out_of_memory;
+  }
+
+  enum qnnp_status status = qnnp_status_success;
+  const size_t required_size = init_snapshot_nodes(plan, records);
+  if (required_size == 0) {
+    qnnp_log_error("failed to serialize plan: an operator of the plan cannot be serialized");
+    status = qnnp_status_invalid_parameter;
+    goto cleanup;
+  }
+  if (data == NULL) {
+    *data_size = required_size;
+    goto cleanup;
+  }
+  if (*data_size < required_size) {
+    qnnp_log_error(
+      "failed to serialize plan into %zu bytes: %zu bytes required", *data_size, required_size);
+    status = qnnp_status_invalid_parameter;
+    goto cleanup;
+  }
+
+  /* Zeroed first to give padding bytes a deterministic value */
+  memset(data, 0, required_size);
+  struct qnnp_plan_snapshot_header header;
+  memset(&header, 0, sizeof(header));
+  init_snapshot_system(&header);
+  header.batch_size = plan->batch_size;
+  header.input_height = plan->input_height;
+  header.input_width = plan->input_width;
+  header.input_channels = plan->input_channels;
+  header.nodes_count = nodes_count;
+  header.memory_size = plan->memory_size;
+  memcpy(data, &header, sizeof(header));
+  memcpy((void*) ((uintptr_t) data + sizeof(header)), records, sizeof(struct qnnp_plan_snapshot_node) * nodes_count);
+
+  const uint8_t* memory = (const uint8_t*) (plan->external_memory != NULL ? plan->external_memory : plan->buffer);
+  for (size_t i = 0; i < nodes_count; i++) {
+    const struct qnnp_plan_node* node = &plan->nodes[i];
+    const struct qnnp_plan_snapshot_node* record = &records[i];
+    size_t operator_size = record->operator_size;
+    status = qnnp_serialize_operator(node->op, (void*) ((uintptr_t) data + record->operator_offset), &operator_size);
+    if (status != qnnp_status_success) {
+      goto cleanup;
+    }
+
+    if (record->workspace_encoding == qnnp_plan_workspace_none) {
+      continue;
+    }
+    const void* workspace = memory + QNNP_PLAN_MEMORY_PADDING + node->workspace_offset;
+    void* image = (void*) ((uintptr_t) data + record->workspace_image_offset);
+    if (record->workspace_encoding == qnnp_plan_workspace_offsets) {
+      memcpy(image, workspace, node->workspace_size);
+    } else {
+      const void** indirection_buffer = (const void**) workspace;
+      const void* zero = qnnp_get_indirection_zero(node->op);
+      const uintptr_t base = (uintptr_t) qnnp_get_indirection_base(node->op);
+      uint64_t* entries = (uint64_t*) image;
+      const size_t indirection_buffer_size = node->workspace_size / sizeof(void*);
+      for (size_t j = 0; j < indirection_buffer_size; j++) {
+        entries[j] = indirection_buffer[j] == zero ?
+          QNNP_PLAN_SNAPSHOT_ZERO : (uint64_t) ((uintptr_t) indirection_buffer[j] - base);
+      }
+    }
+  }
+
+cleanup:
+  free(records);
+  return status;
+}
+
+/* Whether the recomputed node has the shapes and sizes the snapshot recorded, which fit in its memory layout */
+static bool node_matches_snapshot(
+    const struct qnnp_plan* plan,
+    bool last_node,
+    const struct qnnp_plan_node* node,
+    const struct qnnp_plan_snapshot_node* record,
+    size_t memory_size)
+{
+  if (node->batch_size != record->batch_size || node->input_height != record->input_height ||
+      node->input_width != record->input_width || node->input_stride != record->input_stride ||
+      node->output_stride != record->output_stride || node->output_height != record->output_height ||
+      node->output_width != record->output_width || node->output_channels != record->output_channels ||
+      node->workspace_size != record->workspace_size || node->scratch_size != record->scratch_size ||
+      node->macs != record->macs)
+  {
+    return false;
+  }
+
+  const size_t blocks_size = memory_size >= QNNP_PLAN_MEMORY_PADDING ? memory_size - QNNP_PLAN_MEMORY_PADDING : 0;
+  const size_t output_size = last_node ? 0 :
+    plan->batch_size * node->output_height * node->output_width * node->output_channels;
+  const uint64_t block_offsets[3] = { record->output_offset, record->workspace_offset, record->scratch_offset };
+  const size_t block_sizes[3] = { output_size, node->workspace_size, node->scratch_size };
+  for (size_t k = 0; k < 3; k++) {
+    if (block_sizes[k] != 0 && (block_offsets[k] > blocks_size || block_sizes[k] > blocks_size - block_offsets[k])) {
+      return false;
+    }
+  }
+
+  switch ((enum qnnp_plan_workspace_encoding) record->workspace_encoding) {
+    case qnnp_plan_workspace_none:
+      return node->workspace_size == 0;
+    case qnnp_plan_workspace_offsets:
+      return node->workspace_size != 0 && record->workspace_image_size == node->workspace_size;
+    case qnnp_plan_workspace_pointers:
+      return node->workspace_size != 0 && node->workspace_size % sizeof(void*) == 0 &&
+        record->workspace_image_size == node->workspace_size / sizeof(void*) * sizeof(uint64_t);
+    default:
+      return false;
+  }
+}
+
+enum qnnp_status qnnp_create_plan_from_serialized(
+    const void* data,
+    size_t data_size,
+    qnnp_plan_t* plan_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_plan_from_serialized failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  struct qnnp_plan_snapshot_header header;
+  if (data_size < sizeof(header)) {
+    qnnp_log_error("failed to create plan from %zu bytes of serialized data: data is truncated", data_size);
+    return qnnp_status_invalid_parameter;
+  }
+  if (((uintptr_t) data & (sizeof(uint64_t) - 1)) != 0) {
+    qnnp_log_error("failed to create plan from serialized data at %p: data must be 8-byte aligned", data);
+    return qnnp_status_invalid_parameter;
+  }
+  memcpy(&header, data, sizeof(header));
+
+  struct qnnp_plan_snapshot_header system;
+  memset(&system, 0, sizeof(system));
+  init_snapshot_system(&system);
+  if (header.magic != system.magic || header.version != system.version) {
+    qnnp_log_error("failed to create plan from serialized data: unrecognized format or version");
+    return qnnp_status_invalid_parameter;
+  }
+  const size_t system_offset = offsetof(struct qnnp_plan_snapshot_header, pointer_size);
+  const size_t system_size = offsetof(struct qnnp_plan_snapshot_header, reserved) - system_offset;
+  if (memcmp((const char*) &header + system_offset, (const char*) &system + system_offset, system_size) != 0) {
+    qnnp_log_error(
+      "failed to create plan from serialized data: data was written for other instruction set extensions or "
+      "microkernels");
+    return qnnp_status_unsupported_parameter;
+  }
+  if (header.nodes_count == 0 ||
+      header.nodes_count > (data_size - sizeof(header)) / sizeof(struct qnnp_plan_snapshot_node))
+  {
+    qnnp_log_error("failed to create plan from %zu bytes of serialized data: data is truncated", data_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  qnnp_plan_t plan = NULL;
+  enum qnnp_status status = qnnp_create_plan(
+    header.batch_size, header.input_height, header.input_width, header.input_channels, &plan);
+  if (status != qnnp_status_success) {
+    return status;
+  }
+  const size_t nodes_count = (size_t) header.nodes_count;
+  plan->nodes = malloc(sizeof(struct qnnp_plan_node) * nodes_count);
+  if (plan->nodes == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for plan nodes", sizeof(struct qnnp_plan_node) * nodes_count);
+    status = qnnp_status_out_of_memory;
+    goto error;
+  }
+  plan->nodes_capacity = nodes_count;
+
+  for (size_t i = 0; i < nodes_count; i++) {
+    struct qnnp_plan_snapshot_node record;
+    memcpy(&record,
+      (const void*) ((uintptr_t) data + sizeof(header) + sizeof(struct qnnp_plan_snapshot_node) * i), sizeof(record));
+    if (record.operator_offset > data_size || record.operator_size > data_size - record.operator_offset ||
+        record.workspace_image_offset > data_size ||
+        record.workspace_image_size > data_size - record.workspace_image_offset ||
+        record.workspace_image_offset % QNNP_PLAN_SNAPSHOT_ALIGNMENT != 0)
+    {
+      qnnp_log_error("failed to create plan from %zu bytes of serialized data: data is truncated", data_size);
+      status = qnnp_status_invalid_parameter;
+      goto error;
+    }
+
+    /* Packed weights stay in place, see qnnp_create_operator_from_serialized */
+    qnnp_operator_t op = NULL;
+    status = qnnp_create_operator_from_serialized_with_flags(
+      (const void*) ((uintptr_t) data + record.operator_offset), record.operator_size, record.create_flags, &op);
+    if (status != qnnp_status_success) {
+      goto error;
+    }
+    struct qnnp_plan_node node;
+    status = init_node(plan, op, &node);
+    if (status == qnnp_status_success &&
+        !node_matches_snapshot(plan, i + 1 == nodes_count, &node, &record, header.memory_size))
+    {
+      qnnp_log_error(
+        "failed to create plan from serialized data: operator %zu has other buffers than the data records", i);
+      status = qnnp_status_unsupported_parameter;
+    }
+    if (status != qnnp_status_success) {
+      qnnp_delete_operator(op);
+      goto error;
+    }
+
+    /* Offsets are those plan_layout assigned, so the snapshot restores without laying out memory again */
+    node.output_offset = record.output_offset;
+    node.workspace_offset = record.workspace_offset;
+    node.scratch_offset = record.scratch_offset;
+    if (record.workspace_encoding != qnnp_plan_workspace_none) {
+      node.workspace_image = (const void*) ((uintptr_t) data + record.workspace_image_offset);
+      node.workspace_encoding = (enum qnnp_plan_workspace_encoding) record.workspace_encoding;
+      node.indirection_base = record.indirection_base == qnnp_plan_indirection_base_scratch ?
+        qnnp_plan_indirection_base_scratch : qnnp_plan_indirection_base_input;
+      node.indirection_base_offset = (size_t) record.indirection_base_offset;
+    }
+    plan->nodes[plan->nodes_count++] = node;
+    plan->owned_operators_count = plan->nodes_count;
+  }
+  plan->memory_size = header.memory_size;
+
+  *plan_out = plan;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_plan(plan);
+  return status;
+}
+
+enum qnnp_status qnnp_create_plan_from_file(
+    const char* path,
+    qnnp_plan_t* plan_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_plan_from_file failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    qnnp_log_error("failed to create plan from file %s: file cannot be opened", path);
+    return qnnp_status_invalid_parameter;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    qnnp_log_error("failed to create plan from file %s: file is empty or cannot be read", path);
+    close(fd);
+    return qnnp_status_invalid_parameter;
+  }
+  const size_t mapping_size = (size_t) file_stat.st_size;
+
+  /* One shared read-only mapping holds the weights of every operator and the indirection buffers, as for operators */
+  void* mapping = mmap(NULL, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    qnnp_log_error("failed to create plan from file %s: mapping %zu bytes failed", path, mapping_size);
+    return qnnp_status_out_of_memory;
+  }
+
+  qnnp_plan_t plan = NULL;
+  const enum qnnp_status status = qnnp_create_plan_from_serialized(mapping, mapping_size, &plan);
+  if (status != qnnp_status_success) {
+    munmap(mapping, mapping_size);
+    return status;
+  }
+
+  plan->mapping = mapping;
+  plan->mapping_size = mapping_size;
+  *plan_out = plan;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_delete_plan(qnnp_plan_t plan)
+{
+  if (plan != NULL) {
+    for (size_t i = 0; i < plan->owned_operators_count; i++) {
+      qnnp_delete_operator(plan->nodes[i].op);
+    }
+    free(plan->nodes);
+    free(plan->buffer);
+    /* After the operators, whose packed weights point into the mapping */
+    if (plan->mapping != NULL) {
+      munmap(plan->mapping, plan->mapping_size);
+    }
+    free(plan);
+    return qnnp_status_success;
+  }
+  return qnnp_status_invalid_parameter;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/packed-weights.h>
+#include <qnnpack/profiling.h>
+
+#if QNNP_PROFILING
+
+/* Slot of the calling thread in qnnp_operator_stats::thread_compute_ns, assigned on its first task */
+static __thread uint32_t thread_slot = UINT32_MAX;
+static uint32_t next_thread_slot;
+
+uint64_t qnnp_profiling_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * UINT64_C(1000000000) + (uint64_t) ts.tv_nsec;
+}
+
+struct qnnp_operator_stats* qnnp_profiling_get_stats(struct qnnp_operator* op) {
+  if (op->stats == NULL) {
+    op->stats = calloc(1, sizeof(struct qnnp_operator_stats));
+  }
+  return op->stats;
+}
+
+/* Adds the work of one run of a convolution, deconvolution, fully-connected, or fused operator to its statistics */
+static void count_run_work(const struct qnnp_operator* op, struct qnnp_operator_stats* stats) {
+  const uint64_t kernel_size = (uint64_t) op->kernel_height * (uint64_t) op->kernel_width;
+  const uint64_t input_pixels = (uint64_t) op->batch_size * (uint64_t) op->input_height * (uint64_t) op->input_width;
+  const uint64_t output_pixels = (uint64_t) op->batch_size * (uint64_t) op->output_height * (uint64_t) op->output_width;
+  const uint64_t input_channels = (uint64_t) op->groups * (uint64_t) op->group_input_channels;
+  const uint64_t output_channels = (uint64_t) op->groups * (uint64_t) op->group_output_channels;
+  switch (op->type) {
+    case qnnp_operator_type_convolution:
+    case qnnp_operator_type_fully_connected:
+      stats->macs += output_pixels * output_channels * (uint64_t) op->group_input_channels * kernel_size;
+      break;
+    case qnnp_operator_type_deconvolution:
+      stats->macs += input_pixels * input_channels * (uint64_t) op->group_output_channels * kernel_size;
+      break;
+    case qnnp_operator_type_inverted_residual:
+    case qnnp_operator_type_depthwise_separable:
+    {
+      /* Expanded rows that two bands share are computed twice, but only counted once */
+      const struct qnnp_operator* depthwise = op->inverted_residual->depthwise;
+      const uint64_t expanded_channels = (uint64_t) depthwise->groups;
+      const uint64_t depthwise_kernel_size = (uint64_t) depthwise->kernel_height * (uint64_t) depthwise->kernel_width;
+      stats->macs += output_pixels * expanded_channels * (depthwise_kernel_size + output_channels);
+      if (op->inverted_residual->expansion != NULL) {
+        stats->macs += input_pixels * input_channels * expanded_channels;
+      }
+      const struct qnnp_operator* fused_ops[3] = {
+        op->inverted_residual->expansion, depthwise, op->inverted_residual->projection,
+      };
+      for (size_t i = 0; i < 3; i++) {
+        if (fused_ops[i] != NULL) {
+          stats->bytes_read +=
+            fused_ops[i]->packed_weights->packed_kernel_size + fused_ops[i]->packed_weights->bias_size;
+        }
+      }
+      break;
+    }
+    case qnnp_operator_type_lstm_cell:
+    {
+      const struct qnnp_operator* gates = op->lstm_cell->gates;
+      stats->macs += output_pixels * (uint64_t) gates->group_output_channels * (uint64_t) gates->group_input_channels;
+      stats->bytes_read += gates->packed_weights->packed_kernel_size + gates->packed_weights->bias_size;
+      /* Previous hidden and cell states are read, and the new ones written */
+      stats->bytes_read += output_pixels * output_channels * 3;
+      stats->bytes_written += output_pixels * output_channels * 2;
+      break;
+    }
+    default:
+      return;
+  }
+  stats->bytes_read += (input_pixels * input_channels) << qnnp_operator_get_log2_input_element_size(op);
+  if (op->packed_weights != NULL) {
+    stats->bytes_read += op->packed_weights->packed_kernel_size + op->packed_weights->bias_size;
+  }
+  stats->bytes_written += (output_pixels * output_channels) << qnnp_operator_get_log2_output_element_size(op);
+}
+
+void qnnp_profiling_record_phase(struct qnnp_operator* op, enum qnnp_profiling_phase phase, uint64_t start) {
+  const uint64_t elapsed_ns = qnnp_profiling_now() - start;
+  struct qnnp_operator_stats* stats = qnnp_profiling_get_stats(op);
+  if (stats == NULL) {
+    return;
+  }
+  switch (phase) {
+    case qnnp_profiling_phase_setup:
+      stats->setups += 1;
+      stats->setup_ns += elapsed_ns;
+      break;
+    case qnnp_profiling_phase_indirection:
+      stats->indirection_ns += elapsed_ns;
+      break;
+    case qnnp_profiling_phase_packing:
+      stats->packing_ns += elapsed_ns;
+      break;
+    case qnnp_profiling_phase_compute:
+      stats->compute_ns += elapsed_ns;
+      break;
+    case qnnp_profiling_phase_run:
+      stats->runs += 1;
+      stats->run_ns += elapsed_ns;
+      count_run_work(op, stats);
+      break;
+  }
+}
+
+void qnnp_profiling_record_task(struct qnnp_operator_stats* stats, uint64_t start) {
+  const uint64_t elapsed_ns = qnnp_profiling_now() - start;
+  if (thread_slot == UINT32_MAX) {
+    thread_slot = __atomic_fetch_add(&next_thread_slot, 1, __ATOMIC_RELAXED) % QNNP_MAX_PROFILED_THREADS;
+  }
+  /* Threads beyond QNNP_MAX_PROFILED_THREADS share slots */
+  __atomic_fetch_add(&stats->thread_compute_ns[thread_slot], elapsed_ns, __ATOMIC_RELAXED);
+}
+
+#endif /* QNNP_PROFILING */
+
+enum qnnp_status qnnp_get_operator_stats(qnnp_operator_t op, struct qnnp_operator_stats* stats) {
+#if QNNP_PROFILING
+  if (op->stats != NULL) {
+    memcpy(stats, op->stats, sizeof(struct qnnp_operator_stats));
+  } else {
+    memset(stats, 0, sizeof(struct qnnp_operator_stats));
+  }
+  return qnnp_status_success;
+#else
+  qnnp_log_error("failed to get operator statistics: QNNPACK was built without profiling");
+  return qnnp_status_unsupported_parameter;
+#endif
+}
+
+enum qnnp_status qnnp_reset_operator_stats(qnnp_operator_t op) {
+#if QNNP_PROFILING
+  if (op->stats != NULL) {
+    memset(op->stats, 0, sizeof(struct qnnp_operator_stats));
+  }
+  return qnnp_status_success;
+#else
+  qnnp_log_error("failed to reset operator statistics: QNNPACK was built without profiling");
+  return qnnp_status_unsupported_parameter;
+#endif
+}
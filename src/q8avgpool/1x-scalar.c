@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/q8avgpool.h>
+#include <qnnpack/requantization.h>
+
+
+void q8avgpool_ukernel_1x__scalar(
+    size_t channels,
+    size_t output_width,
+    size_t kernel_size,
+    const uint8_t** input,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    int32_t bias,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  assert(channels != 0);
+  assert(output_width != 0);
+  assert(kernel_size != 0);
+
+  const union qnnp_q31_requantization_params params = *requantization_params;
+  do {
+    for (size_t c = 0; c < channels; c++) {
+      int32_t vacc = bias;
+      for (size_t k = 0; k < kernel_size; k++) {
+        vacc += (int32_t) (uint32_t) input[k][input_offset + c];
+      }
+      *output++ = qnnp_q31_requantize(vacc, params);
+    }
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8avgpool.h>
+
+
+static inline uint8x8_t q8avgpool_8c__neon(
+    size_t kernel_size,
+    const uint8_t** input,
+    size_t input_offset,
+    size_t c,
+    int32_t bias,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  int32x4_t vacc_lo = vdupq_n_s32(bias);
+  int32x4_t vacc_hi = vacc_lo;
+  do {
+    const uint8_t* i = *input++ + input_offset;
+    uint8x8_t vi;
+    if QNNP_LIKELY(c == 8) {
+      vi = vld1_u8(i);
+    } else {
+      uint8_t block[8] = { 0 };
+      memcpy(block, i, c);
+      vi = vld1_u8(block);
+    }
+
+    const int16x8_t vxi = vreinterpretq_s16_u16(vmovl_u8(vi));
+    vacc_lo = vaddw_s16(vacc_lo, vget_low_s16(vxi));
+    vacc_hi = vaddw_s16(vacc_hi, vget_high_s16(vxi));
+  } while (--kernel_size != 0);
+
+  const int32x4_t vmultiplier = vld1q_dup_s32(&requantization_params->neon.multiplier);
+  const int32x4_t vright_shift = vld1q_dup_s32(&requantization_params->neon.right_shift);
+  const int16x8_t vzero_point = vld1q_dup_s16(&requantization_params->neon.zero_point);
+  const uint8x8_t vmin = vld1_dup_u8(&requantization_params->neon.min);
+  const uint8x8_t vmax = vld1_dup_u8(&requantization_params->neon.max);
+
+  vacc_lo = vqrdmulhq_s32(vacc_lo, vmultiplier);
+  vacc_hi = vqrdmulhq_s32(vacc_hi, vmultiplier);
+
+  const int32x4_t vzero_shift_mask = vreinterpretq_s32_u32(vceqq_s32(vright_shift, vmovq_n_s32(0)));
+  vacc_lo = vsraq_n_s32(vacc_lo, vbicq_s32(vacc_lo, vzero_shift_mask), 31);
+  vacc_hi = vsraq_n_s32(vacc_hi, vbicq_s32(vacc_hi, vzero_shift_mask), 31);
+
+  vacc_lo = vrshlq_s32(vacc_lo, vright_shift);
+  vacc_hi = vrshlq_s32(vacc_hi, vright_shift);
+
+  const int16x8_t vacc = vqaddq_s16(vcombine_s16(vqmovn_s32(vacc_lo), vqmovn_s32(vacc_hi)), vzero_point);
+  uint8x8_t vout = vqmovun_s16(vacc);
+  vout = vmax_u8(vout, vmin);
+  vout = vmin_u8(vout, vmax);
+  return vout;
+}
+
+void q8avgpool_ukernel_8x__neon(
+    size_t channels,
+    size_t output_width,
+    size_t kernel_size,
+    const uint8_t** input,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    int32_t bias,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  assert(channels != 0);
+  assert(output_width != 0);
+  assert(kernel_size != 0);
+
+  do {
+    size_t c = channels;
+    size_t offset = input_offset;
+    for (; c >= 8; c -= 8) {
+      vst1_u8(output, q8avgpool_8c__neon(kernel_size, input, offset, 8, bias, requantization_params));
+      output += 8;
+      offset += 8;
+    }
+    if (c != 0) {
+      if (channels >= 8) {
+        /* Recompute the last 8 channels, which overlap the previous group, rather than reading past the pixel */
+        const size_t c_decrement = 8 - c;
+        vst1_u8(output - c_decrement,
+          q8avgpool_8c__neon(kernel_size, input, offset - c_decrement, 8, bias, requantization_params));
+      } else {
+        uint8_t block[8];
+        vst1_u8(block, q8avgpool_8c__neon(kernel_size, input, offset, c, bias, requantization_params));
+        memcpy(output, block, c);
+      }
+      output += c;
+    }
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
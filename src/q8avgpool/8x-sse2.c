@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/q8avgpool.h>
+
+
+static inline __m128i q8avgpool_requantize__sse2(
+    __m128i vacc_lo,
+    __m128i vacc_hi,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const __m128i vmultiplier = _mm_load_si128((const __m128i*) requantization_params->sse2.multiplier);
+  const __m128i vrounding = _mm_load_si128((const __m128i*) requantization_params->sse2.rounding);
+
+  const __m128i vnmask_lo0123 = _mm_cmpgt_epi32(_mm_setzero_si128(), vacc_lo);
+  const __m128i vnmask_hi0123 = _mm_cmpgt_epi32(_mm_setzero_si128(), vacc_hi);
+
+  const __m128i vabsacc_lo0123 = _mm_sub_epi32(_mm_xor_si128(vacc_lo, vnmask_lo0123), vnmask_lo0123);
+  const __m128i vabsacc_hi0123 = _mm_sub_epi32(_mm_xor_si128(vacc_hi, vnmask_hi0123), vnmask_hi0123);
+
+  const __m128i vabsacc_lo1032 = _mm_shuffle_epi32(vabsacc_lo0123, _MM_SHUFFLE(2, 3, 0, 1));
+  const __m128i vabsacc_hi1032 = _mm_shuffle_epi32(vabsacc_hi0123, _MM_SHUFFLE(2, 3, 0, 1));
+
+  const __m128i vabsprod_lo02 = _mm_mul_epu32(vabsacc_lo0123, vmultiplier);
+  const __m128i vabsprod_hi02 = _mm_mul_epu32(vabsacc_hi0123, vmultiplier);
+
+  const __m128i vnmask_lo02 = _mm_shuffle_epi32(vnmask_lo0123, _MM_SHUFFLE(2, 2, 0, 0));
+  const __m128i vnmask_hi02 = _mm_shuffle_epi32(vnmask_hi0123, _MM_SHUFFLE(2, 2, 0, 0));
+
+  const __m128i vprod_lo02 = _mm_sub_epi64(_mm_xor_si128(vabsprod_lo02, vnmask_lo02), vnmask_lo02);
+  const __m128i vprod_hi02 = _mm_sub_epi64(_mm_xor_si128(vabsprod_hi02, vnmask_hi02), vnmask_hi02);
+
+  const __m128i vq31prod_lo02 = _mm_srli_epi64(_mm_add_epi64(vprod_lo02, vrounding), 31);
+  const __m128i vq31prod_hi02 = _mm_srli_epi64(_mm_add_epi64(vprod_hi02, vrounding), 31);
+
+  const __m128i vabsprod_lo13 = _mm_mul_epu32(vabsacc_lo1032, vmultiplier);
+  const __m128i vabsprod_hi13 = _mm_mul_epu32(vabsacc_hi1032, vmultiplier);
+
+  const __m128i vnmask_lo13 = _mm_shuffle_epi32(vnmask_lo0123, _MM_SHUFFLE(3, 3, 1, 1));
+  const __m128i vnmask_hi13 = _mm_shuffle_epi32(vnmask_hi0123, _MM_SHUFFLE(3, 3, 1, 1));
+
+  const __m128i vprod_lo13 = _mm_sub_epi64(_mm_xor_si128(vabsprod_lo13, vnmask_lo13), vnmask_lo13);
+  const __m128i vprod_hi13 = _mm_sub_epi64(_mm_xor_si128(vabsprod_hi13, vnmask_hi13), vnmask_hi13);
+
+  const __m128i vq31prod_lo13 = _mm_srli_epi64(_mm_add_epi64(vprod_lo13, vrounding), 31);
+  const __m128i vq31prod_hi13 = _mm_srli_epi64(_mm_add_epi64(vprod_hi13, vrounding), 31);
+
+  const __m128i vq31prod_lo0213 = _mm_castps_si128(_mm_shuffle_ps(
+      _mm_castsi128_ps(vq31prod_lo02), _mm_castsi128_ps(vq31prod_lo13), _MM_SHUFFLE(2, 0, 2, 0)));
+  const __m128i vq31prod_hi0213 = _mm_castps_si128(_mm_shuffle_ps(
+      _mm_castsi128_ps(vq31prod_hi02), _mm_castsi128_ps(vq31prod_hi13), _MM_SHUFFLE(2, 0, 2, 0)));
+
+  const __m128i vq31prod_lo0123 = _mm_shuffle_epi32(vq31prod_lo0213, _MM_SHUFFLE(3, 1, 2, 0));
+  const __m128i vq31prod_hi0123 = _mm_shuffle_epi32(vq31prod_hi0213, _MM_SHUFFLE(3, 1, 2, 0));
+
+  const __m128i vremainder_mask = _mm_load_si128((const __m128i*) requantization_params->sse2.remainder_mask);
+
+  const __m128i vrem_lo0123 =
+    _mm_add_epi32(_mm_and_si128(vq31prod_lo0123, vremainder_mask), _mm_cmpgt_epi32(_mm_setzero_si128(), vq31prod_lo0123));
+  const __m128i vrem_hi0123 =
+    _mm_add_epi32(_mm_and_si128(vq31prod_hi0123, vremainder_mask), _mm_cmpgt_epi32(_mm_setzero_si128(), vq31prod_hi0123));
+
+  const __m128i vremainder_threshold = _mm_load_si128((const __m128i*) requantization_params->sse2.remainder_threshold);
+  const __m128i vshift = _mm_load_si128((const __m128i*) requantization_params->sse2.shift);
+
+  const __m128i vout_lo = _mm_sub_epi32(_mm_sra_epi32(vq31prod_lo0123, vshift), _mm_cmpgt_epi32(vrem_lo0123, vremainder_threshold));
+  const __m128i vout_hi = _mm_sub_epi32(_mm_sra_epi32(vq31prod_hi0123, vshift), _mm_cmpgt_epi32(vrem_hi0123, vremainder_threshold));
+
+  const __m128i vzero_point = _mm_load_si128((const __m128i*) requantization_params->sse2.zero_point);
+  __m128i vout = _mm_adds_epi16(_mm_packs_epi32(vout_lo, vout_hi), vzero_point);
+  vout = _mm_packus_epi16(vout, vout);
+  vout = _mm_max_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.min));
+  vout = _mm_min_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.max));
+  return vout;
+}
+
+static inline __m128i q8avgpool_8c__sse2(
+    size_t kernel_size,
+    const uint8_t** input,
+    size_t input_offset,
+    size_t c,
+    int32_t bias,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i vacc_lo = _mm_set1_epi32(bias);
+  __m128i vacc_hi = vacc_lo;
+  do {
+    const uint8_t* i = *input++ + input_offset;
+    __m128i vi;
+    if QNNP_LIKELY(c == 8) {
+      vi = _mm_loadl_epi64((const __m128i*) i);
+    } else {
+      uint8_t block[8] = { 0 };
+      memcpy(block, i, c);
+      vi = _mm_loadl_epi64((const __m128i*) block);
+    }
+
+    const __m128i vxi = _mm_unpacklo_epi8(vi, vzero);
+    vacc_lo = _mm_add_epi32(vacc_lo, _mm_unpacklo_epi16(vxi, vzero));
+    vacc_hi = _mm_add_epi32(vacc_hi, _mm_unpackhi_epi16(vxi, vzero));
+  } while (--kernel_size != 0);
+
+  return q8avgpool_requantize__sse2(vacc_lo, vacc_hi, requantization_params);
+}
+
+void q8avgpool_ukernel_8x__sse2(
+    size_t channels,
+    size_t output_width,
+    size_t kernel_size,
+    const uint8_t** input,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    int32_t bias,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  assert(channels != 0);
+  assert(output_width != 0);
+  assert(kernel_size != 0);
+
+  do {
+    size_t c = channels;
+    size_t offset = input_offset;
+    for (; c >= 8; c -= 8) {
+      _mm_storel_epi64((__m128i*) output,
+        q8avgpool_8c__sse2(kernel_size, input, offset, 8, bias, requantization_params));
+      output += 8;
+      offset += 8;
+    }
+    if (c != 0) {
+      if (channels >= 8) {
+        /* Recompute the last 8 channels, which overlap the previous group, rather than reading past the pixel */
+        const size_t c_decrement = 8 - c;
+        _mm_storel_epi64((__m128i*) (output - c_decrement),
+          q8avgpool_8c__sse2(kernel_size, input, offset - c_decrement, 8, bias, requantization_params));
+      } else {
+        uint8_t block[8];
+        _mm_storel_epi64((__m128i*) block,
+          q8avgpool_8c__sse2(kernel_size, input, offset, c, bias, requantization_params));
+        memcpy(output, block, c);
+      }
+      output += c;
+    }
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8conv.h>
+
+
+void q8conv_sumrows_ukernel_4x__neon(
+  size_t kc,
+  size_t ks,
+  const uint8_t** restrict a,
+  int32_t multiplier,
+  int32_t* restrict a_sum)
+{
+  uint32x4_t vacc0x0123 = vmovq_n_u32(0); // row 0
+  uint32x4_t vacc1x0123 = vmovq_n_u32(0); // row 1
+  uint32x4_t vacc2x0123 = vmovq_n_u32(0); // row 2
+  uint32x4_t vacc3x0123 = vmovq_n_u32(0); // row 3
+  do {
+    const uint8_t* restrict a0 = *a++;
+    const uint8_t* restrict a1 = *a++;
+    const uint8_t* restrict a2 = *a++;
+    const uint8_t* restrict a3 = *a++;
+
+    size_t k = kc;
+    for (; k >= 16; k -= 16) {
+      vacc0x0123 = vpadalq_u16(vacc0x0123, vpaddlq_u8(vld1q_u8(a0))); a0 += 16;
+      vacc1x0123 = vpadalq_u16(vacc1x0123, vpaddlq_u8(vld1q_u8(a1))); a1 += 16;
+      vacc2x0123 = vpadalq_u16(vacc2x0123, vpaddlq_u8(vld1q_u8(a2))); a2 += 16;
+      vacc3x0123 = vpadalq_u16(vacc3x0123, vpaddlq_u8(vld1q_u8(a3))); a3 += 16;
+    }
+    if (k >= 8) {
+      vacc0x0123 = vaddw_u16(vacc0x0123, vpaddl_u8(vld1_u8(a0))); a0 += 8;
+      vacc1x0123 = vaddw_u16(vacc1x0123, vpaddl_u8(vld1_u8(a1))); a1 += 8;
+      vacc2x0123 = vaddw_u16(vacc2x0123, vpaddl_u8(vld1_u8(a2))); a2 += 8;
+      vacc3x0123 = vaddw_u16(vacc3x0123, vpaddl_u8(vld1_u8(a3))); a3 += 8;
+      k -= 8;
+    }
+    if (k != 0) {
+      /* Same reads as the convolution microkernels: the 8 bytes ending at the last input, shifted past the others */
+      const size_t a_predecrement = 8 - k;
+      const int64x1_t va_shift = vmov_n_s64(-8 * a_predecrement);
+      const uint8x8_t va0 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a0 - a_predecrement)), va_shift));
+      const uint8x8_t va1 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a1 - a_predecrement)), va_shift));
+      const uint8x8_t va2 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a2 - a_predecrement)), va_shift));
+      const uint8x8_t va3 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a3 - a_predecrement)), va_shift));
+      vacc0x0123 = vaddw_u16(vacc0x0123, vpaddl_u8(va0));
+      vacc1x0123 = vaddw_u16(vacc1x0123, vpaddl_u8(va1));
+      vacc2x0123 = vaddw_u16(vacc2x0123, vpaddl_u8(va2));
+      vacc3x0123 = vaddw_u16(vacc3x0123, vpaddl_u8(va3));
+    }
+  } while (--ks != 0);
+
+  const uint32x2_t vsum0x01 = vpadd_u32(vget_low_u32(vacc0x0123), vget_high_u32(vacc0x0123));
+  const uint32x2_t vsum1x01 = vpadd_u32(vget_low_u32(vacc1x0123), vget_high_u32(vacc1x0123));
+  const uint32x2_t vsum2x01 = vpadd_u32(vget_low_u32(vacc2x0123), vget_high_u32(vacc2x0123));
+  const uint32x2_t vsum3x01 = vpadd_u32(vget_low_u32(vacc3x0123), vget_high_u32(vacc3x0123));
+  const uint32x4_t vsum0123 = vcombine_u32(vpadd_u32(vsum0x01, vsum1x01), vpadd_u32(vsum2x01, vsum3x01));
+  vst1q_s32(a_sum, vmulq_n_s32(vreinterpretq_s32_u32(vsum0123), multiplier));
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <immintrin.h>
+
+#include <qnnpack/q8conv.h>
+
+
+void q8conv_sumrows_ukernel_4x__sse2(
+  size_t kc,
+  size_t ks,
+  const uint8_t** restrict a,
+  int32_t multiplier,
+  int32_t* restrict a_sum)
+{
+  /* PSADBW against zero sums each 8-byte half into a 64-bit lane */
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i vacc0 = vzero;
+  __m128i vacc1 = vzero;
+  __m128i vacc2 = vzero;
+  __m128i vacc3 = vzero;
+  do {
+    const uint8_t* restrict a0 = *a++;
+    const uint8_t* restrict a1 = *a++;
+    const uint8_t* restrict a2 = *a++;
+    const uint8_t* restrict a3 = *a++;
+
+    size_t k = kc;
+    for (; k >= 16; k -= 16) {
+      vacc0 = _mm_add_epi64(vacc0, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) a0), vzero)); a0 += 16;
+      vacc1 = _mm_add_epi64(vacc1, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) a1), vzero)); a1 += 16;
+      vacc2 = _mm_add_epi64(vacc2, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) a2), vzero)); a2 += 16;
+      vacc3 = _mm_add_epi64(vacc3, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) a3), vzero)); a3 += 16;
+    }
+    if (k >= 8) {
+      vacc0 = _mm_add_epi64(vacc0, _mm_sad_epu8(_mm_loadl_epi64((const __m128i*) a0), vzero)); a0 += 8;
+      vacc1 = _mm_add_epi64(vacc1, _mm_sad_epu8(_mm_loadl_epi64((const __m128i*) a1), vzero)); a1 += 8;
+      vacc2 = _mm_add_epi64(vacc2, _mm_sad_epu8(_mm_loadl_epi64((const __m128i*) a2), vzero)); a2 += 8;
+      vacc3 = _mm_add_epi64(vacc3, _mm_sad_epu8(_mm_loadl_epi64((const __m128i*) a3), vzero)); a3 += 8;
+      k -= 8;
+    }
+    if (k != 0) {
+      /* Same reads as the convolution microkernels: the 8 bytes ending at the last input, shifted past the others */
+      const size_t a_predecrement = 8 - k;
+      const __m128i va_shift = _mm_cvtsi32_si128(8 * a_predecrement);
+      const __m128i va0 = _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a0 - a_predecrement)), va_shift);
+      const __m128i va1 = _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a1 - a_predecrement)), va_shift);
+      const __m128i va2 = _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a2 - a_predecrement)), va_shift);
+      const __m128i va3 = _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a3 - a_predecrement)), va_shift);
+      vacc0 = _mm_add_epi64(vacc0, _mm_sad_epu8(va0, vzero));
+      vacc1 = _mm_add_epi64(vacc1, _mm_sad_epu8(va1, vzero));
+      vacc2 = _mm_add_epi64(vacc2, _mm_sad_epu8(va2, vzero));
+      vacc3 = _mm_add_epi64(vacc3, _mm_sad_epu8(va3, vzero));
+    }
+  } while (--ks != 0);
+
+  /* Sums of up to ks * kc bytes fit into the low 32 bits of the lanes */
+  const __m128i vsum01 = _mm_add_epi32(_mm_unpacklo_epi64(vacc0, vacc1), _mm_unpackhi_epi64(vacc0, vacc1));
+  const __m128i vsum23 = _mm_add_epi32(_mm_unpacklo_epi64(vacc2, vacc3), _mm_unpackhi_epi64(vacc2, vacc3));
+  a_sum[0] = multiplier * _mm_cvtsi128_si32(vsum01);
+  a_sum[1] = multiplier * _mm_cvtsi128_si32(_mm_unpackhi_epi64(vsum01, vsum01));
+  a_sum[2] = multiplier * _mm_cvtsi128_si32(vsum23);
+  a_sum[3] = multiplier * _mm_cvtsi128_si32(_mm_unpackhi_epi64(vsum23, vsum23));
+}
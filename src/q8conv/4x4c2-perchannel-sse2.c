@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <immintrin.h>
+
+#include <qnnpack/q8conv.h>
+
+
+void q8conv_perchannel_ukernel_4x4c2__sse2(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  /* Each block of 4 output channels has 4 int32_t biases followed by 4 FP32 requantization scales */
+  __m128i vacc0x0123 = _mm_loadu_si128((const __m128i*) bias);
+  __m128i vacc1x0123 = vacc0x0123;
+  __m128i vacc2x0123 = vacc0x0123;
+  __m128i vacc3x0123 = vacc0x0123;
+
+  const __m128i va_offset = _mm_set1_epi16((uint16_t) a_offset);
+  const __m128i vb_offset = _mm_set1_epi16((uint16_t) b_offset);
+  const __m128i vzero = _mm_setzero_si128();
+  do {
+    const uint8_t* restrict a0 = *a++;
+    const uint8_t* restrict a1 = *a++;
+    const uint8_t* restrict a2 = *a++;
+    const uint8_t* restrict a3 = *a++;
+
+    size_t k = kc;
+    for (; k >= 8; k -= 8) {
+      __m128i va0 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) a0), vzero), va_offset);
+      a0 += 8;
+      __m128i va1 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) a1), vzero), va_offset);
+      a1 += 8;
+      __m128i va2 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) a2), vzero), va_offset);
+      a2 += 8;
+      __m128i va3 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) a3), vzero), va_offset);
+      a3 += 8;
+
+      const __m128i vb0 =
+        _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) b), vzero), vb_offset);
+      vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va0, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+      vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va1, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+      vacc2x0123 = _mm_add_epi32(vacc2x0123, _mm_madd_epi16(_mm_shuffle_epi32(va2, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+      vacc3x0123 = _mm_add_epi32(vacc3x0123, _mm_madd_epi16(_mm_shuffle_epi32(va3, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+
+      const __m128i vb1 =
+        _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) (b + 8)), vzero), vb_offset);
+      vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va0, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+      vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va1, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+      vacc2x0123 = _mm_add_epi32(vacc2x0123, _mm_madd_epi16(_mm_shuffle_epi32(va2, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+      vacc3x0123 = _mm_add_epi32(vacc3x0123, _mm_madd_epi16(_mm_shuffle_epi32(va3, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+
+      const __m128i vb2 =
+        _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) (b + 16)), vzero), vb_offset);
+      vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va0, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+      vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va1, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+      vacc2x0123 = _mm_add_epi32(vacc2x0123, _mm_madd_epi16(_mm_shuffle_epi32(va2, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+      vacc3x0123 = _mm_add_epi32(vacc3x0123, _mm_madd_epi16(_mm_shuffle_epi32(va3, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+
+      const __m128i vb3 =
+        _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) (b + 24)), vzero), vb_offset);
+      vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va0, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+      vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va1, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+      vacc2x0123 = _mm_add_epi32(vacc2x0123, _mm_madd_epi16(_mm_shuffle_epi32(va2, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+      vacc3x0123 = _mm_add_epi32(vacc3x0123, _mm_madd_epi16(_mm_shuffle_epi32(va3, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+
+      b += 32;
+    }
+    if (k != 0) {
+      const size_t a_predecrement = 8 - k;
+      const __m128i va_shift = _mm_cvtsi32_si128(8 * a_predecrement);
+
+      const __m128i va0 = _mm_sub_epi16(
+        _mm_unpacklo_epi8(_mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a0 - a_predecrement)), va_shift), vzero),
+        va_offset);
+      const __m128i va1 = _mm_sub_epi16(
+        _mm_unpacklo_epi8(_mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a1 - a_predecrement)), va_shift), vzero),
+        va_offset);
+      const __m128i va2 = _mm_sub_epi16(
+        _mm_unpacklo_epi8(_mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a2 - a_predecrement)), va_shift), vzero),
+        va_offset);
+      const __m128i va3 = _mm_sub_epi16(
+        _mm_unpacklo_epi8(_mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a3 - a_predecrement)), va_shift), vzero),
+        va_offset);
+
+      const __m128i vb0 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) b), vzero), vb_offset);
+      b += 8;
+
+      vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va0, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+      vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va1, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+      vacc2x0123 = _mm_add_epi32(vacc2x0123, _mm_madd_epi16(_mm_shuffle_epi32(va2, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+      vacc3x0123 = _mm_add_epi32(vacc3x0123, _mm_madd_epi16(_mm_shuffle_epi32(va3, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+
+      if (k > 2) {
+        const __m128i vb1 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) b), vzero), vb_offset);
+        b += 8;
+
+        vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va0, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+        vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va1, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+        vacc2x0123 = _mm_add_epi32(vacc2x0123, _mm_madd_epi16(_mm_shuffle_epi32(va2, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+        vacc3x0123 = _mm_add_epi32(vacc3x0123, _mm_madd_epi16(_mm_shuffle_epi32(va3, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+
+        if (k > 4) {
+          const __m128i vb2 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) b), vzero), vb_offset);
+          b += 8;
+
+          vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va0, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+          vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va1, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+          vacc2x0123 = _mm_add_epi32(vacc2x0123, _mm_madd_epi16(_mm_shuffle_epi32(va2, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+          vacc3x0123 = _mm_add_epi32(vacc3x0123, _mm_madd_epi16(_mm_shuffle_epi32(va3, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+
+          if (k > 6) {
+            const __m128i vb3 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) b), vzero), vb_offset);
+            b += 8;
+
+            vacc0x0123 =
+              _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va0, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+            vacc1x0123 =
+              _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va1, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+            vacc2x0123 =
+              _mm_add_epi32(vacc2x0123, _mm_madd_epi16(_mm_shuffle_epi32(va2, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+            vacc3x0123 =
+              _mm_add_epi32(vacc3x0123, _mm_madd_epi16(_mm_shuffle_epi32(va3, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+          }
+        }
+      }
+    }
+  } while (--ks != 0);
+
+  /*
+   * Conversion rounds to nearest with ties to even in the default MXCSR rounding mode, and never overflows because
+   * every scale is below 1.0, see the FP32 requantization in requantization/fp32-sse2.c.
+   */
+  const __m128 vscale = _mm_loadu_ps((const float*) (bias + 4));
+  vacc0x0123 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(vacc0x0123), vscale));
+  vacc1x0123 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(vacc1x0123), vscale));
+  vacc2x0123 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(vacc2x0123), vscale));
+  vacc3x0123 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(vacc3x0123), vscale));
+
+  const __m128i vzero_point = _mm_load_si128((const __m128i*) requantization_params->sse2.zero_point);
+  const __m128i vacc01x0123 = _mm_adds_epi16(_mm_packs_epi32(vacc0x0123, vacc1x0123), vzero_point);
+  const __m128i vacc23x0123 = _mm_adds_epi16(_mm_packs_epi32(vacc2x0123, vacc3x0123), vzero_point);
+  __m128i vout = _mm_packus_epi16(vacc01x0123, vacc23x0123);
+  vout = _mm_max_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.min));
+  vout = _mm_min_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.max));
+
+  uint8_t* c0 = c;
+  uint8_t* c1 = (uint8_t*) ((uintptr_t) c0 + c_stride);
+  if (mr < 2) {
+    c1 = c0;
+  }
+  uint8_t* c2 = (uint8_t*) ((uintptr_t) c1 + c_stride);
+  if (mr <= 2) {
+    c2 = c1;
+  }
+  uint8_t* c3 = (uint8_t*) ((uintptr_t) c2 + c_stride);
+  if (mr != 4) {
+    c3 = c2;
+  }
+  if (nr == 4) {
+    *((uint32_t*) c0) = (uint32_t) _mm_cvtsi128_si32(vout);
+    *((uint32_t*) c1) = (uint32_t) _mm_cvtsi128_si32(_mm_srli_epi64(vout, 32));
+    *((uint32_t*) c2) = (uint32_t) _mm_cvtsi128_si32(_mm_unpackhi_epi32(vout, vout));
+    *((uint32_t*) c3) = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(vout, 12));
+  } else {
+    if (nr >= 2) {
+      *((uint16_t*) c0) = (uint16_t) _mm_extract_epi16(vout, 0); c0 += 2;
+      *((uint16_t*) c1) = (uint16_t) _mm_extract_epi16(vout, 2); c1 += 2;
+      *((uint16_t*) c2) = (uint16_t) _mm_extract_epi16(vout, 4); c2 += 2;
+      *((uint16_t*) c3) = (uint16_t) _mm_extract_epi16(vout, 6); c3 += 2;
+      vout = _mm_srli_epi32(vout, 16);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      *((uint8_t*) c0) = (uint8_t) _mm_cvtsi128_si32(vout);
+      *((uint8_t*) c1) = (uint8_t) _mm_extract_epi16(vout, 2);
+      *((uint8_t*) c2) = (uint8_t) _mm_extract_epi16(vout, 4);
+      *((uint8_t*) c3) = (uint8_t) _mm_extract_epi16(vout, 6);
+    }
+  }
+}
@@ -11,7 +11,8 @@
 #include <qnnpack/q8conv.h>
 
 
-void q8conv_ukernel_4x4c2__sse2(
+/* Clamps of the epilogue are compile-time constants of the microkernels below, which inline this */
+static QNNP_INLINE void compute_q8conv_4x4c2__sse2(
     size_t mr,
     size_t nr,
     size_t kc,
@@ -23,7 +24,9 @@ void q8conv_ukernel_4x4c2__sse2(
     size_t c_stride,
     const uint8_t a_offset,
     const uint8_t b_offset,
-    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1],
+    bool clamp_min,
+    bool clamp_max)
 {
   __m128i vacc0x0123 = _mm_loadu_si128((const __m128i*) bias);
   __m128i vacc1x0123 = vacc0x0123;
@@ -240,8 +243,12 @@ void q8conv_ukernel_4x4c2__sse2(
   const __m128i vacc01x0123 = _mm_adds_epi16(_mm_packs_epi32(vacc0x0123, vacc1x0123), vzero_point);
   const __m128i vacc23x0123 = _mm_adds_epi16(_mm_packs_epi32(vacc2x0123, vacc3x0123), vzero_point);
   __m128i vout = _mm_packus_epi16(vacc01x0123, vacc23x0123);
-  vout = _mm_max_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.min));
-  vout = _mm_min_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.max));
+  if (clamp_min) {
+    vout = _mm_max_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.min));
+  }
+  if (clamp_max) {
+    vout = _mm_min_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.max));
+  }
 
   uint8_t* c0 = c;
   uint8_t* c1 = (uint8_t*) ((uintptr_t) c0 + c_stride);
@@ -278,3 +285,62 @@ void q8conv_ukernel_4x4c2__sse2(
     }
   }
 }
+
+void q8conv_ukernel_4x4c2__sse2(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  compute_q8conv_4x4c2__sse2(
+    mr, nr, kc, ks, a, b, bias, c, c_stride, a_offset, b_offset, requantization_params,
+    true, true);
+}
+
+/* Variant for output_max = 255, which packing to 8 bits already saturates to, e.g. for ReLU outputs */
+void q8conv_relu_ukernel_4x4c2__sse2(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  compute_q8conv_4x4c2__sse2(
+    mr, nr, kc, ks, a, b, bias, c, c_stride, a_offset, b_offset, requantization_params,
+    true, false);
+}
+
+/* Variant for the full [0, 255] output range, which needs neither clamp */
+void q8conv_unclamped_ukernel_4x4c2__sse2(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  compute_q8conv_4x4c2__sse2(
+    mr, nr, kc, ks, a, b, bias, c, c_stride, a_offset, b_offset, requantization_params,
+    false, false);
+}
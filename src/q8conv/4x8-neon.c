@@ -11,7 +11,8 @@
 #include <qnnpack/q8conv.h>
 
 
-void q8conv_ukernel_4x8__neon(
+/* Clamps of the epilogue are compile-time constants of the microkernels below, which inline this */
+static QNNP_INLINE void compute_q8conv_4x8__neon(
     size_t mr,
     size_t nr,
     size_t kc,
@@ -23,7 +24,9 @@ void q8conv_ukernel_4x8__neon(
     size_t c_stride,
     const uint8_t a_offset,
     const uint8_t b_offset,
-    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1],
+    bool clamp_min,
+    bool clamp_max)
 {
   int32x4_t vacc0x0123 = vld1q_s32(bias); bias += 4;
   int32x4_t vacc0x4567 = vld1q_s32(bias);
@@ -311,13 +314,18 @@ void q8conv_ukernel_4x8__neon(
   uint8x16_t vout0x01234567_1x01234567 = vcombine_u8(vqmovun_s16(vacc0x01234567), vqmovun_s16(vacc1x01234567));
   uint8x16_t vout2x01234567_3x01234567 = vcombine_u8(vqmovun_s16(vacc2x01234567), vqmovun_s16(vacc3x01234567));
 #endif
-  const uint8x16_t vmin = vld1q_dup_u8(&requantization_params->neon.min);
-  const uint8x16_t vmax = vld1q_dup_u8(&requantization_params->neon.max);
+  if (clamp_min) {
+    const uint8x16_t vmin = vld1q_dup_u8(&requantization_params->neon.min);
 
-  vout0x01234567_1x01234567 = vmaxq_u8(vout0x01234567_1x01234567, vmin);
-  vout2x01234567_3x01234567 = vmaxq_u8(vout2x01234567_3x01234567, vmin);
-  vout0x01234567_1x01234567 = vminq_u8(vout0x01234567_1x01234567, vmax);
-  vout2x01234567_3x01234567 = vminq_u8(vout2x01234567_3x01234567, vmax);
+    vout0x01234567_1x01234567 = vmaxq_u8(vout0x01234567_1x01234567, vmin);
+    vout2x01234567_3x01234567 = vmaxq_u8(vout2x01234567_3x01234567, vmin);
+  }
+  if (clamp_max) {
+    const uint8x16_t vmax = vld1q_dup_u8(&requantization_params->neon.max);
+
+    vout0x01234567_1x01234567 = vminq_u8(vout0x01234567_1x01234567, vmax);
+    vout2x01234567_3x01234567 = vminq_u8(vout2x01234567_3x01234567, vmax);
+  }
 
   uint8_t* c0 = c;
   uint8_t* c1 = (uint8_t*) ((uintptr_t) c0 + c_stride);
@@ -364,3 +372,62 @@ void q8conv_ukernel_4x8__neon(
     }
   }
 }
+
+void q8conv_ukernel_4x8__neon(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  compute_q8conv_4x8__neon(
+    mr, nr, kc, ks, a, b, bias, c, c_stride, a_offset, b_offset, requantization_params,
+    true, true);
+}
+
+/* Variant for output_max = 255, which packing to 8 bits already saturates to, e.g. for ReLU outputs */
+void q8conv_relu_ukernel_4x8__neon(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  compute_q8conv_4x8__neon(
+    mr, nr, kc, ks, a, b, bias, c, c_stride, a_offset, b_offset, requantization_params,
+    true, false);
+}
+
+/* Variant for the full [0, 255] output range, which needs neither clamp */
+void q8conv_unclamped_ukernel_4x8__neon(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  compute_q8conv_4x8__neon(
+    mr, nr, kc, ks, a, b, bias, c, c_stride, a_offset, b_offset, requantization_params,
+    false, false);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <psimd.h>
+
+#include <qnnpack/q8conv.h>
+#include <qnnpack/requantization.h>
+
+
+/* Counterpart of q8conv_perchannel_ukernel_4x8__neon with the scalar FP32 requantization of each output channel */
+void q8conv_perchannel_ukernel_4x8__psimd(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  /* Each block of 8 output channels has 8 int32_t biases followed by 8 FP32 requantization scales */
+  psimd_s32 vacc0x0123 = psimd_load_s32(bias);
+  psimd_s32 vacc0x4567 = psimd_load_s32(bias + 4);
+  const float* scale = (const float*) (bias + 8);
+  psimd_s32 vacc1x0123 = vacc0x0123;
+  psimd_s32 vacc1x4567 = vacc0x4567;
+  psimd_s32 vacc2x0123 = vacc0x0123;
+  psimd_s32 vacc2x4567 = vacc0x4567;
+  psimd_s32 vacc3x0123 = vacc0x0123;
+  psimd_s32 vacc3x4567 = vacc0x4567;
+
+  const int32_t va_offset = (int32_t) (uint32_t) a_offset;
+  const psimd_s32 vb_offset = psimd_splat_s32((int32_t) (uint32_t) b_offset);
+  do {
+    const uint8_t* restrict a0 = *a++;
+    const uint8_t* restrict a1 = *a++;
+    const uint8_t* restrict a2 = *a++;
+    const uint8_t* restrict a3 = *a++;
+
+    for (size_t k = kc; k != 0; k--) {
+      const psimd_s32 vb0123 = (psimd_s32) { b[0], b[1], b[2], b[3] } - vb_offset;
+      const psimd_s32 vb4567 = (psimd_s32) { b[4], b[5], b[6], b[7] } - vb_offset;
+      b += 8;
+
+      const psimd_s32 va0 = psimd_splat_s32((int32_t) (uint32_t) *a0++ - va_offset);
+      const psimd_s32 va1 = psimd_splat_s32((int32_t) (uint32_t) *a1++ - va_offset);
+      const psimd_s32 va2 = psimd_splat_s32((int32_t) (uint32_t) *a2++ - va_offset);
+      const psimd_s32 va3 = psimd_splat_s32((int32_t) (uint32_t) *a3++ - va_offset);
+
+      vacc0x0123 += va0 * vb0123;
+      vacc0x4567 += va0 * vb4567;
+      vacc1x0123 += va1 * vb0123;
+      vacc1x4567 += va1 * vb4567;
+      vacc2x0123 += va2 * vb0123;
+      vacc2x4567 += va2 * vb4567;
+      vacc3x0123 += va3 * vb0123;
+      vacc3x4567 += va3 * vb4567;
+    }
+  } while (--ks != 0);
+
+  int32_t vacc[4][8];
+  psimd_store_s32(&vacc[0][0], vacc0x0123);
+  psimd_store_s32(&vacc[0][4], vacc0x4567);
+  psimd_store_s32(&vacc[1][0], vacc1x0123);
+  psimd_store_s32(&vacc[1][4], vacc1x4567);
+  psimd_store_s32(&vacc[2][0], vacc2x0123);
+  psimd_store_s32(&vacc[2][4], vacc2x4567);
+  psimd_store_s32(&vacc[3][0], vacc3x0123);
+  psimd_store_s32(&vacc[3][4], vacc3x4567);
+
+  union qnnp_q31_requantization_params params = *requantization_params;
+  for (size_t m = 0; m < mr; m++) {
+    for (size_t n = 0; n < nr; n++) {
+      params.scalar.scale = scale[n];
+      c[n] = qnnp_fp32_requantize(vacc[m][n], params);
+    }
+    c = (uint8_t*) ((uintptr_t) c + c_stride);
+  }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <riscv_vector.h>
+
+#include <qnnpack/q8conv.h>
+#include <qnnpack/requantization-rvv.h>
+
+
+/* Convolution counterpart of q8gemm_ukernel_4x8__rvv */
+void q8conv_ukernel_4x8__rvv(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  vint32m2_t vacc0 = __riscv_vle32_v_i32m2(bias, 8);
+  vint32m2_t vacc1 = vacc0;
+  vint32m2_t vacc2 = vacc0;
+  vint32m2_t vacc3 = vacc0;
+
+  const int32_t va_offset = (int32_t) (uint32_t) a_offset;
+  do {
+    const uint8_t* restrict a0 = *a++;
+    const uint8_t* restrict a1 = *a++;
+    const uint8_t* restrict a2 = *a++;
+    const uint8_t* restrict a3 = *a++;
+
+    for (size_t k = kc; k != 0; k--) {
+      const vint16m1_t vb = __riscv_vreinterpret_v_u16m1_i16m1(
+        __riscv_vwsubu_vx_u16m1(__riscv_vle8_v_u8mf2(b, 8), b_offset, 8));
+      b += 8;
+
+      vacc0 = __riscv_vwmacc_vx_i32m2(vacc0, (int16_t) ((int32_t) (uint32_t) *a0++ - va_offset), vb, 8);
+      vacc1 = __riscv_vwmacc_vx_i32m2(vacc1, (int16_t) ((int32_t) (uint32_t) *a1++ - va_offset), vb, 8);
+      vacc2 = __riscv_vwmacc_vx_i32m2(vacc2, (int16_t) ((int32_t) (uint32_t) *a2++ - va_offset), vb, 8);
+      vacc3 = __riscv_vwmacc_vx_i32m2(vacc3, (int16_t) ((int32_t) (uint32_t) *a3++ - va_offset), vb, 8);
+    }
+  } while (--ks != 0);
+
+  const vuint8mf2_t vout0 = qnnp_q31_requantize__rvv(vacc0, requantization_params, 8);
+  const vuint8mf2_t vout1 = qnnp_q31_requantize__rvv(vacc1, requantization_params, 8);
+  const vuint8mf2_t vout2 = qnnp_q31_requantize__rvv(vacc2, requantization_params, 8);
+  const vuint8mf2_t vout3 = qnnp_q31_requantize__rvv(vacc3, requantization_params, 8);
+
+  uint8_t* c0 = c;
+  uint8_t* c1 = (uint8_t*) ((uintptr_t) c0 + c_stride);
+  if (mr < 2) {
+    c1 = c0;
+  }
+  uint8_t* c2 = (uint8_t*) ((uintptr_t) c1 + c_stride);
+  if (mr <= 2) {
+    c2 = c1;
+  }
+  uint8_t* c3 = (uint8_t*) ((uintptr_t) c2 + c_stride);
+  if (mr != 4) {
+    c3 = c2;
+  }
+  /* Stores of nr lanes write the partial tile without a remainder path; aliased rows get the same values */
+  __riscv_vse8_v_u8mf2(c0, vout0, nr);
+  __riscv_vse8_v_u8mf2(c1, vout1, nr);
+  __riscv_vse8_v_u8mf2(c2, vout2, nr);
+  __riscv_vse8_v_u8mf2(c3, vout3, nr);
+}
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8conv.h>
+
+
+/*
+ * Same zero point correction as in q8gemm_ukernel_4x8c4__neondot, with k = ks * round_up(kc, 4).
+ */
+void q8conv_ukernel_4x8c4__neondot(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** restrict a,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const uint32_t k_padded = (uint32_t) (ks * ((kc + 3) & -4));
+
+  uint32x4_t vacc0x0123 = vmovq_n_u32(0);
+  uint32x4_t vacc0x4567 = vmovq_n_u32(0);
+  uint32x4_t vacc1x0123 = vmovq_n_u32(0);
+  uint32x4_t vacc1x4567 = vmovq_n_u32(0);
+  uint32x4_t vacc2x0123 = vmovq_n_u32(0);
+  uint32x4_t vacc2x4567 = vmovq_n_u32(0);
+  uint32x4_t vacc3x0123 = vmovq_n_u32(0);
+  uint32x4_t vacc3x4567 = vmovq_n_u32(0);
+  uint32x2_t va0sum = vmov_n_u32(0);
+  uint32x2_t va1sum = vmov_n_u32(0);
+  uint32x2_t va2sum = vmov_n_u32(0);
+  uint32x2_t va3sum = vmov_n_u32(0);
+  uint32x4_t vbsum0123 = vmovq_n_u32(0);
+  uint32x4_t vbsum4567 = vmovq_n_u32(0);
+
+  const uint8x16_t vones = vmovq_n_u8(1);
+  do {
+    const uint8_t* restrict a0 = *a++;
+    const uint8_t* restrict a1 = *a++;
+    const uint8_t* restrict a2 = *a++;
+    const uint8_t* restrict a3 = *a++;
+
+    size_t k = kc;
+    for (; k >= 8; k -= 8) {
+      const uint8x8_t va0 = vld1_u8(a0); a0 += 8;
+      const uint8x8_t va1 = vld1_u8(a1); a1 += 8;
+      const uint8x8_t va2 = vld1_u8(a2); a2 += 8;
+      const uint8x8_t va3 = vld1_u8(a3); a3 += 8;
+
+      va0sum = vdot_u32(va0sum, va0, vget_low_u8(vones));
+      va1sum = vdot_u32(va1sum, va1, vget_low_u8(vones));
+      va2sum = vdot_u32(va2sum, va2, vget_low_u8(vones));
+      va3sum = vdot_u32(va3sum, va3, vget_low_u8(vones));
+
+      {
+        const uint8x16_t vb0123 = vld1q_u8(b); b += 16;
+        const uint8x16_t vb4567 = vld1q_u8(b); b += 16;
+
+        vbsum0123 = vdotq_u32(vbsum0123, vb0123, vones);
+        vbsum4567 = vdotq_u32(vbsum4567, vb4567, vones);
+
+        vacc0x0123 = vdotq_lane_u32(vacc0x0123, vb0123, va0, 0);
+        vacc0x4567 = vdotq_lane_u32(vacc0x4567, vb4567, va0, 0);
+        vacc1x0123 = vdotq_lane_u32(vacc1x0123, vb0123, va1, 0);
+        vacc1x4567 = vdotq_lane_u32(vacc1x4567, vb4567, va1, 0);
+        vacc2x0123 = vdotq_lane_u32(vacc2x0123, vb0123, va2, 0);
+        vacc2x4567 = vdotq_lane_u32(vacc2x4567, vb4567, va2, 0);
+        vacc3x0123 = vdotq_lane_u32(vacc3x0123, vb0123, va3, 0);
+        vacc3x4567 = vdotq_lane_u32(vacc3x4567, vb4567, va3, 0);
+      }
+
+      {
+        const uint8x16_t vb0123 = vld1q_u8(b); b += 16;
+        const uint8x16_t vb4567 = vld1q_u8(b); b += 16;
+
+        vbsum0123 = vdotq_u32(vbsum0123, vb0123, vones);
+        vbsum4567 = vdotq_u32(vbsum4567, vb4567, vones);
+
+        vacc0x0123 = vdotq_lane_u32(vacc0x0123, vb0123, va0, 1);
+        vacc0x4567 = vdotq_lane_u32(vacc0x4567, vb4567, va0, 1);
+        vacc1x0123 = vdotq_lane_u32(vacc1x0123, vb0123, va1, 1);
+        vacc1x4567 = vdotq_lane_u32(vacc1x4567, vb4567, va1, 1);
+        vacc2x0123 = vdotq_lane_u32(vacc2x0123, vb0123, va2, 1);
+        vacc2x4567 = vdotq_lane_u32(vacc2x4567, vb4567, va2, 1);
+        vacc3x0123 = vdotq_lane_u32(vacc3x0123, vb0123, va3, 1);
+        vacc3x4567 = vdotq_lane_u32(vacc3x4567, vb4567, va3, 1);
+      }
+    }
+    if (k != 0) {
+      const size_t a_predecrement = 8 - k;
+      const int64x1_t va_shift = vmov_n_s64(-8 * a_predecrement);
+      const uint8x8_t va0 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a0 - a_predecrement)), va_shift));
+      const uint8x8_t va1 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a1 - a_predecrement)), va_shift));
+      const uint8x8_t va2 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a2 - a_predecrement)), va_shift));
+      const uint8x8_t va3 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a3 - a_predecrement)), va_shift));
+
+      va0sum = vdot_u32(va0sum, va0, vget_low_u8(vones));
+      va1sum = vdot_u32(va1sum, va1, vget_low_u8(vones));
+      va2sum = vdot_u32(va2sum, va2, vget_low_u8(vones));
+      va3sum = vdot_u32(va3sum, va3, vget_low_u8(vones));
+
+      {
+        const uint8x16_t vb0123 = vld1q_u8(b); b += 16;
+        const uint8x16_t vb4567 = vld1q_u8(b); b += 16;
+
+        vbsum0123 = vdotq_u32(vbsum0123, vb0123, vones);
+        vbsum4567 = vdotq_u32(vbsum4567, vb4567, vones);
+
+        vacc0x0123 = vdotq_lane_u32(vacc0x0123, vb0123, va0, 0);
+        vacc0x4567 = vdotq_lane_u32(vacc0x4567, vb4567, va0, 0);
+        vacc1x0123 = vdotq_lane_u32(vacc1x0123, vb0123, va1, 0);
+        vacc1x4567 = vdotq_lane_u32(vacc1x4567, vb4567, va1, 0);
+        vacc2x0123 = vdotq_lane_u32(vacc2x0123, vb0123, va2, 0);
+        vacc2x4567 = vdotq_lane_u32(vacc2x4567, vb4567, va2, 0);
+        vacc3x0123 = vdotq_lane_u32(vacc3x0123, vb0123, va3, 0);
+        vacc3x4567 = vdotq_lane_u32(vacc3x4567, vb4567, va3, 0);
+      }
+
+      if (k > 4) {
+        const uint8x16_t vb0123 = vld1q_u8(b); b += 16;
+        const uint8x16_t vb4567 = vld1q_u8(b); b += 16;
+
+        vbsum0123 = vdotq_u32(vbsum0123, vb0123, vones);
+        vbsum4567 = vdotq_u32(vbsum4567, vb4567, vones);
+
+        vacc0x0123 = vdotq_lane_u32(vacc0x0123, vb0123, va0, 1);
+        vacc0x4567 = vdotq_lane_u32(vacc0x4567, vb4567, va0, 1);
+        vacc1x0123 = vdotq_lane_u32(vacc1x0123, vb0123, va1, 1);
+        vacc1x4567 = vdotq_lane_u32(vacc1x4567, vb4567, va1, 1);
+        vacc2x0123 = vdotq_lane_u32(vacc2x0123, vb0123, va2, 1);
+        vacc2x4567 = vdotq_lane_u32(vacc2x4567, vb4567, va2, 1);
+        vacc3x0123 = vdotq_lane_u32(vacc3x0123, vb0123, va3, 1);
+        vacc3x4567 = vdotq_lane_u32(vacc3x4567, vb4567, va3, 1);
+      }
+    }
+  } while (--ks != 0);
+
+  /* Column terms: k * a_offset * b_offset - a_offset * sum b */
+  const uint32x4_t vbcorr0123 = vmlsq_n_u32(vdupq_n_u32(k_padded * a_offset * b_offset), vbsum0123, a_offset);
+  const uint32x4_t vbcorr4567 = vmlsq_n_u32(vdupq_n_u32(k_padded * a_offset * b_offset), vbsum4567, a_offset);
+  /* Row terms: b_offset * sum a */
+  const uint32x4_t va0corr = vdupq_n_u32(vaddv_u32(va0sum) * b_offset);
+  const uint32x4_t va1corr = vdupq_n_u32(vaddv_u32(va1sum) * b_offset);
+  const uint32x4_t va2corr = vdupq_n_u32(vaddv_u32(va2sum) * b_offset);
+  const uint32x4_t va3corr = vdupq_n_u32(vaddv_u32(va3sum) * b_offset);
+
+  const int32x4_t vbias0123 = vld1q_s32(bias);
+  const int32x4_t vbias4567 = vld1q_s32(bias + 4);
+  int32x4_t vout0x0123 = vaddq_s32(vbias0123, vreinterpretq_s32_u32(vsubq_u32(vaddq_u32(vacc0x0123, vbcorr0123), va0corr)));
+  int32x4_t vout0x4567 = vaddq_s32(vbias4567, vreinterpretq_s32_u32(vsubq_u32(vaddq_u32(vacc0x4567, vbcorr4567), va0corr)));
+  int32x4_t vout1x0123 = vaddq_s32(vbias0123, vreinterpretq_s32_u32(vsubq_u32(vaddq_u32(vacc1x0123, vbcorr0123), va1corr)));
+  int32x4_t vout1x4567 = vaddq_s32(vbias4567, vreinterpretq_s32_u32(vsubq_u32(vaddq_u32(vacc1x4567, vbcorr4567), va1corr)));
+  int32x4_t vout2x0123 = vaddq_s32(vbias0123, vreinterpretq_s32_u32(vsubq_u32(vaddq_u32(vacc2x0123, vbcorr0123), va2corr)));
+  int32x4_t vout2x4567 = vaddq_s32(vbias4567, vreinterpretq_s32_u32(vsubq_u32(vaddq_u32(vacc2x4567, vbcorr4567), va2corr)));
+  int32x4_t vout3x0123 = vaddq_s32(vbias0123, vreinterpretq_s32_u32(vsubq_u32(vaddq_u32(vacc3x0123, vbcorr0123), va3corr)));
+  int32x4_t vout3x4567 = vaddq_s32(vbias4567, vreinterpretq_s32_u32(vsubq_u32(vaddq_u32(vacc3x4567, vbcorr4567), va3corr)));
+
+  const int32x4_t vmultiplier = vld1q_dup_s32(&requantization_params->neon.multiplier);
+  vout0x0123 = vqrdmulhq_s32(vout0x0123, vmultiplier);
+  vout0x4567 = vqrdmulhq_s32(vout0x4567, vmultiplier);
+  vout1x0123 = vqrdmulhq_s32(vout1x0123, vmultiplier);
+  vout1x4567 = vqrdmulhq_s32(vout1x4567, vmultiplier);
+  vout2x0123 = vqrdmulhq_s32(vout2x0123, vmultiplier);
+  vout2x4567 = vqrdmulhq_s32(vout2x4567, vmultiplier);
+  vout3x0123 = vqrdmulhq_s32(vout3x0123, vmultiplier);
+  vout3x4567 = vqrdmulhq_s32(vout3x4567, vmultiplier);
+
+  const int32x4_t vright_shift = vld1q_dup_s32(&requantization_params->neon.right_shift);
+  const int32x4_t vzero_shift_mask = vreinterpretq_s32_u32(vceqq_s32(vright_shift, vmovq_n_s32(0)));
+  vout0x0123 = vsraq_n_s32(vout0x0123, vbicq_s32(vout0x0123, vzero_shift_mask), 31);
+  vout0x4567 = vsraq_n_s32(vout0x4567, vbicq_s32(vout0x4567, vzero_shift_mask), 31);
+  vout1x0123 = vsraq_n_s32(vout1x0123, vbicq_s32(vout1x0123, vzero_shift_mask), 31);
+  vout1x4567 = vsraq_n_s32(vout1x4567, vbicq_s32(vout1x4567, vzero_shift_mask), 31);
+  vout2x0123 = vsraq_n_s32(vout2x0123, vbicq_s32(vout2x0123, vzero_shift_mask), 31);
+  vout2x4567 = vsraq_n_s32(vout2x4567, vbicq_s32(vout2x4567, vzero_shift_mask), 31);
+  vout3x0123 = vsraq_n_s32(vout3x0123, vbicq_s32(vout3x0123, vzero_shift_mask), 31);
+  vout3x4567 = vsraq_n_s32(vout3x4567, vbicq_s32(vout3x4567, vzero_shift_mask), 31);
+
+  vout0x0123 = vrshlq_s32(vout0x0123, vright_shift);
+  vout0x4567 = vrshlq_s32(vout0x4567, vright_shift);
+  vout1x0123 = vrshlq_s32(vout1x0123, vright_shift);
+  vout1x4567 = vrshlq_s32(vout1x4567, vright_shift);
+  vout2x0123 = vrshlq_s32(vout2x0123, vright_shift);
+  vout2x4567 = vrshlq_s32(vout2x4567, vright_shift);
+  vout3x0123 = vrshlq_s32(vout3x0123, vright_shift);
+  vout3x4567 = vrshlq_s32(vout3x4567, vright_shift);
+
+  const int16x8_t vzero_point = vld1q_dup_s16(&requantization_params->neon.zero_point);
+  const int16x8_t vout0x01234567 = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vout0x0123), vout0x4567), vzero_point);
+  const int16x8_t vout1x01234567 = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vout1x0123), vout1x4567), vzero_point);
+  const int16x8_t vout2x01234567 = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vout2x0123), vout2x4567), vzero_point);
+  const int16x8_t vout3x01234567 = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vout3x0123), vout3x4567), vzero_point);
+
+  uint8x16_t vout0x01234567_1x01234567 = vqmovun_high_s16(vqmovun_s16(vout0x01234567), vout1x01234567);
+  uint8x16_t vout2x01234567_3x01234567 = vqmovun_high_s16(vqmovun_s16(vout2x01234567), vout3x01234567);
+
+  const uint8x16_t vmin = vld1q_dup_u8(&requantization_params->neon.min);
+  const uint8x16_t vmax = vld1q_dup_u8(&requantization_params->neon.max);
+
+  vout0x01234567_1x01234567 = vmaxq_u8(vout0x01234567_1x01234567, vmin);
+  vout2x01234567_3x01234567 = vmaxq_u8(vout2x01234567_3x01234567, vmin);
+  vout0x01234567_1x01234567 = vminq_u8(vout0x01234567_1x01234567, vmax);
+  vout2x01234567_3x01234567 = vminq_u8(vout2x01234567_3x01234567, vmax);
+
+  uint8_t* c0 = c;
+  uint8_t* c1 = (uint8_t*) ((uintptr_t) c0 + c_stride);
+  if (mr < 2) {
+    c1 = c0;
+  }
+  uint8_t* c2 = (uint8_t*) ((uintptr_t) c1 + c_stride);
+  if (mr <= 2) {
+    c2 = c1;
+  }
+  uint8_t* c3 = (uint8_t*) ((uintptr_t) c2 + c_stride);
+  if (mr != 4) {
+    c3 = c2;
+  }
+  if (nr == 8) {
+    vst1_u8(c0, vget_low_u8(vout0x01234567_1x01234567));
+    vst1_u8(c1, vget_high_u8(vout0x01234567_1x01234567));
+    vst1_u8(c2, vget_low_u8(vout2x01234567_3x01234567));
+    vst1_u8(c3, vget_high_u8(vout2x01234567_3x01234567));
+  } else {
+    if (nr >= 4) {
+      vst1q_lane_u32(__builtin_assume_aligned(c0, 1), vreinterpretq_u32_u8(vout0x01234567_1x01234567), 0); c0 += 4;
+      vst1q_lane_u32(__builtin_assume_aligned(c1, 1), vreinterpretq_u32_u8(vout0x01234567_1x01234567), 2); c1 += 4;
+      vst1q_lane_u32(__builtin_assume_aligned(c2, 1), vreinterpretq_u32_u8(vout2x01234567_3x01234567), 0); c2 += 4;
+      vst1q_lane_u32(__builtin_assume_aligned(c3, 1), vreinterpretq_u32_u8(vout2x01234567_3x01234567), 2); c3 += 4;
+      vout0x01234567_1x01234567 = vextq_u8(vout0x01234567_1x01234567, vout0x01234567_1x01234567, 4);
+      vout2x01234567_3x01234567 = vextq_u8(vout2x01234567_3x01234567, vout2x01234567_3x01234567, 4);
+      nr -= 4;
+    }
+    if (nr >= 2) {
+      vst1q_lane_u16(__builtin_assume_aligned(c0, 1), vreinterpretq_u16_u8(vout0x01234567_1x01234567), 0); c0 += 2;
+      vst1q_lane_u16(__builtin_assume_aligned(c1, 1), vreinterpretq_u16_u8(vout0x01234567_1x01234567), 4); c1 += 2;
+      vst1q_lane_u16(__builtin_assume_aligned(c2, 1), vreinterpretq_u16_u8(vout2x01234567_3x01234567), 0); c2 += 2;
+      vst1q_lane_u16(__builtin_assume_aligned(c3, 1), vreinterpretq_u16_u8(vout2x01234567_3x01234567), 4); c3 += 2;
+      vout0x01234567_1x01234567 = vextq_u8(vout0x01234567_1x01234567, vout0x01234567_1x01234567, 2);
+      vout2x01234567_3x01234567 = vextq_u8(vout2x01234567_3x01234567, vout2x01234567_3x01234567, 2);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      vst1q_lane_u8(c0, vout0x01234567_1x01234567, 0);
+      vst1q_lane_u8(c1, vout0x01234567_1x01234567, 8);
+      vst1q_lane_u8(c2, vout2x01234567_3x01234567, 0);
+      vst1q_lane_u8(c3, vout2x01234567_3x01234567, 8);
+    }
+  }
+}
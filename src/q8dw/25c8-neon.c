@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8dw.h>
+
+
+void q8dw_ukernel_25c8__neon(
+    size_t channels,
+    size_t output_width,
+    const uint8_t** input,
+    const void* weights,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    uint8_t input_zero_point,
+    uint8_t kernel_zero_point,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const uint8x8_t vinput_zero_point = vdup_n_u8(input_zero_point);
+  const uint8x8_t vkernel_zero_point = vdup_n_u8(kernel_zero_point);
+  const int32x4_t vmultiplier = vld1q_dup_s32(&requantization_params->neon.multiplier);
+  const int32x4_t vright_shift = vld1q_dup_s32(&requantization_params->neon.right_shift);
+  const int16x8_t vzero_point = vld1q_dup_s16(&requantization_params->neon.zero_point);
+  const uint8x8_t vmin = vld1_dup_u8(&requantization_params->neon.min);
+  const uint8x8_t vmax = vld1_dup_u8(&requantization_params->neon.max);
+
+  do {
+    const uint8_t* i[25];
+    for (size_t k = 0; k < 25; k++) {
+      i[k] = input[k] + input_offset;
+    }
+
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+
+    size_t c = channels;
+    const void* w = weights;
+    for (; c >= 8; c -= 8) {
+      int32x4_t vaccX1_lo = vld1q_s32(w); w = (void*) ((uintptr_t) w + sizeof(int32x4_t));
+      int32x4_t vaccX1_hi = vld1q_s32(w); w = (void*) ((uintptr_t) w + sizeof(int32x4_t));
+      int32x4_t vaccX0_lo = vmovq_n_s32(0);
+      int32x4_t vaccX0_hi = vmovq_n_s32(0);
+
+      /* Taps are accumulated into two alternating accumulator pairs to shorten the dependency chain */
+      for (size_t k = 0; k < 24; k += 2) {
+        const uint8x8_t vk0 = vld1_u8(w); w = (void*) ((uintptr_t) w + sizeof(uint8x8_t));
+        const uint8x8_t vi0 = vld1_u8(i[k]); i[k] += 8;
+        const int16x8_t vxk0 = vreinterpretq_s16_u16(vsubl_u8(vk0, vkernel_zero_point));
+        const int16x8_t vxi0 = vreinterpretq_s16_u16(vsubl_u8(vi0, vinput_zero_point));
+        vaccX0_lo = vmlal_s16(vaccX0_lo, vget_low_s16(vxk0), vget_low_s16(vxi0));
+        vaccX0_hi = vmlal_s16(vaccX0_hi, vget_high_s16(vxk0), vget_high_s16(vxi0));
+
+        const uint8x8_t vk1 = vld1_u8(w); w = (void*) ((uintptr_t) w + sizeof(uint8x8_t));
+        const uint8x8_t vi1 = vld1_u8(i[k + 1]); i[k + 1] += 8;
+        const int16x8_t vxk1 = vreinterpretq_s16_u16(vsubl_u8(vk1, vkernel_zero_point));
+        const int16x8_t vxi1 = vreinterpretq_s16_u16(vsubl_u8(vi1, vinput_zero_point));
+        vaccX1_lo = vmlal_s16(vaccX1_lo, vget_low_s16(vxk1), vget_low_s16(vxi1));
+        vaccX1_hi = vmlal_s16(vaccX1_hi, vget_high_s16(vxk1), vget_high_s16(vxi1));
+      }
+
+      const uint8x8_t vk24 = vld1_u8(w); w = (void*) ((uintptr_t) w + sizeof(uint8x8_t));
+      const uint8x8_t vi24 = vld1_u8(i[24]); i[24] += 8;
+      const int16x8_t vxk24 = vreinterpretq_s16_u16(vsubl_u8(vk24, vkernel_zero_point));
+      const int16x8_t vxi24 = vreinterpretq_s16_u16(vsubl_u8(vi24, vinput_zero_point));
+      vaccX0_lo = vmlal_s16(vaccX0_lo, vget_low_s16(vxk24), vget_low_s16(vxi24));
+      vaccX0_hi = vmlal_s16(vaccX0_hi, vget_high_s16(vxk24), vget_high_s16(vxi24));
+
+      int32x4_t vacc_lo = vaddq_s32(vaccX0_lo, vaccX1_lo);
+      int32x4_t vacc_hi = vaddq_s32(vaccX0_hi, vaccX1_hi);
+
+      vacc_lo = vqrdmulhq_s32(vacc_lo, vmultiplier);
+      vacc_hi = vqrdmulhq_s32(vacc_hi, vmultiplier);
+
+      const int32x4_t vzero_shift_mask = vreinterpretq_s32_u32(vceqq_s32(vright_shift, vmovq_n_s32(0)));
+      vacc_lo = vsraq_n_s32(vacc_lo, vbicq_s32(vacc_lo, vzero_shift_mask), 31);
+      vacc_hi = vsraq_n_s32(vacc_hi, vbicq_s32(vacc_hi, vzero_shift_mask), 31);
+
+      vacc_lo = vrshlq_s32(vacc_lo, vright_shift);
+      vacc_hi = vrshlq_s32(vacc_hi, vright_shift);
+
+#ifdef __aarch64__
+      const int16x8_t vacc = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vacc_lo), vacc_hi), vzero_point);
+#else
+      const int16x8_t vacc = vqaddq_s16(vcombine_s16(vqmovn_s32(vacc_lo), vqmovn_s32(vacc_hi)), vzero_point);
+#endif
+      uint8x8_t vout = vqmovun_s16(vacc);
+      vout = vmax_u8(vout, vmin);
+      vout = vmin_u8(vout, vmax);
+
+      vst1_u8(output, vout); output += 8;
+    }
+    if (c != 0) {
+      const size_t c_predecrement = 8 - c;
+      const int64x1_t vi_shift = vmov_n_s64(-8 * c_predecrement);
+
+      int32x4_t vaccX1_lo = vld1q_s32(w); w = (void*) ((uintptr_t) w + sizeof(int32x4_t));
+      int32x4_t vaccX1_hi = vld1q_s32(w); w = (void*) ((uintptr_t) w + sizeof(int32x4_t));
+      int32x4_t vaccX0_lo = vmovq_n_s32(0);
+      int32x4_t vaccX0_hi = vmovq_n_s32(0);
+
+      for (size_t k = 0; k < 24; k += 2) {
+        const uint8x8_t vk0 = vld1_u8(w); w = (void*) ((uintptr_t) w + sizeof(uint8x8_t));
+        const uint8x8_t vi0 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(i[k] - c_predecrement)), vi_shift));
+        const int16x8_t vxk0 = vreinterpretq_s16_u16(vsubl_u8(vk0, vkernel_zero_point));
+        const int16x8_t vxi0 = vreinterpretq_s16_u16(vsubl_u8(vi0, vinput_zero_point));
+        vaccX0_lo = vmlal_s16(vaccX0_lo, vget_low_s16(vxk0), vget_low_s16(vxi0));
+        vaccX0_hi = vmlal_s16(vaccX0_hi, vget_high_s16(vxk0), vget_high_s16(vxi0));
+
+        const uint8x8_t vk1 = vld1_u8(w); w = (void*) ((uintptr_t) w + sizeof(uint8x8_t));
+        const uint8x8_t vi1 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(i[k + 1] - c_predecrement)), vi_shift));
+        const int16x8_t vxk1 = vreinterpretq_s16_u16(vsubl_u8(vk1, vkernel_zero_point));
+        const int16x8_t vxi1 = vreinterpretq_s16_u16(vsubl_u8(vi1, vinput_zero_point));
+        vaccX1_lo = vmlal_s16(vaccX1_lo, vget_low_s16(vxk1), vget_low_s16(vxi1));
+        vaccX1_hi = vmlal_s16(vaccX1_hi, vget_high_s16(vxk1), vget_high_s16(vxi1));
+      }
+
+      const uint8x8_t vk24 = vld1_u8(w);
+      const uint8x8_t vi24 = vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(i[24] - c_predecrement)), vi_shift));
+      const int16x8_t vxk24 = vreinterpretq_s16_u16(vsubl_u8(vk24, vkernel_zero_point));
+      const int16x8_t vxi24 = vreinterpretq_s16_u16(vsubl_u8(vi24, vinput_zero_point));
+      vaccX0_lo = vmlal_s16(vaccX0_lo, vget_low_s16(vxk24), vget_low_s16(vxi24));
+      vaccX0_hi = vmlal_s16(vaccX0_hi, vget_high_s16(vxk24), vget_high_s16(vxi24));
+
+      int32x4_t vacc_lo = vaddq_s32(vaccX0_lo, vaccX1_lo);
+      int32x4_t vacc_hi = vaddq_s32(vaccX0_hi, vaccX1_hi);
+
+      vacc_lo = vqrdmulhq_s32(vacc_lo, vmultiplier);
+      vacc_hi = vqrdmulhq_s32(vacc_hi, vmultiplier);
+
+      const int32x4_t vzero_shift_mask = vreinterpretq_s32_u32(vceqq_s32(vright_shift, vmovq_n_s32(0)));
+      vacc_lo = vsraq_n_s32(vacc_lo, vbicq_s32(vacc_lo, vzero_shift_mask), 31);
+      vacc_hi = vsraq_n_s32(vacc_hi, vbicq_s32(vacc_hi, vzero_shift_mask), 31);
+
+      vacc_lo = vrshlq_s32(vacc_lo, vright_shift);
+      vacc_hi = vrshlq_s32(vacc_hi, vright_shift);
+
+#ifdef __aarch64__
+      const int16x8_t vacc = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vacc_lo), vacc_hi), vzero_point);
+#else
+      const int16x8_t vacc = vqaddq_s16(vcombine_s16(vqmovn_s32(vacc_lo), vqmovn_s32(vacc_hi)), vzero_point);
+#endif
+      uint8x8_t vout = vqmovun_s16(vacc);
+      vout = vmax_u8(vout, vmin);
+      vout = vmin_u8(vout, vmax);
+
+      if (c & 4) {
+        vst1_lane_u32(__builtin_assume_aligned(output, 1), vreinterpret_u32_u8(vout), 0); output += 4;
+        vout = vext_u8(vout, vout, 4);
+      }
+      if (c & 2) {
+        vst1_lane_u16(__builtin_assume_aligned(output, 1), vreinterpret_u16_u8(vout), 0); output += 2;
+        vout = vext_u8(vout, vout, 2);
+      }
+      if (c & 1) {
+        vst1_lane_u8(__builtin_assume_aligned(output, 1), vout, 0); output++;
+      }
+    }
+
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <immintrin.h>
+
+#include <qnnpack/q8dw.h>
+
+
+void q8dw_ukernel_25c8__sse2(
+    size_t channels,
+    size_t output_width,
+    const uint8_t** input,
+    const void* weights,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    uint8_t input_zero_point,
+    uint8_t kernel_zero_point,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const __m128i vinput_zero_point = _mm_set1_epi16((short) (uint16_t) input_zero_point);
+  const __m128i vkernel_zero_point = _mm_set1_epi16((short) (uint16_t) kernel_zero_point);
+  const __m128i vzero = _mm_setzero_si128();
+
+  do {
+    const uint8_t* i[25];
+    for (size_t k = 0; k < 25; k++) {
+      i[k] = input[k] + input_offset;
+    }
+
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+
+    size_t c = channels;
+    const void* w = weights;
+    for (; c >= 8; c -= 8) {
+      __m128i vacc_lo = _mm_loadu_si128((const __m128i*) w);
+      __m128i vacc_hi = _mm_loadu_si128((const __m128i*) ((uintptr_t) w + 16));
+
+      for (size_t k = 0; k < 25; k++) {
+        const __m128i vi = _mm_loadl_epi64((const __m128i*) i[k]); i[k] += 8;
+        const __m128i vxi = _mm_sub_epi16(_mm_unpacklo_epi8(vi, vzero), vinput_zero_point);
+        const __m128i vk = _mm_loadl_epi64((const __m128i*) ((uintptr_t) w + 32 + k * 8));
+        const __m128i vxk = _mm_sub_epi16(_mm_unpacklo_epi8(vk, vzero), vkernel_zero_point);
+        const __m128i vprod_odd  = _mm_mullo_epi16(vxi, vxk);
+        const __m128i vprod_even = _mm_mulhi_epi16(vxi, vxk);
+        vacc_lo = _mm_add_epi32(vacc_lo, _mm_unpacklo_epi16(vprod_odd, vprod_even));
+        vacc_hi = _mm_add_epi32(vacc_hi, _mm_unpackhi_epi16(vprod_odd, vprod_even));
+      }
+
+      w = (void*) ((uintptr_t) w + 232);
+
+      const __m128i vmultiplier = _mm_load_si128((const __m128i*) requantization_params->sse2.multiplier);
+      const __m128i vrounding = _mm_load_si128((const __m128i*) requantization_params->sse2.rounding);
+
+      const __m128i vnmask_lo0123 = _mm_cmpgt_epi32(_mm_setzero_si128(), vacc_lo);
+      const __m128i vnmask_hi0123 = _mm_cmpgt_epi32(_mm_setzero_si128(), vacc_hi);
+
+      const __m128i vabsacc_lo0123 = _mm_sub_epi32(_mm_xor_si128(vacc_lo, vnmask_lo0123), vnmask_lo0123);
+      const __m128i vabsacc_hi0123 = _mm_sub_epi32(_mm_xor_si128(vacc_hi, vnmask_hi0123), vnmask_hi0123);
+
+      const __m128i vabsacc_lo1032 = _mm_shuffle_epi32(vabsacc_lo0123, _MM_SHUFFLE(2, 3, 0, 1));
+      const __m128i vabsacc_hi1032 = _mm_shuffle_epi32(vabsacc_hi0123, _MM_SHUFFLE(2, 3, 0, 1));
+
+      const __m128i vabsprod_lo02 = _mm_mul_epu32(vabsacc_lo0123, vmultiplier);
+      const __m128i vabsprod_hi02 = _mm_mul_epu32(vabsacc_hi0123, vmultiplier);
+
+      const __m128i vnmask_lo02 = _mm_shuffle_epi32(vnmask_lo0123, _MM_SHUFFLE(2, 2, 0, 0));
+      const __m128i vnmask_hi02 = _mm_shuffle_epi32(vnmask_hi0123, _MM_SHUFFLE(2, 2, 0, 0));
+
+      const __m128i vprod_lo02 = _mm_sub_epi64(_mm_xor_si128(vabsprod_lo02, vnmask_lo02), vnmask_lo02);
+      const __m128i vprod_hi02 = _mm_sub_epi64(_mm_xor_si128(vabsprod_hi02, vnmask_hi02), vnmask_hi02);
+
+      const __m128i vq31prod_lo02 = _mm_srli_epi64(_mm_add_epi64(vprod_lo02, vrounding), 31);
+      const __m128i vq31prod_hi02 = _mm_srli_epi64(_mm_add_epi64(vprod_hi02, vrounding), 31);
+
+      const __m128i vabsprod_lo13 = _mm_mul_epu32(vabsacc_lo1032, vmultiplier);
+      const __m128i vabsprod_hi13 = _mm_mul_epu32(vabsacc_hi1032, vmultiplier);
+
+      const __m128i vnmask_lo13 = _mm_shuffle_epi32(vnmask_lo0123, _MM_SHUFFLE(3, 3, 1, 1));
+      const __m128i vnmask_hi13 = _mm_shuffle_epi32(vnmask_hi0123, _MM_SHUFFLE(3, 3, 1, 1));
+
+      const __m128i vprod_lo13 = _mm_sub_epi64(_mm_xor_si128(vabsprod_lo13, vnmask_lo13), vnmask_lo13);
+      const __m128i vprod_hi13 = _mm_sub_epi64(_mm_xor_si128(vabsprod_hi13, vnmask_hi13), vnmask_hi13);
+
+      const __m128i vq31prod_lo13 = _mm_srli_epi64(_mm_add_epi64(vprod_lo13, vrounding), 31);
+      const __m128i vq31prod_hi13 = _mm_srli_epi64(_mm_add_epi64(vprod_hi13, vrounding), 31);
+
+      const __m128i vq31prod_lo0213 = _mm_castps_si128(_mm_shuffle_ps(
+          _mm_castsi128_ps(vq31prod_lo02), _mm_castsi128_ps(vq31prod_lo13), _MM_SHUFFLE(2, 0, 2, 0)));
+      const __m128i vq31prod_hi0213 = _mm_castps_si128(_mm_shuffle_ps(
+          _mm_castsi128_ps(vq31prod_hi02), _mm_castsi128_ps(vq31prod_hi13), _MM_SHUFFLE(2, 0, 2, 0)));
+
+      const __m128i vq31prod_lo0123 = _mm_shuffle_epi32(vq31prod_lo0213, _MM_SHUFFLE(3, 1, 2, 0));
+      const __m128i vq31prod_hi0123 = _mm_shuffle_epi32(vq31prod_hi0213, _MM_SHUFFLE(3, 1, 2, 0));
+
+      const __m128i vremainder_mask = _mm_load_si128((const __m128i*) requantization_params->sse2.remainder_mask);
+
+      const __m128i vrem_lo0123 =
+        _mm_add_epi32(_mm_and_si128(vq31prod_lo0123, vremainder_mask), _mm_cmpgt_epi32(_mm_setzero_si128(), vq31prod_lo0123));
+      const __m128i vrem_hi0123 =
+        _mm_add_epi32(_mm_and_si128(vq31prod_hi0123, vremainder_mask), _mm_cmpgt_epi32(_mm_setzero_si128(), vq31prod_hi0123));
+
+      const __m128i vremainder_threshold = _mm_load_si128((const __m128i*) requantization_params->sse2.remainder_threshold);
+      const __m128i vshift = _mm_load_si128((const __m128i*) requantization_params->sse2.shift);
+
+      const __m128i vout_lo = _mm_sub_epi32(_mm_sra_epi32(vq31prod_lo0123, vshift), _mm_cmpgt_epi32(vrem_lo0123, vremainder_threshold));
+      const __m128i vout_hi = _mm_sub_epi32(_mm_sra_epi32(vq31prod_hi0123, vshift), _mm_cmpgt_epi32(vrem_hi0123, vremainder_threshold));
+
+      const __m128i vzero_point = _mm_load_si128((const __m128i*) requantization_params->sse2.zero_point);
+      __m128i vout = _mm_adds_epi16(_mm_packs_epi32(vout_lo, vout_hi), vzero_point);
+      vout = _mm_packus_epi16(vout, vout);
+      vout = _mm_max_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.min));
+      vout = _mm_min_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.max));
+
+      _mm_storel_epi64((__m128i*) output, vout); output += 8;
+    }
+    if (c != 0) {
+      const size_t i_predecrement = 8 - c;
+      const __m128i vi_shift = _mm_cvtsi32_si128(8 * i_predecrement);
+
+      __m128i vacc_lo = _mm_loadu_si128((const __m128i*) w);
+      __m128i vacc_hi = _mm_loadu_si128((const __m128i*) ((uintptr_t) w + 16));
+
+      for (size_t k = 0; k < 25; k++) {
+        const __m128i vi = _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (i[k] - i_predecrement)), vi_shift);
+        const __m128i vxi = _mm_sub_epi16(_mm_unpacklo_epi8(vi, vzero), vinput_zero_point);
+        const __m128i vk = _mm_loadl_epi64((const __m128i*) ((uintptr_t) w + 32 + k * 8));
+        const __m128i vxk = _mm_sub_epi16(_mm_unpacklo_epi8(vk, vzero), vkernel_zero_point);
+        const __m128i vprod_odd  = _mm_mullo_epi16(vxi, vxk);
+        const __m128i vprod_even = _mm_mulhi_epi16(vxi, vxk);
+        vacc_lo = _mm_add_epi32(vacc_lo, _mm_unpacklo_epi16(vprod_odd, vprod_even));
+        vacc_hi = _mm_add_epi32(vacc_hi, _mm_unpackhi_epi16(vprod_odd, vprod_even));
+      }
+
+      const __m128i vmultiplier = _mm_load_si128((const __m128i*) requantization_params->sse2.multiplier);
+      const __m128i vrounding = _mm_load_si128((const __m128i*) requantization_params->sse2.rounding);
+
+      const __m128i vnmask_lo0123 = _mm_cmpgt_epi32(_mm_setzero_si128(), vacc_lo);
+      const __m128i vnmask_hi0123 = _mm_cmpgt_epi32(_mm_setzero_si128(), vacc_hi);
+
+      const __m128i vabsacc_lo0123 = _mm_sub_epi32(_mm_xor_si128(vacc_lo, vnmask_lo0123), vnmask_lo0123);
+      const __m128i vabsacc_hi0123 = _mm_sub_epi32(_mm_xor_si128(vacc_hi, vnmask_hi0123), vnmask_hi0123);
+
+      const __m128i vabsacc_lo1032 = _mm_shuffle_epi32(vabsacc_lo0123, _MM_SHUFFLE(2, 3, 0, 1));
+      const __m128i vabsacc_hi1032 = _mm_shuffle_epi32(vabsacc_hi0123, _MM_SHUFFLE(2, 3, 0, 1));
+
+      const __m128i vabsprod_lo02 = _mm_mul_epu32(vabsacc_lo0123, vmultiplier);
+      const __m128i vabsprod_hi02 = _mm_mul_epu32(vabsacc_hi0123, vmultiplier);
+
+      const __m128i vnmask_lo02 = _mm_shuffle_epi32(vnmask_lo0123, _MM_SHUFFLE(2, 2, 0, 0));
+      const __m128i vnmask_hi02 = _mm_shuffle_epi32(vnmask_hi0123, _MM_SHUFFLE(2, 2, 0, 0));
+
+      const __m128i vprod_lo02 = _mm_sub_epi64(_mm_xor_si128(vabsprod_lo02, vnmask_lo02), vnmask_lo02);
+      const __m128i vprod_hi02 = _mm_sub_epi64(_mm_xor_si128(vabsprod_hi02, vnmask_hi02), vnmask_hi02);
+
+      const __m128i vq31prod_lo02 = _mm_srli_epi64(_mm_add_epi64(vprod_lo02, vrounding), 31);
+      const __m128i vq31prod_hi02 = _mm_srli_epi64(_mm_add_epi64(vprod_hi02, vrounding), 31);
+
+      const __m128i vabsprod_lo13 = _mm_mul_epu32(vabsacc_lo1032, vmultiplier);
+      const __m128i vabsprod_hi13 = _mm_mul_epu32(vabsacc_hi1032, vmultiplier);
+
+      const __m128i vnmask_lo13 = _mm_shuffle_epi32(vnmask_lo0123, _MM_SHUFFLE(3, 3, 1, 1));
+      const __m128i vnmask_hi13 = _mm_shuffle_epi32(vnmask_hi0123, _MM_SHUFFLE(3, 3, 1, 1));
+
+      const __m128i vprod_lo13 = _mm_sub_epi64(_mm_xor_si128(vabsprod_lo13, vnmask_lo13), vnmask_lo13);
+      const __m128i vprod_hi13 = _mm_sub_epi64(_mm_xor_si128(vabsprod_hi13, vnmask_hi13), vnmask_hi13);
+
+      const __m128i vq31prod_lo13 = _mm_srli_epi64(_mm_add_epi64(vprod_lo13, vrounding), 31);
+      const __m128i vq31prod_hi13 = _mm_srli_epi64(_mm_add_epi64(vprod_hi13, vrounding), 31);
+
+      const __m128i vq31prod_lo0213 = _mm_castps_si128(_mm_shuffle_ps(
+          _mm_castsi128_ps(vq31prod_lo02), _mm_castsi128_ps(vq31prod_lo13), _MM_SHUFFLE(2, 0, 2, 0)));
+      const __m128i vq31prod_hi0213 = _mm_castps_si128(_mm_shuffle_ps(
+          _mm_castsi128_ps(vq31prod_hi02), _mm_castsi128_ps(vq31prod_hi13), _MM_SHUFFLE(2, 0, 2, 0)));
+
+      const __m128i vq31prod_lo0123 = _mm_shuffle_epi32(vq31prod_lo0213, _MM_SHUFFLE(3, 1, 2, 0));
+      const __m128i vq31prod_hi0123 = _mm_shuffle_epi32(vq31prod_hi0213, _MM_SHUFFLE(3, 1, 2, 0));
+
+      const __m128i vremainder_mask = _mm_load_si128((const __m128i*) requantization_params->sse2.remainder_mask);
+
+      const __m128i vrem_lo0123 =
+        _mm_add_epi32(_mm_and_si128(vq31prod_lo0123, vremainder_mask), _mm_cmpgt_epi32(_mm_setzero_si128(), vq31prod_lo0123));
+      const __m128i vrem_hi0123 =
+        _mm_add_epi32(_mm_and_si128(vq31prod_hi0123, vremainder_mask), _mm_cmpgt_epi32(_mm_setzero_si128(), vq31prod_hi0123));
+
+      const __m128i vremainder_threshold = _mm_load_si128((const __m128i*) requantization_params->sse2.remainder_threshold);
+      const __m128i vshift = _mm_load_si128((const __m128i*) requantization_params->sse2.shift);
+
+      const __m128i vout_lo = _mm_sub_epi32(_mm_sra_epi32(vq31prod_lo0123, vshift), _mm_cmpgt_epi32(vrem_lo0123, vremainder_threshold));
+      const __m128i vout_hi = _mm_sub_epi32(_mm_sra_epi32(vq31prod_hi0123, vshift), _mm_cmpgt_epi32(vrem_hi0123, vremainder_threshold));
+
+      const __m128i vzero_point = _mm_load_si128((const __m128i*) requantization_params->sse2.zero_point);
+      __m128i vout = _mm_adds_epi16(_mm_packs_epi32(vout_lo, vout_hi), vzero_point);
+      vout = _mm_packus_epi16(vout, vout);
+      vout = _mm_max_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.min));
+      vout = _mm_min_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.max));
+
+      if (c & 4) {
+        *((uint32_t*) output) = (uint32_t) _mm_cvtsi128_si32(vout);
+        output += 4;
+        vout = _mm_srli_epi64(vout, 32);
+      }
+      if (c & 2) {
+        *((uint16_t*) output) = (uint16_t) _mm_extract_epi16(vout, 0);
+        output += 2;
+        vout = _mm_srli_epi32(vout, 16);
+      }
+      if (c & 1) {
+        *((uint8_t*) output) = (uint8_t) _mm_cvtsi128_si32(vout);
+        output += 1;
+      }
+    }
+
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <immintrin.h>
+
+#include <qnnpack/q8dw.h>
+
+
+void q8dw_ukernel_9c16__avx2(
+    size_t channels,
+    size_t output_width,
+    const uint8_t** input,
+    const void* weights,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    uint8_t input_zero_point,
+    uint8_t kernel_zero_point,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const __m256i vinput_zero_point = _mm256_set1_epi16((short) (uint16_t) input_zero_point);
+  const __m256i vkernel_zero_point = _mm256_set1_epi16((short) (uint16_t) kernel_zero_point);
+  const __m256i vmultiplier = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.multiplier));
+  const __m256i vrounding = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.rounding));
+  const __m256i vremainder_mask = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.remainder_mask));
+  const __m256i vremainder_threshold = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.remainder_threshold));
+  const __m128i vshift = _mm_load_si128((const __m128i*) requantization_params->sse2.shift);
+  const __m256i vzero_point = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.zero_point));
+  const __m256i vmin = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.min));
+  const __m256i vmax = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.max));
+
+  do {
+    const uint8_t* i[9];
+    for (size_t k = 0; k < 9; k++) {
+      i[k] = input[k] + input_offset;
+    }
+
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+
+    size_t c = channels;
+    const void* w = weights;
+    for (; c >= 16; c -= 16) {
+      /*
+       * 16-bit products are widened with in-lane unpacks, so the accumulators hold channels 0-3 | 8-11 and
+       * 4-7 | 12-15. PACKSSDW of the two restores the natural channel order.
+       */
+      const __m256i vbias01234567 = _mm256_loadu_si256((const __m256i*) w);
+      const __m256i vbias89ABCDEF = _mm256_loadu_si256((const __m256i*) ((uintptr_t) w + 32));
+      __m256i vacc012389AB = _mm256_permute2x128_si256(vbias01234567, vbias89ABCDEF, 0x20);
+      __m256i vacc4567CDEF = _mm256_permute2x128_si256(vbias01234567, vbias89ABCDEF, 0x31);
+
+      for (size_t k = 0; k < 9; k++) {
+        const __m256i vxi = _mm256_sub_epi16(
+            _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) i[k])), vinput_zero_point);
+        i[k] += 16;
+        const __m256i vxk = _mm256_sub_epi16(
+            _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) ((uintptr_t) w + 64 + k * 16))), vkernel_zero_point);
+        const __m256i vprod_odd  = _mm256_mullo_epi16(vxi, vxk);
+        const __m256i vprod_even = _mm256_mulhi_epi16(vxi, vxk);
+        vacc012389AB = _mm256_add_epi32(vacc012389AB, _mm256_unpacklo_epi16(vprod_odd, vprod_even));
+        vacc4567CDEF = _mm256_add_epi32(vacc4567CDEF, _mm256_unpackhi_epi16(vprod_odd, vprod_even));
+      }
+
+      w = (void*) ((uintptr_t) w + 208);
+
+      const __m256i vprod_lo_even = _mm256_add_epi64(_mm256_mul_epi32(vacc012389AB, vmultiplier), vrounding);
+      const __m256i vprod_hi_even = _mm256_add_epi64(_mm256_mul_epi32(vacc4567CDEF, vmultiplier), vrounding);
+      const __m256i vprod_lo_odd = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(vacc012389AB, 32), vmultiplier), vrounding);
+      const __m256i vprod_hi_odd = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(vacc4567CDEF, 32), vmultiplier), vrounding);
+
+      const __m256i vq31prod_lo = _mm256_blend_epi32(
+          _mm256_srli_epi64(vprod_lo_even, 31), _mm256_add_epi64(vprod_lo_odd, vprod_lo_odd), 0xAA);
+      const __m256i vq31prod_hi = _mm256_blend_epi32(
+          _mm256_srli_epi64(vprod_hi_even, 31), _mm256_add_epi64(vprod_hi_odd, vprod_hi_odd), 0xAA);
+
+      const __m256i vrem_lo =
+        _mm256_add_epi32(_mm256_and_si256(vq31prod_lo, vremainder_mask), _mm256_cmpgt_epi32(_mm256_setzero_si256(), vq31prod_lo));
+      const __m256i vrem_hi =
+        _mm256_add_epi32(_mm256_and_si256(vq31prod_hi, vremainder_mask), _mm256_cmpgt_epi32(_mm256_setzero_si256(), vq31prod_hi));
+
+      const __m256i vout_lo = _mm256_sub_epi32(_mm256_sra_epi32(vq31prod_lo, vshift), _mm256_cmpgt_epi32(vrem_lo, vremainder_threshold));
+      const __m256i vout_hi = _mm256_sub_epi32(_mm256_sra_epi32(vq31prod_hi, vshift), _mm256_cmpgt_epi32(vrem_hi, vremainder_threshold));
+
+      __m256i vout = _mm256_adds_epi16(_mm256_packs_epi32(vout_lo, vout_hi), vzero_point);
+      vout = _mm256_packus_epi16(vout, vout);
+      vout = _mm256_max_epu8(vout, vmin);
+      vout = _mm256_min_epu8(vout, vmax);
+
+      _mm_storeu_si128((__m128i*) output,
+          _mm_unpacklo_epi64(_mm256_castsi256_si128(vout), _mm256_extracti128_si256(vout, 1)));
+      output += 16;
+    }
+    /*
+     * Remainder of up to 15 channels is processed 8 channels at a time, like in the SSE2 kernel, but reads weights
+     * from the 16-channel block. When fewer than 8 channels are left, the input is loaded from before the current
+     * pointer and shifted, so this path never reads past the last channel.
+     */
+    for (size_t c_offset = 0; c != 0; c_offset += 8) {
+      const size_t i_predecrement = c >= 8 ? 0 : 8 - c;
+      const __m128i vi_shift = _mm_cvtsi32_si128(8 * i_predecrement);
+
+      __m128i vacc_lo = _mm_loadu_si128((const __m128i*) ((uintptr_t) w + c_offset * sizeof(int32_t)));
+      __m128i vacc_hi = _mm_loadu_si128((const __m128i*) ((uintptr_t) w + c_offset * sizeof(int32_t) + 16));
+
+      for (size_t k = 0; k < 9; k++) {
+        const __m128i vxi = _mm_sub_epi16(
+            _mm_cvtepu8_epi16(_mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (i[k] - i_predecrement)), vi_shift)),
+            _mm256_castsi256_si128(vinput_zero_point));
+        i[k] += 8;
+        const __m128i vxk = _mm_sub_epi16(
+            _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*) ((uintptr_t) w + 64 + k * 16 + c_offset))),
+            _mm256_castsi256_si128(vkernel_zero_point));
+        const __m128i vprod_odd  = _mm_mullo_epi16(vxi, vxk);
+        const __m128i vprod_even = _mm_mulhi_epi16(vxi, vxk);
+        vacc_lo = _mm_add_epi32(vacc_lo, _mm_unpacklo_epi16(vprod_odd, vprod_even));
+        vacc_hi = _mm_add_epi32(vacc_hi, _mm_unpackhi_epi16(vprod_odd, vprod_even));
+      }
+
+      const __m256i vacc = _mm256_inserti128_si256(_mm256_castsi128_si256(vacc_lo), vacc_hi, 1);
+      const __m256i vprod0246 = _mm256_add_epi64(_mm256_mul_epi32(vacc, vmultiplier), vrounding);
+      const __m256i vprod1357 = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(vacc, 32), vmultiplier), vrounding);
+      const __m256i vq31prod = _mm256_blend_epi32(
+          _mm256_srli_epi64(vprod0246, 31), _mm256_add_epi64(vprod1357, vprod1357), 0xAA);
+      const __m256i vrem =
+        _mm256_add_epi32(_mm256_and_si256(vq31prod, vremainder_mask), _mm256_cmpgt_epi32(_mm256_setzero_si256(), vq31prod));
+      const __m256i vscaled = _mm256_sub_epi32(_mm256_sra_epi32(vq31prod, vshift), _mm256_cmpgt_epi32(vrem, vremainder_threshold));
+
+      __m128i vout = _mm_adds_epi16(
+          _mm_packs_epi32(_mm256_castsi256_si128(vscaled), _mm256_extracti128_si256(vscaled, 1)),
+          _mm256_castsi256_si128(vzero_point));
+      vout = _mm_packus_epi16(vout, vout);
+      vout = _mm_max_epu8(vout, _mm256_castsi256_si128(vmin));
+      vout = _mm_min_epu8(vout, _mm256_castsi256_si128(vmax));
+
+      if (c >= 8) {
+        _mm_storel_epi64((__m128i*) output, vout); output += 8;
+        c -= 8;
+      } else {
+        if (c & 4) {
+          *((uint32_t*) output) = (uint32_t) _mm_cvtsi128_si32(vout);
+          output += 4;
+          vout = _mm_srli_epi64(vout, 32);
+        }
+        if (c & 2) {
+          *((uint16_t*) output) = (uint16_t) _mm_extract_epi16(vout, 0);
+          output += 2;
+          vout = _mm_srli_epi32(vout, 16);
+        }
+        if (c & 1) {
+          *((uint8_t*) output) = (uint8_t) _mm_cvtsi128_si32(vout);
+          output += 1;
+        }
+        c = 0;
+      }
+    }
+
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <psimd.h>
+
+#include <qnnpack/q8dw.h>
+#include <qnnpack/requantization.h>
+
+
+/*
+ * Variant of q8dw_ukernel_9c8__psimd for depthwise convolution with a channel multiplier of 2, 4, or 8: output
+ * channel c reads input channel c / multiplier. channels counts output channels and input_offset is in input channels.
+ */
+void q8dw_multiplier_ukernel_9c8__psimd(
+    size_t channels,
+    size_t multiplier,
+    size_t output_width,
+    const uint8_t** input,
+    const void* weights,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    uint8_t input_zero_point,
+    uint8_t kernel_zero_point,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const psimd_s32 vinput_zero_point = psimd_splat_s32((int32_t) (uint32_t) input_zero_point);
+  const psimd_s32 vkernel_zero_point = psimd_splat_s32((int32_t) (uint32_t) kernel_zero_point);
+  const union qnnp_q31_requantization_params params = *requantization_params;
+
+  do {
+    const uint8_t* i[9];
+    for (size_t t = 0; t < 9; t++) {
+      i[t] = input[t] + input_offset;
+    }
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+
+    const uint8_t* w = weights;
+    for (size_t c = channels; c != 0; ) {
+      const size_t block = c < 8 ? c : 8;
+
+      psimd_s32 vacc_lo = psimd_load_s32(w);
+      psimd_s32 vacc_hi = psimd_load_s32(w + 16);
+      const uint8_t* k = w + 32;
+      for (size_t t = 0; t < 9; t++) {
+        /* Output channel n of the block reads input channel n / multiplier */
+        uint8_t vi[8] = { 0 };
+        for (size_t n = 0; n < block; n++) {
+          vi[n] = i[t][n / multiplier];
+        }
+        i[t] += block / multiplier;
+
+        const psimd_s32 vxi_lo = (psimd_s32) { vi[0], vi[1], vi[2], vi[3] } - vinput_zero_point;
+        const psimd_s32 vxi_hi = (psimd_s32) { vi[4], vi[5], vi[6], vi[7] } - vinput_zero_point;
+        const psimd_s32 vxk_lo = (psimd_s32) { k[0], k[1], k[2], k[3] } - vkernel_zero_point;
+        const psimd_s32 vxk_hi = (psimd_s32) { k[4], k[5], k[6], k[7] } - vkernel_zero_point;
+        k += 8;
+
+        vacc_lo += vxi_lo * vxk_lo;
+        vacc_hi += vxi_hi * vxk_hi;
+      }
+      w = k;
+
+      int32_t vacc[8];
+      psimd_store_s32(&vacc[0], vacc_lo);
+      psimd_store_s32(&vacc[4], vacc_hi);
+      for (size_t n = 0; n < block; n++) {
+        *output++ = qnnp_q31_requantize(vacc[n], params);
+      }
+      c -= block;
+    }
+
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
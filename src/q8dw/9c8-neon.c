@@ -19,6 +19,7 @@ void q8dw_ukernel_9c8__neon(
     uint8_t* output,
     size_t input_stride,
     size_t output_increment,
+    size_t input_offset,
     uint8_t input_zero_point,
     uint8_t kernel_zero_point,
     const union qnnp_q31_requantization_params requantization_params[restrict static 1])
@@ -35,21 +36,21 @@ void q8dw_ukernel_9c8__neon(
   /* Larger number of registers on AArch64 make it possible to process few pixels at a time */
   if (input_stride == 3 * sizeof(void*)) {
     for (; output_width >= 3; output_width -= 3) {
-      const uint8_t* i00 = input[ 0];
-      const uint8_t* i10 = input[ 1];
-      const uint8_t* i20 = input[ 2];
-      const uint8_t* i01 = input[ 3];
-      const uint8_t* i11 = input[ 4];
-      const uint8_t* i21 = input[ 5];
-      const uint8_t* i02 = input[ 6];
-      const uint8_t* i12 = input[ 7];
-      const uint8_t* i22 = input[ 8];
-      const uint8_t* i03 = input[ 9];
-      const uint8_t* i13 = input[10];
-      const uint8_t* i23 = input[11];
-      const uint8_t* i04 = input[12];
-      const uint8_t* i14 = input[13];
-      const uint8_t* i24 = input[14];
+      const uint8_t* i00 = input[ 0] + input_offset;
+      const uint8_t* i10 = input[ 1] + input_offset;
+      const uint8_t* i20 = input[ 2] + input_offset;
+      const uint8_t* i01 = input[ 3] + input_offset;
+      const uint8_t* i11 = input[ 4] + input_offset;
+      const uint8_t* i21 = input[ 5] + input_offset;
+      const uint8_t* i02 = input[ 6] + input_offset;
+      const uint8_t* i12 = input[ 7] + input_offset;
+      const uint8_t* i22 = input[ 8] + input_offset;
+      const uint8_t* i03 = input[ 9] + input_offset;
+      const uint8_t* i13 = input[10] + input_offset;
+      const uint8_t* i23 = input[11] + input_offset;
+      const uint8_t* i04 = input[12] + input_offset;
+      const uint8_t* i14 = input[13] + input_offset;
+      const uint8_t* i24 = input[14] + input_offset;
 
       uint8_t* output0 = output;
       uint8_t* output1 = output0 + channels + output_increment;
@@ -421,15 +422,15 @@ void q8dw_ukernel_9c8__neon(
 #endif
 
   do {
-    const uint8_t* i0 = input[0];
-    const uint8_t* i1 = input[1];
-    const uint8_t* i2 = input[2];
-    const uint8_t* i3 = input[3];
-    const uint8_t* i4 = input[4];
-    const uint8_t* i5 = input[5];
-    const uint8_t* i6 = input[6];
-    const uint8_t* i7 = input[7];
-    const uint8_t* i8 = input[8];
+    const uint8_t* i0 = input[0] + input_offset;
+    const uint8_t* i1 = input[1] + input_offset;
+    const uint8_t* i2 = input[2] + input_offset;
+    const uint8_t* i3 = input[3] + input_offset;
+    const uint8_t* i4 = input[4] + input_offset;
+    const uint8_t* i5 = input[5] + input_offset;
+    const uint8_t* i6 = input[6] + input_offset;
+    const uint8_t* i7 = input[7] + input_offset;
+    const uint8_t* i8 = input[8] + input_offset;
 
     input = (const uint8_t**) ((uintptr_t) input + input_stride);
 
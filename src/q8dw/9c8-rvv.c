@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <riscv_vector.h>
+
+#include <qnnpack/q8dw.h>
+#include <qnnpack/requantization-rvv.h>
+
+
+/* Vector lengths below 8 handle the last block of channels, so there is no remainder path */
+void q8dw_ukernel_9c8__rvv(
+    size_t channels,
+    size_t output_width,
+    const uint8_t** input,
+    const void* weights,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    uint8_t input_zero_point,
+    uint8_t kernel_zero_point,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  do {
+    const uint8_t* i[9];
+    for (size_t k = 0; k < 9; k++) {
+      i[k] = input[k] + input_offset;
+    }
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+
+    const uint8_t* w = weights;
+    for (size_t c = channels; c != 0; ) {
+      const size_t vl = __riscv_vsetvl_e32m2(c < 8 ? c : 8);
+
+      vint32m2_t vacc = __riscv_vle32_v_i32m2((const int32_t*) w, vl);
+      for (size_t k = 0; k < 9; k++) {
+        const vint16m1_t vxi = __riscv_vreinterpret_v_u16m1_i16m1(
+          __riscv_vwsubu_vx_u16m1(__riscv_vle8_v_u8mf2(i[k], vl), input_zero_point, vl));
+        i[k] += vl;
+        const vint16m1_t vxk = __riscv_vreinterpret_v_u16m1_i16m1(
+          __riscv_vwsubu_vx_u16m1(__riscv_vle8_v_u8mf2(w + 32 + k * 8, vl), kernel_zero_point, vl));
+        vacc = __riscv_vwmacc_vv_i32m2(vacc, vxi, vxk, vl);
+      }
+      w += 104;
+
+      __riscv_vse8_v_u8mf2(output, qnnp_q31_requantize__rvv(vacc, requantization_params, vl), vl);
+      output += vl;
+      c -= vl;
+    }
+
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
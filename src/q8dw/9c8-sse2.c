@@ -19,6 +19,7 @@ void q8dw_ukernel_9c8__sse2(
     uint8_t* output,
     size_t input_stride,
     size_t output_increment,
+    size_t input_offset,
     uint8_t input_zero_point,
     uint8_t kernel_zero_point,
     const union qnnp_q31_requantization_params requantization_params[restrict static 1])
@@ -28,15 +29,15 @@ void q8dw_ukernel_9c8__sse2(
   const __m128i vzero = _mm_setzero_si128();
 
   do {
-    const uint8_t* i00 = input[0];
-    const uint8_t* i01 = input[1];
-    const uint8_t* i02 = input[2];
-    const uint8_t* i10 = input[3];
-    const uint8_t* i11 = input[4];
-    const uint8_t* i12 = input[5];
-    const uint8_t* i20 = input[6];
-    const uint8_t* i21 = input[7];
-    const uint8_t* i22 = input[8];
+    const uint8_t* i00 = input[0] + input_offset;
+    const uint8_t* i01 = input[1] + input_offset;
+    const uint8_t* i02 = input[2] + input_offset;
+    const uint8_t* i10 = input[3] + input_offset;
+    const uint8_t* i11 = input[4] + input_offset;
+    const uint8_t* i12 = input[5] + input_offset;
+    const uint8_t* i20 = input[6] + input_offset;
+    const uint8_t* i21 = input[7] + input_offset;
+    const uint8_t* i22 = input[8] + input_offset;
 
     input = (const uint8_t**) ((uintptr_t) input + input_stride);
 
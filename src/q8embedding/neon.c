@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8embedding.h>
+
+
+void q8embedding_ukernel__neon(
+    size_t n,
+    const uint8_t* x,
+    float scale,
+    float bias,
+    float* y)
+{
+  const float32x4_t vscale = vdupq_n_f32(scale);
+  const float32x4_t vbias = vdupq_n_f32(bias);
+
+  uint8_t x_block[8];
+  float y_block[8];
+  while (n != 0) {
+    uint8x8_t vx;
+    float32x4_t vy_lo, vy_hi;
+    if QNNP_LIKELY(n >= 8) {
+      vx = vld1_u8(x);
+      x += 8;
+      vy_lo = vld1q_f32(y);
+      vy_hi = vld1q_f32(y + 4);
+    } else {
+      /* The remainder goes through local buffers rather than reading and writing past the row */
+      memcpy(x_block, x, n);
+      memcpy(y_block, y, n * sizeof(float));
+      vx = vld1_u8(x_block);
+      vy_lo = vld1q_f32(y_block);
+      vy_hi = vld1q_f32(y_block + 4);
+    }
+
+    /* Widen, dequantize with the row scale and bias, and accumulate */
+    const uint16x8_t vxx = vmovl_u8(vx);
+    vy_lo = vaddq_f32(vy_lo, vmlaq_f32(vbias, vcvtq_f32_u32(vmovl_u16(vget_low_u16(vxx))), vscale));
+    vy_hi = vaddq_f32(vy_hi, vmlaq_f32(vbias, vcvtq_f32_u32(vmovl_u16(vget_high_u16(vxx))), vscale));
+
+    if QNNP_LIKELY(n >= 8) {
+      vst1q_f32(y, vy_lo);
+      vst1q_f32(y + 4, vy_hi);
+      y += 8;
+      n -= 8;
+    } else {
+      vst1q_f32(y_block, vy_lo);
+      vst1q_f32(y_block + 4, vy_hi);
+      memcpy(y, y_block, n * sizeof(float));
+      n = 0;
+    }
+  }
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/q8embedding.h>
+
+
+void q8embedding_ukernel__scalar(
+    size_t n,
+    const uint8_t* x,
+    float scale,
+    float bias,
+    float* y)
+{
+  assert(n != 0);
+
+  do {
+    const float vx = (float) *x++;
+    *y++ += vx * scale + bias;
+  } while (--n != 0);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/q8embedding.h>
+
+
+static inline void q8embedding_8x__sse2(
+    __m128i vx,
+    __m128 vscale,
+    __m128 vbias,
+    float y[restrict static 8])
+{
+  const __m128i vxx = _mm_unpacklo_epi8(vx, _mm_setzero_si128());
+  const __m128 vx_lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(vxx, _mm_setzero_si128()));
+  const __m128 vx_hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(vxx, _mm_setzero_si128()));
+
+  _mm_storeu_ps(y, _mm_add_ps(_mm_loadu_ps(y), _mm_add_ps(_mm_mul_ps(vx_lo, vscale), vbias)));
+  _mm_storeu_ps(y + 4, _mm_add_ps(_mm_loadu_ps(y + 4), _mm_add_ps(_mm_mul_ps(vx_hi, vscale), vbias)));
+}
+
+void q8embedding_ukernel__sse2(
+    size_t n,
+    const uint8_t* x,
+    float scale,
+    float bias,
+    float* y)
+{
+  const __m128 vscale = _mm_set1_ps(scale);
+  const __m128 vbias = _mm_set1_ps(bias);
+  for (; n >= 8; n -= 8) {
+    const __m128i vx = _mm_loadl_epi64((const __m128i*) x);
+    x += 8;
+
+    q8embedding_8x__sse2(vx, vscale, vbias, y);
+    y += 8;
+  }
+  if (n != 0) {
+    /* The remainder goes through local buffers rather than reading and writing past the row */
+    uint8_t x_block[8];
+    memcpy(x_block, x, n);
+    const __m128i vx = _mm_loadl_epi64((const __m128i*) x_block);
+
+    float y_block[8];
+    memcpy(y_block, y, n * sizeof(float));
+    q8embedding_8x__sse2(vx, vscale, vbias, y_block);
+    memcpy(y, y_block, n * sizeof(float));
+  }
+}
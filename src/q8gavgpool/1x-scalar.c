@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/q8gavgpool.h>
+#include <qnnpack/requantization.h>
+
+
+void q8gavgpool_ukernel_1x__scalar(
+    size_t m,
+    size_t n,
+    const uint8_t* x,
+    size_t x_stride,
+    int32_t bias,
+    uint8_t* y,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  assert(m != 0);
+  assert(n != 0);
+
+  const union qnnp_q31_requantization_params params = *requantization_params;
+  do {
+    const uint8_t* i = x++;
+    int32_t vacc = bias;
+    for (size_t k = m; k != 0; k--) {
+      vacc += (int32_t) (uint32_t) *i;
+      i += x_stride;
+    }
+    *y++ = qnnp_q31_requantize(vacc, params);
+  } while (--n != 0);
+}
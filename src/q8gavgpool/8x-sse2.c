@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/q8gavgpool.h>
+
+
+static inline __m128i q8gavgpool_requantize__sse2(
+    __m128i vacc_lo,
+    __m128i vacc_hi,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const __m128i vmultiplier = _mm_load_si128((const __m128i*) requantization_params->sse2.multiplier);
+  const __m128i vrounding = _mm_load_si128((const __m128i*) requantization_params->sse2.rounding);
+
+  const __m128i vnmask_lo0123 = _mm_cmpgt_epi32(_mm_setzero_si128(), vacc_lo);
+  const __m128i vnmask_hi0123 = _mm_cmpgt_epi32(_mm_setzero_si128(), vacc_hi);
+
+  const __m128i vabsacc_lo0123 = _mm_sub_epi32(_mm_xor_si128(vacc_lo, vnmask_lo0123), vnmask_lo0123);
+  const __m128i vabsacc_hi0123 = _mm_sub_epi32(_mm_xor_si128(vacc_hi, vnmask_hi0123), vnmask_hi0123);
+
+  const __m128i vabsacc_lo1032 = _mm_shuffle_epi32(vabsacc_lo0123, _MM_SHUFFLE(2, 3, 0, 1));
+  const __m128i vabsacc_hi1032 = _mm_shuffle_epi32(vabsacc_hi0123, _MM_SHUFFLE(2, 3, 0, 1));
+
+  const __m128i vabsprod_lo02 = _mm_mul_epu32(vabsacc_lo0123, vmultiplier);
+  const __m128i vabsprod_hi02 = _mm_mul_epu32(vabsacc_hi0123, vmultiplier);
+
+  const __m128i vnmask_lo02 = _mm_shuffle_epi32(vnmask_lo0123, _MM_SHUFFLE(2, 2, 0, 0));
+  const __m128i vnmask_hi02 = _mm_shuffle_epi32(vnmask_hi0123, _MM_SHUFFLE(2, 2, 0, 0));
+
+  const __m128i vprod_lo02 = _mm_sub_epi64(_mm_xor_si128(vabsprod_lo02, vnmask_lo02), vnmask_lo02);
+  const __m128i vprod_hi02 = _mm_sub_epi64(_mm_xor_si128(vabsprod_hi02, vnmask_hi02), vnmask_hi02);
+
+  const __m128i vq31prod_lo02 = _mm_srli_epi64(_mm_add_epi64(vprod_lo02, vrounding), 31);
+  const __m128i vq31prod_hi02 = _mm_srli_epi64(_mm_add_epi64(vprod_hi02, vrounding), 31);
+
+  const __m128i vabsprod_lo13 = _mm_mul_epu32(vabsacc_lo1032, vmultiplier);
+  const __m128i vabsprod_hi13 = _mm_mul_epu32(vabsacc_hi1032, vmultiplier);
+
+  const __m128i vnmask_lo13 = _mm_shuffle_epi32(vnmask_lo0123, _MM_SHUFFLE(3, 3, 1, 1));
+  const __m128i vnmask_hi13 = _mm_shuffle_epi32(vnmask_hi0123, _MM_SHUFFLE(3, 3, 1, 1));
+
+  const __m128i vprod_lo13 = _mm_sub_epi64(_mm_xor_si128(vabsprod_lo13, vnmask_lo13), vnmask_lo13);
+  const __m128i vprod_hi13 = _mm_sub_epi64(_mm_xor_si128(vabsprod_hi13, vnmask_hi13), vnmask_hi13);
+
+  const __m128i vq31prod_lo13 = _mm_srli_epi64(_mm_add_epi64(vprod_lo13, vrounding), 31);
+  const __m128i vq31prod_hi13 = _mm_srli_epi64(_mm_add_epi64(vprod_hi13, vrounding), 31);
+
+  const __m128i vq31prod_lo0213 = _mm_castps_si128(_mm_shuffle_ps(
+      _mm_castsi128_ps(vq31prod_lo02), _mm_castsi128_ps(vq31prod_lo13), _MM_SHUFFLE(2, 0, 2, 0)));
+  const __m128i vq31prod_hi0213 = _mm_castps_si128(_mm_shuffle_ps(
+      _mm_castsi128_ps(vq31prod_hi02), _mm_castsi128_ps(vq31prod_hi13), _MM_SHUFFLE(2, 0, 2, 0)));
+
+  const __m128i vq31prod_lo0123 = _mm_shuffle_epi32(vq31prod_lo0213, _MM_SHUFFLE(3, 1, 2, 0));
+  const __m128i vq31prod_hi0123 = _mm_shuffle_epi32(vq31prod_hi0213, _MM_SHUFFLE(3, 1, 2, 0));
+
+  const __m128i vremainder_mask = _mm_load_si128((const __m128i*) requantization_params->sse2.remainder_mask);
+
+  const __m128i vrem_lo0123 =
+    _mm_add_epi32(_mm_and_si128(vq31prod_lo0123, vremainder_mask), _mm_cmpgt_epi32(_mm_setzero_si128(), vq31prod_lo0123));
+  const __m128i vrem_hi0123 =
+    _mm_add_epi32(_mm_and_si128(vq31prod_hi0123, vremainder_mask), _mm_cmpgt_epi32(_mm_setzero_si128(), vq31prod_hi0123));
+
+  const __m128i vremainder_threshold = _mm_load_si128((const __m128i*) requantization_params->sse2.remainder_threshold);
+  const __m128i vshift = _mm_load_si128((const __m128i*) requantization_params->sse2.shift);
+
+  const __m128i vout_lo = _mm_sub_epi32(_mm_sra_epi32(vq31prod_lo0123, vshift), _mm_cmpgt_epi32(vrem_lo0123, vremainder_threshold));
+  const __m128i vout_hi = _mm_sub_epi32(_mm_sra_epi32(vq31prod_hi0123, vshift), _mm_cmpgt_epi32(vrem_hi0123, vremainder_threshold));
+
+  const __m128i vzero_point = _mm_load_si128((const __m128i*) requantization_params->sse2.zero_point);
+  __m128i vout = _mm_adds_epi16(_mm_packs_epi32(vout_lo, vout_hi), vzero_point);
+  vout = _mm_packus_epi16(vout, vout);
+  vout = _mm_max_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.min));
+  vout = _mm_min_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.max));
+  return vout;
+}
+
+static inline __m128i q8gavgpool_8c__sse2(
+    size_t m,
+    const uint8_t* x,
+    size_t x_stride,
+    size_t c,
+    int32_t bias,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i vacc_lo = _mm_set1_epi32(bias);
+  __m128i vacc_hi = vacc_lo;
+  do {
+    __m128i vx;
+    if QNNP_LIKELY(c == 8) {
+      vx = _mm_loadl_epi64((const __m128i*) x);
+    } else {
+      uint8_t block[8] = { 0 };
+      memcpy(block, x, c);
+      vx = _mm_loadl_epi64((const __m128i*) block);
+    }
+    x += x_stride;
+
+    const __m128i vxx = _mm_unpacklo_epi8(vx, vzero);
+    vacc_lo = _mm_add_epi32(vacc_lo, _mm_unpacklo_epi16(vxx, vzero));
+    vacc_hi = _mm_add_epi32(vacc_hi, _mm_unpackhi_epi16(vxx, vzero));
+  } while (--m != 0);
+
+  return q8gavgpool_requantize__sse2(vacc_lo, vacc_hi, requantization_params);
+}
+
+void q8gavgpool_ukernel_8x__sse2(
+    size_t m,
+    size_t n,
+    const uint8_t* x,
+    size_t x_stride,
+    int32_t bias,
+    uint8_t* y,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  assert(m != 0);
+  assert(n != 0);
+
+  size_t c = n;
+  for (; c >= 8; c -= 8) {
+    _mm_storel_epi64((__m128i*) y, q8gavgpool_8c__sse2(m, x, x_stride, 8, bias, requantization_params));
+    x += 8;
+    y += 8;
+  }
+  if (c != 0) {
+    if (n >= 8) {
+      /* Recompute the last 8 channels, which overlap the previous group, rather than reading past the row */
+      const size_t c_decrement = 8 - c;
+      _mm_storel_epi64((__m128i*) (y - c_decrement),
+        q8gavgpool_8c__sse2(m, x - c_decrement, x_stride, 8, bias, requantization_params));
+    } else {
+      uint8_t block[8];
+      _mm_storel_epi64((__m128i*) block, q8gavgpool_8c__sse2(m, x, x_stride, c, bias, requantization_params));
+      memcpy(y, block, c);
+    }
+  }
+}
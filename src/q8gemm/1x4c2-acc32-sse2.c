@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <immintrin.h>
+
+#include <qnnpack/q8gemm.h>
+
+
+/*
+ * Variant of q8gemm_ukernel_1x4c2__sse2 that stores the 32-bit accumulators of a slice of K, without bias and
+ * requantization, for split-K GEMM.
+ */
+void q8gemm_acc32_ukernel_1x4c2__sse2(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const uint8_t* restrict a,
+    size_t a_stride,
+    const uint8_t* restrict b,
+    int32_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset)
+{
+  __m128i vacc0x0123 = _mm_setzero_si128();
+  __m128i vacc1x0123 = _mm_setzero_si128();
+
+  const __m128i va_offset = _mm_set1_epi16((uint16_t) a_offset);
+  const __m128i vb_offset = _mm_set1_epi16((uint16_t) b_offset);
+  const __m128i vzero = _mm_setzero_si128();
+  for (; k >= 8; k -= 8) {
+    const __m128i va = _mm_sub_epi16(
+        _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) a), vzero),
+        va_offset);
+    a += 8;
+
+    const __m128i vb01 = _mm_loadu_si128((const __m128i*) b);
+    const __m128i vb23 = _mm_loadu_si128((const __m128i*) (b + 16));
+    b += 32;
+
+    const __m128i vb0 = _mm_sub_epi16(_mm_unpacklo_epi8(vb01, vzero), vb_offset);
+    const __m128i vb1 = _mm_sub_epi16(_mm_unpackhi_epi8(vb01, vzero), vb_offset);
+    vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+    vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+
+    const __m128i vb2 = _mm_sub_epi16(_mm_unpacklo_epi8(vb23, vzero), vb_offset);
+    const __m128i vb3 = _mm_sub_epi16(_mm_unpackhi_epi8(vb23, vzero), vb_offset);
+    vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+    vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+  }
+  if (k != 0) {
+    const size_t a_predecrement = 8 - k;
+    const __m128i va_shift = _mm_cvtsi32_si128(8 * a_predecrement);
+    const __m128i va = _mm_sub_epi16(
+        _mm_unpacklo_epi8(
+            _mm_srl_epi64(
+                _mm_loadl_epi64((const __m128i*) (a - a_predecrement)),
+                va_shift),
+            vzero),
+        va_offset);
+
+    const __m128i vb0 = _mm_sub_epi16(
+        _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) b), vzero),
+        vb_offset);
+    vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+
+    if (k > 2) {
+      const __m128i vb1 = _mm_sub_epi16(
+          _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) (b + 8)), vzero),
+          vb_offset);
+      vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+
+      if (k > 4) {
+        const __m128i vb2 = _mm_sub_epi16(
+            _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) (b + 16)), vzero),
+            vb_offset);
+        vacc0x0123 = _mm_add_epi32(vacc0x0123, _mm_madd_epi16(_mm_shuffle_epi32(va, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+
+        if (k > 6) {
+          const __m128i vb3 = _mm_sub_epi16(
+              _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) (b + 24)), vzero),
+              vb_offset);
+          vacc1x0123 = _mm_add_epi32(vacc1x0123, _mm_madd_epi16(_mm_shuffle_epi32(va, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+        }
+      }
+    }
+  }
+  vacc0x0123 = _mm_add_epi32(vacc0x0123, vacc1x0123);
+
+  if (nr == 4) {
+    _mm_storeu_si128((__m128i*) c, vacc0x0123);
+  } else {
+    if (nr >= 2) {
+      _mm_storel_epi64((__m128i*) c, vacc0x0123);
+      c += 2;
+      vacc0x0123 = _mm_unpackhi_epi64(vacc0x0123, vacc0x0123);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      *c = _mm_cvtsi128_si32(vacc0x0123);
+    }
+  }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8gemm.h>
+
+
+/*
+ * Variant of q8gemm_ukernel_1x8__neon that stores the 32-bit accumulators of a slice of K, without bias and
+ * requantization, for split-K GEMM.
+ */
+void q8gemm_acc32_ukernel_1x8__neon(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const uint8_t* restrict a,
+    size_t a_stride,
+    const uint8_t* restrict b,
+    int32_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset)
+{
+  int32x4_t vacc0x0123 = vmovq_n_s32(0);
+  int32x4_t vacc0x4567 = vmovq_n_s32(0);
+  int32x4_t vacc1x0123 = vmovq_n_s32(0);
+  int32x4_t vacc1x4567 = vmovq_n_s32(0);
+
+  const uint8x8_t va_offset = vdup_n_u8(a_offset);
+  const uint8x8_t vb_offset = vdup_n_u8(b_offset);
+  for (; k >= 8; k -= 8) {
+    const int16x8_t va = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(a), va_offset)); a += 8;
+
+    const int16x8_t vb0 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset));
+    const int16x8_t vb1 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 8), vb_offset));
+    const int16x8_t vb2 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 16), vb_offset));
+    const int16x8_t vb3 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 24), vb_offset));
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb0), vget_low_s16(va), 0);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb0), vget_low_s16(va), 0);
+    vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb1), vget_low_s16(va), 1);
+    vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb1), vget_low_s16(va), 1);
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb2), vget_low_s16(va), 2);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb2), vget_low_s16(va), 2);
+    vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb3), vget_low_s16(va), 3);
+    vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb3), vget_low_s16(va), 3);
+
+    const int16x8_t vb4 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 32), vb_offset));
+    const int16x8_t vb5 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 40), vb_offset));
+    const int16x8_t vb6 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 48), vb_offset));
+    const int16x8_t vb7 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 56), vb_offset));
+    b += 64;
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb4), vget_high_s16(va), 0);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb4), vget_high_s16(va), 0);
+    vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb5), vget_high_s16(va), 1);
+    vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb5), vget_high_s16(va), 1);
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb6), vget_high_s16(va), 2);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb6), vget_high_s16(va), 2);
+    vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb7), vget_high_s16(va), 3);
+    vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb7), vget_high_s16(va), 3);
+  }
+  if (k != 0) {
+    const size_t a_predecrement = 8 - k;
+    const int64x1_t va_shift = vmov_n_s64(-8 * a_predecrement);
+    const int16x8_t va = vreinterpretq_s16_u16(vsubl_u8(
+        vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a - a_predecrement)), va_shift)),
+        va_offset));
+
+    const int16x8_t vb0 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb0), vget_low_s16(va), 0);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb0), vget_low_s16(va), 0);
+    if (k >= 2) {
+      const int16x8_t vb1 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+      vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb1), vget_low_s16(va), 1);
+      vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb1), vget_low_s16(va), 1);
+      if (k >= 3) {
+        const int16x8_t vb2 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+        vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb2), vget_low_s16(va), 2);
+        vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb2), vget_low_s16(va), 2);
+        if (k >= 4) {
+          const int16x8_t vb3 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+          vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb3), vget_low_s16(va), 3);
+          vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb3), vget_low_s16(va), 3);
+          if (k >= 5) {
+            const int16x8_t vb4 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+            vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb4), vget_high_s16(va), 0);
+            vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb4), vget_high_s16(va), 0);
+            if (k >= 6) {
+              const int16x8_t vb5 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+              vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb5), vget_high_s16(va), 1);
+              vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb5), vget_high_s16(va), 1);
+              if (k >= 7) {
+                const int16x8_t vb6 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset));
+                vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb6), vget_high_s16(va), 2);
+                vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb6), vget_high_s16(va), 2);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  vacc0x0123 = vaddq_s32(vacc0x0123, vacc1x0123);
+  vacc0x4567 = vaddq_s32(vacc0x4567, vacc1x4567);
+
+  if (nr == 8) {
+    vst1q_s32(c, vacc0x0123);
+    vst1q_s32(c + 4, vacc0x4567);
+  } else {
+    if (nr >= 4) {
+      vst1q_s32(c, vacc0x0123); c += 4;
+      vacc0x0123 = vacc0x4567;
+      nr -= 4;
+    }
+    if (nr >= 2) {
+      vst1_s32(c, vget_low_s32(vacc0x0123)); c += 2;
+      vacc0x0123 = vextq_s32(vacc0x0123, vacc0x0123, 2);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      vst1q_lane_s32(c, vacc0x0123, 0);
+    }
+  }
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <psimd.h>
+
+#include <qnnpack/q8gemm.h>
+
+
+/*
+ * Variant of q8gemm_ukernel_4x8__psimd that stores the 32-bit accumulators of a slice of K of one row, without bias
+ * and requantization, for split-K GEMM.
+ */
+void q8gemm_acc32_ukernel_1x8__psimd(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const uint8_t* restrict a,
+    size_t a_stride,
+    const uint8_t* restrict b,
+    int32_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset)
+{
+  psimd_s32 vacc0123 = psimd_zero_s32();
+  psimd_s32 vacc4567 = psimd_zero_s32();
+
+  const int32_t va_offset = (int32_t) (uint32_t) a_offset;
+  const psimd_s32 vb_offset = psimd_splat_s32((int32_t) (uint32_t) b_offset);
+  for (; k != 0; k--) {
+    const psimd_s32 vb0123 = (psimd_s32) { b[0], b[1], b[2], b[3] } - vb_offset;
+    const psimd_s32 vb4567 = (psimd_s32) { b[4], b[5], b[6], b[7] } - vb_offset;
+    b += 8;
+
+    const psimd_s32 va = psimd_splat_s32((int32_t) (uint32_t) *a++ - va_offset);
+    vacc0123 += va * vb0123;
+    vacc4567 += va * vb4567;
+  }
+
+  int32_t vacc[8];
+  psimd_store_s32(&vacc[0], vacc0123);
+  psimd_store_s32(&vacc[4], vacc4567);
+  for (size_t n = 0; n < nr; n++) {
+    c[n] = vacc[n];
+  }
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8gemm.h>
+
+
+/*
+ * Single-row counterpart of q8gemm_ukernel_4x8__neon, with the same packed B. With one row the multiply-adds of
+ * consecutive k would form a single dependency chain, so even and odd k accumulate separately until the end.
+ */
+void q8gemm_ukernel_1x8__neon(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const uint8_t* restrict a,
+    size_t a_stride,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  int32x4_t vacc0x0123 = vld1q_s32(bias); bias += 4;
+  int32x4_t vacc0x4567 = vld1q_s32(bias);
+  int32x4_t vacc1x0123 = vmovq_n_s32(0);
+  int32x4_t vacc1x4567 = vmovq_n_s32(0);
+
+  const uint8x8_t va_offset = vdup_n_u8(a_offset);
+  const uint8x8_t vb_offset = vdup_n_u8(b_offset);
+  for (; k >= 8; k -= 8) {
+    const int16x8_t va = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(a), va_offset)); a += 8;
+
+    const int16x8_t vb0 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset));
+    const int16x8_t vb1 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 8), vb_offset));
+    const int16x8_t vb2 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 16), vb_offset));
+    const int16x8_t vb3 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 24), vb_offset));
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb0), vget_low_s16(va), 0);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb0), vget_low_s16(va), 0);
+    vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb1), vget_low_s16(va), 1);
+    vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb1), vget_low_s16(va), 1);
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb2), vget_low_s16(va), 2);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb2), vget_low_s16(va), 2);
+    vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb3), vget_low_s16(va), 3);
+    vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb3), vget_low_s16(va), 3);
+
+    const int16x8_t vb4 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 32), vb_offset));
+    const int16x8_t vb5 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 40), vb_offset));
+    const int16x8_t vb6 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 48), vb_offset));
+    const int16x8_t vb7 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b + 56), vb_offset));
+    b += 64;
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb4), vget_high_s16(va), 0);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb4), vget_high_s16(va), 0);
+    vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb5), vget_high_s16(va), 1);
+    vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb5), vget_high_s16(va), 1);
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb6), vget_high_s16(va), 2);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb6), vget_high_s16(va), 2);
+    vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb7), vget_high_s16(va), 3);
+    vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb7), vget_high_s16(va), 3);
+  }
+  if (k != 0) {
+    const size_t a_predecrement = 8 - k;
+    const int64x1_t va_shift = vmov_n_s64(-8 * a_predecrement);
+    const int16x8_t va = vreinterpretq_s16_u16(vsubl_u8(
+        vreinterpret_u8_u64(vshl_u64(vreinterpret_u64_u8(vld1_u8(a - a_predecrement)), va_shift)),
+        va_offset));
+
+    const int16x8_t vb0 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+    vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb0), vget_low_s16(va), 0);
+    vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb0), vget_low_s16(va), 0);
+    if (k >= 2) {
+      const int16x8_t vb1 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+      vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb1), vget_low_s16(va), 1);
+      vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb1), vget_low_s16(va), 1);
+      if (k >= 3) {
+        const int16x8_t vb2 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+        vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb2), vget_low_s16(va), 2);
+        vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb2), vget_low_s16(va), 2);
+        if (k >= 4) {
+          const int16x8_t vb3 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+          vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb3), vget_low_s16(va), 3);
+          vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb3), vget_low_s16(va), 3);
+          if (k >= 5) {
+            const int16x8_t vb4 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+            vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb4), vget_high_s16(va), 0);
+            vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb4), vget_high_s16(va), 0);
+            if (k >= 6) {
+              const int16x8_t vb5 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset)); b += 8;
+              vacc1x0123 = vmlal_lane_s16(vacc1x0123, vget_low_s16(vb5), vget_high_s16(va), 1);
+              vacc1x4567 = vmlal_lane_s16(vacc1x4567, vget_high_s16(vb5), vget_high_s16(va), 1);
+              if (k >= 7) {
+                const int16x8_t vb6 = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(b), vb_offset));
+                vacc0x0123 = vmlal_lane_s16(vacc0x0123, vget_low_s16(vb6), vget_high_s16(va), 2);
+                vacc0x4567 = vmlal_lane_s16(vacc0x4567, vget_high_s16(vb6), vget_high_s16(va), 2);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  vacc0x0123 = vaddq_s32(vacc0x0123, vacc1x0123);
+  vacc0x4567 = vaddq_s32(vacc0x4567, vacc1x4567);
+
+  const int32x4_t vmultiplier = vld1q_dup_s32(&requantization_params->neon.multiplier);
+  vacc0x0123 = vqrdmulhq_s32(vacc0x0123, vmultiplier);
+  vacc0x4567 = vqrdmulhq_s32(vacc0x4567, vmultiplier);
+
+  const int32x4_t vright_shift = vld1q_dup_s32(&requantization_params->neon.right_shift);
+  const int32x4_t vzero_shift_mask = vreinterpretq_s32_u32(vceqq_s32(vright_shift, vmovq_n_s32(0)));
+  vacc0x0123 = vsraq_n_s32(vacc0x0123, vbicq_s32(vacc0x0123, vzero_shift_mask), 31);
+  vacc0x4567 = vsraq_n_s32(vacc0x4567, vbicq_s32(vacc0x4567, vzero_shift_mask), 31);
+
+  vacc0x0123 = vrshlq_s32(vacc0x0123, vright_shift);
+  vacc0x4567 = vrshlq_s32(vacc0x4567, vright_shift);
+
+  const int16x8_t vzero_point = vld1q_dup_s16(&requantization_params->neon.zero_point);
+#ifdef __aarch64__
+  const int16x8_t vacc0x01234567 = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vacc0x0123), vacc0x4567), vzero_point);
+#else
+  const int16x8_t vacc0x01234567 = vqaddq_s16(vcombine_s16(vqmovn_s32(vacc0x0123), vqmovn_s32(vacc0x4567)), vzero_point);
+#endif
+  uint8x8_t vout0x01234567 = vqmovun_s16(vacc0x01234567);
+
+  const uint8x8_t vmin = vld1_dup_u8(&requantization_params->neon.min);
+  const uint8x8_t vmax = vld1_dup_u8(&requantization_params->neon.max);
+  vout0x01234567 = vmax_u8(vout0x01234567, vmin);
+  vout0x01234567 = vmin_u8(vout0x01234567, vmax);
+
+  if (nr == 8) {
+    vst1_u8(c, vout0x01234567);
+  } else {
+    if (nr >= 4) {
+      vst1_lane_u32(__builtin_assume_aligned(c, 1), vreinterpret_u32_u8(vout0x01234567), 0); c += 4;
+      vout0x01234567 = vext_u8(vout0x01234567, vout0x01234567, 4);
+      nr -= 4;
+    }
+    if (nr >= 2) {
+      vst1_lane_u16(__builtin_assume_aligned(c, 1), vreinterpret_u16_u8(vout0x01234567), 0); c += 2;
+      vout0x01234567 = vext_u8(vout0x01234567, vout0x01234567, 2);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      vst1_lane_u8(c, vout0x01234567, 0);
+    }
+  }
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8gemm.h>
+
+
+/* Single-row counterpart of q8gemm_4bit_ukernel_4x8c2__neon, with the same packed B */
+void q8gemm_4bit_ukernel_1x8c2__neon(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const uint8_t* restrict a,
+    size_t a_stride,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  int32x4_t vacc0x01 = vmovq_n_s32(0);
+  int32x4_t vacc0x23 = vmovq_n_s32(0);
+  int32x4_t vacc0x45 = vmovq_n_s32(0);
+  int32x4_t vacc0x67 = vmovq_n_s32(0);
+
+  const uint8_t* a0 = a;
+
+  const uint8x8_t va_offset = vdup_n_u8(a_offset);
+  const uint8x8_t vb_offset = vdup_n_u8(b_offset);
+  const uint8x8_t vnibble_mask = vmov_n_u8(0x0F);
+  /*
+   * Each byte of B holds both k of a channel; zipping its low and high nibbles restores the 8-bit layout of channels
+   * 0-3 and 4-7. Products of channel j accumulate in lanes 2 * (j % 2) and 2 * (j % 2) + 1 of vacc*x{j & ~1}{j | 1}.
+   */
+  for (; k >= 2; k -= 2) {
+    const uint8x8_t vb_packed = vld1_u8(b); b += 8;
+    const uint8x8x2_t vb = vzip_u8(vand_u8(vb_packed, vnibble_mask), vshr_n_u8(vb_packed, 4));
+    const int16x8_t vxb0123 = vreinterpretq_s16_u16(vsubl_u8(vb.val[0], vb_offset));
+    const int16x8_t vxb4567 = vreinterpretq_s16_u16(vsubl_u8(vb.val[1], vb_offset));
+
+    const uint8x8_t va0 = vreinterpret_u8_u16(vld1_dup_u16(__builtin_assume_aligned((const uint16_t*) a0, 1)));
+    a0 += 2;
+    const int16x8_t vxa0 = vreinterpretq_s16_u16(vsubl_u8(va0, va_offset));
+    vacc0x01 = vmlal_s16(vacc0x01, vget_low_s16(vxa0), vget_low_s16(vxb0123));
+    vacc0x23 = vmlal_s16(vacc0x23, vget_high_s16(vxa0), vget_high_s16(vxb0123));
+    vacc0x45 = vmlal_s16(vacc0x45, vget_low_s16(vxa0), vget_low_s16(vxb4567));
+    vacc0x67 = vmlal_s16(vacc0x67, vget_high_s16(vxa0), vget_high_s16(vxb4567));
+  }
+  if (k != 0) {
+    /* The last k pairs with the zero point, so it is duplicated into both k of the pair */
+    const uint8x8_t vb_packed = vld1_u8(b);
+    const uint8x8x2_t vb = vzip_u8(vand_u8(vb_packed, vnibble_mask), vshr_n_u8(vb_packed, 4));
+    const int16x8_t vxb0123 = vreinterpretq_s16_u16(vsubl_u8(vb.val[0], vb_offset));
+    const int16x8_t vxb4567 = vreinterpretq_s16_u16(vsubl_u8(vb.val[1], vb_offset));
+
+    const int16x8_t vxa0 = vreinterpretq_s16_u16(vsubl_u8(vld1_dup_u8(a0), va_offset));
+    vacc0x01 = vmlal_s16(vacc0x01, vget_low_s16(vxa0), vget_low_s16(vxb0123));
+    vacc0x23 = vmlal_s16(vacc0x23, vget_high_s16(vxa0), vget_high_s16(vxb0123));
+    vacc0x45 = vmlal_s16(vacc0x45, vget_low_s16(vxa0), vget_low_s16(vxb4567));
+    vacc0x67 = vmlal_s16(vacc0x67, vget_high_s16(vxa0), vget_high_s16(vxb4567));
+  }
+
+  /* Sum the pairs of lanes of each output channel and add the bias */
+  int32x4_t vacc0x0123 = vaddq_s32(vld1q_s32(bias + 0), vcombine_s32(
+      vpadd_s32(vget_low_s32(vacc0x01), vget_high_s32(vacc0x01)),
+      vpadd_s32(vget_low_s32(vacc0x23), vget_high_s32(vacc0x23))));
+  int32x4_t vacc0x4567 = vaddq_s32(vld1q_s32(bias + 4), vcombine_s32(
+      vpadd_s32(vget_low_s32(vacc0x45), vget_high_s32(vacc0x45)),
+      vpadd_s32(vget_low_s32(vacc0x67), vget_high_s32(vacc0x67))));
+
+  const int32x4_t vmultiplier = vld1q_dup_s32(&requantization_params->neon.multiplier);
+  vacc0x0123 = vqrdmulhq_s32(vacc0x0123, vmultiplier);
+  vacc0x4567 = vqrdmulhq_s32(vacc0x4567, vmultiplier);
+
+  const int32x4_t vright_shift = vld1q_dup_s32(&requantization_params->neon.right_shift);
+  const int32x4_t vzero_shift_mask = vreinterpretq_s32_u32(vceqq_s32(vright_shift, vmovq_n_s32(0)));
+  vacc0x0123 = vsraq_n_s32(vacc0x0123, vbicq_s32(vacc0x0123, vzero_shift_mask), 31);
+  vacc0x4567 = vsraq_n_s32(vacc0x4567, vbicq_s32(vacc0x4567, vzero_shift_mask), 31);
+
+  vacc0x0123 = vrshlq_s32(vacc0x0123, vright_shift);
+  vacc0x4567 = vrshlq_s32(vacc0x4567, vright_shift);
+
+  const int16x8_t vzero_point = vld1q_dup_s16(&requantization_params->neon.zero_point);
+#ifdef __aarch64__
+  const int16x8_t vacc0x01234567 = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vacc0x0123), vacc0x4567), vzero_point);
+#else
+  const int16x8_t vacc0x01234567 = vqaddq_s16(vcombine_s16(vqmovn_s32(vacc0x0123), vqmovn_s32(vacc0x4567)), vzero_point);
+#endif
+  uint8x8_t vout0x01234567 = vqmovun_s16(vacc0x01234567);
+
+  const uint8x8_t vmin = vld1_dup_u8(&requantization_params->neon.min);
+  const uint8x8_t vmax = vld1_dup_u8(&requantization_params->neon.max);
+  vout0x01234567 = vmax_u8(vout0x01234567, vmin);
+  vout0x01234567 = vmin_u8(vout0x01234567, vmax);
+
+  if (nr == 8) {
+    vst1_u8(c, vout0x01234567);
+  } else {
+    if (nr >= 4) {
+      vst1_lane_u32(__builtin_assume_aligned(c, 1), vreinterpret_u32_u8(vout0x01234567), 0); c += 4;
+      vout0x01234567 = vext_u8(vout0x01234567, vout0x01234567, 4);
+      nr -= 4;
+    }
+    if (nr >= 2) {
+      vst1_lane_u16(__builtin_assume_aligned(c, 1), vreinterpret_u16_u8(vout0x01234567), 0); c += 2;
+      vout0x01234567 = vext_u8(vout0x01234567, vout0x01234567, 2);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      vst1_lane_u8(c, vout0x01234567, 0);
+    }
+  }
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <immintrin.h>
+
+#include <qnnpack/q8gemm.h>
+
+
+/*
+ * Variant of q8gemm_ukernel_1x8c2__avx2 that stores the 32-bit accumulators of a slice of K, without bias and
+ * requantization, for split-K GEMM.
+ */
+void q8gemm_acc32_ukernel_1x8c2__avx2(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const uint8_t* restrict a,
+    size_t a_stride,
+    const uint8_t* restrict b,
+    int32_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset)
+{
+  __m256i vacc0x01234567 = _mm256_setzero_si256();
+  __m256i vacc1x01234567 = _mm256_setzero_si256();
+
+  const __m256i va_offset = _mm256_set1_epi16((uint16_t) a_offset);
+  const __m256i vb_offset = _mm256_set1_epi16((uint16_t) b_offset);
+  for (; k >= 8; k -= 8) {
+    const __m256i va = _mm256_sub_epi16(
+        _mm256_broadcastsi128_si256(_mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*) a))), va_offset);
+    a += 8;
+
+    const __m256i vb0 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) b)), vb_offset);
+    const __m256i vb1 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 16))), vb_offset);
+    vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+    vacc1x01234567 = _mm256_add_epi32(vacc1x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+
+    const __m256i vb2 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 32))), vb_offset);
+    const __m256i vb3 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 48))), vb_offset);
+    b += 64;
+    vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+    vacc1x01234567 = _mm256_add_epi32(vacc1x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+  }
+  if (k != 0) {
+    const size_t a_predecrement = 8 - k;
+    const __m128i va_shift = _mm_cvtsi32_si128(8 * a_predecrement);
+    const __m256i va = _mm256_sub_epi16(_mm256_broadcastsi128_si256(_mm_cvtepu8_epi16(
+        _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a - a_predecrement)), va_shift))), va_offset);
+
+    const __m256i vb0 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) b)), vb_offset);
+    vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+
+    if (k > 2) {
+      const __m256i vb1 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 16))), vb_offset);
+      vacc1x01234567 = _mm256_add_epi32(vacc1x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+
+      if (k > 4) {
+        const __m256i vb2 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 32))), vb_offset);
+        vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+
+        if (k > 6) {
+          const __m256i vb3 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 48))), vb_offset);
+          vacc1x01234567 = _mm256_add_epi32(vacc1x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+        }
+      }
+    }
+  }
+  vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, vacc1x01234567);
+
+  if (nr == 8) {
+    _mm256_storeu_si256((__m256i*) c, vacc0x01234567);
+  } else {
+    __m128i vacc0x0123 = _mm256_castsi256_si128(vacc0x01234567);
+    if (nr >= 4) {
+      _mm_storeu_si128((__m128i*) c, vacc0x0123);
+      c += 4;
+      vacc0x0123 = _mm256_extracti128_si256(vacc0x01234567, 1);
+      nr -= 4;
+    }
+    if (nr >= 2) {
+      _mm_storel_epi64((__m128i*) c, vacc0x0123);
+      c += 2;
+      vacc0x0123 = _mm_unpackhi_epi64(vacc0x0123, vacc0x0123);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      *c = _mm_cvtsi128_si32(vacc0x0123);
+    }
+  }
+}
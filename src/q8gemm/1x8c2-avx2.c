@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <immintrin.h>
+
+#include <qnnpack/q8gemm.h>
+
+
+/*
+ * Single-row counterpart of q8gemm_ukernel_4x8c2__avx2, with the same packed B. Even and odd pairs of k accumulate
+ * separately to keep two independent VPMADDWD chains in flight.
+ */
+void q8gemm_ukernel_1x8c2__avx2(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const uint8_t* restrict a,
+    size_t a_stride,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  __m256i vacc0x01234567 = _mm256_loadu_si256((const __m256i*) bias);
+  __m256i vacc1x01234567 = _mm256_setzero_si256();
+
+  const __m256i va_offset = _mm256_set1_epi16((uint16_t) a_offset);
+  const __m256i vb_offset = _mm256_set1_epi16((uint16_t) b_offset);
+  for (; k >= 8; k -= 8) {
+    const __m256i va = _mm256_sub_epi16(
+        _mm256_broadcastsi128_si256(_mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*) a))), va_offset);
+    a += 8;
+
+    const __m256i vb0 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) b)), vb_offset);
+    const __m256i vb1 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 16))), vb_offset);
+    vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+    vacc1x01234567 = _mm256_add_epi32(vacc1x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+
+    const __m256i vb2 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 32))), vb_offset);
+    const __m256i vb3 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 48))), vb_offset);
+    b += 64;
+    vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+    vacc1x01234567 = _mm256_add_epi32(vacc1x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+  }
+  if (k != 0) {
+    const size_t a_predecrement = 8 - k;
+    const __m128i va_shift = _mm_cvtsi32_si128(8 * a_predecrement);
+    const __m256i va = _mm256_sub_epi16(_mm256_broadcastsi128_si256(_mm_cvtepu8_epi16(
+        _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a - a_predecrement)), va_shift))), va_offset);
+
+    const __m256i vb0 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) b)), vb_offset);
+    vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(0, 0, 0, 0)), vb0));
+
+    if (k > 2) {
+      const __m256i vb1 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 16))), vb_offset);
+      vacc1x01234567 = _mm256_add_epi32(vacc1x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(1, 1, 1, 1)), vb1));
+
+      if (k > 4) {
+        const __m256i vb2 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 32))), vb_offset);
+        vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(2, 2, 2, 2)), vb2));
+
+        if (k > 6) {
+          const __m256i vb3 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*) (b + 48))), vb_offset);
+          vacc1x01234567 = _mm256_add_epi32(vacc1x01234567, _mm256_madd_epi16(_mm256_shuffle_epi32(va, _MM_SHUFFLE(3, 3, 3, 3)), vb3));
+        }
+      }
+    }
+  }
+  vacc0x01234567 = _mm256_add_epi32(vacc0x01234567, vacc1x01234567);
+
+  const __m256i vmultiplier = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.multiplier));
+  const __m256i vrounding = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.rounding));
+
+  const __m256i vprod0x0246 = _mm256_add_epi64(_mm256_mul_epi32(vacc0x01234567, vmultiplier), vrounding);
+  const __m256i vprod0x1357 = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(vacc0x01234567, 32), vmultiplier), vrounding);
+  const __m256i vq31prod0x01234567 = _mm256_blend_epi32(
+      _mm256_srli_epi64(vprod0x0246, 31), _mm256_add_epi64(vprod0x1357, vprod0x1357), 0xAA);
+
+  const __m256i vremainder_mask = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.remainder_mask));
+  const __m256i vrem0x01234567 =
+    _mm256_add_epi32(_mm256_and_si256(vq31prod0x01234567, vremainder_mask), _mm256_cmpgt_epi32(_mm256_setzero_si256(), vq31prod0x01234567));
+
+  const __m256i vremainder_threshold = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.remainder_threshold));
+  const __m128i vshift = _mm_load_si128((const __m128i*) requantization_params->sse2.shift);
+  vacc0x01234567 =
+    _mm256_sub_epi32(_mm256_sra_epi32(vq31prod0x01234567, vshift), _mm256_cmpgt_epi32(vrem0x01234567, vremainder_threshold));
+
+  const __m128i vzero_point = _mm_load_si128((const __m128i*) requantization_params->sse2.zero_point);
+  const __m128i vacc0x01234567s16 = _mm_adds_epi16(
+      _mm_packs_epi32(_mm256_castsi256_si128(vacc0x01234567), _mm256_extracti128_si256(vacc0x01234567, 1)), vzero_point);
+  __m128i vout = _mm_packus_epi16(vacc0x01234567s16, vacc0x01234567s16);
+  vout = _mm_max_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.min));
+  vout = _mm_min_epu8(vout, _mm_load_si128((const __m128i*) requantization_params->sse2.max));
+
+  if (nr == 8) {
+    _mm_storel_epi64((__m128i*) c, vout);
+  } else {
+    if (nr >= 4) {
+      *((uint32_t*) c) = (uint32_t) _mm_cvtsi128_si32(vout);
+      c += 4;
+      vout = _mm_srli_epi64(vout, 32);
+      nr -= 4;
+    }
+    if (nr >= 2) {
+      *((uint16_t*) c) = (uint16_t) _mm_extract_epi16(vout, 0);
+      c += 2;
+      vout = _mm_srli_epi64(vout, 16);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      *((uint8_t*) c) = (uint8_t) _mm_cvtsi128_si32(vout);
+    }
+  }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8gemm.h>
+
+
+void q8gemm_sparse_ukernel_4x4c1x4__neon(
+    size_t mr,
+    size_t nr,
+    const uint8_t* restrict a,
+    size_t a_stride,
+    const uint32_t* restrict row_ptr,
+    const uint32_t* restrict block_channels,
+    const uint8_t* restrict values,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const uint8_t* a0 = a;
+  const uint8_t* a1 = (const uint8_t*) ((uintptr_t) a0 + a_stride);
+  if (mr < 2) {
+    a1 = a0;
+  }
+  const uint8_t* a2 = (const uint8_t*) ((uintptr_t) a1 + a_stride);
+  if (mr <= 2) {
+    a2 = a1;
+  }
+  const uint8_t* a3 = (const uint8_t*) ((uintptr_t) a2 + a_stride);
+  if (mr != 4) {
+    a3 = a2;
+  }
+
+  const uint8x8_t va_offset = vdup_n_u8(a_offset);
+  const uint8x8_t vb_offset = vdup_n_u8(b_offset);
+
+  /* Sums of output channel j over rows 0 to 3 in vacc0123[j]. Output channels past nr have no blocks. */
+  int32x4_t vacc0123[4];
+  for (size_t j = 0; j < 4; j++) {
+    int32x4_t vacc0 = vmovq_n_s32(0);
+    int32x4_t vacc1 = vmovq_n_s32(0);
+    int32x4_t vacc2 = vmovq_n_s32(0);
+    int32x4_t vacc3 = vmovq_n_s32(0);
+    for (uint32_t i = row_ptr[j]; i < row_ptr[j + 1]; i++) {
+      const size_t channel = (size_t) block_channels[i];
+      uint32x2_t va01 = vld1_dup_u32(__builtin_assume_aligned((const uint32_t*) (a0 + channel), 1));
+      va01 = vld1_lane_u32(__builtin_assume_aligned((const uint32_t*) (a1 + channel), 1), va01, 1);
+      uint32x2_t va23 = vld1_dup_u32(__builtin_assume_aligned((const uint32_t*) (a2 + channel), 1));
+      va23 = vld1_lane_u32(__builtin_assume_aligned((const uint32_t*) (a3 + channel), 1), va23, 1);
+      const int16x8_t vxa01 = vreinterpretq_s16_u16(vsubl_u8(vreinterpret_u8_u32(va01), va_offset));
+      const int16x8_t vxa23 = vreinterpretq_s16_u16(vsubl_u8(vreinterpret_u8_u32(va23), va_offset));
+      const uint32x2_t vb = vld1_dup_u32((const uint32_t*) (values + i * 4));
+      const int16x4_t vxb = vget_low_s16(vreinterpretq_s16_u16(vsubl_u8(vreinterpret_u8_u32(vb), vb_offset)));
+      vacc0 = vmlal_s16(vacc0, vget_low_s16(vxa01), vxb);
+      vacc1 = vmlal_s16(vacc1, vget_high_s16(vxa01), vxb);
+      vacc2 = vmlal_s16(vacc2, vget_low_s16(vxa23), vxb);
+      vacc3 = vmlal_s16(vacc3, vget_high_s16(vxa23), vxb);
+    }
+    const int32x2_t vsum01 = vpadd_s32(
+        vpadd_s32(vget_low_s32(vacc0), vget_high_s32(vacc0)),
+        vpadd_s32(vget_low_s32(vacc1), vget_high_s32(vacc1)));
+    const int32x2_t vsum23 = vpadd_s32(
+        vpadd_s32(vget_low_s32(vacc2), vget_high_s32(vacc2)),
+        vpadd_s32(vget_low_s32(vacc3), vget_high_s32(vacc3)));
+    vacc0123[j] = vcombine_s32(vsum01, vsum23);
+  }
+
+  /* Transpose the sums to rows of 4 output channels */
+  const int32x4x2_t vacc01 = vtrnq_s32(vacc0123[0], vacc0123[1]);
+  const int32x4x2_t vacc23 = vtrnq_s32(vacc0123[2], vacc0123[3]);
+  const int32x4_t vbias = vld1q_s32(bias);
+  int32x4_t vacc0x0123 = vaddq_s32(vbias, vcombine_s32(vget_low_s32(vacc01.val[0]), vget_low_s32(vacc23.val[0])));
+  int32x4_t vacc1x0123 = vaddq_s32(vbias, vcombine_s32(vget_low_s32(vacc01.val[1]), vget_low_s32(vacc23.val[1])));
+  int32x4_t vacc2x0123 = vaddq_s32(vbias, vcombine_s32(vget_high_s32(vacc01.val[0]), vget_high_s32(vacc23.val[0])));
+  int32x4_t vacc3x0123 = vaddq_s32(vbias, vcombine_s32(vget_high_s32(vacc01.val[1]), vget_high_s32(vacc23.val[1])));
+
+  const int32x4_t vmultiplier = vld1q_dup_s32(&requantization_params->neon.multiplier);
+  vacc0x0123 = vqrdmulhq_s32(vacc0x0123, vmultiplier);
+  vacc1x0123 = vqrdmulhq_s32(vacc1x0123, vmultiplier);
+  vacc2x0123 = vqrdmulhq_s32(vacc2x0123, vmultiplier);
+  vacc3x0123 = vqrdmulhq_s32(vacc3x0123, vmultiplier);
+
+  const int32x4_t vright_shift = vld1q_dup_s32(&requantization_params->neon.right_shift);
+  const int32x4_t vzero_shift_mask = vreinterpretq_s32_u32(vceqq_s32(vright_shift, vmovq_n_s32(0)));
+  vacc0x0123 = vsraq_n_s32(vacc0x0123, vbicq_s32(vacc0x0123, vzero_shift_mask), 31);
+  vacc1x0123 = vsraq_n_s32(vacc1x0123, vbicq_s32(vacc1x0123, vzero_shift_mask), 31);
+  vacc2x0123 = vsraq_n_s32(vacc2x0123, vbicq_s32(vacc2x0123, vzero_shift_mask), 31);
+  vacc3x0123 = vsraq_n_s32(vacc3x0123, vbicq_s32(vacc3x0123, vzero_shift_mask), 31);
+
+  vacc0x0123 = vrshlq_s32(vacc0x0123, vright_shift);
+  vacc1x0123 = vrshlq_s32(vacc1x0123, vright_shift);
+  vacc2x0123 = vrshlq_s32(vacc2x0123, vright_shift);
+  vacc3x0123 = vrshlq_s32(vacc3x0123, vright_shift);
+
+  const int16x8_t vzero_point = vld1q_dup_s16(&requantization_params->neon.zero_point);
+#ifdef __aarch64__
+  const int16x8_t vacc01x0123 = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vacc0x0123), vacc1x0123), vzero_point);
+  const int16x8_t vacc23x0123 = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vacc2x0123), vacc3x0123), vzero_point);
+
+  uint8x16_t vout0123x0123 = vqmovun_high_s16(vqmovun_s16(vacc01x0123), vacc23x0123);
+#else
+  const int16x8_t vacc01x0123 = vqaddq_s16(vcombine_s16(vqmovn_s32(vacc0x0123), vqmovn_s32(vacc1x0123)), vzero_point);
+  const int16x8_t vacc23x0123 = vqaddq_s16(vcombine_s16(vqmovn_s32(vacc2x0123), vqmovn_s32(vacc3x0123)), vzero_point);
+
+  uint8x16_t vout0123x0123 = vcombine_u8(vqmovun_s16(vacc01x0123), vqmovun_s16(vacc23x0123));
+#endif
+  const uint8x16_t vmin = vld1q_dup_u8(&requantization_params->neon.min);
+  const uint8x16_t vmax = vld1q_dup_u8(&requantization_params->neon.max);
+
+  vout0123x0123 = vmaxq_u8(vout0123x0123, vmin);
+  vout0123x0123 = vminq_u8(vout0123x0123, vmax);
+
+  uint8_t* c0 = c;
+  uint8_t* c1 = (uint8_t*) ((uintptr_t) c0 + c_stride);
+  if (mr < 2) {
+    c1 = c0;
+  }
+  uint8_t* c2 = (uint8_t*) ((uintptr_t) c1 + c_stride);
+  if (mr <= 2) {
+    c2 = c1;
+  }
+  uint8_t* c3 = (uint8_t*) ((uintptr_t) c2 + c_stride);
+  if (mr != 4) {
+    c3 = c2;
+  }
+  if (nr == 4) {
+    vst1q_lane_u32(__builtin_assume_aligned(c0, 1), vreinterpretq_u32_u8(vout0123x0123), 0);
+    vst1q_lane_u32(__builtin_assume_aligned(c1, 1), vreinterpretq_u32_u8(vout0123x0123), 1);
+    vst1q_lane_u32(__builtin_assume_aligned(c2, 1), vreinterpretq_u32_u8(vout0123x0123), 2);
+    vst1q_lane_u32(__builtin_assume_aligned(c3, 1), vreinterpretq_u32_u8(vout0123x0123), 3);
+  } else {
+    if (nr >= 2) {
+      vst1q_lane_u16(__builtin_assume_aligned(c0, 1), vreinterpretq_u16_u8(vout0123x0123), 0); c0 += 2;
+      vst1q_lane_u16(__builtin_assume_aligned(c1, 1), vreinterpretq_u16_u8(vout0123x0123), 2); c1 += 2;
+      vst1q_lane_u16(__builtin_assume_aligned(c2, 1), vreinterpretq_u16_u8(vout0123x0123), 4); c2 += 2;
+      vst1q_lane_u16(__builtin_assume_aligned(c3, 1), vreinterpretq_u16_u8(vout0123x0123), 6); c3 += 2;
+      vout0123x0123 = vextq_u8(vout0123x0123, vout0123x0123, 2);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      vst1q_lane_u8(__builtin_assume_aligned(c0, 1), vout0123x0123, 0);
+      vst1q_lane_u8(__builtin_assume_aligned(c1, 1), vout0123x0123, 4);
+      vst1q_lane_u8(__builtin_assume_aligned(c2, 1), vout0123x0123, 8);
+      vst1q_lane_u8(__builtin_assume_aligned(c3, 1), vout0123x0123, 12);
+    }
+  }
+}
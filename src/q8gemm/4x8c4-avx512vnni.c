@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <immintrin.h>
+
+#include <qnnpack/q8gemm.h>
+
+
+/*
+ * VPDPBUSD multiplies unsigned bytes of A by signed bytes of B, so B is flipped to the signed range
+ * (b ^ 0x80 == b - 128) and the zero points are applied at the end using
+ *   sum (a - a_offset) * (b' - b_offset') = sum a * b' - a_offset * sum b' - b_offset' * sum a + k * a_offset * b_offset',
+ * where b' = b - 128 and b_offset' = b_offset - 128.
+ * As in the dot-product NEON kernel, B is packed with kr = 4 and padded with b_offset, and the K remainder of A is
+ * zero-filled, so the padding contributes nothing to the result when k is rounded up to a multiple of 4.
+ */
+void q8gemm_ukernel_4x8c4__avx512vnni(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const uint8_t* restrict a,
+    size_t a_stride,
+    const uint8_t* restrict b,
+    const int32_t* restrict bias,
+    uint8_t* restrict c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1])
+{
+  const int32_t k_padded = (int32_t) ((k + 3) & -4);
+
+  __m256i vacc0x01234567 = _mm256_loadu_si256((const __m256i*) bias);
+  __m256i vacc1x01234567 = vacc0x01234567;
+  __m256i vacc2x01234567 = vacc0x01234567;
+  __m256i vacc3x01234567 = vacc0x01234567;
+  __m128i va01sum = _mm_setzero_si128();
+  __m128i va23sum = _mm_setzero_si128();
+  __m256i vbsum01234567 = _mm256_setzero_si256();
+
+  const uint8_t* a0 = a;
+  const uint8_t* a1 = (const uint8_t*) ((uintptr_t) a0 + a_stride);
+  if (mr < 2) {
+    a1 = a0;
+  }
+  const uint8_t* a2 = (const uint8_t*) ((uintptr_t) a1 + a_stride);
+  if (mr <= 2) {
+    a2 = a1;
+  }
+  const uint8_t* a3 = (const uint8_t*) ((uintptr_t) a2 + a_stride);
+  if (mr != 4) {
+    a3 = a2;
+  }
+
+  const __m256i vsign = _mm256_set1_epi8((char) 0x80);
+  const __m256i vones = _mm256_set1_epi8(1);
+  const __m128i vzero = _mm_setzero_si128();
+  for (; k >= 8; k -= 8) {
+    const __m128i va0 = _mm_loadl_epi64((const __m128i*) a0); a0 += 8;
+    const __m128i va1 = _mm_loadl_epi64((const __m128i*) a1); a1 += 8;
+    const __m128i va2 = _mm_loadl_epi64((const __m128i*) a2); a2 += 8;
+    const __m128i va3 = _mm_loadl_epi64((const __m128i*) a3); a3 += 8;
+
+    va01sum = _mm_add_epi64(va01sum, _mm_sad_epu8(_mm_unpacklo_epi64(va0, va1), vzero));
+    va23sum = _mm_add_epi64(va23sum, _mm_sad_epu8(_mm_unpacklo_epi64(va2, va3), vzero));
+
+    const __m256i vb0 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) b), vsign);
+    vbsum01234567 = _mm256_dpbusd_epi32(vbsum01234567, vones, vb0);
+    vacc0x01234567 = _mm256_dpbusd_epi32(vacc0x01234567, _mm256_broadcastd_epi32(va0), vb0);
+    vacc1x01234567 = _mm256_dpbusd_epi32(vacc1x01234567, _mm256_broadcastd_epi32(va1), vb0);
+    vacc2x01234567 = _mm256_dpbusd_epi32(vacc2x01234567, _mm256_broadcastd_epi32(va2), vb0);
+    vacc3x01234567 = _mm256_dpbusd_epi32(vacc3x01234567, _mm256_broadcastd_epi32(va3), vb0);
+
+    const __m256i vb1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) (b + 32)), vsign);
+    b += 64;
+    vbsum01234567 = _mm256_dpbusd_epi32(vbsum01234567, vones, vb1);
+    vacc0x01234567 = _mm256_dpbusd_epi32(vacc0x01234567, _mm256_broadcastd_epi32(_mm_srli_epi64(va0, 32)), vb1);
+    vacc1x01234567 = _mm256_dpbusd_epi32(vacc1x01234567, _mm256_broadcastd_epi32(_mm_srli_epi64(va1, 32)), vb1);
+    vacc2x01234567 = _mm256_dpbusd_epi32(vacc2x01234567, _mm256_broadcastd_epi32(_mm_srli_epi64(va2, 32)), vb1);
+    vacc3x01234567 = _mm256_dpbusd_epi32(vacc3x01234567, _mm256_broadcastd_epi32(_mm_srli_epi64(va3, 32)), vb1);
+  }
+  if (k != 0) {
+    const size_t a_predecrement = 8 - k;
+    const __m128i va_shift = _mm_cvtsi32_si128(8 * a_predecrement);
+
+    const __m128i va0 = _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a0 - a_predecrement)), va_shift);
+    const __m128i va1 = _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a1 - a_predecrement)), va_shift);
+    const __m128i va2 = _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a2 - a_predecrement)), va_shift);
+    const __m128i va3 = _mm_srl_epi64(_mm_loadl_epi64((const __m128i*) (a3 - a_predecrement)), va_shift);
+
+    va01sum = _mm_add_epi64(va01sum, _mm_sad_epu8(_mm_unpacklo_epi64(va0, va1), vzero));
+    va23sum = _mm_add_epi64(va23sum, _mm_sad_epu8(_mm_unpacklo_epi64(va2, va3), vzero));
+
+    const __m256i vb0 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) b), vsign);
+    vbsum01234567 = _mm256_dpbusd_epi32(vbsum01234567, vones, vb0);
+    vacc0x01234567 = _mm256_dpbusd_epi32(vacc0x01234567, _mm256_broadcastd_epi32(va0), vb0);
+    vacc1x01234567 = _mm256_dpbusd_epi32(vacc1x01234567, _mm256_broadcastd_epi32(va1), vb0);
+    vacc2x01234567 = _mm256_dpbusd_epi32(vacc2x01234567, _mm256_broadcastd_epi32(va2), vb0);
+    vacc3x01234567 = _mm256_dpbusd_epi32(vacc3x01234567, _mm256_broadcastd_epi32(va3), vb0);
+
+    if (k > 4) {
+      const __m256i vb1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) (b + 32)), vsign);
+      vbsum01234567 = _mm256_dpbusd_epi32(vbsum01234567, vones, vb1);
+      vacc0x01234567 = _mm256_dpbusd_epi32(vacc0x01234567, _mm256_broadcastd_epi32(_mm_srli_epi64(va0, 32)), vb1);
+      vacc1x01234567 = _mm256_dpbusd_epi32(vacc1x01234567, _mm256_broadcastd_epi32(_mm_srli_epi64(va1, 32)), vb1);
+      vacc2x01234567 = _mm256_dpbusd_epi32(vacc2x01234567, _mm256_broadcastd_epi32(_mm_srli_epi64(va2, 32)), vb1);
+      vacc3x01234567 = _mm256_dpbusd_epi32(vacc3x01234567, _mm256_broadcastd_epi32(_mm_srli_epi64(va3, 32)), vb1);
+    }
+  }
+
+  const int32_t signed_b_offset = (int32_t) (uint32_t) b_offset - 128;
+  const __m256i vcorrection01234567 = _mm256_sub_epi32(
+      _mm256_set1_epi32(k_padded * (int32_t) (uint32_t) a_offset * signed_b_offset),
+      _mm256_mullo_epi32(vbsum01234567, _mm256_set1_epi32((int32_t) (uint32_t) a_offset)));
+  vacc0x01234567 = _mm256_sub_epi32(_mm256_add_epi32(vacc0x01234567, vcorrection01234567),
+      _mm256_set1_epi32(signed_b_offset * _mm_cvtsi128_si32(va01sum)));
+  vacc1x01234567 = _mm256_sub_epi32(_mm256_add_epi32(vacc1x01234567, vcorrection01234567),
+      _mm256_set1_epi32(signed_b_offset * _mm_extract_epi32(va01sum, 2)));
+  vacc2x01234567 = _mm256_sub_epi32(_mm256_add_epi32(vacc2x01234567, vcorrection01234567),
+      _mm256_set1_epi32(signed_b_offset * _mm_cvtsi128_si32(va23sum)));
+  vacc3x01234567 = _mm256_sub_epi32(_mm256_add_epi32(vacc3x01234567, vcorrection01234567),
+      _mm256_set1_epi32(signed_b_offset * _mm_extract_epi32(va23sum, 2)));
+
+  const __m256i vmultiplier = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.multiplier));
+  const __m256i vrounding = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.rounding));
+
+  const __m256i vprod0x0246 = _mm256_add_epi64(_mm256_mul_epi32(vacc0x01234567, vmultiplier), vrounding);
+  const __m256i vprod1x0246 = _mm256_add_epi64(_mm256_mul_epi32(vacc1x01234567, vmultiplier), vrounding);
+  const __m256i vprod2x0246 = _mm256_add_epi64(_mm256_mul_epi32(vacc2x01234567, vmultiplier), vrounding);
+  const __m256i vprod3x0246 = _mm256_add_epi64(_mm256_mul_epi32(vacc3x01234567, vmultiplier), vrounding);
+
+  const __m256i vprod0x1357 = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(vacc0x01234567, 32), vmultiplier), vrounding);
+  const __m256i vprod1x1357 = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(vacc1x01234567, 32), vmultiplier), vrounding);
+  const __m256i vprod2x1357 = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(vacc2x01234567, 32), vmultiplier), vrounding);
+  const __m256i vprod3x1357 = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(vacc3x01234567, 32), vmultiplier), vrounding);
+
+  const __m256i vq31prod0x01234567 = _mm256_blend_epi32(
+      _mm256_srli_epi64(vprod0x0246, 31), _mm256_add_epi64(vprod0x1357, vprod0x1357), 0xAA);
+  const __m256i vq31prod1x01234567 = _mm256_blend_epi32(
+      _mm256_srli_epi64(vprod1x0246, 31), _mm256_add_epi64(vprod1x1357, vprod1x1357), 0xAA);
+  const __m256i vq31prod2x01234567 = _mm256_blend_epi32(
+      _mm256_srli_epi64(vprod2x0246, 31), _mm256_add_epi64(vprod2x1357, vprod2x1357), 0xAA);
+  const __m256i vq31prod3x01234567 = _mm256_blend_epi32(
+      _mm256_srli_epi64(vprod3x0246, 31), _mm256_add_epi64(vprod3x1357, vprod3x1357), 0xAA);
+
+  const __m256i vremainder_mask = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.remainder_mask));
+
+  const __m256i vrem0x01234567 =
+    _mm256_add_epi32(_mm256_and_si256(vq31prod0x01234567, vremainder_mask), _mm256_cmpgt_epi32(_mm256_setzero_si256(), vq31prod0x01234567));
+  const __m256i vrem1x01234567 =
+    _mm256_add_epi32(_mm256_and_si256(vq31prod1x01234567, vremainder_mask), _mm256_cmpgt_epi32(_mm256_setzero_si256(), vq31prod1x01234567));
+  const __m256i vrem2x01234567 =
+    _mm256_add_epi32(_mm256_and_si256(vq31prod2x01234567, vremainder_mask), _mm256_cmpgt_epi32(_mm256_setzero_si256(), vq31prod2x01234567));
+  const __m256i vrem3x01234567 =
+    _mm256_add_epi32(_mm256_and_si256(vq31prod3x01234567, vremainder_mask), _mm256_cmpgt_epi32(_mm256_setzero_si256(), vq31prod3x01234567));
+
+  const __m256i vremainder_threshold = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.remainder_threshold));
+  const __m128i vshift = _mm_load_si128((const __m128i*) requantization_params->sse2.shift);
+
+  vacc0x01234567 =
+    _mm256_sub_epi32(_mm256_sra_epi32(vq31prod0x01234567, vshift), _mm256_cmpgt_epi32(vrem0x01234567, vremainder_threshold));
+  vacc1x01234567 =
+    _mm256_sub_epi32(_mm256_sra_epi32(vq31prod1x01234567, vshift), _mm256_cmpgt_epi32(vrem1x01234567, vremainder_threshold));
+  vacc2x01234567 =
+    _mm256_sub_epi32(_mm256_sra_epi32(vq31prod2x01234567, vshift), _mm256_cmpgt_epi32(vrem2x01234567, vremainder_threshold));
+  vacc3x01234567 =
+    _mm256_sub_epi32(_mm256_sra_epi32(vq31prod3x01234567, vshift), _mm256_cmpgt_epi32(vrem3x01234567, vremainder_threshold));
+
+  const __m256i vzero_point = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.zero_point));
+  /* Packing works within 128-bit lanes: rows 0-3 of columns 0-3 end up in the low lane, columns 4-7 in the high lane */
+  const __m256i vacc01x01234567 = _mm256_adds_epi16(_mm256_packs_epi32(vacc0x01234567, vacc1x01234567), vzero_point);
+  const __m256i vacc23x01234567 = _mm256_adds_epi16(_mm256_packs_epi32(vacc2x01234567, vacc3x01234567), vzero_point);
+  __m256i vout = _mm256_permutevar8x32_epi32(
+      _mm256_packus_epi16(vacc01x01234567, vacc23x01234567),
+      _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+  vout = _mm256_max_epu8(vout, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.min)));
+  vout = _mm256_min_epu8(vout, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*) requantization_params->sse2.max)));
+
+  __m128i vout01 = _mm256_castsi256_si128(vout);
+  __m128i vout23 = _mm256_extracti128_si256(vout, 1);
+
+  uint8_t* c0 = c;
+  uint8_t* c1 = (uint8_t*) ((uintptr_t) c0 + c_stride);
+  if (mr < 2) {
+    c1 = c0;
+  }
+  uint8_t* c2 = (uint8_t*) ((uintptr_t) c1 + c_stride);
+  if (mr <= 2) {
+    c2 = c1;
+  }
+  uint8_t* c3 = (uint8_t*) ((uintptr_t) c2 + c_stride);
+  if (mr != 4) {
+    c3 = c2;
+  }
+  if (nr == 8) {
+    _mm_storel_epi64((__m128i*) c0, vout01);
+    _mm_storel_epi64((__m128i*) c1, _mm_unpackhi_epi64(vout01, vout01));
+    _mm_storel_epi64((__m128i*) c2, vout23);
+    _mm_storel_epi64((__m128i*) c3, _mm_unpackhi_epi64(vout23, vout23));
+  } else {
+    if (nr >= 4) {
+      *((uint32_t*) c0) = (uint32_t) _mm_cvtsi128_si32(vout01);
+      c0 += 4;
+      *((uint32_t*) c1) = (uint32_t) _mm_extract_epi32(vout01, 2);
+      c1 += 4;
+      *((uint32_t*) c2) = (uint32_t) _mm_cvtsi128_si32(vout23);
+      c2 += 4;
+      *((uint32_t*) c3) = (uint32_t) _mm_extract_epi32(vout23, 2);
+      c3 += 4;
+      vout01 = _mm_srli_epi64(vout01, 32);
+      vout23 = _mm_srli_epi64(vout23, 32);
+      nr -= 4;
+    }
+    if (nr >= 2) {
+      *((uint16_t*) c0) = (uint16_t) _mm_extract_epi16(vout01, 0);
+      c0 += 2;
+      *((uint16_t*) c1) = (uint16_t) _mm_extract_epi16(vout01, 4);
+      c1 += 2;
+      *((uint16_t*) c2) = (uint16_t) _mm_extract_epi16(vout23, 0);
+      c2 += 2;
+      *((uint16_t*) c3) = (uint16_t) _mm_extract_epi16(vout23, 4);
+      c3 += 2;
+      vout01 = _mm_srli_epi64(vout01, 16);
+      vout23 = _mm_srli_epi64(vout23, 16);
+      nr -= 2;
+    }
+    if (nr != 0) {
+      *((uint8_t*) c0) = (uint8_t) _mm_extract_epi8(vout01, 0);
+      *((uint8_t*) c1) = (uint8_t) _mm_extract_epi8(vout01, 8);
+      *((uint8_t*) c2) = (uint8_t) _mm_extract_epi8(vout23, 0);
+      *((uint8_t*) c3) = (uint8_t) _mm_extract_epi8(vout23, 8);
+    }
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8vadd.h>
+
+
+void q8vadd_ukernel__neon(
+    size_t n,
+    const uint8_t* a,
+    const uint8_t* b,
+    uint8_t* y,
+    const union qnnp_add_quantization_params quantization_params[restrict static 1])
+{
+  const uint8x8_t va_zero_point = vld1_dup_u8(&quantization_params->neon.a_zero_point);
+  const uint8x8_t vb_zero_point = vld1_dup_u8(&quantization_params->neon.b_zero_point);
+  const int16x8_t vy_zero_point = vld1q_dup_s16(&quantization_params->neon.y_zero_point);
+  const int32x4_t va_multiplier = vld1q_dup_s32(&quantization_params->neon.a_multiplier);
+  const int32x4_t vb_multiplier = vld1q_dup_s32(&quantization_params->neon.b_multiplier);
+  const int32x4_t vright_shift = vld1q_dup_s32(&quantization_params->neon.right_shift);
+  const uint8x8_t vy_max = vld1_dup_u8(&quantization_params->neon.y_max);
+  const uint8x8_t vy_min = vld1_dup_u8(&quantization_params->neon.y_min);
+
+  uint8_t block[8];
+  while (n != 0) {
+    uint8x8_t va, vb;
+    if QNNP_LIKELY(n >= 8) {
+      va = vld1_u8(a);
+      a += 8;
+      vb = vld1_u8(b);
+      b += 8;
+    } else {
+      /* Inputs and output may alias, so the remainder goes through a local buffer rather than overreading */
+      memcpy(block, a, n);
+      va = vld1_u8(block);
+      memcpy(block, b, n);
+      vb = vld1_u8(block);
+    }
+
+    /* Subtract zero points and multiply by factors */
+    const int16x8_t vxa = vreinterpretq_s16_u16(vsubl_u8(va, va_zero_point));
+    const int16x8_t vxb = vreinterpretq_s16_u16(vsubl_u8(vb, vb_zero_point));
+    int32x4_t vacc_lo = vmulq_s32(vmovl_s16(vget_low_s16(vxa)), va_multiplier);
+    int32x4_t vacc_hi = vmulq_s32(vmovl_s16(vget_high_s16(vxa)), va_multiplier);
+    vacc_lo = vmlaq_s32(vacc_lo, vmovl_s16(vget_low_s16(vxb)), vb_multiplier);
+    vacc_hi = vmlaq_s32(vacc_hi, vmovl_s16(vget_high_s16(vxb)), vb_multiplier);
+
+    /* Shift right and round half away from zero: the shift is never zero, so negative values can be decremented */
+    vacc_lo = vsraq_n_s32(vacc_lo, vacc_lo, 31);
+    vacc_hi = vsraq_n_s32(vacc_hi, vacc_hi, 31);
+    vacc_lo = vrshlq_s32(vacc_lo, vright_shift);
+    vacc_hi = vrshlq_s32(vacc_hi, vright_shift);
+
+    /* Pack, saturate, add output zero point, and clamp */
+    const int16x8_t vacc = vqaddq_s16(vcombine_s16(vqmovn_s32(vacc_lo), vqmovn_s32(vacc_hi)), vy_zero_point);
+    uint8x8_t vy = vqmovun_s16(vacc);
+    vy = vmax_u8(vy, vy_min);
+    vy = vmin_u8(vy, vy_max);
+
+    if QNNP_LIKELY(n >= 8) {
+      vst1_u8(y, vy);
+      y += 8;
+      n -= 8;
+    } else {
+      vst1_u8(block, vy);
+      memcpy(y, block, n);
+      n = 0;
+    }
+  }
+}
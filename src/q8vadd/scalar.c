@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/q8vadd.h>
+#include <qnnpack/requantization.h>
+
+
+void q8vadd_ukernel__scalar(
+    size_t n,
+    const uint8_t* a,
+    const uint8_t* b,
+    uint8_t* y,
+    const union qnnp_add_quantization_params quantization_params[restrict static 1])
+{
+  assert(n != 0);
+
+  /* Inputs and output may alias, so every element is read before it is written */
+  const union qnnp_add_quantization_params params = *quantization_params;
+  do {
+    const uint8_t va = *a++;
+    const uint8_t vb = *b++;
+    *y++ = qnnp_add_quantize(va, vb, params);
+  } while (--n != 0);
+}
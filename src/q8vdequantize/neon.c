@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8vdequantize.h>
+
+
+void q8vdequantize_ukernel__neon(
+    size_t n,
+    const uint8_t* x,
+    float* y,
+    const union qnnp_f32_dequantization_params dequantization_params[restrict static 1])
+{
+  const uint8x8_t vzero_point = vld1_dup_u8(&dequantization_params->neon.zero_point);
+  const float32x4_t vscale = vld1q_dup_f32(&dequantization_params->neon.scale);
+
+  uint8_t x_block[8];
+  float y_block[8];
+  while (n != 0) {
+    uint8x8_t vx;
+    if QNNP_LIKELY(n >= 8) {
+      vx = vld1_u8(x);
+      x += 8;
+    } else {
+      /* The remainder goes through local buffers rather than reading and writing past the row */
+      memcpy(x_block, x, n);
+      vx = vld1_u8(x_block);
+    }
+
+    /* Subtract zero point, widen, and scale */
+    const int16x8_t vxx = vreinterpretq_s16_u16(vsubl_u8(vx, vzero_point));
+    const float32x4_t vy_lo = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(vxx))), vscale);
+    const float32x4_t vy_hi = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(vxx))), vscale);
+
+    if QNNP_LIKELY(n >= 8) {
+      vst1q_f32(y, vy_lo);
+      vst1q_f32(y + 4, vy_hi);
+      y += 8;
+      n -= 8;
+    } else {
+      vst1q_f32(y_block, vy_lo);
+      vst1q_f32(y_block + 4, vy_hi);
+      memcpy(y, y_block, n * sizeof(float));
+      n = 0;
+    }
+  }
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/q8vdequantize.h>
+
+
+void q8vdequantize_ukernel__scalar(
+    size_t n,
+    const uint8_t* x,
+    float* y,
+    const union qnnp_f32_dequantization_params dequantization_params[restrict static 1])
+{
+  assert(n != 0);
+
+  const int32_t vzero_point = dequantization_params->scalar.zero_point;
+  const float vscale = dequantization_params->scalar.scale;
+  do {
+    const int32_t vx = (int32_t) (uint32_t) *x++ - vzero_point;
+    *y++ = (float) vx * vscale;
+  } while (--n != 0);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/q8vdequantize.h>
+
+
+static inline void q8vdequantize_8x__sse2(
+    __m128i vx,
+    float y[restrict static 8],
+    const union qnnp_f32_dequantization_params dequantization_params[restrict static 1])
+{
+  /* Subtract zero point in 16 bits, and sign-extend to 32 bits by shifting the duplicated halves */
+  const __m128i vzero_point = _mm_load_si128((const __m128i*) dequantization_params->sse2.zero_point);
+  const __m128i vxx = _mm_sub_epi16(_mm_unpacklo_epi8(vx, _mm_setzero_si128()), vzero_point);
+  const __m128i vxx_lo = _mm_srai_epi32(_mm_unpacklo_epi16(vxx, vxx), 16);
+  const __m128i vxx_hi = _mm_srai_epi32(_mm_unpackhi_epi16(vxx, vxx), 16);
+
+  const __m128 vscale = _mm_load_ps(dequantization_params->sse2.scale);
+  _mm_storeu_ps(y, _mm_mul_ps(_mm_cvtepi32_ps(vxx_lo), vscale));
+  _mm_storeu_ps(y + 4, _mm_mul_ps(_mm_cvtepi32_ps(vxx_hi), vscale));
+}
+
+void q8vdequantize_ukernel__sse2(
+    size_t n,
+    const uint8_t* x,
+    float* y,
+    const union qnnp_f32_dequantization_params dequantization_params[restrict static 1])
+{
+  for (; n >= 8; n -= 8) {
+    const __m128i vx = _mm_loadl_epi64((const __m128i*) x);
+    x += 8;
+
+    q8vdequantize_8x__sse2(vx, y, dequantization_params);
+    y += 8;
+  }
+  if (n != 0) {
+    /* The remainder goes through local buffers rather than reading and writing past the row */
+    uint8_t x_block[8];
+    memcpy(x_block, x, n);
+    const __m128i vx = _mm_loadl_epi64((const __m128i*) x_block);
+
+    float y_block[8];
+    q8vdequantize_8x__sse2(vx, y_block, dequantization_params);
+    memcpy(y, y_block, n * sizeof(float));
+  }
+}
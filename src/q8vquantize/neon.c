@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include <arm_neon.h>
+
+#include <qnnpack/q8vquantize.h>
+
+
+void q8vquantize_ukernel__neon(
+    size_t n,
+    const float* x,
+    uint8_t* y,
+    const union qnnp_f32_quantization_params quantization_params[restrict static 1])
+{
+  const float32x4_t vscale = vld1q_dup_f32(&quantization_params->neon.scale);
+  const float32x4_t vmin_less_zero_point = vld1q_dup_f32(&quantization_params->neon.min_less_zero_point);
+  const float32x4_t vmax_less_zero_point = vld1q_dup_f32(&quantization_params->neon.max_less_zero_point);
+  const float32x4_t vmagic = vld1q_dup_f32(&quantization_params->neon.magic);
+  const int32x4_t vmagic_less_zero_point = vld1q_dup_s32(&quantization_params->neon.magic_less_zero_point);
+
+  float x_block[8];
+  uint8_t y_block[8];
+  while (n != 0) {
+    float32x4_t vx_lo, vx_hi;
+    if QNNP_LIKELY(n >= 8) {
+      vx_lo = vld1q_f32(x);
+      vx_hi = vld1q_f32(x + 4);
+      x += 8;
+    } else {
+      /* The remainder goes through local buffers rather than reading and writing past the row */
+      memcpy(x_block, x, n * sizeof(float));
+      vx_lo = vld1q_f32(x_block);
+      vx_hi = vld1q_f32(x_block + 4);
+    }
+
+    /* Scale and clamp in floating point, so that out-of-range inputs never reach the integer conversion */
+    vx_lo = vminq_f32(vmaxq_f32(vmulq_f32(vx_lo, vscale), vmin_less_zero_point), vmax_less_zero_point);
+    vx_hi = vminq_f32(vmaxq_f32(vmulq_f32(vx_hi, vscale), vmin_less_zero_point), vmax_less_zero_point);
+
+    /* Round to nearest-even with the magic number, whose integer bits less the zero point are the output */
+    const int32x4_t vy_lo = vsubq_s32(vreinterpretq_s32_f32(vaddq_f32(vx_lo, vmagic)), vmagic_less_zero_point);
+    const int32x4_t vy_hi = vsubq_s32(vreinterpretq_s32_f32(vaddq_f32(vx_hi, vmagic)), vmagic_less_zero_point);
+
+    /* Outputs are already in [output_min, output_max], so narrowing does not saturate */
+    const uint8x8_t vy = vqmovun_s16(vcombine_s16(vqmovn_s32(vy_lo), vqmovn_s32(vy_hi)));
+
+    if QNNP_LIKELY(n >= 8) {
+      vst1_u8(y, vy);
+      y += 8;
+      n -= 8;
+    } else {
+      vst1_u8(y_block, vy);
+      memcpy(y, y_block, n);
+      n = 0;
+    }
+  }
+}
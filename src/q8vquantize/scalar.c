@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <fp16/bitcasts.h>
+
+#include <qnnpack/q8vquantize.h>
+
+
+void q8vquantize_ukernel__scalar(
+    size_t n,
+    const float* x,
+    uint8_t* y,
+    const union qnnp_f32_quantization_params quantization_params[restrict static 1])
+{
+  assert(n != 0);
+
+  const float vscale = quantization_params->scalar.scale;
+  const float vmin_less_zero_point = quantization_params->scalar.min_less_zero_point;
+  const float vmax_less_zero_point = quantization_params->scalar.max_less_zero_point;
+  const float vmagic = quantization_params->scalar.magic;
+  const int32_t vmagic_less_zero_point = quantization_params->scalar.magic_less_zero_point;
+  do {
+    /* Clamped in the order of the SIMD microkernels, which map NaN to the minimum */
+    float vx = *x++ * vscale;
+    vx = vx > vmin_less_zero_point ? vx : vmin_less_zero_point;
+    vx = vx < vmax_less_zero_point ? vx : vmax_less_zero_point;
+
+    *y++ = (uint8_t) ((int32_t) fp32_to_bits(vx + vmagic) - vmagic_less_zero_point);
+  } while (--n != 0);
+}
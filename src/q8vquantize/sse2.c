@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/q8vquantize.h>
+
+
+static inline __m128i q8vquantize_8x__sse2(
+    __m128 vx_lo,
+    __m128 vx_hi,
+    const union qnnp_f32_quantization_params quantization_params[restrict static 1])
+{
+  const __m128 vscale = _mm_load_ps(quantization_params->sse2.scale);
+  const __m128 vmin_less_zero_point = _mm_load_ps(quantization_params->sse2.min_less_zero_point);
+  const __m128 vmax_less_zero_point = _mm_load_ps(quantization_params->sse2.max_less_zero_point);
+  const __m128 vmagic = _mm_load_ps(quantization_params->sse2.magic);
+  const __m128i vmagic_less_zero_point =
+    _mm_load_si128((const __m128i*) quantization_params->sse2.magic_less_zero_point);
+
+  /* Scale and clamp in floating point, so that out-of-range inputs never reach the integer conversion */
+  vx_lo = _mm_min_ps(_mm_max_ps(_mm_mul_ps(vx_lo, vscale), vmin_less_zero_point), vmax_less_zero_point);
+  vx_hi = _mm_min_ps(_mm_max_ps(_mm_mul_ps(vx_hi, vscale), vmin_less_zero_point), vmax_less_zero_point);
+
+  /* Round to nearest-even with the magic number, whose integer bits less the zero point are the output */
+  const __m128i vy_lo = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(vx_lo, vmagic)), vmagic_less_zero_point);
+  const __m128i vy_hi = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(vx_hi, vmagic)), vmagic_less_zero_point);
+
+  /* Outputs are already in [output_min, output_max], so packing does not saturate */
+  const __m128i vy = _mm_packs_epi32(vy_lo, vy_hi);
+  return _mm_packus_epi16(vy, vy);
+}
+
+void q8vquantize_ukernel__sse2(
+    size_t n,
+    const float* x,
+    uint8_t* y,
+    const union qnnp_f32_quantization_params quantization_params[restrict static 1])
+{
+  for (; n >= 8; n -= 8) {
+    const __m128 vx_lo = _mm_loadu_ps(x);
+    const __m128 vx_hi = _mm_loadu_ps(x + 4);
+    x += 8;
+
+    _mm_storel_epi64((__m128i*) y, q8vquantize_8x__sse2(vx_lo, vx_hi, quantization_params));
+    y += 8;
+  }
+  if (n != 0) {
+    /* The remainder goes through local buffers rather than reading and writing past the row */
+    float x_block[8];
+    memcpy(x_block, x, n * sizeof(float));
+    const __m128 vx_lo = _mm_loadu_ps(x_block);
+    const __m128 vx_hi = _mm_loadu_ps(x_block + 4);
+
+    uint8_t y_block[8];
+    _mm_storel_epi64((__m128i*) y_block, q8vquantize_8x__sse2(vx_lo, vx_hi, quantization_params));
+    memcpy(y, y_block, n);
+  }
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/q8vrescale.h>
+#include <qnnpack/requantization.h>
+
+
+void q8vrescale_ukernel__scalar(
+    size_t n,
+    const uint8_t* x,
+    uint8_t* y,
+    const union qnnp_add_quantization_params quantization_params[restrict static 1])
+{
+  assert(n != 0);
+
+  /* Only the A fields apply, so the second operand of the add reference is zero */
+  const union qnnp_add_quantization_params params = *quantization_params;
+  do {
+    const uint8_t vx = *x++;
+    *y++ = qnnp_add_quantize(vx, 0, params);
+  } while (--n != 0);
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <qnnpack.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Between a begin and its end call, threads of the pool poll for the next loop for a short time instead of sleeping,
+ * and callers of a loop poll for its end, which saves the wake-up latency of consecutive loops. Calls may nest.
+ */
+void qnnp_affinity_pool_begin_spin_wait(struct qnnp_affinity_pool* pool);
+void qnnp_affinity_pool_end_spin_wait(struct qnnp_affinity_pool* pool);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
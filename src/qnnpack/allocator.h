@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#include <qnnpack.h>
+
+/* Alignment of packed weights and zero buffers, a cache line on all supported processors */
+#define QNNP_WEIGHTS_ALIGNMENT 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Allocator set by qnnp_initialize_with_options, or the default one */
+extern struct qnnp_allocator qnnp_allocator;
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+static inline void* qnnp_allocate(size_t size) {
+  return qnnp_allocator.allocate(qnnp_allocator.context, size);
+}
+
+static inline void* qnnp_reallocate(void* pointer, size_t size) {
+  return qnnp_allocator.reallocate(qnnp_allocator.context, pointer, size);
+}
+
+static inline void qnnp_deallocate(void* pointer) {
+  if (pointer != NULL) {
+    qnnp_allocator.deallocate(qnnp_allocator.context, pointer);
+  }
+}
+
+static inline void* qnnp_allocate_weights(size_t size) {
+  return qnnp_allocator.aligned_allocate(qnnp_allocator.context, QNNP_WEIGHTS_ALIGNMENT, size);
+}
+
+static inline void* qnnp_allocate_zero_weights(size_t size) {
+  void* pointer = qnnp_allocate_weights(size);
+  if (pointer != NULL) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+static inline void qnnp_deallocate_weights(void* pointer) {
+  if (pointer != NULL) {
+    qnnp_allocator.aligned_deallocate(qnnp_allocator.context, pointer);
+  }
+}
@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#include <qnnpack.h>
+#include <qnnpack/params.h>
 #include <qnnpack/requantization.h>
 
 
@@ -24,6 +27,244 @@ enum qnnp_format {
 #define QNNP_CONVOLUTION_FLAG_DW       0x02
 #define QNNP_CONVOLUTION_FLAG_XZP_GEMM 0x04
 #define QNNP_CONVOLUTION_FLAG_ZERO     0x10
+/* Requantization scale per output channel, packed after each block of nr biases */
+#define QNNP_CONVOLUTION_FLAG_PER_CHANNEL 0x20
+/*
+ * Kernel with zero point 128 packed as int8 values kernel - 128, with -input_zero_point * sum(kernel - 128) folded
+ * into the bias, for the signed_gemm and signed_conv microkernels
+ */
+#define QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL 0x40
+/*
+ * Strided deconvolution computed as one dense convolution per stride phase of the output. Within each nr-block of the
+ * packed kernel, the taps of every phase are packed together, see pack_q8deconv_b_nr_block_subpixel.
+ */
+#define QNNP_CONVOLUTION_FLAG_SUBPIXEL 0x80
+/* GEMM and convolution microkernels with FP32 requantization, see QNNP_CREATE_FLAG_FP32_REQUANTIZATION */
+#define QNNP_CONVOLUTION_FLAG_FP32_REQUANTIZATION 0x100
+/*
+ * Dense 3x3 convolution with unit stride and dilation computed as Winograd F(2x2, 3x3): every 2x2 block of output
+ * pixels is the output transform of the sum over input channels of the products of the 4x4 transformed input and
+ * kernel tiles. The kernel is packed transformed, see pack_q8winograd_w.
+ */
+#define QNNP_CONVOLUTION_FLAG_WINOGRAD 0x200
+/*
+ * NCHW input, see QNNP_CREATE_FLAG_INPUT_NCHW. The convolution microkernels read one channel through each input
+ * pointer, and each channel of a kernel position is a tap, in the order of the channels in the kernel.
+ */
+#define QNNP_CONVOLUTION_FLAG_NCHW 0x400
+/*
+ * Convolution with few input channels, e.g. the first layer of a network on RGB images. qnnp_run_operator copies the
+ * input rows with their left and right padding into the scratch buffer, so that every kernel row reads
+ * kernel_width * group_input_channels adjacent bytes, and each kernel row is a tap of the convolution microkernels.
+ */
+#define QNNP_CONVOLUTION_FLAG_STEM 0x800
+/*
+ * GEMM microkernel with 16-bit accumulators, see q8conv_parameters::acc16_gemm: for every output channel, the sum of
+ * |kernel - kernel_zero_point| over its row times the largest |input - input_zero_point| fits into int16_t, so no dot
+ * product can overflow them.
+ */
+#define QNNP_CONVOLUTION_FLAG_ACC16 0x1000
+/*
+ * Groups with fewer output channels than the tile of the microkernels, with the channels of several adjacent groups
+ * packed as one group with a block-diagonal kernel: output channels of each group read only the input channels of
+ * their group, and the other input channels of the merged group are padded with the kernel zero point. groups,
+ * group_input_channels, and group_output_channels of the operator and packed weights are those of the merged groups.
+ */
+#define QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS 0x2000
+/*
+ * 1x1 convolution or fully-connected operator of a single group with a block-sparse kernel, see
+ * QNNP_CREATE_FLAG_SPARSE_KERNEL: every output channel keeps the blocks of QNNP_SPARSE_BLOCK_SIZE adjacent input
+ * channels that have a value other than the kernel zero point, see pack_q8gemm_sparse_w, for the sparse microkernel
+ * of qnnp_params.q8gemm_sparse. The operator still has QNNP_CONVOLUTION_FLAG_GEMM.
+ */
+#define QNNP_CONVOLUTION_FLAG_SPARSE 0x4000
+/*
+ * Fully-connected operator with a kernel of 4-bit values, see QNNP_CREATE_FLAG_4BIT_KERNEL: the kernel is packed with
+ * two values per byte, see pack_q8gemm_4bit_b, for the microkernels of qnnp_params.q8conv_4bit. The operator still has
+ * QNNP_CONVOLUTION_FLAG_GEMM.
+ */
+#define QNNP_CONVOLUTION_FLAG_4BIT 0x8000
+/*
+ * Kernel packed as usual with -input_zero_point * sum(kernel - kernel_zero_point) folded into the bias, see
+ * QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT and fold_q8conv_input_zero_point, for the folded_gemm and folded_conv
+ * microkernels, which only subtract the kernel zero point. As with QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL, padded taps
+ * must be read through the zero buffer rather than skipped.
+ */
+#define QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT 0x10000
+/*
+ * Convolution path with the XZP scheme of QNNP_CONVOLUTION_FLAG_XZP_GEMM extended to any number of taps: the kernel
+ * is packed as usual but with zero padding and ks * kc * input_zero_point * kernel_zero_point - input_zero_point *
+ * sum(kernel) folded into the bias, and tiles sum their input rows over all taps with the conv_sum_rows microkernel
+ * for the xzp_conv microkernels, which multiply inputs and kernel without zero points. Padded taps must be read
+ * through the zero buffer rather than skipped.
+ */
+#define QNNP_CONVOLUTION_FLAG_XZP_CONV 0x20000
+/*
+ * Fully-connected operator that stores output channel c of batch row i at output[c * output_stride + i], see
+ * QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT. Microkernels store their tiles into a buffer of at most
+ * QNNP_TRANSPOSED_OUTPUT_MAX_TILE_SIZE outputs, which is then transposed into the output.
+ */
+#define QNNP_CONVOLUTION_FLAG_TRANSPOSED_OUTPUT 0x40000
+#define QNNP_TRANSPOSED_OUTPUT_MAX_TILE_SIZE 64
+
+/* Input channels of every block of a kernel packed with QNNP_CONVOLUTION_FLAG_SPARSE */
+#define QNNP_SPARSE_BLOCK_SIZE 4
+
+/*
+ * Input channels per group of a convolution that uses Winograd. Transforms only pay off with enough channels to reuse
+ * them, and beyond the maximum the sums of the products of the transformed tiles may overflow 32 bits.
+ */
+#define QNNP_WINOGRAD_MIN_CHANNELS 64
+#define QNNP_WINOGRAD_MAX_CHANNELS 512
+/* 2x2 output tiles and output channels of a block of the products of the transformed tiles */
+#define QNNP_WINOGRAD_MR 4
+#define QNNP_WINOGRAD_NR 16
+
+/* Input channels per group of convolutions that use QNNP_CONVOLUTION_FLAG_STEM */
+#define QNNP_STEM_MAX_CHANNELS 4
+
+enum qnnp_operator_type {
+  qnnp_operator_type_none = 0,
+  qnnp_operator_type_convolution,
+  qnnp_operator_type_deconvolution,
+  qnnp_operator_type_fully_connected,
+  qnnp_operator_type_add,
+  qnnp_operator_type_global_average_pooling,
+  qnnp_operator_type_max_pooling,
+  qnnp_operator_type_average_pooling,
+  qnnp_operator_type_channel_shuffle,
+  qnnp_operator_type_concat,
+  qnnp_operator_type_inverted_residual,
+  qnnp_operator_type_depthwise_separable,
+  qnnp_operator_type_lstm_cell,
+  qnnp_operator_type_quantize,
+  qnnp_operator_type_dequantize,
+  qnnp_operator_type_requantize,
+  qnnp_operator_type_softmax,
+  qnnp_operator_type_argmax,
+  qnnp_operator_type_resize_bilinear,
+  qnnp_operator_type_resize_nearest,
+  qnnp_operator_type_embedding_bag,
+};
+
+/* Outputs of a fully-connected operator set up with qnnp_setup_fully_connected_nc_q8_s32 or _f32 */
+enum qnnp_accumulator_output {
+  /* Requantized uint8 outputs */
+  qnnp_accumulator_output_none = 0,
+  /* 32-bit accumulators with bias */
+  qnnp_accumulator_output_int32,
+  /* 32-bit accumulators with bias, times accumulator_scale */
+  qnnp_accumulator_output_float32,
+};
+
+/* Output channels of the single-row GEMM microkernels that qnnp_accumulator_output operators run on */
+#define QNNP_ACCUMULATOR_OUTPUT_MAX_NR 16
+
+/* One input of a concat operator and the slice of every output pixel it fills */
+struct qnnp_concat_input {
+  union qnnp_add_quantization_params quantization_params;
+  const uint8_t* input;
+  size_t input_stride;
+  size_t channels;
+  size_t channel_offset;
+  /* Input and output quantization match and the output is not clamped, so channels are copied as is */
+  bool copy;
+};
+
+/*
+ * Fused expansion, depthwise, and projection convolutions of an inverted residual operator. Output rows are split into
+ * bands, and every band has a buffer with the last ring_rows expanded input rows, at offset QNNP_BAND_PADDING,
+ * depthwise_rows depthwise output rows for the next projection GEMM, and the indirection of one depthwise output row
+ * into the expanded rows. Depthwise separable operators have no expansion and no ring, and their indirection points
+ * into the input.
+ */
+struct qnnp_inverted_residual {
+  /* Operators the kernels and quantization come from, which the fused operator does not own */
+  struct qnnp_operator* expansion;
+  struct qnnp_operator* depthwise;
+  struct qnnp_operator* projection;
+  size_t ring_rows;
+  size_t depthwise_rows;
+  size_t bands;
+  void* band_buffers;
+  size_t band_buffer_stride;
+  size_t depthwise_output_offset;
+  size_t indirection_offset;
+};
+
+/*
+ * Quantized LSTM cell. One GEMM computes the gate pre-activations of all hidden units from the input and the previous
+ * hidden state, which qnnp_run_operator copies side by side into concat_buffer. The gates of a hidden unit are four
+ * adjacent output channels of the GEMM, in the order input, forget, cell, output, so every tile of the microkernels
+ * updates the cell state and hidden output of whole hidden units while their gates are still in cache.
+ */
+struct qnnp_lstm_cell {
+  /* Fully-connected operator with the interleaved gate weights, owned by the LSTM cell */
+  struct qnnp_operator* gates;
+  size_t hidden_channels;
+  const uint8_t* hidden_input;
+  size_t hidden_input_stride;
+  int16_t* cell_state;
+  uint8_t* concat_buffer;
+  uint8_t* gate_buffer;
+  /* The cell state is in units of 2**-cell_shift */
+  uint32_t cell_shift;
+  /* Requantization of the Q30 products of the output gate and the tanh of the cell state to the hidden output */
+  union qnnp_q31_requantization_params hidden_requantization_params;
+  /* Q15 sigmoid and tanh of the gate pre-activations, and tanh at steps of 1/16 in [-8, 8] for the cell state */
+  int16_t sigmoid_table[256];
+  int16_t tanh_table[256];
+  int16_t cell_tanh_table[257];
+};
+
+/* Table of an embedding-bag operator, and the bags of its last setup */
+struct qnnp_embedding_bag {
+  const uint8_t* weights;
+  const float* scales;
+  const float* biases;
+  size_t num_embeddings;
+  const uint32_t* indices;
+  const uint32_t* offsets;
+  const float* per_sample_weights;
+  /* Rows are prefetched when the table does not fit in the L2 cache */
+  bool prefetch;
+};
+
+/*
+ * Indices ahead of the row being added whose rows embedding-bag operators prefetch, which covers the latency of
+ * memory with a few rows of additions in flight
+ */
+#define QNNP_EMBEDDING_BAG_PREFETCH_DISTANCE 8
+/* Bytes between the prefetches of a row, a cache line on all supported processors */
+#define QNNP_EMBEDDING_BAG_PREFETCH_STRIDE 64
+
+/* Quantization of the gate pre-activations of LSTM cells, which covers [-8, 8) where sigmoid and tanh saturate */
+#define QNNP_LSTM_GATE_SCALE 0.0625f
+#define QNNP_LSTM_GATE_ZERO_POINT 128
+
+/*
+ * Internal create flag of the alternative of a convolution created with QNNP_CREATE_FLAG_CALIBRATE_XZP: the 1x1
+ * convolution takes the GEMM path the input channels would not select.
+ */
+#define QNNP_CREATE_FLAG_XZP_ALTERNATIVE 0x80000000
+
+/* Runs of each path before a convolution created with QNNP_CREATE_FLAG_CALIBRATE_XZP keeps the faster one */
+#define QNNP_XZP_CALIBRATION_RUNS 4
+
+/* Calibration of a 1x1 convolution between the XZP and generic GEMM microkernels, see run_xzp_calibration */
+struct qnnp_xzp_calibration {
+  /* The same convolution on the other path, with its own packed weights */
+  struct qnnp_operator* alternative;
+  /* Runs of the operator itself and of the alternative, and the fastest of each in picoseconds per output pixel */
+  uint32_t runs[2];
+  uint64_t fastest_ps_per_pixel[2];
+};
+
+/* Bytes before and after the rows of a band buffer, which microkernels may read with 8-byte loads */
+#define QNNP_BAND_PADDING 16
+
+/* Depthwise output pixels that a band collects, in whole rows, before it runs the projection GEMM on them */
+#define QNNP_PROJECTION_PIXELS 64
 
 struct qnnp_operator {
   size_t batch_size;
@@ -42,14 +283,81 @@ struct qnnp_operator {
   uint32_t groups;
   size_t group_input_channels;
   size_t group_output_channels;
+  /* Channels of elementwise operators, which have no groups */
+  size_t channels;
 
   size_t input_height;
   size_t input_width;
   size_t input_pixel_stride;
+  /*
+   * Elements between input rows and images of convolutions, input_width * input_pixel_stride and input_height *
+   * input_row_stride unless the input is a window of a larger tensor, see qnnp_setup_convolution2d_nhwc_q8_with_strides
+   */
+  size_t input_row_stride;
+  size_t input_image_stride;
+  /*
+   * Crops of the last setup by qnnp_setup_convolution2d_nhwc_q8_rois, or 0. The operator then has one 1 x N image,
+   * where N is the number of output pixels of all crops, and an indirection buffer into the crops.
+   */
+  size_t roi_count;
   const void* input;
   const void** im2col_buffer;
+  void* expanded_input;
+  /* im2col_buffer and expanded_input point into caller-provided memory and are not freed by the operator */
+  bool external_workspace;
+  /*
+   * Input the indirection entries in im2col_buffer point into, or NULL if the buffer must be rebuilt on the next
+   * setup. Entries are for the batch_size, input_height, input_width, and input strides of the last setup.
+   */
+  const void* indirection_input;
+  /*
+   * Input the entries of an indirection buffer already in caller-provided workspace point into, which the next setup
+   * rebases instead of building the buffer, or NULL. Restored plans copy the buffer from their snapshot, see
+   * qnnp_create_plan_from_serialized.
+   */
+  const void* prebuilt_indirection_input;
+  /*
+   * im2col_buffer holds uint32_t pixel indices into one image of input, shared by all groups and images, instead of
+   * pointers. See qnnp_use_indirection_offsets.
+   */
+  bool indirection_offsets;
+  /* Tiles compute their input pointers while running and setup builds no indirection buffer */
+  bool tile_indirection;
+  /* Indirection buffers of earlier setups with other shapes, or NULL, see qnnp_set_operator_setup_cache */
+  struct qnnp_setup_cache* setup_cache;
   uint8_t input_zero_point;
-  void* a_sum;
+  /*
+   * Input channels per slice of K when setup splits the reduction of a fully-connected operator across threads, or 0.
+   * split_k_buffer holds the 32-bit partial sums of every slice, which qnnp_run_operator adds up and requantizes.
+   */
+  size_t split_k_slice;
+  int32_t* split_k_buffer;
+  /*
+   * Whether the last setup of a fully-connected operator asked for its accumulators instead of requantized outputs,
+   * and the input scale times kernel scale that dequantizes them
+   */
+  enum qnnp_accumulator_output accumulator_output;
+  float accumulator_scale;
+  /* Second input of binary elementwise operators */
+  const void* input2;
+  size_t input2_pixel_stride;
+  /* Inputs of concat operators */
+  struct qnnp_concat_input* concat_inputs;
+  size_t concat_inputs_count;
+  /* Fused operators and band buffers of inverted residual operators */
+  struct qnnp_inverted_residual* inverted_residual;
+  /* Other GEMM path of 1x1 convolutions that still calibrate it against their own, or NULL */
+  struct qnnp_xzp_calibration* xzp_calibration;
+  /* Gate GEMM, state, and lookup tables of LSTM cell operators */
+  struct qnnp_lstm_cell* lstm_cell;
+  /* Table and bags of embedding-bag operators */
+  struct qnnp_embedding_bag* embedding_bag;
+  /*
+   * Input columns and rows that resize operators sample, two per output column and then two per output row, and the
+   * Q11 weights of the second of each pair, for the input and output dimensions of the last setup
+   */
+  uint32_t* resize_indices;
+  int16_t* resize_weights;
 
   size_t output_height;
   size_t output_width;
@@ -58,15 +366,261 @@ struct qnnp_operator {
 
   void* packed_kernel;
   uint8_t kernel_zero_point;
+  /* GEMM and convolution microkernels the kernel was packed for */
+  struct q8conv_parameters q8conv;
+  /* Same for FP32 and FP16 operators */
+  struct sconv_parameters sconv;
+  struct hconv_parameters hconv;
 
   void* bias;
+  /* Reference-counted owner of packed_kernel and bias, possibly shared with other operators */
+  struct qnnp_packed_weights* packed_weights;
   void* zero;
 
   union qnnp_q31_requantization_params requantization_params;
+  union qnnp_add_quantization_params add_quantization_params;
+  /* Conversions of quantize and dequantize operators between float and quantized tensors */
+  union qnnp_f32_quantization_params f32_quantization_params;
+  union qnnp_f32_dequantization_params f32_dequantization_params;
+  /* Arguments requantization_params were computed from */
+  float requantization_scale;
+  uint8_t output_zero_point;
+  uint8_t output_min;
+  uint8_t output_max;
+  /* Output range of FP32 and FP16 operators */
+  struct qnnp_fp32_clamping_params fp32_clamping_params;
+  struct qnnp_fp16_clamping_params fp16_clamping_params;
+  /* 256-entry table applied to requantized outputs, or NULL, see qnnp_set_operator_lookup_table */
+  uint8_t* lookup_table;
+  /* 256 values of exp((i - 255) * input_scale) in fixed point for softmax operators, see qnnp_create_softmax_nc_q8 */
+  uint32_t* exp_lookup_table;
+  enum qnnp_operator_type type;
   enum qnnp_format format;
   uint32_t flags;
+  /* Statistics of the setup and run calls, allocated on first use when QNNPACK is built with QNNP_PROFILING */
+  struct qnnp_operator_stats* stats;
+  /* Scheduler of the parallel loops, or one with NULL parallelize to use the thread pool */
+  struct qnnp_scheduler scheduler;
 };
 
+static inline size_t compute_convolution_output_dimension(
+    size_t padded_input_dimension,
+    size_t kernel_dimension,
+    size_t dilation_dimension,
+    size_t subsampling_dimension)
+{
+  const size_t effective_kernel_dimension = (kernel_dimension - 1) * dilation_dimension + 1;
+  return (padded_input_dimension - effective_kernel_dimension) / subsampling_dimension + 1;
+}
+
+static inline size_t compute_deconvolution_output_dimension(
+    size_t input_dimension,
+    size_t input_padding_dimension,
+    size_t adjustment_dimension,
+    size_t kernel_dimension,
+    size_t dilation_dimension,
+    size_t stride_dimension)
+{
+  const size_t effective_kernel_dimension = (kernel_dimension - 1) * dilation_dimension + 1;
+  return stride_dimension * (input_dimension - 1) + adjustment_dimension + effective_kernel_dimension - input_padding_dimension;
+}
+
+/*
+ * Number of taps of a deconvolution kernel dimension that contribute to the output positions of a stride phase: the
+ * taps whose dilated offset is congruent to residue modulo the stride
+ */
+static inline size_t qnnp_subpixel_phase_taps(
+    size_t kernel_dimension,
+    size_t dilation_dimension,
+    size_t stride_dimension,
+    size_t residue)
+{
+  size_t taps = 0;
+  for (size_t k = 0; k < kernel_dimension; k++) {
+    taps += (k * dilation_dimension) % stride_dimension == residue;
+  }
+  return taps;
+}
+
+/*
+ * Largest mr x kernel_size block of input pointers that convolution microkernels get from an indirection buffer of
+ * offsets. The block is expanded on the stack of the thread that computes the tile.
+ */
+#define QNNP_MAX_INDIRECTION_TILE_SIZE 1024
+
+/* Number of output pixels in the tile of the GEMM and convolution microkernels of the operator */
+static inline uint32_t qnnp_operator_get_mr(const struct qnnp_operator* convolution) {
+  switch (convolution->format) {
+    case qnnp_format_float32:
+      return convolution->sconv.mr;
+    case qnnp_format_float16:
+      return convolution->hconv.mr;
+    default:
+      return convolution->q8conv.mr;
+  }
+}
+
+/* Input channels that the convolution microkernels read through each input pointer of a convolution */
+static inline size_t qnnp_convolution_get_tap_channels(const struct qnnp_operator* convolution) {
+  if (convolution->flags & QNNP_CONVOLUTION_FLAG_NCHW) {
+    return 1;
+  } else if (convolution->flags & QNNP_CONVOLUTION_FLAG_STEM) {
+    return (size_t) convolution->kernel_width * convolution->group_input_channels;
+  }
+  return convolution->group_input_channels;
+}
+
+/* Input pointers per output pixel of a convolution that uses the convolution microkernels */
+static inline size_t qnnp_convolution_get_taps(const struct qnnp_operator* convolution) {
+  const size_t kernel_size = (size_t) convolution->kernel_height * (size_t) convolution->kernel_width;
+  if (convolution->flags & QNNP_CONVOLUTION_FLAG_NCHW) {
+    return kernel_size * convolution->group_input_channels;
+  } else if (convolution->flags & QNNP_CONVOLUTION_FLAG_STEM) {
+    return convolution->kernel_height;
+  }
+  return kernel_size;
+}
+
+/* Alignment of every nr-block of output channels in the packed kernel of quantized GEMM and convolution weights */
+#define QNNP_PACKED_BLOCK_ALIGNMENT 64
+
+/*
+ * Bytes of packed kernel per output channel of quantized GEMM and convolution weights with taps taps of tap_channels
+ * input channels. Each nr-block is padded to a multiple of QNNP_PACKED_BLOCK_ALIGNMENT bytes, so that with an aligned
+ * packed kernel no block shares a cache line with its neighbors. nr must divide QNNP_PACKED_BLOCK_ALIGNMENT.
+ */
+static inline size_t qnnp_get_packed_channel_stride(size_t taps, size_t tap_channels, uint32_t nr, uint32_t kr) {
+  const size_t k_stride = (tap_channels + (kr - 1)) & -kr;
+  const size_t block_size = (size_t) nr * taps * k_stride;
+  return ((block_size + (QNNP_PACKED_BLOCK_ALIGNMENT - 1)) & -QNNP_PACKED_BLOCK_ALIGNMENT) / nr;
+}
+
+/*
+ * Bytes of packed kernel per output channel of GEMM weights with k input channels and QNNP_CONVOLUTION_FLAG_4BIT, with
+ * every nr-block padded as in qnnp_get_packed_channel_stride. kr must be even.
+ */
+static inline size_t qnnp_get_4bit_packed_channel_stride(size_t k, uint32_t nr, uint32_t kr) {
+  const size_t k_stride = (k + (kr - 1)) & -kr;
+  const size_t block_size = (size_t) nr * k_stride / 2;
+  return ((block_size + (QNNP_PACKED_BLOCK_ALIGNMENT - 1)) & -QNNP_PACKED_BLOCK_ALIGNMENT) / nr;
+}
+
+/*
+ * Bytes of a kernel packed with QNNP_CONVOLUTION_FLAG_SPARSE for n_stride output channels with blocks stored blocks,
+ * see pack_q8gemm_sparse_w
+ */
+static inline size_t qnnp_get_sparse_packed_kernel_size(size_t n_stride, size_t blocks) {
+  return sizeof(uint32_t) * (n_stride + 1 + blocks) + sizeof(uint8_t) * QNNP_SPARSE_BLOCK_SIZE * blocks;
+}
+
+/* Whether a convolution or deconvolution created with QNNP_CREATE_FLAG_TILE_INDIRECTION can compute pointers per tile */
+static inline bool qnnp_supports_tile_indirection(const struct qnnp_operator* convolution) {
+  const size_t kernel_size = (size_t) convolution->kernel_height * (size_t) convolution->kernel_width;
+  return convolution->format == qnnp_format_quint8 &&
+    !(convolution->flags & (QNNP_CONVOLUTION_FLAG_GEMM | QNNP_CONVOLUTION_FLAG_DW | QNNP_CONVOLUTION_FLAG_XZP_GEMM |
+      QNNP_CONVOLUTION_FLAG_WINOGRAD | QNNP_CONVOLUTION_FLAG_NCHW | QNNP_CONVOLUTION_FLAG_STEM)) &&
+    (size_t) convolution->q8conv.mr * kernel_size <= QNNP_MAX_INDIRECTION_TILE_SIZE;
+}
+
+/* Pixel index in an indirection buffer of offsets for taps that read the zero buffer */
+#define QNNP_INDIRECTION_OFFSET_ZERO UINT32_MAX
+
+/*
+ * Whether a quantized convolution or deconvolution that uses the q8conv microkernels stores its indirection buffer as 32-bit
+ * pixel indices, which take half the memory of pointers on 64-bit systems and are the same for every group and every
+ * image of the batch. Each tile then expands its mr x kernel_size input pointers on the fly from the start of its
+ * image, which requires the block to fit on the stack and every pixel index of an image to fit in 32 bits. Indices of
+ * NCHW inputs would also need the channel of each tap.
+ */
+static inline bool qnnp_use_indirection_offsets(
+    const struct qnnp_operator* convolution,
+    size_t input_height,
+    size_t input_width)
+{
+  const size_t kernel_size = (size_t) convolution->kernel_height * (size_t) convolution->kernel_width;
+  return convolution->format == qnnp_format_quint8 && !(convolution->flags & QNNP_CONVOLUTION_FLAG_NCHW) &&
+    (size_t) convolution->q8conv.mr * kernel_size <= QNNP_MAX_INDIRECTION_TILE_SIZE &&
+    input_height * input_width < QNNP_INDIRECTION_OFFSET_ZERO;
+}
+
+/*
+ * Moves the entries of an indirection buffer built for an input at old_input to the same pixels of an input at
+ * new_input. Entries that point to the zero buffer stay unchanged.
+ */
+static inline void qnnp_rebase_indirection_buffer(
+    const void** indirection_buffer,
+    size_t indirection_buffer_size,
+    const void* zero,
+    const void* old_input,
+    const void* new_input)
+{
+  const uintptr_t delta = (uintptr_t) new_input - (uintptr_t) old_input;
+  if (delta != 0) {
+    for (size_t i = 0; i < indirection_buffer_size; i++) {
+      if (indirection_buffer[i] != zero) {
+        indirection_buffer[i] = (const void*) ((uintptr_t) indirection_buffer[i] + delta);
+      }
+    }
+  }
+}
+
+/*
+ * Pointer that indirection buffers of a convolution or deconvolution hold for taps outside the input. Microkernels
+ * read up to 8 bytes before the last channel of a tap, so with fewer channels it points 8 bytes into the zero buffer.
+ */
+static inline const void* qnnp_get_indirection_zero(const struct qnnp_operator* convolution) {
+  size_t tap_channels;
+  if (convolution->type == qnnp_operator_type_deconvolution) {
+    tap_channels = convolution->group_input_channels;
+  } else if (convolution->flags & QNNP_CONVOLUTION_FLAG_DW) {
+    tap_channels = (size_t) convolution->groups * (size_t) convolution->group_output_channels;
+  } else if (convolution->format == qnnp_format_quint8) {
+    tap_channels = qnnp_convolution_get_tap_channels(convolution);
+  } else {
+    return convolution->zero;
+  }
+  return tap_channels < 8 ? (const void*) ((uintptr_t) convolution->zero + 8) : convolution->zero;
+}
+
+/*
+ * Depthwise microkernel with a channel multiplier that reads every input channel for its consecutive output channels,
+ * or NULL if the depthwise convolution has no multiplier or the microkernels can't read its input channels directly.
+ */
+static inline q8dw_multiplier_ukernel_function qnnp_get_q8dw_multiplier_ukernel(
+    const struct qnnp_operator* convolution)
+{
+  const uint32_t multiplier = convolution->group_output_channels;
+  if (!(convolution->flags & QNNP_CONVOLUTION_FLAG_DW) || multiplier == 1 ||
+      multiplier > 8 || (multiplier & (multiplier - 1)) != 0)
+  {
+    return NULL;
+  }
+  const struct q8dw_parameters* q8dw_params =
+    convolution->kernel_height * convolution->kernel_width == 9 ? &qnnp_params.q8dw9 : &qnnp_params.q8dw25;
+  return q8dw_params->multiplier_dw;
+}
+
+/*
+ * Whether qnnp_run_operator replicates the input channels of a depthwise convolution with a channel multiplier into
+ * expanded_input, because no depthwise microkernel reads them directly.
+ */
+static inline bool qnnp_convolution_expands_input(const struct qnnp_operator* convolution) {
+  return (convolution->flags & QNNP_CONVOLUTION_FLAG_DW) && convolution->group_output_channels != 1 &&
+    qnnp_get_q8dw_multiplier_ukernel(convolution) == NULL;
+}
+
+/*
+ * Input the indirection buffer of a convolution or deconvolution points into after its last setup: the expanded
+ * input for depthwise convolution with a channel multiplier, see qnnp_convolution_expands_input, otherwise the input
+ * itself.
+ */
+static inline const void* qnnp_get_indirection_base(const struct qnnp_operator* convolution) {
+  if (qnnp_convolution_expands_input(convolution)) {
+    return (const void*) ((uintptr_t) convolution->expanded_input + 8);
+  }
+  return convolution->input;
+}
+
 static inline uint32_t qnnp_operator_get_log2_output_element_size(const struct qnnp_operator* convolution) {
   return (uint32_t) (convolution->format & UINT32_C(0xFF));
 }
@@ -82,3 +636,31 @@ static inline uint32_t qnnp_operator_get_log2_kernel_element_size(const struct q
 static inline uint32_t qnnp_operator_get_log2_bias_element_size(const struct qnnp_operator* convolution) {
   return (uint32_t) ((convolution->format >> 24) & UINT32_C(0xFF));
 }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Sets up the input, output, and indirection buffer of an operator as qnnp_setup_convolution2d_nhwc_q8 does. Pooling
+ * operators are created with QNNP_CONVOLUTION_FLAG_DW and share the depthwise indirection buffer this way.
+ */
+enum qnnp_status qnnp_setup_convolution_indirection(
+    struct qnnp_operator* op,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride);
+
+/*
+ * Rebases the indirection buffer of a deconvolution set up without caller-provided workspace onto its current input,
+ * see qnnp_set_operator_io.
+ */
+void qnnp_rebase_deconvolution_indirection(struct qnnp_operator* deconvolution);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
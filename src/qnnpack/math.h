@@ -14,6 +14,15 @@ inline static size_t min(size_t a, size_t b) {
   return a < b ? a : b;
 }
 
+inline static size_t max(size_t a, size_t b) {
+  return a > b ? a : b;
+}
+
+/* Difference or zero */
+inline static size_t doz(size_t a, size_t b) {
+  return a > b ? a - b : 0;
+}
+
 inline static size_t divide_round_up(size_t n, size_t q) {
   return n % q == 0 ? n / q : n / q + 1;
 }
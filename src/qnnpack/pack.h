@@ -32,6 +32,36 @@ static inline void pack_q8gemm_b(
   }
 }
 
+/*
+ * Packs B as pack_q8gemm_b does, but with 4-bit values: value i of the 8-bit layout is nibble i % 2 (the low one
+ * first) of byte i / 2, so with an even kr every byte holds two k of one channel. Values must be in [0, 15], and
+ * packed_b must be filled with the nibbles of the zero point beforehand, which pad k and n.
+ */
+static inline void pack_q8gemm_4bit_b(
+    size_t n,
+    size_t k,
+    uint32_t nr,
+    uint32_t kr,
+    const uint8_t* b,
+    uint8_t* packed_b)
+{
+  const size_t k_stride = (k + (kr - 1)) & -kr;
+  for (size_t nr_block_start = 0; nr_block_start < n; nr_block_start += nr) {
+    const size_t nr_block_size = min(n - nr_block_start, nr);
+    for (size_t nr_block_offset = 0; nr_block_offset < nr_block_size; nr_block_offset++) {
+      for (size_t kr_block_start = 0; kr_block_start < k; kr_block_start += kr) {
+        const size_t kr_block_size = min(k - kr_block_start, kr);
+        for (size_t kr_block_offset = 0; kr_block_offset < kr_block_size; kr_block_offset++) {
+          const size_t index = nr_block_start * k_stride + kr_block_start * nr + nr_block_offset * kr + kr_block_offset;
+          const uint32_t shift = (uint32_t) (index % 2) * 4;
+          const uint8_t value = b[(nr_block_start + nr_block_offset) * k + (kr_block_start + kr_block_offset)];
+          packed_b[index / 2] = (uint8_t) ((packed_b[index / 2] & ~(0x0F << shift)) | ((value & 0x0F) << shift));
+        }
+      }
+    }
+  }
+}
+
 static inline void pack_q8conv_b(
     size_t n,
     size_t ks,
@@ -58,8 +88,37 @@ static inline void pack_q8conv_b(
   }
 }
 
-static inline void pack_q8deconv_b(
+/*
+ * Folds the input zero point into the biases of an nr-block packed by pack_q8gemm_b, pack_q8conv_b, or the other
+ * packing functions with the same layout of kr-blocks, see QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT:
+ * sum (a - input_zero_point) * (b - kernel_zero_point) = sum a * (b - kernel_zero_point) - input_zero_point * sum
+ * (b - kernel_zero_point). Padding of the block holds the kernel zero point, so packed_size may cover all of it.
+ */
+static inline void fold_q8conv_input_zero_point(
+    size_t packed_size,
+    uint32_t nr,
+    uint32_t kr,
+    uint8_t input_zero_point,
+    uint8_t kernel_zero_point,
+    const uint8_t* packed_b,
+    int32_t* packed_bias)
+{
+  const int32_t a_zero_point = (int32_t) (uint32_t) input_zero_point;
+  const int32_t b_zero_point = (int32_t) (uint32_t) kernel_zero_point;
+  for (size_t i = 0; i < packed_size; i++) {
+    packed_bias[i / kr % nr] -= a_zero_point * ((int32_t) (uint32_t) packed_b[i] - b_zero_point);
+  }
+}
+
+/*
+ * Packs block_groups adjacent groups of n output channels and kc input channels each, with block_groups * n <= nr, as
+ * one nr-block of a group of block_groups * kc input channels, see QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS. Only the
+ * diagonal blocks are written, so packed_b must already hold the padding for the input channels of other groups.
+ * With ks = 1, this is also the layout of GEMM microkernels.
+ */
+static inline void pack_q8conv_b_group_block(
     size_t n,
+    size_t block_groups,
     size_t ks,
     size_t kc,
     uint32_t nr,
@@ -67,23 +126,158 @@ static inline void pack_q8deconv_b(
     const uint8_t* b,
     uint8_t* packed_b)
 {
-  const size_t kc_stride = (kc + (kr - 1)) & -kr;
+  const size_t kc_stride = (block_groups * kc + (kr - 1)) & -kr;
+  for (size_t nr_block_offset = 0; nr_block_offset < block_groups * n; nr_block_offset++) {
+    const size_t channel_start = nr_block_offset / n * kc;
+    for (size_t ki = 0; ki < ks; ki++) {
+      for (size_t kci = 0; kci < kc; kci++) {
+        const size_t channel = channel_start + kci;
+        packed_b[ki * nr * kc_stride + (channel & -kr) * nr + nr_block_offset * kr + (channel & (kr - 1))] =
+            b[(nr_block_offset * ks + ki) * kc + kci];
+      }
+    }
+  }
+}
+
+/* FP32 counterpart of pack_q8conv_b with kr = 1, which with ks = 1 is also the layout of GEMM microkernels */
+static inline void pack_sconv_b(
+    size_t n,
+    size_t ks,
+    size_t kc,
+    uint32_t nr,
+    const float* b,
+    float* packed_b)
+{
   for (size_t nr_block_start = 0; nr_block_start < n; nr_block_start += nr) {
     const size_t nr_block_size = min(n - nr_block_start, nr);
-    for (size_t kr_block_start = 0; kr_block_start < kc; kr_block_start += kr) {
-      const size_t kr_block_size = min(kc - kr_block_start, kr);
-      for (size_t ki = 0; ki < ks; ki++) {
+    for (size_t ki = 0; ki < ks; ki++) {
+      for (size_t k = 0; k < kc; k++) {
         for (size_t nr_block_offset = 0; nr_block_offset < nr_block_size; nr_block_offset++) {
-          for (size_t kr_block_offset = 0; kr_block_offset < kr_block_size; kr_block_offset++) {
-            packed_b[(nr_block_start * ks + ki * nr) * kc_stride + kr_block_start * nr + nr_block_offset * kr + kr_block_offset] =
-                b[((kr_block_start + kr_block_offset) * ks + ki) * n + (nr_block_start + nr_block_offset)];
+          packed_b[(nr_block_start * ks + ki * nr) * kc + k * nr + nr_block_offset] =
+              b[((nr_block_start + nr_block_offset) * ks + ki) * kc + k];
+        }
+      }
+    }
+  }
+}
+
+/* FP16 counterpart of pack_sconv_b, with IEEE half-precision elements stored as uint16_t */
+static inline void pack_hconv_b(
+    size_t n,
+    size_t ks,
+    size_t kc,
+    uint32_t nr,
+    const uint16_t* b,
+    uint16_t* packed_b)
+{
+  for (size_t nr_block_start = 0; nr_block_start < n; nr_block_start += nr) {
+    const size_t nr_block_size = min(n - nr_block_start, nr);
+    for (size_t ki = 0; ki < ks; ki++) {
+      for (size_t k = 0; k < kc; k++) {
+        for (size_t nr_block_offset = 0; nr_block_offset < nr_block_size; nr_block_offset++) {
+          packed_b[(nr_block_start * ks + ki * nr) * kc + k * nr + nr_block_offset] =
+              b[((nr_block_start + nr_block_offset) * ks + ki) * kc + k];
+        }
+      }
+    }
+  }
+}
+
+/* Packs tap ki of the nr-block of output channels starting at nr_block_start as tap packed_ki of the block */
+static inline void pack_q8deconv_b_nr_block_tap(
+    size_t n,
+    size_t nr_block_start,
+    size_t ks,
+    size_t ki,
+    size_t packed_ki,
+    size_t kc,
+    uint32_t nr,
+    uint32_t kr,
+    const uint8_t* b,
+    uint8_t* packed_b)
+{
+  const size_t kc_stride = (kc + (kr - 1)) & -kr;
+  const size_t nr_block_size = min(n - nr_block_start, nr);
+  for (size_t kr_block_start = 0; kr_block_start < kc; kr_block_start += kr) {
+    const size_t kr_block_size = min(kc - kr_block_start, kr);
+    for (size_t nr_block_offset = 0; nr_block_offset < nr_block_size; nr_block_offset++) {
+      for (size_t kr_block_offset = 0; kr_block_offset < kr_block_size; kr_block_offset++) {
+        packed_b[(nr_block_start * ks + packed_ki * nr) * kc_stride + kr_block_start * nr + nr_block_offset * kr + kr_block_offset] =
+            b[((kr_block_start + kr_block_offset) * ks + ki) * n + (nr_block_start + nr_block_offset)];
+      }
+    }
+  }
+}
+
+/* Packs the nr-block of output channels starting at nr_block_start, see pack_q8deconv_b */
+static inline void pack_q8deconv_b_nr_block(
+    size_t n,
+    size_t nr_block_start,
+    size_t ks,
+    size_t kc,
+    uint32_t nr,
+    uint32_t kr,
+    const uint8_t* b,
+    uint8_t* packed_b)
+{
+  for (size_t ki = 0; ki < ks; ki++) {
+    pack_q8deconv_b_nr_block_tap(n, nr_block_start, ks, ki, ki, kc, nr, kr, b, packed_b);
+  }
+}
+
+/*
+ * Same as pack_q8deconv_b_nr_block, but with the taps ordered by stride phase (row residue, then column residue of
+ * the dilated tap offsets), so that the taps of each phase are consecutive and in row-major order.
+ */
+static inline void pack_q8deconv_b_nr_block_subpixel(
+    size_t n,
+    size_t nr_block_start,
+    size_t kernel_height,
+    size_t kernel_width,
+    size_t stride_height,
+    size_t stride_width,
+    size_t dilation_height,
+    size_t dilation_width,
+    size_t kc,
+    uint32_t nr,
+    uint32_t kr,
+    const uint8_t* b,
+    uint8_t* packed_b)
+{
+  const size_t ks = kernel_height * kernel_width;
+  size_t packed_ki = 0;
+  for (size_t residue_y = 0; residue_y < stride_height; residue_y++) {
+    for (size_t residue_x = 0; residue_x < stride_width; residue_x++) {
+      for (size_t kernel_y = 0; kernel_y < kernel_height; kernel_y++) {
+        if ((kernel_y * dilation_height) % stride_height != residue_y) {
+          continue;
+        }
+        for (size_t kernel_x = 0; kernel_x < kernel_width; kernel_x++) {
+          if ((kernel_x * dilation_width) % stride_width != residue_x) {
+            continue;
           }
+          pack_q8deconv_b_nr_block_tap(
+            n, nr_block_start, ks, kernel_y * kernel_width + kernel_x, packed_ki++, kc, nr, kr, b, packed_b);
         }
       }
     }
   }
 }
 
+static inline void pack_q8deconv_b(
+    size_t n,
+    size_t ks,
+    size_t kc,
+    uint32_t nr,
+    uint32_t kr,
+    const uint8_t* b,
+    uint8_t* packed_b)
+{
+  for (size_t nr_block_start = 0; nr_block_start < n; nr_block_start += nr) {
+    pack_q8deconv_b_nr_block(n, nr_block_start, ks, kc, nr, kr, b, packed_b);
+  }
+}
+
 static inline void pack_q8dw_w(
   size_t h,
   size_t w,
@@ -152,3 +346,118 @@ static inline void pack_q8gemm_b_diagonal(
     }
   }
 }
+
+/*
+ * Number of blocks of kr adjacent input channels of the n x k kernel b that hold a value other than the zero point,
+ * i.e. the blocks that pack_q8gemm_sparse_w stores.
+ */
+static inline size_t count_q8gemm_sparse_blocks(
+    size_t n,
+    size_t k,
+    uint32_t kr,
+    uint8_t zero_point,
+    const uint8_t* b)
+{
+  size_t blocks = 0;
+  for (size_t n_index = 0; n_index < n; n_index++) {
+    for (size_t kr_block_start = 0; kr_block_start < k; kr_block_start += kr) {
+      const size_t kr_block_size = min(k - kr_block_start, kr);
+      for (size_t kr_block_offset = 0; kr_block_offset < kr_block_size; kr_block_offset++) {
+        if (b[n_index * k + kr_block_start + kr_block_offset] != zero_point) {
+          blocks++;
+          break;
+        }
+      }
+    }
+  }
+  return blocks;
+}
+
+/*
+ * Packs the n x k kernel b for the sparse GEMM microkernels, see QNNP_CONVOLUTION_FLAG_SPARSE: n_stride + 1 uint32_t
+ * offsets row_ptr, where output channel j has the blocks row_ptr[j] to row_ptr[j + 1] - 1 and channels past n have
+ * none, then the first input channel of every block as uint32_t, then the kr values of every block. If kr does not
+ * divide k, the last block of an output channel starts at k - kr instead, so the microkernels never read past the
+ * input channels of a row, and its values of the input channels of the previous block are the zero point. k must be
+ * at least kr.
+ */
+static inline void pack_q8gemm_sparse_w(
+    size_t n,
+    size_t k,
+    size_t n_stride,
+    uint32_t kr,
+    uint8_t zero_point,
+    const uint8_t* b,
+    void* packed_w)
+{
+  uint32_t* row_ptr = (uint32_t*) packed_w;
+  uint32_t* block_channels = row_ptr + n_stride + 1;
+  const size_t blocks = count_q8gemm_sparse_blocks(n, k, kr, zero_point, b);
+  uint8_t* values = (uint8_t*) (block_channels + blocks);
+  uint32_t block = 0;
+  for (size_t n_index = 0; n_index < n_stride; n_index++) {
+    row_ptr[n_index] = block;
+    for (size_t kr_block_start = 0; n_index < n && kr_block_start < k; kr_block_start += kr) {
+      const size_t kr_block_size = min(k - kr_block_start, kr);
+      size_t zero_values = 0;
+      while (zero_values < kr_block_size && b[n_index * k + kr_block_start + zero_values] == zero_point) {
+        zero_values++;
+      }
+      if (zero_values != kr_block_size) {
+        const size_t kr_block_channel = min(kr_block_start, k - kr);
+        const size_t kr_block_skip = kr_block_start - kr_block_channel;
+        block_channels[block] = (uint32_t) kr_block_channel;
+        for (size_t kr_block_offset = 0; kr_block_offset < kr; kr_block_offset++) {
+          values[block * kr + kr_block_offset] = kr_block_offset >= kr_block_skip ?
+            b[n_index * k + kr_block_channel + kr_block_offset] : zero_point;
+        }
+        block++;
+      }
+    }
+  }
+  row_ptr[n_stride] = block;
+}
+
+/*
+ * Packs a block of n <= nr output channels of a 3x3 kernel for Winograd F(2x2, 3x3) as the 4x4 tiles
+ * G (b - kernel_zero_point) G^T, with G = [[2, 0, 0], [1, 1, 1], [1, -1, 1], [0, 0, 2]] twice the usual transform to
+ * keep the tiles integral. Each of the 16 tile positions holds k rows of nr int16 values.
+ */
+static inline void pack_q8winograd_w(
+    size_t n,
+    size_t k,
+    uint32_t nr,
+    uint8_t kernel_zero_point,
+    const uint8_t* b,
+    int16_t* packed_w)
+{
+  const int32_t zero_point = (int32_t) (uint32_t) kernel_zero_point;
+  for (size_t nr_block_offset = 0; nr_block_offset < n; nr_block_offset++) {
+    for (size_t ki = 0; ki < k; ki++) {
+      int32_t g[3][3];
+      for (size_t y = 0; y < 3; y++) {
+        for (size_t x = 0; x < 3; x++) {
+          g[y][x] = (int32_t) (uint32_t) b[(nr_block_offset * 9 + y * 3 + x) * k + ki] - zero_point;
+        }
+      }
+      int32_t gt[4][3];
+      for (size_t x = 0; x < 3; x++) {
+        gt[0][x] = 2 * g[0][x];
+        gt[1][x] = g[0][x] + g[1][x] + g[2][x];
+        gt[2][x] = g[0][x] - g[1][x] + g[2][x];
+        gt[3][x] = 2 * g[2][x];
+      }
+      for (size_t y = 0; y < 4; y++) {
+        const int32_t u[4] = {
+          2 * gt[y][0],
+          gt[y][0] + gt[y][1] + gt[y][2],
+          gt[y][0] - gt[y][1] + gt[y][2],
+          2 * gt[y][2],
+        };
+        for (size_t x = 0; x < 4; x++) {
+          packed_w[((y * 4 + x) * k + ki) * nr + nr_block_offset] = (int16_t) u[x];
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/params.h>
+
+
+enum qnnp_packing_state {
+  qnnp_packing_state_unpacked = 0,
+  qnnp_packing_state_packing,
+  qnnp_packing_state_packed,
+};
+
+struct qnnp_packed_weights {
+  uint32_t reference_count;
+  /* enum qnnp_packing_state, accessed atomically */
+  uint32_t packing_state;
+  /* packed_kernel and bias point into caller-owned memory, e.g. a memory-mapped serialized operator */
+  bool external_memory;
+
+  /* Parameters of the operator the weights were packed for, which determine the packed layout and bias */
+  enum qnnp_operator_type type;
+  enum qnnp_format format;
+  uint32_t flags;
+  uint32_t kernel_height;
+  uint32_t kernel_width;
+  uint32_t groups;
+  size_t group_input_channels;
+  size_t group_output_channels;
+  uint8_t input_zero_point;
+  uint8_t kernel_zero_point;
+  /* Order of the taps with QNNP_CONVOLUTION_FLAG_SUBPIXEL, and 0 otherwise */
+  uint32_t stride_height;
+  uint32_t stride_width;
+  uint32_t dilation_height;
+  uint32_t dilation_width;
+  /*
+   * Tile of the packed layout: nr x kr for GEMM and convolution microkernels, additionally kc for XZP GEMM
+   * microkernels, and channel tile cr in nr for depthwise microkernels. FP32 weights have kr = 1.
+   */
+  uint32_t nr;
+  uint32_t kr;
+  uint32_t kc;
+
+  void* packed_kernel;
+  size_t packed_kernel_size;
+  void* bias;
+  size_t bias_size;
+  /*
+   * Read-only mapping of the serialized operator file that packed_kernel and bias point into, which releasing the
+   * last reference unmaps, or NULL
+   */
+  void* mapping;
+  size_t mapping_size;
+
+  /*
+   * Caller-owned kernel and bias to pack on first use, see QNNP_CREATE_FLAG_LAZY_PACKING: uint8_t kernel and int32_t
+   * bias of quantized operators, or float kernel and bias of FP32 operators.
+   */
+  const void* unpacked_kernel;
+  const void* unpacked_bias;
+  /*
+   * Caller-owned kernel scale of every output channel for QNNP_CONVOLUTION_FLAG_PER_CHANNEL, packed as
+   * input_output_scale * kernel scale, and NULL otherwise.
+   */
+  const float* unpacked_kernel_scales;
+  float input_output_scale;
+  /*
+   * Groups of the unpacked kernel in every group of the packed weights with QNNP_CONVOLUTION_FLAG_GROUP_BLOCKS, and 1
+   * otherwise
+   */
+  uint32_t block_groups;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Makes a newly created operator reference new, not yet packed weights for the kernel and bias. The sizes are those
+ * of the packed kernel and bias for the tile the operator selected.
+ */
+enum qnnp_status qnnp_attach_new_packed_weights(
+    qnnp_operator_t op,
+    const void* kernel,
+    const void* bias,
+    size_t packed_kernel_size,
+    size_t bias_size);
+
+/*
+ * Makes the operator reference existing packed weights, after checking that they were packed for the same
+ * parameters as the operator has.
+ */
+enum qnnp_status qnnp_attach_packed_weights(qnnp_operator_t op, qnnp_packed_weights_t packed_weights);
+
+/*
+ * Packs the weights the operator references unless they are already packed, and points the operator to the packed
+ * kernel and bias. Safe to call concurrently for operators sharing the weights: one caller packs, using the thread
+ * pool, while the others wait.
+ */
+enum qnnp_status qnnp_ensure_packed_weights(qnnp_operator_t op, pthreadpool_t threadpool);
+
+/*
+ * Creates an operator from data written by qnnp_serialize_operator as qnnp_create_operator_from_serialized does,
+ * with QNNP_CREATE_FLAG_* flags that the data does not record, e.g. QNNP_CREATE_FLAG_TILE_INDIRECTION.
+ */
+enum qnnp_status qnnp_create_operator_from_serialized_with_flags(
+    const void* data,
+    size_t data_size,
+    uint32_t extra_create_flags,
+    qnnp_operator_t* op);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -91,6 +91,11 @@ union qnnp_precise_requantization_params {
   } sse2;
 };
 
+/*
+ * Requantization parameters of GEMM and convolution microkernels. Besides the Q31 multiplier and shift, they hold the
+ * scale itself for microkernels with FP32 requantization, see QNNP_CREATE_FLAG_FP32_REQUANTIZATION, which use the
+ * scale instead of the multiplier and shift, and the zero point and output range like the others.
+ */
 union qnnp_q31_requantization_params {
   struct {
     int32_t multiplier;
@@ -100,6 +105,7 @@ union qnnp_q31_requantization_params {
     int32_t min_less_zero_point;
     int32_t max_less_zero_point;
     int32_t zero_point;
+    float scale;
   } scalar;
 #if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
   struct {
@@ -108,6 +114,8 @@ union qnnp_q31_requantization_params {
     int16_t zero_point;
     uint8_t max;
     uint8_t min;
+    /* After the fields that assembly microkernels load by offset */
+    float scale;
   } neon;
 #endif /* CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 */
 #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
@@ -120,6 +128,120 @@ union qnnp_q31_requantization_params {
     QNNP_ALIGN(16) int16_t zero_point[8];
     QNNP_ALIGN(16) uint8_t max[16];
     QNNP_ALIGN(16) uint8_t min[16];
+    QNNP_ALIGN(16) float scale[4];
+  } sse2;
+#endif /* CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 */
+};
+
+union qnnp_add_quantization_params {
+  struct {
+    int32_t zero_point_product;
+    uint32_t a_multiplier;
+    uint32_t b_multiplier;
+    uint32_t shift;
+    int32_t remainder_mask;
+    int32_t remainder_threshold;
+    int32_t y_zero_point;
+    int32_t y_max;
+    int32_t y_min;
+  } scalar;
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  struct {
+    uint8_t a_zero_point;
+    uint8_t b_zero_point;
+    int16_t y_zero_point;
+    int32_t a_multiplier;
+    int32_t b_multiplier;
+    int32_t right_shift;
+    uint8_t y_max;
+    uint8_t y_min;
+  } neon;
+#endif /* CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 */
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  struct {
+    QNNP_ALIGN(16) int32_t zero_point_product[4];
+    QNNP_ALIGN(16) uint16_t a_multiplier_lo[8];
+    QNNP_ALIGN(16) uint16_t a_multiplier_hi[8];
+    QNNP_ALIGN(16) uint16_t b_multiplier_lo[8];
+    QNNP_ALIGN(16) uint16_t b_multiplier_hi[8];
+    QNNP_ALIGN(16) int32_t remainder_mask[4];
+    QNNP_ALIGN(16) int32_t remainder_threshold[4];
+    QNNP_ALIGN(16) int16_t y_zero_point[8];
+    QNNP_ALIGN(16) uint8_t y_max[16];
+    QNNP_ALIGN(16) uint8_t y_min[16];
+    uint32_t shift;
+  } sse2;
+#endif /* CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 */
+};
+
+union qnnp_u8_clamping_params {
+  struct {
+    int32_t output_max;
+    int32_t output_min;
+  } scalar;
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  struct {
+    uint8_t output_max;
+    uint8_t output_min;
+  } neon;
+#endif /* CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 */
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  struct {
+    QNNP_ALIGN(16) uint8_t output_max[16];
+    QNNP_ALIGN(16) uint8_t output_min[16];
+  } sse2;
+#endif /* CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 */
+};
+
+/*
+ * Parameters of the q8vquantize microkernels: inputs are scaled, clamped to the output range less the zero point, and
+ * rounded to nearest-even by adding the magic number 1.5 * 2**23, whose integer bits less magic_less_zero_point are
+ * the output.
+ */
+union qnnp_f32_quantization_params {
+  struct {
+    float scale;
+    float min_less_zero_point;
+    float max_less_zero_point;
+    float magic;
+    int32_t magic_less_zero_point;
+  } scalar;
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  struct {
+    float scale;
+    float min_less_zero_point;
+    float max_less_zero_point;
+    float magic;
+    int32_t magic_less_zero_point;
+  } neon;
+#endif /* CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 */
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  struct {
+    QNNP_ALIGN(16) float scale[4];
+    QNNP_ALIGN(16) float min_less_zero_point[4];
+    QNNP_ALIGN(16) float max_less_zero_point[4];
+    QNNP_ALIGN(16) float magic[4];
+    QNNP_ALIGN(16) int32_t magic_less_zero_point[4];
+  } sse2;
+#endif /* CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 */
+};
+
+/* Parameters of the q8vdequantize microkernels, which compute (x - zero_point) * scale */
+union qnnp_f32_dequantization_params {
+  struct {
+    int32_t zero_point;
+    float scale;
+  } scalar;
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  struct {
+    uint8_t zero_point;
+    float scale;
+  } neon;
+#endif /* CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 */
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  struct {
+    QNNP_ALIGN(16) int16_t zero_point[8];
+    QNNP_ALIGN(16) float scale[4];
   } sse2;
 #endif /* CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 */
 };
@@ -144,6 +266,18 @@ typedef void (*q8gemm_ukernel_function)(
     const uint8_t b_offset,
     const union qnnp_q31_requantization_params* requantization_params);
 
+typedef void (*q8gemm_acc32_ukernel_function)(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const uint8_t* a,
+    size_t a_stride,
+    const uint8_t* b,
+    int32_t* c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset);
+
 typedef void (*q8conv_ukernel_function)(
     size_t mr,
     size_t nr,
@@ -158,6 +292,23 @@ typedef void (*q8conv_ukernel_function)(
     const uint8_t b_offset,
     const union qnnp_q31_requantization_params* requantization_params);
 
+/*
+ * Convolution over unsigned products for XZP convolutions, see QNNP_CONVOLUTION_FLAG_XZP_CONV: a_sum[i] holds the
+ * sum of all ks * kc inputs of row i times the negated kernel zero point, for all mr rows of the tile.
+ */
+typedef void (*q8conv_xzp_ukernel_function)(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const uint8_t** a,
+    const uint8_t* b,
+    const int32_t* bias,
+    uint8_t* c,
+    size_t c_stride,
+    const int32_t* a_sum,
+    const union qnnp_q31_requantization_params* requantization_params);
+
 typedef void (*q8gemm_xzp_ukernel_function)(
     size_t mr,
     size_t nr,
@@ -171,6 +322,26 @@ typedef void (*q8gemm_xzp_ukernel_function)(
     const int32_t* a_sum,
     const union qnnp_q31_requantization_params* requantization_params);
 
+/*
+ * GEMM over a block-sparse kernel, see QNNP_CONVOLUTION_FLAG_SPARSE: output channel j of the tile has the blocks
+ * row_ptr[j] to row_ptr[j + 1] - 1, and block i multiplies the QNNP_SPARSE_BLOCK_SIZE kernel values at
+ * values + i * QNNP_SPARSE_BLOCK_SIZE with the input channels starting at block_channels[i].
+ */
+typedef void (*q8gemm_sparse_ukernel_function)(
+    size_t mr,
+    size_t nr,
+    const uint8_t* a,
+    size_t a_stride,
+    const uint32_t* row_ptr,
+    const uint32_t* block_channels,
+    const uint8_t* values,
+    const int32_t* bias,
+    uint8_t* c,
+    size_t c_stride,
+    const uint8_t a_offset,
+    const uint8_t b_offset,
+    const union qnnp_q31_requantization_params* requantization_params);
+
 typedef void (*q8sum_rows_ukernel_function)(
     const uint8_t* a,
     size_t m,
@@ -179,6 +350,17 @@ typedef void (*q8sum_rows_ukernel_function)(
     int32_t multiplier,
     int32_t* sums);
 
+/*
+ * Sums of the rows of an indirection tile for XZP convolutions: sums[i] is multiplier times the sum of the kc inputs
+ * at a[tap * m + i] over all ks taps, for all m rows of q8sum_rows_parameters.
+ */
+typedef void (*q8conv_sum_rows_ukernel_function)(
+    size_t kc,
+    size_t ks,
+    const uint8_t** a,
+    int32_t multiplier,
+    int32_t* sums);
+
 typedef void (*sgemm_ukernel_function)(
     size_t mr,
     size_t nr,
@@ -191,6 +373,18 @@ typedef void (*sgemm_ukernel_function)(
     size_t c_stride,
     const struct qnnp_fp32_clamping_params* clamping_params);
 
+typedef void (*sconv_ukernel_function)(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const float** a,
+    const float* b,
+    const float* bias,
+    float* c,
+    size_t c_stride,
+    const struct qnnp_fp32_clamping_params* clamping_params);
+
 typedef void (*hgemm_ukernel_function)(
     size_t mr,
     size_t nr,
@@ -203,6 +397,18 @@ typedef void (*hgemm_ukernel_function)(
     size_t c_stride,
     const struct qnnp_fp16_clamping_params* clamping_params);
 
+typedef void (*hconv_ukernel_function)(
+    size_t mr,
+    size_t nr,
+    size_t kc,
+    size_t ks,
+    const void** a,
+    const void* b,
+    const void* bias,
+    void* c,
+    size_t c_stride,
+    const struct qnnp_fp16_clamping_params* clamping_params);
+
 typedef void (*q8dw_ukernel_function)(
     size_t channels,
     size_t output_width,
@@ -211,43 +417,322 @@ typedef void (*q8dw_ukernel_function)(
     uint8_t* output,
     size_t input_stride,
     size_t output_increment,
+    size_t input_offset,
+    uint8_t input_zero_point,
+    uint8_t kernel_zero_point,
+    const union qnnp_q31_requantization_params* requantization_params);
+
+typedef void (*q8dw_multiplier_ukernel_function)(
+    size_t channels,
+    size_t multiplier,
+    size_t output_width,
+    const uint8_t** input,
+    const void* weights,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
     uint8_t input_zero_point,
     uint8_t kernel_zero_point,
     const union qnnp_q31_requantization_params* requantization_params);
 
+typedef void (*q8vadd_ukernel_function)(
+    size_t n,
+    const uint8_t* a,
+    const uint8_t* b,
+    uint8_t* y,
+    const union qnnp_add_quantization_params* quantization_params);
+
+typedef void (*q8vrescale_ukernel_function)(
+    size_t n,
+    const uint8_t* x,
+    uint8_t* y,
+    const union qnnp_add_quantization_params* quantization_params);
+
+typedef void (*q8vquantize_ukernel_function)(
+    size_t n,
+    const float* x,
+    uint8_t* y,
+    const union qnnp_f32_quantization_params* quantization_params);
+
+typedef void (*q8vdequantize_ukernel_function)(
+    size_t n,
+    const uint8_t* x,
+    float* y,
+    const union qnnp_f32_dequantization_params* dequantization_params);
+
+/* Accumulates a row of a quantized embedding table, y += x * scale + bias */
+typedef void (*q8embedding_ukernel_function)(
+    size_t n,
+    const uint8_t* x,
+    float scale,
+    float bias,
+    float* y);
+
+typedef void (*q8gavgpool_ukernel_function)(
+    size_t m,
+    size_t n,
+    const uint8_t* x,
+    size_t x_stride,
+    int32_t bias,
+    uint8_t* y,
+    const union qnnp_q31_requantization_params* requantization_params);
+
+typedef void (*u8maxpool_ukernel_function)(
+    size_t channels,
+    size_t output_width,
+    size_t kernel_size,
+    const uint8_t** input,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    const union qnnp_u8_clamping_params* clamping_params);
+
+typedef void (*q8avgpool_ukernel_function)(
+    size_t channels,
+    size_t output_width,
+    size_t kernel_size,
+    const uint8_t** input,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    int32_t bias,
+    const union qnnp_q31_requantization_params* requantization_params);
+
+typedef void (*x8lut_ukernel_function)(
+    size_t n,
+    const uint8_t* x,
+    const uint8_t* t,
+    uint8_t* y);
+
+typedef uint8_t (*u8rmax_ukernel_function)(
+    size_t n,
+    const uint8_t* x);
+
+typedef void (*u8lut32norm_ukernel_function)(
+    size_t n,
+    const uint8_t* x,
+    const uint32_t* t,
+    uint8_t* y);
+
+typedef void (*u8bilinear_ukernel_function)(
+    size_t output_width,
+    size_t channels,
+    const uint8_t* top,
+    const uint8_t* bottom,
+    size_t input_pixel_stride,
+    const uint32_t* columns,
+    const int16_t* column_weights,
+    int16_t row_weight,
+    uint8_t* output,
+    size_t output_pixel_stride);
+
+typedef void (*xzipc_ukernel_function)(
+    size_t n,
+    const void* x,
+    void* y);
+
+typedef void (*xzipv_ukernel_function)(
+    size_t n,
+    size_t m,
+    const void* x,
+    void* y);
+
 struct q8conv_parameters {
   q8gemm_ukernel_function gemm;
   q8conv_ukernel_function conv;
+  /*
+   * Microkernels with the same tile for signed packed weights, see QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL, or NULL if
+   * they would not be faster than gemm and conv.
+   */
+  q8gemm_ukernel_function signed_gemm;
+  q8conv_ukernel_function signed_conv;
+  /*
+   * Microkernels with the same tile and packed kernel for biases with the input zero point folded in, see
+   * QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT, or NULL if there are none.
+   */
+  q8gemm_ukernel_function folded_gemm;
+  q8conv_ukernel_function folded_conv;
+  /*
+   * Microkernels with the same tile that skip the upper clamp of the outputs, for output_max = 255, e.g. ReLU, and
+   * both clamps, for the full output range, as packing to 8 bits already saturates to [0, 255]; or NULL if there are
+   * none. They are variants of gemm and conv only, not of the signed, folded, or 16-bit accumulation microkernels.
+   */
+  q8gemm_ukernel_function relu_gemm;
+  q8conv_ukernel_function relu_conv;
+  q8gemm_ukernel_function unclamped_gemm;
+  q8conv_ukernel_function unclamped_conv;
+  /*
+   * Convolution microkernel with the same tile for XZP convolutions, which pack the kernel with zero padding and fold
+   * its zero point into sums of the input rows, see QNNP_CONVOLUTION_FLAG_XZP_CONV, or NULL if there is none.
+   */
+  q8conv_xzp_ukernel_function xzp_conv;
+  /*
+   * GEMM microkernel with the same tile and 16-bit accumulators, for kernels whose dot products cannot overflow them,
+   * see QNNP_CONVOLUTION_FLAG_ACC16, or NULL if there is none.
+   */
+  q8gemm_ukernel_function acc16_gemm;
+  /*
+   * Single-row GEMM microkernel with the same nr x kr tile and packed weights as gemm, for matrices with only a few
+   * rows, or NULL if there is none.
+   */
+  q8gemm_ukernel_function gemv;
+  /* Variant of gemv that stores 32-bit accumulators without bias and requantization, for split-K GEMM, or NULL */
+  q8gemm_acc32_ukernel_function gemv_acc32;
+  /* Tile and instruction set of the microkernels, e.g. "4x8c2__avx2", reported by qnnp_get_operator_info */
+  const char* name;
   uint8_t mr;
   uint8_t nr;
   uint8_t kr;
 };
 
+#define QNNP_MAX_Q8CONV_VARIANTS 4
+
+/* Microarchitectures (cpuinfo uarch indices) that can have their own microkernels; others use the default ones */
+#define QNNP_MAX_UARCHES 4
+
+/* Replacement of a GEMM/convolution microkernel pair on one microarchitecture, with the same tile and packing */
+struct q8conv_uarch_override {
+  uint32_t uarch_index;
+  q8gemm_ukernel_function gemm;
+  q8conv_ukernel_function conv;
+  q8gemm_ukernel_function uarch_gemm;
+  q8conv_ukernel_function uarch_conv;
+};
+
+#define QNNP_MAX_Q8CONV_UARCH_OVERRIDES 8
+
+struct q8conv_variant {
+  struct q8conv_parameters parameters;
+  /* Relative multiply-add throughput on full tiles, only meaningful in comparison with other variants */
+  uint32_t throughput;
+};
+
 struct q8conv_xzp_parameters {
   q8gemm_xzp_ukernel_function gemm;
-  /* no conv ukernel */
+  /* Convolution microkernels for XZP are q8conv_parameters::xzp_conv, with the tile of the other variants */
+  const char* name;
   uint8_t mr;
   uint8_t nr;
   uint8_t kr;
   uint8_t kc;
   size_t kthreshold;
+  /* Input channels per tap from which convolutions with several taps use XZP, see QNNP_CONVOLUTION_FLAG_XZP_CONV */
+  size_t conv_kthreshold;
+};
+
+struct q8gemm_sparse_parameters {
+  q8gemm_sparse_ukernel_function gemm;
+  const char* name;
+  uint8_t mr;
+  uint8_t nr;
+};
+
+/* GEMM and convolution microkernels of FP32 operators, which share the tile and the packed layout with kr = 1 */
+struct sconv_parameters {
+  sgemm_ukernel_function gemm;
+  sconv_ukernel_function conv;
+  const char* name;
+  uint8_t mr;
+  uint8_t nr;
+};
+
+/* FP16 counterpart of sconv_parameters; the microkernels are NULL without hardware FP16 arithmetic */
+struct hconv_parameters {
+  hgemm_ukernel_function gemm;
+  hconv_ukernel_function conv;
+  const char* name;
+  uint8_t mr;
+  uint8_t nr;
 };
 
 struct q8dw_parameters {
   q8dw_ukernel_function dw;
+  /*
+   * Optional microkernel with the packing of dw for a channel multiplier of 2, 4, or 8, which reads every input channel
+   * for its consecutive output channels. Without it, the input channels are replicated into a buffer first.
+   */
+  q8dw_multiplier_ukernel_function multiplier_dw;
+  const char* name;
   uint8_t cr;
 };
 
+struct q8gavgpool_parameters {
+  q8gavgpool_ukernel_function gavgpool;
+  /* Channels per microkernel iteration */
+  uint8_t nr;
+};
+
+struct u8maxpool_parameters {
+  u8maxpool_ukernel_function maxpool;
+  /* Channels per microkernel iteration */
+  uint8_t nr;
+};
+
+struct q8avgpool_parameters {
+  q8avgpool_ukernel_function avgpool;
+  /* Channels per microkernel iteration */
+  uint8_t nr;
+};
+
+struct x8zip_parameters {
+  /* Interleaving of 2, 3, and 4 groups */
+  xzipc_ukernel_function x2;
+  xzipc_ukernel_function x3;
+  xzipc_ukernel_function x4;
+  /* Interleaving of any number of groups, at least 4 */
+  xzipv_ukernel_function xm;
+};
+
 struct q8sum_rows_parameters {
   q8sum_rows_ukernel_function sum_rows;
+  q8conv_sum_rows_ukernel_function conv_sum_rows;
   uint32_t m;
 };
 
 struct qnnp_parameters {
   struct q8conv_parameters q8conv;
+  /* Microkernels operators may choose from instead of q8conv, which is always the first one */
+  struct q8conv_variant q8conv_variants[QNNP_MAX_Q8CONV_VARIANTS];
+  uint32_t q8conv_variants_count;
+  struct q8conv_uarch_override q8conv_uarch_overrides[QNNP_MAX_Q8CONV_UARCH_OVERRIDES];
+  uint32_t q8conv_uarch_overrides_count;
+  /* Number of microarchitectures in the system, at most QNNP_MAX_UARCHES */
+  uint32_t uarchs_count;
+  /* Share of the L2 cache per processor, in bytes, which bounds the packed kernel panel of a GEMM tile loop */
+  size_t l2_cache_size;
   struct q8conv_xzp_parameters q8conv_xzp;
+  /* GEMM microkernel for block-sparse kernels, see QNNP_CREATE_FLAG_SPARSE_KERNEL, or NULL if there is none */
+  struct q8gemm_sparse_parameters q8gemm_sparse;
+  /* Convolution microkernel with per-output-channel scales; there is no GEMM microkernel */
+  struct q8conv_parameters q8conv_perchannel;
+  /* GEMM and convolution microkernels with FP32 requantization, see QNNP_CREATE_FLAG_FP32_REQUANTIZATION */
+  struct q8conv_parameters q8conv_fp32;
+  /* GEMM microkernels for 4-bit packed weights, see QNNP_CREATE_FLAG_4BIT_KERNEL; there are no convolution ones */
+  struct q8conv_parameters q8conv_4bit;
+  struct sconv_parameters sconv;
+  struct hconv_parameters hconv;
   struct q8dw_parameters q8dw9;
+  struct q8dw_parameters q8dw25;
   struct q8sum_rows_parameters q8sum_rows;
+  q8vadd_ukernel_function q8vadd;
+  q8vrescale_ukernel_function q8vrescale;
+  q8vquantize_ukernel_function q8vquantize;
+  q8vdequantize_ukernel_function q8vdequantize;
+  /* Row accumulation of embedding-bag operators */
+  q8embedding_ukernel_function q8embedding;
+  struct q8gavgpool_parameters q8gavgpool;
+  struct u8maxpool_parameters u8maxpool;
+  struct q8avgpool_parameters q8avgpool;
+  struct x8zip_parameters x8zip;
+  x8lut_ukernel_function x8lut;
+  /* Maximum of a row, and a row mapped through a 32-bit table and normalized by its sum, for softmax and argmax */
+  u8rmax_ukernel_function u8rmax;
+  u8lut32norm_ukernel_function u8lut32norm;
+  /* Bilinear interpolation of an output row between two input rows, for resize operators */
+  u8bilinear_ukernel_function u8bilinear;
   bool initialized;
 };
 
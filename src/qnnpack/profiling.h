@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/scheduler.h>
+
+/*
+ * Collect qnnp_operator_stats, see the QNNPACK_PROFILING CMake option. Without it, the functions below compile to the
+ * plain qnnp_parallelize calls and the clock is never read.
+ */
+#ifndef QNNP_PROFILING
+#define QNNP_PROFILING 0
+#endif
+
+enum qnnp_profiling_phase {
+  qnnp_profiling_phase_setup,
+  qnnp_profiling_phase_indirection,
+  qnnp_profiling_phase_packing,
+  qnnp_profiling_phase_compute,
+  qnnp_profiling_phase_run,
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if QNNP_PROFILING
+uint64_t qnnp_profiling_now(void);
+
+/* Statistics of the operator, allocated on first use, or NULL if they could not be allocated */
+struct qnnp_operator_stats* qnnp_profiling_get_stats(struct qnnp_operator* op);
+
+/*
+ * Adds the time since start to the phase of the operator. A run phase also counts the run and the multiply-adds and
+ * bytes it moved, according to the shapes of the last setup.
+ */
+void qnnp_profiling_record_phase(struct qnnp_operator* op, enum qnnp_profiling_phase phase, uint64_t start);
+
+/* Adds the time since start to the time the calling thread spent in tasks of the operator */
+void qnnp_profiling_record_task(struct qnnp_operator_stats* stats, uint64_t start);
+#endif /* QNNP_PROFILING */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/* Start time of a phase for qnnp_profile_phase */
+static inline uint64_t qnnp_profile_start(void) {
+#if QNNP_PROFILING
+  return qnnp_profiling_now();
+#else
+  return 0;
+#endif
+}
+
+static inline void qnnp_profile_phase(struct qnnp_operator* op, enum qnnp_profiling_phase phase, uint64_t start) {
+#if QNNP_PROFILING
+  qnnp_profiling_record_phase(op, phase, start);
+#endif
+}
+
+#if QNNP_PROFILING
+/* Task of a parallel loop of an operator, timed on the thread that computes it */
+struct qnnp_profiled_task {
+  union {
+    pthreadpool_function_1d_t function_1d;
+    pthreadpool_function_1d_tiled_t function_1d_tiled;
+    pthreadpool_function_2d_t function_2d;
+    pthreadpool_function_2d_tiled_t function_2d_tiled;
+    pthreadpool_function_3d_tiled_t function_3d_tiled;
+    pthreadpool_function_4d_tiled_t function_4d_tiled;
+  };
+  void* argument;
+  struct qnnp_operator_stats* stats;
+};
+
+static inline void qnnp_profiled_task_1d(const struct qnnp_profiled_task* task, size_t i) {
+  const uint64_t start = qnnp_profiling_now();
+  task->function_1d(task->argument, i);
+  qnnp_profiling_record_task(task->stats, start);
+}
+
+static inline void qnnp_profiled_task_1d_tiled(const struct qnnp_profiled_task* task, size_t i, size_t tile_i) {
+  const uint64_t start = qnnp_profiling_now();
+  task->function_1d_tiled(task->argument, i, tile_i);
+  qnnp_profiling_record_task(task->stats, start);
+}
+
+static inline void qnnp_profiled_task_2d(const struct qnnp_profiled_task* task, size_t i, size_t j) {
+  const uint64_t start = qnnp_profiling_now();
+  task->function_2d(task->argument, i, j);
+  qnnp_profiling_record_task(task->stats, start);
+}
+
+static inline void qnnp_profiled_task_2d_tiled(
+    const struct qnnp_profiled_task* task,
+    size_t i, size_t j,
+    size_t tile_i, size_t tile_j)
+{
+  const uint64_t start = qnnp_profiling_now();
+  task->function_2d_tiled(task->argument, i, j, tile_i, tile_j);
+  qnnp_profiling_record_task(task->stats, start);
+}
+
+static inline void qnnp_profiled_task_3d_tiled(
+    const struct qnnp_profiled_task* task,
+    size_t i, size_t j, size_t k,
+    size_t tile_i, size_t tile_j, size_t tile_k)
+{
+  const uint64_t start = qnnp_profiling_now();
+  task->function_3d_tiled(task->argument, i, j, k, tile_i, tile_j, tile_k);
+  qnnp_profiling_record_task(task->stats, start);
+}
+
+static inline void qnnp_profiled_task_4d_tiled(
+    const struct qnnp_profiled_task* task,
+    size_t i, size_t j, size_t k, size_t l,
+    size_t tile_i, size_t tile_j, size_t tile_k, size_t tile_l)
+{
+  const uint64_t start = qnnp_profiling_now();
+  task->function_4d_tiled(task->argument, i, j, k, l, tile_i, tile_j, tile_k, tile_l);
+  qnnp_profiling_record_task(task->stats, start);
+}
+#endif /* QNNP_PROFILING */
+
+/*
+ * Parallel loops of qnnp_run_operator. With profiling they time every task on its thread, and the whole loop as the
+ * compute phase of the operator.
+ */
+static inline void qnnp_compute_1d(
+    struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_1d_t function,
+    void* argument,
+    size_t range)
+{
+#if QNNP_PROFILING
+  struct qnnp_operator_stats* stats = qnnp_profiling_get_stats(op);
+  if (stats != NULL) {
+    struct qnnp_profiled_task task = { .function_1d = function, .argument = argument, .stats = stats };
+    const uint64_t start = qnnp_profiling_now();
+    qnnp_parallelize_1d(op, threadpool, (pthreadpool_function_1d_t) qnnp_profiled_task_1d, &task, range);
+    qnnp_profiling_record_phase(op, qnnp_profiling_phase_compute, start);
+    return;
+  }
+#endif
+  qnnp_parallelize_1d(op, threadpool, function, argument, range);
+}
+
+static inline void qnnp_compute_1d_tiled(
+    struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_1d_tiled_t function,
+    void* argument,
+    size_t range,
+    size_t tile)
+{
+#if QNNP_PROFILING
+  struct qnnp_operator_stats* stats = qnnp_profiling_get_stats(op);
+  if (stats != NULL) {
+    struct qnnp_profiled_task task = { .function_1d_tiled = function, .argument = argument, .stats = stats };
+    const uint64_t start = qnnp_profiling_now();
+    qnnp_parallelize_1d_tiled(
+      op, threadpool, (pthreadpool_function_1d_tiled_t) qnnp_profiled_task_1d_tiled, &task, range, tile);
+    qnnp_profiling_record_phase(op, qnnp_profiling_phase_compute, start);
+    return;
+  }
+#endif
+  qnnp_parallelize_1d_tiled(op, threadpool, function, argument, range, tile);
+}
+
+static inline void qnnp_compute_2d(
+    struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_2d_t function,
+    void* argument,
+    size_t range_i, size_t range_j)
+{
+#if QNNP_PROFILING
+  struct qnnp_operator_stats* stats = qnnp_profiling_get_stats(op);
+  if (stats != NULL) {
+    struct qnnp_profiled_task task = { .function_2d = function, .argument = argument, .stats = stats };
+    const uint64_t start = qnnp_profiling_now();
+    qnnp_parallelize_2d(op, threadpool, (pthreadpool_function_2d_t) qnnp_profiled_task_2d, &task, range_i, range_j);
+    qnnp_profiling_record_phase(op, qnnp_profiling_phase_compute, start);
+    return;
+  }
+#endif
+  qnnp_parallelize_2d(op, threadpool, function, argument, range_i, range_j);
+}
+
+static inline void qnnp_compute_2d_tiled(
+    struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_2d_tiled_t function,
+    void* argument,
+    size_t range_i, size_t range_j,
+    size_t tile_i, size_t tile_j)
+{
+#if QNNP_PROFILING
+  struct qnnp_operator_stats* stats = qnnp_profiling_get_stats(op);
+  if (stats != NULL) {
+    struct qnnp_profiled_task task = { .function_2d_tiled = function, .argument = argument, .stats = stats };
+    const uint64_t start = qnnp_profiling_now();
+    qnnp_parallelize_2d_tiled(
+      op, threadpool, (pthreadpool_function_2d_tiled_t) qnnp_profiled_task_2d_tiled, &task,
+      range_i, range_j, tile_i, tile_j);
+    qnnp_profiling_record_phase(op, qnnp_profiling_phase_compute, start);
+    return;
+  }
+#endif
+  qnnp_parallelize_2d_tiled(op, threadpool, function, argument, range_i, range_j, tile_i, tile_j);
+}
+
+static inline void qnnp_compute_3d_tiled(
+    struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_3d_tiled_t function,
+    void* argument,
+    size_t range_i, size_t range_j, size_t range_k,
+    size_t tile_i, size_t tile_j, size_t tile_k)
+{
+#if QNNP_PROFILING
+  struct qnnp_operator_stats* stats = qnnp_profiling_get_stats(op);
+  if (stats != NULL) {
+    struct qnnp_profiled_task task = { .function_3d_tiled = function, .argument = argument, .stats = stats };
+    const uint64_t start = qnnp_profiling_now();
+    qnnp_parallelize_3d_tiled(
+      op, threadpool, (pthreadpool_function_3d_tiled_t) qnnp_profiled_task_3d_tiled, &task,
+      range_i, range_j, range_k, tile_i, tile_j, tile_k);
+    qnnp_profiling_record_phase(op, qnnp_profiling_phase_compute, start);
+    return;
+  }
+#endif
+  qnnp_parallelize_3d_tiled(op, threadpool, function, argument, range_i, range_j, range_k, tile_i, tile_j, tile_k);
+}
+
+static inline void qnnp_compute_4d_tiled(
+    struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_4d_tiled_t function,
+    void* argument,
+    size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+    size_t tile_i, size_t tile_j, size_t tile_k, size_t tile_l)
+{
+#if QNNP_PROFILING
+  struct qnnp_operator_stats* stats = qnnp_profiling_get_stats(op);
+  if (stats != NULL) {
+    struct qnnp_profiled_task task = { .function_4d_tiled = function, .argument = argument, .stats = stats };
+    const uint64_t start = qnnp_profiling_now();
+    qnnp_parallelize_4d_tiled(
+      op, threadpool, (pthreadpool_function_4d_tiled_t) qnnp_profiled_task_4d_tiled, &task,
+      range_i, range_j, range_k, range_l, tile_i, tile_j, tile_k, tile_l);
+    qnnp_profiling_record_phase(op, qnnp_profiling_phase_compute, start);
+    return;
+  }
+#endif
+  qnnp_parallelize_4d_tiled(
+    op, threadpool, function, argument,
+    range_i, range_j, range_k, range_l, tile_i, tile_j, tile_k, tile_l);
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <qnnpack/params.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECLARE_Q8AVGPOOL_FUNCTION(fn_name)                             \
+  void fn_name(                                                         \
+    size_t channels,                                                    \
+    size_t output_width,                                                \
+    size_t kernel_size,                                                 \
+    const uint8_t** input,                                              \
+    uint8_t* output,                                                    \
+    size_t input_stride,                                                \
+    size_t output_increment,                                            \
+    size_t input_offset,                                                \
+    int32_t bias,                                                       \
+    const union qnnp_q31_requantization_params* requantization_params);
+
+DECLARE_Q8AVGPOOL_FUNCTION(q8avgpool_ukernel_8x__neon)
+DECLARE_Q8AVGPOOL_FUNCTION(q8avgpool_ukernel_8x__sse2)
+DECLARE_Q8AVGPOOL_FUNCTION(q8avgpool_ukernel_1x__scalar)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
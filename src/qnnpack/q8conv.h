@@ -36,7 +36,77 @@ DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_4x8__neon)
 DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_4x8__aarch32_neon)
 DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_8x8__aarch64_neon)
 DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_8x8__neon)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_4x8c4__neondot)
 DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_4x4c2__sse2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_4x8c2__avx2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_4x8c4__avx512vnni)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_4x8__psimd)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_ukernel_4x8__rvv)
+
+/* Microkernels for signed packed weights, see QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL */
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_signed_ukernel_4x8c2__avx2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_signed_ukernel_4x8c4__avx512vnni)
+
+/* Microkernels for biases with the input zero point folded in, see QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT */
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_folded_ukernel_4x8__neon)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_folded_ukernel_4x4c2__sse2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_folded_ukernel_4x8c2__avx2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_folded_ukernel_4x8c4__avx512vnni)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_folded_ukernel_4x8__psimd)
+
+/* Microkernels that skip the clamps the output range makes redundant, see q8conv_parameters::relu_gemm */
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_relu_ukernel_4x8__neon)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_relu_ukernel_4x4c2__sse2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_relu_ukernel_4x8c2__avx2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_unclamped_ukernel_4x8__neon)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_unclamped_ukernel_4x4c2__sse2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_unclamped_ukernel_4x8c2__avx2)
+
+/*
+ * Microkernels with per-output-channel requantization: every nr block of the bias holds nr int32_t biases followed by
+ * nr FP32 scales, and only the zero point and output range of the requantization parameters are used.
+ */
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_perchannel_ukernel_4x8__neon)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_perchannel_ukernel_4x4c2__sse2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_perchannel_ukernel_4x8__psimd)
+
+/* Microkernels with FP32 requantization, see QNNP_CREATE_FLAG_FP32_REQUANTIZATION */
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_fp32_ukernel_4x8__neon)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_fp32_ukernel_4x4c2__sse2)
+DECLARE_Q8CONV_UKERNEL_FUNCTION(q8conv_fp32_ukernel_4x8__psimd)
+
+#define DECLARE_Q8CONV_XZP_UKERNEL_FUNCTION(fn_name)                      \
+  void fn_name(                                                           \
+      size_t mr,                                                          \
+      size_t nr,                                                          \
+      size_t kc,                                                          \
+      size_t ks,                                                          \
+      const uint8_t** a,                                                  \
+      const uint8_t* b,                                                   \
+      const int32_t* bias,                                                \
+      uint8_t* c,                                                         \
+      size_t c_stride,                                                    \
+      const int32_t* a_sum,                                               \
+      const union qnnp_q31_requantization_params* requantization_params);
+
+/* Microkernels for XZP convolutions, see QNNP_CONVOLUTION_FLAG_XZP_CONV */
+DECLARE_Q8CONV_XZP_UKERNEL_FUNCTION(q8conv_xzp_ukernel_4x8__neon)
+DECLARE_Q8CONV_XZP_UKERNEL_FUNCTION(q8conv_xzp_ukernel_4x4c2__sse2)
+DECLARE_Q8CONV_XZP_UKERNEL_FUNCTION(q8conv_xzp_ukernel_4x8c2__avx2)
+
+/* Sums of the rows of indirection tiles for XZP convolutions, see q8conv_sum_rows_ukernel_function */
+void q8conv_sumrows_ukernel_4x__neon(
+    size_t kc,
+    size_t ks,
+    const uint8_t** a,
+    int32_t multiplier,
+    int32_t* sums);
+void q8conv_sumrows_ukernel_4x__sse2(
+    size_t kc,
+    size_t ks,
+    const uint8_t** a,
+    int32_t multiplier,
+    int32_t* sums);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -26,12 +26,40 @@ extern "C" {
     uint8_t* output,                                                    \
     size_t input_stride,                                                \
     size_t output_increment,                                            \
+    size_t input_offset,                                                \
     uint8_t input_zero_point,                                           \
     uint8_t kernel_zero_point,                                          \
     const union qnnp_q31_requantization_params* requantization_params);
 
 DECLARE_Q8DW_FUNCTION(q8dw_ukernel_9c8__neon)
 DECLARE_Q8DW_FUNCTION(q8dw_ukernel_9c8__sse2)
+DECLARE_Q8DW_FUNCTION(q8dw_ukernel_9c16__avx2)
+DECLARE_Q8DW_FUNCTION(q8dw_ukernel_9c8__psimd)
+DECLARE_Q8DW_FUNCTION(q8dw_ukernel_9c8__rvv)
+DECLARE_Q8DW_FUNCTION(q8dw_ukernel_25c8__neon)
+DECLARE_Q8DW_FUNCTION(q8dw_ukernel_25c8__sse2)
+DECLARE_Q8DW_FUNCTION(q8dw_ukernel_25c8__psimd)
+
+#define DECLARE_Q8DW_MULTIPLIER_FUNCTION(fn_name)                       \
+  void fn_name(                                                         \
+    size_t channels,                                                    \
+    size_t multiplier,                                                  \
+    size_t output_width,                                                \
+    const uint8_t** input,                                              \
+    const void* weights,                                                \
+    uint8_t* output,                                                    \
+    size_t input_stride,                                                \
+    size_t output_increment,                                            \
+    size_t input_offset,                                                \
+    uint8_t input_zero_point,                                           \
+    uint8_t kernel_zero_point,                                          \
+    const union qnnp_q31_requantization_params* requantization_params);
+
+DECLARE_Q8DW_MULTIPLIER_FUNCTION(q8dw_multiplier_ukernel_9c8__sse2)
+DECLARE_Q8DW_MULTIPLIER_FUNCTION(q8dw_multiplier_ukernel_9c16__avx2)
+DECLARE_Q8DW_MULTIPLIER_FUNCTION(q8dw_multiplier_ukernel_9c8__psimd)
+DECLARE_Q8DW_MULTIPLIER_FUNCTION(q8dw_multiplier_ukernel_25c8__sse2)
+DECLARE_Q8DW_MULTIPLIER_FUNCTION(q8dw_multiplier_ukernel_25c8__psimd)
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <qnnpack/params.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECLARE_Q8GAVGPOOL_FUNCTION(fn_name)                            \
+  void fn_name(                                                         \
+    size_t m,                                                           \
+    size_t n,                                                           \
+    const uint8_t* x,                                                   \
+    size_t x_stride,                                                    \
+    int32_t bias,                                                       \
+    uint8_t* y,                                                         \
+    const union qnnp_q31_requantization_params* requantization_params);
+
+DECLARE_Q8GAVGPOOL_FUNCTION(q8gavgpool_ukernel_8x__neon)
+DECLARE_Q8GAVGPOOL_FUNCTION(q8gavgpool_ukernel_8x__sse2)
+DECLARE_Q8GAVGPOOL_FUNCTION(q8gavgpool_ukernel_1x__scalar)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
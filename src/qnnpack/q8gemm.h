@@ -32,6 +32,7 @@ extern "C" {
       const uint8_t b_offset,                                             \
       const union qnnp_q31_requantization_params* requantization_params);
 
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_1x8__neon)
 DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_3x3c8__neon)
 DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_2x4c8__neon)
 DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_4x8__neon)
@@ -42,8 +43,70 @@ DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_4x8__aarch32_neon)
 
 DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_8x8__aarch64_neon)
 
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_4x8c4__neondot)
+
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_1x4c2__sse2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_1x8c2__avx2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_1x8c4__avx512vnni)
 DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_2x4c8__sse2)
 DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_4x4c2__sse2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_4x8c2__avx2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_4x8c4__avx512vnni)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_4x8__psimd)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_4x8__rvv)
+
+/* Microkernels for signed packed weights, see QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL */
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_signed_ukernel_4x8c2__avx2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_signed_ukernel_4x8c4__avx512vnni)
+
+/* Microkernels for biases with the input zero point folded in, see QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT */
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_folded_ukernel_4x8__neon)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_folded_ukernel_4x4c2__sse2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_folded_ukernel_4x8c2__avx2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_folded_ukernel_4x8c4__avx512vnni)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_folded_ukernel_4x8__psimd)
+
+/* Microkernels that skip the clamps the output range makes redundant, see q8conv_parameters::relu_gemm */
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_relu_ukernel_4x8__neon)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_relu_ukernel_4x4c2__sse2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_relu_ukernel_4x8c2__avx2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_unclamped_ukernel_4x8__neon)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_unclamped_ukernel_4x4c2__sse2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_unclamped_ukernel_4x8c2__avx2)
+
+/* Microkernels with 16-bit accumulators, see QNNP_CONVOLUTION_FLAG_ACC16 */
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_acc16_ukernel_4x8__neon)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_acc16_ukernel_8x8__neon)
+
+/* Microkernels with FP32 requantization, see QNNP_CREATE_FLAG_FP32_REQUANTIZATION */
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_fp32_ukernel_4x8__neon)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_fp32_ukernel_4x4c2__sse2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_fp32_ukernel_4x8__psimd)
+
+/* Microkernels for 4-bit packed weights, see QNNP_CONVOLUTION_FLAG_4BIT */
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_4bit_ukernel_1x8c2__neon)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_4bit_ukernel_4x8c2__neon)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_4bit_ukernel_1x4c2__sse2)
+DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_4bit_ukernel_4x4c2__sse2)
+
+#define DECLARE_Q8GEMM_ACC32_UKERNEL_FUNCTION(fn_name) \
+  void fn_name(                                        \
+      size_t mr,                                       \
+      size_t nr,                                       \
+      size_t k,                                        \
+      const uint8_t* a,                                \
+      size_t a_stride,                                 \
+      const uint8_t* b,                                \
+      int32_t* c,                                      \
+      size_t c_stride,                                 \
+      const uint8_t a_offset,                          \
+      const uint8_t b_offset);
+
+DECLARE_Q8GEMM_ACC32_UKERNEL_FUNCTION(q8gemm_acc32_ukernel_1x8__neon)
+DECLARE_Q8GEMM_ACC32_UKERNEL_FUNCTION(q8gemm_acc32_ukernel_1x4c2__sse2)
+DECLARE_Q8GEMM_ACC32_UKERNEL_FUNCTION(q8gemm_acc32_ukernel_1x8c2__avx2)
+DECLARE_Q8GEMM_ACC32_UKERNEL_FUNCTION(q8gemm_acc32_ukernel_1x8c4__avx512vnni)
+DECLARE_Q8GEMM_ACC32_UKERNEL_FUNCTION(q8gemm_acc32_ukernel_1x8__psimd)
 
 #define DECLARE_Q8GEMM_XZP_UKERNEL_FUNCTION(fn_name) \
   void fn_name(                                      \
@@ -61,6 +124,26 @@ DECLARE_Q8GEMM_UKERNEL_FUNCTION(q8gemm_ukernel_4x4c2__sse2)
 DECLARE_Q8GEMM_XZP_UKERNEL_FUNCTION(q8gemm_xzp_ukernel_4x8c2__neon)
 DECLARE_Q8GEMM_XZP_UKERNEL_FUNCTION(q8gemm_xzp_ukernel_4x8c2__aarch32_neon)
 
+#define DECLARE_Q8GEMM_SPARSE_UKERNEL_FUNCTION(fn_name) \
+  void fn_name(                                         \
+      size_t mr,                                        \
+      size_t nr,                                        \
+      const uint8_t* a,                                 \
+      size_t a_stride,                                  \
+      const uint32_t* row_ptr,                          \
+      const uint32_t* block_channels,                   \
+      const uint8_t* values,                            \
+      const int32_t* bias,                              \
+      uint8_t* c,                                       \
+      size_t c_stride,                                  \
+      const uint8_t a_offset,                           \
+      const uint8_t b_offset,                           \
+      const union qnnp_q31_requantization_params* requantization_params);
+
+/* Microkernels for block-sparse kernels, see QNNP_CONVOLUTION_FLAG_SPARSE */
+DECLARE_Q8GEMM_SPARSE_UKERNEL_FUNCTION(q8gemm_sparse_ukernel_4x4c1x4__neon)
+DECLARE_Q8GEMM_SPARSE_UKERNEL_FUNCTION(q8gemm_sparse_ukernel_4x4c1x4__sse2)
+
 void q8sumrows_ukernel_4x__neon(
     const uint8_t* a,
     size_t m,
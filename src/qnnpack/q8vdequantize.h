@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <qnnpack/params.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECLARE_Q8VDEQUANTIZE_FUNCTION(fn_name)                         \
+  void fn_name(                                                         \
+    size_t n,                                                           \
+    const uint8_t* x,                                                   \
+    float* y,                                                           \
+    const union qnnp_f32_dequantization_params* dequantization_params);
+
+DECLARE_Q8VDEQUANTIZE_FUNCTION(q8vdequantize_ukernel__neon)
+DECLARE_Q8VDEQUANTIZE_FUNCTION(q8vdequantize_ukernel__sse2)
+DECLARE_Q8VDEQUANTIZE_FUNCTION(q8vdequantize_ukernel__scalar)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <riscv_vector.h>
+
+#include <qnnpack/params.h>
+
+
+/*
+ * Q31 requantization of up to 8 accumulators with the RISC-V Vector extension, which matches qnnp_q31_requantize:
+ * vsmul with round-to-nearest-up computes (n * multiplier + 2**30) >> 31 without 64-bit lanes, and cannot saturate
+ * because multipliers are below 2**31. The 8 lanes of LMUL=2 need VLEN >= 128, the minimum of the V extension.
+ */
+static inline vuint8mf2_t qnnp_q31_requantize__rvv(
+    vint32m2_t vacc,
+    const union qnnp_q31_requantization_params requantization_params[restrict static 1],
+    size_t vl)
+{
+  const vint32m2_t vq31product =
+    __riscv_vsmul_vx_i32m2(vacc, requantization_params->scalar.multiplier, __RISCV_VXRM_RNU, vl);
+
+  /* Shift right and round half away from zero */
+  const vint32m2_t vremainder = __riscv_vadd_vv_i32m2(
+    __riscv_vand_vx_i32m2(vq31product, requantization_params->scalar.remainder_mask, vl),
+    __riscv_vsra_vx_i32m2(vacc, 31, vl), vl);
+  const vbool16_t vround_up =
+    __riscv_vmsgt_vx_i32m2_b16(vremainder, requantization_params->scalar.remainder_threshold, vl);
+  vint32m2_t vout = __riscv_vsra_vx_i32m2(vq31product, requantization_params->scalar.shift, vl);
+  vout = __riscv_vadd_vx_i32m2_mu(vround_up, vout, vout, 1, vl);
+
+  /* Clamp, add output zero point, and narrow to 8 bits, which no longer saturates */
+  vout = __riscv_vmax_vx_i32m2(vout, requantization_params->scalar.min_less_zero_point, vl);
+  vout = __riscv_vmin_vx_i32m2(vout, requantization_params->scalar.max_less_zero_point, vl);
+  vout = __riscv_vadd_vx_i32m2(vout, requantization_params->scalar.zero_point, vl);
+  const vuint16m1_t vout16 = __riscv_vncvt_x_x_w_u16m1(__riscv_vreinterpret_v_i32m2_u32m2(vout), vl);
+  return __riscv_vncvt_x_x_w_u8mf2(vout16, vl);
+}
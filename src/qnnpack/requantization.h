@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <assert.h>
+#include <math.h>
 
 #include <fp16/bitcasts.h>
 
@@ -47,6 +48,7 @@ static inline union qnnp_q31_requantization_params qnnp_compute_scalar_requantiz
   params.scalar.min_less_zero_point = (int32_t) (uint32_t) min - (int32_t) (uint32_t) zero_point;
   params.scalar.max_less_zero_point = (int32_t) (uint32_t) max - (int32_t) (uint32_t) zero_point;
   params.scalar.zero_point = (int32_t) (uint32_t) zero_point;
+  params.scalar.scale = scale;
   return params;
 }
 
@@ -96,12 +98,17 @@ static inline union qnnp_q31_requantization_params qnnp_compute_requantization_p
       params.sse2.max[i] = max;
       params.sse2.min[i] = min;
     }
+    params.sse2.scale[0] = scale;
+    params.sse2.scale[1] = scale;
+    params.sse2.scale[2] = scale;
+    params.sse2.scale[3] = scale;
   #elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
     params.neon.multiplier = multiplier;
     params.neon.right_shift = -shift;
     params.neon.zero_point = (int16_t) (uint16_t) zero_point;
     params.neon.max = max;
     params.neon.min = min;
+    params.neon.scale = scale;
   #else
     const uint32_t remainder_mask = (UINT32_C(1) << shift) - UINT32_C(1);
     const uint32_t remainder_threshold = remainder_mask >> 1;
@@ -112,6 +119,204 @@ static inline union qnnp_q31_requantization_params qnnp_compute_requantization_p
     params.scalar.min_less_zero_point = (int32_t) (uint32_t) min - (int32_t) (uint32_t) zero_point;
     params.scalar.max_less_zero_point = (int32_t) (uint32_t) max - (int32_t) (uint32_t) zero_point;
     params.scalar.zero_point = (int32_t) (uint32_t) zero_point;
+    params.scalar.scale = scale;
+  #endif
+  return params;
+}
+
+/* Supported range of input to output scale ratios of the add operator, [2**-14, 2**8) */
+#define QNNP_ADD_MIN_OUTPUT_SCALE 6.103515625e-05f
+#define QNNP_ADD_MAX_OUTPUT_SCALE 256.0f
+
+/*
+ * Add quantization parameters scale both inputs by 2**shift, so that the larger multiplier is in [2**21, 2**22).
+ * Every product of an input (less zero point) and a multiplier then fits in 31 bits, and so does their sum.
+ */
+static inline union qnnp_add_quantization_params qnnp_compute_scalar_add_quantization_params(
+  uint8_t a_zero_point,
+  uint8_t b_zero_point,
+  uint8_t output_zero_point,
+  float a_output_scale,
+  float b_output_scale,
+  uint8_t output_min,
+  uint8_t output_max)
+{
+  assert(a_output_scale >= QNNP_ADD_MIN_OUTPUT_SCALE);
+  assert(b_output_scale >= QNNP_ADD_MIN_OUTPUT_SCALE);
+  assert(a_output_scale < QNNP_ADD_MAX_OUTPUT_SCALE);
+  assert(b_output_scale < QNNP_ADD_MAX_OUTPUT_SCALE);
+
+  /* Shift is in [13, 31] range */
+  const float max_output_scale = a_output_scale > b_output_scale ? a_output_scale : b_output_scale;
+  const int32_t max_scale_exponent = (int32_t) (fp32_to_bits(max_output_scale) >> 23) - 127;
+  const uint32_t shift = (uint32_t) (21 - max_scale_exponent);
+  assert(shift >= 13);
+  assert(shift < 32);
+
+  /* Multipliers are in [0, 2**22) range */
+  const float scale_multiplier = fp32_from_bits((uint32_t) (21 - max_scale_exponent + 127) << 23);
+  const uint32_t a_multiplier = (uint32_t) (int32_t) lrintf(a_output_scale * scale_multiplier);
+  const uint32_t b_multiplier = (uint32_t) (int32_t) lrintf(b_output_scale * scale_multiplier);
+  assert(a_multiplier < UINT32_C(0x00400000));
+  assert(b_multiplier < UINT32_C(0x00400000));
+
+  union qnnp_add_quantization_params params;
+  const uint32_t remainder_mask = (UINT32_C(1) << shift) - UINT32_C(1);
+  const uint32_t remainder_threshold = remainder_mask >> 1;
+  params.scalar.zero_point_product =
+    (int32_t) -(a_multiplier * (uint32_t) a_zero_point + b_multiplier * (uint32_t) b_zero_point);
+  params.scalar.a_multiplier = a_multiplier;
+  params.scalar.b_multiplier = b_multiplier;
+  params.scalar.shift = shift;
+  params.scalar.remainder_mask = (int32_t) remainder_mask;
+  params.scalar.remainder_threshold = (int32_t) remainder_threshold;
+  params.scalar.y_zero_point = (int32_t) (uint32_t) output_zero_point;
+  params.scalar.y_max = (int32_t) (uint32_t) output_max;
+  params.scalar.y_min = (int32_t) (uint32_t) output_min;
+  return params;
+}
+
+static inline union qnnp_add_quantization_params qnnp_compute_add_quantization_params(
+  uint8_t a_zero_point,
+  uint8_t b_zero_point,
+  uint8_t output_zero_point,
+  float a_output_scale,
+  float b_output_scale,
+  uint8_t output_min,
+  uint8_t output_max)
+{
+  const union qnnp_add_quantization_params scalar_params = qnnp_compute_scalar_add_quantization_params(
+    a_zero_point, b_zero_point, output_zero_point, a_output_scale, b_output_scale, output_min, output_max);
+
+  union qnnp_add_quantization_params params;
+  #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+    for (uint32_t i = 0; i < 4; i++) {
+      params.sse2.zero_point_product[i] = scalar_params.scalar.zero_point_product;
+      params.sse2.remainder_mask[i] = scalar_params.scalar.remainder_mask;
+      params.sse2.remainder_threshold[i] = scalar_params.scalar.remainder_threshold;
+    }
+    for (uint32_t i = 0; i < 8; i++) {
+      params.sse2.a_multiplier_lo[i] = (uint16_t) scalar_params.scalar.a_multiplier;
+      params.sse2.a_multiplier_hi[i] = (uint16_t) (scalar_params.scalar.a_multiplier >> 16);
+      params.sse2.b_multiplier_lo[i] = (uint16_t) scalar_params.scalar.b_multiplier;
+      params.sse2.b_multiplier_hi[i] = (uint16_t) (scalar_params.scalar.b_multiplier >> 16);
+      params.sse2.y_zero_point[i] = (int16_t) (uint16_t) output_zero_point;
+    }
+    for (uint32_t i = 0; i < 16; i++) {
+      params.sse2.y_max[i] = output_max;
+      params.sse2.y_min[i] = output_min;
+    }
+    params.sse2.shift = scalar_params.scalar.shift;
+  #elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+    params.neon.a_zero_point = a_zero_point;
+    params.neon.b_zero_point = b_zero_point;
+    params.neon.y_zero_point = (int16_t) (uint16_t) output_zero_point;
+    params.neon.a_multiplier = (int32_t) scalar_params.scalar.a_multiplier;
+    params.neon.b_multiplier = (int32_t) scalar_params.scalar.b_multiplier;
+    params.neon.right_shift = -(int32_t) scalar_params.scalar.shift;
+    params.neon.y_max = output_max;
+    params.neon.y_min = output_min;
+  #else
+    params = scalar_params;
+  #endif
+  return params;
+}
+
+/*
+ * Parameters of the q8vrescale microkernels, which requantize a single operand with the A fields of add quantization
+ * parameters. B has the same scale, so the shift and multiplier range are those of A alone.
+ */
+static inline union qnnp_add_quantization_params qnnp_compute_rescale_quantization_params(
+  uint8_t input_zero_point,
+  uint8_t output_zero_point,
+  float input_output_scale,
+  uint8_t output_min,
+  uint8_t output_max)
+{
+  return qnnp_compute_add_quantization_params(
+    input_zero_point, 0, output_zero_point, input_output_scale, input_output_scale, output_min, output_max);
+}
+
+static inline union qnnp_f32_quantization_params qnnp_compute_f32_quantization_params(
+  uint8_t output_zero_point,
+  float output_scale,
+  uint8_t output_min,
+  uint8_t output_max)
+{
+  assert(output_scale > 0.0f);
+  assert(output_min < output_max);
+
+  const float scale = 1.0f / output_scale;
+  const float min_less_zero_point = (float) ((int32_t) (uint32_t) output_min - (int32_t) (uint32_t) output_zero_point);
+  const float max_less_zero_point = (float) ((int32_t) (uint32_t) output_max - (int32_t) (uint32_t) output_zero_point);
+  const float magic = 12582912.0f;
+  const int32_t magic_less_zero_point = (int32_t) fp32_to_bits(magic) - (int32_t) (uint32_t) output_zero_point;
+
+  union qnnp_f32_quantization_params params;
+  #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+    for (uint32_t i = 0; i < 4; i++) {
+      params.sse2.scale[i] = scale;
+      params.sse2.min_less_zero_point[i] = min_less_zero_point;
+      params.sse2.max_less_zero_point[i] = max_less_zero_point;
+      params.sse2.magic[i] = magic;
+      params.sse2.magic_less_zero_point[i] = magic_less_zero_point;
+    }
+  #elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+    params.neon.scale = scale;
+    params.neon.min_less_zero_point = min_less_zero_point;
+    params.neon.max_less_zero_point = max_less_zero_point;
+    params.neon.magic = magic;
+    params.neon.magic_less_zero_point = magic_less_zero_point;
+  #else
+    params.scalar.scale = scale;
+    params.scalar.min_less_zero_point = min_less_zero_point;
+    params.scalar.max_less_zero_point = max_less_zero_point;
+    params.scalar.magic = magic;
+    params.scalar.magic_less_zero_point = magic_less_zero_point;
+  #endif
+  return params;
+}
+
+static inline union qnnp_f32_dequantization_params qnnp_compute_f32_dequantization_params(
+  uint8_t input_zero_point,
+  float input_scale)
+{
+  union qnnp_f32_dequantization_params params;
+  #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+    for (uint32_t i = 0; i < 8; i++) {
+      params.sse2.zero_point[i] = (int16_t) (uint16_t) input_zero_point;
+    }
+    for (uint32_t i = 0; i < 4; i++) {
+      params.sse2.scale[i] = input_scale;
+    }
+  #elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+    params.neon.zero_point = input_zero_point;
+    params.neon.scale = input_scale;
+  #else
+    params.scalar.zero_point = (int32_t) (uint32_t) input_zero_point;
+    params.scalar.scale = input_scale;
+  #endif
+  return params;
+}
+
+static inline union qnnp_u8_clamping_params qnnp_compute_u8_clamping_params(
+  uint8_t output_min,
+  uint8_t output_max)
+{
+  assert(output_min < output_max);
+
+  union qnnp_u8_clamping_params params;
+  #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+    for (uint32_t i = 0; i < 16; i++) {
+      params.sse2.output_max[i] = output_max;
+      params.sse2.output_min[i] = output_min;
+    }
+  #elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+    params.neon.output_max = output_max;
+    params.neon.output_min = output_min;
+  #else
+    params.scalar.output_max = (int32_t) (uint32_t) output_max;
+    params.scalar.output_min = (int32_t) (uint32_t) output_min;
   #endif
   return params;
 }
@@ -133,3 +338,45 @@ static inline uint8_t qnnp_q31_requantize(
 
   return (uint8_t) (n + params.scalar.zero_point);
 }
+
+/* Reference of the FP32 requantization of microkernels for QNNP_CREATE_FLAG_FP32_REQUANTIZATION */
+static inline uint8_t qnnp_fp32_requantize(
+  int32_t n,
+  union qnnp_q31_requantization_params params)
+{
+  /* Rounds to nearest with ties to even in the default rounding mode, like the microkernels */
+  long output = lrintf((float) n * params.scalar.scale);
+  if (output < (long) params.scalar.min_less_zero_point) {
+    output = (long) params.scalar.min_less_zero_point;
+  }
+  if (output > (long) params.scalar.max_less_zero_point) {
+    output = (long) params.scalar.max_less_zero_point;
+  }
+
+  return (uint8_t) ((int32_t) output + params.scalar.zero_point);
+}
+
+static inline uint8_t qnnp_add_quantize(
+  uint8_t a,
+  uint8_t b,
+  union qnnp_add_quantization_params params)
+{
+  /* Multiply by factors and accumulate products */
+  int32_t acc = params.scalar.zero_point_product +
+    (int32_t) ((uint32_t) a * params.scalar.a_multiplier) +
+    (int32_t) ((uint32_t) b * params.scalar.b_multiplier);
+
+  /* Shift right and round half away from zero */
+  const int32_t remainder = (acc & params.scalar.remainder_mask) - (int32_t) (acc < 0);
+  acc = asr_s32(acc, params.scalar.shift) + (int32_t) (remainder > params.scalar.remainder_threshold);
+
+  /* Add output zero point and clamp */
+  int32_t y = acc + params.scalar.y_zero_point;
+  if (y > params.scalar.y_max) {
+    y = params.scalar.y_max;
+  }
+  if (y < params.scalar.y_min) {
+    y = params.scalar.y_min;
+  }
+  return (uint8_t) y;
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+
+enum qnnp_loop_type {
+  qnnp_loop_type_1d,
+  qnnp_loop_type_1d_tiled,
+  qnnp_loop_type_2d,
+  qnnp_loop_type_2d_tiled,
+  qnnp_loop_type_3d_tiled,
+  qnnp_loop_type_4d_tiled,
+};
+
+/*
+ * Parallel loop of an operator with a qnnp_scheduler, flattened into one task per tile. Loops of fewer than 4
+ * dimensions use the inner ones, and the outer ones have range and tile 1.
+ */
+struct qnnp_scheduled_loop {
+  enum qnnp_loop_type type;
+  union {
+    pthreadpool_function_1d_t function_1d;
+    pthreadpool_function_1d_tiled_t function_1d_tiled;
+    pthreadpool_function_2d_t function_2d;
+    pthreadpool_function_2d_tiled_t function_2d_tiled;
+    pthreadpool_function_3d_tiled_t function_3d_tiled;
+    pthreadpool_function_4d_tiled_t function_4d_tiled;
+  };
+  void* argument;
+  size_t range[4];
+  size_t tile[4];
+  size_t tiles[4];
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Runs the tasks of the loop with the scheduler of the operator */
+void qnnp_run_scheduled_loop(const struct qnnp_operator* op, struct qnnp_scheduled_loop* loop);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/* Number of threads that run the parallel loops of the operator, which operators size their tasks for */
+static inline size_t qnnp_get_threads_count(const struct qnnp_operator* op, pthreadpool_t threadpool) {
+  if (op->scheduler.parallelize != NULL) {
+    return op->scheduler.threads_count;
+  }
+  return pthreadpool_get_threads_count(threadpool);
+}
+
+/*
+ * Parallel loops of an operator: on its qnnp_scheduler if it has one, and on the thread pool otherwise. They have the
+ * semantics of the pthreadpool_compute functions.
+ */
+static inline void qnnp_parallelize_1d(
+    const struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_1d_t function,
+    void* argument,
+    size_t range)
+{
+  if (op->scheduler.parallelize != NULL) {
+    struct qnnp_scheduled_loop loop = {
+      .type = qnnp_loop_type_1d,
+      .function_1d = function,
+      .argument = argument,
+      .range = { 1, 1, 1, range },
+      .tile = { 1, 1, 1, 1 },
+    };
+    qnnp_run_scheduled_loop(op, &loop);
+  } else {
+    pthreadpool_compute_1d(threadpool, function, argument, range);
+  }
+}
+
+static inline void qnnp_parallelize_1d_tiled(
+    const struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_1d_tiled_t function,
+    void* argument,
+    size_t range,
+    size_t tile)
+{
+  if (op->scheduler.parallelize != NULL) {
+    struct qnnp_scheduled_loop loop = {
+      .type = qnnp_loop_type_1d_tiled,
+      .function_1d_tiled = function,
+      .argument = argument,
+      .range = { 1, 1, 1, range },
+      .tile = { 1, 1, 1, tile },
+    };
+    qnnp_run_scheduled_loop(op, &loop);
+  } else {
+    pthreadpool_compute_1d_tiled(threadpool, function, argument, range, tile);
+  }
+}
+
+static inline void qnnp_parallelize_2d(
+    const struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_2d_t function,
+    void* argument,
+    size_t range_i, size_t range_j)
+{
+  if (op->scheduler.parallelize != NULL) {
+    struct qnnp_scheduled_loop loop = {
+      .type = qnnp_loop_type_2d,
+      .function_2d = function,
+      .argument = argument,
+      .range = { 1, 1, range_i, range_j },
+      .tile = { 1, 1, 1, 1 },
+    };
+    qnnp_run_scheduled_loop(op, &loop);
+  } else {
+    pthreadpool_compute_2d(threadpool, function, argument, range_i, range_j);
+  }
+}
+
+static inline void qnnp_parallelize_2d_tiled(
+    const struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_2d_tiled_t function,
+    void* argument,
+    size_t range_i, size_t range_j,
+    size_t tile_i, size_t tile_j)
+{
+  if (op->scheduler.parallelize != NULL) {
+    struct qnnp_scheduled_loop loop = {
+      .type = qnnp_loop_type_2d_tiled,
+      .function_2d_tiled = function,
+      .argument = argument,
+      .range = { 1, 1, range_i, range_j },
+      .tile = { 1, 1, tile_i, tile_j },
+    };
+    qnnp_run_scheduled_loop(op, &loop);
+  } else {
+    pthreadpool_compute_2d_tiled(threadpool, function, argument, range_i, range_j, tile_i, tile_j);
+  }
+}
+
+static inline void qnnp_parallelize_3d_tiled(
+    const struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_3d_tiled_t function,
+    void* argument,
+    size_t range_i, size_t range_j, size_t range_k,
+    size_t tile_i, size_t tile_j, size_t tile_k)
+{
+  if (op->scheduler.parallelize != NULL) {
+    struct qnnp_scheduled_loop loop = {
+      .type = qnnp_loop_type_3d_tiled,
+      .function_3d_tiled = function,
+      .argument = argument,
+      .range = { 1, range_i, range_j, range_k },
+      .tile = { 1, tile_i, tile_j, tile_k },
+    };
+    qnnp_run_scheduled_loop(op, &loop);
+  } else {
+    pthreadpool_compute_3d_tiled(threadpool, function, argument, range_i, range_j, range_k, tile_i, tile_j, tile_k);
+  }
+}
+
+static inline void qnnp_parallelize_4d_tiled(
+    const struct qnnp_operator* op,
+    pthreadpool_t threadpool,
+    pthreadpool_function_4d_tiled_t function,
+    void* argument,
+    size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+    size_t tile_i, size_t tile_j, size_t tile_k, size_t tile_l)
+{
+  if (op->scheduler.parallelize != NULL) {
+    struct qnnp_scheduled_loop loop = {
+      .type = qnnp_loop_type_4d_tiled,
+      .function_4d_tiled = function,
+      .argument = argument,
+      .range = { range_i, range_j, range_k, range_l },
+      .tile = { tile_i, tile_j, tile_k, tile_l },
+    };
+    qnnp_run_scheduled_loop(op, &loop);
+  } else {
+    pthreadpool_compute_4d_tiled(
+      threadpool, function, argument,
+      range_i, range_j, range_k, range_l, tile_i, tile_j, tile_k, tile_l);
+  }
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <qnnpack/params.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECLARE_SCONV_UKERNEL_FUNCTION(fn_name)                 \
+  void fn_name(                                                 \
+      size_t mr,                                                \
+      size_t nr,                                                \
+      size_t kc,                                                \
+      size_t ks,                                                \
+      const float** a,                                          \
+      const float* b,                                           \
+      const float* bias,                                        \
+      float* c,                                                 \
+      size_t c_stride,                                          \
+      const struct qnnp_fp32_clamping_params* clamping_params);
+
+DECLARE_SCONV_UKERNEL_FUNCTION(sconv_ukernel_6x8__psimd)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+
+/* Indirection buffer of an earlier setup, see qnnp_set_operator_setup_cache */
+struct qnnp_setup_cache_entry {
+  size_t batch_size;
+  size_t input_height;
+  size_t input_width;
+  size_t input_pixel_stride;
+  const void** im2col_buffer;
+  size_t im2col_buffer_size;
+  /* Input the entries of im2col_buffer point into, as in struct qnnp_operator */
+  const void* indirection_input;
+  bool indirection_offsets;
+  /* Value of the cache clock when the entry was stored, the smallest is the least recently used */
+  uint64_t last_use;
+};
+
+struct qnnp_setup_cache {
+  struct qnnp_setup_cache_entry* entries;
+  size_t entries_count;
+  size_t entries_capacity;
+  /* Bytes of the cached indirection buffers, at most max_size */
+  size_t size;
+  size_t max_size;
+  uint64_t clock;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Moves the indirection buffer of the last setup of the operator, of im2col_buffer_size bytes and built for
+ * indirection_input, into its setup cache, evicting the least recently used entries beyond the size limit. The
+ * operator is left without indirection buffer.
+ */
+void qnnp_setup_cache_store(struct qnnp_operator* op, size_t im2col_buffer_size, const void* indirection_input);
+
+/*
+ * Moves the cached indirection buffer for the shape into the operator, in place of its im2col_buffer, with the input
+ * it was built for in indirection_input. Returns false if the cache has no entry for the shape.
+ */
+bool qnnp_setup_cache_restore(
+    struct qnnp_operator* op,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t input_pixel_stride);
+
+void qnnp_delete_setup_cache(struct qnnp_setup_cache* cache);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <qnnpack/params.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECLARE_U8BILINEAR_UKERNEL_FUNCTION(fn_name)                    \
+  void fn_name(                                                         \
+    size_t output_width,                                                \
+    size_t channels,                                                    \
+    const uint8_t* top,                                                 \
+    const uint8_t* bottom,                                              \
+    size_t input_pixel_stride,                                          \
+    const uint32_t* columns,                                            \
+    const int16_t* column_weights,                                      \
+    int16_t row_weight,                                                 \
+    uint8_t* output,                                                    \
+    size_t output_pixel_stride);
+
+DECLARE_U8BILINEAR_UKERNEL_FUNCTION(u8bilinear_ukernel__neon)
+DECLARE_U8BILINEAR_UKERNEL_FUNCTION(u8bilinear_ukernel__sse2)
+DECLARE_U8BILINEAR_UKERNEL_FUNCTION(u8bilinear_ukernel__scalar)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
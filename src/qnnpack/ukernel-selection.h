@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cpuinfo.h>
+
+#include <qnnpack/convolution.h>
+#include <qnnpack/math.h>
+#include <qnnpack/packed-weights.h>
+#include <qnnpack/params.h>
+
+
+/*
+ * Picks the GEMM/convolution microkernel for a group of k input and n output channels. The work of a microkernel
+ * is proportional to its padded K x N panel divided by its throughput; ties go to the preferred (earlier) variant.
+ */
+static inline struct q8conv_parameters qnnp_select_q8conv_parameters(size_t k, size_t n) {
+  const struct q8conv_variant* best_variant = &qnnp_params.q8conv_variants[0];
+  uint64_t best_work = (uint64_t) round_up(k, best_variant->parameters.kr) * round_up(n, best_variant->parameters.nr);
+  for (uint32_t i = 1; i < qnnp_params.q8conv_variants_count; i++) {
+    const struct q8conv_variant* variant = &qnnp_params.q8conv_variants[i];
+    const uint64_t work = (uint64_t) round_up(k, variant->parameters.kr) * round_up(n, variant->parameters.nr);
+    /* work / throughput < best_work / best_throughput, without division */
+    if (work * best_variant->throughput < best_work * variant->throughput) {
+      best_variant = variant;
+      best_work = work;
+    }
+  }
+  return best_variant->parameters;
+}
+
+/*
+ * Picks the fastest GEMM/convolution microkernel with an nr x kr tile, for weights that were packed for that tile.
+ * Returns false if no such microkernel is available.
+ */
+static inline bool qnnp_select_q8conv_parameters_for_tile(
+    uint32_t nr,
+    uint32_t kr,
+    struct q8conv_parameters parameters[restrict static 1])
+{
+  const struct q8conv_variant* best_variant = NULL;
+  for (uint32_t i = 0; i < qnnp_params.q8conv_variants_count; i++) {
+    const struct q8conv_variant* variant = &qnnp_params.q8conv_variants[i];
+    if (variant->parameters.nr == nr && variant->parameters.kr == kr &&
+        (best_variant == NULL || variant->throughput > best_variant->throughput))
+    {
+      best_variant = variant;
+    }
+  }
+  if (best_variant == NULL) {
+    return false;
+  }
+  *parameters = best_variant->parameters;
+  return true;
+}
+
+/*
+ * Switches to the microkernels for signed packed weights if the weights use them: new weights are packed as signed
+ * when the kernel zero point is 128, i.e. for int8 weights with zero point 0 stored as kernel ^ 0x80, and the tile
+ * has such microkernels, while existing packed weights keep the packing they were created with.
+ * Returns false if existing weights are signed but the tile has no microkernels for them.
+ */
+static inline bool qnnp_select_q8conv_signed_kernel(
+    uint8_t kernel_zero_point,
+    const struct qnnp_packed_weights* packed_weights,
+    struct q8conv_parameters parameters[restrict static 1],
+    uint32_t flags[restrict static 1])
+{
+  const bool signed_kernel = packed_weights != NULL ?
+    (packed_weights->flags & QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL) != 0 :
+    kernel_zero_point == 128 && parameters->signed_gemm != NULL;
+  if (signed_kernel) {
+    if (parameters->signed_gemm == NULL) {
+      return false;
+    }
+    parameters->gemm = parameters->signed_gemm;
+    parameters->conv = parameters->signed_conv;
+    /* There are no single-row microkernels for signed packed weights */
+    parameters->gemv = NULL;
+    parameters->gemv_acc32 = NULL;
+    *flags |= QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL;
+  }
+  return true;
+}
+
+/*
+ * Switches to the microkernels for biases with the input zero point folded in, see
+ * QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT, if the flag asks for them and the tile has them, while existing packed
+ * weights keep the packing they were created with. Signed packed weights already fold the input zero point.
+ * Returns false if existing weights are folded but the tile has no microkernels for them.
+ */
+static inline bool qnnp_select_q8conv_folded_zero_point(
+    uint32_t create_flags,
+    const struct qnnp_packed_weights* packed_weights,
+    struct q8conv_parameters parameters[restrict static 1],
+    uint32_t flags[restrict static 1])
+{
+  const bool folded = packed_weights != NULL ?
+    (packed_weights->flags & QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT) != 0 :
+    (create_flags & QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT) != 0 && parameters->folded_gemm != NULL &&
+      !(*flags & QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL);
+  if (folded) {
+    if (parameters->folded_gemm == NULL) {
+      return false;
+    }
+    parameters->gemm = parameters->folded_gemm;
+    parameters->conv = parameters->folded_conv;
+    /* There are no single-row microkernels for folded biases */
+    parameters->gemv = NULL;
+    parameters->gemv_acc32 = NULL;
+    *flags |= QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT;
+  }
+  return true;
+}
+
+/*
+ * Switches to the microkernels that skip the clamps of the epilogue the output range makes redundant: the upper clamp
+ * for output_max = 255, e.g. for ReLU outputs with output_min at the output zero point, and both for the full range.
+ * Signed, folded, and 16-bit accumulation microkernels keep both clamps, so this runs after their selection.
+ */
+static inline void qnnp_select_q8conv_output_clamp(
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    struct q8conv_parameters parameters[restrict static 1])
+{
+  if (output_max != UINT8_MAX ||
+      (flags & (QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL | QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT)))
+  {
+    return;
+  }
+  q8gemm_ukernel_function gemm = parameters->relu_gemm;
+  q8conv_ukernel_function conv = parameters->relu_conv;
+  if (output_min == 0 && parameters->unclamped_gemm != NULL) {
+    gemm = parameters->unclamped_gemm;
+    conv = parameters->unclamped_conv;
+  }
+  if (gemm == NULL) {
+    return;
+  }
+  if (!(flags & QNNP_CONVOLUTION_FLAG_ACC16)) {
+    parameters->gemm = gemm;
+  }
+  parameters->conv = conv;
+}
+
+/*
+ * Switches a convolution on the convolution microkernels to XZP, see QNNP_CONVOLUTION_FLAG_XZP_CONV, if its taps have
+ * at least q8conv_xzp_parameters::conv_kthreshold channels and the tile has the microkernel, while existing packed
+ * weights keep the packing they were created with. Signed kernels and folded biases already save the zero point
+ * subtractions of one operand. Returns false if existing weights are packed for XZP but the tile has no microkernel.
+ */
+static inline bool qnnp_select_q8conv_xzp_conv(
+    size_t tap_channels,
+    const struct qnnp_packed_weights* packed_weights,
+    const struct q8conv_parameters parameters[restrict static 1],
+    uint32_t flags[restrict static 1])
+{
+  const bool supported = parameters->xzp_conv != NULL && qnnp_params.q8sum_rows.conv_sum_rows != NULL &&
+    parameters->mr == qnnp_params.q8sum_rows.m;
+  const bool xzp = packed_weights != NULL ?
+    (packed_weights->flags & QNNP_CONVOLUTION_FLAG_XZP_CONV) != 0 :
+    supported && tap_channels >= qnnp_params.q8conv_xzp.conv_kthreshold &&
+      !(*flags & (QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL | QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT));
+  if (xzp) {
+    if (!supported) {
+      return false;
+    }
+    *flags |= QNNP_CONVOLUTION_FLAG_XZP_CONV;
+  }
+  return true;
+}
+
+/*
+ * Switches to the GEMM microkernel with 16-bit accumulators if the kernel of rows x k values cannot overflow them,
+ * see QNNP_CONVOLUTION_FLAG_ACC16, while existing packed weights keep the choice they were created with. The bound
+ * follows from the zero points and the kernel itself: inputs are at most max(input_zero_point, 255 - input_zero_point)
+ * from their zero point, so a row whose absolute deviations from the kernel zero point sum to at most INT16_MAX over
+ * that distance has every dot product in int16_t. Convolution and single-row microkernels keep 32-bit accumulators.
+ * Returns false if existing weights use 16-bit accumulators but the tile has no microkernel for them.
+ */
+static inline bool qnnp_select_q8conv_acc16(
+    size_t rows,
+    size_t k,
+    const uint8_t* kernel,
+    uint8_t input_zero_point,
+    uint8_t kernel_zero_point,
+    const struct qnnp_packed_weights* packed_weights,
+    struct q8conv_parameters parameters[restrict static 1],
+    uint32_t flags[restrict static 1])
+{
+  bool acc16 = false;
+  if (packed_weights != NULL) {
+    acc16 = (packed_weights->flags & QNNP_CONVOLUTION_FLAG_ACC16) != 0;
+    if (acc16 && parameters->acc16_gemm == NULL) {
+      return false;
+    }
+  } else if (parameters->acc16_gemm != NULL &&
+             !(*flags & (QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL | QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT)))
+  {
+    const uint32_t max_input_distance = (uint32_t) max(input_zero_point, UINT8_MAX - input_zero_point);
+    const uint32_t max_row_distance = INT16_MAX / max_input_distance;
+    acc16 = true;
+    for (size_t row = 0; acc16 && row < rows; row++) {
+      uint32_t row_distance = 0;
+      for (size_t i = 0; i < k; i++) {
+        const int32_t distance = (int32_t) kernel[row * k + i] - (int32_t) kernel_zero_point;
+        row_distance += (uint32_t) (distance >= 0 ? distance : -distance);
+        if (row_distance > max_row_distance) {
+          acc16 = false;
+          break;
+        }
+      }
+    }
+  }
+  if (acc16) {
+    parameters->gemm = parameters->acc16_gemm;
+    *flags |= QNNP_CONVOLUTION_FLAG_ACC16;
+  }
+  return true;
+}
+
+/*
+ * Switches to the microkernels with FP32 requantization, see QNNP_CREATE_FLAG_FP32_REQUANTIZATION. Their tile may
+ * differ from the one of the default microkernels, so existing packed weights must have been packed for it.
+ * Returns false if there are no such microkernels, or they do not support the tile of existing packed weights.
+ */
+static inline bool qnnp_select_q8conv_fp32_requantization(
+    const struct qnnp_packed_weights* packed_weights,
+    struct q8conv_parameters parameters[restrict static 1],
+    uint32_t flags[restrict static 1])
+{
+  const struct q8conv_parameters* fp32_parameters = &qnnp_params.q8conv_fp32;
+  if (fp32_parameters->gemm == NULL) {
+    return false;
+  }
+  if (packed_weights != NULL &&
+      (packed_weights->nr != fp32_parameters->nr || packed_weights->kr != fp32_parameters->kr))
+  {
+    return false;
+  }
+  *parameters = *fp32_parameters;
+  *flags |= QNNP_CONVOLUTION_FLAG_FP32_REQUANTIZATION;
+  return true;
+}
+
+/*
+ * Whether a 1x1 GEMM of a single group uses the block-sparse microkernel, see QNNP_CONVOLUTION_FLAG_SPARSE: new
+ * weights do if the caller requested it with QNNP_CREATE_FLAG_SPARSE_KERNEL, there is such a microkernel, and there are
+ * enough input channels for a whole block, while existing packed weights keep the format they were created with.
+ */
+static inline bool qnnp_use_q8gemm_sparse(
+    uint32_t create_flags,
+    const struct qnnp_packed_weights* packed_weights,
+    size_t input_channels)
+{
+  if (packed_weights != NULL) {
+    return (packed_weights->flags & QNNP_CONVOLUTION_FLAG_SPARSE) != 0;
+  }
+  return (create_flags & QNNP_CREATE_FLAG_SPARSE_KERNEL) != 0 && qnnp_params.q8gemm_sparse.gemm != NULL &&
+    input_channels >= QNNP_SPARSE_BLOCK_SIZE;
+}
+
+/*
+ * Describes the tile of the block-sparse microkernel with GEMM parameters that have no microkernels of their own:
+ * qnnp_run_operator calls qnnp_params.q8gemm_sparse.gemm instead, and neither signed packed weights, 16-bit
+ * accumulators, nor the single-row microkernels apply. Returns false if there is no such microkernel, or it does not
+ * support the tile of existing packed weights.
+ */
+static inline bool qnnp_select_q8gemm_sparse(
+    const struct qnnp_packed_weights* packed_weights,
+    struct q8conv_parameters parameters[restrict static 1])
+{
+  const struct q8gemm_sparse_parameters* sparse_parameters = &qnnp_params.q8gemm_sparse;
+  if (sparse_parameters->gemm == NULL) {
+    return false;
+  }
+  if (packed_weights != NULL &&
+      (packed_weights->nr != sparse_parameters->nr || packed_weights->kr != QNNP_SPARSE_BLOCK_SIZE))
+  {
+    return false;
+  }
+  *parameters = (struct q8conv_parameters) {
+    .name = sparse_parameters->name,
+    .mr = sparse_parameters->mr,
+    .nr = sparse_parameters->nr,
+    .kr = QNNP_SPARSE_BLOCK_SIZE,
+  };
+  return true;
+}
+
+/*
+ * Whether a fully-connected operator uses the microkernels for 4-bit packed weights, see QNNP_CONVOLUTION_FLAG_4BIT:
+ * new weights do if the caller requested it with QNNP_CREATE_FLAG_4BIT_KERNEL and there are such microkernels, while
+ * existing packed weights keep the format they were created with.
+ */
+static inline bool qnnp_use_q8gemm_4bit(uint32_t create_flags, const struct qnnp_packed_weights* packed_weights) {
+  if (packed_weights != NULL) {
+    return (packed_weights->flags & QNNP_CONVOLUTION_FLAG_4BIT) != 0;
+  }
+  return (create_flags & QNNP_CREATE_FLAG_4BIT_KERNEL) != 0 && qnnp_params.q8conv_4bit.gemm != NULL;
+}
+
+/*
+ * Switches to the microkernels for 4-bit packed weights. They have no signed, 16-bit accumulator, or split-K variants.
+ * Returns false if there are no such microkernels, or they do not support the tile of existing packed weights.
+ */
+static inline bool qnnp_select_q8conv_4bit(
+    const struct qnnp_packed_weights* packed_weights,
+    struct q8conv_parameters parameters[restrict static 1],
+    uint32_t flags[restrict static 1])
+{
+  const struct q8conv_parameters* parameters_4bit = &qnnp_params.q8conv_4bit;
+  if (parameters_4bit->gemm == NULL) {
+    return false;
+  }
+  if (packed_weights != NULL &&
+      (packed_weights->nr != parameters_4bit->nr || packed_weights->kr != parameters_4bit->kr))
+  {
+    return false;
+  }
+  *parameters = *parameters_4bit;
+  *flags |= QNNP_CONVOLUTION_FLAG_4BIT;
+  return true;
+}
+
+/* Microkernels of a GEMM/convolution pair for every microarchitecture, indexed by qnnp_get_current_uarch_index() */
+struct q8conv_uarch_ukernels {
+  q8gemm_ukernel_function gemm[QNNP_MAX_UARCHES];
+  q8conv_ukernel_function conv[QNNP_MAX_UARCHES];
+};
+
+static inline struct q8conv_uarch_ukernels qnnp_get_q8conv_uarch_ukernels(
+    const struct q8conv_parameters parameters[restrict static 1])
+{
+  struct q8conv_uarch_ukernels ukernels;
+  for (uint32_t i = 0; i < QNNP_MAX_UARCHES; i++) {
+    ukernels.gemm[i] = parameters->gemm;
+    ukernels.conv[i] = parameters->conv;
+  }
+  for (uint32_t i = 0; i < qnnp_params.q8conv_uarch_overrides_count; i++) {
+    const struct q8conv_uarch_override* override = &qnnp_params.q8conv_uarch_overrides[i];
+    if (override->gemm == parameters->gemm) {
+      ukernels.gemm[override->uarch_index] = override->uarch_gemm;
+      ukernels.conv[override->uarch_index] = override->uarch_conv;
+    }
+  }
+  return ukernels;
+}
+
+/*
+ * Index of the microarchitecture of the core the calling thread runs on. Threads can migrate at any time, so the
+ * result is only a hint, but any microkernel is correct on any core.
+ */
+static inline uint32_t qnnp_get_current_uarch_index(void) {
+  if (qnnp_params.uarchs_count <= 1) {
+    return 0;
+  }
+  const uint32_t uarch_index = cpuinfo_get_current_uarch_index();
+  return uarch_index < QNNP_MAX_UARCHES ? uarch_index : 0;
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <qnnpack/params.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECLARE_X8LUT_UKERNEL_FUNCTION(fn_name)                         \
+  void fn_name(                                                         \
+    size_t n,                                                           \
+    const uint8_t* x,                                                   \
+    const uint8_t* t,                                                   \
+    uint8_t* y);
+
+DECLARE_X8LUT_UKERNEL_FUNCTION(x8lut_ukernel__scalar)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <qnnpack/params.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECLARE_X8ZIPC_FUNCTION(fn_name)                                \
+  void fn_name(                                                         \
+    size_t n,                                                           \
+    const void* x,                                                      \
+    void* y);
+
+DECLARE_X8ZIPC_FUNCTION(x8zip_ukernel_x2__neon)
+DECLARE_X8ZIPC_FUNCTION(x8zip_ukernel_x3__neon)
+DECLARE_X8ZIPC_FUNCTION(x8zip_ukernel_x4__neon)
+DECLARE_X8ZIPC_FUNCTION(x8zip_ukernel_x2__sse2)
+DECLARE_X8ZIPC_FUNCTION(x8zip_ukernel_x3__sse2)
+DECLARE_X8ZIPC_FUNCTION(x8zip_ukernel_x4__sse2)
+DECLARE_X8ZIPC_FUNCTION(x8zip_ukernel_x2__scalar)
+DECLARE_X8ZIPC_FUNCTION(x8zip_ukernel_x3__scalar)
+DECLARE_X8ZIPC_FUNCTION(x8zip_ukernel_x4__scalar)
+
+#define DECLARE_X8ZIPV_FUNCTION(fn_name)                                \
+  void fn_name(                                                         \
+    size_t n,                                                           \
+    size_t m,                                                           \
+    const void* x,                                                      \
+    void* y);
+
+DECLARE_X8ZIPV_FUNCTION(x8zip_ukernel_xm__neon)
+DECLARE_X8ZIPV_FUNCTION(x8zip_ukernel_xm__sse2)
+DECLARE_X8ZIPV_FUNCTION(x8zip_ukernel_xm__scalar)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+
+/* Run of an operator, or of a plan if plan is not NULL */
+struct qnnp_queue_job {
+  struct qnnp_queue_job* next;
+  qnnp_operator_t op;
+  qnnp_plan_t plan;
+  const uint8_t* input;
+  uint8_t* output;
+  qnnp_completion_callback callback;
+  void* context;
+};
+
+struct qnnp_queue {
+  pthreadpool_t threadpool;
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  /* Signaled when a job is submitted or the queue shuts down */
+  pthread_cond_t submitted;
+  /* Signaled when the last pending job completed */
+  pthread_cond_t idle;
+  struct qnnp_queue_job* first_job;
+  struct qnnp_queue_job* last_job;
+  /* Jobs submitted and not yet completed, including the one that runs */
+  size_t pending_jobs;
+  bool shutdown;
+};
+
+static void* run_queue(void* argument) {
+  struct qnnp_queue* queue = (struct qnnp_queue*) argument;
+  pthread_mutex_lock(&queue->mutex);
+  for (;;) {
+    while (queue->first_job == NULL && !queue->shutdown) {
+      pthread_cond_wait(&queue->submitted, &queue->mutex);
+    }
+    struct qnnp_queue_job* job = queue->first_job;
+    if (job == NULL) {
+      break;
+    }
+    queue->first_job = job->next;
+    if (queue->first_job == NULL) {
+      queue->last_job = NULL;
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    enum qnnp_status status;
+    if (job->plan != NULL) {
+      status = qnnp_plan_run(job->plan, job->input, job->output, queue->threadpool);
+    } else {
+      status = qnnp_run_operator(job->op, queue->threadpool);
+    }
+    if (job->callback != NULL) {
+      job->callback(job->context, status);
+    }
+    free(job);
+
+    pthread_mutex_lock(&queue->mutex);
+    if (--queue->pending_jobs == 0) {
+      pthread_cond_broadcast(&queue->idle);
+    }
+  }
+  pthread_mutex_unlock(&queue->mutex);
+  return NULL;
+}
+
+enum qnnp_status qnnp_create_queue(
+    pthreadpool_t threadpool,
+    qnnp_queue_t* queue_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_queue failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  struct qnnp_queue* queue = calloc(1, sizeof(struct qnnp_queue));
+  if (queue == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_queue structure", sizeof(struct qnnp_queue));
+    return qnnp_status_out_of_memory;
+  }
+  queue->threadpool = threadpool;
+  pthread_mutex_init(&queue->mutex, NULL);
+  pthread_cond_init(&queue->submitted, NULL);
+  pthread_cond_init(&queue->idle, NULL);
+
+  const int error = pthread_create(&queue->thread, NULL, run_queue, queue);
+  if (error != 0) {
+    qnnp_log_error("failed to create dispatch thread of qnnp_queue: error %d", error);
+    pthread_cond_destroy(&queue->idle);
+    pthread_cond_destroy(&queue->submitted);
+    pthread_mutex_destroy(&queue->mutex);
+    free(queue);
+    return qnnp_status_out_of_memory;
+  }
+
+  *queue_out = queue;
+  return qnnp_status_success;
+}
+
+static enum qnnp_status submit_job(struct qnnp_queue* queue, const struct qnnp_queue_job* job_template) {
+  struct qnnp_queue_job* job = malloc(sizeof(struct qnnp_queue_job));
+  if (job == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_queue job", sizeof(struct qnnp_queue_job));
+    return qnnp_status_out_of_memory;
+  }
+  *job = *job_template;
+  job->next = NULL;
+
+  pthread_mutex_lock(&queue->mutex);
+  if (queue->last_job != NULL) {
+    queue->last_job->next = job;
+  } else {
+    queue->first_job = job;
+  }
+  queue->last_job = job;
+  queue->pending_jobs++;
+  pthread_cond_signal(&queue->submitted);
+  pthread_mutex_unlock(&queue->mutex);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_run_operator_async(
+    qnnp_operator_t op,
+    qnnp_queue_t queue,
+    qnnp_completion_callback callback,
+    void* context)
+{
+  if (op == NULL || queue == NULL) {
+    qnnp_log_error("failed to submit operator run: operator and queue must be non-NULL");
+    return qnnp_status_invalid_parameter;
+  }
+
+  const struct qnnp_queue_job job = {
+    .op = op,
+    .callback = callback,
+    .context = context,
+  };
+  return submit_job(queue, &job);
+}
+
+enum qnnp_status qnnp_plan_run_async(
+    qnnp_plan_t plan,
+    const uint8_t* input,
+    uint8_t* output,
+    qnnp_queue_t queue,
+    qnnp_completion_callback callback,
+    void* context)
+{
+  if (plan == NULL || queue == NULL) {
+    qnnp_log_error("failed to submit plan run: plan and queue must be non-NULL");
+    return qnnp_status_invalid_parameter;
+  }
+
+  const struct qnnp_queue_job job = {
+    .plan = plan,
+    .input = input,
+    .output = output,
+    .callback = callback,
+    .context = context,
+  };
+  return submit_job(queue, &job);
+}
+
+enum qnnp_status qnnp_wait_queue(qnnp_queue_t queue)
+{
+  if (queue == NULL) {
+    return qnnp_status_invalid_parameter;
+  }
+
+  pthread_mutex_lock(&queue->mutex);
+  while (queue->pending_jobs != 0) {
+    pthread_cond_wait(&queue->idle, &queue->mutex);
+  }
+  pthread_mutex_unlock(&queue->mutex);
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_delete_queue(qnnp_queue_t queue)
+{
+  if (queue != NULL) {
+    /* The dispatch thread drains the submitted jobs before it exits */
+    pthread_mutex_lock(&queue->mutex);
+    queue->shutdown = true;
+    pthread_cond_signal(&queue->submitted);
+    pthread_mutex_unlock(&queue->mutex);
+    pthread_join(queue->thread, NULL);
+
+    pthread_cond_destroy(&queue->idle);
+    pthread_cond_destroy(&queue->submitted);
+    pthread_mutex_destroy(&queue->mutex);
+    free(queue);
+    return qnnp_status_success;
+  }
+  return qnnp_status_invalid_parameter;
+}
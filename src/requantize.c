@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+#include <qnnpack/requantization.h>
+
+
+enum qnnp_status qnnp_create_requantize_nc_q8(
+    size_t channels,
+    uint8_t input_zero_point,
+    float input_scale,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint8_t output_min,
+    uint8_t output_max,
+    uint32_t flags,
+    qnnp_operator_t* requantize_out)
+{
+  qnnp_operator_t requantize_op = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_requantize_nc_q8 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (channels == 0) {
+    qnnp_log_error(
+      "failed to create requantize operator with %zu channels: number of channels must be non-zero", channels);
+    goto error;
+  }
+
+  if (!(input_scale > 0.0f && isnormal(input_scale)) || !(output_scale > 0.0f && isnormal(output_scale))) {
+    qnnp_log_error(
+      "failed to create requantize operator with %.7g input scale and %.7g output scale: "
+      "scales must be finite, normalized, and positive",
+      input_scale, output_scale);
+    goto error;
+  }
+
+  if (output_min >= output_max) {
+    qnnp_log_error(
+      "failed to create requantize operator with [%" PRIu8 ", %" PRIu8 "] output range: "
+      "range min must be below range max",
+      output_min, output_max);
+    goto error;
+  }
+
+  status = qnnp_status_unsupported_parameter;
+
+  const float input_output_scale = input_scale / output_scale;
+  if (input_output_scale < QNNP_ADD_MIN_OUTPUT_SCALE || input_output_scale >= QNNP_ADD_MAX_OUTPUT_SCALE) {
+    qnnp_log_error(
+      "failed to create requantize operator with %.7g input-to-output scale ratio: "
+      "scale ratio must be in [2**-14, 2**8) range",
+      input_output_scale);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  requantize_op = calloc(1, sizeof(struct qnnp_operator));
+  if (requantize_op == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  requantize_op->channels = channels;
+  requantize_op->add_quantization_params =
+    qnnp_compute_rescale_quantization_params(
+      input_zero_point, output_zero_point, input_output_scale, output_min, output_max);
+  requantize_op->input_zero_point = input_zero_point;
+  requantize_op->output_zero_point = output_zero_point;
+  requantize_op->output_min = output_min;
+  requantize_op->output_max = output_max;
+
+  requantize_op->type = qnnp_operator_type_requantize;
+  requantize_op->format = qnnp_format_quint8;
+
+  *requantize_out = requantize_op;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(requantize_op);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_requantize_nc_q8(
+    qnnp_operator_t requantize_op,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_requantize_nc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (requantize_op->type != qnnp_operator_type_requantize) {
+    qnnp_log_error("failed to setup requantize operator: operator was not created by qnnp_create_requantize_nc_q8");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error(
+      "failed to setup requantize operator with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t channels = requantize_op->channels;
+  if (input_stride < channels || output_stride < channels) {
+    qnnp_log_error(
+      "failed to setup requantize operator with %zu input and %zu output strides: "
+      "strides must be at least the %zu channels",
+      input_stride, output_stride, channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  requantize_op->batch_size = batch_size;
+  requantize_op->input = input;
+  requantize_op->input_pixel_stride = input_stride;
+  requantize_op->output = output;
+  requantize_op->output_pixel_stride = output_stride;
+
+  return qnnp_status_success;
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/allocator.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/math.h>
+#include <qnnpack/params.h>
+
+
+static enum qnnp_status create_resize(
+    const char* name,
+    enum qnnp_operator_type type,
+    size_t channels,
+    uint32_t flags,
+    qnnp_operator_t* resize_out)
+{
+  qnnp_operator_t resize_op = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("failed to create %s resize operator because QNNPACK is not properly initialized", name);
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (channels == 0) {
+    qnnp_log_error(
+      "failed to create %s resize operator with %zu channels: number of channels must be non-zero", name, channels);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  resize_op = calloc(1, sizeof(struct qnnp_operator));
+  if (resize_op == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  resize_op->channels = channels;
+  resize_op->flags = flags & QNNP_CREATE_FLAG_ALIGN_CORNERS;
+
+  resize_op->type = type;
+  resize_op->format = qnnp_format_quint8;
+
+  *resize_out = resize_op;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(resize_op);
+  return status;
+}
+
+enum qnnp_status qnnp_create_resize_bilinear2d_nhwc_u8(
+    size_t channels,
+    uint32_t flags,
+    qnnp_operator_t* resize_out)
+{
+  return create_resize("bilinear", qnnp_operator_type_resize_bilinear, channels, flags, resize_out);
+}
+
+enum qnnp_status qnnp_create_resize_nearest2d_nhwc_u8(
+    size_t channels,
+    uint32_t flags,
+    qnnp_operator_t* resize_out)
+{
+  return create_resize("nearest", qnnp_operator_type_resize_nearest, channels, flags, resize_out);
+}
+
+/*
+ * Input coordinates of an output dimension: with half-pixel centers, output pixel i samples input position
+ * (i + 0.5) * input_size / output_size - 0.5, and with QNNP_CREATE_FLAG_ALIGN_CORNERS the first and last pixels of
+ * both dimensions coincide. Bilinear sampling takes the two input pixels around that position and the Q11 weight of
+ * the second one; nearest sampling takes the closest input pixel twice, with zero weight.
+ */
+static void init_resize_dimension(
+    size_t input_size,
+    size_t output_size,
+    bool align_corners,
+    bool nearest,
+    uint32_t* indices,
+    int16_t* weights)
+{
+  for (size_t i = 0; i < output_size; i++) {
+    size_t index;
+    int16_t weight = 0;
+    if (nearest) {
+      /* Integer arithmetic, so that positions exactly between two input pixels round the same way everywhere */
+      if (align_corners) {
+        index = output_size == 1 ? 0 : (2 * i * (input_size - 1) + (output_size - 1)) / (2 * (output_size - 1));
+      } else {
+        index = min((2 * i + 1) * input_size / (2 * output_size), input_size - 1);
+      }
+    } else {
+      double position;
+      if (align_corners) {
+        position = output_size == 1 ? 0.0 : (double) i * (double) (input_size - 1) / (double) (output_size - 1);
+      } else {
+        position = ((double) i + 0.5) * (double) input_size / (double) output_size - 0.5;
+      }
+      position = fmax(position, 0.0);
+      index = min((size_t) position, input_size - 1);
+      if (index + 1 < input_size) {
+        weight = (int16_t) lrint((position - (double) index) * 2048.0);
+      }
+    }
+    indices[2 * i] = (uint32_t) index;
+    indices[2 * i + 1] = (uint32_t) min(index + (weight != 0), input_size - 1);
+    weights[i] = weight;
+  }
+}
+
+static enum qnnp_status setup_resize(
+    const char* name,
+    enum qnnp_operator_type type,
+    qnnp_operator_t resize_op,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t output_height,
+    size_t output_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("failed to setup %s resize operator because QNNPACK is not properly initialized", name);
+    return qnnp_status_uninitialized;
+  }
+
+  if (resize_op->type != type) {
+    qnnp_log_error(
+      "failed to setup %s resize operator: operator was not created by qnnp_create_resize_%s2d_nhwc_u8", name, name);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error(
+      "failed to setup %s resize operator with batch size %zu: batch size must be non-zero", name, batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (input_width == 0 || input_height == 0 || output_width == 0 || output_height == 0) {
+    qnnp_log_error(
+      "failed to setup %s resize operator with %zux%zu input and %zux%zu output: dimensions must be non-zero",
+      name, input_width, input_height, output_width, output_height);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t channels = resize_op->channels;
+  if (input_pixel_stride < channels || output_pixel_stride < channels) {
+    qnnp_log_error(
+      "failed to setup %s resize operator with %zu input pixel stride and %zu output pixel stride: "
+      "strides must be at least the %zu channels",
+      name, input_pixel_stride, output_pixel_stride, channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (input_height * input_width > (size_t) UINT32_MAX) {
+    qnnp_log_error(
+      "failed to setup %s resize operator with %zux%zu input: input pixel indices must fit in 32 bits",
+      name, input_width, input_height);
+    return qnnp_status_unsupported_parameter;
+  }
+
+  /* Like indirection buffers, the tables only change with the dimensions */
+  if (resize_op->resize_indices == NULL ||
+      resize_op->input_height != input_height || resize_op->input_width != input_width ||
+      resize_op->output_height != output_height || resize_op->output_width != output_width)
+  {
+    const size_t entries = output_width + output_height;
+    uint32_t* resize_indices = qnnp_reallocate(resize_op->resize_indices, 2 * entries * sizeof(uint32_t));
+    if (resize_indices == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for resize indices", 2 * entries * sizeof(uint32_t));
+      return qnnp_status_out_of_memory;
+    }
+    resize_op->resize_indices = resize_indices;
+    int16_t* resize_weights = qnnp_reallocate(resize_op->resize_weights, entries * sizeof(int16_t));
+    if (resize_weights == NULL) {
+      /* The indices are for other dimensions now, and must be rebuilt by the next setup */
+      qnnp_deallocate(resize_op->resize_indices);
+      resize_op->resize_indices = NULL;
+      qnnp_log_error("failed to allocate %zu bytes for resize weights", entries * sizeof(int16_t));
+      return qnnp_status_out_of_memory;
+    }
+    resize_op->resize_weights = resize_weights;
+
+    const bool align_corners = (resize_op->flags & QNNP_CREATE_FLAG_ALIGN_CORNERS) != 0;
+    const bool nearest = type == qnnp_operator_type_resize_nearest;
+    init_resize_dimension(input_width, output_width, align_corners, nearest, resize_indices, resize_weights);
+    init_resize_dimension(
+      input_height, output_height, align_corners, nearest,
+      resize_indices + 2 * output_width, resize_weights + output_width);
+  }
+
+  resize_op->batch_size = batch_size;
+  resize_op->input_height = input_height;
+  resize_op->input_width = input_width;
+  resize_op->input = input;
+  resize_op->input_pixel_stride = input_pixel_stride;
+  resize_op->output_height = output_height;
+  resize_op->output_width = output_width;
+  resize_op->output = output;
+  resize_op->output_pixel_stride = output_pixel_stride;
+
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_setup_resize_bilinear2d_nhwc_u8(
+    qnnp_operator_t resize_op,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t output_height,
+    size_t output_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  return setup_resize(
+    "bilinear", qnnp_operator_type_resize_bilinear, resize_op,
+    batch_size, input_height, input_width, output_height, output_width,
+    input, input_pixel_stride, output, output_pixel_stride);
+}
+
+enum qnnp_status qnnp_setup_resize_nearest2d_nhwc_u8(
+    qnnp_operator_t resize_op,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t output_height,
+    size_t output_width,
+    const uint8_t* input,
+    size_t input_pixel_stride,
+    uint8_t* output,
+    size_t output_pixel_stride,
+    pthreadpool_t threadpool)
+{
+  return setup_resize(
+    "nearest", qnnp_operator_type_resize_nearest, resize_op,
+    batch_size, input_height, input_width, output_height, output_width,
+    input, input_pixel_stride, output, output_pixel_stride);
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/packed-weights.h>
+
+/*
+ * Parallel loop that the operator of a branch currently runs. Its driver thread publishes the loop by setting active,
+ * and every thread that takes tasks from it holds a reference in helpers, so that the driver retires the loop only
+ * after the last of them left it.
+ */
+struct branch_loop {
+  struct branch_region* region;
+  qnnp_task_function task;
+  void* task_context;
+  size_t tasks;
+  size_t next_task;
+  size_t completed_tasks;
+  size_t helpers;
+  bool active;
+} __attribute__((__aligned__(64)));
+
+struct branch_region {
+  const qnnp_operator_t* operators;
+  size_t operators_count;
+  /* Next operator without a driver thread */
+  size_t next_operator;
+  size_t completed_operators;
+  enum qnnp_status statuses[QNNP_MAX_CONCURRENT_OPERATORS];
+  struct branch_loop loops[QNNP_MAX_CONCURRENT_OPERATORS];
+};
+
+/* Runs tasks of the loop until it has none left, and returns whether it ran any */
+static bool run_branch_tasks(struct branch_loop* loop) {
+  const size_t tasks = loop->tasks;
+  bool ran_tasks = false;
+  for (;;) {
+    const size_t task = __atomic_fetch_add(&loop->next_task, 1, __ATOMIC_RELAXED);
+    if (task >= tasks) {
+      return ran_tasks;
+    }
+    loop->task(loop->task_context, task);
+    __atomic_fetch_add(&loop->completed_tasks, 1, __ATOMIC_RELEASE);
+    ran_tasks = true;
+  }
+}
+
+/* Runs the remaining tasks of the active loops of all branches, or yields the processor if there are none */
+static void help_branches(struct branch_region* region) {
+  bool ran_tasks = false;
+  for (size_t i = 0; i < region->operators_count; i++) {
+    struct branch_loop* loop = &region->loops[i];
+    if (!__atomic_load_n(&loop->active, __ATOMIC_RELAXED)) {
+      continue;
+    }
+    /* The loop is active after the helper reference is visible, so its driver waits for the helper to leave it */
+    __atomic_fetch_add(&loop->helpers, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&loop->active, __ATOMIC_SEQ_CST)) {
+      ran_tasks |= run_branch_tasks(loop);
+    }
+    __atomic_fetch_sub(&loop->helpers, 1, __ATOMIC_RELEASE);
+  }
+  if (!ran_tasks) {
+    sched_yield();
+  }
+}
+
+/* qnnp_scheduler of the operators of a region; context is the branch_loop of the operator */
+static void parallelize_branch(void* context, qnnp_task_function task, void* task_context, size_t tasks) {
+  struct branch_loop* loop = (struct branch_loop*) context;
+  loop->task = task;
+  loop->task_context = task_context;
+  loop->tasks = tasks;
+  loop->next_task = 0;
+  loop->completed_tasks = 0;
+  __atomic_store_n(&loop->active, true, __ATOMIC_SEQ_CST);
+
+  run_branch_tasks(loop);
+  while (__atomic_load_n(&loop->completed_tasks, __ATOMIC_ACQUIRE) != tasks) {
+    help_branches(loop->region);
+  }
+
+  /* The next loop of the operator reuses the branch_loop once no thread takes tasks from it */
+  __atomic_store_n(&loop->active, false, __ATOMIC_SEQ_CST);
+  while (__atomic_load_n(&loop->helpers, __ATOMIC_ACQUIRE) != 0) {
+    sched_yield();
+  }
+}
+
+static void run_branch_region_thread(struct branch_region* region, size_t thread_index) {
+  const size_t operators_count = region->operators_count;
+  for (;;) {
+    const size_t operator_index = __atomic_fetch_add(&region->next_operator, 1, __ATOMIC_RELAXED);
+    if (operator_index >= operators_count) {
+      break;
+    }
+    /* The legacy thread pool can't run loops from its own threads, so loops go to the scheduler of the region */
+    region->statuses[operator_index] = qnnp_run_operator(region->operators[operator_index], NULL);
+    __atomic_fetch_add(&region->completed_operators, 1, __ATOMIC_RELEASE);
+  }
+
+  while (__atomic_load_n(&region->completed_operators, __ATOMIC_ACQUIRE) != operators_count) {
+    help_branches(region);
+  }
+}
+
+enum qnnp_status qnnp_run_operators(
+    size_t operators_count,
+    const qnnp_operator_t* operators,
+    pthreadpool_t threadpool)
+{
+  if (operators_count > QNNP_MAX_CONCURRENT_OPERATORS) {
+    qnnp_log_error(
+      "failed to run %zu operators: at most %d operators run concurrently",
+      operators_count, QNNP_MAX_CONCURRENT_OPERATORS);
+    return qnnp_status_unsupported_parameter;
+  }
+
+  /* Weights are packed up front on the whole thread pool, since operators in the region can't use it */
+  for (size_t i = 0; i < operators_count; i++) {
+    if (operators[i]->packed_weights != NULL) {
+      const enum qnnp_status status = qnnp_ensure_packed_weights(operators[i], threadpool);
+      if (status != qnnp_status_success) {
+        return status;
+      }
+    }
+  }
+
+  const size_t threads_count = pthreadpool_get_threads_count(threadpool);
+  if (operators_count <= 1 || threads_count <= 1) {
+    for (size_t i = 0; i < operators_count; i++) {
+      const enum qnnp_status status = qnnp_run_operator(operators[i], threadpool);
+      if (status != qnnp_status_success) {
+        return status;
+      }
+    }
+    return qnnp_status_success;
+  }
+
+  struct branch_region region = {
+    .operators = operators,
+    .operators_count = operators_count,
+  };
+  struct qnnp_scheduler schedulers[QNNP_MAX_CONCURRENT_OPERATORS];
+  for (size_t i = 0; i < operators_count; i++) {
+    region.loops[i].region = &region;
+    schedulers[i] = operators[i]->scheduler;
+    operators[i]->scheduler = (struct qnnp_scheduler) {
+      .parallelize = parallelize_branch,
+      .context = &region.loops[i],
+      .threads_count = threads_count,
+    };
+  }
+
+  pthreadpool_compute_1d(
+    threadpool,
+    (pthreadpool_function_1d_t) run_branch_region_thread,
+    &region,
+    threads_count);
+
+  enum qnnp_status status = qnnp_status_success;
+  for (size_t i = 0; i < operators_count; i++) {
+    operators[i]->scheduler = schedulers[i];
+    if (status == qnnp_status_success) {
+      status = region.statuses[i];
+    }
+  }
+  return status;
+}
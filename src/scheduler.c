@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/math.h>
+#include <qnnpack/scheduler.h>
+
+/* Threads beyond this number run no tasks of the work-stealing scheduler */
+#define QNNP_MAX_WORK_STEALING_THREADS 64
+
+static void run_scheduled_task(const struct qnnp_scheduled_loop* loop, size_t task) {
+  size_t index[4];
+  size_t tile[4];
+  for (size_t d = 4; d-- != 0; ) {
+    index[d] = (task % loop->tiles[d]) * loop->tile[d];
+    tile[d] = min(loop->tile[d], loop->range[d] - index[d]);
+    task /= loop->tiles[d];
+  }
+  switch (loop->type) {
+    case qnnp_loop_type_1d:
+      loop->function_1d(loop->argument, index[3]);
+      break;
+    case qnnp_loop_type_1d_tiled:
+      loop->function_1d_tiled(loop->argument, index[3], tile[3]);
+      break;
+    case qnnp_loop_type_2d:
+      loop->function_2d(loop->argument, index[2], index[3]);
+      break;
+    case qnnp_loop_type_2d_tiled:
+      loop->function_2d_tiled(loop->argument, index[2], index[3], tile[2], tile[3]);
+      break;
+    case qnnp_loop_type_3d_tiled:
+      loop->function_3d_tiled(loop->argument, index[1], index[2], index[3], tile[1], tile[2], tile[3]);
+      break;
+    case qnnp_loop_type_4d_tiled:
+      loop->function_4d_tiled(
+        loop->argument, index[0], index[1], index[2], index[3], tile[0], tile[1], tile[2], tile[3]);
+      break;
+  }
+}
+
+void qnnp_run_scheduled_loop(const struct qnnp_operator* op, struct qnnp_scheduled_loop* loop) {
+  size_t tasks = 1;
+  for (size_t d = 0; d < 4; d++) {
+    loop->tiles[d] = divide_round_up(loop->range[d], loop->tile[d]);
+    tasks *= loop->tiles[d];
+  }
+  if (tasks != 0) {
+    op->scheduler.parallelize(op->scheduler.context, (qnnp_task_function) run_scheduled_task, loop, tasks);
+  }
+}
+
+enum qnnp_status qnnp_set_operator_scheduler(
+    qnnp_operator_t op,
+    const struct qnnp_scheduler* scheduler)
+{
+  if (scheduler == NULL) {
+    op->scheduler = (struct qnnp_scheduler) { 0 };
+    return qnnp_status_success;
+  }
+
+  if (scheduler->parallelize == NULL) {
+    qnnp_log_error("failed to set operator scheduler: parallelize function must be non-NULL");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (scheduler->threads_count == 0) {
+    qnnp_log_error("failed to set operator scheduler with %zu threads: thread count must be non-zero",
+      scheduler->threads_count);
+    return qnnp_status_invalid_parameter;
+  }
+
+  op->scheduler = *scheduler;
+  return qnnp_status_success;
+}
+
+/*
+ * Tasks [start, end) of one thread of the work-stealing scheduler. The thread takes tasks from the start and others
+ * from the end; either first claims one of the length remaining tasks, so that no task runs twice.
+ */
+struct work_stealing_range {
+  size_t start;
+  size_t end;
+  size_t length;
+} __attribute__((__aligned__(64)));
+
+struct work_stealing_context {
+  qnnp_task_function task;
+  void* task_context;
+  size_t threads;
+  struct work_stealing_range* ranges;
+};
+
+static bool claim_task(struct work_stealing_range* range) {
+  size_t length = __atomic_load_n(&range->length, __ATOMIC_RELAXED);
+  while (length != 0) {
+    if (__atomic_compare_exchange_n(&range->length, &length, length - 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void run_work_stealing_thread(const struct work_stealing_context* context, size_t thread_index) {
+  const qnnp_task_function task = context->task;
+  void* task_context = context->task_context;
+
+  struct work_stealing_range* range = &context->ranges[thread_index];
+  while (claim_task(range)) {
+    task(task_context, __atomic_fetch_add(&range->start, 1, __ATOMIC_RELAXED));
+  }
+
+  /* Steal from the other threads in turn, starting with the next one */
+  const size_t threads = context->threads;
+  for (size_t offset = 1; offset < threads; offset++) {
+    struct work_stealing_range* victim_range = &context->ranges[(thread_index + offset) % threads];
+    while (claim_task(victim_range)) {
+      task(task_context, __atomic_sub_fetch(&victim_range->end, 1, __ATOMIC_RELAXED));
+    }
+  }
+}
+
+static void parallelize_work_stealing(
+    void* threadpool,
+    qnnp_task_function task,
+    void* task_context,
+    size_t tasks)
+{
+  const size_t threads = min(min(pthreadpool_get_threads_count((pthreadpool_t) threadpool), tasks),
+    QNNP_MAX_WORK_STEALING_THREADS);
+  if (threads <= 1) {
+    for (size_t i = 0; i < tasks; i++) {
+      task(task_context, i);
+    }
+    return;
+  }
+
+  struct work_stealing_range ranges[QNNP_MAX_WORK_STEALING_THREADS];
+  for (size_t thread_index = 0; thread_index < threads; thread_index++) {
+    const size_t start = tasks * thread_index / threads;
+    const size_t end = tasks * (thread_index + 1) / threads;
+    ranges[thread_index] = (struct work_stealing_range) {
+      .start = start,
+      .end = end,
+      .length = end - start,
+    };
+  }
+  const struct work_stealing_context context = {
+    .task = task,
+    .task_context = task_context,
+    .threads = threads,
+    .ranges = ranges,
+  };
+  /* One item per thread; the thread pool synchronizes the ranges with the threads that read them */
+  pthreadpool_compute_1d(
+    (pthreadpool_t) threadpool,
+    (pthreadpool_function_1d_t) run_work_stealing_thread,
+    (void*) &context,
+    threads);
+}
+
+enum qnnp_status qnnp_get_work_stealing_scheduler(
+    pthreadpool_t threadpool,
+    struct qnnp_scheduler* scheduler)
+{
+  *scheduler = (struct qnnp_scheduler) {
+    .parallelize = parallelize_work_stealing,
+    .context = (void*) threadpool,
+    .threads_count = pthreadpool_get_threads_count(threadpool),
+  };
+  return qnnp_status_success;
+}
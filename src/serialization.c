@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cpuinfo.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/math.h>
+#include <qnnpack/packed-weights.h>
+#include <qnnpack/params.h>
+
+/* "QNNP" in little-endian byte order */
+#define QNNP_SERIALIZED_OPERATOR_MAGIC UINT32_C(0x504E4E51)
+/* Bump when the packed layout changes; 2 pads every nr-block of the kernel to QNNP_PACKED_BLOCK_ALIGNMENT bytes */
+#define QNNP_SERIALIZED_OPERATOR_VERSION 2
+
+#if CPUINFO_ARCH_X86
+  #define QNNP_SERIALIZED_OPERATOR_ARCH 1
+#elif CPUINFO_ARCH_X86_64
+  #define QNNP_SERIALIZED_OPERATOR_ARCH 2
+#elif CPUINFO_ARCH_ARM
+  #define QNNP_SERIALIZED_OPERATOR_ARCH 3
+#elif CPUINFO_ARCH_ARM64
+  #define QNNP_SERIALIZED_OPERATOR_ARCH 4
+#elif CPUINFO_ARCH_RISCV32
+  #define QNNP_SERIALIZED_OPERATOR_ARCH 5
+#elif CPUINFO_ARCH_RISCV64
+  #define QNNP_SERIALIZED_OPERATOR_ARCH 6
+#else
+  #define QNNP_SERIALIZED_OPERATOR_ARCH 0
+#endif
+
+/*
+ * Packed kernel and bias are stored at multiples of a cache line from the start of the serialized data, so they
+ * are as aligned as the data itself (up to a cache line), as when QNNPACK allocates them.
+ */
+#define QNNP_SERIALIZED_OPERATOR_ALIGNMENT 64
+
+/*
+ * The serialized data starts with this header, followed by the packed kernel and bias exactly as the microkernels
+ * read them. Fields use the byte order of the machine, which is why data only loads on the architecture it was
+ * written on.
+ */
+struct qnnp_serialized_operator_header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t arch;
+  uint32_t type;
+  uint32_t flags;
+
+  uint32_t input_padding_top;
+  uint32_t input_padding_right;
+  uint32_t input_padding_bottom;
+  uint32_t input_padding_left;
+  uint32_t adjustment_height;
+  uint32_t adjustment_width;
+  uint32_t kernel_height;
+  uint32_t kernel_width;
+  uint32_t stride_height;
+  uint32_t stride_width;
+  uint32_t dilation_height;
+  uint32_t dilation_width;
+  uint32_t groups;
+  uint64_t group_input_channels;
+  uint64_t group_output_channels;
+
+  /* Microkernel tile the weights are packed for, see struct qnnp_packed_weights */
+  uint32_t nr;
+  uint32_t kr;
+  uint32_t kc;
+
+  float requantization_scale;
+  uint8_t input_zero_point;
+  uint8_t kernel_zero_point;
+  uint8_t output_zero_point;
+  uint8_t output_min;
+  uint8_t output_max;
+  uint8_t reserved[3];
+
+  uint64_t packed_kernel_offset;
+  uint64_t packed_kernel_size;
+  uint64_t bias_offset;
+  uint64_t bias_size;
+};
+
+/* Fills the parameters of the operator into the header, without the offsets and sizes of the packed weights */
+static void init_serialized_header(const struct qnnp_operator* op, struct qnnp_serialized_operator_header* header) {
+  /* Zero-initialized by memset rather than an initializer to give padding bytes a deterministic value */
+  memset(header, 0, sizeof(struct qnnp_serialized_operator_header));
+  header->magic = QNNP_SERIALIZED_OPERATOR_MAGIC;
+  header->version = QNNP_SERIALIZED_OPERATOR_VERSION;
+  header->arch = QNNP_SERIALIZED_OPERATOR_ARCH;
+  header->type = (uint32_t) op->type;
+  header->flags = op->flags;
+  header->input_padding_top = op->input_padding_top;
+  header->input_padding_right = op->input_padding_right;
+  header->input_padding_bottom = op->input_padding_bottom;
+  header->input_padding_left = op->input_padding_left;
+  header->adjustment_height = op->adjustment_height;
+  header->adjustment_width = op->adjustment_width;
+  header->kernel_height = op->kernel_height;
+  header->kernel_width = op->kernel_width;
+  header->stride_height = op->stride_height;
+  header->stride_width = op->stride_width;
+  header->dilation_height = op->dilation_height;
+  header->dilation_width = op->dilation_width;
+  header->groups = op->groups;
+  header->group_input_channels = op->group_input_channels;
+  header->group_output_channels = op->group_output_channels;
+  header->nr = op->packed_weights->nr;
+  header->kr = op->packed_weights->kr;
+  header->kc = op->packed_weights->kc;
+  header->requantization_scale = op->requantization_scale;
+  header->input_zero_point = op->input_zero_point;
+  header->kernel_zero_point = op->kernel_zero_point;
+  header->output_zero_point = op->output_zero_point;
+  header->output_min = op->output_min;
+  header->output_max = op->output_max;
+}
+
+/*
+ * Creates an operator with the parameters of the header that references the packed weights, which must have been
+ * packed for these parameters
+ */
+static enum qnnp_status create_operator_with_packed_weights(
+    const struct qnnp_serialized_operator_header* header,
+    qnnp_packed_weights_t packed_weights,
+    uint32_t extra_create_flags,
+    qnnp_operator_t* op_out)
+{
+  /* The stored scale is already the product of the input and kernel scales divided by the output scale */
+  const uint32_t create_flags =
+    (header->flags & QNNP_CONVOLUTION_FLAG_FP32_REQUANTIZATION ? QNNP_CREATE_FLAG_FP32_REQUANTIZATION : 0) |
+    (header->flags & QNNP_CONVOLUTION_FLAG_NCHW ? QNNP_CREATE_FLAG_INPUT_NCHW : 0) |
+    (header->flags & QNNP_CONVOLUTION_FLAG_TRANSPOSED_OUTPUT ? QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT : 0) |
+    extra_create_flags;
+  enum qnnp_status status = qnnp_status_invalid_parameter;
+  switch ((enum qnnp_operator_type) header->type) {
+    case qnnp_operator_type_convolution:
+      status = qnnp_create_convolution2d_nhwc_q8_with_packed_weights(
+        header->input_padding_top, header->input_padding_right,
+        header->input_padding_bottom, header->input_padding_left,
+        header->kernel_height, header->kernel_width,
+        header->stride_height, header->stride_width,
+        header->dilation_height, header->dilation_width,
+        header->groups, header->group_input_channels, header->group_output_channels,
+        header->input_zero_point, header->requantization_scale,
+        header->kernel_zero_point, 1.0f,
+        packed_weights,
+        header->output_zero_point, 1.0f, header->output_min, header->output_max,
+        create_flags,
+        op_out);
+      break;
+    case qnnp_operator_type_deconvolution:
+      status = qnnp_create_deconvolution2d_nhwc_q8_with_packed_weights(
+        header->input_padding_top, header->input_padding_right,
+        header->input_padding_bottom, header->input_padding_left,
+        header->adjustment_height, header->adjustment_width,
+        header->kernel_height, header->kernel_width,
+        header->stride_height, header->stride_width,
+        header->dilation_height, header->dilation_width,
+        header->groups, header->group_input_channels, header->group_output_channels,
+        header->input_zero_point, header->requantization_scale,
+        header->kernel_zero_point, 1.0f,
+        packed_weights,
+        header->output_zero_point, 1.0f, header->output_min, header->output_max,
+        create_flags,
+        op_out);
+      break;
+    case qnnp_operator_type_fully_connected:
+      status = qnnp_create_fully_connected_nc_q8_with_packed_weights(
+        header->group_input_channels, header->group_output_channels,
+        header->input_zero_point, header->requantization_scale,
+        header->kernel_zero_point, 1.0f,
+        packed_weights,
+        header->output_zero_point, 1.0f, header->output_min, header->output_max,
+        create_flags,
+        op_out);
+      break;
+    default:
+      qnnp_log_error(
+        "failed to create operator with packed weights: unsupported operator type %" PRIu32, header->type);
+      break;
+  }
+
+  return status;
+}
+
+enum qnnp_status qnnp_serialize_operator(
+    qnnp_operator_t op,
+    void* data,
+    size_t* data_size)
+{
+  if (op == NULL || op->packed_weights == NULL) {
+    qnnp_log_error("failed to serialize operator: only convolution, deconvolution, and fully-connected operators "
+      "can be serialized");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (op->format != qnnp_format_quint8) {
+    qnnp_log_error("failed to serialize operator: only quantized 8-bit operators can be serialized");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (op->flags & QNNP_CONVOLUTION_FLAG_PER_CHANNEL) {
+    qnnp_log_error("failed to serialize operator: operators with per-channel scales cannot be serialized");
+    return qnnp_status_invalid_parameter;
+  }
+
+  const enum qnnp_status status = qnnp_ensure_packed_weights(op, NULL);
+  if (status != qnnp_status_success) {
+    return status;
+  }
+
+  const struct qnnp_packed_weights* packed_weights = op->packed_weights;
+  const size_t packed_kernel_offset =
+    round_up(sizeof(struct qnnp_serialized_operator_header), QNNP_SERIALIZED_OPERATOR_ALIGNMENT);
+  const size_t bias_offset =
+    round_up(packed_kernel_offset + packed_weights->packed_kernel_size, QNNP_SERIALIZED_OPERATOR_ALIGNMENT);
+  const size_t required_size = bias_offset + packed_weights->bias_size;
+
+  if (data == NULL) {
+    *data_size = required_size;
+    return qnnp_status_success;
+  }
+  if (*data_size < required_size) {
+    qnnp_log_error("failed to serialize operator into %zu bytes: %zu bytes are required", *data_size, required_size);
+    *data_size = required_size;
+    return qnnp_status_invalid_parameter;
+  }
+
+  struct qnnp_serialized_operator_header header;
+  init_serialized_header(op, &header);
+  header.packed_kernel_offset = packed_kernel_offset;
+  header.packed_kernel_size = packed_weights->packed_kernel_size;
+  header.bias_offset = bias_offset;
+  header.bias_size = packed_weights->bias_size;
+
+  memset(data, 0, required_size);
+  memcpy(data, &header, sizeof(header));
+  memcpy((char*) data + packed_kernel_offset, packed_weights->packed_kernel, packed_weights->packed_kernel_size);
+  if (packed_weights->bias_size != 0) {
+    memcpy((char*) data + bias_offset, packed_weights->bias, packed_weights->bias_size);
+  }
+  *data_size = required_size;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_create_operator_from_serialized_with_flags(
+    const void* data,
+    size_t data_size,
+    uint32_t extra_create_flags,
+    qnnp_operator_t* op_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_operator_from_serialized failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  struct qnnp_serialized_operator_header header;
+  if (data_size < sizeof(header)) {
+    qnnp_log_error("failed to create operator from %zu bytes of serialized data: data is truncated", data_size);
+    return qnnp_status_invalid_parameter;
+  }
+  if (((uintptr_t) data & (sizeof(int32_t) - 1)) != 0) {
+    qnnp_log_error("failed to create operator from serialized data at %p: data must be 4-byte aligned", data);
+    return qnnp_status_invalid_parameter;
+  }
+  memcpy(&header, data, sizeof(header));
+
+  if (header.magic != QNNP_SERIALIZED_OPERATOR_MAGIC || header.version != QNNP_SERIALIZED_OPERATOR_VERSION) {
+    qnnp_log_error("failed to create operator from serialized data: unrecognized format or version");
+    return qnnp_status_invalid_parameter;
+  }
+  if (header.arch != QNNP_SERIALIZED_OPERATOR_ARCH) {
+    qnnp_log_error("failed to create operator from serialized data: data was written on a different architecture");
+    return qnnp_status_unsupported_parameter;
+  }
+  if (header.packed_kernel_offset > data_size || header.packed_kernel_size > data_size - header.packed_kernel_offset ||
+      header.bias_offset > data_size || header.bias_size > data_size - header.bias_offset)
+  {
+    qnnp_log_error("failed to create operator from %zu bytes of serialized data: data is truncated", data_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  struct qnnp_packed_weights* packed_weights = malloc(sizeof(struct qnnp_packed_weights));
+  if (packed_weights == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for packed weights structure", sizeof(struct qnnp_packed_weights));
+    return qnnp_status_out_of_memory;
+  }
+  /* Microkernels only read the weights, so they can stay in read-only (e.g. memory-mapped) memory */
+  *packed_weights = (struct qnnp_packed_weights) {
+    .reference_count = 1,
+    .packing_state = qnnp_packing_state_packed,
+    .external_memory = true,
+    .type = (enum qnnp_operator_type) header.type,
+    .format = qnnp_format_quint8,
+    .flags = header.flags & ~(QNNP_CONVOLUTION_FLAG_ZERO | QNNP_CONVOLUTION_FLAG_TRANSPOSED_OUTPUT),
+    .kernel_height = header.kernel_height,
+    .kernel_width = header.kernel_width,
+    .groups = header.groups,
+    .group_input_channels = header.group_input_channels,
+    .group_output_channels = header.group_output_channels,
+    .input_zero_point = header.input_zero_point,
+    .kernel_zero_point = header.kernel_zero_point,
+    .stride_height = header.flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL ? header.stride_height : 0,
+    .stride_width = header.flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL ? header.stride_width : 0,
+    .dilation_height = header.flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL ? header.dilation_height : 0,
+    .dilation_width = header.flags & QNNP_CONVOLUTION_FLAG_SUBPIXEL ? header.dilation_width : 0,
+    .nr = header.nr,
+    .kr = header.kr,
+    .kc = header.kc,
+    .packed_kernel = (void*) ((uintptr_t) data + header.packed_kernel_offset),
+    .packed_kernel_size = header.packed_kernel_size,
+    .bias = header.bias_size != 0 ? (void*) ((uintptr_t) data + header.bias_offset) : NULL,
+    .bias_size = header.bias_size,
+    .block_groups = 1,
+  };
+
+  const enum qnnp_status status =
+    create_operator_with_packed_weights(&header, packed_weights, extra_create_flags, op_out);
+
+  /* On success, the operator holds the only remaining reference */
+  qnnp_release_packed_weights(packed_weights);
+  return status;
+}
+
+enum qnnp_status qnnp_create_operator_from_serialized(
+    const void* data,
+    size_t data_size,
+    qnnp_operator_t* op_out)
+{
+  return qnnp_create_operator_from_serialized_with_flags(data, data_size, 0, op_out);
+}
+
+enum qnnp_status qnnp_create_operator_from_file(
+    const char* path,
+    qnnp_operator_t* op_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_operator_from_file failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    qnnp_log_error("failed to create operator from file %s: file cannot be opened", path);
+    return qnnp_status_invalid_parameter;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    qnnp_log_error("failed to create operator from file %s: file is empty or cannot be read", path);
+    close(fd);
+    return qnnp_status_invalid_parameter;
+  }
+  const size_t mapping_size = (size_t) file_stat.st_size;
+
+  /*
+   * A shared read-only mapping reads the weights straight from the page cache, so every process that loads the same
+   * file uses the same physical pages, and a stray write faults instead of copying a page
+   */
+  void* mapping = mmap(NULL, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+  /* The mapping keeps the file referenced */
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    qnnp_log_error("failed to create operator from file %s: mapping %zu bytes failed", path, mapping_size);
+    return qnnp_status_out_of_memory;
+  }
+
+  qnnp_operator_t op = NULL;
+  const enum qnnp_status status = qnnp_create_operator_from_serialized(mapping, mapping_size, &op);
+  if (status != qnnp_status_success) {
+    munmap(mapping, mapping_size);
+    return status;
+  }
+
+  /* Operators created from the same packed weights keep the mapping until the last of them is deleted */
+  op->packed_weights->mapping = mapping;
+  op->packed_weights->mapping_size = mapping_size;
+  *op_out = op;
+  return qnnp_status_success;
+}
+
+enum qnnp_status qnnp_clone_operator(
+    qnnp_operator_t op,
+    qnnp_operator_t* clone_out)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_clone_operator failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (op == NULL || op->packed_weights == NULL) {
+    qnnp_log_error("failed to clone operator: only convolution, deconvolution, and fully-connected operators "
+      "can be cloned");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (op->format != qnnp_format_quint8) {
+    qnnp_log_error("failed to clone operator: only quantized 8-bit operators can be cloned");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (op->flags & QNNP_CONVOLUTION_FLAG_PER_CHANNEL) {
+    qnnp_log_error("failed to clone operator: operators with per-channel scales cannot be cloned");
+    return qnnp_status_invalid_parameter;
+  }
+
+  /* The clone is created like a serialized operator, but shares the packed weights rather than a copy of them */
+  struct qnnp_serialized_operator_header header;
+  init_serialized_header(op, &header);
+  qnnp_operator_t clone = NULL;
+  const enum qnnp_status status = create_operator_with_packed_weights(
+    &header, op->packed_weights, op->tile_indirection ? QNNP_CREATE_FLAG_TILE_INDIRECTION : 0, &clone);
+  if (status != qnnp_status_success) {
+    return status;
+  }
+
+  /* Unlike serialized data, the operator knows the input and kernel scales that dequantize its accumulators */
+  clone->accumulator_scale = op->accumulator_scale;
+  *clone_out = clone;
+  return qnnp_status_success;
+}
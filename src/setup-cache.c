@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/allocator.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/setup-cache.h>
+
+static void remove_entry(struct qnnp_setup_cache* cache, size_t index) {
+  cache->size -= cache->entries[index].im2col_buffer_size;
+  cache->entries[index] = cache->entries[--cache->entries_count];
+}
+
+/* Frees least recently used entries until another size bytes fit under the limit */
+static void evict_entries(struct qnnp_setup_cache* cache, size_t size) {
+  while (cache->entries_count != 0 && cache->size + size > cache->max_size) {
+    size_t lru_index = 0;
+    for (size_t i = 1; i < cache->entries_count; i++) {
+      if (cache->entries[i].last_use < cache->entries[lru_index].last_use) {
+        lru_index = i;
+      }
+    }
+    qnnp_deallocate(cache->entries[lru_index].im2col_buffer);
+    remove_entry(cache, lru_index);
+  }
+}
+
+void qnnp_setup_cache_store(struct qnnp_operator* op, size_t im2col_buffer_size, const void* indirection_input) {
+  struct qnnp_setup_cache* cache = op->setup_cache;
+  const void** im2col_buffer = op->im2col_buffer;
+  op->im2col_buffer = NULL;
+
+  if (im2col_buffer_size > cache->max_size) {
+    qnnp_deallocate(im2col_buffer);
+    return;
+  }
+
+  evict_entries(cache, im2col_buffer_size);
+  if (cache->entries_count == cache->entries_capacity) {
+    const size_t entries_capacity = cache->entries_capacity == 0 ? 4 : 2 * cache->entries_capacity;
+    struct qnnp_setup_cache_entry* entries =
+      realloc(cache->entries, entries_capacity * sizeof(struct qnnp_setup_cache_entry));
+    if (entries == NULL) {
+      /* The cache only saves work, so the buffer is dropped instead of failing setup */
+      qnnp_deallocate(im2col_buffer);
+      return;
+    }
+    cache->entries = entries;
+    cache->entries_capacity = entries_capacity;
+  }
+
+  cache->entries[cache->entries_count++] = (struct qnnp_setup_cache_entry) {
+    .batch_size = op->batch_size,
+    .input_height = op->input_height,
+    .input_width = op->input_width,
+    .input_pixel_stride = op->input_pixel_stride,
+    .im2col_buffer = im2col_buffer,
+    .im2col_buffer_size = im2col_buffer_size,
+    .indirection_input = indirection_input,
+    .indirection_offsets = op->indirection_offsets,
+    .last_use = cache->clock++,
+  };
+  cache->size += im2col_buffer_size;
+}
+
+bool qnnp_setup_cache_restore(
+    struct qnnp_operator* op,
+    size_t batch_size,
+    size_t input_height,
+    size_t input_width,
+    size_t input_pixel_stride)
+{
+  struct qnnp_setup_cache* cache = op->setup_cache;
+  for (size_t i = 0; i < cache->entries_count; i++) {
+    const struct qnnp_setup_cache_entry* entry = &cache->entries[i];
+    if (entry->batch_size == batch_size &&
+        entry->input_height == input_height &&
+        entry->input_width == input_width &&
+        entry->input_pixel_stride == input_pixel_stride)
+    {
+      qnnp_deallocate(op->im2col_buffer);
+      op->im2col_buffer = entry->im2col_buffer;
+      op->indirection_input = entry->indirection_input;
+      op->indirection_offsets = entry->indirection_offsets;
+      remove_entry(cache, i);
+      return true;
+    }
+  }
+  return false;
+}
+
+void qnnp_delete_setup_cache(struct qnnp_setup_cache* cache) {
+  if (cache != NULL) {
+    for (size_t i = 0; i < cache->entries_count; i++) {
+      qnnp_deallocate(cache->entries[i].im2col_buffer);
+    }
+    free(cache->entries);
+    free(cache);
+  }
+}
+
+enum qnnp_status qnnp_set_operator_setup_cache(
+    qnnp_operator_t op,
+    size_t max_size)
+{
+  switch (op->type) {
+    case qnnp_operator_type_convolution:
+    case qnnp_operator_type_deconvolution:
+    case qnnp_operator_type_max_pooling:
+    case qnnp_operator_type_average_pooling:
+      break;
+    default:
+      qnnp_log_error(
+        "failed to set setup cache of operator type %d: only convolution, deconvolution, and pooling operators "
+        "have indirection buffers", (int) op->type);
+      return qnnp_status_invalid_parameter;
+  }
+
+  if (max_size == 0) {
+    qnnp_delete_setup_cache(op->setup_cache);
+    op->setup_cache = NULL;
+    return qnnp_status_success;
+  }
+
+  if (op->setup_cache == NULL) {
+    op->setup_cache = calloc(1, sizeof(struct qnnp_setup_cache));
+    if (op->setup_cache == NULL) {
+      qnnp_log_error("failed to allocate %zu bytes for setup cache", sizeof(struct qnnp_setup_cache));
+      return qnnp_status_out_of_memory;
+    }
+  }
+  op->setup_cache->max_size = max_size;
+  evict_entries(op->setup_cache, 0);
+  return qnnp_status_success;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <qnnpack.h>
+#include <qnnpack/convolution.h>
+#include <qnnpack/log.h>
+#include <qnnpack/params.h>
+
+
+enum qnnp_status qnnp_create_softmax_nc_q8(
+    size_t channels,
+    float input_scale,
+    uint8_t output_zero_point,
+    float output_scale,
+    uint32_t flags,
+    qnnp_operator_t* softmax_out)
+{
+  qnnp_operator_t softmax_op = NULL;
+  enum qnnp_status status = qnnp_status_uninitialized;
+
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_create_softmax_nc_q8 failed because QNNPACK is not properly initialized");
+    goto error;
+  }
+
+  status = qnnp_status_invalid_parameter;
+
+  if (channels == 0) {
+    qnnp_log_error(
+      "failed to create softmax operator with %zu channels: number of channels must be non-zero", channels);
+    goto error;
+  }
+
+  if (input_scale <= 0.0f || !isnormal(input_scale)) {
+    qnnp_log_error(
+      "failed to create softmax operator with %.7g input scale: scale must be finite and positive", input_scale);
+    goto error;
+  }
+
+  if (output_scale <= 0.0f || !isnormal(output_scale)) {
+    qnnp_log_error(
+      "failed to create softmax operator with %.7g output scale: scale must be finite and positive", output_scale);
+    goto error;
+  }
+
+  status = qnnp_status_unsupported_parameter;
+
+  if (output_scale != 0x1.0p-8f) {
+    qnnp_log_error(
+      "failed to create softmax operator with %.7g output scale: only output scale of 1/256 is supported",
+      output_scale);
+    goto error;
+  }
+
+  if (output_zero_point != 0) {
+    qnnp_log_error(
+      "failed to create softmax operator with %" PRIu8 " output zero point: only output zero point of 0 is supported",
+      output_zero_point);
+    goto error;
+  }
+
+  status = qnnp_status_out_of_memory;
+
+  softmax_op = calloc(1, sizeof(struct qnnp_operator));
+  if (softmax_op == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for qnnp_operator structure", sizeof(struct qnnp_operator));
+    goto error;
+  }
+
+  softmax_op->exp_lookup_table = malloc(256 * sizeof(uint32_t));
+  if (softmax_op->exp_lookup_table == NULL) {
+    qnnp_log_error("failed to allocate %zu bytes for softmax lookup table", 256 * sizeof(uint32_t));
+    goto error;
+  }
+
+  /*
+   * Entry i is exp((i - 255) * input_scale), scaled so that the sum of all channels fits in 32 bits and an entry
+   * times 256 in 31 bits: rows are shifted by their maximum, so the largest term of every sum is the last entry.
+   */
+  const double qscale = fmin(((double) UINT32_MAX) / (double) channels, 8388607.0);
+  for (int32_t i = 0; i < 256; i++) {
+    const double scaled_exp = qscale * exp((double) (i - 255) * (double) input_scale);
+    softmax_op->exp_lookup_table[i] = (uint32_t) lrint(scaled_exp);
+  }
+
+  softmax_op->channels = channels;
+  softmax_op->output_zero_point = output_zero_point;
+
+  softmax_op->type = qnnp_operator_type_softmax;
+  softmax_op->format = qnnp_format_quint8;
+
+  *softmax_out = softmax_op;
+  return qnnp_status_success;
+
+error:
+  qnnp_delete_operator(softmax_op);
+  return status;
+}
+
+enum qnnp_status qnnp_setup_softmax_nc_q8(
+    qnnp_operator_t softmax_op,
+    size_t batch_size,
+    const uint8_t* input,
+    size_t input_stride,
+    uint8_t* output,
+    size_t output_stride,
+    pthreadpool_t threadpool)
+{
+  if (!qnnp_params.initialized) {
+    qnnp_log_error("qnnp_setup_softmax_nc_q8 failed because QNNPACK is not properly initialized");
+    return qnnp_status_uninitialized;
+  }
+
+  if (softmax_op->type != qnnp_operator_type_softmax) {
+    qnnp_log_error("failed to setup softmax operator: operator was not created by qnnp_create_softmax_nc_q8");
+    return qnnp_status_invalid_parameter;
+  }
+
+  if (batch_size == 0) {
+    qnnp_log_error("failed to setup softmax operator with batch size %zu: batch size must be non-zero", batch_size);
+    return qnnp_status_invalid_parameter;
+  }
+
+  const size_t channels = softmax_op->channels;
+  if (input_stride < channels || output_stride < channels) {
+    qnnp_log_error(
+      "failed to setup softmax operator with %zu input and %zu output strides: "
+      "strides must be at least the %zu channels",
+      input_stride, output_stride, channels);
+    return qnnp_status_invalid_parameter;
+  }
+
+  softmax_op->batch_size = batch_size;
+  softmax_op->input = input;
+  softmax_op->input_pixel_stride = input_stride;
+  softmax_op->output = output;
+  softmax_op->output_pixel_stride = output_stride;
+
+  return qnnp_status_success;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <arm_neon.h>
+
+#include <qnnpack/u8bilinear.h>
+
+
+/*
+ * Interpolates 8 channels: the left and right pixels of each row are weighted in Q11 and rounded to Q7, and the top
+ * and bottom results are weighted in Q11 again and rounded from Q18, as in the SSE2 microkernel.
+ */
+static inline uint8x8_t u8bilinear_8x__neon(
+    uint8x8_t vtl,
+    uint8x8_t vtr,
+    uint8x8_t vbl,
+    uint8x8_t vbr,
+    uint16_t column_weight,
+    uint16_t row_weight)
+{
+  const uint16_t column_complement = 2048 - column_weight;
+  const uint16_t row_complement = 2048 - row_weight;
+  const uint16x8_t vtl16 = vmovl_u8(vtl);
+  const uint16x8_t vtr16 = vmovl_u8(vtr);
+  const uint16x8_t vbl16 = vmovl_u8(vbl);
+  const uint16x8_t vbr16 = vmovl_u8(vbr);
+
+  uint32x4_t vtop_lo = vmull_n_u16(vget_low_u16(vtl16), column_complement);
+  uint32x4_t vtop_hi = vmull_n_u16(vget_high_u16(vtl16), column_complement);
+  uint32x4_t vbottom_lo = vmull_n_u16(vget_low_u16(vbl16), column_complement);
+  uint32x4_t vbottom_hi = vmull_n_u16(vget_high_u16(vbl16), column_complement);
+  vtop_lo = vmlal_n_u16(vtop_lo, vget_low_u16(vtr16), column_weight);
+  vtop_hi = vmlal_n_u16(vtop_hi, vget_high_u16(vtr16), column_weight);
+  vbottom_lo = vmlal_n_u16(vbottom_lo, vget_low_u16(vbr16), column_weight);
+  vbottom_hi = vmlal_n_u16(vbottom_hi, vget_high_u16(vbr16), column_weight);
+  const uint16x8_t vtop = vcombine_u16(vrshrn_n_u32(vtop_lo, 4), vrshrn_n_u32(vtop_hi, 4));
+  const uint16x8_t vbottom = vcombine_u16(vrshrn_n_u32(vbottom_lo, 4), vrshrn_n_u32(vbottom_hi, 4));
+
+  uint32x4_t vacc_lo = vmull_n_u16(vget_low_u16(vtop), row_complement);
+  uint32x4_t vacc_hi = vmull_n_u16(vget_high_u16(vtop), row_complement);
+  vacc_lo = vmlal_n_u16(vacc_lo, vget_low_u16(vbottom), row_weight);
+  vacc_hi = vmlal_n_u16(vacc_hi, vget_high_u16(vbottom), row_weight);
+  const uint16x8_t vout = vcombine_u16(vmovn_u32(vrshrq_n_u32(vacc_lo, 18)), vmovn_u32(vrshrq_n_u32(vacc_hi, 18)));
+  return vqmovn_u16(vout);
+}
+
+void u8bilinear_ukernel__neon(
+    size_t output_width,
+    size_t channels,
+    const uint8_t* top,
+    const uint8_t* bottom,
+    size_t input_pixel_stride,
+    const uint32_t* columns,
+    const int16_t* column_weights,
+    int16_t row_weight,
+    uint8_t* output,
+    size_t output_pixel_stride)
+{
+  assert(output_width != 0);
+  assert(channels != 0);
+
+  do {
+    const size_t left_offset = (size_t) columns[0] * input_pixel_stride;
+    const size_t right_offset = (size_t) columns[1] * input_pixel_stride;
+    columns += 2;
+    const uint16_t column_weight = (uint16_t) *column_weights++;
+
+    const uint8_t* tl = top + left_offset;
+    const uint8_t* tr = top + right_offset;
+    const uint8_t* bl = bottom + left_offset;
+    const uint8_t* br = bottom + right_offset;
+    uint8_t* o = output;
+    size_t c = channels;
+    for (; c >= 8; c -= 8) {
+      const uint8x8_t vtl = vld1_u8(tl); tl += 8;
+      const uint8x8_t vtr = vld1_u8(tr); tr += 8;
+      const uint8x8_t vbl = vld1_u8(bl); bl += 8;
+      const uint8x8_t vbr = vld1_u8(br); br += 8;
+      vst1_u8(o, u8bilinear_8x__neon(vtl, vtr, vbl, vbr, column_weight, (uint16_t) row_weight));
+      o += 8;
+    }
+    if (c != 0) {
+      /* The remainder goes through local buffers rather than reading and writing past the pixel */
+      uint8_t tl_block[8], tr_block[8], bl_block[8], br_block[8];
+      memcpy(tl_block, tl, c);
+      memcpy(tr_block, tr, c);
+      memcpy(bl_block, bl, c);
+      memcpy(br_block, br, c);
+      uint8_t o_block[8];
+      vst1_u8(o_block, u8bilinear_8x__neon(
+        vld1_u8(tl_block), vld1_u8(tr_block), vld1_u8(bl_block), vld1_u8(br_block),
+        column_weight, (uint16_t) row_weight));
+      memcpy(o, o_block, c);
+    }
+    output += output_pixel_stride;
+  } while (--output_width != 0);
+}
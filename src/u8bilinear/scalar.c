@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/u8bilinear.h>
+
+
+/* Same Q11 weights and roundings as u8bilinear_ukernel__sse2, so that all microkernels agree bit for bit */
+void u8bilinear_ukernel__scalar(
+    size_t output_width,
+    size_t channels,
+    const uint8_t* top,
+    const uint8_t* bottom,
+    size_t input_pixel_stride,
+    const uint32_t* columns,
+    const int16_t* column_weights,
+    int16_t row_weight,
+    uint8_t* output,
+    size_t output_pixel_stride)
+{
+  assert(output_width != 0);
+  assert(channels != 0);
+
+  /* Weights are in [0, 2048], so every intermediate is non-negative */
+  const uint32_t vrow_weight = (uint32_t) (uint16_t) row_weight;
+  do {
+    const size_t left_offset = (size_t) columns[0] * input_pixel_stride;
+    const size_t right_offset = (size_t) columns[1] * input_pixel_stride;
+    columns += 2;
+    const uint32_t vcolumn_weight = (uint32_t) (uint16_t) *column_weights++;
+
+    const uint8_t* tl = top + left_offset;
+    const uint8_t* tr = top + right_offset;
+    const uint8_t* bl = bottom + left_offset;
+    const uint8_t* br = bottom + right_offset;
+    uint8_t* o = output;
+    for (size_t c = channels; c != 0; c--) {
+      const uint32_t vtop = ((uint32_t) *tl++ * (2048 - vcolumn_weight) + (uint32_t) *tr++ * vcolumn_weight + 8) >> 4;
+      const uint32_t vbottom =
+        ((uint32_t) *bl++ * (2048 - vcolumn_weight) + (uint32_t) *br++ * vcolumn_weight + 8) >> 4;
+      const uint32_t vacc = vtop * (2048 - vrow_weight) + vbottom * vrow_weight + (UINT32_C(1) << 17);
+      *o++ = (uint8_t) (vacc >> 18);
+    }
+    output += output_pixel_stride;
+  } while (--output_width != 0);
+}
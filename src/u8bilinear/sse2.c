@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/u8bilinear.h>
+
+
+/*
+ * Interpolates 8 channels: the left and right pixels of each row are weighted in Q11 and rounded to Q7, which keeps
+ * them in 16 bits, and the top and bottom results are weighted in Q11 again and rounded from Q18.
+ */
+static inline __m128i u8bilinear_8x__sse2(
+    __m128i vtl,
+    __m128i vtr,
+    __m128i vbl,
+    __m128i vbr,
+    __m128i vcolumn_weights,
+    __m128i vrow_weights)
+{
+  const __m128i vzero = _mm_setzero_si128();
+  const __m128i vtl16 = _mm_unpacklo_epi8(vtl, vzero);
+  const __m128i vtr16 = _mm_unpacklo_epi8(vtr, vzero);
+  const __m128i vbl16 = _mm_unpacklo_epi8(vbl, vzero);
+  const __m128i vbr16 = _mm_unpacklo_epi8(vbr, vzero);
+
+  const __m128i vq7_rounding = _mm_set1_epi32(8);
+  const __m128i vtop_lo = _mm_srai_epi32(
+    _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(vtl16, vtr16), vcolumn_weights), vq7_rounding), 4);
+  const __m128i vtop_hi = _mm_srai_epi32(
+    _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(vtl16, vtr16), vcolumn_weights), vq7_rounding), 4);
+  const __m128i vbottom_lo = _mm_srai_epi32(
+    _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(vbl16, vbr16), vcolumn_weights), vq7_rounding), 4);
+  const __m128i vbottom_hi = _mm_srai_epi32(
+    _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(vbl16, vbr16), vcolumn_weights), vq7_rounding), 4);
+  const __m128i vtop = _mm_packs_epi32(vtop_lo, vtop_hi);
+  const __m128i vbottom = _mm_packs_epi32(vbottom_lo, vbottom_hi);
+
+  const __m128i vq18_rounding = _mm_set1_epi32(INT32_C(1) << 17);
+  const __m128i vacc_lo = _mm_srli_epi32(
+    _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(vtop, vbottom), vrow_weights), vq18_rounding), 18);
+  const __m128i vacc_hi = _mm_srli_epi32(
+    _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(vtop, vbottom), vrow_weights), vq18_rounding), 18);
+  const __m128i vout = _mm_packs_epi32(vacc_lo, vacc_hi);
+  return _mm_packus_epi16(vout, vout);
+}
+
+/* Pairs of (1 - weight, weight) in Q11, which _mm_madd_epi16 applies to interleaved pairs of pixels */
+static inline __m128i u8bilinear_weights__sse2(int16_t weight) {
+  return _mm_set1_epi32((int32_t) (((uint32_t) (uint16_t) weight << 16) | (uint32_t) (2048 - weight)));
+}
+
+void u8bilinear_ukernel__sse2(
+    size_t output_width,
+    size_t channels,
+    const uint8_t* top,
+    const uint8_t* bottom,
+    size_t input_pixel_stride,
+    const uint32_t* columns,
+    const int16_t* column_weights,
+    int16_t row_weight,
+    uint8_t* output,
+    size_t output_pixel_stride)
+{
+  assert(output_width != 0);
+  assert(channels != 0);
+
+  const __m128i vrow_weights = u8bilinear_weights__sse2(row_weight);
+  do {
+    const size_t left_offset = (size_t) columns[0] * input_pixel_stride;
+    const size_t right_offset = (size_t) columns[1] * input_pixel_stride;
+    columns += 2;
+    const int16_t column_weight = *column_weights++;
+    const __m128i vcolumn_weights = u8bilinear_weights__sse2(column_weight);
+
+    const uint8_t* tl = top + left_offset;
+    const uint8_t* tr = top + right_offset;
+    const uint8_t* bl = bottom + left_offset;
+    const uint8_t* br = bottom + right_offset;
+    uint8_t* o = output;
+    size_t c = channels;
+    for (; c >= 8; c -= 8) {
+      const __m128i vtl = _mm_loadl_epi64((const __m128i*) tl); tl += 8;
+      const __m128i vtr = _mm_loadl_epi64((const __m128i*) tr); tr += 8;
+      const __m128i vbl = _mm_loadl_epi64((const __m128i*) bl); bl += 8;
+      const __m128i vbr = _mm_loadl_epi64((const __m128i*) br); br += 8;
+      _mm_storel_epi64((__m128i*) o, u8bilinear_8x__sse2(vtl, vtr, vbl, vbr, vcolumn_weights, vrow_weights));
+      o += 8;
+    }
+    if (c != 0) {
+      /* The remainder goes through local buffers rather than reading and writing past the pixel */
+      uint8_t tl_block[8], tr_block[8], bl_block[8], br_block[8];
+      memcpy(tl_block, tl, c);
+      memcpy(tr_block, tr, c);
+      memcpy(bl_block, bl, c);
+      memcpy(br_block, br, c);
+      const __m128i vout = u8bilinear_8x__sse2(
+        _mm_loadl_epi64((const __m128i*) tl_block), _mm_loadl_epi64((const __m128i*) tr_block),
+        _mm_loadl_epi64((const __m128i*) bl_block), _mm_loadl_epi64((const __m128i*) br_block),
+        vcolumn_weights, vrow_weights);
+      uint8_t o_block[8];
+      _mm_storel_epi64((__m128i*) o_block, vout);
+      memcpy(o, o_block, c);
+    }
+    output += output_pixel_stride;
+  } while (--output_width != 0);
+}
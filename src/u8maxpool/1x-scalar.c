@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/u8maxpool.h>
+
+
+void u8maxpool_ukernel_1x__scalar(
+    size_t channels,
+    size_t output_width,
+    size_t kernel_size,
+    const uint8_t** input,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    const union qnnp_u8_clamping_params clamping_params[restrict static 1])
+{
+  assert(channels != 0);
+  assert(output_width != 0);
+  assert(kernel_size != 0);
+
+  const int32_t voutput_max = clamping_params->scalar.output_max;
+  const int32_t voutput_min = clamping_params->scalar.output_min;
+  do {
+    for (size_t c = 0; c < channels; c++) {
+      int32_t vmax = voutput_min;
+      for (size_t k = 0; k < kernel_size; k++) {
+        const int32_t vi = (int32_t) (uint32_t) input[k][input_offset + c];
+        vmax = vi > vmax ? vi : vmax;
+      }
+      *output++ = (uint8_t) (vmax < voutput_max ? vmax : voutput_max);
+    }
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
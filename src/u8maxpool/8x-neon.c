@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <arm_neon.h>
+
+#include <qnnpack/u8maxpool.h>
+
+
+static inline uint8x8_t u8maxpool_8c__neon(
+    size_t kernel_size,
+    const uint8_t** input,
+    size_t input_offset,
+    size_t c)
+{
+  uint8x8_t vmax = vdup_n_u8(0);
+  do {
+    const uint8_t* i = *input++ + input_offset;
+    uint8x8_t vi;
+    if QNNP_LIKELY(c == 8) {
+      vi = vld1_u8(i);
+    } else {
+      uint8_t block[8] = { 0 };
+      memcpy(block, i, c);
+      vi = vld1_u8(block);
+    }
+    vmax = vmax_u8(vmax, vi);
+  } while (--kernel_size != 0);
+  return vmax;
+}
+
+void u8maxpool_ukernel_8x__neon(
+    size_t channels,
+    size_t output_width,
+    size_t kernel_size,
+    const uint8_t** input,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    const union qnnp_u8_clamping_params clamping_params[restrict static 1])
+{
+  assert(channels != 0);
+  assert(output_width != 0);
+  assert(kernel_size != 0);
+
+  const uint8x8_t voutput_max = vld1_dup_u8(&clamping_params->neon.output_max);
+  const uint8x8_t voutput_min = vld1_dup_u8(&clamping_params->neon.output_min);
+  do {
+    size_t c = channels;
+    size_t offset = input_offset;
+    for (; c >= 8; c -= 8) {
+      uint8x8_t vout = u8maxpool_8c__neon(kernel_size, input, offset, 8);
+      vout = vmax_u8(vout, voutput_min);
+      vout = vmin_u8(vout, voutput_max);
+      vst1_u8(output, vout); output += 8;
+      offset += 8;
+    }
+    if (c != 0) {
+      if (channels >= 8) {
+        /* Recompute the last 8 channels, which overlap the previous group, rather than reading past the pixel */
+        const size_t c_decrement = 8 - c;
+        uint8x8_t vout = u8maxpool_8c__neon(kernel_size, input, offset - c_decrement, 8);
+        vout = vmax_u8(vout, voutput_min);
+        vout = vmin_u8(vout, voutput_max);
+        vst1_u8(output - c_decrement, vout);
+      } else {
+        uint8x8_t vout = u8maxpool_8c__neon(kernel_size, input, offset, c);
+        vout = vmax_u8(vout, voutput_min);
+        vout = vmin_u8(vout, voutput_max);
+        uint8_t block[8];
+        vst1_u8(block, vout);
+        memcpy(output, block, c);
+      }
+      output += c;
+    }
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
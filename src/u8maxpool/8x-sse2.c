@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/u8maxpool.h>
+
+
+static inline __m128i u8maxpool_8c__sse2(
+    size_t kernel_size,
+    const uint8_t** input,
+    size_t input_offset,
+    size_t c)
+{
+  __m128i vmax = _mm_setzero_si128();
+  do {
+    const uint8_t* i = *input++ + input_offset;
+    __m128i vi;
+    if QNNP_LIKELY(c == 8) {
+      vi = _mm_loadl_epi64((const __m128i*) i);
+    } else {
+      uint8_t block[8] = { 0 };
+      memcpy(block, i, c);
+      vi = _mm_loadl_epi64((const __m128i*) block);
+    }
+    vmax = _mm_max_epu8(vmax, vi);
+  } while (--kernel_size != 0);
+  return vmax;
+}
+
+void u8maxpool_ukernel_8x__sse2(
+    size_t channels,
+    size_t output_width,
+    size_t kernel_size,
+    const uint8_t** input,
+    uint8_t* output,
+    size_t input_stride,
+    size_t output_increment,
+    size_t input_offset,
+    const union qnnp_u8_clamping_params clamping_params[restrict static 1])
+{
+  assert(channels != 0);
+  assert(output_width != 0);
+  assert(kernel_size != 0);
+
+  const __m128i voutput_max = _mm_load_si128((const __m128i*) clamping_params->sse2.output_max);
+  const __m128i voutput_min = _mm_load_si128((const __m128i*) clamping_params->sse2.output_min);
+  do {
+    size_t c = channels;
+    size_t offset = input_offset;
+    for (; c >= 8; c -= 8) {
+      __m128i vout = u8maxpool_8c__sse2(kernel_size, input, offset, 8);
+      vout = _mm_max_epu8(vout, voutput_min);
+      vout = _mm_min_epu8(vout, voutput_max);
+      _mm_storel_epi64((__m128i*) output, vout); output += 8;
+      offset += 8;
+    }
+    if (c != 0) {
+      if (channels >= 8) {
+        /* Recompute the last 8 channels, which overlap the previous group, rather than reading past the pixel */
+        const size_t c_decrement = 8 - c;
+        __m128i vout = u8maxpool_8c__sse2(kernel_size, input, offset - c_decrement, 8);
+        vout = _mm_max_epu8(vout, voutput_min);
+        vout = _mm_min_epu8(vout, voutput_max);
+        _mm_storel_epi64((__m128i*) (output - c_decrement), vout);
+      } else {
+        __m128i vout = u8maxpool_8c__sse2(kernel_size, input, offset, c);
+        vout = _mm_max_epu8(vout, voutput_min);
+        vout = _mm_min_epu8(vout, voutput_max);
+        uint8_t block[8];
+        _mm_storel_epi64((__m128i*) block, vout);
+        memcpy(output, block, c);
+      }
+      output += c;
+    }
+    input = (const uint8_t**) ((uintptr_t) input + input_stride);
+    output = (uint8_t*) ((uintptr_t) output + output_increment);
+  } while (--output_width != 0);
+}
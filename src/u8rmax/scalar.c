@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/u8rmax.h>
+
+
+uint8_t u8rmax_ukernel__scalar(
+    size_t n,
+    const uint8_t* x)
+{
+  assert(n != 0);
+
+  uint8_t vmax0 = 0;
+  uint8_t vmax1 = 0;
+  for (; n >= 2; n -= 2) {
+    const uint8_t vx0 = x[0];
+    const uint8_t vx1 = x[1];
+    x += 2;
+
+    vmax0 = vx0 > vmax0 ? vx0 : vmax0;
+    vmax1 = vx1 > vmax1 ? vx1 : vmax1;
+  }
+  if (n != 0) {
+    const uint8_t vx = *x;
+    vmax0 = vx > vmax0 ? vx : vmax0;
+  }
+  return vmax0 > vmax1 ? vmax0 : vmax1;
+}
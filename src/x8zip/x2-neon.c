@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <arm_neon.h>
+
+#include <qnnpack/x8zip.h>
+
+
+void x8zip_ukernel_x2__neon(
+    size_t n,
+    const void* x,
+    void* y)
+{
+  assert(n != 0);
+
+  const uint8_t* x0 = x;
+  const uint8_t* x1 = x0 + n;
+  uint8_t* o = y;
+
+  if (n >= 8) {
+    for (size_t c = n; c >= 8; c -= 8) {
+      uint8x8x2_t vxy;
+      vxy.val[0] = vld1_u8(x0); x0 += 8;
+      vxy.val[1] = vld1_u8(x1); x1 += 8;
+      vst2_u8(o, vxy); o += 16;
+    }
+    const size_t c = n & 7;
+    if (c != 0) {
+      /* Rezip the last 8 channels, which overlap the previous block, rather than reading past the group */
+      const size_t c_decrement = 8 - c;
+      uint8x8x2_t vxy;
+      vxy.val[0] = vld1_u8(x0 - c_decrement);
+      vxy.val[1] = vld1_u8(x1 - c_decrement);
+      vst2_u8(o - 2 * c_decrement, vxy);
+    }
+  } else {
+    do {
+      o[0] = *x0++;
+      o[1] = *x1++;
+      o += 2;
+    } while (--n != 0);
+  }
+}
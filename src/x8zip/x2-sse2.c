@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/x8zip.h>
+
+
+void x8zip_ukernel_x2__sse2(
+    size_t n,
+    const void* x,
+    void* y)
+{
+  assert(n != 0);
+
+  const uint8_t* x0 = x;
+  const uint8_t* x1 = x0 + n;
+  uint8_t* o = y;
+
+  if (n >= 16) {
+    for (size_t c = n; c >= 16; c -= 16) {
+      const __m128i vx0 = _mm_loadu_si128((const __m128i*) x0); x0 += 16;
+      const __m128i vx1 = _mm_loadu_si128((const __m128i*) x1); x1 += 16;
+      _mm_storeu_si128((__m128i*) o, _mm_unpacklo_epi8(vx0, vx1));
+      _mm_storeu_si128((__m128i*) (o + 16), _mm_unpackhi_epi8(vx0, vx1));
+      o += 32;
+    }
+    const size_t c = n & 15;
+    if (c != 0) {
+      /* Rezip the last 16 channels, which overlap the previous block, rather than reading past the group */
+      const size_t c_decrement = 16 - c;
+      const __m128i vx0 = _mm_loadu_si128((const __m128i*) (x0 - c_decrement));
+      const __m128i vx1 = _mm_loadu_si128((const __m128i*) (x1 - c_decrement));
+      o -= 2 * c_decrement;
+      _mm_storeu_si128((__m128i*) o, _mm_unpacklo_epi8(vx0, vx1));
+      _mm_storeu_si128((__m128i*) (o + 16), _mm_unpackhi_epi8(vx0, vx1));
+    }
+  } else {
+    do {
+      o[0] = *x0++;
+      o[1] = *x1++;
+      o += 2;
+    } while (--n != 0);
+  }
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/x8zip.h>
+
+
+void x8zip_ukernel_x3__scalar(
+    size_t n,
+    const void* x,
+    void* y)
+{
+  assert(n != 0);
+
+  const uint8_t* x0 = x;
+  const uint8_t* x1 = x0 + n;
+  const uint8_t* x2 = x1 + n;
+  uint8_t* o = y;
+  do {
+    o[0] = *x0++;
+    o[1] = *x1++;
+    o[2] = *x2++;
+    o += 3;
+  } while (--n != 0);
+}
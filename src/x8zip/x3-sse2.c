@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/x8zip.h>
+
+
+/* Packs the 3 low bytes of both 32-bit lanes in every 64-bit half into its 6 low bytes */
+static inline __m128i x8zip_pack_3x2__sse2(__m128i v) {
+  const __m128i vlo = _mm_and_si128(v, _mm_set_epi32(0, -1, 0, -1));
+  const __m128i vhi = _mm_slli_epi64(_mm_srli_epi64(v, 32), 24);
+  return _mm_or_si128(vlo, vhi);
+}
+
+static inline void x8zip_x3_8c__sse2(
+    const uint8_t* x0,
+    const uint8_t* x1,
+    const uint8_t* x2,
+    uint8_t* o)
+{
+  const __m128i vzero = _mm_setzero_si128();
+  const __m128i vx0 = _mm_loadl_epi64((const __m128i*) x0);
+  const __m128i vx1 = _mm_loadl_epi64((const __m128i*) x1);
+  const __m128i vx2 = _mm_loadl_epi64((const __m128i*) x2);
+
+  /* 32-bit lanes of channels 0-3 and 4-7 hold the 3 groups and a zero byte */
+  const __m128i vx01 = _mm_unpacklo_epi8(vx0, vx1);
+  const __m128i vx2z = _mm_unpacklo_epi8(vx2, vzero);
+  const __m128i vc0123 = x8zip_pack_3x2__sse2(_mm_unpacklo_epi16(vx01, vx2z));
+  const __m128i vc4567 = x8zip_pack_3x2__sse2(_mm_unpackhi_epi16(vx01, vx2z));
+
+  /* Move the 6 bytes of the high 64-bit halves next to the 6 bytes of the low ones */
+  const __m128i vc0123_packed =
+    _mm_or_si128(_mm_move_epi64(vc0123), _mm_slli_si128(_mm_unpackhi_epi64(vc0123, vzero), 6));
+  const __m128i vc4567_packed =
+    _mm_or_si128(_mm_move_epi64(vc4567), _mm_slli_si128(_mm_unpackhi_epi64(vc4567, vzero), 6));
+
+  _mm_storeu_si128((__m128i*) o, _mm_or_si128(vc0123_packed, _mm_slli_si128(vc4567_packed, 12)));
+  _mm_storel_epi64((__m128i*) (o + 16), _mm_srli_si128(vc4567_packed, 4));
+}
+
+void x8zip_ukernel_x3__sse2(
+    size_t n,
+    const void* x,
+    void* y)
+{
+  assert(n != 0);
+
+  const uint8_t* x0 = x;
+  const uint8_t* x1 = x0 + n;
+  const uint8_t* x2 = x1 + n;
+  uint8_t* o = y;
+
+  if (n >= 8) {
+    for (size_t c = n; c >= 8; c -= 8) {
+      x8zip_x3_8c__sse2(x0, x1, x2, o);
+      x0 += 8;
+      x1 += 8;
+      x2 += 8;
+      o += 24;
+    }
+    const size_t c = n & 7;
+    if (c != 0) {
+      /* Rezip the last 8 channels, which overlap the previous block, rather than reading past the group */
+      const size_t c_decrement = 8 - c;
+      x8zip_x3_8c__sse2(x0 - c_decrement, x1 - c_decrement, x2 - c_decrement, o - 3 * c_decrement);
+    }
+  } else {
+    do {
+      o[0] = *x0++;
+      o[1] = *x1++;
+      o[2] = *x2++;
+      o += 3;
+    } while (--n != 0);
+  }
+}
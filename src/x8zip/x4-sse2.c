@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/x8zip.h>
+
+
+static inline void x8zip_x4_16c__sse2(
+    const uint8_t* x0,
+    const uint8_t* x1,
+    const uint8_t* x2,
+    const uint8_t* x3,
+    uint8_t* o)
+{
+  const __m128i vx0 = _mm_loadu_si128((const __m128i*) x0);
+  const __m128i vx1 = _mm_loadu_si128((const __m128i*) x1);
+  const __m128i vx2 = _mm_loadu_si128((const __m128i*) x2);
+  const __m128i vx3 = _mm_loadu_si128((const __m128i*) x3);
+
+  const __m128i vx01_lo = _mm_unpacklo_epi8(vx0, vx1);
+  const __m128i vx01_hi = _mm_unpackhi_epi8(vx0, vx1);
+  const __m128i vx23_lo = _mm_unpacklo_epi8(vx2, vx3);
+  const __m128i vx23_hi = _mm_unpackhi_epi8(vx2, vx3);
+  _mm_storeu_si128((__m128i*) o, _mm_unpacklo_epi16(vx01_lo, vx23_lo));
+  _mm_storeu_si128((__m128i*) (o + 16), _mm_unpackhi_epi16(vx01_lo, vx23_lo));
+  _mm_storeu_si128((__m128i*) (o + 32), _mm_unpacklo_epi16(vx01_hi, vx23_hi));
+  _mm_storeu_si128((__m128i*) (o + 48), _mm_unpackhi_epi16(vx01_hi, vx23_hi));
+}
+
+void x8zip_ukernel_x4__sse2(
+    size_t n,
+    const void* x,
+    void* y)
+{
+  assert(n != 0);
+
+  const uint8_t* x0 = x;
+  const uint8_t* x1 = x0 + n;
+  const uint8_t* x2 = x1 + n;
+  const uint8_t* x3 = x2 + n;
+  uint8_t* o = y;
+
+  if (n >= 16) {
+    for (size_t c = n; c >= 16; c -= 16) {
+      x8zip_x4_16c__sse2(x0, x1, x2, x3, o);
+      x0 += 16;
+      x1 += 16;
+      x2 += 16;
+      x3 += 16;
+      o += 64;
+    }
+    const size_t c = n & 15;
+    if (c != 0) {
+      /* Rezip the last 16 channels, which overlap the previous block, rather than reading past the group */
+      const size_t c_decrement = 16 - c;
+      x8zip_x4_16c__sse2(
+        x0 - c_decrement, x1 - c_decrement, x2 - c_decrement, x3 - c_decrement,
+        o - 4 * c_decrement);
+    }
+  } else {
+    do {
+      o[0] = *x0++;
+      o[1] = *x1++;
+      o[2] = *x2++;
+      o[3] = *x3++;
+      o += 4;
+    } while (--n != 0);
+  }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <arm_neon.h>
+
+#include <qnnpack/x8zip.h>
+
+
+static inline void x8zip_4x8c__neon(
+    const uint8_t* x0,
+    const uint8_t* x1,
+    const uint8_t* x2,
+    const uint8_t* x3,
+    uint8_t* o,
+    size_t m)
+{
+  const uint8x8_t vx0 = vld1_u8(x0);
+  const uint8x8_t vx1 = vld1_u8(x1);
+  const uint8x8_t vx2 = vld1_u8(x2);
+  const uint8x8_t vx3 = vld1_u8(x3);
+
+  const uint8x8x2_t vx01 = vzip_u8(vx0, vx1);
+  const uint8x8x2_t vx23 = vzip_u8(vx2, vx3);
+  const uint16x4x2_t vx0123_lo =
+    vzip_u16(vreinterpret_u16_u8(vx01.val[0]), vreinterpret_u16_u8(vx23.val[0]));
+  const uint16x4x2_t vx0123_hi =
+    vzip_u16(vreinterpret_u16_u8(vx01.val[1]), vreinterpret_u16_u8(vx23.val[1]));
+
+  /* Every 32-bit lane holds one channel of the 4 groups */
+  const uint32x2_t vc01 = vreinterpret_u32_u16(vx0123_lo.val[0]);
+  const uint32x2_t vc23 = vreinterpret_u32_u16(vx0123_lo.val[1]);
+  const uint32x2_t vc45 = vreinterpret_u32_u16(vx0123_hi.val[0]);
+  const uint32x2_t vc67 = vreinterpret_u32_u16(vx0123_hi.val[1]);
+  vst1_lane_u32(__builtin_assume_aligned(o, 1), vc01, 0); o += m;
+  vst1_lane_u32(__builtin_assume_aligned(o, 1), vc01, 1); o += m;
+  vst1_lane_u32(__builtin_assume_aligned(o, 1), vc23, 0); o += m;
+  vst1_lane_u32(__builtin_assume_aligned(o, 1), vc23, 1); o += m;
+  vst1_lane_u32(__builtin_assume_aligned(o, 1), vc45, 0); o += m;
+  vst1_lane_u32(__builtin_assume_aligned(o, 1), vc45, 1); o += m;
+  vst1_lane_u32(__builtin_assume_aligned(o, 1), vc67, 0); o += m;
+  vst1_lane_u32(__builtin_assume_aligned(o, 1), vc67, 1);
+}
+
+void x8zip_ukernel_xm__neon(
+    size_t n,
+    size_t m,
+    const void* x,
+    void* y)
+{
+  assert(n != 0);
+  assert(m >= 4);
+
+  const uint8_t* input = x;
+  uint8_t* output = y;
+
+  if (n >= 8) {
+    size_t g = 0;
+    do {
+      /* When m is not a multiple of 4, the last 4 groups overlap the previous ones */
+      if (g > m - 4) {
+        g = m - 4;
+      }
+      const uint8_t* x0 = input + g * n;
+      const uint8_t* x1 = x0 + n;
+      const uint8_t* x2 = x1 + n;
+      const uint8_t* x3 = x2 + n;
+      uint8_t* o = output + g;
+
+      size_t c = n;
+      for (; c >= 8; c -= 8) {
+        x8zip_4x8c__neon(x0, x1, x2, x3, o, m);
+        x0 += 8;
+        x1 += 8;
+        x2 += 8;
+        x3 += 8;
+        o += 8 * m;
+      }
+      if (c != 0) {
+        /* Rezip the last 8 channels, which overlap the previous block, rather than reading past the group */
+        const size_t c_decrement = 8 - c;
+        x8zip_4x8c__neon(
+          x0 - c_decrement, x1 - c_decrement, x2 - c_decrement, x3 - c_decrement,
+          o - c_decrement * m, m);
+      }
+      g += 4;
+    } while (g < m);
+  } else {
+    for (size_t c = 0; c < n; c++) {
+      for (size_t g = 0; g < m; g++) {
+        *output++ = input[g * n + c];
+      }
+    }
+  }
+}
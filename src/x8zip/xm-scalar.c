@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <qnnpack/x8zip.h>
+
+
+void x8zip_ukernel_xm__scalar(
+    size_t n,
+    size_t m,
+    const void* x,
+    void* y)
+{
+  assert(n != 0);
+  assert(m >= 4);
+
+  const uint8_t* input = x;
+  uint8_t* output = y;
+  for (size_t g = 0; g < m; g++) {
+    const uint8_t* i = input + g * n;
+    uint8_t* o = output + g;
+    for (size_t c = n; c != 0; c--) {
+      *o = *i++;
+      o += m;
+    }
+  }
+}
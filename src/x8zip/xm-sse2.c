@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+
+#include <immintrin.h>
+
+#include <qnnpack/x8zip.h>
+
+
+static inline void x8zip_4x8c__sse2(
+    const uint8_t* x0,
+    const uint8_t* x1,
+    const uint8_t* x2,
+    const uint8_t* x3,
+    uint8_t* o,
+    size_t m)
+{
+  const __m128i vx0 = _mm_loadl_epi64((const __m128i*) x0);
+  const __m128i vx1 = _mm_loadl_epi64((const __m128i*) x1);
+  const __m128i vx2 = _mm_loadl_epi64((const __m128i*) x2);
+  const __m128i vx3 = _mm_loadl_epi64((const __m128i*) x3);
+
+  /* Every 32-bit lane holds one channel of the 4 groups */
+  const __m128i vx01 = _mm_unpacklo_epi8(vx0, vx1);
+  const __m128i vx23 = _mm_unpacklo_epi8(vx2, vx3);
+  const __m128i vc0123 = _mm_unpacklo_epi16(vx01, vx23);
+  const __m128i vc4567 = _mm_unpackhi_epi16(vx01, vx23);
+  *((uint32_t*) o) = (uint32_t) _mm_cvtsi128_si32(vc0123); o += m;
+  *((uint32_t*) o) = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(vc0123, 4)); o += m;
+  *((uint32_t*) o) = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(vc0123, 8)); o += m;
+  *((uint32_t*) o) = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(vc0123, 12)); o += m;
+  *((uint32_t*) o) = (uint32_t) _mm_cvtsi128_si32(vc4567); o += m;
+  *((uint32_t*) o) = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(vc4567, 4)); o += m;
+  *((uint32_t*) o) = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(vc4567, 8)); o += m;
+  *((uint32_t*) o) = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(vc4567, 12));
+}
+
+void x8zip_ukernel_xm__sse2(
+    size_t n,
+    size_t m,
+    const void* x,
+    void* y)
+{
+  assert(n != 0);
+  assert(m >= 4);
+
+  const uint8_t* input = x;
+  uint8_t* output = y;
+
+  if (n >= 8) {
+    size_t g = 0;
+    do {
+      /* When m is not a multiple of 4, the last 4 groups overlap the previous ones */
+      if (g > m - 4) {
+        g = m - 4;
+      }
+      const uint8_t* x0 = input + g * n;
+      const uint8_t* x1 = x0 + n;
+      const uint8_t* x2 = x1 + n;
+      const uint8_t* x3 = x2 + n;
+      uint8_t* o = output + g;
+
+      size_t c = n;
+      for (; c >= 8; c -= 8) {
+        x8zip_4x8c__sse2(x0, x1, x2, x3, o, m);
+        x0 += 8;
+        x1 += 8;
+        x2 += 8;
+        x3 += 8;
+        o += 8 * m;
+      }
+      if (c != 0) {
+        /* Rezip the last 8 channels, which overlap the previous block, rather than reading past the group */
+        const size_t c_decrement = 8 - c;
+        x8zip_4x8c__sse2(
+          x0 - c_decrement, x1 - c_decrement, x2 - c_decrement, x3 - c_decrement,
+          o - c_decrement * m, m);
+      }
+      g += 4;
+    } while (g < m);
+  } else {
+    for (size_t c = 0; c < n; c++) {
+      for (size_t g = 0; g < m; g++) {
+        *output++ = input[g * n + c];
+      }
+    }
+  }
+}
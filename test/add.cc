@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "add-tester.h"
+
+
+TEST(ADD_OP, zero_batch_size) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t add_op = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_add_nc_q8(
+      7, 127, 1.0f, 127, 1.0f, 127, 1.0f, 0, 255, 0, &add_op));
+  uint8_t data[7] = { 0 };
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_add_nc_q8(add_op, 0, data, 7, data, 7, data, 7, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(add_op));
+}
+
+TEST(ADD_OP, unsupported_scale_ratio) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t add_op = nullptr;
+  ASSERT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_create_add_nc_q8(
+      7, 127, 256.0f, 127, 1.0f, 127, 1.0f, 0, 255, 0, &add_op));
+  ASSERT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_create_add_nc_q8(
+      7, 127, 1.0f, 127, 1.0e-5f, 127, 1.0f, 0, 255, 0, &add_op));
+}
+
+TEST(ADD_OP, unit_batch) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    AddTester()
+      .batchSize(1)
+      .channels(channels)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(ADD_OP, unit_batch_with_qmin) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    AddTester()
+      .batchSize(1)
+      .channels(channels)
+      .qmin(128)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(ADD_OP, unit_batch_with_qmax) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    AddTester()
+      .batchSize(1)
+      .channels(channels)
+      .qmax(128)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(ADD_OP, unit_batch_with_scales) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    for (float scale = 1.0e-2f; scale < 1.0e+2f; scale *= 10.0f) {
+      AddTester()
+        .batchSize(1)
+        .channels(channels)
+        .aScale(scale)
+        .bScale(scale * 0.125f)
+        .iterations(1)
+        .test();
+      AddTester()
+        .batchSize(1)
+        .channels(channels)
+        .yScale(scale)
+        .iterations(1)
+        .test();
+    }
+  }
+}
+
+TEST(ADD_OP, unit_batch_with_zero_points) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    for (int32_t zeroPoint = 0; zeroPoint <= 255; zeroPoint += 51) {
+      AddTester()
+        .batchSize(1)
+        .channels(channels)
+        .aZeroPoint(uint8_t(zeroPoint))
+        .bZeroPoint(uint8_t(255 - zeroPoint))
+        .yZeroPoint(uint8_t(zeroPoint))
+        .iterations(1)
+        .test();
+    }
+  }
+}
+
+TEST(ADD_OP, small_batch) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    AddTester()
+      .batchSize(3)
+      .channels(channels)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(ADD_OP, small_batch_with_strides) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    AddTester()
+      .batchSize(3)
+      .channels(channels)
+      .aStride(129)
+      .bStride(117)
+      .yStride(123)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(ADD_OP, small_batch_inplace) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    AddTester()
+      .batchSize(3)
+      .channels(channels)
+      .inplace(true)
+      .iterations(3)
+      .test();
+    AddTester()
+      .batchSize(3)
+      .channels(channels)
+      .yStride(123)
+      .inplace(true)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(ADD_OP, large_batch) {
+  /* Densely packed operands larger than a parallel task */
+  AddTester()
+    .batchSize(1000)
+    .channels(17)
+    .iterations(1)
+    .test();
+}
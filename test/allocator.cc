@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <qnnpack.h>
+
+
+namespace {
+
+/* Counts live allocations of each kind, and records which pointers came from aligned_allocate */
+struct CountingAllocator {
+  size_t allocations = 0;
+  size_t alignedAllocations = 0;
+  size_t liveAllocations = 0;
+  size_t liveAlignedAllocations = 0;
+  size_t minAlignment = SIZE_MAX;
+  std::set<void*> alignedPointers;
+};
+
+void* countingAllocate(void* context, size_t size) {
+  CountingAllocator* allocator = static_cast<CountingAllocator*>(context);
+  void* pointer = malloc(size);
+  if (pointer != nullptr) {
+    allocator->allocations++;
+    allocator->liveAllocations++;
+  }
+  return pointer;
+}
+
+void* countingReallocate(void* context, void* pointer, size_t size) {
+  CountingAllocator* allocator = static_cast<CountingAllocator*>(context);
+  void* newPointer = realloc(pointer, size);
+  if (pointer == nullptr && newPointer != nullptr) {
+    allocator->allocations++;
+    allocator->liveAllocations++;
+  }
+  return newPointer;
+}
+
+void countingDeallocate(void* context, void* pointer) {
+  CountingAllocator* allocator = static_cast<CountingAllocator*>(context);
+  EXPECT_EQ(0u, allocator->alignedPointers.count(pointer));
+  allocator->liveAllocations--;
+  free(pointer);
+}
+
+void* countingAlignedAllocate(void* context, size_t alignment, size_t size) {
+  CountingAllocator* allocator = static_cast<CountingAllocator*>(context);
+  void* pointer = nullptr;
+  if (posix_memalign(&pointer, alignment, size) != 0) {
+    return nullptr;
+  }
+  allocator->alignedAllocations++;
+  allocator->liveAlignedAllocations++;
+  allocator->minAlignment = std::min(allocator->minAlignment, alignment);
+  allocator->alignedPointers.insert(pointer);
+  return pointer;
+}
+
+void countingAlignedDeallocate(void* context, void* pointer) {
+  CountingAllocator* allocator = static_cast<CountingAllocator*>(context);
+  EXPECT_EQ(1u, allocator->alignedPointers.erase(pointer));
+  allocator->liveAlignedAllocations--;
+  free(pointer);
+}
+
+CountingAllocator countingAllocator;
+
+}  // namespace
+
+TEST(ALLOCATOR, incomplete_allocator) {
+  struct qnnp_allocator allocator = { };
+  allocator.allocate = countingAllocate;
+  struct qnnp_initialize_options options = { };
+  options.allocator = &allocator;
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_initialize_with_options(&options));
+}
+
+TEST(ALLOCATOR, convolution_buffers) {
+  struct qnnp_allocator allocator = { };
+  allocator.context = &countingAllocator;
+  allocator.allocate = countingAllocate;
+  allocator.reallocate = countingReallocate;
+  allocator.deallocate = countingDeallocate;
+  allocator.aligned_allocate = countingAlignedAllocate;
+  allocator.aligned_deallocate = countingAlignedDeallocate;
+  struct qnnp_initialize_options options = { };
+  options.allocator = &allocator;
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize_with_options(&options));
+
+  const std::vector<uint8_t> kernel(16 * 3 * 3 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t convolution = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      1, 1, 1, 1,
+      3, 3,
+      1, 1,
+      1, 1,
+      1, 8, 16,
+      127, 1.0f,
+      127, 1.0f,
+      kernel.data(), bias.data(),
+      127, 100.0f, 0, 255,
+      0 /* flags */,
+      &convolution));
+  /* Packed kernel, packed bias, and zero buffer */
+  EXPECT_EQ(3u, countingAllocator.liveAlignedAllocations);
+  EXPECT_LE(64u, countingAllocator.minAlignment);
+  for (void* pointer : countingAllocator.alignedPointers) {
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(pointer) % 64);
+  }
+
+  std::vector<uint8_t> input(9 * 5 * 8);
+  std::vector<uint8_t> output(9 * 5 * 16);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(convolution, 1, 9, 5, input.data(), 8, output.data(), 16, nullptr));
+  /* Indirection buffer */
+  EXPECT_EQ(1u, countingAllocator.liveAllocations);
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(convolution, nullptr));
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+  EXPECT_EQ(0u, countingAllocator.liveAllocations);
+  EXPECT_EQ(0u, countingAllocator.liveAlignedAllocations);
+  EXPECT_NE(0u, countingAllocator.allocations);
+  EXPECT_NE(0u, countingAllocator.alignedAllocations);
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "pooling-tester.h"
+
+
+TEST(AVERAGE_POOLING_OP, unit_batch_3x3_pool) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(1)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .channels(channels)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_3x3s2_pool) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(1)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .stride(2)
+      .channels(channels)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_3x3s2_pool_with_padding) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    for (uint32_t padding = 1; padding <= 2; padding++) {
+      PoolingTester()
+        .batchSize(1)
+        .inputSize(13, 11)
+        .poolingSize(3)
+        .stride(2)
+        .padding(padding)
+        .channels(channels)
+        .testAveragePooling();
+    }
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_2x2s2_pool) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(1)
+      .inputSize(12, 10)
+      .poolingSize(2)
+      .stride(2)
+      .channels(channels)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_asymmetric_pool) {
+  for (uint32_t poolingHeight = 1; poolingHeight <= 5; poolingHeight++) {
+    for (uint32_t poolingWidth = 2; poolingWidth <= 5; poolingWidth++) {
+      PoolingTester()
+        .batchSize(1)
+        .inputSize(9, 8)
+        .poolingHeight(poolingHeight)
+        .poolingWidth(poolingWidth)
+        .strideHeight(1)
+        .strideWidth(2)
+        .channels(19)
+        .testAveragePooling();
+    }
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_with_asymmetric_padding) {
+  PoolingTester()
+    .batchSize(1)
+    .inputSize(9, 8)
+    .poolingSize(3)
+    .paddingTop(2)
+    .paddingLeft(1)
+    .channels(19)
+    .testAveragePooling();
+  PoolingTester()
+    .batchSize(1)
+    .inputSize(9, 8)
+    .poolingSize(3)
+    .paddingBottom(2)
+    .paddingRight(1)
+    .channels(19)
+    .testAveragePooling();
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_with_stride_above_pool_size) {
+  PoolingTester()
+    .batchSize(1)
+    .inputSize(13, 13)
+    .poolingSize(2)
+    .stride(3)
+    .channels(19)
+    .testAveragePooling();
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_with_input_stride) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(1)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .stride(2)
+      .channels(channels)
+      .inputPixelStride(channels * 2 + 3)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_with_output_stride) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(1)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .stride(2)
+      .channels(channels)
+      .outputPixelStride(channels * 2 + 3)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_with_qmin) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(1)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .channels(channels)
+      .qmin(128)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_with_qmax) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(1)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .channels(channels)
+      .qmax(128)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, small_batch) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(3)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .stride(2)
+      .padding(1)
+      .channels(channels)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, small_batch_with_input_stride) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(3)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .stride(2)
+      .channels(channels)
+      .inputPixelStride(channels * 2 + 3)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, small_batch_with_threads) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    PoolingTester()
+      .batchSize(2)
+      .inputSize(7, 7)
+      .poolingSize(3)
+      .padding(1)
+      .channels(channels)
+      .threads(4)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_with_scales) {
+  for (float inputScale = 0.01f; inputScale < 9.0f; inputScale *= 3.14159265f) {
+    PoolingTester()
+      .batchSize(1)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .padding(1)
+      .channels(19)
+      .inputScale(inputScale)
+      .outputScale(0.97f)
+      .testAveragePooling();
+  }
+}
+
+TEST(AVERAGE_POOLING_OP, unit_batch_with_zero_points) {
+  for (int32_t zeroPoint = 0; zeroPoint <= 255; zeroPoint += 51) {
+    PoolingTester()
+      .batchSize(1)
+      .inputSize(13, 11)
+      .poolingSize(3)
+      .padding(1)
+      .channels(19)
+      .inputZeroPoint(uint8_t(zeroPoint))
+      .outputZeroPoint(uint8_t(255 - zeroPoint))
+      .testAveragePooling();
+  }
+}
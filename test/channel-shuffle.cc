@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "channel-shuffle-tester.h"
+
+
+TEST(CHANNEL_SHUFFLE_OP, invalid_parameters) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t channel_shuffle_op = nullptr;
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_channel_shuffle_nc_x8(1, 8, 0, &channel_shuffle_op));
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_channel_shuffle_nc_x8(2, 0, 0, &channel_shuffle_op));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_channel_shuffle_nc_x8(2, 8, 0, &channel_shuffle_op));
+  uint8_t data[16] = { 0 };
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_channel_shuffle_nc_x8(channel_shuffle_op, 0, data, 16, data, 16, nullptr));
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_channel_shuffle_nc_x8(channel_shuffle_op, 1, data, 15, data, 16, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(channel_shuffle_op));
+}
+
+TEST(CHANNEL_SHUFFLE_OP, two_groups_unit_batch) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(1)
+      .groups(2)
+      .groupChannels(groupChannels)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, two_groups_small_batch) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(3)
+      .groups(2)
+      .groupChannels(groupChannels)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, two_groups_small_batch_with_input_stride) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(3)
+      .groups(2)
+      .groupChannels(groupChannels)
+      .inputStride(2 * groupChannels + 7)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, two_groups_small_batch_with_output_stride) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(3)
+      .groups(2)
+      .groupChannels(groupChannels)
+      .outputStride(2 * groupChannels + 11)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, three_groups_unit_batch) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(1)
+      .groups(3)
+      .groupChannels(groupChannels)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, three_groups_small_batch) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(3)
+      .groups(3)
+      .groupChannels(groupChannels)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, three_groups_small_batch_with_input_stride) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(3)
+      .groups(3)
+      .groupChannels(groupChannels)
+      .inputStride(3 * groupChannels + 7)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, three_groups_small_batch_with_output_stride) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(3)
+      .groups(3)
+      .groupChannels(groupChannels)
+      .outputStride(3 * groupChannels + 11)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, four_groups_unit_batch) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(1)
+      .groups(4)
+      .groupChannels(groupChannels)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, four_groups_small_batch) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(3)
+      .groups(4)
+      .groupChannels(groupChannels)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, four_groups_small_batch_with_input_stride) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(3)
+      .groups(4)
+      .groupChannels(groupChannels)
+      .inputStride(4 * groupChannels + 7)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, four_groups_small_batch_with_output_stride) {
+  for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+    ChannelShuffleTester()
+      .batchSize(3)
+      .groups(4)
+      .groupChannels(groupChannels)
+      .outputStride(4 * groupChannels + 11)
+      .iterations(3)
+      .testX8();
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, many_groups_unit_batch) {
+  for (size_t groups = 5; groups < 12; groups += 3) {
+    for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+      ChannelShuffleTester()
+        .batchSize(1)
+        .groups(groups)
+        .groupChannels(groupChannels)
+        .iterations(3)
+        .testX8();
+    }
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, many_groups_small_batch) {
+  for (size_t groups = 5; groups < 12; groups += 3) {
+    for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+      ChannelShuffleTester()
+        .batchSize(3)
+        .groups(groups)
+        .groupChannels(groupChannels)
+        .iterations(3)
+        .testX8();
+    }
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, many_groups_small_batch_with_input_stride) {
+  for (size_t groups = 5; groups < 12; groups += 3) {
+    for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+      ChannelShuffleTester()
+        .batchSize(3)
+        .groups(groups)
+        .groupChannels(groupChannels)
+        .inputStride(groups * groupChannels + 7)
+        .iterations(3)
+        .testX8();
+    }
+  }
+}
+
+TEST(CHANNEL_SHUFFLE_OP, many_groups_small_batch_with_output_stride) {
+  for (size_t groups = 5; groups < 12; groups += 3) {
+    for (size_t groupChannels = 1; groupChannels < 100; groupChannels += 15) {
+      ChannelShuffleTester()
+        .batchSize(3)
+        .groups(groups)
+        .groupChannels(groupChannels)
+        .outputStride(groups * groupChannels + 11)
+        .iterations(3)
+        .testX8();
+    }
+  }
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <qnnpack.h>
+
+
+class ConcatTester {
+ public:
+  inline ConcatTester& inputChannels(std::vector<size_t> inputChannels) {
+    assert(!inputChannels.empty());
+    this->inputChannels_ = inputChannels;
+    return *this;
+  }
+
+  inline const std::vector<size_t>& inputChannels() const {
+    return this->inputChannels_;
+  }
+
+  inline size_t inputs() const {
+    return this->inputChannels_.size();
+  }
+
+  inline size_t outputChannels() const {
+    size_t outputChannels = 0;
+    for (size_t channels : this->inputChannels_) {
+      outputChannels += channels;
+    }
+    return outputChannels;
+  }
+
+  inline ConcatTester& inputStridePadding(size_t inputStridePadding) {
+    this->inputStridePadding_ = inputStridePadding;
+    return *this;
+  }
+
+  inline size_t inputStridePadding() const {
+    return this->inputStridePadding_;
+  }
+
+  inline ConcatTester& outputStridePadding(size_t outputStridePadding) {
+    this->outputStridePadding_ = outputStridePadding;
+    return *this;
+  }
+
+  inline size_t outputStride() const {
+    return outputChannels() + this->outputStridePadding_;
+  }
+
+  inline ConcatTester& batchSize(size_t batchSize) {
+    this->batchSize_ = batchSize;
+    return *this;
+  }
+
+  inline size_t batchSize() const {
+    return this->batchSize_;
+  }
+
+  /* Inputs quantized like the output, which the operator copies */
+  inline ConcatTester& sameQuantization(bool sameQuantization) {
+    this->sameQuantization_ = sameQuantization;
+    return *this;
+  }
+
+  inline bool sameQuantization() const {
+    return this->sameQuantization_;
+  }
+
+  inline ConcatTester& qmin(uint8_t qmin) {
+    this->qmin_ = qmin;
+    return *this;
+  }
+
+  inline uint8_t qmin() const {
+    return this->qmin_;
+  }
+
+  inline ConcatTester& qmax(uint8_t qmax) {
+    this->qmax_ = qmax;
+    return *this;
+  }
+
+  inline uint8_t qmax() const {
+    return this->qmax_;
+  }
+
+  inline ConcatTester& iterations(size_t iterations) {
+    this->iterations_ = iterations;
+    return *this;
+  }
+
+  inline size_t iterations() const {
+    return this->iterations_;
+  }
+
+  void testQ8() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+    auto scaleRng = std::bind(std::uniform_real_distribution<float>(0.25f, 4.0f), rng);
+
+    const uint8_t outputZeroPoint = 131;
+    const float outputScale = 0.75f;
+
+    std::vector<std::vector<uint8_t>> inputs(this->inputs());
+    std::vector<size_t> inputStrides(this->inputs());
+    std::vector<uint8_t> inputZeroPoints(this->inputs());
+    std::vector<float> inputScales(this->inputs());
+    for (size_t j = 0; j < this->inputs(); j++) {
+      inputStrides[j] = inputChannels()[j] + inputStridePadding();
+      inputs[j].resize((batchSize() - 1) * inputStrides[j] + inputChannels()[j]);
+    }
+    std::vector<uint8_t> output((batchSize() - 1) * outputStride() + outputChannels());
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      for (size_t j = 0; j < this->inputs(); j++) {
+        std::generate(inputs[j].begin(), inputs[j].end(), std::ref(u8rng));
+        inputZeroPoints[j] = sameQuantization() ? outputZeroPoint : u8rng();
+        inputScales[j] = sameQuantization() ? outputScale : outputScale * scaleRng();
+      }
+      std::fill(output.begin(), output.end(), 0xA5);
+
+      /* Create, setup, run, and destroy Concat operator */
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t concat_op = nullptr;
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_concat_nc_q8(
+          this->inputs(), inputChannels().data(),
+          inputZeroPoints.data(), inputScales.data(),
+          outputZeroPoint, outputScale,
+          qmin(), qmax(),
+          0, &concat_op));
+      ASSERT_NE(nullptr, concat_op);
+
+      std::vector<const uint8_t*> inputPointers(this->inputs());
+      for (size_t j = 0; j < this->inputs(); j++) {
+        inputPointers[j] = inputs[j].data();
+      }
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_concat_nc_q8(
+          concat_op,
+          batchSize(),
+          inputPointers.data(), inputStrides.data(),
+          output.data(), outputStride(),
+          nullptr /* thread pool */));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_run_operator(concat_op, nullptr /* thread pool */));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_delete_operator(concat_op));
+      concat_op = nullptr;
+
+      /* Verify results */
+      for (size_t i = 0; i < batchSize(); i++) {
+        size_t channelOffset = 0;
+        for (size_t j = 0; j < this->inputs(); j++) {
+          for (size_t c = 0; c < inputChannels()[j]; c++) {
+            const uint8_t x = inputs[j][i * inputStrides[j] + c];
+            const float yRef = std::max<float>(std::min<float>(
+              float(outputZeroPoint) + inputScales[j] / outputScale * (int32_t(x) - int32_t(inputZeroPoints[j])),
+              float(qmax())), float(qmin()));
+            const uint8_t y = output[i * outputStride() + channelOffset + c];
+            if (sameQuantization() && qmin() == 0 && qmax() == 255) {
+              ASSERT_EQ(uint32_t(x), uint32_t(y))
+                << "batch index " << i << ", input " << j << ", channel " << c;
+            } else {
+              ASSERT_NEAR(yRef, float(int32_t(y)), 0.6f)
+                << "batch index " << i << ", input " << j << ", channel " << c;
+            }
+          }
+          channelOffset += inputChannels()[j];
+        }
+        for (size_t k = outputChannels(); i + 1 < batchSize() && k < outputStride(); k++) {
+          ASSERT_EQ(uint32_t(0xA5), uint32_t(output[i * outputStride() + k]))
+            << "batch index " << i << ", padding " << k << " was overwritten";
+        }
+      }
+    }
+  }
+
+ private:
+  std::vector<size_t> inputChannels_{1};
+  size_t inputStridePadding_{0};
+  size_t outputStridePadding_{0};
+  size_t batchSize_{1};
+  bool sameQuantization_{false};
+  uint8_t qmin_{0};
+  uint8_t qmax_{255};
+  size_t iterations_{15};
+};
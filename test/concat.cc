@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "concat-tester.h"
+
+
+TEST(CONCAT_OP, invalid_parameters) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t concat_op = nullptr;
+  const size_t channels[2] = { 7, 0 };
+  const uint8_t zeroPoints[2] = { 127, 127 };
+  const float scales[2] = { 1.0f, 1.0f };
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_concat_nc_q8(0, channels, zeroPoints, scales, 127, 1.0f, 0, 255, 0, &concat_op));
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_concat_nc_q8(2, channels, zeroPoints, scales, 127, 1.0f, 0, 255, 0, &concat_op));
+  ASSERT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_create_concat_nc_q8(1, channels, zeroPoints, scales, 127, 1.0e-3f, 0, 255, 0, &concat_op));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_concat_nc_q8(1, channels, zeroPoints, scales, 127, 1.0f, 0, 255, 0, &concat_op));
+  uint8_t data[7] = { 0 };
+  const uint8_t* inputs[1] = { data };
+  const size_t shortStride[1] = { 6 };
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_concat_nc_q8(concat_op, 1, inputs, shortStride, data, 7, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(concat_op));
+}
+
+TEST(CONCAT_OP, two_inputs_unit_batch) {
+  ConcatTester()
+    .inputChannels({ 13, 7 })
+    .batchSize(1)
+    .testQ8();
+}
+
+TEST(CONCAT_OP, two_inputs_small_batch) {
+  ConcatTester()
+    .inputChannels({ 13, 7 })
+    .batchSize(5)
+    .testQ8();
+}
+
+TEST(CONCAT_OP, many_inputs_small_batch) {
+  ConcatTester()
+    .inputChannels({ 1, 8, 17, 3, 64, 5 })
+    .batchSize(5)
+    .testQ8();
+}
+
+TEST(CONCAT_OP, small_batch_with_input_stride) {
+  ConcatTester()
+    .inputChannels({ 13, 7, 24 })
+    .inputStridePadding(5)
+    .batchSize(5)
+    .testQ8();
+}
+
+TEST(CONCAT_OP, small_batch_with_output_stride) {
+  ConcatTester()
+    .inputChannels({ 13, 7, 24 })
+    .outputStridePadding(9)
+    .batchSize(5)
+    .testQ8();
+}
+
+TEST(CONCAT_OP, small_batch_with_qmin) {
+  ConcatTester()
+    .inputChannels({ 13, 7, 24 })
+    .batchSize(5)
+    .qmin(128)
+    .testQ8();
+}
+
+TEST(CONCAT_OP, small_batch_with_qmax) {
+  ConcatTester()
+    .inputChannels({ 13, 7, 24 })
+    .batchSize(5)
+    .qmax(128)
+    .testQ8();
+}
+
+TEST(CONCAT_OP, same_quantization) {
+  ConcatTester()
+    .inputChannels({ 13, 7, 24 })
+    .outputStridePadding(9)
+    .batchSize(5)
+    .sameQuantization(true)
+    .testQ8();
+}
+
+TEST(CONCAT_OP, same_quantization_with_qmax) {
+  ConcatTester()
+    .inputChannels({ 13, 7, 24 })
+    .batchSize(5)
+    .sameQuantization(true)
+    .qmax(128)
+    .testQ8();
+}
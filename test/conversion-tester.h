@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+/* Tests quantize, dequantize, and requantize operators on a batch of strided rows */
+class ConversionTester {
+ public:
+  inline ConversionTester& channels(size_t channels) {
+    assert(channels != 0);
+    this->channels_ = channels;
+    return *this;
+  }
+
+  inline size_t channels() const {
+    return this->channels_;
+  }
+
+  inline ConversionTester& inputStride(size_t inputStride) {
+    assert(inputStride != 0);
+    this->inputStride_ = inputStride;
+    return *this;
+  }
+
+  inline size_t inputStride() const {
+    if (this->inputStride_ == 0) {
+      return this->channels_;
+    } else {
+      assert(this->inputStride_ >= this->channels_);
+      return this->inputStride_;
+    }
+  }
+
+  inline ConversionTester& outputStride(size_t outputStride) {
+    assert(outputStride != 0);
+    this->outputStride_ = outputStride;
+    return *this;
+  }
+
+  inline size_t outputStride() const {
+    if (this->outputStride_ == 0) {
+      return this->channels_;
+    } else {
+      assert(this->outputStride_ >= this->channels_);
+      return this->outputStride_;
+    }
+  }
+
+  inline ConversionTester& batchSize(size_t batchSize) {
+    this->batchSize_ = batchSize;
+    return *this;
+  }
+
+  inline size_t batchSize() const {
+    return this->batchSize_;
+  }
+
+  /* Requantize the input in place; the input and output strides must match */
+  inline ConversionTester& inPlace(bool inPlace) {
+    this->inPlace_ = inPlace;
+    return *this;
+  }
+
+  inline bool inPlace() const {
+    return this->inPlace_;
+  }
+
+  inline ConversionTester& qmin(uint8_t qmin) {
+    this->qmin_ = qmin;
+    return *this;
+  }
+
+  inline uint8_t qmin() const {
+    return this->qmin_;
+  }
+
+  inline ConversionTester& qmax(uint8_t qmax) {
+    this->qmax_ = qmax;
+    return *this;
+  }
+
+  inline uint8_t qmax() const {
+    return this->qmax_;
+  }
+
+  inline ConversionTester& threads(size_t threads) {
+    this->threads_ = threads;
+    return *this;
+  }
+
+  inline size_t threads() const {
+    return this->threads_;
+  }
+
+  inline ConversionTester& iterations(size_t iterations) {
+    this->iterations_ = iterations;
+    return *this;
+  }
+
+  inline size_t iterations() const {
+    return this->iterations_;
+  }
+
+  void testQuantize() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+    auto scaleRng = std::bind(std::uniform_real_distribution<float>(0.01f, 1.0f), rng);
+
+    std::vector<float> input((batchSize() - 1) * inputStride() + channels());
+    std::vector<uint8_t> output((batchSize() - 1) * outputStride() + channels());
+    pthreadpool_t threadpool = threads() > 1 ? pthreadpool_create(threads()) : nullptr;
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      const uint8_t outputZeroPoint = u8rng();
+      const float outputScale = scaleRng();
+      /* Inputs well beyond the output range, so that clamping is tested too */
+      auto f32rng = std::bind(std::uniform_real_distribution<float>(-300.0f * outputScale, 300.0f * outputScale), rng);
+      std::generate(input.begin(), input.end(), std::ref(f32rng));
+      std::fill(output.begin(), output.end(), 0xA5);
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t quantize_op = nullptr;
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_quantize_nc_f32_q8(
+          channels(), outputZeroPoint, outputScale, qmin(), qmax(), 0, &quantize_op));
+      ASSERT_NE(nullptr, quantize_op);
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_quantize_nc_f32_q8(
+          quantize_op, batchSize(), input.data(), inputStride(), output.data(), outputStride(), threadpool));
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(quantize_op, threadpool));
+      ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(quantize_op));
+
+      const float scale = 1.0f / outputScale;
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t c = 0; c < channels(); c++) {
+          const float x = input[i * inputStride() + c] * scale;
+          const float yRef = std::min<float>(std::max<float>(
+            std::nearbyint(x) + float(outputZeroPoint), float(qmin())), float(qmax()));
+          ASSERT_EQ(uint32_t(yRef), uint32_t(output[i * outputStride() + c]))
+            << "batch index " << i << ", channel " << c << ", input " << input[i * inputStride() + c];
+        }
+        for (size_t c = channels(); i + 1 < batchSize() && c < outputStride(); c++) {
+          ASSERT_EQ(uint32_t(0xA5), uint32_t(output[i * outputStride() + c]))
+            << "batch index " << i << ", padding " << c << " was overwritten";
+        }
+      }
+    }
+    if (threadpool != nullptr) {
+      pthreadpool_destroy(threadpool);
+    }
+  }
+
+  void testDequantize() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+    auto scaleRng = std::bind(std::uniform_real_distribution<float>(0.01f, 1.0f), rng);
+
+    std::vector<uint8_t> input((batchSize() - 1) * inputStride() + channels());
+    std::vector<float> output((batchSize() - 1) * outputStride() + channels());
+    pthreadpool_t threadpool = threads() > 1 ? pthreadpool_create(threads()) : nullptr;
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      const uint8_t inputZeroPoint = u8rng();
+      const float inputScale = scaleRng();
+      std::generate(input.begin(), input.end(), std::ref(u8rng));
+      std::fill(output.begin(), output.end(), std::nanf(""));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t dequantize_op = nullptr;
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_dequantize_nc_q8_f32(channels(), inputZeroPoint, inputScale, 0, &dequantize_op));
+      ASSERT_NE(nullptr, dequantize_op);
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_dequantize_nc_q8_f32(
+          dequantize_op, batchSize(), input.data(), inputStride(), output.data(), outputStride(), threadpool));
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(dequantize_op, threadpool));
+      ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(dequantize_op));
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t c = 0; c < channels(); c++) {
+          const float yRef =
+            float(int32_t(input[i * inputStride() + c]) - int32_t(inputZeroPoint)) * inputScale;
+          ASSERT_EQ(yRef, output[i * outputStride() + c])
+            << "batch index " << i << ", channel " << c;
+        }
+        for (size_t c = channels(); i + 1 < batchSize() && c < outputStride(); c++) {
+          ASSERT_TRUE(std::isnan(output[i * outputStride() + c]))
+            << "batch index " << i << ", padding " << c << " was overwritten";
+        }
+      }
+    }
+    if (threadpool != nullptr) {
+      pthreadpool_destroy(threadpool);
+    }
+  }
+
+  void testRequantize() const {
+    assert(!inPlace() || inputStride() == outputStride());
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+    auto scaleRng = std::bind(std::uniform_real_distribution<float>(0.25f, 4.0f), rng);
+
+    std::vector<uint8_t> input((batchSize() - 1) * inputStride() + channels());
+    std::vector<uint8_t> output((batchSize() - 1) * outputStride() + channels());
+    pthreadpool_t threadpool = threads() > 1 ? pthreadpool_create(threads()) : nullptr;
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      const uint8_t inputZeroPoint = u8rng();
+      const uint8_t outputZeroPoint = u8rng();
+      const float outputScale = 0.75f;
+      const float inputScale = outputScale * scaleRng();
+      std::generate(input.begin(), input.end(), std::ref(u8rng));
+      std::fill(output.begin(), output.end(), 0xA5);
+      const std::vector<uint8_t> inputCopy(input);
+      uint8_t* outputData = inPlace() ? input.data() : output.data();
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t requantize_op = nullptr;
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_requantize_nc_q8(
+          channels(), inputZeroPoint, inputScale, outputZeroPoint, outputScale, qmin(), qmax(), 0, &requantize_op));
+      ASSERT_NE(nullptr, requantize_op);
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_requantize_nc_q8(
+          requantize_op, batchSize(), input.data(), inputStride(), outputData, outputStride(), threadpool));
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(requantize_op, threadpool));
+      ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(requantize_op));
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t c = 0; c < channels(); c++) {
+          const uint8_t x = inputCopy[i * inputStride() + c];
+          const float yRef = std::max<float>(std::min<float>(
+            float(outputZeroPoint) + inputScale / outputScale * (int32_t(x) - int32_t(inputZeroPoint)),
+            float(qmax())), float(qmin()));
+          ASSERT_NEAR(yRef, float(int32_t(outputData[i * outputStride() + c])), 0.6f)
+            << "batch index " << i << ", channel " << c;
+        }
+        for (size_t c = channels(); !inPlace() && i + 1 < batchSize() && c < outputStride(); c++) {
+          ASSERT_EQ(uint32_t(0xA5), uint32_t(output[i * outputStride() + c]))
+            << "batch index " << i << ", padding " << c << " was overwritten";
+        }
+      }
+    }
+    if (threadpool != nullptr) {
+      pthreadpool_destroy(threadpool);
+    }
+  }
+
+ private:
+  size_t channels_{1};
+  size_t inputStride_{0};
+  size_t outputStride_{0};
+  size_t batchSize_{1};
+  bool inPlace_{false};
+  uint8_t qmin_{0};
+  uint8_t qmax_{255};
+  size_t threads_{1};
+  size_t iterations_{15};
+};
@@ -16,6 +16,9 @@
 #include <random>
 #include <vector>
 
+#include <cpuinfo.h>
+#include <fp16.h>
+
 #include <qnnpack.h>
 
 
@@ -314,6 +317,41 @@ class ConvolutionTester {
     }
   }
 
+  inline ConvolutionTester& kernelZeroPoint(uint8_t kernelZeroPoint) {
+    this->kernelZeroPoint_ = kernelZeroPoint;
+    return *this;
+  }
+
+  inline uint8_t kernelZeroPoint() const {
+    return this->kernelZeroPoint_;
+  }
+
+  /*
+   * Largest difference of the kernel from its zero point, or 0 for any kernel. Kernels close to their zero point let
+   * GEMM microkernels accumulate in 16 bits, see QNNP_OPERATOR_INFO_FLAG_ACC16.
+   */
+  inline ConvolutionTester& kernelMaxDeviation(uint8_t kernelMaxDeviation) {
+    this->kernelMaxDeviation_ = kernelMaxDeviation;
+    return *this;
+  }
+
+  inline uint8_t kernelMaxDeviation() const {
+    return this->kernelMaxDeviation_;
+  }
+
+  /*
+   * Sets about half of the blocks of 4 consecutive input channels of every kernel row to the kernel zero point, for the
+   * block-sparse microkernels of QNNP_CREATE_FLAG_SPARSE_KERNEL.
+   */
+  inline ConvolutionTester& prunedKernel(bool prunedKernel) {
+    this->prunedKernel_ = prunedKernel;
+    return *this;
+  }
+
+  inline bool prunedKernel() const {
+    return this->prunedKernel_;
+  }
+
   inline ConvolutionTester& qmin(uint8_t qmin) {
     this->qmin_ = qmin;
     return *this;
@@ -341,26 +379,164 @@ class ConvolutionTester {
     return this->iterations_;
   }
 
+  inline ConvolutionTester& flags(uint32_t flags) {
+    this->flags_ = flags;
+    return *this;
+  }
+
+  inline uint32_t flags() const {
+    return this->flags_;
+  }
+
+  inline ConvolutionTester& packingThreads(size_t packingThreads) {
+    this->packingThreads_ = packingThreads;
+    return *this;
+  }
+
+  inline size_t packingThreads() const {
+    return this->packingThreads_;
+  }
+
+  inline ConvolutionTester& threads(size_t threads) {
+    this->threads_ = threads;
+    return *this;
+  }
+
+  inline size_t threads() const {
+    return this->threads_;
+  }
+
+  inline ConvolutionTester& repeatSetup(bool repeatSetup) {
+    this->repeatSetup_ = repeatSetup;
+    return *this;
+  }
+
+  inline bool repeatSetup() const {
+    return this->repeatSetup_;
+  }
+
+  inline ConvolutionTester& setOperatorIO(bool setOperatorIO) {
+    this->setOperatorIO_ = setOperatorIO;
+    return *this;
+  }
+
+  inline bool setOperatorIO() const {
+    return this->setOperatorIO_;
+  }
+
+  inline ConvolutionTester& setupCacheSize(size_t setupCacheSize) {
+    this->setupCacheSize_ = setupCacheSize;
+    return *this;
+  }
+
+  inline size_t setupCacheSize() const {
+    return this->setupCacheSize_;
+  }
+
+  inline ConvolutionTester& streamingRows(size_t streamingRows) {
+    this->streamingRows_ = streamingRows;
+    return *this;
+  }
+
+  inline size_t streamingRows() const {
+    return this->streamingRows_;
+  }
+
+  inline ConvolutionTester& invertingLookupTable(bool invertingLookupTable) {
+    this->invertingLookupTable_ = invertingLookupTable;
+    return *this;
+  }
+
+  inline bool invertingLookupTable() const {
+    return this->invertingLookupTable_;
+  }
+
+  inline ConvolutionTester& runs(size_t runs) {
+    this->runs_ = runs;
+    return *this;
+  }
+
+  inline size_t runs() const {
+    return this->runs_;
+  }
+
+  inline ConvolutionTester& inputWindow(size_t windowTop, size_t windowLeft) {
+    this->inputWindow_ = true;
+    this->windowTop_ = windowTop;
+    this->windowLeft_ = windowLeft;
+    return *this;
+  }
+
+  inline bool inputWindow() const {
+    return this->inputWindow_;
+  }
+
+  inline size_t windowTop() const {
+    return this->windowTop_;
+  }
+
+  inline size_t windowLeft() const {
+    return this->windowLeft_;
+  }
+
+  inline ConvolutionTester& rois(size_t rois) {
+    this->rois_ = rois;
+    return *this;
+  }
+
+  inline size_t rois() const {
+    return this->rois_;
+  }
+
+  inline ConvolutionTester& perChannel(bool perChannel) {
+    this->perChannel_ = perChannel;
+    return *this;
+  }
+
+  inline bool perChannel() const {
+    return this->perChannel_;
+  }
+
   void test() const {
     std::random_device randomDevice;
     auto rng = std::mt19937(randomDevice());
     auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
     auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+    auto scaleRng = std::bind(std::uniform_real_distribution<float>(0.5f, 1.0f), rng);
+    const int32_t kernelMin = kernelMaxDeviation() == 0 ? 0 :
+      std::max<int32_t>(int32_t(kernelZeroPoint()) - int32_t(kernelMaxDeviation()), 0);
+    const int32_t kernelMax = kernelMaxDeviation() == 0 ? 255 :
+      std::min<int32_t>(int32_t(kernelZeroPoint()) + int32_t(kernelMaxDeviation()), 255);
+    auto kernelRng = std::bind(std::uniform_int_distribution<int32_t>(kernelMin, kernelMax), rng);
 
     std::vector<uint8_t> input(batchSize() * ((inputHeight() * inputWidth() - 1) * inputPixelStride() + groups() * groupInputChannels()) + 8);
     std::vector<uint8_t> kernel(groups() * groupOutputChannels() * kernelHeight() * kernelWidth() * groupInputChannels());
     std::vector<int32_t> bias(groups() * groupOutputChannels());
+    /* Without perChannel, every output channel has kernel scale 1.0 */
+    std::vector<float> kernelScales(groups() * groupOutputChannels(), 1.0f);
     std::vector<uint8_t> output(batchSize() * ((outputHeight() * outputWidth() - 1) * outputPixelStride() + groups() * groupOutputChannels()));
     std::vector<int32_t> accumulators(batchSize() * outputHeight() * outputWidth() * groups() * groupOutputChannels());
 
     const uint8_t* inputPtr = input.data() + 8;
     const uint8_t inputZeroPoint = 127;
-    const uint8_t kernelZeroPoint = 127;
 
     for (size_t iteration = 0; iteration < iterations(); iteration++) {
       std::generate(input.begin(), input.end(), std::ref(u8rng));
-      std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+      std::generate(kernel.begin(), kernel.end(), [&] { return uint8_t(kernelRng()); });
+      if (prunedKernel()) {
+        const size_t rowSize = kernelHeight() * kernelWidth() * groupInputChannels();
+        for (size_t rowStart = 0; rowStart < kernel.size(); rowStart += rowSize) {
+          for (size_t blockStart = 0; blockStart < rowSize; blockStart += 4) {
+            if (u8rng() & 1) {
+              std::fill_n(&kernel[rowStart + blockStart], std::min<size_t>(4, rowSize - blockStart), kernelZeroPoint());
+            }
+          }
+        }
+      }
       std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+      if (perChannel()) {
+        std::generate(kernelScales.begin(), kernelScales.end(), std::ref(scaleRng));
+      }
       std::fill(output.begin(), output.end(), 0xA5);
       std::fill(accumulators.begin(), accumulators.end(), 0);
 
@@ -390,7 +566,7 @@ class ConvolutionTester {
                         for (size_t ic = 0; ic < groupInputChannels(); ic++) {
                           accumulators[(((i * outputHeight() + oy) * outputWidth() + ox) * groups() + g) * groupOutputChannels() + oc] +=
                             (int32_t(inputPtr[((i * inputHeight() + iy) * inputWidth() + ix) * inputPixelStride() + g * groupInputChannels() + ic]) - int32_t(inputZeroPoint)) *
-                            (int32_t(kernel[(((g * groupOutputChannels() + oc) * kernelHeight() + ky) * kernelWidth() + kx) * groupInputChannels() + ic]) - int32_t(kernelZeroPoint));
+                            (int32_t(kernel[(((g * groupOutputChannels() + oc) * kernelHeight() + ky) * kernelWidth() + kx) * groupInputChannels() + ic]) - int32_t(kernelZeroPoint()));
                         }
                       }
                     }
@@ -413,6 +589,286 @@ class ConvolutionTester {
       qnnp_operator_t convolution = nullptr;
 
 
+      if (perChannel()) {
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_create_convolution2d_nhwc_q8_per_channel(
+            paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+            kernelHeight(), kernelWidth(),
+            subsamplingHeight(), subsamplingWidth(),
+            dilationHeight(), dilationWidth(),
+            groups(), groupInputChannels(), groupOutputChannels(),
+            inputZeroPoint, 1.0f /* input scale */,
+            kernelZeroPoint(), kernelScales.data(),
+            kernel.data(), bias.data(),
+            outputZeroPoint, outputScale, qmin(), qmax(),
+            flags(),
+            &convolution));
+      } else if (packingThreads() != 0) {
+        pthreadpool_t threadpool = pthreadpool_create(packingThreads());
+        ASSERT_NE(nullptr, threadpool);
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_create_convolution2d_nhwc_q8_with_threadpool(
+            paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+            kernelHeight(), kernelWidth(),
+            subsamplingHeight(), subsamplingWidth(),
+            dilationHeight(), dilationWidth(),
+            groups(), groupInputChannels(), groupOutputChannels(),
+            inputZeroPoint, 1.0f /* input scale */,
+            kernelZeroPoint(), 1.0f /* kernel scale */,
+            kernel.data(), bias.data(),
+            outputZeroPoint, outputScale, qmin(), qmax(),
+            flags(),
+            threadpool,
+            &convolution));
+        pthreadpool_destroy(threadpool);
+      } else {
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_create_convolution2d_nhwc_q8(
+            paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+            kernelHeight(), kernelWidth(),
+            subsamplingHeight(), subsamplingWidth(),
+            dilationHeight(), dilationWidth(),
+            groups(), groupInputChannels(), groupOutputChannels(),
+            inputZeroPoint, 1.0f /* input scale */,
+            kernelZeroPoint(), 1.0f /* kernel scale */,
+            kernel.data(), bias.data(),
+            outputZeroPoint, outputScale, qmin(), qmax(),
+            flags(),
+            &convolution));
+      }
+
+      if (invertingLookupTable()) {
+        /* q -> 255 - q has unit slope, so the rounding tolerance of the reference comparison still holds */
+        uint8_t lookupTable[256];
+        for (size_t q = 0; q < 256; q++) {
+          lookupTable[q] = uint8_t(255 - q);
+        }
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_set_operator_lookup_table(convolution, lookupTable));
+      }
+
+      /*
+       * Set up and run with other input data of the same shape first, so the final setup only moves the input. With
+       * setOperatorIO, qnnp_set_operator_io replaces the final setup. With setupCacheSize, a setup with a wider input
+       * comes in between, so the final setup takes the indirection buffer from the setup cache.
+       */
+      std::vector<uint8_t> previousInput, previousOutput;
+      if (setupCacheSize() != 0) {
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_set_operator_setup_cache(convolution, setupCacheSize()));
+      }
+      if (repeatSetup() || setOperatorIO() || setupCacheSize() != 0) {
+        previousInput.resize(input.size());
+        previousOutput.resize(output.size());
+        std::generate(previousInput.begin(), previousInput.end(), std::ref(u8rng));
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_setup_convolution2d_nhwc_q8(
+            convolution,
+            batchSize(),
+            inputHeight(),
+            inputWidth(),
+            previousInput.data() + 8,
+            inputPixelStride(),
+            previousOutput.data(),
+            outputPixelStride(),
+            nullptr /* thread pool */));
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_run_operator(convolution, nullptr /* thread pool */));
+      }
+      if (setupCacheSize() != 0) {
+        /* Rows of the wider input have at most 3 more output pixels */
+        const size_t widerInputWidth = inputWidth() + 3;
+        std::vector<uint8_t> widerInput(batchSize() * inputHeight() * widerInputWidth * inputPixelStride() + 8);
+        std::vector<uint8_t> widerOutput(
+          batchSize() * outputHeight() * (outputWidth() + 3) * outputPixelStride());
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_setup_convolution2d_nhwc_q8(
+            convolution,
+            batchSize(),
+            inputHeight(),
+            widerInputWidth,
+            widerInput.data() + 8,
+            inputPixelStride(),
+            widerOutput.data(),
+            outputPixelStride(),
+            nullptr /* thread pool */));
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_run_operator(convolution, nullptr /* thread pool */));
+      }
+
+      if (streamingRows() != 0) {
+        /* Input rows arrive band by band into a buffer that holds garbage until then */
+        std::vector<uint8_t> streamedInput(input.size());
+        std::generate(streamedInput.begin(), streamedInput.end(), std::ref(u8rng));
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_setup_convolution2d_nhwc_q8(
+            convolution,
+            batchSize(),
+            inputHeight(),
+            inputWidth(),
+            streamedInput.data() + 8,
+            inputPixelStride(),
+            output.data(),
+            outputPixelStride(),
+            nullptr /* thread pool */));
+
+        for (size_t outputY = 0; outputY < outputHeight(); outputY += streamingRows()) {
+          const size_t outputRows = std::min(streamingRows(), outputHeight() - outputY);
+          size_t inputY = 0, inputRows = 0;
+          ASSERT_EQ(qnnp_status_success,
+            qnnp_get_convolution2d_nhwc_q8_input_rows(convolution, outputY, outputRows, &inputY, &inputRows));
+          ASSERT_LE(inputY + inputRows, inputHeight());
+          for (size_t i = 0; i < batchSize(); i++) {
+            const size_t begin = 8 + (i * inputHeight() + inputY) * inputWidth() * inputPixelStride();
+            const size_t end = std::min(8 + (i * inputHeight() + inputY + inputRows) * inputWidth() * inputPixelStride(), input.size());
+            std::copy(input.cbegin() + begin, input.cbegin() + end, streamedInput.begin() + begin);
+          }
+          ASSERT_EQ(qnnp_status_success,
+            qnnp_run_convolution2d_nhwc_q8_rows(convolution, outputY, outputRows, nullptr /* thread pool */));
+        }
+      } else {
+        /* With QNNP_CREATE_FLAG_INPUT_NCHW, the convolution reads the same pixels stored as planes of channels */
+        std::vector<uint8_t> nchwInput;
+        if (flags() & QNNP_CREATE_FLAG_INPUT_NCHW) {
+          const size_t channels = groups() * groupInputChannels();
+          nchwInput.resize(batchSize() * channels * inputHeight() * inputWidth() + 8);
+          for (size_t i = 0; i < batchSize(); i++) {
+            for (size_t c = 0; c < channels; c++) {
+              for (size_t pixel = 0; pixel < inputHeight() * inputWidth(); pixel++) {
+                nchwInput[8 + (i * channels + c) * inputHeight() * inputWidth() + pixel] =
+                  inputPtr[(i * inputHeight() * inputWidth() + pixel) * inputPixelStride() + c];
+              }
+            }
+          }
+        }
+        /*
+         * With inputWindow, the convolution reads the same pixels in place from a larger frame, at windowTop and
+         * windowLeft, with other pixels and images left and right, above and below.
+         */
+        std::vector<uint8_t> frame;
+        const size_t frameRowStride = (windowLeft() + inputWidth() + 3) * inputPixelStride();
+        const size_t frameImageStride = (windowTop() + inputHeight() + 2) * frameRowStride;
+        if (inputWindow()) {
+          frame.resize(batchSize() * frameImageStride + 8);
+          std::generate(frame.begin(), frame.end(), std::ref(u8rng));
+          for (size_t i = 0; i < batchSize(); i++) {
+            for (size_t y = 0; y < inputHeight(); y++) {
+              for (size_t x = 0; x < inputWidth(); x++) {
+                std::copy_n(
+                  &inputPtr[((i * inputHeight() + y) * inputWidth() + x) * inputPixelStride()],
+                  groups() * groupInputChannels(),
+                  &frame[8 + i * frameImageStride + (windowTop() + y) * frameRowStride +
+                    (windowLeft() + x) * inputPixelStride()]);
+              }
+            }
+          }
+        }
+        if (inputWindow()) {
+          ASSERT_EQ(qnnp_status_success,
+            qnnp_setup_convolution2d_nhwc_q8_with_strides(
+              convolution,
+              batchSize(),
+              inputHeight(),
+              inputWidth(),
+              frame.data() + 8 + windowTop() * frameRowStride + windowLeft() * inputPixelStride(),
+              inputPixelStride(),
+              frameRowStride,
+              frameImageStride,
+              output.data(),
+              outputPixelStride(),
+              nullptr /* thread pool */));
+        } else if (setOperatorIO()) {
+          ASSERT_EQ(qnnp_status_success,
+            qnnp_set_operator_io(
+              convolution,
+              nchwInput.empty() ? inputPtr : nchwInput.data() + 8,
+              output.data()));
+        } else {
+          ASSERT_EQ(qnnp_status_success,
+            qnnp_setup_convolution2d_nhwc_q8(
+              convolution,
+              batchSize(),
+              inputHeight(),
+              inputWidth(),
+              nchwInput.empty() ? inputPtr : nchwInput.data() + 8,
+              inputPixelStride(),
+              output.data(),
+              outputPixelStride(),
+              nullptr /* thread pool */));
+        }
+
+        pthreadpool_t threadpool = nullptr;
+        if (threads() != 0) {
+          threadpool = pthreadpool_create(threads());
+          ASSERT_NE(nullptr, threadpool);
+        }
+        /* Every run must compute the whole output, e.g. on either path of QNNP_CREATE_FLAG_CALIBRATE_XZP */
+        for (size_t run = 0; run < runs(); run++) {
+          std::fill(output.begin(), output.end(), UINT8_C(0xA5));
+          ASSERT_EQ(qnnp_status_success,
+            qnnp_run_operator(convolution, threadpool));
+        }
+        if (threadpool != nullptr) {
+          pthreadpool_destroy(threadpool);
+        }
+      }
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_delete_operator(convolution));
+      convolution = nullptr;
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t y = 0; y < outputHeight(); y++) {
+          for (size_t x = 0; x < outputWidth(); x++) {
+            for (size_t g = 0; g < groups(); g++) {
+              for (size_t c = 0; c < groupOutputChannels(); c++) {
+                const double scaledAccumulator =
+                  accumulators[(((i * outputHeight() + y) * outputWidth() + x) * groups() + g) * groupOutputChannels() + c] *
+                    double(kernelScales[g * groupOutputChannels() + c]) / outputScale;
+                const double clampedAccumulator = std::max(std::min(scaledAccumulator,
+                  double(qmax()) - double(outputZeroPoint)),
+                  double(qmin()) - double(outputZeroPoint));
+                const uint8_t outputValue =
+                  output[((i * outputHeight() + y) * outputWidth() + x) * outputPixelStride() + g * groupOutputChannels() + c];
+                ASSERT_NEAR(
+                  clampedAccumulator,
+                  (int32_t(invertingLookupTable() ? 255 - outputValue : outputValue) - outputZeroPoint),
+                  0.9) << "(x, y) = (" << x << ", " << y << "), group = " << g << ", channel = " << c;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /*
+   * Runs the convolution on rois() crops of a frame with the heights and widths of the input up to 2 and 4 pixels
+   * smaller, all in one setup, and checks the result against setups with each crop copied into a packed input.
+   */
+  void testROIs() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    const size_t channels = groups() * groupInputChannels();
+    const size_t frameWidth = inputWidth() + 5;
+    const size_t frameRowStride = frameWidth * inputPixelStride();
+    std::vector<uint8_t> frame((inputHeight() + 3) * frameRowStride + 8);
+    std::vector<uint8_t> kernel(
+      groups() * groupOutputChannels() * kernelHeight() * kernelWidth() * groupInputChannels());
+    std::vector<int32_t> bias(groups() * groupOutputChannels());
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(frame.begin(), frame.end(), std::ref(u8rng));
+      std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+      std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t convolution = nullptr;
+      /* Unit outputs for about the standard deviation of the accumulators */
+      const float outputScale = 64.0f * std::sqrt(float(kernelHeight() * kernelWidth() * groupInputChannels()));
       ASSERT_EQ(qnnp_status_success,
         qnnp_create_convolution2d_nhwc_q8(
           paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
@@ -420,19 +876,144 @@ class ConvolutionTester {
           subsamplingHeight(), subsamplingWidth(),
           dilationHeight(), dilationWidth(),
           groups(), groupInputChannels(), groupOutputChannels(),
-          inputZeroPoint, 1.0f /* input scale */,
-          kernelZeroPoint, 1.0f /* kernel scale */,
+          127 /* input zero point */, 1.0f /* input scale */,
+          kernelZeroPoint(), 1.0f /* kernel scale */,
           kernel.data(), bias.data(),
-          outputZeroPoint, outputScale, qmin(), qmax(),
+          127 /* output zero point */, outputScale, qmin(), qmax(),
+          flags(), &convolution));
+
+      std::vector<qnnp_roi> rois(this->rois());
+      std::vector<size_t> roiOutputOffsets(this->rois() + 1);
+      for (size_t i = 0; i < this->rois(); i++) {
+        const size_t height = inputHeight() - i % 3;
+        const size_t width = inputWidth() - i % 5;
+        rois[i] = qnnp_roi {
+          frame.data() + 8 + (i % 4) * frameRowStride + (i * 3 % 6) * inputPixelStride(),
+          height, width, frameRowStride,
+        };
+        const size_t outputPixels =
+          ((paddingTop() + height + paddingBottom() - dilatedKernelHeight()) / subsamplingHeight() + 1) *
+          ((paddingLeft() + width + paddingRight() - dilatedKernelWidth()) / subsamplingWidth() + 1);
+        roiOutputOffsets[i + 1] = roiOutputOffsets[i] + outputPixels * outputPixelStride();
+      }
+      std::vector<uint8_t> output(roiOutputOffsets.back());
+      std::vector<uint8_t> referenceOutput(roiOutputOffsets.back());
+
+      /* The reference runs first, so the ROI setup replaces the indirection buffer of a packed input */
+      for (size_t i = 0; i < this->rois(); i++) {
+        std::vector<uint8_t> packedInput(rois[i].height * rois[i].width * inputPixelStride() + 8);
+        for (size_t y = 0; y < rois[i].height; y++) {
+          for (size_t x = 0; x < rois[i].width; x++) {
+            std::copy_n(
+              rois[i].input + y * frameRowStride + x * inputPixelStride(), channels,
+              &packedInput[8 + (y * rois[i].width + x) * inputPixelStride()]);
+          }
+        }
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_setup_convolution2d_nhwc_q8(
+            convolution, 1, rois[i].height, rois[i].width,
+            packedInput.data() + 8, inputPixelStride(),
+            &referenceOutput[roiOutputOffsets[i]], outputPixelStride(),
+            nullptr /* thread pool */));
+        ASSERT_EQ(qnnp_status_success, qnnp_run_operator(convolution, nullptr /* thread pool */));
+      }
+
+      pthreadpool_t threadpool = nullptr;
+      if (threads() != 0) {
+        threadpool = pthreadpool_create(threads());
+        ASSERT_NE(nullptr, threadpool);
+      }
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_convolution2d_nhwc_q8_rois(
+          convolution, rois.size(), rois.data(), inputPixelStride(),
+          output.data(), outputPixelStride(), threadpool));
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(convolution, threadpool));
+      if (threadpool != nullptr) {
+        pthreadpool_destroy(threadpool);
+      }
+      ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+
+      for (size_t i = 0; i < this->rois(); i++) {
+        for (size_t offset = roiOutputOffsets[i]; offset < roiOutputOffsets[i + 1]; offset += outputPixelStride()) {
+          for (size_t c = 0; c < groups() * groupOutputChannels(); c++) {
+            ASSERT_EQ(uint32_t(referenceOutput[offset + c]), uint32_t(output[offset + c]))
+              << "ROI " << i << ", output pixel " << (offset - roiOutputOffsets[i]) / outputPixelStride()
+              << ", channel " << c;
+          }
+        }
+      }
+    }
+  }
+
+  void testF32() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto f32rng = std::bind(std::uniform_real_distribution<float>(-1.0f, 1.0f), rng);
+
+    std::vector<float> input((batchSize() * inputHeight() * inputWidth() - 1) * inputPixelStride() + groups() * groupInputChannels());
+    std::vector<float> kernel(groups() * groupOutputChannels() * kernelHeight() * kernelWidth() * groupInputChannels());
+    std::vector<float> bias(groups() * groupOutputChannels());
+    std::vector<float> output((batchSize() * outputHeight() * outputWidth() - 1) * outputPixelStride() + groups() * groupOutputChannels());
+    std::vector<double> outputRef(batchSize() * outputHeight() * outputWidth() * groups() * groupOutputChannels());
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(input.begin(), input.end(), std::ref(f32rng));
+      std::generate(kernel.begin(), kernel.end(), std::ref(f32rng));
+      std::generate(bias.begin(), bias.end(), std::ref(f32rng));
+      std::fill(output.begin(), output.end(), nanf(""));
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t oy = 0; oy < outputHeight(); oy++) {
+          for (size_t ox = 0; ox < outputWidth(); ox++) {
+            for (size_t g = 0; g < groups(); g++) {
+              for (size_t oc = 0; oc < groupOutputChannels(); oc++) {
+                double acc = bias[g * groupOutputChannels() + oc];
+                for (size_t ky = 0; ky < kernelHeight(); ky++) {
+                  const size_t iy = oy * subsamplingHeight() + ky * dilationHeight() - paddingTop();
+                  for (size_t kx = 0; kx < kernelWidth(); kx++) {
+                    const size_t ix = ox * subsamplingWidth() + kx * dilationWidth() - paddingLeft();
+                    if (iy < inputHeight() && ix < inputWidth()) {
+                      for (size_t ic = 0; ic < groupInputChannels(); ic++) {
+                        acc +=
+                          double(input[((i * inputHeight() + iy) * inputWidth() + ix) * inputPixelStride() + g * groupInputChannels() + ic]) *
+                          double(kernel[(((g * groupOutputChannels() + oc) * kernelHeight() + ky) * kernelWidth() + kx) * groupInputChannels() + ic]);
+                      }
+                    }
+                  }
+                }
+                outputRef[(((i * outputHeight() + oy) * outputWidth() + ox) * groups() + g) * groupOutputChannels() + oc] = acc;
+              }
+            }
+          }
+        }
+      }
+      const double accMin = *std::min_element(outputRef.cbegin(), outputRef.cend());
+      const double accMax = *std::max_element(outputRef.cbegin(), outputRef.cend());
+      const float outputMin = float(accMin + (accMax - accMin) / 255.0 * double(qmin()));
+      const float outputMax = float(accMax - (accMax - accMin) / 255.0 * double(255 - qmax()));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t convolution = nullptr;
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_convolution2d_nhwc_f32(
+          paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+          kernelHeight(), kernelWidth(),
+          subsamplingHeight(), subsamplingWidth(),
+          dilationHeight(), dilationWidth(),
+          groups(), groupInputChannels(), groupOutputChannels(),
+          kernel.data(), bias.data(),
+          qmin() == 0 ? -INFINITY : outputMin, qmax() == 255 ? +INFINITY : outputMax,
+          flags(),
           &convolution));
 
       ASSERT_EQ(qnnp_status_success,
-        qnnp_setup_convolution2d_nhwc_q8(
+        qnnp_setup_convolution2d_nhwc_f32(
           convolution,
           batchSize(),
           inputHeight(),
           inputWidth(),
-          inputPtr,
+          input.data(),
           inputPixelStride(),
           output.data(),
           outputPixelStride(),
@@ -450,15 +1031,152 @@ class ConvolutionTester {
           for (size_t x = 0; x < outputWidth(); x++) {
             for (size_t g = 0; g < groups(); g++) {
               for (size_t c = 0; c < groupOutputChannels(); c++) {
-                const double scaledAccumulator =
-                  accumulators[(((i * outputHeight() + y) * outputWidth() + x) * groups() + g) * groupOutputChannels() + c] / outputScale;
-                const double clampedAccumulator = std::max(std::min(scaledAccumulator,
-                  double(qmax()) - double(outputZeroPoint)),
-                  double(qmin()) - double(outputZeroPoint));
+                double outputRefValue =
+                  outputRef[(((i * outputHeight() + y) * outputWidth() + x) * groups() + g) * groupOutputChannels() + c];
+                if (qmin() != 0) {
+                  outputRefValue = std::max(outputRefValue, double(outputMin));
+                }
+                if (qmax() != 255) {
+                  outputRefValue = std::min(outputRefValue, double(outputMax));
+                }
                 ASSERT_NEAR(
-                  clampedAccumulator,
-                  (int32_t(output[((i * outputHeight() + y) * outputWidth() + x) * outputPixelStride() + g * groupOutputChannels() + c]) - outputZeroPoint),
-                  0.9) << "(x, y) = (" << x << ", " << y << "), group = " << g << ", channel = " << c;
+                  outputRefValue,
+                  output[((i * outputHeight() + y) * outputWidth() + x) * outputPixelStride() + g * groupOutputChannels() + c],
+                  1.0e-5 * std::max(1.0, std::abs(outputRefValue))) << "(x, y) = (" << x << ", " << y << "), group = " << g << ", channel = " << c;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void testF16() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto f16rng = std::bind(fp16_ieee_from_fp32_value, std::bind(std::uniform_real_distribution<float>(-1.0f, 1.0f), rng));
+
+    std::vector<uint16_t> input((batchSize() * inputHeight() * inputWidth() - 1) * inputPixelStride() + groups() * groupInputChannels());
+    std::vector<uint16_t> kernel(groups() * groupOutputChannels() * kernelHeight() * kernelWidth() * groupInputChannels());
+    std::vector<uint16_t> bias(groups() * groupOutputChannels());
+    std::vector<uint16_t> output((batchSize() * outputHeight() * outputWidth() - 1) * outputPixelStride() + groups() * groupOutputChannels());
+    std::vector<double> outputRef(batchSize() * outputHeight() * outputWidth() * groups() * groupOutputChannels());
+    /* Sums of absolute values of the accumulated terms, which bound the FP16 rounding error */
+    std::vector<double> outputMagnitude(outputRef.size());
+
+    ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+    if (!cpuinfo_has_arm_neon_fp16_arith()) {
+      qnnp_operator_t convolution = nullptr;
+      ASSERT_EQ(qnnp_status_unsupported_hardware,
+        qnnp_create_convolution2d_nhwc_f16(
+          paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+          kernelHeight(), kernelWidth(),
+          subsamplingHeight(), subsamplingWidth(),
+          dilationHeight(), dilationWidth(),
+          groups(), groupInputChannels(), groupOutputChannels(),
+          kernel.data(), bias.data(),
+          -INFINITY, +INFINITY,
+          flags(),
+          &convolution));
+      return;
+    }
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(input.begin(), input.end(), std::ref(f16rng));
+      std::generate(kernel.begin(), kernel.end(), std::ref(f16rng));
+      std::generate(bias.begin(), bias.end(), std::ref(f16rng));
+      std::fill(output.begin(), output.end(), UINT16_C(0x7E00) /* NaN */);
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t oy = 0; oy < outputHeight(); oy++) {
+          for (size_t ox = 0; ox < outputWidth(); ox++) {
+            for (size_t g = 0; g < groups(); g++) {
+              for (size_t oc = 0; oc < groupOutputChannels(); oc++) {
+                double acc = fp16_ieee_to_fp32_value(bias[g * groupOutputChannels() + oc]);
+                double magnitude = std::abs(acc);
+                for (size_t ky = 0; ky < kernelHeight(); ky++) {
+                  const size_t iy = oy * subsamplingHeight() + ky * dilationHeight() - paddingTop();
+                  for (size_t kx = 0; kx < kernelWidth(); kx++) {
+                    const size_t ix = ox * subsamplingWidth() + kx * dilationWidth() - paddingLeft();
+                    if (iy < inputHeight() && ix < inputWidth()) {
+                      for (size_t ic = 0; ic < groupInputChannels(); ic++) {
+                        const double product =
+                          double(fp16_ieee_to_fp32_value(input[((i * inputHeight() + iy) * inputWidth() + ix) * inputPixelStride() + g * groupInputChannels() + ic])) *
+                          double(fp16_ieee_to_fp32_value(kernel[(((g * groupOutputChannels() + oc) * kernelHeight() + ky) * kernelWidth() + kx) * groupInputChannels() + ic]));
+                        acc += product;
+                        magnitude += std::abs(product);
+                      }
+                    }
+                  }
+                }
+                outputRef[(((i * outputHeight() + oy) * outputWidth() + ox) * groups() + g) * groupOutputChannels() + oc] = acc;
+                outputMagnitude[(((i * outputHeight() + oy) * outputWidth() + ox) * groups() + g) * groupOutputChannels() + oc] = magnitude;
+              }
+            }
+          }
+        }
+      }
+      const double accMin = *std::min_element(outputRef.cbegin(), outputRef.cend());
+      const double accMax = *std::max_element(outputRef.cbegin(), outputRef.cend());
+      /* The operator rounds the output range to half precision */
+      const float outputMin = fp16_ieee_to_fp32_value(fp16_ieee_from_fp32_value(
+        float(accMin + (accMax - accMin) / 255.0 * double(qmin()))));
+      const float outputMax = fp16_ieee_to_fp32_value(fp16_ieee_from_fp32_value(
+        float(accMax - (accMax - accMin) / 255.0 * double(255 - qmax()))));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t convolution = nullptr;
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_convolution2d_nhwc_f16(
+          paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+          kernelHeight(), kernelWidth(),
+          subsamplingHeight(), subsamplingWidth(),
+          dilationHeight(), dilationWidth(),
+          groups(), groupInputChannels(), groupOutputChannels(),
+          kernel.data(), bias.data(),
+          qmin() == 0 ? -INFINITY : outputMin, qmax() == 255 ? +INFINITY : outputMax,
+          flags(),
+          &convolution));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_convolution2d_nhwc_f16(
+          convolution,
+          batchSize(),
+          inputHeight(),
+          inputWidth(),
+          input.data(),
+          inputPixelStride(),
+          output.data(),
+          outputPixelStride(),
+          nullptr /* thread pool */));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_run_operator(convolution, nullptr /* thread pool */));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_delete_operator(convolution));
+      convolution = nullptr;
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t y = 0; y < outputHeight(); y++) {
+          for (size_t x = 0; x < outputWidth(); x++) {
+            for (size_t g = 0; g < groups(); g++) {
+              for (size_t c = 0; c < groupOutputChannels(); c++) {
+                double outputRefValue =
+                  outputRef[(((i * outputHeight() + y) * outputWidth() + x) * groups() + g) * groupOutputChannels() + c];
+                if (qmin() != 0) {
+                  outputRefValue = std::max(outputRefValue, double(outputMin));
+                }
+                if (qmax() != 255) {
+                  outputRefValue = std::min(outputRefValue, double(outputMax));
+                }
+                ASSERT_NEAR(
+                  outputRefValue,
+                  fp16_ieee_to_fp32_value(output[((i * outputHeight() + y) * outputWidth() + x) * outputPixelStride() + g * groupOutputChannels() + c]),
+                  5.0e-3 * std::max(1.0,
+                    outputMagnitude[(((i * outputHeight() + y) * outputWidth() + x) * groups() + g) * groupOutputChannels() + c]))
+                  << "(x, y) = (" << x << ", " << y << "), group = " << g << ", channel = " << c;
               }
             }
           }
@@ -486,7 +1204,24 @@ class ConvolutionTester {
   uint32_t dilationWidth_{1};
   uint32_t subsamplingHeight_{1};
   uint32_t subsamplingWidth_{1};
+  uint8_t kernelZeroPoint_{127};
+  uint8_t kernelMaxDeviation_{0};
+  bool prunedKernel_{false};
   uint8_t qmin_{0};
   uint8_t qmax_{255};
   size_t iterations_{1};
+  uint32_t flags_{0};
+  size_t packingThreads_{0};
+  size_t threads_{0};
+  bool repeatSetup_{false};
+  bool setOperatorIO_{false};
+  size_t setupCacheSize_{0};
+  size_t streamingRows_{0};
+  bool invertingLookupTable_{false};
+  bool perChannel_{false};
+  size_t rois_{1};
+  bool inputWindow_{false};
+  size_t windowTop_{0};
+  size_t windowLeft_{0};
+  size_t runs_{1};
 };
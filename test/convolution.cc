@@ -89,6 +89,30 @@ TEST(CONVOLUTION, grouped_1x1) {
     .test();
 }
 
+TEST(CONVOLUTION, 1x1_with_small_kernel) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .kernelMaxDeviation(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_1x1_with_small_kernel) {
+  ConvolutionTester()
+    .inputSize(24, 25)
+    .kernelSize(1, 1)
+    .groups(3)
+    .groupInputChannels(12)
+    .groupOutputChannels(17)
+    .kernelMaxDeviation(5)
+    .threads(4)
+    .iterations(3)
+    .test();
+}
+
 TEST(CONVOLUTION, xzp_1x1) {
   ASSERT_EQ(qnnp_status_success, qnnp_initialize());
   if (qnnp_params.q8conv_xzp.kthreshold != SIZE_MAX) {
@@ -186,6 +210,110 @@ TEST(CONVOLUTION, grouped_xzp_1x1) {
   }
 }
 
+TEST(CONVOLUTION, sparse_1x1) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, sparse_1x1_with_qmin) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .qmin(128)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, sparse_1x1_with_qmax) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .qmax(128)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, sparse_1x1_with_input_stride) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .inputPixelStride(28)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, sparse_1x1_with_output_stride) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .outputPixelStride(29)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, sparse_1x1_with_batch) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .kernelSize(1, 1)
+    .batchSize(3)
+    .threads(4)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, sparse_1x1_with_lookup_table) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .invertingLookupTable(true)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_sparse_1x1) {
+  ConvolutionTester()
+    .inputSize(24, 25)
+    .kernelSize(1, 1)
+    .groups(2)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
 TEST(CONVOLUTION, 1x3) {
   ConvolutionTester()
     .inputSize(20, 19)
@@ -297,6 +425,41 @@ TEST(CONVOLUTION, 3x3_with_bottom_padding) {
     .test();
 }
 
+TEST(CONVOLUTION, 3x3_on_7x7_with_padding) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(7, 7)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3_with_padding_beyond_kernel) {
+  ConvolutionTester()
+    .inputSize(5, 4)
+    .padding(3)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3_with_padding_beyond_kernel_and_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(5, 4)
+    .padding(3)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
 TEST(CONVOLUTION, 3x3_with_input_stride) {
   ConvolutionTester()
     .inputSize(13, 12)
@@ -345,6 +508,42 @@ TEST(CONVOLUTION, grouped_3x3) {
     .test();
 }
 
+TEST(CONVOLUTION, grouped_1x1_with_few_output_channels) {
+  ConvolutionTester()
+    .inputSize(24, 25)
+    .kernelSize(1, 1)
+    .groups(8)
+    .groupInputChannels(6)
+    .groupOutputChannels(2)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_few_output_channels) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(6)
+    .groupInputChannels(5)
+    .groupOutputChannels(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_few_output_channels_and_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(6)
+    .groupInputChannels(5)
+    .groupOutputChannels(3)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
 TEST(CONVOLUTION, 3x3s2) {
   ConvolutionTester()
     .inputSize(19, 21)
@@ -492,3 +691,2546 @@ TEST(CONVOLUTION, depthwise_3x3d2x1) {
     .iterations(3)
     .test();
 }
+
+TEST(CONVOLUTION, depthwise_3x3d4) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(4, 4)
+    .kernelSize(3, 3)
+    .dilation(4)
+    .groups(27)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3s2d2) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(2, 2)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .dilation(2)
+    .groups(27)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3s2d3) {
+  ConvolutionTester()
+    .inputSize(17, 19)
+    .padding(3, 3)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .dilation(3)
+    .groups(27)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3d4_with_fewer_output_columns_than_phases) {
+  ConvolutionTester()
+    .inputSize(9, 3)
+    .padding(4, 1)
+    .kernelSize(3, 3)
+    .dilation(4, 2)
+    .groups(27)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3d2_with_output_stride) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(2, 2)
+    .kernelSize(3, 3)
+    .dilation(2)
+    .groups(27)
+    .outputPixelStride(31)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_5x5d2_with_multiplier) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(4, 4)
+    .kernelSize(5, 5)
+    .dilation(2)
+    .groups(9)
+    .groupOutputChannels(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_5x5) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(2, 2)
+    .kernelSize(5, 5)
+    .groups(27)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_5x5s2) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(2, 2)
+    .kernelSize(5, 5)
+    .subsampling(2)
+    .groups(27)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_5x5d2) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(2, 2)
+    .kernelSize(5, 5)
+    .dilation(2)
+    .groups(27)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_5x5d1x2) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(2, 2)
+    .kernelSize(5, 5)
+    .dilation(1, 2)
+    .groups(27)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_multiplier) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .groupOutputChannels(2)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3s2_with_multiplier) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groups(13)
+    .groupOutputChannels(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_multiplier_few_channels) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(3)
+    .groupOutputChannels(2)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_5x5_with_multiplier) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(2, 2)
+    .kernelSize(5, 5)
+    .groups(27)
+    .groupOutputChannels(2)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_small_output) {
+  ConvolutionTester()
+    .inputSize(3, 3)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_5x5_small_output) {
+  ConvolutionTester()
+    .inputSize(2, 2)
+    .padding(2, 2)
+    .kernelSize(5, 5)
+    .groups(43)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 1x1_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, xzp_1x1_with_lazy_packing) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  if (qnnp_params.q8conv_xzp.kthreshold != SIZE_MAX) {
+    ConvolutionTester()
+      .inputSize(27, 29)
+      .kernelSize(1, 1)
+      .groupInputChannels(qnnp_params.q8conv_xzp.kthreshold + 1)
+      .groupOutputChannels(19)
+      .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(CONVOLUTION, 1x1_with_xzp_calibration) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_CALIBRATE_XZP)
+    .runs(2 * 4 + 1)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, xzp_1x1_with_xzp_calibration) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  if (qnnp_params.q8conv_xzp.kthreshold != SIZE_MAX) {
+    ConvolutionTester()
+      .inputSize(27, 29)
+      .kernelSize(1, 1)
+      .groupInputChannels(qnnp_params.q8conv_xzp.kthreshold + 1)
+      .groupOutputChannels(19)
+      .flags(QNNP_CREATE_FLAG_CALIBRATE_XZP)
+      .runs(2 * 4 + 1)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(CONVOLUTION, 1x1_with_xzp_calibration_and_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_CALIBRATE_XZP | QNNP_CREATE_FLAG_LAZY_PACKING)
+    .runs(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 1x1_with_xzp_calibration_and_lookup_table) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_CALIBRATE_XZP)
+    .invertingLookupTable(true)
+    .runs(2 * 4 + 1)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_1x1_with_xzp_calibration) {
+  ConvolutionTester()
+    .inputSize(24, 25)
+    .kernelSize(1, 1)
+    .groups(2)
+    .groupInputChannels(17)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_CALIBRATE_XZP)
+    .runs(2 * 4 + 1)
+    .threads(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_1x1_with_few_output_channels_and_xzp_calibration) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  if (qnnp_params.q8conv_xzp.kthreshold != SIZE_MAX) {
+    /* The GEMM path merges the groups, while the XZP path keeps them */
+    ConvolutionTester()
+      .inputSize(24, 25)
+      .kernelSize(1, 1)
+      .groups(4)
+      .groupInputChannels(qnnp_params.q8conv_xzp.kthreshold + 1)
+      .groupOutputChannels(2)
+      .flags(QNNP_CREATE_FLAG_CALIBRATE_XZP)
+      .runs(2 * 4 + 1)
+      .threads(3)
+      .test();
+  }
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_multiplier_and_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .groupOutputChannels(2)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 1x1_with_parallel_packing) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(67)
+    .packingThreads(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, xzp_1x1_with_parallel_packing) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  if (qnnp_params.q8conv_xzp.kthreshold != SIZE_MAX) {
+    ConvolutionTester()
+      .inputSize(27, 29)
+      .kernelSize(1, 1)
+      .groupInputChannels(qnnp_params.q8conv_xzp.kthreshold + 1)
+      .groupOutputChannels(67)
+      .packingThreads(4)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_parallel_packing) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(3)
+    .groupInputChannels(14)
+    .groupOutputChannels(29)
+    .packingThreads(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_parallel_packing) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(67)
+    .packingThreads(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_parallel_and_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .packingThreads(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 1x1_with_few_threads) {
+  /* Tasks cover several microkernel tiles */
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(67)
+    .threads(2)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 1x1_with_many_threads) {
+  /* Every microkernel tile is a task */
+  ConvolutionTester()
+    .inputSize(5, 3)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .threads(32)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_few_threads) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(3)
+    .groupInputChannels(14)
+    .groupOutputChannels(29)
+    .threads(2)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_many_threads) {
+  ConvolutionTester()
+    .inputSize(5, 6)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .threads(32)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 1x1_with_repeated_setup) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3_with_repeated_setup) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_batch_and_repeated_setup) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(4)
+    .groupOutputChannels(13)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_repeated_setup) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_multiplier_and_repeated_setup) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .groupOutputChannels(2)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 1x1_with_operator_io) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .setOperatorIO(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, xzp_1x1_with_operator_io) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  if (qnnp_params.q8conv_xzp.kthreshold != SIZE_MAX) {
+    ConvolutionTester()
+      .inputSize(27, 29)
+      .kernelSize(1, 1)
+      .groupInputChannels(qnnp_params.q8conv_xzp.kthreshold + 1)
+      .groupOutputChannels(19)
+      .setOperatorIO(true)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(CONVOLUTION, 3x3_with_operator_io) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .setOperatorIO(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_batch_and_operator_io) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(4)
+    .groupOutputChannels(13)
+    .setOperatorIO(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3_with_tile_indirection_and_operator_io) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .setOperatorIO(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 17x17_with_pointer_indirection_and_operator_io) {
+  ConvolutionTester()
+    .inputSize(19, 20)
+    .padding(4)
+    .kernelSize(17, 17)
+    .groups(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(5)
+    .setOperatorIO(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_operator_io) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .setOperatorIO(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_multiplier_and_operator_io) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .groupOutputChannels(2)
+    .setOperatorIO(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, operator_io_requires_setup_without_workspace) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(8 * 3 * 3 * 8, 1);
+  const std::vector<int32_t> bias(8, 0);
+  qnnp_operator_t convolution = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      1, 1, 1, 1, 3, 3, 1, 1, 1, 1, 1, 8, 8,
+      127, 0.5f, 127, 0.5f, kernel.data(), bias.data(), 127, 1.0f, 0, 255,
+      0, &convolution));
+  std::vector<uint8_t> input(8 + 5 * 5 * 8), output(5 * 5 * 8);
+  EXPECT_EQ(qnnp_status_invalid_parameter, qnnp_set_operator_io(convolution, input.data() + 8, output.data()));
+
+  size_t workspaceSize = 0, scratchSize = 0;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_get_convolution2d_nhwc_q8_workspace_size(convolution, 1, 5, 5, &workspaceSize, &scratchSize));
+  std::vector<uint8_t> workspace(workspaceSize), scratch(scratchSize);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8_with_workspace(
+      convolution, 1, 5, 5, input.data() + 8, 8, output.data(), 8,
+      workspace.empty() ? nullptr : workspace.data(), scratch.empty() ? nullptr : scratch.data(), nullptr));
+  if (workspaceSize != 0) {
+    EXPECT_EQ(qnnp_status_invalid_parameter, qnnp_set_operator_io(convolution, input.data() + 8, output.data()));
+  }
+
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(convolution, 1, 5, 5, input.data() + 8, 8, output.data(), 8, nullptr));
+  EXPECT_EQ(qnnp_status_success, qnnp_set_operator_io(convolution, input.data() + 8, output.data()));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+}
+
+TEST(CONVOLUTION, 3x3_with_setup_cache) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .setupCacheSize(16 << 20)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_batch_and_setup_cache) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(4)
+    .groupOutputChannels(13)
+    .setupCacheSize(16 << 20)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3_with_small_setup_cache) {
+  /* The indirection buffer does not fit into the cache, so setup rebuilds it */
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .setupCacheSize(1)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 17x17_with_pointer_indirection_and_setup_cache) {
+  ConvolutionTester()
+    .inputSize(19, 20)
+    .padding(4)
+    .kernelSize(17, 17)
+    .groups(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(5)
+    .setupCacheSize(16 << 20)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_setup_cache) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .setupCacheSize(16 << 20)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_multiplier_and_setup_cache) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .groupOutputChannels(2)
+    .setupCacheSize(16 << 20)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 17x17_with_pointer_indirection) {
+  /* The mr x 289 block of input pointers is too large to expand per tile, so setup stores pointers */
+  ConvolutionTester()
+    .inputSize(19, 20)
+    .padding(4)
+    .kernelSize(17, 17)
+    .groups(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(5)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3_with_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_with_batch_and_tile_indirection) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(4)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3s2_with_input_stride_and_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(15)
+    .inputPixelStride(19)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3d2_with_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .padding(2)
+    .kernelSize(3, 3)
+    .dilation(2)
+    .groupInputChannels(5)
+    .groupOutputChannels(7)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 1x1_by_row_bands) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(13, 14)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .streamingRows(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, xzp_1x1_by_row_bands) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  if (qnnp_params.q8conv_xzp.kthreshold != SIZE_MAX) {
+    ConvolutionTester()
+      .batchSize(2)
+      .inputSize(13, 14)
+      .kernelSize(1, 1)
+      .groupInputChannels(qnnp_params.q8conv_xzp.kthreshold + 1)
+      .groupOutputChannels(19)
+      .streamingRows(3)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(CONVOLUTION, grouped_3x3_by_row_bands) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(13, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(5)
+    .groupOutputChannels(7)
+    .streamingRows(2)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 5x5s2d2_by_row_bands) {
+  ConvolutionTester()
+    .inputSize(23, 14)
+    .paddingTop(3)
+    .paddingRight(2)
+    .paddingBottom(1)
+    .paddingLeft(4)
+    .kernelSize(5, 5)
+    .subsampling(2)
+    .dilation(2)
+    .groupInputChannels(5)
+    .groupOutputChannels(7)
+    .streamingRows(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3s2_by_row_bands) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groups(27)
+    .streamingRows(2)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3d2_by_row_bands) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(15, 14)
+    .padding(2, 2)
+    .kernelSize(3, 3)
+    .dilation(2)
+    .groups(27)
+    .streamingRows(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_5x5_with_multiplier_by_row_bands) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(2, 2)
+    .kernelSize(5, 5)
+    .groups(19)
+    .groupOutputChannels(2)
+    .streamingRows(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 1x1_with_lookup_table) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .invertingLookupTable(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, xzp_1x1_with_lookup_table) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  if (qnnp_params.q8conv_xzp.kthreshold != SIZE_MAX) {
+    ConvolutionTester()
+      .inputSize(27, 29)
+      .kernelSize(1, 1)
+      .groupInputChannels(qnnp_params.q8conv_xzp.kthreshold + 1)
+      .groupOutputChannels(19)
+      .invertingLookupTable(true)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(CONVOLUTION, 3x3_with_output_stride_and_lookup_table) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .outputPixelStride(23)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .invertingLookupTable(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3_with_tile_indirection_and_lookup_table) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .invertingLookupTable(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, depthwise_3x3_with_lookup_table) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .invertingLookupTable(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_3x3_by_row_bands_with_lookup_table) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(13, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(5)
+    .groupOutputChannels(7)
+    .streamingRows(2)
+    .invertingLookupTable(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(69)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3_without_padding) {
+  ConvolutionTester()
+    .inputSize(11, 14)
+    .kernelSize(3, 3)
+    .groupInputChannels(64)
+    .groupOutputChannels(65)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3_with_asymmetric_padding) {
+  ConvolutionTester()
+    .inputSize(10, 9)
+    .paddingTop(2)
+    .paddingLeft(1)
+    .paddingBottom(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(65)
+    .groupOutputChannels(81)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3_with_max_channels) {
+  ConvolutionTester()
+    .inputSize(5, 6)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(512)
+    .groupOutputChannels(64)
+    .kernelZeroPoint(255)
+    .iterations(1)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3_with_input_and_output_stride) {
+  ConvolutionTester()
+    .inputSize(9, 7)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(69)
+    .inputPixelStride(75)
+    .outputPixelStride(71)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_winograd_3x3_with_batch) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(7, 8)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(67)
+    .groupOutputChannels(69)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(9, 8)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(64)
+    .groupOutputChannels(64)
+    .qmin(128)
+    .qmax(192)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3_with_many_threads) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(69)
+    .threads(7)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(9, 8)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(69)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3_with_repeated_setup) {
+  ConvolutionTester()
+    .inputSize(9, 8)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(69)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, grouped_winograd_3x3_by_row_bands) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(13, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(67)
+    .groupOutputChannels(69)
+    .streamingRows(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, winograd_3x3_with_lookup_table) {
+  ConvolutionTester()
+    .inputSize(9, 8)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(69)
+    .invertingLookupTable(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION, 3x3_without_winograd) {
+  ConvolutionTester()
+    .inputSize(9, 8)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(69)
+    .flags(QNNP_CREATE_FLAG_NO_WINOGRAD)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_PER_CHANNEL, 1x1) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_PER_CHANNEL, 3x3) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_PER_CHANNEL, grouped_3x3_with_few_output_channels) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(4)
+    .groupInputChannels(7)
+    .groupOutputChannels(2)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_PER_CHANNEL, 3x3s2_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(14, 13)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(4)
+    .groupOutputChannels(31)
+    .qmin(128)
+    .qmax(192)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_PER_CHANNEL, grouped_3x3) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_PER_CHANNEL, depthwise_3x3) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_PER_CHANNEL, 3x3_with_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_PER_CHANNEL, 3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_PER_CHANNEL, 3x3_by_row_bands) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(5)
+    .groupOutputChannels(7)
+    .streamingRows(2)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, 1x1) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, 3x3) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, grouped_1x1_with_few_output_channels) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .kernelSize(1, 1)
+    .groups(6)
+    .groupInputChannels(9)
+    .groupOutputChannels(2)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, 3x3s2_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(14, 13)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(4)
+    .groupOutputChannels(31)
+    .qmin(128)
+    .qmax(192)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, grouped_3x3) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, depthwise_3x3) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, 3x3_with_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, 3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, 3x3_by_row_bands) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(5)
+    .groupOutputChannels(7)
+    .streamingRows(2)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_SIGNED_KERNEL, 3x3_per_channel) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .kernelZeroPoint(128)
+    .perChannel(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FOLDED_ZERO_POINT, 1x1) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FOLDED_ZERO_POINT, 3x3) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT | QNNP_CREATE_FLAG_NO_WINOGRAD)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FOLDED_ZERO_POINT, grouped_1x1_with_few_output_channels) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .kernelSize(1, 1)
+    .groups(6)
+    .groupInputChannels(9)
+    .groupOutputChannels(2)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FOLDED_ZERO_POINT, 3x3s2_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(14, 13)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(4)
+    .groupOutputChannels(31)
+    .qmin(128)
+    .qmax(192)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FOLDED_ZERO_POINT, grouped_3x3) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT | QNNP_CREATE_FLAG_NO_WINOGRAD)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FOLDED_ZERO_POINT, 3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT | QNNP_CREATE_FLAG_NO_WINOGRAD | QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FOLDED_ZERO_POINT, 3x3_with_signed_kernel) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .kernelZeroPoint(128)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT | QNNP_CREATE_FLAG_NO_WINOGRAD)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_XZP, 3x3) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_NO_WINOGRAD)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_XZP, 3x3s2_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(14, 13)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(72)
+    .groupOutputChannels(31)
+    .qmin(128)
+    .qmax(192)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_XZP, grouped_3x3) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(65)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_NO_WINOGRAD)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_XZP, 3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_NO_WINOGRAD | QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_XZP, 3x3_with_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_NO_WINOGRAD | QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_XZP, 3x3_with_streaming_rows) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(67)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_NO_WINOGRAD)
+    .streamingRows(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_XZP, 3x3_with_panels_for_threads) {
+  ConvolutionTester()
+    .inputSize(5, 4)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(64)
+    .groupOutputChannels(45)
+    .flags(QNNP_CREATE_FLAG_NO_WINOGRAD)
+    .threads(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3s2_with_3_input_channels) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(32)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3s2_with_input_stride) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(24)
+    .inputPixelStride(5)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3s2_with_batch_and_threads) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(17)
+    .threads(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3_with_asymmetric_padding) {
+  ConvolutionTester()
+    .inputSize(11, 10)
+    .paddingTop(0)
+    .paddingRight(2)
+    .paddingBottom(1)
+    .paddingLeft(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(3)
+    .groupOutputChannels(19)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3_without_padding) {
+  ConvolutionTester()
+    .inputSize(11, 10)
+    .kernelSize(3, 3)
+    .groupInputChannels(2)
+    .groupOutputChannels(19)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 7x7s2_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(23, 21)
+    .padding(3)
+    .kernelSize(7, 7)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(40)
+    .qmin(128)
+    .qmax(192)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 5x3_with_1_input_channel) {
+  ConvolutionTester()
+    .inputSize(12, 13)
+    .padding(2, 1)
+    .kernelSize(5, 3)
+    .groupInputChannels(1)
+    .groupOutputChannels(16)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3_with_dilation_height) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(2, 1)
+    .kernelSize(3, 3)
+    .dilation(2, 1)
+    .groupInputChannels(4)
+    .groupOutputChannels(13)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3s2_with_output_stride) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(16)
+    .outputPixelStride(21)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3s2_by_row_bands) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(16)
+    .streamingRows(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3_with_repeated_setup) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(3)
+    .groupOutputChannels(16)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(3)
+    .groupOutputChannels(16)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_STEM, 3x3_with_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(3)
+    .groupOutputChannels(16)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 3x3s2_with_3_input_channels) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(32)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 3x3s2_with_batch) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(11, 10)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 5x5_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(2, 1)
+    .kernelSize(5, 5)
+    .groupInputChannels(3)
+    .groupOutputChannels(19)
+    .qmin(128)
+    .qmax(192)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 3x3d2_with_output_stride) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(2)
+    .kernelSize(3, 3)
+    .dilation(2)
+    .groupInputChannels(4)
+    .groupOutputChannels(13)
+    .outputPixelStride(17)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 1x1) {
+  ConvolutionTester()
+    .inputSize(9, 7)
+    .kernelSize(1, 1)
+    .groupInputChannels(3)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, grouped_3x3) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, depthwise_3x3) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(17)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 3x3_with_repeated_setup) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(3)
+    .groupOutputChannels(16)
+    .repeatSetup(true)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(3)
+    .groupOutputChannels(16)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW | QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 3x3_with_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(3)
+    .groupOutputChannels(16)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW | QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 3x3_with_fp32_requantization) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(16)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW | QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 3x3_per_channel) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(3)
+    .groupOutputChannels(17)
+    .perChannel(true)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_NCHW_INPUT, 3x3_with_signed_kernel) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(3)
+    .groupOutputChannels(17)
+    .kernelZeroPoint(128)
+    .flags(QNNP_CREATE_FLAG_INPUT_NCHW)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, 3x3) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .inputWindow(2, 3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, 3x3s2_with_input_stride) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .inputPixelStride(22)
+    .inputWindow(1, 5)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, grouped_3x3_with_batch_and_threads) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .inputWindow(3, 0)
+    .threads(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, 3x3_with_repeated_setup) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .inputWindow(2, 3)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, 3x3_with_setup_cache) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .inputWindow(2, 3)
+    .setupCacheSize(1 << 20)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, depthwise_3x3_with_batch) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .inputWindow(4, 2)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, depthwise_5x5d2) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(4)
+    .kernelSize(5, 5)
+    .dilation(2)
+    .groups(27)
+    .inputWindow(1, 1)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, depthwise_3x3_with_multiplier_and_batch) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(9)
+    .groupOutputChannels(2)
+    .inputWindow(2, 3)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, stem_3x3s2_with_batch) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(32)
+    .inputWindow(3, 4)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_INPUT_WINDOW, 1x1_is_unsupported) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(19 * 23, 1);
+  const std::vector<int32_t> bias(19, 0);
+  qnnp_operator_t convolution = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 23, 19,
+      127, 1.0f, 127, 1.0f, kernel.data(), bias.data(),
+      127, 16.0f, 0, 255, 0 /* flags */, &convolution));
+  /* A 5x7 window of a 9x11 frame */
+  std::vector<uint8_t> frame(9 * 11 * 23 + 8), output(5 * 7 * 19);
+  EXPECT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_setup_convolution2d_nhwc_q8_with_strides(
+      convolution, 1, 5, 7, frame.data() + 8, 23, 11 * 23, 9 * 11 * 23, output.data(), 19, nullptr));
+  EXPECT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8_with_strides(
+      convolution, 1, 5, 7, frame.data() + 8, 23, 7 * 23, 5 * 7 * 23, output.data(), 19, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+}
+
+TEST(CONVOLUTION_ROIS, 3x3_single_roi) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .rois(1)
+    .iterations(3)
+    .testROIs();
+}
+
+TEST(CONVOLUTION_ROIS, 3x3_many_rois) {
+  ConvolutionTester()
+    .inputSize(9, 10)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .rois(23)
+    .iterations(3)
+    .testROIs();
+}
+
+TEST(CONVOLUTION_ROIS, 3x3s2_with_input_and_output_stride) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .inputPixelStride(22)
+    .outputPixelStride(19)
+    .rois(7)
+    .iterations(3)
+    .testROIs();
+}
+
+TEST(CONVOLUTION_ROIS, grouped_3x3_without_padding) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .rois(5)
+    .iterations(3)
+    .testROIs();
+}
+
+TEST(CONVOLUTION_ROIS, 5x5d2_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(14, 15)
+    .padding(4)
+    .kernelSize(5, 5)
+    .dilation(2)
+    .groupInputChannels(7)
+    .groupOutputChannels(9)
+    .qmin(64)
+    .qmax(192)
+    .rois(6)
+    .iterations(3)
+    .testROIs();
+}
+
+TEST(CONVOLUTION_ROIS, 3x3_with_threads) {
+  ConvolutionTester()
+    .inputSize(9, 10)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(37)
+    .rois(17)
+    .threads(4)
+    .iterations(3)
+    .testROIs();
+}
+
+TEST(CONVOLUTION_ROIS, depthwise_is_unsupported) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(9 * 9, 1);
+  const std::vector<int32_t> bias(9, 0);
+  qnnp_operator_t convolution = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      1, 1, 1, 1, 3, 3, 1, 1, 1, 1, 9, 1, 1,
+      127, 1.0f, 127, 1.0f, kernel.data(), bias.data(),
+      127, 16.0f, 0, 255, 0 /* flags */, &convolution));
+  std::vector<uint8_t> frame(7 * 7 * 9 + 8), output(5 * 5 * 9);
+  const qnnp_roi roi = { frame.data() + 8, 5, 5, 7 * 9 };
+  EXPECT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_setup_convolution2d_nhwc_q8_rois(convolution, 1, &roi, 9, output.data(), 9, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+}
+
+TEST(CONVOLUTION_ROIS, rows_after_roi_setup) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 9 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t convolution = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      1, 1, 1, 1, 3, 3, 1, 1, 1, 1, 1, 8, 16,
+      127, 1.0f, 127, 1.0f, kernel.data(), bias.data(),
+      127, 16.0f, 0, 255, 0 /* flags */, &convolution));
+  std::vector<uint8_t> frame(7 * 7 * 8 + 8), output(2 * 5 * 5 * 16);
+  const qnnp_roi rois[2] = {
+    { frame.data() + 8, 5, 5, 7 * 8 },
+    { frame.data() + 8 + 2 * 7 * 8 + 2 * 8, 5, 5, 7 * 8 },
+  };
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8_rois(convolution, 2, rois, 8, output.data(), 16, nullptr));
+  EXPECT_EQ(qnnp_status_invalid_parameter,
+    qnnp_run_convolution2d_nhwc_q8_rows(convolution, 0, 1, nullptr));
+  EXPECT_EQ(qnnp_status_invalid_parameter,
+    qnnp_set_operator_io(convolution, frame.data() + 8, output.data()));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(convolution, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+}
+
+TEST(CONVOLUTION_FP32_REQUANTIZATION, 1x1) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FP32_REQUANTIZATION, 1x1_with_many_input_channels) {
+  ConvolutionTester()
+    .inputSize(7, 5)
+    .kernelSize(1, 1)
+    .groupInputChannels(300)
+    .groupOutputChannels(19)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FP32_REQUANTIZATION, 3x3) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FP32_REQUANTIZATION, 3x3s2_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(14, 13)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .groupInputChannels(4)
+    .groupOutputChannels(31)
+    .qmin(128)
+    .qmax(192)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FP32_REQUANTIZATION, grouped_3x3_with_batch) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FP32_REQUANTIZATION, depthwise_3x3) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1, 1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FP32_REQUANTIZATION, 3x3_with_tile_indirection) {
+  ConvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION | QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_FP32_REQUANTIZATION, 3x3_with_signed_kernel) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .kernelZeroPoint(128)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(CONVOLUTION_F32, 1x1) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 1x1_with_input_stride) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .inputPixelStride(28)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 1x1_with_output_stride) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .outputPixelStride(29)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 1x1_with_qmin) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .qmin(128)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 1x1_with_qmax) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .qmax(128)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 1x1_with_padding) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .paddingTop(1)
+    .paddingLeft(2)
+    .kernelSize(1, 1)
+    .groupInputChannels(7)
+    .groupOutputChannels(11)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, grouped_1x1_with_batch) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(13, 14)
+    .kernelSize(1, 1)
+    .groups(2)
+    .groupInputChannels(17)
+    .groupOutputChannels(13)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 3x3) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 3x3_without_padding) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 3x3s2_with_input_stride) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .inputPixelStride(22)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 3x3d2) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .padding(2)
+    .kernelSize(3, 3)
+    .dilation(2)
+    .groupInputChannels(7)
+    .groupOutputChannels(11)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, grouped_3x3_with_batch) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, depthwise_3x3) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 5x5_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(2)
+    .kernelSize(5, 5)
+    .groupInputChannels(5)
+    .groupOutputChannels(9)
+    .qmin(64)
+    .qmax(192)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F32, 3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(CONVOLUTION_F16, 1x1) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 1x1_with_input_stride) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .inputPixelStride(28)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 1x1_with_output_stride) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .outputPixelStride(29)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 1x1_with_qmin) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .qmin(128)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 1x1_with_qmax) {
+  ConvolutionTester()
+    .inputSize(27, 29)
+    .kernelSize(1, 1)
+    .groupInputChannels(23)
+    .groupOutputChannels(19)
+    .qmax(128)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 1x1_with_padding) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .paddingTop(1)
+    .paddingLeft(2)
+    .kernelSize(1, 1)
+    .groupInputChannels(7)
+    .groupOutputChannels(11)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, grouped_1x1_with_batch) {
+  ConvolutionTester()
+    .batchSize(3)
+    .inputSize(13, 14)
+    .kernelSize(1, 1)
+    .groups(2)
+    .groupInputChannels(17)
+    .groupOutputChannels(13)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 3x3) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 3x3_without_padding) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 3x3s2_with_input_stride) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .subsampling(2)
+    .inputPixelStride(22)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 3x3d2) {
+  ConvolutionTester()
+    .inputSize(13, 14)
+    .padding(2)
+    .kernelSize(3, 3)
+    .dilation(2)
+    .groupInputChannels(7)
+    .groupOutputChannels(11)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, grouped_3x3_with_batch) {
+  ConvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, depthwise_3x3) {
+  ConvolutionTester()
+    .inputSize(15, 14)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(27)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 5x5_with_qmin_and_qmax) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(2)
+    .kernelSize(5, 5)
+    .groupInputChannels(5)
+    .groupOutputChannels(9)
+    .qmin(64)
+    .qmax(192)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(CONVOLUTION_F16, 3x3_with_lazy_packing) {
+  ConvolutionTester()
+    .inputSize(13, 12)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .testF16();
+}
@@ -330,6 +330,15 @@ class DeconvolutionTester {
     return strideWidth() * (inputWidth() - 1) + adjustmentWidth() + dilatedKernelWidth() - paddingWidth();
   }
 
+  inline DeconvolutionTester& kernelZeroPoint(uint8_t kernelZeroPoint) {
+    this->kernelZeroPoint_ = kernelZeroPoint;
+    return *this;
+  }
+
+  inline uint8_t kernelZeroPoint() const {
+    return this->kernelZeroPoint_;
+  }
+
   inline DeconvolutionTester& qmin(uint8_t qmin) {
     this->qmin_ = qmin;
     return *this;
@@ -357,6 +366,51 @@ class DeconvolutionTester {
     return this->iterations_;
   }
 
+  inline DeconvolutionTester& flags(uint32_t flags) {
+    this->flags_ = flags;
+    return *this;
+  }
+
+  inline uint32_t flags() const {
+    return this->flags_;
+  }
+
+  inline DeconvolutionTester& packingThreads(size_t packingThreads) {
+    this->packingThreads_ = packingThreads;
+    return *this;
+  }
+
+  inline size_t packingThreads() const {
+    return this->packingThreads_;
+  }
+
+  inline DeconvolutionTester& repeatSetup(bool repeatSetup) {
+    this->repeatSetup_ = repeatSetup;
+    return *this;
+  }
+
+  inline bool repeatSetup() const {
+    return this->repeatSetup_;
+  }
+
+  inline DeconvolutionTester& setOperatorIO(bool setOperatorIO) {
+    this->setOperatorIO_ = setOperatorIO;
+    return *this;
+  }
+
+  inline bool setOperatorIO() const {
+    return this->setOperatorIO_;
+  }
+
+  inline DeconvolutionTester& setupCacheSize(size_t setupCacheSize) {
+    this->setupCacheSize_ = setupCacheSize;
+    return *this;
+  }
+
+  inline size_t setupCacheSize() const {
+    return this->setupCacheSize_;
+  }
+
   void test() const {
     std::random_device randomDevice;
     auto rng = std::mt19937(randomDevice());
@@ -371,7 +425,6 @@ class DeconvolutionTester {
 
     const uint8_t* inputPtr = input.data() + 8;
     const uint8_t inputZeroPoint = 127;
-    const uint8_t kernelZeroPoint = 127;
 
     for (size_t iteration = 0; iteration < iterations(); iteration++) {
       std::generate(input.begin(), input.end(), std::ref(u8rng));
@@ -408,7 +461,7 @@ class DeconvolutionTester {
                         for (size_t ic = 0; ic < groupInputChannels(); ic++) {
                           accumulators[(((i * outputHeight() + oy) * outputWidth() + ox) * groups() + g) * groupOutputChannels() + oc] +=
                             (int32_t(inputPtr[((i * inputHeight() + iy) * inputWidth() + ix) * inputPixelStride() + g * groupInputChannels() + ic]) - int32_t(inputZeroPoint)) *
-                            (int32_t(kernel[(((g * groupInputChannels() + ic) * kernelHeight() + ky) * kernelWidth() + kx) * groupOutputChannels() + oc]) - int32_t(kernelZeroPoint));
+                            (int32_t(kernel[(((g * groupInputChannels() + ic) * kernelHeight() + ky) * kernelWidth() + kx) * groupOutputChannels() + oc]) - int32_t(kernelZeroPoint()));
                         }
                       }
                     }
@@ -431,31 +484,107 @@ class DeconvolutionTester {
       qnnp_operator_t deconvolution = nullptr;
 
 
-      ASSERT_EQ(qnnp_status_success,
-        qnnp_create_deconvolution2d_nhwc_q8(
-          paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
-          adjustmentHeight(), adjustmentWidth(),
-          kernelHeight(), kernelWidth(),
-          strideHeight(), strideWidth(),
-          dilationHeight(), dilationWidth(),
-          groups(), groupInputChannels(), groupOutputChannels(),
-          inputZeroPoint, 1.0f /* input scale */,
-          kernelZeroPoint, 1.0f /* kernel scale */,
-          kernel.data(), bias.data(),
-          outputZeroPoint, outputScale, qmin(), qmax(),
-          &deconvolution));
+      if (packingThreads() != 0) {
+        pthreadpool_t threadpool = pthreadpool_create(packingThreads());
+        ASSERT_NE(nullptr, threadpool);
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_create_deconvolution2d_nhwc_q8_with_threadpool(
+            paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+            adjustmentHeight(), adjustmentWidth(),
+            kernelHeight(), kernelWidth(),
+            strideHeight(), strideWidth(),
+            dilationHeight(), dilationWidth(),
+            groups(), groupInputChannels(), groupOutputChannels(),
+            inputZeroPoint, 1.0f /* input scale */,
+            kernelZeroPoint(), 1.0f /* kernel scale */,
+            kernel.data(), bias.data(),
+            outputZeroPoint, outputScale, qmin(), qmax(),
+            flags(),
+            threadpool,
+            &deconvolution));
+        pthreadpool_destroy(threadpool);
+      } else {
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_create_deconvolution2d_nhwc_q8(
+            paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+            adjustmentHeight(), adjustmentWidth(),
+            kernelHeight(), kernelWidth(),
+            strideHeight(), strideWidth(),
+            dilationHeight(), dilationWidth(),
+            groups(), groupInputChannels(), groupOutputChannels(),
+            inputZeroPoint, 1.0f /* input scale */,
+            kernelZeroPoint(), 1.0f /* kernel scale */,
+            kernel.data(), bias.data(),
+            outputZeroPoint, outputScale, qmin(), qmax(),
+            flags(),
+            &deconvolution));
+      }
 
-      ASSERT_EQ(qnnp_status_success,
-        qnnp_setup_deconvolution2d_nhwc_q8(
-          deconvolution,
-          batchSize(),
-          inputHeight(),
-          inputWidth(),
-          inputPtr,
-          inputPixelStride(),
-          output.data(),
-          outputPixelStride(),
-          nullptr /* thread pool */));
+      /*
+       * Set up and run with other input data of the same shape first, so the final setup only moves the input. With
+       * setOperatorIO, qnnp_set_operator_io replaces the final setup. With setupCacheSize, a setup with a wider input
+       * comes in between, so the final setup takes the indirection buffer from the setup cache.
+       */
+      std::vector<uint8_t> previousInput, previousOutput;
+      if (setupCacheSize() != 0) {
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_set_operator_setup_cache(deconvolution, setupCacheSize()));
+      }
+      if (repeatSetup() || setOperatorIO() || setupCacheSize() != 0) {
+        previousInput.resize(input.size());
+        previousOutput.resize(output.size());
+        std::generate(previousInput.begin(), previousInput.end(), std::ref(u8rng));
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_setup_deconvolution2d_nhwc_q8(
+            deconvolution,
+            batchSize(),
+            inputHeight(),
+            inputWidth(),
+            previousInput.data() + 8,
+            inputPixelStride(),
+            previousOutput.data(),
+            outputPixelStride(),
+            nullptr /* thread pool */));
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_run_operator(deconvolution, nullptr /* thread pool */));
+      }
+      if (setupCacheSize() != 0) {
+        /* Rows of the wider input have at most 3 strides more output pixels */
+        const size_t widerInputWidth = inputWidth() + 3;
+        std::vector<uint8_t> widerInput(batchSize() * inputHeight() * widerInputWidth * inputPixelStride() + 8);
+        std::vector<uint8_t> widerOutput(
+          batchSize() * outputHeight() * (outputWidth() + 3 * strideWidth()) * outputPixelStride());
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_setup_deconvolution2d_nhwc_q8(
+            deconvolution,
+            batchSize(),
+            inputHeight(),
+            widerInputWidth,
+            widerInput.data() + 8,
+            inputPixelStride(),
+            widerOutput.data(),
+            outputPixelStride(),
+            nullptr /* thread pool */));
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_run_operator(deconvolution, nullptr /* thread pool */));
+      }
+
+      if (setOperatorIO()) {
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_set_operator_io(deconvolution, inputPtr, output.data()));
+      } else {
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_setup_deconvolution2d_nhwc_q8(
+            deconvolution,
+            batchSize(),
+            inputHeight(),
+            inputWidth(),
+            inputPtr,
+            inputPixelStride(),
+            output.data(),
+            outputPixelStride(),
+            nullptr /* thread pool */));
+      }
 
       ASSERT_EQ(qnnp_status_success,
         qnnp_run_operator(deconvolution, nullptr /* thread pool */));
@@ -515,7 +644,13 @@ class DeconvolutionTester {
   uint32_t dilationWidth_{1};
   uint32_t strideHeight_{1};
   uint32_t strideWidth_{1};
+  uint8_t kernelZeroPoint_{127};
   uint8_t qmin_{0};
   uint8_t qmax_{255};
   size_t iterations_{1};
+  uint32_t flags_{0};
+  size_t packingThreads_{0};
+  bool repeatSetup_{false};
+  bool setOperatorIO_{false};
+  size_t setupCacheSize_{0};
 };
@@ -263,3 +263,315 @@ TEST(DECONVOLUTION, 3x3d2x1) {
     .iterations(3)
     .test();
 }
+
+TEST(DECONVOLUTION, 4x4s2) {
+  DeconvolutionTester()
+    .inputSize(10, 9)
+    .padding(1)
+    .kernelSize(4, 4)
+    .stride(2)
+    .groupInputChannels(27)
+    .groupOutputChannels(19)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 4x4s2_with_asymmetric_padding) {
+  DeconvolutionTester()
+    .inputSize(10, 9)
+    .paddingTop(3)
+    .paddingLeft(0)
+    .paddingBottom(1)
+    .paddingRight(2)
+    .kernelSize(4, 4)
+    .stride(2)
+    .groupInputChannels(17)
+    .groupOutputChannels(13)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 3x3s2_with_adjustment) {
+  DeconvolutionTester()
+    .inputSize(11, 10)
+    .padding(1)
+    .adjustmentHeight(1)
+    .adjustmentWidth(1)
+    .kernelSize(3, 3)
+    .stride(2)
+    .groupInputChannels(23)
+    .groupOutputChannels(17)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 5x5s3) {
+  DeconvolutionTester()
+    .inputSize(8, 7)
+    .padding(2)
+    .kernelSize(5, 5)
+    .stride(3)
+    .groupInputChannels(11)
+    .groupOutputChannels(21)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 3x3s2d3) {
+  DeconvolutionTester()
+    .inputSize(9, 10)
+    .padding(3)
+    .kernelSize(3, 3)
+    .stride(2)
+    .dilation(3)
+    .groupInputChannels(7)
+    .groupOutputChannels(9)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 3x3s2d2) {
+  DeconvolutionTester()
+    .inputSize(9, 10)
+    .padding(2)
+    .kernelSize(3, 3)
+    .stride(2)
+    .dilation(2)
+    .groupInputChannels(7)
+    .groupOutputChannels(9)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, grouped_4x4s2_with_batch) {
+  DeconvolutionTester()
+    .batchSize(3)
+    .inputSize(7, 6)
+    .padding(1)
+    .kernelSize(4, 4)
+    .stride(2)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 1x1s2_with_tile_indirection) {
+  DeconvolutionTester()
+    .inputSize(10, 9)
+    .kernelSize(1, 1)
+    .stride(2)
+    .groupInputChannels(5)
+    .groupOutputChannels(7)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, grouped_3x3_with_lazy_packing) {
+  DeconvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, grouped_3x3_with_parallel_packing) {
+  DeconvolutionTester()
+    .inputSize(10, 11)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groups(3)
+    .groupInputChannels(14)
+    .groupOutputChannels(29)
+    .packingThreads(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, grouped_3x3s2_with_batch_and_repeated_setup) {
+  DeconvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 9)
+    .padding(1)
+    .kernelSize(3, 3)
+    .stride(2)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 17x17_with_pointer_indirection) {
+  DeconvolutionTester()
+    .inputSize(5, 6)
+    .padding(4)
+    .kernelSize(17, 17)
+    .groups(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(5)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, grouped_3x3s2_with_batch_and_operator_io) {
+  DeconvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 9)
+    .padding(1)
+    .kernelSize(3, 3)
+    .stride(2)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .setOperatorIO(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 17x17_with_pointer_indirection_and_operator_io) {
+  DeconvolutionTester()
+    .inputSize(5, 6)
+    .padding(4)
+    .kernelSize(17, 17)
+    .groups(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(5)
+    .setOperatorIO(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, grouped_3x3s2_with_batch_and_setup_cache) {
+  DeconvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 9)
+    .padding(1)
+    .kernelSize(3, 3)
+    .stride(2)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .setupCacheSize(16 << 20)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 17x17_with_pointer_indirection_and_setup_cache) {
+  DeconvolutionTester()
+    .inputSize(5, 6)
+    .padding(4)
+    .kernelSize(17, 17)
+    .groups(2)
+    .groupInputChannels(3)
+    .groupOutputChannels(5)
+    .setupCacheSize(16 << 20)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, grouped_3x3s2_with_batch_and_tile_indirection) {
+  DeconvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 9)
+    .padding(1)
+    .kernelSize(3, 3)
+    .stride(2)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .repeatSetup(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 3x3d2_with_tile_indirection) {
+  DeconvolutionTester()
+    .inputSize(10, 9)
+    .padding(2)
+    .kernelSize(3, 3)
+    .dilation(2)
+    .groupInputChannels(5)
+    .groupOutputChannels(7)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 3x3s2_with_signed_kernel) {
+  DeconvolutionTester()
+    .inputSize(19, 21)
+    .padding(1)
+    .kernelSize(3, 3)
+    .stride(2)
+    .groupInputChannels(27)
+    .groupOutputChannels(19)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, grouped_3x3s2_with_signed_kernel_and_tile_indirection) {
+  DeconvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 9)
+    .padding(1)
+    .kernelSize(3, 3)
+    .stride(2)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_TILE_INDIRECTION)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 3x3_with_folded_zero_point) {
+  DeconvolutionTester()
+    .inputSize(10, 9)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, 3x3_with_fp32_requantization) {
+  DeconvolutionTester()
+    .inputSize(10, 9)
+    .padding(1)
+    .kernelSize(3, 3)
+    .groupInputChannels(15)
+    .groupOutputChannels(17)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(DECONVOLUTION, grouped_4x4s2_with_fp32_requantization) {
+  DeconvolutionTester()
+    .batchSize(2)
+    .inputSize(10, 9)
+    .padding(1)
+    .kernelSize(4, 4)
+    .stride(2)
+    .groups(2)
+    .groupInputChannels(14)
+    .groupOutputChannels(13)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
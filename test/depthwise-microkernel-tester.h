@@ -65,6 +65,21 @@ class DepthwiseMicrokernelTester {
     return this->cr_;
   }
 
+  inline DepthwiseMicrokernelTester& multiplier(uint32_t multiplier) {
+    assert(multiplier != 0);
+    this->multiplier_ = multiplier;
+    return *this;
+  }
+
+  inline uint32_t multiplier() const {
+    return this->multiplier_;
+  }
+
+  inline uint32_t inputChannels() const {
+    assert(channels() % multiplier() == 0);
+    return channels() / multiplier();
+  }
+
   inline uint32_t packedChannels() const {
     return (channels() | (cr() - 1)) + 1;
   }
@@ -101,13 +116,22 @@ class DepthwiseMicrokernelTester {
 
   inline uint32_t inputStride() const {
     if (this->inputStride_ == 0) {
-      return channels();
+      return inputOffset() + inputChannels();
     } else {
-      assert(this->inputStride_ >= channels());
+      assert(this->inputStride_ >= inputOffset() + inputChannels());
       return this->inputStride_;
     }
   }
 
+  inline DepthwiseMicrokernelTester& inputOffset(uint32_t inputOffset) {
+    this->inputOffset_ = inputOffset;
+    return *this;
+  }
+
+  inline uint32_t inputOffset() const {
+    return this->inputOffset_;
+  }
+
   inline DepthwiseMicrokernelTester& outputStride(uint32_t outputStride) {
     assert(outputStride != 0);
     this->outputStride_ = outputStride;
@@ -151,12 +175,22 @@ class DepthwiseMicrokernelTester {
   }
 
   void test(q8dw_ukernel_function q8dw) const {
+    ASSERT_EQ(1, multiplier());
+    test(q8dw, nullptr);
+  }
+
+  void test(q8dw_multiplier_ukernel_function q8dw) const {
+    test(nullptr, q8dw);
+  }
+
+ private:
+  void test(q8dw_ukernel_function q8dw, q8dw_multiplier_ukernel_function multiplierQ8dw) const {
     std::random_device randomDevice;
     auto rng = std::mt19937(randomDevice());
     auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
     auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
 
-    std::vector<uint8_t> input((kernelSize() + (width() - 1) * kernelHeight() * subsampling() - 1) * inputStride() + channels() + 8);
+    std::vector<uint8_t> input((kernelSize() + (width() - 1) * kernelHeight() * subsampling() - 1) * inputStride() + inputOffset() + channels() + 8);
     std::vector<uint8_t> kernel(channels() * kernelSize());
     std::vector<uint8_t, AlignedAllocator<uint8_t, 32>> packedWeights((kernelSize() + sizeof(int32_t) / sizeof(uint8_t)) * packedChannels());
     std::vector<int32_t> bias(packedChannels());
@@ -192,8 +226,9 @@ class DepthwiseMicrokernelTester {
           int32_t acc = bias[c];
           for (size_t kx = 0; kx < kernelWidth(); kx++) {
             for (size_t ky = 0; ky < kernelHeight(); ky++) {
+              const uint8_t* inputRow = indirectInput[(x * subsampling() + kx) * kernelHeight() + ky];
               acc +=
-                (int32_t(indirectInput[(x * subsampling() + kx) * kernelHeight() + ky][c]) - int32_t(inputZeroPoint)) *
+                (int32_t(inputRow[inputOffset() + c / multiplier()]) - int32_t(inputZeroPoint)) *
                 (int32_t(kernel[(c * kernelHeight() + ky) * kernelWidth() + kx]) - int32_t(kernelZeroPoint));
             }
           }
@@ -218,12 +253,23 @@ class DepthwiseMicrokernelTester {
         qnnp_compute_scalar_requantization_params(
           requantizationScale, outputZeroPoint, qmin(), qmax());
 
-      q8dw(
-        channels(), width(),
-        indirectInput.data(), packedWeights.data(), output.data(),
-        kernelHeight() * subsampling() * sizeof(void*),
-        (outputStride() - channels()) * sizeof(uint8_t),
-        inputZeroPoint, kernelZeroPoint, &requantizationParams);
+      if (multiplierQ8dw != nullptr) {
+        multiplierQ8dw(
+          channels(), multiplier(), width(),
+          indirectInput.data(), packedWeights.data(), output.data(),
+          kernelHeight() * subsampling() * sizeof(void*),
+          (outputStride() - channels()) * sizeof(uint8_t),
+          inputOffset() * sizeof(uint8_t),
+          inputZeroPoint, kernelZeroPoint, &requantizationParams);
+      } else {
+        q8dw(
+          channels(), width(),
+          indirectInput.data(), packedWeights.data(), output.data(),
+          kernelHeight() * subsampling() * sizeof(void*),
+          (outputStride() - channels()) * sizeof(uint8_t),
+          inputOffset() * sizeof(uint8_t),
+          inputZeroPoint, kernelZeroPoint, &requantizationParams);
+      }
 
       for (size_t x = 0; x < width(); x++) {
         for (size_t c = 0; c < channels(); c++) {
@@ -240,14 +286,15 @@ class DepthwiseMicrokernelTester {
     }
   }
 
- private:
   uint32_t channels_{1};
   uint32_t cr_{1};
+  uint32_t multiplier_{1};
   uint32_t width_{1};
   uint32_t subsampling_{1};
   uint32_t kernelHeight_{1};
   uint32_t kernelWidth_{1};
   uint32_t inputStride_{0};
+  uint32_t inputOffset_{0};
   uint32_t outputStride_{0};
   uint8_t qmin_{0};
   uint8_t qmax_{255};
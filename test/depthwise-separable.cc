@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+namespace {
+
+qnnp_operator_t createConvolution(
+    uint32_t kernelSize, uint32_t padding, uint32_t subsampling,
+    uint32_t groups, size_t groupInputChannels, size_t groupOutputChannels,
+    const std::vector<uint8_t>& kernel, const std::vector<int32_t>& bias,
+    uint32_t flags)
+{
+  qnnp_operator_t convolution = nullptr;
+  EXPECT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      padding, padding, padding, padding,
+      kernelSize, kernelSize,
+      subsampling, subsampling,
+      1, 1,
+      groups, groupInputChannels, groupOutputChannels,
+      127, 0.5f,
+      127, 0.5f,
+      kernel.data(), bias.data(),
+      127, 0.25f * kernelSize * kernelSize * groupInputChannels, 0, 255,
+      flags,
+      &convolution));
+  return convolution;
+}
+
+/*
+ * Depthwise 3x3 convolution followed by a 1x1 pointwise convolution. Checks that the fused operator gives the output
+ * of the two convolutions run one after another.
+ */
+void testDepthwiseSeparable(
+    size_t threads, size_t batchSize, size_t height, size_t width,
+    size_t inputChannels, size_t outputChannels, size_t inputPixelStride,
+    uint32_t subsampling, uint32_t flags)
+{
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  const size_t outputHeight = (height + 2 - 3) / subsampling + 1;
+  const size_t outputWidth = (width + 2 - 3) / subsampling + 1;
+  std::vector<uint8_t> input(((batchSize * height * width - 1) * inputPixelStride + inputChannels) + 8);
+  std::vector<uint8_t> depthwiseKernel(inputChannels * 3 * 3);
+  std::vector<uint8_t> pointwiseKernel(outputChannels * inputChannels);
+  std::vector<int32_t> depthwiseBias(inputChannels), pointwiseBias(outputChannels);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::generate(depthwiseKernel.begin(), depthwiseKernel.end(), std::ref(u8rng));
+  std::generate(pointwiseKernel.begin(), pointwiseKernel.end(), std::ref(u8rng));
+  std::generate(depthwiseBias.begin(), depthwiseBias.end(), std::ref(s32rng));
+  std::generate(pointwiseBias.begin(), pointwiseBias.end(), std::ref(s32rng));
+
+  qnnp_operator_t depthwise =
+    createConvolution(3, 1, subsampling, inputChannels, 1, 1, depthwiseKernel, depthwiseBias, flags);
+  qnnp_operator_t pointwise =
+    createConvolution(1, 0, 1, 1, inputChannels, outputChannels, pointwiseKernel, pointwiseBias, flags);
+  ASSERT_NE(nullptr, depthwise);
+  ASSERT_NE(nullptr, pointwise);
+
+  pthreadpool_t threadpool = pthreadpool_create(threads);
+  std::vector<uint8_t> filtered(batchSize * outputHeight * outputWidth * inputChannels + 8);
+  std::vector<uint8_t> referenceOutput(batchSize * outputHeight * outputWidth * outputChannels);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(
+      depthwise, batchSize, height, width,
+      input.data() + 8, inputPixelStride,
+      filtered.data() + 8, inputChannels,
+      threadpool));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(depthwise, threadpool));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(
+      pointwise, batchSize, outputHeight, outputWidth,
+      filtered.data() + 8, inputChannels,
+      referenceOutput.data(), outputChannels,
+      threadpool));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(pointwise, threadpool));
+
+  qnnp_operator_t depthwiseSeparable = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_depthwise_separable_nhwc_q8(depthwise, pointwise, 0 /* flags */, &depthwiseSeparable));
+  ASSERT_NE(nullptr, depthwiseSeparable);
+
+  std::vector<uint8_t> output(batchSize * outputHeight * outputWidth * outputChannels);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_depthwise_separable_nhwc_q8(
+      depthwiseSeparable, batchSize, height, width,
+      input.data() + 8, inputPixelStride,
+      output.data(), outputChannels,
+      threadpool));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(depthwiseSeparable, threadpool));
+  EXPECT_EQ(referenceOutput, output);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(depthwiseSeparable));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(depthwise));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(pointwise));
+  if (threadpool != nullptr) {
+    pthreadpool_destroy(threadpool);
+  }
+}
+
+}  // namespace
+
+TEST(DEPTHWISE_SEPARABLE, single_thread) {
+  testDepthwiseSeparable(1, 1, 13, 11, 24, 16, 24, 1, 0 /* flags */);
+}
+
+TEST(DEPTHWISE_SEPARABLE, single_thread_with_subsampling) {
+  testDepthwiseSeparable(1, 1, 13, 11, 24, 16, 24, 2, 0 /* flags */);
+}
+
+TEST(DEPTHWISE_SEPARABLE, multithreaded) {
+  testDepthwiseSeparable(4, 2, 13, 11, 24, 16, 24, 1, 0 /* flags */);
+}
+
+TEST(DEPTHWISE_SEPARABLE, multithreaded_with_subsampling) {
+  testDepthwiseSeparable(4, 2, 14, 12, 24, 16, 24, 2, 0 /* flags */);
+}
+
+TEST(DEPTHWISE_SEPARABLE, wide_rows) {
+  testDepthwiseSeparable(3, 2, 5, 97, 16, 8, 16, 1, 0 /* flags */);
+}
+
+TEST(DEPTHWISE_SEPARABLE, input_pixel_stride) {
+  testDepthwiseSeparable(3, 2, 9, 7, 24, 16, 29, 1, 0 /* flags */);
+}
+
+TEST(DEPTHWISE_SEPARABLE, few_channels) {
+  testDepthwiseSeparable(3, 2, 9, 7, 5, 4, 5, 1, 0 /* flags */);
+}
+
+TEST(DEPTHWISE_SEPARABLE, lazy_packing) {
+  testDepthwiseSeparable(3, 2, 13, 11, 24, 16, 24, 1, QNNP_CREATE_FLAG_LAZY_PACKING);
+}
+
+TEST(DEPTHWISE_SEPARABLE, padded_pointwise) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> depthwiseKernel(16 * 9, 1), pointwiseKernel(16 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t depthwise = createConvolution(3, 1, 1, 16, 1, 1, depthwiseKernel, bias, 0);
+  qnnp_operator_t pointwise = createConvolution(1, 1, 1, 1, 16, 8, pointwiseKernel, bias, 0);
+
+  qnnp_operator_t depthwiseSeparable = nullptr;
+  EXPECT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_create_depthwise_separable_nhwc_q8(depthwise, pointwise, 0 /* flags */, &depthwiseSeparable));
+  EXPECT_EQ(nullptr, depthwiseSeparable);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(depthwise));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(pointwise));
+}
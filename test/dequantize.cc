@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "conversion-tester.h"
+
+
+TEST(DEQUANTIZE_OP, invalid_parameters) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t dequantize_op = nullptr;
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_dequantize_nc_q8_f32(0, 127, 1.0f, 0, &dequantize_op));
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_dequantize_nc_q8_f32(7, 127, -1.0f, 0, &dequantize_op));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_dequantize_nc_q8_f32(7, 127, 1.0f, 0, &dequantize_op));
+  uint8_t input[7] = { 0 };
+  float output[7] = { 0.0f };
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_dequantize_nc_q8_f32(dequantize_op, 1, input, 7, output, 6, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(dequantize_op));
+}
+
+TEST(DEQUANTIZE_OP, unit_batch) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(1)
+      .channels(channels)
+      .iterations(3)
+      .testDequantize();
+  }
+}
+
+TEST(DEQUANTIZE_OP, small_batch) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(3)
+      .channels(channels)
+      .iterations(3)
+      .testDequantize();
+  }
+}
+
+TEST(DEQUANTIZE_OP, small_batch_with_input_stride) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(3)
+      .channels(channels)
+      .inputStride(129)
+      .iterations(3)
+      .testDequantize();
+  }
+}
+
+TEST(DEQUANTIZE_OP, small_batch_with_output_stride) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(3)
+      .channels(channels)
+      .outputStride(117)
+      .iterations(3)
+      .testDequantize();
+  }
+}
+
+TEST(DEQUANTIZE_OP, large_batch_multithreaded) {
+  ConversionTester()
+    .batchSize(1000)
+    .channels(19)
+    .threads(4)
+    .iterations(2)
+    .testDequantize();
+}
+
+TEST(DEQUANTIZE_OP, large_batch_multithreaded_with_strides) {
+  ConversionTester()
+    .batchSize(300)
+    .channels(19)
+    .inputStride(23)
+    .outputStride(29)
+    .threads(4)
+    .iterations(2)
+    .testDequantize();
+}
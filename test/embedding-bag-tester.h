@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+/* Tests embedding-bag operators on bags of random lengths in [0, maxBagSize] */
+class EmbeddingBagTester {
+ public:
+  inline EmbeddingBagTester& numEmbeddings(size_t numEmbeddings) {
+    assert(numEmbeddings != 0);
+    this->numEmbeddings_ = numEmbeddings;
+    return *this;
+  }
+
+  inline size_t numEmbeddings() const {
+    return this->numEmbeddings_;
+  }
+
+  inline EmbeddingBagTester& embeddingDim(size_t embeddingDim) {
+    assert(embeddingDim != 0);
+    this->embeddingDim_ = embeddingDim;
+    return *this;
+  }
+
+  inline size_t embeddingDim() const {
+    return this->embeddingDim_;
+  }
+
+  inline EmbeddingBagTester& bags(size_t bags) {
+    assert(bags != 0);
+    this->bags_ = bags;
+    return *this;
+  }
+
+  inline size_t bags() const {
+    return this->bags_;
+  }
+
+  inline EmbeddingBagTester& maxBagSize(size_t maxBagSize) {
+    this->maxBagSize_ = maxBagSize;
+    return *this;
+  }
+
+  inline size_t maxBagSize() const {
+    return this->maxBagSize_;
+  }
+
+  inline EmbeddingBagTester& outputStride(size_t outputStride) {
+    assert(outputStride != 0);
+    this->outputStride_ = outputStride;
+    return *this;
+  }
+
+  inline size_t outputStride() const {
+    if (this->outputStride_ == 0) {
+      return this->embeddingDim_;
+    } else {
+      assert(this->outputStride_ >= this->embeddingDim_);
+      return this->outputStride_;
+    }
+  }
+
+  inline EmbeddingBagTester& mean(bool mean) {
+    this->mean_ = mean;
+    return *this;
+  }
+
+  inline bool mean() const {
+    return this->mean_;
+  }
+
+  inline EmbeddingBagTester& perSampleWeights(bool perSampleWeights) {
+    this->perSampleWeights_ = perSampleWeights;
+    return *this;
+  }
+
+  inline bool perSampleWeights() const {
+    return this->perSampleWeights_;
+  }
+
+  inline EmbeddingBagTester& threads(size_t threads) {
+    this->threads_ = threads;
+    return *this;
+  }
+
+  inline size_t threads() const {
+    return this->threads_;
+  }
+
+  inline EmbeddingBagTester& iterations(size_t iterations) {
+    this->iterations_ = iterations;
+    return *this;
+  }
+
+  inline size_t iterations() const {
+    return this->iterations_;
+  }
+
+  void testQ8() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint32_t>(0, 255), rng);
+    auto indexRng = std::bind(std::uniform_int_distribution<uint32_t>(0, uint32_t(numEmbeddings() - 1)), rng);
+    auto lengthRng = std::bind(std::uniform_int_distribution<uint32_t>(0, uint32_t(maxBagSize())), rng);
+    auto scaleRng = std::bind(std::uniform_real_distribution<float>(0.001f, 0.01f), rng);
+    auto biasRng = std::bind(std::uniform_real_distribution<float>(-1.0f, 1.0f), rng);
+    auto weightRng = std::bind(std::uniform_real_distribution<float>(0.0f, 2.0f), rng);
+
+    std::vector<uint8_t> weights(numEmbeddings() * embeddingDim());
+    std::vector<float> scales(numEmbeddings());
+    std::vector<float> biases(numEmbeddings());
+    std::vector<uint32_t> offsets(bags() + 1);
+    std::vector<uint32_t> indices;
+    std::vector<float> sampleWeights;
+    std::vector<float> output((bags() - 1) * outputStride() + embeddingDim());
+    std::vector<double> outputRef(bags() * embeddingDim());
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(weights.begin(), weights.end(), std::ref(u8rng));
+      std::generate(scales.begin(), scales.end(), std::ref(scaleRng));
+      std::generate(biases.begin(), biases.end(), std::ref(biasRng));
+      offsets[0] = 0;
+      for (size_t i = 0; i < bags(); i++) {
+        offsets[i + 1] = offsets[i] + lengthRng();
+      }
+      indices.resize(offsets[bags()]);
+      std::generate(indices.begin(), indices.end(), std::ref(indexRng));
+      sampleWeights.resize(offsets[bags()]);
+      std::generate(sampleWeights.begin(), sampleWeights.end(), std::ref(weightRng));
+      std::fill(output.begin(), output.end(), 0xA5);
+
+      std::fill(outputRef.begin(), outputRef.end(), 0.0);
+      for (size_t i = 0; i < bags(); i++) {
+        for (size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+          const uint32_t index = indices[j];
+          const double weight = perSampleWeights() ? double(sampleWeights[j]) : 1.0;
+          for (size_t c = 0; c < embeddingDim(); c++) {
+            outputRef[i * embeddingDim() + c] +=
+              weight * (double(weights[index * embeddingDim() + c]) * double(scales[index]) + double(biases[index]));
+          }
+        }
+        if (mean() && offsets[i + 1] != offsets[i]) {
+          for (size_t c = 0; c < embeddingDim(); c++) {
+            outputRef[i * embeddingDim() + c] /= double(offsets[i + 1] - offsets[i]);
+          }
+        }
+      }
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t embeddingBag = nullptr;
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_embedding_bag_q8(
+          numEmbeddings(), embeddingDim(),
+          weights.data(), scales.data(), biases.data(),
+          mean() ? QNNP_CREATE_FLAG_EMBEDDING_BAG_MEAN : 0, &embeddingBag));
+      ASSERT_NE(nullptr, embeddingBag);
+
+      pthreadpool_t threadpool = nullptr;
+      if (threads() != 1) {
+        threadpool = pthreadpool_create(threads());
+        ASSERT_NE(nullptr, threadpool);
+      }
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_embedding_bag_q8(
+          embeddingBag,
+          bags(),
+          indices.data(), offsets.data(),
+          perSampleWeights() ? sampleWeights.data() : nullptr,
+          output.data(), outputStride(),
+          threadpool));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(embeddingBag, threadpool));
+
+      if (threadpool != nullptr) {
+        pthreadpool_destroy(threadpool);
+      }
+      ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(embeddingBag));
+
+      for (size_t i = 0; i < bags(); i++) {
+        const size_t bagSize = offsets[i + 1] - offsets[i];
+        for (size_t c = 0; c < embeddingDim(); c++) {
+          /* Rounding of the float accumulation grows with the rows of the bag */
+          const double tolerance = 1.0e-4 * double(std::max<size_t>(bagSize, 1));
+          ASSERT_NEAR(outputRef[i * embeddingDim() + c], double(output[i * outputStride() + c]), tolerance)
+            << "bag = " << i << " of size " << bagSize << ", channel = " << c;
+        }
+        for (size_t c = embeddingDim(); i + 1 < bags() && c < outputStride(); c++) {
+          ASSERT_EQ(float(0xA5), output[i * outputStride() + c])
+            << "bag = " << i << ", padding " << c << " was overwritten";
+        }
+      }
+    }
+  }
+
+ private:
+  size_t numEmbeddings_{100};
+  size_t embeddingDim_{1};
+  size_t bags_{1};
+  size_t maxBagSize_{10};
+  size_t outputStride_{0};
+  bool mean_{false};
+  bool perSampleWeights_{false};
+  size_t threads_{1};
+  size_t iterations_{3};
+};
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "embedding-bag-tester.h"
+
+
+TEST(EMBEDDING_BAG_OP, invalid_parameters) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> weights(4 * 3);
+  const std::vector<float> scales(4, 1.0f);
+  const std::vector<float> biases(4, 0.0f);
+  qnnp_operator_t embedding_bag = nullptr;
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_embedding_bag_q8(0, 3, weights.data(), scales.data(), biases.data(), 0, &embedding_bag));
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_embedding_bag_q8(4, 0, weights.data(), scales.data(), biases.data(), 0, &embedding_bag));
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_embedding_bag_q8(4, 3, weights.data(), nullptr, biases.data(), 0, &embedding_bag));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_embedding_bag_q8(4, 3, weights.data(), scales.data(), biases.data(), 0, &embedding_bag));
+
+  const uint32_t indices[3] = { 0, 3, 4 };
+  const uint32_t offsets[3] = { 0, 2, 3 };
+  const uint32_t unordered_offsets[3] = { 0, 2, 1 };
+  std::vector<float> output(2 * 3);
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_embedding_bag_q8(embedding_bag, 0, indices, offsets, nullptr, output.data(), 3, nullptr));
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_embedding_bag_q8(embedding_bag, 1, indices, offsets, nullptr, output.data(), 2, nullptr));
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_embedding_bag_q8(embedding_bag, 2, indices, unordered_offsets, nullptr, output.data(), 3, nullptr));
+  /* Index 4 is out of the table */
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_embedding_bag_q8(embedding_bag, 2, indices, offsets, nullptr, output.data(), 3, nullptr));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_embedding_bag_q8(embedding_bag, 1, indices, offsets, nullptr, output.data(), 3, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(embedding_bag));
+}
+
+TEST(EMBEDDING_BAG_OP, unit_bag) {
+  for (size_t embeddingDim = 1; embeddingDim < 40; embeddingDim += 3) {
+    EmbeddingBagTester()
+      .embeddingDim(embeddingDim)
+      .testQ8();
+  }
+}
+
+TEST(EMBEDDING_BAG_OP, small_batch) {
+  for (size_t embeddingDim = 1; embeddingDim < 40; embeddingDim += 3) {
+    EmbeddingBagTester()
+      .embeddingDim(embeddingDim)
+      .bags(5)
+      .testQ8();
+  }
+}
+
+TEST(EMBEDDING_BAG_OP, small_batch_with_output_stride) {
+  for (size_t embeddingDim = 1; embeddingDim < 40; embeddingDim += 3) {
+    EmbeddingBagTester()
+      .embeddingDim(embeddingDim)
+      .bags(5)
+      .outputStride(43)
+      .testQ8();
+  }
+}
+
+TEST(EMBEDDING_BAG_OP, empty_bags) {
+  EmbeddingBagTester()
+    .embeddingDim(17)
+    .bags(7)
+    .maxBagSize(0)
+    .testQ8();
+  EmbeddingBagTester()
+    .embeddingDim(17)
+    .bags(7)
+    .maxBagSize(0)
+    .mean(true)
+    .testQ8();
+}
+
+TEST(EMBEDDING_BAG_OP, mean) {
+  for (size_t embeddingDim = 1; embeddingDim < 40; embeddingDim += 3) {
+    EmbeddingBagTester()
+      .embeddingDim(embeddingDim)
+      .bags(5)
+      .mean(true)
+      .testQ8();
+  }
+}
+
+TEST(EMBEDDING_BAG_OP, per_sample_weights) {
+  for (size_t embeddingDim = 1; embeddingDim < 40; embeddingDim += 3) {
+    EmbeddingBagTester()
+      .embeddingDim(embeddingDim)
+      .bags(5)
+      .perSampleWeights(true)
+      .testQ8();
+  }
+}
+
+TEST(EMBEDDING_BAG_OP, mean_with_per_sample_weights) {
+  for (size_t embeddingDim = 1; embeddingDim < 40; embeddingDim += 3) {
+    EmbeddingBagTester()
+      .embeddingDim(embeddingDim)
+      .bags(5)
+      .mean(true)
+      .perSampleWeights(true)
+      .testQ8();
+  }
+}
+
+TEST(EMBEDDING_BAG_OP, large_table_with_prefetch) {
+  /* 64K rows of 64 elements do not fit in the L2 cache, so rows are prefetched */
+  EmbeddingBagTester()
+    .numEmbeddings(65536)
+    .embeddingDim(64)
+    .bags(64)
+    .maxBagSize(40)
+    .iterations(1)
+    .testQ8();
+}
+
+TEST(EMBEDDING_BAG_OP, large_batch_multithreaded) {
+  EmbeddingBagTester()
+    .numEmbeddings(1000)
+    .embeddingDim(24)
+    .bags(500)
+    .mean(true)
+    .threads(4)
+    .iterations(2)
+    .testQ8();
+}
@@ -16,6 +16,9 @@
 #include <random>
 #include <vector>
 
+#include <cpuinfo.h>
+#include <fp16.h>
+
 #include <qnnpack.h>
 
 
@@ -72,15 +75,66 @@ class FullyConnectedTester {
     return *this;
   }
 
+  /* Distance between batch rows, or between output channels with QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT */
   inline size_t outputStride() const {
+    const size_t rowSize = transposedOutput() ? batchSize() : outputChannels();
     if (this->outputStride_ == 0) {
-      return outputChannels();
+      return rowSize;
     } else {
-      assert(this->outputStride_ >= outputChannels());
+      assert(this->outputStride_ >= rowSize);
       return this->outputStride_;
     }
   }
 
+  inline bool transposedOutput() const {
+    return (flags() & QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT) != 0;
+  }
+
+  inline size_t outputSize() const {
+    return transposedOutput() ?
+      (outputChannels() - 1) * outputStride() + batchSize() :
+      (batchSize() - 1) * outputStride() + outputChannels();
+  }
+
+  inline size_t outputIndex(size_t batchIndex, size_t channel) const {
+    return transposedOutput() ? channel * outputStride() + batchIndex : batchIndex * outputStride() + channel;
+  }
+
+  inline FullyConnectedTester& kernelZeroPoint(uint8_t kernelZeroPoint) {
+    this->kernelZeroPoint_ = kernelZeroPoint;
+    return *this;
+  }
+
+  inline uint8_t kernelZeroPoint() const {
+    return this->kernelZeroPoint_;
+  }
+
+  /*
+   * Largest difference of the kernel from its zero point, or 0 for any kernel. Kernels close to their zero point let
+   * GEMM microkernels accumulate in 16 bits, see QNNP_OPERATOR_INFO_FLAG_ACC16.
+   */
+  inline FullyConnectedTester& kernelMaxDeviation(uint8_t kernelMaxDeviation) {
+    this->kernelMaxDeviation_ = kernelMaxDeviation;
+    return *this;
+  }
+
+  inline uint8_t kernelMaxDeviation() const {
+    return this->kernelMaxDeviation_;
+  }
+
+  /*
+   * Sets about half of the blocks of 4 consecutive input channels of every kernel row to the kernel zero point, for the
+   * block-sparse microkernels of QNNP_CREATE_FLAG_SPARSE_KERNEL.
+   */
+  inline FullyConnectedTester& prunedKernel(bool prunedKernel) {
+    this->prunedKernel_ = prunedKernel;
+    return *this;
+  }
+
+  inline bool prunedKernel() const {
+    return this->prunedKernel_;
+  }
+
   inline FullyConnectedTester& qmin(uint8_t qmin) {
     this->qmin_ = qmin;
     return *this;
@@ -108,25 +162,66 @@ class FullyConnectedTester {
     return this->iterations_;
   }
 
+  inline FullyConnectedTester& flags(uint32_t flags) {
+    this->flags_ = flags;
+    return *this;
+  }
+
+  inline uint32_t flags() const {
+    return this->flags_;
+  }
+
+  inline FullyConnectedTester& threads(size_t threads) {
+    this->threads_ = threads;
+    return *this;
+  }
+
+  inline size_t threads() const {
+    return this->threads_;
+  }
+
+  inline FullyConnectedTester& invertingLookupTable(bool invertingLookupTable) {
+    this->invertingLookupTable_ = invertingLookupTable;
+    return *this;
+  }
+
+  inline bool invertingLookupTable() const {
+    return this->invertingLookupTable_;
+  }
+
   void test() const {
     std::random_device randomDevice;
     auto rng = std::mt19937(randomDevice());
     auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
     auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+    const int32_t kernelMin = kernelMaxDeviation() == 0 ? 0 :
+      std::max<int32_t>(int32_t(kernelZeroPoint()) - int32_t(kernelMaxDeviation()), 0);
+    const int32_t kernelMax = kernelMaxDeviation() == 0 ? 255 :
+      std::min<int32_t>(int32_t(kernelZeroPoint()) + int32_t(kernelMaxDeviation()), 255);
+    auto kernelRng = std::bind(std::uniform_int_distribution<int32_t>(kernelMin, kernelMax), rng);
 
     std::vector<uint8_t> input((batchSize() - 1) * inputStride() + inputChannels() + 8);
     std::vector<uint8_t> kernel(outputChannels() * inputChannels());
     std::vector<int32_t> bias(outputChannels());
-    std::vector<uint8_t> output((batchSize() - 1) * outputStride() + outputChannels());
+    std::vector<uint8_t> output(outputSize());
     std::vector<int32_t> accumulators(batchSize() * outputChannels());
 
     const uint8_t* inputPtr = input.data() + 8;
     const uint8_t inputZeroPoint = 127;
-    const uint8_t kernelZeroPoint = 127;
 
     for (size_t iteration = 0; iteration < iterations(); iteration++) {
       std::generate(input.begin(), input.end(), std::ref(u8rng));
-      std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+      std::generate(kernel.begin(), kernel.end(), [&] { return uint8_t(kernelRng()); });
+      if (prunedKernel()) {
+        const size_t rowSize = inputChannels();
+        for (size_t rowStart = 0; rowStart < kernel.size(); rowStart += rowSize) {
+          for (size_t blockStart = 0; blockStart < rowSize; blockStart += 4) {
+            if (u8rng() & 1) {
+              std::fill_n(&kernel[rowStart + blockStart], std::min<size_t>(4, rowSize - blockStart), kernelZeroPoint());
+            }
+          }
+        }
+      }
       std::generate(bias.begin(), bias.end(), std::ref(s32rng));
       std::fill(output.begin(), output.end(), 0xA5);
       std::fill(accumulators.begin(), accumulators.end(), 0);
@@ -141,7 +236,7 @@ class FullyConnectedTester {
           for (size_t ic = 0; ic < inputChannels(); ic++) {
             accumulators[i * outputChannels() + oc] +=
               (int32_t(inputPtr[i * inputStride() + ic]) - int32_t(inputZeroPoint)) *
-              (int32_t(kernel[oc * inputChannels() + ic]) - int32_t(kernelZeroPoint));
+              (int32_t(kernel[oc * inputChannels() + ic]) - int32_t(kernelZeroPoint()));
           }
         }
       }
@@ -161,11 +256,28 @@ class FullyConnectedTester {
         qnnp_create_fully_connected_nc_q8(
           inputChannels(), outputChannels(),
           inputZeroPoint, 1.0f /* input scale */,
-          kernelZeroPoint, 1.0f /* kernel scale */,
+          kernelZeroPoint(), 1.0f /* kernel scale */,
           kernel.data(), bias.data(),
           outputZeroPoint, outputScale, qmin(), qmax(),
+          flags(),
           &convolution));
 
+      if (invertingLookupTable()) {
+        /* q -> 255 - q has unit slope, so the rounding tolerance of the reference comparison still holds */
+        uint8_t lookupTable[256];
+        for (size_t q = 0; q < 256; q++) {
+          lookupTable[q] = uint8_t(255 - q);
+        }
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_set_operator_lookup_table(convolution, lookupTable));
+      }
+
+      pthreadpool_t threadpool = nullptr;
+      if (threads() != 1) {
+        threadpool = pthreadpool_create(threads());
+        ASSERT_NE(nullptr, threadpool);
+      }
+
       ASSERT_EQ(qnnp_status_success,
         qnnp_setup_fully_connected_nc_q8(
           convolution,
@@ -174,10 +286,14 @@ class FullyConnectedTester {
           inputStride(),
           output.data(),
           outputStride(),
-          nullptr /* thread pool */));
+          threadpool));
 
       ASSERT_EQ(qnnp_status_success,
-        qnnp_run_operator(convolution, nullptr /* thread pool */));
+        qnnp_run_operator(convolution, threadpool));
+
+      if (threadpool != nullptr) {
+        pthreadpool_destroy(threadpool);
+      }
 
       ASSERT_EQ(qnnp_status_success,
         qnnp_delete_operator(convolution));
@@ -189,22 +305,316 @@ class FullyConnectedTester {
           const double clampedAccumulator = std::max(std::min(scaledAccumulator,
             double(qmax()) - double(outputZeroPoint)),
             double(qmin()) - double(outputZeroPoint));
+          const uint8_t outputValue = output[outputIndex(i, c)];
           ASSERT_NEAR(
             clampedAccumulator,
-            (int32_t(output[i * outputStride() + c]) - outputZeroPoint),
+            (int32_t(invertingLookupTable() ? 255 - outputValue : outputValue) - outputZeroPoint),
             0.9) << "batch index = " << i << ", channel = " << c;
         }
       }
     }
   }
 
+  /* Checks the int32 and float accumulator outputs of qnnp_setup_fully_connected_nc_q8_s32 and _f32 */
+  void testAccumulators() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    std::vector<uint8_t> input((batchSize() - 1) * inputStride() + inputChannels() + 8);
+    std::vector<uint8_t> kernel(outputChannels() * inputChannels());
+    std::vector<int32_t> bias(outputChannels());
+    std::vector<int32_t> output(outputSize());
+    std::vector<float> dequantizedOutput(outputSize());
+    std::vector<int32_t> accumulators(batchSize() * outputChannels());
+
+    const uint8_t* inputPtr = input.data() + 8;
+    const uint8_t inputZeroPoint = 127;
+    /* Powers of two, so that the dequantized accumulators are exact */
+    const float inputScale = 0.5f;
+    const float kernelScale = 0.25f;
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(input.begin(), input.end(), std::ref(u8rng));
+      std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+      std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+      std::fill(output.begin(), output.end(), INT32_C(0x5A5A5A5A));
+      std::fill(dequantizedOutput.begin(), dequantizedOutput.end(), std::nanf(""));
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t oc = 0; oc < outputChannels(); oc++) {
+          int32_t accumulator = bias[oc];
+          for (size_t ic = 0; ic < inputChannels(); ic++) {
+            accumulator +=
+              (int32_t(inputPtr[i * inputStride() + ic]) - int32_t(inputZeroPoint)) *
+              (int32_t(kernel[oc * inputChannels() + ic]) - int32_t(kernelZeroPoint()));
+          }
+          accumulators[i * outputChannels() + oc] = accumulator;
+        }
+      }
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t convolution = nullptr;
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_fully_connected_nc_q8(
+          inputChannels(), outputChannels(),
+          inputZeroPoint, inputScale,
+          kernelZeroPoint(), kernelScale,
+          kernel.data(), bias.data(),
+          127, 1.0e+6f /* output scale */, qmin(), qmax(),
+          flags(),
+          &convolution));
+
+      pthreadpool_t threadpool = nullptr;
+      if (threads() != 1) {
+        threadpool = pthreadpool_create(threads());
+        ASSERT_NE(nullptr, threadpool);
+      }
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_fully_connected_nc_q8_s32(
+          convolution,
+          batchSize(),
+          inputPtr, inputStride(),
+          output.data(), outputStride(),
+          threadpool));
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_run_operator(convolution, threadpool));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_fully_connected_nc_q8_f32(
+          convolution,
+          batchSize(),
+          inputPtr, inputStride(),
+          dequantizedOutput.data(), outputStride(),
+          threadpool));
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_run_operator(convolution, threadpool));
+
+      qnnp_operator_info info;
+      ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(convolution, &info));
+      ASSERT_TRUE(info.flags & QNNP_OPERATOR_INFO_FLAG_ACCUMULATOR_OUTPUT);
+
+      if (threadpool != nullptr) {
+        pthreadpool_destroy(threadpool);
+      }
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_delete_operator(convolution));
+      convolution = nullptr;
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t c = 0; c < outputChannels(); c++) {
+          const int32_t accumulator = accumulators[i * outputChannels() + c];
+          ASSERT_EQ(accumulator, output[outputIndex(i, c)])
+            << "batch index = " << i << ", channel = " << c;
+          ASSERT_EQ(float(accumulator) * inputScale * kernelScale, dequantizedOutput[outputIndex(i, c)])
+            << "batch index = " << i << ", channel = " << c;
+        }
+        for (size_t c = outputChannels(); !transposedOutput() && i + 1 < batchSize() && c < outputStride(); c++) {
+          ASSERT_EQ(INT32_C(0x5A5A5A5A), output[i * outputStride() + c])
+            << "batch index = " << i << ", padding " << c << " was overwritten";
+          ASSERT_TRUE(std::isnan(dequantizedOutput[i * outputStride() + c]))
+            << "batch index = " << i << ", padding " << c << " was overwritten";
+        }
+      }
+      for (size_t c = 0; transposedOutput() && c + 1 < outputChannels(); c++) {
+        for (size_t i = batchSize(); i < outputStride(); i++) {
+          ASSERT_EQ(INT32_C(0x5A5A5A5A), output[c * outputStride() + i])
+            << "channel = " << c << ", padding " << i << " was overwritten";
+        }
+      }
+    }
+  }
+
+  void testF32() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto f32rng = std::bind(std::uniform_real_distribution<float>(-1.0f, 1.0f), rng);
+
+    std::vector<float> input((batchSize() - 1) * inputStride() + inputChannels());
+    std::vector<float> kernel(outputChannels() * inputChannels());
+    std::vector<float> bias(outputChannels());
+    std::vector<float> output((batchSize() - 1) * outputStride() + outputChannels());
+    std::vector<double> outputRef(batchSize() * outputChannels());
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(input.begin(), input.end(), std::ref(f32rng));
+      std::generate(kernel.begin(), kernel.end(), std::ref(f32rng));
+      std::generate(bias.begin(), bias.end(), std::ref(f32rng));
+      std::fill(output.begin(), output.end(), nanf(""));
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t oc = 0; oc < outputChannels(); oc++) {
+          double acc = bias[oc];
+          for (size_t ic = 0; ic < inputChannels(); ic++) {
+            acc += double(input[i * inputStride() + ic]) * double(kernel[oc * inputChannels() + ic]);
+          }
+          outputRef[i * outputChannels() + oc] = acc;
+        }
+      }
+      const double accMin = *std::min_element(outputRef.cbegin(), outputRef.cend());
+      const double accMax = *std::max_element(outputRef.cbegin(), outputRef.cend());
+      const float outputMin = float(accMin + (accMax - accMin) / 255.0 * double(qmin()));
+      const float outputMax = float(accMax - (accMax - accMin) / 255.0 * double(255 - qmax()));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t fullyConnected = nullptr;
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_fully_connected_nc_f32(
+          inputChannels(), outputChannels(),
+          kernel.data(), bias.data(),
+          qmin() == 0 ? -INFINITY : outputMin, qmax() == 255 ? +INFINITY : outputMax,
+          flags(),
+          &fullyConnected));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_fully_connected_nc_f32(
+          fullyConnected,
+          batchSize(),
+          input.data(), inputStride(),
+          output.data(), outputStride(),
+          nullptr /* thread pool */));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_run_operator(fullyConnected, nullptr /* thread pool */));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_delete_operator(fullyConnected));
+      fullyConnected = nullptr;
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t c = 0; c < outputChannels(); c++) {
+          double outputRefValue = outputRef[i * outputChannels() + c];
+          if (qmin() != 0) {
+            outputRefValue = std::max(outputRefValue, double(outputMin));
+          }
+          if (qmax() != 255) {
+            outputRefValue = std::min(outputRefValue, double(outputMax));
+          }
+          ASSERT_NEAR(
+            outputRefValue,
+            output[i * outputStride() + c],
+            1.0e-5 * std::max(1.0, std::abs(outputRefValue))) << "batch index = " << i << ", channel = " << c;
+        }
+      }
+    }
+  }
+
+  void testF16() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto f16rng = std::bind(fp16_ieee_from_fp32_value, std::bind(std::uniform_real_distribution<float>(-1.0f, 1.0f), rng));
+
+    std::vector<uint16_t> input((batchSize() - 1) * inputStride() + inputChannels());
+    std::vector<uint16_t> kernel(outputChannels() * inputChannels());
+    std::vector<uint16_t> bias(outputChannels());
+    std::vector<uint16_t> output((batchSize() - 1) * outputStride() + outputChannels());
+    std::vector<double> outputRef(batchSize() * outputChannels());
+    /* Sums of absolute values of the accumulated terms, which bound the FP16 rounding error */
+    std::vector<double> outputMagnitude(batchSize() * outputChannels());
+
+    ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+    if (!cpuinfo_has_arm_neon_fp16_arith()) {
+      qnnp_operator_t fullyConnected = nullptr;
+      ASSERT_EQ(qnnp_status_unsupported_hardware,
+        qnnp_create_fully_connected_nc_f16(
+          inputChannels(), outputChannels(),
+          kernel.data(), bias.data(),
+          -INFINITY, +INFINITY,
+          flags(),
+          &fullyConnected));
+      return;
+    }
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(input.begin(), input.end(), std::ref(f16rng));
+      std::generate(kernel.begin(), kernel.end(), std::ref(f16rng));
+      std::generate(bias.begin(), bias.end(), std::ref(f16rng));
+      std::fill(output.begin(), output.end(), UINT16_C(0x7E00) /* NaN */);
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t oc = 0; oc < outputChannels(); oc++) {
+          double acc = fp16_ieee_to_fp32_value(bias[oc]);
+          double magnitude = std::abs(acc);
+          for (size_t ic = 0; ic < inputChannels(); ic++) {
+            const double product =
+              double(fp16_ieee_to_fp32_value(input[i * inputStride() + ic])) * double(fp16_ieee_to_fp32_value(kernel[oc * inputChannels() + ic]));
+            acc += product;
+            magnitude += std::abs(product);
+          }
+          outputRef[i * outputChannels() + oc] = acc;
+          outputMagnitude[i * outputChannels() + oc] = magnitude;
+        }
+      }
+      const double accMin = *std::min_element(outputRef.cbegin(), outputRef.cend());
+      const double accMax = *std::max_element(outputRef.cbegin(), outputRef.cend());
+      /* The operator rounds the output range to half precision */
+      const float outputMin = fp16_ieee_to_fp32_value(fp16_ieee_from_fp32_value(
+        float(accMin + (accMax - accMin) / 255.0 * double(qmin()))));
+      const float outputMax = fp16_ieee_to_fp32_value(fp16_ieee_from_fp32_value(
+        float(accMax - (accMax - accMin) / 255.0 * double(255 - qmax()))));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t fullyConnected = nullptr;
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_fully_connected_nc_f16(
+          inputChannels(), outputChannels(),
+          kernel.data(), bias.data(),
+          qmin() == 0 ? -INFINITY : outputMin, qmax() == 255 ? +INFINITY : outputMax,
+          flags(),
+          &fullyConnected));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_fully_connected_nc_f16(
+          fullyConnected,
+          batchSize(),
+          input.data(), inputStride(),
+          output.data(), outputStride(),
+          nullptr /* thread pool */));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_run_operator(fullyConnected, nullptr /* thread pool */));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_delete_operator(fullyConnected));
+      fullyConnected = nullptr;
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t c = 0; c < outputChannels(); c++) {
+          double outputRefValue = outputRef[i * outputChannels() + c];
+          if (qmin() != 0) {
+            outputRefValue = std::max(outputRefValue, double(outputMin));
+          }
+          if (qmax() != 255) {
+            outputRefValue = std::min(outputRefValue, double(outputMax));
+          }
+          ASSERT_NEAR(
+            outputRefValue,
+            fp16_ieee_to_fp32_value(output[i * outputStride() + c]),
+            5.0e-3 * std::max(1.0, outputMagnitude[i * outputChannels() + c])) << "batch index = " << i << ", channel = " << c;
+        }
+      }
+    }
+  }
+
  private:
   size_t inputChannels_{1};
   size_t inputStride_{0};
   size_t outputChannels_{1};
   size_t outputStride_{0};
   size_t batchSize_{1};
+  uint8_t kernelZeroPoint_{127};
+  uint8_t kernelMaxDeviation_{0};
+  bool prunedKernel_{false};
   uint8_t qmin_{0};
   uint8_t qmax_{255};
   size_t iterations_{1};
+  uint32_t flags_{0};
+  bool invertingLookupTable_{false};
+  size_t threads_{1};
 };
@@ -110,3 +110,848 @@ TEST(FULLY_CONNECTED, small_batch_with_output_stride) {
     .iterations(3)
     .test();
 }
+
+TEST(FULLY_CONNECTED, small_batch_with_lazy_packing) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_lookup_table) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .outputStride(29)
+    .invertingLookupTable(true)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_signed_kernel) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .kernelZeroPoint(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_signed_kernel_and_lazy_packing) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .kernelZeroPoint(128)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_folded_zero_point) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, unit_batch_with_folded_zero_point) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_small_kernel) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .kernelMaxDeviation(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_small_kernel_near_acc16_bound) {
+  /* Rows deviate from the kernel zero point by at most 64 * 3 = 192 in total, within INT16_MAX / 128 */
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(64)
+    .outputChannels(19)
+    .kernelMaxDeviation(3)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_small_kernel_and_threads) {
+  FullyConnectedTester()
+    .batchSize(29)
+    .inputChannels(23)
+    .outputChannels(43)
+    .kernelMaxDeviation(3)
+    .threads(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, unit_batch_with_few_output_channels) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(256)
+    .outputChannels(4)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_few_output_channels) {
+  /* Narrow layers may select a narrower tile than the default microkernel, see OPERATOR_INFO */
+  for (size_t outputChannels = 1; outputChannels <= 4; outputChannels++) {
+    FullyConnectedTester()
+      .batchSize(12)
+      .inputChannels(256)
+      .outputChannels(outputChannels)
+      .iterations(1)
+      .test();
+  }
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_few_output_channels_and_signed_kernel) {
+  for (size_t outputChannels = 1; outputChannels <= 4; outputChannels++) {
+    FullyConnectedTester()
+      .batchSize(12)
+      .inputChannels(256)
+      .outputChannels(outputChannels)
+      .kernelZeroPoint(128)
+      .iterations(1)
+      .test();
+  }
+}
+
+TEST(FULLY_CONNECTED, batch_lt_mr) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  for (size_t batchSize = 1; batchSize < qnnp_params.q8conv.mr; batchSize++) {
+    FullyConnectedTester()
+      .batchSize(batchSize)
+      .inputChannels(71)
+      .outputChannels(37)
+      .outputStride(41)
+      .iterations(1)
+      .test();
+  }
+}
+
+TEST(FULLY_CONNECTED, batch_lt_mr_with_lookup_table) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  for (size_t batchSize = 1; batchSize < qnnp_params.q8conv.mr; batchSize++) {
+    FullyConnectedTester()
+      .batchSize(batchSize)
+      .inputChannels(71)
+      .outputChannels(37)
+      .invertingLookupTable(true)
+      .iterations(1)
+      .test();
+  }
+}
+
+TEST(FULLY_CONNECTED, unit_batch_with_split_k) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(2053)
+    .outputChannels(19)
+    .threads(16)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, unit_batch_with_split_k_and_lookup_table) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(2053)
+    .outputChannels(19)
+    .outputStride(29)
+    .invertingLookupTable(true)
+    .threads(16)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, unit_batch_with_split_k_and_many_threads) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(4096)
+    .outputChannels(5)
+    .threads(64)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_large_kernel) {
+  FullyConnectedTester()
+    .batchSize(13)
+    .inputChannels(4096)
+    .outputChannels(161)
+    .iterations(1)
+    .test();
+}
+
+TEST(FULLY_CONNECTED, small_batch_with_large_kernel_and_threads) {
+  FullyConnectedTester()
+    .batchSize(13)
+    .inputChannels(4096)
+    .outputChannels(161)
+    .threads(4)
+    .iterations(1)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_FP32_REQUANTIZATION, unit_batch) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_FP32_REQUANTIZATION, small_batch) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_FP32_REQUANTIZATION, small_batch_with_qmin) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmin(128)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_FP32_REQUANTIZATION, small_batch_with_qmax) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmax(128)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_FP32_REQUANTIZATION, small_batch_with_signed_kernel) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .kernelZeroPoint(128)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_FP32_REQUANTIZATION, unit_batch_with_split_k) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(2053)
+    .outputChannels(19)
+    .threads(16)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_FP32_REQUANTIZATION, small_batch_with_large_kernel_and_threads) {
+  FullyConnectedTester()
+    .batchSize(13)
+    .inputChannels(4096)
+    .outputChannels(161)
+    .threads(4)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(1)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, unit_batch) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(23)
+    .outputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, small_batch) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, small_batch_with_few_input_channels) {
+  /* The last block of every row ends at its last input channel, and fewer channels than a block use a dense kernel */
+  for (size_t inputChannels = 1; inputChannels <= 7; inputChannels++) {
+    FullyConnectedTester()
+      .batchSize(12)
+      .inputChannels(inputChannels)
+      .outputChannels(19)
+      .prunedKernel(true)
+      .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, small_batch_with_qmin) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmin(128)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, small_batch_with_qmax) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmax(128)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, small_batch_with_strides) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .inputStride(28)
+    .outputChannels(19)
+    .outputStride(29)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, small_batch_with_dense_kernel) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, small_batch_with_lazy_packing) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL | QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, small_batch_with_lookup_table) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .invertingLookupTable(true)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_SPARSE_KERNEL, small_batch_with_large_kernel_and_threads) {
+  FullyConnectedTester()
+    .batchSize(13)
+    .inputChannels(1024)
+    .outputChannels(161)
+    .threads(4)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL)
+    .iterations(1)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, unit_batch) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(23)
+    .outputChannels(19)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, small_batch) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, small_batch_with_qmin) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmin(128)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, small_batch_with_qmax) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmax(128)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, small_batch_with_strides) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .inputStride(28)
+    .outputChannels(19)
+    .outputStride(29)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, small_batch_with_lazy_packing) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL | QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, small_batch_with_lookup_table) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .invertingLookupTable(true)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, unit_batch_with_large_kernel_and_threads) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(1024)
+    .outputChannels(161)
+    .threads(4)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL)
+    .iterations(1)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, small_batch_with_large_kernel_and_threads) {
+  FullyConnectedTester()
+    .batchSize(13)
+    .inputChannels(1024)
+    .outputChannels(161)
+    .threads(4)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL)
+    .iterations(1)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_4BIT_KERNEL, kernel_out_of_range) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::vector<uint8_t> kernel(4 * 3, 15);
+  const std::vector<int32_t> bias(4, 0);
+  qnnp_operator_t op = nullptr;
+  kernel[5] = 16;
+  EXPECT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_fully_connected_nc_q8(
+      3, 4, 127, 1.0f, 7, 1.0f, kernel.data(), bias.data(),
+      127, 100.0f, 0, 255, QNNP_CREATE_FLAG_4BIT_KERNEL, &op));
+  EXPECT_EQ(nullptr, op);
+
+  kernel[5] = 15;
+  EXPECT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_fully_connected_nc_q8(
+      3, 4, 127, 1.0f, 16, 1.0f, kernel.data(), bias.data(),
+      127, 100.0f, 0, 255, QNNP_CREATE_FLAG_4BIT_KERNEL, &op));
+  EXPECT_EQ(nullptr, op);
+}
+
+TEST(FULLY_CONNECTED_ACCUMULATORS, unit_batch) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(23)
+    .outputChannels(19)
+    .iterations(3)
+    .testAccumulators();
+}
+
+TEST(FULLY_CONNECTED_ACCUMULATORS, small_batch) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .iterations(3)
+    .testAccumulators();
+}
+
+TEST(FULLY_CONNECTED_ACCUMULATORS, small_batch_with_strides) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .inputStride(28)
+    .outputChannels(19)
+    .outputStride(29)
+    .iterations(3)
+    .testAccumulators();
+}
+
+TEST(FULLY_CONNECTED_ACCUMULATORS, large_kernel_multithreaded) {
+  FullyConnectedTester()
+    .batchSize(3)
+    .inputChannels(1023)
+    .outputChannels(61)
+    .threads(4)
+    .iterations(1)
+    .testAccumulators();
+}
+
+TEST(FULLY_CONNECTED_ACCUMULATORS, fp32_requantization) {
+  FullyConnectedTester()
+    .batchSize(5)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_FP32_REQUANTIZATION)
+    .iterations(3)
+    .testAccumulators();
+}
+
+TEST(FULLY_CONNECTED_ACCUMULATORS, sparse_kernel_unsupported) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(4 * 3, 127);
+  const std::vector<int32_t> bias(4, 0);
+  qnnp_operator_t op = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      3, 4, 127, 1.0f, 127, 1.0f, kernel.data(), bias.data(),
+      127, 100.0f, 0, 255, QNNP_CREATE_FLAG_SPARSE_KERNEL, &op));
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  std::vector<uint8_t> input(3 + 8);
+  std::vector<int32_t> output(4);
+  EXPECT_EQ((info.flags & QNNP_OPERATOR_INFO_FLAG_SPARSE) ? qnnp_status_unsupported_parameter : qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8_s32(op, 1, input.data(), 3, output.data(), 4, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, unit_batch) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, small_batch) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, small_batch_with_strides) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .inputStride(28)
+    .outputChannels(19)
+    .outputStride(17)
+    .flags(QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, small_batch_with_lookup_table) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .invertingLookupTable(true)
+    .flags(QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, batch_lt_mr) {
+  FullyConnectedTester()
+    .batchSize(2)
+    .inputChannels(71)
+    .outputChannels(37)
+    .flags(QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, unit_batch_with_split_k) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(2053)
+    .outputChannels(19)
+    .outputStride(3)
+    .threads(16)
+    .flags(QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, small_batch_with_large_kernel_and_threads) {
+  FullyConnectedTester()
+    .batchSize(13)
+    .inputChannels(4096)
+    .outputChannels(161)
+    .threads(4)
+    .flags(QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(1)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, small_batch_with_sparse_kernel) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .prunedKernel(true)
+    .flags(QNNP_CREATE_FLAG_SPARSE_KERNEL | QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, small_batch_with_4bit_kernel) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .kernelZeroPoint(7)
+    .kernelMaxDeviation(8)
+    .flags(QNNP_CREATE_FLAG_4BIT_KERNEL | QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(3)
+    .test();
+}
+
+TEST(FULLY_CONNECTED_TRANSPOSED_OUTPUT, accumulators) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .outputStride(15)
+    .flags(QNNP_CREATE_FLAG_TRANSPOSED_OUTPUT)
+    .iterations(3)
+    .testAccumulators();
+}
+
+TEST(FULLY_CONNECTED_F32, unit_batch) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(23)
+    .outputChannels(19)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(FULLY_CONNECTED_F32, small_batch) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(FULLY_CONNECTED_F32, small_batch_with_qmin) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmin(128)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(FULLY_CONNECTED_F32, small_batch_with_qmax) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmax(128)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(FULLY_CONNECTED_F32, small_batch_with_input_stride) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .inputStride(28)
+    .outputChannels(19)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(FULLY_CONNECTED_F32, small_batch_with_output_stride) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .outputStride(29)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(FULLY_CONNECTED_F32, small_batch_with_lazy_packing) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .testF32();
+}
+
+TEST(FULLY_CONNECTED_F16, unit_batch) {
+  FullyConnectedTester()
+    .batchSize(1)
+    .inputChannels(23)
+    .outputChannels(19)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(FULLY_CONNECTED_F16, small_batch) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(FULLY_CONNECTED_F16, small_batch_with_qmin) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmin(128)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(FULLY_CONNECTED_F16, small_batch_with_qmax) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .qmax(128)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(FULLY_CONNECTED_F16, small_batch_with_input_stride) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .inputStride(28)
+    .outputChannels(19)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(FULLY_CONNECTED_F16, small_batch_with_output_stride) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .outputStride(29)
+    .iterations(3)
+    .testF16();
+}
+
+TEST(FULLY_CONNECTED_F16, small_batch_with_lazy_packing) {
+  FullyConnectedTester()
+    .batchSize(12)
+    .inputChannels(23)
+    .outputChannels(19)
+    .flags(QNNP_CREATE_FLAG_LAZY_PACKING)
+    .iterations(3)
+    .testF16();
+}
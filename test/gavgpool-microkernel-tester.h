@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <qnnpack/params.h>
+#include <qnnpack/requantization.h>
+
+
+class GAvgPoolMicrokernelTester {
+ public:
+  inline GAvgPoolMicrokernelTester& m(size_t m) {
+    assert(m != 0);
+    this->m_ = m;
+    return *this;
+  }
+
+  inline size_t m() const {
+    return this->m_;
+  }
+
+  inline GAvgPoolMicrokernelTester& n(size_t n) {
+    assert(n != 0);
+    this->n_ = n;
+    return *this;
+  }
+
+  inline size_t n() const {
+    return this->n_;
+  }
+
+  inline GAvgPoolMicrokernelTester& xStride(size_t xStride) {
+    assert(xStride != 0);
+    this->xStride_ = xStride;
+    return *this;
+  }
+
+  inline size_t xStride() const {
+    if (this->xStride_ == 0) {
+      return n();
+    } else {
+      assert(this->xStride_ >= n());
+      return this->xStride_;
+    }
+  }
+
+  inline GAvgPoolMicrokernelTester& xScale(float xScale) {
+    assert(xScale > 0.0f);
+    assert(std::isnormal(xScale));
+    this->xScale_ = xScale;
+    return *this;
+  }
+
+  inline float xScale() const {
+    return this->xScale_;
+  }
+
+  inline GAvgPoolMicrokernelTester& xZeroPoint(uint8_t xZeroPoint) {
+    this->xZeroPoint_ = xZeroPoint;
+    return *this;
+  }
+
+  inline uint8_t xZeroPoint() const {
+    return this->xZeroPoint_;
+  }
+
+  inline GAvgPoolMicrokernelTester& yScale(float yScale) {
+    assert(yScale > 0.0f);
+    assert(std::isnormal(yScale));
+    this->yScale_ = yScale;
+    return *this;
+  }
+
+  inline float yScale() const {
+    return this->yScale_;
+  }
+
+  inline GAvgPoolMicrokernelTester& yZeroPoint(uint8_t yZeroPoint) {
+    this->yZeroPoint_ = yZeroPoint;
+    return *this;
+  }
+
+  inline uint8_t yZeroPoint() const {
+    return this->yZeroPoint_;
+  }
+
+  inline GAvgPoolMicrokernelTester& qmin(uint8_t qmin) {
+    this->qmin_ = qmin;
+    return *this;
+  }
+
+  inline uint8_t qmin() const {
+    return this->qmin_;
+  }
+
+  inline GAvgPoolMicrokernelTester& qmax(uint8_t qmax) {
+    this->qmax_ = qmax;
+    return *this;
+  }
+
+  inline uint8_t qmax() const {
+    return this->qmax_;
+  }
+
+  inline GAvgPoolMicrokernelTester& iterations(size_t iterations) {
+    this->iterations_ = iterations;
+    return *this;
+  }
+
+  inline size_t iterations() const {
+    return this->iterations_;
+  }
+
+  void test(q8gavgpool_ukernel_function q8gavgpool) const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    std::vector<uint8_t> x((m() - 1) * xStride() + n());
+    std::vector<uint8_t> y(n());
+    std::vector<float> yFP(n());
+    std::vector<uint8_t> yRef(n());
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(x.begin(), x.end(), std::ref(u8rng));
+      std::fill(y.begin(), y.end(), 0xA5);
+
+      /* Prepare quantization parameters */
+      const float scale = xScale() / (yScale() * float(m()));
+      const int32_t bias = -int32_t(m()) * int32_t(xZeroPoint());
+      const union qnnp_q31_requantization_params requantizationParams =
+        qnnp_compute_requantization_params(scale, yZeroPoint(), qmin(), qmax());
+      const union qnnp_q31_requantization_params scalarRequantizationParams =
+        qnnp_compute_scalar_requantization_params(scale, yZeroPoint(), qmin(), qmax());
+
+      /* Compute reference results */
+      for (size_t j = 0; j < n(); j++) {
+        int32_t acc = bias;
+        for (size_t i = 0; i < m(); i++) {
+          acc += int32_t(x[i * xStride() + j]);
+        }
+        yRef[j] = qnnp_q31_requantize(acc, scalarRequantizationParams);
+        yFP[j] = std::min<float>(std::max<float>(float(acc) * scale + float(yZeroPoint()), float(qmin())), float(qmax()));
+      }
+
+      /* Call optimized micro-kernel */
+      q8gavgpool(m(), n(), x.data(), xStride() * sizeof(uint8_t), bias, y.data(), &requantizationParams);
+
+      /* Verify results */
+      for (size_t j = 0; j < n(); j++) {
+        ASSERT_LE(uint32_t(y[j]), uint32_t(qmax()))
+          << "at position " << j << ", m = " << m() << ", n = " << n();
+        ASSERT_GE(uint32_t(y[j]), uint32_t(qmin()))
+          << "at position " << j << ", m = " << m() << ", n = " << n();
+        /* Q31 requantization rounds twice, first to 31 fractional bits and then to an integer */
+        ASSERT_NEAR(float(int32_t(y[j])), yFP[j], 1.0f)
+          << "at position " << j << ", m = " << m() << ", n = " << n();
+        ASSERT_EQ(uint32_t(yRef[j]), uint32_t(y[j]))
+          << "at position " << j << ", m = " << m() << ", n = " << n();
+      }
+    }
+  }
+
+ private:
+  size_t m_{1};
+  size_t n_{1};
+  size_t xStride_{0};
+  float xScale_{1.25f};
+  float yScale_{1.75f};
+  uint8_t xZeroPoint_{121};
+  uint8_t yZeroPoint_{133};
+  uint8_t qmin_{0};
+  uint8_t qmax_{255};
+  size_t iterations_{15};
+};
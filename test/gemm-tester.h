@@ -10,6 +10,7 @@
 
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 
 #include <algorithm>
 #include <cfloat>
@@ -20,11 +21,14 @@
 
 #include <cpuinfo.h>
 #include <qnnpack/AlignedAllocator.h>
+#include <qnnpack/pack.h>
 #include <qnnpack/params.h>
+#include <qnnpack/hconv.h>
 #include <qnnpack/q8gemm.h>
 #include <qnnpack/q8conv.h>
 #include <qnnpack/scalar-utils.h>
 #include <qnnpack/requantization.h>
+#include <qnnpack/sconv.h>
 #include <qnnpack/sgemm.h>
 
 #include <fp16.h>
@@ -152,6 +156,68 @@ class GemmTester {
     return this->qmax_;
   }
 
+  /*
+   * Tests microkernels for signed packed weights: the kernel zero point is 128, and B and the bias are converted as
+   * for QNNP_CONVOLUTION_FLAG_SIGNED_KERNEL before calling the microkernel.
+   */
+  inline GemmTester& signedKernel(bool signedKernel) {
+    this->signedKernel_ = signedKernel;
+    return *this;
+  }
+
+  inline bool signedKernel() const {
+    return this->signedKernel_;
+  }
+
+  /* Tests microkernels with FP32 requantization, see QNNP_CREATE_FLAG_FP32_REQUANTIZATION */
+  inline GemmTester& fp32Requantization(bool fp32Requantization) {
+    this->fp32Requantization_ = fp32Requantization;
+    return *this;
+  }
+
+  inline bool fp32Requantization() const {
+    return this->fp32Requantization_;
+  }
+
+  /*
+   * Tests microkernels for biases with the input zero point folded in: the bias is folded as for
+   * QNNP_CONVOLUTION_FLAG_FOLDED_ZERO_POINT before calling the microkernel.
+   */
+  inline GemmTester& foldedZeroPoint(bool foldedZeroPoint) {
+    this->foldedZeroPoint_ = foldedZeroPoint;
+    return *this;
+  }
+
+  inline bool foldedZeroPoint() const {
+    return this->foldedZeroPoint_;
+  }
+
+  /*
+   * Tests microkernels with 16-bit accumulators, see QNNP_CONVOLUTION_FLAG_ACC16: B is close enough to its zero point
+   * that the dot product of every column with any A fits into int16_t.
+   */
+  inline GemmTester& acc16(bool acc16) {
+    this->acc16_ = acc16;
+    return *this;
+  }
+
+  inline bool acc16() const {
+    return this->acc16_;
+  }
+
+  /*
+   * Tests microkernels for 4-bit packed weights, see QNNP_CONVOLUTION_FLAG_4BIT: B is in [0, 15] with zero point 7,
+   * and is packed with two values per byte before calling the microkernel.
+   */
+  inline GemmTester& fourBitKernel(bool fourBitKernel) {
+    this->fourBitKernel_ = fourBitKernel;
+    return *this;
+  }
+
+  inline bool fourBitKernel() const {
+    return this->fourBitKernel_;
+  }
+
   inline GemmTester& iterations(size_t iterations) {
     this->iterations_ = iterations;
     return *this;
@@ -172,7 +238,15 @@ class GemmTester {
     auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
 
     const uint8_t aZeroPoint = 127;
-    const uint8_t bZeroPoint = 127;
+    const uint8_t bZeroPoint = signedKernel() ? 128 : fourBitKernel() ? 7 : 127;
+    /* A is at most 128 from its zero point, so deviations of B up to 255 / K keep dot products within int16_t */
+    const int32_t bMaxDeviation = acc16() ? std::max<int32_t>(std::min<int32_t>(255 / int32_t(k()), 127), 1) : 0;
+    auto b16rng = std::bind(
+      std::uniform_int_distribution<int32_t>(bZeroPoint - bMaxDeviation, bZeroPoint + bMaxDeviation), rng);
+    auto u4rng = std::bind(std::uniform_int_distribution<int32_t>(0, 15), rng);
+    if (acc16()) {
+      ASSERT_LE(k(), 255);
+    }
 
     std::vector<uint8_t> a((m() - 1) * aStride() + k() + 8);
     std::vector<uint8_t> b(n() * k());
@@ -186,7 +260,13 @@ class GemmTester {
 
     for (size_t iteration = 0; iteration < iterations(); iteration++) {
       std::generate(a.begin(), a.end(), std::ref(u8rng));
-      std::generate(b.begin(), b.end(), std::ref(u8rng));
+      if (acc16()) {
+        std::generate(b.begin(), b.end(), [&] { return uint8_t(b16rng()); });
+      } else if (fourBitKernel()) {
+        std::generate(b.begin(), b.end(), [&] { return uint8_t(u4rng()); });
+      } else {
+        std::generate(b.begin(), b.end(), std::ref(u8rng));
+      }
       std::generate(bias.begin(), bias.end(), std::ref(s32rng));
       std::fill(c.begin(), c.end(), 0xA5);
 
@@ -211,6 +291,9 @@ class GemmTester {
                   (int32_t(packedB[kBlockStart * packedN() + nIndex * kr() + kBlockOffset]) - int32_t(bZeroPoint));
             }
           }
+          if (acc16()) {
+            ASSERT_LE(std::abs(acc[mIndex * n() + nIndex]), INT16_MAX);
+          }
           acc[mIndex * n() + nIndex] += bias[nIndex];
         }
       }
@@ -236,16 +319,32 @@ class GemmTester {
         qnnp_compute_scalar_requantization_params(
           requantizationScale, cZeroPoint, qmin(), qmax());
 
+      std::vector<uint8_t, AlignedAllocator<uint8_t, 32>> kernelB(packedB);
+      std::vector<int32_t> kernelBias(bias);
+      if (signedKernel()) {
+        convertToSignedKernel(aZeroPoint, kernelB, kernelBias);
+      }
+      if (foldedZeroPoint()) {
+        ASSERT_EQ(np(), nr());
+        fold_q8conv_input_zero_point(
+          kernelB.size(), nr(), kr(), aZeroPoint, bZeroPoint, kernelB.data(), kernelBias.data());
+      }
+      if (fourBitKernel()) {
+        convertToFourBitKernel(kernelB);
+      }
+
       qgemm(
         m(), n(), k(),
         aPtr, aStride() * sizeof(uint8_t),
-        packedB.data(), bias.data(),
+        kernelB.data(), kernelBias.data(),
         c.data(), cStride() * sizeof(uint8_t),
         aZeroPoint, bZeroPoint, &requantizationParams);
 
       for (size_t mIndex = 0; mIndex < m(); mIndex++) {
         for (size_t nIndex = 0; nIndex < n(); nIndex++) {
-          cRef[mIndex * n() + nIndex] = qnnp_q31_requantize(acc[mIndex * n() + nIndex], scalarRequantizationParams);
+          cRef[mIndex * n() + nIndex] = fp32Requantization() ?
+            qnnp_fp32_requantize(acc[mIndex * n() + nIndex], scalarRequantizationParams) :
+            qnnp_q31_requantize(acc[mIndex * n() + nIndex], scalarRequantizationParams);
         }
       }
 
@@ -264,7 +363,68 @@ class GemmTester {
     }
   }
 
-  void testMicroKernel(q8conv_ukernel_function qconv) const {
+  void testMicroKernel(q8gemm_acc32_ukernel_function qgemm) const {
+    ASSERT_LE(m(), mr());
+    ASSERT_LE(n(), nr());
+    ASSERT_GE(k(), kr());
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    const uint8_t aZeroPoint = 127;
+    const uint8_t bZeroPoint = 127;
+
+    std::vector<uint8_t> a((m() - 1) * aStride() + k() + 8);
+    std::vector<uint8_t> b(n() * k());
+    std::vector<uint8_t, AlignedAllocator<uint8_t, 32>> packedB(packedN() * packedK());
+    std::vector<int32_t> c((m() - 1) * cStride() + n());
+    std::vector<int32_t> acc(m() * n());
+
+    const uint8_t* aPtr = a.data() + 8;
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(a.begin(), a.end(), std::ref(u8rng));
+      std::generate(b.begin(), b.end(), std::ref(u8rng));
+      std::fill(c.begin(), c.end(), 0xA5A5A5A5);
+
+      std::fill(packedB.begin(), packedB.end(), bZeroPoint);
+      pack_q8gemm_b(n(), k(), np(), kr(), b.data(), k(), packedB.data());
+
+      ASSERT_NE(*std::max_element(a.cbegin(), a.cend()), *std::min_element(a.cbegin(), a.cend()));
+      ASSERT_NE(*std::max_element(b.cbegin(), b.cend()), *std::min_element(b.cbegin(), b.cend()));
+
+      std::fill(acc.begin(), acc.end(), 0);
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          for (size_t kBlockStart = 0; kBlockStart < k(); kBlockStart += kr()) {
+            for (size_t kBlockOffset = 0; kBlockOffset < std::min(k() - kBlockStart, kr()); kBlockOffset++) {
+              acc[mIndex * n() + nIndex] +=
+                  (int32_t(aPtr[mIndex * aStride() + kBlockStart + kBlockOffset]) - int32_t(aZeroPoint)) *
+                  (int32_t(packedB[kBlockStart * packedN() + nIndex * kr() + kBlockOffset]) - int32_t(bZeroPoint));
+            }
+          }
+        }
+      }
+
+      qgemm(
+        m(), n(), k(),
+        aPtr, aStride() * sizeof(uint8_t),
+        packedB.data(),
+        c.data(), cStride() * sizeof(int32_t),
+        aZeroPoint, bZeroPoint);
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          ASSERT_EQ(c[mIndex * cStride() + nIndex], acc[mIndex * n() + nIndex])
+              << "at " << mIndex << ", " << nIndex << ", Mr x Nr x Kr = " << mr() << " x "
+              << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n() << " x " << k();
+        }
+      }
+    }
+  }
+
+  void testMicroKernel(q8gemm_sparse_ukernel_function qgemm) const {
     ASSERT_LE(m(), mr());
     ASSERT_LE(n(), nr());
     ASSERT_GE(k(), kr());
@@ -277,6 +437,108 @@ class GemmTester {
     const uint8_t aZeroPoint = 127;
     const uint8_t bZeroPoint = 127;
 
+    /* No padding past K: the last block of a row ends at K, so reading past it is a sanitizer error */
+    std::vector<uint8_t> a((m() - 1) * aStride() + k());
+    std::vector<uint8_t> b(n() * k());
+    std::vector<int32_t> bias(nr());
+    std::vector<uint8_t> c((m() - 1) * cStride() + n());
+    std::vector<int32_t> acc(m() * n());
+    std::vector<uint8_t> cRef(m() * n());
+
+    const uint8_t* aPtr = a.data();
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(a.begin(), a.end(), std::ref(u8rng));
+      std::generate(b.begin(), b.end(), std::ref(u8rng));
+      /* Prune about half of the blocks */
+      for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+        for (size_t kBlockStart = 0; kBlockStart < k(); kBlockStart += kr()) {
+          if (u8rng() & 1) {
+            std::fill_n(&b[nIndex * k() + kBlockStart], std::min(k() - kBlockStart, kr()), bZeroPoint);
+          }
+        }
+      }
+      std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+      std::fill(c.begin(), c.end(), 0xA5);
+
+      const size_t blocks = count_q8gemm_sparse_blocks(n(), k(), kr(), bZeroPoint, b.data());
+      std::vector<uint8_t, AlignedAllocator<uint8_t, 32>> packedB(
+          sizeof(uint32_t) * (nr() + 1 + blocks) + kr() * blocks);
+      pack_q8gemm_sparse_w(n(), k(), nr(), kr(), bZeroPoint, b.data(), packedB.data());
+      const uint32_t* rowPtr = reinterpret_cast<const uint32_t*>(packedB.data());
+      const uint32_t* blockChannels = rowPtr + nr() + 1;
+      const uint8_t* values = reinterpret_cast<const uint8_t*>(blockChannels + blocks);
+
+      /* Compute 32-bit results and output quantization arguments */
+      std::fill(acc.begin(), acc.end(), 0);
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          for (size_t kIndex = 0; kIndex < k(); kIndex++) {
+            acc[mIndex * n() + nIndex] +=
+                (int32_t(aPtr[mIndex * aStride() + kIndex]) - int32_t(aZeroPoint)) *
+                (int32_t(b[nIndex * k() + kIndex]) - int32_t(bZeroPoint));
+          }
+          acc[mIndex * n() + nIndex] += bias[nIndex];
+        }
+      }
+
+      const int32_t accMin = *std::min_element(acc.cbegin(), acc.cend());
+      const int32_t accMax = *std::max_element(acc.cbegin(), acc.cend());
+
+      const double cScale = uint32_t(accMax - accMin) >= 256 ? double(uint32_t(accMax - accMin)) / 255.0 : 1.00001;
+      const uint8_t cZeroPoint = uint8_t(std::max(std::min(
+        lrint(127.5 - 0.5 * double(accMin + accMax) / cScale),
+        long(std::numeric_limits<uint8_t>::max())), long(std::numeric_limits<uint8_t>::min())));
+
+      const float requantizationScale = 1.0f / float(cScale);
+      const union qnnp_q31_requantization_params requantizationParams =
+        qnnp_compute_requantization_params(
+          requantizationScale, cZeroPoint, qmin(), qmax());
+      const union qnnp_q31_requantization_params scalarRequantizationParams =
+        qnnp_compute_scalar_requantization_params(
+          requantizationScale, cZeroPoint, qmin(), qmax());
+
+      qgemm(
+        m(), n(),
+        aPtr, aStride() * sizeof(uint8_t),
+        rowPtr, blockChannels, values, bias.data(),
+        c.data(), cStride() * sizeof(uint8_t),
+        aZeroPoint, bZeroPoint, &requantizationParams);
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          cRef[mIndex * n() + nIndex] = qnnp_q31_requantize(acc[mIndex * n() + nIndex], scalarRequantizationParams);
+        }
+      }
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          ASSERT_LE(uint32_t(c[mIndex * cStride() + nIndex]), uint32_t(qmax()));
+          ASSERT_GE(uint32_t(c[mIndex * cStride() + nIndex]), uint32_t(qmin()));
+          ASSERT_EQ(uint32_t(c[mIndex * cStride() + nIndex]), uint32_t(cRef[mIndex * n() + nIndex]))
+              << "at " << mIndex << ", " << nIndex << ": reference = " << (uint32_t) cRef[mIndex * n() + nIndex]
+              << " (accumulator = " << acc[mIndex * n() + nIndex]
+              << "), optimized = " << (uint32_t) c[mIndex * cStride() + nIndex] << ", Mr x Nr x Kr = " << mr() << " x "
+              << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n() << " x " << k()
+              << ", blocks = " << blocks;
+        }
+      }
+    }
+  }
+
+  void testMicroKernel(q8conv_ukernel_function qconv) const {
+    ASSERT_LE(m(), mr());
+    ASSERT_LE(n(), nr());
+    ASSERT_GE(k(), kr());
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    const uint8_t aZeroPoint = 127;
+    const uint8_t bZeroPoint = signedKernel() ? 128 : 127;
+
     std::vector<uint8_t> a((mr() - 1) * aStride() + k() + 8);
     std::vector<uint8_t> b(n() * ks() * k());
     std::vector<uint8_t, AlignedAllocator<uint8_t, 32>> packedB(packedN() * ks() * packedK());
@@ -322,11 +584,11 @@ class GemmTester {
                 ASSERT_LT(ksIndex * mr() + mIndex, im2col.size());
                 ASSERT_LT(kBlockStart + kBlockOffset, k());
                 ASSERT_LT(kBlockStart + kBlockOffset, aStride());
-                ASSERT_LT(kBlockStart * ks() * packedN() + (ksIndex * nr() + nIndex) * kr() + kBlockOffset, packedB.size());
+                ASSERT_LT(ksIndex * packedN() * packedK() + kBlockStart * packedN() + nIndex * kr() + kBlockOffset, packedB.size());
 
                 acc[mIndex * n() + nIndex] +=
                   (int32_t(im2col[ksIndex * mr() + mIndex][kBlockStart + kBlockOffset]) - int32_t(aZeroPoint)) *
-                  (int32_t(packedB[kBlockStart * ks() * packedN() + (ksIndex * nr() + nIndex) * kr() + kBlockOffset]) - int32_t(bZeroPoint));
+                  (int32_t(packedB[ksIndex * packedN() * packedK() + kBlockStart * packedN() + nIndex * kr() + kBlockOffset]) - int32_t(bZeroPoint));
               }
             }
           }
@@ -355,15 +617,28 @@ class GemmTester {
         qnnp_compute_scalar_requantization_params(
           requantizationScale, cZeroPoint, qmin(), qmax());
 
+      std::vector<uint8_t, AlignedAllocator<uint8_t, 32>> kernelB(packedB);
+      std::vector<int32_t> kernelBias(bias);
+      if (signedKernel()) {
+        convertToSignedKernel(aZeroPoint, kernelB, kernelBias);
+      }
+      if (foldedZeroPoint()) {
+        ASSERT_EQ(np(), nr());
+        fold_q8conv_input_zero_point(
+          kernelB.size(), nr(), kr(), aZeroPoint, bZeroPoint, kernelB.data(), kernelBias.data());
+      }
+
       qconv(
         m(), n(), k(), ks(),
-        im2col.data(), packedB.data(), bias.data(),
+        im2col.data(), kernelB.data(), kernelBias.data(),
         c.data(), cStride() * sizeof(uint8_t),
         aZeroPoint, bZeroPoint, &requantizationParams);
 
       for (size_t mIndex = 0; mIndex < m(); mIndex++) {
         for (size_t nIndex = 0; nIndex < n(); nIndex++) {
-          cRef[mIndex * n() + nIndex] = qnnp_q31_requantize(acc[mIndex * n() + nIndex], scalarRequantizationParams);
+          cRef[mIndex * n() + nIndex] = fp32Requantization() ?
+            qnnp_fp32_requantize(acc[mIndex * n() + nIndex], scalarRequantizationParams) :
+            qnnp_q31_requantize(acc[mIndex * n() + nIndex], scalarRequantizationParams);
         }
       }
 
@@ -382,6 +657,117 @@ class GemmTester {
     }
   }
 
+  /*
+   * Tests a convolution microkernel with per-output-channel requantization, which reads nr() FP32 scales after the
+   * nr() biases.
+   */
+  void testPerChannelMicroKernel(q8conv_ukernel_function qconv) const {
+    ASSERT_LE(m(), mr());
+    ASSERT_LE(n(), nr());
+    ASSERT_GE(k(), kr());
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+    auto scaleRng = std::bind(std::uniform_real_distribution<float>(0.5f, 1.0f), rng);
+
+    const uint8_t aZeroPoint = 127;
+    const uint8_t bZeroPoint = 127;
+
+    std::vector<uint8_t> a((mr() - 1) * aStride() + k() + 8);
+    std::vector<uint8_t> b(n() * ks() * k());
+    std::vector<uint8_t, AlignedAllocator<uint8_t, 32>> packedB(packedN() * ks() * packedK());
+    std::vector<int32_t> biasAndScales(2 * nr());
+    std::vector<float> scales(nr());
+    std::vector<uint8_t> c((m() - 1) * cStride() + n());
+    std::vector<int32_t> acc(m() * n());
+    std::vector<uint8_t> cRef(m() * n());
+    std::vector<const uint8_t*> im2col(mr() * ks());
+
+    const uint8_t* aPtr = a.data() + 8;
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(a.begin(), a.end(), std::ref(u8rng));
+      std::generate(b.begin(), b.end(), std::ref(u8rng));
+      std::generate(biasAndScales.begin(), biasAndScales.begin() + nr(), std::ref(s32rng));
+      std::fill(c.begin(), c.end(), 0xA5);
+
+      std::fill(packedB.begin(), packedB.end(), bZeroPoint);
+      pack_q8conv_b(n(), ks(), k(), np(), kr(), b.data(), packedB.data());
+
+      for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+        for (size_t mIndex = 0; mIndex < mr(); mIndex++) {
+          im2col[ksIndex * mr() + mIndex] = aPtr + aStride() * mIndex;
+        }
+      }
+      std::shuffle(im2col.begin(), im2col.end(), rng);
+      for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+        for (size_t mIndex = m(); mIndex < mr(); mIndex++) {
+          im2col[ksIndex * mr() + mIndex] = im2col[ksIndex * mr() + m() - 1];
+        }
+      }
+
+      std::fill(acc.begin(), acc.end(), 0);
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+            for (size_t kBlockStart = 0; kBlockStart < k(); kBlockStart += kr()) {
+              for (size_t kBlockOffset = 0; kBlockOffset < std::min(k() - kBlockStart, kr()); kBlockOffset++) {
+                acc[mIndex * n() + nIndex] +=
+                  (int32_t(im2col[ksIndex * mr() + mIndex][kBlockStart + kBlockOffset]) - int32_t(aZeroPoint)) *
+                  (int32_t(packedB[ksIndex * np() * packedK() + kBlockStart * np() + nIndex * kr() + kBlockOffset]) - int32_t(bZeroPoint));
+              }
+            }
+          }
+          acc[mIndex * n() + nIndex] += biasAndScales[nIndex];
+        }
+      }
+
+      const int32_t accMin = *std::min_element(acc.cbegin(), acc.cend());
+      const int32_t accMax = *std::max_element(acc.cbegin(), acc.cend());
+      const double cScale = uint32_t(accMax - accMin) >= 256 ? double(uint32_t(accMax - accMin)) / 255.0 : 1.00001;
+      const uint8_t cZeroPoint = uint8_t(std::max(std::min(
+        lrint(127.5 - 0.5 * double(accMin + accMax) / cScale),
+        long(std::numeric_limits<uint8_t>::max())), long(std::numeric_limits<uint8_t>::min())));
+
+      /* Channels get different scales up to the scale that maps the accumulator range to the output range */
+      const float requantizationScale = 1.0f / float(cScale);
+      for (size_t nIndex = 0; nIndex < nr(); nIndex++) {
+        scales[nIndex] = requantizationScale * scaleRng();
+      }
+      memcpy(biasAndScales.data() + nr(), scales.data(), nr() * sizeof(float));
+      const union qnnp_q31_requantization_params requantizationParams =
+        qnnp_compute_requantization_params(
+          requantizationScale, cZeroPoint, qmin(), qmax());
+
+      qconv(
+        m(), n(), k(), ks(),
+        im2col.data(), packedB.data(), biasAndScales.data(),
+        c.data(), cStride() * sizeof(uint8_t),
+        aZeroPoint, bZeroPoint, &requantizationParams);
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          const float scaledAcc = float(acc[mIndex * n() + nIndex]) * scales[nIndex];
+          const long output = lrintf(scaledAcc) + long(cZeroPoint);
+          cRef[mIndex * n() + nIndex] = uint8_t(std::max(std::min(output, long(qmax())), long(qmin())));
+        }
+      }
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          ASSERT_EQ(uint32_t(c[mIndex * cStride() + nIndex]), uint32_t(cRef[mIndex * n() + nIndex]))
+              << "at " << mIndex << ", " << nIndex << ": reference = " << uint32_t(cRef[mIndex * n() + nIndex])
+              << " (accumulator = " << acc[mIndex * n() + nIndex] << ", scale = " << scales[nIndex]
+              << "), optimized = " << uint32_t(c[mIndex * cStride() + nIndex]) << ", Mr x Nr x Kr = " << mr() << " x "
+              << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n() << " x " << k()
+              << ", output zero point = " << int32_t(cZeroPoint);
+        }
+      }
+    }
+  }
+
   void pack_sgemm_b(size_t n, size_t k, size_t np, size_t kr, const float* b, size_t b_stride, float* packed_b) const
   {
     const size_t k_stride = (k + (kr - 1)) & -kr;
@@ -555,94 +941,235 @@ class GemmTester {
       std::fill(c.begin(), c.end(), 0xA5);
       std::fill(cAcc.begin(), cAcc.end(), 0);
 
-      ASSERT_NE(*std::max_element(a.cbegin(), a.cend()), *std::min_element(a.cbegin(), a.cend()));
-      ASSERT_NE(*std::max_element(b.cbegin(), b.cend()), *std::min_element(b.cbegin(), b.cend()));
+      ASSERT_NE(*std::max_element(a.cbegin(), a.cend()), *std::min_element(a.cbegin(), a.cend()));
+      ASSERT_NE(*std::max_element(b.cbegin(), b.cend()), *std::min_element(b.cbegin(), b.cend()));
+
+      /* compute row sums of a and b */
+      q8gemm_compute_row_sum(aPtr, m(), k(), aStride(), -bZeroPoint, as.data(), q8sum_rows);
+      q8gemm_compute_row_sum(b.data(), n(), k(), k(), -aZeroPoint, biasBuf.data(), q8sum_rows);
+      const int32_t zeropoint_product = k() * aZeroPoint * bZeroPoint;
+      for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+        biasBuf[nIndex] += bias[nIndex] + zeropoint_product;
+      }
+
+      /* Compute 32-bit results and output quantization arguments */
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          int32_t bAcc = 0;
+          for (size_t kBlockStart = 0; kBlockStart < k(); kBlockStart += kr()) {
+            for (size_t kBlockOffset = 0; kBlockOffset < std::min(k() - kBlockStart, kr()); kBlockOffset++) {
+              ASSERT_LE(n(), packedN());
+              ASSERT_LT(mIndex * n() + nIndex, cAcc.size());
+              ASSERT_LT(mIndex * k() + kBlockStart + kBlockOffset, a.size());
+              ASSERT_LT(kBlockStart * np() + nIndex * kr() + kBlockOffset, packedB.size());
+              if (nIndex == 0) {
+                asRef[mIndex] += (int32_t) aPtr[mIndex * aStride() + kBlockStart + kBlockOffset];
+              }
+              if (mIndex == 0) {
+                bAcc += (int32_t) b[nIndex * k() + kBlockStart + kBlockOffset];
+              }
+              cAcc[mIndex * n() + nIndex] +=
+                  ((int32_t) aPtr[mIndex * aStride() + kBlockStart + kBlockOffset] - (int32_t) aZeroPoint) *
+                  ((int32_t) b[nIndex * k() + kBlockStart + kBlockOffset] - (int32_t) bZeroPoint);
+            }
+          }
+          if (mIndex == 0) {
+            biasRef[nIndex] += bAcc * (-aZeroPoint) + k() * aZeroPoint * bZeroPoint;
+          }
+          cAcc[mIndex * n() + nIndex] += bias[nIndex];
+        }
+        asRef[mIndex] *= -bZeroPoint;
+      }
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        ASSERT_EQ(as[mIndex], asRef[mIndex])
+            << "at " << mIndex << ": reference = " << asRef[mIndex] << ", optimized = " << as[mIndex]
+            << ", Mr x Nr x Kr = " << mr() << " x " << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n()
+            << " x " << k();
+      }
+
+      for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+        ASSERT_EQ(biasBuf[nIndex], biasRef[nIndex])
+            << "at " << nIndex << ": reference = " << biasRef[nIndex] << ", optimized = " << biasBuf[nIndex]
+            << ", Mr x Nr x Kr = " << mr() << " x " << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n()
+            << " x " << k();
+      }
+
+      const int32_t accMin = *std::min_element(cAcc.cbegin(), cAcc.cend());
+      const int32_t accMax = *std::max_element(cAcc.cbegin(), cAcc.cend());
+      if (m() * n() >= 3) {
+        ASSERT_NE(accMax, accMin) << "Mr x Nr x Kr = " << mr() << " x " << nr() << " x " << kr()
+                                  << ", M x N x K = " << m() << " x " << n() << " x " << k();
+      }
+
+      const double cScale = uint32_t(accMax - accMin) >= 256 ? double(uint32_t(accMax - accMin)) / 255.0 : 1.00001;
+      const uint8_t cZeroPoint = uint8_t(std::max(
+          std::min(lrint(127.5 - 0.5 * double(accMin + accMax) / cScale), long(std::numeric_limits<uint8_t>::max())),
+          long(std::numeric_limits<uint8_t>::min())));
+
+      const float requantizationScale = 1.0f / float(cScale);
+      const union qnnp_q31_requantization_params requantizationParams =
+          qnnp_compute_requantization_params(requantizationScale, cZeroPoint, qmin(), qmax());
+      const union qnnp_q31_requantization_params scalarRequantizationParams =
+          qnnp_compute_scalar_requantization_params(requantizationScale, cZeroPoint, qmin(), qmax());
+
+      qgemm(
+          m(),
+          n(),
+          k(),
+          aPtr,
+          aStride(),
+          packedB.data(),
+          biasBuf.data(),
+          c.data(),
+          cStride(),
+          as.data(),
+          &requantizationParams);
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          cRef[mIndex * n() + nIndex] = qnnp_q31_requantize(cAcc[mIndex * n() + nIndex], scalarRequantizationParams);
+        }
+      }
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          ASSERT_LE(uint32_t(c[mIndex * cStride() + nIndex]), uint32_t(qmax()));
+          ASSERT_GE(uint32_t(c[mIndex * cStride() + nIndex]), uint32_t(qmin()));
+          ASSERT_EQ(c[mIndex * cStride() + nIndex], cRef[mIndex * n() + nIndex])
+              << "at " << mIndex << ", " << nIndex << ": reference = " << (uint32_t) cRef[mIndex * n() + nIndex]
+              << ", optimized = " << (uint32_t) c[mIndex * cStride() + nIndex] << ", Mr x Nr x Kr = " << mr() << " x "
+              << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n() << " x " << k();
+        }
+      }
+    }
+  }
+
+  /*
+   * Tests a convolution microkernel for XZP convolutions, see QNNP_CONVOLUTION_FLAG_XZP_CONV, with the sums of the
+   * indirection tile from q8conv_sum_rows and the bias folded as in packing.
+   */
+  void testMicroKernel(q8conv_xzp_ukernel_function qconv, q8conv_sum_rows_ukernel_function q8conv_sum_rows) const {
+    ASSERT_LE(m(), mr());
+    ASSERT_LE(n(), nr());
+    ASSERT_GE(k(), kr());
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    const uint8_t aZeroPoint = 127;
+    const uint8_t bZeroPoint = 127;
+
+    std::vector<uint8_t> a((mr() - 1) * aStride() + k() + 8);
+    std::vector<uint8_t> b(n() * ks() * k());
+    std::vector<uint8_t, AlignedAllocator<uint8_t, 32>> packedB(packedN() * ks() * packedK());
+    std::vector<int32_t> bias(nr());
+    std::vector<int32_t> xzpBias(nr());
+    std::vector<int32_t> aSum(mr());
+    std::vector<uint8_t> c((m() - 1) * cStride() + n());
+    std::vector<int32_t> acc(m() * n());
+    std::vector<uint8_t> cRef(m() * n());
+    std::vector<const uint8_t*> im2col(mr() * ks());
+
+    const uint8_t* aPtr = a.data() + 8;
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(a.begin(), a.end(), std::ref(u8rng));
+      std::generate(b.begin(), b.end(), std::ref(u8rng));
+      std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+      std::fill(c.begin(), c.end(), 0xA5);
+
+      std::fill(packedB.begin(), packedB.end(), 0);
+      pack_q8conv_b(n(), ks(), k(), np(), kr(), b.data(), packedB.data());
+
+      ASSERT_NE(*std::max_element(a.cbegin(), a.cend()), *std::min_element(a.cbegin(), a.cend()));
+      ASSERT_NE(*std::max_element(b.cbegin(), b.cend()), *std::min_element(b.cbegin(), b.cend()));
+
+      for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+        for (size_t mIndex = 0; mIndex < mr(); mIndex++) {
+          im2col[ksIndex * mr() + mIndex] = aPtr + aStride() * mIndex;
+        }
+      }
+      std::shuffle(im2col.begin(), im2col.end(), rng);
+      for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+        for (size_t mIndex = m(); mIndex < mr(); mIndex++) {
+          im2col[ksIndex * mr() + mIndex] = im2col[ksIndex * mr() + m() - 1];
+        }
+      }
+
+      /* The sums of all mr rows over the ks x k inputs are scaled by the negated kernel zero point */
+      std::fill(aSum.begin(), aSum.end(), 0xA5A5A5A5);
+      q8conv_sum_rows(k(), ks(), im2col.data(), -int32_t(bZeroPoint), aSum.data());
+      for (size_t mIndex = 0; mIndex < mr(); mIndex++) {
+        int32_t aSumRef = 0;
+        for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+          for (size_t kIndex = 0; kIndex < k(); kIndex++) {
+            aSumRef += int32_t(im2col[ksIndex * mr() + mIndex][kIndex]);
+          }
+        }
+        aSumRef *= -int32_t(bZeroPoint);
+        ASSERT_EQ(aSumRef, aSum[mIndex])
+            << "at " << mIndex << ": K x KS = " << k() << " x " << ks();
+      }
 
-      /* compute row sums of a and b */
-      q8gemm_compute_row_sum(aPtr, m(), k(), aStride(), -bZeroPoint, as.data(), q8sum_rows);
-      q8gemm_compute_row_sum(b.data(), n(), k(), k(), -aZeroPoint, biasBuf.data(), q8sum_rows);
-      const int32_t zeropoint_product = k() * aZeroPoint * bZeroPoint;
-      for (size_t nIndex = 0; nIndex < n(); nIndex++) {
-        biasBuf[nIndex] += bias[nIndex] + zeropoint_product;
+      for (size_t nIndex = 0; nIndex < nr(); nIndex++) {
+        int32_t bSum = 0;
+        for (size_t ksIndex = 0; nIndex < n() && ksIndex < ks(); ksIndex++) {
+          for (size_t kIndex = 0; kIndex < k(); kIndex++) {
+            bSum += int32_t(b[(nIndex * ks() + ksIndex) * k() + kIndex]);
+          }
+        }
+        xzpBias[nIndex] = bias[nIndex] + int32_t(ks() * k()) * int32_t(aZeroPoint) * int32_t(bZeroPoint) -
+          int32_t(aZeroPoint) * bSum;
       }
 
       /* Compute 32-bit results and output quantization arguments */
+      std::fill(acc.begin(), acc.end(), 0);
       for (size_t mIndex = 0; mIndex < m(); mIndex++) {
         for (size_t nIndex = 0; nIndex < n(); nIndex++) {
-          int32_t bAcc = 0;
-          for (size_t kBlockStart = 0; kBlockStart < k(); kBlockStart += kr()) {
-            for (size_t kBlockOffset = 0; kBlockOffset < std::min(k() - kBlockStart, kr()); kBlockOffset++) {
-              ASSERT_LE(n(), packedN());
-              ASSERT_LT(mIndex * n() + nIndex, cAcc.size());
-              ASSERT_LT(mIndex * k() + kBlockStart + kBlockOffset, a.size());
-              ASSERT_LT(kBlockStart * np() + nIndex * kr() + kBlockOffset, packedB.size());
-              if (nIndex == 0) {
-                asRef[mIndex] += (int32_t) aPtr[mIndex * aStride() + kBlockStart + kBlockOffset];
-              }
-              if (mIndex == 0) {
-                bAcc += (int32_t) b[nIndex * k() + kBlockStart + kBlockOffset];
-              }
-              cAcc[mIndex * n() + nIndex] +=
-                  ((int32_t) aPtr[mIndex * aStride() + kBlockStart + kBlockOffset] - (int32_t) aZeroPoint) *
-                  ((int32_t) b[nIndex * k() + kBlockStart + kBlockOffset] - (int32_t) bZeroPoint);
+          for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+            for (size_t kIndex = 0; kIndex < k(); kIndex++) {
+              acc[mIndex * n() + nIndex] +=
+                (int32_t(im2col[ksIndex * mr() + mIndex][kIndex]) - int32_t(aZeroPoint)) *
+                (int32_t(b[(nIndex * ks() + ksIndex) * k() + kIndex]) - int32_t(bZeroPoint));
             }
           }
-          if (mIndex == 0) {
-            biasRef[nIndex] += bAcc * (-aZeroPoint) + k() * aZeroPoint * bZeroPoint;
-          }
-          cAcc[mIndex * n() + nIndex] += bias[nIndex];
+          acc[mIndex * n() + nIndex] += bias[nIndex];
         }
-        asRef[mIndex] *= -bZeroPoint;
       }
 
-      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
-        ASSERT_EQ(as[mIndex], asRef[mIndex])
-            << "at " << mIndex << ": reference = " << asRef[mIndex] << ", optimized = " << as[mIndex]
-            << ", Mr x Nr x Kr = " << mr() << " x " << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n()
-            << " x " << k();
-      }
-
-      for (size_t nIndex = 0; nIndex < n(); nIndex++) {
-        ASSERT_EQ(biasBuf[nIndex], biasRef[nIndex])
-            << "at " << nIndex << ": reference = " << biasRef[nIndex] << ", optimized = " << biasBuf[nIndex]
-            << ", Mr x Nr x Kr = " << mr() << " x " << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n()
-            << " x " << k();
-      }
-
-      const int32_t accMin = *std::min_element(cAcc.cbegin(), cAcc.cend());
-      const int32_t accMax = *std::max_element(cAcc.cbegin(), cAcc.cend());
+      const int32_t accMin = *std::min_element(acc.cbegin(), acc.cend());
+      const int32_t accMax = *std::max_element(acc.cbegin(), acc.cend());
       if (m() * n() >= 3) {
-        ASSERT_NE(accMax, accMin) << "Mr x Nr x Kr = " << mr() << " x " << nr() << " x " << kr()
-                                  << ", M x N x K = " << m() << " x " << n() << " x " << k();
+        ASSERT_NE(accMax, accMin)
+            << "Mr x Nr x Kr = " << mr() << " x " << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n()
+            << " x " << k();
       }
 
       const double cScale = uint32_t(accMax - accMin) >= 256 ? double(uint32_t(accMax - accMin)) / 255.0 : 1.00001;
-      const uint8_t cZeroPoint = uint8_t(std::max(
-          std::min(lrint(127.5 - 0.5 * double(accMin + accMax) / cScale), long(std::numeric_limits<uint8_t>::max())),
-          long(std::numeric_limits<uint8_t>::min())));
+      const uint8_t cZeroPoint = uint8_t(std::max(std::min(
+        lrint(127.5 - 0.5 * double(accMin + accMax) / cScale),
+        long(std::numeric_limits<uint8_t>::max())), long(std::numeric_limits<uint8_t>::min())));
 
       const float requantizationScale = 1.0f / float(cScale);
       const union qnnp_q31_requantization_params requantizationParams =
-          qnnp_compute_requantization_params(requantizationScale, cZeroPoint, qmin(), qmax());
+        qnnp_compute_requantization_params(
+          requantizationScale, cZeroPoint, qmin(), qmax());
       const union qnnp_q31_requantization_params scalarRequantizationParams =
-          qnnp_compute_scalar_requantization_params(requantizationScale, cZeroPoint, qmin(), qmax());
+        qnnp_compute_scalar_requantization_params(
+          requantizationScale, cZeroPoint, qmin(), qmax());
 
-      qgemm(
-          m(),
-          n(),
-          k(),
-          aPtr,
-          aStride(),
-          packedB.data(),
-          biasBuf.data(),
-          c.data(),
-          cStride(),
-          as.data(),
-          &requantizationParams);
+      qconv(
+        m(), n(), k(), ks(),
+        im2col.data(), packedB.data(), xzpBias.data(),
+        c.data(), cStride() * sizeof(uint8_t),
+        aSum.data(), &requantizationParams);
 
       for (size_t mIndex = 0; mIndex < m(); mIndex++) {
         for (size_t nIndex = 0; nIndex < n(); nIndex++) {
-          cRef[mIndex * n() + nIndex] = qnnp_q31_requantize(cAcc[mIndex * n() + nIndex], scalarRequantizationParams);
+          cRef[mIndex * n() + nIndex] = qnnp_q31_requantize(acc[mIndex * n() + nIndex], scalarRequantizationParams);
         }
       }
 
@@ -650,9 +1177,10 @@ class GemmTester {
         for (size_t nIndex = 0; nIndex < n(); nIndex++) {
           ASSERT_LE(uint32_t(c[mIndex * cStride() + nIndex]), uint32_t(qmax()));
           ASSERT_GE(uint32_t(c[mIndex * cStride() + nIndex]), uint32_t(qmin()));
-          ASSERT_EQ(c[mIndex * cStride() + nIndex], cRef[mIndex * n() + nIndex])
-              << "at " << mIndex << ", " << nIndex << ": reference = " << (uint32_t) cRef[mIndex * n() + nIndex]
-              << ", optimized = " << (uint32_t) c[mIndex * cStride() + nIndex] << ", Mr x Nr x Kr = " << mr() << " x "
+          ASSERT_EQ(uint32_t(c[mIndex * cStride() + nIndex]), uint32_t(cRef[mIndex * n() + nIndex]))
+              << "at " << mIndex << ", " << nIndex << ": reference = " << uint32_t(cRef[mIndex * n() + nIndex])
+              << " (accumulator = " << acc[mIndex * n() + nIndex]
+              << "), optimized = " << uint32_t(c[mIndex * cStride() + nIndex]) << ", Mr x Nr x Kr = " << mr() << " x "
               << nr() << " x " << kr() << ", M x N x K = " << m() << " x " << n() << " x " << k();
         }
       }
@@ -857,7 +1385,230 @@ class GemmTester {
     }
   }
 
+  void testMicroKernel(sconv_ukernel_function sconv) const {
+    ASSERT_LE(m(), mr());
+    ASSERT_LE(n(), nr());
+    ASSERT_EQ(1, kr());
+    ASSERT_GE(aStride(), k());
+    ASSERT_GE(cStride(), n());
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto f32rng = std::bind(std::uniform_real_distribution<float>(), rng);
+
+    std::vector<float> a((mr() - 1) * aStride() + k());
+    std::vector<float> b(n() * ks() * k());
+    std::vector<float, AlignedAllocator<float, 32>> packedB(packedN() * ks() * k());
+    std::vector<float> bias(nr());
+    std::vector<float> c((mr() - 1) * cStride() + nr());
+    std::vector<float> cRef(m() * n());
+    std::vector<const float*> im2col(mr() * ks());
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(a.begin(), a.end(), std::ref(f32rng));
+      std::generate(b.begin(), b.end(), std::ref(f32rng));
+      std::generate(bias.begin(), bias.end(), std::ref(f32rng));
+      std::fill(c.begin(), c.end(), nanf(""));
+
+      std::fill(packedB.begin(), packedB.end(), 0.0f);
+      pack_sconv_b(n(), ks(), k(), np(), b.data(), packedB.data());
+
+      for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+        for (size_t mIndex = 0; mIndex < mr(); mIndex++) {
+          im2col[ksIndex * mr() + mIndex] = a.data() + aStride() * mIndex;
+        }
+      }
+      std::shuffle(im2col.begin(), im2col.end(), rng);
+      for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+        for (size_t mIndex = m(); mIndex < mr(); mIndex++) {
+          im2col[ksIndex * mr() + mIndex] = im2col[ksIndex * mr() + m() - 1];
+        }
+      }
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          float acc = bias[nIndex];
+          for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+            for (size_t kIndex = 0; kIndex < k(); kIndex++) {
+              acc += im2col[ksIndex * mr() + mIndex][kIndex] * b[(nIndex * ks() + ksIndex) * k() + kIndex];
+            }
+          }
+          cRef[mIndex * n() + nIndex] = acc;
+        }
+      }
+
+      const float accMin = *std::min_element(cRef.cbegin(), cRef.cend());
+      const float accMax = *std::max_element(cRef.cbegin(), cRef.cend());
+      const float cMin = accMin + (accMax - accMin) / 255.0f * float(qmin());
+      const float cMax = accMax - (accMax - accMin) / 255.0f * float(255 - qmax());
+      struct qnnp_fp32_clamping_params clampingParams = {
+        .max = cMax,
+        .min = cMin,
+      };
+      for (float& cValue : cRef) {
+        cValue = std::max(std::min(cValue, cMax), cMin);
+      }
+
+      sconv(
+        m(), n(), k(), ks(),
+        im2col.data(), packedB.data(), bias.data(),
+        c.data(), cStride() * sizeof(float),
+        &clampingParams);
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          ASSERT_NEAR(
+              c[mIndex * cStride() + nIndex],
+              cRef[mIndex * n() + nIndex],
+              std::abs(cRef[mIndex * n() + nIndex]) * 1.0e-5f)
+              << "at " << mIndex << ", " << nIndex << ": reference = " << cRef[mIndex * n() + nIndex]
+              << ", optimized = " << c[mIndex * cStride() + nIndex] << ", Mr x Nr = " << mr() << " x " << nr()
+              << ", M x N x K x KS = " << m() << " x " << n() << " x " << k() << " x " << ks();
+        }
+      }
+      for (size_t mIndex = 0; mIndex < m() - 1; mIndex++) {
+        for (size_t nIndex = n(); nIndex < cStride(); nIndex++) {
+          ASSERT_TRUE(std::isnan(c[mIndex * cStride() + nIndex]))
+            << "at " << mIndex << ", " << nIndex << ": Mr x Nr = " << mr() << " x " << nr();
+        }
+      }
+      for (size_t i = (m() - 1) * cStride() + n(); i < c.size(); i++) {
+        ASSERT_TRUE(std::isnan(c[i])) << "at i = " << i << ", Mr x Nr = " << mr() << " x " << nr();
+      }
+    }
+  }
+
+  void testMicroKernel(hconv_ukernel_function hconv) const {
+    if (!cpuinfo_initialize() || !cpuinfo_has_arm_neon_fp16_arith()) {
+      return;
+    }
+
+    ASSERT_LE(m(), mr());
+    ASSERT_LE(n(), nr());
+    ASSERT_EQ(1, kr());
+    ASSERT_GE(aStride(), k());
+    ASSERT_GE(cStride(), n());
+
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto f16rng = std::bind(fp16_ieee_from_fp32_value, std::bind(std::uniform_real_distribution<float>(), rng));
+
+    std::vector<uint16_t> a((mr() - 1) * aStride() + k());
+    std::vector<uint16_t> b(n() * ks() * k());
+    std::vector<uint16_t, AlignedAllocator<uint16_t, 32>> packedB(packedN() * ks() * k());
+    std::vector<uint16_t> bias(nr());
+    std::vector<uint16_t> c((mr() - 1) * cStride() + nr());
+    std::vector<float> cRef(m() * n());
+    std::vector<const void*> im2col(mr() * ks());
+
+    struct qnnp_fp16_clamping_params clampingParams;
+    clampingParams.scale = UINT16_C(0x3C00) /* 1.0 */;
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(a.begin(), a.end(), std::ref(f16rng));
+      std::generate(b.begin(), b.end(), std::ref(f16rng));
+      std::generate(bias.begin(), bias.end(), std::ref(f16rng));
+      std::fill(c.begin(), c.end(), UINT16_C(0x7E00) /* NaN */);
+
+      std::fill(packedB.begin(), packedB.end(), 0);
+      pack_hconv_b(n(), ks(), k(), np(), b.data(), packedB.data());
+
+      for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+        for (size_t mIndex = 0; mIndex < mr(); mIndex++) {
+          im2col[ksIndex * mr() + mIndex] = a.data() + aStride() * mIndex;
+        }
+      }
+      std::shuffle(im2col.begin(), im2col.end(), rng);
+      for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+        for (size_t mIndex = m(); mIndex < mr(); mIndex++) {
+          im2col[ksIndex * mr() + mIndex] = im2col[ksIndex * mr() + m() - 1];
+        }
+      }
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          float acc = fp16_ieee_to_fp32_value(bias[nIndex]);
+          for (size_t ksIndex = 0; ksIndex < ks(); ksIndex++) {
+            const uint16_t* aRow = static_cast<const uint16_t*>(im2col[ksIndex * mr() + mIndex]);
+            for (size_t kIndex = 0; kIndex < k(); kIndex++) {
+              acc += fp16_ieee_to_fp32_value(aRow[kIndex]) *
+                fp16_ieee_to_fp32_value(b[(nIndex * ks() + ksIndex) * k() + kIndex]);
+            }
+          }
+          cRef[mIndex * n() + nIndex] = acc;
+        }
+      }
+
+      const float accMin = *std::min_element(cRef.cbegin(), cRef.cend());
+      const float accMax = *std::max_element(cRef.cbegin(), cRef.cend());
+      const float cMin = fp16_ieee_to_fp32_value(fp16_ieee_from_fp32_value(accMin + (accMax - accMin) / 255.0f * float(qmin())));
+      const float cMax = fp16_ieee_to_fp32_value(fp16_ieee_from_fp32_value(accMax - (accMax - accMin) / 255.0f * float(255 - qmax())));
+      clampingParams.max = fp16_ieee_from_fp32_value(cMax);
+      clampingParams.min = fp16_ieee_from_fp32_value(cMin);
+      for (float& cValue : cRef) {
+        cValue = std::max(std::min(cValue, cMax), cMin);
+      }
+
+      hconv(
+        m(), n(), k(), ks(),
+        im2col.data(), packedB.data(), bias.data(),
+        c.data(), cStride() * sizeof(uint16_t),
+        &clampingParams);
+
+      for (size_t mIndex = 0; mIndex < m(); mIndex++) {
+        for (size_t nIndex = 0; nIndex < n(); nIndex++) {
+          ASSERT_NEAR(
+              fp16_ieee_to_fp32_value(c[mIndex * cStride() + nIndex]),
+              cRef[mIndex * n() + nIndex],
+              std::abs(cRef[mIndex * n() + nIndex]) * 1.0e-2f)
+              << "at " << mIndex << ", " << nIndex << ": reference = " << cRef[mIndex * n() + nIndex]
+              << ", optimized = " << fp16_ieee_to_fp32_value(c[mIndex * cStride() + nIndex])
+              << ", Mr x Nr = " << mr() << " x " << nr()
+              << ", M x N x K x KS = " << m() << " x " << n() << " x " << k() << " x " << ks();
+        }
+      }
+      for (size_t mIndex = 0; mIndex < m() - 1; mIndex++) {
+        for (size_t nIndex = n(); nIndex < cStride(); nIndex++) {
+          ASSERT_EQ(UINT16_C(0x7E00) /* NaN */, c[mIndex * cStride() + nIndex])
+            << "at " << mIndex << ", " << nIndex << ": Mr x Nr = " << mr() << " x " << nr();
+        }
+      }
+      for (size_t i = (m() - 1) * cStride() + n(); i < c.size(); i++) {
+        ASSERT_EQ(UINT16_C(0x7E00) /* NaN */, c[i]) << "at i = " << i << ", Mr x Nr = " << mr() << " x " << nr();
+      }
+    }
+  }
+
  private:
+  /* Converts packed B with zero point 128 to int8 and folds the A zero point into the bias */
+  void convertToSignedKernel(
+      uint8_t aZeroPoint,
+      std::vector<uint8_t, AlignedAllocator<uint8_t, 32>>& packedB,
+      std::vector<int32_t>& bias) const
+  {
+    ASSERT_EQ(np(), nr());
+    for (size_t i = 0; i < packedB.size(); i++) {
+      packedB[i] ^= 0x80;
+      bias[i / kr() % nr()] -= int32_t(aZeroPoint) * int32_t(int8_t(packedB[i]));
+    }
+  }
+
+  /*
+   * Packs B with two values per byte, see pack_q8gemm_4bit_b, padded to whole 64-byte blocks as the packed kernels of
+   * operators are, see QNNP_PACKED_BLOCK_ALIGNMENT
+   */
+  void convertToFourBitKernel(std::vector<uint8_t, AlignedAllocator<uint8_t, 32>>& packedB) const {
+    ASSERT_EQ(np(), nr());
+    ASSERT_EQ(0, kr() % 2);
+    std::vector<uint8_t, AlignedAllocator<uint8_t, 32>> fourBitB(
+      (packedB.size() / 2 + 63) / 64 * 64);
+    for (size_t i = 0; i < packedB.size(); i++) {
+      ASSERT_LE(packedB[i], 15);
+      fourBitB[i / 2] |= uint8_t(packedB[i] << (i % 2 * 4));
+    }
+    packedB.assign(fourBitB.cbegin(), fourBitB.cend());
+  }
+
   size_t mr_{1};
   size_t nr_{1};
   size_t np_{1};
@@ -870,5 +1621,10 @@ class GemmTester {
   size_t cStride_{0};
   uint8_t qmin_{0};
   uint8_t qmax_{255};
+  bool signedKernel_{false};
+  bool foldedZeroPoint_{false};
+  bool fp32Requantization_{false};
+  bool acc16_{false};
+  bool fourBitKernel_{false};
   size_t iterations_{15};
 };
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "global-average-pooling-tester.h"
+
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, unit_batch_small_width) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    for (size_t width = 2; width <= 16; width++) {
+      GlobalAveragePoolingTester()
+        .batchSize(1)
+        .width(width)
+        .channels(channels)
+        .test();
+    }
+  }
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, unit_batch_unit_width) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    GlobalAveragePoolingTester()
+      .batchSize(1)
+      .width(1)
+      .channels(channels)
+      .outputScale(1.5f)
+      .test();
+  }
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, unit_batch_large_width) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    for (size_t width = 49; width <= 196; width += 49) {
+      GlobalAveragePoolingTester()
+        .batchSize(1)
+        .width(width)
+        .channels(channels)
+        .test();
+    }
+  }
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, unit_batch_with_input_stride) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    GlobalAveragePoolingTester()
+      .batchSize(1)
+      .width(49)
+      .channels(channels)
+      .inputStride(channels * 2 + 3)
+      .test();
+  }
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, unit_batch_with_scales) {
+  for (float inputScale = 0.01f; inputScale < 40.0f; inputScale *= 3.14159265f) {
+    GlobalAveragePoolingTester()
+      .batchSize(1)
+      .width(49)
+      .channels(19)
+      .inputScale(inputScale)
+      .iterations(3)
+      .test();
+  }
+  for (float outputScale = 0.1f; outputScale < 100.0f; outputScale *= 3.14159265f) {
+    GlobalAveragePoolingTester()
+      .batchSize(1)
+      .width(49)
+      .channels(19)
+      .outputScale(outputScale)
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, unit_batch_with_zero_points) {
+  for (int32_t zeroPoint = 0; zeroPoint <= 255; zeroPoint += 51) {
+    GlobalAveragePoolingTester()
+      .batchSize(1)
+      .width(49)
+      .channels(19)
+      .inputZeroPoint(uint8_t(zeroPoint))
+      .outputZeroPoint(uint8_t(255 - zeroPoint))
+      .iterations(3)
+      .test();
+  }
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, unit_batch_with_qmin) {
+  GlobalAveragePoolingTester()
+    .batchSize(1)
+    .width(49)
+    .channels(19)
+    .qmin(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, unit_batch_with_qmax) {
+  GlobalAveragePoolingTester()
+    .batchSize(1)
+    .width(49)
+    .channels(19)
+    .qmax(128)
+    .iterations(3)
+    .test();
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, small_batch) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    GlobalAveragePoolingTester()
+      .batchSize(3)
+      .width(13)
+      .channels(channels)
+      .test();
+  }
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, small_batch_with_strides) {
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    GlobalAveragePoolingTester()
+      .batchSize(3)
+      .width(13)
+      .channels(channels)
+      .inputStride(channels * 2 + 3)
+      .outputStride(channels + 5)
+      .test();
+  }
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, small_batch_with_threads) {
+  /* Few images on many threads split channels into tiles */
+  for (size_t channels = 1; channels <= 100; channels += 9) {
+    GlobalAveragePoolingTester()
+      .batchSize(2)
+      .width(49)
+      .channels(channels)
+      .threads(4)
+      .test();
+  }
+}
+
+TEST(GLOBAL_AVERAGE_POOLING_OP, unsupported_requantization_scale) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t global_average_pooling_op = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_global_average_pooling_nwc_q8(
+      7, 127, 4.0f, 127, 1.0f, 0, 255, 0, &global_average_pooling_op));
+  uint8_t input[7 * 2] = { 0 };
+  uint8_t output[7] = { 0 };
+  ASSERT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_setup_global_average_pooling_nwc_q8(
+      global_average_pooling_op, 1, 2, input, 7, output, 7, nullptr));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_global_average_pooling_nwc_q8(
+      global_average_pooling_op, 1, 5, input, 7, output, 7, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(global_average_pooling_op));
+}
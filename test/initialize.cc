@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <qnnpack.h>
+
+
+TEST(INITIALIZE, autotune) {
+  struct qnnp_initialize_options options = { };
+  options.flags = QNNP_INITIALIZE_FLAG_AUTOTUNE;
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize_with_options(&options));
+
+  struct qnnp_tuning_result tuning_result;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_tuning_result(&tuning_result));
+}
+
+TEST(INITIALIZE, tuning_result_round_trip) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  struct qnnp_tuning_result tuning_result;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_tuning_result(&tuning_result));
+
+  struct qnnp_initialize_options options = { };
+  options.tuning_result = &tuning_result;
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize_with_options(&options));
+
+  struct qnnp_tuning_result reinitialized_tuning_result;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_tuning_result(&reinitialized_tuning_result));
+  ASSERT_EQ(tuning_result.version, reinitialized_tuning_result.version);
+  ASSERT_EQ(tuning_result.uarch, reinitialized_tuning_result.uarch);
+  ASSERT_EQ(tuning_result.q8conv_ukernel, reinitialized_tuning_result.q8conv_ukernel);
+}
+
+TEST(INITIALIZE, null_options) {
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_initialize_with_options(nullptr));
+}
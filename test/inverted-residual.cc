@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+namespace {
+
+qnnp_operator_t createConvolution(
+    uint32_t kernelSize, uint32_t padding, uint32_t subsampling,
+    uint32_t groups, size_t groupInputChannels, size_t groupOutputChannels,
+    const std::vector<uint8_t>& kernel, const std::vector<int32_t>& bias,
+    uint32_t flags)
+{
+  qnnp_operator_t convolution = nullptr;
+  EXPECT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      padding, padding, padding, padding,
+      kernelSize, kernelSize,
+      subsampling, subsampling,
+      1, 1,
+      groups, groupInputChannels, groupOutputChannels,
+      127, 0.5f,
+      127, 0.5f,
+      kernel.data(), bias.data(),
+      127, 0.25f * kernelSize * kernelSize * groupInputChannels, 0, 255,
+      flags,
+      &convolution));
+  return convolution;
+}
+
+/*
+ * Block of 1x1 expansion, 3x3 depthwise, and 1x1 projection convolutions. Checks that the fused operator gives the
+ * output of the three convolutions run one after another.
+ */
+void testInvertedResidual(
+    size_t threads, size_t batchSize, size_t height, size_t width,
+    size_t inputChannels, size_t expandedChannels, size_t outputChannels,
+    uint32_t subsampling, uint32_t flags)
+{
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  const size_t outputHeight = (height + 2 - 3) / subsampling + 1;
+  const size_t outputWidth = (width + 2 - 3) / subsampling + 1;
+  std::vector<uint8_t> input(batchSize * height * width * inputChannels + 8);
+  std::vector<uint8_t> expansionKernel(expandedChannels * inputChannels);
+  std::vector<uint8_t> depthwiseKernel(expandedChannels * 3 * 3);
+  std::vector<uint8_t> projectionKernel(outputChannels * expandedChannels);
+  std::vector<int32_t> expansionBias(expandedChannels), depthwiseBias(expandedChannels);
+  std::vector<int32_t> projectionBias(outputChannels);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::generate(expansionKernel.begin(), expansionKernel.end(), std::ref(u8rng));
+  std::generate(depthwiseKernel.begin(), depthwiseKernel.end(), std::ref(u8rng));
+  std::generate(projectionKernel.begin(), projectionKernel.end(), std::ref(u8rng));
+  std::generate(expansionBias.begin(), expansionBias.end(), std::ref(s32rng));
+  std::generate(depthwiseBias.begin(), depthwiseBias.end(), std::ref(s32rng));
+  std::generate(projectionBias.begin(), projectionBias.end(), std::ref(s32rng));
+
+  qnnp_operator_t expansion =
+    createConvolution(1, 0, 1, 1, inputChannels, expandedChannels, expansionKernel, expansionBias, flags);
+  qnnp_operator_t depthwise =
+    createConvolution(3, 1, subsampling, expandedChannels, 1, 1, depthwiseKernel, depthwiseBias, flags);
+  qnnp_operator_t projection =
+    createConvolution(1, 0, 1, 1, expandedChannels, outputChannels, projectionKernel, projectionBias, flags);
+  ASSERT_NE(nullptr, expansion);
+  ASSERT_NE(nullptr, depthwise);
+  ASSERT_NE(nullptr, projection);
+
+  pthreadpool_t threadpool = pthreadpool_create(threads);
+  std::vector<uint8_t> expanded(batchSize * height * width * expandedChannels + 8);
+  std::vector<uint8_t> filtered(batchSize * outputHeight * outputWidth * expandedChannels + 8);
+  std::vector<uint8_t> referenceOutput(batchSize * outputHeight * outputWidth * outputChannels);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(
+      expansion, batchSize, height, width,
+      input.data() + 8, inputChannels,
+      expanded.data() + 8, expandedChannels,
+      threadpool));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(expansion, threadpool));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(
+      depthwise, batchSize, height, width,
+      expanded.data() + 8, expandedChannels,
+      filtered.data() + 8, expandedChannels,
+      threadpool));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(depthwise, threadpool));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(
+      projection, batchSize, outputHeight, outputWidth,
+      filtered.data() + 8, expandedChannels,
+      referenceOutput.data(), outputChannels,
+      threadpool));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(projection, threadpool));
+
+  qnnp_operator_t invertedResidual = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_inverted_residual_nhwc_q8(expansion, depthwise, projection, 0 /* flags */, &invertedResidual));
+  ASSERT_NE(nullptr, invertedResidual);
+
+  std::vector<uint8_t> output(batchSize * outputHeight * outputWidth * outputChannels);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_inverted_residual_nhwc_q8(
+      invertedResidual, batchSize, height, width,
+      input.data() + 8, inputChannels,
+      output.data(), outputChannels,
+      threadpool));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(invertedResidual, threadpool));
+  EXPECT_EQ(referenceOutput, output);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(invertedResidual));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(expansion));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(depthwise));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(projection));
+  if (threadpool != nullptr) {
+    pthreadpool_destroy(threadpool);
+  }
+}
+
+}  // namespace
+
+TEST(INVERTED_RESIDUAL, single_thread) {
+  testInvertedResidual(1, 1, 13, 11, 16, 24, 8, 1, 0 /* flags */);
+}
+
+TEST(INVERTED_RESIDUAL, single_thread_with_subsampling) {
+  testInvertedResidual(1, 1, 13, 11, 16, 24, 8, 2, 0 /* flags */);
+}
+
+TEST(INVERTED_RESIDUAL, multithreaded) {
+  testInvertedResidual(4, 2, 13, 11, 16, 24, 8, 1, 0 /* flags */);
+}
+
+TEST(INVERTED_RESIDUAL, multithreaded_with_subsampling) {
+  testInvertedResidual(4, 2, 14, 12, 16, 24, 8, 2, 0 /* flags */);
+}
+
+TEST(INVERTED_RESIDUAL, few_expanded_channels) {
+  testInvertedResidual(3, 2, 9, 7, 3, 5, 4, 1, 0 /* flags */);
+}
+
+TEST(INVERTED_RESIDUAL, more_threads_than_rows) {
+  testInvertedResidual(8, 1, 3, 5, 8, 16, 8, 2, 0 /* flags */);
+}
+
+TEST(INVERTED_RESIDUAL, lazy_packing) {
+  testInvertedResidual(3, 2, 13, 11, 16, 24, 8, 1, QNNP_CREATE_FLAG_LAZY_PACKING);
+}
+
+TEST(INVERTED_RESIDUAL, padded_projection) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> expansionKernel(16 * 8, 1), depthwiseKernel(16 * 9, 1), projectionKernel(8 * 16, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t expansion = createConvolution(1, 0, 1, 1, 8, 16, expansionKernel, bias, 0);
+  qnnp_operator_t depthwise = createConvolution(3, 1, 1, 16, 1, 1, depthwiseKernel, bias, 0);
+  qnnp_operator_t projection = createConvolution(1, 1, 1, 1, 16, 8, projectionKernel, bias, 0);
+
+  qnnp_operator_t invertedResidual = nullptr;
+  EXPECT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_create_inverted_residual_nhwc_q8(expansion, depthwise, projection, 0 /* flags */, &invertedResidual));
+  EXPECT_EQ(nullptr, invertedResidual);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(expansion));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(depthwise));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(projection));
+}
+
+TEST(INVERTED_RESIDUAL, mismatched_channels) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> expansionKernel(16 * 8, 1), depthwiseKernel(24 * 9, 1), projectionKernel(8 * 24, 1);
+  const std::vector<int32_t> bias(24, 0);
+  qnnp_operator_t expansion = createConvolution(1, 0, 1, 1, 8, 16, expansionKernel, bias, 0);
+  qnnp_operator_t depthwise = createConvolution(3, 1, 1, 24, 1, 1, depthwiseKernel, bias, 0);
+  qnnp_operator_t projection = createConvolution(1, 0, 1, 1, 24, 8, projectionKernel, bias, 0);
+
+  qnnp_operator_t invertedResidual = nullptr;
+  EXPECT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_inverted_residual_nhwc_q8(expansion, depthwise, projection, 0 /* flags */, &invertedResidual));
+  EXPECT_EQ(nullptr, invertedResidual);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(expansion));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(depthwise));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(projection));
+}
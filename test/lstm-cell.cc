@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+namespace {
+
+const uint8_t kInputZeroPoint = 128;
+const float kInputScale = 1.0f / 64.0f;
+const float kCellScale = 1.0f / 2048.0f;
+
+float sigmoid(float x) {
+  return 1.0f / (1.0f + std::exp(-x));
+}
+
+/*
+ * Runs timesteps of an LSTM cell and checks every one against a reference computed from the same hidden and cell
+ * states: gate pre-activations from a fully-connected operator over the input and hidden state, which requantizes
+ * them as the LSTM cell does, and sigmoid, tanh, and the state update in float.
+ */
+void testLSTMCell(
+    size_t threads, size_t batchSize, size_t inputChannels, size_t hiddenChannels,
+    size_t timesteps, size_t inputStride, size_t hiddenStride, bool inPlace,
+    uint8_t kernelZeroPoint, uint32_t flags)
+{
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-5000, 5000), rng);
+  auto s16rng = std::bind(std::uniform_int_distribution<int16_t>(-8192, 8192), rng);
+
+  const size_t concatChannels = inputChannels + hiddenChannels;
+  const size_t gateChannels = 4 * hiddenChannels;
+  /* Gate pre-activations of a few units in [-8, 8), so that sigmoid and tanh are neither linear nor saturated */
+  const float kernelScale = 0.05f / std::sqrt(float(concatChannels));
+  std::vector<uint8_t> inputKernel(gateChannels * inputChannels);
+  std::vector<uint8_t> recurrentKernel(gateChannels * hiddenChannels);
+  std::vector<int32_t> bias(gateChannels);
+  std::generate(inputKernel.begin(), inputKernel.end(), std::ref(u8rng));
+  std::generate(recurrentKernel.begin(), recurrentKernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  std::vector<uint8_t> gateKernel(gateChannels * concatChannels);
+  for (size_t r = 0; r < gateChannels; r++) {
+    std::copy_n(&inputKernel[r * inputChannels], inputChannels, &gateKernel[r * concatChannels]);
+    std::copy_n(&recurrentKernel[r * hiddenChannels], hiddenChannels, &gateKernel[r * concatChannels + inputChannels]);
+  }
+  qnnp_operator_t referenceGates = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      concatChannels, gateChannels,
+      kInputZeroPoint, kInputScale,
+      kernelZeroPoint, kernelScale,
+      gateKernel.data(), bias.data(),
+      128, 1.0f / 16.0f, 0, 255,
+      flags, &referenceGates));
+
+  qnnp_operator_t lstmCell = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_lstm_cell_nc_q8(
+      inputChannels, hiddenChannels,
+      kInputZeroPoint, kInputScale,
+      kernelZeroPoint, kernelScale,
+      inputKernel.data(), recurrentKernel.data(), bias.data(),
+      kCellScale, flags, &lstmCell));
+  ASSERT_NE(nullptr, lstmCell);
+
+  pthreadpool_t threadpool = pthreadpool_create(threads);
+  std::vector<uint8_t> input((batchSize - 1) * inputStride + inputChannels + 8);
+  std::vector<uint8_t> hiddenInput((batchSize - 1) * hiddenStride + hiddenChannels);
+  std::vector<uint8_t> hiddenOutput((batchSize - 1) * hiddenStride + hiddenChannels);
+  std::vector<int16_t> cellState(batchSize * hiddenChannels);
+  std::generate(hiddenInput.begin(), hiddenInput.end(), std::ref(u8rng));
+  std::generate(cellState.begin(), cellState.end(), std::ref(s16rng));
+  uint8_t* hiddenOutputData = inPlace ? hiddenInput.data() : hiddenOutput.data();
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_lstm_cell_nc_q8(
+      lstmCell, batchSize,
+      input.data(), inputStride,
+      hiddenInput.data(), hiddenStride,
+      cellState.data(),
+      hiddenOutputData, hiddenStride,
+      threadpool));
+
+  std::vector<uint8_t> concat(batchSize * concatChannels + 8);
+  std::vector<uint8_t> gates(batchSize * gateChannels);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(
+      referenceGates, batchSize,
+      concat.data(), concatChannels,
+      gates.data(), gateChannels,
+      threadpool));
+
+  for (size_t t = 0; t < timesteps; t++) {
+    std::generate(input.begin(), input.end(), std::ref(u8rng));
+    for (size_t i = 0; i < batchSize; i++) {
+      std::copy_n(&input[i * inputStride], inputChannels, &concat[i * concatChannels]);
+      std::copy_n(&hiddenInput[i * hiddenStride], hiddenChannels, &concat[i * concatChannels + inputChannels]);
+    }
+    const std::vector<int16_t> previousCellState(cellState);
+    ASSERT_EQ(qnnp_status_success, qnnp_run_operator(referenceGates, threadpool));
+    ASSERT_EQ(qnnp_status_success, qnnp_run_operator(lstmCell, threadpool));
+
+    for (size_t i = 0; i < batchSize; i++) {
+      for (size_t j = 0; j < hiddenChannels; j++) {
+        float gate[4];
+        for (size_t g = 0; g < 4; g++) {
+          gate[g] = (float(int32_t(gates[i * gateChannels + g * hiddenChannels + j])) - 128.0f) / 16.0f;
+        }
+        const float cell =
+          sigmoid(gate[1]) * float(previousCellState[i * hiddenChannels + j]) * kCellScale +
+          sigmoid(gate[0]) * std::tanh(gate[2]);
+        const float referenceCell = std::min(std::max(cell / kCellScale, -32768.0f), 32767.0f);
+        const float hidden = sigmoid(gate[3]) * std::tanh(referenceCell * kCellScale);
+        const float referenceHidden =
+          std::min(std::max(hidden / kInputScale + float(kInputZeroPoint), 0.0f), 255.0f);
+        ASSERT_NEAR(referenceCell, float(cellState[i * hiddenChannels + j]), 2.0f)
+          << "timestep " << t << ", batch index " << i << ", hidden channel " << j;
+        ASSERT_NEAR(referenceHidden, float(int32_t(hiddenOutputData[i * hiddenStride + j])), 1.0f)
+          << "timestep " << t << ", batch index " << i << ", hidden channel " << j;
+      }
+    }
+    if (!inPlace) {
+      hiddenInput = hiddenOutput;
+    }
+  }
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(lstmCell));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(referenceGates));
+  if (threadpool != nullptr) {
+    pthreadpool_destroy(threadpool);
+  }
+}
+
+}  // namespace
+
+TEST(LSTM_CELL_Q8, single_thread) {
+  testLSTMCell(1, 1, 11, 8, 1, 11, 8, false, 127, 0 /* flags */);
+}
+
+TEST(LSTM_CELL_Q8, small_batch) {
+  testLSTMCell(1, 3, 11, 8, 1, 11, 8, false, 127, 0 /* flags */);
+}
+
+TEST(LSTM_CELL_Q8, large_batch) {
+  testLSTMCell(1, 13, 19, 24, 1, 19, 24, false, 127, 0 /* flags */);
+}
+
+TEST(LSTM_CELL_Q8, odd_hidden_channels) {
+  testLSTMCell(1, 5, 7, 13, 1, 7, 13, false, 127, 0 /* flags */);
+}
+
+TEST(LSTM_CELL_Q8, multithreaded) {
+  testLSTMCell(4, 7, 23, 37, 1, 23, 37, false, 127, 0 /* flags */);
+}
+
+TEST(LSTM_CELL_Q8, strides) {
+  testLSTMCell(2, 5, 11, 9, 1, 17, 14, false, 127, 0 /* flags */);
+}
+
+TEST(LSTM_CELL_Q8, timesteps) {
+  testLSTMCell(2, 3, 11, 16, 6, 11, 16, false, 127, 0 /* flags */);
+}
+
+TEST(LSTM_CELL_Q8, in_place_timesteps) {
+  testLSTMCell(2, 3, 11, 16, 6, 11, 16, true, 127, 0 /* flags */);
+}
+
+TEST(LSTM_CELL_Q8, signed_kernel) {
+  testLSTMCell(2, 3, 11, 16, 3, 11, 16, true, 128, 0 /* flags */);
+}
+
+TEST(LSTM_CELL_Q8, fp32_requantization) {
+  testLSTMCell(2, 3, 11, 16, 3, 11, 16, true, 127, QNNP_CREATE_FLAG_FP32_REQUANTIZATION);
+}
+
+TEST(LSTM_CELL_Q8, cell_scale_not_power_of_two) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> inputKernel(16 * 3, 1), recurrentKernel(16 * 4, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t lstmCell = nullptr;
+  EXPECT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_lstm_cell_nc_q8(
+      3, 4, kInputZeroPoint, kInputScale, 127, 0.01f,
+      inputKernel.data(), recurrentKernel.data(), bias.data(),
+      0.001f, 0 /* flags */, &lstmCell));
+  EXPECT_EQ(nullptr, lstmCell);
+}
+
+TEST(LSTM_CELL_Q8, setup_other_operator) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(4 * 3, 1);
+  const std::vector<int32_t> bias(4, 0);
+  qnnp_operator_t fullyConnected = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      3, 4, kInputZeroPoint, kInputScale, 127, 0.01f, kernel.data(), bias.data(),
+      128, 1.0f, 0, 255, 0 /* flags */, &fullyConnected));
+  std::vector<uint8_t> input(3 + 8), hidden(4);
+  std::vector<int16_t> cellState(4);
+  EXPECT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_lstm_cell_nc_q8(
+      fullyConnected, 1, input.data(), 3, hidden.data(), 4, cellState.data(), hidden.data(), 4, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(fullyConnected));
+}
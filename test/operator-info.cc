@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <qnnpack.h>
+#include <qnnpack/params.h>
+
+
+namespace {
+
+qnnp_operator_t createConvolution(
+    uint32_t padding, uint32_t kernelSize,
+    uint32_t groups, size_t groupInputChannels, size_t groupOutputChannels,
+    const std::vector<uint8_t>& kernel, const std::vector<int32_t>& bias,
+    uint32_t flags = 0)
+{
+  qnnp_operator_t op = nullptr;
+  EXPECT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      padding, padding, padding, padding,
+      kernelSize, kernelSize,
+      1, 1,
+      1, 1,
+      groups, groupInputChannels, groupOutputChannels,
+      127, 1.0f,
+      127, 1.0f,
+      kernel.data(), bias.data(),
+      127, 100.0f, 0, 255,
+      flags,
+      &op));
+  return op;
+}
+
+}  // namespace
+
+TEST(OPERATOR_INFO, gemm_convolution) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = createConvolution(0, 1, 1, 8, 16, kernel, bias);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_gemm, info.path);
+  EXPECT_NE(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_PACKED);
+  ASSERT_NE(nullptr, info.ukernel);
+  EXPECT_NE(0u, info.mr);
+  EXPECT_NE(0u, info.nr);
+  EXPECT_NE(0u, info.kr);
+  const size_t nStride = (16 + info.nr - 1) / info.nr * info.nr;
+  const size_t kStride = (8 + info.kr - 1) / info.kr * info.kr;
+  EXPECT_EQ(nStride * kStride, info.packed_kernel_size);
+  EXPECT_EQ(sizeof(int32_t) * nStride, info.bias_size);
+  EXPECT_EQ(0u, info.im2col_buffer_size);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, indirect_convolution) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 3 * 3 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = createConvolution(1, 3, 1, 8, 16, kernel, bias);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_conv, info.path);
+  /* Buffers are sized by setup */
+  EXPECT_EQ(0u, info.im2col_buffer_size);
+
+  std::vector<uint8_t> input(9 * 10 * 8);
+  std::vector<uint8_t> output(9 * 10 * 16);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(op, 2, 9, 5, input.data(), 8, output.data(), 16, nullptr));
+
+  size_t workspaceSize = 0, scratchSize = 0;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_get_convolution2d_nhwc_q8_workspace_size(op, 2, 9, 5, &workspaceSize, &scratchSize));
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_NE(0u, workspaceSize);
+  EXPECT_EQ(workspaceSize, info.im2col_buffer_size);
+  EXPECT_EQ(0u, info.expanded_input_size);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, aligned_packed_blocks) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(2 * 16 * 3 * 3 * 3, 1);
+  const std::vector<int32_t> bias(2 * 16, 0);
+  qnnp_operator_t op = createConvolution(1, 3, 2, 3, 16, kernel, bias);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_conv, info.path);
+  ASSERT_NE(0u, info.nr);
+  ASSERT_NE(0u, info.kr);
+  /* Every nr-block of the 3x3 taps of 3 channels is padded to a multiple of 64 bytes */
+  const size_t nStride = (16 + info.nr - 1) / info.nr * info.nr;
+  const size_t kStride = (3 + info.kr - 1) / info.kr * info.kr;
+  const size_t blockSize = (info.nr * 3 * 3 * kStride + 63) / 64 * 64;
+  EXPECT_EQ(2 * nStride / info.nr * blockSize, info.packed_kernel_size);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, indirection_offsets_shared_by_batch) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 3 * 3 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = createConvolution(1, 3, 1, 8, 16, kernel, bias);
+  ASSERT_NE(nullptr, op);
+
+  size_t singleImageWorkspaceSize = 0, workspaceSize = 0, scratchSize = 0;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_get_convolution2d_nhwc_q8_workspace_size(op, 1, 9, 5, &singleImageWorkspaceSize, &scratchSize));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_get_convolution2d_nhwc_q8_workspace_size(op, 4, 9, 5, &workspaceSize, &scratchSize));
+  EXPECT_NE(0u, singleImageWorkspaceSize);
+  EXPECT_EQ(singleImageWorkspaceSize, workspaceSize);
+
+  std::vector<uint8_t> input(4 * 9 * 5 * 8);
+  std::vector<uint8_t> output(4 * 9 * 5 * 16);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(op, 4, 9, 5, input.data(), 8, output.data(), 16, nullptr));
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_NE(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_INDIRECTION_OFFSETS);
+  EXPECT_EQ(singleImageWorkspaceSize, info.im2col_buffer_size);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, depthwise_convolution) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(24 * 3 * 3, 1);
+  const std::vector<int32_t> bias(24, 0);
+  qnnp_operator_t op = createConvolution(1, 3, 24, 1, 1, kernel, bias);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_depthwise, info.path);
+  ASSERT_NE(nullptr, info.ukernel);
+  EXPECT_EQ(1u, info.mr);
+  ASSERT_NE(0u, info.nr);
+  const size_t cStride = (24 + info.nr - 1) / info.nr * info.nr;
+  /* Bias is interleaved with the packed kernel */
+  EXPECT_EQ((3 * 3 + sizeof(int32_t)) * cStride, info.packed_kernel_size);
+  EXPECT_EQ(0u, info.bias_size);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, depthwise_with_multiplier) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::vector<uint8_t> input(9 * 9 * 8);
+  std::vector<uint8_t> output(9 * 9 * 24);
+  qnnp_operator_info info;
+
+  /* Power-of-two multipliers read the input channels directly when the tile has a microkernel for them */
+  qnnp_operator_t op =
+    createConvolution(1, 3, 8, 1, 2, std::vector<uint8_t>(16 * 3 * 3, 1), std::vector<int32_t>(16, 0));
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(op, 1, 9, 9, input.data(), 8, output.data(), 16, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_depthwise, info.path);
+  EXPECT_EQ(qnnp_params.q8dw9.multiplier_dw == nullptr, info.expanded_input_size != 0);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+
+  /* Other multipliers replicate the input channels first */
+  op = createConvolution(1, 3, 8, 1, 3, std::vector<uint8_t>(24 * 3 * 3, 1), std::vector<int32_t>(24, 0));
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(op, 1, 9, 9, input.data(), 8, output.data(), 24, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_NE(0u, info.expanded_input_size);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, winograd_convolution) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(72 * 3 * 3 * 64, 1);
+  const std::vector<int32_t> bias(72, 0);
+  qnnp_operator_t op = createConvolution(1, 3, 1, 64, 72, kernel, bias);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_winograd, info.path);
+  ASSERT_NE(nullptr, info.ukernel);
+  ASSERT_NE(0u, info.nr);
+  EXPECT_EQ(1u, info.kr);
+  const size_t nStride = (72 + info.nr - 1) / info.nr * info.nr;
+  /* The 4x4 transformed kernel tiles are packed as 16-bit values */
+  EXPECT_EQ(sizeof(int16_t) * 16 * 64 * nStride, info.packed_kernel_size);
+  EXPECT_EQ(sizeof(int32_t) * nStride, info.bias_size);
+
+  std::vector<uint8_t> input(9 * 5 * 64);
+  std::vector<uint8_t> output(9 * 5 * 72);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(op, 1, 9, 5, input.data(), 64, output.data(), 72, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(0u, info.im2col_buffer_size);
+  /* 5x3 tiles of 2x2 output pixels */
+  EXPECT_EQ(sizeof(int16_t) * 5 * 3 * 16 * 64, info.transformed_input_size);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+
+  op = createConvolution(1, 3, 1, 64, 72, kernel, bias, QNNP_CREATE_FLAG_NO_WINOGRAD);
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_conv, info.path);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, lazy_packing) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 3 * 3 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = createConvolution(1, 3, 1, 8, 16, kernel, bias, QNNP_CREATE_FLAG_LAZY_PACKING);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_PACKED);
+  /* The size of the packed kernel is known before packing */
+  EXPECT_NE(0u, info.packed_kernel_size);
+
+  std::vector<uint8_t> input(9 * 10 * 8);
+  std::vector<uint8_t> output(9 * 10 * 16);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(op, 1, 9, 10, input.data(), 8, output.data(), 16, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(op, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_NE(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_PACKED);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, fully_connected) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      8, 16,
+      127, 1.0f,
+      127, 1.0f,
+      kernel.data(), bias.data(),
+      127, 100.0f, 0, 255,
+      0 /* flags */,
+      &op));
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_gemm, info.path);
+  ASSERT_NE(nullptr, info.ukernel);
+  EXPECT_NE(0u, info.packed_kernel_size);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, fully_connected_with_few_output_channels) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(4 * 256, 1);
+  const std::vector<int32_t> bias(4, 0);
+  qnnp_operator_t op = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      256, 4,
+      127, 1.0f,
+      127, 1.0f,
+      kernel.data(), bias.data(),
+      127, 100.0f, 0, 255,
+      0 /* flags */,
+      &op));
+
+  /* The variant with the least padded work per throughput, the preferred one on ties */
+  const q8conv_variant* expected = &qnnp_params.q8conv_variants[0];
+  for (uint32_t i = 1; i < qnnp_params.q8conv_variants_count; i++) {
+    const q8conv_variant& variant = qnnp_params.q8conv_variants[i];
+    const uint64_t work = (256 + variant.parameters.kr - 1) / variant.parameters.kr * variant.parameters.kr *
+      ((4 + variant.parameters.nr - 1) / variant.parameters.nr * variant.parameters.nr);
+    const uint64_t expectedWork = (256 + expected->parameters.kr - 1) / expected->parameters.kr *
+      expected->parameters.kr * ((4 + expected->parameters.nr - 1) / expected->parameters.nr * expected->parameters.nr);
+    if (work * expected->throughput < expectedWork * variant.throughput) {
+      expected = &variant;
+    }
+  }
+  /* With AVX2 but not AVX512-VNNI, 4 output channels fill a 4-wide SSE2 tile instead of half an 8-wide AVX2 one */
+  if (strcmp(qnnp_params.q8conv.name, "4x8c2__avx2") == 0) {
+    EXPECT_STREQ("4x4c2__sse2", expected->parameters.name);
+  }
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_STREQ(expected->parameters.name, info.ukernel);
+  EXPECT_EQ(expected->parameters.nr, info.nr);
+  EXPECT_EQ(expected->parameters.kr, info.kr);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, folded_zero_point) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 9 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = createConvolution(
+    1, 3, 1, 8, 16, kernel, bias, QNNP_CREATE_FLAG_FOLD_INPUT_ZERO_POINT | QNNP_CREATE_FLAG_NO_WINOGRAD);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_conv, info.path);
+  EXPECT_NE(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_FOLDED_ZERO_POINT);
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_ACC16);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+
+  /* Without the flag the bias keeps the kernel sums out */
+  op = createConvolution(1, 3, 1, 8, 16, kernel, bias, QNNP_CREATE_FLAG_NO_WINOGRAD);
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_FOLDED_ZERO_POINT);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, xzp_convolution) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  /* Indirect convolutions with enough input channels per tap sum their rows instead of subtracting zero points */
+  const std::vector<uint8_t> kernel(16 * 9 * 256, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = createConvolution(1, 3, 1, 256, 16, kernel, bias, QNNP_CREATE_FLAG_NO_WINOGRAD);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_conv, info.path);
+  /* Tiles without an XZP convolution microkernel, like AVX512-VNNI or the portable ones, keep the regular one */
+  bool xzpSupported = false;
+  for (uint32_t i = 0; i < qnnp_params.q8conv_variants_count; i++) {
+    const q8conv_parameters& parameters = qnnp_params.q8conv_variants[i].parameters;
+    if (strcmp(parameters.name, info.ukernel) == 0) {
+      xzpSupported = parameters.xzp_conv != nullptr && qnnp_params.q8sum_rows.conv_sum_rows != nullptr &&
+        parameters.mr == qnnp_params.q8sum_rows.m && 256 >= qnnp_params.q8conv_xzp.conv_kthreshold;
+    }
+  }
+  EXPECT_EQ(xzpSupported, (info.flags & QNNP_OPERATOR_INFO_FLAG_XZP) != 0);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+
+  /* A few input channels per tap keep the zero point subtractions of the microkernel */
+  op = createConvolution(1, 3, 1, 8, 16, std::vector<uint8_t>(16 * 9 * 8, 1), bias, QNNP_CREATE_FLAG_NO_WINOGRAD);
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_XZP);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, acc16_needs_small_kernel) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  /* Every row deviates from the kernel zero point 127 by 8 * 126 in total, which could overflow 16-bit accumulators */
+  const std::vector<uint8_t> kernel(16 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = createConvolution(0, 1, 1, 8, 16, kernel, bias);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_gemm, info.path);
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_ACC16);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+
+  /* Only 1x1 convolutions run the GEMM microkernels that may accumulate in 16 bits */
+  const std::vector<uint8_t> smallKernel(16 * 9 * 8, 128);
+  op = createConvolution(1, 3, 1, 8, 16, smallKernel, bias, QNNP_CREATE_FLAG_NO_WINOGRAD);
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_conv, info.path);
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_ACC16);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, group_blocks) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(8 * 2 * 3 * 3 * 4, 1);
+  const std::vector<int32_t> bias(8 * 2, 0);
+  qnnp_operator_t op = createConvolution(1, 3, 8, 4, 2, kernel, bias);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_conv, info.path);
+  if (info.nr >= 4) {
+    /* Groups of 2 output channels share nr-blocks, which pack as many input channels as the groups have together */
+    EXPECT_NE(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_GROUP_BLOCKS);
+    const size_t blockGroups = std::min<size_t>(info.nr / 2, 8);
+    const size_t kStride = (blockGroups * 4 + info.kr - 1) / info.kr * info.kr;
+    EXPECT_EQ(8 / blockGroups * sizeof(int32_t) * info.nr, info.bias_size);
+    EXPECT_LE(8 / blockGroups * 9 * kStride * info.nr, info.packed_kernel_size);
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+
+  /* Groups with a full nr-block of output channels each are packed on their own */
+  const std::vector<uint8_t> wideKernel(2 * 40 * 4, 1);
+  op = createConvolution(0, 1, 2, 4, 40, wideKernel, std::vector<int32_t>(2 * 40, 0));
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_GROUP_BLOCKS);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, sparse_kernel) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  /* Each row has the kernel zero point in the first of its 2 blocks of 4 input channels */
+  std::vector<uint8_t> kernel(16 * 8, 1);
+  for (size_t i = 0; i < 16; i++) {
+    std::fill_n(&kernel[i * 8], 4, 127);
+  }
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = createConvolution(0, 1, 1, 8, 16, kernel, bias, QNNP_CREATE_FLAG_SPARSE_KERNEL);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_gemm, info.path);
+  if (info.flags & QNNP_OPERATOR_INFO_FLAG_SPARSE) {
+    /* Offsets of the output channels, then the first input channel and the 4 values of each of the 16 blocks */
+    const size_t nStride = (16 + info.nr - 1) / info.nr * info.nr;
+    EXPECT_EQ(4u, info.kr);
+    EXPECT_EQ(sizeof(uint32_t) * (nStride + 1 + 16) + 4 * 16, info.packed_kernel_size);
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+
+  /* Padded and grouped convolutions keep the dense microkernels */
+  op = createConvolution(1, 1, 1, 8, 16, kernel, bias, QNNP_CREATE_FLAG_SPARSE_KERNEL);
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_SPARSE);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+
+  const std::vector<uint8_t> groupedKernel(2 * 16 * 8, 1);
+  op = createConvolution(0, 1, 2, 8, 16, groupedKernel, std::vector<int32_t>(2 * 16, 0),
+    QNNP_CREATE_FLAG_SPARSE_KERNEL);
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_SPARSE);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+
+  /* So do kernels with fewer input channels than a block */
+  op = createConvolution(0, 1, 1, 3, 16, std::vector<uint8_t>(16 * 3, 1), bias, QNNP_CREATE_FLAG_SPARSE_KERNEL);
+  ASSERT_NE(nullptr, op);
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(0u, info.flags & QNNP_OPERATOR_INFO_FLAG_SPARSE);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, 4bit_kernel) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::vector<uint8_t> kernel(16 * 8);
+  for (size_t i = 0; i < kernel.size(); i++) {
+    kernel[i] = uint8_t(i % 16);
+  }
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t op = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      8, 16,
+      127, 1.0f,
+      7, 1.0f,
+      kernel.data(), bias.data(),
+      127, 100.0f, 0, 255,
+      QNNP_CREATE_FLAG_4BIT_KERNEL,
+      &op));
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_gemm, info.path);
+  if (info.flags & QNNP_OPERATOR_INFO_FLAG_4BIT_KERNEL) {
+    /* Two values per byte, with every nr-block padded to 64 bytes */
+    const size_t nStride = (16 + info.nr - 1) / info.nr * info.nr;
+    const size_t kStride = (8 + info.kr - 1) / info.kr * info.kr;
+    EXPECT_EQ(nStride / info.nr * ((info.nr * kStride / 2 + 63) / 64 * 64), info.packed_kernel_size);
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(OPERATOR_INFO, max_pooling) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t op = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_max_pooling2d_nhwc_u8(
+      0, 0, 0, 0,
+      2, 2,
+      2, 2,
+      1, 1,
+      8,
+      0, 255,
+      0 /* flags */,
+      &op));
+
+  std::vector<uint8_t> input(8 * 8 * 8);
+  std::vector<uint8_t> output(4 * 4 * 8);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_max_pooling2d_nhwc_u8(op, 1, 8, 8, input.data(), 8, output.data(), 8, nullptr));
+
+  qnnp_operator_info info;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(op, &info));
+  EXPECT_EQ(qnnp_operator_path_none, info.path);
+  EXPECT_EQ(nullptr, info.ukernel);
+  EXPECT_EQ(0u, info.packed_kernel_size);
+  /* Pooling reads its input through a depthwise indirection buffer */
+  EXPECT_NE(0u, info.im2col_buffer_size);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
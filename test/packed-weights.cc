@@ -0,0 +1,654 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <qnnpack.h>
+
+
+namespace {
+
+struct ConvolutionParameters {
+  uint32_t padding;
+  uint32_t kernelSize;
+  uint32_t groups;
+  size_t groupInputChannels;
+  size_t groupOutputChannels;
+  uint32_t flags;
+};
+
+qnnp_operator_t createConvolution(
+    const ConvolutionParameters& p,
+    const uint8_t* kernel, const int32_t* bias,
+    qnnp_packed_weights_t packedWeights,
+    uint8_t outputZeroPoint,
+    enum qnnp_status expectedStatus = qnnp_status_success)
+{
+  qnnp_operator_t op = nullptr;
+  const float outputScale = 1.0f * p.kernelSize * p.kernelSize * p.groupInputChannels;
+  if (packedWeights == nullptr) {
+    EXPECT_EQ(expectedStatus,
+      qnnp_create_convolution2d_nhwc_q8(
+        p.padding, p.padding, p.padding, p.padding,
+        p.kernelSize, p.kernelSize,
+        1, 1,
+        1, 1,
+        p.groups, p.groupInputChannels, p.groupOutputChannels,
+        127, 1.0f,
+        127, 1.0f,
+        kernel, bias,
+        outputZeroPoint, outputScale, 0, 255,
+        p.flags,
+        &op));
+  } else {
+    EXPECT_EQ(expectedStatus,
+      qnnp_create_convolution2d_nhwc_q8_with_packed_weights(
+        p.padding, p.padding, p.padding, p.padding,
+        p.kernelSize, p.kernelSize,
+        1, 1,
+        1, 1,
+        p.groups, p.groupInputChannels, p.groupOutputChannels,
+        127, 1.0f,
+        127, 1.0f,
+        packedWeights,
+        outputZeroPoint, outputScale, 0, 255,
+        p.flags,
+        &op));
+  }
+  return op;
+}
+
+std::vector<uint8_t> runConvolution(
+    qnnp_operator_t op, const ConvolutionParameters& p,
+    size_t height, size_t width, const std::vector<uint8_t>& input)
+{
+  const size_t outputHeight = height + 2 * p.padding - p.kernelSize + 1;
+  const size_t outputWidth = width + 2 * p.padding - p.kernelSize + 1;
+  const size_t outputChannels = p.groups * p.groupOutputChannels;
+  std::vector<uint8_t> output(outputHeight * outputWidth * outputChannels);
+  EXPECT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(
+      op, 1, height, width,
+      input.data() + 8, p.groups * p.groupInputChannels,
+      output.data(), outputChannels,
+      nullptr));
+  EXPECT_EQ(qnnp_status_success, qnnp_run_operator(op, nullptr));
+  return output;
+}
+
+/*
+ * Creates a convolution from a kernel and a second one from its packed weights, and checks that the second one gives
+ * the same results on a differently shaped input, including after the first one is deleted.
+ */
+void testSharedConvolution(const ConvolutionParameters& p) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  std::vector<uint8_t> kernel(p.groups * p.groupOutputChannels * p.kernelSize * p.kernelSize * p.groupInputChannels);
+  std::vector<int32_t> bias(p.groups * p.groupOutputChannels);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  qnnp_operator_t original = createConvolution(p, kernel.data(), bias.data(), nullptr, 127);
+  ASSERT_NE(nullptr, original);
+  qnnp_operator_t reference = createConvolution(p, kernel.data(), bias.data(), nullptr, 120);
+  ASSERT_NE(nullptr, reference);
+
+  qnnp_packed_weights_t packedWeights = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_packed_weights(original, &packedWeights));
+  /* Output quantization is not part of the packed weights and may differ */
+  qnnp_operator_t shared = createConvolution(p, nullptr, nullptr, packedWeights, 120);
+  ASSERT_NE(nullptr, shared);
+  ASSERT_EQ(qnnp_status_success, qnnp_release_packed_weights(packedWeights));
+
+  std::vector<uint8_t> input(9 * 7 * p.groups * p.groupInputChannels + 8);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  ASSERT_EQ(runConvolution(reference, p, 9, 7, input), runConvolution(shared, p, 9, 7, input));
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+
+  input.resize(5 * 11 * p.groups * p.groupInputChannels + 8);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  ASSERT_EQ(runConvolution(reference, p, 5, 11, input), runConvolution(shared, p, 5, 11, input));
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(shared));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(reference));
+}
+
+/*
+ * Clones a convolution several times, and checks that the clones, set up for different input shapes and run on
+ * their own threads at once, give the same results as the convolution.
+ */
+void testClonedConvolution(const ConvolutionParameters& p) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  std::vector<uint8_t> kernel(p.groups * p.groupOutputChannels * p.kernelSize * p.kernelSize * p.groupInputChannels);
+  std::vector<int32_t> bias(p.groups * p.groupOutputChannels);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  qnnp_operator_t original = createConvolution(p, kernel.data(), bias.data(), nullptr, 127);
+  ASSERT_NE(nullptr, original);
+
+  const size_t clonesCount = 4;
+  std::vector<qnnp_operator_t> clones(clonesCount);
+  std::vector<std::vector<uint8_t>> inputs(clonesCount);
+  std::vector<std::vector<uint8_t>> references(clonesCount);
+  for (size_t i = 0; i < clonesCount; i++) {
+    ASSERT_EQ(qnnp_status_success, qnnp_clone_operator(original, &clones[i]));
+    inputs[i].resize((5 + i) * (11 - i) * p.groups * p.groupInputChannels + 8);
+    std::generate(inputs[i].begin(), inputs[i].end(), std::ref(u8rng));
+    references[i] = runConvolution(original, p, 5 + i, 11 - i, inputs[i]);
+  }
+  /* Clones keep the packed weights after the operator they were cloned from is deleted */
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+
+  std::vector<std::vector<uint8_t>> outputs(clonesCount);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < clonesCount; i++) {
+    threads.emplace_back([&, i]() {
+      outputs[i] = runConvolution(clones[i], p, 5 + i, 11 - i, inputs[i]);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < clonesCount; i++) {
+    ASSERT_EQ(references[i], outputs[i]) << "clone " << i;
+    ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(clones[i]));
+  }
+}
+
+}  // namespace
+
+TEST(PACKED_WEIGHTS, convolution) {
+  testSharedConvolution({ 1, 3, 1, 7, 15 });
+}
+
+TEST(PACKED_WEIGHTS, grouped_convolution) {
+  testSharedConvolution({ 1, 3, 2, 5, 9 });
+}
+
+TEST(PACKED_WEIGHTS, grouped_convolution_with_few_output_channels) {
+  testSharedConvolution({ 1, 3, 6, 5, 2 });
+}
+
+TEST(PACKED_WEIGHTS, pointwise_convolution) {
+  testSharedConvolution({ 0, 1, 1, 23, 17 });
+}
+
+TEST(PACKED_WEIGHTS, depthwise_convolution) {
+  testSharedConvolution({ 1, 3, 19, 1, 1 });
+}
+
+TEST(PACKED_WEIGHTS, nchw_convolution) {
+  testSharedConvolution({ 1, 3, 1, 3, 16, QNNP_CREATE_FLAG_INPUT_NCHW });
+}
+
+TEST(PACKED_WEIGHTS, sparse_pointwise_convolution) {
+  testSharedConvolution({ 0, 1, 1, 23, 17, QNNP_CREATE_FLAG_SPARSE_KERNEL });
+}
+
+TEST(PACKED_WEIGHTS, mismatched_parameters) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  const ConvolutionParameters p = { 1, 3, 1, 7, 15 };
+  std::vector<uint8_t> kernel(p.groupOutputChannels * p.kernelSize * p.kernelSize * p.groupInputChannels, 130);
+  std::vector<int32_t> bias(p.groupOutputChannels);
+  qnnp_operator_t original = createConvolution(p, kernel.data(), bias.data(), nullptr, 127);
+  ASSERT_NE(nullptr, original);
+
+  qnnp_packed_weights_t packedWeights = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_packed_weights(original, &packedWeights));
+  ASSERT_EQ(nullptr, createConvolution({ 1, 3, 1, 7, 16 }, nullptr, nullptr, packedWeights, 127, qnnp_status_invalid_parameter));
+  ASSERT_EQ(nullptr, createConvolution({ 2, 5, 1, 7, 15 }, nullptr, nullptr, packedWeights, 127, qnnp_status_invalid_parameter));
+  ASSERT_EQ(nullptr,
+    createConvolution(
+      { 1, 3, 1, 7, 15, QNNP_CREATE_FLAG_INPUT_NCHW }, nullptr, nullptr, packedWeights, 127,
+      qnnp_status_invalid_parameter));
+
+  qnnp_operator_t fullyConnected = nullptr;
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_fully_connected_nc_q8_with_packed_weights(
+      7, 15, 127, 1.0f, 127, 1.0f, packedWeights, 127, 100.0f, 0, 255, 0 /* flags */, &fullyConnected));
+  ASSERT_EQ(nullptr, fullyConnected);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_release_packed_weights(packedWeights));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+}
+
+TEST(PACKED_WEIGHTS, fully_connected) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  const size_t inputChannels = 37;
+  const size_t outputChannels = 19;
+  std::vector<uint8_t> kernel(outputChannels * inputChannels);
+  std::vector<int32_t> bias(outputChannels);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  qnnp_operator_t original = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      inputChannels, outputChannels, 127, 1.0f, 127, 1.0f,
+      kernel.data(), bias.data(), 127, 100.0f, 0, 255, 0 /* flags */, &original));
+
+  qnnp_packed_weights_t packedWeights = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_packed_weights(original, &packedWeights));
+  qnnp_operator_t shared = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8_with_packed_weights(
+      inputChannels, outputChannels, 127, 1.0f, 127, 1.0f,
+      packedWeights, 127, 100.0f, 0, 255, 0 /* flags */, &shared));
+  ASSERT_EQ(qnnp_status_success, qnnp_release_packed_weights(packedWeights));
+
+  const size_t batchSize = 13;
+  std::vector<uint8_t> input(batchSize * inputChannels + 8);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::vector<uint8_t> originalOutput(batchSize * outputChannels);
+  std::vector<uint8_t> sharedOutput(batchSize * outputChannels);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(
+      original, batchSize, input.data(), inputChannels, originalOutput.data(), outputChannels, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(original, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(
+      shared, batchSize, input.data(), inputChannels, sharedOutput.data(), outputChannels, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(shared, nullptr));
+  ASSERT_EQ(originalOutput, sharedOutput);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(shared));
+}
+
+namespace {
+
+std::vector<uint64_t> serialize(qnnp_operator_t op) {
+  size_t size = 0;
+  EXPECT_EQ(qnnp_status_success, qnnp_serialize_operator(op, nullptr, &size));
+  /* uint64_t elements keep the data aligned like a memory-mapped file */
+  std::vector<uint64_t> data((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+  EXPECT_EQ(qnnp_status_success, qnnp_serialize_operator(op, data.data(), &size));
+  return data;
+}
+
+/*
+ * Serializes a convolution, deletes it, and checks that the operator loaded from the serialized data gives the same
+ * results as a convolution created from the same kernel.
+ */
+void testSerializedConvolution(const ConvolutionParameters& p) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  std::vector<uint8_t> kernel(p.groups * p.groupOutputChannels * p.kernelSize * p.kernelSize * p.groupInputChannels);
+  std::vector<int32_t> bias(p.groups * p.groupOutputChannels);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  qnnp_operator_t original = createConvolution(p, kernel.data(), bias.data(), nullptr, 127);
+  ASSERT_NE(nullptr, original);
+  qnnp_operator_t reference = createConvolution(p, kernel.data(), bias.data(), nullptr, 127);
+  ASSERT_NE(nullptr, reference);
+
+  const std::vector<uint64_t> data = serialize(original);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+
+  qnnp_operator_t loaded = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_operator_from_serialized(data.data(), data.size() * sizeof(uint64_t), &loaded));
+
+  std::vector<uint8_t> input(9 * 7 * p.groups * p.groupInputChannels + 8);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  ASSERT_EQ(runConvolution(reference, p, 9, 7, input), runConvolution(loaded, p, 9, 7, input));
+
+  /* Serializing the loaded operator reproduces the data */
+  ASSERT_EQ(data, serialize(loaded));
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(loaded));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(reference));
+}
+
+}  // namespace
+
+TEST(CLONE, convolution) {
+  testClonedConvolution({ 1, 3, 1, 7, 15 });
+}
+
+TEST(CLONE, grouped_convolution) {
+  testClonedConvolution({ 1, 3, 2, 5, 9 });
+}
+
+TEST(CLONE, pointwise_convolution) {
+  testClonedConvolution({ 0, 1, 1, 23, 17 });
+}
+
+TEST(CLONE, depthwise_convolution) {
+  testClonedConvolution({ 1, 3, 19, 1, 1 });
+}
+
+TEST(CLONE, tile_indirection_convolution) {
+  testClonedConvolution({ 1, 3, 1, 7, 15, QNNP_CREATE_FLAG_TILE_INDIRECTION });
+}
+
+TEST(CLONE, fully_connected) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  const size_t inputChannels = 37;
+  const size_t outputChannels = 19;
+  std::vector<uint8_t> kernel(outputChannels * inputChannels);
+  std::vector<int32_t> bias(outputChannels);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  qnnp_operator_t original = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      inputChannels, outputChannels, 127, 0.5f, 127, 0.25f,
+      kernel.data(), bias.data(), 127, 100.0f, 0, 255, 0 /* flags */, &original));
+  qnnp_operator_t clone = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_clone_operator(original, &clone));
+
+  const size_t batchSize = 13;
+  std::vector<uint8_t> input(batchSize * inputChannels + 8);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::vector<uint8_t> originalOutput(batchSize * outputChannels), cloneOutput(batchSize * outputChannels);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(
+      original, batchSize, input.data(), inputChannels, originalOutput.data(), outputChannels, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(original, nullptr));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(
+      clone, batchSize, input.data(), inputChannels, cloneOutput.data(), outputChannels, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(clone, nullptr));
+  ASSERT_EQ(originalOutput, cloneOutput);
+
+  /* Dequantized accumulators use the scales of the operator that was cloned */
+  std::vector<float> originalAccumulators(batchSize * outputChannels), cloneAccumulators(batchSize * outputChannels);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8_f32(
+      original, batchSize, input.data(), inputChannels, originalAccumulators.data(), outputChannels, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(original, nullptr));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8_f32(
+      clone, batchSize, input.data(), inputChannels, cloneAccumulators.data(), outputChannels, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(clone, nullptr));
+  ASSERT_EQ(originalAccumulators, cloneAccumulators);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(clone));
+}
+
+TEST(CLONE, unsupported_operator) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t add = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_add_nc_q8(8, 127, 1.0f, 127, 1.0f, 127, 2.0f, 0, 255, 0 /* flags */, &add));
+  qnnp_operator_t clone = nullptr;
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_clone_operator(add, &clone));
+  ASSERT_EQ(nullptr, clone);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(add));
+}
+
+TEST(SERIALIZATION, convolution) {
+  testSerializedConvolution({ 1, 3, 1, 7, 15 });
+}
+
+TEST(SERIALIZATION, pointwise_convolution) {
+  testSerializedConvolution({ 0, 1, 2, 23, 17 });
+}
+
+TEST(SERIALIZATION, sparse_pointwise_convolution) {
+  testSerializedConvolution({ 0, 1, 1, 23, 17, QNNP_CREATE_FLAG_SPARSE_KERNEL });
+}
+
+TEST(SERIALIZATION, grouped_convolution_with_few_output_channels) {
+  testSerializedConvolution({ 0, 1, 8, 6, 3 });
+}
+
+TEST(SERIALIZATION, depthwise_convolution) {
+  testSerializedConvolution({ 2, 5, 19, 1, 2 });
+}
+
+TEST(SERIALIZATION, nchw_convolution) {
+  testSerializedConvolution({ 1, 3, 1, 3, 16, QNNP_CREATE_FLAG_INPUT_NCHW });
+}
+
+TEST(SERIALIZATION, fully_connected) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::vector<uint8_t> kernel(5 * 3, 131);
+  std::vector<int32_t> bias(5, 1000);
+  qnnp_operator_t original = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      3, 5, 127, 1.0f, 127, 1.0f,
+      kernel.data(), bias.data(), 100, 20.0f, 0, 255, 0 /* flags */, &original));
+  const std::vector<uint64_t> data = serialize(original);
+
+  qnnp_operator_t loaded = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_operator_from_serialized(data.data(), data.size() * sizeof(uint64_t), &loaded));
+
+  /* Microkernels may read up to 8 bytes before the rows when there are fewer than 8 channels */
+  const std::vector<uint8_t> input = { 0, 0, 0, 0, 0, 0, 0, 0, 127, 128, 129, 120, 130, 140 };
+  std::vector<uint8_t> originalOutput(2 * 5), loadedOutput(2 * 5);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(original, 2, input.data() + 8, 3, originalOutput.data(), 5, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(original, nullptr));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(loaded, 2, input.data() + 8, 3, loadedOutput.data(), 5, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(loaded, nullptr));
+  ASSERT_EQ(originalOutput, loadedOutput);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(loaded));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+}
+
+TEST(SERIALIZATION, fully_connected_4bit_kernel) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::vector<uint8_t> kernel(5 * 3);
+  for (size_t i = 0; i < kernel.size(); i++) {
+    kernel[i] = uint8_t(i * 7 % 16);
+  }
+  std::vector<int32_t> bias(5, 1000);
+  qnnp_operator_t original = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      3, 5, 127, 1.0f, 7, 1.0f,
+      kernel.data(), bias.data(), 100, 20.0f, 0, 255, QNNP_CREATE_FLAG_4BIT_KERNEL, &original));
+  const std::vector<uint64_t> data = serialize(original);
+
+  qnnp_operator_t loaded = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_operator_from_serialized(data.data(), data.size() * sizeof(uint64_t), &loaded));
+  qnnp_operator_info originalInfo, loadedInfo;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(original, &originalInfo));
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_info(loaded, &loadedInfo));
+  EXPECT_EQ(
+    originalInfo.flags & QNNP_OPERATOR_INFO_FLAG_4BIT_KERNEL, loadedInfo.flags & QNNP_OPERATOR_INFO_FLAG_4BIT_KERNEL);
+
+  /* Microkernels may read up to 8 bytes before the rows when there are fewer than 8 channels */
+  const std::vector<uint8_t> input = { 0, 0, 0, 0, 0, 0, 0, 0, 127, 128, 129, 120, 130, 140 };
+  std::vector<uint8_t> originalOutput(2 * 5), loadedOutput(2 * 5);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(original, 2, input.data() + 8, 3, originalOutput.data(), 5, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(original, nullptr));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(loaded, 2, input.data() + 8, 3, loadedOutput.data(), 5, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(loaded, nullptr));
+  ASSERT_EQ(originalOutput, loadedOutput);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(loaded));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+}
+
+TEST(SERIALIZATION, fully_connected_from_file) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  std::vector<uint8_t> kernel(24 * 40);
+  std::vector<int32_t> bias(24, 1000);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  qnnp_operator_t original = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      40, 24, 127, 1.0f, 127, 1.0f,
+      kernel.data(), bias.data(), 100, 20.0f, 0, 255, 0 /* flags */, &original));
+  size_t size = 0;
+  ASSERT_EQ(qnnp_status_success, qnnp_serialize_operator(original, nullptr, &size));
+  std::vector<uint8_t> data(size);
+  ASSERT_EQ(qnnp_status_success, qnnp_serialize_operator(original, data.data(), &size));
+
+  char path[] = "/tmp/qnnpack-serialized-XXXXXX";
+  const int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(ssize_t(size), write(fd, data.data(), size));
+  ASSERT_EQ(0, close(fd));
+
+  qnnp_operator_t loaded = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_operator_from_file(path, &loaded));
+  /* The mapping keeps the weights of the removed file */
+  ASSERT_EQ(0, unlink(path));
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_create_operator_from_file(path, &loaded));
+
+  /* An operator that shares the mapped weights keeps the mapping after the loaded operator is deleted */
+  qnnp_packed_weights_t packedWeights = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_packed_weights(loaded, &packedWeights));
+  qnnp_operator_t shared = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8_with_packed_weights(
+      40, 24, 127, 0.05f, 127, 1.0f, packedWeights, 100, 1.0f, 0, 255, 0 /* flags */, &shared));
+  ASSERT_EQ(qnnp_status_success, qnnp_release_packed_weights(packedWeights));
+
+  std::vector<uint8_t> input(3 * 40);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::vector<uint8_t> originalOutput(3 * 24), loadedOutput(3 * 24), sharedOutput(3 * 24);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(original, 3, input.data(), 40, originalOutput.data(), 24, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(original, nullptr));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(loaded, 3, input.data(), 40, loadedOutput.data(), 24, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(loaded, nullptr));
+  ASSERT_EQ(originalOutput, loadedOutput);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(loaded));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(shared, 3, input.data(), 40, sharedOutput.data(), 24, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(shared, nullptr));
+  ASSERT_EQ(originalOutput, sharedOutput);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(shared));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+}
+
+TEST(SERIALIZATION, invalid_data) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::vector<uint8_t> kernel(5 * 3, 131);
+  std::vector<int32_t> bias(5, 1000);
+  qnnp_operator_t original = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      3, 5, 127, 1.0f, 127, 1.0f,
+      kernel.data(), bias.data(), 100, 20.0f, 0, 255, 0 /* flags */, &original));
+  std::vector<uint64_t> data = serialize(original);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(original));
+
+  qnnp_operator_t loaded = nullptr;
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_operator_from_serialized(data.data(), data.size() * sizeof(uint64_t) - 8, &loaded));
+  data[0] ^= 1;
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_operator_from_serialized(data.data(), data.size() * sizeof(uint64_t), &loaded));
+  ASSERT_EQ(nullptr, loaded);
+}
+
+TEST(PACKED_WEIGHTS, lazy_packing) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  const ConvolutionParameters p = { 1, 3, 2, 5, 9 };
+  std::vector<uint8_t> kernel(p.groups * p.groupOutputChannels * p.kernelSize * p.kernelSize * p.groupInputChannels);
+  std::vector<int32_t> bias(p.groups * p.groupOutputChannels);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  qnnp_operator_t reference = createConvolution(p, kernel.data(), bias.data(), nullptr, 127);
+  ASSERT_NE(nullptr, reference);
+  qnnp_operator_t lazy = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      p.padding, p.padding, p.padding, p.padding,
+      p.kernelSize, p.kernelSize,
+      1, 1,
+      1, 1,
+      p.groups, p.groupInputChannels, p.groupOutputChannels,
+      127, 1.0f,
+      127, 1.0f,
+      kernel.data(), bias.data(),
+      127, 1.0f * p.kernelSize * p.kernelSize * p.groupInputChannels, 0, 255,
+      QNNP_CREATE_FLAG_LAZY_PACKING,
+      &lazy));
+
+  /* Weights obtained before packing get packed by whichever operator runs first */
+  qnnp_packed_weights_t packedWeights = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_packed_weights(lazy, &packedWeights));
+  qnnp_operator_t shared = createConvolution(p, nullptr, nullptr, packedWeights, 127);
+  ASSERT_NE(nullptr, shared);
+  ASSERT_EQ(qnnp_status_success, qnnp_release_packed_weights(packedWeights));
+
+  std::vector<uint8_t> input(9 * 7 * p.groups * p.groupInputChannels + 8);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  const std::vector<uint8_t> referenceOutput = runConvolution(reference, p, 9, 7, input);
+  ASSERT_EQ(referenceOutput, runConvolution(shared, p, 9, 7, input));
+  ASSERT_EQ(referenceOutput, runConvolution(lazy, p, 9, 7, input));
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(lazy));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(shared));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(reference));
+}
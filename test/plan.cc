@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <cpuinfo.h>
+#include <qnnpack.h>
+
+
+namespace {
+
+struct Layer {
+  /* 0: convolution, 1: deconvolution, 2: fully-connected */
+  int type;
+  uint32_t kernelSize;
+  uint32_t stride;
+  uint32_t padding;
+  uint32_t groups;
+  size_t groupInputChannels;
+  size_t groupOutputChannels;
+};
+
+qnnp_operator_t createOperator(const Layer& layer, const std::vector<uint8_t>& kernel, const std::vector<int32_t>& bias) {
+  const uint8_t inputZeroPoint = 127;
+  const uint8_t kernelZeroPoint = 127;
+  const float outputScale = 1.0f * layer.kernelSize * layer.kernelSize * layer.groupInputChannels;
+  qnnp_operator_t op = nullptr;
+  switch (layer.type) {
+    case 0:
+      EXPECT_EQ(qnnp_status_success,
+        qnnp_create_convolution2d_nhwc_q8(
+          layer.padding, layer.padding, layer.padding, layer.padding,
+          layer.kernelSize, layer.kernelSize,
+          layer.stride, layer.stride,
+          1, 1,
+          layer.groups, layer.groupInputChannels, layer.groupOutputChannels,
+          inputZeroPoint, 1.0f,
+          kernelZeroPoint, 1.0f,
+          kernel.data(), bias.data(),
+          127, outputScale, 0, 255,
+          0 /* flags */,
+          &op));
+      break;
+    case 1:
+      EXPECT_EQ(qnnp_status_success,
+        qnnp_create_deconvolution2d_nhwc_q8(
+          layer.padding, layer.padding, layer.padding, layer.padding,
+          0, 0,
+          layer.kernelSize, layer.kernelSize,
+          layer.stride, layer.stride,
+          1, 1,
+          layer.groups, layer.groupInputChannels, layer.groupOutputChannels,
+          inputZeroPoint, 1.0f,
+          kernelZeroPoint, 1.0f,
+          kernel.data(), bias.data(),
+          127, outputScale, 0, 255,
+          0 /* flags */,
+          &op));
+      break;
+    case 2:
+      EXPECT_EQ(qnnp_status_success,
+        qnnp_create_fully_connected_nc_q8(
+          layer.groupInputChannels, layer.groupOutputChannels,
+          inputZeroPoint, 1.0f,
+          kernelZeroPoint, 1.0f,
+          kernel.data(), bias.data(),
+          127, outputScale, 0, 255,
+          0 /* flags */,
+          &op));
+      break;
+  }
+  return op;
+}
+
+/* How the plan runs its operators */
+struct PlanThreads {
+  qnnp_affinity_pool_t affinityPool{nullptr};
+  bool spinWait{false};
+  uint64_t serialMacsThreshold{0};
+  /* If not NULL, the plan operators get a scheduler that counts the parallel loops it runs here */
+  size_t* scheduledLoops{nullptr};
+};
+
+void parallelizeCounted(void* context, qnnp_task_function task, void* taskContext, size_t tasks) {
+  *static_cast<size_t*>(context) += 1;
+  for (size_t i = 0; i < tasks; i++) {
+    task(taskContext, i);
+  }
+}
+
+/*
+ * Runs the layers as a plan and as individually set up operators with their own buffers, and checks that both give
+ * the same output. With snapshot, the plan runs once, and a plan restored from its snapshot file runs instead.
+ */
+void testPlan(
+    size_t batchSize, size_t inputHeight, size_t inputWidth, size_t inputChannels,
+    const std::vector<Layer>& layers,
+    bool callerMemory = false,
+    const PlanThreads& threads = PlanThreads(),
+    bool snapshot = false)
+{
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  std::function<uint8_t()> u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  std::function<int32_t()> s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  std::vector<qnnp_operator_t> planOperators;
+  std::vector<qnnp_operator_t> referenceOperators;
+  for (const Layer& layer : layers) {
+    std::vector<uint8_t> kernel(
+      layer.groups * layer.groupOutputChannels * layer.kernelSize * layer.kernelSize * layer.groupInputChannels);
+    std::vector<int32_t> bias(layer.groups * layer.groupOutputChannels);
+    std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+    std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+    planOperators.push_back(createOperator(layer, kernel, bias));
+    referenceOperators.push_back(createOperator(layer, kernel, bias));
+    if (threads.scheduledLoops != nullptr) {
+      const qnnp_scheduler scheduler = { parallelizeCounted, threads.scheduledLoops, 2 };
+      ASSERT_EQ(qnnp_status_success, qnnp_set_operator_scheduler(planOperators.back(), &scheduler));
+    }
+  }
+
+  qnnp_plan_t plan = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_plan(batchSize, inputHeight, inputWidth, inputChannels, &plan));
+  for (qnnp_operator_t op : planOperators) {
+    ASSERT_EQ(qnnp_status_success, qnnp_plan_add_operator(plan, op));
+  }
+  size_t outputHeight, outputWidth, outputChannels;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_plan_output_shape(plan, &outputHeight, &outputWidth, &outputChannels));
+  if (snapshot) {
+    std::vector<uint8_t> snapshotInput(batchSize * inputHeight * inputWidth * inputChannels + 8);
+    std::vector<uint8_t> snapshotOutput(batchSize * outputHeight * outputWidth * outputChannels);
+    ASSERT_EQ(qnnp_status_success, qnnp_plan_run(plan, snapshotInput.data() + 8, snapshotOutput.data(), nullptr));
+    size_t size = 0;
+    ASSERT_EQ(qnnp_status_success, qnnp_serialize_plan(plan, nullptr, &size));
+    std::vector<uint8_t> data(size);
+    ASSERT_EQ(qnnp_status_success, qnnp_serialize_plan(plan, data.data(), &size));
+    ASSERT_EQ(qnnp_status_success, qnnp_delete_plan(plan));
+
+    char path[] = "/tmp/qnnpack-plan-XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ssize_t(size), write(fd, data.data(), size));
+    ASSERT_EQ(0, close(fd));
+    plan = nullptr;
+    ASSERT_EQ(qnnp_status_success, qnnp_create_plan_from_file(path, &plan));
+    ASSERT_EQ(0, unlink(path));
+  }
+  if (threads.affinityPool != nullptr) {
+    ASSERT_EQ(qnnp_status_success, qnnp_plan_set_affinity_pool(plan, threads.affinityPool, threads.spinWait));
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_plan_set_serial_threshold(plan, threads.serialMacsThreshold));
+
+  std::vector<uint64_t> memory;
+  if (callerMemory) {
+    size_t memorySize = 0;
+    ASSERT_EQ(qnnp_status_success, qnnp_get_plan_memory_size(plan, &memorySize));
+    memory.resize(memorySize / sizeof(uint64_t) + 2);
+    /* 16-byte aligned, as the plan requires */
+    void* alignedMemory = reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(memory.data()) + 15) & ~uintptr_t(15));
+    ASSERT_EQ(qnnp_status_success, qnnp_plan_set_memory(plan, alignedMemory, memorySize));
+  }
+
+  std::vector<uint8_t> input(batchSize * inputHeight * inputWidth * inputChannels + 8);
+  /* Alternate between two output buffers to exercise setup of the last operator on later runs */
+  std::vector<uint8_t> planOutputs[2] = {
+    std::vector<uint8_t>(batchSize * outputHeight * outputWidth * outputChannels),
+    std::vector<uint8_t>(batchSize * outputHeight * outputWidth * outputChannels),
+  };
+  for (size_t iteration = 0; iteration < 3; iteration++) {
+    std::vector<uint8_t>& planOutput = planOutputs[iteration % 2];
+    std::generate(input.begin(), input.end(), std::ref(u8rng));
+
+    /* Reference: every operator reads the dense output of the previous one, preceded by 8 bytes of padding */
+    std::vector<uint8_t> layerInput(input);
+    size_t height = inputHeight, width = inputWidth, channels = inputChannels;
+    for (size_t i = 0; i < layers.size(); i++) {
+      const Layer& layer = layers[i];
+      const size_t outputChannelsI = layer.groups * layer.groupOutputChannels;
+      size_t nextHeight = height, nextWidth = width;
+      if (layer.type == 0) {
+        nextHeight = (height + 2 * layer.padding - layer.kernelSize) / layer.stride + 1;
+        nextWidth = (width + 2 * layer.padding - layer.kernelSize) / layer.stride + 1;
+      } else if (layer.type == 1) {
+        nextHeight = layer.stride * (height - 1) + layer.kernelSize - 2 * layer.padding;
+        nextWidth = layer.stride * (width - 1) + layer.kernelSize - 2 * layer.padding;
+      }
+      const bool flatten = layer.type == 2 && layer.groupInputChannels != channels;
+      if (flatten) {
+        nextHeight = 1;
+        nextWidth = 1;
+      }
+      std::vector<uint8_t> layerOutput(batchSize * nextHeight * nextWidth * outputChannelsI + 8);
+      switch (layer.type) {
+        case 0:
+          ASSERT_EQ(qnnp_status_success,
+            qnnp_setup_convolution2d_nhwc_q8(
+              referenceOperators[i], batchSize, height, width,
+              layerInput.data() + 8, channels,
+              layerOutput.data() + 8, outputChannelsI,
+              nullptr));
+          break;
+        case 1:
+          ASSERT_EQ(qnnp_status_success,
+            qnnp_setup_deconvolution2d_nhwc_q8(
+              referenceOperators[i], batchSize, height, width,
+              layerInput.data() + 8, channels,
+              layerOutput.data() + 8, outputChannelsI,
+              nullptr));
+          break;
+        case 2:
+          ASSERT_EQ(qnnp_status_success,
+            qnnp_setup_fully_connected_nc_q8(
+              referenceOperators[i],
+              flatten ? batchSize : batchSize * height * width,
+              layerInput.data() + 8, flatten ? height * width * channels : channels,
+              layerOutput.data() + 8, outputChannelsI,
+              nullptr));
+          break;
+      }
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(referenceOperators[i], nullptr));
+      layerInput = layerOutput;
+      height = nextHeight;
+      width = nextWidth;
+      channels = outputChannelsI;
+    }
+    ASSERT_EQ(outputHeight, height);
+    ASSERT_EQ(outputWidth, width);
+    ASSERT_EQ(outputChannels, channels);
+
+    ASSERT_EQ(qnnp_status_success, qnnp_plan_run(plan, input.data() + 8, planOutput.data(), nullptr));
+    for (size_t i = 0; i < planOutput.size(); i++) {
+      ASSERT_EQ(uint32_t(layerInput[i + 8]), uint32_t(planOutput[i])) << "at position " << i << ", iteration " << iteration;
+    }
+  }
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_plan(plan));
+  for (qnnp_operator_t op : planOperators) {
+    ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+  }
+  for (qnnp_operator_t op : referenceOperators) {
+    ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+  }
+}
+
+}  // namespace
+
+TEST(PLAN, single_convolution) {
+  testPlan(1, 13, 11, 7, {
+    { 0, 3, 1, 1, 1, 7, 15 },
+  });
+}
+
+TEST(PLAN, convolution_chain) {
+  testPlan(2, 13, 11, 7, {
+    { 0, 3, 2, 1, 1, 7, 16 },
+    { 0, 3, 1, 1, 16, 1, 1 },
+    { 0, 1, 1, 0, 1, 16, 24 },
+    { 0, 1, 1, 0, 2, 12, 5 },
+  });
+}
+
+TEST(PLAN, deconvolution_in_chain) {
+  testPlan(1, 7, 9, 5, {
+    { 0, 3, 1, 1, 1, 5, 12 },
+    { 1, 3, 2, 1, 1, 12, 9 },
+    { 0, 1, 1, 0, 1, 9, 4 },
+  });
+}
+
+TEST(PLAN, fully_connected_per_pixel) {
+  testPlan(3, 5, 6, 17, {
+    { 2, 1, 1, 0, 1, 17, 9 },
+    { 0, 3, 1, 1, 1, 9, 10 },
+  });
+}
+
+TEST(PLAN, depthwise_with_multiplier) {
+  testPlan(1, 9, 9, 8, {
+    { 0, 3, 1, 1, 8, 1, 2 },
+    { 0, 1, 1, 0, 1, 16, 8 },
+  });
+}
+
+TEST(PLAN, caller_memory) {
+  testPlan(2, 13, 11, 7, {
+    { 0, 3, 2, 1, 1, 7, 16 },
+    { 0, 3, 1, 1, 16, 1, 2 },
+    { 1, 3, 2, 1, 1, 32, 9 },
+    { 2, 1, 1, 0, 1, 9, 4 },
+  }, true);
+}
+
+TEST(PLAN, fully_connected_flatten) {
+  testPlan(3, 7, 7, 3, {
+    { 0, 3, 2, 0, 1, 3, 8 },
+    { 2, 1, 1, 0, 1, 3 * 3 * 8, 10 },
+    { 2, 1, 1, 0, 1, 10, 4 },
+  });
+}
+
+TEST(PLAN, affinity_pool_spin_wait) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  /* Two threads on the processor the test runs on, which the process may use */
+  uint32_t processor = 0;
+  for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+    if (cpuinfo_get_processor(i)->linux_id == sched_getcpu()) {
+      processor = i;
+    }
+  }
+  const uint32_t processors[2] = { processor, processor };
+  PlanThreads threads;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_affinity_pool(2, processors, &threads.affinityPool));
+  for (bool spinWait : { false, true }) {
+    threads.spinWait = spinWait;
+    testPlan(1, 14, 14, 24, {
+      { 0, 1, 1, 0, 8, 3, 11 },
+      { 0, 3, 1, 1, 88, 1, 1 },
+      { 0, 1, 1, 0, 8, 11, 3 },
+    }, false, threads);
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_affinity_pool(threads.affinityPool));
+}
+
+TEST(PLAN, serial_threshold) {
+  const std::vector<Layer> layers = {
+    { 0, 1, 1, 0, 1, 7, 16 },
+    { 0, 3, 1, 1, 16, 1, 1 },
+    { 2, 1, 1, 0, 1, 16, 5 },
+  };
+  size_t scheduledLoops = 0;
+  PlanThreads threads;
+  threads.scheduledLoops = &scheduledLoops;
+  testPlan(2, 7, 5, 7, layers, false, threads);
+  EXPECT_NE(0, scheduledLoops);
+
+  /* The largest layer is the depthwise one, with 2 * 7 * 5 * 16 * 9 multiply-adds */
+  scheduledLoops = 0;
+  threads.serialMacsThreshold = 2 * 7 * 5 * 16 * 9 + 1;
+  testPlan(2, 7, 5, 7, layers, false, threads);
+  EXPECT_EQ(0, scheduledLoops);
+}
+
+TEST(PLAN, snapshot_convolution_chain) {
+  testPlan(2, 13, 11, 7, {
+    { 0, 3, 2, 1, 1, 7, 16 },
+    { 0, 3, 1, 1, 16, 1, 1 },
+    { 0, 1, 1, 0, 1, 16, 24 },
+    { 0, 1, 1, 0, 2, 12, 5 },
+  }, false, PlanThreads(), true);
+}
+
+TEST(PLAN, snapshot_deconvolution_and_fully_connected) {
+  testPlan(1, 7, 9, 5, {
+    { 0, 3, 1, 1, 1, 5, 12 },
+    { 1, 3, 2, 1, 1, 12, 9 },
+    { 2, 1, 1, 0, 1, 9, 4 },
+  }, false, PlanThreads(), true);
+}
+
+TEST(PLAN, snapshot_depthwise_with_multiplier) {
+  testPlan(1, 9, 9, 8, {
+    { 0, 3, 1, 1, 8, 1, 2 },
+    { 0, 1, 1, 0, 1, 16, 8 },
+  }, false, PlanThreads(), true);
+}
+
+TEST(PLAN, snapshot_caller_memory) {
+  testPlan(2, 13, 11, 7, {
+    { 0, 3, 2, 1, 1, 7, 16 },
+    { 0, 3, 1, 1, 16, 1, 2 },
+    { 1, 3, 2, 1, 1, 32, 9 },
+    { 2, 1, 1, 0, 1, 9, 4 },
+  }, true, PlanThreads(), true);
+}
+
+TEST(PLAN, snapshot_validation) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const Layer layer = { 0, 3, 1, 1, 1, 7, 15 };
+  std::vector<uint8_t> kernel(15 * 3 * 3 * 7, 130);
+  std::vector<int32_t> bias(15, 100);
+  qnnp_operator_t op = createOperator(layer, kernel, bias);
+  qnnp_plan_t plan = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_plan(1, 5, 5, 7, &plan));
+  ASSERT_EQ(qnnp_status_success, qnnp_plan_add_operator(plan, op));
+
+  /* Only plans that ran have indirection buffers to store */
+  size_t size = 0;
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_serialize_plan(plan, nullptr, &size));
+  std::vector<uint8_t> input(5 * 5 * 7 + 8, 140);
+  std::vector<uint8_t> output(5 * 5 * 15);
+  ASSERT_EQ(qnnp_status_success, qnnp_plan_run(plan, input.data() + 8, output.data(), nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_serialize_plan(plan, nullptr, &size));
+  /* 8-byte aligned, as restoring requires */
+  std::vector<uint64_t> data(size / sizeof(uint64_t) + 1);
+  ASSERT_EQ(qnnp_status_success, qnnp_serialize_plan(plan, data.data(), &size));
+
+  qnnp_plan_t restored = nullptr;
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_create_plan_from_serialized(data.data(), 64, &restored));
+
+  /* The header starts with the magic number, version, pointer size, and instruction set extensions of the writer */
+  uint32_t* header = reinterpret_cast<uint32_t*>(data.data());
+  header[3] ^= UINT32_C(0x80000000);
+  ASSERT_EQ(qnnp_status_unsupported_parameter, qnnp_create_plan_from_serialized(data.data(), size, &restored));
+  header[3] ^= UINT32_C(0x80000000);
+  header[0] ^= UINT32_C(1);
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_create_plan_from_serialized(data.data(), size, &restored));
+  header[0] ^= UINT32_C(1);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_create_plan_from_serialized(data.data(), size, &restored));
+  std::vector<uint8_t> restoredOutput(output.size());
+  ASSERT_EQ(qnnp_status_success, qnnp_plan_run(restored, input.data() + 8, restoredOutput.data(), nullptr));
+  ASSERT_EQ(output, restoredOutput);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_plan(restored));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_plan(plan));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <qnnpack/params.h>
+#include <qnnpack/requantization.h>
+
+
+class PoolMicrokernelTester {
+ public:
+  inline PoolMicrokernelTester& kernelSize(size_t kernelSize) {
+    assert(kernelSize != 0);
+    this->kernelSize_ = kernelSize;
+    return *this;
+  }
+
+  inline size_t kernelSize() const {
+    return this->kernelSize_;
+  }
+
+  inline PoolMicrokernelTester& channels(size_t channels) {
+    assert(channels != 0);
+    this->channels_ = channels;
+    return *this;
+  }
+
+  inline size_t channels() const {
+    return this->channels_;
+  }
+
+  inline PoolMicrokernelTester& outputWidth(size_t outputWidth) {
+    assert(outputWidth != 0);
+    this->outputWidth_ = outputWidth;
+    return *this;
+  }
+
+  inline size_t outputWidth() const {
+    return this->outputWidth_;
+  }
+
+  /* Input pointers between adjacent output pixels, as in depthwise indirection buffers */
+  inline PoolMicrokernelTester& inputStep(size_t inputStep) {
+    assert(inputStep != 0);
+    this->inputStep_ = inputStep;
+    return *this;
+  }
+
+  inline size_t inputStep() const {
+    if (this->inputStep_ == 0) {
+      return kernelSize();
+    } else {
+      return this->inputStep_;
+    }
+  }
+
+  inline PoolMicrokernelTester& inputOffset(size_t inputOffset) {
+    this->inputOffset_ = inputOffset;
+    return *this;
+  }
+
+  inline size_t inputOffset() const {
+    return this->inputOffset_;
+  }
+
+  inline PoolMicrokernelTester& outputStride(size_t outputStride) {
+    assert(outputStride != 0);
+    this->outputStride_ = outputStride;
+    return *this;
+  }
+
+  inline size_t outputStride() const {
+    if (this->outputStride_ == 0) {
+      return channels();
+    } else {
+      assert(this->outputStride_ >= channels());
+      return this->outputStride_;
+    }
+  }
+
+  inline PoolMicrokernelTester& xScale(float xScale) {
+    assert(xScale > 0.0f);
+    assert(std::isnormal(xScale));
+    this->xScale_ = xScale;
+    return *this;
+  }
+
+  inline float xScale() const {
+    return this->xScale_;
+  }
+
+  inline PoolMicrokernelTester& xZeroPoint(uint8_t xZeroPoint) {
+    this->xZeroPoint_ = xZeroPoint;
+    return *this;
+  }
+
+  inline uint8_t xZeroPoint() const {
+    return this->xZeroPoint_;
+  }
+
+  inline PoolMicrokernelTester& yScale(float yScale) {
+    assert(yScale > 0.0f);
+    assert(std::isnormal(yScale));
+    this->yScale_ = yScale;
+    return *this;
+  }
+
+  inline float yScale() const {
+    return this->yScale_;
+  }
+
+  inline PoolMicrokernelTester& yZeroPoint(uint8_t yZeroPoint) {
+    this->yZeroPoint_ = yZeroPoint;
+    return *this;
+  }
+
+  inline uint8_t yZeroPoint() const {
+    return this->yZeroPoint_;
+  }
+
+  inline PoolMicrokernelTester& qmin(uint8_t qmin) {
+    this->qmin_ = qmin;
+    return *this;
+  }
+
+  inline uint8_t qmin() const {
+    return this->qmin_;
+  }
+
+  inline PoolMicrokernelTester& qmax(uint8_t qmax) {
+    this->qmax_ = qmax;
+    return *this;
+  }
+
+  inline uint8_t qmax() const {
+    return this->qmax_;
+  }
+
+  inline PoolMicrokernelTester& iterations(size_t iterations) {
+    this->iterations_ = iterations;
+    return *this;
+  }
+
+  inline size_t iterations() const {
+    return this->iterations_;
+  }
+
+  void test(u8maxpool_ukernel_function u8maxpool) const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    const size_t pixels = (outputWidth() - 1) * inputStep() + kernelSize();
+    const size_t pixelStride = inputOffset() + channels();
+    std::vector<uint8_t> x(pixels * pixelStride);
+    std::vector<const uint8_t*> indirectionX(pixels);
+    std::vector<uint8_t> y((outputWidth() - 1) * outputStride() + channels());
+    std::vector<uint8_t> yRef(outputWidth() * channels());
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(x.begin(), x.end(), std::ref(u8rng));
+      std::fill(y.begin(), y.end(), 0xA5);
+      for (size_t i = 0; i < pixels; i++) {
+        indirectionX[i] = x.data() + i * pixelStride;
+      }
+      std::shuffle(indirectionX.begin(), indirectionX.end(), rng);
+
+      /* Prepare clamping parameters */
+      const union qnnp_u8_clamping_params clampingParams = qnnp_compute_u8_clamping_params(qmin(), qmax());
+
+      /* Compute reference results */
+      for (size_t i = 0; i < outputWidth(); i++) {
+        for (size_t c = 0; c < channels(); c++) {
+          uint8_t max = 0;
+          for (size_t k = 0; k < kernelSize(); k++) {
+            max = std::max(max, indirectionX[i * inputStep() + k][inputOffset() + c]);
+          }
+          yRef[i * channels() + c] = std::min(std::max(max, qmin()), qmax());
+        }
+      }
+
+      /* Call optimized micro-kernel */
+      u8maxpool(
+        channels(), outputWidth(), kernelSize(),
+        indirectionX.data(), y.data(),
+        inputStep() * sizeof(void*),
+        (outputStride() - channels()) * sizeof(uint8_t),
+        inputOffset() * sizeof(uint8_t),
+        &clampingParams);
+
+      /* Verify results */
+      for (size_t i = 0; i < outputWidth(); i++) {
+        for (size_t c = 0; c < channels(); c++) {
+          ASSERT_EQ(uint32_t(yRef[i * channels() + c]), uint32_t(y[i * outputStride() + c]))
+            << "at pixel " << i << ", channel " << c << ", kernel size = " << kernelSize()
+            << ", channels = " << channels();
+        }
+      }
+    }
+  }
+
+  void test(q8avgpool_ukernel_function q8avgpool) const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    const size_t pixels = (outputWidth() - 1) * inputStep() + kernelSize();
+    const size_t pixelStride = inputOffset() + channels();
+    std::vector<uint8_t> x(pixels * pixelStride);
+    std::vector<const uint8_t*> indirectionX(pixels);
+    std::vector<uint8_t> y((outputWidth() - 1) * outputStride() + channels());
+    std::vector<float> yFP(outputWidth() * channels());
+    std::vector<uint8_t> yRef(outputWidth() * channels());
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(x.begin(), x.end(), std::ref(u8rng));
+      std::fill(y.begin(), y.end(), 0xA5);
+      for (size_t i = 0; i < pixels; i++) {
+        indirectionX[i] = x.data() + i * pixelStride;
+      }
+      std::shuffle(indirectionX.begin(), indirectionX.end(), rng);
+
+      /* Prepare quantization parameters */
+      const float scale = xScale() / (yScale() * float(kernelSize()));
+      const int32_t bias = -int32_t(kernelSize()) * int32_t(xZeroPoint());
+      const union qnnp_q31_requantization_params requantizationParams =
+        qnnp_compute_requantization_params(scale, yZeroPoint(), qmin(), qmax());
+      const union qnnp_q31_requantization_params scalarRequantizationParams =
+        qnnp_compute_scalar_requantization_params(scale, yZeroPoint(), qmin(), qmax());
+
+      /* Compute reference results */
+      for (size_t i = 0; i < outputWidth(); i++) {
+        for (size_t c = 0; c < channels(); c++) {
+          int32_t acc = bias;
+          for (size_t k = 0; k < kernelSize(); k++) {
+            acc += int32_t(indirectionX[i * inputStep() + k][inputOffset() + c]);
+          }
+          yRef[i * channels() + c] = qnnp_q31_requantize(acc, scalarRequantizationParams);
+          yFP[i * channels() + c] =
+            std::min<float>(std::max<float>(float(acc) * scale + float(yZeroPoint()), float(qmin())), float(qmax()));
+        }
+      }
+
+      /* Call optimized micro-kernel */
+      q8avgpool(
+        channels(), outputWidth(), kernelSize(),
+        indirectionX.data(), y.data(),
+        inputStep() * sizeof(void*),
+        (outputStride() - channels()) * sizeof(uint8_t),
+        inputOffset() * sizeof(uint8_t),
+        bias,
+        &requantizationParams);
+
+      /* Verify results */
+      for (size_t i = 0; i < outputWidth(); i++) {
+        for (size_t c = 0; c < channels(); c++) {
+          const uint8_t yValue = y[i * outputStride() + c];
+          ASSERT_LE(uint32_t(yValue), uint32_t(qmax()))
+            << "at pixel " << i << ", channel " << c << ", kernel size = " << kernelSize()
+            << ", channels = " << channels();
+          ASSERT_GE(uint32_t(yValue), uint32_t(qmin()))
+            << "at pixel " << i << ", channel " << c << ", kernel size = " << kernelSize()
+            << ", channels = " << channels();
+          /* Q31 requantization rounds twice, first to 31 fractional bits and then to an integer */
+          ASSERT_NEAR(float(int32_t(yValue)), yFP[i * channels() + c], 1.0f)
+            << "at pixel " << i << ", channel " << c << ", kernel size = " << kernelSize()
+            << ", channels = " << channels();
+          ASSERT_EQ(uint32_t(yRef[i * channels() + c]), uint32_t(yValue))
+            << "at pixel " << i << ", channel " << c << ", kernel size = " << kernelSize()
+            << ", channels = " << channels();
+        }
+      }
+    }
+  }
+
+ private:
+  size_t kernelSize_{1};
+  size_t channels_{1};
+  size_t outputWidth_{1};
+  size_t inputStep_{0};
+  size_t inputOffset_{0};
+  size_t outputStride_{0};
+  float xScale_{1.25f};
+  float yScale_{1.75f};
+  uint8_t xZeroPoint_{121};
+  uint8_t yZeroPoint_{133};
+  uint8_t qmin_{0};
+  uint8_t qmax_{255};
+  size_t iterations_{15};
+};
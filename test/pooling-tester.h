@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <qnnpack.h>
+
+
+class PoolingTester {
+ public:
+  inline PoolingTester& padding(uint32_t padding) {
+    this->paddingTop_ = padding;
+    this->paddingRight_ = padding;
+    this->paddingBottom_ = padding;
+    this->paddingLeft_ = padding;
+    return *this;
+  }
+
+  inline PoolingTester& paddingTop(uint32_t paddingTop) {
+    this->paddingTop_ = paddingTop;
+    return *this;
+  }
+
+  inline uint32_t paddingTop() const {
+    return this->paddingTop_;
+  }
+
+  inline PoolingTester& paddingRight(uint32_t paddingRight) {
+    this->paddingRight_ = paddingRight;
+    return *this;
+  }
+
+  inline uint32_t paddingRight() const {
+    return this->paddingRight_;
+  }
+
+  inline PoolingTester& paddingBottom(uint32_t paddingBottom) {
+    this->paddingBottom_ = paddingBottom;
+    return *this;
+  }
+
+  inline uint32_t paddingBottom() const {
+    return this->paddingBottom_;
+  }
+
+  inline PoolingTester& paddingLeft(uint32_t paddingLeft) {
+    this->paddingLeft_ = paddingLeft;
+    return *this;
+  }
+
+  inline uint32_t paddingLeft() const {
+    return this->paddingLeft_;
+  }
+
+  inline PoolingTester& inputHeight(size_t inputHeight) {
+    assert(inputHeight != 0);
+    this->inputHeight_ = inputHeight;
+    return *this;
+  }
+
+  inline size_t inputHeight() const {
+    return this->inputHeight_;
+  }
+
+  inline PoolingTester& inputWidth(size_t inputWidth) {
+    assert(inputWidth != 0);
+    this->inputWidth_ = inputWidth;
+    return *this;
+  }
+
+  inline size_t inputWidth() const {
+    return this->inputWidth_;
+  }
+
+  inline PoolingTester& inputSize(size_t inputHeight, size_t inputWidth) {
+    assert(inputHeight != 0);
+    assert(inputWidth != 0);
+    this->inputHeight_ = inputHeight;
+    this->inputWidth_ = inputWidth;
+    return *this;
+  }
+
+  inline PoolingTester& poolingHeight(uint32_t poolingHeight) {
+    assert(poolingHeight != 0);
+    this->poolingHeight_ = poolingHeight;
+    return *this;
+  }
+
+  inline uint32_t poolingHeight() const {
+    return this->poolingHeight_;
+  }
+
+  inline PoolingTester& poolingWidth(uint32_t poolingWidth) {
+    assert(poolingWidth != 0);
+    this->poolingWidth_ = poolingWidth;
+    return *this;
+  }
+
+  inline uint32_t poolingWidth() const {
+    return this->poolingWidth_;
+  }
+
+  inline PoolingTester& poolingSize(uint32_t poolingSize) {
+    assert(poolingSize != 0);
+    this->poolingHeight_ = poolingSize;
+    this->poolingWidth_ = poolingSize;
+    return *this;
+  }
+
+  inline uint32_t poolingElements() const {
+    return poolingHeight() * poolingWidth();
+  }
+
+  inline PoolingTester& stride(uint32_t stride) {
+    assert(stride != 0);
+    this->strideHeight_ = stride;
+    this->strideWidth_ = stride;
+    return *this;
+  }
+
+  inline PoolingTester& strideHeight(uint32_t strideHeight) {
+    assert(strideHeight != 0);
+    this->strideHeight_ = strideHeight;
+    return *this;
+  }
+
+  inline uint32_t strideHeight() const {
+    return this->strideHeight_;
+  }
+
+  inline PoolingTester& strideWidth(uint32_t strideWidth) {
+    assert(strideWidth != 0);
+    this->strideWidth_ = strideWidth;
+    return *this;
+  }
+
+  inline uint32_t strideWidth() const {
+    return this->strideWidth_;
+  }
+
+  inline PoolingTester& dilationHeight(uint32_t dilationHeight) {
+    assert(dilationHeight != 0);
+    this->dilationHeight_ = dilationHeight;
+    return *this;
+  }
+
+  inline uint32_t dilationHeight() const {
+    return this->dilationHeight_;
+  }
+
+  inline PoolingTester& dilationWidth(uint32_t dilationWidth) {
+    assert(dilationWidth != 0);
+    this->dilationWidth_ = dilationWidth;
+    return *this;
+  }
+
+  inline uint32_t dilationWidth() const {
+    return this->dilationWidth_;
+  }
+
+  inline PoolingTester& dilation(uint32_t dilation) {
+    assert(dilation != 0);
+    this->dilationHeight_ = dilation;
+    this->dilationWidth_ = dilation;
+    return *this;
+  }
+
+  inline size_t outputHeight() const {
+    const size_t paddedInputHeight = paddingTop() + inputHeight() + paddingBottom();
+    const size_t dilatedPoolingHeight = (poolingHeight() - 1) * dilationHeight() + 1;
+    assert(paddedInputHeight >= dilatedPoolingHeight);
+    return (paddedInputHeight - dilatedPoolingHeight) / strideHeight() + 1;
+  }
+
+  inline size_t outputWidth() const {
+    const size_t paddedInputWidth = paddingLeft() + inputWidth() + paddingRight();
+    const size_t dilatedPoolingWidth = (poolingWidth() - 1) * dilationWidth() + 1;
+    assert(paddedInputWidth >= dilatedPoolingWidth);
+    return (paddedInputWidth - dilatedPoolingWidth) / strideWidth() + 1;
+  }
+
+  inline PoolingTester& channels(size_t channels) {
+    assert(channels != 0);
+    this->channels_ = channels;
+    return *this;
+  }
+
+  inline size_t channels() const {
+    return this->channels_;
+  }
+
+  inline PoolingTester& batchSize(size_t batchSize) {
+    assert(batchSize != 0);
+    this->batchSize_ = batchSize;
+    return *this;
+  }
+
+  inline size_t batchSize() const {
+    return this->batchSize_;
+  }
+
+  inline PoolingTester& inputPixelStride(size_t inputPixelStride) {
+    assert(inputPixelStride != 0);
+    this->inputPixelStride_ = inputPixelStride;
+    return *this;
+  }
+
+  inline size_t inputPixelStride() const {
+    if (this->inputPixelStride_ == 0) {
+      return channels();
+    } else {
+      assert(this->inputPixelStride_ >= channels());
+      return this->inputPixelStride_;
+    }
+  }
+
+  inline PoolingTester& outputPixelStride(size_t outputPixelStride) {
+    assert(outputPixelStride != 0);
+    this->outputPixelStride_ = outputPixelStride;
+    return *this;
+  }
+
+  inline size_t outputPixelStride() const {
+    if (this->outputPixelStride_ == 0) {
+      return channels();
+    } else {
+      assert(this->outputPixelStride_ >= channels());
+      return this->outputPixelStride_;
+    }
+  }
+
+  inline PoolingTester& inputScale(float inputScale) {
+    assert(inputScale > 0.0f);
+    assert(std::isnormal(inputScale));
+    this->inputScale_ = inputScale;
+    return *this;
+  }
+
+  inline float inputScale() const {
+    return this->inputScale_;
+  }
+
+  inline PoolingTester& inputZeroPoint(uint8_t inputZeroPoint) {
+    this->inputZeroPoint_ = inputZeroPoint;
+    return *this;
+  }
+
+  inline uint8_t inputZeroPoint() const {
+    return this->inputZeroPoint_;
+  }
+
+  inline PoolingTester& outputScale(float outputScale) {
+    assert(outputScale > 0.0f);
+    assert(std::isnormal(outputScale));
+    this->outputScale_ = outputScale;
+    return *this;
+  }
+
+  inline float outputScale() const {
+    return this->outputScale_;
+  }
+
+  inline PoolingTester& outputZeroPoint(uint8_t outputZeroPoint) {
+    this->outputZeroPoint_ = outputZeroPoint;
+    return *this;
+  }
+
+  inline uint8_t outputZeroPoint() const {
+    return this->outputZeroPoint_;
+  }
+
+  inline PoolingTester& qmin(uint8_t qmin) {
+    this->qmin_ = qmin;
+    return *this;
+  }
+
+  inline uint8_t qmin() const {
+    return this->qmin_;
+  }
+
+  inline PoolingTester& qmax(uint8_t qmax) {
+    this->qmax_ = qmax;
+    return *this;
+  }
+
+  inline uint8_t qmax() const {
+    return this->qmax_;
+  }
+
+  inline PoolingTester& threads(size_t threads) {
+    this->threads_ = threads;
+    return *this;
+  }
+
+  inline size_t threads() const {
+    return this->threads_;
+  }
+
+  inline PoolingTester& iterations(size_t iterations) {
+    this->iterations_ = iterations;
+    return *this;
+  }
+
+  inline size_t iterations() const {
+    return this->iterations_;
+  }
+
+  /*
+   * Runs the operator on two alternating input buffers, so that later iterations set up the operator again with an
+   * indirection buffer built for the other input.
+   */
+  void testMaxPooling() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    std::vector<uint8_t> inputs[2] = {
+      std::vector<uint8_t>((batchSize() * inputHeight() * inputWidth() - 1) * inputPixelStride() + channels()),
+      std::vector<uint8_t>((batchSize() * inputHeight() * inputWidth() - 1) * inputPixelStride() + channels()),
+    };
+    std::vector<uint8_t> output((batchSize() * outputHeight() * outputWidth() - 1) * outputPixelStride() + channels());
+    std::vector<uint8_t> outputRef(batchSize() * outputHeight() * outputWidth() * channels());
+    pthreadpool_t threadpool = nullptr;
+    if (threads() != 0) {
+      threadpool = pthreadpool_create(threads());
+      ASSERT_NE(nullptr, threadpool);
+    }
+
+    ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+    qnnp_operator_t max_pooling_op = nullptr;
+
+    ASSERT_EQ(qnnp_status_success,
+      qnnp_create_max_pooling2d_nhwc_u8(
+        paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+        poolingHeight(), poolingWidth(),
+        strideHeight(), strideWidth(),
+        dilationHeight(), dilationWidth(),
+        channels(), qmin(), qmax(),
+        0, &max_pooling_op));
+    ASSERT_NE(nullptr, max_pooling_op);
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::vector<uint8_t>& input = inputs[iteration % 2];
+      std::generate(input.begin(), input.end(), std::ref(u8rng));
+      std::fill(output.begin(), output.end(), 0xA5);
+
+      /* Compute reference results, padding never wins the maximum */
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t oy = 0; oy < outputHeight(); oy++) {
+          for (size_t ox = 0; ox < outputWidth(); ox++) {
+            for (size_t c = 0; c < channels(); c++) {
+              uint8_t maxValue = 0;
+              for (size_t py = 0; py < poolingHeight(); py++) {
+                const size_t iy = oy * strideHeight() + py * dilationHeight() - paddingTop();
+                for (size_t px = 0; px < poolingWidth(); px++) {
+                  const size_t ix = ox * strideWidth() + px * dilationWidth() - paddingLeft();
+                  if (ix < inputWidth() && iy < inputHeight()) {
+                    maxValue = std::max(maxValue,
+                      input[((i * inputHeight() + iy) * inputWidth() + ix) * inputPixelStride() + c]);
+                  }
+                }
+              }
+              outputRef[((i * outputHeight() + oy) * outputWidth() + ox) * channels() + c] =
+                std::min(std::max(maxValue, qmin()), qmax());
+            }
+          }
+        }
+      }
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_max_pooling2d_nhwc_u8(
+          max_pooling_op,
+          batchSize(), inputHeight(), inputWidth(),
+          input.data(), inputPixelStride(),
+          output.data(), outputPixelStride(),
+          threadpool));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_run_operator(max_pooling_op, threadpool));
+
+      /* Verify results */
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t y = 0; y < outputHeight(); y++) {
+          for (size_t x = 0; x < outputWidth(); x++) {
+            for (size_t c = 0; c < channels(); c++) {
+              ASSERT_EQ(
+                uint32_t(outputRef[((i * outputHeight() + y) * outputWidth() + x) * channels() + c]),
+                uint32_t(output[((i * outputHeight() + y) * outputWidth() + x) * outputPixelStride() + c]))
+                << "at image " << i << ", pixel " << y << ":" << x << ", channel " << c
+                << ", iteration " << iteration;
+            }
+          }
+        }
+      }
+    }
+
+    ASSERT_EQ(qnnp_status_success,
+      qnnp_delete_operator(max_pooling_op));
+    max_pooling_op = nullptr;
+    if (threadpool != nullptr) {
+      pthreadpool_destroy(threadpool);
+    }
+  }
+
+  /* Runs the operator on two alternating input buffers, as testMaxPooling does */
+  void testAveragePooling() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+    std::vector<uint8_t> inputs[2] = {
+      std::vector<uint8_t>((batchSize() * inputHeight() * inputWidth() - 1) * inputPixelStride() + channels()),
+      std::vector<uint8_t>((batchSize() * inputHeight() * inputWidth() - 1) * inputPixelStride() + channels()),
+    };
+    std::vector<uint8_t> output((batchSize() * outputHeight() * outputWidth() - 1) * outputPixelStride() + channels());
+    std::vector<float> outputRef(batchSize() * outputHeight() * outputWidth() * channels());
+    pthreadpool_t threadpool = nullptr;
+    if (threads() != 0) {
+      threadpool = pthreadpool_create(threads());
+      ASSERT_NE(nullptr, threadpool);
+    }
+
+    ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+    qnnp_operator_t average_pooling_op = nullptr;
+
+    ASSERT_EQ(qnnp_status_success,
+      qnnp_create_average_pooling2d_nhwc_q8(
+        paddingTop(), paddingRight(), paddingBottom(), paddingLeft(),
+        poolingHeight(), poolingWidth(),
+        strideHeight(), strideWidth(),
+        channels(),
+        inputZeroPoint(), inputScale(),
+        outputZeroPoint(), outputScale(),
+        qmin(), qmax(),
+        0, &average_pooling_op));
+    ASSERT_NE(nullptr, average_pooling_op);
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::vector<uint8_t>& input = inputs[iteration % 2];
+      std::generate(input.begin(), input.end(), std::ref(u8rng));
+      std::fill(output.begin(), output.end(), 0xA5);
+
+      /* Compute reference results, padding counts as inputs equal to the zero point */
+      const double scale = double(inputScale()) / (double(poolingElements()) * double(outputScale()));
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t oy = 0; oy < outputHeight(); oy++) {
+          for (size_t ox = 0; ox < outputWidth(); ox++) {
+            for (size_t c = 0; c < channels(); c++) {
+              double acc = 0.0;
+              for (size_t py = 0; py < poolingHeight(); py++) {
+                const size_t iy = oy * strideHeight() + py - paddingTop();
+                for (size_t px = 0; px < poolingWidth(); px++) {
+                  const size_t ix = ox * strideWidth() + px - paddingLeft();
+                  if (ix < inputWidth() && iy < inputHeight()) {
+                    acc += double(
+                      int32_t(input[((i * inputHeight() + iy) * inputWidth() + ix) * inputPixelStride() + c]) -
+                      int32_t(inputZeroPoint()));
+                  }
+                }
+              }
+              float& outputValue = outputRef[((i * outputHeight() + oy) * outputWidth() + ox) * channels() + c];
+              outputValue = float(acc * scale + double(outputZeroPoint()));
+              outputValue = std::min<float>(outputValue, float(qmax()));
+              outputValue = std::max<float>(outputValue, float(qmin()));
+            }
+          }
+        }
+      }
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_average_pooling2d_nhwc_q8(
+          average_pooling_op,
+          batchSize(), inputHeight(), inputWidth(),
+          input.data(), inputPixelStride(),
+          output.data(), outputPixelStride(),
+          threadpool));
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_run_operator(average_pooling_op, threadpool));
+
+      /* Verify results */
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t y = 0; y < outputHeight(); y++) {
+          for (size_t x = 0; x < outputWidth(); x++) {
+            for (size_t c = 0; c < channels(); c++) {
+              const uint8_t outputValue =
+                output[((i * outputHeight() + y) * outputWidth() + x) * outputPixelStride() + c];
+              ASSERT_LE(uint32_t(outputValue), uint32_t(qmax()));
+              ASSERT_GE(uint32_t(outputValue), uint32_t(qmin()));
+              /* Q31 requantization rounds twice, first to 31 fractional bits and then to an integer */
+              ASSERT_NEAR(
+                float(int32_t(outputValue)),
+                outputRef[((i * outputHeight() + y) * outputWidth() + x) * channels() + c],
+                1.0f)
+                << "at image " << i << ", pixel " << y << ":" << x << ", channel " << c
+                << ", iteration " << iteration;
+            }
+          }
+        }
+      }
+    }
+
+    ASSERT_EQ(qnnp_status_success,
+      qnnp_delete_operator(average_pooling_op));
+    average_pooling_op = nullptr;
+    if (threadpool != nullptr) {
+      pthreadpool_destroy(threadpool);
+    }
+  }
+
+ private:
+  uint32_t paddingTop_{0};
+  uint32_t paddingRight_{0};
+  uint32_t paddingBottom_{0};
+  uint32_t paddingLeft_{0};
+  size_t inputHeight_{1};
+  size_t inputWidth_{1};
+  uint32_t poolingHeight_{1};
+  uint32_t poolingWidth_{1};
+  uint32_t strideHeight_{1};
+  uint32_t strideWidth_{1};
+  uint32_t dilationHeight_{1};
+  uint32_t dilationWidth_{1};
+  size_t channels_{1};
+  size_t batchSize_{1};
+  size_t inputPixelStride_{0};
+  size_t outputPixelStride_{0};
+  float inputScale_{1.0f};
+  float outputScale_{1.0f};
+  uint8_t inputZeroPoint_{121};
+  uint8_t outputZeroPoint_{133};
+  uint8_t qmin_{0};
+  uint8_t qmax_{255};
+  size_t threads_{0};
+  size_t iterations_{3};
+};
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+/* Defined to 1 when QNNPACK is built with the QNNPACK_PROFILING CMake option */
+#ifndef QNNP_PROFILING
+#define QNNP_PROFILING 0
+#endif
+
+
+namespace {
+
+/* 3x3 convolution with padding 1 and 8 input channels, producing 16 channels */
+qnnp_operator_t createConvolution(const std::vector<uint8_t>& kernel, const std::vector<int32_t>& bias, uint32_t flags) {
+  qnnp_operator_t convolution = nullptr;
+  EXPECT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      1, 1, 1, 1,
+      3, 3,
+      1, 1,
+      1, 1,
+      1, 8, 16,
+      127, 1.0f,
+      127, 1.0f,
+      kernel.data(), bias.data(),
+      127, 100.0f, 0, 255,
+      flags,
+      &convolution));
+  return convolution;
+}
+
+}  // namespace
+
+#if QNNP_PROFILING
+
+TEST(PROFILING, convolution_stats) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 3 * 3 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t convolution = createConvolution(kernel, bias, 0 /* flags */);
+  ASSERT_NE(nullptr, convolution);
+
+  std::vector<uint8_t> input(9 * 10 * 8);
+  std::vector<uint8_t> output(9 * 10 * 16);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(
+      convolution, 1, 9, 10, input.data(), 8, output.data(), 16, nullptr));
+
+  pthreadpool_t threadpool = pthreadpool_create(2);
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(convolution, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(convolution, threadpool));
+  pthreadpool_destroy(threadpool);
+
+  qnnp_operator_stats stats;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_stats(convolution, &stats));
+  EXPECT_EQ(UINT64_C(1), stats.setups);
+  EXPECT_EQ(UINT64_C(2), stats.runs);
+  EXPECT_LE(stats.indirection_ns, stats.setup_ns);
+  EXPECT_LE(stats.compute_ns + stats.packing_ns, stats.run_ns);
+  EXPECT_EQ(uint64_t(2 * (9 * 10) * 16 * 8 * (3 * 3)), stats.macs);
+  EXPECT_LE(uint64_t(2 * (9 * 10 * 8 + 16 * 3 * 3 * 8)), stats.bytes_read);
+  EXPECT_EQ(uint64_t(2 * (9 * 10 * 16)), stats.bytes_written);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_reset_operator_stats(convolution));
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_stats(convolution, &stats));
+  EXPECT_EQ(UINT64_C(0), stats.runs);
+  EXPECT_EQ(UINT64_C(0), stats.run_ns);
+  EXPECT_EQ(UINT64_C(0), stats.macs);
+  for (size_t i = 0; i < QNNP_MAX_PROFILED_THREADS; i++) {
+    EXPECT_EQ(UINT64_C(0), stats.thread_compute_ns[i]);
+  }
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+}
+
+TEST(PROFILING, lazy_packing_stats) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  /* With lazy packing the kernel and bias must stay valid until the first run */
+  const std::vector<uint8_t> kernel(16 * 3 * 3 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t convolution = createConvolution(kernel, bias, QNNP_CREATE_FLAG_LAZY_PACKING);
+  ASSERT_NE(nullptr, convolution);
+
+  std::vector<uint8_t> input(9 * 10 * 8);
+  std::vector<uint8_t> output(9 * 10 * 16);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_convolution2d_nhwc_q8(
+      convolution, 1, 9, 10, input.data(), 8, output.data(), 16, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(convolution, nullptr));
+
+  qnnp_operator_stats stats;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_operator_stats(convolution, &stats));
+  EXPECT_EQ(UINT64_C(1), stats.runs);
+  EXPECT_LE(stats.packing_ns + stats.compute_ns, stats.run_ns);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+}
+
+#else
+
+TEST(PROFILING, unsupported_without_profiling) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 3 * 3 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t convolution = createConvolution(kernel, bias, 0 /* flags */);
+  ASSERT_NE(nullptr, convolution);
+
+  qnnp_operator_stats stats;
+  EXPECT_EQ(qnnp_status_unsupported_parameter, qnnp_get_operator_stats(convolution, &stats));
+  EXPECT_EQ(qnnp_status_unsupported_parameter, qnnp_reset_operator_stats(convolution));
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+}
+
+#endif
@@ -0,0 +1,561 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <qnnpack/q8avgpool.h>
+
+#include "pool-microkernel-tester.h"
+
+
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  TEST(Q8AVGPOOL_8x_NEON, c_eq_8_ks_eq_9) {
+    PoolMicrokernelTester()
+      .kernelSize(9)
+      .channels(8)
+      .test(q8avgpool_ukernel_8x__neon);
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, c_eq_8_ks_any) {
+    for (size_t ks = 2; ks <= 25; ks++) {
+      PoolMicrokernelTester()
+        .kernelSize(ks)
+        .channels(8)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, c_div_8) {
+    for (size_t c = 16; c < 128; c += 24) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, c_gt_8) {
+    for (size_t c = 9; c < 16; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, c_lt_8) {
+    for (size_t c = 1; c < 8; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, with_input_offset) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .inputOffset(13)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, multiple_pixels) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t w = 2; w <= 5; w++) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(w)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, multiple_pixels_with_shared_columns) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t step = 3; step <= 6; step += 3) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(5)
+          .inputStep(step)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, multiple_pixels_with_output_stride) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(5)
+        .outputStride(29)
+        .inputOffset(7)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, x_scale) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (float xScale = 0.01f; xScale < 1.0f; xScale *= 3.14159265f) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .xScale(xScale)
+          .iterations(1)
+          .test(q8avgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, x_zero_point) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (int32_t xZeroPoint = 0; xZeroPoint <= 255; xZeroPoint += 51) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .xZeroPoint(uint8_t(xZeroPoint))
+          .iterations(1)
+          .test(q8avgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, y_scale) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (float yScale = 0.2f; yScale < 100.0f; yScale *= 3.14159265f) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .yScale(yScale)
+          .iterations(1)
+          .test(q8avgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, y_zero_point) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (int32_t yZeroPoint = 0; yZeroPoint <= 255; yZeroPoint += 51) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .yZeroPoint(uint8_t(yZeroPoint))
+          .iterations(1)
+          .test(q8avgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, qmin) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmin(128)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_NEON, qmax) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmax(128)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__neon);
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  TEST(Q8AVGPOOL_8x_SSE2, c_eq_8_ks_eq_9) {
+    PoolMicrokernelTester()
+      .kernelSize(9)
+      .channels(8)
+      .test(q8avgpool_ukernel_8x__sse2);
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, c_eq_8_ks_any) {
+    for (size_t ks = 2; ks <= 25; ks++) {
+      PoolMicrokernelTester()
+        .kernelSize(ks)
+        .channels(8)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, c_div_8) {
+    for (size_t c = 16; c < 128; c += 24) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, c_gt_8) {
+    for (size_t c = 9; c < 16; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, c_lt_8) {
+    for (size_t c = 1; c < 8; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, with_input_offset) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .inputOffset(13)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, multiple_pixels) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t w = 2; w <= 5; w++) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(w)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, multiple_pixels_with_shared_columns) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t step = 3; step <= 6; step += 3) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(5)
+          .inputStep(step)
+          .iterations(3)
+          .test(q8avgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, multiple_pixels_with_output_stride) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(5)
+        .outputStride(29)
+        .inputOffset(7)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, x_scale) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (float xScale = 0.01f; xScale < 1.0f; xScale *= 3.14159265f) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .xScale(xScale)
+          .iterations(1)
+          .test(q8avgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, x_zero_point) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (int32_t xZeroPoint = 0; xZeroPoint <= 255; xZeroPoint += 51) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .xZeroPoint(uint8_t(xZeroPoint))
+          .iterations(1)
+          .test(q8avgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, y_scale) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (float yScale = 0.2f; yScale < 100.0f; yScale *= 3.14159265f) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .yScale(yScale)
+          .iterations(1)
+          .test(q8avgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, y_zero_point) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (int32_t yZeroPoint = 0; yZeroPoint <= 255; yZeroPoint += 51) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .yZeroPoint(uint8_t(yZeroPoint))
+          .iterations(1)
+          .test(q8avgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, qmin) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmin(128)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(Q8AVGPOOL_8x_SSE2, qmax) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmax(128)
+        .iterations(3)
+        .test(q8avgpool_ukernel_8x__sse2);
+    }
+  }
+#endif
+
+#if !CPUINFO_ARCH_ARM && !CPUINFO_ARCH_ARM64 && !CPUINFO_ARCH_X86 && !CPUINFO_ARCH_X86_64
+  TEST(Q8AVGPOOL_1x_SCALAR, c_eq_8_ks_eq_9) {
+    PoolMicrokernelTester()
+      .kernelSize(9)
+      .channels(8)
+      .test(q8avgpool_ukernel_1x__scalar);
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, c_eq_8_ks_any) {
+    for (size_t ks = 2; ks <= 25; ks++) {
+      PoolMicrokernelTester()
+        .kernelSize(ks)
+        .channels(8)
+        .iterations(3)
+        .test(q8avgpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, c_div_8) {
+    for (size_t c = 16; c < 128; c += 24) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(q8avgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, c_gt_8) {
+    for (size_t c = 9; c < 16; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(q8avgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, c_lt_8) {
+    for (size_t c = 1; c < 8; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(q8avgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, with_input_offset) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .inputOffset(13)
+        .iterations(3)
+        .test(q8avgpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, multiple_pixels) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t w = 2; w <= 5; w++) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(w)
+          .iterations(3)
+          .test(q8avgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, multiple_pixels_with_shared_columns) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t step = 3; step <= 6; step += 3) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(5)
+          .inputStep(step)
+          .iterations(3)
+          .test(q8avgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, multiple_pixels_with_output_stride) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(5)
+        .outputStride(29)
+        .inputOffset(7)
+        .iterations(3)
+        .test(q8avgpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, x_scale) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (float xScale = 0.01f; xScale < 1.0f; xScale *= 3.14159265f) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .xScale(xScale)
+          .iterations(1)
+          .test(q8avgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, x_zero_point) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (int32_t xZeroPoint = 0; xZeroPoint <= 255; xZeroPoint += 51) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .xZeroPoint(uint8_t(xZeroPoint))
+          .iterations(1)
+          .test(q8avgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, y_scale) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (float yScale = 0.2f; yScale < 100.0f; yScale *= 3.14159265f) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .yScale(yScale)
+          .iterations(1)
+          .test(q8avgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, y_zero_point) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (int32_t yZeroPoint = 0; yZeroPoint <= 255; yZeroPoint += 51) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .yZeroPoint(uint8_t(yZeroPoint))
+          .iterations(1)
+          .test(q8avgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, qmin) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmin(128)
+        .iterations(3)
+        .test(q8avgpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(Q8AVGPOOL_1x_SCALAR, qmax) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmax(128)
+        .iterations(3)
+        .test(q8avgpool_ukernel_1x__scalar);
+    }
+  }
+#endif
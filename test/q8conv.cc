@@ -12,6 +12,40 @@
 #include <gemm-tester.h>
 #include <qnnpack/q8gemm.h>
 
+#if CPUINFO_ARCH_ARM64
+  #define TEST_REQUIRES_ARM_NEON_DOT \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_arm_neon_dot()) { \
+        return; \
+      } \
+    } while (0)
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  #define TEST_REQUIRES_X86_AVX2 \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_x86_avx2()) { \
+        return; \
+      } \
+    } while (0)
+
+  #define TEST_REQUIRES_X86_AVX512VNNI \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_x86_avx512vnni() || !cpuinfo_has_x86_avx512vl()) { \
+        return; \
+      } \
+    } while (0)
+#endif
+
+#if CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+  #define TEST_REQUIRES_RISCV_V \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_riscv_v()) { \
+        return; \
+      } \
+    } while (0)
+#endif
+
 // clang-format off
 
 #if CPUINFO_ARCH_ARM
@@ -326,94 +360,99 @@
       }
     }
   }
-#endif
 
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
-  TEST(Q8CONV_4x8_NEON, k_eq_8) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_eq_8) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(1)
+      .kr(4)
       .m(4)
       .n(8)
       .k(8)
       .aStride(37)
-      .testMicroKernel(q8conv_ukernel_4x8__neon);
+      .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
   }
 
-  TEST(Q8CONV_4x8_NEON, k_eq_8_strided_c) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_eq_8_strided_c) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(1)
+      .kr(4)
       .m(4)
       .n(8)
       .k(8)
       .aStride(37)
       .cStride(17)
-      .testMicroKernel(q8conv_ukernel_4x8__neon);
+      .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
   }
 
-  TEST(Q8CONV_4x8_NEON, k_eq_8_qmin128) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_eq_8_qmin128) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(1)
+      .kr(4)
       .m(4)
       .n(8)
       .k(8)
       .qmin(128)
-      .testMicroKernel(q8conv_ukernel_4x8__neon);
+      .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
   }
 
-  TEST(Q8CONV_4x8_NEON, k_eq_8_qmax128) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_eq_8_qmax128) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(1)
+      .kr(4)
       .m(4)
       .n(8)
       .k(8)
       .qmax(128)
-      .testMicroKernel(q8conv_ukernel_4x8__neon);
+      .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
   }
 
-  TEST(Q8CONV_4x8_NEON, k_gt_8) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_gt_8) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
         .aStride(37)
-        .testMicroKernel(q8conv_ukernel_4x8__neon);
+        .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8CONV_4x8_NEON, k_gt_8_strided_c) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_gt_8_strided_c) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
         .aStride(37)
         .cStride(17)
-        .testMicroKernel(q8conv_ukernel_4x8__neon);
+        .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8CONV_4x8_NEON, k_gt_8_subtile) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_gt_8_subtile) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 9; k < 16; k++) {
       for (uint32_t m = 1; m <= 4; m++) {
         for (uint32_t n = 1; n <= 8; n++) {
@@ -421,50 +460,53 @@
             .mr(4)
             .nr(8)
             .np(8)
-            .kr(1)
+            .kr(4)
             .m(m)
             .n(n)
             .k(k)
             .aStride(37)
             .iterations(3)
-            .testMicroKernel(q8conv_ukernel_4x8__neon);
+            .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
         }
       }
     }
   }
 
-  TEST(Q8CONV_4x8_NEON, k_div_8) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_div_8) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
         .aStride(171)
-        .testMicroKernel(q8conv_ukernel_4x8__neon);
+        .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8CONV_4x8_NEON, k_div_8_strided_c) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_div_8_strided_c) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
         .aStride(171)
         .cStride(17)
-        .testMicroKernel(q8conv_ukernel_4x8__neon);
+        .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8CONV_4x8_NEON, k_div_8_subtile) {
+  TEST(Q8CONV_4x8c4_NEONDOT, k_div_8_subtile) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 16; k < 128; k += 24) {
       for (uint32_t m = 1; m <= 4; m++) {
         for (uint32_t n = 1; n <= 8; n++) {
@@ -472,108 +514,110 @@
             .mr(4)
             .nr(8)
             .np(8)
-            .kr(1)
+            .kr(4)
             .m(m)
             .n(n)
             .k(k)
             .aStride(171)
             .iterations(3)
-            .testMicroKernel(q8conv_ukernel_4x8__neon);
+            .testMicroKernel(q8conv_ukernel_4x8c4__neondot);
         }
       }
     }
   }
+#endif
 
-  TEST(Q8CONV_8x8_NEON, k_eq_8) {
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  TEST(Q8CONV_4x8_NEON, k_eq_8) {
     GemmTester()
-      .mr(8)
+      .mr(4)
       .nr(8)
       .np(8)
       .kr(1)
-      .m(8)
+      .m(4)
       .n(8)
       .k(8)
       .aStride(37)
-      .testMicroKernel(q8conv_ukernel_8x8__neon);
+      .testMicroKernel(q8conv_ukernel_4x8__neon);
   }
 
-  TEST(Q8CONV_8x8_NEON, k_eq_8_strided_c) {
+  TEST(Q8CONV_4x8_NEON, k_eq_8_strided_c) {
     GemmTester()
-      .mr(8)
+      .mr(4)
       .nr(8)
       .np(8)
       .kr(1)
-      .m(8)
+      .m(4)
       .n(8)
       .k(8)
       .aStride(37)
       .cStride(17)
-      .testMicroKernel(q8conv_ukernel_8x8__neon);
+      .testMicroKernel(q8conv_ukernel_4x8__neon);
   }
 
-  TEST(Q8CONV_8x8_NEON, k_eq_8_qmin128) {
+  TEST(Q8CONV_4x8_NEON, k_eq_8_qmin128) {
     GemmTester()
-      .mr(8)
+      .mr(4)
       .nr(8)
       .np(8)
       .kr(1)
-      .m(8)
+      .m(4)
       .n(8)
       .k(8)
       .qmin(128)
-      .testMicroKernel(q8conv_ukernel_8x8__neon);
+      .testMicroKernel(q8conv_ukernel_4x8__neon);
   }
 
-  TEST(Q8CONV_8x8_NEON, k_eq_8_qmax128) {
+  TEST(Q8CONV_4x8_NEON, k_eq_8_qmax128) {
     GemmTester()
-      .mr(8)
+      .mr(4)
       .nr(8)
       .np(8)
       .kr(1)
-      .m(8)
+      .m(4)
       .n(8)
       .k(8)
       .qmax(128)
-      .testMicroKernel(q8conv_ukernel_8x8__neon);
+      .testMicroKernel(q8conv_ukernel_4x8__neon);
   }
 
-  TEST(Q8CONV_8x8_NEON, k_gt_8) {
+  TEST(Q8CONV_4x8_NEON, k_gt_8) {
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(8)
+        .mr(4)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(4)
         .n(8)
         .k(k)
         .aStride(37)
-        .testMicroKernel(q8conv_ukernel_8x8__neon);
+        .testMicroKernel(q8conv_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8CONV_8x8_NEON, k_gt_8_strided_c) {
+  TEST(Q8CONV_4x8_NEON, k_gt_8_strided_c) {
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(8)
+        .mr(4)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(4)
         .n(8)
         .k(k)
         .aStride(37)
         .cStride(17)
-        .testMicroKernel(q8conv_ukernel_8x8__neon);
+        .testMicroKernel(q8conv_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8CONV_8x8_NEON, k_gt_8_subtile) {
+  TEST(Q8CONV_4x8_NEON, k_gt_8_subtile) {
     for (size_t k = 9; k < 16; k++) {
-      for (uint32_t m = 1; m <= 8; m++) {
+      for (uint32_t m = 1; m <= 4; m++) {
         for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
-            .mr(8)
+            .mr(4)
             .nr(8)
             .np(8)
             .kr(1)
@@ -582,49 +626,49 @@
             .k(k)
             .aStride(37)
             .iterations(3)
-            .testMicroKernel(q8conv_ukernel_8x8__neon);
+            .testMicroKernel(q8conv_ukernel_4x8__neon);
         }
       }
     }
   }
 
-  TEST(Q8CONV_8x8_NEON, k_div_8) {
+  TEST(Q8CONV_4x8_NEON, k_div_8) {
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
-        .mr(8)
+        .mr(4)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(4)
         .n(8)
         .k(k)
         .aStride(171)
-        .testMicroKernel(q8conv_ukernel_8x8__neon);
+        .testMicroKernel(q8conv_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8CONV_8x8_NEON, k_div_8_strided_c) {
+  TEST(Q8CONV_4x8_NEON, k_div_8_strided_c) {
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
-        .mr(8)
+        .mr(4)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(4)
         .n(8)
         .k(k)
         .aStride(171)
         .cStride(17)
-        .testMicroKernel(q8conv_ukernel_8x8__neon);
+        .testMicroKernel(q8conv_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8CONV_8x8_NEON, k_div_8_subtile) {
+  TEST(Q8CONV_4x8_NEON, k_div_8_subtile) {
     for (size_t k = 16; k < 128; k += 24) {
-      for (uint32_t m = 1; m <= 8; m++) {
+      for (uint32_t m = 1; m <= 4; m++) {
         for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
-            .mr(8)
+            .mr(4)
             .nr(8)
             .np(8)
             .kr(1)
@@ -633,164 +677,3177 @@
             .k(k)
             .aStride(171)
             .iterations(3)
-            .testMicroKernel(q8conv_ukernel_8x8__neon);
+            .testMicroKernel(q8conv_ukernel_4x8__neon);
         }
       }
     }
   }
-#endif
 
-#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
-  TEST(Q8CONV_4x4c2_SSE2, k_eq_8) {
+  TEST(Q8CONV_FOLDED_4x8_NEON, k_eq_8) {
     GemmTester()
       .mr(4)
-      .nr(4)
-      .np(4)
-      .kr(2)
+      .nr(8)
+      .np(8)
+      .kr(1)
       .m(4)
-      .n(4)
+      .n(8)
       .k(8)
       .aStride(37)
-      .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8__neon);
   }
 
-  TEST(Q8CONV_4x4c2_SSE2, k_eq_8_strided_c) {
+  TEST(Q8CONV_FOLDED_4x8_NEON, k_eq_8_strided_c) {
     GemmTester()
       .mr(4)
-      .nr(4)
-      .np(4)
-      .kr(2)
+      .nr(8)
+      .np(8)
+      .kr(1)
       .m(4)
-      .n(4)
+      .n(8)
       .k(8)
       .aStride(37)
       .cStride(17)
-      .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8__neon);
   }
 
-  TEST(Q8CONV_4x4c2_SSE2, k_eq_8_qmin128) {
+  TEST(Q8CONV_FOLDED_4x8_NEON, k_eq_8_qmin128) {
     GemmTester()
       .mr(4)
-      .nr(4)
-      .np(4)
-      .kr(2)
+      .nr(8)
+      .np(8)
+      .kr(1)
       .m(4)
-      .n(4)
+      .n(8)
       .k(8)
       .qmin(128)
-      .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8__neon);
   }
 
-  TEST(Q8CONV_4x4c2_SSE2, k_eq_8_qmax128) {
+  TEST(Q8CONV_FOLDED_4x8_NEON, k_eq_8_qmax128) {
     GemmTester()
       .mr(4)
-      .nr(4)
-      .np(4)
-      .kr(2)
+      .nr(8)
+      .np(8)
+      .kr(1)
       .m(4)
-      .n(4)
+      .n(8)
       .k(8)
       .qmax(128)
-      .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8__neon);
   }
 
-  TEST(Q8CONV_4x4c2_SSE2, k_gt_8) {
+  TEST(Q8CONV_FOLDED_4x8_NEON, k_gt_8_subtile) {
     for (size_t k = 9; k < 16; k++) {
-      GemmTester()
-        .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
-        .m(4)
-        .n(4)
-        .k(k)
-        .aStride(37)
-        .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x8__neon);
+        }
+      }
     }
   }
 
-  TEST(Q8CONV_4x4c2_SSE2, k_gt_8_strided_c) {
-    for (size_t k = 9; k < 16; k++) {
+  TEST(Q8CONV_FOLDED_4x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8_NEON, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
       GemmTester()
         .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
+        .nr(8)
+        .np(8)
+        .kr(1)
         .m(4)
-        .n(4)
-        .k(k)
+        .n(8)
+        .k(11)
+        .ks(ks)
         .aStride(37)
-        .cStride(17)
-        .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+        .foldedZeroPoint(true)
+        .testMicroKernel(q8conv_folded_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8CONV_4x4c2_SSE2, k_gt_8_subtile) {
+  TEST(Q8CONV_RELU_4x8_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .qmin(128)
+      .testMicroKernel(q8conv_relu_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_RELU_4x8_NEON, k_gt_8_subtile_qmin128) {
     for (size_t k = 9; k < 16; k++) {
       for (uint32_t m = 1; m <= 4; m++) {
-        for (uint32_t n = 1; n <= 4; n++) {
+        for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
             .mr(4)
-            .nr(4)
-            .np(4)
-            .kr(2)
+            .nr(8)
+            .np(8)
+            .kr(1)
             .m(m)
             .n(n)
             .k(k)
             .aStride(37)
             .iterations(3)
-            .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+            .qmin(128)
+            .testMicroKernel(q8conv_relu_ukernel_4x8__neon);
         }
       }
     }
   }
 
-  TEST(Q8CONV_4x4c2_SSE2, k_div_8) {
-    for (size_t k = 16; k < 128; k += 8) {
+  TEST(Q8CONV_RELU_4x8_NEON, ks_gt_1_qmin128) {
+    for (size_t ks = 2; ks <= 9; ks++) {
       GemmTester()
         .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
+        .nr(8)
+        .np(8)
+        .kr(1)
         .m(4)
-        .n(4)
-        .k(k)
-        .aStride(171)
-        .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
-    }
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .qmin(128)
+        .testMicroKernel(q8conv_relu_ukernel_4x8__neon);
+    }
+  }
+
+  TEST(Q8CONV_UNCLAMPED_4x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_unclamped_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_UNCLAMPED_4x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_unclamped_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_UNCLAMPED_4x8_NEON, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .testMicroKernel(q8conv_unclamped_ukernel_4x8__neon);
+    }
+  }
+
+  TEST(Q8CONV_XZP_4x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8__neon, q8conv_sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8CONV_XZP_4x8_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8__neon, q8conv_sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8CONV_XZP_4x8_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8__neon, q8conv_sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8CONV_XZP_4x8_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8__neon, q8conv_sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8CONV_XZP_4x8_NEON, k_lt_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(5)
+      .aStride(37)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8__neon, q8conv_sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8CONV_XZP_4x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_xzp_ukernel_4x8__neon, q8conv_sumrows_ukernel_4x__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_XZP_4x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testMicroKernel(q8conv_xzp_ukernel_4x8__neon, q8conv_sumrows_ukernel_4x__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_XZP_4x8_NEON, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .testMicroKernel(q8conv_xzp_ukernel_4x8__neon, q8conv_sumrows_ukernel_4x__neon);
+    }
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_ukernel_8x8__neon);
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(q8conv_ukernel_8x8__neon);
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8conv_ukernel_8x8__neon);
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8conv_ukernel_8x8__neon);
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8conv_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_gt_8_strided_c) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 8; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(8)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_8x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8conv_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_div_8_strided_c) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8CONV_8x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 8; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(8)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_8x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_NEON, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__neon);
+    }
+  }
+
+  TEST(Q8CONV_FP32_4x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_FP32_4x8_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_FP32_4x8_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_FP32_4x8_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x8__neon);
+  }
+
+  TEST(Q8CONV_FP32_4x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8conv_fp32_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FP32_4x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8conv_fp32_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FP32_4x8_NEON, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .fp32Requantization(true)
+        .testMicroKernel(q8conv_fp32_ukernel_4x8__neon);
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  TEST(Q8CONV_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_4x4c2_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_4x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_4x4c2_SSE2, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8CONV_4x4c2_SSE2, k_gt_8_strided_c) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .aStride(37)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8CONV_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_4x4c2_SSE2, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8CONV_4x4c2_SSE2, k_div_8_strided_c) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .aStride(171)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8CONV_4x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_FOLDED_4x4c2_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_FOLDED_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_FOLDED_4x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_FOLDED_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x4c2_SSE2, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .foldedZeroPoint(true)
+        .testMicroKernel(q8conv_folded_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8CONV_RELU_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .qmin(128)
+      .testMicroKernel(q8conv_relu_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_RELU_4x4c2_SSE2, k_gt_8_subtile_qmin128) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .qmin(128)
+            .testMicroKernel(q8conv_relu_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_RELU_4x4c2_SSE2, ks_gt_1_qmin128) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .qmin(128)
+        .testMicroKernel(q8conv_relu_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8CONV_UNCLAMPED_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_unclamped_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_UNCLAMPED_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_unclamped_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_UNCLAMPED_4x4c2_SSE2, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .testMicroKernel(q8conv_unclamped_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8CONV_XZP_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_xzp_ukernel_4x4c2__sse2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x4c2_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(q8conv_xzp_ukernel_4x4c2__sse2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8conv_xzp_ukernel_4x4c2__sse2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8conv_xzp_ukernel_4x4c2__sse2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x4c2_SSE2, k_lt_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(5)
+      .aStride(37)
+      .testMicroKernel(q8conv_xzp_ukernel_4x4c2__sse2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_xzp_ukernel_4x4c2__sse2, q8conv_sumrows_ukernel_4x__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_XZP_4x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testMicroKernel(q8conv_xzp_ukernel_4x4c2__sse2, q8conv_sumrows_ukernel_4x__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_XZP_4x4c2_SSE2, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .testMicroKernel(q8conv_xzp_ukernel_4x4c2__sse2, q8conv_sumrows_ukernel_4x__sse2);
+    }
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x4c2_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x4c2_SSE2, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8CONV_FP32_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_FP32_4x4c2_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_FP32_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_FP32_4x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8CONV_FP32_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8conv_fp32_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FP32_4x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8conv_fp32_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FP32_4x4c2_SSE2, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .fp32Requantization(true)
+        .testMicroKernel(q8conv_fp32_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_eq_8_strided_c) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_gt_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_gt_8_strided_c) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_div_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_div_8_strided_c) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8CONV_4x8c2_AVX2, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c2_AVX2, k_eq_8_strided_c) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c2_AVX2, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c2_AVX2, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c2_AVX2, ks_gt_1) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .foldedZeroPoint(true)
+        .testMicroKernel(q8conv_folded_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8CONV_RELU_4x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .qmin(128)
+      .testMicroKernel(q8conv_relu_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_RELU_4x8c2_AVX2, k_gt_8_subtile_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .qmin(128)
+            .testMicroKernel(q8conv_relu_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_RELU_4x8c2_AVX2, ks_gt_1_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .qmin(128)
+        .testMicroKernel(q8conv_relu_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8CONV_UNCLAMPED_4x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_unclamped_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_UNCLAMPED_4x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_unclamped_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_UNCLAMPED_4x8c2_AVX2, ks_gt_1) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .testMicroKernel(q8conv_unclamped_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8CONV_XZP_4x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8c2__avx2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x8c2_AVX2, k_eq_8_strided_c) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8c2__avx2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8c2__avx2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x8c2_AVX2, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8c2__avx2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x8c2_AVX2, k_lt_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(5)
+      .aStride(37)
+      .testMicroKernel(q8conv_xzp_ukernel_4x8c2__avx2, q8conv_sumrows_ukernel_4x__sse2);
+  }
+
+  TEST(Q8CONV_XZP_4x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_xzp_ukernel_4x8c2__avx2, q8conv_sumrows_ukernel_4x__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_XZP_4x8c2_AVX2, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testMicroKernel(q8conv_xzp_ukernel_4x8c2__avx2, q8conv_sumrows_ukernel_4x__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_XZP_4x8c2_AVX2, ks_gt_1) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .testMicroKernel(q8conv_xzp_ukernel_4x8c2__avx2, q8conv_sumrows_ukernel_4x__sse2);
+    }
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .signedKernel(true)
+      .testMicroKernel(q8conv_signed_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c2_AVX2, k_eq_8_strided_c) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .signedKernel(true)
+      .testMicroKernel(q8conv_signed_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .signedKernel(true)
+      .testMicroKernel(q8conv_signed_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c2_AVX2, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .signedKernel(true)
+      .testMicroKernel(q8conv_signed_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .signedKernel(true)
+            .testMicroKernel(q8conv_signed_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c2_AVX2, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .signedKernel(true)
+            .testMicroKernel(q8conv_signed_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c2_AVX2, ks_gt_1) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t ks = 2; ks <= 9; ks++) {
+      for (size_t k = 4; k < 24; k += 3) {
+        GemmTester()
+          .mr(4)
+          .nr(8)
+          .np(8)
+          .kr(2)
+          .m(4)
+          .n(8)
+          .k(k)
+          .ks(ks)
+          .aStride(37)
+          .iterations(3)
+          .signedKernel(true)
+          .testMicroKernel(q8conv_signed_ukernel_4x8c2__avx2);
+      }
+    }
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_eq_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_eq_8_strided_c) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_gt_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_gt_8_strided_c) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_div_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_div_8_strided_c) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8CONV_4x8c4_AVX512VNNI, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c4_AVX512VNNI, k_eq_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c4_AVX512VNNI, k_eq_8_strided_c) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c4_AVX512VNNI, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c4_AVX512VNNI, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c4_AVX512VNNI, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c4_AVX512VNNI, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8c4_AVX512VNNI, ks_gt_1) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .foldedZeroPoint(true)
+        .testMicroKernel(q8conv_folded_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c4_AVX512VNNI, k_eq_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .signedKernel(true)
+      .testMicroKernel(q8conv_signed_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c4_AVX512VNNI, k_eq_8_strided_c) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .signedKernel(true)
+      .testMicroKernel(q8conv_signed_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c4_AVX512VNNI, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .signedKernel(true)
+      .testMicroKernel(q8conv_signed_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c4_AVX512VNNI, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .signedKernel(true)
+      .testMicroKernel(q8conv_signed_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c4_AVX512VNNI, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .signedKernel(true)
+            .testMicroKernel(q8conv_signed_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c4_AVX512VNNI, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .signedKernel(true)
+            .testMicroKernel(q8conv_signed_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_SIGNED_4x8c4_AVX512VNNI, ks_gt_1) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t ks = 2; ks <= 9; ks++) {
+      for (size_t k = 4; k < 24; k += 3) {
+        GemmTester()
+          .mr(4)
+          .nr(8)
+          .np(8)
+          .kr(4)
+          .m(4)
+          .n(8)
+          .k(k)
+          .ks(ks)
+          .aStride(37)
+          .iterations(3)
+          .signedKernel(true)
+          .testMicroKernel(q8conv_signed_ukernel_4x8c4__avx512vnni);
+      }
+    }
+  }
+#endif
+
+#if !CPUINFO_ARCH_ARM && !CPUINFO_ARCH_ARM64 && !CPUINFO_ARCH_X86 && !CPUINFO_ARCH_X86_64
+  TEST(Q8CONV_4x8_PSIMD, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_4x8_PSIMD, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(q8conv_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_4x8_PSIMD, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8conv_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_4x8_PSIMD, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8conv_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_4x8_PSIMD, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8conv_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8CONV_4x8_PSIMD, k_gt_8_strided_c) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8CONV_4x8_PSIMD, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_4x8__psimd);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_4x8_PSIMD, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8conv_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8CONV_4x8_PSIMD, k_div_8_strided_c) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8CONV_4x8_PSIMD, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_4x8__psimd);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8_PSIMD, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8_PSIMD, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8_PSIMD, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8_PSIMD, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8conv_folded_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_FOLDED_4x8_PSIMD, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x8__psimd);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8_PSIMD, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8conv_folded_ukernel_4x8__psimd);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FOLDED_4x8_PSIMD, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .foldedZeroPoint(true)
+        .testMicroKernel(q8conv_folded_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_PSIMD, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_PSIMD, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_PSIMD, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_PSIMD, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_PSIMD, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__psimd);
+        }
+      }
+    }
   }
 
-  TEST(Q8CONV_4x4c2_SSE2, k_div_8_strided_c) {
+  TEST(Q8CONV_PERCHANNEL_4x8_PSIMD, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__psimd);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_PERCHANNEL_4x8_PSIMD, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .testPerChannelMicroKernel(q8conv_perchannel_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8CONV_FP32_4x8_PSIMD, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_FP32_4x8_PSIMD, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_FP32_4x8_PSIMD, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_FP32_4x8_PSIMD, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8conv_fp32_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8CONV_FP32_4x8_PSIMD, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8conv_fp32_ukernel_4x8__psimd);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FP32_4x8_PSIMD, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(171)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8conv_fp32_ukernel_4x8__psimd);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_FP32_4x8_PSIMD, ks_gt_1) {
+    for (size_t ks = 2; ks <= 9; ks++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(11)
+        .ks(ks)
+        .aStride(37)
+        .fp32Requantization(true)
+        .testMicroKernel(q8conv_fp32_ukernel_4x8__psimd);
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+  TEST(Q8CONV_4x8_RVV, k_eq_8) {
+    TEST_REQUIRES_RISCV_V;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8conv_ukernel_4x8__rvv);
+  }
+
+  TEST(Q8CONV_4x8_RVV, k_eq_8_strided_c) {
+    TEST_REQUIRES_RISCV_V;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(q8conv_ukernel_4x8__rvv);
+  }
+
+  TEST(Q8CONV_4x8_RVV, k_eq_8_qmin128) {
+    TEST_REQUIRES_RISCV_V;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8conv_ukernel_4x8__rvv);
+  }
+
+  TEST(Q8CONV_4x8_RVV, k_eq_8_qmax128) {
+    TEST_REQUIRES_RISCV_V;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8conv_ukernel_4x8__rvv);
+  }
+
+  TEST(Q8CONV_4x8_RVV, k_gt_8) {
+    TEST_REQUIRES_RISCV_V;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8conv_ukernel_4x8__rvv);
+    }
+  }
+
+  TEST(Q8CONV_4x8_RVV, k_gt_8_strided_c) {
+    TEST_REQUIRES_RISCV_V;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .cStride(17)
+        .testMicroKernel(q8conv_ukernel_4x8__rvv);
+    }
+  }
+
+  TEST(Q8CONV_4x8_RVV, k_gt_8_subtile) {
+    TEST_REQUIRES_RISCV_V;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .aStride(37)
+            .iterations(3)
+            .testMicroKernel(q8conv_ukernel_4x8__rvv);
+        }
+      }
+    }
+  }
+
+  TEST(Q8CONV_4x8_RVV, k_div_8) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
         .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
+        .nr(8)
+        .np(8)
+        .kr(1)
         .m(4)
-        .n(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8conv_ukernel_4x8__rvv);
+    }
+  }
+
+  TEST(Q8CONV_4x8_RVV, k_div_8_strided_c) {
+    TEST_REQUIRES_RISCV_V;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
         .k(k)
         .aStride(171)
         .cStride(17)
-        .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+        .testMicroKernel(q8conv_ukernel_4x8__rvv);
     }
   }
 
-  TEST(Q8CONV_4x4c2_SSE2, k_div_8_subtile) {
+  TEST(Q8CONV_4x8_RVV, k_div_8_subtile) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 16; k < 128; k += 24) {
       for (uint32_t m = 1; m <= 4; m++) {
-        for (uint32_t n = 1; n <= 4; n++) {
+        for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
             .mr(4)
-            .nr(4)
-            .np(4)
-            .kr(2)
+            .nr(8)
+            .np(8)
+            .kr(1)
             .m(m)
             .n(n)
             .k(k)
             .aStride(171)
             .iterations(3)
-            .testMicroKernel(q8conv_ukernel_4x4c2__sse2);
+            .testMicroKernel(q8conv_ukernel_4x8__rvv);
         }
       }
     }
@@ -23,6 +23,23 @@
 #include <depthwise-microkernel-tester.h>
 #include <qnnpack/q8dw.h>
 
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  #define TEST_REQUIRES_X86_AVX2 \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_x86_avx2()) { \
+        return; \
+      } \
+    } while (0)
+#endif
+
+#if CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+  #define TEST_REQUIRES_RISCV_V \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_riscv_v()) { \
+        return; \
+      } \
+    } while (0)
+#endif
 
 #if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
   TEST(Q8DW_9c8_NEON, single_output_channels_eq_8) {
@@ -199,6 +216,209 @@
         .test(q8dw_ukernel_9c8__neon);
     }
   }
+
+  TEST(Q8DW_9c8_NEON, multi_output_channels_gt_8_with_input_offset) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_ukernel_9c8__neon);
+    }
+  }
+
+  TEST(Q8DW_25c8_NEON, single_output_channels_eq_8) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .test(q8dw_ukernel_25c8__neon);
+  }
+
+  TEST(Q8DW_25c8_NEON, single_output_channels_eq_8_with_qmin) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmin(128)
+      .test(q8dw_ukernel_25c8__neon);
+  }
+
+  TEST(Q8DW_25c8_NEON, single_output_channels_eq_8_with_qmax) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmax(128)
+      .test(q8dw_ukernel_25c8__neon);
+  }
+
+  TEST(Q8DW_25c8_NEON, multi_output_channels_eq_8) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_25c8__neon);
+  }
+
+  TEST(Q8DW_25c8_NEON, multi_output_channels_eq_8_with_subsampling) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .subsampling(2)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_25c8__neon);
+  }
+
+  TEST(Q8DW_25c8_NEON, multi_output_channels_eq_8_with_input_stride) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .inputStride(17)
+      .test(q8dw_ukernel_25c8__neon);
+  }
+
+  TEST(Q8DW_25c8_NEON, multi_output_channels_eq_8_with_output_stride) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .outputStride(19)
+      .test(q8dw_ukernel_25c8__neon);
+  }
+
+  TEST(Q8DW_25c8_NEON, single_output_channels_div_8) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_25c8__neon);
+    }
+  }
+
+  TEST(Q8DW_25c8_NEON, multi_output_channels_div_8) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_25c8__neon);
+    }
+  }
+
+  TEST(Q8DW_25c8_NEON, multi_output_channels_div_8_with_output_stride) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(171)
+        .test(q8dw_ukernel_25c8__neon);
+    }
+  }
+
+  TEST(Q8DW_25c8_NEON, single_output_channels_gt_8) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_25c8__neon);
+    }
+  }
+
+  TEST(Q8DW_25c8_NEON, single_output_channels_gt_8_with_qmin) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmin(128)
+        .test(q8dw_ukernel_25c8__neon);
+    }
+  }
+
+  TEST(Q8DW_25c8_NEON, single_output_channels_gt_8_with_qmax) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmax(128)
+        .test(q8dw_ukernel_25c8__neon);
+    }
+  }
+
+  TEST(Q8DW_25c8_NEON, multi_output_channels_gt_8) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_25c8__neon);
+    }
+  }
+
+  TEST(Q8DW_25c8_NEON, multi_output_channels_gt_8_with_output_stride) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(17)
+        .test(q8dw_ukernel_25c8__neon);
+    }
+  }
+
+  TEST(Q8DW_25c8_NEON, multi_output_channels_gt_8_with_input_offset) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_ukernel_25c8__neon);
+    }
+  }
 #endif /* CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 */
 
 #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
@@ -376,4 +596,1415 @@
         .test(q8dw_ukernel_9c8__sse2);
     }
   }
-#endif /* CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 */
+
+  TEST(Q8DW_9c8_SSE2, multi_output_channels_gt_8_with_input_offset) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_ukernel_9c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_9c8_SSE2, multiplier_2) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_9c8_SSE2, multiplier_4) {
+    for (uint32_t channels = 4; channels <= 32; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(4)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_9c8_SSE2, multiplier_8) {
+    for (uint32_t channels = 8; channels <= 32; channels += 8) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(8)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_9c8_SSE2, multiplier_2_with_subsampling) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .subsampling(2)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_9c8_SSE2, multiplier_4_with_input_offset) {
+    for (uint32_t channels = 4; channels <= 32; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(4)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_multiplier_ukernel_9c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_9c8_SSE2, multiplier_2_with_output_stride) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(5)
+        .outputStride(35)
+        .test(q8dw_multiplier_ukernel_9c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, single_output_channels_eq_16) {
+    TEST_REQUIRES_X86_AVX2;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(16)
+      .channels(16)
+      .width(1)
+      .test(q8dw_ukernel_9c16__avx2);
+  }
+
+  TEST(Q8DW_9c16_AVX2, single_output_channels_eq_16_with_qmin) {
+    TEST_REQUIRES_X86_AVX2;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(16)
+      .channels(16)
+      .width(1)
+      .qmin(128)
+      .test(q8dw_ukernel_9c16__avx2);
+  }
+
+  TEST(Q8DW_9c16_AVX2, single_output_channels_eq_16_with_qmax) {
+    TEST_REQUIRES_X86_AVX2;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(16)
+      .channels(16)
+      .width(1)
+      .qmax(128)
+      .test(q8dw_ukernel_9c16__avx2);
+  }
+
+  TEST(Q8DW_9c16_AVX2, multi_output_channels_eq_16) {
+    TEST_REQUIRES_X86_AVX2;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(16)
+      .channels(16)
+      .width(5)
+      .test(q8dw_ukernel_9c16__avx2);
+  }
+
+  TEST(Q8DW_9c16_AVX2, multi_output_channels_eq_16_with_subsampling) {
+    TEST_REQUIRES_X86_AVX2;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .subsampling(2)
+      .cr(16)
+      .channels(16)
+      .width(5)
+      .test(q8dw_ukernel_9c16__avx2);
+  }
+
+  TEST(Q8DW_9c16_AVX2, multi_output_channels_eq_16_with_input_stride) {
+    TEST_REQUIRES_X86_AVX2;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(16)
+      .channels(16)
+      .width(5)
+      .inputStride(17)
+      .test(q8dw_ukernel_9c16__avx2);
+  }
+
+  TEST(Q8DW_9c16_AVX2, multi_output_channels_eq_16_with_output_stride) {
+    TEST_REQUIRES_X86_AVX2;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(16)
+      .channels(16)
+      .width(5)
+      .outputStride(19)
+      .test(q8dw_ukernel_9c16__avx2);
+  }
+
+  TEST(Q8DW_9c16_AVX2, single_output_channels_div_16) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 32; channels < 256; channels += 48) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multi_output_channels_div_16) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 32; channels < 256; channels += 48) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multi_output_channels_div_16_with_output_stride) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 32; channels < 256; channels += 48) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .width(5)
+        .outputStride(293)
+        .test(q8dw_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, single_output_channels_gt_16) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 17; channels < 32; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, single_output_channels_gt_16_with_qmin) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 17; channels < 32; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .width(1)
+        .qmin(128)
+        .test(q8dw_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, single_output_channels_gt_16_with_qmax) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 17; channels < 32; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .width(1)
+        .qmax(128)
+        .test(q8dw_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multi_output_channels_gt_16) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 17; channels < 32; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multi_output_channels_gt_16_with_output_stride) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 17; channels < 32; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .width(5)
+        .outputStride(37)
+        .test(q8dw_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multi_output_channels_gt_16_with_input_offset) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 17; channels < 32; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(53)
+        .test(q8dw_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multiplier_2) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 2; channels <= 64; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multiplier_4) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 4; channels <= 64; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .multiplier(4)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multiplier_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 8; channels <= 64; channels += 8) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .multiplier(8)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multiplier_2_with_subsampling) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 2; channels <= 64; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .subsampling(2)
+        .cr(16)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multiplier_4_with_input_offset) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 4; channels <= 64; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .multiplier(4)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_multiplier_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_9c16_AVX2, multiplier_2_with_output_stride) {
+    TEST_REQUIRES_X86_AVX2;
+    for (uint32_t channels = 2; channels <= 64; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(16)
+        .channels(channels)
+        .multiplier(2)
+        .width(5)
+        .outputStride(67)
+        .test(q8dw_multiplier_ukernel_9c16__avx2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, single_output_channels_eq_8) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .test(q8dw_ukernel_25c8__sse2);
+  }
+
+  TEST(Q8DW_25c8_SSE2, single_output_channels_eq_8_with_qmin) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmin(128)
+      .test(q8dw_ukernel_25c8__sse2);
+  }
+
+  TEST(Q8DW_25c8_SSE2, single_output_channels_eq_8_with_qmax) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmax(128)
+      .test(q8dw_ukernel_25c8__sse2);
+  }
+
+  TEST(Q8DW_25c8_SSE2, multi_output_channels_eq_8) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_25c8__sse2);
+  }
+
+  TEST(Q8DW_25c8_SSE2, multi_output_channels_eq_8_with_subsampling) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .subsampling(2)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_25c8__sse2);
+  }
+
+  TEST(Q8DW_25c8_SSE2, multi_output_channels_eq_8_with_input_stride) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .inputStride(17)
+      .test(q8dw_ukernel_25c8__sse2);
+  }
+
+  TEST(Q8DW_25c8_SSE2, multi_output_channels_eq_8_with_output_stride) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .outputStride(19)
+      .test(q8dw_ukernel_25c8__sse2);
+  }
+
+  TEST(Q8DW_25c8_SSE2, single_output_channels_div_8) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multi_output_channels_div_8) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multi_output_channels_div_8_with_output_stride) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(171)
+        .test(q8dw_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, single_output_channels_gt_8) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, single_output_channels_gt_8_with_qmin) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmin(128)
+        .test(q8dw_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, single_output_channels_gt_8_with_qmax) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmax(128)
+        .test(q8dw_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multi_output_channels_gt_8) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multi_output_channels_gt_8_with_output_stride) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(17)
+        .test(q8dw_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multi_output_channels_gt_8_with_input_offset) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multiplier_2) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multiplier_4) {
+    for (uint32_t channels = 4; channels <= 32; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(4)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multiplier_8) {
+    for (uint32_t channels = 8; channels <= 32; channels += 8) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(8)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multiplier_2_with_subsampling) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .subsampling(2)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multiplier_4_with_input_offset) {
+    for (uint32_t channels = 4; channels <= 32; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(4)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_multiplier_ukernel_25c8__sse2);
+    }
+  }
+
+  TEST(Q8DW_25c8_SSE2, multiplier_2_with_output_stride) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(5)
+        .outputStride(35)
+        .test(q8dw_multiplier_ukernel_25c8__sse2);
+    }
+  }
+#endif /* CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 */
+
+#if !CPUINFO_ARCH_ARM && !CPUINFO_ARCH_ARM64 && !CPUINFO_ARCH_X86 && !CPUINFO_ARCH_X86_64
+  TEST(Q8DW_9c8_PSIMD, single_output_channels_eq_8) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .test(q8dw_ukernel_9c8__psimd);
+  }
+
+  TEST(Q8DW_9c8_PSIMD, single_output_channels_eq_8_with_qmin) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmin(128)
+      .test(q8dw_ukernel_9c8__psimd);
+  }
+
+  TEST(Q8DW_9c8_PSIMD, single_output_channels_eq_8_with_qmax) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmax(128)
+      .test(q8dw_ukernel_9c8__psimd);
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multi_output_channels_eq_8) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_9c8__psimd);
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multi_output_channels_eq_8_with_subsampling) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .subsampling(2)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_9c8__psimd);
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multi_output_channels_eq_8_with_input_stride) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .inputStride(17)
+      .test(q8dw_ukernel_9c8__psimd);
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multi_output_channels_eq_8_with_output_stride) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .outputStride(19)
+      .test(q8dw_ukernel_9c8__psimd);
+  }
+
+  TEST(Q8DW_9c8_PSIMD, single_output_channels_div_8) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multi_output_channels_div_8) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multi_output_channels_div_8_with_output_stride) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(171)
+        .test(q8dw_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, single_output_channels_gt_8) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, single_output_channels_gt_8_with_qmin) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmin(128)
+        .test(q8dw_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, single_output_channels_gt_8_with_qmax) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmax(128)
+        .test(q8dw_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multi_output_channels_gt_8) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multi_output_channels_gt_8_with_output_stride) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(17)
+        .test(q8dw_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multi_output_channels_gt_8_with_input_offset) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multiplier_2) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multiplier_4) {
+    for (uint32_t channels = 4; channels <= 32; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(4)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multiplier_8) {
+    for (uint32_t channels = 8; channels <= 32; channels += 8) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(8)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multiplier_2_with_subsampling) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .subsampling(2)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multiplier_4_with_input_offset) {
+    for (uint32_t channels = 4; channels <= 32; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(4)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_multiplier_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_9c8_PSIMD, multiplier_2_with_output_stride) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(5)
+        .outputStride(35)
+        .test(q8dw_multiplier_ukernel_9c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, single_output_channels_eq_8) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .test(q8dw_ukernel_25c8__psimd);
+  }
+
+  TEST(Q8DW_25c8_PSIMD, single_output_channels_eq_8_with_qmin) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmin(128)
+      .test(q8dw_ukernel_25c8__psimd);
+  }
+
+  TEST(Q8DW_25c8_PSIMD, single_output_channels_eq_8_with_qmax) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmax(128)
+      .test(q8dw_ukernel_25c8__psimd);
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multi_output_channels_eq_8) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_25c8__psimd);
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multi_output_channels_eq_8_with_subsampling) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .subsampling(2)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_25c8__psimd);
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multi_output_channels_eq_8_with_input_stride) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .inputStride(17)
+      .test(q8dw_ukernel_25c8__psimd);
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multi_output_channels_eq_8_with_output_stride) {
+    DepthwiseMicrokernelTester()
+      .kernelHeight(5)
+      .kernelWidth(5)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .outputStride(19)
+      .test(q8dw_ukernel_25c8__psimd);
+  }
+
+  TEST(Q8DW_25c8_PSIMD, single_output_channels_div_8) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multi_output_channels_div_8) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multi_output_channels_div_8_with_output_stride) {
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(171)
+        .test(q8dw_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, single_output_channels_gt_8) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, single_output_channels_gt_8_with_qmin) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmin(128)
+        .test(q8dw_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, single_output_channels_gt_8_with_qmax) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmax(128)
+        .test(q8dw_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multi_output_channels_gt_8) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multi_output_channels_gt_8_with_output_stride) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(17)
+        .test(q8dw_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multi_output_channels_gt_8_with_input_offset) {
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multiplier_2) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multiplier_4) {
+    for (uint32_t channels = 4; channels <= 32; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(4)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multiplier_8) {
+    for (uint32_t channels = 8; channels <= 32; channels += 8) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(8)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multiplier_2_with_subsampling) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .subsampling(2)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(3)
+        .test(q8dw_multiplier_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multiplier_4_with_input_offset) {
+    for (uint32_t channels = 4; channels <= 32; channels += 4) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(4)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_multiplier_ukernel_25c8__psimd);
+    }
+  }
+
+  TEST(Q8DW_25c8_PSIMD, multiplier_2_with_output_stride) {
+    for (uint32_t channels = 2; channels <= 32; channels += 2) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(5)
+        .kernelWidth(5)
+        .cr(8)
+        .channels(channels)
+        .multiplier(2)
+        .width(5)
+        .outputStride(35)
+        .test(q8dw_multiplier_ukernel_25c8__psimd);
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+  TEST(Q8DW_9c8_RVV, single_output_channels_eq_8) {
+    TEST_REQUIRES_RISCV_V;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .test(q8dw_ukernel_9c8__rvv);
+  }
+
+  TEST(Q8DW_9c8_RVV, single_output_channels_eq_8_with_qmin) {
+    TEST_REQUIRES_RISCV_V;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmin(128)
+      .test(q8dw_ukernel_9c8__rvv);
+  }
+
+  TEST(Q8DW_9c8_RVV, single_output_channels_eq_8_with_qmax) {
+    TEST_REQUIRES_RISCV_V;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(1)
+      .qmax(128)
+      .test(q8dw_ukernel_9c8__rvv);
+  }
+
+  TEST(Q8DW_9c8_RVV, multi_output_channels_eq_8) {
+    TEST_REQUIRES_RISCV_V;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_9c8__rvv);
+  }
+
+  TEST(Q8DW_9c8_RVV, multi_output_channels_eq_8_with_subsampling) {
+    TEST_REQUIRES_RISCV_V;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .subsampling(2)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .test(q8dw_ukernel_9c8__rvv);
+  }
+
+  TEST(Q8DW_9c8_RVV, multi_output_channels_eq_8_with_input_stride) {
+    TEST_REQUIRES_RISCV_V;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .inputStride(17)
+      .test(q8dw_ukernel_9c8__rvv);
+  }
+
+  TEST(Q8DW_9c8_RVV, multi_output_channels_eq_8_with_output_stride) {
+    TEST_REQUIRES_RISCV_V;
+    DepthwiseMicrokernelTester()
+      .kernelHeight(3)
+      .kernelWidth(3)
+      .cr(8)
+      .channels(8)
+      .width(5)
+      .outputStride(19)
+      .test(q8dw_ukernel_9c8__rvv);
+  }
+
+  TEST(Q8DW_9c8_RVV, single_output_channels_div_8) {
+    TEST_REQUIRES_RISCV_V;
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_9c8__rvv);
+    }
+  }
+
+  TEST(Q8DW_9c8_RVV, multi_output_channels_div_8) {
+    TEST_REQUIRES_RISCV_V;
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_9c8__rvv);
+    }
+  }
+
+  TEST(Q8DW_9c8_RVV, multi_output_channels_div_8_with_output_stride) {
+    TEST_REQUIRES_RISCV_V;
+    for (uint32_t channels = 16; channels < 128; channels += 24) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(171)
+        .test(q8dw_ukernel_9c8__rvv);
+    }
+  }
+
+  TEST(Q8DW_9c8_RVV, single_output_channels_gt_8) {
+    TEST_REQUIRES_RISCV_V;
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .test(q8dw_ukernel_9c8__rvv);
+    }
+  }
+
+  TEST(Q8DW_9c8_RVV, single_output_channels_gt_8_with_qmin) {
+    TEST_REQUIRES_RISCV_V;
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmin(128)
+        .test(q8dw_ukernel_9c8__rvv);
+    }
+  }
+
+  TEST(Q8DW_9c8_RVV, single_output_channels_gt_8_with_qmax) {
+    TEST_REQUIRES_RISCV_V;
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(1)
+        .qmax(128)
+        .test(q8dw_ukernel_9c8__rvv);
+    }
+  }
+
+  TEST(Q8DW_9c8_RVV, multi_output_channels_gt_8) {
+    TEST_REQUIRES_RISCV_V;
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .test(q8dw_ukernel_9c8__rvv);
+    }
+  }
+
+  TEST(Q8DW_9c8_RVV, multi_output_channels_gt_8_with_output_stride) {
+    TEST_REQUIRES_RISCV_V;
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .outputStride(17)
+        .test(q8dw_ukernel_9c8__rvv);
+    }
+  }
+
+  TEST(Q8DW_9c8_RVV, multi_output_channels_gt_8_with_input_offset) {
+    TEST_REQUIRES_RISCV_V;
+    for (uint32_t channels = 9; channels < 16; channels++) {
+      DepthwiseMicrokernelTester()
+        .kernelHeight(3)
+        .kernelWidth(3)
+        .cr(8)
+        .channels(channels)
+        .width(5)
+        .inputOffset(16)
+        .inputStride(37)
+        .test(q8dw_ukernel_9c8__rvv);
+    }
+  }
+#endif
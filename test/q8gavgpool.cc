@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <qnnpack/q8gavgpool.h>
+
+#include "gavgpool-microkernel-tester.h"
+
+
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  TEST(Q8GAVGPOOL_8x_NEON, n_eq_8_m_eq_1) {
+    GAvgPoolMicrokernelTester()
+      .m(1)
+      .n(8)
+      .test(q8gavgpool_ukernel_8x__neon);
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, n_eq_8_m_gt_1) {
+    for (size_t m = 2; m <= 64; m++) {
+      GAvgPoolMicrokernelTester()
+        .m(m)
+        .n(8)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, n_eq_8_with_x_stride) {
+    for (size_t m = 1; m <= 49; m += 6) {
+      GAvgPoolMicrokernelTester()
+        .m(m)
+        .n(8)
+        .xStride(11)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, n_div_8) {
+    for (size_t n = 8; n < 128; n += 24) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, n_gt_8_with_x_stride) {
+    for (size_t n = 9; n < 16; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .xStride(23)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, n_lt_8_with_x_stride) {
+    for (size_t n = 1; n < 8; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .xStride(11)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, x_scale) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (float xScale = 0.01f; xScale < 1.0f; xScale *= 3.14159265f) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .xScale(xScale)
+          .iterations(1)
+          .test(q8gavgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, x_zero_point) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (int32_t xZeroPoint = 0; xZeroPoint <= 255; xZeroPoint += 51) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .xZeroPoint(uint8_t(xZeroPoint))
+          .iterations(1)
+          .test(q8gavgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, y_scale) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (float yScale = 0.1f; yScale < 100.0f; yScale *= 3.14159265f) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .yScale(yScale)
+          .iterations(1)
+          .test(q8gavgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, y_zero_point) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (int32_t yZeroPoint = 0; yZeroPoint <= 255; yZeroPoint += 51) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .yZeroPoint(uint8_t(yZeroPoint))
+          .iterations(1)
+          .test(q8gavgpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, qmin) {
+    for (size_t n = 1; n < 24; n += 5) {
+      GAvgPoolMicrokernelTester()
+        .m(49)
+        .n(n)
+        .qmin(128)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_NEON, qmax) {
+    for (size_t n = 1; n < 24; n += 5) {
+      GAvgPoolMicrokernelTester()
+        .m(49)
+        .n(n)
+        .qmax(128)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_8x__neon);
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  TEST(Q8GAVGPOOL_8x_SSE2, n_eq_8_m_eq_1) {
+    GAvgPoolMicrokernelTester()
+      .m(1)
+      .n(8)
+      .test(q8gavgpool_ukernel_8x__sse2);
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, n_eq_8_m_gt_1) {
+    for (size_t m = 2; m <= 64; m++) {
+      GAvgPoolMicrokernelTester()
+        .m(m)
+        .n(8)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, n_eq_8_with_x_stride) {
+    for (size_t m = 1; m <= 49; m += 6) {
+      GAvgPoolMicrokernelTester()
+        .m(m)
+        .n(8)
+        .xStride(11)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, n_div_8) {
+    for (size_t n = 8; n < 128; n += 24) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, n_gt_8_with_x_stride) {
+    for (size_t n = 9; n < 16; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .xStride(23)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, n_lt_8_with_x_stride) {
+    for (size_t n = 1; n < 8; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .xStride(11)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, x_scale) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (float xScale = 0.01f; xScale < 1.0f; xScale *= 3.14159265f) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .xScale(xScale)
+          .iterations(1)
+          .test(q8gavgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, x_zero_point) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (int32_t xZeroPoint = 0; xZeroPoint <= 255; xZeroPoint += 51) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .xZeroPoint(uint8_t(xZeroPoint))
+          .iterations(1)
+          .test(q8gavgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, y_scale) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (float yScale = 0.1f; yScale < 100.0f; yScale *= 3.14159265f) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .yScale(yScale)
+          .iterations(1)
+          .test(q8gavgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, y_zero_point) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (int32_t yZeroPoint = 0; yZeroPoint <= 255; yZeroPoint += 51) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .yZeroPoint(uint8_t(yZeroPoint))
+          .iterations(1)
+          .test(q8gavgpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, qmin) {
+    for (size_t n = 1; n < 24; n += 5) {
+      GAvgPoolMicrokernelTester()
+        .m(49)
+        .n(n)
+        .qmin(128)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(Q8GAVGPOOL_8x_SSE2, qmax) {
+    for (size_t n = 1; n < 24; n += 5) {
+      GAvgPoolMicrokernelTester()
+        .m(49)
+        .n(n)
+        .qmax(128)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_8x__sse2);
+    }
+  }
+#endif
+
+#if !CPUINFO_ARCH_ARM && !CPUINFO_ARCH_ARM64 && !CPUINFO_ARCH_X86 && !CPUINFO_ARCH_X86_64
+  TEST(Q8GAVGPOOL_1x_SCALAR, n_eq_8_m_eq_1) {
+    GAvgPoolMicrokernelTester()
+      .m(1)
+      .n(8)
+      .test(q8gavgpool_ukernel_1x__scalar);
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, n_eq_8_m_gt_1) {
+    for (size_t m = 2; m <= 64; m++) {
+      GAvgPoolMicrokernelTester()
+        .m(m)
+        .n(8)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, n_eq_8_with_x_stride) {
+    for (size_t m = 1; m <= 49; m += 6) {
+      GAvgPoolMicrokernelTester()
+        .m(m)
+        .n(8)
+        .xStride(11)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, n_div_8) {
+    for (size_t n = 8; n < 128; n += 24) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, n_gt_8_with_x_stride) {
+    for (size_t n = 9; n < 16; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .xStride(23)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, n_lt_8_with_x_stride) {
+    for (size_t n = 1; n < 8; n++) {
+      for (size_t m = 1; m <= 49; m += 12) {
+        GAvgPoolMicrokernelTester()
+          .m(m)
+          .n(n)
+          .xStride(11)
+          .iterations(3)
+          .test(q8gavgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, x_scale) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (float xScale = 0.01f; xScale < 1.0f; xScale *= 3.14159265f) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .xScale(xScale)
+          .iterations(1)
+          .test(q8gavgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, x_zero_point) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (int32_t xZeroPoint = 0; xZeroPoint <= 255; xZeroPoint += 51) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .xZeroPoint(uint8_t(xZeroPoint))
+          .iterations(1)
+          .test(q8gavgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, y_scale) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (float yScale = 0.1f; yScale < 100.0f; yScale *= 3.14159265f) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .yScale(yScale)
+          .iterations(1)
+          .test(q8gavgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, y_zero_point) {
+    for (size_t n = 1; n < 24; n += 5) {
+      for (int32_t yZeroPoint = 0; yZeroPoint <= 255; yZeroPoint += 51) {
+        GAvgPoolMicrokernelTester()
+          .m(49)
+          .n(n)
+          .yZeroPoint(uint8_t(yZeroPoint))
+          .iterations(1)
+          .test(q8gavgpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, qmin) {
+    for (size_t n = 1; n < 24; n += 5) {
+      GAvgPoolMicrokernelTester()
+        .m(49)
+        .n(n)
+        .qmin(128)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(Q8GAVGPOOL_1x_SCALAR, qmax) {
+    for (size_t n = 1; n < 24; n += 5) {
+      GAvgPoolMicrokernelTester()
+        .m(49)
+        .n(n)
+        .qmax(128)
+        .iterations(3)
+        .test(q8gavgpool_ukernel_1x__scalar);
+    }
+  }
+#endif
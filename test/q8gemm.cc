@@ -12,6 +12,40 @@
 #include <gemm-tester.h>
 #include <qnnpack/q8gemm.h>
 
+#if CPUINFO_ARCH_ARM64
+  #define TEST_REQUIRES_ARM_NEON_DOT \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_arm_neon_dot()) { \
+        return; \
+      } \
+    } while (0)
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  #define TEST_REQUIRES_X86_AVX2 \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_x86_avx2()) { \
+        return; \
+      } \
+    } while (0)
+
+  #define TEST_REQUIRES_X86_AVX512VNNI \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_x86_avx512vnni() || !cpuinfo_has_x86_avx512vl()) { \
+        return; \
+      } \
+    } while (0)
+#endif
+
+#if CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+  #define TEST_REQUIRES_RISCV_V \
+    do { \
+      if (!cpuinfo_initialize() || !cpuinfo_has_riscv_v()) { \
+        return; \
+      } \
+    } while (0)
+#endif
+
 // clang-format off
 
 #if CPUINFO_ARCH_ARM
@@ -586,118 +620,125 @@
       }
     }
   }
-#endif
 
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
-  TEST(Q8GEMM_4x8_NEON, k_eq_8) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_eq_8) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(1)
+      .kr(4)
       .m(4)
       .n(8)
       .k(8)
-      .testMicroKernel(q8gemm_ukernel_4x8__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_eq_8_strided_a) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_eq_8_strided_a) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(1)
+      .kr(4)
       .m(4)
       .n(8)
       .k(8)
       .aStride(37)
-      .testMicroKernel(q8gemm_ukernel_4x8__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_eq_8_strided_c) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_eq_8_strided_c) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(1)
+      .kr(4)
       .m(4)
       .n(8)
       .k(8)
       .cStride(17)
-      .testMicroKernel(q8gemm_ukernel_4x8__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_eq_8_qmin128) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_eq_8_qmin128) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(1)
+      .kr(4)
       .m(4)
       .n(8)
       .k(8)
       .qmin(128)
-      .testMicroKernel(q8gemm_ukernel_4x8__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_eq_8_qmax128) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_eq_8_qmax128) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(1)
+      .kr(4)
       .m(4)
       .n(8)
       .k(8)
       .qmax(128)
-      .testMicroKernel(q8gemm_ukernel_4x8__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_gt_8) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_gt_8) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
-        .testMicroKernel(q8gemm_ukernel_4x8__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_gt_8_strided_a) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_gt_8_strided_a) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
         .aStride(37)
-        .testMicroKernel(q8gemm_ukernel_4x8__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_gt_8_strided_c) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_gt_8_strided_c) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
         .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_4x8__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_gt_8_subtile) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_gt_8_subtile) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 9; k < 16; k++) {
       for (uint32_t m = 1; m <= 4; m++) {
         for (uint32_t n = 1; n <= 8; n++) {
@@ -705,62 +746,66 @@
             .mr(4)
             .nr(8)
             .np(8)
-            .kr(1)
+            .kr(4)
             .m(m)
             .n(n)
             .k(k)
             .iterations(3)
-            .testMicroKernel(q8gemm_ukernel_4x8__neon);
+            .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
         }
       }
     }
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_div_8) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_div_8) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
-        .testMicroKernel(q8gemm_ukernel_4x8__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_div_8_strided_a) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_div_8_strided_a) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
         .aStride(171)
-        .testMicroKernel(q8gemm_ukernel_4x8__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_div_8_strided_c) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_div_8_strided_c) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
         .mr(4)
         .nr(8)
         .np(8)
-        .kr(1)
+        .kr(4)
         .m(4)
         .n(8)
         .k(k)
         .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_4x8__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
     }
   }
 
-  TEST(Q8GEMM_4x8_NEON, k_div_8_subtile) {
+  TEST(Q8GEMM_4x8c4_NEONDOT, k_div_8_subtile) {
+    TEST_REQUIRES_ARM_NEON_DOT;
     for (size_t k = 16; k < 128; k += 24) {
       for (uint32_t m = 1; m <= 4; m++) {
         for (uint32_t n = 1; n <= 8; n++) {
@@ -768,505 +813,450 @@
             .mr(4)
             .nr(8)
             .np(8)
-            .kr(1)
+            .kr(4)
             .m(m)
             .n(n)
             .k(k)
             .iterations(3)
-            .testMicroKernel(q8gemm_ukernel_4x8__neon);
+            .testMicroKernel(q8gemm_ukernel_4x8c4__neondot);
         }
       }
     }
   }
+#endif
 
-  TEST(Q8GEMM_8x8_NEON, k_eq_8) {
-    GemmTester()
-      .mr(8)
-      .nr(8)
-      .np(8)
-      .kr(1)
-      .m(8)
-      .n(8)
-      .k(8)
-      .testMicroKernel(q8gemm_ukernel_8x8__neon);
-  }
-
-  TEST(Q8GEMM_8x8_NEON, k_eq_8_strided_a) {
-    GemmTester()
-      .mr(8)
-      .nr(8)
-      .np(8)
-      .kr(1)
-      .m(8)
-      .n(8)
-      .k(8)
-      .aStride(37)
-      .testMicroKernel(q8gemm_ukernel_8x8__neon);
-  }
-
-  TEST(Q8GEMM_8x8_NEON, k_eq_8_strided_c) {
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  TEST(Q8GEMM_1x8_NEON, k_eq_8) {
     GemmTester()
-      .mr(8)
+      .mr(1)
       .nr(8)
       .np(8)
       .kr(1)
-      .m(8)
+      .m(1)
       .n(8)
       .k(8)
-      .cStride(17)
-      .testMicroKernel(q8gemm_ukernel_8x8__neon);
+      .testMicroKernel(q8gemm_ukernel_1x8__neon);
   }
 
-  TEST(Q8GEMM_8x8_NEON, k_eq_8_qmin128) {
+  TEST(Q8GEMM_1x8_NEON, k_eq_8_qmin128) {
     GemmTester()
-      .mr(8)
+      .mr(1)
       .nr(8)
       .np(8)
       .kr(1)
-      .m(8)
+      .m(1)
       .n(8)
       .k(8)
       .qmin(128)
-      .testMicroKernel(q8gemm_ukernel_8x8__neon);
+      .testMicroKernel(q8gemm_ukernel_1x8__neon);
   }
 
-  TEST(Q8GEMM_8x8_NEON, k_eq_8_qmax128) {
+  TEST(Q8GEMM_1x8_NEON, k_eq_8_qmax128) {
     GemmTester()
-      .mr(8)
+      .mr(1)
       .nr(8)
       .np(8)
       .kr(1)
-      .m(8)
+      .m(1)
       .n(8)
       .k(8)
       .qmax(128)
-      .testMicroKernel(q8gemm_ukernel_8x8__neon);
+      .testMicroKernel(q8gemm_ukernel_1x8__neon);
   }
 
-  TEST(Q8GEMM_8x8_NEON, k_gt_8) {
-    for (size_t k = 9; k < 16; k++) {
+  TEST(Q8GEMM_1x8_NEON, k_lt_8) {
+    for (size_t k = 1; k < 8; k++) {
       GemmTester()
-        .mr(8)
+        .mr(1)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(1)
         .n(8)
         .k(k)
-        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+        .testMicroKernel(q8gemm_ukernel_1x8__neon);
     }
   }
 
-  TEST(Q8GEMM_8x8_NEON, k_gt_8_strided_a) {
+  TEST(Q8GEMM_1x8_NEON, k_gt_8) {
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(8)
+        .mr(1)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(1)
         .n(8)
         .k(k)
-        .aStride(37)
-        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+        .testMicroKernel(q8gemm_ukernel_1x8__neon);
     }
   }
 
-  TEST(Q8GEMM_8x8_NEON, k_gt_8_strided_c) {
+  TEST(Q8GEMM_1x8_NEON, k_gt_8_subtile) {
     for (size_t k = 9; k < 16; k++) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(1)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_ukernel_1x8__neon);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_1x8_NEON, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
-        .mr(8)
+        .mr(1)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(1)
         .n(8)
         .k(k)
-        .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+        .testMicroKernel(q8gemm_ukernel_1x8__neon);
     }
   }
 
-  TEST(Q8GEMM_8x8_NEON, k_gt_8_subtile) {
-    for (size_t k = 9; k < 16; k++) {
-      for (uint32_t m = 1; m <= 8; m++) {
-        for (uint32_t n = 1; n <= 8; n++) {
-          GemmTester()
-            .mr(8)
-            .nr(8)
-            .np(8)
-            .kr(1)
-            .m(m)
-            .n(n)
-            .k(k)
-            .iterations(3)
-            .testMicroKernel(q8gemm_ukernel_8x8__neon);
-        }
+  TEST(Q8GEMM_1x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(1)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_ukernel_1x8__neon);
       }
     }
   }
 
-  TEST(Q8GEMM_8x8_NEON, k_div_8) {
-    for (size_t k = 16; k < 128; k += 8) {
+  TEST(Q8GEMM_ACC32_1x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(1)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_acc32_ukernel_1x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC32_1x8_NEON, k_lt_8) {
+    for (size_t k = 1; k < 8; k++) {
       GemmTester()
-        .mr(8)
+        .mr(1)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(1)
         .n(8)
         .k(k)
-        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8__neon);
     }
   }
 
-  TEST(Q8GEMM_8x8_NEON, k_div_8_strided_a) {
-    for (size_t k = 16; k < 128; k += 8) {
+  TEST(Q8GEMM_ACC32_1x8_NEON, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(8)
+        .mr(1)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(1)
         .n(8)
         .k(k)
-        .aStride(171)
-        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8__neon);
     }
   }
 
-  TEST(Q8GEMM_8x8_NEON, k_div_8_strided_c) {
+  TEST(Q8GEMM_ACC32_1x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(1)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_acc32_ukernel_1x8__neon);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8_NEON, k_div_8) {
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
-        .mr(8)
+        .mr(1)
         .nr(8)
         .np(8)
         .kr(1)
-        .m(8)
+        .m(1)
         .n(8)
         .k(k)
-        .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_8x8__neon);
-    }
-  }
-
-  TEST(Q8GEMM_8x8_NEON, k_div_8_subtile) {
-    for (size_t k = 16; k < 128; k += 24) {
-      for (uint32_t m = 1; m <= 8; m++) {
-        for (uint32_t n = 1; n <= 8; n++) {
-          GemmTester()
-            .mr(8)
-            .nr(8)
-            .np(8)
-            .kr(1)
-            .m(m)
-            .n(n)
-            .k(k)
-            .iterations(3)
-            .testMicroKernel(q8gemm_ukernel_8x8__neon);
-        }
-      }
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8__neon);
     }
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_eq_8) {
+  TEST(Q8GEMM_4x8_NEON, k_eq_8) {
     GemmTester()
-      .mr(6)
-      .nr(4)
-      .np(4)
+      .mr(4)
+      .nr(8)
+      .np(8)
       .kr(1)
-      .m(6)
-      .n(4)
+      .m(4)
+      .n(8)
       .k(8)
-      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_eq_8_strided_a) {
+  TEST(Q8GEMM_4x8_NEON, k_eq_8_strided_a) {
     GemmTester()
-      .mr(6)
-      .nr(4)
-      .np(4)
+      .mr(4)
+      .nr(8)
+      .np(8)
       .kr(1)
-      .m(6)
-      .n(4)
+      .m(4)
+      .n(8)
       .k(8)
       .aStride(37)
-      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_eq_8_strided_c) {
+  TEST(Q8GEMM_4x8_NEON, k_eq_8_strided_c) {
     GemmTester()
-      .mr(6)
-      .nr(4)
-      .np(4)
+      .mr(4)
+      .nr(8)
+      .np(8)
       .kr(1)
-      .m(6)
-      .n(4)
+      .m(4)
+      .n(8)
       .k(8)
       .cStride(17)
-      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_eq_8_qmin128) {
+  TEST(Q8GEMM_4x8_NEON, k_eq_8_qmin128) {
     GemmTester()
-      .mr(6)
-      .nr(4)
-      .np(4)
+      .mr(4)
+      .nr(8)
+      .np(8)
       .kr(1)
-      .m(6)
-      .n(4)
+      .m(4)
+      .n(8)
       .k(8)
       .qmin(128)
-      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_eq_8_qmax128) {
+  TEST(Q8GEMM_4x8_NEON, k_eq_8_qmax128) {
     GemmTester()
-      .mr(6)
-      .nr(4)
-      .np(4)
+      .mr(4)
+      .nr(8)
+      .np(8)
       .kr(1)
-      .m(6)
-      .n(4)
+      .m(4)
+      .n(8)
       .k(8)
       .qmax(128)
-      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+      .testMicroKernel(q8gemm_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_gt_8) {
+  TEST(Q8GEMM_4x8_NEON, k_gt_8) {
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(6)
-        .nr(4)
-        .np(4)
+        .mr(4)
+        .nr(8)
+        .np(8)
         .kr(1)
-        .m(6)
-        .n(4)
+        .m(4)
+        .n(8)
         .k(k)
-        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_gt_8_strided_a) {
+  TEST(Q8GEMM_4x8_NEON, k_gt_8_strided_a) {
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(6)
-        .nr(4)
-        .np(4)
+        .mr(4)
+        .nr(8)
+        .np(8)
         .kr(1)
-        .m(6)
-        .n(4)
+        .m(4)
+        .n(8)
         .k(k)
         .aStride(37)
-        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_gt_8_strided_c) {
+  TEST(Q8GEMM_4x8_NEON, k_gt_8_strided_c) {
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(6)
-        .nr(4)
-        .np(4)
+        .mr(4)
+        .nr(8)
+        .np(8)
         .kr(1)
-        .m(6)
-        .n(4)
+        .m(4)
+        .n(8)
         .k(k)
         .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_gt_8_subtile) {
+  TEST(Q8GEMM_4x8_NEON, k_gt_8_subtile) {
     for (size_t k = 9; k < 16; k++) {
-      for (uint32_t m = 1; m <= 6; m++) {
-        for (uint32_t n = 1; n <= 4; n++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
-            .mr(6)
-            .nr(4)
-            .np(4)
+            .mr(4)
+            .nr(8)
+            .np(8)
             .kr(1)
             .m(m)
             .n(n)
             .k(k)
             .iterations(3)
-            .testMicroKernel(q8gemm_ukernel_6x4__neon);
+            .testMicroKernel(q8gemm_ukernel_4x8__neon);
         }
       }
     }
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_div_8) {
+  TEST(Q8GEMM_4x8_NEON, k_div_8) {
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
-        .mr(6)
-        .nr(4)
-        .np(4)
+        .mr(4)
+        .nr(8)
+        .np(8)
         .kr(1)
-        .m(6)
-        .n(4)
+        .m(4)
+        .n(8)
         .k(k)
-        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_div_8_strided_a) {
+  TEST(Q8GEMM_4x8_NEON, k_div_8_strided_a) {
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
-        .mr(6)
-        .nr(4)
-        .np(4)
+        .mr(4)
+        .nr(8)
+        .np(8)
         .kr(1)
-        .m(6)
-        .n(4)
+        .m(4)
+        .n(8)
         .k(k)
         .aStride(171)
-        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_div_8_strided_c) {
+  TEST(Q8GEMM_4x8_NEON, k_div_8_strided_c) {
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
-        .mr(6)
-        .nr(4)
-        .np(4)
+        .mr(4)
+        .nr(8)
+        .np(8)
         .kr(1)
-        .m(6)
-        .n(4)
+        .m(4)
+        .n(8)
         .k(k)
         .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+        .testMicroKernel(q8gemm_ukernel_4x8__neon);
     }
   }
 
-  TEST(Q8GEMM_6x4_NEON, k_div_8_subtile) {
+  TEST(Q8GEMM_4x8_NEON, k_div_8_subtile) {
     for (size_t k = 16; k < 128; k += 24) {
-      for (uint32_t m = 1; m <= 6; m++) {
-        for (uint32_t n = 1; n <= 4; n++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
-            .mr(6)
-            .nr(4)
-            .np(4)
+            .mr(4)
+            .nr(8)
+            .np(8)
             .kr(1)
             .m(m)
             .n(n)
             .k(k)
-            .testMicroKernel(q8gemm_ukernel_6x4__neon);
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_4x8__neon);
         }
       }
     }
   }
 
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8) {
+  TEST(Q8GEMM_FOLDED_4x8_NEON, k_eq_8) {
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(2)
+      .kr(1)
       .m(4)
       .n(8)
       .k(8)
-      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8_strided_a) {
+  TEST(Q8GEMM_FOLDED_4x8_NEON, k_eq_8_strided_a) {
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(2)
+      .kr(1)
       .m(4)
       .n(8)
       .k(8)
       .aStride(37)
-      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
-  }
-
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8_strided_c) {
-    GemmTester()
-      .mr(4)
-      .nr(8)
-      .np(8)
-      .kr(2)
-      .m(4)
-      .n(8)
-      .k(8)
-      .cStride(17)
-      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8_qmin128) {
+  TEST(Q8GEMM_FOLDED_4x8_NEON, k_eq_8_qmin128) {
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(2)
+      .kr(1)
       .m(4)
       .n(8)
       .k(8)
       .qmin(128)
-      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8_qmax128) {
+  TEST(Q8GEMM_FOLDED_4x8_NEON, k_eq_8_qmax128) {
     GemmTester()
       .mr(4)
       .nr(8)
       .np(8)
-      .kr(2)
+      .kr(1)
       .m(4)
       .n(8)
       .k(8)
       .qmax(128)
-      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
-  }
-
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_gt_8) {
-    for (size_t k = 9; k < 16; k++) {
-      GemmTester()
-        .mr(4)
-        .nr(8)
-        .np(8)
-        .kr(2)
-        .m(4)
-        .n(8)
-        .k(k)
-        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
-    }
-  }
-
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_gt_8_strided_a) {
-    for (size_t k = 9; k < 16; k++) {
-      GemmTester()
-        .mr(4)
-        .nr(8)
-        .np(8)
-        .kr(2)
-        .m(4)
-        .n(8)
-        .k(k)
-        .aStride(37)
-        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
-    }
-  }
-
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_gt_8_strided_c) {
-    for (size_t k = 9; k < 16; k++) {
-      GemmTester()
-        .mr(4)
-        .nr(8)
-        .np(8)
-        .kr(2)
-        .m(4)
-        .n(8)
-        .k(k)
-        .cStride(17)
-        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
-    }
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_gt_8_subtile) {
+  TEST(Q8GEMM_FOLDED_4x8_NEON, k_gt_8_subtile) {
     for (size_t k = 9; k < 16; k++) {
       for (uint32_t m = 1; m <= 4; m++) {
         for (uint32_t n = 1; n <= 8; n++) {
@@ -1274,62 +1264,19 @@
             .mr(4)
             .nr(8)
             .np(8)
-            .kr(2)
+            .kr(1)
             .m(m)
             .n(n)
             .k(k)
             .iterations(3)
-            .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x8__neon);
         }
       }
     }
   }
 
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_div_8) {
-    for (size_t k = 16; k < 128; k += 8) {
-      GemmTester()
-        .mr(4)
-        .nr(8)
-        .np(8)
-        .kr(2)
-        .m(4)
-        .n(8)
-        .k(k)
-        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
-    }
-  }
-
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_div_8_strided_a) {
-    for (size_t k = 16; k < 128; k += 8) {
-      GemmTester()
-        .mr(4)
-        .nr(8)
-        .np(8)
-        .kr(2)
-        .m(4)
-        .n(8)
-        .k(k)
-        .aStride(171)
-        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
-    }
-  }
-
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_div_8_strided_c) {
-    for (size_t k = 16; k < 128; k += 8) {
-      GemmTester()
-        .mr(4)
-        .nr(8)
-        .np(8)
-        .kr(2)
-        .m(4)
-        .n(8)
-        .k(k)
-        .cStride(17)
-        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
-    }
-  }
-
-  TEST(Q8GEMM_4x8c2_XZP_NEON, k_div_8_subtile) {
+  TEST(Q8GEMM_FOLDED_4x8_NEON, k_div_8_subtile) {
     for (size_t k = 16; k < 128; k += 24) {
       for (uint32_t m = 1; m <= 4; m++) {
         for (uint32_t n = 1; n <= 8; n++) {
@@ -1337,394 +1284,4460 @@
             .mr(4)
             .nr(8)
             .np(8)
-            .kr(2)
+            .kr(1)
             .m(m)
             .n(n)
             .k(k)
             .iterations(3)
-            .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x8__neon);
         }
       }
     }
   }
-#endif
 
-#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
-  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8) {
+  TEST(Q8GEMM_RELU_4x8_NEON, k_eq_8_qmin128) {
     GemmTester()
-      .mr(2)
-      .nr(4)
-      .np(1)
-      .kr(8)
-      .m(2)
-      .n(4)
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
       .k(8)
-      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+      .qmin(128)
+      .testMicroKernel(q8gemm_relu_ukernel_4x8__neon);
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8_strided_a) {
-    GemmTester()
-      .mr(2)
+  TEST(Q8GEMM_RELU_4x8_NEON, k_gt_8_subtile_qmin128) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .qmin(128)
+            .testMicroKernel(q8gemm_relu_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_UNCLAMPED_4x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_unclamped_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_UNCLAMPED_4x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_unclamped_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC16_4x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_4x8_NEON, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_4x8_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_4x8_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_4x8_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_4x8_NEON, k_lt_8) {
+    for (size_t k = 1; k < 8; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .acc16(true)
+        .testMicroKernel(q8gemm_acc16_ukernel_4x8__neon);
+    }
+  }
+
+  TEST(Q8GEMM_ACC16_4x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .acc16(true)
+            .testMicroKernel(q8gemm_acc16_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC16_4x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .acc16(true)
+            .testMicroKernel(q8gemm_acc16_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FP32_4x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_FP32_4x8_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_FP32_4x8_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_FP32_4x8_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x8__neon);
+  }
+
+  TEST(Q8GEMM_FP32_4x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8gemm_fp32_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FP32_4x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8gemm_fp32_ukernel_4x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8gemm_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .testMicroKernel(q8gemm_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_gt_8_strided_a) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_gt_8_strided_c) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 8; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(8)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_8x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_div_8_strided_a) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_div_8_strided_c) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8GEMM_8x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 8; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(8)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_8x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC16_8x8_NEON, k_eq_8) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_8x8_NEON, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_8x8_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_8x8_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_8x8_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(8)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(8)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .acc16(true)
+      .testMicroKernel(q8gemm_acc16_ukernel_8x8__neon);
+  }
+
+  TEST(Q8GEMM_ACC16_8x8_NEON, k_lt_8) {
+    for (size_t k = 1; k < 8; k++) {
+      GemmTester()
+        .mr(8)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(8)
+        .n(8)
+        .k(k)
+        .acc16(true)
+        .testMicroKernel(q8gemm_acc16_ukernel_8x8__neon);
+    }
+  }
+
+  TEST(Q8GEMM_ACC16_8x8_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 8; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(8)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .acc16(true)
+            .testMicroKernel(q8gemm_acc16_ukernel_8x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC16_8x8_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 8; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(8)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .acc16(true)
+            .testMicroKernel(q8gemm_acc16_ukernel_8x8__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_eq_8) {
+    GemmTester()
+      .mr(6)
+      .nr(4)
+      .np(4)
+      .kr(1)
+      .m(6)
+      .n(4)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(6)
+      .nr(4)
+      .np(4)
+      .kr(1)
+      .m(6)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(6)
+      .nr(4)
+      .np(4)
+      .kr(1)
+      .m(6)
+      .n(4)
+      .k(8)
+      .cStride(17)
+      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(6)
+      .nr(4)
+      .np(4)
+      .kr(1)
+      .m(6)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(6)
+      .nr(4)
+      .np(4)
+      .kr(1)
+      .m(6)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_ukernel_6x4__neon);
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(6)
+        .nr(4)
+        .np(4)
+        .kr(1)
+        .m(6)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+    }
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_gt_8_strided_a) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(6)
+        .nr(4)
+        .np(4)
+        .kr(1)
+        .m(6)
+        .n(4)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+    }
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_gt_8_strided_c) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(6)
+        .nr(4)
+        .np(4)
+        .kr(1)
+        .m(6)
+        .n(4)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+    }
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 6; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(6)
+            .nr(4)
+            .np(4)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_6x4__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(6)
+        .nr(4)
+        .np(4)
+        .kr(1)
+        .m(6)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+    }
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_div_8_strided_a) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(6)
+        .nr(4)
+        .np(4)
+        .kr(1)
+        .m(6)
+        .n(4)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+    }
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_div_8_strided_c) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(6)
+        .nr(4)
+        .np(4)
+        .kr(1)
+        .m(6)
+        .n(4)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_6x4__neon);
+    }
+  }
+
+  TEST(Q8GEMM_6x4_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 6; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(6)
+            .nr(4)
+            .np(4)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .testMicroKernel(q8gemm_ukernel_6x4__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_gt_8_strided_a) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_gt_8_strided_c) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_div_8_strided_a) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_div_8_strided_c) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_XZP_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_xzp_ukernel_4x8c2__neon, q8sumrows_ukernel_4x__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__neon);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_NEON, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__neon);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .cStride(17)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__neon);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__neon);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__neon);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_NEON, k_lt_8) {
+    for (size_t k = 4; k < 8; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(4)
+        .m(4)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__neon);
+    }
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_NEON, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(4)
+        .m(4)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__neon);
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_4x8c2_NEON, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_4x8c2_NEON, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_4x8c2_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_4x8c2_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_4x8c2_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_4x8c2_NEON, k_lt_8) {
+    for (size_t k = 2; k < 8; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .fourBitKernel(true)
+        .testMicroKernel(q8gemm_4bit_ukernel_4x8c2__neon);
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_4x8c2_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fourBitKernel(true)
+            .testMicroKernel(q8gemm_4bit_ukernel_4x8c2__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_4x8c2_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fourBitKernel(true)
+            .testMicroKernel(q8gemm_4bit_ukernel_4x8c2__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_1x8c2_NEON, k_eq_8) {
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(1)
+      .n(8)
+      .k(8)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_1x8c2_NEON, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(1)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_1x8c2_NEON, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(1)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_1x8c2_NEON, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(1)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_1x8c2_NEON, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(1)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x8c2__neon);
+  }
+
+  TEST(Q8GEMM_4BIT_1x8c2_NEON, k_lt_8) {
+    for (size_t k = 2; k < 8; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(1)
+        .n(8)
+        .k(k)
+        .fourBitKernel(true)
+        .testMicroKernel(q8gemm_4bit_ukernel_1x8c2__neon);
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_1x8c2_NEON, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 1; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(1)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fourBitKernel(true)
+            .testMicroKernel(q8gemm_4bit_ukernel_1x8c2__neon);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_1x8c2_NEON, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 1; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(1)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fourBitKernel(true)
+            .testMicroKernel(q8gemm_4bit_ukernel_1x8c2__neon);
+        }
+      }
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(2)
+      .nr(4)
+      .np(1)
+      .kr(8)
+      .m(2)
+      .n(4)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(2)
+      .nr(4)
+      .np(1)
+      .kr(8)
+      .m(2)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(2)
+      .nr(4)
+      .np(1)
+      .kr(8)
+      .m(2)
+      .n(4)
+      .k(8)
+      .cStride(17)
+      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(2)
+      .nr(4)
+      .np(1)
+      .kr(8)
+      .m(2)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(2)
+      .nr(4)
+      .np(1)
+      .kr(8)
+      .m(2)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(2)
+        .nr(4)
+        .np(1)
+        .kr(8)
+        .m(2)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_gt_8_strided_a) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(2)
+        .nr(4)
+        .np(1)
+        .kr(8)
+        .m(2)
+        .n(4)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_gt_8_strided_c) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(2)
+        .nr(4)
+        .np(1)
+        .kr(8)
+        .m(2)
+        .n(4)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 2; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(2)
+            .nr(4)
+            .np(1)
+            .kr(8)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(2)
+        .nr(4)
+        .np(1)
+        .kr(8)
+        .m(2)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_div_8_strided_a) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(2)
+        .nr(4)
+        .np(1)
+        .kr(8)
+        .m(2)
+        .n(4)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_div_8_strided_c) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(2)
+        .nr(4)
+        .np(1)
+        .kr(8)
+        .m(2)
+        .n(4)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_2x4c8_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 2; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(2)
+            .nr(4)
+            .np(1)
+            .kr(8)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_1x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(1)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(1)
+      .n(4)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_1x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_1x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(1)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(1)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_ukernel_1x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_1x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(1)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(1)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_ukernel_1x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_1x4c2_SSE2, k_lt_8) {
+    for (size_t k = 2; k < 8; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(1)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_1x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_1x4c2_SSE2, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(1)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_1x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_1x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t n = 1; n <= 4; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(4)
+          .np(4)
+          .kr(2)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_ukernel_1x4c2__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_1x4c2_SSE2, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(1)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(1)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_1x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_1x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t n = 1; n <= 4; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(4)
+          .np(4)
+          .kr(2)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_ukernel_1x4c2__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(1)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(1)
+      .n(4)
+      .k(8)
+      .testMicroKernel(q8gemm_acc32_ukernel_1x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_ACC32_1x4c2_SSE2, k_lt_8) {
+    for (size_t k = 2; k < 8; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(1)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x4c2_SSE2, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(1)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t n = 1; n <= 4; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(4)
+          .np(4)
+          .kr(2)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_acc32_ukernel_1x4c2__sse2);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x4c2_SSE2, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(1)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(1)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .cStride(17)
+      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_gt_8_strided_a) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_gt_8_strided_c) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_div_8_strided_a) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_div_8_strided_c) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_4x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FOLDED_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x4c2_SSE2, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FOLDED_4x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_RELU_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_relu_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_RELU_4x4c2_SSE2, k_gt_8_subtile_qmin128) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .qmin(128)
+            .testMicroKernel(q8gemm_relu_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_UNCLAMPED_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .testMicroKernel(q8gemm_unclamped_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_UNCLAMPED_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_unclamped_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FP32_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_FP32_4x4c2_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .cStride(17)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_FP32_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_FP32_4x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_FP32_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8gemm_fp32_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FP32_4x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8gemm_fp32_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__sse2);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_SSE2, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__sse2);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .cStride(17)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__sse2);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__sse2);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(4)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__sse2);
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_SSE2, k_lt_8) {
+    for (size_t k = 4; k < 8; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(4)
+        .m(4)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_SPARSE_4x4c1x4_SSE2, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(4)
+        .m(4)
+        .n(4)
+        .k(k)
+        .testMicroKernel(q8gemm_sparse_ukernel_4x4c1x4__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_1x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(1)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_1x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_1x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(1)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_ukernel_1x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_1x8c2_AVX2, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(1)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_ukernel_1x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_1x8c2_AVX2, k_lt_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 2; k < 8; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_1x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_1x8c2_AVX2, k_gt_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_1x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_1x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(2)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_ukernel_1x8c2__avx2);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_1x8c2_AVX2, k_div_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_1x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_1x8c2_AVX2, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(2)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_ukernel_1x8c2__avx2);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(1)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_acc32_ukernel_1x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c2_AVX2, k_lt_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 2; k < 8; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c2_AVX2, k_gt_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(2)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_acc32_ukernel_1x8c2__avx2);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c2_AVX2, k_div_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_eq_8_strided_a) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_eq_8_strided_c) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_gt_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_gt_8_strided_a) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_gt_8_strided_c) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_div_8) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_div_8_strided_a) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_div_8_strided_c) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(2)
+        .m(4)
+        .n(8)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c2_AVX2, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c2_AVX2, k_eq_8_strided_a) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c2_AVX2, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c2_AVX2, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_RELU_4x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_relu_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_RELU_4x8c2_AVX2, k_gt_8_subtile_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .qmin(128)
+            .testMicroKernel(q8gemm_relu_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_UNCLAMPED_4x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_unclamped_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_UNCLAMPED_4x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_unclamped_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c2_AVX2, k_eq_8) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .signedKernel(true)
+      .testMicroKernel(q8gemm_signed_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c2_AVX2, k_eq_8_strided_a) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .signedKernel(true)
+      .testMicroKernel(q8gemm_signed_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c2_AVX2, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .signedKernel(true)
+      .testMicroKernel(q8gemm_signed_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c2_AVX2, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX2;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(2)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .signedKernel(true)
+      .testMicroKernel(q8gemm_signed_ukernel_4x8c2__avx2);
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c2_AVX2, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .signedKernel(true)
+            .testMicroKernel(q8gemm_signed_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c2_AVX2, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX2;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .signedKernel(true)
+            .testMicroKernel(q8gemm_signed_ukernel_4x8c2__avx2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_1x8c4_AVX512VNNI, k_eq_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(1)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_1x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_1x8c4_AVX512VNNI, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(1)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_ukernel_1x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_1x8c4_AVX512VNNI, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(1)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_ukernel_1x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_1x8c4_AVX512VNNI, k_lt_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 4; k < 8; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_1x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_1x8c4_AVX512VNNI, k_gt_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_1x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_1x8c4_AVX512VNNI, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(4)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_ukernel_1x8c4__avx512vnni);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_1x8c4_AVX512VNNI, k_div_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_1x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_1x8c4_AVX512VNNI, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(4)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_ukernel_1x8c4__avx512vnni);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c4_AVX512VNNI, k_eq_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(1)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_acc32_ukernel_1x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c4_AVX512VNNI, k_lt_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 4; k < 8; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c4_AVX512VNNI, k_gt_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c4_AVX512VNNI, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(4)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_acc32_ukernel_1x8c4__avx512vnni);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8c4_AVX512VNNI, k_div_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_eq_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_eq_8_strided_a) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_eq_8_strided_c) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_gt_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_gt_8_strided_a) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(37)
+        .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_gt_8_strided_c) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_div_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_div_8_strided_a) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_div_8_strided_c) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(4)
+        .m(4)
+        .n(8)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+    }
+  }
+
+  TEST(Q8GEMM_4x8c4_AVX512VNNI, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c4_AVX512VNNI, k_eq_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c4_AVX512VNNI, k_eq_8_strided_a) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c4_AVX512VNNI, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c4_AVX512VNNI, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c4_AVX512VNNI, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8c4_AVX512VNNI, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c4_AVX512VNNI, k_eq_8) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .signedKernel(true)
+      .testMicroKernel(q8gemm_signed_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c4_AVX512VNNI, k_eq_8_strided_a) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .signedKernel(true)
+      .testMicroKernel(q8gemm_signed_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c4_AVX512VNNI, k_eq_8_qmin128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .signedKernel(true)
+      .testMicroKernel(q8gemm_signed_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c4_AVX512VNNI, k_eq_8_qmax128) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(4)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .signedKernel(true)
+      .testMicroKernel(q8gemm_signed_ukernel_4x8c4__avx512vnni);
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c4_AVX512VNNI, k_gt_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .signedKernel(true)
+            .testMicroKernel(q8gemm_signed_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_SIGNED_4x8c4_AVX512VNNI, k_div_8_subtile) {
+    TEST_REQUIRES_X86_AVX512VNNI;
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(4)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .signedKernel(true)
+            .testMicroKernel(q8gemm_signed_ukernel_4x8c4__avx512vnni);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_4x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(4)
       .nr(4)
-      .np(1)
-      .kr(8)
-      .m(2)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_4x4c2_SSE2, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_4x4c2_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .cStride(17)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_4x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_4x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(4)
+      .n(4)
+      .k(8)
+      .qmax(128)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_4x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_4x4c2_SSE2, k_lt_8) {
+    for (size_t k = 2; k < 8; k++) {
+      GemmTester()
+        .mr(4)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(4)
+        .n(4)
+        .k(k)
+        .fourBitKernel(true)
+        .testMicroKernel(q8gemm_4bit_ukernel_4x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_4x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fourBitKernel(true)
+            .testMicroKernel(q8gemm_4bit_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_4x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fourBitKernel(true)
+            .testMicroKernel(q8gemm_4bit_ukernel_4x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_1x4c2_SSE2, k_eq_8) {
+    GemmTester()
+      .mr(1)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(1)
+      .n(4)
+      .k(8)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_1x4c2_SSE2, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(1)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(1)
+      .n(4)
+      .k(8)
+      .aStride(37)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_1x4c2_SSE2, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(1)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(1)
+      .n(4)
+      .k(8)
+      .cStride(17)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_1x4c2_SSE2, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(1)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(1)
+      .n(4)
+      .k(8)
+      .qmin(128)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_1x4c2_SSE2, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(1)
+      .nr(4)
+      .np(4)
+      .kr(2)
+      .m(1)
       .n(4)
       .k(8)
+      .qmax(128)
+      .fourBitKernel(true)
+      .testMicroKernel(q8gemm_4bit_ukernel_1x4c2__sse2);
+  }
+
+  TEST(Q8GEMM_4BIT_1x4c2_SSE2, k_lt_8) {
+    for (size_t k = 2; k < 8; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(4)
+        .np(4)
+        .kr(2)
+        .m(1)
+        .n(4)
+        .k(k)
+        .fourBitKernel(true)
+        .testMicroKernel(q8gemm_4bit_ukernel_1x4c2__sse2);
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_1x4c2_SSE2, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 1; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(1)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fourBitKernel(true)
+            .testMicroKernel(q8gemm_4bit_ukernel_1x4c2__sse2);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4BIT_1x4c2_SSE2, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 1; m++) {
+        for (uint32_t n = 1; n <= 4; n++) {
+          GemmTester()
+            .mr(1)
+            .nr(4)
+            .np(4)
+            .kr(2)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fourBitKernel(true)
+            .testMicroKernel(q8gemm_4bit_ukernel_1x4c2__sse2);
+        }
+      }
+    }
+  }
+#endif
+
+#if !CPUINFO_ARCH_ARM && !CPUINFO_ARCH_ARM64 && !CPUINFO_ARCH_X86 && !CPUINFO_ARCH_X86_64
+  TEST(Q8GEMM_ACC32_1x8_PSIMD, k_eq_8) {
+    GemmTester()
+      .mr(1)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(1)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_acc32_ukernel_1x8__psimd);
+  }
+
+  TEST(Q8GEMM_ACC32_1x8_PSIMD, k_lt_8) {
+    for (size_t k = 1; k < 8; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8__psimd);
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8_PSIMD, k_gt_8) {
+    for (size_t k = 9; k < 16; k++) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8__psimd);
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8_PSIMD, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(1)
+          .nr(8)
+          .np(8)
+          .kr(1)
+          .m(1)
+          .n(n)
+          .k(k)
+          .iterations(3)
+          .testMicroKernel(q8gemm_acc32_ukernel_1x8__psimd);
+      }
+    }
+  }
+
+  TEST(Q8GEMM_ACC32_1x8_PSIMD, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(1)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(1)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_acc32_ukernel_1x8__psimd);
+    }
+  }
+
+  TEST(Q8GEMM_4x8_PSIMD, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .testMicroKernel(q8gemm_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8GEMM_4x8_PSIMD, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
       .aStride(37)
-      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+      .testMicroKernel(q8gemm_ukernel_4x8__psimd);
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8_strided_c) {
+  TEST(Q8GEMM_4x8_PSIMD, k_eq_8_strided_c) {
     GemmTester()
-      .mr(2)
-      .nr(4)
-      .np(1)
-      .kr(8)
-      .m(2)
-      .n(4)
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
       .k(8)
       .cStride(17)
-      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+      .testMicroKernel(q8gemm_ukernel_4x8__psimd);
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8_qmin128) {
+  TEST(Q8GEMM_4x8_PSIMD, k_eq_8_qmin128) {
     GemmTester()
-      .mr(2)
-      .nr(4)
-      .np(1)
-      .kr(8)
-      .m(2)
-      .n(4)
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
       .k(8)
       .qmin(128)
-      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+      .testMicroKernel(q8gemm_ukernel_4x8__psimd);
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_eq_8_qmax128) {
+  TEST(Q8GEMM_4x8_PSIMD, k_eq_8_qmax128) {
     GemmTester()
-      .mr(2)
-      .nr(4)
-      .np(1)
-      .kr(8)
-      .m(2)
-      .n(4)
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
       .k(8)
       .qmax(128)
-      .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+      .testMicroKernel(q8gemm_ukernel_4x8__psimd);
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_gt_8) {
+  TEST(Q8GEMM_4x8_PSIMD, k_gt_8) {
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(2)
-        .nr(4)
-        .np(1)
-        .kr(8)
-        .m(2)
-        .n(4)
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
         .k(k)
-        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+        .testMicroKernel(q8gemm_ukernel_4x8__psimd);
     }
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_gt_8_strided_a) {
+  TEST(Q8GEMM_4x8_PSIMD, k_gt_8_strided_a) {
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(2)
-        .nr(4)
-        .np(1)
-        .kr(8)
-        .m(2)
-        .n(4)
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
         .k(k)
         .aStride(37)
-        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+        .testMicroKernel(q8gemm_ukernel_4x8__psimd);
     }
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_gt_8_strided_c) {
+  TEST(Q8GEMM_4x8_PSIMD, k_gt_8_strided_c) {
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
-        .mr(2)
-        .nr(4)
-        .np(1)
-        .kr(8)
-        .m(2)
-        .n(4)
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
         .k(k)
         .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+        .testMicroKernel(q8gemm_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8GEMM_4x8_PSIMD, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_4x8__psimd);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_4x8_PSIMD, k_div_8) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .testMicroKernel(q8gemm_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8GEMM_4x8_PSIMD, k_div_8_strided_a) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .aStride(171)
+        .testMicroKernel(q8gemm_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8GEMM_4x8_PSIMD, k_div_8_strided_c) {
+    for (size_t k = 16; k < 128; k += 8) {
+      GemmTester()
+        .mr(4)
+        .nr(8)
+        .np(8)
+        .kr(1)
+        .m(4)
+        .n(8)
+        .k(k)
+        .cStride(17)
+        .testMicroKernel(q8gemm_ukernel_4x8__psimd);
+    }
+  }
+
+  TEST(Q8GEMM_4x8_PSIMD, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .testMicroKernel(q8gemm_ukernel_4x8__psimd);
+        }
+      }
+    }
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8_PSIMD, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8_PSIMD, k_eq_8_strided_a) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .aStride(37)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8_PSIMD, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8_PSIMD, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .foldedZeroPoint(true)
+      .testMicroKernel(q8gemm_folded_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8GEMM_FOLDED_4x8_PSIMD, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x8__psimd);
+        }
+      }
     }
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_gt_8_subtile) {
-    for (size_t k = 9; k < 16; k++) {
-      for (uint32_t m = 1; m <= 2; m++) {
-        for (uint32_t n = 1; n <= 4; n++) {
+  TEST(Q8GEMM_FOLDED_4x8_PSIMD, k_div_8_subtile) {
+    for (size_t k = 16; k < 128; k += 24) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
-            .mr(2)
-            .nr(4)
-            .np(1)
-            .kr(8)
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
             .m(m)
             .n(n)
             .k(k)
             .iterations(3)
-            .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+            .foldedZeroPoint(true)
+            .testMicroKernel(q8gemm_folded_ukernel_4x8__psimd);
         }
       }
     }
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_div_8) {
-    for (size_t k = 16; k < 128; k += 8) {
-      GemmTester()
-        .mr(2)
-        .nr(4)
-        .np(1)
-        .kr(8)
-        .m(2)
-        .n(4)
-        .k(k)
-        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
-    }
+  TEST(Q8GEMM_FP32_4x8_PSIMD, k_eq_8) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x8__psimd);
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_div_8_strided_a) {
-    for (size_t k = 16; k < 128; k += 8) {
-      GemmTester()
-        .mr(2)
-        .nr(4)
-        .np(1)
-        .kr(8)
-        .m(2)
-        .n(4)
-        .k(k)
-        .aStride(171)
-        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
-    }
+  TEST(Q8GEMM_FP32_4x8_PSIMD, k_eq_8_strided_c) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .cStride(17)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x8__psimd);
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_div_8_strided_c) {
-    for (size_t k = 16; k < 128; k += 8) {
-      GemmTester()
-        .mr(2)
-        .nr(4)
-        .np(1)
-        .kr(8)
-        .m(2)
-        .n(4)
-        .k(k)
-        .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+  TEST(Q8GEMM_FP32_4x8_PSIMD, k_eq_8_qmin128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmin(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8GEMM_FP32_4x8_PSIMD, k_eq_8_qmax128) {
+    GemmTester()
+      .mr(4)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(4)
+      .n(8)
+      .k(8)
+      .qmax(128)
+      .fp32Requantization(true)
+      .testMicroKernel(q8gemm_fp32_ukernel_4x8__psimd);
+  }
+
+  TEST(Q8GEMM_FP32_4x8_PSIMD, k_gt_8_subtile) {
+    for (size_t k = 9; k < 16; k++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
+          GemmTester()
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .iterations(3)
+            .fp32Requantization(true)
+            .testMicroKernel(q8gemm_fp32_ukernel_4x8__psimd);
+        }
+      }
     }
   }
 
-  TEST(Q8GEMM_2x4c8_SSE2, k_div_8_subtile) {
+  TEST(Q8GEMM_FP32_4x8_PSIMD, k_div_8_subtile) {
     for (size_t k = 16; k < 128; k += 24) {
-      for (uint32_t m = 1; m <= 2; m++) {
-        for (uint32_t n = 1; n <= 4; n++) {
+      for (uint32_t m = 1; m <= 4; m++) {
+        for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
-            .mr(2)
-            .nr(4)
-            .np(1)
-            .kr(8)
+            .mr(4)
+            .nr(8)
+            .np(8)
+            .kr(1)
             .m(m)
             .n(n)
             .k(k)
             .iterations(3)
-            .testMicroKernel(q8gemm_ukernel_2x4c8__sse2);
+            .fp32Requantization(true)
+            .testMicroKernel(q8gemm_fp32_ukernel_4x8__psimd);
         }
       }
     }
   }
+#endif
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8) {
+#if CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+  TEST(Q8GEMM_4x8_RVV, k_eq_8) {
+    TEST_REQUIRES_RISCV_V;
     GemmTester()
       .mr(4)
-      .nr(4)
-      .np(4)
-      .kr(2)
+      .nr(8)
+      .np(8)
+      .kr(1)
       .m(4)
-      .n(4)
+      .n(8)
       .k(8)
-      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+      .testMicroKernel(q8gemm_ukernel_4x8__rvv);
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8_strided_a) {
+  TEST(Q8GEMM_4x8_RVV, k_eq_8_strided_a) {
+    TEST_REQUIRES_RISCV_V;
     GemmTester()
       .mr(4)
-      .nr(4)
-      .np(4)
-      .kr(2)
+      .nr(8)
+      .np(8)
+      .kr(1)
       .m(4)
-      .n(4)
+      .n(8)
       .k(8)
       .aStride(37)
-      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+      .testMicroKernel(q8gemm_ukernel_4x8__rvv);
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8_strided_c) {
+  TEST(Q8GEMM_4x8_RVV, k_eq_8_strided_c) {
+    TEST_REQUIRES_RISCV_V;
     GemmTester()
       .mr(4)
-      .nr(4)
-      .np(4)
-      .kr(2)
+      .nr(8)
+      .np(8)
+      .kr(1)
       .m(4)
-      .n(4)
+      .n(8)
       .k(8)
       .cStride(17)
-      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+      .testMicroKernel(q8gemm_ukernel_4x8__rvv);
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8_qmin128) {
+  TEST(Q8GEMM_4x8_RVV, k_eq_8_qmin128) {
+    TEST_REQUIRES_RISCV_V;
     GemmTester()
       .mr(4)
-      .nr(4)
-      .np(4)
-      .kr(2)
+      .nr(8)
+      .np(8)
+      .kr(1)
       .m(4)
-      .n(4)
+      .n(8)
       .k(8)
       .qmin(128)
-      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+      .testMicroKernel(q8gemm_ukernel_4x8__rvv);
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_eq_8_qmax128) {
+  TEST(Q8GEMM_4x8_RVV, k_eq_8_qmax128) {
+    TEST_REQUIRES_RISCV_V;
     GemmTester()
       .mr(4)
-      .nr(4)
-      .np(4)
-      .kr(2)
+      .nr(8)
+      .np(8)
+      .kr(1)
       .m(4)
-      .n(4)
+      .n(8)
       .k(8)
       .qmax(128)
-      .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+      .testMicroKernel(q8gemm_ukernel_4x8__rvv);
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_gt_8) {
+  TEST(Q8GEMM_4x8_RVV, k_gt_8) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
         .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
+        .nr(8)
+        .np(8)
+        .kr(1)
         .m(4)
-        .n(4)
+        .n(8)
         .k(k)
-        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+        .testMicroKernel(q8gemm_ukernel_4x8__rvv);
     }
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_gt_8_strided_a) {
+  TEST(Q8GEMM_4x8_RVV, k_gt_8_strided_a) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
         .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
+        .nr(8)
+        .np(8)
+        .kr(1)
         .m(4)
-        .n(4)
+        .n(8)
         .k(k)
         .aStride(37)
-        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+        .testMicroKernel(q8gemm_ukernel_4x8__rvv);
     }
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_gt_8_strided_c) {
+  TEST(Q8GEMM_4x8_RVV, k_gt_8_strided_c) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 9; k < 16; k++) {
       GemmTester()
         .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
+        .nr(8)
+        .np(8)
+        .kr(1)
         .m(4)
-        .n(4)
+        .n(8)
         .k(k)
         .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+        .testMicroKernel(q8gemm_ukernel_4x8__rvv);
     }
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_gt_8_subtile) {
+  TEST(Q8GEMM_4x8_RVV, k_gt_8_subtile) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 9; k < 16; k++) {
       for (uint32_t m = 1; m <= 4; m++) {
-        for (uint32_t n = 1; n <= 4; n++) {
+        for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
             .mr(4)
-            .nr(4)
-            .np(4)
-            .kr(2)
+            .nr(8)
+            .np(8)
+            .kr(1)
             .m(m)
             .n(n)
             .k(k)
             .iterations(3)
-            .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+            .testMicroKernel(q8gemm_ukernel_4x8__rvv);
         }
       }
     }
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_div_8) {
+  TEST(Q8GEMM_4x8_RVV, k_div_8) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
         .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
+        .nr(8)
+        .np(8)
+        .kr(1)
         .m(4)
-        .n(4)
+        .n(8)
         .k(k)
-        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+        .testMicroKernel(q8gemm_ukernel_4x8__rvv);
     }
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_div_8_strided_a) {
+  TEST(Q8GEMM_4x8_RVV, k_div_8_strided_a) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
         .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
+        .nr(8)
+        .np(8)
+        .kr(1)
         .m(4)
-        .n(4)
+        .n(8)
         .k(k)
         .aStride(171)
-        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+        .testMicroKernel(q8gemm_ukernel_4x8__rvv);
     }
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_div_8_strided_c) {
+  TEST(Q8GEMM_4x8_RVV, k_div_8_strided_c) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 16; k < 128; k += 8) {
       GemmTester()
         .mr(4)
-        .nr(4)
-        .np(4)
-        .kr(2)
+        .nr(8)
+        .np(8)
+        .kr(1)
         .m(4)
-        .n(4)
+        .n(8)
         .k(k)
         .cStride(17)
-        .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+        .testMicroKernel(q8gemm_ukernel_4x8__rvv);
     }
   }
 
-  TEST(Q8GEMM_4x4c2_SSE2, k_div_8_subtile) {
+  TEST(Q8GEMM_4x8_RVV, k_div_8_subtile) {
+    TEST_REQUIRES_RISCV_V;
     for (size_t k = 16; k < 128; k += 24) {
       for (uint32_t m = 1; m <= 4; m++) {
-        for (uint32_t n = 1; n <= 4; n++) {
+        for (uint32_t n = 1; n <= 8; n++) {
           GemmTester()
             .mr(4)
-            .nr(4)
-            .np(4)
-            .kr(2)
+            .nr(8)
+            .np(8)
+            .kr(1)
             .m(m)
             .n(n)
             .k(k)
             .iterations(3)
-            .testMicroKernel(q8gemm_ukernel_4x4c2__sse2);
+            .testMicroKernel(q8gemm_ukernel_4x8__rvv);
         }
       }
     }
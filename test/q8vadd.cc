@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <qnnpack/q8vadd.h>
+
+#include "vadd-microkernel-tester.h"
+
+
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  TEST(Q8VADD_NEON, n_eq_8) {
+    VAddMicrokernelTester()
+      .n(8)
+      .test(q8vadd_ukernel__neon);
+  }
+
+  TEST(Q8VADD_NEON, n_div_8) {
+    for (size_t n = 8; n < 128; n += 24) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .test(q8vadd_ukernel__neon);
+    }
+  }
+
+  TEST(Q8VADD_NEON, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .test(q8vadd_ukernel__neon);
+    }
+  }
+
+  TEST(Q8VADD_NEON, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .test(q8vadd_ukernel__neon);
+    }
+  }
+
+  TEST(Q8VADD_NEON, inplace_a) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .inplaceA(true)
+        .test(q8vadd_ukernel__neon);
+    }
+  }
+
+  TEST(Q8VADD_NEON, inplace_b) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .inplaceB(true)
+        .test(q8vadd_ukernel__neon);
+    }
+  }
+
+  TEST(Q8VADD_NEON, inplace_a_and_b) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .inplaceA(true)
+        .inplaceB(true)
+        .test(q8vadd_ukernel__neon);
+    }
+  }
+
+  TEST(Q8VADD_NEON, a_scale) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (float aScale = 1.0e-2f; aScale < 1.0e+2f; aScale *= 1.7f) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .aScale(aScale)
+          .test(q8vadd_ukernel__neon);
+      }
+    }
+  }
+
+  TEST(Q8VADD_NEON, b_scale) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (float bScale = 1.0e-2f; bScale < 1.0e+2f; bScale *= 1.7f) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .bScale(bScale)
+          .test(q8vadd_ukernel__neon);
+      }
+    }
+  }
+
+  TEST(Q8VADD_NEON, y_scale) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (float yScale = 1.0e-2f; yScale < 1.0e+2f; yScale *= 1.7f) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .yScale(yScale)
+          .test(q8vadd_ukernel__neon);
+      }
+    }
+  }
+
+  TEST(Q8VADD_NEON, a_zero_point) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (int32_t aZeroPoint = 0; aZeroPoint <= 255; aZeroPoint += 51) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .aZeroPoint(uint8_t(aZeroPoint))
+          .test(q8vadd_ukernel__neon);
+      }
+    }
+  }
+
+  TEST(Q8VADD_NEON, b_zero_point) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (int32_t bZeroPoint = 0; bZeroPoint <= 255; bZeroPoint += 51) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .bZeroPoint(uint8_t(bZeroPoint))
+          .test(q8vadd_ukernel__neon);
+      }
+    }
+  }
+
+  TEST(Q8VADD_NEON, y_zero_point) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (int32_t yZeroPoint = 0; yZeroPoint <= 255; yZeroPoint += 51) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .yZeroPoint(uint8_t(yZeroPoint))
+          .test(q8vadd_ukernel__neon);
+      }
+    }
+  }
+
+  TEST(Q8VADD_NEON, qmin) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .qmin(128)
+        .test(q8vadd_ukernel__neon);
+    }
+  }
+
+  TEST(Q8VADD_NEON, qmax) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .qmax(128)
+        .test(q8vadd_ukernel__neon);
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  TEST(Q8VADD_SSE2, n_eq_8) {
+    VAddMicrokernelTester()
+      .n(8)
+      .test(q8vadd_ukernel__sse2);
+  }
+
+  TEST(Q8VADD_SSE2, n_div_8) {
+    for (size_t n = 8; n < 128; n += 24) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .test(q8vadd_ukernel__sse2);
+    }
+  }
+
+  TEST(Q8VADD_SSE2, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .test(q8vadd_ukernel__sse2);
+    }
+  }
+
+  TEST(Q8VADD_SSE2, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .test(q8vadd_ukernel__sse2);
+    }
+  }
+
+  TEST(Q8VADD_SSE2, inplace_a) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .inplaceA(true)
+        .test(q8vadd_ukernel__sse2);
+    }
+  }
+
+  TEST(Q8VADD_SSE2, inplace_b) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .inplaceB(true)
+        .test(q8vadd_ukernel__sse2);
+    }
+  }
+
+  TEST(Q8VADD_SSE2, inplace_a_and_b) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .inplaceA(true)
+        .inplaceB(true)
+        .test(q8vadd_ukernel__sse2);
+    }
+  }
+
+  TEST(Q8VADD_SSE2, a_scale) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (float aScale = 1.0e-2f; aScale < 1.0e+2f; aScale *= 1.7f) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .aScale(aScale)
+          .test(q8vadd_ukernel__sse2);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SSE2, b_scale) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (float bScale = 1.0e-2f; bScale < 1.0e+2f; bScale *= 1.7f) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .bScale(bScale)
+          .test(q8vadd_ukernel__sse2);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SSE2, y_scale) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (float yScale = 1.0e-2f; yScale < 1.0e+2f; yScale *= 1.7f) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .yScale(yScale)
+          .test(q8vadd_ukernel__sse2);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SSE2, a_zero_point) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (int32_t aZeroPoint = 0; aZeroPoint <= 255; aZeroPoint += 51) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .aZeroPoint(uint8_t(aZeroPoint))
+          .test(q8vadd_ukernel__sse2);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SSE2, b_zero_point) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (int32_t bZeroPoint = 0; bZeroPoint <= 255; bZeroPoint += 51) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .bZeroPoint(uint8_t(bZeroPoint))
+          .test(q8vadd_ukernel__sse2);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SSE2, y_zero_point) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (int32_t yZeroPoint = 0; yZeroPoint <= 255; yZeroPoint += 51) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .yZeroPoint(uint8_t(yZeroPoint))
+          .test(q8vadd_ukernel__sse2);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SSE2, qmin) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .qmin(128)
+        .test(q8vadd_ukernel__sse2);
+    }
+  }
+
+  TEST(Q8VADD_SSE2, qmax) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .qmax(128)
+        .test(q8vadd_ukernel__sse2);
+    }
+  }
+#endif
+
+#if !CPUINFO_ARCH_ARM && !CPUINFO_ARCH_ARM64 && !CPUINFO_ARCH_X86 && !CPUINFO_ARCH_X86_64
+  TEST(Q8VADD_SCALAR, n_eq_8) {
+    VAddMicrokernelTester()
+      .n(8)
+      .test(q8vadd_ukernel__scalar);
+  }
+
+  TEST(Q8VADD_SCALAR, n_div_8) {
+    for (size_t n = 8; n < 128; n += 24) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .test(q8vadd_ukernel__scalar);
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .test(q8vadd_ukernel__scalar);
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .test(q8vadd_ukernel__scalar);
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, inplace_a) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .inplaceA(true)
+        .test(q8vadd_ukernel__scalar);
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, inplace_b) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .inplaceB(true)
+        .test(q8vadd_ukernel__scalar);
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, inplace_a_and_b) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .inplaceA(true)
+        .inplaceB(true)
+        .test(q8vadd_ukernel__scalar);
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, a_scale) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (float aScale = 1.0e-2f; aScale < 1.0e+2f; aScale *= 1.7f) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .aScale(aScale)
+          .test(q8vadd_ukernel__scalar);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, b_scale) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (float bScale = 1.0e-2f; bScale < 1.0e+2f; bScale *= 1.7f) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .bScale(bScale)
+          .test(q8vadd_ukernel__scalar);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, y_scale) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (float yScale = 1.0e-2f; yScale < 1.0e+2f; yScale *= 1.7f) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .yScale(yScale)
+          .test(q8vadd_ukernel__scalar);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, a_zero_point) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (int32_t aZeroPoint = 0; aZeroPoint <= 255; aZeroPoint += 51) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .aZeroPoint(uint8_t(aZeroPoint))
+          .test(q8vadd_ukernel__scalar);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, b_zero_point) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (int32_t bZeroPoint = 0; bZeroPoint <= 255; bZeroPoint += 51) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .bZeroPoint(uint8_t(bZeroPoint))
+          .test(q8vadd_ukernel__scalar);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, y_zero_point) {
+    for (size_t n = 1; n < 128; n += 11) {
+      for (int32_t yZeroPoint = 0; yZeroPoint <= 255; yZeroPoint += 51) {
+        VAddMicrokernelTester()
+          .iterations(1)
+          .n(n)
+          .yZeroPoint(uint8_t(yZeroPoint))
+          .test(q8vadd_ukernel__scalar);
+      }
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, qmin) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .qmin(128)
+        .test(q8vadd_ukernel__scalar);
+    }
+  }
+
+  TEST(Q8VADD_SCALAR, qmax) {
+    for (size_t n = 1; n < 128; n += 11) {
+      VAddMicrokernelTester()
+        .iterations(1)
+        .n(n)
+        .qmax(128)
+        .test(q8vadd_ukernel__scalar);
+    }
+  }
+#endif
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+namespace {
+
+struct Completion {
+  std::atomic<size_t> calls;
+  std::atomic<size_t> failures;
+};
+
+void countCompletion(void* context, qnnp_status status) {
+  Completion* completion = static_cast<Completion*>(context);
+  completion->calls++;
+  if (status != qnnp_status_success) {
+    completion->failures++;
+  }
+}
+
+/* Fully-connected layer with 40 inputs and 24 outputs */
+qnnp_operator_t createFullyConnected(const std::vector<uint8_t>& kernel, const std::vector<int32_t>& bias) {
+  qnnp_operator_t op = nullptr;
+  EXPECT_EQ(qnnp_status_success,
+    qnnp_create_fully_connected_nc_q8(
+      40, 24,
+      127, 1.0f,
+      127, 1.0f,
+      kernel.data(), bias.data(),
+      127, 40.0f, 0, 255,
+      0 /* flags */,
+      &op));
+  return op;
+}
+
+}  // namespace
+
+TEST(QUEUE, run_operator_async) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+  std::vector<uint8_t> kernel(24 * 40);
+  std::vector<int32_t> bias(24, 0);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+
+  /* Independent operators, which run after one another on the queue */
+  const size_t operatorsCount = 4;
+  const size_t batchSize = 7;
+  std::vector<uint8_t> input(batchSize * 40);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::vector<qnnp_operator_t> operators;
+  std::vector<std::vector<uint8_t>> outputs(operatorsCount, std::vector<uint8_t>(batchSize * 24));
+  for (size_t i = 0; i < operatorsCount; i++) {
+    operators.push_back(createFullyConnected(kernel, bias));
+    ASSERT_NE(nullptr, operators[i]);
+    ASSERT_EQ(qnnp_status_success,
+      qnnp_setup_fully_connected_nc_q8(operators[i], batchSize, input.data(), 40, outputs[i].data(), 24, nullptr));
+  }
+
+  std::vector<uint8_t> reference(batchSize * 24);
+  qnnp_operator_t referenceOperator = createFullyConnected(kernel, bias);
+  ASSERT_NE(nullptr, referenceOperator);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(referenceOperator, batchSize, input.data(), 40, reference.data(), 24, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(referenceOperator, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(referenceOperator));
+
+  pthreadpool_t threadpool = pthreadpool_create(2);
+  qnnp_queue_t queue = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_queue(threadpool, &queue));
+  Completion completion = { { 0 }, { 0 } };
+  for (size_t i = 0; i < operatorsCount; i++) {
+    ASSERT_EQ(qnnp_status_success, qnnp_run_operator_async(operators[i], queue, countCompletion, &completion));
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_wait_queue(queue));
+  EXPECT_EQ(operatorsCount, completion.calls.load());
+  EXPECT_EQ(0u, completion.failures.load());
+  for (size_t i = 0; i < operatorsCount; i++) {
+    EXPECT_EQ(reference, outputs[i]) << "operator " << i;
+  }
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_queue(queue));
+  if (threadpool != nullptr) {
+    pthreadpool_destroy(threadpool);
+  }
+  for (qnnp_operator_t op : operators) {
+    ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+  }
+}
+
+TEST(QUEUE, plan_run_async) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+  std::vector<uint8_t> kernel(24 * 40);
+  std::vector<int32_t> bias(24, 0);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  qnnp_operator_t planOperator = createFullyConnected(kernel, bias);
+  qnnp_operator_t referenceOperator = createFullyConnected(kernel, bias);
+  ASSERT_NE(nullptr, planOperator);
+  ASSERT_NE(nullptr, referenceOperator);
+
+  const size_t batchSize = 3;
+  std::vector<uint8_t> input(batchSize * 40);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::vector<uint8_t> reference(batchSize * 24);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(referenceOperator, batchSize, input.data(), 40, reference.data(), 24, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(referenceOperator, nullptr));
+
+  qnnp_plan_t plan = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_plan(batchSize, 1, 1, 40, &plan));
+  ASSERT_EQ(qnnp_status_success, qnnp_plan_add_operator(plan, planOperator));
+
+  qnnp_queue_t queue = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_queue(nullptr, &queue));
+  Completion completion = { { 0 }, { 0 } };
+  std::vector<uint8_t> output(batchSize * 24);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_plan_run_async(plan, input.data(), output.data(), queue, countCompletion, &completion));
+  /* Deleting the queue waits for the submitted run */
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_queue(queue));
+  EXPECT_EQ(1u, completion.calls.load());
+  EXPECT_EQ(0u, completion.failures.load());
+  EXPECT_EQ(reference, output);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_plan(plan));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(planOperator));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(referenceOperator));
+}
+
+TEST(BATCHER, invalid_parameters) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::vector<uint8_t> kernel(24 * 40, 127);
+  std::vector<int32_t> bias(24, 0);
+  qnnp_operator_t op = createFullyConnected(kernel, bias);
+  ASSERT_NE(nullptr, op);
+
+  qnnp_batcher_t batcher = nullptr;
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_create_batcher(nullptr, 4, 100, nullptr, &batcher));
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_create_batcher(op, 0, 100, nullptr, &batcher));
+  ASSERT_EQ(qnnp_status_success, qnnp_create_batcher(op, 4, 100, nullptr, &batcher));
+  std::vector<uint8_t> output(24);
+  ASSERT_EQ(qnnp_status_invalid_parameter, qnnp_batcher_submit(batcher, nullptr, output.data(), nullptr, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_batcher(batcher));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(BATCHER, concurrent_requests) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+  std::vector<uint8_t> kernel(24 * 40);
+  std::vector<int32_t> bias(24, 0);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+
+  /* Callers that submit rows concurrently, which the batcher runs in batches of up to 5 rows */
+  const size_t callersCount = 4;
+  const size_t requestsPerCaller = 25;
+  const size_t requestsCount = callersCount * requestsPerCaller;
+  std::vector<uint8_t> input(requestsCount * 40);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::vector<uint8_t> reference(requestsCount * 24);
+  qnnp_operator_t referenceOperator = createFullyConnected(kernel, bias);
+  ASSERT_NE(nullptr, referenceOperator);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(
+      referenceOperator, requestsCount, input.data(), 40, reference.data(), 24, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(referenceOperator, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(referenceOperator));
+
+  qnnp_operator_t op = createFullyConnected(kernel, bias);
+  ASSERT_NE(nullptr, op);
+  pthreadpool_t threadpool = pthreadpool_create(2);
+  qnnp_batcher_t batcher = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_batcher(op, 5, 200 /* us */, threadpool, &batcher));
+
+  Completion completion = { { 0 }, { 0 } };
+  std::vector<uint8_t> output(requestsCount * 24);
+  std::vector<std::thread> callers;
+  for (size_t caller = 0; caller < callersCount; caller++) {
+    callers.emplace_back([&, caller]() {
+      for (size_t i = caller * requestsPerCaller; i < (caller + 1) * requestsPerCaller; i++) {
+        EXPECT_EQ(qnnp_status_success,
+          qnnp_batcher_submit(batcher, &input[i * 40], &output[i * 24], countCompletion, &completion));
+      }
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_wait_batcher(batcher));
+  EXPECT_EQ(requestsCount, completion.calls.load());
+  EXPECT_EQ(0u, completion.failures.load());
+  EXPECT_EQ(reference, output);
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_batcher(batcher));
+  if (threadpool != nullptr) {
+    pthreadpool_destroy(threadpool);
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(BATCHER, full_batch_and_delete_skip_window) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+  std::vector<uint8_t> kernel(24 * 40);
+  std::vector<int32_t> bias(24, 0);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+
+  const size_t requestsCount = 7;
+  std::vector<uint8_t> input(requestsCount * 40);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::vector<uint8_t> reference(requestsCount * 24);
+  qnnp_operator_t referenceOperator = createFullyConnected(kernel, bias);
+  ASSERT_NE(nullptr, referenceOperator);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(
+      referenceOperator, requestsCount, input.data(), 40, reference.data(), 24, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(referenceOperator, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(referenceOperator));
+
+  /*
+   * With a window of an hour, the first 4 requests run once the batch is full, and deleting the batcher runs the
+   * last 3 without waiting for the window
+   */
+  qnnp_operator_t op = createFullyConnected(kernel, bias);
+  ASSERT_NE(nullptr, op);
+  qnnp_batcher_t batcher = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_batcher(op, 4, UINT64_C(3600000000), nullptr, &batcher));
+  Completion completion = { { 0 }, { 0 } };
+  std::vector<uint8_t> output(requestsCount * 24);
+  for (size_t i = 0; i < 4; i++) {
+    ASSERT_EQ(qnnp_status_success,
+      qnnp_batcher_submit(batcher, &input[i * 40], &output[i * 24], countCompletion, &completion));
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_wait_batcher(batcher));
+  EXPECT_EQ(4u, completion.calls.load());
+  for (size_t i = 4; i < requestsCount; i++) {
+    ASSERT_EQ(qnnp_status_success,
+      qnnp_batcher_submit(batcher, &input[i * 40], &output[i * 24], countCompletion, &completion));
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_batcher(batcher));
+  EXPECT_EQ(requestsCount, completion.calls.load());
+  EXPECT_EQ(0u, completion.failures.load());
+  EXPECT_EQ(reference, output);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
+
+TEST(BATCHER, zero_window) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+
+  std::vector<uint8_t> kernel(24 * 40);
+  std::vector<int32_t> bias(24, 0);
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::vector<uint8_t> input(40);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::vector<uint8_t> reference(24);
+  qnnp_operator_t referenceOperator = createFullyConnected(kernel, bias);
+  ASSERT_NE(nullptr, referenceOperator);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_fully_connected_nc_q8(referenceOperator, 1, input.data(), 40, reference.data(), 24, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(referenceOperator, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(referenceOperator));
+
+  /* A single request runs without waiting for others */
+  qnnp_operator_t op = createFullyConnected(kernel, bias);
+  ASSERT_NE(nullptr, op);
+  qnnp_batcher_t batcher = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_batcher(op, 8, 0, nullptr, &batcher));
+  Completion completion = { { 0 }, { 0 } };
+  std::vector<uint8_t> output(24);
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_batcher_submit(batcher, input.data(), output.data(), countCompletion, &completion));
+  ASSERT_EQ(qnnp_status_success, qnnp_wait_batcher(batcher));
+  EXPECT_EQ(1u, completion.calls.load());
+  EXPECT_EQ(0u, completion.failures.load());
+  EXPECT_EQ(reference, output);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_batcher(batcher));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(op));
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "conversion-tester.h"
+
+
+TEST(REQUANTIZE_OP, invalid_parameters) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t requantize_op = nullptr;
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_requantize_nc_q8(0, 127, 1.0f, 127, 1.0f, 0, 255, 0, &requantize_op));
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_create_requantize_nc_q8(7, 127, 1.0f, 127, 1.0f, 128, 128, 0, &requantize_op));
+  ASSERT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_create_requantize_nc_q8(7, 127, 1.0f, 127, 1.0e-3f, 0, 255, 0, &requantize_op));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_requantize_nc_q8(7, 127, 1.0f, 127, 1.0f, 0, 255, 0, &requantize_op));
+  uint8_t data[7] = { 0 };
+  ASSERT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_requantize_nc_q8(requantize_op, 1, data, 6, data, 7, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(requantize_op));
+}
+
+TEST(REQUANTIZE_OP, unit_batch) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(1)
+      .channels(channels)
+      .iterations(3)
+      .testRequantize();
+  }
+}
+
+TEST(REQUANTIZE_OP, small_batch) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(3)
+      .channels(channels)
+      .iterations(3)
+      .testRequantize();
+  }
+}
+
+TEST(REQUANTIZE_OP, small_batch_with_input_stride) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(3)
+      .channels(channels)
+      .inputStride(129)
+      .iterations(3)
+      .testRequantize();
+  }
+}
+
+TEST(REQUANTIZE_OP, small_batch_with_output_stride) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(3)
+      .channels(channels)
+      .outputStride(117)
+      .iterations(3)
+      .testRequantize();
+  }
+}
+
+TEST(REQUANTIZE_OP, small_batch_with_qmin) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(3)
+      .channels(channels)
+      .qmin(128)
+      .iterations(3)
+      .testRequantize();
+  }
+}
+
+TEST(REQUANTIZE_OP, small_batch_with_qmax) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(3)
+      .channels(channels)
+      .qmax(128)
+      .iterations(3)
+      .testRequantize();
+  }
+}
+
+TEST(REQUANTIZE_OP, small_batch_inplace) {
+  for (size_t channels = 1; channels < 100; channels += 15) {
+    ConversionTester()
+      .batchSize(3)
+      .channels(channels)
+      .inputStride(111)
+      .outputStride(111)
+      .inPlace(true)
+      .iterations(3)
+      .testRequantize();
+  }
+}
+
+TEST(REQUANTIZE_OP, large_batch_multithreaded) {
+  ConversionTester()
+    .batchSize(1000)
+    .channels(19)
+    .threads(4)
+    .iterations(2)
+    .testRequantize();
+}
+
+TEST(REQUANTIZE_OP, large_batch_multithreaded_with_strides) {
+  ConversionTester()
+    .batchSize(300)
+    .channels(19)
+    .inputStride(23)
+    .outputStride(29)
+    .threads(4)
+    .iterations(2)
+    .testRequantize();
+}
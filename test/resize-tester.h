@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+/* Tests bilinear and nearest-neighbor resize operators against interpolation in double precision */
+class ResizeTester {
+ public:
+  inline ResizeTester& channels(size_t channels) {
+    assert(channels != 0);
+    this->channels_ = channels;
+    return *this;
+  }
+
+  inline size_t channels() const {
+    return this->channels_;
+  }
+
+  inline ResizeTester& inputSize(size_t inputHeight, size_t inputWidth) {
+    assert(inputHeight >= 1);
+    assert(inputWidth >= 1);
+    this->inputHeight_ = inputHeight;
+    this->inputWidth_ = inputWidth;
+    return *this;
+  }
+
+  inline size_t inputHeight() const {
+    return this->inputHeight_;
+  }
+
+  inline size_t inputWidth() const {
+    return this->inputWidth_;
+  }
+
+  inline ResizeTester& outputSize(size_t outputHeight, size_t outputWidth) {
+    assert(outputHeight >= 1);
+    assert(outputWidth >= 1);
+    this->outputHeight_ = outputHeight;
+    this->outputWidth_ = outputWidth;
+    return *this;
+  }
+
+  inline size_t outputHeight() const {
+    return this->outputHeight_;
+  }
+
+  inline size_t outputWidth() const {
+    return this->outputWidth_;
+  }
+
+  inline ResizeTester& inputPixelStride(size_t inputPixelStride) {
+    assert(inputPixelStride != 0);
+    this->inputPixelStride_ = inputPixelStride;
+    return *this;
+  }
+
+  inline size_t inputPixelStride() const {
+    if (this->inputPixelStride_ == 0) {
+      return this->channels_;
+    } else {
+      assert(this->inputPixelStride_ >= this->channels_);
+      return this->inputPixelStride_;
+    }
+  }
+
+  inline ResizeTester& outputPixelStride(size_t outputPixelStride) {
+    assert(outputPixelStride != 0);
+    this->outputPixelStride_ = outputPixelStride;
+    return *this;
+  }
+
+  inline size_t outputPixelStride() const {
+    if (this->outputPixelStride_ == 0) {
+      return this->channels_;
+    } else {
+      assert(this->outputPixelStride_ >= this->channels_);
+      return this->outputPixelStride_;
+    }
+  }
+
+  inline ResizeTester& batchSize(size_t batchSize) {
+    this->batchSize_ = batchSize;
+    return *this;
+  }
+
+  inline size_t batchSize() const {
+    return this->batchSize_;
+  }
+
+  inline ResizeTester& alignCorners(bool alignCorners) {
+    this->alignCorners_ = alignCorners;
+    return *this;
+  }
+
+  inline bool alignCorners() const {
+    return this->alignCorners_;
+  }
+
+  inline ResizeTester& threads(size_t threads) {
+    this->threads_ = threads;
+    return *this;
+  }
+
+  inline size_t threads() const {
+    return this->threads_;
+  }
+
+  inline ResizeTester& iterations(size_t iterations) {
+    this->iterations_ = iterations;
+    return *this;
+  }
+
+  inline size_t iterations() const {
+    return this->iterations_;
+  }
+
+  void testBilinear() const {
+    test(false);
+  }
+
+  void testNearest() const {
+    test(true);
+  }
+
+ private:
+  /* Input position that output pixel i of a dimension samples */
+  double position(size_t i, size_t inputSize, size_t outputSize) const {
+    if (alignCorners()) {
+      return outputSize == 1 ? 0.0 : double(i) * double(inputSize - 1) / double(outputSize - 1);
+    } else {
+      return (double(i) + 0.5) * double(inputSize) / double(outputSize) - 0.5;
+    }
+  }
+
+  void test(bool nearest) const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint32_t>(0, 255), rng);
+
+    const size_t inputPixels = batchSize() * inputHeight() * inputWidth();
+    const size_t outputPixels = batchSize() * outputHeight() * outputWidth();
+    std::vector<uint8_t> input((inputPixels - 1) * inputPixelStride() + channels());
+    std::vector<uint8_t> output((outputPixels - 1) * outputPixelStride() + channels());
+    std::vector<double> outputRef(outputPixels * channels());
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(input.begin(), input.end(), std::ref(u8rng));
+      std::fill(output.begin(), output.end(), 0xA5);
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t oy = 0; oy < outputHeight(); oy++) {
+          for (size_t ox = 0; ox < outputWidth(); ox++) {
+            const double y = std::max(position(oy, inputHeight(), outputHeight()), 0.0);
+            const double x = std::max(position(ox, inputWidth(), outputWidth()), 0.0);
+            for (size_t c = 0; c < channels(); c++) {
+              auto inputAt = [&](size_t iy, size_t ix) -> double {
+                return double(input[((i * inputHeight() + iy) * inputWidth() + ix) * inputPixelStride() + c]);
+              };
+              double value;
+              if (nearest) {
+                const size_t iy = std::min(size_t(std::floor(y + 0.5)), inputHeight() - 1);
+                const size_t ix = std::min(size_t(std::floor(x + 0.5)), inputWidth() - 1);
+                value = inputAt(iy, ix);
+              } else {
+                const size_t y0 = std::min(size_t(y), inputHeight() - 1);
+                const size_t x0 = std::min(size_t(x), inputWidth() - 1);
+                const size_t y1 = std::min(y0 + 1, inputHeight() - 1);
+                const size_t x1 = std::min(x0 + 1, inputWidth() - 1);
+                const double ay = y - double(y0);
+                const double ax = x - double(x0);
+                const double top = inputAt(y0, x0) * (1.0 - ax) + inputAt(y0, x1) * ax;
+                const double bottom = inputAt(y1, x0) * (1.0 - ax) + inputAt(y1, x1) * ax;
+                value = top * (1.0 - ay) + bottom * ay;
+              }
+              outputRef[((i * outputHeight() + oy) * outputWidth() + ox) * channels() + c] = value;
+            }
+          }
+        }
+      }
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t resize = nullptr;
+      const uint32_t flags = alignCorners() ? QNNP_CREATE_FLAG_ALIGN_CORNERS : 0;
+      if (nearest) {
+        ASSERT_EQ(qnnp_status_success, qnnp_create_resize_nearest2d_nhwc_u8(channels(), flags, &resize));
+      } else {
+        ASSERT_EQ(qnnp_status_success, qnnp_create_resize_bilinear2d_nhwc_u8(channels(), flags, &resize));
+      }
+      ASSERT_NE(nullptr, resize);
+
+      pthreadpool_t threadpool = nullptr;
+      if (threads() != 1) {
+        threadpool = pthreadpool_create(threads());
+        ASSERT_NE(nullptr, threadpool);
+      }
+
+      if (nearest) {
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_setup_resize_nearest2d_nhwc_u8(
+            resize, batchSize(),
+            inputHeight(), inputWidth(), outputHeight(), outputWidth(),
+            input.data(), inputPixelStride(),
+            output.data(), outputPixelStride(),
+            threadpool));
+      } else {
+        ASSERT_EQ(qnnp_status_success,
+          qnnp_setup_resize_bilinear2d_nhwc_u8(
+            resize, batchSize(),
+            inputHeight(), inputWidth(), outputHeight(), outputWidth(),
+            input.data(), inputPixelStride(),
+            output.data(), outputPixelStride(),
+            threadpool));
+      }
+
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(resize, threadpool));
+
+      if (threadpool != nullptr) {
+        pthreadpool_destroy(threadpool);
+      }
+      ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(resize));
+
+      for (size_t p = 0; p < outputPixels; p++) {
+        for (size_t c = 0; c < channels(); c++) {
+          const double valueRef = outputRef[p * channels() + c];
+          const uint8_t value = output[p * outputPixelStride() + c];
+          if (nearest) {
+            ASSERT_EQ(uint32_t(valueRef), uint32_t(value)) << "output pixel " << p << ", channel " << c;
+          } else {
+            ASSERT_NEAR(valueRef, double(value), 0.6) << "output pixel " << p << ", channel " << c;
+          }
+        }
+        for (size_t c = channels(); p + 1 < outputPixels && c < outputPixelStride(); c++) {
+          ASSERT_EQ(0xA5, output[p * outputPixelStride() + c])
+            << "output pixel " << p << ", padding " << c << " was overwritten";
+        }
+      }
+    }
+  }
+
+  size_t batchSize_{1};
+  size_t channels_{1};
+  size_t inputHeight_{1};
+  size_t inputWidth_{1};
+  size_t outputHeight_{1};
+  size_t outputWidth_{1};
+  size_t inputPixelStride_{0};
+  size_t outputPixelStride_{0};
+  bool alignCorners_{false};
+  size_t threads_{1};
+  size_t iterations_{3};
+};
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "resize-tester.h"
+
+
+TEST(RESIZE_BILINEAR_U8, upsample_2x) {
+  for (size_t channels = 1; channels <= 40; channels += 3) {
+    ResizeTester()
+      .inputSize(5, 7)
+      .outputSize(10, 14)
+      .channels(channels)
+      .testBilinear();
+  }
+}
+
+TEST(RESIZE_BILINEAR_U8, upsample_non_integer) {
+  ResizeTester()
+    .inputSize(5, 7)
+    .outputSize(13, 11)
+    .channels(19)
+    .testBilinear();
+}
+
+TEST(RESIZE_BILINEAR_U8, downsample) {
+  ResizeTester()
+    .inputSize(13, 11)
+    .outputSize(5, 7)
+    .channels(19)
+    .testBilinear();
+}
+
+TEST(RESIZE_BILINEAR_U8, unit_output) {
+  ResizeTester()
+    .inputSize(4, 6)
+    .outputSize(1, 1)
+    .channels(8)
+    .testBilinear();
+}
+
+TEST(RESIZE_BILINEAR_U8, unit_input) {
+  ResizeTester()
+    .inputSize(1, 1)
+    .outputSize(3, 5)
+    .channels(11)
+    .testBilinear();
+}
+
+TEST(RESIZE_BILINEAR_U8, align_corners) {
+  for (size_t channels = 1; channels <= 24; channels += 7) {
+    ResizeTester()
+      .inputSize(5, 7)
+      .outputSize(9, 12)
+      .alignCorners(true)
+      .channels(channels)
+      .testBilinear();
+  }
+}
+
+TEST(RESIZE_BILINEAR_U8, batch_with_strides) {
+  ResizeTester()
+    .batchSize(3)
+    .inputSize(4, 5)
+    .outputSize(8, 10)
+    .channels(17)
+    .inputPixelStride(23)
+    .outputPixelStride(29)
+    .testBilinear();
+}
+
+TEST(RESIZE_BILINEAR_U8, multithreaded) {
+  ResizeTester()
+    .batchSize(2)
+    .inputSize(9, 8)
+    .outputSize(18, 16)
+    .channels(32)
+    .threads(4)
+    .testBilinear();
+}
+
+TEST(RESIZE_NEAREST_U8, upsample_2x) {
+  for (size_t channels = 1; channels <= 40; channels += 3) {
+    ResizeTester()
+      .inputSize(5, 7)
+      .outputSize(10, 14)
+      .channels(channels)
+      .testNearest();
+  }
+}
+
+TEST(RESIZE_NEAREST_U8, upsample_non_integer) {
+  ResizeTester()
+    .inputSize(5, 7)
+    .outputSize(13, 11)
+    .channels(19)
+    .testNearest();
+}
+
+TEST(RESIZE_NEAREST_U8, downsample) {
+  ResizeTester()
+    .inputSize(13, 11)
+    .outputSize(5, 7)
+    .channels(19)
+    .testNearest();
+}
+
+TEST(RESIZE_NEAREST_U8, align_corners) {
+  ResizeTester()
+    .inputSize(5, 7)
+    .outputSize(9, 12)
+    .alignCorners(true)
+    .channels(13)
+    .testNearest();
+}
+
+TEST(RESIZE_NEAREST_U8, batch_with_strides) {
+  ResizeTester()
+    .batchSize(3)
+    .inputSize(4, 5)
+    .outputSize(8, 10)
+    .channels(17)
+    .inputPixelStride(23)
+    .outputPixelStride(29)
+    .testNearest();
+}
+
+TEST(RESIZE_NEAREST_U8, multithreaded) {
+  ResizeTester()
+    .batchSize(2)
+    .inputSize(9, 8)
+    .outputSize(18, 16)
+    .channels(32)
+    .threads(4)
+    .testNearest();
+}
+
+TEST(RESIZE_NEAREST_U8, setup_reuses_tables) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t resize = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_resize_nearest2d_nhwc_u8(3, 0, &resize));
+  std::vector<uint8_t> input(2 * 2 * 3), output(4 * 4 * 3), smallOutput(3 * 3 * 3);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = uint8_t(i);
+  }
+  /* Setups with other output dimensions in between must rebuild the tables */
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_resize_nearest2d_nhwc_u8(resize, 1, 2, 2, 4, 4, input.data(), 3, output.data(), 3, nullptr));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_resize_nearest2d_nhwc_u8(resize, 1, 2, 2, 3, 3, input.data(), 3, smallOutput.data(), 3, nullptr));
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_setup_resize_nearest2d_nhwc_u8(resize, 1, 2, 2, 4, 4, input.data(), 3, output.data(), 3, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_run_operator(resize, nullptr));
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      for (size_t c = 0; c < 3; c++) {
+        ASSERT_EQ(input[((y / 2) * 2 + x / 2) * 3 + c], output[(y * 4 + x) * 3 + c])
+          << "y = " << y << ", x = " << x << ", channel " << c;
+      }
+    }
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(resize));
+}
+
+TEST(RESIZE_NEAREST_U8, setup_other_operator) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t resize = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_resize_bilinear2d_nhwc_u8(3, 0, &resize));
+  std::vector<uint8_t> input(3), output(4 * 3);
+  EXPECT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_resize_nearest2d_nhwc_u8(resize, 1, 1, 1, 2, 2, input.data(), 3, output.data(), 3, nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(resize));
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+namespace {
+
+qnnp_operator_t createConvolution(
+    uint32_t kernelSize, size_t inputChannels, size_t outputChannels,
+    const std::vector<uint8_t>& kernel, const std::vector<int32_t>& bias,
+    uint32_t flags)
+{
+  const uint32_t padding = kernelSize / 2;
+  qnnp_operator_t convolution = nullptr;
+  EXPECT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      padding, padding, padding, padding,
+      kernelSize, kernelSize,
+      1, 1,
+      1, 1,
+      1, inputChannels, outputChannels,
+      127, 0.5f,
+      127, 0.5f,
+      kernel.data(), bias.data(),
+      127, 0.25f * kernelSize * kernelSize * inputChannels, 0, 255,
+      flags,
+      &convolution));
+  return convolution;
+}
+
+/*
+ * Expand branches of a fire module: 1x1 and 3x3 convolutions of the same input, which write the two channel slices
+ * of the concatenated output. Checks that running them with qnnp_run_operators gives the output of separate runs.
+ */
+void testFireModule(size_t threads, uint32_t flags) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  const size_t batchSize = 2, height = 13, width = 11;
+  const size_t inputChannels = 16, expand1x1Channels = 64, expand3x3Channels = 64;
+  const size_t outputChannels = expand1x1Channels + expand3x3Channels;
+  std::vector<uint8_t> input(batchSize * height * width * inputChannels + 8);
+  std::vector<uint8_t> kernel1x1(expand1x1Channels * inputChannels);
+  std::vector<uint8_t> kernel3x3(expand3x3Channels * 3 * 3 * inputChannels);
+  std::vector<int32_t> bias1x1(expand1x1Channels), bias3x3(expand3x3Channels);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::generate(kernel1x1.begin(), kernel1x1.end(), std::ref(u8rng));
+  std::generate(kernel3x3.begin(), kernel3x3.end(), std::ref(u8rng));
+  std::generate(bias1x1.begin(), bias1x1.end(), std::ref(s32rng));
+  std::generate(bias3x3.begin(), bias3x3.end(), std::ref(s32rng));
+
+  pthreadpool_t threadpool = pthreadpool_create(threads);
+  std::vector<uint8_t> outputs[2] = {
+    std::vector<uint8_t>(batchSize * height * width * outputChannels),
+    std::vector<uint8_t>(batchSize * height * width * outputChannels),
+  };
+  for (size_t iteration = 0; iteration < 2; iteration++) {
+    qnnp_operator_t branches[2] = {
+      createConvolution(1, inputChannels, expand1x1Channels, kernel1x1, bias1x1, flags),
+      createConvolution(3, inputChannels, expand3x3Channels, kernel3x3, bias3x3, flags),
+    };
+    ASSERT_NE(nullptr, branches[0]);
+    ASSERT_NE(nullptr, branches[1]);
+    uint8_t* output = outputs[iteration].data();
+    ASSERT_EQ(qnnp_status_success,
+      qnnp_setup_convolution2d_nhwc_q8(
+        branches[0], batchSize, height, width,
+        input.data() + 8, inputChannels,
+        output, outputChannels,
+        threadpool));
+    ASSERT_EQ(qnnp_status_success,
+      qnnp_setup_convolution2d_nhwc_q8(
+        branches[1], batchSize, height, width,
+        input.data() + 8, inputChannels,
+        output + expand1x1Channels, outputChannels,
+        threadpool));
+    if (iteration == 0) {
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(branches[0], threadpool));
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(branches[1], threadpool));
+    } else {
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operators(2, branches, threadpool));
+    }
+    ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(branches[0]));
+    ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(branches[1]));
+  }
+  if (threadpool != nullptr) {
+    pthreadpool_destroy(threadpool);
+  }
+  EXPECT_EQ(outputs[0], outputs[1]);
+}
+
+}  // namespace
+
+TEST(RUN_OPERATORS, fire_module_single_thread) {
+  testFireModule(1, 0 /* flags */);
+}
+
+TEST(RUN_OPERATORS, fire_module_multithreaded) {
+  testFireModule(4, 0 /* flags */);
+}
+
+TEST(RUN_OPERATORS, fire_module_lazy_packing) {
+  testFireModule(3, QNNP_CREATE_FLAG_LAZY_PACKING);
+}
+
+TEST(RUN_OPERATORS, too_many_operators) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::vector<qnnp_operator_t> operators(QNNP_MAX_CONCURRENT_OPERATORS + 1, nullptr);
+  EXPECT_EQ(qnnp_status_unsupported_parameter, qnnp_run_operators(operators.size(), operators.data(), nullptr));
+}
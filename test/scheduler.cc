@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <sched.h>
+
+#include <cpuinfo.h>
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+namespace {
+
+struct SerialScheduler {
+  size_t loops;
+  size_t tasks;
+};
+
+/* Runs the tasks in reverse order on the calling thread, which exposes order dependencies of the loops */
+void parallelizeSerial(void* context, qnnp_task_function task, void* taskContext, size_t tasks) {
+  SerialScheduler* scheduler = static_cast<SerialScheduler*>(context);
+  scheduler->loops++;
+  scheduler->tasks += tasks;
+  for (size_t i = tasks; i-- != 0; ) {
+    task(taskContext, i);
+  }
+}
+
+/* Records the operating system processor of every task */
+void recordProcessor(void* context, size_t task) {
+  static_cast<int*>(context)[task] = sched_getcpu();
+}
+
+/* Index of the processor of the calling thread in cpuinfo_get_processor */
+uint32_t getCurrentProcessorIndex() {
+  const int processorId = sched_getcpu();
+  for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+    if (cpuinfo_get_processor(i)->linux_id == processorId) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Grouped 3x3 convolution with padding 1, run on the given scheduler, or on the thread pool if it is NULL. The input
+ * starts after 8 padding bytes, which microkernels may read before the first pixel, like in the testers.
+ */
+std::vector<uint8_t> runConvolution(
+    const std::vector<uint8_t>& input,
+    const std::vector<uint8_t>& kernel,
+    const std::vector<int32_t>& bias,
+    size_t groups, size_t groupInputChannels, size_t groupOutputChannels,
+    size_t batchSize, size_t inputHeight, size_t inputWidth,
+    pthreadpool_t threadpool,
+    const qnnp_scheduler* scheduler)
+{
+  qnnp_operator_t convolution = nullptr;
+  EXPECT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      1, 1, 1, 1,
+      3, 3,
+      1, 1,
+      1, 1,
+      groups, groupInputChannels, groupOutputChannels,
+      127, 0.5f,
+      127, 0.5f,
+      kernel.data(), bias.data(),
+      127, 8.0f, 0, 255,
+      0 /* flags */,
+      &convolution));
+
+  std::vector<uint8_t> output(batchSize * inputHeight * inputWidth * groups * groupOutputChannels);
+  if (convolution != nullptr) {
+    EXPECT_EQ(qnnp_status_success, qnnp_set_operator_scheduler(convolution, scheduler));
+    EXPECT_EQ(qnnp_status_success,
+      qnnp_setup_convolution2d_nhwc_q8(
+        convolution, batchSize, inputHeight, inputWidth,
+        input.data() + 8, groups * groupInputChannels,
+        output.data(), groups * groupOutputChannels,
+        threadpool));
+    EXPECT_EQ(qnnp_status_success, qnnp_run_operator(convolution, threadpool));
+    EXPECT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+  }
+  return output;
+}
+
+}  // namespace
+
+TEST(SCHEDULER, invalid_scheduler) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const std::vector<uint8_t> kernel(16 * 3 * 3 * 8, 1);
+  const std::vector<int32_t> bias(16, 0);
+  qnnp_operator_t convolution = nullptr;
+  ASSERT_EQ(qnnp_status_success,
+    qnnp_create_convolution2d_nhwc_q8(
+      1, 1, 1, 1,
+      3, 3,
+      1, 1,
+      1, 1,
+      1, 8, 16,
+      127, 1.0f,
+      127, 1.0f,
+      kernel.data(), bias.data(),
+      127, 100.0f, 0, 255,
+      0 /* flags */,
+      &convolution));
+
+  SerialScheduler serialScheduler = { 0, 0 };
+  qnnp_scheduler scheduler = { nullptr, &serialScheduler, 1 };
+  EXPECT_EQ(qnnp_status_invalid_parameter, qnnp_set_operator_scheduler(convolution, &scheduler));
+  scheduler.parallelize = parallelizeSerial;
+  scheduler.threads_count = 0;
+  EXPECT_EQ(qnnp_status_invalid_parameter, qnnp_set_operator_scheduler(convolution, &scheduler));
+  EXPECT_EQ(qnnp_status_success, qnnp_set_operator_scheduler(convolution, nullptr));
+
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(convolution));
+}
+
+TEST(SCHEDULER, custom_scheduler) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  const size_t groups = 2, groupInputChannels = 5, groupOutputChannels = 11;
+  std::vector<uint8_t> input(2 * 9 * 7 * groups * groupInputChannels + 8);
+  std::vector<uint8_t> kernel(groups * groupOutputChannels * 3 * 3 * groupInputChannels);
+  std::vector<int32_t> bias(groups * groupOutputChannels);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  const std::vector<uint8_t> reference = runConvolution(
+    input, kernel, bias, groups, groupInputChannels, groupOutputChannels, 2, 9, 7, nullptr, nullptr);
+
+  SerialScheduler serialScheduler = { 0, 0 };
+  const qnnp_scheduler scheduler = { parallelizeSerial, &serialScheduler, 3 };
+  const std::vector<uint8_t> output = runConvolution(
+    input, kernel, bias, groups, groupInputChannels, groupOutputChannels, 2, 9, 7, nullptr, &scheduler);
+  EXPECT_NE(0u, serialScheduler.loops);
+  EXPECT_LE(serialScheduler.loops, serialScheduler.tasks);
+  EXPECT_EQ(reference, output);
+}
+
+TEST(SCHEDULER, work_stealing_scheduler) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  const size_t groups = 1, groupInputChannels = 17, groupOutputChannels = 23;
+  std::vector<uint8_t> input(3 * 13 * 11 * groups * groupInputChannels + 8);
+  std::vector<uint8_t> kernel(groups * groupOutputChannels * 3 * 3 * groupInputChannels);
+  std::vector<int32_t> bias(groups * groupOutputChannels);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  const std::vector<uint8_t> reference = runConvolution(
+    input, kernel, bias, groups, groupInputChannels, groupOutputChannels, 3, 13, 11, nullptr, nullptr);
+
+  pthreadpool_t threadpool = pthreadpool_create(4);
+  qnnp_scheduler scheduler;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_work_stealing_scheduler(threadpool, &scheduler));
+  const std::vector<uint8_t> output = runConvolution(
+    input, kernel, bias, groups, groupInputChannels, groupOutputChannels, 3, 13, 11, threadpool, &scheduler);
+  if (threadpool != nullptr) {
+    pthreadpool_destroy(threadpool);
+  }
+  EXPECT_EQ(reference, output);
+}
+
+TEST(SCHEDULER, affinity_pool_scheduler) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint8_t>(), rng);
+  auto s32rng = std::bind(std::uniform_int_distribution<int32_t>(-10000, 10000), rng);
+
+  const size_t groups = 1, groupInputChannels = 17, groupOutputChannels = 23;
+  std::vector<uint8_t> input(3 * 13 * 11 * groups * groupInputChannels + 8);
+  std::vector<uint8_t> kernel(groups * groupOutputChannels * 3 * 3 * groupInputChannels);
+  std::vector<int32_t> bias(groups * groupOutputChannels);
+  std::generate(input.begin(), input.end(), std::ref(u8rng));
+  std::generate(kernel.begin(), kernel.end(), std::ref(u8rng));
+  std::generate(bias.begin(), bias.end(), std::ref(s32rng));
+
+  const std::vector<uint8_t> reference = runConvolution(
+    input, kernel, bias, groups, groupInputChannels, groupOutputChannels, 3, 13, 11, nullptr, nullptr);
+
+  /* Two threads on the processor the test runs on, which the process may use */
+  const uint32_t processors[2] = { getCurrentProcessorIndex(), getCurrentProcessorIndex() };
+  qnnp_affinity_pool_t pool = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_affinity_pool(2, processors, &pool));
+  qnnp_scheduler scheduler;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_affinity_pool_scheduler(pool, &scheduler));
+  EXPECT_EQ(2u, scheduler.threads_count);
+
+  std::vector<int> taskProcessors(37, -1);
+  scheduler.parallelize(scheduler.context, recordProcessor, taskProcessors.data(), taskProcessors.size());
+  for (int processorId : taskProcessors) {
+    EXPECT_EQ(cpuinfo_get_processor(processors[0])->linux_id, processorId);
+  }
+
+  const std::vector<uint8_t> output = runConvolution(
+    input, kernel, bias, groups, groupInputChannels, groupOutputChannels, 3, 13, 11, nullptr, &scheduler);
+  EXPECT_EQ(reference, output);
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_affinity_pool(pool));
+}
+
+TEST(SCHEDULER, cluster_affinity_pool) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  const cpuinfo_cluster* cluster = cpuinfo_get_processor(getCurrentProcessorIndex())->cluster;
+  const uint32_t clusterIndex = uint32_t(cluster - cpuinfo_get_cluster(0));
+  qnnp_affinity_pool_t pool = nullptr;
+  const qnnp_status status = qnnp_create_cluster_affinity_pool(clusterIndex, &pool);
+  /* The process may not be allowed on every processor of the cluster */
+  if (status == qnnp_status_unsupported_hardware) {
+    return;
+  }
+  ASSERT_EQ(qnnp_status_success, status);
+  qnnp_scheduler scheduler;
+  ASSERT_EQ(qnnp_status_success, qnnp_get_affinity_pool_scheduler(pool, &scheduler));
+  EXPECT_EQ(size_t(cluster->processor_count), scheduler.threads_count);
+
+  std::vector<int> taskProcessors(4 * cluster->processor_count, -1);
+  scheduler.parallelize(scheduler.context, recordProcessor, taskProcessors.data(), taskProcessors.size());
+  for (int processorId : taskProcessors) {
+    bool inCluster = false;
+    for (uint32_t i = 0; i < cluster->processor_count; i++) {
+      inCluster |= cpuinfo_get_processor(cluster->processor_start + i)->linux_id == processorId;
+    }
+    EXPECT_TRUE(inCluster) << "processor " << processorId;
+  }
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_affinity_pool(pool));
+}
+
+TEST(SCHEDULER, invalid_affinity_pool) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_affinity_pool_t pool = nullptr;
+  const uint32_t processor = cpuinfo_get_processors_count();
+  EXPECT_EQ(qnnp_status_invalid_parameter, qnnp_create_affinity_pool(0, &processor, &pool));
+  EXPECT_EQ(qnnp_status_invalid_parameter, qnnp_create_affinity_pool(1, &processor, &pool));
+  EXPECT_EQ(qnnp_status_invalid_parameter, qnnp_create_cluster_affinity_pool(cpuinfo_get_clusters_count(), &pool));
+  EXPECT_EQ(nullptr, pool);
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <gemm-tester.h>
+#include <qnnpack/sconv.h>
+
+// clang-format off
+
+TEST(SCONV_6x8_PSIMD, k_eq_1) {
+  GemmTester()
+    .mr(6)
+    .nr(8)
+    .np(8)
+    .kr(1)
+    .m(6)
+    .n(8)
+    .k(1)
+    .ks(3)
+    .testMicroKernel(sconv_ukernel_6x8__psimd);
+}
+
+TEST(SCONV_6x8_PSIMD, k_eq_1_strided_c) {
+  GemmTester()
+    .mr(6)
+    .nr(8)
+    .np(8)
+    .kr(1)
+    .m(6)
+    .n(8)
+    .k(1)
+    .ks(3)
+    .cStride(17)
+    .testMicroKernel(sconv_ukernel_6x8__psimd);
+}
+
+TEST(SCONV_6x8_PSIMD, k_eq_8_qmin128) {
+  GemmTester()
+    .mr(6)
+    .nr(8)
+    .np(8)
+    .kr(1)
+    .m(6)
+    .n(8)
+    .k(8)
+    .ks(3)
+    .qmin(128)
+    .testMicroKernel(sconv_ukernel_6x8__psimd);
+}
+
+TEST(SCONV_6x8_PSIMD, k_eq_8_qmax128) {
+  GemmTester()
+    .mr(6)
+    .nr(8)
+    .np(8)
+    .kr(1)
+    .m(6)
+    .n(8)
+    .k(8)
+    .ks(3)
+    .qmax(128)
+    .testMicroKernel(sconv_ukernel_6x8__psimd);
+}
+
+TEST(SCONV_6x8_PSIMD, k_gt_1) {
+  for (size_t k = 2; k < 16; k++) {
+    GemmTester()
+      .mr(6)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(6)
+      .n(8)
+      .k(k)
+      .ks(3)
+      .aStride(37)
+      .testMicroKernel(sconv_ukernel_6x8__psimd);
+  }
+}
+
+TEST(SCONV_6x8_PSIMD, k_gt_1_strided_c) {
+  for (size_t k = 2; k < 16; k++) {
+    GemmTester()
+      .mr(6)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(6)
+      .n(8)
+      .k(k)
+      .ks(3)
+      .aStride(37)
+      .cStride(17)
+      .testMicroKernel(sconv_ukernel_6x8__psimd);
+  }
+}
+
+TEST(SCONV_6x8_PSIMD, k_gt_1_subtile) {
+  for (size_t k = 2; k < 16; k += 3) {
+    for (uint32_t m = 1; m <= 6; m++) {
+      for (uint32_t n = 1; n <= 8; n++) {
+        GemmTester()
+          .mr(6)
+          .nr(8)
+          .np(8)
+          .kr(1)
+          .m(m)
+          .n(n)
+          .k(k)
+          .ks(3)
+          .aStride(37)
+          .iterations(3)
+          .testMicroKernel(sconv_ukernel_6x8__psimd);
+      }
+    }
+  }
+}
+
+TEST(SCONV_6x8_PSIMD, ks_gt_1) {
+  for (size_t ks = 1; ks < 10; ks++) {
+    GemmTester()
+      .mr(6)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(6)
+      .n(8)
+      .k(5)
+      .ks(ks)
+      .aStride(37)
+      .testMicroKernel(sconv_ukernel_6x8__psimd);
+  }
+}
+
+TEST(SCONV_6x8_PSIMD, k_div_8) {
+  for (size_t k = 16; k < 128; k += 8) {
+    GemmTester()
+      .mr(6)
+      .nr(8)
+      .np(8)
+      .kr(1)
+      .m(6)
+      .n(8)
+      .k(k)
+      .ks(3)
+      .aStride(171)
+      .testMicroKernel(sconv_ukernel_6x8__psimd);
+  }
+}
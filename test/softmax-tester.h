@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <pthreadpool.h>
+
+#include <qnnpack.h>
+
+
+/* Tests softmax and argmax operators on a batch of strided rows */
+class SoftmaxTester {
+ public:
+  inline SoftmaxTester& channels(size_t channels) {
+    assert(channels != 0);
+    this->channels_ = channels;
+    return *this;
+  }
+
+  inline size_t channels() const {
+    return this->channels_;
+  }
+
+  inline SoftmaxTester& inputStride(size_t inputStride) {
+    assert(inputStride != 0);
+    this->inputStride_ = inputStride;
+    return *this;
+  }
+
+  inline size_t inputStride() const {
+    if (this->inputStride_ == 0) {
+      return this->channels_;
+    } else {
+      assert(this->inputStride_ >= this->channels_);
+      return this->inputStride_;
+    }
+  }
+
+  inline SoftmaxTester& outputStride(size_t outputStride) {
+    assert(outputStride != 0);
+    this->outputStride_ = outputStride;
+    return *this;
+  }
+
+  inline size_t outputStride() const {
+    if (this->outputStride_ == 0) {
+      return this->channels_;
+    } else {
+      assert(this->outputStride_ >= this->channels_);
+      return this->outputStride_;
+    }
+  }
+
+  inline SoftmaxTester& batchSize(size_t batchSize) {
+    this->batchSize_ = batchSize;
+    return *this;
+  }
+
+  inline size_t batchSize() const {
+    return this->batchSize_;
+  }
+
+  inline SoftmaxTester& inputScale(float inputScale) {
+    assert(inputScale > 0.0f);
+    assert(std::isnormal(inputScale));
+    this->inputScale_ = inputScale;
+    return *this;
+  }
+
+  inline float inputScale() const {
+    return this->inputScale_;
+  }
+
+  /* Draw inputs from [0, inputMax], so that rows have ties and maxima below 255 */
+  inline SoftmaxTester& inputMax(uint8_t inputMax) {
+    this->inputMax_ = inputMax;
+    return *this;
+  }
+
+  inline uint8_t inputMax() const {
+    return this->inputMax_;
+  }
+
+  inline SoftmaxTester& threads(size_t threads) {
+    this->threads_ = threads;
+    return *this;
+  }
+
+  inline size_t threads() const {
+    return this->threads_;
+  }
+
+  inline SoftmaxTester& iterations(size_t iterations) {
+    this->iterations_ = iterations;
+    return *this;
+  }
+
+  inline size_t iterations() const {
+    return this->iterations_;
+  }
+
+  void testSoftmax() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint32_t>(0, inputMax()), rng);
+
+    std::vector<uint8_t> input((batchSize() - 1) * inputStride() + channels());
+    std::vector<uint8_t> output((batchSize() - 1) * outputStride() + channels());
+    std::vector<float> outputRef(batchSize() * channels());
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(input.begin(), input.end(), std::ref(u8rng));
+      std::fill(output.begin(), output.end(), 0xA5);
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        const uint8_t* row = &input[i * inputStride()];
+        const int32_t maxInput = int32_t(*std::max_element(row, row + channels()));
+        float sumExp = 0.0f;
+        for (size_t c = 0; c < channels(); c++) {
+          sumExp += std::exp(float(int32_t(row[c]) - maxInput) * inputScale());
+        }
+        for (size_t c = 0; c < channels(); c++) {
+          const float scaledExp = std::exp(float(int32_t(row[c]) - maxInput) * inputScale());
+          outputRef[i * channels() + c] = std::min(scaledExp / sumExp * 256.0f, 255.0f);
+        }
+      }
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t softmax = nullptr;
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_create_softmax_nc_q8(
+          channels(), inputScale(),
+          0 /* output zero point */, 1.0f / 256.0f /* output scale */,
+          0, &softmax));
+      ASSERT_NE(nullptr, softmax);
+
+      pthreadpool_t threadpool = nullptr;
+      if (threads() != 1) {
+        threadpool = pthreadpool_create(threads());
+        ASSERT_NE(nullptr, threadpool);
+      }
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_softmax_nc_q8(
+          softmax,
+          batchSize(),
+          input.data(), inputStride(),
+          output.data(), outputStride(),
+          threadpool));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(softmax, threadpool));
+
+      if (threadpool != nullptr) {
+        pthreadpool_destroy(threadpool);
+      }
+      ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(softmax));
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        for (size_t c = 0; c < channels(); c++) {
+          ASSERT_NEAR(float(int32_t(output[i * outputStride() + c])), outputRef[i * channels() + c], 0.6f)
+            << "batch index = " << i << ", channel = " << c;
+        }
+        for (size_t c = channels(); i + 1 < batchSize() && c < outputStride(); c++) {
+          ASSERT_EQ(0xA5, output[i * outputStride() + c])
+            << "batch index = " << i << ", padding " << c << " was overwritten";
+        }
+      }
+    }
+  }
+
+  void testArgmax() const {
+    std::random_device randomDevice;
+    auto rng = std::mt19937(randomDevice());
+    auto u8rng = std::bind(std::uniform_int_distribution<uint32_t>(0, inputMax()), rng);
+
+    std::vector<uint8_t> input((batchSize() - 1) * inputStride() + channels());
+    std::vector<uint32_t> output(batchSize());
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(input.begin(), input.end(), std::ref(u8rng));
+      std::fill(output.begin(), output.end(), UINT32_C(0xA5A5A5A5));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+      qnnp_operator_t argmax = nullptr;
+
+      ASSERT_EQ(qnnp_status_success, qnnp_create_argmax_nc_q8(channels(), 0, &argmax));
+      ASSERT_NE(nullptr, argmax);
+
+      pthreadpool_t threadpool = nullptr;
+      if (threads() != 1) {
+        threadpool = pthreadpool_create(threads());
+        ASSERT_NE(nullptr, threadpool);
+      }
+
+      ASSERT_EQ(qnnp_status_success,
+        qnnp_setup_argmax_nc_q8(
+          argmax,
+          batchSize(),
+          input.data(), inputStride(),
+          output.data(),
+          threadpool));
+
+      ASSERT_EQ(qnnp_status_success, qnnp_run_operator(argmax, threadpool));
+
+      if (threadpool != nullptr) {
+        pthreadpool_destroy(threadpool);
+      }
+      ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(argmax));
+
+      for (size_t i = 0; i < batchSize(); i++) {
+        const uint8_t* row = &input[i * inputStride()];
+        const uint32_t argmaxRef = uint32_t(std::max_element(row, row + channels()) - row);
+        ASSERT_EQ(argmaxRef, output[i]) << "batch index = " << i;
+      }
+    }
+  }
+
+ private:
+  size_t batchSize_{1};
+  size_t channels_{1};
+  size_t inputStride_{0};
+  size_t outputStride_{0};
+  float inputScale_{0.1f};
+  uint8_t inputMax_{255};
+  size_t threads_{1};
+  size_t iterations_{15};
+};
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "softmax-tester.h"
+
+
+TEST(SOFTMAX_Q8, single_channel) {
+  SoftmaxTester()
+    .batchSize(1)
+    .channels(1)
+    .testSoftmax();
+}
+
+TEST(SOFTMAX_Q8, unit_batch) {
+  for (size_t channels = 2; channels < 100; channels++) {
+    SoftmaxTester()
+      .batchSize(1)
+      .channels(channels)
+      .iterations(3)
+      .testSoftmax();
+  }
+}
+
+TEST(SOFTMAX_Q8, small_batch) {
+  for (size_t channels = 1; channels < 100; channels += 7) {
+    SoftmaxTester()
+      .batchSize(3)
+      .channels(channels)
+      .iterations(3)
+      .testSoftmax();
+  }
+}
+
+TEST(SOFTMAX_Q8, small_batch_with_strides) {
+  for (size_t channels = 1; channels < 100; channels += 7) {
+    SoftmaxTester()
+      .batchSize(3)
+      .channels(channels)
+      .inputStride(129)
+      .outputStride(117)
+      .iterations(3)
+      .testSoftmax();
+  }
+}
+
+TEST(SOFTMAX_Q8, input_scale) {
+  for (size_t channels = 1; channels < 100; channels += 19) {
+    for (float inputScale = 1.0e-2f; inputScale < 1.0e+2f; inputScale *= 3.14159265f) {
+      SoftmaxTester()
+        .batchSize(3)
+        .channels(channels)
+        .inputScale(inputScale)
+        .iterations(1)
+        .testSoftmax();
+    }
+  }
+}
+
+TEST(SOFTMAX_Q8, row_max_below_255) {
+  for (size_t channels = 1; channels < 100; channels += 19) {
+    SoftmaxTester()
+      .batchSize(3)
+      .channels(channels)
+      .inputMax(100)
+      .iterations(3)
+      .testSoftmax();
+  }
+}
+
+TEST(SOFTMAX_Q8, many_channels) {
+  SoftmaxTester()
+    .batchSize(2)
+    .channels(1001)
+    .inputScale(0.05f)
+    .iterations(3)
+    .testSoftmax();
+}
+
+TEST(SOFTMAX_Q8, multithreaded) {
+  SoftmaxTester()
+    .batchSize(13)
+    .channels(37)
+    .threads(4)
+    .iterations(3)
+    .testSoftmax();
+}
+
+TEST(SOFTMAX_Q8, invalid_output_quantization) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t softmax = nullptr;
+  EXPECT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_create_softmax_nc_q8(10, 0.1f, 0, 1.0f / 255.0f, 0, &softmax));
+  EXPECT_EQ(qnnp_status_unsupported_parameter,
+    qnnp_create_softmax_nc_q8(10, 0.1f, 1, 1.0f / 256.0f, 0, &softmax));
+  EXPECT_EQ(nullptr, softmax);
+}
+
+TEST(ARGMAX_Q8, single_channel) {
+  SoftmaxTester()
+    .batchSize(1)
+    .channels(1)
+    .testArgmax();
+}
+
+TEST(ARGMAX_Q8, unit_batch) {
+  for (size_t channels = 2; channels < 100; channels++) {
+    SoftmaxTester()
+      .batchSize(1)
+      .channels(channels)
+      .iterations(3)
+      .testArgmax();
+  }
+}
+
+TEST(ARGMAX_Q8, small_batch_with_stride) {
+  for (size_t channels = 1; channels < 100; channels += 7) {
+    SoftmaxTester()
+      .batchSize(3)
+      .channels(channels)
+      .inputStride(129)
+      .iterations(3)
+      .testArgmax();
+  }
+}
+
+TEST(ARGMAX_Q8, ties) {
+  for (size_t channels = 1; channels < 100; channels += 7) {
+    SoftmaxTester()
+      .batchSize(5)
+      .channels(channels)
+      .inputMax(3)
+      .iterations(3)
+      .testArgmax();
+  }
+}
+
+TEST(ARGMAX_Q8, multithreaded) {
+  SoftmaxTester()
+    .batchSize(13)
+    .channels(1001)
+    .threads(4)
+    .iterations(3)
+    .testArgmax();
+}
+
+TEST(ARGMAX_Q8, setup_other_operator) {
+  ASSERT_EQ(qnnp_status_success, qnnp_initialize());
+  qnnp_operator_t softmax = nullptr;
+  ASSERT_EQ(qnnp_status_success, qnnp_create_softmax_nc_q8(4, 0.1f, 0, 1.0f / 256.0f, 0, &softmax));
+  std::vector<uint8_t> input(4);
+  std::vector<uint32_t> output(1);
+  EXPECT_EQ(qnnp_status_invalid_parameter,
+    qnnp_setup_argmax_nc_q8(softmax, 1, input.data(), 4, output.data(), nullptr));
+  ASSERT_EQ(qnnp_status_success, qnnp_delete_operator(softmax));
+}
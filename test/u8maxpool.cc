@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <qnnpack/u8maxpool.h>
+
+#include "pool-microkernel-tester.h"
+
+
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  TEST(U8MAXPOOL_8x_NEON, c_eq_8_ks_eq_9) {
+    PoolMicrokernelTester()
+      .kernelSize(9)
+      .channels(8)
+      .test(u8maxpool_ukernel_8x__neon);
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, c_eq_8_ks_any) {
+    for (size_t ks = 2; ks <= 25; ks++) {
+      PoolMicrokernelTester()
+        .kernelSize(ks)
+        .channels(8)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, c_div_8) {
+    for (size_t c = 16; c < 128; c += 24) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, c_gt_8) {
+    for (size_t c = 9; c < 16; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, c_lt_8) {
+    for (size_t c = 1; c < 8; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, with_input_offset) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .inputOffset(13)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, multiple_pixels) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t w = 2; w <= 5; w++) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(w)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, multiple_pixels_with_shared_columns) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t step = 3; step <= 6; step += 3) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(5)
+          .inputStep(step)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__neon);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, multiple_pixels_with_output_stride) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(5)
+        .outputStride(29)
+        .inputOffset(7)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, qmin) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmin(192)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__neon);
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_NEON, qmax) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmax(192)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__neon);
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  TEST(U8MAXPOOL_8x_SSE2, c_eq_8_ks_eq_9) {
+    PoolMicrokernelTester()
+      .kernelSize(9)
+      .channels(8)
+      .test(u8maxpool_ukernel_8x__sse2);
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, c_eq_8_ks_any) {
+    for (size_t ks = 2; ks <= 25; ks++) {
+      PoolMicrokernelTester()
+        .kernelSize(ks)
+        .channels(8)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, c_div_8) {
+    for (size_t c = 16; c < 128; c += 24) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, c_gt_8) {
+    for (size_t c = 9; c < 16; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, c_lt_8) {
+    for (size_t c = 1; c < 8; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, with_input_offset) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .inputOffset(13)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, multiple_pixels) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t w = 2; w <= 5; w++) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(w)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, multiple_pixels_with_shared_columns) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t step = 3; step <= 6; step += 3) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(5)
+          .inputStep(step)
+          .iterations(3)
+          .test(u8maxpool_ukernel_8x__sse2);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, multiple_pixels_with_output_stride) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(5)
+        .outputStride(29)
+        .inputOffset(7)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, qmin) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmin(192)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__sse2);
+    }
+  }
+
+  TEST(U8MAXPOOL_8x_SSE2, qmax) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmax(192)
+        .iterations(3)
+        .test(u8maxpool_ukernel_8x__sse2);
+    }
+  }
+#endif
+
+#if !CPUINFO_ARCH_ARM && !CPUINFO_ARCH_ARM64 && !CPUINFO_ARCH_X86 && !CPUINFO_ARCH_X86_64
+  TEST(U8MAXPOOL_1x_SCALAR, c_eq_8_ks_eq_9) {
+    PoolMicrokernelTester()
+      .kernelSize(9)
+      .channels(8)
+      .test(u8maxpool_ukernel_1x__scalar);
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, c_eq_8_ks_any) {
+    for (size_t ks = 2; ks <= 25; ks++) {
+      PoolMicrokernelTester()
+        .kernelSize(ks)
+        .channels(8)
+        .iterations(3)
+        .test(u8maxpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, c_div_8) {
+    for (size_t c = 16; c < 128; c += 24) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(u8maxpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, c_gt_8) {
+    for (size_t c = 9; c < 16; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(u8maxpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, c_lt_8) {
+    for (size_t c = 1; c < 8; c++) {
+      for (size_t ks = 2; ks <= 25; ks += 7) {
+        PoolMicrokernelTester()
+          .kernelSize(ks)
+          .channels(c)
+          .iterations(3)
+          .test(u8maxpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, with_input_offset) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .inputOffset(13)
+        .iterations(3)
+        .test(u8maxpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, multiple_pixels) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t w = 2; w <= 5; w++) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(w)
+          .iterations(3)
+          .test(u8maxpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, multiple_pixels_with_shared_columns) {
+    for (size_t c = 1; c < 24; c += 5) {
+      for (size_t step = 3; step <= 6; step += 3) {
+        PoolMicrokernelTester()
+          .kernelSize(9)
+          .channels(c)
+          .outputWidth(5)
+          .inputStep(step)
+          .iterations(3)
+          .test(u8maxpool_ukernel_1x__scalar);
+      }
+    }
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, multiple_pixels_with_output_stride) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(5)
+        .outputStride(29)
+        .inputOffset(7)
+        .iterations(3)
+        .test(u8maxpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, qmin) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmin(192)
+        .iterations(3)
+        .test(u8maxpool_ukernel_1x__scalar);
+    }
+  }
+
+  TEST(U8MAXPOOL_1x_SCALAR, qmax) {
+    for (size_t c = 1; c < 24; c += 5) {
+      PoolMicrokernelTester()
+        .kernelSize(9)
+        .channels(c)
+        .outputWidth(3)
+        .qmax(192)
+        .iterations(3)
+        .test(u8maxpool_ukernel_1x__scalar);
+    }
+  }
+#endif
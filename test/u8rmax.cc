@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <qnnpack/u8rmax.h>
+
+
+namespace {
+
+/* Checks the maximum of n random elements in [0, maxValue] */
+void testRMax(size_t n, uint8_t maxValue, u8rmax_ukernel_function u8rmax) {
+  std::random_device randomDevice;
+  auto rng = std::mt19937(randomDevice());
+  auto u8rng = std::bind(std::uniform_int_distribution<uint32_t>(0, maxValue), rng);
+
+  std::vector<uint8_t> x(n);
+  for (size_t iteration = 0; iteration < 20; iteration++) {
+    std::generate(x.begin(), x.end(), std::ref(u8rng));
+    const uint8_t maxRef = *std::max_element(x.begin(), x.end());
+    ASSERT_EQ(uint32_t(maxRef), uint32_t(u8rmax(n, x.data()))) << "n = " << n;
+  }
+}
+
+}  // namespace
+
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  TEST(U8RMAX_NEON, n_lt_16) {
+    for (size_t n = 1; n < 16; n++) {
+      testRMax(n, 255, u8rmax_ukernel__neon);
+    }
+  }
+
+  TEST(U8RMAX_NEON, n_eq_16) {
+    testRMax(16, 255, u8rmax_ukernel__neon);
+  }
+
+  TEST(U8RMAX_NEON, n_div_16) {
+    for (size_t n = 32; n < 512; n += 16) {
+      testRMax(n, 200, u8rmax_ukernel__neon);
+    }
+  }
+
+  TEST(U8RMAX_NEON, n_gt_16) {
+    for (size_t n = 17; n < 32; n++) {
+      testRMax(n, 200, u8rmax_ukernel__neon);
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  TEST(U8RMAX_SSE2, n_lt_16) {
+    for (size_t n = 1; n < 16; n++) {
+      testRMax(n, 255, u8rmax_ukernel__sse2);
+    }
+  }
+
+  TEST(U8RMAX_SSE2, n_eq_16) {
+    testRMax(16, 255, u8rmax_ukernel__sse2);
+  }
+
+  TEST(U8RMAX_SSE2, n_div_16) {
+    for (size_t n = 32; n < 512; n += 16) {
+      testRMax(n, 200, u8rmax_ukernel__sse2);
+    }
+  }
+
+  TEST(U8RMAX_SSE2, n_gt_16) {
+    for (size_t n = 17; n < 32; n++) {
+      testRMax(n, 200, u8rmax_ukernel__sse2);
+    }
+  }
+#endif
+
+#if !CPUINFO_ARCH_ARM && !CPUINFO_ARCH_ARM64 && !CPUINFO_ARCH_X86 && !CPUINFO_ARCH_X86_64
+  TEST(U8RMAX_SCALAR, n_lt_16) {
+    for (size_t n = 1; n < 16; n++) {
+      testRMax(n, 255, u8rmax_ukernel__scalar);
+    }
+  }
+
+  TEST(U8RMAX_SCALAR, n_eq_16) {
+    testRMax(16, 255, u8rmax_ukernel__scalar);
+  }
+
+  TEST(U8RMAX_SCALAR, n_div_16) {
+    for (size_t n = 32; n < 512; n += 16) {
+      testRMax(n, 200, u8rmax_ukernel__scalar);
+    }
+  }
+
+  TEST(U8RMAX_SCALAR, n_gt_16) {
+    for (size_t n = 17; n < 32; n++) {
+      testRMax(n, 200, u8rmax_ukernel__scalar);
+    }
+  }
+#endif
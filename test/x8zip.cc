@@ -0,0 +1,501 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <qnnpack/x8zip.h>
+
+#include "zip-microkernel-tester.h"
+
+
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+  TEST(X8ZIP_X2_NEON, n_eq_8) {
+    ZipMicrokernelTester()
+      .n(8)
+      .g(2)
+      .test(x8zip_ukernel_x2__neon);
+  }
+
+  TEST(X8ZIP_X2_NEON, n_div_8) {
+    for (size_t n = 8; n < 64; n += 8) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(2)
+        .test(x8zip_ukernel_x2__neon);
+    }
+  }
+
+  TEST(X8ZIP_X2_NEON, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(2)
+        .test(x8zip_ukernel_x2__neon);
+    }
+  }
+
+  TEST(X8ZIP_X2_NEON, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(2)
+        .test(x8zip_ukernel_x2__neon);
+    }
+  }
+
+  TEST(X8ZIP_X3_NEON, n_eq_8) {
+    ZipMicrokernelTester()
+      .n(8)
+      .g(3)
+      .test(x8zip_ukernel_x3__neon);
+  }
+
+  TEST(X8ZIP_X3_NEON, n_div_8) {
+    for (size_t n = 8; n < 64; n += 8) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(3)
+        .test(x8zip_ukernel_x3__neon);
+    }
+  }
+
+  TEST(X8ZIP_X3_NEON, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(3)
+        .test(x8zip_ukernel_x3__neon);
+    }
+  }
+
+  TEST(X8ZIP_X3_NEON, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(3)
+        .test(x8zip_ukernel_x3__neon);
+    }
+  }
+
+  TEST(X8ZIP_X4_NEON, n_eq_8) {
+    ZipMicrokernelTester()
+      .n(8)
+      .g(4)
+      .test(x8zip_ukernel_x4__neon);
+  }
+
+  TEST(X8ZIP_X4_NEON, n_div_8) {
+    for (size_t n = 8; n < 64; n += 8) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(4)
+        .test(x8zip_ukernel_x4__neon);
+    }
+  }
+
+  TEST(X8ZIP_X4_NEON, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(4)
+        .test(x8zip_ukernel_x4__neon);
+    }
+  }
+
+  TEST(X8ZIP_X4_NEON, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(4)
+        .test(x8zip_ukernel_x4__neon);
+    }
+  }
+
+  TEST(X8ZIP_XM_NEON, n_eq_8_m_eq_4) {
+    ZipMicrokernelTester()
+      .n(8)
+      .g(4)
+      .test(x8zip_ukernel_xm__neon);
+  }
+
+  TEST(X8ZIP_XM_NEON, n_eq_8_m_div_4) {
+    for (size_t g = 4; g < 32; g += 4) {
+      ZipMicrokernelTester()
+        .n(8)
+        .g(g)
+        .test(x8zip_ukernel_xm__neon);
+    }
+  }
+
+  TEST(X8ZIP_XM_NEON, n_eq_8_m_gt_4) {
+    for (size_t g = 5; g < 8; g++) {
+      ZipMicrokernelTester()
+        .n(8)
+        .g(g)
+        .test(x8zip_ukernel_xm__neon);
+    }
+  }
+
+  TEST(X8ZIP_XM_NEON, n_div_8_m_div_4) {
+    for (size_t g = 4; g < 32; g += 4) {
+      for (size_t n = 8; n < 64; n += 8) {
+        ZipMicrokernelTester()
+          .n(n)
+          .g(g)
+          .test(x8zip_ukernel_xm__neon);
+      }
+    }
+  }
+
+  TEST(X8ZIP_XM_NEON, n_gt_8_m_gt_4) {
+    for (size_t g = 5; g < 8; g++) {
+      for (size_t n = 9; n < 16; n++) {
+        ZipMicrokernelTester()
+          .n(n)
+          .g(g)
+          .test(x8zip_ukernel_xm__neon);
+      }
+    }
+  }
+
+  TEST(X8ZIP_XM_NEON, n_lt_8) {
+    for (size_t g = 4; g < 12; g++) {
+      for (size_t n = 1; n < 8; n++) {
+        ZipMicrokernelTester()
+          .n(n)
+          .g(g)
+          .test(x8zip_ukernel_xm__neon);
+      }
+    }
+  }
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+  TEST(X8ZIP_X2_SSE2, n_eq_16) {
+    ZipMicrokernelTester()
+      .n(16)
+      .g(2)
+      .test(x8zip_ukernel_x2__sse2);
+  }
+
+  TEST(X8ZIP_X2_SSE2, n_div_16) {
+    for (size_t n = 16; n < 128; n += 16) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(2)
+        .test(x8zip_ukernel_x2__sse2);
+    }
+  }
+
+  TEST(X8ZIP_X2_SSE2, n_gt_16) {
+    for (size_t n = 17; n < 32; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(2)
+        .test(x8zip_ukernel_x2__sse2);
+    }
+  }
+
+  TEST(X8ZIP_X2_SSE2, n_lt_16) {
+    for (size_t n = 1; n < 16; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(2)
+        .test(x8zip_ukernel_x2__sse2);
+    }
+  }
+
+  TEST(X8ZIP_X3_SSE2, n_eq_8) {
+    ZipMicrokernelTester()
+      .n(8)
+      .g(3)
+      .test(x8zip_ukernel_x3__sse2);
+  }
+
+  TEST(X8ZIP_X3_SSE2, n_div_8) {
+    for (size_t n = 8; n < 64; n += 8) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(3)
+        .test(x8zip_ukernel_x3__sse2);
+    }
+  }
+
+  TEST(X8ZIP_X3_SSE2, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(3)
+        .test(x8zip_ukernel_x3__sse2);
+    }
+  }
+
+  TEST(X8ZIP_X3_SSE2, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(3)
+        .test(x8zip_ukernel_x3__sse2);
+    }
+  }
+
+  TEST(X8ZIP_X4_SSE2, n_eq_16) {
+    ZipMicrokernelTester()
+      .n(16)
+      .g(4)
+      .test(x8zip_ukernel_x4__sse2);
+  }
+
+  TEST(X8ZIP_X4_SSE2, n_div_16) {
+    for (size_t n = 16; n < 128; n += 16) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(4)
+        .test(x8zip_ukernel_x4__sse2);
+    }
+  }
+
+  TEST(X8ZIP_X4_SSE2, n_gt_16) {
+    for (size_t n = 17; n < 32; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(4)
+        .test(x8zip_ukernel_x4__sse2);
+    }
+  }
+
+  TEST(X8ZIP_X4_SSE2, n_lt_16) {
+    for (size_t n = 1; n < 16; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(4)
+        .test(x8zip_ukernel_x4__sse2);
+    }
+  }
+
+  TEST(X8ZIP_XM_SSE2, n_eq_8_m_eq_4) {
+    ZipMicrokernelTester()
+      .n(8)
+      .g(4)
+      .test(x8zip_ukernel_xm__sse2);
+  }
+
+  TEST(X8ZIP_XM_SSE2, n_eq_8_m_div_4) {
+    for (size_t g = 4; g < 32; g += 4) {
+      ZipMicrokernelTester()
+        .n(8)
+        .g(g)
+        .test(x8zip_ukernel_xm__sse2);
+    }
+  }
+
+  TEST(X8ZIP_XM_SSE2, n_eq_8_m_gt_4) {
+    for (size_t g = 5; g < 8; g++) {
+      ZipMicrokernelTester()
+        .n(8)
+        .g(g)
+        .test(x8zip_ukernel_xm__sse2);
+    }
+  }
+
+  TEST(X8ZIP_XM_SSE2, n_div_8_m_div_4) {
+    for (size_t g = 4; g < 32; g += 4) {
+      for (size_t n = 8; n < 64; n += 8) {
+        ZipMicrokernelTester()
+          .n(n)
+          .g(g)
+          .test(x8zip_ukernel_xm__sse2);
+      }
+    }
+  }
+
+  TEST(X8ZIP_XM_SSE2, n_gt_8_m_gt_4) {
+    for (size_t g = 5; g < 8; g++) {
+      for (size_t n = 9; n < 16; n++) {
+        ZipMicrokernelTester()
+          .n(n)
+          .g(g)
+          .test(x8zip_ukernel_xm__sse2);
+      }
+    }
+  }
+
+  TEST(X8ZIP_XM_SSE2, n_lt_8) {
+    for (size_t g = 4; g < 12; g++) {
+      for (size_t n = 1; n < 8; n++) {
+        ZipMicrokernelTester()
+          .n(n)
+          .g(g)
+          .test(x8zip_ukernel_xm__sse2);
+      }
+    }
+  }
+#endif
+
+#if !CPUINFO_ARCH_ARM && !CPUINFO_ARCH_ARM64 && !CPUINFO_ARCH_X86 && !CPUINFO_ARCH_X86_64
+  TEST(X8ZIP_X2_SCALAR, n_eq_16) {
+    ZipMicrokernelTester()
+      .n(16)
+      .g(2)
+      .test(x8zip_ukernel_x2__scalar);
+  }
+
+  TEST(X8ZIP_X2_SCALAR, n_div_16) {
+    for (size_t n = 16; n < 128; n += 16) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(2)
+        .test(x8zip_ukernel_x2__scalar);
+    }
+  }
+
+  TEST(X8ZIP_X2_SCALAR, n_gt_16) {
+    for (size_t n = 17; n < 32; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(2)
+        .test(x8zip_ukernel_x2__scalar);
+    }
+  }
+
+  TEST(X8ZIP_X2_SCALAR, n_lt_16) {
+    for (size_t n = 1; n < 16; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(2)
+        .test(x8zip_ukernel_x2__scalar);
+    }
+  }
+
+  TEST(X8ZIP_X3_SCALAR, n_eq_8) {
+    ZipMicrokernelTester()
+      .n(8)
+      .g(3)
+      .test(x8zip_ukernel_x3__scalar);
+  }
+
+  TEST(X8ZIP_X3_SCALAR, n_div_8) {
+    for (size_t n = 8; n < 64; n += 8) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(3)
+        .test(x8zip_ukernel_x3__scalar);
+    }
+  }
+
+  TEST(X8ZIP_X3_SCALAR, n_gt_8) {
+    for (size_t n = 9; n < 16; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(3)
+        .test(x8zip_ukernel_x3__scalar);
+    }
+  }
+
+  TEST(X8ZIP_X3_SCALAR, n_lt_8) {
+    for (size_t n = 1; n < 8; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(3)
+        .test(x8zip_ukernel_x3__scalar);
+    }
+  }
+
+  TEST(X8ZIP_X4_SCALAR, n_eq_16) {
+    ZipMicrokernelTester()
+      .n(16)
+      .g(4)
+      .test(x8zip_ukernel_x4__scalar);
+  }
+
+  TEST(X8ZIP_X4_SCALAR, n_div_16) {
+    for (size_t n = 16; n < 128; n += 16) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(4)
+        .test(x8zip_ukernel_x4__scalar);
+    }
+  }
+
+  TEST(X8ZIP_X4_SCALAR, n_gt_16) {
+    for (size_t n = 17; n < 32; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(4)
+        .test(x8zip_ukernel_x4__scalar);
+    }
+  }
+
+  TEST(X8ZIP_X4_SCALAR, n_lt_16) {
+    for (size_t n = 1; n < 16; n++) {
+      ZipMicrokernelTester()
+        .n(n)
+        .g(4)
+        .test(x8zip_ukernel_x4__scalar);
+    }
+  }
+
+  TEST(X8ZIP_XM_SCALAR, n_eq_8_m_eq_4) {
+    ZipMicrokernelTester()
+      .n(8)
+      .g(4)
+      .test(x8zip_ukernel_xm__scalar);
+  }
+
+  TEST(X8ZIP_XM_SCALAR, n_eq_8_m_div_4) {
+    for (size_t g = 4; g < 32; g += 4) {
+      ZipMicrokernelTester()
+        .n(8)
+        .g(g)
+        .test(x8zip_ukernel_xm__scalar);
+    }
+  }
+
+  TEST(X8ZIP_XM_SCALAR, n_eq_8_m_gt_4) {
+    for (size_t g = 5; g < 8; g++) {
+      ZipMicrokernelTester()
+        .n(8)
+        .g(g)
+        .test(x8zip_ukernel_xm__scalar);
+    }
+  }
+
+  TEST(X8ZIP_XM_SCALAR, n_div_8_m_div_4) {
+    for (size_t g = 4; g < 32; g += 4) {
+      for (size_t n = 8; n < 64; n += 8) {
+        ZipMicrokernelTester()
+          .n(n)
+          .g(g)
+          .test(x8zip_ukernel_xm__scalar);
+      }
+    }
+  }
+
+  TEST(X8ZIP_XM_SCALAR, n_gt_8_m_gt_4) {
+    for (size_t g = 5; g < 8; g++) {
+      for (size_t n = 9; n < 16; n++) {
+        ZipMicrokernelTester()
+          .n(n)
+          .g(g)
+          .test(x8zip_ukernel_xm__scalar);
+      }
+    }
+  }
+
+  TEST(X8ZIP_XM_SCALAR, n_lt_8) {
+    for (size_t g = 4; g < 12; g++) {
+      for (size_t n = 1; n < 8; n++) {
+        ZipMicrokernelTester()
+          .n(n)
+          .g(g)
+          .test(x8zip_ukernel_xm__scalar);
+      }
+    }
+  }
+#endif